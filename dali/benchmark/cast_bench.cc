@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <benchmark/benchmark.h>
+#include <vector>
 #include "dali/benchmark/operator_bench.h"
 #include "dali/benchmark/dali_bench.h"
 
@@ -40,4 +41,88 @@ BENCHMARK_REGISTER_F(OperatorBench, CastGPU)->Iterations(100)
   {500, 1000},
 });
 
+namespace {
+
+OpSpec CastSpec(const std::string &device, int batch_size, DALIDataType dtype) {
+  return OpSpec("Cast")
+      .AddArg("max_batch_size", batch_size)
+      .AddArg("num_threads", 4)
+      .AddArg("device", device)
+      .AddArg("dtype", dtype);
+}
+
+OpSpec MultiCastSpec(const std::string &device, int batch_size,
+                     const std::vector<DALIDataType> &dtypes) {
+  return OpSpec("experimental__MultiCast")
+      .AddArg("max_batch_size", batch_size)
+      .AddArg("num_threads", 4)
+      .AddArg("device", device)
+      .AddArg("dtypes", dtypes);
+}
+
+void CastArgs(benchmark::internal::Benchmark *b) {
+  b->Iterations(50)
+   ->Unit(benchmark::kMicrosecond)
+   ->UseRealTime()
+   ->ArgsProduct({{1, 16, 64}, {500, 1000}});
+}
+
+}  // namespace
+
+// Cast, for a few common type pairs
+
+#define CAST_PAIR_BENCHMARK(name, In, out_dtype)                                               \
+  BENCHMARK_DEFINE_F(OperatorBench, CastCPU_##name)(benchmark::State & st) {                   \
+    int batch_size = st.range(0), H = st.range(1), W = st.range(1);                            \
+    this->RunCPU<In>(st, CastSpec("cpu", batch_size, out_dtype), batch_size, H, W);            \
+  }                                                                                            \
+  BENCHMARK_REGISTER_F(OperatorBench, CastCPU_##name)->Apply(CastArgs);                        \
+  BENCHMARK_DEFINE_F(OperatorBench, CastGPU_##name)(benchmark::State & st) {                   \
+    int batch_size = st.range(0), H = st.range(1), W = st.range(1);                            \
+    this->RunGPU<In>(st, CastSpec("gpu", batch_size, out_dtype), batch_size,                   \
+                     TensorShape<>{H, W, 3});                                                  \
+  }                                                                                            \
+  BENCHMARK_REGISTER_F(OperatorBench, CastGPU_##name)->Apply(CastArgs)
+
+CAST_PAIR_BENCHMARK(U8_F32, uint8_t, DALI_FLOAT);
+CAST_PAIR_BENCHMARK(U8_F16, uint8_t, DALI_FLOAT16);
+CAST_PAIR_BENCHMARK(F32_U8, float, DALI_UINT8);
+CAST_PAIR_BENCHMARK(F32_F16, float, DALI_FLOAT16);
+CAST_PAIR_BENCHMARK(I16_F32, int16_t, DALI_FLOAT);
+CAST_PAIR_BENCHMARK(I32_I64, int32_t, DALI_INT64);
+
+// Casting one input to several types at once; compare with the sum of the respective pairs
+
+BENCHMARK_DEFINE_F(OperatorBench, MultiCastCPU_U8_F32_F16)(benchmark::State& st) {
+  int batch_size = st.range(0), H = st.range(1), W = st.range(1);
+  this->RunCPU<uint8_t>(st, MultiCastSpec("cpu", batch_size, {DALI_FLOAT, DALI_FLOAT16}),
+                        batch_size, H, W);
+}
+
+BENCHMARK_REGISTER_F(OperatorBench, MultiCastCPU_U8_F32_F16)->Apply(CastArgs);
+
+BENCHMARK_DEFINE_F(OperatorBench, MultiCastGPU_U8_F32_F16)(benchmark::State& st) {
+  int batch_size = st.range(0), H = st.range(1), W = st.range(1);
+  this->RunGPU<uint8_t>(st, MultiCastSpec("gpu", batch_size, {DALI_FLOAT, DALI_FLOAT16}),
+                        batch_size, TensorShape<>{H, W, 3});
+}
+
+BENCHMARK_REGISTER_F(OperatorBench, MultiCastGPU_U8_F32_F16)->Apply(CastArgs);
+
+BENCHMARK_DEFINE_F(OperatorBench, MultiCastCPU_F32_U8_F16)(benchmark::State& st) {
+  int batch_size = st.range(0), H = st.range(1), W = st.range(1);
+  this->RunCPU<float>(st, MultiCastSpec("cpu", batch_size, {DALI_UINT8, DALI_FLOAT16}),
+                      batch_size, H, W);
+}
+
+BENCHMARK_REGISTER_F(OperatorBench, MultiCastCPU_F32_U8_F16)->Apply(CastArgs);
+
+BENCHMARK_DEFINE_F(OperatorBench, MultiCastGPU_F32_U8_F16)(benchmark::State& st) {
+  int batch_size = st.range(0), H = st.range(1), W = st.range(1);
+  this->RunGPU<float>(st, MultiCastSpec("gpu", batch_size, {DALI_UINT8, DALI_FLOAT16}),
+                      batch_size, TensorShape<>{H, W, 3});
+}
+
+BENCHMARK_REGISTER_F(OperatorBench, MultiCastGPU_F32_U8_F16)->Apply(CastArgs);
+
 }  // namespace dali
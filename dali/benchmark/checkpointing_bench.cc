@@ -1,4 +1,4 @@
-// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <benchmark/benchmark.h>
+#include <future>
+#include <string>
 
 #include "dali/benchmark/dali_bench.h"
 #include "dali/pipeline/pipeline.h"
@@ -21,7 +23,9 @@
 
 namespace dali {
 
-enum class CheckpointingPolicy {Disabled, Enabled, SaveEveryIter, SerializeEveryIter};
+enum class CheckpointingPolicy {
+  Disabled, Enabled, SaveEveryIter, SerializeEveryIter, SerializeAsyncEveryIter
+};
 
 class CheckpointingOverhead : public DALIBenchmark {
  public:
@@ -38,6 +42,7 @@ class CheckpointingOverhead : public DALIBenchmark {
     pipe->Build(outputs);
 
     Workspace ws;
+    std::shared_future<std::string> pending;
 
     // Warmup
     pipe->Run();
@@ -50,8 +55,15 @@ class CheckpointingOverhead : public DALIBenchmark {
         volatile auto cpt = pipe->GetCheckpoint();
       } else if (policy == CheckpointingPolicy::SerializeEveryIter) {
         volatile auto cpt = pipe->SerializedCheckpoint({});
+      } else if (policy == CheckpointingPolicy::SerializeAsyncEveryIter) {
+        // Keep at most one serialization in flight, overlapping it with the next iteration.
+        if (pending.valid())
+          benchmark::DoNotOptimize(pending.get());
+        pending = pipe->SerializedCheckpointAsync({});
       }
     }
+    if (pending.valid())
+      pending.wait();
 
     if (policy == CheckpointingPolicy::Disabled) {
       st.SetLabel("disabled");
@@ -61,6 +73,8 @@ class CheckpointingOverhead : public DALIBenchmark {
       st.SetLabel("save");
     } else if (policy == CheckpointingPolicy::SerializeEveryIter) {
       st.SetLabel("serialize");
+    } else if (policy == CheckpointingPolicy::SerializeAsyncEveryIter) {
+      st.SetLabel("serialize_async");
     }
   }
 
@@ -85,6 +99,7 @@ static void Args(benchmark::internal::Benchmark *b) {
     CheckpointingPolicy::Enabled,
     CheckpointingPolicy::SaveEveryIter,
     CheckpointingPolicy::SerializeEveryIter,
+    CheckpointingPolicy::SerializeAsyncEveryIter,
   };
   for (auto p : policies) {
     b->Args({static_cast<int>(p)});
@@ -17,6 +17,7 @@
 
 #include <benchmark/benchmark.h>
 
+#include "dali/benchmark/generic_op_bench.h"
 #include "dali/core/common.h"
 #include "dali/pipeline/init.h"
 #include "dali/operators.h"
@@ -41,6 +42,7 @@ int main(int argc, char **argv) {
   dali::DALIInit(dali::OpSpec("CPUAllocator"),
       dali::OpSpec("PinnedCPUAllocator"),
       dali::OpSpec("GPUAllocator"));
+  dali::RegisterGenericOpBenchmarks(&argc, argv);
   ::benchmark::Initialize(&argc, argv);
   ::benchmark::RunSpecifiedBenchmarks();
 }
@@ -0,0 +1,462 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/benchmark/generic_op_bench.h"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "dali/core/cuda_event.h"
+#include "dali/core/cuda_stream_pool.h"
+#include "dali/core/static_switch.h"
+#include "dali/pipeline/dali.pb.h"
+#include "dali/pipeline/operator/operator.h"
+#include "dali/pipeline/pipeline.h"
+#include "dali/pipeline/util/thread_pool.h"
+#include "dali/pipeline/workspace/workspace.h"
+
+namespace dali {
+
+namespace {
+
+std::vector<std::string> Split(const std::string &s, char delim) {
+  std::vector<std::string> parts;
+  std::stringstream ss(s);
+  std::string part;
+  while (std::getline(ss, part, delim)) {
+    if (!part.empty())
+      parts.push_back(part);
+  }
+  return parts;
+}
+
+bool ParseBool(const std::string &s) {
+  if (s == "1" || s == "true" || s == "True")
+    return true;
+  if (s == "0" || s == "false" || s == "False")
+    return false;
+  DALI_FAIL(make_string("Invalid boolean value: \"", s, "\"."));
+}
+
+DALIDataType ParseDataType(const std::string &s) {
+  for (int t = 0; t < DALI_NUM_BUILTIN_TYPES; t++) {
+    auto type = static_cast<DALIDataType>(t);
+    if (TypeTable::TryGetTypeInfo(type) && TypeName(type) == s)
+      return type;
+  }
+  DALI_FAIL(make_string("Unknown data type: \"", s, "\"."));
+}
+
+template <typename T, typename Parse>
+std::vector<T> ParseList(const std::string &s, Parse &&parse) {
+  std::vector<T> values;
+  for (auto &item : Split(s, ','))
+    values.push_back(parse(item));
+  return values;
+}
+
+TensorShape<> ParseShape(const std::string &s) {
+  TensorShape<> shape;
+  auto extents = Split(s, 'x');
+  shape.resize(extents.size());
+  for (size_t i = 0; i < extents.size(); i++)
+    shape[i] = std::stoll(extents[i]);
+  return shape;
+}
+
+void FillRandom(TensorList<CPUBackend> &tl, std::mt19937 &rng) {
+  TYPE_SWITCH(tl.type(), type2id, T,
+              (uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, int64_t, uint64_t,
+               float16, float, double, bool),
+    (
+      std::uniform_int_distribution<int> dist(0, 255);
+      for (int s = 0; s < tl.num_samples(); s++) {
+        T *data = tl.mutable_tensor<T>(s);
+        int64_t n = tl.shape().tensor_size(s);
+        for (int64_t i = 0; i < n; i++) {
+          if constexpr (std::is_same_v<T, bool>)
+            data[i] = dist(rng) & 1;
+          else if constexpr (std::is_floating_point_v<T> || std::is_same_v<T, float16>)
+            data[i] = static_cast<T>(dist(rng) / 255.0f);
+          else
+            data[i] = static_cast<T>(dist(rng));
+        }
+      }
+    ), (DALI_FAIL(make_string("Unsupported input type: ", tl.type()))));  // NOLINT
+}
+
+bool UsesGPU(const OpSpec &spec) {
+  return spec.GetArgument<std::string>("device") != "cpu";
+}
+
+/**
+ * @brief Runs the operator in the benchmark loop
+ */
+void RunOpBench(benchmark::State &st, const OpSpec &spec, const std::vector<OpBenchInput> &inputs,
+                const OpBenchArgInputs &arg_inputs, int batch_size, int num_threads) {
+  auto op = InstantiateOperator(spec);
+  Workspace ws;
+  for (auto &input : inputs) {
+    if (input.gpu)
+      ws.AddInput(input.gpu);
+    else
+      ws.AddInput(input.cpu);
+  }
+  for (auto &[name, arg] : arg_inputs)
+    ws.AddArgumentInput(name, arg);
+  for (int i = 0; i < spec.NumOutput(); i++) {
+    if (spec.OutputDevice(i) == "cpu")
+      ws.AddOutput(std::make_shared<TensorList<CPUBackend>>(batch_size));
+    else
+      ws.AddOutput(std::make_shared<TensorList<GPUBackend>>(batch_size));
+  }
+  ws.SetBatchSizes(batch_size);
+
+  int device_id = 0;
+  CUDA_CALL(cudaGetDevice(&device_id));
+  ThreadPool thread_pool(num_threads, device_id, false, "GenericOpBench");
+  ws.SetThreadPool(&thread_pool);
+  bool uses_gpu = UsesGPU(spec);
+  CUDAStreamLease stream;
+  if (uses_gpu) {
+    stream = CUDAStreamPool::instance().Get(device_id);
+    ws.set_stream(stream.get());
+  }
+
+  auto run = [&]() {
+    std::vector<OutputDesc> output_descs;
+    if (op->Setup(output_descs, ws)) {
+      for (int i = 0; i < ws.NumOutput(); i++) {
+        if (ws.OutputIsType<CPUBackend>(i))
+          ws.Output<CPUBackend>(i).Resize(output_descs[i].shape, output_descs[i].type);
+        else
+          ws.Output<GPUBackend>(i).Resize(output_descs[i].shape, output_descs[i].type);
+      }
+    }
+    op->Run(ws);
+  };
+
+  // warm-up - the first iteration allocates the scratch and output memory
+  run();
+  if (uses_gpu)
+    CUDA_CALL(cudaStreamSynchronize(stream));
+
+  if (uses_gpu) {
+    auto start = CUDAEvent::CreateWithFlags(cudaEventDefault, device_id);
+    auto end = CUDAEvent::CreateWithFlags(cudaEventDefault, device_id);
+    for (auto _ : st) {
+      CUDA_CALL(cudaEventRecord(start, stream));
+      run();
+      CUDA_CALL(cudaEventRecord(end, stream));
+      CUDA_CALL(cudaEventSynchronize(end));
+      float ms = 0;
+      CUDA_CALL(cudaEventElapsedTime(&ms, start, end));
+      st.SetIterationTime(ms * 1e-3);
+    }
+  } else {
+    for (auto _ : st)
+      run();
+  }
+  st.counters["FPS"] = benchmark::Counter(batch_size * st.iterations(),
+                                          benchmark::Counter::kIsRate);
+}
+
+void Register(const std::string &name, OpSpec spec, std::vector<OpBenchInput> inputs,
+              OpBenchArgInputs arg_inputs, int batch_size, int num_threads) {
+  bool uses_gpu = UsesGPU(spec);
+  auto *bench = benchmark::RegisterBenchmark(name.c_str(),
+      [=](benchmark::State &st) {
+        RunOpBench(st, spec, inputs, arg_inputs, batch_size, num_threads);
+      });
+  bench->Unit(benchmark::kMicrosecond);
+  if (uses_gpu)
+    bench->UseManualTime();
+  else
+    bench->UseRealTime();
+}
+
+struct GenericOpBenchOptions {
+  std::string op_name;
+  std::string device = "gpu";
+  std::vector<std::pair<std::string, std::string>> args;
+  TensorShape<> shape{1080, 1920, 3};
+  TensorLayout layout = "HWC";
+  std::vector<DALIDataType> dtypes{DALI_UINT8};
+  std::vector<int> batch_sizes{1, 32, 256};
+  std::vector<double> shape_variances{0};
+  int num_inputs = 1;
+  int num_threads = 4;
+  std::string pipeline;
+  int pipeline_warmup = 10;
+};
+
+GenericOpBenchOptions ParseOptions(int *argc, char **argv) {
+  GenericOpBenchOptions opts;
+  int out = 1;
+  for (int i = 1; i < *argc; i++) {
+    std::string arg = argv[i];
+    auto eq = arg.find('=');
+    std::string key = arg.substr(0, eq);
+    std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+    if (key == "--op_name") {
+      opts.op_name = value;
+    } else if (key == "--op_device") {
+      opts.device = value;
+    } else if (key == "--op_args") {
+      for (auto &kv : Split(value, ';')) {
+        auto kv_eq = kv.find('=');
+        DALI_ENFORCE(kv_eq != std::string::npos,
+                     make_string("Invalid operator argument \"", kv, "\"; expected name=value."));
+        opts.args.emplace_back(kv.substr(0, kv_eq), kv.substr(kv_eq + 1));
+      }
+    } else if (key == "--op_shape") {
+      opts.shape = ParseShape(value);
+    } else if (key == "--op_layout") {
+      opts.layout = value;
+    } else if (key == "--op_dtypes") {
+      opts.dtypes = ParseList<DALIDataType>(value, ParseDataType);
+    } else if (key == "--op_batch_sizes") {
+      opts.batch_sizes = ParseList<int>(value, [](const std::string &s) { return std::stoi(s); });
+    } else if (key == "--op_shape_variance") {
+      opts.shape_variances = ParseList<double>(value, [](const std::string &s) {
+        return std::stod(s);
+      });
+    } else if (key == "--op_num_inputs") {
+      opts.num_inputs = std::stoi(value);
+    } else if (key == "--op_threads") {
+      opts.num_threads = std::stoi(value);
+    } else if (key == "--op_pipeline") {
+      opts.pipeline = value;
+    } else if (key == "--op_pipeline_warmup") {
+      opts.pipeline_warmup = std::stoi(value);
+    } else {
+      argv[out++] = argv[i];  // not ours - leave it for the benchmark library
+    }
+  }
+  *argc = out;
+  return opts;
+}
+
+void RegisterSynthetic(const GenericOpBenchOptions &opts) {
+  DALI_ENFORCE(opts.layout.empty() || opts.layout.ndim() == opts.shape.sample_dim(),
+               make_string("The layout \"", opts.layout, "\" doesn't match the shape ",
+                           opts.shape, "."));
+  for (auto dtype : opts.dtypes) {
+    for (int batch_size : opts.batch_sizes) {
+      for (double variance : opts.shape_variances) {
+        OpSpec spec(opts.op_name);
+        spec.AddArg("device", opts.device)
+            .AddArg("max_batch_size", batch_size)
+            .AddArg("num_threads", opts.num_threads);
+        for (auto &[arg_name, value] : opts.args)
+          AddArgFromString(spec, arg_name, value);
+        std::vector<OpBenchInput> inputs;
+        for (int i = 0; i < opts.num_inputs; i++) {
+          OpBenchInput input;
+          input.cpu = GenerateBenchInput(dtype, opts.shape, opts.layout, batch_size, variance, i);
+          if (opts.device == "gpu") {
+            input.gpu = std::make_shared<TensorList<GPUBackend>>();
+            input.gpu->Copy(*input.cpu, (cudaStream_t)0);
+            CUDA_CALL(cudaStreamSynchronize(0));
+            input.cpu.reset();
+          }
+          spec.AddInput(make_string("input", i), opts.device == "gpu" ? "gpu" : "cpu");
+          inputs.push_back(std::move(input));
+        }
+        int num_outputs = spec.GetSchema().CalculateOutputs(spec);
+        for (int i = 0; i < num_outputs; i++)
+          spec.AddOutput(make_string("output", i), opts.device == "cpu" ? "cpu" : "gpu");
+
+        auto name = make_string("GenericOp/", opts.op_name, "/", opts.device, "/", dtype,
+                                "/batch_size:", batch_size, "/shape_variance:", variance);
+        Register(name, std::move(spec), std::move(inputs), {}, batch_size, opts.num_threads);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Runs the serialized pipeline, captures the inputs of its operators and registers
+ *        a benchmark for each operator (or the ones called `op_name`).
+ */
+void RegisterReplay(const GenericOpBenchOptions &opts) {
+  std::ifstream file(opts.pipeline, std::ios::binary);
+  DALI_ENFORCE(file.good(), make_string("Cannot open the pipeline file: ", opts.pipeline));
+  std::string serialized((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  dali_proto::PipelineDef def;
+  DALI_ENFORCE(def.ParseFromString(serialized), "Cannot parse the serialized pipeline.");
+
+  // The pipeline outputs the inputs of all operators (as well as its own outputs, so that
+  // nothing is pruned)
+  std::vector<PipelineOutputDesc> outputs;
+  std::set<std::pair<std::string, std::string>> added;
+  auto add_output = [&](const std::string &name, const std::string &device) {
+    if (added.emplace(name, device).second)
+      outputs.emplace_back(std::make_pair(name, device));
+  };
+  for (auto &out : def.pipe_outputs())
+    add_output(out.name(), out.device());
+  for (auto &op_def : def.op()) {
+    for (auto &in : op_def.input())
+      add_output(in.name(), in.device());
+  }
+
+  Pipeline pipe(serialized, -1, opts.num_threads, -1, true, 2, true, true);
+  pipe.Build(outputs);
+  Workspace ws;
+  for (int i = 0; i <= opts.pipeline_warmup; i++) {
+    pipe.Run();
+    pipe.Outputs(&ws);
+  }
+
+  int device_id = 0;
+  CUDA_CALL(cudaGetDevice(&device_id));
+  auto stream = CUDAStreamPool::instance().Get(device_id);
+  std::map<std::pair<std::string, std::string>, OpBenchInput> captured;
+  for (size_t i = 0; i < outputs.size(); i++) {
+    OpBenchInput data;
+    if (ws.OutputIsType<CPUBackend>(i)) {
+      data.cpu = std::make_shared<TensorList<CPUBackend>>();
+      data.cpu->Copy(ws.Output<CPUBackend>(i), AccessOrder::host());
+    } else {
+      data.gpu = std::make_shared<TensorList<GPUBackend>>();
+      data.gpu->Copy(ws.Output<GPUBackend>(i), stream.get());
+    }
+    captured[{outputs[i].name, outputs[i].device}] = std::move(data);
+  }
+  CUDA_CALL(cudaStreamSynchronize(stream));
+
+  for (auto &op_def : def.op()) {
+    auto *node = pipe.GetOperatorNode(op_def.inst_name());
+    if (!node || node->spec.NumRegularInput() == 0)
+      continue;  // pruned, or a source operator
+    const OpSpec &spec = node->spec;
+    if (!opts.op_name.empty() && spec.SchemaName() != opts.op_name)
+      continue;
+    std::vector<OpBenchInput> inputs;
+    OpBenchArgInputs arg_inputs;
+    bool complete = true;
+    for (int i = 0; i < spec.NumInput(); i++) {
+      auto it = captured.find({spec.InputName(i), spec.InputDevice(i)});
+      if (it == captured.end()) {
+        complete = false;
+        break;
+      }
+      if (spec.IsArgumentInput(i))
+        arg_inputs[spec.ArgumentInputName(i)] = it->second.cpu;
+      else
+        inputs.push_back(it->second);
+    }
+    if (!complete)
+      continue;
+    int batch_size = inputs[0].cpu ? inputs[0].cpu->num_samples() : inputs[0].gpu->num_samples();
+    auto name = make_string("PipelineOp/", op_def.inst_name(), "/", spec.SchemaName(), "/",
+                            spec.GetArgument<std::string>("device"), "/batch_size:", batch_size);
+    Register(name, spec, std::move(inputs), std::move(arg_inputs), batch_size,
+             opts.num_threads);
+  }
+}
+
+}  // namespace
+
+void AddArgFromString(OpSpec &spec, const std::string &name, const std::string &value) {
+  auto type = spec.GetSchema().GetArgumentType(name);
+  auto to_int = [](const std::string &s) { return std::stoi(s); };
+  auto to_float = [](const std::string &s) { return std::stof(s); };
+  auto to_string = [](const std::string &s) { return s; };
+  switch (type) {
+    case DALI_INT32:
+      spec.AddArg(name, std::stoi(value));
+      break;
+    case DALI_INT64:
+      spec.AddArg(name, static_cast<int64_t>(std::stoll(value)));
+      break;
+    case DALI_FLOAT:
+      spec.AddArg(name, std::stof(value));
+      break;
+    case DALI_BOOL:
+      spec.AddArg(name, ParseBool(value));
+      break;
+    case DALI_STRING:
+      spec.AddArg(name, value);
+      break;
+    case DALI_TENSOR_LAYOUT:
+      spec.AddArg(name, TensorLayout(value));
+      break;
+    case DALI_DATA_TYPE:
+      spec.AddArg(name, ParseDataType(value));
+      break;
+    case DALI_IMAGE_TYPE:
+      spec.AddArg(name, static_cast<DALIImageType>(std::stoi(value)));
+      break;
+    case DALI_INTERP_TYPE:
+      spec.AddArg(name, static_cast<DALIInterpType>(std::stoi(value)));
+      break;
+    case DALI_INT_VEC:
+      spec.AddArg(name, ParseList<int>(value, to_int));
+      break;
+    case DALI_FLOAT_VEC:
+      spec.AddArg(name, ParseList<float>(value, to_float));
+      break;
+    case DALI_BOOL_VEC:
+      spec.AddArg(name, ParseList<bool>(value, ParseBool));
+      break;
+    case DALI_STRING_VEC:
+      spec.AddArg(name, ParseList<std::string>(value, to_string));
+      break;
+    default:
+      DALI_FAIL(make_string("The argument \"", name, "\" of type ", type,
+                            " cannot be set from the command line."));
+  }
+}
+
+std::shared_ptr<TensorList<CPUBackend>> GenerateBenchInput(
+    DALIDataType type, const TensorShape<> &shape, const TensorLayout &layout, int batch_size,
+    double shape_variance, int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> scale(1 - shape_variance, 1);
+  int channel_dim = layout.find('C');
+  TensorListShape<> tls(batch_size, shape.sample_dim());
+  for (int s = 0; s < batch_size; s++) {
+    auto sample_shape = shape;
+    for (int d = 0; d < shape.sample_dim(); d++) {
+      if (d != channel_dim && shape_variance > 0)
+        sample_shape[d] = std::max<int64_t>(1, std::llround(shape[d] * scale(rng)));
+    }
+    tls.set_tensor_shape(s, sample_shape);
+  }
+  auto tl = std::make_shared<TensorList<CPUBackend>>();
+  tl->Resize(tls, type);
+  if (!layout.empty())
+    tl->SetLayout(layout);
+  FillRandom(*tl, rng);
+  return tl;
+}
+
+void RegisterGenericOpBenchmarks(int *argc, char **argv) {
+  auto opts = ParseOptions(argc, argv);
+  if (!opts.pipeline.empty())
+    RegisterReplay(opts);
+  else if (!opts.op_name.empty())
+    RegisterSynthetic(opts);
+}
+
+}  // namespace dali
@@ -0,0 +1,81 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_BENCHMARK_GENERIC_OP_BENCH_H_
+#define DALI_BENCHMARK_GENERIC_OP_BENCH_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "dali/core/common.h"
+#include "dali/pipeline/data/tensor_list.h"
+#include "dali/pipeline/operator/op_spec.h"
+
+namespace dali {
+
+/**
+ * @brief A positional input of the benchmarked operator; only one of the pointers is set
+ */
+struct OpBenchInput {
+  std::shared_ptr<TensorList<CPUBackend>> cpu;
+  std::shared_ptr<TensorList<GPUBackend>> gpu;
+};
+
+using OpBenchArgInputs = std::map<std::string, std::shared_ptr<TensorList<CPUBackend>>>;
+
+/**
+ * @brief Sets an argument of the OpSpec from its text representation
+ *
+ * The value is interpreted according to the type of the argument in the schema. The elements
+ * of lists are separated with commas, e.g. "0.5,0.5,0.5".
+ */
+DLL_PUBLIC void AddArgFromString(OpSpec &spec, const std::string &name, const std::string &value);
+
+/**
+ * @brief Generates a batch of `batch_size` samples of the given type with random content
+ *
+ * The extents of the samples are drawn from `[(1 - shape_variance) * shape[d], shape[d]]`,
+ * except for the channel dimension (if `layout` has one), which is not varied.
+ */
+DLL_PUBLIC std::shared_ptr<TensorList<CPUBackend>> GenerateBenchInput(
+    DALIDataType type, const TensorShape<> &shape, const TensorLayout &layout, int batch_size,
+    double shape_variance, int seed);
+
+/**
+ * @brief Registers the benchmarks given in the command line and removes the options it
+ *        recognizes from `argv`
+ *
+ * Synthetic inputs - sweeps the batch sizes, the input types and the sample size variance:
+ *
+ * ```
+ * --op_name=Flip --op_device=gpu --op_args="horizontal=1;vertical=0" --op_shape=1080x1920x3
+ * --op_layout=HWC --op_dtypes=uint8,float --op_batch_sizes=1,32,256 --op_shape_variance=0,0.5
+ * --op_num_inputs=1 --op_threads=4
+ * ```
+ *
+ * Replay of a real pipeline - a serialized pipeline (without external sources) is run, the
+ * inputs of all its operators are captured and each operator is benchmarked with them:
+ *
+ * ```
+ * --op_pipeline=pipeline.dali --op_pipeline_warmup=10 [--op_name=Resize]
+ * ```
+ *
+ * The GPU and mixed operators are timed with CUDA events recorded in the operator's stream.
+ */
+DLL_PUBLIC void RegisterGenericOpBenchmarks(int *argc, char **argv);
+
+}  // namespace dali
+
+#endif  // DALI_BENCHMARK_GENERIC_OP_BENCH_H_
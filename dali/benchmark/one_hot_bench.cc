@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <benchmark/benchmark.h>
+#include <vector>
 #include "dali/benchmark/dali_bench.h"
 #include "dali/benchmark/operator_bench.h"
 
@@ -67,4 +68,70 @@ BENCHMARK_REGISTER_F(OperatorBench, OneHotGPU)
     ->UseRealTime()
     ->Apply(OneHotGPUArgs);
 
+// Batches of token ids: {batch_size, num_ids, num_classes}
+static void OneHotGPUTokenIdsArgs(benchmark::internal::Benchmark *b) {
+  for (int batch_size : {1, 8})
+    for (int num_ids : {1 << 12, 1 << 16})
+      for (int num_classes : {10, 100})
+        b->Args({batch_size, num_ids, num_classes});
+}
+
+BENCHMARK_DEFINE_F(OperatorBench, OneHotGPUTokenIds)(benchmark::State &st) {
+  int batch_size = st.range(0);
+  int num_ids = st.range(1);
+  int num_classes = st.range(2);
+
+  this->RunGPU<int32_t>(st,
+                        OpSpec("OneHot")
+                            .AddArg("max_batch_size", batch_size)
+                            .AddArg("num_threads", 1)
+                            .AddArg("device", "gpu")
+                            .AddArg("dtype", DALI_FLOAT)
+                            .AddArg("num_classes", num_classes),
+                        batch_size, TensorShape<>{num_ids}, "X", true);
+}
+
+BENCHMARK_REGISTER_F(OperatorBench, OneHotGPUTokenIds)
+    ->Iterations(1000)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime()
+    ->Apply(OneHotGPUTokenIdsArgs);
+
+// {batch_size, num_ids, table_size} - the smaller tables are cached in the shared memory.
+static void LookupTableGPUArgs(benchmark::internal::Benchmark *b) {
+  for (int batch_size : {1, 16, 64})
+    for (int num_ids : {1 << 16, 1 << 20})
+      for (int table_size : {256, 4096, 65536})
+        b->Args({batch_size, num_ids, table_size});
+}
+
+BENCHMARK_DEFINE_F(OperatorBench, LookupTableGPU)(benchmark::State &st) {
+  int batch_size = st.range(0);
+  int num_ids = st.range(1);
+  int table_size = st.range(2);
+
+  std::vector<int> keys(table_size);
+  std::vector<float> values(table_size);
+  for (int i = 0; i < table_size; i++) {
+    keys[i] = i;
+    values[i] = 0.5f * i;
+  }
+
+  this->RunGPU<int32_t>(st,
+                        OpSpec("LookupTable")
+                            .AddArg("max_batch_size", batch_size)
+                            .AddArg("num_threads", 1)
+                            .AddArg("device", "gpu")
+                            .AddArg("dtype", DALI_FLOAT)
+                            .AddArg("keys", keys)
+                            .AddArg("values", values),
+                        batch_size, TensorShape<>{num_ids}, "X", true);
+}
+
+BENCHMARK_REGISTER_F(OperatorBench, LookupTableGPU)
+    ->Iterations(1000)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime()
+    ->Apply(LookupTableGPUArgs);
+
 }  // namespace dali
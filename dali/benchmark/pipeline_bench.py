@@ -0,0 +1,387 @@
+# Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""End-to-end pipeline benchmarks.
+
+Runs complete pipelines modeled after the typical training workloads - ImageNet classification,
+COCO detection, video action recognition and speech recognition - with the dynamic executor
+and the data cached in memory, so that the results reflect the processing in DALI rather than
+the storage. For each workload, it reports the throughput, the iteration latency (mean, p50,
+p99), the CPU utilization and the peak host, device and pinned memory usage.
+
+The results can be saved as JSON (``--output``) and compared with a previous run
+(``--baseline``) - the script fails if the throughput of any workload dropped by more than
+``--max-regression``.
+
+Example::
+
+    python pipeline_bench.py --workloads imagenet coco --images /data/jpegs --output rel.json
+    python pipeline_bench.py --baseline rel.json
+"""
+
+import argparse
+import concurrent.futures
+import io
+import json
+import multiprocessing
+import os
+import resource
+import sys
+import time
+
+import numpy as np
+
+WORKLOADS = ["imagenet", "coco", "video", "asr"]
+
+DEFAULT_BATCH_SIZE = {"imagenet": 256, "coco": 64, "video": 8, "asr": 64}
+
+_MB = 1024 * 1024
+
+
+def _load_images(images_dir, count, seed):
+    """Returns `count` encoded images - from `images_dir` or synthetic JPEGs."""
+    if images_dir:
+        files = []
+        for root, _, names in os.walk(images_dir):
+            files += [
+                os.path.join(root, n) for n in names if n.lower().endswith((".jpg", ".jpeg"))
+            ]
+        if not files:
+            raise ValueError(f"No JPEG files found in {images_dir}")
+        files = sorted(files)[:count]
+        return [np.fromfile(f, dtype=np.uint8) for f in files]
+
+    from PIL import Image
+
+    rng = np.random.default_rng(seed)
+    images = []
+    for _ in range(min(count, 64)):
+        h, w = rng.integers(300, 600, size=2)
+        # smooth content compresses like natural images, unlike white noise
+        base = rng.integers(0, 256, size=(h // 16 + 1, w // 16 + 1, 3), dtype=np.uint8)
+        img = Image.fromarray(base).resize((int(w), int(h)), Image.BILINEAR)
+        buf = io.BytesIO()
+        img.save(buf, format="JPEG", quality=90)
+        images.append(np.frombuffer(buf.getvalue(), dtype=np.uint8))
+    return images
+
+
+def _batches(samples, batch_size):
+    """Groups cached samples into batches, cycling over the samples."""
+    num_batches = max(1, len(samples) // batch_size)
+    return [
+        [samples[(b * batch_size + i) % len(samples)] for i in range(batch_size)]
+        for b in range(num_batches)
+    ]
+
+
+def imagenet_pipeline(args, batch_size):
+    from nvidia.dali import fn, pipeline_def, types
+
+    images = _load_images(args.images, 1024, args.seed)
+
+    @pipeline_def(
+        batch_size=batch_size,
+        num_threads=args.num_threads,
+        device_id=args.device_id,
+        exec_dynamic=True,
+        prefetch_queue_depth=args.prefetch_queue_depth,
+        seed=args.seed,
+    )
+    def pipe():
+        jpegs = fn.external_source(source=_batches(images, batch_size), cycle=True)
+        images_gpu = fn.decoders.image_random_crop(jpegs, device="mixed", output_type=types.RGB)
+        images_gpu = fn.resize(images_gpu, resize_x=224, resize_y=224)
+        return fn.crop_mirror_normalize(
+            images_gpu,
+            dtype=types.FLOAT,
+            output_layout="CHW",
+            mean=[0.485 * 255, 0.456 * 255, 0.406 * 255],
+            std=[0.229 * 255, 0.224 * 255, 0.225 * 255],
+            mirror=fn.random.coin_flip(),
+        )
+
+    return pipe()
+
+
+def coco_pipeline(args, batch_size):
+    from nvidia.dali import fn, pipeline_def, types
+
+    images = _load_images(args.images, 1024, args.seed)
+    rng = np.random.default_rng(args.seed)
+    boxes, labels = [], []
+    for _ in range(len(images)):
+        n = int(rng.integers(1, 20))
+        lt = rng.uniform(0, 0.8, size=(n, 2))
+        wh = rng.uniform(0.05, 0.2, size=(n, 2))
+        boxes.append(np.concatenate([lt, np.minimum(lt + wh, 1)], axis=1).astype(np.float32))
+        labels.append(rng.integers(1, 81, size=(n,), dtype=np.int32))
+
+    @pipeline_def(
+        batch_size=batch_size,
+        num_threads=args.num_threads,
+        device_id=args.device_id,
+        exec_dynamic=True,
+        prefetch_queue_depth=args.prefetch_queue_depth,
+        seed=args.seed,
+    )
+    def pipe():
+        jpegs, bboxes, classes = fn.external_source(
+            source=list(
+                zip(*(_batches(x, batch_size) for x in (images, boxes, labels)))
+            ),
+            num_outputs=3,
+            cycle=True,
+        )
+        crop_begin, crop_size, bboxes, classes = fn.random_bbox_crop(
+            bboxes,
+            classes,
+            aspect_ratio=[0.5, 2.0],
+            thresholds=[0, 0.1, 0.3, 0.5, 0.7, 0.9],
+            scaling=[0.3, 1.0],
+            bbox_layout="xyXY",
+            allow_no_crop=True,
+            num_attempts=50,
+        )
+        images_gpu = fn.decoders.image_slice(
+            jpegs, crop_begin, crop_size, device="mixed", output_type=types.RGB
+        )
+        flip = fn.random.coin_flip()
+        bboxes = fn.bb_flip(bboxes, ltrb=True, horizontal=flip)
+        images_gpu = fn.resize(images_gpu, resize_x=300, resize_y=300)
+        images_gpu = fn.crop_mirror_normalize(
+            images_gpu,
+            dtype=types.FLOAT,
+            output_layout="CHW",
+            mean=[0.485 * 255, 0.456 * 255, 0.406 * 255],
+            std=[0.229 * 255, 0.224 * 255, 0.225 * 255],
+            mirror=flip,
+        )
+        return images_gpu, bboxes.gpu(), classes.gpu()
+
+    return pipe()
+
+
+def video_pipeline(args, batch_size):
+    from nvidia.dali import fn, pipeline_def, types
+
+    # Decoded frames - the video decoding depends on the hardware decoder and the input files
+    rng = np.random.default_rng(args.seed)
+    clips = [
+        rng.integers(0, 256, size=(16, 256, 340, 3), dtype=np.uint8)
+        for _ in range(min(2 * batch_size, 32))
+    ]
+
+    @pipeline_def(
+        batch_size=batch_size,
+        num_threads=args.num_threads,
+        device_id=args.device_id,
+        exec_dynamic=True,
+        prefetch_queue_depth=args.prefetch_queue_depth,
+        seed=args.seed,
+    )
+    def pipe():
+        frames = fn.external_source(
+            source=_batches(clips, batch_size), cycle=True, layout="FHWC"
+        )
+        frames = fn.resize(frames.gpu(), resize_shorter=fn.random.uniform(range=[256, 320]))
+        return fn.crop_mirror_normalize(
+            frames,
+            dtype=types.FLOAT,
+            output_layout="CFHW",
+            crop=(224, 224),
+            crop_pos_x=fn.random.uniform(range=[0, 1]),
+            crop_pos_y=fn.random.uniform(range=[0, 1]),
+            mean=[0.43 * 255, 0.4 * 255, 0.37 * 255],
+            std=[0.23 * 255, 0.22 * 255, 0.22 * 255],
+            mirror=fn.random.coin_flip(),
+        )
+
+    return pipe()
+
+
+def asr_pipeline(args, batch_size):
+    from nvidia.dali import fn, pipeline_def
+
+    sample_rate = 16000
+    rng = np.random.default_rng(args.seed)
+    audio = [
+        rng.normal(0, 0.1, size=(int(rng.uniform(2, 16) * sample_rate),)).astype(np.float32)
+        for _ in range(256)
+    ]
+
+    @pipeline_def(
+        batch_size=batch_size,
+        num_threads=args.num_threads,
+        device_id=args.device_id,
+        exec_dynamic=True,
+        prefetch_queue_depth=args.prefetch_queue_depth,
+        seed=args.seed,
+    )
+    def pipe():
+        samples = fn.external_source(source=_batches(audio, batch_size), cycle=True)
+        samples = fn.preemphasis_filter(samples.gpu(), preemph_coeff=0.97)
+        spec = fn.spectrogram(
+            samples, nfft=512, window_length=400, window_step=160, center_windows=True
+        )
+        mel = fn.mel_filter_bank(spec, sample_rate=sample_rate, nfilter=80)
+        mel = fn.to_decibels(mel, multiplier=10, reference=1.0, cutoff_db=-80)
+        mel = fn.normalize(mel, axes=[1])
+        return fn.pad(mel, axes=[1], align=16)
+
+    return pipe()
+
+
+_PIPELINES = {
+    "imagenet": imagenet_pipeline,
+    "coco": coco_pipeline,
+    "video": video_pipeline,
+    "asr": asr_pipeline,
+}
+
+
+def _percentile(values, q):
+    return float(np.percentile(values, q)) if values else 0.0
+
+
+def run_workload(name, args):
+    """Builds and runs the pipeline of the workload, returns the measurements as a dict."""
+    from nvidia.dali import backend
+
+    batch_size = args.batch_size or DEFAULT_BATCH_SIZE[name]
+    pipe = _PIPELINES[name](args, batch_size)
+    pipe.build()
+
+    for _ in range(args.warmup):
+        pipe.run()
+
+    latencies = []
+    cpu_start = os.times()
+    start = time.perf_counter()
+    for _ in range(args.iters):
+        t = time.perf_counter()
+        pipe.run()
+        latencies.append(time.perf_counter() - t)
+    wall = time.perf_counter() - start
+    cpu_end = os.times()
+
+    cpu_time = (cpu_end.user - cpu_start.user) + (cpu_end.system - cpu_start.system)
+    device_stats = backend.GetDevicePoolStats(args.device_id)
+    pinned_stats = backend.GetPinnedPoolStats(args.device_id)
+    latencies_ms = [t * 1000 for t in latencies]
+    return {
+        "name": name,
+        "batch_size": batch_size,
+        "iterations": args.iters,
+        "num_threads": args.num_threads,
+        "throughput": batch_size * args.iters / wall,
+        "latency_ms": {
+            "mean": float(np.mean(latencies_ms)),
+            "p50": _percentile(latencies_ms, 50),
+            "p99": _percentile(latencies_ms, 99),
+        },
+        # 100% means all CPU cores of the machine saturated
+        "cpu_utilization": 100 * cpu_time / (wall * os.cpu_count()),
+        "cpu_time_per_iteration_ms": 1000 * cpu_time / args.iters,
+        "peak_host_memory_mb": resource.getrusage(resource.RUSAGE_SELF).ru_maxrss * 1024 / _MB,
+        "peak_device_memory_mb": device_stats["peak_allocated"] / _MB,
+        "peak_pinned_memory_mb": pinned_stats["peak_allocated"] / _MB,
+    }
+
+
+def run_isolated(name, args):
+    """Runs the workload in a separate process, so that the peak memory is not shared."""
+    ctx = multiprocessing.get_context("spawn")
+    with concurrent.futures.ProcessPoolExecutor(max_workers=1, mp_context=ctx) as executor:
+        return executor.submit(run_workload, name, args).result()
+
+
+def compare(results, baseline, max_regression):
+    """Prints the throughput relative to the baseline; returns the names of regressed workloads."""
+    reference = {b["name"]: b for b in baseline["benchmarks"]}
+    regressed = []
+    for r in results:
+        ref = reference.get(r["name"])
+        if ref is None or ref["batch_size"] != r["batch_size"]:
+            print(f"{r['name']}: no matching baseline")
+            continue
+        change = r["throughput"] / ref["throughput"] - 1
+        status = "REGRESSION" if change < -max_regression else "ok"
+        print(
+            f"{r['name']}: {r['throughput']:.1f} vs {ref['throughput']:.1f} samples/s "
+            f"({change * 100:+.1f}%) {status}"
+        )
+        if status != "ok":
+            regressed.append(r["name"])
+    return regressed
+
+
+def main():
+    parser = argparse.ArgumentParser(description="End-to-end DALI pipeline benchmarks")
+    parser.add_argument("--workloads", nargs="+", choices=WORKLOADS, default=WORKLOADS)
+    parser.add_argument(
+        "--batch-size", type=int, default=None, help="Batch size; by default, per-workload"
+    )
+    parser.add_argument("--num-threads", type=int, default=4)
+    parser.add_argument("--device-id", type=int, default=0)
+    parser.add_argument("--prefetch-queue-depth", type=int, default=2)
+    parser.add_argument("--iters", type=int, default=100)
+    parser.add_argument("--warmup", type=int, default=10)
+    parser.add_argument("--seed", type=int, default=42)
+    parser.add_argument(
+        "--images", default=None, help="Directory with JPEG images; synthetic images by default"
+    )
+    parser.add_argument("--output", default=None, help="The path of the JSON with the results")
+    parser.add_argument("--baseline", default=None, help="The JSON with the results to compare")
+    parser.add_argument(
+        "--max-regression",
+        type=float,
+        default=0.05,
+        help="The largest accepted relative drop of throughput with respect to the baseline",
+    )
+    args = parser.parse_args()
+
+    import nvidia.dali as dali
+
+    results = []
+    for name in args.workloads:
+        r = run_isolated(name, args)
+        print(
+            f"{name}: {r['throughput']:.1f} samples/s, latency p50 {r['latency_ms']['p50']:.2f} "
+            f"ms, p99 {r['latency_ms']['p99']:.2f} ms, CPU {r['cpu_utilization']:.1f}%, "
+            f"peak memory: host {r['peak_host_memory_mb']:.0f} MB, "
+            f"device {r['peak_device_memory_mb']:.0f} MB, "
+            f"pinned {r['peak_pinned_memory_mb']:.0f} MB"
+        )
+        results.append(r)
+
+    report = {
+        "dali_version": dali.__version__,
+        "timestamp": time.strftime("%Y-%m-%dT%H:%M:%S%z"),
+        "cpu_count": os.cpu_count(),
+        "benchmarks": results,
+    }
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(report, f, indent=2)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        if compare(results, baseline, args.max_regression):
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,261 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dali/core/exec/tasking.h"
+#include "dali/pipeline/util/thread_pool.h"
+
+namespace dali {
+
+// Scalability benchmarks of ThreadPool and tasking::Executor:
+// - Submit     - throughput of many tiny tasks, submitted from one thread,
+// - Contention - the latency between the submission and the start of a task, when the tasks
+//                are submitted from multiple threads at once,
+// - FanOut     - (tasking only) layers of independent tasks separated by a join task.
+// The first argument of each benchmark is the number of worker threads.
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+constexpr int kNumTasks = 4096;
+
+/**
+ * @brief Busy-waits for the given number of nanoseconds - the payload of a task
+ */
+inline void Spin(int64_t ns) {
+  if (ns <= 0)
+    return;
+  auto end = bench_clock::now() + std::chrono::nanoseconds(ns);
+  while (bench_clock::now() < end) {}
+}
+
+/**
+ * @brief Collects the queuing latency of the tasks and reports its mean and the 99th percentile
+ */
+class LatencyStats {
+ public:
+  explicit LatencyStats(int num_tasks) : submitted_(num_tasks), started_(num_tasks) {}
+
+  void Submitted(int i) { submitted_[i] = bench_clock::now(); }
+  void Started(int i) { started_[i] = bench_clock::now(); }
+
+  void Accumulate() {
+    for (size_t i = 0; i < started_.size(); i++)
+      latencies_us_.push_back(
+          std::chrono::duration<double, std::micro>(started_[i] - submitted_[i]).count());
+  }
+
+  void Report(benchmark::State &st) {
+    if (latencies_us_.empty())
+      return;
+    double sum = 0;
+    for (double l : latencies_us_)
+      sum += l;
+    size_t p99 = latencies_us_.size() * 99 / 100;
+    std::nth_element(latencies_us_.begin(), latencies_us_.begin() + p99, latencies_us_.end());
+    st.counters["latency_mean_us"] = sum / latencies_us_.size();
+    st.counters["latency_p99_us"] = latencies_us_[p99];
+  }
+
+ private:
+  std::vector<bench_clock::time_point> submitted_, started_;
+  std::vector<double> latencies_us_;
+};
+
+void SetTaskRate(benchmark::State &st, int64_t tasks_per_iteration) {
+  st.counters["tasks/s"] = benchmark::Counter(st.iterations() * tasks_per_iteration,
+                                              benchmark::Counter::kIsRate);
+}
+
+/**
+ * @brief Submits the tasks from `num_producers` threads at once; `submit(i)` submits i-th task
+ */
+template <typename Submit>
+void SubmitConcurrently(int num_producers, int num_tasks, Submit &&submit) {
+  std::vector<std::thread> producers;
+  std::atomic_bool go{false};
+  for (int p = 0; p < num_producers; p++) {
+    producers.emplace_back([&, p]() {
+      while (!go) {}
+      for (int i = p; i < num_tasks; i += num_producers)
+        submit(i);
+    });
+  }
+  go = true;
+  for (auto &t : producers)
+    t.join();
+}
+
+void ThreadArgs(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"threads", "task_ns"});
+  for (int threads : {4, 8, 16, 32, 64, 128})
+    for (int task_ns : {0, 1000})
+      b->Args({threads, task_ns});
+}
+
+void ContentionArgs(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"threads", "producers"});
+  for (int threads : {4, 16, 64, 128})
+    for (int producers : {1, 4, 16})
+      b->Args({threads, producers});
+}
+
+void FanOutArgs(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"threads", "width"});
+  for (int threads : {4, 16, 64, 128})
+    for (int width : {16, 256, 4096})
+      b->Args({threads, width});
+}
+
+}  // namespace
+
+static void BM_ThreadPoolSubmit(benchmark::State &st) {
+  int nthreads = st.range(0);
+  int64_t task_ns = st.range(1);
+  ThreadPool tp(nthreads, CPU_ONLY_DEVICE_ID, false, "SchedulerBench");
+  for (auto _ : st) {
+    for (int i = 0; i < kNumTasks; i++)
+      tp.AddWork([task_ns](int) { Spin(task_ns); });
+    tp.RunAll();
+  }
+  SetTaskRate(st, kNumTasks);
+}
+
+static void BM_ThreadPoolSubmitBatch(benchmark::State &st) {
+  int nthreads = st.range(0);
+  int64_t task_ns = st.range(1);
+  ThreadPool tp(nthreads, CPU_ONLY_DEVICE_ID, false, "SchedulerBench");
+  std::vector<ThreadPool::PrioritizedWork> work;
+  for (auto _ : st) {
+    work.clear();
+    for (int i = 0; i < kNumTasks; i++)
+      work.emplace_back(0, [task_ns](int) { Spin(task_ns); });
+    tp.AddWorkBatch(make_span(work));
+    tp.RunAll();
+  }
+  SetTaskRate(st, kNumTasks);
+}
+
+static void BM_ThreadPoolContention(benchmark::State &st) {
+  int nthreads = st.range(0);
+  int nproducers = st.range(1);
+  ThreadPool tp(nthreads, CPU_ONLY_DEVICE_ID, false, "SchedulerBench");
+  LatencyStats stats(kNumTasks);
+  for (auto _ : st) {
+    SubmitConcurrently(nproducers, kNumTasks, [&](int i) {
+      stats.Submitted(i);
+      tp.AddWork([&stats, i](int) { stats.Started(i); }, 0, true);
+    });
+    tp.WaitForWork();
+    stats.Accumulate();
+  }
+  stats.Report(st);
+  SetTaskRate(st, kNumTasks);
+}
+
+static void BM_TaskingSubmit(benchmark::State &st) {
+  int nthreads = st.range(0);
+  int64_t task_ns = st.range(1);
+  tasking::Executor ex(nthreads);
+  ex.Start();
+  for (auto _ : st) {
+    // A join task with kNumTasks preconditions would measure the dependency tracking;
+    // the completion is detected with a counter instead.
+    std::atomic_int remaining{kNumTasks};
+    auto done = std::make_shared<std::promise<void>>();
+    auto finished = done->get_future();
+    for (int i = 0; i < kNumTasks; i++) {
+      ex.AddSilentTask(tasking::Task::Create([&remaining, done, task_ns]() {
+        Spin(task_ns);
+        if (--remaining == 0)
+          done->set_value();
+      }));
+    }
+    finished.wait();
+  }
+  SetTaskRate(st, kNumTasks);
+}
+
+static void BM_TaskingContention(benchmark::State &st) {
+  int nthreads = st.range(0);
+  int nproducers = st.range(1);
+  tasking::Executor ex(nthreads);
+  ex.Start();
+  LatencyStats stats(kNumTasks);
+  for (auto _ : st) {
+    std::atomic_int remaining{kNumTasks};
+    auto done = std::make_shared<std::promise<void>>();
+    auto finished = done->get_future();
+    SubmitConcurrently(nproducers, kNumTasks, [&](int i) {
+      stats.Submitted(i);
+      ex.AddSilentTask(tasking::Task::Create([&stats, &remaining, done, i]() {
+        stats.Started(i);
+        if (--remaining == 0)
+          done->set_value();
+      }));
+    });
+    finished.wait();
+    stats.Accumulate();
+  }
+  stats.Report(st);
+  SetTaskRate(st, kNumTasks);
+}
+
+static void BM_TaskingFanOut(benchmark::State &st) {
+  int nthreads = st.range(0);
+  int width = st.range(1);
+  const int layers = std::max(1, kNumTasks / width);
+  tasking::Executor ex(nthreads);
+  ex.Start();
+  for (auto _ : st) {
+    // the whole graph is built and submitted up front, only the first layer is ready
+    tasking::SharedTask join;
+    for (int l = 0; l < layers; l++) {
+      auto next_join = tasking::Task::Create([]() {});
+      for (int i = 0; i < width; i++) {
+        auto task = tasking::Task::Create([]() {});
+        if (join)
+          task->Succeed(join);
+        next_join->Succeed(task);
+        ex.AddSilentTask(std::move(task));
+      }
+      ex.AddSilentTask(next_join);
+      join = std::move(next_join);
+    }
+    ex.Wait(join);
+  }
+  SetTaskRate(st, static_cast<int64_t>(layers) * (width + 1));
+}
+
+BENCHMARK(BM_ThreadPoolSubmit)->Apply(ThreadArgs)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(BM_ThreadPoolSubmitBatch)->Apply(ThreadArgs)
+    ->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(BM_ThreadPoolContention)->Apply(ContentionArgs)
+    ->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(BM_TaskingSubmit)->Apply(ThreadArgs)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(BM_TaskingContention)->Apply(ContentionArgs)
+    ->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(BM_TaskingFanOut)->Apply(FanOutArgs)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+}  // namespace dali
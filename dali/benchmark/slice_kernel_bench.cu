@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -23,15 +23,13 @@
 namespace dali {
 
 constexpr int Dims = 3;
-using InputType = float;
-using OutputType = float;
 
 class SliceBenchGPU : public DALIBenchmark {
  public:
-  kernels::TestTensorList<InputType, Dims> test_data;
-  kernels::TestTensorList<OutputType, Dims> out_data;
-
-  void Setup(const TensorShape<Dims> &in_shape,
+  template <typename InputType, typename OutputType>
+  void Setup(kernels::TestTensorList<InputType, Dims> &test_data,
+             kernels::TestTensorList<OutputType, Dims> &out_data,
+             const TensorShape<Dims> &in_shape,
              const TensorShape<Dims> &out_shape,
              int batch_size = 1) {
     test_data.reshape(uniform_list_shape<Dims>(batch_size, in_shape));
@@ -41,6 +39,7 @@ class SliceBenchGPU : public DALIBenchmark {
     out_data.reshape(uniform_list_shape<Dims>(batch_size, out_shape));
   }
 
+  template <typename InputType = float, typename OutputType = float>
   void RunGPU(benchmark::State& st) {
     int H = st.range(0);
     int W = st.range(1);
@@ -56,7 +55,9 @@ class SliceBenchGPU : public DALIBenchmark {
     TensorShape<Dims> in_shape{H, W, C};
     TensorShape<Dims> anchor{anchor_h, anchor_w, anchor_c};
     TensorShape<Dims> out_shape{crop_h, crop_w, crop_c};
-    Setup(in_shape, out_shape, batch_size);
+    kernels::TestTensorList<InputType, Dims> test_data;
+    kernels::TestTensorList<OutputType, Dims> out_data;
+    Setup(test_data, out_data, in_shape, out_shape, batch_size);
 
     using Kernel = kernels::SliceGPU<OutputType, InputType, Dims>;
     Kernel kernel;
@@ -150,5 +151,30 @@ BENCHMARK_REGISTER_F(SliceBenchGPU, Slice_GPU_SliceAndPad)->Iterations(1000)
 ->UseRealTime()
 ->Apply(SliceKernelArgs_GPU_SliceAndPad);
 
+static void SliceKernelArgs_GPU_OnlySlice_U8(benchmark::internal::Benchmark *b) {
+  for (int H = 1024; H >= 512; H /= 2) {
+    int W = H, C = 3;
+    int crop_h = 7 * H / 8;
+    int crop_w = 7 * W / 8;
+    int anchor_h = H / 16;
+    int anchor_w = W / 16;
+    // the rows of the crop are 16-byte aligned - the slice is copied with 16-byte vectors
+    b->Args({H, W, C, anchor_h, anchor_w, 0, crop_h, crop_w, C, 1});
+    b->Args({H, W, C, anchor_h, anchor_w, 0, crop_h, crop_w, C, 10});
+    // the rows of the crop are only 1-byte aligned - the slice is copied element by element
+    b->Args({H, W, C, anchor_h + 1, anchor_w + 1, 0, crop_h - 1, crop_w - 1, C, 1});
+    b->Args({H, W, C, anchor_h + 1, anchor_w + 1, 0, crop_h - 1, crop_w - 1, C, 10});
+  }
+}
+
+BENCHMARK_DEFINE_F(SliceBenchGPU, Slice_GPU_OnlySlice_U8)(benchmark::State& st) {
+  this->RunGPU<uint8_t, uint8_t>(st);
+}
+
+BENCHMARK_REGISTER_F(SliceBenchGPU, Slice_GPU_OnlySlice_U8)->Iterations(1000)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(SliceKernelArgs_GPU_OnlySlice_U8);
+
 
 }  // namespace dali
@@ -0,0 +1,162 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <stdlib.h>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/pipeline/pipeline.h"
+#include "dali/test/dali_test_config.h"
+#include "dali/util/throttled_file.h"
+
+namespace dali {
+
+// Benchmarks of the readers with the storage simulated by ThrottledFileStream.
+// The arguments are: the read latency (us), the reader's prefetch_queue_depth and the number
+// of threads of the pipeline. Each file open costs additionally 4x the read latency.
+
+namespace {
+
+constexpr int kBatchSize = 32;
+constexpr int kNumNumpyFiles = 256;
+
+/**
+ * @brief Writes a set of .npy files to a temporary directory, which is removed at exit
+ */
+const std::string &NumpyDataDir() {
+  struct NumpyDir {
+    std::string path = "/tmp/dali_storage_bench_XXXXXX";
+    NumpyDir() {
+      DALI_ENFORCE(mkdtemp(&path[0]) != nullptr, "Could not create a temporary directory.");
+      // version 1.0 header padded with spaces to 128 bytes
+      std::string header = "{'descr': '<f4', 'fortran_order': False, 'shape': (256, 256), }";
+      header.resize(128 - 10 - 1, ' ');
+      header += '\n';
+      std::vector<float> data(256 * 256, 1.0f);
+      for (int i = 0; i < kNumNumpyFiles; i++) {
+        std::ofstream f(make_string(path, "/", i, ".npy"), std::ios::binary);
+        f.write("\x93NUMPY\x01\x00", 8);
+        char len[2] = {static_cast<char>(header.size()), 0};
+        f.write(len, 2);
+        f.write(header.data(), header.size());
+        f.write(reinterpret_cast<const char *>(data.data()), data.size() * sizeof(float));
+      }
+    }
+    ~NumpyDir() {
+      for (int i = 0; i < kNumNumpyFiles; i++)
+        std::remove(make_string(path, "/", i, ".npy").c_str());
+      std::remove(path.c_str());
+    }
+  };
+  static NumpyDir dir;
+  return dir.path;
+}
+
+OpSpec ReaderSpec(const std::string &reader) {
+  const std::string db = testing::dali_extra_path() + "/db";
+  if (reader == "File") {
+    return OpSpec("readers__File")
+        .AddArg("file_root", db + "/single/jpeg")
+        .AddOutput("data", "cpu")
+        .AddOutput("labels", "cpu");
+  } else if (reader == "MXNet") {
+    return OpSpec("readers__MXNet")
+        .AddArg("path", std::vector<std::string>{db + "/recordio/train.rec"})
+        .AddArg("index_path", std::vector<std::string>{db + "/recordio/train.idx"})
+        .AddOutput("data", "cpu")
+        .AddOutput("labels", "cpu");
+  } else if (reader == "Webdataset") {
+    return OpSpec("readers__Webdataset")
+        .AddArg("paths", std::vector<std::string>{db + "/webdataset/MNIST/devel-0.tar"})
+        .AddArg("ext", std::vector<std::string>{"jpg", "cls"})
+        .AddOutput("data", "cpu")
+        .AddOutput("labels", "cpu");
+  } else {
+    DALI_ENFORCE(reader == "Numpy", make_string("Unknown reader: ", reader));
+    return OpSpec("readers__Numpy")
+        .AddArg("file_root", NumpyDataDir())
+        .AddArg("file_filter", "*.npy")
+        .AddOutput("data", "cpu");
+  }
+}
+
+void RunReaderBenchmark(benchmark::State &st, const std::string &reader) {
+  int64_t read_latency_us = st.range(0);
+  int prefetch_queue_depth = st.range(1);
+  int num_threads = st.range(2);
+
+  auto prev_sim = GetStorageSimulation();
+  StorageSimulation sim;
+  sim.read_latency_us = read_latency_us;
+  sim.open_latency_us = 4 * read_latency_us;
+  sim.latency_jitter_us = read_latency_us / 4;
+  SetStorageSimulation(sim);
+
+  Pipeline pipe(kBatchSize, num_threads, CPU_ONLY_DEVICE_ID, 0);
+  pipe.AddOperator(ReaderSpec(reader)
+                       .AddArg("device", "cpu")
+                       .AddArg("prefetch_queue_depth", prefetch_queue_depth));
+  pipe.Build({{"data", "cpu"}});
+
+  Workspace ws;
+  // fill the prefetch queue, so that the measurement includes the steady state only
+  pipe.Run();
+  pipe.Outputs(&ws);
+
+  int64_t bytes = 0;
+  for (auto _ : st) {
+    pipe.Run();
+    pipe.Outputs(&ws);
+    bytes += ws.Output<CPUBackend>(0).nbytes();
+  }
+  SetStorageSimulation(prev_sim);
+
+  st.counters["samples/s"] = benchmark::Counter(st.iterations() * kBatchSize,
+                                                benchmark::Counter::kIsRate);
+  st.SetBytesProcessed(bytes);
+}
+
+void StorageArgs(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"latency_us", "prefetch", "threads"});
+  for (int64_t latency : {0, 100, 1000, 10000}) {
+    for (int prefetch : {1, 2, 4}) {
+      for (int threads : {1, 4}) {
+        b->Args({latency, prefetch, threads});
+      }
+    }
+  }
+}
+
+}  // namespace
+
+#define STORAGE_BENCHMARK(reader)                                 \
+  static void BM_StorageReader##reader(benchmark::State &st) {    \
+    RunReaderBenchmark(st, #reader);                              \
+  }                                                               \
+  BENCHMARK(BM_StorageReader##reader)->Apply(StorageArgs)         \
+      ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+STORAGE_BENCHMARK(File)
+STORAGE_BENCHMARK(MXNet)
+STORAGE_BENCHMARK(Webdataset)
+STORAGE_BENCHMARK(Numpy)
+
+}  // namespace dali
@@ -24,6 +24,7 @@ static std::vector<int> permutations3[] = {
   {0, 1, 2},
   {2, 0, 1},
   {2, 1, 0},
+  {1, 0, 2},  // the innermost dimension is not permuted - moved in (up to 16-byte) vectors
 };
 
 static void TransposeGPUArgs(benchmark::internal::Benchmark *b) {
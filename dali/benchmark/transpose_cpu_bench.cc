@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2021, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,9 +13,11 @@
 // limitations under the License.
 
 #include <benchmark/benchmark.h>
+#include <memory>
 #include <numeric>
 #include "dali/kernels/transpose/transpose.h"
 #include "dali/core/mm/memory.h"
+#include "dali/pipeline/util/thread_pool.h"
 
 namespace dali {
 
@@ -168,4 +170,84 @@ BENCHMARK_REGISTER_F(TransposeFixture, CompactUint16Test)->Apply(CustomArguments
 BENCHMARK_REGISTER_F(TransposeFixture, CompactIntTest)->Apply(CustomArguments);
 BENCHMARK_REGISTER_F(TransposeFixture, CompactDoubleTest)->Apply(CustomArguments);
 
+// Large single tensors (e.g. volumes in a batch of 1), split between the threads
+static CaseData volume_cases[] = {
+    CaseData{{256, 256, 256}, {2, 1, 0}},
+    CaseData{{256, 256, 256}, {0, 2, 1}},
+    CaseData{{256, 256, 256}, {1, 0, 2}},
+    CaseData{{64, 256, 256, 4}, {3, 0, 1, 2}},  // DHWC -> CDHW
+    CaseData{{4, 64, 256, 256}, {1, 2, 3, 0}},  // CDHW -> DHWC
+};
+
+static void VolumeArguments(benchmark::internal::Benchmark* b) {
+  for (unsigned int i = 0; i < sizeof(volume_cases) / sizeof(*volume_cases); i++) {
+    for (int num_threads = 1; num_threads <= 8; num_threads *= 2) {
+      b->Args({i, num_threads});
+    }
+  }
+}
+
+template <typename T>
+class TransposeVolumeFixture : public benchmark::Fixture {
+ public:
+  void SetUp(benchmark::State& st) override {
+    std::tie(src_shape_, perm_) = volume_cases[st.range(0)];
+    num_threads_ = st.range(1);
+    auto total_size = volume(src_shape_);
+    dst_mem_.resize(total_size);
+    src_mem_.resize(total_size);
+    for (int64_t i = 0; i < total_size; i++) {
+      src_mem_[i] = i;
+    }
+    thread_pool_ = std::make_unique<ThreadPool>(num_threads_, CPU_ONLY_DEVICE_ID, false,
+                                                "TransposeBench");
+  }
+
+  void TearDown(benchmark::State& st) override {
+    thread_pool_.reset();
+    dst_mem_.clear();
+    dst_mem_.shrink_to_fit();
+    src_mem_.clear();
+    src_mem_.shrink_to_fit();
+  }
+
+  void Run(benchmark::State& st) {
+    kernels::TiledTranspose<T> transpose(dst_mem_.data(), src_mem_.data(), src_shape_,
+                                         make_cspan(perm_));
+    int64_t num_blocks = transpose.NumBlocks();
+    for (auto _ : st) {
+      for (int t = 0; t < num_threads_; t++) {
+        int64_t begin = num_blocks * t / num_threads_;
+        int64_t end = num_blocks * (t + 1) / num_threads_;
+        thread_pool_->AddWork([&, begin, end](int) { transpose.Run(begin, end); });
+      }
+      thread_pool_->RunAll();
+      benchmark::DoNotOptimize(dst_mem_.data());
+      benchmark::ClobberMemory();
+    }
+    st.SetBytesProcessed(st.iterations() * 2 * volume(src_shape_) * sizeof(T));
+  }
+
+  std::vector<int> perm_;
+  TensorShape<> src_shape_;
+  std::vector<T> dst_mem_, src_mem_;
+  int num_threads_ = 1;
+  std::unique_ptr<ThreadPool> thread_pool_;
+};
+
+BENCHMARK_TEMPLATE_DEFINE_F(TransposeVolumeFixture, VolumeUint8Test, uint8_t)(
+    benchmark::State& st) {
+  Run(st);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(TransposeVolumeFixture, VolumeFloatTest, float)(
+    benchmark::State& st) {
+  Run(st);
+}
+
+BENCHMARK_REGISTER_F(TransposeVolumeFixture, VolumeUint8Test)->Apply(VolumeArguments)
+    ->UseRealTime();
+BENCHMARK_REGISTER_F(TransposeVolumeFixture, VolumeFloatTest)->Apply(VolumeArguments)
+    ->UseRealTime();
+
 }  // namespace dali
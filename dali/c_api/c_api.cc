@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,14 +15,21 @@
 #include "dali/c_api.h"  // NOLINT [build/include]
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <map>
 
 #include "dali/core/common.h"
+#include "dali/core/cuda_event_pool.h"
 #include "dali/core/cuda_stream_pool.h"
 #include "dali/core/format.h"
+#include "dali/core/metrics.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/core/mm/default_resources.h"
 #include "dali/pipeline/init.h"
@@ -75,6 +82,46 @@ struct DALIPipeline {
  */
 typedef daliPipelineHandle *daliPipelineHandle_t;
 
+/**
+ * @brief Gathers the requests fed from multiple threads into batches and runs the pipeline
+ *
+ * The worker thread is the only one touching the pipeline.
+ */
+struct DALIBatchingServer {
+  struct Request {
+    int64_t id;
+    device_type_t device = CPU;
+    dali_data_type_t type;
+    dali::TensorShape<> shape;
+    std::shared_ptr<void> data;  // a copy made by the server or a wrapped external buffer
+    bool zero_copy = false;
+    dali::CUDAEvent ready;  // recorded in the producer's stream (GPU requests)
+    std::chrono::steady_clock::time_point enqueued;
+
+    bool BatchesWith(const Request &other) const {
+      return device == other.device && zero_copy == other.zero_copy && type == other.type &&
+             shape.sample_dim() == other.shape.sample_dim();
+    }
+  };
+
+  daliPipelineHandle_t pipe_handle = nullptr;
+  std::string input_name;
+  int max_batch_size = 1;
+  std::chrono::microseconds max_delay{0};
+  daliBatchingServerCallback callback = nullptr;
+  void *user_data = nullptr;
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::deque<Request> queue;
+  bool stop = false;
+  std::thread worker;
+
+  void Enqueue(Request &&r);
+  void Run();
+  void RunBatch(std::vector<Request> &batch);
+};
+
 namespace {
 
 int PopCurrBatchSize(batch_size_map_t *batch_size_map, int max_batch_size,
@@ -106,10 +153,30 @@ dali::InputOperatorNoCopyMode GetExternalSourceCopyMode(unsigned int flags) {
   return no_copy_mode;
 }
 
+/**
+ * @param release If not null, the data is owned by the caller and `release` is invoked once DALI
+ *                no longer uses it; the data is not copied, unless DALI_ext_force_copy is set.
+ */
 template <typename Backend>
 void SetExternalInput(daliPipelineHandle_t pipe_handle, const char *name, const void *data_ptr,
                       dali_data_type_t data_type, const int64_t *shapes, int sample_dim,
-                      const char *layout_str, cudaStream_t stream = 0, unsigned int flags = 0) {
+                      const char *layout_str, cudaStream_t stream = 0, unsigned int flags = 0,
+                      daliExternalInputReleaseCallback release = nullptr,
+                      void *user_data = nullptr) {
+  // Take the ownership first, so that the data is released if anything below throws
+  std::shared_ptr<void> owner;
+  if (release) {
+    AccessOrder release_order = std::is_same_v<Backend, GPUBackend> || (flags & DALI_ext_pinned)
+                              ? AccessOrder(stream)
+                              : AccessOrder::host();
+    owner = dali::WrapExternalBuffer(const_cast<void *>(data_ptr), release, user_data,
+                                     (*pipe_handle)->pipeline->device_id(), release_order);
+    if (!(flags & DALI_ext_force_copy))
+      flags |= DALI_ext_force_no_copy;
+  } else {
+    owner = std::shared_ptr<void>(const_cast<void *>(data_ptr), [](void *) {});
+  }
+
   dali::Pipeline *pipeline = (*pipe_handle)->pipeline.get();
   auto *bs_map = &(*pipe_handle)->batch_size_map;
   auto *data_id_map = &(*pipe_handle)->data_id_map;
@@ -134,9 +201,8 @@ void SetExternalInput(daliPipelineHandle_t pipe_handle, const char *name, const
   // We do not support feeding memory cross-device, it is assumed it's on the current device
   // that is tied to the pipeline.
   int device_id = pipeline->device_id();
-  data.ShareData(std::shared_ptr<void>(const_cast<void *>(data_ptr), [](void *) {}),
-                 tl_shape.num_elements() * elem_sizeof, flags & DALI_ext_pinned, tl_shape, type_id,
-                 device_id, order);
+  data.ShareData(std::move(owner), tl_shape.num_elements() * elem_sizeof,
+                 flags & DALI_ext_pinned, tl_shape, type_id, device_id, order);
   data.SetLayout(layout);
 
   auto data_id = data_id_map->extract(name);
@@ -147,11 +213,16 @@ void SetExternalInput(daliPipelineHandle_t pipe_handle, const char *name, const
 }
 
 
+/**
+ * @param owners If not null, the samples are kept alive by these pointers for as long as
+ *               the pipeline uses them; otherwise the caller owns the data.
+ */
 template<typename Backend>
 void SetExternalInputTensors(daliPipelineHandle_t pipe_handle, const char *name,
                              const void *const *data_ptr, dali_data_type_t data_type,
                              const int64_t *shapes, int64_t sample_dim, const char *layout_str,
-                             cudaStream_t stream = 0, unsigned int flags = 0) {
+                             cudaStream_t stream = 0, unsigned int flags = 0,
+                             const std::shared_ptr<void> *owners = nullptr) {
   dali::Pipeline *pipeline = (*pipe_handle)->pipeline.get();
   auto *bs_map = &(*pipe_handle)->batch_size_map;
   auto *data_id_map = &(*pipe_handle)->data_id_map;
@@ -187,7 +258,9 @@ void SetExternalInputTensors(daliPipelineHandle_t pipe_handle, const char *name,
     // We cast away the const from data_ptr, as there is no other way of passing it to the
     // Tensor as we must also set the shape and type metadata.
     // The vector that we pass to pipeline is const.
-    std::shared_ptr<void> ptr(const_cast<void *>(data_ptr[i]), [](void *){});  // no deleter
+    std::shared_ptr<void> ptr = owners
+        ? owners[i]
+        : std::shared_ptr<void>(const_cast<void *>(data_ptr[i]), [](void *){});  // no deleter
     data.SetSample(i, ptr, tl_shape[i].num_elements() * elem_sizeof, flags & DALI_ext_pinned,
                    tl_shape[i], type_id, device_id, order, layout);
   }
@@ -373,6 +446,29 @@ void daliSetExternalInputAsync(daliPipelineHandle_t pipe_handle, const char *nam
 }
 
 
+void daliSetExternalInputWithRelease(daliPipelineHandle_t pipe_handle, const char *name,
+                                     device_type_t device, void *data_ptr,
+                                     dali_data_type_t data_type, const int64_t *shapes,
+                                     int sample_dim, const char *layout_str, cudaStream_t stream,
+                                     unsigned int flags,
+                                     daliExternalInputReleaseCallback release, void *user_data) {
+  DALI_ENFORCE(release != nullptr, "The release callback must not be NULL.");
+  switch (device) {
+    case device_type_t::CPU:
+      SetExternalInput<CPUBackend>(pipe_handle, name, data_ptr, data_type, shapes, sample_dim,
+                                   layout_str, stream, flags, release, user_data);
+      return;
+    case device_type_t::GPU:
+      SetExternalInput<GPUBackend>(pipe_handle, name, data_ptr, data_type, shapes, sample_dim,
+                                   layout_str, stream, flags, release, user_data);
+      return;
+    default:
+      release(data_ptr, user_data, nullptr);
+      DALI_FAIL(dali::make_string("Unknown device: ", device));
+  }
+}
+
+
 void daliSetExternalInputTensors(daliPipelineHandle_t pipe_handle, const char *name,
                                  device_type_t device, const void *const *data_ptr,
                                  dali_data_type_t data_type, const int64_t *shapes,
@@ -451,6 +547,12 @@ void daliOutputRelease(daliPipelineHandle_t pipe_handle) {
   pipeline->ReleaseOutputs();
 }
 
+
+int daliOutputReady(daliPipelineHandle_t pipe_handle) {
+  dali::Pipeline *pipeline = (*pipe_handle)->pipeline.get();
+  return pipeline->OutputsReady();
+}
+
 int64_t daliOutputHasUniformShape(daliPipelineHandle_t pipe_handle, int i) {
   dali::Workspace* ws = &(*pipe_handle)->workspace;
   if (ws->OutputIsType<CPUBackend>(i)) {
@@ -700,6 +802,24 @@ void daliOutputCopySamples(daliPipelineHandle_t pipe_handle, void **dsts, int ou
   wait_order.wait(copy_order);
 }
 
+void daliOutputRaggedOffsets(daliPipelineHandle_t pipe_handle, int64_t *offsets,
+                             int output_idx) {
+  dali::Workspace *ws = &(*pipe_handle)->workspace;
+  assert(ws != nullptr);
+  std::vector<int64_t> tl_offsets;
+  if (ws->OutputIsType<CPUBackend>(output_idx))
+    tl_offsets = ws->Output<CPUBackend>(output_idx).RaggedOffsets();
+  else
+    tl_offsets = ws->Output<GPUBackend>(output_idx).RaggedOffsets();
+  std::copy(tl_offsets.begin(), tl_offsets.end(), offsets);
+}
+
+void daliSetOutputBuffer(daliPipelineHandle_t pipe_handle, int output_idx, void *dst,
+                         size_t size, cudaStream_t stream) {
+  dali::Pipeline *pipeline = (*pipe_handle)->pipeline.get();
+  pipeline->SetOutputBuffer(output_idx, dst, size, AccessOrder(stream));
+}
+
 
 void daliCopyTensorNTo(daliPipelineHandle_t pipe_handle, void *dst, int output_id,
                     device_type_t dst_type, cudaStream_t stream, int non_blocking) {
@@ -839,6 +959,46 @@ int daliPreallocatePinnedMemory(size_t bytes) {
   }
 }
 
+namespace {
+
+void ToPoolStats(daliPoolStats *out, const dali::mm::pool_stats &stats) {
+  out->reserved = stats.reserved;
+  out->allocated = stats.allocated;
+  out->peak_allocated = stats.peak_allocated;
+  out->free = stats.free;
+  out->largest_free_block = stats.largest_free_block;
+  out->free_blocks = stats.free_blocks;
+  out->upstream_blocks = stats.upstream_blocks;
+  out->pending_free = stats.pending_free;
+  out->pending_free_blocks = stats.pending_free_blocks;
+  out->pending_free_streams = stats.pending_free_streams;
+}
+
+}  // namespace
+
+void daliGetDevicePoolStats(daliPoolStats *stats, int device_id) {
+  ToPoolStats(stats, dali::mm::GetDevicePoolStats(device_id));
+}
+
+void daliGetPinnedPoolStats(daliPoolStats *stats, int device_id) {
+  ToPoolStats(stats, dali::mm::GetPinnedPoolStats(device_id));
+}
+
+void daliSetPoolStatsLogInterval(double interval_seconds) {
+  dali::mm::SetPoolStatsLogInterval(interval_seconds);
+}
+
+void daliSetMetricsEnabled(int enabled) {
+  dali::metrics::SetEnabled(enabled != 0);
+}
+
+char *daliGetMetrics() {
+  std::string text = dali::metrics::ToPrometheusText(dali::metrics::Snapshot());
+  char *out = static_cast<char *>(daliAlloc(text.size() + 1));
+  memcpy(out, text.c_str(), text.size() + 1);
+  return out;
+}
+
 void *daliAlloc(size_t n) {
   return malloc(n);
 }
@@ -847,6 +1007,171 @@ void daliFree(void *ptr) {
   free(ptr);
 }
 
+void DALIBatchingServer::Run() {
+  std::vector<Request> batch;
+  for (;;) {
+    std::unique_lock lock(mtx);
+    cv.wait(lock, [&]() { return stop || !queue.empty(); });
+    if (queue.empty())
+      return;  // stopped and drained
+    auto deadline = queue.front().enqueued + max_delay;
+    cv.wait_until(lock, deadline, [&]() {
+      return stop || static_cast<int>(queue.size()) >= max_batch_size;
+    });
+
+    batch.clear();
+    while (!queue.empty() && static_cast<int>(batch.size()) < max_batch_size) {
+      auto &next = queue.front();
+      if (!batch.empty() && !next.BatchesWith(batch[0]))
+        break;
+      batch.push_back(std::move(next));
+      queue.pop_front();
+    }
+    lock.unlock();
+    RunBatch(batch);
+  }
+}
+
+void DALIBatchingServer::Enqueue(Request &&r) {
+  r.enqueued = std::chrono::steady_clock::now();
+  {
+    std::lock_guard lock(mtx);
+    DALI_ENFORCE(!stop, "The batching server is stopped.");
+    queue.push_back(std::move(r));
+  }
+  cv.notify_one();
+}
+
+void DALIBatchingServer::RunBatch(std::vector<Request> &batch) {
+  int n = batch.size();
+  int ndim = batch[0].shape.sample_dim();
+  bool gpu = batch[0].device == GPU;
+  int device_id = (*pipe_handle)->pipeline->device_id();
+  cudaStream_t stream = gpu ? (*pipe_handle)->copy_stream.get() : 0;
+  std::vector<const void *> ptrs(n);
+  std::vector<std::shared_ptr<void>> owners(n);
+  std::vector<int64_t> shapes;
+  shapes.reserve(n * ndim);
+  for (int i = 0; i < n; i++) {
+    ptrs[i] = batch[i].data.get();
+    owners[i] = std::move(batch[i].data);
+    shapes.insert(shapes.end(), batch[i].shape.begin(), batch[i].shape.end());
+  }
+  try {
+    for (auto &r : batch) {
+      if (r.ready) {
+        CUDA_CALL(cudaStreamWaitEvent(stream, r.ready, 0));
+        dali::CUDAEventPool::instance().Put(std::move(r.ready), device_id);
+      }
+    }
+    // The pipeline shares the ownership of the zero-copy requests; the copies made by the server
+    // are copied once more, as before, so that they can be fed to an input on any device.
+    unsigned int flags = batch[0].zero_copy ? DALI_ext_force_no_copy
+                                            : DALI_ext_force_copy | DALI_ext_force_sync;
+    daliSetExternalInputBatchSize(pipe_handle, input_name.c_str(), n);
+    if (gpu) {
+      SetExternalInputTensors<GPUBackend>(pipe_handle, input_name.c_str(), ptrs.data(),
+                                          batch[0].type, shapes.data(), ndim, nullptr, stream,
+                                          flags, owners.data());
+    } else {
+      SetExternalInputTensors<CPUBackend>(pipe_handle, input_name.c_str(), ptrs.data(),
+                                          batch[0].type, shapes.data(), ndim, nullptr, stream,
+                                          flags, owners.data());
+    }
+    owners.clear();  // the external buffers are released as soon as the pipeline is done
+    daliRun(pipe_handle);
+    daliOutput(pipe_handle);
+  } catch (std::exception &e) {
+    for (auto &r : batch)
+      callback(user_data, r.id, pipe_handle, -1, e.what());
+    return;
+  }
+  for (int i = 0; i < n; i++)
+    callback(user_data, batch[i].id, pipe_handle, i, nullptr);
+  daliOutputRelease(pipe_handle);
+}
+
+void daliBatchingServerCreate(daliBatchingServerHandle *server, daliPipelineHandle_t pipe_handle,
+                              const char *input_name, int max_batch_size, int64_t max_delay_us,
+                              daliBatchingServerCallback callback, void *user_data) {
+  DALI_ENFORCE(server && pipe_handle && input_name, "The handles and the input name are required.");
+  DALI_ENFORCE(callback != nullptr, "The callback must not be NULL.");
+  DALI_ENFORCE(max_delay_us >= 0, "The delay must not be negative.");
+  int pipeline_batch_size = (*pipe_handle)->pipeline->max_batch_size();
+  DALI_ENFORCE(max_batch_size <= pipeline_batch_size, dali::make_string(
+      "The batch size of the server (", max_batch_size, ") exceeds the max batch size of the "
+      "pipeline (", pipeline_batch_size, ")."));
+  auto s = std::make_unique<DALIBatchingServer>();
+  s->pipe_handle = pipe_handle;
+  s->input_name = input_name;
+  s->max_batch_size = max_batch_size > 0 ? max_batch_size : pipeline_batch_size;
+  s->max_delay = std::chrono::microseconds(max_delay_us);
+  s->callback = callback;
+  s->user_data = user_data;
+  s->worker = std::thread([srv = s.get()]() { srv->Run(); });
+  *server = s.release();
+}
+
+void daliBatchingServerEnqueue(daliBatchingServerHandle *server, int64_t request_id,
+                               const void *data, dali_data_type_t data_type,
+                               const int64_t *shape, int sample_dim) {
+  DALIBatchingServer::Request r;
+  r.id = request_id;
+  r.type = data_type;
+  r.shape = dali::TensorShape<>(shape, shape + sample_dim);
+  auto type_id = static_cast<dali::DALIDataType>(static_cast<int>(data_type));
+  size_t bytes = volume(r.shape) * dali::TypeTable::GetTypeInfo(type_id).size();
+  std::shared_ptr<uint8_t> copy(new uint8_t[bytes], std::default_delete<uint8_t[]>());
+  memcpy(copy.get(), data, bytes);
+  r.data = std::move(copy);
+  (*server)->Enqueue(std::move(r));
+}
+
+void daliBatchingServerEnqueueWithRelease(daliBatchingServerHandle *server, int64_t request_id,
+                                          device_type_t device, void *data,
+                                          dali_data_type_t data_type, const int64_t *shape,
+                                          int sample_dim, cudaStream_t stream,
+                                          daliExternalInputReleaseCallback release,
+                                          void *user_data) {
+  DALI_ENFORCE(release != nullptr, "The release callback must not be NULL.");
+  auto *s = *server;
+  auto &pipe = **s->pipe_handle;
+  int device_id = pipe.pipeline->device_id();
+  if (device != CPU && (device != GPU || device_id < 0)) {
+    release(data, user_data, nullptr);
+    DALI_FAIL(device == GPU ? "GPU requests require a pipeline with a GPU."
+                            : dali::make_string("Unknown device: ", device));
+  }
+  bool gpu = device == GPU;
+  DALIBatchingServer::Request r;
+  // Take the ownership first, so that the data is released if anything below throws
+  r.data = dali::WrapExternalBuffer(data, release, user_data, device_id,
+                                    gpu ? AccessOrder(pipe.copy_stream.get())
+                                        : AccessOrder::host());
+  r.id = request_id;
+  r.device = device;
+  r.type = data_type;
+  r.shape = dali::TensorShape<>(shape, shape + sample_dim);
+  r.zero_copy = true;
+  if (gpu) {
+    // the batch is fed in the pipeline's copy stream, which waits for the producer's work
+    r.ready = dali::CUDAEventPool::instance().Get(device_id);
+    CUDA_CALL(cudaEventRecord(r.ready, stream));
+  }
+  s->Enqueue(std::move(r));
+}
+
+void daliBatchingServerDestroy(daliBatchingServerHandle *server) {
+  std::unique_ptr<DALIBatchingServer> s(*server);
+  *server = nullptr;
+  {
+    std::lock_guard lock(s->mtx);
+    s->stop = true;
+  }
+  s->cv.notify_one();
+  s->worker.join();
+}
+
 void daliGetSerializedCheckpoint(
     daliPipelineHandle_t pipe_handle,
     const daliExternalContextCheckpoint *external_context,
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, 2024-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,8 +13,13 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -285,6 +290,40 @@ TYPED_TEST(CApiTest, FileReaderPipe) {
   daliDeletePipeline(&handle);
 }
 
+TYPED_TEST(CApiTest, FileReaderPipeOutputReady) {
+  auto pipe_ptr = GetTestPipeline<TypeParam>(true, this->output_device_);
+  auto serialized = pipe_ptr->SerializeToProtobuf();
+
+  pipe_ptr->Build();
+  for (int i = 0; i < prefetch_queue_depth; i++) {
+    pipe_ptr->Run();
+  }
+
+  daliPipelineHandle handle;
+  daliCreatePipeline3(&handle, serialized.c_str(), serialized.size(), batch_size, num_thread,
+                      this->device_id_, DALI_EXEC_DYNAMIC, prefetch_queue_depth,
+                      prefetch_queue_depth, prefetch_queue_depth, false);
+  daliPrefetch(&handle);
+
+  auto wait_ready = [&]() {
+    // poll, as a thread serving multiple pipelines would
+    while (!daliOutputReady(&handle))
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  };
+  for (int i = 0; i < prefetch_queue_depth; i++) {
+    wait_ready();
+    ComparePipelinesOutputs<TypeParam>(handle, *pipe_ptr);
+  }
+
+  daliRun(&handle);
+  pipe_ptr->Run();
+  wait_ready();
+  ComparePipelinesOutputs<TypeParam>(handle, *pipe_ptr);
+  // all the outputs were consumed
+  EXPECT_THROW(daliOutputReady(&handle), std::exception);
+  daliDeletePipeline(&handle);
+}
+
 TYPED_TEST(CApiTest, FileReaderDefaultPipe) {
   auto pipe_ptr = GetTestPipeline<TypeParam>(true, this->output_device_);
   auto serialized = pipe_ptr->SerializeToProtobuf();
@@ -825,6 +864,79 @@ TYPED_TEST(CApiTest, ForceNoCopy) {
 }
 
 
+namespace {
+
+struct ReleasedBuffers {
+  std::mutex mtx;
+  std::vector<void *> ptrs;
+};
+
+void ReleaseBuffer(void *data_ptr, void *user_data, cudaEvent_t done) {
+  if (done)
+    CUDA_CALL(cudaEventSynchronize(done));
+  auto *released = static_cast<ReleasedBuffers *>(user_data);
+  std::lock_guard<std::mutex> g(released->mtx);
+  released->ptrs.push_back(data_ptr);
+}
+
+}  // namespace
+
+TYPED_TEST(CApiTest, ExternalSourceWithRelease) {
+  TensorListShape<> input_shape = uniform_list_shape(batch_size, {24, 32, 3});
+  auto num_elems = input_shape.num_elements();
+  auto input_cpu = AllocBuffer<CPUBackend>(num_elems, false);
+
+  auto pipe_ptr = GetExternalSourcePipeline(false, this->output_device_);
+  auto serialized = pipe_ptr->SerializeToProtobuf();
+  pipe_ptr->Build();
+
+  daliPipelineHandle handle;
+  daliCreatePipeline(&handle, serialized.c_str(), serialized.size(), batch_size, num_thread,
+                     this->device_id_, false, prefetch_queue_depth, prefetch_queue_depth,
+                     prefetch_queue_depth, false);
+
+  ReleasedBuffers released;
+  std::vector<std::shared_ptr<uint8_t>> data;
+  for (int i = 0; i < prefetch_queue_depth; i++) {
+    data.push_back(AllocBuffer<TypeParam>(num_elems, false));
+    SequentialFill(TensorListView<StorageCPU, uint8_t>(input_cpu.get(), input_shape), 42 * i);
+    if constexpr (std::is_same_v<TypeParam, CPUBackend>)
+      memcpy(data[i].get(), input_cpu.get(), num_elems);
+    else
+      MemCopy(data[i].get(), input_cpu.get(), num_elems, cuda_stream);
+
+    TensorList<TypeParam> input_wrapper;
+    input_wrapper.ShareData(std::static_pointer_cast<void>(data[i]), num_elems,
+                            false, input_shape, DALI_UINT8, this->device_id_);
+    pipe_ptr->SetExternalInput(input_name, input_wrapper);
+    daliSetExternalInputWithRelease(&handle, input_name.c_str(),
+                                    backend_to_device_type<TypeParam>::value, data[i].get(),
+                                    dali_data_type_t::DALI_UINT8, input_shape.data(),
+                                    input_shape.sample_dim(), nullptr, cuda_stream,
+                                    DALI_ext_default, ReleaseBuffer, &released);
+  }
+  {
+    std::lock_guard<std::mutex> g(released.mtx);
+    EXPECT_TRUE(released.ptrs.empty()) << "Released before the data was consumed";
+  }
+
+  for (int i = 0; i < prefetch_queue_depth; i++)
+    pipe_ptr->Run();
+  daliPrefetchUniform(&handle, prefetch_queue_depth);
+  for (int i = 0; i < prefetch_queue_depth; i++)
+    ComparePipelinesOutputs<TypeParam>(handle, *pipe_ptr);
+
+  daliDeletePipeline(&handle);
+  // Each buffer is released exactly once
+  std::sort(released.ptrs.begin(), released.ptrs.end());
+  std::vector<void *> expected;
+  for (auto &d : data)
+    expected.push_back(d.get());
+  std::sort(expected.begin(), expected.end());
+  EXPECT_EQ(released.ptrs, expected);
+}
+
+
 template <typename Backend>
 void Clear(Tensor<Backend>& tensor);
 
@@ -862,6 +974,12 @@ TYPED_TEST(CApiTest, daliOutputCopySamples) {
       free(shape);
     }
 
+    std::vector<int64_t> offsets(batch_size + 1, -1);
+    daliOutputRaggedOffsets(&handle, offsets.data(), out_idx);
+    EXPECT_EQ(offsets[0], 0);
+    for (int sample_idx = 0; sample_idx < batch_size; sample_idx++)
+      EXPECT_EQ(offsets[sample_idx + 1] - offsets[sample_idx], sample_sizes[sample_idx]);
+
     DALIDataType type = static_cast<DALIDataType>(daliTypeAt(&handle, out_idx));
     auto type_info = dali::TypeTable::GetTypeInfo(type);
     int64_t out_size = daliNumElements(&handle, out_idx);
@@ -1076,6 +1194,120 @@ TEST(CApiTest, GetDeclaredOutputDtypeNdimTest) {
   daliDeletePipeline(&handle);
 }
 
+struct BatchingServerTestContext {
+  std::mutex mtx;
+  std::map<int64_t, std::vector<int32_t>> results;
+  int max_batch = 0;
+  bool error = false;
+};
+
+void BatchingServerTestCallback(void *user_data, int64_t request_id,
+                                daliPipelineHandle *pipe_handle, int sample_idx,
+                                const char *error) {
+  auto *ctx = static_cast<BatchingServerTestContext *>(user_data);
+  std::lock_guard lock(ctx->mtx);
+  if (error) {
+    ctx->error = true;
+    return;
+  }
+  int batch = daliNumTensors(pipe_handle, 0);
+  ctx->max_batch = std::max(ctx->max_batch, batch);
+  int64_t *shape = daliShapeAtSample(pipe_handle, 0, sample_idx);
+  std::vector<int32_t> data(shape[0]);
+  free(shape);
+  std::vector<void *> dsts(batch, nullptr);
+  dsts[sample_idx] = data.data();
+  daliOutputCopySamples(pipe_handle, dsts.data(), 0, CPU, 0, DALI_ext_force_sync);
+  ctx->results[request_id] = std::move(data);
+}
+
+TEST(CApiTest, BatchingServer) {
+  const int max_batch_size = 8;
+  dali::Pipeline pipe(max_batch_size, 1, CPU_ONLY_DEVICE_ID, -1, true, 1);
+  pipe.AddExternalInput("INPUT", "cpu", DALI_INT32, 1);
+  pipe.SetOutputDescs({{"INPUT", "cpu"}});
+  std::string ser = pipe.SerializeToProtobuf();
+  daliPipelineHandle handle;
+  daliCreatePipeline(&handle, ser.c_str(), ser.size(), max_batch_size, 1, CPU_ONLY_DEVICE_ID,
+                     false, 1, 1, 1, false);
+
+  BatchingServerTestContext ctx;
+  daliBatchingServerHandle server;
+  daliBatchingServerCreate(&server, &handle, "INPUT", 0, 2000, BatchingServerTestCallback, &ctx);
+
+  const int num_threads = 4, requests_per_thread = 25;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < requests_per_thread; i++) {
+        int64_t id = t * requests_per_thread + i;
+        int64_t shape = id % 5 + 1;
+        std::vector<int32_t> sample(shape, id);
+        daliBatchingServerEnqueue(&server, id, sample.data(), dali_data_type_t::DALI_INT32,
+                                  &shape, 1);
+        if (i % 10 == 0)
+          std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      }
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+  daliBatchingServerDestroy(&server);
+  EXPECT_EQ(server, nullptr);
+
+  EXPECT_FALSE(ctx.error);
+  EXPECT_LE(ctx.max_batch, max_batch_size);
+  ASSERT_EQ(ctx.results.size(), static_cast<size_t>(num_threads * requests_per_thread));
+  for (auto &[id, data] : ctx.results) {
+    EXPECT_EQ(data, std::vector<int32_t>(id % 5 + 1, id)) << "Wrong output for request " << id;
+  }
+  daliDeletePipeline(&handle);
+}
+
+TEST(CApiTest, BatchingServerZeroCopyGPU) {
+  const int max_batch_size = 8;
+  dali::Pipeline pipe(max_batch_size, 1, device_id, -1, true, 1);
+  pipe.AddExternalInput("INPUT", "gpu", DALI_INT32, 1);
+  pipe.SetOutputDescs({{"INPUT", "gpu"}});
+  std::string ser = pipe.SerializeToProtobuf();
+  daliPipelineHandle handle;
+  daliCreatePipeline(&handle, ser.c_str(), ser.size(), max_batch_size, 1, device_id,
+                     false, 1, 1, 1, false);
+
+  BatchingServerTestContext ctx;
+  daliBatchingServerHandle server;
+  daliBatchingServerCreate(&server, &handle, "INPUT", 0, 2000, BatchingServerTestCallback, &ctx);
+
+  const int num_requests = 40;
+  ReleasedBuffers released;
+  std::vector<std::shared_ptr<uint8_t>> buffers;
+  for (int64_t id = 0; id < num_requests; id++) {
+    int64_t shape = id % 5 + 1;
+    std::vector<int32_t> sample(shape, id);
+    buffers.push_back(AllocBuffer<GPUBackend>(shape * sizeof(int32_t), false));
+    MemCopy(buffers.back().get(), sample.data(), shape * sizeof(int32_t), cuda_stream);
+    daliBatchingServerEnqueueWithRelease(&server, id, GPU, buffers.back().get(),
+                                         dali_data_type_t::DALI_INT32, &shape, 1, cuda_stream,
+                                         ReleaseBuffer, &released);
+  }
+  daliBatchingServerDestroy(&server);
+
+  EXPECT_FALSE(ctx.error);
+  ASSERT_EQ(ctx.results.size(), static_cast<size_t>(num_requests));
+  for (auto &[id, data] : ctx.results) {
+    EXPECT_EQ(data, std::vector<int32_t>(id % 5 + 1, id)) << "Wrong output for request " << id;
+  }
+  daliDeletePipeline(&handle);
+
+  // Each buffer is released exactly once
+  std::sort(released.ptrs.begin(), released.ptrs.end());
+  std::vector<void *> expected;
+  for (auto &b : buffers)
+    expected.push_back(b.get());
+  std::sort(expected.begin(), expected.end());
+  EXPECT_EQ(released.ptrs, expected);
+}
+
 daliPipelineHandle CreateCheckpointingTestPipe() {
   dali::Pipeline pipe(1, 1, 0, -1, true, 1);
   pipe.AddOperator(
@@ -0,0 +1,98 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include "dali/core/bfloat16.h"
+#include "dali/core/convert.h"
+
+namespace dali {
+
+TEST(BFloat16, Construction) {
+  bfloat16 a = 42;
+  EXPECT_EQ(static_cast<float>(a), 42.0f);
+  bfloat16 b{-42L};
+  EXPECT_EQ(static_cast<float>(b), -42.0f);
+  bfloat16 c = -5.5f;
+  EXPECT_EQ(static_cast<float>(c), -5.5f);
+  bfloat16 d = 0.25;
+  EXPECT_EQ(static_cast<float>(d), 0.25f);
+  bfloat16 e = float16(3.5f);
+  EXPECT_EQ(static_cast<float>(e), 3.5f);
+  EXPECT_EQ(bfloat16(1.0f).bits, 0x3f80);
+  EXPECT_EQ(static_cast<float>(bfloat16::FromBits(0xc000)), -2.0f);
+}
+
+TEST(BFloat16, Rounding) {
+  // 1 + 2^-8 is exactly halfway between 1 and the next bfloat16 (1 + 2^-7) - ties to even
+  EXPECT_EQ(static_cast<float>(bfloat16(1.0f + 0x1p-8f)), 1.0f);
+  // 1 + 3 * 2^-8 is halfway between 1 + 2^-7 and 1 + 2^-6 - ties to even
+  EXPECT_EQ(static_cast<float>(bfloat16(1.0f + 3 * 0x1p-8f)), 1.0f + 0x1p-6f);
+  // above halfway - rounds up
+  EXPECT_EQ(static_cast<float>(bfloat16(1.0f + 0x1p-8f + 0x1p-20f)), 1.0f + 0x1p-7f);
+  // integers up to 256 are exact
+  for (int i = -256; i <= 256; i++)
+    EXPECT_EQ(static_cast<float>(bfloat16(i)), i);
+  EXPECT_EQ(static_cast<float>(bfloat16(257)), 256.0f);
+}
+
+TEST(BFloat16, SpecialValues) {
+  float inf = std::numeric_limits<float>::infinity();
+  EXPECT_EQ(static_cast<float>(bfloat16(inf)), inf);
+  EXPECT_EQ(static_cast<float>(bfloat16(-inf)), -inf);
+  EXPECT_TRUE(std::isnan(static_cast<float>(bfloat16(std::nanf("")))));
+  // a NaN with the payload only in the lower half of the float must not become an infinity
+  EXPECT_TRUE(std::isnan(static_cast<float>(bfloat16(std::nanf("1")))));
+  // the largest float rounds to infinity; bfloat16 has the range of float
+  EXPECT_EQ(static_cast<float>(bfloat16(std::numeric_limits<float>::max())), inf);
+  EXPECT_EQ(static_cast<float>(bfloat16(1e38f)), 0x1.2cp+126f);
+  EXPECT_EQ(static_cast<float>(-bfloat16(0.0f)), 0.0f);
+  EXPECT_TRUE(std::signbit(static_cast<float>(-bfloat16(0.0f))));
+}
+
+TEST(BFloat16, Arithmetic) {
+  bfloat16 a = 1.5f, b = 2.0f;
+  EXPECT_EQ(a + b, 3.5f);
+  EXPECT_EQ(a * b, 3.0f);
+  EXPECT_EQ(a - b, -0.5f);
+  EXPECT_EQ(b / a, 2.0f / 1.5f);
+  EXPECT_LT(a, b);
+  a += 1;
+  EXPECT_EQ(a, 2.5f);
+  a *= b;
+  EXPECT_EQ(a, 5.0f);
+  a -= 0.5;
+  EXPECT_EQ(a, 4.5f);
+  a /= b;
+  EXPECT_EQ(a, 2.25f);
+}
+
+TEST(BFloat16, Convert) {
+  EXPECT_EQ(ConvertSat<uint8_t>(bfloat16(300.0f)), 255);
+  EXPECT_EQ(ConvertSat<uint8_t>(bfloat16(-3.0f)), 0);
+  EXPECT_EQ(ConvertSat<int8_t>(bfloat16(-2.5f)), -3);
+  EXPECT_EQ(Convert<int>(bfloat16(13.75f)), 14);
+  EXPECT_EQ(ConvertSatNorm<uint8_t>(bfloat16(1.0f)), 255);
+  EXPECT_EQ(ConvertSatNorm<uint8_t>(bfloat16(0.5f)), 128);
+  EXPECT_EQ(static_cast<float>(ConvertNorm<bfloat16>(uint8_t(255))), 1.0f);
+  EXPECT_EQ(static_cast<float>(ConvertSat<bfloat16>(int64_t(1) << 40)), 0x1p40f);
+  EXPECT_EQ(ConvertSat<float>(bfloat16(0.75f)), 0.75f);
+  EXPECT_EQ(static_cast<float>(ConvertSat<float16>(bfloat16(0.375f))), 0.375f);
+  EXPECT_EQ(static_cast<float>(ConvertSat<bfloat16>(float16(-0.375f))), -0.375f);
+  EXPECT_EQ(static_cast<float>(clamp<float16>(bfloat16(1e10f))), 65504.0f);
+}
+
+}  // namespace dali
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <cassert>
 #include <mutex>
 #include <utility>
@@ -28,21 +29,24 @@ CUDAStreamPool::CUDAStreamPool() {
   dev_streams_.reserve(128);  // to avoid allocation in 1st call
 }
 
-CUDAStreamLease CUDAStreamPool::Get(int device_id) {
+CUDAStreamLease CUDAStreamPool::Get(int device_id, int priority) {
   if (device_id < 0)
     CUDA_CALL(cudaGetDevice(&device_id));
 
-  CUDAStream s = GetFromPool(device_id);
-  if (!s)
-    s = CUDAStream::Create(true, device_id);
-  return { std::move(s), device_id, this };
+  CUDAStream s = GetFromPool(device_id, priority);
+  if (!s) {
+    s = priority == 0 ? CUDAStream::Create(true, device_id)
+                      : CUDAStream::CreateWithPriority(true, priority, device_id);
+  }
+  return { std::move(s), device_id, priority, this };
 }
 
 void CUDAStreamPool::Purge() {
   std::lock_guard<spinlock> guard(lock_);
   DeleteList(unused_);
-  for (auto &list : dev_streams_)
-    DeleteList(list);
+  for (auto &lists : dev_streams_)
+    for (auto &list : lists)
+      DeleteList(list);
 }
 
 void CUDAStreamPool::DeleteList(StreamEntry *&head) {
@@ -59,15 +63,19 @@ void CUDAStreamPool::Init() {
   (void)cudaGetLastError();  // clear the error
   if (e != cudaSuccess && e != cudaErrorNoDevice && e != cudaErrorInsufficientDriver)
     throw CUDAError(e);
-  dev_streams_.resize(num_devices);
+  dev_streams_.resize(num_devices, std::vector<StreamEntry *>(1));
 }
 
-CUDAStream CUDAStreamPool::GetFromPool(int device_id) {
+CUDAStream CUDAStreamPool::GetFromPool(int device_id, int priority) {
   std::lock_guard<spinlock> guard(lock_);
   if (dev_streams_.empty())
     Init();
   assert(device_id >= 0 && device_id < static_cast<int>(dev_streams_.size()));
-  StreamEntry *e = Pop(dev_streams_[device_id]);
+  auto &lists = dev_streams_[device_id];
+  int idx = PriorityIndex(priority);
+  if (idx >= static_cast<int>(lists.size()))
+    return {};
+  StreamEntry *e = Pop(lists[idx]);
   if (!e)
     return {};
   CUDAStream ev = std::move(e->stream);
@@ -75,7 +83,7 @@ CUDAStream CUDAStreamPool::GetFromPool(int device_id) {
   return ev;
 }
 
-void CUDAStreamPool::Put(CUDAStream &&stream, int device_id) {
+void CUDAStreamPool::Put(CUDAStream &&stream, int device_id, int priority) {
   if (!stream)
     throw std::invalid_argument("Cannot put a null stream in the pool.");
   if (device_id < 0) {
@@ -91,10 +99,22 @@ void CUDAStreamPool::Put(CUDAStream &&stream, int device_id) {
     }
   }
 
+  int idx = PriorityIndex(priority);
   std::unique_lock<spinlock> lock(lock_);
   if (dev_streams_.empty())
     Init();
   assert(device_id >= 0 && device_id < static_cast<int>(dev_streams_.size()));
+  auto &lists = dev_streams_[device_id];
+  if (idx >= static_cast<int>(lists.size())) {
+    lock.unlock();
+    std::vector<StreamEntry *> resized(idx + 1, nullptr);
+    lock.lock();
+    // another thread might have grown the list in the meantime
+    if (idx >= static_cast<int>(lists.size())) {
+      std::copy(lists.begin(), lists.end(), resized.begin());
+      lists.swap(resized);
+    }
+  }
 
   StreamEntry *e = Pop(unused_);
   if (!e) {
@@ -104,7 +124,7 @@ void CUDAStreamPool::Put(CUDAStream &&stream, int device_id) {
   } else {
     e->stream = std::move(stream);
   }
-  Push(dev_streams_[device_id], e);
+  Push(lists[idx], e);
 }
 
 CUDAStreamPool &CUDAStreamPool::instance() {
@@ -73,6 +73,32 @@ class CUDAStreamPoolTest : public ::testing::Test {
       t.join();
     ASSERT_EQ(0, pool.lease_count_.load());
   }
+
+  void TestPriority() {
+    int devices = 0;
+    (void)cudaGetDeviceCount(&devices);
+    if (devices == 0) {
+      (void)cudaGetLastError();  // No CUDA devices - we don't care about the error
+      GTEST_SKIP();
+    }
+    int least = 0, greatest = 0;
+    CUDA_CALL(cudaDeviceGetStreamPriorityRange(&least, &greatest));
+    if (least == greatest)
+      GTEST_SKIP() << "Stream priorities are not supported";
+
+    CUDAStreamPool pool;
+    for (int i = 0; i < 3; i++) {
+      auto high = pool.Get(-1, greatest);
+      auto low = pool.Get(-1, least);
+      int priority = 0;
+      CUDA_CALL(cudaStreamGetPriority(high, &priority));
+      EXPECT_EQ(priority, greatest) << "A stream with a different priority was reused";
+      EXPECT_EQ(high.priority(), greatest);
+      CUDA_CALL(cudaStreamGetPriority(low, &priority));
+      EXPECT_EQ(priority, least) << "A stream with a different priority was reused";
+    }
+    ASSERT_EQ(0, pool.lease_count_.load());
+  }
 };
 
 namespace test {
@@ -81,5 +107,9 @@ TEST_F(CUDAStreamPoolTest, PutGet) {
   TestPutGet();
 }
 
+TEST_F(CUDAStreamPoolTest, Priority) {
+  TestPriority();
+}
+
 }  // namespace test
 }  // namespace dali
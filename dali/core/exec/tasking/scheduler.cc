@@ -19,7 +19,7 @@
 
 namespace dali::tasking {
 
-bool Scheduler::AcquireAllAndMoveToReady(SharedTask &task) noexcept {
+bool Scheduler::AcquireAllAndMoveToReady(SharedTask &task, ReadyBatch &batch) noexcept {
   assert(task->state_ <= TaskState::Pending);
 
   // All or nothing - first we check that all preconditions are met
@@ -38,15 +38,15 @@ bool Scheduler::AcquireAllAndMoveToReady(SharedTask &task) noexcept {
   task->preconditions_.clear();
   task->state_ = TaskState::Ready;
   pending_.Remove(task);
-  ready_.push(std::move(task));
+  batch.push_back(std::move(task));
   return true;
 }
 
 void Scheduler::Notify(Waitable *w) {
-  bool is_completion_event = dynamic_cast<CompletionEvent *>(w) != nullptr;
-  bool is_task = is_completion_event && dynamic_cast<Task *>(w);
+  bool is_completion_event = w->kind_ != Waitable::Kind::Other;
+  bool is_task = w->kind_ == Waitable::Kind::Task;
 
-  int new_ready = 0;
+  ReadyBatch new_ready;
   {
     std::lock_guard g(mtx_);
     if (is_task)
@@ -86,23 +86,19 @@ void Scheduler::Notify(Waitable *w) {
         if (task->Ready()) {
           pending_.Remove(task);
           task->state_ = TaskState::Ready;
-          ready_.push(std::move(task));
-          new_ready++;
+          new_ready.push_back(std::move(task));
           // OK, the task is ready, we're done with it
           continue;
         }
       }
 
-      if (AcquireAllAndMoveToReady(task))
-        new_ready++;
+      AcquireAllAndMoveToReady(task, new_ready);
     }
   }
 
-
-  if (new_ready == 1)
-    this->task_ready_.notify_one();
-  else if (new_ready > 1)
-    this->task_ready_.notify_all();
+  // The ready tasks are pushed after releasing mtx_ - this way, Pop is blocked only for the
+  // time of the push and not for the evaluation of the preconditions above.
+  PushReady(new_ready);
 }
 
 }  // namespace dali::tasking
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <iostream>
 #include <random>
 #include <vector>
 #include "dali/core/exec/tasking.h"
@@ -632,6 +633,22 @@ TEST(TaskingTest, HighLoadWithSemaphore) {
   }
 }
 
+TEST(TaskingTest, Scalability) {
+  // Many tiny tasks with dependencies - the run time is dominated by the scheduling overhead.
+  for (int num_threads : { 1, 4, 16, 32 }) {
+    Executor ex(num_threads);
+    ex.Start();
+    const int kIters = 20;
+    const int kLayerSize = 500;
+    auto start = t_now();
+    for (int i = 0; i < kIters; i++)
+      GraphTest(ex, 4, kLayerSize, 2);
+    double sec = std::chrono::duration<double>(t_now() - start).count();
+    double tasks_per_sec = kIters * 4 * kLayerSize / sec;
+    std::cout << num_threads << " threads: " << tasks_per_sec << " tasks/s" << std::endl;
+  }
+}
+
 TEST(TaskingTest, Priority) {
   Scheduler sched;
   // add 4 tasks with shuffled order
@@ -0,0 +1,388 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dali/core/format.h"
+#include "dali/core/metrics.h"
+
+namespace dali::metrics {
+
+namespace {
+
+bool EnvFlag(const char *name) {
+  const char *env = std::getenv(name);
+  return env && std::atoi(env) != 0;
+}
+
+int EnvInt(const char *name, int default_value) {
+  const char *env = std::getenv(name);
+  return env ? std::max(std::atoi(env), 1) : default_value;
+}
+
+std::atomic<int> g_sampling_interval{EnvInt("DALI_METRICS_SAMPLING", 1)};
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+int BucketIndex(double value) {
+  if (!(value > 1))  // also catches NaN
+    return 0;
+  return std::min<int>(kNumBuckets - 1, std::ceil(std::log2(value)));
+}
+
+/** The values accumulated by one thread; written only by the owning thread. */
+struct Slot {
+  Slot() {
+    for (auto &b : buckets)
+      b.store(0, std::memory_order_relaxed);
+  }
+
+  std::atomic<uint64_t> count{0};
+  std::atomic<double> sum{0}, min{kInf}, max{-kInf};
+  std::atomic<uint64_t> buckets[kNumBuckets];
+
+  // The owner is the only writer - a load and a store are enough; no RMW is necessary.
+  template <typename T, typename U>
+  static void Inc(std::atomic<T> &a, U delta) {
+    a.store(a.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+  }
+
+  void Add(double value) {
+    Inc(count, 1);
+    Inc(sum, value);
+  }
+
+  void Observe(double value, uint64_t n) {
+    Inc(count, n);
+    Inc(sum, value * n);
+    if (value < min.load(std::memory_order_relaxed))
+      min.store(value, std::memory_order_relaxed);
+    if (value > max.load(std::memory_order_relaxed))
+      max.store(value, std::memory_order_relaxed);
+    Inc(buckets[BucketIndex(value)], n);
+  }
+};
+
+/** Plain (non-atomic) accumulator used when aggregating the slots */
+struct Accumulator {
+  uint64_t count = 0;
+  double sum = 0, min = kInf, max = -kInf;
+  uint64_t buckets[kNumBuckets] = {};
+
+  void Merge(const Slot &s) {
+    count += s.count.load(std::memory_order_relaxed);
+    sum += s.sum.load(std::memory_order_relaxed);
+    min = std::min(min, s.min.load(std::memory_order_relaxed));
+    max = std::max(max, s.max.load(std::memory_order_relaxed));
+    for (int i = 0; i < kNumBuckets; i++)
+      buckets[i] += s.buckets[i].load(std::memory_order_relaxed);
+  }
+};
+
+struct MetricInfo {
+  std::string name, labels, help;
+  MetricKind kind;
+  std::atomic<double> gauge{0};
+  std::atomic<uint64_t> gauge_updates{0};
+};
+
+constexpr int kChunkSize = 64;
+constexpr int kNumChunks = (kMaxMetrics + kChunkSize - 1) / kChunkSize;
+
+/**
+ * The slots of one thread. The slots are allocated when the thread first updates the metric;
+ * the pointers are published with release stores, so they can be read by the aggregating thread.
+ */
+class ThreadTable {
+ public:
+  ThreadTable();
+  ~ThreadTable();
+
+  Slot &GetSlot(int id) {
+    auto &chunk_ptr = chunks_[id / kChunkSize];
+    Chunk *chunk = chunk_ptr.load(std::memory_order_relaxed);
+    if (!chunk) {
+      chunk = new Chunk();
+      chunk_ptr.store(chunk, std::memory_order_release);
+    }
+    auto &slot_ptr = chunk->slots[id % kChunkSize];
+    Slot *slot = slot_ptr.load(std::memory_order_relaxed);
+    if (!slot) {
+      slot = new Slot();
+      slot_ptr.store(slot, std::memory_order_release);
+    }
+    return *slot;
+  }
+
+  const Slot *FindSlot(int id) const {
+    const Chunk *chunk = chunks_[id / kChunkSize].load(std::memory_order_acquire);
+    return chunk ? chunk->slots[id % kChunkSize].load(std::memory_order_acquire) : nullptr;
+  }
+
+ private:
+  struct Chunk {
+    Chunk() {
+      for (auto &s : slots)
+        s.store(nullptr, std::memory_order_relaxed);
+    }
+    ~Chunk() {
+      for (auto &s : slots)
+        delete s.load(std::memory_order_relaxed);
+    }
+    std::atomic<Slot *> slots[kChunkSize];
+  };
+  std::atomic<Chunk *> chunks_[kNumChunks] = {};
+};
+
+class Registry {
+ public:
+  /** The registry is never destroyed, so that it outlives the thread-local tables. */
+  static Registry &Instance() {
+    static Registry *instance = new Registry();
+    return *instance;
+  }
+
+  int GetId(const std::string &name, MetricKind kind, const std::string &labels,
+            const std::string &help) {
+    std::lock_guard<std::mutex> g(mtx_);
+    auto it = ids_.find({name, labels});
+    if (it != ids_.end()) {
+      if (infos_[it->second]->kind != kind)
+        throw std::invalid_argument(make_string(
+            "The metric \"", name, "\" was already registered with a different kind."));
+      return it->second;
+    }
+    int id = num_metrics_;
+    if (id >= kMaxMetrics)
+      return -1;
+    auto info = std::make_unique<MetricInfo>();
+    info->name = name;
+    info->labels = labels;
+    info->help = help;
+    info->kind = kind;
+    infos_[id] = std::move(info);
+    ids_.emplace(std::make_pair(name, labels), id);
+    num_metrics_ = id + 1;
+    return id;
+  }
+
+  MetricInfo &Info(int id) {
+    // The entries are never removed; the id couldn't be obtained before the entry was set.
+    return *infos_[id];
+  }
+
+  void AddThread(ThreadTable *t) {
+    std::lock_guard<std::mutex> g(mtx_);
+    threads_.push_back(t);
+  }
+
+  void RemoveThread(ThreadTable *t) {
+    std::lock_guard<std::mutex> g(mtx_);
+    for (int id = 0; id < num_metrics_; id++) {
+      if (const Slot *s = t->FindSlot(id))
+        retired_[id].Merge(*s);
+    }
+    threads_.erase(std::remove(threads_.begin(), threads_.end(), t), threads_.end());
+  }
+
+  std::vector<MetricSnapshot> Snapshot() {
+    std::lock_guard<std::mutex> g(mtx_);
+    std::vector<MetricSnapshot> ret(num_metrics_);
+    for (int id = 0; id < num_metrics_; id++) {
+      auto &info = *infos_[id];
+      auto &out = ret[id];
+      out.name = info.name;
+      out.labels = info.labels;
+      out.help = info.help;
+      out.kind = info.kind;
+      if (info.kind == MetricKind::Gauge) {
+        out.value = info.gauge.load(std::memory_order_relaxed);
+        out.count = info.gauge_updates.load(std::memory_order_relaxed);
+        continue;
+      }
+      Accumulator acc = retired_[id];
+      for (auto *t : threads_) {
+        if (const Slot *s = t->FindSlot(id))
+          acc.Merge(*s);
+      }
+      out.count = acc.count;
+      out.value = acc.sum;
+      if (info.kind == MetricKind::Histogram) {
+        out.min = acc.count ? acc.min : 0;
+        out.max = acc.count ? acc.max : 0;
+        out.buckets.assign(acc.buckets, acc.buckets + kNumBuckets);
+      }
+    }
+    return ret;
+  }
+
+ private:
+  Registry() : retired_(kMaxMetrics) {}
+
+  std::mutex mtx_;
+  std::map<std::pair<std::string, std::string>, int> ids_;
+  std::unique_ptr<MetricInfo> infos_[kMaxMetrics];
+  int num_metrics_ = 0;
+  std::vector<ThreadTable *> threads_;
+  /** The values accumulated by the threads which have already exited */
+  std::vector<Accumulator> retired_;
+};
+
+ThreadTable::ThreadTable() {
+  Registry::Instance().AddThread(this);
+}
+
+ThreadTable::~ThreadTable() {
+  Registry::Instance().RemoveThread(this);
+  for (auto &c : chunks_)
+    delete c.load(std::memory_order_relaxed);
+}
+
+ThreadTable &ThisThreadTable() {
+  static thread_local ThreadTable table;
+  return table;
+}
+
+std::string FormatValue(double v) {
+  if (std::isinf(v))
+    return v > 0 ? "+Inf" : "-Inf";
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.17g", v);
+  return buf;
+}
+
+std::string Labels(const std::string &labels, const std::string &extra = "") {
+  if (labels.empty() && extra.empty())
+    return "";
+  if (labels.empty() || extra.empty())
+    return "{" + labels + extra + "}";
+  return "{" + labels + "," + extra + "}";
+}
+
+}  // namespace
+
+std::atomic<bool> g_metrics_enabled{EnvFlag("DALI_METRICS")};
+
+void SetEnabled(bool enabled) {
+  g_metrics_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void SetSamplingInterval(int interval) {
+  if (interval < 1)
+    throw std::invalid_argument(make_string(
+        "The sampling interval must be positive, got ", interval, "."));
+  g_sampling_interval.store(interval, std::memory_order_relaxed);
+}
+
+int GetSamplingInterval() {
+  return g_sampling_interval.load(std::memory_order_relaxed);
+}
+
+Metric::Metric(const std::string &name, MetricKind kind, const std::string &labels,
+               const std::string &help)
+    : id_(Registry::Instance().GetId(name, kind, labels, help)) {}
+
+void Metric::AddImpl(double value) const {
+  ThisThreadTable().GetSlot(id_).Add(value);
+}
+
+void Metric::SetImpl(double value) const {
+  auto &info = Registry::Instance().Info(id_);
+  info.gauge.store(value, std::memory_order_relaxed);
+  info.gauge_updates.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metric::ObserveImpl(double value, uint64_t count) const {
+  ThisThreadTable().GetSlot(id_).Observe(value, count);
+}
+
+bool LatencyTimer::Sample() {
+  int interval = g_sampling_interval.load(std::memory_order_relaxed);
+  if (interval <= 1)
+    return true;
+  static thread_local unsigned counter = 0;
+  return ++counter % interval == 0;
+}
+
+std::vector<MetricSnapshot> Snapshot() {
+  return Registry::Instance().Snapshot();
+}
+
+std::string Label(const std::string &name, const std::string &value) {
+  std::string out = name + "=\"";
+  for (char c : value) {
+    if (c == '\\' || c == '"')
+      out += '\\';
+    if (c == '\n')
+      out += "\\n";
+    else
+      out += c;
+  }
+  return out + "\"";
+}
+
+double BucketUpperBound(int bucket) {
+  return bucket < kNumBuckets - 1 ? std::ldexp(1.0, bucket) : kInf;
+}
+
+std::string ToPrometheusText(const std::vector<MetricSnapshot> &metrics) {
+  // Prometheus requires all the series of a metric to be grouped
+  std::vector<std::string> names;
+  std::map<std::string, std::vector<const MetricSnapshot *>> by_name;
+  for (auto &m : metrics) {
+    auto &group = by_name[m.name];
+    if (group.empty())
+      names.push_back(m.name);
+    group.push_back(&m);
+  }
+
+  std::string out;
+  for (auto &name : names) {
+    auto &group = by_name[name];
+    auto kind = group[0]->kind;
+    if (!group[0]->help.empty())
+      out += make_string("# HELP ", name, " ", group[0]->help, "\n");
+    out += make_string("# TYPE ", name, " ",
+                       kind == MetricKind::Counter ? "counter" :
+                       kind == MetricKind::Gauge ? "gauge" : "histogram", "\n");
+    for (auto *m : group) {
+      if (kind != MetricKind::Histogram) {
+        out += make_string(name, Labels(m->labels), " ", FormatValue(m->value), "\n");
+        continue;
+      }
+      uint64_t cumulative = 0;
+      for (int b = 0; b < kNumBuckets; b++) {
+        cumulative += b < static_cast<int>(m->buckets.size()) ? m->buckets[b] : 0;
+        out += make_string(name, "_bucket",
+                           Labels(m->labels, "le=\"" + FormatValue(BucketUpperBound(b)) + "\""),
+                           " ", cumulative, "\n");
+      }
+      out += make_string(name, "_sum", Labels(m->labels), " ", FormatValue(m->value), "\n");
+      out += make_string(name, "_count", Labels(m->labels), " ", m->count, "\n");
+    }
+  }
+  return out;
+}
+
+}  // namespace dali::metrics
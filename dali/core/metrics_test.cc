@@ -0,0 +1,119 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "dali/core/metrics.h"
+
+namespace dali::metrics::test {
+
+namespace {
+
+const MetricSnapshot *Find(const std::vector<MetricSnapshot> &metrics, const std::string &name,
+                           const std::string &labels = "") {
+  for (auto &m : metrics)
+    if (m.name == name && m.labels == labels)
+      return &m;
+  return nullptr;
+}
+
+struct EnableMetrics {
+  EnableMetrics() : prev(Enabled()) { SetEnabled(true); }
+  ~EnableMetrics() { SetEnabled(prev); }
+  bool prev;
+};
+
+}  // namespace
+
+TEST(MetricsTest, CounterFromManyThreads) {
+  EnableMetrics enable;
+  Metric counter("metrics_test_counter", MetricKind::Counter, "thread=\"any\"");
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 1000; i++)
+        counter.Add(2);
+    });
+  }
+  // the values accumulated by the threads are kept after the threads exit
+  for (auto &t : threads)
+    t.join();
+  auto snapshot = Snapshot();
+  auto *m = Find(snapshot, "metrics_test_counter", "thread=\"any\"");
+  ASSERT_NE(m, nullptr);
+  EXPECT_EQ(m->count, 8000u);
+  EXPECT_EQ(m->value, 16000);
+
+  // the same name and labels give the same metric
+  Metric same("metrics_test_counter", MetricKind::Counter, "thread=\"any\"");
+  EXPECT_EQ(same.id(), counter.id());
+  EXPECT_THROW(Metric("metrics_test_counter", MetricKind::Gauge, "thread=\"any\""),
+               std::invalid_argument);
+}
+
+TEST(MetricsTest, Histogram) {
+  EnableMetrics enable;
+  Metric hist("metrics_test_histogram", MetricKind::Histogram);
+  hist.Observe(0.5);
+  hist.Observe(3);
+  hist.Observe(4, 2);
+  hist.Observe(1000);
+  auto snapshot = Snapshot();
+  auto *m = Find(snapshot, "metrics_test_histogram");
+  ASSERT_NE(m, nullptr);
+  EXPECT_EQ(m->count, 5u);
+  EXPECT_EQ(m->value, 0.5 + 3 + 8 + 1000);
+  EXPECT_EQ(m->min, 0.5);
+  EXPECT_EQ(m->max, 1000);
+  ASSERT_EQ(m->buckets.size(), static_cast<size_t>(kNumBuckets));
+  EXPECT_EQ(m->buckets[0], 1u);   // <= 1
+  EXPECT_EQ(m->buckets[2], 3u);   // (2, 4]
+  EXPECT_EQ(m->buckets[10], 1u);  // (512, 1024]
+
+  auto text = ToPrometheusText({*m});
+  EXPECT_NE(text.find("# TYPE metrics_test_histogram histogram"), std::string::npos);
+  EXPECT_NE(text.find("metrics_test_histogram_bucket{le=\"4\"} 4\n"), std::string::npos);
+  EXPECT_NE(text.find("metrics_test_histogram_bucket{le=\"+Inf\"} 5\n"), std::string::npos);
+  EXPECT_NE(text.find("metrics_test_histogram_count 5\n"), std::string::npos);
+}
+
+TEST(MetricsTest, DisabledAndSampling) {
+  Metric gauge("metrics_test_gauge", MetricKind::Gauge);
+  Metric hist("metrics_test_timer", MetricKind::Histogram);
+  {
+    EnableMetrics enable;
+    SetEnabled(false);
+    gauge.Set(5);
+    LatencyTimer t(hist);
+  }
+  auto snapshot = Snapshot();
+  auto *m = Find(snapshot, "metrics_test_gauge");
+  ASSERT_NE(m, nullptr);
+  EXPECT_EQ(m->count, 0u);
+
+  EnableMetrics enable;
+  gauge.Set(7);
+  int prev_interval = GetSamplingInterval();
+  SetSamplingInterval(4);
+  for (int i = 0; i < 40; i++)
+    LatencyTimer t(hist);
+  SetSamplingInterval(prev_interval);
+  snapshot = Snapshot();
+  EXPECT_EQ(Find(snapshot, "metrics_test_gauge")->value, 7);
+  EXPECT_EQ(Find(snapshot, "metrics_test_timer")->count, 10u);
+}
+
+}  // namespace dali::metrics::test
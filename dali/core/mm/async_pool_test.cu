@@ -111,6 +111,43 @@ TEST(MMAsyncPool, TwoStream) {
   upstream.check_leaks();
 }
 
+TEST(MMAsyncPool, CrossStreamReuse) {
+  mm::test::test_device_resource upstream;
+  CUDAStream s1 = CUDAStream::Create(true);
+  CUDAStream s2 = CUDAStream::Create(true);
+  stream_view sv1(s1);
+  stream_view sv2(s2);
+
+  GPUHog hog;
+  hog.init();
+  {
+    async_pool_resource<memory_kind::device> pool(&upstream, false);
+    pool.set_cross_stream_reuse(true);
+    const size_t size = 1 << 20;
+    void *p1 = pool.allocate_async(size, sv1);
+    // exhaust the global pool, so that the next allocation can't be satisfied from there
+    std::vector<void *> fillers;
+    while (void *p = pool.try_allocate_from_free(size, 256))
+      fillers.push_back(p);
+    size_t upstream_allocs = upstream.get_num_allocs();
+
+    hog.run(s1, 10);
+    pool.deallocate_async(p1, size, sv1);
+    void *p2 = pool.allocate_async(size, sv2);
+    EXPECT_EQ(p1, p2) << "The block freed on s1 should be reused on s2";
+    EXPECT_EQ(upstream.get_num_allocs(), upstream_allocs) << "Upstream should not be used";
+    // s2 must wait for s1
+    hog.run(s2);
+    CUDA_CALL(cudaStreamSynchronize(s2));
+    EXPECT_EQ(cudaStreamQuery(s1), cudaSuccess);
+
+    pool.deallocate_async(p2, size, sv2);
+    for (void *p : fillers)
+      pool.deallocate(p, size, 256);
+  }
+  upstream.check_leaks();
+}
+
 namespace {
 
 __global__ void Check(const void *ptr, size_t size, uint8_t fill, int *failures) {
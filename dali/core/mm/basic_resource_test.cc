@@ -78,6 +78,29 @@ TYPED_TEST(MMBasicResourceTest, OOM) {
   this->OOMTest();
 }
 
+TEST(MMNumaPinnedResourceTest, AllocateAndStats) {
+  numa_pinned_memory_resource res(0);
+  EXPECT_EQ(res.numa_node(), 0);
+  void *p1 = res.allocate(1000);
+  ASSERT_NE(p1, nullptr);
+  void *p2 = res.allocate(1 << 20, 4096);
+  ASSERT_NE(p2, nullptr);
+  EXPECT_TRUE(detail::is_aligned(p2, 4096));
+  EXPECT_GE(res.allocated(), 1000u + (1 << 20));
+
+  cudaPointerAttributes attr = {};
+  CUDA_CALL(cudaPointerGetAttributes(&attr, p2));
+  EXPECT_EQ(attr.type, cudaMemoryTypeHost);
+  memset(p2, 0x55, 1 << 20);
+
+  size_t peak = res.peak_allocated();
+  EXPECT_EQ(peak, res.allocated());
+  res.deallocate(p1, 1000);
+  res.deallocate(p2, 1 << 20, 4096);
+  EXPECT_EQ(res.allocated(), 0u);
+  EXPECT_EQ(res.peak_allocated(), peak);
+}
+
 }  // namespace test
 }  // namespace mm
 }  // namespace dali
@@ -0,0 +1,73 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "dali/core/mm/budget_resource.h"
+#include "dali/core/mm/pool_resource.h"
+#include "dali/core/mm/mm_test_utils.h"
+
+namespace dali {
+namespace mm {
+namespace test {
+
+TEST(MMBudgetResource, Limit) {
+  test_host_resource upstream;
+  memory_budget budget;
+  budget.limit = 1000;
+  budget_resource<memory_kind::host> rsrc(&upstream, &budget);
+  void *m1 = rsrc.allocate(600);
+  EXPECT_EQ(budget.used, 600u);
+  EXPECT_FALSE(budget.under_pressure());
+  EXPECT_THROW(rsrc.allocate(600), std::bad_alloc);
+  EXPECT_EQ(budget.used, 600u);
+  EXPECT_EQ(upstream.get_num_allocs(), 1u);
+  void *m2 = rsrc.allocate(350);
+  EXPECT_TRUE(budget.under_pressure());
+  rsrc.deallocate(m1, 600);
+  EXPECT_FALSE(budget.under_pressure());
+  budget.limit = 0;  // no limit
+  void *m3 = rsrc.allocate(10000);
+  rsrc.deallocate(m2, 350);
+  rsrc.deallocate(m3, 10000);
+  EXPECT_EQ(budget.used, 0u);
+  EXPECT_EQ(upstream.get_current_size(), 0u);
+}
+
+TEST(MMBudgetResource, PoolReleasesUnusedBlocks) {
+  test_host_resource upstream;
+  memory_budget budget;
+  budget.limit = 1 << 20;
+  budget_resource<memory_kind::host> rsrc(&upstream, &budget);
+  pool_options opts = default_host_pool_opts();
+  opts.min_block_size = 1 << 10;
+  opts.max_block_size = 1 << 20;
+  pool_resource<memory_kind::host, coalescing_free_tree, detail::dummy_lock> pool(&rsrc, opts);
+  // Fill the pool with many small blocks...
+  std::vector<void *> mem;
+  for (int i = 0; i < 32; i++)
+    mem.push_back(pool.allocate(10000));
+  for (auto *m : mem)
+    pool.deallocate(m, 10000);
+  size_t used = budget.used;
+  EXPECT_GT(used, 0u);
+  // ...and request a large one - it fits only if the pool returns the free blocks
+  void *large = pool.allocate((1 << 20) - used / 2);
+  EXPECT_LE(budget.used, budget.limit);
+  pool.deallocate(large, (1 << 20) - used / 2);
+}
+
+}  // namespace test
+}  // namespace mm
+}  // namespace dali
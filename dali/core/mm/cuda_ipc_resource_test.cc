@@ -0,0 +1,77 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/core/mm/cuda_ipc_resource.h"
+#include <gtest/gtest.h>
+#include <vector>
+#include "dali/core/mm/pool_resource.h"
+#include "dali/core/spinlock.h"
+
+#if DALI_USE_CUDA_VM_MAP
+
+namespace dali {
+namespace mm {
+namespace test {
+
+TEST(MMCudaIPCResource, ExportImport) {
+  int device_id = 0;
+  CUDA_CALL(cudaGetDevice(&device_id));
+  if (!cuda_ipc_memory_resource::is_supported(device_id))
+    GTEST_SKIP() << "Shareable CUDA memory handles are not supported on this machine";
+
+  cuda_ipc_memory_resource upstream(device_id);
+  pool_resource<memory_kind::device, coalescing_free_tree, spinlock> pool(&upstream);
+  const size_t size = 1000;
+  char *p1 = static_cast<char *>(pool.allocate(size, 256));
+  char *p2 = static_cast<char *>(pool.allocate(size, 256));
+  EXPECT_TRUE(upstream.owns(p1));
+  EXPECT_TRUE(upstream.owns(p2));
+  int dummy;
+  EXPECT_FALSE(upstream.owns(&dummy));
+  CUDA_CALL(cudaMemset(p1, 1, size));
+  CUDA_CALL(cudaMemset(p2, 2, size));
+  CUDA_CALL(cudaDeviceSynchronize());
+
+  ipc_mem_handle h1 = upstream.export_handle(p1);
+  ipc_mem_handle h2 = upstream.export_handle(p2);
+  EXPECT_GE(h1.fd, 0);
+  EXPECT_EQ(h1.fd, h2.fd) << "The pool should place both allocations in one upstream block";
+  EXPECT_NE(h1.offset, h2.offset);
+  EXPECT_LE(h2.offset + size, h2.size);
+
+  {
+    cuda_ipc_mapping m1(h1), m2(h2);
+    std::vector<char> host(size);
+    CUDA_CALL(cudaMemcpy(host.data(), m1.data(), size, cudaMemcpyDeviceToHost));
+    for (size_t i = 0; i < size; i++)
+      ASSERT_EQ(host[i], 1) << " at index " << i;
+    CUDA_CALL(cudaMemcpy(host.data(), m2.data(), size, cudaMemcpyDeviceToHost));
+    for (size_t i = 0; i < size; i++)
+      ASSERT_EQ(host[i], 2) << " at index " << i;
+
+    cuda_ipc_mapping moved = std::move(m1);
+    EXPECT_EQ(m1.data(), nullptr);
+    EXPECT_NE(moved.data(), nullptr);
+  }
+
+  pool.deallocate(p1, size, 256);
+  pool.deallocate(p2, size, 256);
+  EXPECT_THROW(upstream.export_handle(&dummy), std::invalid_argument);
+}
+
+}  // namespace test
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_USE_CUDA_VM_MAP
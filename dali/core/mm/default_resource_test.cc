@@ -446,6 +446,22 @@ TEST(MMDefaultResource, PreallocatePinnedMemory) {
   mm::ReleaseUnusedMemory();
 }
 
+TEST(MMDefaultResource, NumaPinnedMemory) {
+  int node = mm::GetPinnedMemoryNumaNode();
+  if (node < 0)
+    GTEST_SKIP() << "The pinned memory pools are not NUMA-aware on this system.";
+
+  auto *res = mm::GetDefaultResource<mm::memory_kind::pinned>();
+  size_t size = 16_uz << 20;  // 16 MiB
+  void *mem = res->allocate(size);
+  auto stats = mm::GetPinnedMemoryStats(node);
+  EXPECT_GE(stats.allocated, size);
+  EXPECT_GE(stats.peak_allocated, stats.allocated);
+  res->deallocate(mem, size);
+
+  EXPECT_EQ(mm::GetPinnedMemoryStats(-1).allocated, 0u);
+}
+
 static void TestPreallocateDeviceMemory(bool multigpu) {
   int device_id = multigpu ? 1 : 0;
   DeviceGuard dg(device_id);
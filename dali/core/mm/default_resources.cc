@@ -12,8 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <stdexcept>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include "dali/core/mm/default_resources.h"
 #include "dali/core/error_handling.h"
 #include "dali/core/format.h"
@@ -21,9 +27,14 @@
 #include "dali/core/mm/binning_resource.h"
 #include "dali/core/device_guard.h"
 #include "dali/core/mm/async_pool.h"
+#include "dali/core/mm/budget_resource.h"
 #include "dali/core/mm/composite_resource.h"
 #include "dali/core/mm/cuda_vm_resource.h"
+#include "dali/core/mm/tracing_resource.h"
 #include "dali/core/call_at_exit.h"
+#if NVML_ENABLED
+#include "dali/util/nvml.h"
+#endif  // NVML_ENABLED
 
 namespace dali {
 namespace mm {
@@ -38,7 +49,12 @@ inline std::shared_ptr<T> wrap(T *p, bool own) {
     return std::shared_ptr<T>(p, [](T*){});
 }
 
+constexpr int kMaxNumaNodes = 64;
+constexpr int kUnknownNumaNode = -2;
+
 struct DefaultResources {
+  DefaultResources();
+
   ~DefaultResources() {
     ReleasePinned();
     ReleaseDevice();
@@ -51,6 +67,11 @@ struct DefaultResources {
     return dr;
   }
 
+  // The budgets must outlive the resources which use them
+  std::unique_ptr<memory_budget[]> device_budget;
+  memory_budget pinned_budget;
+  std::atomic<size_t> device_budget_limit{0};
+
   std::shared_ptr<host_memory_resource> host;
   std::shared_ptr<pinned_async_resource> pinned_async;
   std::shared_ptr<managed_async_resource> managed;
@@ -58,8 +79,18 @@ struct DefaultResources {
   int num_devices = 0;
   std::mutex mtx;
 
+  // The pinned memory pools local to each NUMA node - used unless pinned_async is set explicitly
+  std::shared_ptr<pinned_async_resource> pinned_numa[kMaxNumaNodes];
+  std::shared_ptr<numa_pinned_memory_resource> pinned_numa_upstream[kMaxNumaNodes];
+  std::unique_ptr<std::atomic<int>[]> device_numa_node;
+  std::atomic<bool> pinned_set_explicitly{false};
+
   void ReleasePinned() {
     Release(pinned_async);
+    for (auto &numa : pinned_numa)
+      Release(numa);
+    for (auto &upstream : pinned_numa_upstream)
+      Release(upstream);
   }
 
   void ReleaseManaged() {
@@ -81,6 +112,12 @@ struct DefaultResources {
         int ndevs = 0;
         CUDA_CALL(cudaGetDeviceCount(&ndevs));
         decltype(device) tmp(new std::shared_ptr<device_async_resource>[ndevs]);
+        device_numa_node.reset(new std::atomic<int>[ndevs]);
+        device_budget.reset(new memory_budget[ndevs]);
+        for (int i = 0; i < ndevs; i++) {
+          device_numa_node[i] = kUnknownNumaNode;
+          device_budget[i].limit = device_budget_limit.load();
+        }
         std::atomic_thread_fence(std::memory_order::memory_order_seq_cst);
         num_devices = ndevs;
         std::atomic_thread_fence(std::memory_order::memory_order_seq_cst);
@@ -138,10 +175,15 @@ struct CUDARTLoader {
 struct MMEnv {
   bool use_dev_mem_pool = true;
   bool use_pinned_mem_pool = true;
+  bool use_numa_pinned_mem_pool = true;
   bool use_vmm = true;
   bool use_cuda_malloc_async = false;
+  bool cross_stream_reuse = true;
 
   size_t host_malloc_threshold;
+  size_t device_memory_budget = 0;
+  size_t pinned_memory_budget = 0;
+  std::string trace_file;
 
   static const MMEnv &get() {
     static MMEnv env;
@@ -159,9 +201,16 @@ struct MMEnv {
     const char *use_pinned_mem_pool_env = std::getenv("DALI_USE_PINNED_MEM_POOL");
     use_pinned_mem_pool = !use_pinned_mem_pool_env || atoi(use_pinned_mem_pool_env);
 
+    const char *use_numa_pinned_mem_pool_env = std::getenv("DALI_USE_NUMA_PINNED_MEM_POOL");
+    use_numa_pinned_mem_pool = use_pinned_mem_pool &&
+        (!use_numa_pinned_mem_pool_env || atoi(use_numa_pinned_mem_pool_env));
+
     const char *use_cuda_malloc_async_env = std::getenv("DALI_USE_CUDA_MALLOC_ASYNC");
     use_cuda_malloc_async = use_cuda_malloc_async_env && atoi(use_cuda_malloc_async_env);
 
+    const char *cross_stream_reuse_env = std::getenv("DALI_MEM_POOL_CROSS_STREAM_REUSE");
+    cross_stream_reuse = !cross_stream_reuse_env || atoi(cross_stream_reuse_env);
+
     if (use_dev_mem_pool && use_cuda_malloc_async) {
       if (!use_dev_mem_pool_env) {
         use_dev_mem_pool = false;
@@ -181,6 +230,37 @@ struct MMEnv {
     }
 
     host_malloc_threshold = ParseMallocThresholdEnv();
+    device_memory_budget = ParseSizeEnv("DALI_DEVICE_MEMORY_BUDGET");
+    pinned_memory_budget = ParseSizeEnv("DALI_PINNED_MEMORY_BUDGET");
+
+    if (const char *trace_file_env = std::getenv("DALI_MM_TRACE_FILE"))
+      trace_file = trace_file_env;
+  }
+
+  /**
+   * @brief Parses a size, in bytes, optionally followed by 'k', 'M' or 'G'; 0 if not set
+   */
+  static size_t ParseSizeEnv(const char *name) {
+    const char *env = getenv(name);
+    int len = env ? strlen(env) : 0;
+    if (!len)
+      return 0;
+    for (int i = 0; i < len; i++) {
+      bool valid = std::isdigit(env[i]) ||
+                   (i == len - 1 && i > 0 && (env[i] == 'k' || env[i] == 'M' || env[i] == 'G'));
+      if (!valid) {
+        DALI_FAIL(make_string(
+          name, " must be a number, optionally followed by 'k', 'M' or 'G', got: ", env));
+      }
+    }
+    size_t s = atoll(env);
+    if (env[len-1] == 'k')
+      s <<= 10;
+    else if (env[len-1] == 'M')
+      s <<= 20;
+    else if (env[len-1] == 'G')
+      s <<= 30;
+    return s;
   }
 
   ssize_t ParseMallocThresholdEnv() {
@@ -213,6 +293,44 @@ struct MMEnv {
   }
 };
 
+DefaultResources::DefaultResources() {
+  device_budget_limit = MMEnv::get().device_memory_budget;
+  pinned_budget.limit = MMEnv::get().pinned_memory_budget;
+}
+
+/**
+ * @brief The trace of the requests to the default resources, written to DALI_MM_TRACE_FILE
+ *        at exit; null if the variable is not set.
+ */
+const std::shared_ptr<alloc_trace> &DefaultResourceTrace() {
+  static std::shared_ptr<alloc_trace> trace = []() -> std::shared_ptr<alloc_trace> {
+    if (MMEnv::get().trace_file.empty())
+      return nullptr;
+    return std::make_shared<alloc_trace>();
+  }();
+  static auto writer = AtScopeExit([] {
+    if (!trace)
+      return;
+    std::ofstream f(MMEnv::get().trace_file);
+    if (f.good())
+      trace->write(f);
+    else
+      std::cerr << "Cannot write the allocation trace to " << MMEnv::get().trace_file << "\n";
+  });
+  return trace;
+}
+
+/**
+ * @brief Records the requests to the resource in the default trace, if tracing is enabled.
+ */
+template <typename Interface>
+std::shared_ptr<Interface> Traced(std::shared_ptr<Interface> rsrc) {
+  auto &trace = DefaultResourceTrace();
+  if (!trace)
+    return rsrc;
+  return std::make_shared<tracing_resource<Interface>>(std::move(rsrc), trace);
+}
+
 inline std::shared_ptr<host_memory_resource> CreateDefaultHostResource() {
   auto rsrc = std::make_shared<malloc_memory_resource>();
   size_t threshold = MMEnv::get().host_malloc_threshold;
@@ -247,20 +365,28 @@ inline std::shared_ptr<device_async_resource> CreateDefaultDeviceResource() {
   if (!MMEnv::get().use_dev_mem_pool) {
     return std::make_shared<mm::cuda_malloc_memory_resource>(device_id);
   }
+  memory_budget *budget = &g_resources.device_budget[device_id];
   #if DALI_USE_CUDA_VM_MAP
-  if (cuvm::IsSupported() && MMEnv::get().use_vmm) {
+  // The VMM pool maps the physical memory on its own - it cannot be placed on top of a budget.
+  if (cuvm::IsSupported() && MMEnv::get().use_vmm && !budget->limit) {
     using resource_type = mm::async_pool_resource<mm::memory_kind::device, cuda_vm_resource,
                                                   std::mutex, void>;
-    return std::make_shared<resource_type>();
+    auto rsrc = std::make_shared<resource_type>();
+    rsrc->set_cross_stream_reuse(MMEnv::get().cross_stream_reuse);
+    return rsrc;
   }
   #endif  // DALI_USE_CUDA_VM_MAP
   {
     auto upstream = std::make_shared<mm::cuda_malloc_memory_resource>(device_id);
+    auto budgeted = std::make_shared<budget_resource<memory_kind::device>>(
+        upstream.get(), budget);
 
     using resource_type = mm::async_pool_resource<mm::memory_kind::device,
             pool_resource<memory_kind::device, coalescing_free_tree, spinlock>>;
-    auto rsrc = std::make_shared<resource_type>(upstream.get());
-    return make_shared_composite_resource(std::move(rsrc), std::move(upstream));
+    auto rsrc = std::make_shared<resource_type>(budgeted.get());
+    rsrc->set_cross_stream_reuse(MMEnv::get().cross_stream_reuse);
+    return make_shared_composite_resource(std::move(rsrc), std::move(budgeted),
+                                          std::move(upstream));
   }
 }
 
@@ -270,10 +396,25 @@ inline std::shared_ptr<pinned_async_resource> CreateDefaultPinnedResource() {
     return upstream;
   }
   static auto upstream = std::make_shared<pinned_malloc_memory_resource>();
+  auto budgeted = std::make_shared<budget_resource<memory_kind::pinned>>(
+      upstream.get(), &g_resources.pinned_budget);
+  using resource_type = mm::async_pool_resource<mm::memory_kind::pinned,
+      pool_resource<memory_kind::pinned, coalescing_free_tree, spinlock>>;
+  auto rsrc = std::make_shared<resource_type>(budgeted.get());
+  rsrc->set_cross_stream_reuse(MMEnv::get().cross_stream_reuse);
+  return make_shared_composite_resource(std::move(rsrc), std::move(budgeted), upstream);
+}
+
+inline std::shared_ptr<pinned_async_resource> CreateNumaPinnedResource(
+      const std::shared_ptr<numa_pinned_memory_resource> &upstream) {
+  // All the pinned pools share one budget
+  auto budgeted = std::make_shared<budget_resource<memory_kind::pinned>>(
+      upstream.get(), &g_resources.pinned_budget);
   using resource_type = mm::async_pool_resource<mm::memory_kind::pinned,
       pool_resource<memory_kind::pinned, coalescing_free_tree, spinlock>>;
-  auto rsrc = std::make_shared<resource_type>(upstream.get());
-  return make_shared_composite_resource(std::move(rsrc), upstream);
+  auto rsrc = std::make_shared<resource_type>(budgeted.get());
+  rsrc->set_cross_stream_reuse(MMEnv::get().cross_stream_reuse);
+  return make_shared_composite_resource(std::move(rsrc), std::move(budgeted), upstream);
 }
 
 inline std::shared_ptr<managed_async_resource> CreateDefaultManagedResource() {
@@ -290,18 +431,72 @@ const std::shared_ptr<host_memory_resource> &ShareDefaultResourceImpl<memory_kin
   if (!g_resources.host) {
     std::lock_guard<std::mutex> lock(g_resources.mtx);
     if (!g_resources.host)
-      g_resources.host = CreateDefaultHostResource();
+      g_resources.host = Traced(CreateDefaultHostResource());
   }
   return g_resources.host;
 }
 
+/**
+ * @brief Gets the NUMA node closest to the device or -1, if it's unknown
+ */
+int GetDeviceNumaNode(int device_id) {
+  if (device_id < 0) {
+    CUDA_CALL(cudaGetDevice(&device_id));
+  }
+  g_resources.InitDeviceResArray();
+  g_resources.CheckDeviceIndex(device_id);
+  int node = g_resources.device_numa_node[device_id];
+  if (node == kUnknownNumaNode) {
+    node = -1;
+#if NVML_ENABLED
+    try {
+      auto nvml_handle = nvml::NvmlInstance::CreateNvmlInstance();
+      node = nvml::GetNumaNode(device_id);
+    } catch (const std::exception &) {
+      node = -1;
+    }
+#endif  // NVML_ENABLED
+    if (node >= kMaxNumaNodes)
+      node = -1;
+    g_resources.device_numa_node[device_id] = node;
+  }
+  return node;
+}
+
+/**
+ * @brief Gets the pinned memory pool local to the current device or nullptr,
+ *        if the pools are not NUMA-aware.
+ */
+const std::shared_ptr<pinned_async_resource> *ShareNumaPinnedResourceImpl() {
+  if (!MMEnv::get().use_numa_pinned_mem_pool || g_resources.pinned_set_explicitly)
+    return nullptr;
+  int node = GetDeviceNumaNode(-1);
+  if (node < 0)
+    return nullptr;
+  if (!g_resources.pinned_numa[node]) {
+    std::lock_guard<std::mutex> lock(g_resources.mtx);
+    if (!g_resources.pinned_numa[node]) {
+      static CUDARTLoader init_cuda;  // force initialization of CUDA before creating the resource
+      auto upstream = std::make_shared<numa_pinned_memory_resource>(node);
+      g_resources.pinned_numa_upstream[node] = upstream;
+      g_resources.pinned_numa[node] = Traced(CreateNumaPinnedResource(upstream));
+      static auto cleanup = AtScopeExit([] {
+        g_resources.ReleasePinned();
+      });
+    }
+  }
+  return &g_resources.pinned_numa[node];
+}
+
 template <>
 const std::shared_ptr<pinned_async_resource> &ShareDefaultResourceImpl<memory_kind::pinned>() {
+  if (auto *numa = ShareNumaPinnedResourceImpl())
+    return *numa;
   if (!g_resources.pinned_async) {
     std::lock_guard<std::mutex> lock(g_resources.mtx);
     if (!g_resources.pinned_async) {
       static CUDARTLoader init_cuda;  // force initialization of CUDA before creating the resource
-      g_resources.pinned_async = CreateDefaultPinnedResource();
+      g_resources.pinned_async = Traced(CreateDefaultPinnedResource());
       static auto cleanup = AtScopeExit([] {
         g_resources.ReleasePinned();
       });
@@ -316,7 +511,7 @@ const std::shared_ptr<managed_async_resource> &ShareDefaultResourceImpl<memory_k
     std::lock_guard<std::mutex> lock(g_resources.mtx);
     if (!g_resources.managed) {
       static CUDARTLoader init_cuda;  // force initialization of CUDA before creating the resource
-      g_resources.managed = CreateDefaultManagedResource();
+      g_resources.managed = Traced(CreateDefaultManagedResource());
       static auto cleanup = AtScopeExit([] {
         g_resources.ReleaseManaged();
       });
@@ -336,7 +531,7 @@ const std::shared_ptr<device_async_resource> &ShareDefaultDeviceResourceImpl(int
     if (!g_resources.device[device_id]) {
       DeviceGuard devg(device_id);
       static CUDARTLoader init_cuda;  // force initialization of CUDA before creating the resource
-      g_resources.device[device_id] = CreateDefaultDeviceResource();
+      g_resources.device[device_id] = Traced(CreateDefaultDeviceResource());
       static auto cleanup = AtScopeExit([] {
         g_resources.ReleaseDevice();
       });
@@ -369,6 +564,7 @@ void SetDefaultResource<memory_kind::host>(host_memory_resource *resource, bool
 template <> DLL_PUBLIC
 void SetDefaultResource<memory_kind::pinned>(std::shared_ptr<pinned_async_resource> resource) {
   std::lock_guard<std::mutex> lock(g_resources.mtx);
+  g_resources.pinned_set_explicitly = resource != nullptr;
   g_resources.pinned_async = std::move(resource);
 }
 
@@ -397,6 +593,7 @@ void SetDefaultDeviceResource(int device_id, device_async_resource *resource, bo
 DLL_PUBLIC void _Test_FreeDeviceResources() {
   std::lock_guard<std::mutex> mtx(g_resources.mtx);
   g_resources.device.reset();
+  g_resources.device_numa_node.reset();
   g_resources.num_devices = 0;
 }
 
@@ -463,6 +660,8 @@ void ReleaseUnusedMemory() {
   }
 
   ReleaseUnusedMemory(g_resources.pinned_async.get());
+  for (auto &numa : g_resources.pinned_numa)
+    ReleaseUnusedMemory(numa.get());
   ReleaseUnusedMemory(g_resources.host.get());
 }
 
@@ -480,5 +679,199 @@ void PreallocatePinnedMemory(size_t bytes) {
   res->deallocate(mem, bytes);
 }
 
+DLL_PUBLIC
+int GetPinnedMemoryNumaNode(int device_id) {
+  if (!MMEnv::get().use_numa_pinned_mem_pool || g_resources.pinned_set_explicitly)
+    return -1;
+  return GetDeviceNumaNode(device_id);
+}
+
+DLL_PUBLIC
+PinnedMemoryStats GetPinnedMemoryStats(int numa_node) {
+  PinnedMemoryStats stats;
+  if (numa_node < 0 || numa_node >= kMaxNumaNodes)
+    return stats;
+  std::lock_guard<std::mutex> lock(g_resources.mtx);
+  if (auto &upstream = g_resources.pinned_numa_upstream[numa_node]) {
+    stats.allocated = upstream->allocated();
+    stats.peak_allocated = upstream->peak_allocated();
+  }
+  return stats;
+}
+
+namespace {
+
+template <typename Kind>
+pool_stats GetPoolStats(mm::memory_resource<Kind> *mr) {
+  while (mr) {
+    if (auto *pool = dynamic_cast<mm::pool_resource_base<Kind>*>(mr))
+      return pool->get_stats();
+    if (auto *up = dynamic_cast<mm::with_upstream<Kind>*>(mr)) {
+      mr = up->upstream();
+    } else {
+      break;
+    }
+  }
+  return {};
+}
+
+std::shared_ptr<device_async_resource> GetExistingDeviceResource(int device_id) {
+  std::lock_guard<std::mutex> lock(g_resources.mtx);
+  if (!g_resources.device || device_id < 0 || device_id >= g_resources.num_devices)
+    return nullptr;
+  return g_resources.device[device_id];
+}
+
+std::shared_ptr<pinned_async_resource> GetExistingPinnedResource(int numa_node) {
+  std::lock_guard<std::mutex> lock(g_resources.mtx);
+  if (numa_node >= 0 && numa_node < kMaxNumaNodes && !g_resources.pinned_set_explicitly)
+    return g_resources.pinned_numa[numa_node];
+  return g_resources.pinned_async;
+}
+
+void PrintPoolStats(std::ostream &os, const char *name, const pool_stats &stats) {
+  print(os, name,
+    ": reserved ", stats.reserved, " B in ", stats.upstream_blocks, " blocks"
+    ", allocated ", stats.allocated, " B (peak ", stats.peak_allocated, " B)"
+    ", free ", stats.free, " B in ", stats.free_blocks, " blocks"
+    " (largest ", stats.largest_free_block, " B)"
+    ", pending frees ", stats.pending_free, " B in ", stats.pending_free_blocks, " blocks"
+    " on ", stats.pending_free_streams, " streams\n");
+}
+
+void LogPoolStats(std::ostream &os) {
+  for (int i = 0; i < g_resources.num_devices; i++) {
+    if (auto rsrc = GetExistingDeviceResource(i))
+      PrintPoolStats(os, make_string("Device ", i, " memory pool").c_str(),
+                     GetPoolStats<memory_kind::device>(rsrc.get()));
+  }
+  for (int node = 0; node < kMaxNumaNodes; node++) {
+    std::shared_ptr<pinned_async_resource> rsrc;
+    {
+      std::lock_guard<std::mutex> lock(g_resources.mtx);
+      rsrc = g_resources.pinned_numa[node];
+    }
+    if (rsrc)
+      PrintPoolStats(os, make_string("NUMA node ", node, " pinned memory pool").c_str(),
+                     GetPoolStats<memory_kind::pinned>(rsrc.get()));
+  }
+  if (auto rsrc = GetExistingPinnedResource(-1))
+    PrintPoolStats(os, "Pinned memory pool", GetPoolStats<memory_kind::pinned>(rsrc.get()));
+}
+
+class PoolStatsLogger {
+ public:
+  static PoolStatsLogger &instance() {
+    (void)g_resources;  // make sure that the resources outlive the logger
+    static PoolStatsLogger logger;
+    return logger;
+  }
+
+  ~PoolStatsLogger() {
+    Stop();
+  }
+
+  void SetInterval(double seconds) {
+    std::lock_guard<std::mutex> guard(set_mtx_);
+    Stop();
+    if (seconds <= 0)
+      return;
+    interval_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(seconds));
+    stop_ = false;
+    thread_ = std::thread([this]() { Run(); });
+  }
+
+ private:
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> guard(mtx_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable())
+      thread_.join();
+  }
+
+  void Run() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    while (!cv_.wait_for(lock, interval_, [&]() { return stop_; })) {
+      lock.unlock();
+      LogPoolStats(std::cerr);
+      lock.lock();
+    }
+  }
+
+  std::mutex set_mtx_, mtx_;
+  std::condition_variable cv_;
+  std::thread thread_;
+  std::chrono::steady_clock::duration interval_{};
+  bool stop_ = false;
+};
+
+}  // namespace
+
+DLL_PUBLIC
+pool_stats GetDevicePoolStats(int device_id) {
+  if (device_id < 0) {
+    CUDA_CALL(cudaGetDevice(&device_id));
+  }
+  auto rsrc = GetExistingDeviceResource(device_id);
+  return rsrc ? GetPoolStats<memory_kind::device>(rsrc.get()) : pool_stats{};
+}
+
+DLL_PUBLIC
+pool_stats GetPinnedPoolStats(int device_id) {
+  auto rsrc = GetExistingPinnedResource(GetPinnedMemoryNumaNode(device_id));
+  return rsrc ? GetPoolStats<memory_kind::pinned>(rsrc.get()) : pool_stats{};
+}
+
+DLL_PUBLIC
+std::shared_ptr<alloc_trace> GetDefaultResourceTrace() {
+  return DefaultResourceTrace();
+}
+
+DLL_PUBLIC
+void SetPoolStatsLogInterval(double interval_seconds) {
+  PoolStatsLogger::instance().SetInterval(interval_seconds);
+}
+
+DLL_PUBLIC
+void SetDeviceMemoryBudget(size_t bytes) {
+  g_resources.InitDeviceResArray();
+  g_resources.device_budget_limit = bytes;
+  for (int i = 0; i < g_resources.num_devices; i++)
+    g_resources.device_budget[i].limit = bytes;
+}
+
+DLL_PUBLIC
+size_t GetDeviceMemoryBudget() {
+  return g_resources.device_budget_limit;
+}
+
+DLL_PUBLIC
+void SetPinnedMemoryBudget(size_t bytes) {
+  g_resources.pinned_budget.limit = bytes;
+}
+
+DLL_PUBLIC
+size_t GetPinnedMemoryBudget() {
+  return g_resources.pinned_budget.limit;
+}
+
+DLL_PUBLIC
+bool IsDeviceMemoryUnderPressure(int device_id) {
+  if (device_id < 0)
+    CUDA_CALL(cudaGetDevice(&device_id));
+  g_resources.InitDeviceResArray();
+  g_resources.CheckDeviceIndex(device_id);
+  return g_resources.device_budget[device_id].under_pressure();
+}
+
+DLL_PUBLIC
+bool IsPinnedMemoryUnderPressure() {
+  return g_resources.pinned_budget.under_pressure();
+}
+
 }  // namespace mm
 }  // namespace dali
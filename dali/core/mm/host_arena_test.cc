@@ -0,0 +1,87 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include "dali/core/mm/host_arena.h"
+#include "dali/core/mm/mm_test_utils.h"
+
+namespace dali {
+namespace mm {
+namespace test {
+
+TEST(MMHostArena, ReuseAfterReset) {
+  test_host_resource upstream;
+  {
+    host_arena arena(&upstream, 1024);
+    EXPECT_EQ(upstream.get_num_allocs(), 1u);
+    void *m1 = arena.allocate(100);
+    void *m2 = arena.allocate(200, 64);
+    EXPECT_TRUE(detail::is_aligned(m2, 64));
+    EXPECT_GE(static_cast<char *>(m2), static_cast<char *>(m1) + 100);
+    arena.reset();
+    EXPECT_EQ(arena.allocate(100), m1);
+    EXPECT_EQ(upstream.get_num_allocs(), 1u);
+  }
+  EXPECT_EQ(upstream.get_current_size(), 0u);
+}
+
+TEST(MMHostArena, GrowsToPeakUsage) {
+  test_host_resource upstream;
+  {
+    host_arena arena(&upstream);
+    for (int i = 0; i < 100; i++)
+      memset(arena.allocate(1000, 16), i, 1000);
+    size_t used = arena.used();
+    EXPECT_GE(used, 100000u);
+    arena.reset();
+    EXPECT_GE(arena.capacity(), used);
+    size_t allocs = upstream.get_num_allocs();
+    for (int iter = 0; iter < 3; iter++) {
+      for (int i = 0; i < 100; i++)
+        memset(arena.allocate(1000, 16), i, 1000);
+      arena.reset();
+    }
+    EXPECT_EQ(upstream.get_num_allocs(), allocs);
+  }
+  EXPECT_EQ(upstream.get_current_size(), 0u);
+}
+
+TEST(MMHostArena, Allocator) {
+  test_host_resource upstream;
+  {
+    host_arena arena(&upstream);
+    arena_vector<int> v(&arena);
+    for (int i = 0; i < 1000; i++)
+      v.push_back(i);
+    arena_small_vector<int64_t, 4> sv(&arena);
+    for (int i = 0; i < 1000; i++)
+      sv.push_back(i);
+    for (int i = 0; i < 1000; i++) {
+      ASSERT_EQ(v[i], i);
+      ASSERT_EQ(sv[i], i);
+    }
+    EXPECT_GE(arena.used(), 1000 * (sizeof(int) + sizeof(int64_t)));
+  }
+  EXPECT_EQ(upstream.get_current_size(), 0u);
+
+  // a default-constructed allocator uses the heap
+  arena_vector<int> v;
+  v.resize(1000, 42);
+  EXPECT_EQ(v[999], 42);
+}
+
+}  // namespace test
+}  // namespace mm
+}  // namespace dali
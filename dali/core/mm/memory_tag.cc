@@ -0,0 +1,70 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utility>
+#include "dali/core/mm/memory_tag.h"
+
+namespace dali {
+namespace mm {
+
+namespace {
+
+thread_local MemoryTagContext tls_memory_tag_context;
+
+}  // namespace
+
+const char *MemoryTagName(MemoryTag tag) {
+  switch (tag) {
+    case MemoryTag::Other:
+      return "other";
+    case MemoryTag::Output:
+      return "output";
+    case MemoryTag::Scratch:
+      return "scratch";
+    case MemoryTag::Staging:
+      return "staging";
+    case MemoryTag::Cache:
+      return "cache";
+    default:
+      return "<invalid>";
+  }
+}
+
+void MemoryTracker::Allocated(MemoryTag tag, memory_kind_id kind, size_t bytes) noexcept {
+  auto &c = counter(tag, kind);
+  int64_t current = c.current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  int64_t peak = c.peak.load(std::memory_order_relaxed);
+  while (current > peak && !c.peak.compare_exchange_weak(peak, current,
+                                                        std::memory_order_relaxed)) {}
+}
+
+void MemoryTracker::ResetPeak() noexcept {
+  for (auto &tag_counters : counters_)
+    for (auto &c : tag_counters)
+      c.peak.store(c.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+const MemoryTagContext &GetMemoryTagContext() noexcept {
+  return tls_memory_tag_context;
+}
+
+MemoryTagScope::MemoryTagScope(MemoryTagContext ctx)
+: prev_(std::exchange(tls_memory_tag_context, std::move(ctx))) {}
+
+MemoryTagScope::~MemoryTagScope() {
+  tls_memory_tag_context = std::move(prev_);
+}
+
+}  // namespace mm
+}  // namespace dali
@@ -0,0 +1,83 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include "dali/core/mm/memory.h"
+#include "dali/core/mm/memory_tag.h"
+
+namespace dali {
+namespace mm {
+namespace test {
+
+TEST(MMMemoryTag, TrackAllocations) {
+  auto tracker = std::make_shared<MemoryTracker>();
+  uptr<char> a, b;
+  std::shared_ptr<char> c;
+  {
+    MemoryTagScope scope(tracker, MemoryTag::Other);
+    a = alloc_raw_unique<char, memory_kind::host>(1000);
+    {
+      MemoryTagScope tag(MemoryTag::Scratch);
+      b = alloc_raw_unique<char, memory_kind::host>(200);
+      EXPECT_EQ(GetMemoryTagContext().tracker, tracker);
+      EXPECT_EQ(GetMemoryTagContext().tag, MemoryTag::Scratch);
+    }
+    EXPECT_EQ(GetMemoryTagContext().tag, MemoryTag::Other);
+    c = alloc_raw_shared<char, memory_kind::host>(300);
+  }
+  EXPECT_EQ(GetMemoryTagContext().tracker, nullptr);
+  // not tracked
+  auto d = alloc_raw_unique<char, memory_kind::host>(5000);
+
+  auto other = tracker->Get(MemoryTag::Other, memory_kind_id::host);
+  auto scratch = tracker->Get(MemoryTag::Scratch, memory_kind_id::host);
+  EXPECT_EQ(other.current, 1300);
+  EXPECT_EQ(other.peak, 1300);
+  EXPECT_EQ(scratch.current, 200);
+  EXPECT_EQ(tracker->Get(MemoryTag::Output, memory_kind_id::host).peak, 0);
+
+  a.reset();
+  c.reset();
+  other = tracker->Get(MemoryTag::Other, memory_kind_id::host);
+  EXPECT_EQ(other.current, 0);
+  EXPECT_EQ(other.peak, 1300);
+
+  tracker->ResetPeak();
+  EXPECT_EQ(tracker->Get(MemoryTag::Other, memory_kind_id::host).peak, 0);
+  EXPECT_EQ(tracker->Get(MemoryTag::Scratch, memory_kind_id::host).peak, 200);
+
+  // the tracker is kept alive by the allocations made in its context
+  std::weak_ptr<MemoryTracker> weak = tracker;
+  tracker.reset();
+  EXPECT_FALSE(weak.expired());
+  b.reset();
+  EXPECT_TRUE(weak.expired());
+}
+
+TEST(MMMemoryTag, ThreadLocal) {
+  auto tracker = std::make_shared<MemoryTracker>();
+  MemoryTagScope scope(tracker, MemoryTag::Cache);
+  std::thread t([]() {
+    EXPECT_EQ(GetMemoryTagContext().tracker, nullptr);
+    auto mem = alloc_raw_unique<char, memory_kind::host>(100);
+  });
+  t.join();
+  EXPECT_EQ(tracker->Get(MemoryTag::Cache, memory_kind_id::host).peak, 0);
+}
+
+}  // namespace test
+}  // namespace mm
+}  // namespace dali
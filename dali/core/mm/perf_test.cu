@@ -1,4 +1,4 @@
-// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,14 +15,23 @@
 #include <gtest/gtest.h>
 #include <chrono>
 #include <cmath>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <random>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
+#include "dali/core/mm/async_pool.h"
+#include "dali/core/mm/binning_resource.h"
 #include "dali/core/mm/default_resources.h"
 #include "dali/core/mm/malloc_resource.h"
+#include "dali/core/mm/pool_resource.h"
+#include "dali/core/mm/tracing_resource.h"
+#include "dali/core/format.h"
 #include "dali/core/spinlock.h"
 #include "dali/core/cuda_stream.h"
 #include "dali/core/cuda_stream_pool.h"
@@ -194,6 +203,205 @@ TEST(MMPerfTest, CudaMallocAsync) {
 }
 #endif
 
+/**
+ * @brief Returns the device allocation trace to replay
+ *
+ * The trace is read from the file given in DALI_MM_REPLAY_TRACE (see DALI_MM_TRACE_FILE);
+ * otherwise, a synthetic trace resembling a pipeline is generated: in each iteration,
+ * the operators allocate their outputs, which are freed a few iterations later (the queue),
+ * and some scratch memory, freed at the end of the operator's run.
+ */
+std::vector<alloc_trace_event> GetReplayTrace() {
+  if (const char *file = std::getenv("DALI_MM_REPLAY_TRACE")) {
+    std::ifstream f(file);
+    if (!f.good())
+      throw std::runtime_error(make_string("Cannot open the allocation trace: ", file));
+    return alloc_trace::read(f);
+  }
+  std::vector<alloc_trace_event> trace;
+  std::mt19937_64 rng(1234);
+  std::uniform_real_distribution<float> size_log_dist(8, 24);
+  std::uniform_real_distribution<float> jitter_dist(0.8, 1.2);
+  const int num_ops = 8, queue_depth = 2, num_iters = 1000;
+  const uint64_t streams[2] = { 0x1000, 0x2000 };
+  std::vector<size_t> base_sizes(num_ops);
+  for (auto &size : base_sizes)
+    size = powf(2, size_log_dist(rng));
+  uint64_t id = 0;
+  int64_t time = 0;
+  auto add = [&](bool is_free, uint64_t alloc_id, size_t size, uint64_t stream) {
+    alloc_trace_event e;
+    e.time = time++;
+    e.id = alloc_id;
+    e.size = size;
+    e.alignment = 256;
+    e.stream = stream;
+    e.kind = memory_kind_id::device;
+    e.is_free = is_free;
+    trace.push_back(e);
+  };
+  std::vector<std::vector<std::pair<uint64_t, size_t>>> outputs(num_iters);
+  for (int iter = 0; iter < num_iters; iter++) {
+    for (int op = 0; op < num_ops; op++) {
+      uint64_t stream = streams[op % 2];
+      // the sizes of the variable batches
+      size_t out_size = base_sizes[op] * jitter_dist(rng);
+      outputs[iter].emplace_back(++id, out_size);
+      add(false, id, out_size, stream);
+      size_t scratch_size = base_sizes[(op + 1) % num_ops] / 4 + 1;
+      add(false, ++id, scratch_size, stream);
+      add(true, id, scratch_size, stream);
+    }
+    if (iter >= queue_depth) {
+      for (auto &[out_id, size] : outputs[iter - queue_depth])
+        add(true, out_id, size, streams[1]);
+    }
+  }
+  return trace;
+}
+
+template <typename Kind>
+pool_stats GetReplayPoolStats(memory_resource<Kind> *mr) {
+  while (mr) {
+    if (auto *pool = dynamic_cast<pool_resource_base<Kind> *>(mr))
+      return pool->get_stats();
+    auto *up = dynamic_cast<with_upstream<Kind> *>(mr);
+    mr = up ? up->upstream() : nullptr;
+  }
+  return {};
+}
+
+/**
+ * @brief Replays the allocations of given kind from the trace, in the order of the trace
+ *
+ * The streams of the trace are mapped to distinct streams. The resources without stream
+ * semantics replay the stream-ordered requests in host order.
+ * The replay doesn't reproduce the timing and the concurrency of the trace - it measures
+ * the cost of the allocator itself.
+ */
+template <typename Resource>
+void ReplayTrace(Resource *res, const std::vector<alloc_trace_event> &trace,
+                 memory_kind_id kind = memory_kind_id::device) {
+  using Kind = typename Resource::memory_kind;
+  constexpr bool is_async = std::is_base_of_v<async_memory_resource<Kind>, Resource>;
+  std::unordered_map<uint64_t, CUDAStreamLease> streams;
+  auto get_stream = [&](uint64_t trace_stream) -> cudaStream_t {
+    auto &lease = streams[trace_stream];
+    if (!lease)
+      lease = CUDAStreamPool::instance().Get();
+    return lease.get();
+  };
+  struct Alloc {
+    void *ptr;
+    size_t size, alignment;
+  };
+  std::unordered_map<uint64_t, Alloc> live;
+  perf_timer::duration alloc_time = {}, dealloc_time = {};
+  int64_t num_allocs = 0, num_deallocs = 0;
+
+  for (auto &e : trace) {
+    if (e.kind != kind)
+      continue;
+    bool host_order = !is_async || e.stream == alloc_trace_event::host_order;
+    if (!e.is_free) {
+      auto it = live.find(e.id);
+      if (it != live.end()) {  // the deallocation is missing from the trace
+        res->deallocate(it->second.ptr, it->second.size, it->second.alignment);
+        live.erase(it);
+      }
+      size_t alignment = e.alignment ? e.alignment : 256;
+      void *ptr;
+      auto start = perf_timer::now();
+      if constexpr (is_async) {
+        ptr = host_order ? res->allocate(e.size, alignment)
+                         : res->allocate_async(e.size, alignment, get_stream(e.stream));
+      } else {
+        ptr = res->allocate(e.size, alignment);
+      }
+      alloc_time += perf_timer::now() - start;
+      num_allocs++;
+      live[e.id] = { ptr, e.size, alignment };
+    } else {
+      auto it = live.find(e.id);
+      if (it == live.end())  // allocated before the trace started
+        continue;
+      auto &a = it->second;
+      auto start = perf_timer::now();
+      if constexpr (is_async) {
+        if (host_order)
+          res->deallocate(a.ptr, a.size, a.alignment);
+        else
+          res->deallocate_async(a.ptr, a.size, a.alignment, get_stream(e.stream));
+      } else {
+        res->deallocate(a.ptr, a.size, a.alignment);
+      }
+      dealloc_time += perf_timer::now() - start;
+      num_deallocs++;
+      live.erase(it);
+    }
+  }
+  auto stats = GetReplayPoolStats<Kind>(res);
+  for (auto &[id, a] : live)
+    res->deallocate(a.ptr, a.size, a.alignment);
+  for (auto &[trace_stream, lease] : streams)
+    CUDA_CALL(cudaStreamSynchronize(lease.get()));
+
+  double mean_alloc_time = seconds(alloc_time) / std::max<int64_t>(num_allocs, 1);
+  double mean_dealloc_time = seconds(dealloc_time) / std::max<int64_t>(num_deallocs, 1);
+  print(std::cout,
+    "# allocations:           ", num_allocs, "\n"
+    "# deallocations:         ", num_deallocs, "\n"
+    "Allocation time:         ", format_time(mean_alloc_time), "\n"
+    "Deallocation time:       ", format_time(mean_dealloc_time), "\n");
+  if (stats.upstream_blocks > 0)
+    print(std::cout,
+      "Peak allocated:          ", stats.peak_allocated, " B\n"
+      "Reserved:                ", stats.reserved, " B in ", stats.upstream_blocks, " blocks\n");
+}
+
+TEST(MMPerfTest, ReplayTrace_DefaultGPUAlloc) {
+  auto trace = GetReplayTrace();
+  ReplayTrace(mm::GetDefaultDeviceResource(0), trace);
+}
+
+TEST(MMPerfTest, ReplayTrace_AsyncPool) {
+  auto trace = GetReplayTrace();
+  cuda_malloc_memory_resource upstream;
+  async_pool_resource<memory_kind::device,
+                      pool_resource<memory_kind::device, coalescing_free_tree, spinlock>>
+      res(&upstream);
+  ReplayTrace(&res, trace);
+}
+
+TEST(MMPerfTest, ReplayTrace_Pool) {
+  auto trace = GetReplayTrace();
+  cuda_malloc_memory_resource upstream;
+  pool_resource<memory_kind::device, coalescing_free_tree, spinlock> res(&upstream);
+  ReplayTrace(&res, trace);
+}
+
+TEST(MMPerfTest, ReplayTrace_Binning) {
+  auto trace = GetReplayTrace();
+  cuda_malloc_memory_resource upstream;
+  using pool_t = pool_resource<memory_kind::device, coalescing_free_tree, spinlock>;
+  // the small allocations are kept apart from the large ones, to limit the fragmentation
+  pool_t small(&upstream), large(&upstream);
+  std::array<size_t, 1> thresholds = {{ 1 << 16 }};
+  std::array<pool_t *, 2> resources = {{ &small, &large }};
+  binning_resource<memory_kind::device, 2> res(thresholds, resources);
+  ReplayTrace(&res, trace);
+}
+
+#if CUDA_VERSION >= 11020
+TEST(MMPerfTest, ReplayTrace_CudaMallocAsync) {
+  if (!cuda_malloc_async_memory_resource::is_supported())
+    GTEST_SKIP() << "cudaMallocAsync not supported";
+  auto trace = GetReplayTrace();
+  cuda_malloc_async_memory_resource res;
+  ReplayTrace(&res, trace);
+}
+#endif
+
 }  // namespace test
 }  // namespace mm
 }  // namespace dali
@@ -91,6 +91,42 @@ TEST(MMPoolResource, CoalescingFreeTree) {
   TestPoolResource<coalescing_free_tree>(100000);
 }
 
+TEST(MMPoolResource, Stats) {
+  test_host_resource upstream;
+  {
+    pool_resource<memory_kind::host, coalescing_free_tree, detail::dummy_lock> pool(&upstream);
+    auto stats = pool.get_stats();
+    EXPECT_EQ(stats.reserved, 0u);
+    EXPECT_EQ(stats.allocated, 0u);
+
+    void *p1 = pool.allocate(1000);
+    void *p2 = pool.allocate(3000);
+    stats = pool.get_stats();
+    EXPECT_EQ(stats.allocated, 4000u);
+    EXPECT_EQ(stats.peak_allocated, 4000u);
+    EXPECT_GE(stats.upstream_blocks, 1u);
+    EXPECT_EQ(stats.reserved, static_cast<size_t>(upstream.get_current_size()));
+    EXPECT_EQ(stats.reserved, stats.allocated + stats.free);
+    EXPECT_LE(stats.largest_free_block, stats.free);
+
+    pool.deallocate(p1, 1000);
+    stats = pool.get_stats();
+    EXPECT_EQ(stats.allocated, 3000u);
+    EXPECT_EQ(stats.peak_allocated, 4000u);
+    EXPECT_EQ(stats.reserved, stats.allocated + stats.free);
+    EXPECT_GE(stats.largest_free_block, 1000u);
+    EXPECT_GE(stats.free_blocks, 1u);
+
+    pool.deallocate(p2, 3000);
+    stats = pool.get_stats();
+    EXPECT_EQ(stats.allocated, 0u);
+    EXPECT_EQ(stats.peak_allocated, 4000u);
+    EXPECT_EQ(stats.free, stats.reserved);
+    EXPECT_LE(stats.free_blocks, stats.upstream_blocks);
+  }
+  upstream.check_leaks();
+}
+
 TEST(MMPoolResource, ReturnToUpstream) {
   cudaDeviceProp device_prop;
   CUDA_CALL(cudaGetDeviceProperties(&device_prop, 0));
@@ -0,0 +1,92 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "dali/core/mm/tracing_resource.h"
+#include "dali/core/format.h"
+
+namespace dali {
+namespace mm {
+
+void alloc_trace::record(bool is_free, memory_kind_id kind, void *ptr, size_t size,
+                         size_t alignment, uint64_t stream) {
+  alloc_trace_event e;
+  e.is_free = is_free;
+  e.kind = kind;
+  e.id = reinterpret_cast<uintptr_t>(ptr);
+  e.size = size;
+  e.alignment = alignment;
+  e.stream = stream;
+  static thread_local int64_t tid = syscall(SYS_gettid);
+  e.thread = tid;
+  std::lock_guard g(mtx_);
+  e.time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start_).count();
+  events_.push_back(e);
+}
+
+std::vector<alloc_trace_event> alloc_trace::events() const {
+  std::lock_guard g(mtx_);
+  return events_;
+}
+
+void alloc_trace::clear() {
+  std::lock_guard g(mtx_);
+  events_.clear();
+}
+
+void alloc_trace::write(std::ostream &os) const {
+  for (auto &e : events()) {
+    os << e.time << (e.is_free ? " f " : " a ") << static_cast<int>(e.kind) << " " << e.id
+       << " " << e.size << " " << e.alignment << " ";
+    if (e.stream == alloc_trace_event::host_order)
+      os << "host";
+    else
+      os << e.stream;
+    os << " " << e.thread << "\n";
+  }
+}
+
+std::vector<alloc_trace_event> alloc_trace::read(std::istream &is) {
+  std::vector<alloc_trace_event> events;
+  std::string line;
+  for (int line_no = 1; std::getline(is, line); line_no++) {
+    if (line.empty() || line[0] == '#')
+      continue;
+    std::istringstream ls(line);
+    alloc_trace_event e;
+    char op = 0;
+    int kind = -1;
+    std::string stream;
+    ls >> e.time >> op >> kind >> e.id >> e.size >> e.alignment >> stream >> e.thread;
+    if (!ls || (op != 'a' && op != 'f') || kind < 0 || kind >= memory_kind_id::count)
+      throw std::invalid_argument(make_string("Malformed allocation trace at line ", line_no,
+                                              ": \"", line, "\""));
+    e.is_free = op == 'f';
+    e.kind = static_cast<memory_kind_id>(kind);
+    e.stream = stream == "host" ? alloc_trace_event::host_order : std::stoull(stream);
+    events.push_back(e);
+  }
+  return events;
+}
+
+}  // namespace mm
+}  // namespace dali
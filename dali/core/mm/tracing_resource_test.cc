@@ -0,0 +1,85 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "dali/core/mm/malloc_resource.h"
+#include "dali/core/mm/tracing_resource.h"
+
+namespace dali {
+namespace mm {
+namespace test {
+
+TEST(MMTracingResource, RecordAndReplayFormat) {
+  auto upstream = std::make_shared<malloc_memory_resource>();
+  auto trace = std::make_shared<alloc_trace>();
+  tracing_resource<memory_resource<memory_kind::host>> res(upstream, trace);
+  EXPECT_EQ(res.upstream(), upstream.get());
+
+  void *a = res.allocate(100, 16);
+  void *b = res.allocate(2000, 64);
+  res.deallocate(a, 100, 16);
+  res.deallocate(b, 2000, 64);
+
+  auto events = trace->events();
+  ASSERT_EQ(events.size(), 4u);
+  EXPECT_FALSE(events[0].is_free);
+  EXPECT_EQ(events[0].id, reinterpret_cast<uintptr_t>(a));
+  EXPECT_EQ(events[0].size, 100u);
+  EXPECT_EQ(events[0].alignment, 16u);
+  EXPECT_EQ(events[0].stream, alloc_trace_event::host_order);
+  EXPECT_EQ(events[0].kind, memory_kind_id::host);
+  EXPECT_TRUE(events[2].is_free);
+  EXPECT_EQ(events[2].id, events[0].id);
+  for (size_t i = 1; i < events.size(); i++)
+    EXPECT_GE(events[i].time, events[i - 1].time);
+
+  std::stringstream ss;
+  trace->write(ss);
+  auto read = alloc_trace::read(ss);
+  ASSERT_EQ(read.size(), events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    EXPECT_EQ(read[i].time, events[i].time);
+    EXPECT_EQ(read[i].id, events[i].id);
+    EXPECT_EQ(read[i].size, events[i].size);
+    EXPECT_EQ(read[i].alignment, events[i].alignment);
+    EXPECT_EQ(read[i].stream, events[i].stream);
+    EXPECT_EQ(read[i].thread, events[i].thread);
+    EXPECT_EQ(read[i].kind, events[i].kind);
+    EXPECT_EQ(read[i].is_free, events[i].is_free);
+  }
+
+  trace->clear();
+  EXPECT_TRUE(trace->events().empty());
+}
+
+TEST(MMTracingResource, ReadStreamAndErrors) {
+  std::stringstream ss("# comment\n10 a 2 4096 256 256 12345 7\n20 f 2 4096 256 256 host 7\n");
+  auto events = alloc_trace::read(ss);
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].kind, memory_kind_id::device);
+  EXPECT_EQ(events[0].stream, 12345u);
+  EXPECT_EQ(events[1].stream, alloc_trace_event::host_order);
+  EXPECT_TRUE(events[1].is_free);
+
+  std::stringstream bad("10 x 2 4096 256 256 host 7\n");
+  EXPECT_THROW(alloc_trace::read(bad), std::invalid_argument);
+}
+
+}  // namespace test
+}  // namespace mm
+}  // namespace dali
@@ -20,6 +20,7 @@
 #include <unistd.h>
 #include <cstring>
 #include <exception>
+#include <string>
 
 #include "dali/core/format.h"
 #include "dali/core/os/shared_mem.h"
@@ -84,6 +85,24 @@ ShmHandle ShmHandle::CreateHandle() {
   return fd;
 }
 
+ShmHandle ShmHandle::OpenNamed(const std::string &name, bool *created) {
+  std::string path = "/" + name;
+  auto fd = ShmHandle(shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR));
+  bool is_new = !!fd;
+  if (!fd && errno == EEXIST)
+    fd = ShmHandle(shm_open(path.c_str(), O_RDWR, S_IRUSR | S_IWUSR));
+  POSIX_CHECK_STATUS_EX(fd ? 0 : -1, "shm_open", make_string("Cannot open ", path, "."));
+  if (created)
+    *created = is_new;
+  return fd;
+}
+
+void ShmHandle::Unlink(const std::string &name) {
+  std::string path = "/" + name;
+  if (shm_unlink(path.c_str()) == -1 && errno != ENOENT)
+    POSIX_CHECK_STATUS(-1, "shm_unlink");
+}
+
 void ShmHandle::DestroyHandle(shm_handle_t h) {
   if (h >= 0) {
     POSIX_CALL(::close(h));
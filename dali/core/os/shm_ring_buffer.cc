@@ -0,0 +1,196 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/core/os/shm_ring_buffer.h"
+#include <sys/stat.h>
+#include <cstring>
+#include <new>
+#include "dali/core/format.h"
+#include "dali/core/util.h"
+
+namespace dali {
+
+/**
+ * @brief The control block, at the beginning of the shared memory
+ *
+ * The positions are the total numbers of bytes written and released; they're modified only by
+ * the producer and only by the consumer, respectively. The offset in the data region is the
+ * position modulo the capacity.
+ */
+struct ShmRingBuffer::Header {
+  static constexpr uint64_t kMagic = 0x676e6952696c6144ull;  // "DaliRing"
+  uint64_t magic;
+  uint64_t capacity;
+  alignas(kAlignment) std::atomic<uint64_t> write_pos;
+  alignas(kAlignment) std::atomic<uint64_t> release_pos;
+};
+
+namespace {
+
+/** The size stored in the record header when the rest of the data region is skipped. */
+constexpr uint64_t kWrapMarker = ~0ull;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "The ring buffer requires lock-free 64-bit atomics.");
+
+}  // namespace
+
+ShmRingBuffer::ShmRingBuffer(shm_handle_t handle, uint64_t size) : shm_(handle, size) {}
+
+std::unique_ptr<ShmRingBuffer> ShmRingBuffer::Create(uint64_t capacity) {
+  DALI_ENFORCE(capacity > kAlignment, make_string(
+      "The capacity of the ring buffer must be larger than ", kAlignment, " bytes."));
+  static_assert(sizeof(Header) <= kHeaderSize);
+  capacity = align_up(capacity, kAlignment);
+  std::unique_ptr<ShmRingBuffer> rb(new ShmRingBuffer(-1, kHeaderSize + capacity));
+  rb->capacity_ = capacity;
+  auto *h = new (rb->shm_.get_raw_ptr()) Header();
+  h->capacity = capacity;
+  h->write_pos.store(0, std::memory_order_relaxed);
+  h->release_pos.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  h->magic = Header::kMagic;
+  return rb;
+}
+
+std::unique_ptr<ShmRingBuffer> ShmRingBuffer::Attach(shm_handle_t handle) {
+  struct stat st;
+  if (fstat(handle, &st) == -1) {
+    ShmHandle::DestroyHandle(handle);
+    POSIX_CHECK_STATUS(-1, "fstat");
+  }
+  DALI_ENFORCE(static_cast<uint64_t>(st.st_size) > kHeaderSize,
+               "The shared memory object is too small to be a ring buffer.");
+  std::unique_ptr<ShmRingBuffer> rb(new ShmRingBuffer(handle, st.st_size));
+  auto *h = rb->header();
+  DALI_ENFORCE(h->magic == Header::kMagic && h->capacity + kHeaderSize <= rb->shm_.size(),
+               "The shared memory object is not a ring buffer.");
+  rb->capacity_ = h->capacity;
+  rb->read_pos_ = h->release_pos.load(std::memory_order_acquire);
+  return rb;
+}
+
+ShmRingBuffer::Header *ShmRingBuffer::header() {
+  return reinterpret_cast<Header *>(shm_.get_raw_ptr());
+}
+
+uint8_t *ShmRingBuffer::data() {
+  return shm_.get_raw_ptr() + kHeaderSize;
+}
+
+uint8_t *ShmRingBuffer::TryReserve(uint64_t size) {
+  DALI_ENFORCE(!reservation_.active, "The previously reserved record was not committed.");
+  DALI_ENFORCE(size <= max_record_size(), make_string(
+      "The record of ", size, " bytes doesn't fit in the ring buffer; the maximum size is ",
+      max_record_size(), " bytes."));
+  auto *h = header();
+  uint64_t extent = kAlignment + align_up(size, kAlignment);
+  uint64_t pos = h->write_pos.load(std::memory_order_relaxed);
+  uint64_t released = h->release_pos.load(std::memory_order_acquire);
+  uint64_t offset = pos % capacity_;
+  // the records are contiguous - if it doesn't fit before the end, the rest is skipped
+  uint64_t skip = offset + extent > capacity_ ? capacity_ - offset : 0;
+  if (pos + skip + extent - released > capacity_)
+    return nullptr;
+  reservation_.pos = pos;
+  reservation_.skip = skip;
+  reservation_.size = size;
+  reservation_.extent = extent;
+  reservation_.active = true;
+  return data() + (pos + skip) % capacity_ + kAlignment;
+}
+
+void ShmRingBuffer::Commit() {
+  DALI_ENFORCE(reservation_.active, "There's no reserved record to commit.");
+  auto &r = reservation_;
+  if (r.skip)
+    std::memcpy(data() + r.pos % capacity_, &kWrapMarker, sizeof(kWrapMarker));
+  std::memcpy(data() + (r.pos + r.skip) % capacity_, &r.size, sizeof(r.size));
+  header()->write_pos.store(r.pos + r.skip + r.extent, std::memory_order_release);
+  r.active = false;
+}
+
+bool ShmRingBuffer::ReadNext(span<uint8_t> &record, uint64_t &pos) {
+  uint64_t written = header()->write_pos.load(std::memory_order_acquire);
+  if (read_pos_ == written)
+    return false;
+  uint64_t offset = read_pos_ % capacity_;
+  uint64_t skip = 0;
+  uint64_t size;
+  std::memcpy(&size, data() + offset, sizeof(size));
+  if (size == kWrapMarker) {
+    skip = capacity_ - offset;
+    offset = 0;
+    std::memcpy(&size, data(), sizeof(size));
+  }
+  uint64_t extent = skip + kAlignment + align_up(size, kAlignment);
+  pos = read_pos_;
+  read_.push_back({pos, extent, false});
+  read_pos_ += extent;
+  record = {data() + offset + kAlignment, static_cast<span_extent_t>(size)};
+  return true;
+}
+
+span<uint8_t> ShmRingBuffer::TryRead() {
+  std::lock_guard<std::mutex> g(read_mtx_);
+  span<uint8_t> record;
+  uint64_t pos;
+  ReadNext(record, pos);
+  return record;
+}
+
+void ShmRingBuffer::Release() {
+  std::lock_guard<std::mutex> g(read_mtx_);
+  auto it = read_.begin();
+  while (it != read_.end() && it->done)
+    ++it;
+  DALI_ENFORCE(it != read_.end(), "There are no records to release.");
+  it->done = true;
+  ReleaseDone();
+}
+
+void ShmRingBuffer::ReleaseDone() {
+  if (read_.empty() || !read_.front().done)
+    return;
+  uint64_t released = 0;
+  while (!read_.empty() && read_.front().done) {
+    released = read_.front().pos + read_.front().extent;
+    read_.pop_front();
+  }
+  header()->release_pos.store(released, std::memory_order_release);
+}
+
+std::shared_ptr<uint8_t> ShmRingBuffer::TryShare(uint64_t *size) {
+  span<uint8_t> record;
+  uint64_t pos;
+  {
+    std::lock_guard<std::mutex> g(read_mtx_);
+    if (!ReadNext(record, pos))
+      return nullptr;
+  }
+  if (size)
+    *size = record.size();
+  return std::shared_ptr<uint8_t>(record.data(), [this, pos](uint8_t *) {
+    std::lock_guard<std::mutex> g(read_mtx_);
+    for (auto &r : read_) {
+      if (r.pos == pos) {
+        r.done = true;
+        break;
+      }
+    }
+    ReleaseDone();
+  });
+}
+
+}  // namespace dali
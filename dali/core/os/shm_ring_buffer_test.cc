@@ -0,0 +1,151 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/core/os/shm_ring_buffer.h"
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace dali {
+namespace test {
+
+namespace {
+
+void FillRecord(uint8_t *data, uint64_t size, int index) {
+  for (uint64_t i = 0; i < size; i++)
+    data[i] = static_cast<uint8_t>(index + i);
+}
+
+void CheckRecord(span<uint8_t> record, uint64_t size, int index) {
+  ASSERT_EQ(static_cast<uint64_t>(record.size()), size) << "record " << index;
+  for (uint64_t i = 0; i < size; i++)
+    ASSERT_EQ(record[i], static_cast<uint8_t>(index + i)) << "record " << index << ", byte " << i;
+}
+
+uint64_t RecordSize(int index) {
+  return (index * 37) % 1000;
+}
+
+}  // namespace
+
+TEST(ShmRingBuffer, WriteRead) {
+  auto rb = ShmRingBuffer::Create(1000);
+  EXPECT_EQ(rb->capacity(), 1024u);
+  EXPECT_EQ(rb->TryRead().data(), nullptr);
+
+  uint8_t *rec = rb->TryReserve(10);
+  ASSERT_NE(rec, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(rec) % ShmRingBuffer::kAlignment, 0u);
+  FillRecord(rec, 10, 0);
+  // not visible before commit
+  EXPECT_EQ(rb->TryRead().data(), nullptr);
+  rb->Commit();
+
+  // an empty record
+  ASSERT_NE(rb->TryReserve(0), nullptr);
+  rb->Commit();
+
+  CheckRecord(rb->TryRead(), 10, 0);
+  auto empty = rb->TryRead();
+  EXPECT_NE(empty.data(), nullptr);
+  EXPECT_EQ(empty.size(), 0);
+  EXPECT_EQ(rb->TryRead().data(), nullptr);
+  rb->Release();
+  rb->Release();
+  EXPECT_THROW(rb->Release(), std::exception);
+}
+
+TEST(ShmRingBuffer, FullAndWrap) {
+  auto rb = ShmRingBuffer::Create(1024);
+  EXPECT_THROW(rb->TryReserve(rb->max_record_size() + 1), std::exception);
+
+  // each record takes 64 (header) + 320 bytes
+  for (int i = 0; i < 2; i++) {
+    auto *rec = rb->TryReserve(300);
+    ASSERT_NE(rec, nullptr);
+    FillRecord(rec, 300, i);
+    rb->Commit();
+  }
+  // only 256 bytes left - no room for another record
+  EXPECT_EQ(rb->TryReserve(300), nullptr);
+  CheckRecord(rb->TryRead(), 300, 0);
+  // the record is read, but not released
+  EXPECT_EQ(rb->TryReserve(300), nullptr);
+  rb->Release();
+  // the new record doesn't fit at the end - it's placed at the beginning
+  auto *rec = rb->TryReserve(300);
+  ASSERT_NE(rec, nullptr);
+  FillRecord(rec, 300, 2);
+  rb->Commit();
+  CheckRecord(rb->TryRead(), 300, 1);
+  CheckRecord(rb->TryRead(), 300, 2);
+}
+
+TEST(ShmRingBuffer, SharedRecords) {
+  auto rb = ShmRingBuffer::Create(1024);
+  for (int i = 0; i < 3; i++) {
+    auto *rec = rb->TryReserve(200);
+    ASSERT_NE(rec, nullptr);
+    FillRecord(rec, 200, i);
+    rb->Commit();
+  }
+  uint64_t size = 0;
+  std::vector<std::shared_ptr<uint8_t>> recs;
+  for (int i = 0; i < 3; i++) {
+    recs.push_back(rb->TryShare(&size));
+    ASSERT_NE(recs.back(), nullptr);
+    CheckRecord(make_span(recs.back().get(), size), 200, i);
+  }
+  EXPECT_EQ(rb->TryShare(), nullptr);
+  EXPECT_EQ(rb->TryReserve(200), nullptr);
+  // releasing a newer record doesn't free any space...
+  recs[1].reset();
+  EXPECT_EQ(rb->TryReserve(200), nullptr);
+  // ...until the older ones are released
+  recs[0].reset();
+  ASSERT_NE(rb->TryReserve(400), nullptr);
+  rb->Commit();
+}
+
+TEST(ShmRingBuffer, AttachAndStream) {
+  auto producer = ShmRingBuffer::Create(4096);
+  auto consumer = ShmRingBuffer::Attach(dup(producer->handle()));
+  EXPECT_EQ(consumer->capacity(), producer->capacity());
+
+  constexpr int kNumRecords = 2000;
+  std::thread writer([&]() {
+    for (int i = 0; i < kNumRecords; i++) {
+      uint64_t size = RecordSize(i);
+      uint8_t *rec;
+      while (!(rec = producer->TryReserve(size)))
+        std::this_thread::yield();
+      FillRecord(rec, size, i);
+      producer->Commit();
+    }
+  });
+  for (int i = 0; i < kNumRecords; i++) {
+    span<uint8_t> rec;
+    while (!(rec = consumer->TryRead()).data())
+      std::this_thread::yield();
+    CheckRecord(rec, RecordSize(i), i);
+    consumer->Release();
+  }
+  writer.join();
+}
+
+}  // namespace test
+}  // namespace dali
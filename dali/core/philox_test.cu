@@ -0,0 +1,105 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/core/philox.h"  // NOLINT
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "dali/test/device_test.h"
+#include <curand_kernel.h>  // NOLINT
+
+namespace dali {
+
+TEST(Philox4x32_10, KnownAnswer) {
+  // Test vectors published with the Random123 library
+  struct {
+    uint32_t ctr[4], key[2], out[4];
+  } kat[] = {
+    { { 0, 0, 0, 0 }, { 0, 0 },
+      { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 } },
+    { { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff },
+      { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd } },
+    { { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 },
+      { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } },
+  };
+  for (auto &t : kat) {
+    uint32_t out[4];
+    Philox4x32_10::Block(out, t.ctr, t.key);
+    for (int i = 0; i < 4; i++)
+      EXPECT_EQ(out[i], t.out[i]);
+  }
+
+  Philox4x32_10 gen(0);
+  for (int i = 0; i < 4; i++)
+    EXPECT_EQ(gen(), kat[0].out[i]);
+}
+
+TEST(Philox4x32_10, Skipahead) {
+  Philox4x32_10 ref(1234, 5);
+  std::vector<uint32_t> seq(1000);
+  for (auto &x : seq)
+    x = ref();
+
+  for (uint64_t offset : { 0, 1, 3, 4, 5, 17, 999 }) {
+    Philox4x32_10 gen(1234, 5, offset);
+    EXPECT_EQ(gen(), seq[offset]) << "offset " << offset;
+
+    Philox4x32_10 gen2(1234, 5);
+    gen2();
+    gen2.skipahead(offset);
+    if (offset + 1 < seq.size())
+      EXPECT_EQ(gen2(), seq[offset + 1]) << "offset " << offset;
+  }
+
+  Philox4x32_10 a(1234, 5, 8), b(1234, 5);
+  EXPECT_NE(a, b);
+  for (int i = 0; i < 8; i++)
+    b();
+  EXPECT_EQ(a, b);
+}
+
+TEST(Philox4x32_10, Subsequences) {
+  // The subsequence and the offset occupy disjoint parts of the counter
+  Philox4x32_10 a(42, 1), b(42, 0, uint64_t(1) << 62), c(43, 1);
+  std::uniform_real_distribution<double> dist(0, 1);
+  int equal_ab = 0, equal_ac = 0;
+  for (int i = 0; i < 1000; i++) {
+    auto va = a(), vb = b(), vc = c();
+    equal_ab += va == vb;
+    equal_ac += va == vc;
+  }
+  EXPECT_LT(equal_ab, 2);
+  EXPECT_LT(equal_ac, 2);
+
+  Philox4x32_10 s(42, 1);
+  double sum = 0;
+  const int n = 100000;
+  for (int i = 0; i < n; i++)
+    sum += dist(s);
+  EXPECT_NEAR(sum / n, 0.5, 0.01);
+}
+
+DEVICE_TEST(Philox4x32_10_Dev, MatchesCurand, 1, 64) {
+  uint64_t seed = 0x123456789abcdefull;
+  uint64_t subsequence = threadIdx.x * 0x100000001ull;
+  uint64_t offset = threadIdx.x * 7;
+  curandStatePhilox4_32_10_t state;
+  curand_init(seed, subsequence, offset, &state);
+  Philox4x32_10 gen(seed, subsequence, offset);
+  for (int i = 0; i < 100; i++) {
+    DEV_ASSERT_EQ(gen(), curand(&state));
+  }
+}
+
+}  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,7 +16,9 @@
 #define DALI_KERNELS_COMMON_BLOCK_SETUP_H_
 
 #include <cuda_runtime.h>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <vector>
 #include <utility>
 #include "dali/kernels/kernel.h"
@@ -86,6 +88,14 @@ struct BlockDesc<1> {
  * @remark Depending on whether the uniform block coverage (see SetupBlocks) is used or not,
  * the calculated grid dimension allow to iterate over blocks with blockIdx.z or blockIdx.x
  * respectively.
+ *
+ * @remark With a persistent grid (see SetMaxGridSize), the variable-size blocks have similar
+ * area and there may be fewer CUDA blocks than BlockDesc - the kernel must iterate over them:
+ *
+ *   for (int b = blockIdx.x; b < num_blocks; b += gridDim.x) {
+ *     const auto &block = blocks[b];
+ *     ...
+ *   }
  */
 template <int _ndim, int _channel_dim>
 class BlockSetup {
@@ -215,6 +225,25 @@ class BlockSetup {
     max_block_elements_ = block_volume_scale_ * volume(block_size);
   }
 
+  /**
+   * @brief Enables a persistent grid of at most `max_grid_size` blocks for variable-size batches
+   *
+   * The block size is chosen for the whole batch (and not for each sample separately), so that
+   * the blocks of all samples have similar area and can be distributed evenly over the grid.
+   * Within a sample, the blocks are split evenly, so there are no thin blocks at the edges.
+   * The block size is not greater than the default block size and not smaller than BlockDim.
+   *
+   * 0 disables the persistent grid - there's one CUDA block per BlockDesc.
+   * Uniform batches are not affected.
+   */
+  void SetMaxGridSize(int max_grid_size) {
+    max_grid_size_ = max_grid_size;
+  }
+
+  int MaxGridSize() const {
+    return max_grid_size_;
+  }
+
   span<const BlockDesc> Blocks() const { return make_span(blocks_); }
 
   coord_vec UniformOutputSize() const {
@@ -249,6 +278,7 @@ class BlockSetup {
   coord_t max_block_elements_;
   bool is_uniform_ = false;
   int block_volume_scale_ = 4;
+  int max_grid_size_ = 0;
 
   template <int d>
   void MakeBlocks(BlockDesc blk, coord_vec size, coord_vec block_size,
@@ -333,6 +363,10 @@ class BlockSetup {
   }
 
   void VariableSizeSetup(const TensorListShape<tensor_ndim> &output_shape) {
+    if (max_grid_size_ > 0) {
+      BalancedSizeSetup(output_shape);
+      return;
+    }
     for (int i = 0; i < output_shape.num_samples(); i++) {
       coord_vec size = shape2size(output_shape[i]);
       coord_vec block_size = VariableBlockSize<ndim>(size);
@@ -340,6 +374,57 @@ class BlockSetup {
     }
   }
 
+  /**
+   * @brief Calculates the block size for given sample, so that the sample is split evenly into
+   *        blocks with volume close to `block_volume`
+   */
+  coord_vec BalancedBlockSize(const coord_vec &size, int64_t block_volume) const {
+    coord_vec max_block = VariableBlockSize<ndim>(size);
+    coord_vec block = max_block;
+    auto split = [&](int d, int64_t nblocks) {
+      coord_t even_block = div_ceil(div_ceil(size[d], nblocks), block_dim_[d]) * block_dim_[d];
+      block[d] = std::min<coord_t>(even_block, max_block[d]);
+    };
+    if constexpr (ndim == 1) {
+      split(0, div_ceil(size[0], block_volume));
+    } else {
+      // the extent of the block in the dimensions other than XY
+      int64_t depth = volume(max_block) / (static_cast<int64_t>(max_block[0]) * max_block[1]);
+      int64_t nblocks = div_ceil(static_cast<int64_t>(size[0]) * size[1] * depth, block_volume);
+      // nx * ny blocks, with the aspect ratio of the sample
+      double aspect = static_cast<double>(size[0]) / size[1];
+      int64_t nx = std::lround(std::sqrt(nblocks * aspect));
+      nx = std::max<int64_t>(1, std::min<int64_t>(nx, nblocks));
+      split(0, nx);
+      split(1, div_ceil(nblocks, nx));
+    }
+    return block;
+  }
+
+  void BalancedSizeSetup(const TensorListShape<tensor_ndim> &output_shape) {
+    int64_t total_volume = 0;
+    for (int i = 0; i < output_shape.num_samples(); i++)
+      total_volume += volume(shape2size(output_shape[i]));
+
+    // The blocks are not bigger than the default and each CUDA block of the grid processes
+    // the same number of them ("waves").
+    int64_t max_block_volume = ndim > 1 ? volume(default_block_size_) : max_block_elements_;
+    int64_t min_block_volume = ndim > 1 ? block_dim_.x * block_dim_.y : block_dim_.x;
+    int64_t waves = std::max<int64_t>(
+        div_ceil(total_volume, max_block_volume * max_grid_size_), 1);
+    int64_t block_volume = div_ceil(total_volume, waves * max_grid_size_);
+    block_volume = std::max(std::min(block_volume, max_block_volume), min_block_volume);
+
+    for (int i = 0; i < output_shape.num_samples(); i++) {
+      coord_vec size = shape2size(output_shape[i]);
+      if (volume(size) == 0)
+        continue;
+      MakeBlocks(i, size, BalancedBlockSize(size, block_volume));
+    }
+    int64_t num_blocks = blocks_.size();
+    grid_dim_ = ivec3(std::max<int64_t>(std::min<int64_t>(num_blocks, max_grid_size_), 1), 1, 1);
+  }
+
   void UniformSizeSetup(const TensorListShape<tensor_ndim> &output_shape) {
     if (output_shape.empty())
       return;
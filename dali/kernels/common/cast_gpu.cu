@@ -1,4 +1,4 @@
-// Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -60,6 +60,46 @@ __global__ void BinSearchCastKernel(const SampleDesc *samples,
   }
 }
 
+/**
+ * @brief A group of N values, loaded and stored with a single (vector) memory access
+ */
+template <typename T, int N>
+struct alignas(sizeof(T) * N) VecOf {
+  T v[N];
+};
+
+/**
+ * @brief The number of elements converted at once in a packed batch
+ *
+ * The wider of the types is accessed in 16-byte vectors.
+ */
+template <typename Out, typename In>
+constexpr int kVecSize = 16 / (sizeof(Out) > sizeof(In) ? sizeof(Out) : sizeof(In));
+
+/**
+ * @brief Converts a packed batch, kVec elements at a time.
+ *
+ * The pointers must be aligned to kVec elements and block_sz must be a multiple of kVec.
+ */
+template <typename Out, typename In, int kVec>
+__global__ void FlatCastKernel(Out *out, const In *in, int64_t size, int block_sz) {
+  int64_t block_start = static_cast<int64_t>(blockIdx.x) * block_sz;
+  int64_t block_end = cuda_min<int64_t>(block_start + block_sz, size);
+  for (int64_t x = block_start + threadIdx.x * kVec; x < block_end; x += blockDim.x * kVec) {
+    if (x + kVec <= block_end) {
+      auto in_vec = *reinterpret_cast<const VecOf<In, kVec> *>(in + x);
+      VecOf<Out, kVec> out_vec;
+      #pragma unroll
+      for (int i = 0; i < kVec; i++)
+        out_vec.v[i] = ConvertSat<Out>(in_vec.v[i]);
+      *reinterpret_cast<VecOf<Out, kVec> *>(out + x) = out_vec;
+    } else {
+      for (int64_t i = x; i < block_end; i++)
+        out[i] = ConvertSat<Out>(in[i]);
+    }
+  }
+}
+
 }  // namespace impl
 
 template <typename Out, typename In>
@@ -70,10 +110,38 @@ void CastGPU<Out, In>::Run(KernelContext &ctx,
     throw std::invalid_argument("Different number of elements in output vs. input");
 
   int num_samples = in.num_samples();
-  impl::SampleDesc *samples = ctx.scratchpad->AllocatePinned<impl::SampleDesc>(num_samples);
-
   constexpr int kBlockSize = 256;
   constexpr int kLogicalBlockSize = 4 * kBlockSize;
+
+  if (num_samples > 0 && in.is_contiguous() && out.is_contiguous()) {
+    // Packed batch (e.g. uniform samples) - no per-sample descriptors need to be copied
+    for (int i = 0; i < num_samples; i++) {
+      if (out.shape.tensor_size(i) != in.shape.tensor_size(i))
+        throw std::invalid_argument("Different number of elements in output vs. input");
+    }
+    int64_t size = in.num_elements();
+    if (size == 0)
+      return;
+    constexpr int kVec = impl::kVecSize<Out, In>;
+    auto aligned = [](const void *ptr, size_t alignment) {
+      return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+    };
+    if (aligned(out.data[0], kVec * sizeof(Out)) && aligned(in.data[0], kVec * sizeof(In))) {
+      constexpr int kVecBlockSize = kVec * kLogicalBlockSize;
+      impl::FlatCastKernel<Out, In, kVec>
+          <<<div_ceil(size, kVecBlockSize), kBlockSize, 0, ctx.gpu.stream>>>(
+            out.data[0], in.data[0], size, kVecBlockSize);
+    } else {
+      impl::FlatCastKernel<Out, In, 1>
+          <<<div_ceil(size, kLogicalBlockSize), kBlockSize, 0, ctx.gpu.stream>>>(
+            out.data[0], in.data[0], size, kLogicalBlockSize);
+    }
+    CUDA_CALL(cudaGetLastError());
+    return;
+  }
+
+  impl::SampleDesc *samples = ctx.scratchpad->AllocatePinned<impl::SampleDesc>(num_samples);
+
   uint32_t offset_blk = 0;
   int nonempty_nsamples = 0;
   for (int i = 0; i < num_samples; i++) {
@@ -0,0 +1,86 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/kernels/common/cpu_isa.h"
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+namespace dali {
+namespace kernels {
+
+namespace {
+
+CpuIsa DetectCpuIsa() {
+  CpuIsa best = CpuIsa::Baseline;
+  for (CpuIsa isa : { CpuIsa::AVX2, CpuIsa::AVX512, CpuIsa::NEON })
+    if (CpuSupports(isa))
+      best = isa;
+
+  const char *env = std::getenv("DALI_CPU_ISA");
+  if (env && *env) {
+    // the requested instruction set is used only if it's not better than the best one available
+    if (!std::strcmp(env, "baseline"))
+      return CpuIsa::Baseline;
+    if (!std::strcmp(env, "avx2") && best == CpuIsa::AVX512)
+      return CpuIsa::AVX2;
+  }
+  return best;
+}
+
+}  // namespace
+
+bool CpuSupports(CpuIsa isa) {
+  switch (isa) {
+    case CpuIsa::Baseline:
+      return true;
+#if DALI_CPU_DISPATCH_X86
+    // __builtin_cpu_supports also checks whether the OS saves the extended registers
+    case CpuIsa::AVX2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case CpuIsa::AVX512:
+      return CpuSupports(CpuIsa::AVX2) &&
+             __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#endif
+#if DALI_CPU_DISPATCH_NEON
+    case CpuIsa::NEON:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+CpuIsa GetCpuIsa() {
+  static const CpuIsa isa = DetectCpuIsa();
+  return isa;
+}
+
+const char *CpuIsaName(CpuIsa isa) {
+  switch (isa) {
+    case CpuIsa::Baseline:
+      return "baseline";
+    case CpuIsa::AVX2:
+      return "avx2";
+    case CpuIsa::AVX512:
+      return "avx512";
+    case CpuIsa::NEON:
+      return "neon";
+    default:
+      return "<unknown>";
+  }
+}
+
+}  // namespace kernels
+}  // namespace dali
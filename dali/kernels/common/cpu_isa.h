@@ -0,0 +1,130 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_COMMON_CPU_ISA_H_
+#define DALI_KERNELS_COMMON_CPU_ISA_H_
+
+#include <type_traits>
+#include "dali/core/api_helper.h"
+
+/**
+ * Run-time selection of the instruction set used by the CPU kernels.
+ *
+ * A kernel which has variants for wider instruction sets declares a function template with
+ * a `CpuIsa` parameter and specializes it - the x86 variants are defined in separate translation
+ * units, in which (only) the variant's code is compiled with the instruction set enabled:
+ *
+ * ```
+ * #include ...  // everything, before the code is compiled for the wider instruction set
+ * DALI_CPU_TARGET_BEGIN_AVX2
+ * template <typename V> inline void MyKernelBody(...) { ... }   // the vectorized code
+ * DALI_CPU_TARGET_END
+ * template <> void MyKernelImpl<CpuIsa::AVX2>(...) { MyKernelBody<AVX2Vec>(...); }
+ * ```
+ *
+ * The entry points (here, the specializations) are compiled for the baseline, so they can be
+ * declared in headers and called from the generic code, e.g. with `DispatchCpuIsa`.
+ * The functions defined in the headers included before `DALI_CPU_TARGET_BEGIN_*`, which may be
+ * instantiated (and merged by the linker) in other translation units, are not affected.
+ *
+ * On aarch64, NEON is a part of the baseline and it's used without the run-time check.
+ */
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__CUDACC__)
+#define DALI_CPU_DISPATCH_X86 1
+#else
+#define DALI_CPU_DISPATCH_X86 0
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON) && !defined(__CUDACC__)
+#define DALI_CPU_DISPATCH_NEON 1
+#else
+#define DALI_CPU_DISPATCH_NEON 0
+#endif
+
+#if DALI_CPU_DISPATCH_X86
+#if defined(__clang__)
+#define DALI_CPU_TARGET_BEGIN(target_list) \
+  _Pragma(DALI_CPU_TARGET_STR(clang attribute push(__attribute__((target(target_list))), \
+                                                   apply_to = function)))
+#define DALI_CPU_TARGET_END _Pragma("clang attribute pop")
+#else
+#define DALI_CPU_TARGET_BEGIN(target_list) \
+  _Pragma("GCC push_options") _Pragma(DALI_CPU_TARGET_STR(GCC target(target_list)))
+#define DALI_CPU_TARGET_END _Pragma("GCC pop_options")
+#endif
+#define DALI_CPU_TARGET_STR(...) #__VA_ARGS__
+
+#define DALI_CPU_TARGET_BEGIN_AVX2 DALI_CPU_TARGET_BEGIN("avx2,fma")
+#define DALI_CPU_TARGET_BEGIN_AVX512 DALI_CPU_TARGET_BEGIN("avx512f,avx512bw,avx2,fma")
+#endif  // DALI_CPU_DISPATCH_X86
+
+namespace dali {
+namespace kernels {
+
+enum class CpuIsa : int {
+  Baseline = 0,  // SSE2 on x86_64 - what the code is compiled for by default
+  AVX2,          // AVX2 + FMA
+  AVX512,        // AVX-512 F + BW (and AVX2 + FMA)
+  NEON,
+};
+
+template <CpuIsa isa>
+using cpu_isa_t = std::integral_constant<CpuIsa, isa>;
+
+/**
+ * @brief Returns true, if the CPU (and the OS) supports the instruction set
+ *
+ * The instruction sets for which this build has no variants are reported as unsupported.
+ */
+DLL_PUBLIC bool CpuSupports(CpuIsa isa);
+
+/**
+ * @brief Returns the instruction set to be used by the CPU kernels
+ *
+ * It's the best instruction set supported by the CPU, detected once. It can be limited with
+ * the DALI_CPU_ISA environment variable, set to "avx2" or "baseline" (e.g. if the wide vector
+ * instructions lower the clock of the CPU too much). Other values are ignored.
+ */
+DLL_PUBLIC CpuIsa GetCpuIsa();
+
+DLL_PUBLIC const char *CpuIsaName(CpuIsa isa);
+
+/**
+ * @brief Calls `f(cpu_isa_t<isa>())` for the instruction set returned by `GetCpuIsa`
+ *
+ * Only the variants available in this build are instantiated; `f(cpu_isa_t<CpuIsa::Baseline>())`
+ * is the fallback.
+ */
+template <typename F>
+decltype(auto) DispatchCpuIsa(F &&f) {
+  switch (GetCpuIsa()) {
+#if DALI_CPU_DISPATCH_X86
+    case CpuIsa::AVX512:
+      return f(cpu_isa_t<CpuIsa::AVX512>());
+    case CpuIsa::AVX2:
+      return f(cpu_isa_t<CpuIsa::AVX2>());
+#endif
+#if DALI_CPU_DISPATCH_NEON
+    case CpuIsa::NEON:
+      return f(cpu_isa_t<CpuIsa::NEON>());
+#endif
+    default:
+      return f(cpu_isa_t<CpuIsa::Baseline>());
+  }
+}
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_COMMON_CPU_ISA_H_
@@ -0,0 +1,47 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include "dali/kernels/common/cpu_isa.h"
+
+namespace dali {
+namespace kernels {
+
+TEST(CpuIsa, SelectedIsSupported) {
+  CpuIsa isa = GetCpuIsa();
+  EXPECT_TRUE(CpuSupports(isa)) << CpuIsaName(isa);
+  EXPECT_TRUE(CpuSupports(CpuIsa::Baseline));
+  EXPECT_EQ(GetCpuIsa(), isa) << "The instruction set should be selected once";
+#if !DALI_CPU_DISPATCH_X86
+  EXPECT_FALSE(CpuSupports(CpuIsa::AVX2));
+  EXPECT_FALSE(CpuSupports(CpuIsa::AVX512));
+#endif
+#if !DALI_CPU_DISPATCH_NEON
+  EXPECT_FALSE(CpuSupports(CpuIsa::NEON));
+#endif
+  if (CpuSupports(CpuIsa::AVX512)) {
+    EXPECT_TRUE(CpuSupports(CpuIsa::AVX2));
+  }
+}
+
+TEST(CpuIsa, Dispatch) {
+  std::string name = DispatchCpuIsa([](auto isa) {
+    return std::string(CpuIsaName(isa()));
+  });
+  EXPECT_EQ(name, CpuIsaName(GetCpuIsa()));
+}
+
+}  // namespace kernels
+}  // namespace dali
@@ -13,11 +13,19 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
 #include "dali/core/cuda_error.h"
+#include "dali/core/cuda_event.h"
+#include "dali/core/cuda_stream.h"
+#include "dali/core/device_guard.h"
 #include "dali/kernels/common/scatter_gather.h"
 #include "dali/kernels/dynamic_scratchpad.h"
 
@@ -63,6 +71,34 @@ size_t Coalesce(span<CopyRange> ranges) {
   return n;
 }
 
+size_t TuneCopyKernelThreshold(int device_id);
+
+size_t CopyKernelThreshold(int device_id) {
+  static const char *env = std::getenv("DALI_COPY_KERNEL_THRESHOLD");
+  if (env && *env)
+    return std::strtoull(env, nullptr, 10);
+
+  struct TunedThreshold {
+    std::once_flag once;
+    size_t value = 0;
+  };
+  static std::unique_ptr<TunedThreshold[]> thresholds;
+  static int ndevs = 0;
+  static std::once_flag init;
+  std::call_once(init, []() {
+    CUDA_CALL(cudaGetDeviceCount(&ndevs));
+    thresholds.reset(new TunedThreshold[ndevs]);
+  });
+  if (device_id < 0)
+    CUDA_CALL(cudaGetDevice(&device_id));
+  assert(device_id < ndevs);
+  auto &t = thresholds[device_id];
+  std::call_once(t.once, [&]() {
+    t.value = TuneCopyKernelThreshold(device_id);
+  });
+  return t.value;
+}
+
 }  // namespace detail
 
 std::pair<size_t, size_t>
@@ -157,19 +193,71 @@ __global__ void BatchCopy(CopyRanges ranges) {
   }
 }
 
+void ScatterGatherGPU::RunMemcpy(cudaStream_t stream, cudaMemcpyKind memcpyKind,
+                                 bool src_pageable) {
+#if CUDART_VERSION >= 12080
+  // The batched copy cannot be issued on the legacy default stream
+  static std::atomic<bool> batch_supported{true};
+  if (batch_supported && ranges_.size() > 2 && stream != 0) {
+    size_t n = ranges_.size();
+    batch_dsts_.resize(n);
+    batch_srcs_.resize(n);
+    batch_sizes_.resize(n);
+    for (size_t i = 0; i < n; i++) {
+      batch_dsts_[i] = ranges_[i].dst;
+      batch_srcs_[i] = const_cast<char *>(ranges_[i].src);
+      batch_sizes_[i] = ranges_[i].size;
+    }
+    cudaMemcpyAttributes attr = {};
+    // Pageable memory is read during the call, like with a regular cudaMemcpyAsync
+    attr.srcAccessOrder = src_pageable ? cudaMemcpySrcAccessOrderDuringApiCall
+                                       : cudaMemcpySrcAccessOrderStream;
+    size_t attr_idx = 0;
+  #if CUDART_VERSION >= 13000
+    cudaError_t err = cudaMemcpyBatchAsync(batch_dsts_.data(), batch_srcs_.data(),
+                                           batch_sizes_.data(), n, &attr, &attr_idx, 1, stream);
+  #else
+    size_t fail_idx = 0;
+    cudaError_t err = cudaMemcpyBatchAsync(batch_dsts_.data(), batch_srcs_.data(),
+                                           batch_sizes_.data(), n, &attr, &attr_idx, 1,
+                                           &fail_idx, stream);
+  #endif
+    if (err == cudaSuccess)
+      return;
+    if (err != cudaErrorNotSupported && err != cudaErrorCallRequiresNewerDriver)
+      CUDA_CALL(err);
+    // the driver doesn't support batched copies - clear the error and don't try again
+    (void)cudaGetLastError();
+    batch_supported = false;
+  }
+#endif
+  for (auto &r : ranges_) {
+    CUDA_CALL(cudaMemcpyAsync(r.dst, r.src, r.size, memcpyKind, stream));
+  }
+}
+
 void ScatterGatherGPU::Run(cudaStream_t stream, bool reset, ScatterGatherGPU::Method method,
                            cudaMemcpyKind memcpyKind) {
   Coalesce();
 
   // TODO(michalz): Error handling
 
-  bool use_memcpy = (method == ScatterGatherGPU::Method::Memcpy) ||
-    (method == ScatterGatherGPU::Method::Default && ranges_.size() <= 2);
+  bool use_memcpy = method == ScatterGatherGPU::Method::Memcpy ||
+                    method == ScatterGatherGPU::Method::PageableMemcpy;
+  if (method == ScatterGatherGPU::Method::Default) {
+    if (ranges_.size() <= 2) {
+      use_memcpy = true;
+    } else if (memcpyKind != cudaMemcpyDeviceToDevice) {
+      // The kernel accesses the host memory directly, which is slow for larger ranges
+      size_t total_size = 0;
+      for (auto &r : ranges_)
+        total_size += r.size;
+      use_memcpy = total_size / ranges_.size() > detail::CopyKernelThreshold(-1);
+    }
+  }
 
   if (use_memcpy) {
-    for (auto &r : ranges_) {
-      CUDA_CALL(cudaMemcpyAsync(r.dst, r.src, r.size, memcpyKind, stream));
-    }
+    RunMemcpy(stream, memcpyKind, method == ScatterGatherGPU::Method::PageableMemcpy);
   } else {
     size_t num_blocks, size_per_block;
     std::tie(num_blocks, size_per_block) = BlockCountAndSize(ranges_);
@@ -199,5 +287,60 @@ void ScatterGatherGPU::Run(cudaStream_t stream, bool reset, ScatterGatherGPU::Me
     Reset();
 }
 
+namespace detail {
+
+/**
+ * @brief Finds the largest range size for which the kernel copies pinned host memory to the
+ *        device at least as fast as cudaMemcpyAsync.
+ */
+size_t TuneCopyKernelThreshold(int device_id) {
+  // if the measurement fails, use the kernel, as before the threshold was introduced
+  constexpr size_t kFallback = std::numeric_limits<size_t>::max();
+  try {
+    DeviceGuard dg(device_id);
+    constexpr size_t kTotalSize = 4 << 20;
+    constexpr int kMaxRanges = 256;
+    auto host = mm::alloc_raw_unique<char, mm::memory_kind::pinned>(kTotalSize);
+    auto dev = mm::alloc_raw_unique<char, mm::memory_kind::device>(kTotalSize);
+    CUDAStream stream = CUDAStream::Create(true, device_id);
+    CUDAEvent start = CUDAEvent::CreateWithFlags(cudaEventDefault, device_id);
+    CUDAEvent end = CUDAEvent::CreateWithFlags(cudaEventDefault, device_id);
+    ScatterGatherGPU sg;
+
+    auto measure = [&](size_t range_size, ScatterGatherGPU::Method method) {
+      int n = std::min<size_t>(kTotalSize / range_size, kMaxRanges);
+      float best = std::numeric_limits<float>::max();
+      for (int rep = 0; rep < 3; rep++) {
+        // the destinations are in reverse order, so that the ranges are not coalesced
+        for (int i = 0; i < n; i++)
+          sg.AddCopy(dev.get() + (n - 1 - i) * range_size, host.get() + i * range_size,
+                     range_size);
+        CUDA_CALL(cudaEventRecord(start, stream));
+        sg.Run(stream, true, method, cudaMemcpyHostToDevice);
+        CUDA_CALL(cudaEventRecord(end, stream));
+        CUDA_CALL(cudaEventSynchronize(end));
+        float ms = 0;
+        CUDA_CALL(cudaEventElapsedTime(&ms, start, end));
+        best = std::min(best, ms);
+      }
+      return best;
+    };
+
+    size_t threshold = 0;
+    for (size_t range_size = 1 << 10; range_size <= (1 << 20); range_size <<= 2) {
+      if (measure(range_size, ScatterGatherGPU::Method::Kernel) >
+          measure(range_size, ScatterGatherGPU::Method::Memcpy))
+        break;
+      threshold = range_size;
+    }
+    return threshold;
+  } catch (const std::exception &) {
+    (void)cudaGetLastError();
+    return kFallback;
+  }
+}
+
+}  // namespace detail
+
 }  // namespace kernels
 }  // namespace dali
@@ -37,6 +37,15 @@ struct DLL_PUBLIC CopyRange {
 };
 
 DLL_PUBLIC size_t Coalesce(span<CopyRange> ranges);
+
+/**
+ * @brief The average size of a range (in bytes) up to which the scatter-gather kernel is faster
+ *        than cudaMemcpyAsync for host-device copies on given device.
+ *
+ * The value is measured once per device, on first use, unless it's set with
+ * the DALI_COPY_KERNEL_THRESHOLD environment variable.
+ */
+DLL_PUBLIC size_t CopyKernelThreshold(int device_id);
 }  // namespace detail
 
 /**
@@ -75,10 +84,13 @@ class DLL_PUBLIC ScatterGatherBase {
 
   enum class Method {
     Default = 0,  // For GPU, uses scatter-gather kernel, unless there are 2 or fewer single
-                  // effective copy ranges, in that cases cudaMemcpyAsync is used
+                  // effective copy ranges or, for other than device-to-device copies, the ranges
+                  // are larger than detail::CopyKernelThreshold - then cudaMemcpyAsync is used
                   // For CPU, uses memcpy
     Memcpy = 1,   // Always use cudaMemcpyAsync, only for GPU
     Kernel = 2,   // Always use scatter-gather kernel, only for GPU
+    PageableMemcpy = 3,  // Use cudaMemcpyAsync, the sources may be in pageable host memory,
+                         // only for GPU
   };
 
   using CopyRange = detail::CopyRange;
@@ -120,6 +132,10 @@ class DLL_PUBLIC ScatterGatherGPU : public ScatterGatherBase {
 
   /**
    * @brief Executes the copies
+   *
+   * When cudaMemcpyAsync is used, all the copies are issued with one call to
+   * cudaMemcpyBatchAsync, if it's available.
+   *
    * @param stream     - the cudaStream on which the copies are scheduled
    * @param reset      - if true, calls Reset after processing is over
    * @param method     - see ScatterGatherGPU::CopyMethod
@@ -137,6 +153,19 @@ class DLL_PUBLIC ScatterGatherGPU : public ScatterGatherBase {
   }
 
   using CopyRange = detail::CopyRange;
+
+ private:
+  /**
+   * @brief Copies the ranges with cudaMemcpyBatchAsync or, if it's not available,
+   *        one cudaMemcpyAsync per range.
+   *
+   * @param src_pageable - if true, the sources can be in pageable memory and they are read
+   *                       before the function returns
+   */
+  void RunMemcpy(cudaStream_t stream, cudaMemcpyKind memcpyKind, bool src_pageable);
+
+  std::vector<void *> batch_dsts_, batch_srcs_;
+  std::vector<size_t> batch_sizes_;
 };
 
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2021, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,7 +15,9 @@
 #ifndef DALI_KERNELS_COMMON_SPLIT_SHAPE_H_
 #define DALI_KERNELS_COMMON_SPLIT_SHAPE_H_
 
+#include <algorithm>
 #include <utility>
+#include "dali/core/span.h"
 #include "dali/core/util.h"
 #include "dali/core/tensor_shape.h"
 
@@ -117,6 +119,71 @@ void ForEachBlock(TensorShape<ndim> start, TensorShape<ndim> end, const SplitFac
   }
 }
 
+/**
+ * @brief Calculates the number of ranges into which a sample should be split
+ *
+ * The whole batch is divided into about `num_threads * tasks_per_thread` tasks of similar cost,
+ * but not cheaper than `min_range_cost`. A sample gets as many ranges as it has such tasks
+ * (at least 1 and at most `extent`), so that a small batch of large samples occupies all the
+ * threads, while a large batch of small samples is still processed one sample per task.
+ *
+ * @param extent      number of the independent slices in the sample
+ * @param cost        cost of processing the sample
+ * @param total_cost  cost of processing the whole batch
+ */
+inline int64_t NumSampleRanges(int64_t extent, int64_t cost, int64_t total_cost,
+                               int num_threads, int64_t min_range_cost, int tasks_per_thread = 2) {
+  if (num_threads <= 1 || extent <= 1)
+    return 1;
+  int64_t task_cost = std::max<int64_t>(min_range_cost,
+                                        total_cost / (int64_t(num_threads) * tasks_per_thread));
+  return std::clamp<int64_t>(div_ceil(cost, std::max<int64_t>(task_cost, 1)), 1, extent);
+}
+
+/**
+ * @brief Distributes the processing of a batch of samples among the threads of an engine.
+ *
+ * Each sample `i` consists of `extents[i]` independent slices (e.g. the rows of an output
+ * image or the planes of a volume) and is split into contiguous ranges of the slices, as
+ * calculated with `NumSampleRanges`. Each range is added as a separate work item, with the
+ * priority equal to its share of the sample's cost. The samples with the extent of 0 are
+ * skipped.
+ *
+ * The work is only added - the caller is responsible for running it (e.g. with RunAll).
+ *
+ * @param exec_engine    the execution engine (e.g. a ThreadPool)
+ * @param extents        the number of independent slices in each sample
+ * @param costs          the (estimated) cost of processing each sample
+ * @param func           a copyable callable `func(thread_idx, sample_idx, begin, end)`,
+ *                       which processes the slices [begin, end) of a sample;
+ *                       it must remain valid until the work is complete
+ * @param min_range_cost the minimum practical cost of a range
+ */
+template <typename ExecutionEngine, typename RangeFunc>
+void AddSampleRangeWork(ExecutionEngine &exec_engine, span<const int64_t> extents,
+                        span<const int64_t> costs, RangeFunc &&func,
+                        int64_t min_range_cost = 1 << 16, int tasks_per_thread = 2) {
+  assert(extents.size() == costs.size());
+  int64_t total_cost = 0;
+  for (auto cost : costs)
+    total_cost += cost;
+  int num_threads = exec_engine.NumThreads();
+  for (int i = 0; i < extents.size(); i++) {
+    int64_t extent = extents[i];
+    if (extent == 0)
+      continue;
+    int64_t nranges = NumSampleRanges(extent, costs[i], total_cost, num_threads,
+                                      min_range_cost, tasks_per_thread);
+    for (int64_t r = 0; r < nranges; r++) {
+      int64_t begin = extent * r / nranges;
+      int64_t end = extent * (r + 1) / nranges;
+      exec_engine.AddWork([func, i, begin, end](int thread_idx) {
+        func(thread_idx, i, begin, end);
+      }, costs[i] * (end - begin) / extent);
+    }
+  }
+}
+
 }  // namespace kernels
 }  // namespace dali
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2021, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <functional>
 #include <vector>
 #include "dali/core/tensor_shape.h"
 #include "dali/kernels/common/split_shape.h"
@@ -75,5 +76,74 @@ TEST(split_shape, basic_test) {
   ASSERT_EQ(split_factor[2], 1);
 }
 
+namespace {
+
+/** Records the work instead of running it */
+struct RecordingEngine {
+  template <typename FunctionLike>
+  void AddWork(FunctionLike &&f, int64_t priority = 0, bool start_immediately = false) {
+    work.emplace_back(std::forward<FunctionLike>(f));
+    priorities.push_back(priority);
+  }
+
+  void RunAll() {
+    for (auto &w : work)
+      w(0);
+    work.clear();
+  }
+
+  int NumThreads() const noexcept { return num_threads; }
+
+  int num_threads = 4;
+  std::vector<std::function<void(int)>> work;
+  std::vector<int64_t> priorities;
+};
+
+}  // namespace
+
+TEST(split_shape, NumSampleRanges) {
+  // many small samples - one task per sample
+  EXPECT_EQ(NumSampleRanges(100, 1000, 64000, 4, 1), 1);
+  // a single large sample - split for all the threads
+  EXPECT_EQ(NumSampleRanges(100, 80000, 80000, 4, 1), 8);
+  // limited by the minimum range cost...
+  EXPECT_EQ(NumSampleRanges(100, 80000, 80000, 4, 40000), 2);
+  // ...and the extent
+  EXPECT_EQ(NumSampleRanges(3, 80000, 80000, 4, 1), 3);
+  // single-threaded
+  EXPECT_EQ(NumSampleRanges(100, 80000, 80000, 1, 1), 1);
+  // uneven samples - proportional to the cost
+  EXPECT_EQ(NumSampleRanges(100, 60000, 80000, 4, 1), 6);
+  EXPECT_EQ(NumSampleRanges(100, 20000, 80000, 4, 1), 2);
+}
+
+TEST(split_shape, AddSampleRangeWork) {
+  RecordingEngine engine;
+  std::vector<int64_t> extents = { 1000, 0, 7, 250 };
+  std::vector<int64_t> costs = { 1000000, 0, 7, 250000 };
+  std::vector<std::vector<int>> visited(extents.size());
+  for (size_t i = 0; i < extents.size(); i++)
+    visited[i].resize(extents[i]);
+
+  AddSampleRangeWork(engine, make_cspan(extents), make_cspan(costs),
+    [&](int thread_idx, int sample_idx, int64_t begin, int64_t end) {
+      ASSERT_LT(begin, end);
+      for (int64_t i = begin; i < end; i++)
+        visited[sample_idx][i]++;
+    }, 1000);
+  // 8 tasks are requested; the first sample gets 7 of them, the last sample - 2
+  EXPECT_EQ(engine.work.size(), 7u + 1u + 2u);
+  int64_t total_priority = 0;
+  for (auto p : engine.priorities)
+    total_priority += p;
+  EXPECT_EQ(total_priority, 1000000 + 7 + 250000);
+
+  engine.RunAll();
+  for (size_t i = 0; i < extents.size(); i++) {
+    for (int64_t j = 0; j < extents[i]; j++)
+      EXPECT_EQ(visited[i][j], 1) << "sample " << i << ", slice " << j;
+  }
+}
+
 }  // namespace kernels
 }  // namespace dali
@@ -24,6 +24,7 @@
 #include "dali/core/mm/fixed_order_resource.h"
 #include "dali/core/mm/memory.h"
 #include "dali/core/mm/memory_kind.h"
+#include "dali/core/mm/memory_tag.h"
 #include "dali/core/mm/monotonic_resource.h"
 #include "dali/kernels/context.h"
 #include "dali/kernels/kernel_req.h"
@@ -129,6 +130,9 @@ using DynamicScratchpadImpl = DynamicScratchpadImplT<
  * Device memory is allocated and deallocated in order specified in `device_order`.
  * Pinned memory is, by default, allocated in host order and deallocated in the same order as the
  * one used for device memory. These orders, however, can be specified explicitly.
+ *
+ * The memory requested from the scratchpad is recorded as mm::MemoryTag::Scratch in the memory
+ * tracking context in which the scratchpad was created, if any (see mm::MemoryTagScope).
  */
 class DynamicScratchpad
   : public Scratchpad
@@ -165,6 +169,14 @@ class DynamicScratchpad
     managed_dealloc_order_ = managed_dealloc_order;
   }
 
+  ~DynamicScratchpad() {
+    if (tracking_.tracker) {
+      for (int kind = 0; kind < mm::memory_kind_id::count; kind++)
+        tracking_.tracker->Freed(mm::MemoryTag::Scratch, static_cast<mm::memory_kind_id>(kind),
+                                 tracked_bytes_[kind]);
+    }
+  }
+
   virtual void *Alloc(mm::memory_kind_id kind_id, size_t bytes, size_t alignment) {
     void *ret = nullptr;
     TYPE_SWITCH(kind_id, mm::kind2id, Kind,
@@ -214,10 +226,17 @@ class DynamicScratchpad
       InitResource(type_tag<Kind>());
       assert(r.upstream() != nullptr);
     }
-    return r.allocate(bytes, alignment);
+    void *ret = r.allocate(bytes, alignment);
+    if (tracking_.tracker) {
+      tracking_.tracker->Allocated(mm::MemoryTag::Scratch, mm::kind2id_v<Kind>, bytes);
+      tracked_bytes_[mm::kind2id_v<Kind>] += bytes;
+    }
+    return ret;
   }
 
   AccessOrder device_order_, pinned_dealloc_order_, managed_dealloc_order_;
+  mm::MemoryTagContext tracking_ = mm::GetMemoryTagContext();
+  std::array<size_t, mm::memory_kind_id::count> tracked_bytes_{};
 };
 
 }  // namespace kernels
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -69,10 +69,14 @@ using box = Box<ndim, T>;
 template <int ndim>
 using ibox = box<int32_t, ndim>;
 
+/**
+ * The output may be the same buffer as the input - in that case, only the erased elements
+ * are written.
+ */
 template <typename T, int ndim>
 struct erase_sample_desc {
-  const T * __restrict__ in = nullptr;
-  T * __restrict__ out = nullptr;
+  const T *in = nullptr;
+  T *out = nullptr;
   const T* fill_values = nullptr;
   span<const ibox<ndim>> erase_regions = {};
   ivec<ndim> sample_shape;
@@ -305,7 +309,10 @@ struct do_copy_or_erase {
         copy = false;
       }
     }
-    sample.out[offset] = copy ? sample.in[offset] : fill_value;
+    if (!copy)
+      sample.out[offset] = fill_value;
+    else if (sample.out != sample.in)
+      sample.out[offset] = sample.in[offset];
   }
 };
 
@@ -348,8 +355,9 @@ __global__ void erase_gpu_impl(const erase_sample_desc<T, ndim> *samples,
   int is_fully_erased = __any_sync(FULL_MASK, full_cover);
 
   if (total_erase_regions == 0) {
-    // do a full copy
-    erase_generic<do_copy, channel_dim>(sample, region_box);
+    // do a full copy - unless the sample is processed in place
+    if (sample.out != sample.in)
+      erase_generic<do_copy, channel_dim>(sample, region_box);
     return;
   } else if (is_fully_erased) {
     // do a total erase
@@ -1,4 +1,4 @@
-// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -29,30 +29,41 @@ __global__ void ZeroMem(const SampleDesc *sample_descs) {
   sample_desc.out[blockIdx.x * SampleDesc::range_size + threadIdx.x] = 0;
 }
 
-__global__ void Histogram(const SampleDesc *sample_descs) {
+/**
+ * @brief Computes the histograms of the block's part of the sample in `num_hists` private
+ *        shared memory copies and adds them to the (global) output histogram.
+ *
+ * The warp `w` updates the copy `w % num_hists`, so that the atomics in hot bins (e.g. in uniform
+ * image regions) are not contended by all the warps in the block.
+ */
+__global__ void Histogram(const SampleDesc *sample_descs, int num_hists) {
   // cuda headers do not provide atomicAdd for uint64_t, but they do for unsigned long long int
   using ull_t = unsigned long long int;  // NOLINT(runtime/int)
   static_assert(sizeof(ull_t) == sizeof(uint64_t));
   extern __shared__ char shm[];
-  auto *workspace = reinterpret_cast<ull_t *>(shm);
+  auto *workspace = reinterpret_cast<uint32_t *>(shm);
   auto sample_desc = sample_descs[blockIdx.y];
   const uint8_t *in = sample_desc.in;
   auto *out = reinterpret_cast<ull_t *>(sample_desc.out);
-  for (unsigned int idx = threadIdx.x; idx < SampleDesc::range_size * sample_desc.num_channels;
-       idx += blockDim.x) {
+  unsigned int hist_size = SampleDesc::range_size * sample_desc.num_channels;
+  for (unsigned int idx = threadIdx.x; idx < hist_size * num_hists; idx += blockDim.x) {
     workspace[idx] = 0;
   }
   __syncthreads();
+  uint32_t *hist = workspace + (threadIdx.x / 32) % num_hists * hist_size;
   for (uint64_t idx = static_cast<uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
        idx < sample_desc.num_elements;
        idx += static_cast<uint64_t>(blockDim.x) * gridDim.x) {
     uint64_t channel_idx = idx % sample_desc.num_channels;
-    atomicAdd(workspace + channel_idx * SampleDesc::range_size + in[idx], 1);
+    atomicAdd(hist + channel_idx * SampleDesc::range_size + in[idx], 1u);
   }
   __syncthreads();
-  for (unsigned int idx = threadIdx.x; idx < SampleDesc::range_size * sample_desc.num_channels;
-       idx += blockDim.x) {
-    atomicAdd(out + idx, workspace[idx]);
+  for (unsigned int idx = threadIdx.x; idx < hist_size; idx += blockDim.x) {
+    uint64_t count = 0;
+    for (int h = 0; h < num_hists; h++)
+      count += workspace[h * hist_size + idx];
+    if (count)
+      atomicAdd(out + idx, count);
   }
 }
 
@@ -63,6 +74,7 @@ void HistogramKernelGpu::Run(KernelContext &ctx, TensorListView<StorageGPU, uint
   sample_descs_.clear();
   sample_descs_.reserve(batch_size);
   int64_t max_num_blocks = 0;
+  int64_t max_num_elements = 0;
   int64_t max_num_channels = 0;
   for (int sample_idx = 0; sample_idx < batch_size; sample_idx++) {
     int64_t num_channels = in.shape[sample_idx][1];
@@ -70,6 +82,7 @@ void HistogramKernelGpu::Run(KernelContext &ctx, TensorListView<StorageGPU, uint
     assert(num_channels == out.shape[sample_idx][0]);
     int64_t num_blocks = div_ceil(num_elements, kBlockSize);
     max_num_blocks = std::max(max_num_blocks, num_blocks);
+    max_num_elements = std::max(max_num_elements, num_elements);
     max_num_channels = std::max(max_num_channels, num_channels);
     sample_descs_.push_back({out.data[sample_idx], in.data[sample_idx],
                              static_cast<uint64_t>(num_elements),
@@ -82,7 +95,9 @@ void HistogramKernelGpu::Run(KernelContext &ctx, TensorListView<StorageGPU, uint
                     shared_mem_limit_ / kShmPerChannelSize, ", however got a sample with ",
                     max_num_channels, "."));
   }
-  max_num_blocks = std::min(max_num_blocks, kMaxGridSize);
+  int num_hists = std::min<int64_t>(shared_mem_limit_ / workspace_size, kMaxPrivateHists);
+  max_num_blocks = std::max(std::min(max_num_blocks, kMaxGridSize),
+                            div_ceil(max_num_elements, kMaxElementsPerBlock));
   SampleDesc *samples_desc_dev;
   std::tie(samples_desc_dev) = ctx.scratchpad->ToContiguousGPU(ctx.gpu.stream, sample_descs_);
   dim3 zero_grid{static_cast<unsigned int>(max_num_channels),
@@ -90,7 +105,8 @@ void HistogramKernelGpu::Run(KernelContext &ctx, TensorListView<StorageGPU, uint
   ZeroMem<<<zero_grid, kBlockSize, 0, ctx.gpu.stream>>>(samples_desc_dev);
   CUDA_CALL(cudaGetLastError());
   dim3 hist_grid{static_cast<unsigned int>(max_num_blocks), static_cast<unsigned int>(batch_size)};
-  Histogram<<<hist_grid, kBlockSize, workspace_size, ctx.gpu.stream>>>(samples_desc_dev);
+  Histogram<<<hist_grid, kBlockSize, workspace_size * num_hists, ctx.gpu.stream>>>(
+      samples_desc_dev, num_hists);
   CUDA_CALL(cudaGetLastError());
 }
 
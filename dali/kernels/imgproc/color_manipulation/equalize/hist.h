@@ -1,4 +1,4 @@
-// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -40,7 +40,17 @@ struct SampleDesc {
 struct DLL_PUBLIC HistogramKernelGpu {
   static constexpr int64_t kBlockSize = 256;
   static constexpr int64_t kMaxGridSize = 128;
-  static constexpr int64_t kShmPerChannelSize = SampleDesc::range_size * sizeof(uint64_t);
+  /**
+   * The block keeps up to one private (32-bit) histogram per warp, so that the warps
+   * don't contend for the same shared memory counters.
+   */
+  static constexpr int64_t kMaxPrivateHists = kBlockSize / 32;
+  static constexpr int64_t kShmPerChannelSize = SampleDesc::range_size * sizeof(uint32_t);
+  /**
+   * The number of elements that a single block can process without overflowing
+   * the 32-bit counters (with a margin for the rounding in the grid-stride loop).
+   */
+  static constexpr int64_t kMaxElementsPerBlock = int64_t{1} << 31;
 
   HistogramKernelGpu() : shared_mem_limit_{GetSharedMemPerBlock()} {}
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -113,6 +113,13 @@ TEST_F(EqualizeHistGpuTest, UniformRandVarChannels) {
   this->Run();
 }
 
+TEST_F(EqualizeHistGpuTest, UniformRandManyChannels) {
+  // the histograms of this many channels leave room for just one private copy in a block
+  TensorListShape<2> tls{{{4096 * 3 + 1, 40}, {1024, 3}, {50, 1}}};
+  this->PrepareUniformRandom(tls);
+  this->Run();
+}
+
 TEST_F(EqualizeHistGpuTest, SingleValue) {
   TensorListShape<2> batch_shape{{{1024 * 1024 * 64, 1},
                                   {1024 * 1024 * 64 - 1, 2},
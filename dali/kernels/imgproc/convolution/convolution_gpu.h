@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,8 +15,11 @@
 #ifndef DALI_KERNELS_IMGPROC_CONVOLUTION_CONVOLUTION_GPU_H_
 #define DALI_KERNELS_IMGPROC_CONVOLUTION_CONVOLUTION_GPU_H_
 
+#include <algorithm>
+#include <type_traits>
 #include "dali/core/boundary.h"
 #include "dali/core/convert.h"
+#include "dali/core/cuda_rt_utils.h"
 #include "dali/core/format.h"
 #include "dali/core/span.h"
 #include "dali/core/tensor_view.h"
@@ -78,6 +81,10 @@ struct ConvEpilogue {
  * the C matrix is zeroed.
  * A and B correspond to `in` and `window` (the order depends on whether it's an inner or an outer
  * convolution). Effectively, we calculate ``D = alpha * A * B + beta * D``.
+ *
+ * For half-precision input, big windows (at least kTensorOpMinWindowSize) and devices with
+ * compute capability 7.5 or newer, the GEMM is computed with Tensor Cores: the window is converted
+ * to half when loaded and the accumulation is done in float.
  */
 template <typename Out, typename In, typename W, int ndim, int axis, bool has_channels = true>
 struct ConvolutionGpu {
@@ -103,9 +110,13 @@ struct ConvolutionGpu {
                    make_string("Window is too big for sample ", i, ", got: ", window_size[i][0],
                                ", expected at most: ", kMaxWindowSize / num_channels, "."));
     }
+    use_tensor_op_ = UseTensorOp(window_size);
     se.add<mm::memory_kind::host, W>(num_samples * kWindowCopyBufferSize);
     se.add<mm::memory_kind::device, W>(num_samples * kWindowCopyBufferSize);
-    se.add<mm::memory_kind::device, typename CutlassConv::SampleParams>(num_samples);
+    if (use_tensor_op_)
+      se.add<mm::memory_kind::device, typename CutlassConvTensorOp::SampleParams>(num_samples);
+    else
+      se.add<mm::memory_kind::device, typename CutlassConv::SampleParams>(num_samples);
     req.scratch_sizes = se.sizes;
     req.output_shapes.push_back(in_shape);
     return req;
@@ -115,6 +126,23 @@ struct ConvolutionGpu {
            const TensorListView<StorageGPU, const In, ndim>& in,
            const TensorListView<StorageCPU, const W, 1>& windows,
            const span<const int> window_anchors = {}, const ConvEpilogue& conv_epilogue = 1.f) {
+    if constexpr (kHasTensorOpConv) {
+      if (use_tensor_op_) {
+        RunConv<CutlassConvTensorOp>(ctx, out, in, windows, window_anchors, conv_epilogue);
+        return;
+      }
+    }
+    RunConv<CutlassConv>(ctx, out, in, windows, window_anchors, conv_epilogue);
+  }
+
+ private:
+  template <typename Conv>
+  void RunConv(KernelContext& ctx, const TensorListView<StorageGPU, Out, ndim> out,
+               const TensorListView<StorageGPU, const In, ndim>& in,
+               const TensorListView<StorageCPU, const W, 1>& windows,
+               const span<const int> window_anchors, const ConvEpilogue& conv_epilogue) {
+    using Arguments = typename Conv::Arguments;
+    using SampleArguments = typename Conv::SampleArguments;
     int num_samples = in.size();
     int num_scales = conv_epilogue.num_samples();
 
@@ -144,7 +172,7 @@ struct ConvolutionGpu {
 
     Arguments args;
     args.device_params_ptr =
-        ctx.scratchpad->AllocateGPU<typename CutlassConv::SampleParams>(num_samples);
+        ctx.scratchpad->AllocateGPU<typename Conv::SampleParams>(num_samples);
 
     if (kIsInnerConv) {
       // Inner (innermost) - repack arguments
@@ -235,14 +263,13 @@ struct ConvolutionGpu {
       }
     }
     // Construct and invoke the CUTLASS kernel
-    CutlassConv gemm_operator;
+    Conv gemm_operator;
     auto status = gemm_operator.can_implement(args);
     DALI_ENFORCE(status == cutlass::Status::kSuccess,
                  make_string("Operation not possible: ", cutlass::cutlassGetStatusString(status)));
     gemm_operator(args, ctx.gpu.stream);
   }
 
- private:
   // Innermost convolution requires channel handling and multiplies by "kernel matrix"
   // (matrix generated based on convolution kernel windows) from right.
   // Non-innermost convolutions are channel agnostic (assume channels = 1) and place the
@@ -275,15 +302,60 @@ struct ConvolutionGpu {
       CutlassWindowConfig,  /// Size and layout of SMEM for window kernel lookups
       float>;               /// Element type for internal accumulation
 
+  // Tensor Core kernel for half-precision input. The window is cast to half when loading it,
+  // the accumulation is done in float. The alignment of 1 element keeps the requirements on the
+  // input shapes the same as in the SIMT kernel.
+  using CutlassConvTensorOp = typename cutlass::gemm::device::Conv<
+      cutlass_In,                           /// Data-type of Input matrix
+      cutlass::half_t,                      /// Additional cast for Input matrix type when loading
+      RowMajor,                             /// Layout of Input matrix
+      cutlass_W,                            /// Data-type of Conv window
+      cutlass::half_t,                      /// Additional cast for Conv window type when loading
+      cutlass_Out,                          /// Data-type of Output matrix
+      RowMajor,                             /// Layout of Output matrix
+      kIsInnerConv,                         /// convolution kind
+      CutlassWindowConfig,                  /// Size and layout of SMEM for window kernel lookups
+      float,                                /// Element type for internal accumulation
+      cutlass::arch::OpClassTensorOp,       /// Operator class
+      cutlass::arch::Sm75,                  /// Minimum architecture
+      cutlass::gemm::GemmShape<128, 128, 32>,  /// Threadblock-level tile size
+      cutlass::gemm::GemmShape<64, 64, 32>,    /// Warp-level tile size
+      cutlass::gemm::GemmShape<16, 8, 8>,      /// Instruction-level tile size
+      cutlass::epilogue::thread::LinearCombination<cutlass_Out, 1, float, float>,
+      cutlass::gemm::threadblock::GemmIdentityThreadblockSwizzle<>,
+      2,                                    /// Number of stages
+      1,                                    /// Alignment of A matrix
+      1>;                                   /// Alignment of B matrix
+
+  static constexpr bool kHasTensorOpConv = std::is_same<In, float16>::value;
+
+  /**
+   * @brief The smallest window for which the Tensor Core kernel is used.
+   *
+   * With small windows the generated matrix is mostly zeros and the kernel is bound by
+   * the memory bandwidth, so there's nothing to gain from the faster math.
+   */
+  static constexpr int kTensorOpMinWindowSize = 31;
+
+  static bool UseTensorOp(const TensorListShape<1>& window_size) {
+    if (!kHasTensorOpConv)
+      return false;
+    int max_window_size = 0;
+    for (int i = 0; i < window_size.num_samples(); i++)
+      max_window_size = std::max<int>(max_window_size, window_size[i][0]);
+    if (max_window_size < kTensorOpMinWindowSize)
+      return false;
+    const auto& props = GetDeviceProperties();
+    return props.major * 10 + props.minor >= 75;
+  }
+
+  bool use_tensor_op_ = false;
+
 
   static constexpr int kMaxWindowSize = CutlassConv::ConvWindowConfiguration::kMaxWindowSize;
   static constexpr int kWindowCopyBufferSize =
       CutlassConv::ConvWindowConfiguration::kTotalAlignedSize;
 
-  using Arguments = typename CutlassConv::Arguments;
-
-  using SampleArguments = typename CutlassConv::SampleArguments;
-
   static_assert(0 <= axis && axis <= kLastSpatialDim,
                 "Selected axis must be in [0, ndim) when there is no channel axis, or in [0, ndim "
                 "- 1) for channel-last input");
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -20,6 +20,7 @@
 
 #include "dali/core/boundary.h"
 #include "dali/core/convert.h"
+#include "dali/core/float16.h"
 #include "dali/kernels/common/utils.h"
 #include "dali/kernels/imgproc/convolution/baseline_convolution.h"
 #include "dali/kernels/imgproc/convolution/convolution_cpu.h"
@@ -288,5 +289,62 @@ REGISTER_TYPED_TEST_SUITE_P(ConvolutionGpuKernelTest, DoConvolution);
 INSTANTIATE_TYPED_TEST_SUITE_P(ConvolutionGpuKernel, ConvolutionGpuKernelTest,
                                ConvolutionTestValues);
 
+/**
+ * @brief Compares the convolution of half-precision input, which uses Tensor Cores for big windows
+ *        (when available), with the convolution of the same values stored as float.
+ */
+template <int axis>
+void TestHalfInputConvolution() {
+  constexpr int ndim = 3;
+  TensorListShape<ndim> shape = {{{64, 300, 3}, {200, 150, 3}, {31, 500, 1}, {1, 40, 2}}};
+  TensorListShape<1> window_shape = {{{31, 61, 101, 45}}};
+
+  TestTensorList<float16, ndim> in_half;
+  TestTensorList<float, ndim> in_float, out, ref;
+  TestTensorList<float, 1> windows;
+  in_half.reshape(shape);
+  in_float.reshape(shape);
+  out.reshape(shape);
+  ref.reshape(shape);
+  windows.reshape(window_shape);
+
+  std::mt19937 rng;
+  UniformRandomFill(in_half.cpu(), rng, 0, 1);
+  UniformRandomFill(windows.cpu(), rng, 0, 1);
+  auto in_half_cpu = in_half.cpu();
+  auto in_float_cpu = in_float.cpu();
+  for (int i = 0; i < shape.num_samples(); i++) {
+    for (int64_t j = 0; j < in_half_cpu[i].num_elements(); j++)
+      in_float_cpu[i].data[j] = in_half_cpu[i].data[j];
+  }
+
+  auto run = [&](auto &kernel, auto in_gpu, auto out_gpu) {
+    KernelContext ctx;
+    ctx.gpu.stream = 0;
+    auto req = kernel.Setup(ctx, in_gpu.shape, window_shape);
+    ScratchpadAllocator scratch_alloc;
+    scratch_alloc.Reserve(req.scratch_sizes);
+    auto scratchpad = scratch_alloc.GetScratchpad();
+    ctx.scratchpad = &scratchpad;
+    kernel.Run(ctx, out_gpu, in_gpu, windows.cpu());
+    CUDA_CALL(cudaStreamSynchronize(0));
+  };
+
+  ConvolutionGpu<float, float16, float, ndim, axis, true> kernel_half;
+  ConvolutionGpu<float, float, float, ndim, axis, true> kernel_float;
+  run(kernel_half, in_half.gpu(), out.gpu());
+  run(kernel_float, in_float.gpu(), ref.gpu());
+  // the window is rounded to half precision in the Tensor Core kernel
+  Check(out.cpu(), ref.cpu(), EqualEpsRel(1e-2, 1e-3));
+}
+
+TEST(ConvolutionGpuHalfInputTest, OuterAxis) {
+  TestHalfInputConvolution<0>();
+}
+
+TEST(ConvolutionGpuHalfInputTest, InnerAxis) {
+  TestHalfInputConvolution<1>();
+}
+
 }  // namespace kernels
 }  // namespace dali
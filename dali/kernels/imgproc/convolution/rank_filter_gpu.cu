@@ -0,0 +1,217 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include "dali/core/convert.h"
+#include "dali/core/cuda_error.h"
+#include "dali/core/static_switch.h"
+#include "dali/core/util.h"
+#include "dali/kernels/imgproc/convolution/rank_filter_gpu.h"
+
+namespace dali {
+namespace kernels {
+
+namespace rank_filter {
+
+using boundary::BoundaryType;
+
+constexpr int kTileWidth = 32;
+constexpr int kTileHeight = 8;
+constexpr int kMaxHalo = RankFilterGPU<uint8_t>::kMaxWindow - 1;
+constexpr int kMaxChannels = RankFilterGPU<uint8_t>::kMaxChannels;
+constexpr int kMaxTileSize = (kTileWidth + kMaxHalo) * (kTileHeight + kMaxHalo) * kMaxChannels;
+constexpr int kMaxGridExtent = 64;
+
+template <BoundaryType border>
+__device__ __forceinline__ int Remap(int idx, int size) {
+  if constexpr (border == BoundaryType::CLAMP)
+    return boundary::idx_clamp(idx, size);
+  else if constexpr (border == BoundaryType::REFLECT_1001)
+    return boundary::idx_reflect_1001(idx, size);
+  else if constexpr (border == BoundaryType::REFLECT_101)
+    return boundary::idx_reflect_101(idx, size);
+  else if constexpr (border == BoundaryType::WRAP)
+    return boundary::idx_wrap(idx, size);
+  else
+    return idx;
+}
+
+/** The value of the out-of-bounds pixels with the CONSTANT border - it never wins. */
+template <RankFilterType type, typename T>
+__device__ __forceinline__ T NeutralValue() {
+  return type == RankFilterType::Min ? max_value<T>() : min_value<T>();
+}
+
+template <typename T>
+__device__ __forceinline__ void SortPair(T &a, T &b) {
+  T lo = b < a ? b : a;
+  T hi = b < a ? a : b;
+  a = lo;
+  b = hi;
+}
+
+/**
+ * @brief Finds the median of an n x n window in the shared memory tile.
+ *
+ * The first half of the values is sorted with selection; all the indices are known at compile
+ * time, so the window stays in registers.
+ */
+template <int n, typename T>
+__device__ __forceinline__ T WindowMedian(const T *tile, int row_stride, int channels) {
+  constexpr int kSize = n * n;
+  T v[kSize];
+  #pragma unroll
+  for (int j = 0; j < n; j++) {
+    #pragma unroll
+    for (int i = 0; i < n; i++)
+      v[j * n + i] = tile[j * row_stride + i * channels];
+  }
+  #pragma unroll
+  for (int k = 0; k <= kSize / 2; k++) {
+    #pragma unroll
+    for (int m = k + 1; m < kSize; m++)
+      SortPair(v[k], v[m]);
+  }
+  return v[kSize / 2];
+}
+
+template <RankFilterType type, typename T>
+__device__ __forceinline__ T WindowExtremum(const T *tile, int row_stride, int channels,
+                                            ivec2 window) {
+  T acc = tile[0];
+  for (int j = 0; j < window.y; j++) {
+    for (int i = 0; i < window.x; i++) {
+      T v = tile[j * row_stride + i * channels];
+      if (type == RankFilterType::Min)
+        acc = v < acc ? v : acc;
+      else
+        acc = acc < v ? v : acc;
+    }
+  }
+  return acc;
+}
+
+template <RankFilterType type, BoundaryType border, typename T>
+__global__ void RankFilterKernel(const SampleDesc<T> *samples) {
+  __shared__ T tile[kMaxTileSize];
+  const auto sample = samples[blockIdx.z];
+  const int W = sample.size.x, H = sample.size.y, C = sample.channels;
+  const int tile_w = kTileWidth + sample.window.x - 1;
+  const int tile_h = kTileHeight + sample.window.y - 1;
+  const int row_stride = tile_w * C;
+  const int tid = threadIdx.y * blockDim.x + threadIdx.x;
+  const int nthreads = blockDim.x * blockDim.y;
+
+  for (int y0 = blockIdx.y * kTileHeight; y0 < H; y0 += gridDim.y * kTileHeight) {
+    for (int x0 = blockIdx.x * kTileWidth; x0 < W; x0 += gridDim.x * kTileWidth) {
+      __syncthreads();  // the previous tile is no longer used
+      for (int idx = tid; idx < tile_w * tile_h; idx += nthreads) {
+        int ty = idx / tile_w;
+        int tx = idx - ty * tile_w;
+        int y = y0 - sample.anchor.y + ty;
+        int x = x0 - sample.anchor.x + tx;
+        T *dst = tile + idx * C;
+        if (border == BoundaryType::CONSTANT && (x < 0 || y < 0 || x >= W || y >= H)) {
+          for (int c = 0; c < C; c++)
+            dst[c] = NeutralValue<type, T>();
+          continue;
+        }
+        const T *src = sample.in + (static_cast<int64_t>(Remap<border>(y, H)) * W +
+                                    Remap<border>(x, W)) * C;
+        for (int c = 0; c < C; c++)
+          dst[c] = src[c];
+      }
+      __syncthreads();
+
+      int x = x0 + threadIdx.x, y = y0 + threadIdx.y;
+      if (x >= W || y >= H)
+        continue;
+      const T *window = tile + threadIdx.y * row_stride + threadIdx.x * C;
+      T *out = sample.out + (static_cast<int64_t>(y) * W + x) * C;
+      for (int c = 0; c < C; c++) {
+        if constexpr (type == RankFilterType::Median) {
+          out[c] = sample.window.x == 3 ? WindowMedian<3>(window + c, row_stride, C)
+                                        : WindowMedian<5>(window + c, row_stride, C);
+        } else {
+          out[c] = WindowExtremum<type>(window + c, row_stride, C, sample.window);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace rank_filter
+
+template <typename T>
+void RankFilterGPU<T>::Run(KernelContext &ctx, const OutListGPU<T, 3> &out,
+                           const InListGPU<T, 3> &in, RankFilterType type,
+                           span<const ivec2> window, span<const ivec2> anchor,
+                           boundary::BoundaryType border) {
+  using boundary::BoundaryType;
+  int nsamples = in.num_samples();
+  DALI_ENFORCE(out.num_samples() == nsamples && window.size() == nsamples &&
+               anchor.size() == nsamples, "The number of samples doesn't match.");
+  DALI_ENFORCE(type != RankFilterType::Median || border != BoundaryType::CONSTANT,
+               "The constant border is not supported for the median filter.");
+  samples_.clear();
+  int max_w = 0, max_h = 0;
+  for (int s = 0; s < nsamples; s++) {
+    auto shape = in.tensor_shape(s);
+    DALI_ENFORCE(out.tensor_shape(s) == shape, "The output shape must match the input shape.");
+    if (volume(shape) == 0)
+      continue;
+    int channels = shape[2];
+    DALI_ENFORCE(IsSupported(type, window[s], channels),
+                 make_string("Unsupported window ", window[s].x, "x", window[s].y, " or number "
+                             "of channels ", channels, " in the sample ", s, "."));
+    ivec2 sample_anchor;
+    for (int d = 0; d < 2; d++) {
+      sample_anchor[d] = anchor[s][d] < 0 ? window[s][d] / 2 : anchor[s][d];
+      DALI_ENFORCE(sample_anchor[d] < window[s][d],
+                   make_string("The anchor must lie within the window; got ", anchor[s][d],
+                               " for the window extent ", window[s][d], "."));
+    }
+    ivec2 size(shape[1], shape[0]);
+    samples_.push_back({out.tensor_data(s), in.tensor_data(s), size, channels, window[s],
+                        sample_anchor});
+    max_w = std::max(max_w, size.x);
+    max_h = std::max(max_h, size.y);
+  }
+  if (samples_.empty())
+    return;
+
+  auto *samples_dev = ctx.scratchpad->ToGPU(ctx.gpu.stream, samples_);
+  dim3 block(rank_filter::kTileWidth, rank_filter::kTileHeight);
+  dim3 grid(std::min(div_ceil(max_w, rank_filter::kTileWidth), rank_filter::kMaxGridExtent),
+            std::min(div_ceil(max_h, rank_filter::kTileHeight), rank_filter::kMaxGridExtent),
+            samples_.size());
+  VALUE_SWITCH(type, static_type,
+      (RankFilterType::Median, RankFilterType::Min, RankFilterType::Max), (
+    VALUE_SWITCH(border, static_border,
+        (BoundaryType::CONSTANT, BoundaryType::CLAMP, BoundaryType::REFLECT_1001,
+         BoundaryType::REFLECT_101, BoundaryType::WRAP), (
+      rank_filter::RankFilterKernel<static_type, static_border>
+          <<<grid, block, 0, ctx.gpu.stream>>>(samples_dev);
+    ), DALI_FAIL(make_string("Unsupported border type: ", static_cast<int>(border))));  // NOLINT
+  ), DALI_FAIL("Unsupported rank filter type."));  // NOLINT
+  CUDA_CALL(cudaGetLastError());
+}
+
+template class RankFilterGPU<uint8_t>;
+template class RankFilterGPU<uint16_t>;
+template class RankFilterGPU<int16_t>;
+template class RankFilterGPU<float>;
+
+}  // namespace kernels
+}  // namespace dali
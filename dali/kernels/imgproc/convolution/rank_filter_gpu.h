@@ -0,0 +1,89 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_CONVOLUTION_RANK_FILTER_GPU_H_
+#define DALI_KERNELS_IMGPROC_CONVOLUTION_RANK_FILTER_GPU_H_
+
+#include <vector>
+#include "dali/core/boundary.h"
+#include "dali/core/common.h"
+#include "dali/core/geom/vec.h"
+#include "dali/core/span.h"
+#include "dali/core/tensor_view.h"
+#include "dali/kernels/kernel.h"
+
+namespace dali {
+namespace kernels {
+
+enum class RankFilterType {
+  Median,  ///< the median of the window
+  Min,     ///< the minimum of the window (erosion)
+  Max,     ///< the maximum of the window (dilation)
+};
+
+namespace rank_filter {
+
+template <typename T>
+struct SampleDesc {
+  T *__restrict__ out;
+  const T *__restrict__ in;
+  ivec2 size;  // (width, height)
+  int channels;
+  ivec2 window, anchor;
+};
+
+}  // namespace rank_filter
+
+/**
+ * @brief Applies a median, minimum or maximum filter with a small window to a batch of
+ *        HWC images.
+ *
+ * The kernel covers the windows which are the most common in the augmentation pipelines
+ * (up to 5x5). Similarly to the FilterGpu, a tile of the input (with the halo) is loaded to
+ * the shared memory, once per block, and each thread computes an output pixel from it.
+ * The median of the 3x3 and 5x5 windows is found with an unrolled selection network, which
+ * keeps the window in registers.
+ *
+ * The `anchor` is the position of the output pixel in the window; -1 stands for the center
+ * (`window / 2`). With the CONSTANT border the pixels outside of the image don't contribute
+ * to the minimum/maximum (as for erosion and dilation in OpenCV) - it is not supported for
+ * the median.
+ */
+template <typename T>
+class DLL_PUBLIC RankFilterGPU {
+ public:
+  static constexpr int kMaxWindow = 5;
+  static constexpr int kMaxChannels = 4;
+
+  /** Whether the kernel can handle the window and the number of channels */
+  static bool IsSupported(RankFilterType type, ivec2 window, int channels) {
+    if (channels < 1 || channels > kMaxChannels)
+      return false;
+    if (type == RankFilterType::Median)
+      return window.x == window.y && (window.x == 3 || window.x == 5);
+    return window.x >= 1 && window.y >= 1 && window.x <= kMaxWindow && window.y <= kMaxWindow;
+  }
+
+  void Run(KernelContext &ctx, const OutListGPU<T, 3> &out, const InListGPU<T, 3> &in,
+           RankFilterType type, span<const ivec2> window, span<const ivec2> anchor,
+           boundary::BoundaryType border);
+
+ private:
+  std::vector<rank_filter::SampleDesc<T>> samples_;
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_CONVOLUTION_RANK_FILTER_GPU_H_
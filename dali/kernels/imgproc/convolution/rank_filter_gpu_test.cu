@@ -0,0 +1,142 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "dali/core/boundary.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/imgproc/convolution/rank_filter_gpu.h"
+#include "dali/test/tensor_test_utils.h"
+#include "dali/test/test_tensors.h"
+
+namespace dali {
+namespace kernels {
+
+using boundary::BoundaryType;
+
+namespace {
+
+int RemapBaseline(int idx, int size, BoundaryType border) {
+  switch (border) {
+    case BoundaryType::CLAMP:
+      return boundary::idx_clamp(idx, size);
+    case BoundaryType::REFLECT_1001:
+      return boundary::idx_reflect_1001(idx, size);
+    case BoundaryType::REFLECT_101:
+      return boundary::idx_reflect_101(idx, size);
+    case BoundaryType::WRAP:
+      return boundary::idx_wrap(idx, size);
+    default:
+      return idx;
+  }
+}
+
+template <typename T>
+void RankFilterBaseline(const TensorView<StorageCPU, T, 3> &out,
+                        const TensorView<StorageCPU, T, 3> &in, RankFilterType type,
+                        ivec2 window, ivec2 anchor, BoundaryType border) {
+  int H = in.shape[0], W = in.shape[1], C = in.shape[2];
+  std::vector<T> values;
+  for (int y = 0; y < H; y++) {
+    for (int x = 0; x < W; x++) {
+      for (int c = 0; c < C; c++) {
+        values.clear();
+        for (int j = 0; j < window.y; j++) {
+          for (int i = 0; i < window.x; i++) {
+            int sy = y - anchor.y + j, sx = x - anchor.x + i;
+            if (border == BoundaryType::CONSTANT && (sx < 0 || sy < 0 || sx >= W || sy >= H))
+              continue;  // doesn't contribute to the minimum/maximum
+            sy = RemapBaseline(sy, H, border);
+            sx = RemapBaseline(sx, W, border);
+            values.push_back(*in(sy, sx, c));
+          }
+        }
+        T result;
+        if (type == RankFilterType::Min) {
+          result = *std::min_element(values.begin(), values.end());
+        } else if (type == RankFilterType::Max) {
+          result = *std::max_element(values.begin(), values.end());
+        } else {
+          std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+          result = values[values.size() / 2];
+        }
+        *out(y, x, c) = result;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+class RankFilterGPUTest : public ::testing::Test {
+ protected:
+  void RunTest(RankFilterType type, BoundaryType border, const std::vector<ivec2> &windows,
+               const std::vector<ivec2> &anchors) {
+    TensorListShape<3> shape({{1, 1, 1}, {37, 41, 3}, {8, 5, 1}, {90, 33, 4}, {300, 250, 3}});
+    ASSERT_EQ(windows.size(), static_cast<size_t>(shape.num_samples()));
+    TestTensorList<T, 3> in, out, baseline;
+    in.reshape(shape);
+    out.reshape(shape);
+    baseline.reshape(shape);
+    std::mt19937 rng(1234);
+    UniformRandomFill(in.cpu(), rng, 0, 100);
+
+    KernelContext ctx;
+    ctx.gpu.stream = 0;
+    DynamicScratchpad scratchpad({}, AccessOrder(ctx.gpu.stream));
+    ctx.scratchpad = &scratchpad;
+    RankFilterGPU<T> kernel;
+    kernel.Run(ctx, out.gpu(), in.gpu(), type, make_cspan(windows), make_cspan(anchors),
+               border);
+
+    auto in_cpu = in.cpu();
+    auto baseline_cpu = baseline.cpu();
+    for (int s = 0; s < shape.num_samples(); s++) {
+      ivec2 anchor = anchors[s];
+      for (int d = 0; d < 2; d++) {
+        if (anchor[d] < 0)
+          anchor[d] = windows[s][d] / 2;
+      }
+      RankFilterBaseline(baseline_cpu[s], in_cpu[s], type, windows[s], anchor, border);
+    }
+    Check(out.cpu(), baseline_cpu);
+  }
+};
+
+using RankFilterTypes = ::testing::Types<uint8_t, int16_t, float>;
+TYPED_TEST_SUITE(RankFilterGPUTest, RankFilterTypes);
+
+TYPED_TEST(RankFilterGPUTest, Median) {
+  std::vector<ivec2> windows = {{3, 3}, {5, 5}, {3, 3}, {5, 5}, {3, 3}};
+  std::vector<ivec2> anchors(windows.size(), ivec2(-1, -1));
+  for (auto border : {BoundaryType::CLAMP, BoundaryType::REFLECT_101, BoundaryType::WRAP})
+    this->RunTest(RankFilterType::Median, border, windows, anchors);
+}
+
+TYPED_TEST(RankFilterGPUTest, MinMax) {
+  std::vector<ivec2> windows = {{3, 3}, {1, 5}, {4, 2}, {5, 5}, {2, 3}};
+  std::vector<ivec2> anchors = {{-1, -1}, {0, 4}, {-1, -1}, {1, 3}, {1, 0}};
+  for (auto type : {RankFilterType::Min, RankFilterType::Max}) {
+    for (auto border : {BoundaryType::CONSTANT, BoundaryType::CLAMP, BoundaryType::REFLECT_1001,
+                        BoundaryType::REFLECT_101, BoundaryType::WRAP})
+      this->RunTest(type, border, windows, anchors);
+  }
+}
+
+}  // namespace kernels
+}  // namespace dali
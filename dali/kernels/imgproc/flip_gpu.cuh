@@ -101,19 +101,35 @@ class DLL_PUBLIC FlipGPU {
                       const std::vector<int> &flip_x) {
     auto num_samples = static_cast<size_t>(in.num_samples());
     DALI_ENFORCE(flip_x.size() == num_samples && flip_y.size() == num_samples);
+    if (num_samples == 0)
+      return;
+    if (SameFlips(flip_z, flip_y, flip_x) && in.is_tensor() && out.is_tensor()) {
+      // The samples of a uniform, packed batch are consecutive frames of one sequence -
+      // flip them all with a single launch.
+      auto shape = in.tensor_shape(0);
+      shape[0] *= num_samples;
+      detail::gpu::FlipImpl(out.data[0], in.data[0], shape, flip_z[0], flip_y[0], flip_x[0],
+                            context.gpu.stream);
+      return;
+    }
     for (size_t i = 0; i < num_samples; ++i) {
       const auto &shape = in.tensor_shape(i);
-      auto seq_length = shape[0];
-      auto depth = shape[1];
-      auto height = shape[2];
-      auto width = shape[3];
-      auto channels = shape[4];
       auto in_data = in[i].data;
       auto out_data = out[i].data;
       detail::gpu::FlipImpl(out_data, in_data, shape, flip_z[i], flip_y[i], flip_x[i],
                             context.gpu.stream);
     }
   }
+
+ private:
+  static bool SameFlips(const std::vector<int> &flip_z, const std::vector<int> &flip_y,
+                        const std::vector<int> &flip_x) {
+    for (size_t i = 1; i < flip_x.size(); i++) {
+      if (flip_z[i] != flip_z[0] || flip_y[i] != flip_y[0] || flip_x[i] != flip_x[0])
+        return false;
+    }
+    return true;
+  }
 };
 
 }  // namespace kernels
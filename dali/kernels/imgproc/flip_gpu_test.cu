@@ -94,6 +94,29 @@ TEST_P(FlipGpuTest, KernelTest) {
   }
 }
 
+TEST_P(FlipGpuTest, KernelTestSameFlips) {
+  KernelContext ctx;
+  ctx.gpu.stream = 0;
+  FlipGPU<float> kernel;
+  auto in_view = ttl_in_.gpu(nullptr);
+  ttl_in_.invalidate_cpu();
+  ASSERT_TRUE(in_view.is_tensor());
+  KernelRequirements reqs = kernel.Setup(ctx, in_view);
+  ttl_out_.reshape(reqs.output_shapes[0].to_static<sample_ndim>());
+  auto out_view = ttl_out_.gpu();
+  int N = in_view.num_samples();
+  std::vector<int> flip_z(N, 1), flip_y(N, 0), flip_x(N, 1);
+  kernel.Run(ctx, out_view, in_view, flip_z, flip_y, flip_x);
+  auto out_view_cpu = ttl_out_.cpu(nullptr);
+  auto in_view_cpu = ttl_in_.cpu(nullptr);
+  for (int i = 0; i < out_view_cpu.num_samples(); ++i) {
+    ASSERT_TRUE(is_flipped(out_view_cpu.tensor_data(i),
+                           in_view_cpu.tensor_data(i),
+                           shape_[i][0], shape_[i][1], shape_[i][2], shape_[i][3], shape_[i][4],
+                           flip_z[i], flip_y[i], flip_x[i]));
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(FlipGpuTest, FlipGpuTest,
     ::testing::ValuesIn({
         std::array<Index, sample_ndim>{4, 1, 2, 2, 10},
@@ -1,4 +1,4 @@
-// Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -149,8 +149,14 @@ __global__ void ChromaSubsampleDistortion(const SampleDesc *samples,
   }
 }
 
-__device__ __inline__ float quantize(float value, float Q_coeff) {
-  return Q_coeff * roundf(value * __frcp_rn(Q_coeff));
+/**
+ * @brief Quantizes a DCT coefficient.
+ *
+ * The reciprocal of the quantization coefficient is passed by the caller, which computes it
+ * once per thread, rather than once per coefficient.
+ */
+__device__ __inline__ float quantize(float value, float Q_coeff, float Q_coeff_rcp) {
+  return Q_coeff * roundf(value * Q_coeff_rcp);
 }
 
 /**
@@ -195,15 +201,21 @@ __global__ void JpegCompressionDistortion(const SampleDesc *samples,
   luma_x = luma_x & 7;  // % 8
   luma_y = luma_y & 7;  // % 8
 
+  // The quantization coefficients don't change within the sample - each thread keeps
+  // the ones (and their reciprocals) for the coefficients it quantizes in the registers.
   float luma_q[1 + vert_subsample][1 + horz_subsample];
+  float luma_q_rcp[1 + vert_subsample][1 + horz_subsample];
   #pragma unroll
   for (int i = 0; i < 1 + vert_subsample; i++) {
     #pragma unroll
-    for (int j = 0; j < 1 + horz_subsample; j++)
+    for (int j = 0; j < 1 + horz_subsample; j++) {
       luma_q[i][j] = __ldg(&sample.luma_Q_table(luma_y + i, luma_x + j));
+      luma_q_rcp[i][j] = __frcp_rn(luma_q[i][j]);
+    }
   }
 
   float chroma_q = __ldg(&sample.chroma_Q_table(chroma_y, chroma_x));
+  float chroma_q_rcp = __frcp_rn(chroma_q);
 
 
   const Surface2D<const uint8_t> in = {
@@ -265,19 +277,21 @@ __global__ void JpegCompressionDistortion(const SampleDesc *samples,
         for (int page = 0; page < num_pages; page++) {
           int cofs = chroma_page * page;
           int lofs = luma_page * page;
-          cb[cofs][chroma_y][chroma_x] = quantize(cb[cofs][chroma_y][chroma_x], chroma_q);
-          cr[cofs][chroma_y][chroma_x] = quantize(cr[cofs][chroma_y][chroma_x], chroma_q);
+          float &Cb = cb[cofs][chroma_y][chroma_x];
+          float &Cr = cr[cofs][chroma_y][chroma_x];
+          Cb = quantize(Cb, chroma_q, chroma_q_rcp);
+          Cr = quantize(Cr, chroma_q, chroma_q_rcp);
           #pragma unroll
           for (int i = 0, k = 0; i < vert_subsample+1; i++) {
             #pragma unroll
             for (int j = 0; j < horz_subsample+1; j++, k++) {
-              float Y = luma[lofs][luma_y + i][luma_x + j];
-              luma[lofs][luma_y + i][luma_x + j] = quantize(Y, luma_q[i][j]);
+              float &Y = luma[lofs][luma_y + i][luma_x + j];
+              Y = quantize(Y, luma_q[i][j], luma_q_rcp[i][j]);
             }
           }
         }
+        __syncthreads();  // the inverse DCT reads the coefficients quantized by other threads
       }
-      __syncthreads();
 
       for (int slice_id = tid; slice_id < num_dct_slices; slice_id += block_size) {
         dct_inv_8x8_1d<row_stride>(&flat_blocks[slice_id >> 3][0][slice_id & 7]);
@@ -250,8 +250,134 @@ PasteKernel(const SampleDescriptorGPU<OutputType, InputType, ndims> *samples,
   }
 }
 
+/**
+ * @brief A region copied directly from an input to an output
+ *
+ * The width is flattened with the channels; the pitches and offsets are in elements.
+ */
+template <class OutputType, class InputType>
+struct RegionDesc {
+  OutputType *out;
+  const InputType *in;
+  int out_sample_idx;
+  int in_sample_idx, in_batch_idx;
+  int64_t out_offset, in_offset;
+  int out_pitch, in_pitch;
+};
+
+/**
+ * @brief The maximum number of regions per sample for which the overlap is checked
+ *
+ * The check is quadratic in the number of regions; with more regions, the generic path is used.
+ */
+constexpr int kMaxDirectPasteRegions = 64;
+
+/**
+ * @brief Checks whether the pasted regions of all the samples are pairwise disjoint
+ *
+ * In such a case, each region can be copied independently, without looking up the topmost
+ * region for every output pixel.
+ */
+template <int ndims>
+bool RegionsDisjoint(span<const MultiPasteSampleInput<ndims>> samples) {
+  for (const auto &sample : samples) {
+    int n = sample.inputs.size();
+    if (n > kMaxDirectPasteRegions)
+      return false;
+    for (int i = 0; i < n; i++) {
+      const auto &a = sample.inputs[i];
+      Box<ndims, int> box_a(a.out_anchor, a.out_anchor + a.size);
+      for (int j = i + 1; j < n; j++) {
+        const auto &b = sample.inputs[j];
+        if (box_a.overlaps(Box<ndims, int>(b.out_anchor, b.out_anchor + b.size)))
+          return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Creates the descriptors of the regions to copy; for the samples that are not fully
+ *        covered by the regions, `needs_fill` is set
+ */
+template <class OutputType, class InputType, int ndims>
+void CreateRegionDescriptors(
+    std::vector<RegionDesc<OutputType, InputType>> &out_regions,
+    TensorListShape<2> &region_shapes,
+    std::vector<bool> &needs_fill,
+    const span<TensorListShape<ndims>> &in_shapes,
+    span<paste::MultiPasteSampleInput<ndims - 1>> samples) {
+  static_assert(ndims == 3, "Only 2D data with channels supported");
+  int batch_size = samples.size();
+  out_regions.clear();
+  needs_fill.resize(batch_size);
+  std::vector<TensorShape<2>> shapes;
+  for (int out_idx = 0; out_idx < batch_size; out_idx++) {
+    const auto &sample = samples[out_idx];
+    const int channels = sample.channels;
+    int64_t covered = 0;
+    for (const auto &input : sample.inputs) {
+      int64_t area = static_cast<int64_t>(input.size[0]) * input.size[1];
+      if (area == 0)
+        continue;
+      covered += area;
+      int in_width = in_shapes[input.batch_idx][input.in_idx][1];
+      RegionDesc<OutputType, InputType> region;
+      region.out = nullptr;  // to be filled later
+      region.in = nullptr;
+      region.out_sample_idx = out_idx;
+      region.in_sample_idx = input.in_idx;
+      region.in_batch_idx = input.batch_idx;
+      region.out_pitch = sample.out_size[1] * channels;
+      region.in_pitch = in_width * channels;
+      region.out_offset = (static_cast<int64_t>(input.out_anchor[0]) * sample.out_size[1] +
+                           input.out_anchor[1]) * channels;
+      region.in_offset = (static_cast<int64_t>(input.in_anchor[0]) * in_width +
+                          input.in_anchor[1]) * channels;
+      out_regions.push_back(region);
+      shapes.push_back({input.size[0], input.size[1] * channels});
+    }
+    needs_fill[out_idx] = covered < static_cast<int64_t>(sample.out_size[0]) * sample.out_size[1];
+  }
+  region_shapes = TensorListShape<2>(shapes);
+}
+
+template <class OutputType, class InputType>
+void FillPointers(span<RegionDesc<OutputType, InputType>> regions,
+                  const OutListGPU<OutputType, 3> &out,
+                  const span<InListGPU<InputType, 3>> &ins) {
+  for (auto &r : regions) {
+    r.out = out.data[r.out_sample_idx] + r.out_offset;
+    r.in = ins[r.in_batch_idx].data[r.in_sample_idx] + r.in_offset;
+  }
+}
+
+template <class OutputType, class InputType>
+__global__ void PasteRegionsKernel(const RegionDesc<OutputType, InputType> *regions,
+                                   const BlockDesc<2> *blocks) {
+  const auto &block = blocks[blockIdx.x];
+  const auto &region = regions[block.sample_idx];
+  for (int y = block.start.y + static_cast<int>(threadIdx.y);
+       y < block.end.y; y += static_cast<int>(blockDim.y)) {
+    auto *__restrict__ out = region.out + static_cast<int64_t>(y) * region.out_pitch;
+    const auto *__restrict__ in = region.in + static_cast<int64_t>(y) * region.in_pitch;
+    for (int x = block.start.x + static_cast<int>(threadIdx.x);
+         x < block.end.x; x += static_cast<int>(blockDim.x)) {
+      out[x] = ConvertSat<OutputType>(in[x]);
+    }
+  }
+}
+
 }  // namespace paste
 
+/**
+ * @brief Pastes the regions of the inputs into the outputs
+ *
+ * When the regions don't overlap (e.g. mosaic), they're copied directly, in parallel, and only
+ * the outputs that are not fully covered are zeroed beforehand. Otherwise the output is split
+ * into patches, each taken from the topmost region covering it.
+ */
 template <typename OutputType, typename InputType, int ndims>
 class PasteGPU {
  private:
@@ -260,9 +386,15 @@ class PasteGPU {
   using SampleDesc = paste::SampleDescriptorGPU<OutputType, InputType, spatial_dims>;
   using PatchDesc = paste::PatchDesc<InputType, spatial_dims>;
 
+  using RegionDesc = paste::RegionDesc<OutputType, InputType>;
+
   std::vector<SampleDesc> sample_descriptors_;
   std::vector<PatchDesc> patch_descriptors_;
 
+  bool disjoint_regions_ = false;
+  std::vector<RegionDesc> region_descriptors_;
+  std::vector<bool> needs_fill_;
+
  public:
   BlockSetup<spatial_dims, -1 /* No channel dimension, only spatial */> block_setup_;
 
@@ -271,15 +403,23 @@ class PasteGPU {
       span<paste::MultiPasteSampleInput<spatial_dims>> samples,
       const TensorListShape<ndims> &out_shape,
       const span<TensorListShape<ndims>> &in_shapes) {
-    paste::CreateSampleDescriptors(sample_descriptors_, patch_descriptors_, in_shapes, samples);
-
     KernelRequirements req;
     ScratchpadEstimator se;
-    // merge width with channels
-    auto flattened_shape = collapse_dim(out_shape, spatial_dims - 1);
-    block_setup_.SetupBlocks(flattened_shape, true);
-    se.add<mm::memory_kind::device, SampleDesc>(sample_descriptors_.size());
-    se.add<mm::memory_kind::device, PatchDesc>(patch_descriptors_.size());
+    disjoint_regions_ = paste::RegionsDisjoint(make_cspan(samples));
+    if (disjoint_regions_) {
+      TensorListShape<2> region_shapes;
+      paste::CreateRegionDescriptors(region_descriptors_, region_shapes, needs_fill_,
+                                     in_shapes, samples);
+      block_setup_.SetupBlocks(region_shapes, true);
+      se.add<mm::memory_kind::device, RegionDesc>(region_descriptors_.size());
+    } else {
+      paste::CreateSampleDescriptors(sample_descriptors_, patch_descriptors_, in_shapes, samples);
+      // merge width with channels
+      auto flattened_shape = collapse_dim(out_shape, spatial_dims - 1);
+      block_setup_.SetupBlocks(flattened_shape, true);
+      se.add<mm::memory_kind::device, SampleDesc>(sample_descriptors_.size());
+      se.add<mm::memory_kind::device, PatchDesc>(patch_descriptors_.size());
+    }
     se.add<mm::memory_kind::device, BlockDesc>(block_setup_.Blocks().size());
     req.output_shapes = { out_shape };
     req.scratch_sizes = se.sizes;
@@ -291,6 +431,10 @@ class PasteGPU {
       KernelContext &context,
       const OutListGPU<OutputType, ndims> &out,
       const span<InListGPU<InputType, ndims>> &ins) {
+    if (disjoint_regions_) {
+      RunRegions(context, out, ins);
+      return;
+    }
     paste::FillPointers(make_span(sample_descriptors_), make_span(patch_descriptors_), out, ins);
 
     SampleDesc *samples_gpu;
@@ -308,6 +452,32 @@ class PasteGPU {
         samples_gpu, patches_gpu, blocks_gpu);
     CUDA_CALL(cudaGetLastError());
   }
+
+ private:
+  void RunRegions(
+      KernelContext &context,
+      const OutListGPU<OutputType, ndims> &out,
+      const span<InListGPU<InputType, ndims>> &ins) {
+    auto stream = context.gpu.stream;
+    for (int i = 0; i < out.num_samples(); i++) {
+      if (needs_fill_[i])
+        CUDA_CALL(cudaMemsetAsync(out.data[i], 0, out.shape[i].num_elements() * sizeof(OutputType),
+                                  stream));
+    }
+    if (region_descriptors_.empty())
+      return;
+    paste::FillPointers(make_span(region_descriptors_), out, ins);
+
+    RegionDesc *regions_gpu;
+    BlockDesc *blocks_gpu;
+    std::tie(regions_gpu, blocks_gpu) = context.scratchpad->ToContiguousGPU(
+        stream, region_descriptors_, block_setup_.Blocks());
+
+    dim3 grid_dim = block_setup_.GridDim();
+    dim3 block_dim = block_setup_.BlockDim();
+    paste::PasteRegionsKernel<<<grid_dim, block_dim, 0, stream>>>(regions_gpu, blocks_gpu);
+    CUDA_CALL(cudaGetLastError());
+  }
 };
 
 }  // namespace kernels
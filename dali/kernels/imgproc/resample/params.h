@@ -63,11 +63,11 @@ struct FilterDesc {
   bool antialias = true;
   float radius = 0;
 
-  constexpr bool operator==(const FilterDesc &rhs) {
+  constexpr bool operator==(const FilterDesc &rhs) const {
     return type == rhs.type && antialias == rhs.antialias && radius == rhs.radius;
   }
 
-  constexpr bool operator!=(const FilterDesc &rhs) {
+  constexpr bool operator!=(const FilterDesc &rhs) const {
     return !(*this == rhs);
   }
 };
@@ -88,8 +88,25 @@ struct ResamplingParams {
     bool use_roi = false;
     float start = 0;
     float end = 0;
+
+    constexpr bool operator==(const ROI &rhs) const {
+      return use_roi == rhs.use_roi && start == rhs.start && end == rhs.end;
+    }
+
+    constexpr bool operator!=(const ROI &rhs) const {
+      return !(*this == rhs);
+    }
   };
   ROI roi;
+
+  constexpr bool operator==(const ResamplingParams &rhs) const {
+    return min_filter == rhs.min_filter && mag_filter == rhs.mag_filter &&
+           output_size == rhs.output_size && roi == rhs.roi;
+  }
+
+  constexpr bool operator!=(const ResamplingParams &rhs) const {
+    return !(*this == rhs);
+  }
 };
 
 template <int ndim>
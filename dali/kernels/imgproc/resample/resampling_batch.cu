@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <cuda_runtime.h>
+#include <algorithm>
+#include "dali/core/cuda_rt_utils.h"
 #include "dali/kernels/imgproc/resample/resampling_batch.h"
 #include "dali/kernels/imgproc/resample/bilinear_impl.cuh"
 #include "dali/kernels/imgproc/resample/nearest_impl.cuh"
@@ -23,12 +25,10 @@ namespace kernels {
 namespace resampling {
 
 template <int spatial_ndim, typename Output, typename Input>
-__global__ void BatchedSeparableResampleKernel(
+__device__ void ResampleBlock(
     int which_pass,
     const SampleDesc<spatial_ndim> *__restrict__ samples,
-    const BlockDesc<spatial_ndim> *__restrict__ block2sample) {
-  // find which part of which sample this block will process
-  BlockDesc<spatial_ndim> bdesc = block2sample[blockIdx.x];
+    BlockDesc<spatial_ndim> bdesc) {
   const auto &sample = samples[bdesc.sample_idx];
   Output *__restrict__ sample_out;
   const Input *__restrict__ sample_in;
@@ -90,6 +90,20 @@ __global__ void BatchedSeparableResampleKernel(
   }
 }
 
+template <int spatial_ndim, typename Output, typename Input>
+__global__ void BatchedSeparableResampleKernel(
+    int which_pass,
+    const SampleDesc<spatial_ndim> *__restrict__ samples,
+    const BlockDesc<spatial_ndim> *__restrict__ block2sample,
+    int num_blocks) {
+  // The grid may be smaller than the number of blocks (persistent grid).
+  // The resampling functions synchronize the threads before reusing the shared memory.
+  for (int b = blockIdx.x; b < num_blocks; b += gridDim.x) {
+    // find which part of which sample this block will process
+    ResampleBlock<spatial_ndim, Output, Input>(which_pass, samples, block2sample[b]);
+  }
+}
+
 template <int spatial_ndim, typename Output, typename Input>
 void BatchedSeparableResample(
     int which_pass,
@@ -103,8 +117,15 @@ void BatchedSeparableResample(
 
   dim3 block(block_size.x, block_size.y, block_size.z);
 
-  BatchedSeparableResampleKernel<spatial_ndim, Output, Input>
-  <<<num_blocks, block, shm_size, stream>>>(which_pass, samples, block2sample);
+  // The blocks have similar size (see SeparableResamplingSetup::ComputeBlockLayout), so they're
+  // distributed evenly over a persistent grid of as many CUDA blocks as can run concurrently.
+  auto *kernel = BatchedSeparableResampleKernel<spatial_ndim, Output, Input>;
+  int blocks_per_sm = 0;
+  CUDA_CALL(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+      &blocks_per_sm, kernel, volume(block_size), shm_size));
+  int grid_size = std::min(num_blocks, std::max(blocks_per_sm, 1) * GetSmCount());
+
+  kernel<<<grid_size, block, shm_size, stream>>>(which_pass, samples, block2sample, num_blocks);
   CUDA_CALL(cudaGetLastError());
 }
 
@@ -20,6 +20,7 @@
 #include "dali/core/static_switch.h"
 #include "dali/core/convert.h"
 #include "dali/kernels/common/simd.h"
+#include "dali/kernels/imgproc/resample/resampling_impl_cpu_simd.h"
 #include "dali/kernels/imgproc/surface.h"
 #include "dali/core/geom/vec.h"
 
@@ -140,7 +141,9 @@ struct SIMD_horz_resample_impl {
                  int dynamic_channels) {
     const int channels = static_channels < 0 ? dynamic_channels : static_channels;
 
-    int x = ox0;
+    // the wider SIMD variants, if available, leave less than their vector width to the code below
+    int x = resample_simd::ResampleHorzSpan<static_channels, clamp_left, clamp_right>(
+        out, in, ox0, ox1, w, in_columns, coeffs, support);
 #ifdef __SSE2__
     float tmpin[kNumLanes];
     for (; x + kNumLanes <= ox1; x += kNumLanes) {
@@ -383,8 +386,11 @@ void ResampleVert(
     for (int x0 = 0; x0 < flat_w; x0 += tile) {
       int tile_w = x0 + tile <= flat_w ? tile : flat_w - x0;
       assert(tile_w <= tile);
+      const float *kernel = &row_coeffs[y * support];
+      int x = resample_simd::ResampleVertSpan<Out, std::remove_const_t<In>>(
+          out_row, in_row_ptrs, kernel, support, x0, x0 + tile_w);
       SIMD_vert_resample_impl<Out, In> res;
-      res.run(out_row, in_row_ptrs, &row_coeffs[y * support], support, x0, x0 + tile_w);
+      res.run(out_row, in_row_ptrs, kernel, support, x, x0 + tile_w);
     }
   }
 }
@@ -0,0 +1,83 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/kernels/imgproc/resample/resampling_impl_cpu_simd.h"
+
+#if DALI_CPU_DISPATCH_X86
+
+#include <immintrin.h>
+#include <cstdint>
+#include "dali/core/force_inline.h"
+
+// Only the code below is compiled with AVX2 enabled - the functions defined in the headers
+// included above (which may also be instantiated in other translation units) are not.
+DALI_CPU_TARGET_BEGIN_AVX2
+
+namespace dali {
+namespace kernels {
+namespace resample_simd {
+
+struct AVX2Vec {
+  using vec = __m256;
+  static constexpr int kLanes = 8;
+
+  DALI_FORCEINLINE static vec zero() { return _mm256_setzero_ps(); }
+  DALI_FORCEINLINE static vec set1(float x) { return _mm256_set1_ps(x); }
+  DALI_FORCEINLINE static vec load(const float *in) { return _mm256_loadu_ps(in); }
+  DALI_FORCEINLINE static vec fma(vec acc, vec a, vec b) { return _mm256_fmadd_ps(a, b, acc); }
+
+  DALI_FORCEINLINE static void load4(const float *in, vec *v) {
+    for (int i = 0; i < 4; i++)
+      v[i] = _mm256_loadu_ps(in + i * kLanes);
+  }
+
+  DALI_FORCEINLINE static void load4(const uint8_t *in, vec *v) {
+    for (int i = 0; i < 4; i++) {
+      __m128i u8 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in + i * kLanes));
+      v[i] = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(u8));
+    }
+  }
+
+  DALI_FORCEINLINE static void store4(float *out, const vec *v) {
+    for (int i = 0; i < 4; i++)
+      _mm256_storeu_ps(out + i * kLanes, v[i]);
+  }
+
+  DALI_FORCEINLINE static void store4(uint8_t *out, const vec *v) {
+    __m256i i32[4];
+    for (int i = 0; i < 4; i++) {
+      // clamping first makes the packing below exact; it also turns NaNs into 0
+      vec clamped = _mm256_min_ps(_mm256_max_ps(v[i], zero()), set1(255));
+      i32[i] = _mm256_cvtps_epi32(clamped);  // round
+    }
+    // the packing works within 128-bit lanes - the 32-bit groups are shuffled back in order
+    __m256i i16_01 = _mm256_packs_epi32(i32[0], i32[1]);
+    __m256i i16_23 = _mm256_packs_epi32(i32[2], i32[3]);
+    __m256i u8 = _mm256_packus_epi16(i16_01, i16_23);
+    u8 = _mm256_permutevar8x32_epi32(u8, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), u8);
+  }
+};
+
+}  // namespace resample_simd
+}  // namespace kernels
+}  // namespace dali
+
+#include "dali/kernels/imgproc/resample/resampling_impl_cpu_simd_impl.h"
+
+DALI_CPU_TARGET_END
+
+DALI_RESAMPLE_SIMD_DEFINE(CpuIsa::AVX2, AVX2Vec)
+
+#endif  // DALI_CPU_DISPATCH_X86
@@ -0,0 +1,81 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/kernels/imgproc/resample/resampling_impl_cpu_simd.h"
+
+#if DALI_CPU_DISPATCH_X86
+
+#if defined(__GNUC__) && !defined(__clang__)
+// GCC reports the intentionally undefined vectors in avx512fintrin.h as uninitialized
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+#include <immintrin.h>
+#include <cstdint>
+#include "dali/core/force_inline.h"
+
+// Only the code below is compiled with AVX-512 enabled - see resampling_impl_cpu_avx2.cc
+DALI_CPU_TARGET_BEGIN_AVX512
+
+namespace dali {
+namespace kernels {
+namespace resample_simd {
+
+struct AVX512Vec {
+  using vec = __m512;
+  static constexpr int kLanes = 16;
+
+  DALI_FORCEINLINE static vec zero() { return _mm512_set1_ps(0.0f); }
+  DALI_FORCEINLINE static vec set1(float x) { return _mm512_set1_ps(x); }
+  DALI_FORCEINLINE static vec load(const float *in) { return _mm512_loadu_ps(in); }
+  DALI_FORCEINLINE static vec fma(vec acc, vec a, vec b) { return _mm512_fmadd_ps(a, b, acc); }
+
+  DALI_FORCEINLINE static void load4(const float *in, vec *v) {
+    for (int i = 0; i < 4; i++)
+      v[i] = _mm512_loadu_ps(in + i * kLanes);
+  }
+
+  DALI_FORCEINLINE static void load4(const uint8_t *in, vec *v) {
+    for (int i = 0; i < 4; i++) {
+      __m128i u8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i * kLanes));
+      v[i] = _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(u8));
+    }
+  }
+
+  DALI_FORCEINLINE static void store4(float *out, const vec *v) {
+    for (int i = 0; i < 4; i++)
+      _mm512_storeu_ps(out + i * kLanes, v[i]);
+  }
+
+  DALI_FORCEINLINE static void store4(uint8_t *out, const vec *v) {
+    for (int i = 0; i < 4; i++) {
+      // clamping first turns NaNs into 0; the narrowing saturates anyway
+      vec clamped = _mm512_min_ps(_mm512_max_ps(v[i], zero()), set1(255));
+      __m128i u8 = _mm512_cvtusepi32_epi8(_mm512_cvtps_epi32(clamped));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i * kLanes), u8);
+    }
+  }
+};
+
+}  // namespace resample_simd
+}  // namespace kernels
+}  // namespace dali
+
+#include "dali/kernels/imgproc/resample/resampling_impl_cpu_simd_impl.h"
+
+DALI_CPU_TARGET_END
+
+DALI_RESAMPLE_SIMD_DEFINE(CpuIsa::AVX512, AVX512Vec)
+
+#endif  // DALI_CPU_DISPATCH_X86
@@ -0,0 +1,74 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/kernels/imgproc/resample/resampling_impl_cpu_simd.h"
+
+#if DALI_CPU_DISPATCH_NEON
+
+#include <arm_neon.h>
+#include <cstdint>
+#include "dali/core/force_inline.h"
+
+namespace dali {
+namespace kernels {
+namespace resample_simd {
+
+struct NEONVec {
+  using vec = float32x4_t;
+  static constexpr int kLanes = 4;
+
+  DALI_FORCEINLINE static vec zero() { return vdupq_n_f32(0); }
+  DALI_FORCEINLINE static vec set1(float x) { return vdupq_n_f32(x); }
+  DALI_FORCEINLINE static vec load(const float *in) { return vld1q_f32(in); }
+  DALI_FORCEINLINE static vec fma(vec acc, vec a, vec b) { return vfmaq_f32(acc, a, b); }
+
+  DALI_FORCEINLINE static void load4(const float *in, vec *v) {
+    for (int i = 0; i < 4; i++)
+      v[i] = vld1q_f32(in + i * kLanes);
+  }
+
+  DALI_FORCEINLINE static void load4(const uint8_t *in, vec *v) {
+    uint8x16_t u8 = vld1q_u8(in);
+    uint16x8_t lo = vmovl_u8(vget_low_u8(u8));
+    uint16x8_t hi = vmovl_u8(vget_high_u8(u8));
+    v[0] = vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo)));
+    v[1] = vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo)));
+    v[2] = vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi)));
+    v[3] = vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi)));
+  }
+
+  DALI_FORCEINLINE static void store4(float *out, const vec *v) {
+    for (int i = 0; i < 4; i++)
+      vst1q_f32(out + i * kLanes, v[i]);
+  }
+
+  DALI_FORCEINLINE static void store4(uint8_t *out, const vec *v) {
+    // the conversion rounds to nearest and saturates (NaNs become 0), so does the narrowing
+    uint16x8_t lo = vcombine_u16(vqmovun_s32(vcvtnq_s32_f32(v[0])),
+                                 vqmovun_s32(vcvtnq_s32_f32(v[1])));
+    uint16x8_t hi = vcombine_u16(vqmovun_s32(vcvtnq_s32_f32(v[2])),
+                                 vqmovun_s32(vcvtnq_s32_f32(v[3])));
+    vst1q_u8(out, vcombine_u8(vqmovn_u16(lo), vqmovn_u16(hi)));
+  }
+};
+
+}  // namespace resample_simd
+}  // namespace kernels
+}  // namespace dali
+
+#include "dali/kernels/imgproc/resample/resampling_impl_cpu_simd_impl.h"
+
+DALI_RESAMPLE_SIMD_DEFINE(CpuIsa::NEON, NEONVec)
+
+#endif  // DALI_CPU_DISPATCH_NEON
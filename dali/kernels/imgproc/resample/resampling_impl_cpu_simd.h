@@ -0,0 +1,154 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_RESAMPLE_RESAMPLING_IMPL_CPU_SIMD_H_
+#define DALI_KERNELS_IMGPROC_RESAMPLE_RESAMPLING_IMPL_CPU_SIMD_H_
+
+#include <cstdint>
+#include <type_traits>
+#include "dali/core/api_helper.h"
+#include "dali/kernels/common/cpu_isa.h"
+
+// Wide SIMD variants of the CPU resampling passes, selected at run time (see cpu_isa.h).
+// They only cover the element types used in typical image processing (uint8_t and float);
+// other types use the SSE2 code in resampling_impl_cpu.h.
+
+namespace dali {
+namespace kernels {
+namespace resample_simd {
+
+template <typename T>
+constexpr bool is_supported_type =
+    std::is_same<T, uint8_t>::value || std::is_same<T, float>::value;
+
+template <typename Out, typename In>
+constexpr bool is_supported = is_supported_type<Out> && is_supported_type<In>;
+
+template <int channels>
+constexpr bool is_supported_channels = channels == 1 || channels == 3 || channels == 4;
+
+/**
+ * @brief Calculates the vertical pass in the range [begin, end) of a (flattened) row
+ *
+ * @return The end of the processed part of the range - the remaining elements
+ *         (fewer than a vector width) are left to the caller.
+ */
+template <CpuIsa isa, typename Out, typename In>
+DLL_PUBLIC int ResampleVertSpanImpl(Out *out, const In *const *rows, const float *kernel,
+                                    int support, int begin, int end);
+
+/**
+ * @brief Calculates the horizontal pass for the output columns [ox0, ox1)
+ *
+ * @return The first column which was not processed - the remaining columns
+ *         (fewer than a vector width) are left to the caller.
+ */
+template <CpuIsa isa, int channels, bool clamp_left, bool clamp_right, typename Out, typename In>
+DLL_PUBLIC int ResampleHorzSpanImpl(Out *out, const In *in, int ox0, int ox1, int w,
+                                    const int32_t *in_columns, const float *coeffs, int support);
+
+// X-macros listing the (explicitly specialized) variants of ResampleVertSpanImpl and
+// ResampleHorzSpanImpl; `X` is invoked with `(isa, arg, [channels, clamp_left, clamp_right,]
+// Out, In)`
+
+#define DALI_RESAMPLE_SIMD_VERT_TYPES(X, isa, arg)                                               \
+  X(isa, arg, float, uint8_t)                                                                    \
+  X(isa, arg, float, float)                                                                      \
+  X(isa, arg, uint8_t, float)                                                                    \
+  X(isa, arg, uint8_t, uint8_t)
+
+#define DALI_RESAMPLE_SIMD_HORZ_TYPES(X, isa, arg)                                               \
+  DALI_RESAMPLE_SIMD_HORZ_CHANNELS(X, isa, arg, 1)                                               \
+  DALI_RESAMPLE_SIMD_HORZ_CHANNELS(X, isa, arg, 3)                                               \
+  DALI_RESAMPLE_SIMD_HORZ_CHANNELS(X, isa, arg, 4)
+
+#define DALI_RESAMPLE_SIMD_HORZ_CHANNELS(X, isa, arg, channels)                                  \
+  DALI_RESAMPLE_SIMD_HORZ_CLAMP(X, isa, arg, channels, float, uint8_t)                           \
+  DALI_RESAMPLE_SIMD_HORZ_CLAMP(X, isa, arg, channels, float, float)                             \
+  DALI_RESAMPLE_SIMD_HORZ_CLAMP(X, isa, arg, channels, uint8_t, float)                           \
+  DALI_RESAMPLE_SIMD_HORZ_CLAMP(X, isa, arg, channels, uint8_t, uint8_t)
+
+#define DALI_RESAMPLE_SIMD_HORZ_CLAMP(X, isa, arg, channels, Out, In)                            \
+  X(isa, arg, channels, false, false, Out, In)                                                   \
+  X(isa, arg, channels, false, true, Out, In)                                                    \
+  X(isa, arg, channels, true, false, Out, In)                                                    \
+  X(isa, arg, channels, true, true, Out, In)
+
+#define DALI_RESAMPLE_SIMD_DECLARE_VERT(isa, unused, Out, In)                                    \
+  template <>                                                                                    \
+  DLL_PUBLIC int ResampleVertSpanImpl<isa>(Out *, const In *const *, const float *, int, int,    \
+                                           int);
+
+#define DALI_RESAMPLE_SIMD_DECLARE_HORZ(isa, unused, channels, left, right, Out, In)             \
+  template <>                                                                                    \
+  DLL_PUBLIC int ResampleHorzSpanImpl<isa, channels, left, right>(Out *, const In *, int, int,   \
+                                                                  int, const int32_t *,          \
+                                                                  const float *, int);
+
+#define DALI_RESAMPLE_SIMD_DECLARE(isa)                                                          \
+  DALI_RESAMPLE_SIMD_VERT_TYPES(DALI_RESAMPLE_SIMD_DECLARE_VERT, isa, _)                         \
+  DALI_RESAMPLE_SIMD_HORZ_TYPES(DALI_RESAMPLE_SIMD_DECLARE_HORZ, isa, _)
+
+#if DALI_CPU_DISPATCH_X86
+DALI_RESAMPLE_SIMD_DECLARE(CpuIsa::AVX2)
+DALI_RESAMPLE_SIMD_DECLARE(CpuIsa::AVX512)
+#endif
+#if DALI_CPU_DISPATCH_NEON
+DALI_RESAMPLE_SIMD_DECLARE(CpuIsa::NEON)
+#endif
+
+/**
+ * @brief Runs the best available variant of `ResampleVertSpanImpl`
+ *
+ * If there's none, nothing is processed and `begin` is returned.
+ */
+template <typename Out, typename In>
+inline int ResampleVertSpan(Out *out, const In *const *rows, const float *kernel, int support,
+                            int begin, int end) {
+  if constexpr (is_supported<Out, In>) {
+    return DispatchCpuIsa([&](auto isa) {
+      if constexpr (isa() == CpuIsa::Baseline)
+        return begin;
+      else
+        return ResampleVertSpanImpl<isa()>(out, rows, kernel, support, begin, end);
+    });
+  }
+  return begin;
+}
+
+/**
+ * @brief Runs the best available variant of `ResampleHorzSpanImpl`
+ *
+ * If there's none, nothing is processed and `ox0` is returned.
+ */
+template <int channels, bool clamp_left, bool clamp_right, typename Out, typename In>
+inline int ResampleHorzSpan(Out *out, const In *in, int ox0, int ox1, int w,
+                            const int32_t *in_columns, const float *coeffs, int support) {
+  if constexpr (is_supported<Out, In> && is_supported_channels<channels>) {
+    return DispatchCpuIsa([&](auto isa) {
+      if constexpr (isa() == CpuIsa::Baseline)
+        return ox0;
+      else
+        return ResampleHorzSpanImpl<isa(), channels, clamp_left, clamp_right>(
+            out, in, ox0, ox1, w, in_columns, coeffs, support);
+    });
+  }
+  return ox0;
+}
+
+}  // namespace resample_simd
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_RESAMPLE_RESAMPLING_IMPL_CPU_SIMD_H_
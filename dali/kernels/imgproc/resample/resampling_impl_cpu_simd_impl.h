@@ -0,0 +1,133 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_RESAMPLE_RESAMPLING_IMPL_CPU_SIMD_IMPL_H_
+#define DALI_KERNELS_IMGPROC_RESAMPLE_RESAMPLING_IMPL_CPU_SIMD_IMPL_H_
+
+// The code below is generic over the vector type `V` and it's compiled once per instruction set.
+// It must only be included in the translation units which enable that instruction set for the
+// code that follows (see resampling_impl_cpu_avx2.cc) - that is, after all the other includes.
+//
+// `V` provides:
+//   vec                           - the vector of floats
+//   kLanes                        - the number of floats in `vec`
+//   zero(), set1(x), load(float*) - obvious
+//   fma(acc, a, b)                - acc + a * b
+//   load4(const In *in, vec *v)   - loads 4 * kLanes values of type In and converts them to float
+//   store4(Out *out, const vec *v)- stores 4 vectors, with rounding and saturation, if needed
+
+namespace dali {
+namespace kernels {
+namespace resample_simd {
+
+template <typename V, typename Out, typename In>
+inline int VertSpan(Out *out, const In *const *rows, const float *kernel, int support,
+                    int begin, int end) {
+  using vec = typename V::vec;
+  constexpr int kNumLanes = 4 * V::kLanes;
+  int i = begin;
+  for (; i + kNumLanes <= end; i += kNumLanes) {
+    vec acc[4] = { V::zero(), V::zero(), V::zero(), V::zero() };
+    for (int k = 0; k < support; k++) {
+      vec in[4];
+      V::load4(rows[k] + i, in);
+      vec coeff = V::set1(kernel[k]);
+      for (int v = 0; v < 4; v++)
+        acc[v] = V::fma(acc[v], coeff, in[v]);
+    }
+    V::store4(out + i, acc);
+  }
+  return i;
+}
+
+template <typename V, int channels, bool clamp_left, bool clamp_right, typename Out, typename In>
+inline int HorzSpan(Out *out, const In *in, int ox0, int ox1, int w,
+                    const int32_t *in_columns, const float *coeffs, int support) {
+  using vec = typename V::vec;
+  constexpr int kNumLanes = 4 * V::kLanes;
+  int x = ox0;
+  for (; x + kNumLanes <= ox1; x += kNumLanes) {
+    vec acc[channels][4];  // NOLINT
+    for (int c = 0; c < channels; c++)
+      for (int v = 0; v < 4; v++)
+        acc[c][v] = V::zero();
+
+    for (int k = 0; k < support; k++) {
+      alignas(64) float tmp_coeffs[kNumLanes];
+      alignas(64) float tmp_in[channels][kNumLanes];  // NOLINT
+      for (int l = 0; l < kNumLanes; l++) {
+        tmp_coeffs[l] = coeffs[(x + l) * support + k];  // interleave per-column coefficients
+        int srcx = in_columns[x + l] + k;
+        if (clamp_left) if (srcx < 0) srcx = 0;
+        if (clamp_right) if (srcx > w-1) srcx = w-1;
+        for (int c = 0; c < channels; c++)
+          tmp_in[c][l] = in[srcx * channels + c];
+      }
+      for (int v = 0; v < 4; v++) {
+        vec vcoeffs = V::load(tmp_coeffs + v * V::kLanes);
+        for (int c = 0; c < channels; c++)
+          acc[c][v] = V::fma(acc[c][v], vcoeffs, V::load(tmp_in[c] + v * V::kLanes));
+      }
+    }
+
+    if constexpr (channels == 1) {
+      V::store4(out + x, acc[0]);
+    } else {
+      alignas(64) Out tmp_out[channels][kNumLanes];  // NOLINT
+      for (int c = 0; c < channels; c++)
+        V::store4(tmp_out[c], acc[c]);
+      for (int l = 0; l < kNumLanes; l++)
+        for (int c = 0; c < channels; c++)
+          out[channels * (x + l) + c] = tmp_out[c][l];  // interleave channels
+    }
+  }
+  return x;
+}
+
+}  // namespace resample_simd
+}  // namespace kernels
+}  // namespace dali
+
+/**
+ * Defines the specializations of ResampleVertSpanImpl and ResampleHorzSpanImpl for instruction
+ * set `isa`, which call VertSpan and HorzSpan with the vector type `V`.
+ *
+ * This must be used after the instruction set is disabled again - the specializations are called
+ * from the generic code and they're compiled for the baseline instruction set.
+ */
+#define DALI_RESAMPLE_SIMD_DEFINE(isa, V)                                                        \
+namespace dali {                                                                                 \
+namespace kernels {                                                                              \
+namespace resample_simd {                                                                        \
+DALI_RESAMPLE_SIMD_VERT_TYPES(DALI_RESAMPLE_SIMD_DEFINE_VERT, isa, V)                            \
+DALI_RESAMPLE_SIMD_HORZ_TYPES(DALI_RESAMPLE_SIMD_DEFINE_HORZ, isa, V)                            \
+}  /* namespace resample_simd */                                                                 \
+}  /* namespace kernels */                                                                       \
+}  /* namespace dali */
+
+#define DALI_RESAMPLE_SIMD_DEFINE_VERT(isa, V, Out, In)                                          \
+template <>                                                                                      \
+int ResampleVertSpanImpl<isa>(Out *out, const In *const *rows, const float *kernel,              \
+                              int support, int begin, int end) {                                 \
+  return VertSpan<V>(out, rows, kernel, support, begin, end);                                    \
+}
+
+#define DALI_RESAMPLE_SIMD_DEFINE_HORZ(isa, V, channels, left, right, Out, In)                   \
+template <>                                                                                      \
+int ResampleHorzSpanImpl<isa, channels, left, right>(Out *out, const In *in, int ox0, int ox1,   \
+    int w, const int32_t *in_columns, const float *coeffs, int support) {                        \
+  return HorzSpan<V, channels, left, right>(out, in, ox0, ox1, w, in_columns, coeffs, support);  \
+}
+
+#endif  // DALI_KERNELS_IMGPROC_RESAMPLE_RESAMPLING_IMPL_CPU_SIMD_IMPL_H_
@@ -0,0 +1,317 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <tuple>
+#include "dali/core/convert.h"
+#include "dali/core/cuda_error.h"
+#include "dali/core/error_handling.h"
+#include "dali/core/bfloat16.h"
+#include "dali/core/float16.h"
+#include "dali/core/geom/vec.h"
+#include "dali/core/math_util.h"
+#include "dali/core/static_switch.h"
+#include "dali/kernels/imgproc/resample/resampling_setup.h"
+#include "dali/kernels/imgproc/resample/resize_crop_mirror_normalize_gpu.h"
+
+namespace dali {
+namespace kernels {
+
+namespace resize_crop_mirror_normalize {
+
+template <typename Out>
+struct SampleDesc {
+  Out *__restrict__ out;
+  const uint8_t *__restrict__ in;
+  const float *__restrict__ norm_add;
+  const float *__restrict__ norm_mul;
+  const Out *__restrict__ fill_values;
+
+  ivec2 in_size, out_size;  // (x, y)
+  int out_channels;
+  bool planar;
+
+  vec2 origin, scale;
+  ResamplingFilter filter[2];  // NOLINT
+  int support[2];              // NOLINT - 0 means nearest neighbor
+};
+
+/**
+ * @brief The source pixels contributing to an output pixel, in one axis
+ */
+struct AxisTaps {
+  int start;       // the first source pixel (not clamped)
+  int count;       // the number of taps
+  float f0, step;  // the filter argument for the first tap and its step
+};
+
+__device__ __forceinline__ AxisTaps GetTaps(int dst, float origin, float scale,
+                                            const ResamplingFilter &filter, int support) {
+  AxisTaps taps;
+  if (support == 0) {
+    taps.start = floor_int(dst * scale + origin + 0.5f * scale);
+    taps.count = 1;
+    taps.f0 = taps.step = 0;
+  } else {
+    // the same as in ResampleHorz_Channels
+    float sf = dst * scale + origin + 0.5f * scale - 0.5f - filter.anchor;
+    taps.start = __float2int_ru(sf);
+    taps.count = support;
+    taps.f0 = (taps.start - sf) * filter.scale;
+    taps.step = filter.scale;
+  }
+  return taps;
+}
+
+__device__ __forceinline__ float TapWeight(const ResamplingFilter &filter,
+                                           const AxisTaps &taps, int k) {
+  return taps.step == 0 ? 1.0f : filter(taps.f0 + k * taps.step);
+}
+
+template <int channels, typename Out>
+__global__ void ResizeCropMirrorNormalizeKernel(const SampleDesc<Out> *samples,
+                                                const BlockDesc<2> *blocks) {
+  const auto block = blocks[blockIdx.x];
+  const auto &sample = samples[block.sample_idx];
+  const int in_w = sample.in_size.x;
+  const int in_h = sample.in_size.y;
+  const ptrdiff_t in_stride = static_cast<ptrdiff_t>(in_w) * channels;
+  const ptrdiff_t plane_size = static_cast<ptrdiff_t>(sample.out_size.x) * sample.out_size.y;
+
+  for (int y = block.start.y + threadIdx.y; y < block.end.y; y += blockDim.y) {
+    AxisTaps ty = GetTaps(y, sample.origin.y, sample.scale.y, sample.filter[1], sample.support[1]);
+    for (int x = block.start.x + threadIdx.x; x < block.end.x; x += blockDim.x) {
+      AxisTaps tx = GetTaps(x, sample.origin.x, sample.scale.x, sample.filter[0],
+                            sample.support[0]);
+      float norm_x = 0;
+      for (int kx = 0; kx < tx.count; kx++)
+        norm_x += TapWeight(sample.filter[0], tx, kx);
+
+      float acc[channels];  // NOLINT - not a variable length array
+      for (int c = 0; c < channels; c++)
+        acc[c] = 0;
+      float norm_y = 0;
+      for (int ky = 0; ky < ty.count; ky++) {
+        float wy = TapWeight(sample.filter[1], ty, ky);
+        norm_y += wy;
+        if (wy == 0)
+          continue;
+        int sy = clamp(ty.start + ky, 0, in_h - 1);
+        const uint8_t *in_row = sample.in + sy * in_stride;
+        float row_acc[channels];  // NOLINT - not a variable length array
+        for (int c = 0; c < channels; c++)
+          row_acc[c] = 0;
+        for (int kx = 0; kx < tx.count; kx++) {
+          float wx = TapWeight(sample.filter[0], tx, kx);
+          int sx = clamp(tx.start + kx, 0, in_w - 1);
+          for (int c = 0; c < channels; c++)
+            row_acc[c] = fmaf(__ldg(in_row + sx * channels + c), wx, row_acc[c]);
+        }
+        for (int c = 0; c < channels; c++)
+          acc[c] = fmaf(row_acc[c], wy, acc[c]);
+      }
+      float norm = 1.0f / (norm_x * norm_y);
+
+      ptrdiff_t offset = static_cast<ptrdiff_t>(y) * sample.out_size.x + x;
+      ptrdiff_t c_stride = sample.planar ? plane_size : 1;
+      Out *out = sample.planar ? sample.out + offset : sample.out + offset * sample.out_channels;
+      for (int c = 0; c < channels; c++)
+        out[c * c_stride] = ConvertSat<Out>(fmaf(acc[c] * norm, sample.norm_mul[c],
+                                                 sample.norm_add[c]));
+      for (int c = channels; c < sample.out_channels; c++)
+        out[c * c_stride] = sample.fill_values[c];
+    }
+  }
+}
+
+}  // namespace resize_crop_mirror_normalize
+
+template <typename Out>
+KernelRequirements ResizeCropMirrorNormalizeGPU<Out>::Setup(KernelContext &ctx,
+                                                            const TensorListShape<ndim> &in_shape,
+                                                            span<const SampleArgs> args,
+                                                            TensorLayout output_layout) {
+  (void)ctx;
+  int num_samples = in_shape.num_samples();
+  DALI_ENFORCE(num_samples == static_cast<int>(args.size()),
+               "Invalid number of samples in kernel args");
+  DALI_ENFORCE(output_layout == "HWC" || output_layout == "CHW",
+               "Only CHW and HWC output layouts allowed");
+  planar_ = output_layout == "CHW";
+  SetupNumChannels(in_shape, args);
+
+  out_shape_.resize(num_samples, ndim);
+  for (int i = 0; i < num_samples; i++) {
+    int out_h = args[i].params[0].output_size;
+    int out_w = args[i].params[1].output_size;
+    DALI_ENFORCE(out_h >= 0 && out_w >= 0,
+                 make_string("The output size must be specified explicitly; got ", out_h, "x",
+                             out_w, " in sample ", i, "."));
+    if (planar_)
+      out_shape_.set_tensor_shape(i, TensorShape<ndim>(out_nchannels_, out_h, out_w));
+    else
+      out_shape_.set_tensor_shape(i, TensorShape<ndim>(out_h, out_w, out_nchannels_));
+  }
+  KernelRequirements req;
+  req.output_shapes = { out_shape_ };
+  return req;
+}
+
+template <typename Out>
+void ResizeCropMirrorNormalizeGPU<Out>::SetupNumChannels(const TensorListShape<ndim> &in_shape,
+                                                         span<const SampleArgs> args) {
+  if (in_shape.num_samples() == 0)
+    return;
+  nchannels_ = in_shape.tensor_shape_span(0)[2];
+  for (int i = 1; i < in_shape.num_samples(); i++) {
+    int ch = in_shape.tensor_shape_span(i)[2];
+    DALI_ENFORCE(nchannels_ == ch,
+                 make_string("All samples should have the same number of channels, expected ",
+                             nchannels_, " channels, got ", ch, " channels in sample ", i));
+  }
+  DALI_ENFORCE(nchannels_ >= 1 && nchannels_ <= kMaxChannels,
+               make_string("Only images with up to ", kMaxChannels, " channels are supported; "
+                           "got ", nchannels_, " channels."));
+  out_nchannels_ = std::max(nchannels_, static_cast<int>(args[0].fill_values.size()));
+  for (int i = 1; i < in_shape.num_samples(); i++) {
+    DALI_ENFORCE(args[i].fill_values.size() == args[0].fill_values.size(),
+                 "All sample arguments should have the same number of fill values.");
+  }
+}
+
+template <typename Out>
+std::tuple<float *, float *, Out *> ResizeCropMirrorNormalizeGPU<Out>::SetupParams(
+    KernelContext &ctx, span<const SampleArgs> args) {
+  int num_samples = args.size();
+  float *norm_add_cpu = ctx.scratchpad->AllocatePinned<float>(num_samples * nchannels_);
+  float *norm_mul_cpu = ctx.scratchpad->AllocatePinned<float>(num_samples * nchannels_);
+  Out *fill_values_cpu = ctx.scratchpad->AllocatePinned<Out>(num_samples * out_nchannels_);
+  for (int i = 0; i < num_samples; i++) {
+    const auto &sample_arg = args[i];
+    auto *norm_add_data = norm_add_cpu + i * nchannels_;
+    auto *norm_mul_data = norm_mul_cpu + i * nchannels_;
+    int mean_sz = sample_arg.mean.size();
+    assert(mean_sz == static_cast<int>(sample_arg.inv_stddev.size()));
+    int c = 0;
+    for (; c < mean_sz && c < nchannels_; c++) {
+      norm_add_data[c] = -sample_arg.mean[c] * sample_arg.inv_stddev[c];
+      norm_mul_data[c] = sample_arg.inv_stddev[c];
+    }
+    for (; c < nchannels_; c++) {
+      norm_add_data[c] = 0.0f;
+      norm_mul_data[c] = 1.0f;
+    }
+    auto *fill_values_data = fill_values_cpu + i * out_nchannels_;
+    int fill_values_sz = sample_arg.fill_values.size();
+    for (c = 0; c < fill_values_sz; c++)
+      fill_values_data[c] = ConvertSat<Out>(sample_arg.fill_values[c]);
+    for (; c < out_nchannels_; c++)
+      fill_values_data[c] = ConvertSat<Out>(0.0f);
+  }
+
+  return ctx.scratchpad->ToContiguousGPU(ctx.gpu.stream,
+                                         make_span(norm_add_cpu, num_samples * nchannels_),
+                                         make_span(norm_mul_cpu, num_samples * nchannels_),
+                                         make_span(fill_values_cpu, num_samples * out_nchannels_));
+}
+
+template <typename Out>
+void ResizeCropMirrorNormalizeGPU<Out>::Run(KernelContext &ctx, const OutListGPU<Out, ndim> &out,
+                                            const InListGPU<In, ndim> &in,
+                                            span<const SampleArgs> args) {
+  using SampleDesc = resize_crop_mirror_normalize::SampleDesc<Out>;
+  int num_samples = in.num_samples();
+  if (num_samples == 0)
+    return;
+  if (!filters_)
+    filters_ = GetResamplingFilters();
+
+  auto *samples_cpu = ctx.scratchpad->AllocatePinned<SampleDesc>(num_samples);
+  auto [norm_add_gpu, norm_mul_gpu, fill_values_gpu] = SetupParams(ctx, args);
+
+  // the blocks cover the output pixels - the shape is HWC, regardless of the output layout
+  TensorListShape<ndim> block_shape(num_samples, ndim);
+  for (int i = 0; i < num_samples; i++) {
+    auto &sample = samples_cpu[i];
+    const auto &params = args[i].params;
+    auto in_sample_shape = in.tensor_shape_span(i);
+    sample.in = in.tensor_data(i);
+    sample.out = out.tensor_data(i);
+    sample.in_size = { static_cast<int>(in_sample_shape[1]),
+                       static_cast<int>(in_sample_shape[0]) };
+    sample.out_size = { params[1].output_size, params[0].output_size };
+    sample.out_channels = out_nchannels_;
+    sample.planar = planar_;
+    sample.norm_add = norm_add_gpu + i * nchannels_;
+    sample.norm_mul = norm_mul_gpu + i * nchannels_;
+    sample.fill_values = fill_values_gpu + i * out_nchannels_;
+    block_shape.set_tensor_shape(i, TensorShape<ndim>(sample.out_size.y, sample.out_size.x, 1));
+
+    for (int axis = 0; axis < spatial_ndim; axis++) {
+      const auto &p = params[spatial_ndim - 1 - axis];
+      float roi_start = 0, roi_end = sample.in_size[axis];
+      if (p.roi.use_roi) {
+        roi_start = p.roi.start;
+        roi_end = p.roi.end;
+      }
+      int out_size = sample.out_size[axis];
+      sample.origin[axis] = roi_start;
+      sample.scale[axis] = out_size > 0 ? (roi_end - roi_start) / out_size : 0;
+
+      // filter selection - the same as in SeparableResamplingSetup::SetFilters
+      float in_size = std::abs(roi_end - roi_start);
+      auto fdesc = out_size < in_size ? p.min_filter : p.mag_filter;
+      if (fdesc.antialias && fdesc.type == ResamplingFilterType::Linear)
+        fdesc.type = ResamplingFilterType::Triangular;
+      else if (!fdesc.antialias && fdesc.type == ResamplingFilterType::Triangular)
+        fdesc.type = ResamplingFilterType::Linear;
+      if (fdesc.radius == 0)
+        fdesc.radius = DefaultFilterRadius(fdesc.type, fdesc.antialias, in_size, out_size);
+
+      auto &filter = sample.filter[axis];
+      filter = resampling::GetResamplingFilter(filters_.get(), fdesc);
+      if (fdesc.type == ResamplingFilterType::Nearest || filter.num_coeffs == 0) {
+        sample.support[axis] = 0;
+      } else {
+        if (filter.support() > kMaxSupport)
+          filter.rescale(kMaxSupport);
+        sample.support[axis] = filter.support();
+      }
+    }
+  }
+
+  block_setup_.SetDefaultBlockSize({32, 32});
+  block_setup_.SetBlockDim(dim3(32, 8, 1));
+  block_setup_.SetupBlocks(block_shape, true);
+  if (block_setup_.Blocks().empty())
+    return;
+  SampleDesc *samples_gpu = nullptr;
+  const BlockDesc<spatial_ndim> *blocks_gpu = nullptr;
+  std::tie(samples_gpu, blocks_gpu) = ctx.scratchpad->ToContiguousGPU(
+      ctx.gpu.stream, make_span(samples_cpu, num_samples), block_setup_.Blocks());
+
+  VALUE_SWITCH(nchannels_, static_channels, (1, 2, 3, 4), (
+    resize_crop_mirror_normalize::ResizeCropMirrorNormalizeKernel<static_channels>
+      <<<block_setup_.GridDim(), block_setup_.BlockDim(), 0, ctx.gpu.stream>>>(
+        samples_gpu, blocks_gpu);
+  ), DALI_FAIL(make_string("Unsupported number of channels: ", nchannels_)););  // NOLINT
+  CUDA_CALL(cudaGetLastError());
+}
+
+template class DLL_PUBLIC ResizeCropMirrorNormalizeGPU<float>;
+template class DLL_PUBLIC ResizeCropMirrorNormalizeGPU<float16>;
+template class DLL_PUBLIC ResizeCropMirrorNormalizeGPU<bfloat16>;
+
+}  // namespace kernels
+}  // namespace dali
@@ -0,0 +1,96 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_RESAMPLE_RESIZE_CROP_MIRROR_NORMALIZE_GPU_H_
+#define DALI_KERNELS_IMGPROC_RESAMPLE_RESIZE_CROP_MIRROR_NORMALIZE_GPU_H_
+
+#include <memory>
+#include <tuple>
+#include "dali/core/common.h"
+#include "dali/core/small_vector.h"
+#include "dali/core/tensor_layout.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/kernels/common/block_setup.h"
+#include "dali/kernels/imgproc/resample/params.h"
+#include "dali/kernels/imgproc/resample/resampling_filters.cuh"
+#include "dali/kernels/kernel.h"
+
+namespace dali {
+namespace kernels {
+
+/**
+ * @brief Resamples a HWC u8 image and writes a normalized HWC or CHW image in a single pass.
+ *
+ * The crop and the mirror are expressed by the resampling ROI (see ResamplingParams::ROI) - the
+ * ROI is the (back-projected) source region which maps to the output and it's flipped if
+ * start > end.
+ *
+ * Each thread computes one output pixel: the separable filter weights are evaluated for both axes
+ * and the whole 2D footprint of the filter is accumulated, with the source coordinates clamped to
+ * the image (as in the separable resampling). No intermediate image is stored, which pays off
+ * when the footprint is small - upscaling or moderate downscaling. With strong antialiased
+ * downscaling, the separable resampling followed by a normalization does fewer operations.
+ *
+ * The output is `(resampled - mean) * inv_stddev`; if there are more fill values than input
+ * channels, the output channels are padded with the fill values.
+ *
+ * @tparam Out output type - float, float16 or bfloat16
+ */
+template <typename Out>
+class DLL_PUBLIC ResizeCropMirrorNormalizeGPU {
+ public:
+  static constexpr int spatial_ndim = 2;
+  static constexpr int ndim = 3;
+  static constexpr int kMaxChannels = 4;
+  /// The maximum support of the filter, in source pixels, in each axis
+  static constexpr int kMaxSupport = 256;
+  using In = uint8_t;
+
+  struct SampleArgs {
+    ResamplingParams2D params;          // output size, source ROI and filters - in (y, x) order
+    SmallVector<float, 4> mean;         // mean (as many values as num. of channels)
+    SmallVector<float, 4> inv_stddev;   // reciprocal of stddev (as many as num. of channels)
+    SmallVector<float, 4> fill_values;  // values of the padded channels - the output has
+                                        // max(channels, fill_values.size()) channels
+  };
+
+  DLL_PUBLIC KernelRequirements Setup(KernelContext &ctx, const TensorListShape<ndim> &in_shape,
+                                      span<const SampleArgs> args, TensorLayout output_layout);
+
+  DLL_PUBLIC void Run(KernelContext &ctx, const OutListGPU<Out, ndim> &out,
+                      const InListGPU<In, ndim> &in, span<const SampleArgs> args);
+
+ private:
+  /**
+   * @brief Transfers the mean, inv_stddev and fill values to the GPU
+   *
+   * @return Pointers to (norm_add, norm_mul, fill_values) - the first two have nchannels_ values
+   *         per sample, the last one - out_nchannels_.
+   */
+  std::tuple<float *, float *, Out *> SetupParams(KernelContext &ctx, span<const SampleArgs> args);
+
+  void SetupNumChannels(const TensorListShape<ndim> &in_shape, span<const SampleArgs> args);
+
+  std::shared_ptr<ResamplingFilters> filters_;
+  BlockSetup<spatial_ndim, spatial_ndim> block_setup_;
+  TensorListShape<ndim> out_shape_;
+  int nchannels_ = -1;
+  int out_nchannels_ = -1;
+  bool planar_ = true;
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_RESAMPLE_RESIZE_CROP_MIRROR_NORMALIZE_GPU_H_
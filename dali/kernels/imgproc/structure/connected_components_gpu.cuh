@@ -0,0 +1,468 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_STRUCTURE_CONNECTED_COMPONENTS_GPU_CUH_
+#define DALI_KERNELS_IMGPROC_STRUCTURE_CONNECTED_COMPONENTS_GPU_CUH_
+
+#include <cuda_runtime.h>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/fast_div.h"
+#include "dali/core/tensor_view.h"
+#include "dali/core/util.h"
+#include "dali/kernels/kernel.h"
+
+namespace dali {
+namespace kernels {
+namespace connected_components {
+namespace gpu_detail {
+
+constexpr int kMaxDims = 6;
+
+/**
+ * @brief Describes a sample for the connected component labeling kernels
+ *
+ * The labels are offsets of the elements with respect to the start of the sample, which allows
+ * the output tensor to be used directly as a disjoint set structure (like in the CPU variant).
+ * The background is marked with -1 until the final relabeling.
+ */
+template <typename OutLabel, typename InLabel>
+struct SampleDesc {
+  OutLabel *labels;
+  const InLabel *in;
+  int64_t volume;
+  int ndim;
+  int64_t stride[kMaxDims];
+  /// stride[d] * shape[d] - the distance between consecutive "rows" in dimension d
+  fast_div<uint64_t> outer[kMaxDims];
+  /// number of tiles in this sample
+  int num_tiles;
+  /// per-tile counters of root elements; after scanning - the index of the first root in the tile
+  int64_t *tile_counts;
+  /// (optional) number of non-background components
+  int64_t *num_labels;
+};
+
+template <typename OutLabel, typename InLabel>
+DALI_DEVICE DALI_FORCEINLINE bool HasPrev(const SampleDesc<OutLabel, InLabel> &sample,
+                                          int64_t idx, int d) {
+  uint64_t i = idx;
+  uint64_t pos_in_row = d == 0 ? i : i - (i / sample.outer[d]) * uint64_t(sample.outer[d]);
+  return pos_in_row >= static_cast<uint64_t>(sample.stride[d]);
+}
+
+DALI_DEVICE DALI_FORCEINLINE int32_t AtomicMinLabel(int32_t *addr, int32_t value) {
+  return atomicMin(addr, value);
+}
+
+DALI_DEVICE DALI_FORCEINLINE int64_t AtomicMinLabel(int64_t *addr, int64_t value) {
+  return atomicMin(reinterpret_cast<long long *>(addr), static_cast<long long>(value));  // NOLINT
+}
+
+/**
+ * @brief Finds the root of the element `x`
+ *
+ * The parent of an element always has a lower index, so the root is the element with the lowest
+ * index in the set.
+ *
+ * @tparam compress If true, the path is halved along the way. This replaces the parents with
+ *                  ancestors, so it's safe to run concurrently with other Find and Union
+ *                  operations - but not with writes of final values to the labels.
+ */
+template <bool compress = true, typename OutLabel>
+DALI_DEVICE OutLabel Find(OutLabel *labels, OutLabel x) {
+  volatile OutLabel *l = labels;
+  OutLabel parent = l[x];
+  while (parent != x) {
+    OutLabel grandparent = l[parent];
+    if (compress && grandparent != parent)
+      l[x] = grandparent;
+    x = parent;
+    parent = grandparent;
+  }
+  return x;
+}
+
+/**
+ * @brief Merges the sets containing the elements `a` and `b`
+ *
+ * The root with the higher index is attached to the one with the lower index with an atomic
+ * operation. If the root has been concurrently attached elsewhere, the operation is repeated
+ * with its new parent.
+ */
+template <typename OutLabel>
+DALI_DEVICE void Union(OutLabel *labels, OutLabel a, OutLabel b) {
+  for (;;) {
+    a = Find(labels, a);
+    b = Find(labels, b);
+    if (a == b)
+      return;
+    if (b < a) {
+      OutLabel tmp = a;
+      a = b;
+      b = tmp;
+    }
+    OutLabel old = AtomicMinLabel(&labels[b], a);
+    if (old == b)
+      return;
+    b = old;
+  }
+}
+
+template <int kBlockSize, int kItemsPerThread, typename Sample>
+DALI_DEVICE DALI_FORCEINLINE int64_t TileStart(const Sample &sample) {
+  return static_cast<int64_t>(blockIdx.x) * kBlockSize * kItemsPerThread;
+}
+
+/**
+ * @brief Sets the parent of each foreground element to the start of its run of equal values
+ *        within the warp; the background is marked with -1.
+ *
+ * The runs which continue from the preceding warp are connected in MergeKernel.
+ */
+template <int kBlockSize, int kItemsPerThread, typename OutLabel, typename InLabel>
+__global__ void InitLabelsKernel(const SampleDesc<OutLabel, InLabel> *samples,
+                                 InLabel background) {
+  const auto &sample = samples[blockIdx.y];
+  if (static_cast<int>(blockIdx.x) >= sample.num_tiles)
+    return;
+  int64_t start = TileStart<kBlockSize, kItemsPerThread>(sample);
+  int inner = sample.ndim - 1;
+  int lane = threadIdx.x % 32;
+  unsigned lanes_up_to_this = lane == 31 ? 0xffffffffu : (2u << lane) - 1;
+  #pragma unroll
+  for (int k = 0; k < kItemsPerThread; k++) {
+    int64_t i = start + k * kBlockSize + threadIdx.x;
+    bool valid = i < sample.volume;
+    InLabel v = valid ? sample.in[i] : background;
+    bool same_as_left = valid && HasPrev(sample, i, inner) && sample.in[i - 1] == v;
+    unsigned run_starts = __ballot_sync(0xffffffffu, valid && (!same_as_left || lane == 0));
+    int start_lane = 31 - __clz(run_starts & lanes_up_to_this);
+    if (valid)
+      sample.labels[i] = v != background ? i - (lane - start_lane) : -1;
+  }
+}
+
+/**
+ * @brief Merges the sets of the neighboring elements with the same value
+ *
+ * In the innermost dimension, only the runs crossing the warp boundaries need to be merged.
+ * In the outer dimensions, the neighbors are merged only when it's not implied by merging
+ * the predecessors in the innermost dimension.
+ */
+template <int kBlockSize, int kItemsPerThread, typename OutLabel, typename InLabel>
+__global__ void MergeKernel(const SampleDesc<OutLabel, InLabel> *samples,
+                            InLabel background) {
+  const auto &sample = samples[blockIdx.y];
+  if (static_cast<int>(blockIdx.x) >= sample.num_tiles)
+    return;
+  int64_t start = TileStart<kBlockSize, kItemsPerThread>(sample);
+  int inner = sample.ndim - 1;
+  int lane = threadIdx.x % 32;
+  for (int k = 0; k < kItemsPerThread; k++) {
+    int64_t i = start + k * kBlockSize + threadIdx.x;
+    if (i >= sample.volume)
+      break;
+    InLabel v = sample.in[i];
+    if (v == background)
+      continue;
+    bool same_as_left = HasPrev(sample, i, inner) && sample.in[i - 1] == v;
+    if (same_as_left && lane == 0)
+      Union<OutLabel>(sample.labels, i, i - 1);
+    for (int d = 0; d < inner; d++) {
+      if (!HasPrev(sample, i, d))
+        continue;
+      int64_t j = i - sample.stride[d];
+      if (sample.in[j] != v)
+        continue;
+      if (same_as_left && sample.in[j - 1] == v)
+        continue;  // already connected through the left neighbor
+      Union<OutLabel>(sample.labels, i, j);
+    }
+  }
+}
+
+/**
+ * @brief Points every foreground element directly to its root and counts the roots in each tile
+ */
+template <int kBlockSize, int kItemsPerThread, typename OutLabel, typename InLabel>
+__global__ void FlattenKernel(const SampleDesc<OutLabel, InLabel> *samples) {
+  const auto &sample = samples[blockIdx.y];
+  if (static_cast<int>(blockIdx.x) >= sample.num_tiles)
+    return;
+  int64_t start = TileStart<kBlockSize, kItemsPerThread>(sample);
+  int count = 0;
+  for (int k = 0; k < kItemsPerThread; k++) {
+    int64_t i = start + k * kBlockSize + threadIdx.x;
+    bool is_root = false;
+    if (i < sample.volume) {
+      OutLabel label = sample.labels[i];
+      if (label >= 0) {
+        // no path compression - it could overwrite the roots stored by other threads
+        OutLabel root = Find<false, OutLabel>(sample.labels, i);
+        sample.labels[i] = root;
+        is_root = root == i;
+      }
+    }
+    count += __syncthreads_count(is_root);
+  }
+  if (threadIdx.x == 0)
+    sample.tile_counts[blockIdx.x] = count;
+}
+
+/**
+ * @brief Calculates the exclusive prefix sum of the tile counts, one block per sample
+ */
+template <int kBlockSize, typename OutLabel, typename InLabel>
+__global__ void ScanTileCountsKernel(const SampleDesc<OutLabel, InLabel> *samples) {
+  const auto &sample = samples[blockIdx.x];
+  __shared__ int64_t tmp[kBlockSize];
+  int64_t carry = 0;
+  for (int base = 0; base < sample.num_tiles; base += kBlockSize) {
+    int idx = base + threadIdx.x;
+    int64_t value = idx < sample.num_tiles ? sample.tile_counts[idx] : 0;
+    tmp[threadIdx.x] = value;
+    __syncthreads();
+    for (int ofs = 1; ofs < kBlockSize; ofs <<= 1) {
+      int64_t prev = threadIdx.x >= ofs ? tmp[threadIdx.x - ofs] : 0;
+      __syncthreads();
+      tmp[threadIdx.x] += prev;
+      __syncthreads();
+    }
+    if (idx < sample.num_tiles)
+      sample.tile_counts[idx] = carry + tmp[threadIdx.x] - value;
+    carry += tmp[kBlockSize - 1];
+    __syncthreads();
+  }
+  if (threadIdx.x == 0 && sample.num_labels)
+    *sample.num_labels = carry;
+}
+
+/**
+ * @brief Assigns consecutive indices to the roots, in the order of their position in the sample
+ *
+ * The index is stored in the root element, encoded as -2 - index, so that it can be told apart
+ * from the parent indices and the background (-1).
+ */
+template <int kBlockSize, int kItemsPerThread, typename OutLabel, typename InLabel>
+__global__ void RankRootsKernel(const SampleDesc<OutLabel, InLabel> *samples) {
+  const auto &sample = samples[blockIdx.y];
+  if (static_cast<int>(blockIdx.x) >= sample.num_tiles)
+    return;
+  constexpr int kNumWarps = kBlockSize / 32;
+  __shared__ int warp_offsets[kNumWarps];
+  int64_t start = TileStart<kBlockSize, kItemsPerThread>(sample);
+  int64_t rank_base = sample.tile_counts[blockIdx.x];
+  int warp = threadIdx.x / 32, lane = threadIdx.x % 32;
+  for (int k = 0; k < kItemsPerThread; k++) {
+    int64_t i = start + k * kBlockSize + threadIdx.x;
+    bool is_root = i < sample.volume && sample.labels[i] == i;
+    unsigned mask = __ballot_sync(0xffffffffu, is_root);
+    if (lane == 0)
+      warp_offsets[warp] = __popc(mask);
+    __syncthreads();
+    int offset = 0, total = 0;
+    for (int w = 0; w < kNumWarps; w++) {
+      int n = warp_offsets[w];
+      offset += w < warp ? n : 0;
+      total += n;
+    }
+    if (is_root) {
+      int64_t rank = rank_base + offset + __popc(mask & ((1u << lane) - 1));
+      sample.labels[i] = -2 - rank;
+    }
+    rank_base += total;
+    __syncthreads();
+  }
+}
+
+template <typename OutLabel>
+DALI_DEVICE DALI_FORCEINLINE OutLabel FinalLabel(OutLabel encoded_rank, OutLabel background) {
+  OutLabel rank = -2 - encoded_rank;
+  return background >= 0 && rank >= background ? rank + 1 : rank;
+}
+
+/**
+ * @brief Replaces the root indices in non-root elements with the final labels
+ */
+template <int kBlockSize, int kItemsPerThread, typename OutLabel, typename InLabel>
+__global__ void RelabelKernel(const SampleDesc<OutLabel, InLabel> *samples,
+                              OutLabel background) {
+  const auto &sample = samples[blockIdx.y];
+  if (static_cast<int>(blockIdx.x) >= sample.num_tiles)
+    return;
+  int64_t start = TileStart<kBlockSize, kItemsPerThread>(sample);
+  #pragma unroll
+  for (int k = 0; k < kItemsPerThread; k++) {
+    int64_t i = start + k * kBlockSize + threadIdx.x;
+    if (i >= sample.volume)
+      break;
+    OutLabel root = sample.labels[i];
+    if (root >= 0)
+      sample.labels[i] = FinalLabel(sample.labels[root], background);
+  }
+}
+
+/**
+ * @brief Replaces the encoded ranks in the roots and the background markers with the final labels
+ */
+template <int kBlockSize, int kItemsPerThread, typename OutLabel, typename InLabel>
+__global__ void RelabelRootsKernel(const SampleDesc<OutLabel, InLabel> *samples,
+                                   OutLabel background) {
+  const auto &sample = samples[blockIdx.y];
+  if (static_cast<int>(blockIdx.x) >= sample.num_tiles)
+    return;
+  int64_t start = TileStart<kBlockSize, kItemsPerThread>(sample);
+  #pragma unroll
+  for (int k = 0; k < kItemsPerThread; k++) {
+    int64_t i = start + k * kBlockSize + threadIdx.x;
+    if (i >= sample.volume)
+      break;
+    OutLabel label = sample.labels[i];
+    if (label == -1)
+      sample.labels[i] = background;
+    else if (label < -1)
+      sample.labels[i] = FinalLabel(label, background);
+  }
+}
+
+}  // namespace gpu_detail
+
+/**
+ * @brief Labels connected components on the GPU
+ *
+ * The result is the same as that of the CPU LabelConnectedRegions: the elements are connected
+ * when they are neighbors along one of the axes and have the same value; the labels are
+ * assigned in the order of the first occurrence of the component in the sample, skipping
+ * `background_out`.
+ *
+ * The labeling is done with a concurrent union-find: each element is first attached to the start
+ * of its run of equal values within a warp, then the sets of the neighbors are merged with atomic
+ * operations. Lastly, the roots are ranked with a prefix sum and
+ * the ranks are propagated to all elements.
+ *
+ * @tparam OutLabel signed integer type, capable of storing the offset to the last element
+ *                  in a sample
+ */
+template <typename OutLabel, typename InLabel>
+class LabelConnectedRegionsGPU {
+ public:
+  static_assert(std::is_same<OutLabel, int32_t>::value || std::is_same<OutLabel, int64_t>::value,
+                "The output label must be a 32- or 64-bit signed integer");
+
+  static constexpr int kBlockSize = 256;
+  static constexpr int kItemsPerThread = 8;
+  static constexpr int kTileSize = kBlockSize * kItemsPerThread;
+
+  /**
+   * @param ctx             Kernel context; the scratchpad is used for temporary buffers
+   * @param out             Output labels
+   * @param in              Input tensor with objects; one value can mark multiple objects
+   * @param num_labels      (optional) device pointer to an array which receives the number of
+   *                        non-background components in each sample
+   * @param background_out  The label assigned to background elements in the output
+   * @param background_in   The value which denotes background elements in the input
+   */
+  void Run(KernelContext &ctx,
+           const OutListGPU<OutLabel> &out,
+           const InListGPU<InLabel> &in,
+           int64_t *num_labels = nullptr,
+           same_as_t<OutLabel> background_out = 0,
+           same_as_t<InLabel> background_in = 0) {
+    using gpu_detail::SampleDesc;
+    int N = in.num_samples();
+    assert(out.shape == in.shape);
+    if (N == 0)
+      return;
+    int ndim = in.sample_dim();
+    DALI_ENFORCE(ndim <= gpu_detail::kMaxDims, make_string(
+        "Unsupported number of dimensions: ", ndim, ". Valid range is 0..",
+        gpu_detail::kMaxDims, "."));
+
+    samples_.resize(N);
+    int64_t total_tiles = 0;
+    int max_tiles = 0;
+    for (int i = 0; i < N; i++) {
+      auto sh = in.tensor_shape_span(i);
+      auto &s = samples_[i];
+      s.labels = out.data[i];
+      s.in = in.data[i];
+      s.volume = volume(sh);
+      DALI_ENFORCE(s.volume <= std::numeric_limits<OutLabel>::max(), make_string(
+          "The sample ", i, " is too large for the output label type."));
+      // a scalar is processed as a 1D tensor with one element
+      s.ndim = std::max(ndim, 1);
+      int64_t stride = 1;
+      for (int d = s.ndim - 1; d >= 0; d--) {
+        int64_t extent = ndim ? sh[d] : 1;
+        s.stride[d] = stride;
+        s.outer[d] = static_cast<uint64_t>(std::max<int64_t>(stride * extent, 1));
+        stride *= extent;
+      }
+      s.num_tiles = div_ceil(s.volume, kTileSize);
+      s.tile_counts = nullptr;  // assigned below
+      s.num_labels = num_labels ? num_labels + i : nullptr;
+      total_tiles += s.num_tiles;
+      max_tiles = std::max(max_tiles, s.num_tiles);
+    }
+
+    int64_t *tile_counts = ctx.scratchpad->AllocateGPU<int64_t>(std::max<int64_t>(total_tiles, 1));
+    for (auto &s : samples_) {
+      s.tile_counts = tile_counts;
+      tile_counts += s.num_tiles;
+    }
+
+    cudaStream_t stream = ctx.gpu.stream;
+    auto *samples_gpu = ctx.scratchpad->ToGPU(stream, samples_);
+
+    if (max_tiles > 0) {
+      dim3 grid(max_tiles, N);
+      gpu_detail::InitLabelsKernel<kBlockSize, kItemsPerThread>
+          <<<grid, kBlockSize, 0, stream>>>(samples_gpu, background_in);
+      CUDA_CALL(cudaGetLastError());
+      gpu_detail::MergeKernel<kBlockSize, kItemsPerThread>
+          <<<grid, kBlockSize, 0, stream>>>(samples_gpu, background_in);
+      CUDA_CALL(cudaGetLastError());
+      gpu_detail::FlattenKernel<kBlockSize, kItemsPerThread>
+          <<<grid, kBlockSize, 0, stream>>>(samples_gpu);
+      CUDA_CALL(cudaGetLastError());
+    }
+    gpu_detail::ScanTileCountsKernel<kBlockSize><<<N, kBlockSize, 0, stream>>>(samples_gpu);
+    CUDA_CALL(cudaGetLastError());
+    if (max_tiles > 0) {
+      dim3 grid(max_tiles, N);
+      gpu_detail::RankRootsKernel<kBlockSize, kItemsPerThread>
+          <<<grid, kBlockSize, 0, stream>>>(samples_gpu);
+      CUDA_CALL(cudaGetLastError());
+      gpu_detail::RelabelKernel<kBlockSize, kItemsPerThread>
+          <<<grid, kBlockSize, 0, stream>>>(samples_gpu, background_out);
+      CUDA_CALL(cudaGetLastError());
+      gpu_detail::RelabelRootsKernel<kBlockSize, kItemsPerThread>
+          <<<grid, kBlockSize, 0, stream>>>(samples_gpu, background_out);
+      CUDA_CALL(cudaGetLastError());
+    }
+  }
+
+ private:
+  std::vector<gpu_detail::SampleDesc<OutLabel, InLabel>> samples_;
+};
+
+}  // namespace connected_components
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_STRUCTURE_CONNECTED_COMPONENTS_GPU_CUH_
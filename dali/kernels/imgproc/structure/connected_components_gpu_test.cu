@@ -0,0 +1,108 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "dali/core/dev_buffer.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/imgproc/structure/connected_components.h"
+#include "dali/kernels/imgproc/structure/connected_components_gpu.cuh"
+#include "dali/test/tensor_test_utils.h"
+#include "dali/test/test_tensors.h"
+
+namespace dali {
+namespace kernels {
+
+namespace {
+
+/**
+ * @brief Fills the input with runs of random lengths and values from the range [0, num_values),
+ *        so that the blobs span across warps and tiles.
+ */
+template <typename T, int ndim>
+void FillBlobs(const TensorListView<StorageCPU, T, ndim> &in, std::mt19937_64 &rng,
+               int num_values) {
+  std::uniform_int_distribution<int> value_dist(0, num_values - 1);
+  std::bernoulli_distribution keep(0.9);
+  for (int i = 0; i < in.num_samples(); i++) {
+    auto *data = in.data[i];
+    int64_t n = in[i].num_elements();
+    for (int64_t j = 0; j < n; j++)
+      data[j] = (j > 0 && keep(rng)) ? data[j - 1] : value_dist(rng);
+  }
+}
+
+}  // namespace
+
+template <typename OutLabel, typename InLabel>
+void TestConnectedComponentsGPU(const TensorListShape<> &shape, InLabel bg_in, OutLabel bg_out,
+                                int num_values) {
+  std::mt19937_64 rng(1234);
+  TestTensorList<InLabel> in;
+  TestTensorList<OutLabel> out, ref;
+  in.reshape(shape);
+  out.reshape(shape);
+  ref.reshape(shape);
+  FillBlobs(in.cpu(), rng, num_values);
+
+  int N = shape.num_samples();
+  TensorListView<StorageCPU, const InLabel> in_cpu = in.cpu();
+  auto ref_cpu = ref.cpu();
+  std::vector<int64_t> ref_num_labels(N);
+  SequentialExecutionEngine engine;
+  for (int i = 0; i < N; i++)
+    ref_num_labels[i] = connected_components::LabelConnectedRegions(
+        ref_cpu[i], in_cpu[i], engine, bg_out, bg_in);
+
+  DeviceBuffer<int64_t> num_labels;
+  num_labels.resize(N);
+  connected_components::LabelConnectedRegionsGPU<OutLabel, InLabel> kernel;
+  DynamicScratchpad scratchpad;
+  KernelContext ctx;
+  ctx.gpu.stream = 0;
+  ctx.scratchpad = &scratchpad;
+  kernel.Run(ctx, out.gpu(), in.gpu(), num_labels.data(), bg_out, bg_in);
+
+  std::vector<int64_t> out_num_labels(N);
+  CUDA_CALL(cudaMemcpy(out_num_labels.data(), num_labels.data(), N * sizeof(int64_t),
+                       cudaMemcpyDeviceToHost));
+  EXPECT_EQ(out_num_labels, ref_num_labels);
+  Check(out.cpu(), ref_cpu);
+}
+
+TEST(ConnectedComponentsGPU, 1D) {
+  TensorListShape<> shape = {{ 1 }, { 31 }, { 1000 }, { 12345 }, { 0 }};
+  TestConnectedComponentsGPU<int64_t, uint8_t>(shape, 0, 0, 3);
+}
+
+TEST(ConnectedComponentsGPU, 2D) {
+  TensorListShape<> shape = {{ 480, 640 }, { 1, 1 }, { 33, 7 }, { 100, 1 }, { 256, 2050 }};
+  TestConnectedComponentsGPU<int64_t, uint8_t>(shape, 0, 0, 2);
+  TestConnectedComponentsGPU<int32_t, int>(shape, 1, -1, 4);
+}
+
+TEST(ConnectedComponentsGPU, 3D) {
+  TensorListShape<> shape = {{ 40, 50, 60 }, { 3, 1, 1000 }, { 1, 100, 1 }, { 100, 200, 30 }};
+  TestConnectedComponentsGPU<int64_t, int>(shape, 0, 0, 3);
+  TestConnectedComponentsGPU<int32_t, uint8_t>(shape, 2, 5, 3);
+}
+
+TEST(ConnectedComponentsGPU, 5D) {
+  TensorListShape<> shape = {{ 3, 4, 5, 6, 7 }, { 7, 1, 9, 1, 40 }};
+  TestConnectedComponentsGPU<int64_t, uint8_t>(shape, 0, 0, 2);
+}
+
+}  // namespace kernels
+}  // namespace dali
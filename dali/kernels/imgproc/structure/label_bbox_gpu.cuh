@@ -0,0 +1,213 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_STRUCTURE_LABEL_BBOX_GPU_CUH_
+#define DALI_KERNELS_IMGPROC_STRUCTURE_LABEL_BBOX_GPU_CUH_
+
+#include <cuda_runtime.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/cuda_utils.h"
+#include "dali/core/fast_div.h"
+#include "dali/core/geom/box.h"
+#include "dali/core/tensor_view.h"
+#include "dali/core/util.h"
+#include "dali/kernels/kernel.h"
+
+namespace dali {
+namespace kernels {
+namespace label_bbox {
+namespace gpu_detail {
+
+template <typename Label, int ndim>
+struct SampleDesc {
+  Box<ndim, int> *boxes;
+  int num_boxes;
+  const Label *in;
+  int64_t volume;
+  fast_div<uint64_t> stride[ndim];
+  /// stride[d] * shape[d]
+  fast_div<uint64_t> outer[ndim];
+  int num_tiles;
+};
+
+/**
+ * @brief Prepares the boxes for atomic min/max accumulation
+ */
+template <typename Label, int ndim>
+__global__ void InitBoxesKernel(const SampleDesc<Label, ndim> *samples) {
+  const auto &sample = samples[blockIdx.y];
+  for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < sample.num_boxes;
+       i += blockDim.x * gridDim.x) {
+    Box<ndim, int> box;
+    for (int d = 0; d < ndim; d++) {
+      box.lo[d] = std::numeric_limits<int>::max();
+      box.hi[d] = std::numeric_limits<int>::min();
+    }
+    sample.boxes[i] = box;
+  }
+}
+
+/**
+ * @brief Expands the boxes to contain all the elements with the corresponding labels
+ *
+ * When a whole warp encounters the same label (which is the typical case inside the objects),
+ * the coordinates are reduced within the warp and only one lane updates the box.
+ */
+template <int kBlockSize, int kItemsPerThread, typename Label, int ndim>
+__global__ void AccumulateBoxesKernel(const SampleDesc<Label, ndim> *samples, Label background) {
+  const auto &sample = samples[blockIdx.y];
+  if (static_cast<int>(blockIdx.x) >= sample.num_tiles)
+    return;
+  int64_t start = static_cast<int64_t>(blockIdx.x) * kBlockSize * kItemsPerThread;
+  const unsigned nboxes = sample.num_boxes;
+  for (int k = 0; k < kItemsPerThread; k++) {
+    int64_t i = start + k * kBlockSize + threadIdx.x;
+    unsigned idx = nboxes;  // invalid
+    if (i < sample.volume) {
+      Label label = sample.in[i];
+      if (label != background) {
+        // The same mapping as in the CPU variant: a "hole" is made for the background and
+        // the negative labels are out of range (deliberate unsigned overflow).
+        int skip_bg = (background >= 0 && label >= background);
+        idx = static_cast<unsigned>(label) - skip_bg;
+      }
+    }
+    ivec<ndim> lo, hi;
+    uint64_t pos = i;
+    for (int d = 0; d < ndim; d++) {
+      uint64_t pos_in_row = d == 0 ? pos : pos - (pos / sample.outer[d]) * sample.outer[d];
+      lo[d] = pos_in_row / sample.stride[d];
+      hi[d] = lo[d] + 1;
+    }
+    unsigned idx0 = __shfl_sync(0xffffffffu, idx, 0);
+    if (__all_sync(0xffffffffu, idx == idx0)) {
+      if (idx0 >= nboxes)
+        continue;
+      for (int ofs = 16; ofs > 0; ofs >>= 1) {
+        for (int d = 0; d < ndim; d++) {
+          lo[d] = cuda_min(lo[d], __shfl_xor_sync(0xffffffffu, lo[d], ofs));
+          hi[d] = cuda_max(hi[d], __shfl_xor_sync(0xffffffffu, hi[d], ofs));
+        }
+      }
+      if (threadIdx.x % 32 != 0)
+        continue;
+    } else if (idx >= nboxes) {
+      continue;
+    }
+    auto &box = sample.boxes[idx];
+    for (int d = 0; d < ndim; d++) {
+      atomicMin(&box.lo[d], lo[d]);
+      atomicMax(&box.hi[d], hi[d]);
+    }
+  }
+}
+
+/**
+ * @brief Replaces the boxes of the labels that were not found with empty boxes
+ */
+template <typename Label, int ndim>
+__global__ void FinalizeBoxesKernel(const SampleDesc<Label, ndim> *samples) {
+  const auto &sample = samples[blockIdx.y];
+  for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < sample.num_boxes;
+       i += blockDim.x * gridDim.x) {
+    if (sample.boxes[i].hi[0] < sample.boxes[i].lo[0])
+      sample.boxes[i] = {};
+  }
+}
+
+}  // namespace gpu_detail
+
+/**
+ * @brief Calculates a bounding box for each label, on the GPU
+ *
+ * The result is the same as that of the CPU GetLabelBoundingBoxes with integer coordinates:
+ * the box index for a label is calculated as
+ * `background >= 0 && label > background ? label-1 : label`; labels whose box index is outside
+ * of the valid range are ignored and the boxes of the labels which are not present are empty.
+ */
+template <typename Label, int ndim>
+class LabelBoundingBoxesGPU {
+ public:
+  static constexpr int kBlockSize = 256;
+  static constexpr int kItemsPerThread = 8;
+  static constexpr int kTileSize = kBlockSize * kItemsPerThread;
+
+  /**
+   * @param ctx         Kernel context
+   * @param boxes       Output boxes; the number of boxes for the sample `i` is `boxes.shape[i][0]`
+   *                    and the boxes are stored as `Box<ndim, int>`, so `boxes.shape[i][1]` must
+   *                    be `2*ndim`
+   * @param in          Input labels
+   * @param background  The label value interpreted as background; it has no bounding box
+   */
+  void Run(KernelContext &ctx,
+           const OutListGPU<int, 2> &boxes,
+           const InListGPU<Label, ndim> &in,
+           Label background) {
+    using gpu_detail::SampleDesc;
+    int N = in.num_samples();
+    assert(boxes.num_samples() == N);
+    if (N == 0)
+      return;
+    samples_.resize(N);
+    int max_tiles = 0, max_boxes = 0;
+    for (int i = 0; i < N; i++) {
+      auto &s = samples_[i];
+      DALI_ENFORCE(boxes.shape[i][1] == 2 * ndim, make_string(
+          "Expected ", 2 * ndim, " coordinates per box, got ", boxes.shape[i][1], "."));
+      s.boxes = reinterpret_cast<Box<ndim, int> *>(boxes.data[i]);
+      s.num_boxes = boxes.shape[i][0];
+      s.in = in.data[i];
+      auto sh = in.shape[i];
+      s.volume = volume(sh);
+      int64_t stride = 1;
+      for (int d = ndim - 1; d >= 0; d--) {
+        s.stride[d] = static_cast<uint64_t>(stride);
+        s.outer[d] = static_cast<uint64_t>(std::max<int64_t>(stride * sh[d], 1));
+        stride *= sh[d];
+      }
+      s.num_tiles = div_ceil(s.volume, kTileSize);
+      max_tiles = std::max(max_tiles, s.num_tiles);
+      max_boxes = std::max(max_boxes, s.num_boxes);
+    }
+    if (max_boxes == 0)
+      return;
+
+    cudaStream_t stream = ctx.gpu.stream;
+    auto *samples_gpu = ctx.scratchpad->ToGPU(stream, samples_);
+    dim3 boxes_grid(div_ceil(max_boxes, kBlockSize), N);
+    gpu_detail::InitBoxesKernel<<<boxes_grid, kBlockSize, 0, stream>>>(samples_gpu);
+    CUDA_CALL(cudaGetLastError());
+    if (max_tiles > 0) {
+      dim3 grid(max_tiles, N);
+      gpu_detail::AccumulateBoxesKernel<kBlockSize, kItemsPerThread>
+          <<<grid, kBlockSize, 0, stream>>>(samples_gpu, background);
+      CUDA_CALL(cudaGetLastError());
+    }
+    gpu_detail::FinalizeBoxesKernel<<<boxes_grid, kBlockSize, 0, stream>>>(samples_gpu);
+    CUDA_CALL(cudaGetLastError());
+  }
+
+ private:
+  std::vector<gpu_detail::SampleDesc<Label, ndim>> samples_;
+};
+
+}  // namespace label_bbox
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_STRUCTURE_LABEL_BBOX_GPU_CUH_
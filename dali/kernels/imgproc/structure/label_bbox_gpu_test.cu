@@ -0,0 +1,84 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/imgproc/structure/label_bbox.h"
+#include "dali/kernels/imgproc/structure/label_bbox_gpu.cuh"
+#include "dali/test/tensor_test_utils.h"
+#include "dali/test/test_tensors.h"
+
+namespace dali {
+namespace kernels {
+
+template <typename Label, int ndim>
+void TestLabelBBoxesGPU(const TensorListShape<> &shape, int num_labels, int num_boxes,
+                        Label background) {
+  std::mt19937_64 rng(4321);
+  TestTensorList<Label, ndim> in;
+  TestTensorList<int, 2> boxes;
+  in.reshape(shape.to_static<ndim>());
+  int N = shape.num_samples();
+  boxes.reshape(uniform_list_shape<2>(N, { num_boxes, 2 * ndim }));
+
+  // runs of labels, with some negative labels mixed in
+  std::uniform_int_distribution<int> label_dist(-1, num_labels - 1);
+  std::bernoulli_distribution keep(0.95);
+  auto in_cpu = in.cpu();
+  for (int i = 0; i < N; i++) {
+    int64_t n = in_cpu[i].num_elements();
+    for (int64_t j = 0; j < n; j++)
+      in_cpu.data[i][j] = (j > 0 && keep(rng)) ? in_cpu.data[i][j - 1] : label_dist(rng);
+  }
+
+  label_bbox::LabelBoundingBoxesGPU<Label, ndim> kernel;
+  DynamicScratchpad scratchpad;
+  KernelContext ctx;
+  ctx.gpu.stream = 0;
+  ctx.scratchpad = &scratchpad;
+  kernel.Run(ctx, boxes.gpu(), in.gpu(), background);
+  auto out_cpu = boxes.cpu();
+
+  std::vector<Box<ndim, int>> ref(num_boxes);
+  for (int i = 0; i < N; i++) {
+    TensorView<StorageCPU, const Label, ndim> sample = in_cpu[i];
+    label_bbox::GetLabelBoundingBoxes(make_span(ref), sample, background);
+    auto *out = reinterpret_cast<const Box<ndim, int> *>(out_cpu.data[i]);
+    for (int b = 0; b < num_boxes; b++)
+      EXPECT_EQ(out[b], ref[b]) << "Box " << b << " differs in sample " << i;
+  }
+}
+
+TEST(LabelBBoxesGPU, 1D) {
+  TensorListShape<> shape = {{ 1 }, { 31 }, { 1000 }, { 12345 }, { 0 }};
+  TestLabelBBoxesGPU<int, 1>(shape, 10, 12, 0);
+  TestLabelBBoxesGPU<int, 1>(shape, 10, 5, -1);
+}
+
+TEST(LabelBBoxesGPU, 2D) {
+  TensorListShape<> shape = {{ 480, 640 }, { 1, 1 }, { 33, 7 }, { 100, 1 }, { 256, 2050 }};
+  TestLabelBBoxesGPU<int, 2>(shape, 20, 20, 0);
+  TestLabelBBoxesGPU<int64_t, 2>(shape, 20, 30, 3);
+}
+
+TEST(LabelBBoxesGPU, 3D) {
+  TensorListShape<> shape = {{ 40, 50, 60 }, { 3, 1, 1000 }, { 1, 100, 1 }, { 100, 200, 30 }};
+  TestLabelBBoxesGPU<int, 3>(shape, 50, 49, 0);
+  TestLabelBBoxesGPU<int, 3>(shape, 5, 10, -1);
+}
+
+}  // namespace kernels
+}  // namespace dali
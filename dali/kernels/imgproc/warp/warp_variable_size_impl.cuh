@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -31,14 +31,18 @@ template <typename Mapping,
 __global__ void BatchWarpVariableSize(
     const SampleDesc<ndim, OutputType, InputType> *samples,
     const BlockDesc<ndim> *blocks,
+    int num_blocks,
     const mapping_params_t<Mapping> *mapping,
     BorderType border) {
-  auto block = blocks[blockIdx.x];
-  auto sample = samples[block.sample_idx];
-  VALUE_SWITCH(sample.interp, interp_const, (DALI_INTERP_NN, DALI_INTERP_LINEAR), (
-    BlockWarp<interp_const, Mapping, OutputType, InputType, BorderType>(
-      sample, block, Mapping(mapping[block.sample_idx]), border)),
-    (assert(!"Interpolation type not supported")));
+  // the grid may be smaller than the number of blocks (persistent grid)
+  for (int b = blockIdx.x; b < num_blocks; b += gridDim.x) {
+    auto block = blocks[b];
+    auto sample = samples[block.sample_idx];
+    VALUE_SWITCH(sample.interp, interp_const, (DALI_INTERP_NN, DALI_INTERP_LINEAR), (
+      BlockWarp<interp_const, Mapping, OutputType, InputType, BorderType>(
+        sample, block, Mapping(mapping[block.sample_idx]), border)),
+      (assert(!"Interpolation type not supported")));
+  }
 }
 
 }  // namespace warp
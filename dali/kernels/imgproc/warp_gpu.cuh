@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,7 +15,9 @@
 #ifndef DALI_KERNELS_IMGPROC_WARP_GPU_CUH_
 #define DALI_KERNELS_IMGPROC_WARP_GPU_CUH_
 
+#include <algorithm>
 #include "dali/core/common.h"
+#include "dali/core/cuda_rt_utils.h"
 #include "dali/core/geom/vec.h"
 #include "dali/kernels/kernel.h"
 #include "dali/kernels/imgproc/warp/warp_setup.cuh"
@@ -65,6 +67,7 @@ class WarpGPU {
                            BorderType border = {}) {
     assert(in.size() == output_sizes.size());
     setup.SetBlockDim(dim3(32, 8, 1));
+    setup.SetMaxGridSize(MaxGridSize(setup.BlockDim()));
     auto out_shapes = setup.GetOutputShape(in.shape, output_sizes);
     return setup.Setup(out_shapes);
   }
@@ -117,6 +120,7 @@ class WarpGPU {
         <<<grid_dim, block_dim, 0, context.gpu.stream>>>(
           gpu_samples,
           gpu_blocks,
+          static_cast<int>(setup.Blocks().size()),
           mapping.data,
           border);
       CUDA_CALL(cudaGetLastError());
@@ -124,7 +128,23 @@ class WarpGPU {
   }
 
  private:
+  /**
+   * @brief The number of blocks of the variable-size kernel that can run concurrently -
+   *        used as the size of the persistent grid.
+   */
+  int MaxGridSize(dim3 block_dim) {
+    if (blocks_per_sm_ == 0) {
+      CUDA_CALL(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+          &blocks_per_sm_,
+          warp::BatchWarpVariableSize<Mapping, spatial_ndim, OutputType, InputType, BorderType>,
+          block_dim.x * block_dim.y * block_dim.z, 0));
+      blocks_per_sm_ = std::max(blocks_per_sm_, 1);
+    }
+    return blocks_per_sm_ * GetSmCount();
+  }
+
   WarpSetup setup;
+  int blocks_per_sm_ = 0;
   friend class WarpPrivateTest;
 };
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,6 +15,7 @@
 #ifndef DALI_KERNELS_KERNEL_MANAGER_H_
 #define DALI_KERNELS_KERNEL_MANAGER_H_
 
+#include <any>
 #include <cassert>
 #include <memory>
 #include <utility>
@@ -23,6 +24,7 @@
 #include "dali/kernels/context.h"
 #include "dali/kernels/kernel_req.h"
 #include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/scratchpad_arena.h"
 #include "dali/core/call_at_exit.h"
 #include "dali/core/small_vector.h"
 #include "dali/core/mm/memory_kind.h"
@@ -33,12 +35,15 @@ namespace kernels {
 struct AnyKernelInstance {
   KernelRequirements requirements;
   std::unique_ptr<void, void(*)(void*)> instance = { nullptr, free };
+  /// The key of the cached requirements, see KernelManager::SetupCached
+  std::any setup_key;
 
   template <typename Kernel, typename... Args>
   Kernel &create_or_get(Args&&... args) {
     void (*deleter)(void *) = delete_kernel<Kernel>;
     if (!instance || instance.get_deleter() != deleter) {
       instance.reset();
+      setup_key.reset();
       Kernel *k = new Kernel{std::forward<Args>(args)...};
       instance = { k, deleter };
     }
@@ -170,10 +175,50 @@ class DLL_PUBLIC KernelManager {
   template <typename Kernel, typename... InArgs>
   KernelRequirements &Setup(int instance_idx, KernelContext &context, InArgs &&...in_args) {
     auto &inst = instances[instance_idx];
+    inst.setup_key.reset();
     inst.requirements = inst.get<Kernel>().Setup(context, std::forward<InArgs>(in_args)...);
     return inst.requirements;
   }
 
+  /**
+   * @brief Calls setup on specified kernel instance, unless it was last set up with the same key.
+   *
+   * The key should combine everything the kernel's Setup depends on - typically, the input
+   * shapes and the arguments. If it compares equal to the key passed in the previous call
+   * for this instance, Setup is skipped and the cached requirements are returned; the kernel
+   * keeps the state (e.g. the block setup) computed in that call.
+   * Calling the regular Setup or recreating the instance invalidates the cached requirements.
+   *
+   * @param instance_idx   - kernel instance index; typically corresponds
+   *                         to sample index (for per-sample kernels) or minibatch index
+   * @param key            - a copyable, equality-comparable value describing the setup
+   * @param context        - context for the kernel
+   * @param in_args        - pack of arguments (inputs, arguments) used in Kernel::Setup
+   * @return Reference to internally maintained copy of the kernel requirements.
+   *
+   * @remark The kernel instance must already exist (see Initialize or CreateOrGet).
+   */
+  template <typename Kernel, typename Key, typename... InArgs>
+  KernelRequirements &SetupCached(int instance_idx, const Key &key, KernelContext &context,
+                                  InArgs &&...in_args) {
+    auto &inst = instances[instance_idx];
+    Kernel &kernel = inst.get<Kernel>();
+    Key *prev = std::any_cast<Key>(&inst.setup_key);
+    if (prev && *prev == key)
+      return inst.requirements;
+    try {
+      inst.requirements = kernel.Setup(context, std::forward<InArgs>(in_args)...);
+    } catch (...) {
+      inst.setup_key.reset();
+      throw;
+    }
+    if (prev)
+      *prev = key;  // reuse the storage
+    else
+      inst.setup_key = key;
+    return inst.requirements;
+  }
+
   /**
    * @brief Calls Run on specified kernel instance
    *
@@ -181,8 +226,10 @@ class DLL_PUBLIC KernelManager {
    *                         to sample index (for per-sample kernels) or minibatch index
    * @param context        - context for the kernel
    *                         * should contain valid CUDA stream for GPU kernels;
-   *                         * if scratchpad pointer is null, a temporary dynamic scratchpad is
-   *                           created
+   *                         * if scratchpad pointer is null, the memory is taken from the
+   *                           calling thread's ScratchpadArena, which is first grown to the
+   *                           scratch sizes declared in Setup; if the arena is already in use,
+   *                           a temporary dynamic scratchpad is created
    * @param out_in_args    - pack of arguments (outputs, inputs, arguments) used in Kernel::Run
    *
    * @remark You can't pass the brace initialization to the OutInArgs,
@@ -195,12 +242,21 @@ class DLL_PUBLIC KernelManager {
            "Kernel instance index (instance_idx) out of range");
     auto &inst = instances[instance_idx];
     if (!context.scratchpad) {
-      DynamicScratchpad scratchpad({}, AccessOrder(context.gpu.stream));
-      context.scratchpad = &scratchpad;
+      AccessOrder order(context.gpu.stream);
+      auto &arena = ScratchpadArena::ThreadLocal(order.device_id());
       auto finally = AtScopeExit([&]() {
         context.scratchpad = nullptr;
       });
-      inst.get<Kernel>().Run(context, std::forward<OutInArgs>(out_in_args)...);
+      if (!arena.InUse()) {
+        arena.Reserve(inst.requirements.scratch_sizes, order);
+        auto scratchpad = arena.GetScratchpad(order);
+        context.scratchpad = &scratchpad;
+        inst.get<Kernel>().Run(context, std::forward<OutInArgs>(out_in_args)...);
+      } else {
+        DynamicScratchpad scratchpad({}, order);
+        context.scratchpad = &scratchpad;
+        inst.get<Kernel>().Run(context, std::forward<OutInArgs>(out_in_args)...);
+      }
     } else {
       inst.get<Kernel>().Run(context, std::forward<OutInArgs>(out_in_args)...);
     }
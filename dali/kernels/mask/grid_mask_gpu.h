@@ -1,4 +1,4 @@
-// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2021, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -46,8 +46,10 @@ __global__ void GridMaskKernel(const GridMaskSampleDesc<T> *samples,
       float fx = fmaf(x, sample.ca, fxy);
       float fy = fmaf(x, sample.sa, fyy);
       if ((fx - ::floor(fx) >= sample.ratio) || (fy - ::floor(fy) >= sample.ratio)) {
-        for (unsigned i = 0; i < (C ? C : sample.channels); i++)
-          sample.out[off + i] = sample.in[off + i];
+        if (sample.out != sample.in) {  // in place, only the masked pixels are written
+          for (unsigned i = 0; i < (C ? C : sample.channels); i++)
+            sample.out[off + i] = sample.in[off + i];
+        }
       } else {
         for (unsigned i = 0; i < (C ? C : sample.channels); i++)
           sample.out[off + i] = 0;
@@ -0,0 +1,108 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_MATH_TRANSFORM_BOXES_CUH_
+#define DALI_KERNELS_MATH_TRANSFORM_BOXES_CUH_
+
+#include <algorithm>
+#include "dali/core/cuda_error.h"
+#include "dali/core/static_switch.h"
+#include "dali/core/util.h"
+#include "dali/kernels/math/transform_boxes.h"
+
+namespace dali {
+namespace kernels {
+
+struct TransformBoxesSampleDesc {
+  float *__restrict__ out;        // output boxes
+  const float *__restrict__ in;   // input boxes
+  int64_t size;                   // number of boxes
+  mat2 M;
+  vec2 T;
+};
+
+template <bool ltrb, bool clip>
+__global__ void TransformBoxesKernel(const TransformBoxesSampleDesc *descs) {
+  auto desc = descs[blockIdx.y];
+  int64_t grid_stride = static_cast<int64_t>(gridDim.x) * blockDim.x;
+  int64_t start_idx = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  for (int64_t idx = start_idx; idx < desc.size; idx += grid_stride)
+    TransformBox(desc.out + idx * 4, desc.in + idx * 4, desc.M, desc.T, ltrb, clip);
+}
+
+/**
+ * @brief Applies per-sample affine transforms to 2D bounding boxes (see TransformBox).
+ *
+ * The whole batch is processed in one launch. A sequence of box transformations (flip,
+ * paste, crop, ...) can be applied at once by combining their matrices on the host first.
+ */
+class TransformBoxesGPU {
+  using SampleDesc = TransformBoxesSampleDesc;
+
+ public:
+  KernelRequirements Setup(KernelContext &ctx, const TensorListShape<> &in_shape) {
+    KernelRequirements req;
+    int N = in_shape.num_samples();
+    for (int i = 0; i < N; i++) {
+      auto sample_shape = in_shape.tensor_shape_span(i);
+      DALI_ENFORCE(!sample_shape.empty() && sample_shape.back() == 4,
+                   make_string("The boxes must be stored in the innermost dimension, which "
+                               "must have an extent of 4; got shape ", in_shape[i],
+                               " in the sample ", i));
+    }
+    req.output_shapes = { in_shape };
+
+    ScratchpadEstimator se;
+    se.add<mm::memory_kind::pinned, SampleDesc>(N);
+    se.add<mm::memory_kind::device, SampleDesc>(N);
+    req.scratch_sizes = se.sizes;
+    return req;
+  }
+
+  void Run(KernelContext &ctx, const OutListGPU<float> &out, const InListGPU<float> &in,
+           span<const mat2> M, span<const vec2> T, bool ltrb, bool clip = false) {
+    int N = in.shape.num_samples();
+    auto *host_descs = ctx.scratchpad->AllocatePinned<SampleDesc>(N);
+    int64_t max_size = 0;
+    for (int i = 0, i_m = 0, i_t = 0; i < N; i++) {
+      host_descs[i].out = out.data[i];
+      host_descs[i].in  = in.data[i];
+      host_descs[i].size = in.shape.tensor_size(i) / 4;
+      host_descs[i].M = M.empty() ? 1.0f : M[i_m];
+      host_descs[i].T = T.empty() ? 0.0f : T[i_t];
+      max_size = std::max(max_size, host_descs[i].size);
+
+      i_m += (M.size() > 1);  // if there's just one value in M, don't advance the index
+      i_t += (T.size() > 1);  // if there's just one value in T, don't advance the index
+    }
+    if (max_size == 0)
+      return;
+    auto *gpu_descs = ctx.scratchpad->ToGPU(ctx.gpu.stream, make_span(host_descs, N));
+    const int block = 256;
+    // the boxes are few - don't launch more blocks than needed to cover the largest sample
+    dim3 grid(std::min<int64_t>(div_ceil(max_size, block), 1024), N);
+    BOOL_SWITCH(ltrb, static_ltrb, (
+      BOOL_SWITCH(clip, static_clip, (
+        TransformBoxesKernel<static_ltrb, static_clip><<<grid, block, 0, ctx.gpu.stream>>>(
+            gpu_descs);
+      ));  // NOLINT
+    ));  // NOLINT
+    CUDA_CALL(cudaGetLastError());
+  }
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_MATH_TRANSFORM_BOXES_CUH_
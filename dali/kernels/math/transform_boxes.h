@@ -0,0 +1,99 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_MATH_TRANSFORM_BOXES_H_
+#define DALI_KERNELS_MATH_TRANSFORM_BOXES_H_
+
+#include "dali/core/format.h"
+#include "dali/core/geom/mat.h"
+#include "dali/core/host_dev.h"
+#include "dali/core/math_util.h"
+#include "dali/core/tensor_shape_print.h"
+#include "dali/kernels/kernel.h"
+
+namespace dali {
+namespace kernels {
+
+/**
+ * @brief Applies an affine transform to a 2D bounding box.
+ *
+ * The box is given as `ltrb` (left, top, right, bottom) or `xywh` (left, top, width, height).
+ * The result is the smallest axis-aligned box which contains the transformed corners of the
+ * input box - for the transforms which map axis-aligned boxes to axis-aligned boxes (flips,
+ * scaling, translation, 90-degree rotations) it's the exact image of the box.
+ * If `clip` is true, the output box is clamped to the [0, 1] range.
+ */
+DALI_HOST_DEV inline void TransformBox(float *out, const float *in, const mat2 &M, vec2 T,
+                                       bool ltrb, bool clip) {
+  vec2 lo(in[0], in[1]);
+  vec2 hi = ltrb ? vec2(in[2], in[3]) : vec2(in[0] + in[2], in[1] + in[3]);
+  vec2 corners[4] = {
+    M * lo + T,
+    M * vec2(hi.x, lo.y) + T,
+    M * vec2(lo.x, hi.y) + T,
+    M * hi + T
+  };
+  vec2 out_lo = corners[0], out_hi = corners[0];
+  #pragma unroll
+  for (int i = 1; i < 4; i++) {
+    #pragma unroll
+    for (int d = 0; d < 2; d++) {
+      out_lo[d] = corners[i][d] < out_lo[d] ? corners[i][d] : out_lo[d];
+      out_hi[d] = corners[i][d] > out_hi[d] ? corners[i][d] : out_hi[d];
+    }
+  }
+  if (clip) {
+    out_lo = clamp(out_lo, vec2(0.0f), vec2(1.0f));
+    out_hi = clamp(out_hi, vec2(0.0f), vec2(1.0f));
+  }
+  out[0] = out_lo.x;
+  out[1] = out_lo.y;
+  if (ltrb) {
+    out[2] = out_hi.x;
+    out[3] = out_hi.y;
+  } else {
+    out[2] = out_hi.x - out_lo.x;
+    out[3] = out_hi.y - out_lo.y;
+  }
+}
+
+/**
+ * @brief Applies an affine transform to 2D bounding boxes (see TransformBox).
+ *
+ * The boxes are stored in the innermost dimension, which must have an extent of 4.
+ */
+class TransformBoxesCPU {
+ public:
+  KernelRequirements Setup(KernelContext &ctx, const TensorShape<> &in_shape) {
+    KernelRequirements req;
+    DALI_ENFORCE(in_shape.size() > 0 && in_shape[in_shape.size() - 1] == 4,
+                 make_string("The boxes must be stored in the innermost dimension, which "
+                             "must have an extent of 4; got shape ", in_shape));
+    req.output_shapes = { TensorListShape<>{{ in_shape }} };
+    return req;
+  }
+
+  void Run(KernelContext &ctx, const OutTensorCPU<float> &out, const InTensorCPU<float> &in,
+           const mat2 &M, vec2 T, bool ltrb, bool clip = false) {
+    int64_t n = in.num_elements() / 4;
+    assert(out.num_elements() == n * 4);
+    for (int64_t i = 0; i < n; i++)
+      TransformBox(out.data + i * 4, in.data + i * 4, M, T, ltrb, clip);
+  }
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_MATH_TRANSFORM_BOXES_H_
@@ -0,0 +1,161 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "dali/kernels/kernel_manager.h"
+#include "dali/kernels/math/transform_boxes.h"
+#include "dali/kernels/math/transform_boxes.cuh"
+#include "dali/test/tensor_test_utils.h"
+#include "dali/test/test_tensors.h"
+
+namespace dali {
+namespace kernels {
+
+TEST(TransformBox, FlipAndPaste) {
+  // horizontal flip: x' = 1 - x
+  mat2 flip = {{ {-1, 0}, {0, 1} }};
+  vec2 flip_t(1, 0);
+  float ltrb[4] = { 0.1f, 0.2f, 0.3f, 0.6f };
+  float out[4];
+  TransformBox(out, ltrb, flip, flip_t, true, false);
+  EXPECT_FLOAT_EQ(out[0], 0.7f);
+  EXPECT_FLOAT_EQ(out[1], 0.2f);
+  EXPECT_FLOAT_EQ(out[2], 0.9f);
+  EXPECT_FLOAT_EQ(out[3], 0.6f);
+
+  float xywh[4] = { 0.1f, 0.2f, 0.2f, 0.4f };
+  TransformBox(out, xywh, flip, flip_t, false, false);
+  EXPECT_FLOAT_EQ(out[0], 0.7f);
+  EXPECT_FLOAT_EQ(out[1], 0.2f);
+  EXPECT_FLOAT_EQ(out[2], 0.2f);
+  EXPECT_FLOAT_EQ(out[3], 0.4f);
+
+  // paste at the center of a canvas twice as large
+  mat2 paste = 0.5f;
+  vec2 paste_t(0.25f, 0.25f);
+  TransformBox(out, ltrb, paste, paste_t, true, false);
+  EXPECT_FLOAT_EQ(out[0], 0.3f);
+  EXPECT_FLOAT_EQ(out[1], 0.35f);
+  EXPECT_FLOAT_EQ(out[2], 0.4f);
+  EXPECT_FLOAT_EQ(out[3], 0.55f);
+
+  // crop with clipping
+  mat2 crop = 2.0f;
+  vec2 crop_t(-0.4f, -0.4f);
+  TransformBox(out, ltrb, crop, crop_t, true, true);
+  EXPECT_FLOAT_EQ(out[0], 0.0f);
+  EXPECT_FLOAT_EQ(out[1], 0.0f);
+  EXPECT_FLOAT_EQ(out[2], 0.2f);
+  EXPECT_FLOAT_EQ(out[3], 0.8f);
+}
+
+TEST(TransformBox, Rotation) {
+  // rotation by 90 degrees around (0.5, 0.5): (x, y) -> (1 - y, x)
+  mat2 rot = {{ {0, -1}, {1, 0} }};
+  vec2 t(1, 0);
+  float ltrb[4] = { 0.1f, 0.2f, 0.3f, 0.6f };
+  float out[4];
+  TransformBox(out, ltrb, rot, t, true, false);
+  EXPECT_FLOAT_EQ(out[0], 0.4f);
+  EXPECT_FLOAT_EQ(out[1], 0.1f);
+  EXPECT_FLOAT_EQ(out[2], 0.8f);
+  EXPECT_FLOAT_EQ(out[3], 0.3f);
+}
+
+struct TransformBoxesTest : ::testing::Test {
+  void PrepareData() {
+    TensorListShape<> shape = {{ {0, 4}, {1, 4}, {1000, 4}, {37, 4} }};
+    in_data_.reshape(shape);
+    out_data_.reshape(shape);
+    UniformRandomFill(in_data_.cpu(), rng_, 0, 0.5);
+    int N = shape.num_samples();
+    M_.resize(N);
+    T_.resize(N);
+    auto dist = uniform_distribution<float>(-1, 1);
+    for (int s = 0; s < N; s++) {
+      for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++)
+          M_[s](i, j) = dist(rng_);
+        T_[s][i] = dist(rng_);
+      }
+    }
+  }
+
+  void CheckOutput(bool ltrb, bool clip) {
+    auto in_cpu = in_data_.cpu();
+    auto out_cpu = out_data_.cpu();
+    for (int s = 0; s < in_cpu.num_samples(); s++) {
+      for (int64_t b = 0; b < in_cpu.shape[s][0]; b++) {
+        float ref[4];
+        TransformBox(ref, in_cpu[s].data + b * 4, M_[s], T_[s], ltrb, clip);
+        for (int k = 0; k < 4; k++)
+          EXPECT_NEAR(out_cpu[s].data[b * 4 + k], ref[k], 1e-6f);
+      }
+    }
+  }
+
+  void RunCPU(bool ltrb, bool clip) {
+    PrepareData();
+    using Kernel = TransformBoxesCPU;
+    auto in = in_data_.cpu();
+    auto out = out_data_.cpu();
+    kmgr_.Resize<Kernel>(1);
+    for (int i = 0; i < in.num_samples(); i++) {
+      KernelContext ctx;
+      auto &req = kmgr_.Setup<Kernel>(0, ctx, in[i].shape);
+      ASSERT_EQ(req.output_shapes[0][0], out[i].shape);
+      kmgr_.Run<Kernel>(0, ctx, out[i], in[i], M_[i], T_[i], ltrb, clip);
+    }
+    CheckOutput(ltrb, clip);
+  }
+
+  void RunGPU(bool ltrb, bool clip) {
+    PrepareData();
+    using Kernel = TransformBoxesGPU;
+    auto in_gpu = in_data_.gpu();
+    auto out_gpu = out_data_.gpu();
+    kmgr_.Resize<Kernel>(1);
+    KernelContext ctx;
+    ctx.gpu.stream = 0;
+    auto &req = kmgr_.Setup<Kernel>(0, ctx, in_gpu.shape);
+    ASSERT_EQ(req.output_shapes[0], out_gpu.shape);
+    kmgr_.Run<Kernel>(0, ctx, out_gpu, in_gpu, make_cspan(M_), make_cspan(T_), ltrb, clip);
+    CheckOutput(ltrb, clip);
+  }
+
+  TestTensorList<float> in_data_, out_data_;
+  std::vector<mat2> M_;
+  std::vector<vec2> T_;
+  KernelManager kmgr_;
+
+  std::mt19937_64 rng_{1234};
+};
+
+TEST_F(TransformBoxesTest, CPU) {
+  for (bool ltrb : {false, true})
+    for (bool clip : {false, true})
+      RunCPU(ltrb, clip);
+}
+
+TEST_F(TransformBoxesTest, GPU) {
+  for (bool ltrb : {false, true})
+    for (bool clip : {false, true})
+      RunGPU(ltrb, clip);
+}
+
+}  // namespace kernels
+}  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -126,6 +126,32 @@ struct NormalizeCPU {
            const InTensorCPU<Param, -1> &mean,
            const InTensorCPU<Param, -1> &scale,
            Param shift = 0) {
+    Run(ctx, out, in, mean, scale, shift, 0, NumSlices());
+  }
+
+  /**
+   * @brief The number of independent slices of the data, which can be normalized separately
+   *
+   * The slices are the outermost dimension of the data, after collapsing the dimensions.
+   */
+  int64_t NumSlices() const {
+    return ndim() > 0 ? data_shape_[0] : 1;
+  }
+
+  /**
+   * @brief Normalizes the slices [begin, end) of the data (see NumSlices)
+   *
+   * This overload doesn't modify the kernel, so disjoint ranges of a tensor can be normalized
+   * concurrently.
+   */
+  void Run(KernelContext &ctx,
+           const OutTensorCPU<Out, -1> &out,
+           const InTensorCPU<In, -1> &in,
+           const InTensorCPU<Param, -1> &mean,
+           const InTensorCPU<Param, -1> &scale,
+           Param shift,
+           int64_t begin,
+           int64_t end) const {
     (void)ctx;
 
     DALI_ENFORCE(mean.shape == scale.shape, make_string(
@@ -138,34 +164,44 @@ struct NormalizeCPU {
 
     DALI_ENFORCE(out.shape == orig_shape_, "Output and input shapes must match");
 
-    input_ = in.data;
-    output_ = out.data;
+    assert(0 <= begin && begin <= end && end <= NumSlices());
+    if (begin == end)
+      return;
 
-    mean_ = mean.data;
-    scale_ = scale.data;
-
-    shift_ = shift;
-
-    Normalize();
+    Normalize(out.data, in.data, mean.data, scale.data, shift, begin, end);
   }
 
-  void Normalize() {
+  void Normalize(Out *out, const In *in, const Param *mean, const Param *scale, Param shift,
+                 int64_t begin, int64_t end) const {
     int D = ndim();
+    if (D == 0) {  // a scalar
+      *out = ConvertSat<Out>((*in - *mean) * *scale + shift);
+      return;
+    }
     TensorShape<> data_strides = GetStrides(data_shape_);
     TensorShape<> param_strides = GetStrides(param_shape_);
     for (int i = 0; i < D; i++) {
       if (param_shape_[i] == 1)
         param_strides[i] = 0;  // reduced dim - use the same parameter slice for all data slices
     }
-    NormalizeAxis(0, output_, input_, data_strides.data(),
-                  mean_, scale_, param_strides.data());
+    out += begin * data_strides[0];
+    in += begin * data_strides[0];
+    mean += begin * param_strides[0];
+    scale += begin * param_strides[0];
+    NormalizeAxis(0, end - begin, out, in, data_strides.data(),
+                  mean, scale, param_strides.data(), shift);
   }
 
-  void NormalizeAxis(int axis,
+  /**
+   * @param extent  the extent of the dimension `axis`; it's smaller than in data_shape_, when
+   *                normalizing a range of slices
+   */
+  void NormalizeAxis(int axis, int64_t extent,
     Out *out, const In *in,
     const int64_t *data_strides,
     const Param *mean, const Param *scale,
-    const int64_t *param_strides) {
+    const int64_t *param_strides,
+    Param shift) const {
 
     using namespace normalize_impl;  // NOLINT
 
@@ -175,30 +211,29 @@ struct NormalizeCPU {
 
       // last dimension - 1D case, which can be either:
       if (param_strides[axis] == 0)
-        normalize(out, in, data_shape_[axis], *mean, *scale, shift_);  // shared factors or..
+        normalize(out, in, extent, *mean, *scale, shift);  // shared factors or..
       else
-        normalize(out, in, data_shape_[axis], mean, scale, shift_);    // per-element factors
+        normalize(out, in, extent, mean, scale, shift);    // per-element factors
     } else if (axis == ndim() - 2) {
       // 2D case can be either normalizing the inner or the outer dimension
       if (param_strides[axis] == 0 && param_strides[axis+1] != 0) {
         // e.g. normalize R,G,B interleaved channels using per-channel normalization factors
         // shared across pixels
         assert(param_strides[axis+1] == 1);
-        normalize_inner(out, in, data_shape_[axis], data_shape_[axis+1], mean, scale, shift_);
+        normalize_inner(out, in, extent, data_shape_[axis+1], mean, scale, shift);
       } else {
         assert(param_strides[axis] == 1 && param_strides[axis+1] == 0);
         // e.g. normalize R,G,B planes using per-channel normalization factors shared across pixels
-        normalize_outer(out, in, data_shape_[axis], data_shape_[axis+1], mean, scale, shift_);
+        normalize_outer(out, in, extent, data_shape_[axis+1], mean, scale, shift);
       }
     } else {
       // anything else - just recursively peel off the outermost dimension
       ptrdiff_t data_ofs = 0, param_ofs = 0;
       ptrdiff_t data_stride = data_strides[axis];
       ptrdiff_t param_stride = param_strides[axis];
-      for (int i = 0; i < data_shape_[axis];
-           i++, data_ofs += data_stride, param_ofs += param_stride) {
-        NormalizeAxis(axis + 1, out + data_ofs, in + data_ofs, data_strides,
-                      mean + param_ofs, scale + param_ofs, param_strides);
+      for (int64_t i = 0; i < extent; i++, data_ofs += data_stride, param_ofs += param_stride) {
+        NormalizeAxis(axis + 1, data_shape_[axis + 1], out + data_ofs, in + data_ofs,
+                      data_strides, mean + param_ofs, scale + param_ofs, param_strides, shift);
       }
     }
   }
@@ -240,10 +275,6 @@ struct NormalizeCPU {
   inline int ndim() const noexcept { return data_shape_.size(); }
 
   TensorShape<> orig_shape_, orig_param_shape_, data_shape_, param_shape_;
-  const In *input_  = nullptr;;
-  Out *output_ = nullptr;
-  const Param *mean_, *scale_;
-  Param shift_ = 0;
 };
 
 }  // namespace kernels
@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -14,6 +14,7 @@
 
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <string>
 #include <tuple>
 #include "dali/kernels/normalize/normalize_cpu.h"
@@ -178,6 +179,19 @@ TEST_P(NormalizeNDTest, NormalizeNDTest) {
              << "\ndata shape      " << data_shape
              << "\nparameter shape " << param_shape;
     }
+
+    // normalize in uneven ranges of slices, as when splitting a sample between threads
+    std::fill(out_data.begin(), out_data.end(), 0);
+    int64_t num_slices = norm.NumSlices();
+    for (int64_t begin = 0, step = 1; begin < num_slices; begin += step, step++)
+      norm.Run(ctx, out, in, mean, invstddev, 0, begin, std::min(begin + step, num_slices));
+    Check(out, ref);
+    if (HasFailure()) {
+      FAIL() << "Test of ranges failed with dim = " << dim
+             << " reduction mask = " << mask_str
+             << "\ndata shape      " << data_shape
+             << "\nparameter shape " << param_shape;
+    }
   }
 }
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -79,6 +79,50 @@ __global__ void ReduceAllBatchedKernel(Out *out, const In *const *in, const int6
     out[blockIdx.x + blockIdx.y * gridDim.x] = ConvertSat<Out>(postprocess(val));
 }
 
+/**
+ * @brief Reduces small samples, one warp per sample.
+ *
+ * This kernel is used instead of ReduceAllBatchedKernel when there are many samples that are
+ * small enough to be reduced by a single warp - it saves the block-level reduction and
+ * doesn't occupy a 1024-thread block with a handful of elements.
+ *
+ * `blockDim = 32, warps_per_block`
+ * `gridDim = div_ceil(num_samples, warps_per_block)`
+ *
+ * @param out         the result - one value per sample
+ * @param in          pointers to sample data
+ * @param in_sizes    sizes of the samples
+ * @param num_samples number of samples
+ * @param reduce      the reduction functor
+ * @param pre         per-sample preprocessing to be applied to each value fetched from `in`
+ * @param post        per-sample postprocessing applied to the result
+ */
+template <typename Acc, typename Out, typename In,
+          typename Reduction = reductions::sum,
+          typename Preprocess = dali::identity,
+          typename Postprocess = dali::identity>
+__global__ void ReduceAllSmallSamplesKernel(Out *out, const In *const *in,
+                                            const int64_t *in_sizes, int num_samples,
+                                            Reduction reduce = {},
+                                            const Preprocess *pre = nullptr,
+                                            const Postprocess *post = nullptr) {
+  const int sample = blockIdx.x * blockDim.y + threadIdx.y;
+  if (sample >= num_samples)
+    return;  // the whole warp exits - it doesn't break the warp shuffles
+  Preprocess preprocess = pre ? pre[sample] : Preprocess();
+  const int64_t n = in_sizes[sample];
+  const In *sample_in = in[sample];
+  Acc val = reduce.template neutral<Acc>();
+  for (int64_t idx = threadIdx.x; idx < n; idx += 32) {
+    reduce(val, preprocess(sample_in[idx]));
+  }
+  WarpReduce(val, reduce);
+  if (threadIdx.x == 0) {
+    Postprocess postprocess = post ? post[sample] : Postprocess();
+    out[sample] = ConvertSat<Out>(postprocess(val));
+  }
+}
+
 /**
  * @brief Reduce evenly-spaced, contiguous blocks in `in` and store blockwise results in `out`.
  *
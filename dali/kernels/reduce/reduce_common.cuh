@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,6 +16,7 @@
 #define DALI_KERNELS_REDUCE_REDUCE_COMMON_CUH_
 
 #include <cuda_runtime.h>
+#include "dali/core/geom/vec.h"
 #include "dali/core/util.h"
 
 namespace dali {
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -885,6 +885,11 @@ class ReduceImplGPU {
     CalculateOffsets();
   }
 
+  /// The largest sample which is reduced by a single warp in a per-sample reduction
+  static constexpr int64_t kMaxWarpPerSampleSize = 2048;
+  /// The number of small samples reduced by one block
+  static constexpr int kSmallSampleWarpsPerBlock = 8;
+
   /**
    * @brief Defines excution environment of the reduction.
    */
@@ -1046,14 +1051,13 @@ class ReduceImplGPU {
     StageOut *out = is_last ? reinterpret_cast<StageOut *>(ctx.output.data[0])
                             : wa.OutputBuffer<StageOut>(stage.output_elements());
     int64_t *sizes = wa.ParamBuffer<int64_t>(stage.num_samples());
+    int64_t max_size = 0;
     for (int i = 0; i < stage.num_samples(); i++) {
       sizes[i] = stage.shape[i].reduced_in;
+      max_size = std::max(max_size, sizes[i]);
       assert(stage.shape[i].reduced_out == stage.shape[0].reduced_out);
     }
 
-    dim3 block(32, 32);
-    dim3 grid(stage.shape[0].reduced_out, stage.num_samples());
-
     auto *pre = GetPreprocessors<is_first>(wa);
     auto *post = GetPostprocessors<is_last>(wa);
 
@@ -1064,8 +1068,18 @@ class ReduceImplGPU {
     auto *gpu_pre             = wa.GetDeviceParam(pre);
     auto *gpu_post            = wa.GetDeviceParam(post);
 
-    ReduceAllBatchedKernel<Acc><<<grid, block, 0, ctx.stream>>>(
-      out, gpu_in, gpu_sizes, This().GetReduction(), gpu_pre, gpu_post);
+    if (stage.shape[0].reduced_out == 1 && max_size <= kMaxWarpPerSampleSize) {
+      // Small samples - a warp per sample is enough
+      dim3 block(32, kSmallSampleWarpsPerBlock);
+      dim3 grid(div_ceil(stage.num_samples(), kSmallSampleWarpsPerBlock));
+      ReduceAllSmallSamplesKernel<Acc><<<grid, block, 0, ctx.stream>>>(
+        out, gpu_in, gpu_sizes, stage.num_samples(), This().GetReduction(), gpu_pre, gpu_post);
+    } else {
+      dim3 block(32, 32);
+      dim3 grid(stage.shape[0].reduced_out, stage.num_samples());
+      ReduceAllBatchedKernel<Acc><<<grid, block, 0, ctx.stream>>>(
+        out, gpu_in, gpu_sizes, This().GetReduction(), gpu_pre, gpu_post);
+    }
 
     CUDA_CALL(cudaGetLastError());
   }
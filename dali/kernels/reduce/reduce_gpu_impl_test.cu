@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -344,6 +344,27 @@ TEST(SumImplGPU, WholeSamples) {
   test.Check();
 }
 
+TEST(SumImplGPU, ManySmallSamples) {
+  std::mt19937_64 rng(1234);
+  std::uniform_int_distribution<int> extent(0, 40);
+  const int N = 257;
+  TensorListShape<> in_shape(N, 2);
+  for (int i = 0; i < N; i++)
+    in_shape.set_tensor_shape(i, { extent(rng), extent(rng) });
+  in_shape.set_tensor_shape(0, { 32, 64 });   // the largest sample reduced by a single warp
+  TensorListShape<> ref_out_shape = uniform_list_shape(N, { 1, 1 });
+  int axes[] = { 0, 1 };
+  testing::ReductionKernelTest<SumImplGPU<int64_t, uint8_t>, int64_t, uint8_t> test;
+  test.Setup(in_shape, ref_out_shape, make_span(axes), true, false);
+  ASSERT_EQ(test.kernel.GetNumStages(), 1);
+  EXPECT_EQ(test.kernel.GetStage(0).kind, ReductionKind::Sample);
+  test.FillData(0, 255);
+  test.Run();
+
+  RefReduce(test.ref.cpu(), test.in.cpu(), make_span(axes), true, false, reductions::sum());
+
+  test.Check();
+}
 
 TEST(SumImplGPU, All) {
   TensorListShape<> in_shape = {{
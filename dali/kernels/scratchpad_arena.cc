@@ -0,0 +1,227 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/kernels/scratchpad_arena.h"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include "dali/core/cuda_error.h"
+#include "dali/core/small_vector.h"
+#include "dali/core/static_switch.h"
+#include "dali/core/util.h"
+
+namespace dali {
+namespace kernels {
+
+namespace {
+
+inline bool IsHostAccessible(mm::memory_kind_id kind) {
+  return kind == mm::memory_kind_id::pinned || kind == mm::memory_kind_id::managed;
+}
+
+}  // namespace
+
+ArenaScratchpad::~ArenaScratchpad() {
+  arena_->Release(*this);
+}
+
+void *ArenaScratchpad::Alloc(mm::memory_kind_id kind_id, size_t bytes, size_t alignment) {
+  if (bytes == 0)
+    return nullptr;
+  int k = static_cast<int>(kind_id);
+  assert(k >= 0 && k < ScratchpadArena::kNumKinds);
+
+  if (IsHostAccessible(kind_id)) {
+    // The buffer may be still read by the previous user - don't block, allocate dynamically
+    if (!arena_->HostBuffersReady())
+      return AllocOverflow(kind_id, bytes, alignment);
+  } else if (kind_id == mm::memory_kind_id::device) {
+    arena_->WaitForRelease(order_);
+  }
+
+  auto &buf = arena_->buffers_[k];
+  if (buf.ptr) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(buf.ptr);
+    size_t offset = align_up(base + used_[k], alignment) - base;
+    if (offset + bytes <= buf.capacity) {
+      used_[k] = offset + bytes;
+      return reinterpret_cast<void *>(base + offset);
+    }
+  }
+  // The buffer is exhausted - the arena grows to the high-water mark with the next scratchpad
+  overflow_[k] += bytes + alignment;
+  return AllocOverflow(kind_id, bytes, alignment);
+}
+
+void *ArenaScratchpad::AllocOverflow(mm::memory_kind_id kind_id, size_t bytes, size_t alignment) {
+  if (!overflow_scratchpad_)
+    overflow_scratchpad_.emplace(scratch_sizes_t{}, order_);
+  return overflow_scratchpad_->Alloc(kind_id, bytes, alignment);
+}
+
+ScratchpadArena::~ScratchpadArena() {
+  assert(!in_use_);
+  try {
+    Free();
+  } catch (const std::exception &e) {
+    // the arenas are usually destroyed at thread exit - we can't throw from there
+    std::cerr << "Fatal error: cannot free the scratchpad arena: " << e.what() << std::endl;
+    std::terminate();
+  }
+}
+
+ScratchpadArena &ScratchpadArena::ThreadLocal(int device_id) {
+  thread_local SmallVector<std::pair<int, std::unique_ptr<ScratchpadArena>>, 2> arenas;
+  for (auto &a : arenas) {
+    if (a.first == device_id)
+      return *a.second;
+  }
+  arenas.emplace_back(device_id, std::make_unique<ScratchpadArena>());
+  return *arenas.back().second;
+}
+
+void ScratchpadArena::Acquire(AccessOrder order) {
+  waited_ = false;
+  host_buffers_ready_.reset();
+  Reserve(high_water_mark_, order);
+  in_use_ = true;
+}
+
+void ScratchpadArena::Release(const ArenaScratchpad &scratchpad) {
+  assert(in_use_);
+  bool used_by_device = false;
+  for (int k = 0; k < kNumKinds; k++) {
+    size_t requested = scratchpad.used_[k] + scratchpad.overflow_[k];
+    high_water_mark_[k] = std::max(high_water_mark_[k], requested);
+    if (k != static_cast<int>(mm::memory_kind_id::host) && scratchpad.used_[k] > 0)
+      used_by_device = true;
+  }
+  AccessOrder order = scratchpad.order_;
+  if (used_by_device && order.is_device()) {
+    // The new event must cover the work of the previous users, too
+    WaitForRelease(order);
+    if (!release_event_ || event_device_ != order.device_id()) {
+      release_event_ = CUDAEvent::Create(order.device_id());
+      event_device_ = order.device_id();
+    }
+    CUDA_CALL(cudaEventRecord(release_event_, order.stream()));
+    event_pending_ = true;
+  }
+  in_use_ = false;
+}
+
+void ScratchpadArena::WaitForRelease(AccessOrder order) {
+  if (!event_pending_ || waited_)
+    return;
+  order.wait(release_event_);
+  if (order.is_device()) {
+    waited_ = true;
+  } else {
+    event_pending_ = false;  // synchronized with the host
+  }
+}
+
+bool ScratchpadArena::HostBuffersReady() {
+  if (!host_buffers_ready_.has_value()) {
+    bool ready = true;
+    if (event_pending_) {
+      auto status = cudaEventQuery(release_event_);
+      if (status == cudaErrorNotReady) {
+        (void)cudaGetLastError();  // clear the "error"
+        ready = false;
+      } else {
+        CUDA_CALL(status);
+      }
+    }
+    host_buffers_ready_ = ready;
+  }
+  return *host_buffers_ready_;
+}
+
+void ScratchpadArena::Reserve(const scratch_sizes_t &sizes, AccessOrder order) {
+  assert(!in_use_);
+  for (int k = 0; k < kNumKinds; k++) {
+    auto &buf = buffers_[k];
+    if (sizes[k] <= buf.capacity)
+      continue;
+    auto kind = static_cast<mm::memory_kind_id>(k);
+    // The old buffer may be still in use - it's freed after the previous users' work
+    if (kind != mm::memory_kind_id::host)
+      WaitForRelease(order);
+    size_t new_capacity = align_up(sizes[k], kAlignment);
+    TYPE_SWITCH(kind, mm::kind2id, Kind,
+      (mm::memory_kind::host,
+       mm::memory_kind::pinned,
+       mm::memory_kind::device,
+       mm::memory_kind::managed), (
+        void *old_ptr = std::exchange(buf.ptr, nullptr);
+        if (old_ptr)
+          Deallocate<Kind>(old_ptr, std::exchange(buf.capacity, 0), order);
+        buf.ptr = Allocate<Kind>(new_capacity, order);
+        buf.capacity = new_capacity;
+      ), (assert(!"Incorrect memory kind id");));  // NOLINT
+  }
+}
+
+void ScratchpadArena::Free() {
+  assert(!in_use_);
+  auto order = AccessOrder::host();
+  for (int k = 0; k < kNumKinds; k++) {
+    auto &buf = buffers_[k];
+    if (!buf.ptr)
+      continue;
+    auto kind = static_cast<mm::memory_kind_id>(k);
+    if (kind != mm::memory_kind_id::host)
+      WaitForRelease(order);
+    TYPE_SWITCH(kind, mm::kind2id, Kind,
+      (mm::memory_kind::host,
+       mm::memory_kind::pinned,
+       mm::memory_kind::device,
+       mm::memory_kind::managed), (
+        Deallocate<Kind>(buf.ptr, buf.capacity, order);
+      ), (assert(!"Incorrect memory kind id");));  // NOLINT
+    buf = {};
+  }
+}
+
+template <typename Kind>
+auto &ScratchpadArena::Resource() {
+  auto &rsrc = std::get<std::shared_ptr<mm::default_memory_resource_t<Kind>>>(resources_);
+  if (!rsrc)
+    rsrc = mm::ShareDefaultResource<Kind>();
+  return *rsrc;
+}
+
+template <typename Kind>
+void *ScratchpadArena::Allocate(size_t bytes, AccessOrder order) {
+  auto &rsrc = Resource<Kind>();
+  if constexpr (std::is_same_v<Kind, mm::memory_kind::device>) {
+    if (order.is_device())
+      return rsrc.allocate_async(bytes, kAlignment, order.stream());
+  }
+  return rsrc.allocate(bytes, kAlignment);
+}
+
+template <typename Kind>
+void ScratchpadArena::Deallocate(void *ptr, size_t bytes, AccessOrder order) {
+  auto &rsrc = Resource<Kind>();
+  if constexpr (!std::is_same_v<Kind, mm::memory_kind::host>) {
+    if (order.is_device())
+      return rsrc.deallocate_async(ptr, bytes, kAlignment, order.stream());
+  }
+  rsrc.deallocate(ptr, bytes, kAlignment);
+}
+
+}  // namespace kernels
+}  // namespace dali
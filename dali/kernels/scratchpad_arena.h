@@ -0,0 +1,194 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_SCRATCHPAD_ARENA_H_
+#define DALI_KERNELS_SCRATCHPAD_ARENA_H_
+
+#include <array>
+#include <cassert>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include "dali/core/access_order.h"
+#include "dali/core/api_helper.h"
+#include "dali/core/cuda_event.h"
+#include "dali/core/mm/default_resources.h"
+#include "dali/core/mm/memory_kind.h"
+#include "dali/kernels/context.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/kernel_req.h"
+
+namespace dali {
+namespace kernels {
+
+class ScratchpadArena;
+
+/**
+ * @brief A scratchpad, which allocates from the buffers of a ScratchpadArena
+ *
+ * The memory is returned to the arena when the scratchpad is destroyed. The requests which
+ * don't fit in the arena's buffers are served by a DynamicScratchpad and the arena grows to
+ * accommodate them the next time a scratchpad is obtained.
+ */
+class DLL_PUBLIC ArenaScratchpad : public Scratchpad {
+ public:
+  ~ArenaScratchpad();
+
+  ArenaScratchpad(const ArenaScratchpad &) = delete;
+  ArenaScratchpad &operator=(const ArenaScratchpad &) = delete;
+
+  void *Alloc(mm::memory_kind_id kind_id, size_t bytes, size_t alignment) override;
+
+ private:
+  friend class ScratchpadArena;
+  ArenaScratchpad(ScratchpadArena *arena, AccessOrder order) : arena_(arena), order_(order) {}
+
+  void *AllocOverflow(mm::memory_kind_id kind_id, size_t bytes, size_t alignment);
+
+  ScratchpadArena *arena_;
+  AccessOrder order_;
+  scratch_sizes_t used_{}, overflow_{};
+  std::optional<DynamicScratchpad> overflow_scratchpad_;
+};
+
+/**
+ * @brief Persistent scratch memory, which is kept between the iterations
+ *
+ * The arena keeps one buffer for each memory kind. A scratchpad obtained with `GetScratchpad`
+ * allocates from these buffers by bumping a pointer, so returning the memory (and reusing it
+ * in the next iteration) takes constant time and there are no calls to the upstream resources
+ * in the steady state. The buffers grow to the high-water mark of the memory requested
+ * from the scratchpads; they can be also grown ahead of time with `Reserve` (e.g. with the
+ * scratch sizes declared by the kernels in Setup).
+ *
+ * Only one scratchpad can be obtained from an arena at a time.
+ *
+ * The scratchpads can use different access orders. The memory is returned to the arena in
+ * the order of the scratchpad which used it - the next scratchpad waits for it in its own
+ * order. The host-accessible (pinned and managed) buffers are reused only if the work issued
+ * by the previous user has already completed; otherwise, the new scratchpad allocates such
+ * memory dynamically, instead of blocking the host.
+ *
+ * @remarks The arena is not thread safe - see `ThreadLocal` for per-thread arenas.
+ */
+class DLL_PUBLIC ScratchpadArena {
+ public:
+  static constexpr int kNumKinds = static_cast<int>(mm::memory_kind_id::count);
+
+  ScratchpadArena() = default;
+  ~ScratchpadArena();
+
+  ScratchpadArena(const ScratchpadArena &) = delete;
+  ScratchpadArena &operator=(const ScratchpadArena &) = delete;
+
+  /**
+   * @brief Returns the arena of the calling thread for the given device
+   *
+   * The arena is destroyed when the thread exits.
+   */
+  static ScratchpadArena &ThreadLocal(int device_id);
+
+  /**
+   * @brief Returns a scratchpad which allocates from the arena in the given order
+   *
+   * @remarks The arena must not be in use (see InUse).
+   */
+  ArenaScratchpad GetScratchpad(AccessOrder order) {
+    assert(!in_use_);
+    Acquire(order);
+    return ArenaScratchpad(this, order);
+  }
+
+  /**
+   * @brief Ensures that the buffers have at least the given sizes, in bytes.
+   *
+   * @remarks The arena must not be in use (see InUse).
+   */
+  void Reserve(const scratch_sizes_t &sizes, AccessOrder order = AccessOrder::host());
+
+  /**
+   * @brief Releases the buffers.
+   *
+   * @remarks The arena must not be in use (see InUse).
+   */
+  void Free();
+
+  /** Whether there's a live scratchpad obtained from this arena */
+  bool InUse() const noexcept { return in_use_; }
+
+  /** The sizes of the buffers */
+  scratch_sizes_t Capacities() const noexcept {
+    scratch_sizes_t ret;
+    for (int k = 0; k < kNumKinds; k++)
+      ret[k] = buffers_[k].capacity;
+    return ret;
+  }
+
+  /** The maximum amount of memory requested from a single scratchpad */
+  const scratch_sizes_t &HighWaterMark() const noexcept { return high_water_mark_; }
+
+ private:
+  friend class ArenaScratchpad;
+
+  /** The buffers are aligned to (and their sizes are multiples of) this value */
+  static constexpr size_t kAlignment = 256;
+
+  struct Buffer {
+    void *ptr = nullptr;
+    size_t capacity = 0;
+  };
+
+  void Acquire(AccessOrder order);
+  void Release(const ArenaScratchpad &scratchpad);
+
+  /** Makes `order` wait for the work of the previous users of the buffers */
+  void WaitForRelease(AccessOrder order);
+
+  /** Whether the host can write to the host-accessible buffers without synchronization */
+  bool HostBuffersReady();
+
+  template <typename Kind>
+  auto &Resource();
+
+  template <typename Kind>
+  void *Allocate(size_t bytes, AccessOrder order);
+
+  template <typename Kind>
+  void Deallocate(void *ptr, size_t bytes, AccessOrder order);
+
+  std::array<Buffer, kNumKinds> buffers_;
+  scratch_sizes_t high_water_mark_{};
+  bool in_use_ = false;
+
+  /** Recorded after the work which used the buffers; the next users wait for it */
+  CUDAEvent release_event_;
+  int event_device_ = -1;
+  bool event_pending_ = false;
+  /** Whether the current scratchpad's order already waits for the release event */
+  bool waited_ = false;
+  /** Whether the host-accessible buffers can be used by the current scratchpad */
+  std::optional<bool> host_buffers_ready_;
+
+  /** The upstream resources are kept alive until the buffers are freed */
+  std::tuple<std::shared_ptr<mm::default_memory_resource_t<mm::memory_kind::host>>,
+             std::shared_ptr<mm::default_memory_resource_t<mm::memory_kind::pinned>>,
+             std::shared_ptr<mm::default_memory_resource_t<mm::memory_kind::device>>,
+             std::shared_ptr<mm::default_memory_resource_t<mm::memory_kind::managed>>>
+      resources_;
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_SCRATCHPAD_ARENA_H_
@@ -0,0 +1,142 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/kernels/scratchpad_arena.h"  // NOLINT
+#include <gtest/gtest.h>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/cuda_stream_pool.h"
+#include "dali/core/mm/memory.h"
+
+namespace dali {
+namespace kernels {
+namespace test {
+
+TEST(ScratchpadArena, HostReuse) {
+  ScratchpadArena arena;
+  const int N = 1000;
+  char *first = nullptr;
+  for (int iter = 0; iter < 5; iter++) {
+    auto scratch = arena.GetScratchpad(AccessOrder::host());
+    EXPECT_TRUE(arena.InUse());
+    char *p = scratch.Allocate<mm::memory_kind::host, char>(N);
+    memset(p, iter, N);
+    // the first allocation is served by the overflow scratchpad - the arena was empty
+    if (iter == 1) {
+      first = p;
+    } else if (iter > 1) {
+      EXPECT_EQ(p, first) << "The memory should be reused in the steady state";
+    }
+  }
+  EXPECT_FALSE(arena.InUse());
+  EXPECT_GE(arena.Capacities()[static_cast<int>(mm::memory_kind_id::host)], N);
+  EXPECT_GE(arena.HighWaterMark()[static_cast<int>(mm::memory_kind_id::host)], N);
+}
+
+TEST(ScratchpadArena, GrowToHighWaterMark) {
+  ScratchpadArena arena;
+  const int host = static_cast<int>(mm::memory_kind_id::host);
+  scratch_sizes_t sizes{};
+  sizes[host] = 1024;
+  arena.Reserve(sizes);
+  EXPECT_EQ(arena.Capacities()[host], 1024u);
+  char *base;
+  {
+    auto scratch = arena.GetScratchpad(AccessOrder::host());
+    base = scratch.Allocate<mm::memory_kind::host, char>(512);
+    char *next = scratch.Allocate<mm::memory_kind::host, char>(512);
+    EXPECT_EQ(next, base + 512);
+    // doesn't fit - must come from elsewhere
+    char *overflow = scratch.Allocate<mm::memory_kind::host, char>(4096);
+    EXPECT_TRUE(overflow + 4096 <= base || overflow >= base + 1024);
+    memset(overflow, 0, 4096);
+  }
+  EXPECT_EQ(arena.Capacities()[host], 1024u) << "The arena must not grow while in use";
+  {
+    auto scratch = arena.GetScratchpad(AccessOrder::host());
+    EXPECT_GE(arena.Capacities()[host], 1024u + 4096u);
+    char *p = scratch.Allocate<mm::memory_kind::host, char>(1024 + 4096);
+    memset(p, 0, 1024 + 4096);
+  }
+  auto hwm = arena.HighWaterMark()[host];
+  auto capacity = arena.Capacities()[host];
+  sizes[host] = capacity / 2;
+  arena.Reserve(sizes);
+  EXPECT_EQ(arena.Capacities()[host], capacity) << "Reserve must not shrink the buffers";
+  sizes[host] = capacity + 1;
+  arena.Reserve(sizes);
+  EXPECT_GT(arena.Capacities()[host], capacity);
+  EXPECT_EQ(arena.HighWaterMark()[host], hwm);
+  arena.Free();
+  EXPECT_EQ(arena.Capacities()[host], 0u);
+}
+
+TEST(ScratchpadArena, ThreadLocal) {
+  auto &arena = ScratchpadArena::ThreadLocal(-1);
+  EXPECT_EQ(&arena, &ScratchpadArena::ThreadLocal(-1));
+  ScratchpadArena *other = nullptr;
+  std::thread([&]() {
+    other = &ScratchpadArena::ThreadLocal(-1);
+  }).join();
+  EXPECT_NE(&arena, other);
+}
+
+/**
+ * @brief Checks that the device and pinned buffers are reused in stream order
+ *
+ * The pinned buffer must not be reused while the stream which used it is still running.
+ */
+TEST(ScratchpadArena, DeviceAndPinned) {
+  const int N = 64 << 10;  // 64 KiB
+  const int pinned = static_cast<int>(mm::memory_kind_id::pinned);
+  const int device = static_cast<int>(mm::memory_kind_id::device);
+
+  std::vector<char> in(N);
+  for (int i = 0; i < N; i++)
+    in[i] = i + 42;
+
+  ScratchpadArena arena;
+  scratch_sizes_t sizes{};
+  sizes[pinned] = N;
+  sizes[device] = N;
+  auto streams = std::vector<CUDAStreamLease>();
+  streams.push_back(CUDAStreamPool::instance().Get());
+  streams.push_back(CUDAStreamPool::instance().Get());
+  arena.Reserve(sizes, AccessOrder(streams[0]));
+  auto capacities = arena.Capacities();
+
+  for (int iter = 0; iter < 20; iter++) {
+    cudaStream_t stream = streams[iter % 2];
+    char *host_ptr, *dev_ptr;
+    {
+      auto scratch = arena.GetScratchpad(AccessOrder(stream));
+      host_ptr = scratch.Allocate<mm::memory_kind::pinned, char>(N);
+      dev_ptr = scratch.Allocate<mm::memory_kind::device, char>(N);
+      memcpy(host_ptr, in.data(), N);
+      CUDA_CALL(cudaMemcpyAsync(dev_ptr, host_ptr, N, cudaMemcpyHostToDevice, stream));
+      CUDA_CALL(cudaMemsetAsync(host_ptr, 0, N, stream));
+      CUDA_CALL(cudaMemcpyAsync(host_ptr, dev_ptr, N, cudaMemcpyDeviceToHost, stream));
+    }
+    CUDA_CALL(cudaStreamSynchronize(stream));
+    ASSERT_EQ(memcmp(in.data(), host_ptr, N), 0);
+  }
+  EXPECT_EQ(arena.Capacities(), capacities) << "The reserved sizes should be sufficient";
+  arena.Free();
+}
+
+}  // namespace test
+}  // namespace kernels
+}  // namespace dali
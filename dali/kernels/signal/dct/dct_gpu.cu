@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -49,19 +49,40 @@ __global__ void ApplyDct(const typename Dct1DGpu<OutputType, InputType>::SampleD
     cos_table[i] = cos_table_inp[i];
   }
   __syncthreads();
+  // The transform is a matrix product (cosine table x input columns): each thread computes
+  // kRowsPerThread coefficients of a column, so that every input value is loaded only once
+  // for all of them. The table rows are the same across a warp, so the reads are broadcast.
+  constexpr int kRowsPerThread = 4;
+  int input_length = sample.input_length;
   for (int z = block.start.z + threadIdx.z; z < block.end.z; z += blockDim.z) {
-    for (int y = block.start.y + threadIdx.y; y < block.end.y; y += blockDim.y) {
-      const OutputType *cos_row = cos_table + sample.input_length * (y - block.start.y);
-      float coeff = HasLifter ? lifter_coeffs[y] : 1.f;
+    for (int y0 = block.start.y + threadIdx.y * kRowsPerThread; y0 < block.end.y;
+         y0 += blockDim.y * kRowsPerThread) {
+      int nrows = cuda_min(kRowsPerThread, block.end.y - y0);
+      const OutputType *cos_rows[kRowsPerThread];
+      float coeffs[kRowsPerThread];
+      #pragma unroll
+      for (int r = 0; r < kRowsPerThread; r++) {
+        int y = y0 + cuda_min(r, nrows - 1);  // the excess rows are computed, but not stored
+        cos_rows[r] = cos_table + input_length * (y - block.start.y);
+        coeffs[r] = HasLifter ? lifter_coeffs[y] : 1.f;
+      }
       for (int x = block.start.x + threadIdx.x; x < block.end.x; x += blockDim.x) {
-        int output_idx = out_stride[0]*z + out_stride[1]*y + x;
         const InputType *input = sample.input + in_stride[0]*z + x;
-        OutputType out_val = 0;
-        for (int i = 0; i < sample.input_length; ++i) {
-          out_val = fma(*input, cos_row[i], out_val);
+        OutputType acc[kRowsPerThread] = {};
+        for (int i = 0; i < input_length; ++i) {
+          OutputType in_val = *input;
+          #pragma unroll
+          for (int r = 0; r < kRowsPerThread; r++)
+            acc[r] = fma(in_val, cos_rows[r][i], acc[r]);
           input += in_stride[1];
         }
-        sample.output[output_idx] = HasLifter ? out_val * coeff : out_val;
+        #pragma unroll
+        for (int r = 0; r < kRowsPerThread; r++) {
+          if (r < nrows) {
+            int output_idx = out_stride[0]*z + out_stride[1]*(y0 + r) + x;
+            sample.output[output_idx] = HasLifter ? acc[r] * coeffs[r] : acc[r];
+          }
+        }
       }
     }
   }
@@ -91,25 +112,32 @@ __global__ void ApplyDctInner(const typename Dct1DGpu<OutputType, InputType>::Sa
     in_frames[idx] = input[idx];
   }
   __syncthreads();
-  for (int f = 0; f < nframes; ++f) {
-    const auto *in_frame = in_frames + sample.input_length * f;
-    auto *out_frame = output + ndct * f;
-    for (int y = threadIdx.y; y < ndct; y += blockDim.y) {
-      float lifter_coeff = HasLifter ? lifter_coeffs[y] : 1.f;
-      const auto *cos_row = &cos_table[y * sample.input_length];
-      OutputType acc = 0;
-      for (int x = threadIdx.x; x < sample.input_length; x += blockDim.x) {
-        acc = fma(in_frame[x], cos_row[x], acc);
-      }
-      acc += __shfl_down_sync(0xffffffff, acc, 16);
-      acc += __shfl_down_sync(0xffffffff, acc, 8);
-      acc += __shfl_down_sync(0xffffffff, acc, 4);
-      acc += __shfl_down_sync(0xffffffff, acc, 2);
-      acc += __shfl_down_sync(0xffffffff, acc, 1);
-      if (threadIdx.x == 0) {
-        out_frame[y] = HasLifter ? acc * lifter_coeff : acc;
+  // All frames of the block are transformed at once, so that each element of the cosine table
+  // is loaded only once for all of them.
+  constexpr int kMaxFrames = BlockSetupInner::kFramesPerBlock;
+  assert(nframes <= kMaxFrames);
+  for (int y = threadIdx.y; y < ndct; y += blockDim.y) {
+    float lifter_coeff = HasLifter ? lifter_coeffs[y] : 1.f;
+    const auto *cos_row = &cos_table[y * sample.input_length];
+    OutputType acc[kMaxFrames] = {};
+    for (int x = threadIdx.x; x < sample.input_length; x += blockDim.x) {
+      OutputType cos_val = cos_row[x];
+      #pragma unroll
+      for (int f = 0; f < kMaxFrames; f++) {
+        if (f < nframes)
+          acc[f] = fma(in_frames[sample.input_length * f + x], cos_val, acc[f]);
       }
     }
+    #pragma unroll
+    for (int f = 0; f < kMaxFrames; f++) {
+      acc[f] += __shfl_down_sync(0xffffffff, acc[f], 16);
+      acc[f] += __shfl_down_sync(0xffffffff, acc[f], 8);
+      acc[f] += __shfl_down_sync(0xffffffff, acc[f], 4);
+      acc[f] += __shfl_down_sync(0xffffffff, acc[f], 2);
+      acc[f] += __shfl_down_sync(0xffffffff, acc[f], 1);
+      if (threadIdx.x == 0 && f < nframes)
+        output[ndct * f + y] = HasLifter ? acc[f] * lifter_coeff : acc[f];
+    }
   }
 }
 
@@ -240,12 +268,12 @@ void BlockSetupInner::Setup(const TensorListShape<3> &reduced_shape) {
   for (int s = 0; s < reduced_shape.num_samples(); ++s) {
     assert(reduced_shape[s][2] == 1);
     int64_t nframes = reduced_shape[s][0];
-    int64_t nblocks = div_ceil(nframes, frames_per_block_);
+    int64_t nblocks = div_ceil(nframes, kFramesPerBlock);
     blocks_.resize(blocks_.size() + nblocks);
-    for (int64_t f = 0; f < nframes; f += frames_per_block_, ++bid) {
+    for (int64_t f = 0; f < nframes; f += kFramesPerBlock, ++bid) {
       blocks_[bid].sample_idx = s;
       blocks_[bid].frame_start = f;
-      blocks_[bid].frame_count = std::min(frames_per_block_, nframes - f);
+      blocks_[bid].frame_count = std::min<int64_t>(kFramesPerBlock, nframes - f);
     }
   }
 }
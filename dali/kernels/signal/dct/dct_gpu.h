@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -35,6 +35,9 @@ namespace dct {
 
 class BlockSetupInner {
  public:
+  /** The maximum number of frames (outer indices) transformed by a block */
+  static constexpr int kFramesPerBlock = 8;
+
   struct BlockDesc {
     int64_t sample_idx;
     int64_t frame_start;
@@ -57,13 +60,12 @@ class BlockSetupInner {
 
   template <typename OutputType, typename InputType>
   size_t SharedMemSize(int64_t max_input_length, int64_t max_cos_table_size) {
-    return sizeof(InputType) * max_input_length * frames_per_block_
+    return sizeof(InputType) * max_input_length * kFramesPerBlock
            + sizeof(OutputType) * max_cos_table_size;
   }
 
  private:
   std::vector<BlockDesc> blocks_{};
-  const int64_t frames_per_block_ = 8;
 };
 
 /**
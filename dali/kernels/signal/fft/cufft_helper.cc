@@ -1,4 +1,4 @@
-// Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "dali/kernels/signal/fft/cufft_helper.h"
+#include "dali/core/device_guard.h"
 #include "dali/core/version_util.h"
 
 namespace dali {
@@ -27,4 +28,96 @@ DLL_PUBLIC int cufftGetVersion() {
   return MakeVersionNumber(major, minor, patch);
 }
 
+CUFFTPlanCache::~CUFFTPlanCache() {
+  for (auto &plan : plans_)
+    DestroyPlan(plan);
+}
+
+CUFFTPlan CUFFTPlanCache::CreatePlan(const CUFFTPlan::Key &key) {
+  CUFFTPlan plan;
+  plan.key = key;
+  cufftHandle handle;
+  CUDA_CALL(cufftCreate(&handle));
+  plan.handle.reset(handle);
+  CUDA_CALL(cufftSetAutoAllocation(handle, false));
+  int n[1] = { key.size };
+  CUDA_CALL(cufftMakePlanMany(
+      handle, 1, n,
+      0, 0, 0, 0, 0, 0,
+      key.type, key.batch, &plan.work_size));
+  return plan;
+}
+
+void CUFFTPlanCache::DestroyPlan(CUFFTPlan &plan) noexcept {
+  if (!plan.handle)
+    return;
+  // the cache may outlive the users of the plans - don't throw from the destructor
+  DeviceGuard dg(plan.key.device_id);
+  CUDA_DTOR_CALL(cufftDestroy(plan.handle.release()));
+}
+
+CUFFTPlan CUFFTPlanCache::Get(int size, int batch, cufftType type) {
+  CUFFTPlan::Key key;
+  CUDA_CALL(cudaGetDevice(&key.device_id));
+  key.size = size;
+  key.batch = batch;
+  key.type = type;
+  {
+    std::lock_guard<std::mutex> g(mtx_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      CUFFTPlan plan = std::move(*it->second);
+      plans_.erase(it->second);
+      index_.erase(it);
+      return plan;
+    }
+  }
+  return CreatePlan(key);
+}
+
+void CUFFTPlanCache::Put(CUFFTPlan &&plan) {
+  if (!plan)
+    return;
+  std::lock_guard<std::mutex> g(mtx_);
+  plans_.push_front(std::move(plan));
+  index_.emplace(plans_.front().key, plans_.begin());
+  Evict(capacity_);
+}
+
+void CUFFTPlanCache::Evict(int max_size) {
+  while (static_cast<int>(plans_.size()) > max_size) {
+    auto last = std::prev(plans_.end());
+    auto range = index_.equal_range(last->key);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == last) {
+        index_.erase(it);
+        break;
+      }
+    }
+    DestroyPlan(*last);
+    plans_.erase(last);
+  }
+}
+
+void CUFFTPlanCache::Purge() {
+  std::lock_guard<std::mutex> g(mtx_);
+  Evict(0);
+}
+
+void CUFFTPlanCache::SetCapacity(int capacity) {
+  std::lock_guard<std::mutex> g(mtx_);
+  capacity_ = capacity;
+  Evict(capacity_);
+}
+
+int CUFFTPlanCache::size() const {
+  std::lock_guard<std::mutex> g(mtx_);
+  return plans_.size();
+}
+
+CUFFTPlanCache &CUFFTPlanCache::instance() {
+  static CUFFTPlanCache instance;
+  return instance;
+}
+
 }  // namespace dali
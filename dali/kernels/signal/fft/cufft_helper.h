@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,8 +16,13 @@
 #define DALI_KERNELS_SIGNAL_FFT_CUFFT_HELPER_H_
 
 #include <cufft.h>
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
 #include <utility>
 #include <string>
+#include "dali/core/api_helper.h"
 #include "dali/core/cuda_error.h"
 #include "dali/core/unique_handle.h"
 #include "dali/core/format.h"
@@ -118,6 +123,98 @@ struct CUFFTHandle : public UniqueHandle<cufftHandle, CUFFTHandle> {
 // Obtain cuFFT library version or -1 if it is not available
 int cufftGetVersion();
 
+/**
+ * @brief A batched 1D cuFFT plan without an automatically allocated work area
+ *
+ * The work area (of `work_size` bytes) must be set with `cufftSetWorkArea` before execution;
+ * typically, it's allocated from the scratchpad.
+ */
+struct CUFFTPlan {
+  struct Key {
+    int device_id = -1;
+    int size = 0;
+    int batch = 0;
+    cufftType type = CUFFT_R2C;
+
+    bool operator<(const Key &other) const {
+      return std::tie(device_id, size, batch, type) <
+             std::tie(other.device_id, other.size, other.batch, other.type);
+    }
+  };
+
+  Key key;
+  CUFFTHandle handle;
+  size_t work_size = 0;
+
+  explicit operator bool() const noexcept { return static_cast<bool>(handle); }
+};
+
+/**
+ * @brief A process-wide cache of cuFFT plans
+ *
+ * Creating a cuFFT plan is expensive. The plans which are no longer used (e.g. when the
+ * operator's arguments or the number of windows change, or when the operator is destroyed) are
+ * placed in the cache and can be taken by any other user who needs a plan with the same key.
+ *
+ * A plan is owned by one user at a time - cuFFT plans carry the stream and the work area,
+ * so they cannot be used concurrently.
+ * When the number of cached plans exceeds the capacity, the least recently returned ones are
+ * destroyed.
+ */
+class DLL_PUBLIC CUFFTPlanCache {
+ public:
+  static constexpr int kDefaultCapacity = 64;
+
+  explicit CUFFTPlanCache(int capacity = kDefaultCapacity) : capacity_(capacity) {}
+  ~CUFFTPlanCache();
+
+  /**
+   * @brief Gets a plan for a batch of `batch` 1D transforms of given `size` and `type`
+   *        on the current device.
+   *
+   * If there's a matching plan in the cache, it's taken from it, otherwise a new plan is created.
+   */
+  CUFFTPlan Get(int size, int batch, cufftType type);
+
+  /**
+   * @brief Places the plan in the cache. The caller relinquishes ownership of the plan.
+   */
+  void Put(CUFFTPlan &&plan);
+
+  /**
+   * @brief Destroys all the cached plans.
+   */
+  void Purge();
+
+  /**
+   * @brief Sets the maximum number of cached plans; the excess plans are destroyed.
+   */
+  void SetCapacity(int capacity);
+
+  int capacity() const { return capacity_; }
+
+  /**
+   * @brief The number of plans currently in the cache
+   */
+  int size() const;
+
+  /**
+   * @brief Returns a reference to the singleton instance.
+   */
+  static CUFFTPlanCache &instance();
+
+ private:
+  static CUFFTPlan CreatePlan(const CUFFTPlan::Key &key);
+  static void DestroyPlan(CUFFTPlan &plan) noexcept;
+  void Evict(int max_size);
+
+  using LRUList = std::list<CUFFTPlan>;  // most recently returned first
+  LRUList plans_;
+  std::multimap<CUFFTPlan::Key, LRUList::iterator> index_;
+  int capacity_ = kDefaultCapacity;
+  mutable std::mutex mtx_;
+};
+
 }  // namespace dali
 
 #endif  // DALI_KERNELS_SIGNAL_FFT_CUFFT_HELPER_H_
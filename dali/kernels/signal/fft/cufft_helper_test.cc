@@ -0,0 +1,70 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <utility>
+#include "dali/kernels/signal/fft/cufft_helper.h"
+
+namespace dali {
+
+TEST(CUFFTPlanCache, Reuse) {
+  CUFFTPlanCache cache;
+  CUFFTPlan p1 = cache.Get(256, 8, CUFFT_R2C);
+  ASSERT_TRUE(p1);
+  EXPECT_EQ(p1.key.size, 256);
+  EXPECT_EQ(p1.key.batch, 8);
+  EXPECT_EQ(p1.key.type, CUFFT_R2C);
+  EXPECT_GT(p1.work_size, 0u);
+  cufftHandle h1 = p1.handle;
+  size_t ws1 = p1.work_size;
+  cache.Put(std::move(p1));
+  EXPECT_EQ(cache.size(), 1);
+
+  CUFFTPlan p2 = cache.Get(256, 4, CUFFT_R2C);  // different batch - a new plan
+  EXPECT_NE(static_cast<cufftHandle>(p2.handle), h1);
+  EXPECT_EQ(cache.size(), 1);
+
+  CUFFTPlan p3 = cache.Get(256, 8, CUFFT_R2C);  // same key - the cached plan
+  EXPECT_EQ(static_cast<cufftHandle>(p3.handle), h1);
+  EXPECT_EQ(p3.work_size, ws1);
+  EXPECT_EQ(cache.size(), 0);
+
+  cache.Put(std::move(p2));
+  cache.Put(std::move(p3));
+  EXPECT_EQ(cache.size(), 2);
+  cache.Purge();
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(CUFFTPlanCache, Eviction) {
+  CUFFTPlanCache cache(2);
+  CUFFTPlan p1 = cache.Get(64, 1, CUFFT_R2C);
+  CUFFTPlan p2 = cache.Get(64, 2, CUFFT_R2C);
+  CUFFTPlan p3 = cache.Get(64, 4, CUFFT_R2C);
+  cufftHandle h2 = p2.handle;
+  cache.Put(std::move(p1));
+  cache.Put(std::move(p2));
+  cache.Put(std::move(p3));  // evicts p1 - the least recently returned
+  EXPECT_EQ(cache.size(), 2);
+
+  CUFFTPlan p = cache.Get(64, 2, CUFFT_R2C);
+  EXPECT_EQ(static_cast<cufftHandle>(p.handle), h2);
+  cache.Put(std::move(p));
+  cache.SetCapacity(1);  // p3 is now the least recently returned
+  EXPECT_EQ(cache.size(), 1);
+  p = cache.Get(64, 4, CUFFT_R2C);  // p3 was evicted - a new plan, p2 stays in the cache
+  EXPECT_EQ(cache.size(), 1);
+}
+
+}  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -21,8 +21,19 @@ namespace kernels {
 namespace signal {
 namespace fft {
 
-void StftImplGPU::Reset() {
+StftImplGPU::~StftImplGPU() {
+  ReleasePlans();
+}
+
+void StftImplGPU::ReleasePlans() {
+  auto &cache = CUFFTPlanCache::instance();
+  for (auto &kv : plans_)
+    cache.Put(std::move(kv.second));
   plans_.clear();
+}
+
+void StftImplGPU::Reset() {
+  ReleasePlans();
   post_complex_.reset();
   post_real_.reset();
 }
@@ -121,20 +132,10 @@ void StftImplGPU::CreatePlans(int64_t nwindows) {
   max_windows_ = max_windows;
   min_windows_ = std::min(max_windows_, next_pow2(kMinSize / transform_size()));
 
-  int n[1] = { transform_size() };
   for (int w = max_windows_; w >= min_windows_; w >>= 1) {
     auto &plan = plans_[w];
-    if (!plan.handle) {
-      cufftHandle handle;
-      CUDA_CALL(cufftCreate(&handle));
-      plan.handle.reset(handle);
-      CUDA_CALL(cufftSetAutoAllocation(handle, false));
-      plan.work_size = 0;
-      CUDA_CALL(cufftMakePlanMany(
-          handle, 1, n,
-          0, 0, 0, 0, 0, 0,
-          CUFFT_R2C, w, &plan.work_size));
-    }
+    if (!plan)
+      plan = CUFFTPlanCache::instance().Get(transform_size(), w, CUFFT_R2C);
   }
 
   CreateStreams(std::min<int>(plans_.size(), kMaxStreams + 0 /* clang bug */));
@@ -277,7 +278,7 @@ void StftImplGPU::RunTransform(ExecutionContext &ctx) {
     int64_t batch = it->first;  // widen for multiplication
 
     max_stream = std::max(max_stream, stream_idx);
-    PlanInfo &pi = it->second;
+    CUFFTPlan &pi = it->second;
     if (first_round)
       CUDA_CALL(cudaStreamWaitEvent(streams_[stream_idx].stream, main_stream_ready_, 0));
     CUDA_CALL(cufftSetStream(pi.handle, streams_[stream_idx].stream));
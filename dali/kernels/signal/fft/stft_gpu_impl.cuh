@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -39,6 +39,7 @@ class StftImplGPU {
   StftImplGPU() = default;
   StftImplGPU(StftImplGPU &&) = delete;
   StftImplGPU(const StftImplGPU &) = delete;
+  ~StftImplGPU();
 
 
   KernelRequirements Setup(KernelContext &ctx, span<const int64_t> lengths, const StftArgs &args);
@@ -61,6 +62,7 @@ class StftImplGPU {
 
  private:
   void Reset();
+  void ReleasePlans();
 
   // setup functions
 
@@ -108,11 +110,8 @@ class StftImplGPU {
     return align_up(total_windows_, min_windows_);
   }
 
-  struct PlanInfo {
-    CUFFTHandle handle;
-    size_t work_size = 0;
-  };
-  std::map<int, PlanInfo> plans_;
+  /// Plans for batches of (power of 2) windows; borrowed from the CUFFTPlanCache
+  std::map<int, CUFFTPlan> plans_;
   struct Stream {
     CUDAStream stream;
     CUDAEvent event;
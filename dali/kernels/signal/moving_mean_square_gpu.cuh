@@ -0,0 +1,236 @@
+// Copyright (c) 2022-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_SIGNAL_MOVING_MEAN_SQUARE_GPU_CUH_
+#define DALI_KERNELS_SIGNAL_MOVING_MEAN_SQUARE_GPU_CUH_
+
+#include <cuda_runtime.h>
+#include <stdexcept>
+#include "dali/core/cuda_rt_utils.h"
+#include "dali/core/force_inline.h"
+#include "dali/core/host_dev.h"
+#include "dali/core/util.h"
+#include "dali/kernels/signal/moving_mean_square.h"
+
+namespace dali {
+namespace kernels {
+namespace signal {
+
+/**
+ * @brief Shared memory access pattern to avoid bank conflicts.
+ * @remarks See Example 39-4 from
+ *  https://developer.nvidia.com/gpugems/gpugems3/part-vi-gpu-computing/chapter-39-parallel-prefix-sum-scan-cuda
+ */
+struct conflict_free_pos {
+  static constexpr int kSharedMemBanks = 32;
+  static constexpr int kLogMemBanks = 5;
+
+  DALI_HOST_DEV DALI_FORCEINLINE int operator()(int pos) const noexcept {
+    return pos + (pos >> kLogMemBanks);
+  }
+};
+
+struct square {
+  template <typename T>
+  DALI_HOST_DEV DALI_FORCEINLINE T operator()(T x) const noexcept {
+    return x * x;
+  }
+};
+
+struct divide {
+  divide() = default;
+
+  constexpr DALI_HOST_DEV explicit divide(float divisor) : factor(1.0f / divisor) {}
+
+  DALI_HOST_DEV DALI_FORCEINLINE float operator()(float x) const noexcept {
+    return x * factor;
+  }
+
+  float factor;  // not-initialized in purpose so that it stays trivially constructible.
+};
+
+
+/**
+ * @brief Computes the prefix sum (exclusive scan algorithm) in-place on shared memory
+ * @remarks Work-efficient algorithm from
+ *  https://developer.nvidia.com/gpugems/gpugems3/part-vi-gpu-computing/chapter-39-parallel-prefix-sum-scan-cuda
+ *
+ * @tparam T Data type
+ * @tparam SharedMemPos shared memory access pattern (Example 39-3 in the above link)
+ * @param buffer Input/Output buffer
+ * @param pow2 Size of the buffer (must be a power of 2)
+ * @param shm_pos Shared memory access pattern
+ */
+template <typename T, typename SharedMemPos = conflict_free_pos>
+__device__ void PrefixSumSharedMem(T *buffer, int pow2, SharedMemPos shm_pos = {}) {
+  int offset = 1;
+  int tid = threadIdx.x;
+
+  // build sum in place up the tree
+  for (int d = pow2 >> 1; d > 0; d >>= 1) {
+    __syncthreads();
+    for (int idx = tid; idx < d; idx += blockDim.x) {
+      int ai = offset * (2 * idx + 1) - 1;
+      int bi = offset * (2 * idx + 2) - 1;
+      buffer[shm_pos(bi)] += buffer[shm_pos(ai)];
+    }
+    offset <<= 1;
+  }
+
+  // clear the last element
+  if (tid == 0) {
+    int last = pow2 - 1;
+    buffer[shm_pos(last)] = 0;
+  }
+
+  // traverse down tree & build scan
+  for (int d = 1; d < pow2; d <<= 1) {
+    offset >>= 1;
+    __syncthreads();
+    for (int idx = tid; idx < d; idx += blockDim.x) {
+      int shm_pos_ai = shm_pos(offset * (2 * idx + 1) - 1);
+      int shm_pos_bi = shm_pos(offset * (2 * idx + 2) - 1);
+      auto t = buffer[shm_pos_ai];
+      buffer[shm_pos_ai] = buffer[shm_pos_bi];
+      buffer[shm_pos_bi] += t;
+    }
+  }
+  __syncthreads();
+}
+
+/**
+ * @brief Calculates a running sum of a 1D signal using a sliding window of an arbitrary size.
+ *
+ * The function is meant to be called by all threads of a block; the blocks in the x dimension
+ * of the grid divide the sample into logical blocks. The output is computed on a shared memory
+ * buffer `temp` of size `logical_block + window` (rounded up to `pow2`), which corresponds to
+ * an output region of `logical_block` size.
+ *
+ * The output has the same size as the input - the signal is padded with zeros at the beginning,
+ * so that we can calculate the same number of windows as elements in the input.
+ * The input is NOT padded at the end to match every possible window overlap.
+ *
+ * Instead of storing the result, the function passes it to `consume(index, window_sum)`,
+ * so that the callers can either store it or reduce it without going through memory.
+ *
+ * @param temp          shared memory buffer of `shm_pos(pow2)` elements
+ * @param input         the input sample
+ * @param sample_len    the length of the sample
+ * @param logical_block logical block size
+ * @param window        window size
+ * @param pow2          next power of two of `window + logical_block`
+ * @param pre           preprocessing step (e.g. square)
+ * @param consume       called for each output element with its index and the window sum
+ * @param shm_pos       shared memory access pattern
+ */
+template <typename In, typename Preprocessor, typename Consumer,
+          typename SharedMemPos = conflict_free_pos>
+__device__ void SlidingWindowSumBlocks(acc_t<In> *temp, const In *input, int64_t sample_len,
+                                       int64_t logical_block, int window, int pow2,
+                                       Preprocessor pre, Consumer &&consume,
+                                       SharedMemPos shm_pos = {}) {
+  int64_t grid_stride = gridDim.x * logical_block;
+
+  // Each CUDA block calculates the output for `logical_block` samples, where `logical_block` is
+  // typically larger than the CUDA block.
+  for (int64_t logical_block_start = logical_block * blockIdx.x; logical_block_start < sample_len;
+       logical_block_start += grid_stride) {
+    const In *logical_block_in_ptr = input + logical_block_start;
+    int64_t logical_block_sz = cuda_min(logical_block, sample_len - logical_block_start);
+
+    const In *extended_blk_start = logical_block_in_ptr - window;
+    const In *extended_blk_end = logical_block_in_ptr + logical_block_sz;
+
+    // Step 1: Load extended logical block to shared mem.
+    // Out of bounds values are assumed to be 0.
+    for (int pos = threadIdx.x; pos < pow2; pos += blockDim.x) {
+      acc_t<In> value(0);
+      auto extended_blk_ptr = extended_blk_start + pos;
+      if (extended_blk_ptr >= input && extended_blk_ptr < extended_blk_end) {
+        value = *extended_blk_ptr;
+      }
+      temp[shm_pos(pos)] = pre(value);
+    }
+
+    // Step 2: Calculate prefix sum of the extended block, in place
+    // (note: __syncthreads already happens inside)
+    PrefixSumSharedMem(temp, pow2, shm_pos);
+
+    // Step 3: Compute the output, the sum in window, by subtracting two values of the prefix sum
+    // and adding the input value at the current position.
+    for (int pos = threadIdx.x; pos < logical_block_sz; pos += blockDim.x) {
+      acc_t<In> x = logical_block_in_ptr[pos];
+      acc_t<In> out_val = pre(x)                          // current element
+                          + temp[shm_pos(window + pos)]   // prefix sum @ pos
+                          - temp[shm_pos(pos + 1)];       // prefix sum @ pos - (window-1)
+      consume(logical_block_start + pos, out_val);
+    }
+    __syncthreads();  // the buffer is overwritten in the next iteration
+  }
+}
+
+/**
+ * @brief The shared memory configuration of SlidingWindowSumBlocks
+ */
+struct SlidingWindowSumParams {
+  /** The size of the shared memory buffer, in elements (before applying `conflict_free_pos`) */
+  int pow2;
+  /** The number of outputs calculated by a block in one step */
+  int logical_block;
+  /** The size of the shared memory buffer, in bytes */
+  int shm_size;
+};
+
+/**
+ * @brief Selects the shared memory configuration for a sliding window sum over `In`
+ *
+ * If reset interval is given, the logical block is selected so that it's close to it,
+ * effectively clearing the accumulation error every `reset_interval` samples.
+ */
+template <typename In>
+SlidingWindowSumParams GetSlidingWindowSumParams(int window_len, int reset_interval) {
+  conflict_free_pos shm_pos;
+  constexpr int kSharedMemBanks = conflict_free_pos::kSharedMemBanks;
+
+  int max_shm_bytes = GetSharedMemPerBlock();
+  int max_shm_elems = max_shm_bytes / sizeof(acc_t<In>);
+
+  // Get a power of two that doesn't exceed the desired maximum shared memory size
+  int pow2 = prev_pow2(max_shm_elems * kSharedMemBanks / (kSharedMemBanks + 1));
+
+  if (needs_reset<In>::value && reset_interval > 0 && reset_interval < pow2) {
+    auto p = prev_pow2(reset_interval);
+    auto n = next_pow2(reset_interval);
+    if (p > window_len)
+      pow2 = p;
+    else if (n < pow2)
+      pow2 = n;
+  }
+
+  int shm_sz = shm_pos(pow2) * sizeof(acc_t<In>);
+  int logical_block = pow2 - window_len;
+
+  // At the very least we should be able to fit a window plus one element in shared mem
+  if (logical_block <= 0 || shm_sz > max_shm_bytes) {
+    throw std::runtime_error(
+      "Can't compute the requested running sum, due to shared memory restrictions");
+  }
+  return { pow2, logical_block, shm_sz };
+}
+
+}  // namespace signal
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_SIGNAL_MOVING_MEAN_SQUARE_GPU_CUH_
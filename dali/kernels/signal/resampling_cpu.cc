@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -21,13 +21,16 @@
 #include <arm_neon.h>
 #endif
 #include <cmath>
+#include <cstring>
 #include <functional>
 #include <utility>
 #include <vector>
 #include "dali/core/convert.h"
+#include "dali/core/error_handling.h"
 #include "dali/core/math_util.h"
 #include "dali/core/small_vector.h"
 #include "dali/core/static_switch.h"
+#include "dali/core/util.h"
 
 namespace dali {
 namespace kernels {
@@ -259,11 +262,62 @@ void ResampleCPUImpl(ResamplingWindow window, Out *__restrict__ out, int64_t out
       in, n_in, in_rate, num_channels)));
 }
 
+template <typename Out>
+void ResampleStreamCPUImpl(ResamplingWindow window, Out *__restrict__ out, int64_t out_len,
+                           double out_rate, const ResamplerInputFn &read_input, int64_t n_in,
+                           double in_rate, int num_channels, std::vector<float> &buffer,
+                           int64_t out_chunk) {
+  assert(out_rate > 0 && in_rate > 0 && "Sampling rate must be positive");
+  // The chunks are aligned to the blocks of ResampleCPUImpl, so that the fractional positions
+  // are accumulated exactly as when resampling the whole signal at once.
+  const int64_t block = 1 << 8;
+  out_chunk = align_up(std::max<int64_t>(out_chunk, 1), block);
+  double scale = in_rate / out_rate;
+  // the filter reaches `lobes` input frames around the center, plus a rounding margin
+  int64_t margin = window.lobes + 2;
+
+  int64_t buf_begin = 0, buf_end = 0;  // the range of input frames held in the buffer
+  for (int64_t out_begin = 0; out_begin < out_len; out_begin += out_chunk) {
+    int64_t out_end = std::min(out_begin + out_chunk, out_len);
+    int64_t in_begin = clamp<int64_t>(std::floor(out_begin * scale) - margin, 0, n_in);
+    int64_t in_end = clamp<int64_t>(std::ceil(out_end * scale) + margin, 0, n_in);
+    assert(in_begin >= buf_begin && in_begin <= buf_end);
+
+    // drop the frames which are not needed anymore
+    if (in_begin > buf_begin) {
+      std::memmove(buffer.data(), buffer.data() + (in_begin - buf_begin) * num_channels,
+                   (buf_end - in_begin) * num_channels * sizeof(float));
+      buf_begin = in_begin;
+    }
+
+    if (static_cast<int64_t>(buffer.size()) < (in_end - buf_begin) * num_channels)
+      buffer.resize((in_end - buf_begin) * num_channels);
+    while (buf_end < in_end) {
+      int64_t n = read_input(buffer.data() + (buf_end - buf_begin) * num_channels,
+                             in_end - buf_end);
+      DALI_ENFORCE(n > 0 && n <= in_end - buf_end, make_string(
+          "Could not read the input signal at frame ", buf_end, " of ", n_in));
+      buf_end += n;
+    }
+
+    // The input pointer is adjusted, so that the absolute positions in the signal
+    // point to the frames in the buffer.
+    const float *in = buffer.data() - buf_begin * num_channels;
+    ResampleCPUImpl(window, out + out_begin * num_channels, out_begin, out_end, out_rate,
+                    in, n_in, in_rate, num_channels);
+  }
+}
+
 #define DALI_INSTANTIATE_RESAMPLER_CPU_OUT(Out)                                             \
   template void ResampleCPUImpl(ResamplingWindow window, Out *__restrict__ out,             \
                                 int64_t out_begin, int64_t out_end, double out_rate,        \
                                 const float *__restrict__ in, int64_t n_in, double in_rate, \
-                                int num_channels);
+                                int num_channels);                                          \
+  template void ResampleStreamCPUImpl(ResamplingWindow window, Out *__restrict__ out,       \
+                                      int64_t out_len, double out_rate,                     \
+                                      const ResamplerInputFn &read_input, int64_t n_in,     \
+                                      double in_rate, int num_channels,                     \
+                                      std::vector<float> &buffer, int64_t out_chunk);
 
 #define DALI_INSTANTIATE_RESAMPLER_CPU()        \
   DALI_INSTANTIATE_RESAMPLER_CPU_OUT(float);    \
@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,6 +15,8 @@
 #ifndef DALI_KERNELS_SIGNAL_RESAMPLING_CPU_H_
 #define DALI_KERNELS_SIGNAL_RESAMPLING_CPU_H_
 
+#include <functional>
+#include <vector>
 #include "dali/kernels/signal/resampling.h"
 #include "dali/core/api_helper.h"
 
@@ -29,7 +31,27 @@ DLL_PUBLIC void ResampleCPUImpl(ResamplingWindow window, Out *__restrict__ out,
                                 int64_t out_end, double out_rate, const float *__restrict__ in,
                                 int64_t n_in, double in_rate, int num_channels);
 
+/**
+ * @brief Reads the next frames of the input signal
+ *
+ * Stores up to `nframes` consecutive frames (with interleaved channels) in `out` and returns
+ * the number of frames stored. The frames are requested in order, each one exactly once.
+ */
+using ResamplerInputFn = std::function<int64_t(float *out, int64_t nframes)>;
+
+template <typename Out>
+DLL_PUBLIC void ResampleStreamCPUImpl(ResamplingWindow window, Out *__restrict__ out,
+                                      int64_t out_len, double out_rate,
+                                      const ResamplerInputFn &read_input, int64_t n_in,
+                                      double in_rate, int num_channels,
+                                      std::vector<float> &buffer, int64_t out_chunk);
+
 struct DLL_PUBLIC ResamplerCPU {
+  /**
+   * @brief The default number of output frames calculated per input chunk in ResampleStream
+   */
+  static constexpr int64_t kDefaultStreamChunk = 1 << 14;
+
   ResamplingWindowCPU window;
 
   inline void Initialize(int lobes = 16, int lookup_size = 2048) {
@@ -48,6 +70,23 @@ struct DLL_PUBLIC ResamplerCPU {
                 const float *__restrict__ in, int64_t n_in, double in_rate, int num_channels) {
     ResampleCPUImpl(window, out, out_begin, out_end, out_rate, in, n_in, in_rate, num_channels);
   }
+
+  /**
+   * @brief Resample multi-channel (or single channel) signal, read in chunks, and convert to Out
+   *
+   * Calculates the whole resampled signal (`out_len` frames), reading the `n_in` input frames
+   * with `read_input` only as they're needed. The input is kept in `buffer`, which holds
+   * roughly `out_chunk * in_rate / out_rate` frames at a time, so the memory needed doesn't
+   * depend on the length of the signal. The result is the same as that of `Resample`.
+   */
+  template <typename Out>
+  void ResampleStream(Out *__restrict__ out, int64_t out_len, double out_rate,
+                      const ResamplerInputFn &read_input, int64_t n_in, double in_rate,
+                      int num_channels, std::vector<float> &buffer,
+                      int64_t out_chunk = kDefaultStreamChunk) {
+    ResampleStreamCPUImpl(window, out, out_len, out_rate, read_input, n_in, in_rate,
+                          num_channels, buffer, out_chunk);
+  }
 };
 
 }  // namespace resampling
@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -38,12 +38,28 @@ void ResamplerGPU<Out, In>::Initialize(int lobes, int lookup_size) {
 
 template <typename Out, typename In>
 KernelRequirements ResamplerGPU<Out, In>::Setup(KernelContext &context, const InListGPU<In> &in,
-                                                span<const Args> args) {
+                                                span<const Args> args,
+                                                const InTensorCPU<float, 2> &downmix) {
   KernelRequirements req;
-  auto out_shape = in.shape;
+  TensorListShape<> out_shape;
+  int out_channels = downmix.data ? downmix.shape[0] : 0;
+  if (downmix.data) {
+    DALI_ENFORCE(out_channels > 0, "The downmixing matrix must have at least one row.");
+    out_shape.resize(in.num_samples(), out_channels == 1 ? 1 : 2);
+  } else {
+    out_shape = in.shape;
+  }
   for (int i = 0; i < in.num_samples(); i++) {
     auto in_sh = in.shape.tensor_shape_span(i);
     auto out_sh = out_shape.tensor_shape_span(i);
+    if (downmix.data) {
+      int nchannels = in_sh.size() > 1 ? in_sh[1] : 1;
+      DALI_ENFORCE(nchannels == downmix.shape[1], make_string(
+          "The downmixing matrix has ", downmix.shape[1], " columns, but sample ", i, " has ",
+          nchannels, " channels."));
+      if (out_channels > 1)
+        out_sh[1] = out_channels;
+    }
     auto &arg = args[i];
     if (arg.out_begin > 0 || arg.out_end > 0) {
       out_sh[0] = arg.out_end - arg.out_begin;
@@ -57,7 +73,8 @@ KernelRequirements ResamplerGPU<Out, In>::Setup(KernelContext &context, const In
 
 template <typename Out, typename In>
 void ResamplerGPU<Out, In>::Run(KernelContext &context, const OutListGPU<Out> &out,
-                                const InListGPU<In> &in, span<const Args> args) {
+                                const InListGPU<In> &in, span<const Args> args,
+                                const InTensorCPU<float, 2> &downmix) {
   if (window_gpu_storage_.empty())
     Initialize();
 
@@ -68,6 +85,12 @@ void ResamplerGPU<Out, In>::Run(KernelContext &context, const OutListGPU<Out> &o
   auto samples_cpu =
       make_span(scratch.Allocate<mm::memory_kind::pinned, SampleDesc>(nsamples), nsamples);
 
+  bool do_downmix = downmix.data != nullptr;
+  const float *downmix_gpu = nullptr;
+  if (do_downmix)
+    downmix_gpu = scratch.ToGPU(context.gpu.stream,
+                                make_span(downmix.data, downmix.num_elements()));
+
   bool any_multichannel = false;
   for (int i = 0; i < nsamples; i++) {
     auto &desc = samples_cpu[i];
@@ -84,6 +107,8 @@ void ResamplerGPU<Out, In>::Run(KernelContext &context, const OutListGPU<Out> &o
         arg.out_end > 0 ? arg.out_end : resampled_length(in_sh[0], arg.in_rate, arg.out_rate);
     assert((desc.out_end - desc.out_begin) == out_sample.shape[0]);
     desc.nchannels = in_sh.sample_dim() > 1 ? in_sh[1] : 1;
+    desc.out_nchannels = do_downmix ? downmix.shape[0] : desc.nchannels;
+    desc.downmix = downmix_gpu;
     desc.scale = arg.in_rate / arg.out_rate;
     any_multichannel |= desc.nchannels > 1;
   }
@@ -97,9 +122,14 @@ void ResamplerGPU<Out, In>::Run(KernelContext &context, const OutListGPU<Out> &o
   // window coefficients and temporary per channel out values
   size_t shm_size = (window_gpu_storage_.size() + (SHM_NCHANNELS + 1) * block.x) * sizeof(float);
 
-  BOOL_SWITCH(!any_multichannel, SingleChannel,
-              (ResampleGPUKernel<Out, In, SingleChannel>
-               <<<grid, block, shm_size, context.gpu.stream>>>(samples_gpu);));  // NOLINT
+  if (do_downmix) {
+    ResampleGPUKernel<Out, In, false, true>
+        <<<grid, block, shm_size, context.gpu.stream>>>(samples_gpu);
+  } else {
+    BOOL_SWITCH(!any_multichannel, SingleChannel,
+                (ResampleGPUKernel<Out, In, SingleChannel>
+                 <<<grid, block, shm_size, context.gpu.stream>>>(samples_gpu);));  // NOLINT
+  }
   CUDA_CALL(cudaGetLastError());
 }
 
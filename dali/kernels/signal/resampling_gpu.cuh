@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -36,6 +36,8 @@ struct SampleDesc {
   int64_t out_begin;  // output region-of-interest start
   int64_t out_end;  // output region-of-interest end
   int nchannels;  // number of channels
+  int out_nchannels;  // number of output channels; differs from nchannels when downmixing
+  const float *downmix;  // out_nchannels x nchannels mixing matrix (only when downmixing)
   double scale;  // in_sampling_rate / out_sampling_rate
 };
 
@@ -56,14 +58,20 @@ __device__ float ConvertInput(In in_val) {
 /**
  * @brief Resamples 1D signal (single or multi-channel), optionally converting to a different data type.
  *
+ * When `Downmix` is true, the input channels are mixed into `out_nchannels` output channels
+ * with the sample's `downmix` matrix in the same pass - the frames are mixed as they're read,
+ * so the multi-channel signal at the input rate is never stored.
+ *
  * @param samples sample descriptors
  */
-template <typename Out, typename In, bool SingleChannel = false>
+template <typename Out, typename In, bool SingleChannel = false, bool Downmix = false>
 __global__ void ResampleGPUKernel(const SampleDesc *samples) {
+  static_assert(!(SingleChannel && Downmix), "Downmixing requires the multi-channel variant");
   auto sample = samples[blockIdx.y];
   double scale = sample.scale;
   float fscale = scale;
   int nchannels = SingleChannel ? 1 : sample.nchannels;
+  int out_nchannels = Downmix ? sample.out_nchannels : nchannels;
   auto& window = sample.window;
 
   extern __shared__ float sh_mem[];
@@ -111,9 +119,9 @@ __global__ void ResampleGPUKernel(const SampleDesc *samples) {
       }
       out[out_pos - sample.out_begin] = ConvertSatNorm<Out>(out_val);
     } else {  // multiple channels
-      Out *out_ptr = out + (out_pos - sample.out_begin) * nchannels;
-      for (int c0 = 0; c0 < nchannels; c0 += SHM_NCHANNELS) {
-        int nc = cuda_min(SHM_NCHANNELS, nchannels - c0);
+      Out *out_ptr = out + (out_pos - sample.out_begin) * out_nchannels;
+      for (int c0 = 0; c0 < out_nchannels; c0 += SHM_NCHANNELS) {
+        int nc = cuda_min(SHM_NCHANNELS, out_nchannels - c0);
         for (int c = 0; c < nc; c++) {
           tmp[c] = 0;
         }
@@ -121,10 +129,21 @@ __global__ void ResampleGPUKernel(const SampleDesc *samples) {
         for (int i = i0; i < i1; i++) {
           float x = i - in_pos;
           float w = window(x);
-          const In *in_ptr = in_blk_ptr + i * nchannels + c0;
-          for (int c = 0; c < nc; c++) {
-            float in_val = ConvertInput<Out, In>(in_ptr[c]);
-            tmp[c] = fma(in_val, w, tmp[c]);
+          if (Downmix) {
+            const In *in_ptr = in_blk_ptr + i * nchannels;
+            for (int c = 0; c < nc; c++) {
+              const float *mix = sample.downmix + (c0 + c) * nchannels;
+              float in_val = 0;
+              for (int ic = 0; ic < nchannels; ic++)
+                in_val = fma(ConvertInput<Out, In>(in_ptr[ic]), mix[ic], in_val);
+              tmp[c] = fma(in_val, w, tmp[c]);
+            }
+          } else {
+            const In *in_ptr = in_blk_ptr + i * nchannels + c0;
+            for (int c = 0; c < nc; c++) {
+              float in_val = ConvertInput<Out, In>(in_ptr[c]);
+              tmp[c] = fma(in_val, w, tmp[c]);
+            }
           }
         }
 
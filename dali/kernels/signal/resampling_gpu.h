@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -31,10 +31,21 @@ class DLL_PUBLIC ResamplerGPU {
  public:
   void Initialize(int lobes = 16, int lookup_size = 2048);
 
-  KernelRequirements Setup(KernelContext &context, const InListGPU<In> &in, span<const Args> args);
+  /**
+   * @brief Calculates the output shapes
+   *
+   * @param downmix optional mixing matrix, with one row per output channel and one column per
+   *                input channel; when specified, the input channels are downmixed (e.g. to mono
+   *                or stereo) while resampling, in a single pass. All samples must have as many
+   *                channels as there are columns. A single output channel produces 1D (mono)
+   *                output; otherwise the output has the shape (length, num_rows).
+   */
+  KernelRequirements Setup(KernelContext &context, const InListGPU<In> &in, span<const Args> args,
+                           const InTensorCPU<float, 2> &downmix = {});
 
   void Run(KernelContext &context, const OutListGPU<Out> &out,
-           const InListGPU<In> &in, span<const Args> args);
+           const InListGPU<In> &in, span<const Args> args,
+           const InTensorCPU<float, 2> &downmix = {});
 
  private:
   ResamplingWindowCPU window_cpu_;
@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -96,6 +96,61 @@ class ResamplingGPUTest : public ResamplingTest {
     std::cout << "Processed " << n_iters * out_bytes / (total_time_ms * 1e6) << " GBs/sec"
               << std::endl;
   }
+
+  /**
+   * @brief Resamples with downmixing to `out_channels` and compares the result with
+   *        the reference signal mixed with the same matrix.
+   */
+  void RunDownmixTest(int out_channels) {
+    std::vector<Args> args_v;
+    for (int i = 0; i < nsamples_; i++)
+      args_v.push_back({i % 2 ? 44100.0f : 22050.0f, 16000.0f, roi_start_, roi_end_});
+    auto args = make_cspan(args_v);
+    PrepareData(args);
+
+    std::vector<float> mix(out_channels * nchannels_);
+    for (int oc = 0; oc < out_channels; oc++) {
+      float sum = 0;
+      for (int c = 0; c < nchannels_; c++)
+        sum += mix[oc * nchannels_ + c] = 1 + (oc + c) % 3;
+      for (int c = 0; c < nchannels_; c++)
+        mix[oc * nchannels_ + c] /= sum;
+    }
+    InTensorCPU<float, 2> downmix(mix.data(), {out_channels, nchannels_});
+
+    ResamplerGPU<float> R;
+    R.Initialize(16);
+
+    KernelContext ctx;
+    ctx.gpu.stream = 0;
+    DynamicScratchpad dyn_scratchpad({}, AccessOrder(ctx.gpu.stream));
+    ctx.scratchpad = &dyn_scratchpad;
+
+    auto req = R.Setup(ctx, ttl_in_.gpu(), args, downmix);
+    auto &out_sh = req.output_shapes[0];
+    ASSERT_EQ(out_sh.sample_dim(), out_channels == 1 ? 1 : 2);
+    TestTensorList<float> out;
+    out.reshape(out_sh);
+
+    R.Run(ctx, out.gpu(), ttl_in_.gpu(), args, downmix);
+    CUDA_CALL(cudaStreamSynchronize(ctx.gpu.stream));
+
+    auto ref = ttl_outref_.cpu();
+    auto result = out.cpu();
+    for (int s = 0; s < nsamples_; s++) {
+      int64_t len = ref.shape[s][0];
+      ASSERT_EQ(result.shape[s][0], len);
+      for (int64_t i = 0; i < len; i++) {
+        for (int oc = 0; oc < out_channels; oc++) {
+          float expected = 0;
+          for (int c = 0; c < nchannels_; c++)
+            expected += mix[oc * nchannels_ + c] * ref[s].data[i * nchannels_ + c];
+          ASSERT_NEAR(result[s].data[i * out_channels + oc], expected, eps_)
+              << "@ sample=" << s << " pos=" << i << " channel=" << oc;
+        }
+      }
+    }
+  }
 };
 
 TEST_F(ResamplingGPUTest, SingleChannel) {
@@ -131,6 +186,23 @@ TEST_F(ResamplingGPUTest, EightChannelOutBeginEnd) {
   this->RunTest();
 }
 
+TEST_F(ResamplingGPUTest, DownmixStereoToMono) {
+  this->nchannels_ = 2;
+  this->RunDownmixTest(1);
+}
+
+TEST_F(ResamplingGPUTest, Downmix6ChannelsToStereo) {
+  this->nchannels_ = 6;
+  this->RunDownmixTest(2);
+}
+
+TEST_F(ResamplingGPUTest, DownmixOutBeginEnd) {
+  this->roi_start_ = 100;
+  this->roi_end_ = 8000;
+  this->nchannels_ = 8;
+  this->RunDownmixTest(1);
+}
+
 TEST_F(ResamplingGPUTest, PerfTest) {
   this->RunPerfTest(1000);
 }
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -14,6 +14,7 @@
 
 #include "dali/kernels/signal/resampling_cpu.h"
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <vector>
 #include <numeric>
 #include "dali/core/cuda_error.h"
@@ -177,6 +178,62 @@ TEST_F(ResamplingCPUTest, EightChannelOutBeginEnd) {
   this->RunTest();
 }
 
+class ResamplingStreamCPUTest : public ResamplingTest {
+ public:
+  void RunResampling(span<const Args> args) override {
+    ResamplerCPU R;
+    R.Initialize(16);
+
+    auto in_view = ttl_in_.cpu();
+    auto out_view = ttl_out_.cpu();
+    for (int s = 0; s < nsamples_; s++) {
+      auto in_sh = in_view.shape[s];
+      int64_t n_in = in_sh[0];
+      int64_t n_out = out_view.shape[s][0];
+      int nchannels = in_sh.sample_dim() > 1 ? in_sh[1] : 1;
+      const float *in = in_view[s].data;
+      int64_t pos = 0;
+      auto read = [&](float *out, int64_t nframes) -> int64_t {
+        nframes = std::min<int64_t>(nframes, 1000);  // deliver the input in small pieces
+        std::copy(in + pos * nchannels, in + (pos + nframes) * nchannels, out);
+        pos += nframes;
+        return nframes;
+      };
+      std::vector<float> buffer;
+      R.ResampleStream(out_view[s].data, n_out, args[s].out_rate, read, n_in, args[s].in_rate,
+                       nchannels, buffer, chunk_);
+      EXPECT_EQ(pos, n_in);
+      double max_frames = chunk_ * args[s].in_rate / args[s].out_rate + 2 * (R.window.lobes + 3);
+      EXPECT_LE(buffer.size(), max_frames * nchannels);
+
+      // the result is the same as when resampling the whole signal
+      std::vector<float> ref(n_out * nchannels);
+      R.Resample(ref.data(), 0, n_out, args[s].out_rate, in, n_in, args[s].in_rate, nchannels);
+      for (int64_t i = 0; i < n_out * nchannels; i++)
+        ASSERT_EQ(out_view[s].data[i], ref[i]) << " at " << i;
+    }
+  }
+
+ protected:
+  int64_t chunk_ = 1 << 12;
+};
+
+TEST_F(ResamplingStreamCPUTest, SingleChannel) {
+  this->nsamples_ = 2;
+  this->RunTest();
+}
+
+TEST_F(ResamplingStreamCPUTest, ThreeChannel) {
+  this->nchannels_ = 3;
+  this->nsamples_ = 2;
+  this->RunTest();
+}
+
+TEST_F(ResamplingStreamCPUTest, UnalignedChunk) {
+  this->chunk_ = 1000;  // rounded up to the processing block
+  this->RunTest();
+}
+
 TEST_F(ResamplingCPUTest, SingleChannelNeedHighPrecision) {
   this->default_freq_in_ = 0.49;
   this->nsec_ = 400;
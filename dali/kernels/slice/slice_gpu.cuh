@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,6 +16,8 @@
 #define DALI_KERNELS_SLICE_SLICE_GPU_CUH_
 
 #include <cuda_runtime.h>
+#include <algorithm>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include "dali/core/common.h"
@@ -212,6 +214,102 @@ __device__ void SliceFunc(OutputType *__restrict__ out, const InputType *__restr
   }
 }
 
+/**
+ * @brief Collapsed (fused) shape of a slice without padding
+ *
+ * The dimensions of extent 1 are removed and the dimensions which are contiguous in both the
+ * input and the output are fused.
+ */
+template <int Dims>
+struct CollapsedSlice {
+  int64_t shape[Dims];
+  int64_t in_strides[Dims];
+  int ndim = 0;
+};
+
+/**
+ * @remarks `desc` should have `anchor` and `step` pre-applied to `in` and `in_strides`
+ */
+template <int Dims>
+CollapsedSlice<Dims> CollapseSlice(const SliceSampleDesc<Dims> &desc) {
+  CollapsedSlice<Dims> c;
+  for (int d = 0; d < Dims; d++) {
+    int64_t extent = desc.out_shape[d];
+    int64_t in_stride = desc.in_strides[d];
+    if (extent == 1)
+      continue;
+    if (c.ndim > 0 && c.in_strides[c.ndim - 1] == in_stride * extent) {
+      c.shape[c.ndim - 1] *= extent;
+      c.in_strides[c.ndim - 1] = in_stride;
+    } else {
+      c.shape[c.ndim] = extent;
+      c.in_strides[c.ndim] = in_stride;
+      c.ndim++;
+    }
+  }
+  return c;
+}
+
+/**
+ * @brief Calculates the widest vector (up to `max_vec_size` bytes) in terms of which the slice
+ *        of `elem_size`-byte elements can be expressed.
+ *
+ * A vector can be used when the innermost (collapsed) dimension is contiguous in the input and
+ * its extent, the remaining input strides and both the input and output pointers are multiples
+ * of the vector size.
+ *
+ * @remarks `desc` should have `anchor` and `step` pre-applied to `in` and `in_strides`
+ * @return The vector size, in bytes; `elem_size` if the slice cannot be vectorized.
+ */
+template <int Dims>
+int MaxSliceVectorSize(const SliceSampleDesc<Dims> &desc, int elem_size, int max_vec_size) {
+  if (volume(desc.out_shape) == 0)
+    return max_vec_size;  // nothing to copy - doesn't constrain the vector size
+  auto c = CollapseSlice(desc);
+  if (c.ndim == 0 || c.in_strides[c.ndim - 1] != 1)
+    return elem_size;
+  auto in_addr = reinterpret_cast<uintptr_t>(desc.in);
+  auto out_addr = reinterpret_cast<uintptr_t>(desc.out);
+  int vec_size = max_vec_size;
+  for (; vec_size > elem_size; vec_size >>= 1) {
+    bool ok = in_addr % vec_size == 0 && out_addr % vec_size == 0 &&
+              c.shape[c.ndim - 1] * elem_size % vec_size == 0;
+    for (int d = 0; ok && d < c.ndim - 1; d++)
+      ok = c.in_strides[d] * elem_size % vec_size == 0;
+    if (ok)
+      break;
+  }
+  return vec_size;
+}
+
+/**
+ * @brief Rewrites the sample descriptor so that it describes a slice of `vec_size`-byte vectors.
+ *
+ * The collapsed dimensions are right-aligned and the leading dimensions have unit extent.
+ *
+ * @remarks The vector size must be valid for the sample - see MaxSliceVectorSize
+ */
+template <int Dims>
+void VectorizeSliceSample(SliceSampleDesc<Dims> &desc, int elem_size, int vec_size) {
+  auto c = CollapseSlice(desc);
+  int ratio = vec_size / elem_size;
+  for (int d = 0; d < Dims; d++) {
+    int cd = d - (Dims - c.ndim);
+    int64_t extent = cd >= 0 ? c.shape[cd] : 1;
+    int64_t in_stride = cd >= 0 ? c.in_strides[cd] : 0;
+    if (d == Dims - 1)
+      extent /= ratio;
+    else
+      in_stride /= ratio;
+    desc.out_shape[d] = extent;
+    desc.in_shape[d] = extent;
+    desc.in_strides[d] = in_stride;
+    desc.anchor[d] = 0;
+    desc.step[d] = 1;
+  }
+  CalcStrides(desc.out_strides, desc.out_shape);
+}
+
 template <typename OutputType, typename InputType, int Dims, bool SupportPad>
 __global__ void SliceKernel(const SliceSampleDesc<Dims> *samples, const SliceBlockDesc *blocks) {
   int sampleIdx = blocks[blockIdx.x].sampleIdx;
@@ -244,6 +342,8 @@ class SliceGPU {
   static constexpr uint64_t kBlockDim = 256;
   static constexpr uint64_t kMinBlockSize = 4 * kBlockDim;
   static constexpr uint64_t kMaxBlockSize = 64 * kBlockDim;
+  /// The maximum size, in bytes, of the vector used to copy the slices which need no conversion
+  static constexpr int kMaxVectorSize = 16;
 
   uint64_t block_size_ = kMaxBlockSize;
   uint64_t block_count_ = 0;
@@ -386,12 +486,33 @@ class SliceGPU {
       any_padded_sample |= sample_desc.need_pad;
     }
 
+    // A slice without padding or conversion is a copy of strided rows - if the strides and
+    // addresses allow, the rows are copied with (up to 16-byte) vectors.
+    int vec_size = sizeof(OutputType);
+    if constexpr (std::is_same<OutputType, InputType>::value) {
+      if (!any_padded_sample) {
+        vec_size = kMaxVectorSize;
+        for (int i = 0; i < num_samples; i++)
+          vec_size = std::min(vec_size, slice_impl::MaxSliceVectorSize(
+                                            sample_descs_cpu[i], sizeof(OutputType), vec_size));
+      }
+    }
+    uint64_t block_size = block_size_;
+    if (vec_size > static_cast<int>(sizeof(OutputType))) {
+      for (int i = 0; i < num_samples; i++) {
+        slice_impl::VectorizeSliceSample(sample_descs_cpu[i], sizeof(OutputType), vec_size);
+        sample_sizes[i] = volume(sample_descs_cpu[i].out_shape);
+      }
+      // keep the number of blocks (at most) the same, but don't starve the threads
+      block_size = std::max(block_size_ / (vec_size / sizeof(OutputType)), kBlockDim);
+    }
+
     int64_t block_idx = 0;
     for (int i = 0; i < num_samples; i++) {
       uint64_t offset = 0;
       uint64_t remaining = sample_sizes[i];
       while (remaining > 0) {
-        uint64_t size = remaining < block_size_ ? remaining : block_size_;
+        uint64_t size = remaining < block_size ? remaining : block_size;
         block_descs_cpu[block_idx++] = {i, offset, size};
         remaining -= size;
         offset += size;
@@ -403,14 +524,24 @@ class SliceGPU {
     std::tie(sample_descs, block_descs) =
         context.scratchpad->ToContiguousGPU(context.gpu.stream,
                                             make_cspan(sample_descs_cpu, num_samples),
-                                            make_cspan(block_descs_cpu, block_count_));
+                                            make_cspan(block_descs_cpu, block_idx));
     CUDA_CALL(cudaGetLastError());
 
-    const auto grid = block_count_;
-    BOOL_SWITCH(any_padded_sample, NeedPad, (
-      slice_impl::SliceKernel<OutputType, InputType, Dims, NeedPad>
-        <<<grid, kBlockDim, 0, context.gpu.stream>>>(sample_descs, block_descs);
-    ));  // NOLINT
+    const auto grid = block_idx;
+    if (vec_size > static_cast<int>(sizeof(OutputType))) {
+      if constexpr (std::is_same<OutputType, InputType>::value) {
+        VALUE_SWITCH(vec_size, static_vec_size, (2, 4, 8, 16), (
+          using Vec = type_of_size<static_vec_size>;
+          slice_impl::SliceKernel<Vec, Vec, Dims, false>
+            <<<grid, kBlockDim, 0, context.gpu.stream>>>(sample_descs, block_descs);
+        ), (assert(!"Unreachable code")));  // NOLINT
+      }
+    } else {
+      BOOL_SWITCH(any_padded_sample, NeedPad, (
+        slice_impl::SliceKernel<OutputType, InputType, Dims, NeedPad>
+          <<<grid, kBlockDim, 0, context.gpu.stream>>>(sample_descs, block_descs);
+      ));  // NOLINT
+    }
     CUDA_CALL(cudaGetLastError());
   }
 
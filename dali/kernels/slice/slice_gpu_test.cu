@@ -1,4 +1,4 @@
-// Copyright (c) 2019, 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019, 2022, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -73,5 +73,45 @@ TYPED_TEST(SliceGPUTest, All) {
   this->Run();
 }
 
+TEST(SliceGPUVectorizeTest, VectorSize) {
+  slice_impl::SliceSampleDesc<3> desc{};
+  // a 32x32x4 slice of a 64x64x4 uint8 image
+  desc.out_shape = { 32, 32, 4 };
+  desc.in_strides = { 256, 4, 1 };
+  desc.out = reinterpret_cast<void *>(0x10000);
+  desc.in = reinterpret_cast<const void *>(0x20000 + 16 * 256 + 16 * 4);
+  EXPECT_EQ(slice_impl::MaxSliceVectorSize(desc, 1, 16), 16);
+  EXPECT_EQ(slice_impl::MaxSliceVectorSize(desc, 1, 8), 8);
+  // x anchor not aligned to 16 bytes
+  desc.in = reinterpret_cast<const void *>(0x20000 + 16 * 256 + 17 * 4);
+  EXPECT_EQ(slice_impl::MaxSliceVectorSize(desc, 1, 16), 4);
+  // only 2 out of 4 channels - the rows are not contiguous
+  desc.out_shape = { 32, 32, 2 };
+  EXPECT_EQ(slice_impl::MaxSliceVectorSize(desc, 1, 16), 2);
+  // flipped horizontally
+  desc.out_shape = { 32, 32, 4 };
+  desc.in_strides = { 256, -4, 1 };
+  EXPECT_EQ(slice_impl::MaxSliceVectorSize(desc, 1, 16), 4);
+  // the channels are flipped
+  desc.in_strides = { 256, 4, -1 };
+  EXPECT_EQ(slice_impl::MaxSliceVectorSize(desc, 1, 16), 1);
+}
+
+TEST(SliceGPUVectorizeTest, Vectorize) {
+  slice_impl::SliceSampleDesc<3> desc{};
+  desc.out_shape = { 32, 32, 4 };
+  desc.in_shape = { 64, 64, 4 };
+  desc.anchor = { 16, 16, 0 };
+  desc.step = { 1, 1, 1 };
+  desc.in_strides = { 256, 4, 1 };
+  slice_impl::VectorizeSliceSample(desc, 1, 16);
+  EXPECT_EQ(desc.out_shape, TensorShape<3>(1, 32, 8));
+  EXPECT_EQ(desc.in_strides, TensorShape<3>(0, 16, 1));
+  EXPECT_EQ(desc.anchor, TensorShape<3>(0, 0, 0));
+  EXPECT_EQ(static_cast<uint64_t>(desc.out_strides[0]), 256u);
+  EXPECT_EQ(static_cast<uint64_t>(desc.out_strides[1]), 8u);
+  EXPECT_EQ(static_cast<uint64_t>(desc.out_strides[2]), 1u);
+}
+
 }  // namespace kernels
 }  // namespace dali
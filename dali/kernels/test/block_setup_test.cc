@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -310,6 +310,52 @@ TEST(BlockSetup, SetupBlocks_Variable_DHWC) {
 }
 
 
+TEST(BlockSetup, SetupBlocks_Variable_PersistentGrid) {
+  TensorListShape<3> TLS({
+    { 224, 224, 3 },
+    { 1024, 1024, 3 },
+    { 224, 224, 3 },
+    { 300, 1000, 3 },
+    { 1, 1, 3 },
+    { 0, 100, 3 },
+    { 1024, 1024, 3 }
+  });
+
+  BlockSetup<2, 2> setup;
+  setup.SetBlockDim(dim3(32, 8, 1));
+  const int max_grid_size = 40;
+  setup.SetMaxGridSize(max_grid_size);
+  setup.SetupBlocks(TLS);
+  ASSERT_FALSE(setup.IsUniformSize());
+  int prev = -1;
+  BlockMap<2> map;
+  int64_t max_area = 0, min_area = 1_i64 << 62;
+  for (auto &blk : setup.Blocks()) {
+    if (blk.sample_idx != prev) {
+      if (prev != -1) {
+        ValidateBlockMap(map, TLS[prev].first<2>());
+      }
+      prev = blk.sample_idx;
+      map = {};
+    }
+    auto &b = map.inner[blk.start.y];
+    b.end = blk.end.y;
+    b.inner[blk.start.x].end = blk.end.x;
+    if (blk.sample_idx != 4) {  // the 1x1 sample can't be split to match the other blocks
+      int64_t area = volume(blk.end - blk.start);
+      max_area = std::max(max_area, area);
+      min_area = std::min(min_area, area);
+    }
+  }
+  if (prev != -1)
+    ValidateBlockMap(map, TLS[prev].first<2>());
+  EXPECT_LE(max_area, 256 * 256);
+  EXPECT_LE(max_area, 2 * min_area) << "The blocks should have similar area";
+  EXPECT_GT(static_cast<int>(setup.Blocks().size()), max_grid_size);
+  EXPECT_EQ(setup.GridDimVec(), ivec3(max_grid_size, 1, 1));
+}
+
+
 TEST(BlockSetup, SetupBlocks_Uniform_HWC) {
   const int W = 1920;
   const int H = 1080;
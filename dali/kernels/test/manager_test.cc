@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <utility>
 #include "dali/kernels/kernel_manager.h"
 #include "dali/kernels/kernel.h"
 
@@ -50,6 +51,17 @@ struct TestKernel {
   }
 };
 
+struct CountingKernel {
+  KernelRequirements Setup(KernelContext &ctx, const TensorShape<2> &shape, int arg) {
+    num_setups++;
+    KernelRequirements req = {};
+    req.output_shapes.push_back(uniform_list_shape(arg, shape));
+    return req;
+  }
+
+  int num_setups = 0;
+};
+
 }  // namespace
 
 TEST(AnyKernelInstance, CreateOrGet) {
@@ -121,5 +133,32 @@ TEST(KernelManager, TemplateResize) {
   mgr.Run<TestKernel>(0, ctx, out, in, 100, 1.25f);
 }
 
+TEST(KernelManager, SetupCached) {
+  KernelManager mgr;
+  mgr.Resize<CountingKernel>(2);
+  KernelContext ctx;
+  TensorShape<2> shape = { 10, 20 };
+  auto key = std::make_pair(shape, 3);
+  auto &k0 = mgr.Get<CountingKernel>(0);
+  auto &req = mgr.SetupCached<CountingKernel>(0, key, ctx, shape, 3);
+  EXPECT_EQ(k0.num_setups, 1);
+  EXPECT_EQ(req.output_shapes[0], uniform_list_shape(3, shape));
+
+  mgr.SetupCached<CountingKernel>(0, key, ctx, shape, 3);
+  EXPECT_EQ(k0.num_setups, 1) << "The setup should be cached";
+  mgr.SetupCached<CountingKernel>(1, key, ctx, shape, 3);
+  EXPECT_EQ(mgr.Get<CountingKernel>(1).num_setups, 1) << "The instances are cached separately";
+
+  key.second = 4;
+  auto &req2 = mgr.SetupCached<CountingKernel>(0, key, ctx, shape, 4);
+  EXPECT_EQ(k0.num_setups, 2) << "The key has changed";
+  EXPECT_EQ(req2.output_shapes[0], uniform_list_shape(4, shape));
+
+  mgr.Setup<CountingKernel>(0, ctx, shape, 4);
+  EXPECT_EQ(k0.num_setups, 3);
+  mgr.SetupCached<CountingKernel>(0, key, ctx, shape, 4);
+  EXPECT_EQ(k0.num_setups, 4) << "The regular Setup should invalidate the cached one";
+}
+
 }  // namespace kernels
 }  // namespace dali
@@ -14,10 +14,13 @@
 
 #include <gtest/gtest.h>
 #include <opencv2/imgcodecs.hpp>
+#include <random>
+#include <vector>
 #include "dali/kernels/test/test_data.h"
 #include "dali/test/tensor_test_utils.h"
 #include "dali/kernels/imgproc/resample/resampling_filters.cuh"
 #include "dali/kernels/imgproc/resample/resampling_impl_cpu.h"
+#include "dali/kernels/imgproc/resample/resampling_impl_cpu_simd.h"
 #include "dali/test/mat2tensor.h"
 #include "dali/core/tensor_shape_print.h"
 
@@ -238,5 +241,114 @@ TEST(ResampleCPU, Linear) {
 }
 
 
+namespace {
+
+template <typename T>
+double WideSIMDEps() {
+  return std::is_integral<T>::value ? 1 : 1e-3;
+}
+
+template <CpuIsa isa, typename Out, typename In>
+void TestWideSIMDVert(std::mt19937 &rng) {
+  const int w = 517, support = 5, begin = 3;
+  std::uniform_real_distribution<float> value_dist(0, 255), coeff_dist(-0.3f, 0.7f);
+  std::vector<std::vector<In>> rows(support, std::vector<In>(w));
+  std::vector<const In *> row_ptrs(support);
+  std::vector<float> kernel(support);
+  for (int k = 0; k < support; k++) {
+    for (auto &x : rows[k])
+      x = value_dist(rng);
+    row_ptrs[k] = rows[k].data();
+    kernel[k] = coeff_dist(rng);  // the sum may be off 1, which exercises the saturation
+  }
+
+  std::vector<Out> out(w, 42);
+  int end = resample_simd::ResampleVertSpanImpl<isa>(out.data(), row_ptrs.data(), kernel.data(),
+                                                     support, begin, w);
+  EXPECT_GT(end, w - 64);
+  EXPECT_LE(end, w);
+  for (int i = 0; i < w; i++) {
+    if (i < begin || i >= end) {
+      EXPECT_EQ(out[i], 42) << "an element outside of the processed range was modified: " << i;
+      continue;
+    }
+    float ref = 0;
+    for (int k = 0; k < support; k++)
+      ref += rows[k][i] * kernel[k];
+    EXPECT_NEAR(out[i], ConvertSat<Out>(ref), WideSIMDEps<Out>()) << "at " << i;
+  }
+}
+
+template <CpuIsa isa, int channels, typename Out, typename In>
+void TestWideSIMDHorz(std::mt19937 &rng) {
+  const int in_w = 97, out_w = 333, support = 4, ox0 = 5;
+  std::uniform_real_distribution<float> value_dist(0, 255), coeff_dist(-0.3f, 0.7f);
+  std::vector<In> in(in_w * channels);
+  for (auto &x : in)
+    x = value_dist(rng);
+  // the footprints stick out of the input on both sides
+  std::vector<int32_t> in_columns(out_w);
+  std::vector<float> coeffs(out_w * support);
+  for (int x = 0; x < out_w; x++)
+    in_columns[x] = x * in_w / out_w - 2;
+  for (auto &c : coeffs)
+    c = coeff_dist(rng);
+
+  std::vector<Out> out(out_w * channels, 42), ref(out_w * channels);
+  int end = resample_simd::ResampleHorzSpanImpl<isa, channels, true, true>(
+      out.data(), in.data(), ox0, out_w, in_w, in_columns.data(), coeffs.data(), support);
+  EXPECT_GT(end, out_w - 64);
+  EXPECT_LE(end, out_w);
+  for (int x = ox0; x < end; x++)
+    ResampleCol<channels, true, true>(ref.data(), in.data(), x, in_w, in_columns.data(),
+                                      coeffs.data(), support, channels);
+  for (int x = 0; x < out_w; x++) {
+    for (int c = 0; c < channels; c++) {
+      int i = x * channels + c;
+      if (x < ox0 || x >= end)
+        EXPECT_EQ(out[i], 42) << "a column outside of the processed range was modified: " << x;
+      else
+        EXPECT_NEAR(out[i], ref[i], WideSIMDEps<Out>()) << "at " << x << ", channel " << c;
+    }
+  }
+}
+
+template <CpuIsa isa>
+void TestWideSIMD() {
+  std::mt19937 rng(1234);
+  TestWideSIMDVert<isa, float, uint8_t>(rng);
+  TestWideSIMDVert<isa, float, float>(rng);
+  TestWideSIMDVert<isa, uint8_t, float>(rng);
+  TestWideSIMDVert<isa, uint8_t, uint8_t>(rng);
+  TestWideSIMDHorz<isa, 1, float, uint8_t>(rng);
+  TestWideSIMDHorz<isa, 3, float, uint8_t>(rng);
+  TestWideSIMDHorz<isa, 4, float, float>(rng);
+  TestWideSIMDHorz<isa, 1, uint8_t, float>(rng);
+  TestWideSIMDHorz<isa, 3, uint8_t, float>(rng);
+  TestWideSIMDHorz<isa, 4, uint8_t, uint8_t>(rng);
+}
+
+}  // namespace
+
+TEST(ResampleCPU, WideSIMD) {
+  bool tested = false;
+#if DALI_CPU_DISPATCH_X86
+  if (CpuSupports(CpuIsa::AVX2)) {
+    TestWideSIMD<CpuIsa::AVX2>();
+    tested = true;
+  }
+  if (CpuSupports(CpuIsa::AVX512)) {
+    TestWideSIMD<CpuIsa::AVX512>();
+    tested = true;
+  }
+#endif
+#if DALI_CPU_DISPATCH_NEON
+  TestWideSIMD<CpuIsa::NEON>();
+  tested = true;
+#endif
+  if (!tested)
+    GTEST_SKIP() << "No wide SIMD instruction set available.";
+}
+
 }  // namespace kernels
 }  // namespace dali
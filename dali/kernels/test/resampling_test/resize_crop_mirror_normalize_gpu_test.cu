@@ -0,0 +1,174 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cuda_runtime.h>
+#include <random>
+#include <vector>
+#include "dali/core/bfloat16.h"
+#include "dali/core/float16.h"
+#include "dali/core/geom/vec.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/imgproc/resample.h"
+#include "dali/kernels/imgproc/resample/resize_crop_mirror_normalize_gpu.h"
+#include "dali/kernels/scratch.h"
+#include "dali/test/tensor_test_utils.h"
+#include "dali/test/test_tensors.h"
+
+namespace dali {
+namespace kernels {
+namespace resample_test {
+
+class ResizeCropMirrorNormalizeGPUTest : public ::testing::Test {
+ protected:
+  using Kernel = ResizeCropMirrorNormalizeGPU<float>;
+
+  void SetUp() override {
+    TensorListShape<3> in_shape = {{ {480, 640, 3}, {100, 200, 3}, {37, 29, 3}, {300, 300, 3} }};
+    input_.reshape(in_shape);
+    std::mt19937_64 rng(1234);
+    UniformRandomFill(input_.cpu(), rng, 0, 255);
+
+    int N = in_shape.num_samples();
+    args_.resize(N);
+    FilterDesc linear(ResamplingFilterType::Linear);
+    FilterDesc cubic(ResamplingFilterType::Cubic);
+    FilterDesc nearest(ResamplingFilterType::Nearest);
+    // downscaling with antialiasing, a crop with mirroring
+    SetParams(args_[0], {224, 224}, {40.0f, 440.0f}, {560.0f, 80.0f}, linear, linear);
+    // upscaling, the top half of the image, flipped vertically
+    SetParams(args_[1], {160, 320}, {50.0f, 0.0f}, {0.0f, 200.0f}, linear, cubic);
+    // nearest neighbor, the ROI partially outside of the image
+    SetParams(args_[2], {64, 48}, {-5.0f, 40.0f}, {3.0f, 25.0f}, nearest, nearest);
+    // anisotropic
+    SetParams(args_[3], {100, 500}, {0.0f, 300.0f}, {0.0f, 300.0f}, cubic, linear);
+
+    for (auto &a : args_) {
+      a.mean = { 255 * 0.485f, 255 * 0.456f, 255 * 0.406f };
+      a.inv_stddev = { 1 / (255 * 0.229f), 1 / (255 * 0.224f), 1 / (255 * 0.225f) };
+    }
+  }
+
+  static void SetParams(Kernel::SampleArgs &args, ivec2 out_size_hw, vec2 roi_y, vec2 roi_x,
+                        FilterDesc min_filter, FilterDesc mag_filter) {
+    vec2 roi_hw[2] = { roi_y, roi_x };
+    for (int d = 0; d < 2; d++) {
+      auto &p = args.params[d];
+      p.output_size = out_size_hw[d];
+      p.roi = ResamplingParams::ROI(roi_hw[d][0], roi_hw[d][1]);
+      p.min_filter = min_filter;
+      p.mag_filter = mag_filter;
+    }
+  }
+
+  /**
+   * @brief Computes the reference with the separable resampling, followed by a normalization
+   *        and a (optional) transposition on the host
+   */
+  void ComputeReference(bool planar, int out_channels) {
+    std::vector<ResamplingParams2D> params;
+    for (auto &a : args_)
+      params.push_back(a.params);
+    auto in_gpu = input_.gpu();
+
+    ResampleGPU<float, uint8_t, 2> resample;
+    KernelContext ctx;
+    ctx.gpu.stream = 0;
+    auto req = resample.Setup(ctx, in_gpu, make_span(params));
+    ScratchpadAllocator sa;
+    sa.Reserve(req.scratch_sizes);
+    auto scratchpad = sa.GetScratchpad();
+    ctx.scratchpad = &scratchpad;
+    TestTensorList<float, 3> resized;
+    resized.reshape(req.output_shapes[0].to_static<3>());
+    resample.Run(ctx, resized.gpu(), in_gpu, make_span(params));
+    auto resized_cpu = resized.cpu();
+
+    int N = args_.size();
+    TensorListShape<3> ref_shape(N, 3);
+    for (int i = 0; i < N; i++) {
+      auto sh = resized_cpu.shape[i];
+      ref_shape.set_tensor_shape(i, planar ? TensorShape<3>(out_channels, sh[0], sh[1])
+                                           : TensorShape<3>(sh[0], sh[1], out_channels));
+    }
+    ref_.reshape(ref_shape);
+    auto ref_cpu = ref_.cpu();
+    for (int i = 0; i < N; i++) {
+      auto in = resized_cpu[i];
+      auto out = ref_cpu[i];
+      int H = in.shape[0], W = in.shape[1], C = in.shape[2];
+      for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+          for (int c = 0; c < out_channels; c++) {
+            float v = c < C ? (*in(y, x, c) - args_[i].mean[c]) * args_[i].inv_stddev[c]
+                            : args_[i].fill_values[c];
+            *(planar ? out(c, y, x) : out(y, x, c)) = v;
+          }
+        }
+      }
+    }
+  }
+
+  template <typename Out>
+  void RunKernel(TestTensorList<Out, 3> &output, TensorLayout layout) {
+    ResizeCropMirrorNormalizeGPU<Out> kernel;
+    KernelContext ctx;
+    DynamicScratchpad scratchpad;
+    ctx.scratchpad = &scratchpad;
+    ctx.gpu.stream = 0;
+    auto in_gpu = input_.gpu();
+    auto req = kernel.Setup(ctx, in_gpu.shape, make_cspan(args_), layout);
+    output.reshape(req.output_shapes[0].template to_static<3>());
+    kernel.Run(ctx, output.gpu(), in_gpu, make_cspan(args_));
+    CUDA_CALL(cudaStreamSynchronize(0));
+  }
+
+  TestTensorList<uint8_t, 3> input_;
+  TestTensorList<float, 3> ref_;
+  std::vector<Kernel::SampleArgs> args_;
+};
+
+TEST_F(ResizeCropMirrorNormalizeGPUTest, CHW) {
+  ComputeReference(true, 3);
+  TestTensorList<float, 3> output;
+  RunKernel(output, "CHW");
+  Check(output.cpu(), ref_.cpu(), EqualEpsRel(1e-3, 1e-3));
+}
+
+TEST_F(ResizeCropMirrorNormalizeGPUTest, HWC_Pad) {
+  for (auto &a : args_)
+    a.fill_values = { 0, 0, 0, 42 };
+  ComputeReference(false, 4);
+  TestTensorList<float, 3> output;
+  RunKernel(output, "HWC");
+  Check(output.cpu(), ref_.cpu(), EqualEpsRel(1e-3, 1e-3));
+}
+
+TEST_F(ResizeCropMirrorNormalizeGPUTest, CHW_Half) {
+  ComputeReference(true, 3);
+  TestTensorList<float16, 3> output;
+  RunKernel(output, "CHW");
+  Check(output.cpu(), ref_.cpu(), EqualEpsRel(1e-2, 1e-2));
+}
+
+TEST_F(ResizeCropMirrorNormalizeGPUTest, HWC_BFloat16) {
+  ComputeReference(false, 3);
+  TestTensorList<bfloat16, 3> output;
+  RunKernel(output, "HWC");
+  Check(output.cpu(), ref_.cpu(), EqualEpsRel(1e-2, 1e-2));
+}
+
+}  // namespace resample_test
+}  // namespace kernels
+}  // namespace dali
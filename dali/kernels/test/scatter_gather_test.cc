@@ -17,6 +17,7 @@
 #include <algorithm>
 
 #include "dali/core/cuda_error.h"
+#include "dali/core/cuda_stream.h"
 #include "dali/core/mm/memory.h"
 #include "dali/kernels/common/scatter_gather.h"
 #include "dali/pipeline/util/thread_pool.h"
@@ -172,5 +173,42 @@ REGISTER_TYPED_TEST_SUITE_P(ScatterGatherTest, CopyLargeChunks, CopySmallChunks)
 using ScatterGatherTypes = ::testing::Types<ScatterGatherCPU, ScatterGatherGPU>;
 INSTANTIATE_TYPED_TEST_SUITE_P(ScatterGatherSuite, ScatterGatherTest, ScatterGatherTypes);
 
+TEST(ScatterGatherGPU, ManySmallCopies) {
+  const int n = 2000;
+  const size_t sample_size = 100;
+  std::vector<char> in(n * sample_size), out(n * sample_size);
+  unsigned seed = 42;
+  for (auto &x : in)
+    x = rand_r(&seed);
+  auto dev = mm::alloc_raw_unique<char, mm::memory_kind::device>(in.size());
+  // the kernel and the regular batched copy need the host memory to be pinned
+  auto pinned = mm::alloc_raw_unique<char, mm::memory_kind::pinned>(in.size());
+  memcpy(pinned.get(), in.data(), in.size());
+  CUDAStream stream = CUDAStream::Create(true);
+
+  for (auto method : { ScatterGatherGPU::Method::PageableMemcpy,
+                       ScatterGatherGPU::Method::Memcpy, ScatterGatherGPU::Method::Default }) {
+    const char *src = method == ScatterGatherGPU::Method::PageableMemcpy
+                    ? in.data() : pinned.get();
+    CUDA_CALL(cudaMemsetAsync(dev.get(), 0, in.size(), stream));
+    ScatterGatherGPU sg;
+    // reverse the order of the samples, so that the ranges are not coalesced
+    for (int i = 0; i < n; i++)
+      sg.AddCopy(dev.get() + (n - 1 - i) * sample_size, src + i * sample_size, sample_size);
+    sg.Run(stream, true, method, cudaMemcpyHostToDevice);
+    CUDA_CALL(cudaMemcpyAsync(out.data(), dev.get(), out.size(), cudaMemcpyDeviceToHost, stream));
+    CUDA_CALL(cudaStreamSynchronize(stream));
+    for (int i = 0; i < n; i++)
+      ASSERT_EQ(0, memcmp(out.data() + (n - 1 - i) * sample_size, in.data() + i * sample_size,
+                          sample_size)) << "Sample " << i << " differs";
+  }
+}
+
+TEST(ScatterGatherGPU, CopyKernelThreshold) {
+  size_t threshold = detail::CopyKernelThreshold(0);
+  // the result is cached
+  EXPECT_EQ(threshold, detail::CopyKernelThreshold(0));
+}
+
 }  // namespace kernels
 }  // namespace dali
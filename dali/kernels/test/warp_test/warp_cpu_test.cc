@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2021, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/imgproc.hpp>
+#include <random>
 #include <string>
 #include <vector>
 #include "dali/kernels/imgproc/warp_cpu.h"
@@ -146,5 +147,48 @@ TEST(WarpCPU, Affine_RotateScale) {
   }
 }
 
+TEST(WarpCPU, RangesMatchFullRun) {
+  std::mt19937_64 rng(1234);
+  KernelContext ctx = {};
+  auto tr = translation(vec2(40, 10)) * rotation2D(-M_PI/6) * scaling(vec2(0.7f, 1.3f));
+  AffineMapping2D mapping2d = sub<2, 3>(tr, 0, 0);
+  TestTensorList<uint8_t, 3> in2d, out2d, ref2d;
+  in2d.reshape(uniform_list_shape<3>(1, { 97, 113, 3 }));
+  UniformRandomFill(in2d.cpu(), rng, 0, 255);
+  TensorShape<2> out_size2d = { 131, 89 };
+  ref2d.reshape(uniform_list_shape(1, shape_cat(out_size2d, 3)));
+  out2d.reshape(ref2d.cpu().shape);
+
+  WarpCPU<AffineMapping2D, 2, uint8_t, uint8_t, uint8_t> warp2d;
+  warp2d.Run(ctx, ref2d.cpu()[0], in2d.cpu()[0], mapping2d, out_size2d, DALI_INTERP_LINEAR, 0);
+  for (int begin = 0, step = 1; begin < out_size2d[0]; begin += step, step++) {
+    int end = std::min<int>(begin + step, out_size2d[0]);
+    warp2d.Run(ctx, out2d.cpu()[0], in2d.cpu()[0], mapping2d, out_size2d, DALI_INTERP_LINEAR,
+               0, begin, end);
+  }
+  Check(out2d.cpu()[0], ref2d.cpu()[0]);
+
+  AffineMapping3D mapping3d = mat3x4{{
+    { 0.9f, 0.1f, 0, 1 },
+    { -0.1f, 1.1f, 0, 2 },
+    { 0, 0.2f, 0.8f, 3 }
+  }};
+  TestTensorList<float, 4> in3d, out3d, ref3d;
+  in3d.reshape(uniform_list_shape<4>(1, { 20, 31, 27, 2 }));
+  UniformRandomFill(in3d.cpu(), rng, 0, 1);
+  TensorShape<3> out_size3d = { 23, 29, 30 };
+  ref3d.reshape(uniform_list_shape(1, shape_cat(out_size3d, 2)));
+  out3d.reshape(ref3d.cpu().shape);
+
+  WarpCPU<AffineMapping3D, 3, float, float, BorderClamp> warp3d;
+  warp3d.Run(ctx, ref3d.cpu()[0], in3d.cpu()[0], mapping3d, out_size3d, DALI_INTERP_NN);
+  for (int begin = 0, step = 1; begin < out_size3d[0]; begin += step, step++) {
+    int end = std::min<int>(begin + step, out_size3d[0]);
+    warp3d.Run(ctx, out3d.cpu()[0], in3d.cpu()[0], mapping3d, out_size3d, DALI_INTERP_NN,
+               {}, begin, end);
+  }
+  Check(out3d.cpu()[0], ref3d.cpu()[0]);
+}
+
 }  // namespace kernels
 }  // namespace dali
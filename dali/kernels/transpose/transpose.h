@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,13 +15,16 @@
 #ifndef DALI_KERNELS_TRANSPOSE_TRANSPOSE_H_
 #define DALI_KERNELS_TRANSPOSE_TRANSPOSE_H_
 
+#include <algorithm>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "dali/core/small_vector.h"
 #include "dali/core/static_switch.h"
 #include "dali/core/tensor_view.h"
 #include "dali/kernels/common/utils.h"
+#include "dali/kernels/transpose/transpose_cpu_simd.h"
 #include "dali/kernels/transpose/transpose_util.h"
 
 namespace dali {
@@ -139,6 +142,190 @@ void Transpose(const TensorView<StorageCPU, T> &dst, const TensorView<StorageCPU
         make_span(dst_strides), make_span(src_strides), dst.shape, perm);));
 }
 
+/**
+ * @brief Transposition of a tensor, divided into blocks which can be processed independently
+ *
+ * The permutation is simplified first (see SimplifyPermute). If the innermost dimension stays
+ * in place, its contiguous runs are copied - the short ones in groups of consecutive rows of
+ * the output. Otherwise, the innermost dimension of the output and the one which is innermost in
+ * the source form 2D matrices, which are transposed in blocks of kBlock x kBlock elements - so
+ * that both the reads and the writes use whole cache lines. Within a block, the tiles of
+ * 8x8 elements (16x16 for 1-byte types) are transposed in registers, if the CPU supports it
+ * (see transpose_cpu_simd.h).
+ *
+ * A range of blocks can be transposed with `Run`, so a large tensor can be split between
+ * the threads.
+ */
+template <typename T>
+class TiledTranspose {
+ public:
+  /** The extent of the 2D blocks */
+  static constexpr int kBlock = 32;
+  /** The maximum number of elements copied in one block when the innermost dimension stays */
+  static constexpr int kCopyBlock = kBlock * kBlock;
+
+  TiledTranspose() = default;
+
+  /**
+   * @param perm target permutation, source dimension `perm[i]` goes to destination dimension `i`
+   */
+  TiledTranspose(T *dst, const T *src, const TensorShape<> &src_shape, span<const int> perm)
+  : dst_(dst), src_(src) {
+    TensorShape<> shape;
+    SmallVector<int, 6> simplified_perm;
+    transpose_impl::SimplifyPermute(shape, simplified_perm, src_shape, perm);
+    if (shape.empty()) {  // a scalar or all extents equal to 1
+      shape = TensorShape<>{1};
+      simplified_perm.clear();
+      simplified_perm.push_back(0);
+    }
+    ndim_ = shape.size();
+    auto src_strides = GetStrides(shape);
+    size_ = permute(shape, simplified_perm);
+    auto dst_strides = GetStrides(size_);
+    dst_stride_.resize(ndim_);
+    src_stride_.resize(ndim_);
+    for (int d = 0; d < ndim_; d++) {
+      dst_stride_[d] = dst_strides[d];
+      src_stride_[d] = src_strides[simplified_perm[d]];
+      if (simplified_perm[d] == ndim_ - 1)
+        src_inner_ = d;
+    }
+    if (volume(shape) == 0)
+      return;
+    int n = ndim_ - 1;
+    copy_ = src_inner_ == n;
+    if (copy_) {
+      // the runs of the innermost dimension are copied - the short ones in groups, along
+      // the next dimension
+      k_ = n - 1;
+      block_rows_ = std::max<int64_t>(1, kCopyBlock / size_[n]);
+      block_cols_ = kCopyBlock;
+    } else {
+      k_ = src_inner_;
+      block_rows_ = block_cols_ = kBlock;
+      tile_func_ = transpose_simd::GetTransposeTileFunc<sizeof(T)>();
+    }
+    blocks_k_ = k_ >= 0 ? div_ceil(size_[k_], block_rows_) : 1;
+    blocks_n_ = div_ceil(size_[n], block_cols_);
+    int64_t num_outer = volume(size_) / size_[n] / (k_ >= 0 ? size_[k_] : 1);
+    num_blocks_ = num_outer * blocks_k_ * blocks_n_;
+  }
+
+  int64_t NumBlocks() const {
+    return num_blocks_;
+  }
+
+  /** Transposes the blocks [begin, end) */
+  void Run(int64_t begin, int64_t end) const {
+    if (begin >= end)
+      return;
+    int n = ndim_ - 1;
+    int64_t blocks_per_outer = blocks_k_ * blocks_n_;
+    int64_t outer = begin / blocks_per_outer;
+    int64_t bk = begin % blocks_per_outer / blocks_n_;
+    int64_t bn = begin % blocks_n_;
+
+    // position in the outer dimensions, i.e. all but the innermost ones in dst and src
+    SmallVector<int64_t, 6> pos;
+    pos.resize(ndim_, 0);
+    int64_t dst_offset = 0, src_offset = 0;
+    for (int d = n - 1; d >= 0; d--) {
+      if (d == k_)
+        continue;
+      pos[d] = outer % size_[d];
+      outer /= size_[d];
+      dst_offset += pos[d] * dst_stride_[d];
+      src_offset += pos[d] * src_stride_[d];
+    }
+
+    for (int64_t b = begin; b < end; b++) {
+      RunBlock(dst_ + dst_offset, src_ + src_offset, bk, bn);
+      if (++bn < blocks_n_)
+        continue;
+      bn = 0;
+      if (++bk < blocks_k_)
+        continue;
+      bk = 0;
+      for (int d = n - 1; d >= 0; d--) {
+        if (d == k_)
+          continue;
+        dst_offset += dst_stride_[d];
+        src_offset += src_stride_[d];
+        if (++pos[d] < size_[d])
+          break;
+        dst_offset -= size_[d] * dst_stride_[d];
+        src_offset -= size_[d] * src_stride_[d];
+        pos[d] = 0;
+      }
+    }
+  }
+
+  void Run() const {
+    Run(0, num_blocks_);
+  }
+
+ private:
+  void RunBlock(T *dst, const T *src, int64_t bk, int64_t bn) const {
+    int n = ndim_ - 1;
+    int64_t r0 = bk * block_rows_, c0 = bn * block_cols_;
+    int64_t rows = k_ >= 0 ? std::min<int64_t>(block_rows_, size_[k_] - r0) : 1;
+    int64_t cols = std::min<int64_t>(block_cols_, size_[n] - c0);
+    int64_t dst_stride = k_ >= 0 ? dst_stride_[k_] : 0;
+    if (copy_) {
+      int64_t src_stride = k_ >= 0 ? src_stride_[k_] : 0;
+      dst += r0 * dst_stride + c0;
+      src += r0 * src_stride + c0;
+      for (int64_t r = 0; r < rows; r++) {
+        for (int64_t c = 0; c < cols; c++)
+          dst[r * dst_stride + c] = src[r * src_stride + c];
+      }
+      return;
+    }
+    // dst[r * dst_stride + c] = src[c * src_stride + r]
+    int64_t src_stride = src_stride_[n];
+    dst += r0 * dst_stride + c0;
+    src += c0 * src_stride + r0;
+    int64_t full_rows = 0, full_cols = 0;
+    if (tile_func_) {
+      constexpr int kTile = transpose_simd::kTileSize<sizeof(T)>;
+      full_rows = rows - rows % kTile;
+      full_cols = cols - cols % kTile;
+      for (int64_t c = 0; c < full_cols; c += kTile) {
+        for (int64_t r = 0; r < full_rows; r += kTile)
+          tile_func_(dst + r * dst_stride + c, dst_stride, src + c * src_stride + r, src_stride);
+      }
+    }
+    TransposeScalar(dst, dst_stride, src, src_stride, 0, full_rows, full_cols, cols);
+    TransposeScalar(dst, dst_stride, src, src_stride, full_rows, rows, 0, cols);
+  }
+
+  static void TransposeScalar(T *dst, int64_t dst_stride, const T *src, int64_t src_stride,
+                              int64_t r0, int64_t r1, int64_t c0, int64_t c1) {
+    for (int64_t r = r0; r < r1; r++) {
+      for (int64_t c = c0; c < c1; c++)
+        dst[r * dst_stride + c] = src[c * src_stride + r];
+    }
+  }
+
+  T *dst_ = nullptr;
+  const T *src_ = nullptr;
+  int ndim_ = 0;
+  /** The (simplified) output shape */
+  TensorShape<> size_;
+  /** The strides of the output and the source, in the output order */
+  SmallVector<int64_t, 6> dst_stride_, src_stride_;
+  /** The output dimension which is innermost in the source */
+  int src_inner_ = 0;
+  /** Whether the innermost dimension stays in place */
+  bool copy_ = false;
+  /** The output dimension along which the blocks have multiple rows; -1 if there's none */
+  int k_ = -1;
+  int64_t block_rows_ = 0, block_cols_ = 0;
+  int64_t blocks_k_ = 0, blocks_n_ = 0, num_blocks_ = 0;
+  transpose_simd::TransposeTileFunc tile_func_ = nullptr;
+};
+
 /**
  * @brief Transpose `src` Tensor to `dst` wrt to permutation `perm`
  *
@@ -147,20 +334,14 @@ void Transpose(const TensorView<StorageCPU, T> &dst, const TensorView<StorageCPU
  * For example "HWC", perm = {2, 0, 1}; the "HW" would be collapsed to one dimension "X",
  * and effectively we will do XC -> CX transposition.
  *
+ * The transposition is cache-blocked, see TiledTranspose.
+ *
  * Source dimension `perm[i]` goes to destination dimension `i`.
  */
 template <typename T>
 void TransposeGrouped(const TensorView<StorageCPU, T> &dst,
                       const TensorView<StorageCPU, const T> &src, span<const int> perm) {
-  int N = src.shape.sample_dim();
-  auto src_shape = src.shape;
-  TensorShape<> collapsed_src_shape;
-  SmallVector<int, DynamicTensorShapeContainer::static_size> collapsed_perm;
-  transpose_impl::SimplifyPermute(collapsed_src_shape, collapsed_perm, src.shape, perm);
-  auto collapsed_dst_shape = permute(collapsed_src_shape, collapsed_perm);
-  Transpose(TensorView<StorageCPU, T>{dst.data, collapsed_dst_shape},
-            TensorView<StorageCPU, const T>{src.data, collapsed_src_shape},
-            make_cspan(collapsed_perm));
+  TiledTranspose<T>(dst.data, src.data, src.shape, perm).Run();
 }
 
 }  // namespace kernels
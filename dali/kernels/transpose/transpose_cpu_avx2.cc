@@ -0,0 +1,146 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/kernels/transpose/transpose_cpu_simd.h"
+
+#if DALI_CPU_DISPATCH_X86
+
+#include <immintrin.h>
+#include <cstdint>
+#include "dali/core/force_inline.h"
+
+DALI_CPU_TARGET_BEGIN_AVX2
+
+namespace dali {
+namespace kernels {
+namespace transpose_simd {
+namespace {
+
+DALI_FORCEINLINE __m128i Load128(const void *src, int64_t offset_bytes) {
+  return _mm_loadu_si128(
+      reinterpret_cast<const __m128i *>(static_cast<const uint8_t *>(src) + offset_bytes));
+}
+
+DALI_FORCEINLINE void Store128(void *dst, int64_t offset_bytes, __m128i v) {
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(static_cast<uint8_t *>(dst) + offset_bytes), v);
+}
+
+/** Transposes 8x8 16-bit elements, in place */
+DALI_FORCEINLINE void Transpose8x8x16(__m128i *r) {
+  __m128i a[8], b[8];
+  for (int i = 0; i < 4; i++) {
+    a[2 * i] = _mm_unpacklo_epi16(r[2 * i], r[2 * i + 1]);
+    a[2 * i + 1] = _mm_unpackhi_epi16(r[2 * i], r[2 * i + 1]);
+  }
+  // a[0], a[2], a[4], a[6] hold columns 0-3 of the row pairs; a[odd] hold columns 4-7
+  for (int h = 0; h < 2; h++) {
+    for (int i = 0; i < 2; i++) {
+      b[4 * h + 2 * i] = _mm_unpacklo_epi32(a[h + 4 * i], a[h + 4 * i + 2]);
+      b[4 * h + 2 * i + 1] = _mm_unpackhi_epi32(a[h + 4 * i], a[h + 4 * i + 2]);
+    }
+  }
+  // b[4 * h + 2 * i + q] holds columns 4 * h + 2 * q and 4 * h + 2 * q + 1
+  // of rows 4 * i to 4 * i + 3
+  for (int h = 0; h < 2; h++) {
+    for (int q = 0; q < 2; q++) {
+      r[4 * h + 2 * q] = _mm_unpacklo_epi64(b[4 * h + q], b[4 * h + 2 + q]);
+      r[4 * h + 2 * q + 1] = _mm_unpackhi_epi64(b[4 * h + q], b[4 * h + 2 + q]);
+    }
+  }
+}
+
+void Transpose16x16x8(void *dst, int64_t dst_stride, const void *src, int64_t src_stride) {
+  __m128i lo[8], hi[8];
+  // interleaving the pairs of rows gives 16-bit elements, which are transposed 8x8
+  for (int i = 0; i < 8; i++) {
+    __m128i r0 = Load128(src, (2 * i) * src_stride);
+    __m128i r1 = Load128(src, (2 * i + 1) * src_stride);
+    lo[i] = _mm_unpacklo_epi8(r0, r1);
+    hi[i] = _mm_unpackhi_epi8(r0, r1);
+  }
+  Transpose8x8x16(lo);
+  Transpose8x8x16(hi);
+  for (int i = 0; i < 8; i++) {
+    Store128(dst, i * dst_stride, lo[i]);
+    Store128(dst, (i + 8) * dst_stride, hi[i]);
+  }
+}
+
+void Transpose8x8x16(void *dst, int64_t dst_stride, const void *src, int64_t src_stride) {
+  __m128i r[8];
+  for (int i = 0; i < 8; i++)
+    r[i] = Load128(src, i * src_stride * 2);
+  Transpose8x8x16(r);
+  for (int i = 0; i < 8; i++)
+    Store128(dst, i * dst_stride * 2, r[i]);
+}
+
+void Transpose8x8x32(void *dst, int64_t dst_stride, const void *src, int64_t src_stride) {
+  auto *in = static_cast<const float *>(src);
+  auto *out = static_cast<float *>(dst);
+  // only the data movement instructions are used, so any 32-bit type can be handled as float
+  __m256 r[8], t[8];
+  for (int i = 0; i < 8; i++)
+    r[i] = _mm256_loadu_ps(in + i * src_stride);
+  for (int i = 0; i < 4; i++) {
+    t[2 * i] = _mm256_unpacklo_ps(r[2 * i], r[2 * i + 1]);
+    t[2 * i + 1] = _mm256_unpackhi_ps(r[2 * i], r[2 * i + 1]);
+  }
+  for (int i = 0; i < 2; i++) {
+    r[4 * i + 0] = _mm256_shuffle_ps(t[4 * i], t[4 * i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+    r[4 * i + 1] = _mm256_shuffle_ps(t[4 * i], t[4 * i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+    r[4 * i + 2] = _mm256_shuffle_ps(t[4 * i + 1], t[4 * i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+    r[4 * i + 3] = _mm256_shuffle_ps(t[4 * i + 1], t[4 * i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+  }
+  // each 128-bit lane now holds a 4x4 block; the lanes of the row quads are exchanged
+  for (int i = 0; i < 4; i++) {
+    _mm256_storeu_ps(out + i * dst_stride, _mm256_permute2f128_ps(r[i], r[i + 4], 0x20));
+    _mm256_storeu_ps(out + (i + 4) * dst_stride, _mm256_permute2f128_ps(r[i], r[i + 4], 0x31));
+  }
+}
+
+}  // namespace
+}  // namespace transpose_simd
+}  // namespace kernels
+}  // namespace dali
+
+DALI_CPU_TARGET_END
+
+namespace dali {
+namespace kernels {
+namespace transpose_simd {
+
+template <>
+void TransposeTileImpl<CpuIsa::AVX2, 1>(void *dst, int64_t dst_stride,
+                                        const void *src, int64_t src_stride) {
+  Transpose16x16x8(dst, dst_stride, src, src_stride);
+}
+
+template <>
+void TransposeTileImpl<CpuIsa::AVX2, 2>(void *dst, int64_t dst_stride,
+                                        const void *src, int64_t src_stride) {
+  Transpose8x8x16(dst, dst_stride, src, src_stride);
+}
+
+template <>
+void TransposeTileImpl<CpuIsa::AVX2, 4>(void *dst, int64_t dst_stride,
+                                        const void *src, int64_t src_stride) {
+  Transpose8x8x32(dst, dst_stride, src, src_stride);
+}
+
+}  // namespace transpose_simd
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_CPU_DISPATCH_X86
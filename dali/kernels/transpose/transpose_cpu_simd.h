@@ -0,0 +1,80 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_TRANSPOSE_TRANSPOSE_CPU_SIMD_H_
+#define DALI_KERNELS_TRANSPOSE_TRANSPOSE_CPU_SIMD_H_
+
+#include <cstdint>
+#include "dali/core/api_helper.h"
+#include "dali/kernels/common/cpu_isa.h"
+
+// In-register transposition of small square tiles, selected at run time (see cpu_isa.h).
+// There are variants for 1-, 2- and 4-byte elements; the tiles of other types are transposed
+// with scalar code.
+
+namespace dali {
+namespace kernels {
+namespace transpose_simd {
+
+/** The extent of the tile transposed in registers */
+template <int elem_size>
+constexpr int kTileSize = elem_size == 1 ? 16 : 8;
+
+/**
+ * @brief Transposes a kTileSize x kTileSize tile.
+ *
+ * `dst[i * dst_stride + j] = src[j * src_stride + i]`; the strides are in elements.
+ */
+template <CpuIsa isa, int elem_size>
+DLL_PUBLIC void TransposeTileImpl(void *dst, int64_t dst_stride,
+                                  const void *src, int64_t src_stride);
+
+using TransposeTileFunc = void (*)(void *dst, int64_t dst_stride,
+                                   const void *src, int64_t src_stride);
+
+#if DALI_CPU_DISPATCH_X86
+template <>
+DLL_PUBLIC void TransposeTileImpl<CpuIsa::AVX2, 1>(void *, int64_t, const void *, int64_t);
+template <>
+DLL_PUBLIC void TransposeTileImpl<CpuIsa::AVX2, 2>(void *, int64_t, const void *, int64_t);
+template <>
+DLL_PUBLIC void TransposeTileImpl<CpuIsa::AVX2, 4>(void *, int64_t, const void *, int64_t);
+#endif
+
+/**
+ * @brief Returns the best available variant of `TransposeTileImpl` for given element size
+ *
+ * If there's none, nullptr is returned.
+ */
+template <int elem_size>
+TransposeTileFunc GetTransposeTileFunc() {
+#if DALI_CPU_DISPATCH_X86
+  if constexpr (elem_size == 1 || elem_size == 2 || elem_size == 4) {
+    return DispatchCpuIsa([](auto isa) -> TransposeTileFunc {
+      // the AVX-512 machines use the AVX2 code - the tiles are too small for wider vectors
+      if constexpr (isa() == CpuIsa::Baseline)
+        return nullptr;
+      else
+        return &TransposeTileImpl<CpuIsa::AVX2, elem_size>;
+    });
+  }
+#endif
+  return nullptr;
+}
+
+}  // namespace transpose_simd
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_TRANSPOSE_TRANSPOSE_CPU_SIMD_H_
@@ -0,0 +1,74 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "dali/core/tensor_shape_print.h"
+#include "dali/kernels/transpose/transpose.h"
+#include "dali/kernels/transpose/transpose_test.h"
+
+namespace dali {
+namespace kernels {
+
+template <typename T>
+class TiledTransposeTest : public ::testing::Test {
+ protected:
+  void RunTest(const TensorShape<> &shape, span<const int> perm) {
+    int64_t n = volume(shape);
+    std::vector<T> in(n), out(n), ref(n);
+    std::mt19937_64 rng(1234);
+    for (auto &x : in)
+      x = static_cast<T>(rng());
+    testing::RefTranspose(ref.data(), in.data(), shape.data(), perm.data(), shape.size());
+
+    TiledTranspose<T> transpose(out.data(), in.data(), shape, perm);
+    transpose.Run();
+    ASSERT_EQ(out, ref) << "shape: " << shape;
+
+    // split the blocks into uneven ranges, as when running in multiple threads
+    std::fill(out.begin(), out.end(), T());
+    int64_t num_blocks = transpose.NumBlocks();
+    for (int64_t begin = 0, step = 1; begin < num_blocks; begin += step, step += 2)
+      transpose.Run(begin, std::min(num_blocks, begin + step));
+    ASSERT_EQ(out, ref) << "shape: " << shape << " (split)";
+  }
+};
+
+using TiledTransposeTypes = ::testing::Types<uint8_t, uint16_t, float, double>;
+TYPED_TEST_SUITE(TiledTransposeTest, TiledTransposeTypes);
+
+TYPED_TEST(TiledTransposeTest, Transpose2D) {
+  int perm[] = { 1, 0 };
+  for (auto shape : { TensorShape<>{1, 1}, TensorShape<>{16, 16}, TensorShape<>{33, 70},
+                      TensorShape<>{257, 129}, TensorShape<>{3, 1000} })
+    this->RunTest(shape, make_cspan(perm));
+}
+
+TYPED_TEST(TiledTransposeTest, Transpose4DAll) {
+  TensorShape<> shape = { 19, 7, 35, 5 };
+  for (auto &perm : testing::Permutations4)
+    this->RunTest(shape, make_cspan(perm));
+}
+
+TYPED_TEST(TiledTransposeTest, HWC2CHW) {
+  int perm[] = { 2, 0, 1 };
+  this->RunTest({ 123, 97, 3 }, make_cspan(perm));
+  int inv_perm[] = { 1, 2, 0 };
+  this->RunTest({ 3, 123, 97 }, make_cspan(inv_perm));
+}
+
+}  // namespace kernels
+}  // namespace dali
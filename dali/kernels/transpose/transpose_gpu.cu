@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -14,6 +14,7 @@
 
 #include "dali/kernels/transpose/transpose_gpu.h"
 #include <cuda_runtime.h>
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include "dali/core/util.h"
@@ -36,6 +37,7 @@ struct TransposeInfo {
 
 constexpr int kMaxInterleaveSize = 32;
 constexpr int kMaxDeinterleaveSize = kMaxInterleaveSize;
+constexpr int kMaxGenericVectorSize = 16;
 
 inline bool UseTiledTranspose(const int64_t *shape, const int *perm, int ndim, int element_size) {
   if (perm[ndim-1] == ndim - 1) {
@@ -77,6 +79,25 @@ TransposeMethod GetTransposeMethod(const int64_t *shape,
   return TransposeMethod::Generic;
 }
 
+/**
+ * @brief Calculates the widest vector, in bytes, which the generic transposition can move
+ *        instead of single elements.
+ *
+ * If the innermost dimension is not permuted, the generic transposition can treat a group of
+ * elements in that dimension as a single, wider element - as long as the extent of the dimension
+ * is divisible by the group size.
+ */
+inline int GenericTransposeVectorSize(const TransposeInfo &info) {
+  int ndim = info.shape.size();
+  if (ndim == 0 || info.perm[ndim-1] != ndim - 1)
+    return info.element_size;
+  int64_t inner_size = info.shape[ndim-1] * info.element_size;
+  int vec_size = kMaxGenericVectorSize;
+  while (vec_size > info.element_size && inner_size % vec_size != 0)
+    vec_size >>= 1;
+  return vec_size;
+}
+
 void GetTransposeInfo(TransposeInfo &info, int element_size,
                       span<const int64_t> in_shape, span<const int> perm) {
   SimplifyPermute(info.shape, info.perm, in_shape.data(), perm.data(), in_shape.size());
@@ -90,6 +111,13 @@ void GetTransposeInfo(TransposeInfo &info, int element_size,
 void GetTransposeInfo(TransposeInfo *infos, int element_size,
                       const TensorListShape<> &tls, span<const int> perm) {
   int N = tls.num_samples();
+  if (N > 0 && is_uniform(tls)) {
+    // the simplified permutation and the method depend only on the shape
+    GetTransposeInfo(infos[0], element_size, tls.tensor_shape_span(0), perm);
+    for (int i = 1; i < N; i++)
+      infos[i] = infos[0];
+    return;
+  }
   for (int i = 0; i < N; i++) {
     GetTransposeInfo(infos[i], element_size, tls.tensor_shape_span(i), perm);
   }
@@ -124,6 +152,7 @@ class TransposeGPU::Impl {
     tiled_descs_.reserve(infos_.size());
     deinterleave_descs_.reserve(infos_.size());
     generic_descs_.reserve(infos_.size());
+    generic_vec_size_ = kMaxGenericVectorSize;
 
     for (int i = 0; i < N; i++) {
       auto &shape = infos_[i].shape;
@@ -148,15 +177,12 @@ class TransposeGPU::Impl {
         case TransposeMethod::Interleave:  // no specialized implementation yet
         case TransposeMethod::Copy:  // generic kernel does a good job at just copying
         default:
-          {
-            GenericTransposeDesc<T> desc;
-            InitGenericTranspose(desc, shape, perm);
-            AddDesc(desc);
-            idx_generic_.push_back(i);
-          }
+          generic_vec_size_ = std::min(generic_vec_size_, GenericTransposeVectorSize(infos_[i]));
+          idx_generic_.push_back(i);
           break;
       }
     }
+    InitGenericDescs(generic_vec_size_);
 
     KernelRequirements req;
     req.output_shapes = { out_shape_ };
@@ -203,10 +229,24 @@ class TransposeGPU::Impl {
   }
 
 
-  template <typename T>
-  void AddDesc(const GenericTransposeDesc<T> &desc) {
-    generic_descs_.push_back(reinterpret_cast<const GenericTransposeDesc<void> &>(desc));
+  /**
+   * @brief Initializes the descriptors of the generic transposition, in terms of `vec_size`-byte
+   *        vectors.
+   */
+  void InitGenericDescs(int vec_size) {
+    generic_vec_size_ = vec_size;
+    generic_descs_.clear();
+    for (int i : idx_generic_) {
+      auto &info = infos_[i];
+      TensorShape<> shape = info.shape;
+      if (vec_size > info.element_size)
+        shape[shape.size() - 1] /= vec_size / info.element_size;
+      GenericTransposeDesc<void> desc;
+      InitGenericTranspose(desc, shape, make_span(info.perm));
+      generic_descs_.push_back(desc);
+    }
   }
+
   template <typename T>
   void AddDesc(const DeinterleaveDesc<T> &desc) {
     deinterleave_descs_.push_back(reinterpret_cast<const DeinterleaveDesc<void> &>(desc));
@@ -218,22 +258,41 @@ class TransposeGPU::Impl {
 
   template <typename T>
   void RunGeneric(KernelContext &ctx, T *const *out, const T *const *in) {
-    if (!generic_descs_.empty()) {
-      uint64_t max_size = 0;
-      int block_size = 256;
-      for (size_t i = 0; i < generic_descs_.size(); i++) {
-        generic_descs_[i].out = out[idx_generic_[i]];
-        generic_descs_[i].in =  in[idx_generic_[i]];
-        if (generic_descs_[i].size > max_size)
-          max_size = generic_descs_[i].size;
-      }
-      auto *gpu_descs = reinterpret_cast<GenericTransposeDesc<T>*>(
-        std::get<0>(ctx.scratchpad->ToContiguousGPU(ctx.gpu.stream, generic_descs_)));
-
-      dim3 grid(div_ceil(max_size, block_size * 8), generic_descs_.size());
+    if (generic_descs_.empty())
+      return;
+    if (generic_vec_size_ > static_cast<int>(sizeof(T))) {
+      uintptr_t addr_bits = 0;
+      for (int i : idx_generic_)
+        addr_bits |= reinterpret_cast<uintptr_t>(out[i]) | reinterpret_cast<uintptr_t>(in[i]);
+      if (addr_bits % generic_vec_size_ != 0)
+        InitGenericDescs(sizeof(T));  // misaligned - fall back to moving single elements
+    }
+    VALUE_SWITCH(generic_vec_size_, static_vec_size, (1, 2, 4, 8, 16), (
+        using Vec = type_of_size<static_vec_size>;
+        RunGenericImpl(ctx, reinterpret_cast<Vec *const *>(out),
+                       reinterpret_cast<const Vec *const *>(in));
+      ), (  // NOLINT
+        assert(!"Unreachable code");
+      )  // NOLINT
+    );   // NOLINT
+  }
 
-      TransposeGenericBatch<<<grid, block_size, 0, ctx.gpu.stream>>>(gpu_descs);
+  template <typename T>
+  void RunGenericImpl(KernelContext &ctx, T *const *out, const T *const *in) {
+    uint64_t max_size = 0;
+    int block_size = 256;
+    for (size_t i = 0; i < generic_descs_.size(); i++) {
+      generic_descs_[i].out = out[idx_generic_[i]];
+      generic_descs_[i].in =  in[idx_generic_[i]];
+      if (generic_descs_[i].size > max_size)
+        max_size = generic_descs_[i].size;
     }
+    auto *gpu_descs = reinterpret_cast<GenericTransposeDesc<T>*>(
+      std::get<0>(ctx.scratchpad->ToContiguousGPU(ctx.gpu.stream, generic_descs_)));
+
+    dim3 grid(div_ceil(max_size, block_size * 8), generic_descs_.size());
+
+    TransposeGenericBatch<<<grid, block_size, 0, ctx.gpu.stream>>>(gpu_descs);
   }
 
   template <typename T>
@@ -294,6 +353,7 @@ class TransposeGPU::Impl {
   }
 
   int element_size_ = 0;
+  int generic_vec_size_ = 0;  // the size, in bytes, of the vectors moved by the generic kernel
   TensorListShape<> in_shape_, out_shape_;
   std::vector<TransposeInfo> infos_;
   std::vector<GenericTransposeDesc<void>> generic_descs_;
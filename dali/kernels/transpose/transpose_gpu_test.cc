@@ -1,4 +1,4 @@
-// Copyright (c) 2020, 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020, 2022, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -229,6 +229,35 @@ TEST(TransposeGPU, PerfInterleave) {
   RunPerfTest<uint8_t>(rng, shape, make_span(perm));
 }
 
+TEST(TransposeGPU, PerfGenericVectorized) {
+  std::mt19937_64 rng;
+  TensorListShape<> shape;
+  int N = 10;
+  int D = 3;
+
+  int min_extent = 100;
+  int max_extent = 300;
+  int inner = 48;
+  std::uniform_int_distribution<int> shape_dist(min_extent, max_extent);
+
+  int perm[] = { 1, 0, 2 };
+  shape.resize(N, D);
+
+  for (int i = 0; i < N; i++)
+      shape.set_tensor_shape(i, TensorShape<3>{ shape_dist(rng), shape_dist(rng), inner });
+
+  std::cerr << "Permuting 1-byte data; permutation 1 0 2\ninput shape = \n" << shape << "\n";
+
+  RunPerfTest<uint8_t>(rng, shape, make_span(perm));
+}
+
+TEST(TransposeGPU, GenericVectorizedMixed) {
+  std::mt19937_64 rng;
+  // a mix of tiled, generic and copy - the generic ones differ in the size of the inner dimension
+  TensorListShape<3> shape = {{ {30, 50, 6}, {17, 33, 8}, {1, 1, 12}, {40, 41, 4}, {9, 70, 4} }};
+  int perm[] = { 1, 0, 2 };
+  RunPerfTest<int16_t>(rng, shape, make_span(perm));
+}
 
 }  // namespace kernels
 }  // namespace dali
@@ -0,0 +1,544 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "dali/core/boundary.h"
+#include "dali/core/tensor_view.h"
+#include "dali/kernels/audio/mel_scale/mel_filter_bank_args.h"
+#include "dali/kernels/audio/mel_scale/mel_filter_bank_cpu.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/kernel_manager.h"
+#include "dali/kernels/signal/decibel/to_decibels_args.h"
+#include "dali/kernels/signal/decibel/to_decibels_cpu.h"
+#include "dali/kernels/signal/fft/fft_cpu.h"
+#include "dali/kernels/signal/resampling.h"
+#include "dali/kernels/signal/resampling_cpu.h"
+#include "dali/kernels/signal/window/extract_windows_args.h"
+#include "dali/kernels/signal/window/window_functions.h"
+#include "dali/operators/audio/resampling_params.h"
+#include "dali/pipeline/data/views.h"
+#include "dali/pipeline/operator/checkpointing/stateless_operator.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+DALI_SCHEMA(experimental__LogMelSpectrogram)
+  .DocStr(R"(Calculates log-mel features of a 1D signal (for example, audio).
+
+The operator is equivalent to the following chain of operators::
+
+  audio_resample -> preemphasis_filter -> spectrogram -> mel_filter_bank -> to_decibels -> normalize
+
+but each sample is processed from start to finish by one thread: the windows are extracted,
+transformed and reduced to the mel bands in small blocks, so the intermediate results stay
+in the cache and are never materialized for the whole signal.
+
+Input data is expected to be one channel (shape being ``(nsamples,)``, ``(nsamples, 1)``, or
+``(1, nsamples)``) of type float32.)")
+  .NumInput(1)
+  .NumOutput(1)
+  .AddOptionalArg("sample_rate",
+    R"(Sampling rate of the input signal.)",
+    44100.0f, true)
+  .AddOptionalArg<float>("resample_rate",
+    R"(If specified, the signal is resampled from ``sample_rate`` to this rate first
+and the mel filters are calculated for this rate.)",
+    nullptr)
+  .AddOptionalArg("quality", R"(Resampling quality, where 0 is the lowest, and 100 is
+the highest.
+
+0 gives 3 lobes of the sinc filter, 50 gives 16 lobes, and 100 gives 64 lobes.)",
+    50.0f)
+  .AddOptionalArg("preemph_coeff",
+    R"(Preemphasis coefficient. The value 0 disables the preemphasis filter.
+
+See :meth:`preemphasis_filter` for details.)",
+    0.97f, true)
+  .AddOptionalArg("border",
+    R"(Border value policy of the preemphasis filter. Possible values are \"zero\", \"clamp\",
+\"reflect\".)",
+    "clamp")
+  .AddOptionalArg<int>("nfft",
+    R"(Size of the FFT.
+
+If not specified, ``window_length`` is used.)",
+    nullptr)
+  .AddOptionalArg("window_length",
+    R"(Window size in number of samples.)",
+    512)
+  .AddOptionalArg("window_step",
+    R"(Step between the STFT windows in number of samples.)",
+    256)
+  .AddOptionalArg("window_fn",
+    R"(Samples of the window function that will be multiplied to each extracted window when
+calculating the STFT.
+
+If a value is provided, it should be a list of floating point numbers of size ``window_length``.
+If a value is not provided, a Hann window will be used.)",
+    std::vector<float>{})
+  .AddOptionalArg("power",
+    R"(Exponent of the magnitude of the spectrum.
+
+Supported values:
+
+- ``1`` - amplitude,
+- ``2`` - power (faster to compute).
+)",
+    2)
+  .AddOptionalArg("center_windows",
+    R"(Indicates whether extracted windows should be padded so that the window function is
+centered at multiples of ``window_step``.)",
+    true)
+  .AddOptionalArg("reflect_padding",
+    R"(Indicates the padding policy when sampling outside the bounds of the signal.
+
+If set to True, the signal is mirrored with respect to the boundary, otherwise the signal
+is padded with zeros. When ``center_windows`` is set to False, this option is ignored.)",
+    true)
+  .AddOptionalArg("nfilter",
+    R"(Number of mel filters.)",
+    128)
+  .AddOptionalArg("freq_low",
+    R"(The minimum frequency.)",
+    0.0f)
+  .AddOptionalArg("freq_high",
+    R"(The maximum frequency.
+
+If this value is not provided, half of the sampling rate is used.)",
+    0.0f)
+  .AddOptionalArg("normalize",
+    R"(Determines whether to normalize the triangular filter weights by the width
+of their frequency bands.
+
+See :meth:`mel_filter_bank` for details.)",
+    true)
+  .AddOptionalArg("mel_formula",
+    R"(Determines the formula that will be used to convert frequencies from hertz to mel
+and from mel to hertz. Supported values are ``slaney`` and ``htk``.
+
+See :meth:`mel_filter_bank` for details.)",
+    "slaney")
+  .AddOptionalArg("multiplier",
+    R"(Factor by which the logarithm is multiplied.)",
+    10.0f)
+  .AddOptionalArg<float>("reference",
+    R"(Reference magnitude.
+
+If a value is not provided, the maximum value of the mel spectrogram will be used as reference.)",
+    nullptr)
+  .AddOptionalArg("cutoff_db",
+    R"(Minimum or cut-off ratio in dB.)",
+    -200.0f)
+  .AddOptionalArg("feature_normalization",
+    R"(Normalization of the log-mel features.
+
+Supported values:
+
+- ``none`` - the features are not normalized,
+- ``per_feature`` - each mel band is normalized to zero mean and unit variance along
+  the time axis,
+- ``all`` - the whole sample is normalized to zero mean and unit variance.
+)",
+    "none")
+  .AddOptionalArg("epsilon",
+    R"(A value added to the variance when normalizing the features.
+
+If the variance and the epsilon are both 0, the normalized values are 0.)",
+    0.0f)
+  .AddOptionalArg("layout", R"(Output layout: "ft" (frequency-major) or "tf" (time-major).)",
+    TensorLayout("ft"));
+
+class LogMelSpectrogramCPU : public StatelessOperator<CPUBackend> {
+ public:
+  explicit LogMelSpectrogramCPU(const OpSpec &spec);
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override;
+  void RunImpl(Workspace &ws) override;
+
+ private:
+  enum class BorderType { Zero, Clamp, Reflect };
+  enum class FeatureNormalization { None, PerFeature, All };
+
+  using FftKernel = kernels::signal::fft::Fft1DCpu<float, float, 2>;
+  using MelKernel = kernels::audio::MelFilterBankCpu<float>;
+  using DecibelsKernel = kernels::signal::ToDecibelsCpu<float>;
+
+  /**
+   * @brief The number of windows processed together by the FFT and the mel filter bank
+   */
+  static constexpr int kBlockSize = 64;
+
+  struct ThreadBuffers {
+    std::vector<float> signal;
+    std::vector<float> windows;
+    std::vector<float> spectrum;
+    std::vector<float> mel;
+  };
+
+  void RunSample(int thread_idx, int sample_idx, float *out, const float *in, int64_t in_len);
+
+  /**
+   * @brief Extracts `nwin` windows, starting at window `first_win`, from the preemphasized signal
+   */
+  void ExtractWindows(float *windows, int64_t first_win, int nwin,
+                      const float *signal, int64_t length, float coeff) const;
+
+  void NormalizeFeatures(float *data, int64_t nwin) const;
+
+  bool NeedsResampling(int sample_idx) const {
+    return resample_rate_ > 0 && resample_rate_ != sample_rate_[sample_idx];
+  }
+
+  /**
+   * @brief The length of the signal after resampling (if any)
+   */
+  int64_t SignalLength(int sample_idx, int64_t in_len) const {
+    if (!NeedsResampling(sample_idx))
+      return in_len;
+    return kernels::signal::resampling::resampled_length(in_len, sample_rate_[sample_idx],
+                                                         resample_rate_);
+  }
+
+  std::vector<float> sample_rate_;
+  std::vector<float> preemph_coeff_;
+
+  float resample_rate_ = 0;  // 0 means no resampling
+  kernels::signal::resampling::ResamplerCPU resampler_;
+  BorderType border_type_ = BorderType::Clamp;
+
+  int window_length_ = -1;
+  int window_step_ = -1;
+  int window_center_ = 0;
+  int nfft_ = -1;
+  bool centered_ = true;
+  bool reflect_padding_ = true;
+  std::vector<float> window_fn_;
+  kernels::signal::fft::FftArgs fft_args_;
+
+  kernels::audio::MelFilterBankArgs mel_args_;
+  kernels::signal::ToDecibelsArgs<float> db_args_;
+
+  FeatureNormalization normalization_ = FeatureNormalization::None;
+  float epsilon_ = 0;
+  bool time_major_ = false;
+  TensorLayout layout_;
+
+  // one kernel instance per thread
+  kernels::KernelManager kmgr_fft_, kmgr_mel_, kmgr_db_;
+  std::vector<ThreadBuffers> buffers_;
+};
+
+LogMelSpectrogramCPU::LogMelSpectrogramCPU(const OpSpec &spec)
+    : StatelessOperator<CPUBackend>(spec)
+    , window_length_(spec.GetArgument<int>("window_length"))
+    , window_step_(spec.GetArgument<int>("window_step"))
+    , window_fn_(spec.GetRepeatedArgument<float>("window_fn")) {
+  DALI_ENFORCE(window_length_ > 0, make_string("Invalid window length: ", window_length_));
+  DALI_ENFORCE(window_step_ > 0, make_string("Invalid window step: ", window_step_));
+  nfft_ = spec.HasArgument("nfft") ? spec.GetArgument<int>("nfft") : window_length_;
+  DALI_ENFORCE(window_length_ <= nfft_, make_string(
+    "Window length (", window_length_, ") can't be bigger than the FFT size (", nfft_, ")"));
+
+  if (window_fn_.empty()) {
+    window_fn_.resize(window_length_);
+    kernels::signal::HannWindow(make_span(window_fn_));
+  }
+  DALI_ENFORCE(window_fn_.size() == static_cast<size_t>(window_length_),
+    "Window function should match the specified `window_length`");
+
+  centered_ = spec.GetArgument<bool>("center_windows");
+  reflect_padding_ = spec.GetArgument<bool>("reflect_padding");
+  window_center_ = centered_ ? window_length_ / 2 : 0;
+
+  fft_args_.nfft = nfft_;
+  fft_args_.transform_axis = 1;
+  int power = spec.GetArgument<int>("power");
+  switch (power) {
+    case 1:
+      fft_args_.spectrum_type = kernels::signal::fft::FFT_SPECTRUM_MAGNITUDE;
+      break;
+    case 2:
+      fft_args_.spectrum_type = kernels::signal::fft::FFT_SPECTRUM_POWER;
+      break;
+    default:
+      DALI_FAIL(make_string("`power` can be only 1 (energy) or 2 (power), received ", power));
+  }
+
+  if (spec.HasArgument("resample_rate")) {
+    resample_rate_ = spec.GetArgument<float>("resample_rate");
+    DALI_ENFORCE(resample_rate_ > 0, make_string("Invalid resample rate: ", resample_rate_));
+    auto params = audio::ResamplingParams::FromQuality(spec.GetArgument<float>("quality"));
+    resampler_.Initialize(params.lobes, params.lookup_size);
+  }
+
+  auto border = spec.GetArgument<std::string>("border");
+  if (border == "zero") {
+    border_type_ = BorderType::Zero;
+  } else if (border == "clamp") {
+    border_type_ = BorderType::Clamp;
+  } else if (border == "reflect") {
+    border_type_ = BorderType::Reflect;
+  } else {
+    DALI_FAIL(make_string("``border`` mode \"", border, "\" is not supported."));
+  }
+
+  mel_args_.nfilter = spec.GetArgument<int>("nfilter");
+  DALI_ENFORCE(mel_args_.nfilter > 0, "number of filters should be > 0");
+  mel_args_.freq_low = spec.GetArgument<float>("freq_low");
+  DALI_ENFORCE(mel_args_.freq_low >= 0.0f, "freq_low should be >= 0");
+  mel_args_.freq_high = spec.GetArgument<float>("freq_high");
+  mel_args_.normalize = spec.GetArgument<bool>("normalize");
+  mel_args_.nfft = nfft_;
+  mel_args_.axis = 1;
+  auto mel_formula = spec.GetArgument<std::string>("mel_formula");
+  if (mel_formula == "htk") {
+    mel_args_.mel_formula = kernels::audio::MelScaleFormula::HTK;
+  } else if (mel_formula == "slaney") {
+    mel_args_.mel_formula = kernels::audio::MelScaleFormula::Slaney;
+  } else {
+    DALI_FAIL(make_string("Unsupported mel_formula value \"", mel_formula,
+      "\". Supported values are: \"slaney\", \"htk\""));
+  }
+
+  db_args_.multiplier = spec.GetArgument<float>("multiplier");
+  db_args_.ref_max = !spec.HasArgument("reference");
+  if (!db_args_.ref_max) {
+    db_args_.s_ref = spec.GetArgument<float>("reference");
+    DALI_ENFORCE(db_args_.s_ref != 0, "`reference` argument can't be zero");
+  }
+  auto cutoff_db = spec.GetArgument<float>("cutoff_db");
+  db_args_.min_ratio = std::pow(10.0f, cutoff_db / db_args_.multiplier);
+  if (db_args_.min_ratio == 0)
+    db_args_.min_ratio = std::nextafter(0.0f, 1.0f);
+
+  auto normalization = spec.GetArgument<std::string>("feature_normalization");
+  if (normalization == "none") {
+    normalization_ = FeatureNormalization::None;
+  } else if (normalization == "per_feature") {
+    normalization_ = FeatureNormalization::PerFeature;
+  } else if (normalization == "all") {
+    normalization_ = FeatureNormalization::All;
+  } else {
+    DALI_FAIL(make_string("Unsupported feature_normalization value \"", normalization,
+      "\". Supported values are: \"none\", \"per_feature\", \"all\""));
+  }
+  epsilon_ = spec.GetArgument<float>("epsilon");
+  DALI_ENFORCE(epsilon_ >= 0, make_string("`epsilon` must not be negative. Got: ", epsilon_));
+
+  layout_ = spec.GetArgument<TensorLayout>("layout");
+  DALI_ENFORCE(layout_ == "tf" || layout_ == "ft",
+               make_string("Unexpected layout: ", layout_));
+  time_major_ = layout_ == "tf";
+}
+
+bool LogMelSpectrogramCPU::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                     const Workspace &ws) {
+  const auto &input = ws.Input<CPUBackend>(0);
+  DALI_ENFORCE(input.type() == DALI_FLOAT,
+               make_string("Unsupported input type: ", input.type(), ". Expected float."));
+  auto in_shape = input.shape();
+  int nsamples = input.num_samples();
+  int nthreads = ws.GetThreadPool().NumThreads();
+
+  // Check that input is 1-D (allowing having extra dims with extent 1)
+  if (in_shape.sample_dim() > 1) {
+    for (int i = 0; i < nsamples; i++) {
+      auto shape = in_shape.tensor_shape(i);
+      auto n = volume(shape);
+      for (auto extent : shape) {
+        DALI_ENFORCE(extent == 1 || extent == n, make_string("Input data must be 1D or all "
+          "but one dimensions must be degenerate (extent 1). Got: ", shape));
+      }
+    }
+  }
+
+  GetPerSampleArgument(sample_rate_, "sample_rate", ws, nsamples);
+  GetPerSampleArgument(preemph_coeff_, "preemph_coeff", ws, nsamples);
+
+  output_desc.resize(1);
+  output_desc[0].type = DALI_FLOAT;
+  output_desc[0].shape.resize(nsamples, 2);
+  for (int i = 0; i < nsamples; i++) {
+    float in_rate = sample_rate_[i];
+    DALI_ENFORCE(in_rate > 0, make_string("Invalid sample rate: ", in_rate, " for sample ", i));
+    float rate = resample_rate_ > 0 ? resample_rate_ : in_rate;
+    float freq_high = mel_args_.freq_high > 0 ? mel_args_.freq_high : 0.5f * rate;
+    DALI_ENFORCE(freq_high > mel_args_.freq_low && freq_high <= rate, make_string(
+      "freq_high should be within the range (freq_low, sample_rate/2]. Got freq_low: ",
+      mel_args_.freq_low, ", freq_high: ", freq_high, " for sample ", i));
+
+    int64_t length = SignalLength(i, in_shape[i].num_elements());
+    int64_t nwin = kernels::signal::num_windows(length, window_length_, window_step_, centered_);
+    DALI_ENFORCE(nwin > 0, make_string("Signal is too short (", length, ") for sample ", i));
+    if (time_major_)
+      output_desc[0].shape.set_tensor_shape(i, {nwin, mel_args_.nfilter});
+    else
+      output_desc[0].shape.set_tensor_shape(i, {mel_args_.nfilter, nwin});
+  }
+
+  buffers_.resize(nthreads);
+  kmgr_fft_.Resize<FftKernel>(nthreads);
+  kmgr_mel_.Resize<MelKernel>(nthreads);
+  kmgr_db_.Resize<DecibelsKernel>(nthreads);
+  return true;
+}
+
+void LogMelSpectrogramCPU::ExtractWindows(float *windows, int64_t first_win, int nwin,
+                                          const float *signal, int64_t length,
+                                          float coeff) const {
+  float border = 0;
+  if (border_type_ == BorderType::Clamp)
+    border = signal[0];
+  else if (border_type_ == BorderType::Reflect && length > 1)
+    border = signal[1];
+
+  // the signal after the preemphasis filter
+  auto filtered = [&](int64_t idx) {
+    return signal[idx] - coeff * (idx > 0 ? signal[idx - 1] : border);
+  };
+
+  for (int w = 0; w < nwin; w++) {
+    float *out = windows + static_cast<int64_t>(w) * window_length_;
+    int64_t start = (first_win + w) * window_step_ - window_center_;
+    if (start >= 0 && start + window_length_ <= length) {
+      for (int t = 0; t < window_length_; t++)
+        out[t] = window_fn_[t] * filtered(start + t);
+    } else {
+      for (int t = 0; t < window_length_; t++) {
+        int64_t idx = start + t;
+        if (idx >= 0 && idx < length)
+          out[t] = window_fn_[t] * filtered(idx);
+        else if (reflect_padding_)
+          out[t] = window_fn_[t] * filtered(boundary::idx_reflect_101(idx, length));
+        else
+          out[t] = 0;
+      }
+    }
+  }
+}
+
+void LogMelSpectrogramCPU::NormalizeFeatures(float *data, int64_t nwin) const {
+  int nfilter = mel_args_.nfilter;
+  auto normalize = [&](float *start, int64_t n, int64_t stride) {
+    double sum = 0;
+    for (int64_t i = 0; i < n; i++)
+      sum += start[i * stride];
+    double mean = sum / n;
+    double sum_sq = 0;
+    for (int64_t i = 0; i < n; i++) {
+      double d = start[i * stride] - mean;
+      sum_sq += d * d;
+    }
+    double var = sum_sq / n + epsilon_;
+    float inv_stddev = var > 0 ? static_cast<float>(1 / std::sqrt(var)) : 0.0f;
+    float fmean = mean;
+    for (int64_t i = 0; i < n; i++)
+      start[i * stride] = (start[i * stride] - fmean) * inv_stddev;
+  };
+
+  if (normalization_ == FeatureNormalization::All) {
+    normalize(data, nwin * nfilter, 1);
+  } else {
+    for (int f = 0; f < nfilter; f++) {
+      if (time_major_)
+        normalize(data + f, nwin, nfilter);
+      else
+        normalize(data + f * nwin, nwin, 1);
+    }
+  }
+}
+
+void LogMelSpectrogramCPU::RunSample(int thread_idx, int sample_idx,
+                                     float *out, const float *in, int64_t in_len) {
+  auto &buf = buffers_[thread_idx];
+  kernels::KernelContext ctx;
+  kernels::DynamicScratchpad scratchpad({}, AccessOrder::host());
+  ctx.scratchpad = &scratchpad;
+
+  const float *signal = in;
+  int64_t length = SignalLength(sample_idx, in_len);
+  if (NeedsResampling(sample_idx)) {
+    buf.signal.resize(length);
+    resampler_.Resample(buf.signal.data(), 0, length, resample_rate_,
+                        in, in_len, sample_rate_[sample_idx], 1);
+    signal = buf.signal.data();
+  }
+
+  auto mel_args = mel_args_;
+  mel_args.sample_rate = resample_rate_ > 0 ? resample_rate_ : sample_rate_[sample_idx];
+  if (mel_args.freq_high <= 0)
+    mel_args.freq_high = 0.5f * mel_args.sample_rate;
+
+  int nfilter = mel_args.nfilter;
+  int nbins = nfft_ / 2 + 1;
+  int64_t nwin = kernels::signal::num_windows(length, window_length_, window_step_, centered_);
+  buf.windows.resize(kBlockSize * window_length_);
+  buf.spectrum.resize(kBlockSize * nbins);
+  if (!time_major_)
+    buf.mel.resize(kBlockSize * nfilter);
+
+  float coeff = preemph_coeff_[sample_idx];
+  for (int64_t first_win = 0; first_win < nwin; first_win += kBlockSize) {
+    int nblock = std::min<int64_t>(kBlockSize, nwin - first_win);
+    ExtractWindows(buf.windows.data(), first_win, nblock, signal, length, coeff);
+
+    auto windows = make_tensor_cpu<2>(buf.windows.data(), {nblock, window_length_});
+    auto spectrum = make_tensor_cpu<2>(buf.spectrum.data(), {nblock, nbins});
+    kmgr_fft_.Setup<FftKernel>(thread_idx, ctx, windows, fft_args_);
+    kmgr_fft_.Run<FftKernel>(thread_idx, ctx, spectrum, windows, fft_args_);
+
+    // time-major features are produced in place, frequency-major ones are transposed
+    float *mel_ptr = time_major_ ? out + first_win * nfilter : buf.mel.data();
+    auto mel = make_tensor_cpu<2>(mel_ptr, {nblock, nfilter});
+    kmgr_mel_.Setup<MelKernel>(thread_idx, ctx, spectrum, mel_args);
+    kmgr_mel_.Run<MelKernel>(thread_idx, ctx, mel, spectrum);
+    if (!time_major_) {
+      for (int f = 0; f < nfilter; f++)
+        for (int w = 0; w < nblock; w++)
+          out[f * nwin + first_win + w] = mel_ptr[w * nfilter + f];
+    }
+  }
+
+  TensorShape<> out_shape = time_major_ ? TensorShape<>{nwin, nfilter}
+                                        : TensorShape<>{nfilter, nwin};
+  auto features = make_tensor_cpu(out, out_shape);
+  kmgr_db_.Setup<DecibelsKernel>(thread_idx, ctx, features, db_args_);
+  kmgr_db_.Run<DecibelsKernel>(thread_idx, ctx, features, features, db_args_);
+
+  if (normalization_ != FeatureNormalization::None)
+    NormalizeFeatures(out, nwin);
+}
+
+void LogMelSpectrogramCPU::RunImpl(Workspace &ws) {
+  const auto &input = ws.Input<CPUBackend>(0);
+  auto &output = ws.Output<CPUBackend>(0);
+  auto &tp = ws.GetThreadPool();
+  output.SetLayout(layout_);
+
+  for (int i = 0; i < input.num_samples(); i++) {
+    int64_t in_len = input.tensor_shape(i).num_elements();
+    tp.AddWork([this, &input, &output, i, in_len](int thread_idx) {
+      RunSample(thread_idx, i, output.mutable_tensor<float>(i), input.tensor<float>(i), in_len);
+    }, in_len);
+  }
+  tp.RunAll();
+}
+
+DALI_REGISTER_OPERATOR(experimental__LogMelSpectrogram, LogMelSpectrogramCPU, CPU);
+
+}  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -12,10 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include "dali/kernels/reduce/find_region.cuh"
-#include "dali/kernels/reduce/reduce_gpu.h"
+#include <algorithm>
+#include <tuple>
+#include "dali/core/cuda_error.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/reduce/reduce_common.cuh"
+#include "dali/kernels/reduce/reductions.h"
 #include "dali/kernels/signal/decibel/decibel_calculator.h"
-#include "dali/kernels/signal/moving_mean_square_gpu.h"
+#include "dali/kernels/signal/moving_mean_square_gpu.cuh"
 #include "dali/operators/audio/nonsilence_op.h"
 #include "dali/pipeline/data/views.h"
 
@@ -23,55 +27,134 @@ namespace dali {
 
 namespace {
 
+using kernels::signal::acc_t;
+
+template <typename T>
+struct NonsilenceSampleDesc {
+  const T *in;
+  int64_t len;
+  float threshold;  // used when the reference power is given
+  float cutoff_db;
+};
+
 /**
- * @brief Threshold predicate for the nonsilent region.
+ * @brief The per-sample results, accumulated with atomics across the blocks.
+ *
+ * The state is zero-initialized:
+ * - `max_mms` is non-negative, so its bit pattern can be compared as an integer,
+ * - `first` is stored as a bitwise complement, so that the smallest index is the largest value.
  */
-template <typename T>
-struct NotLess {
-  T value_;
+struct NonsilenceState {
+  float max_mms;
+  unsigned long long first_inv;  // NOLINT(runtime/int) - the type used by atomicMax
+  unsigned long long end;        // NOLINT(runtime/int)
+};
 
-  DALI_HOST_DEV DALI_FORCEINLINE bool operator()(T x) const noexcept {
-    return x >= value_;
+/**
+ * @brief Reduces the value across the block; the result is valid in thread 0.
+ *
+ * @remarks The block size must be a multiple of warp size.
+ */
+template <typename T>
+__device__ T BlockMax(T value) {
+  __shared__ T tmp[32];
+  kernels::reductions::max reduce_max;
+  kernels::WarpReduce(value, reduce_max);
+  int lane = threadIdx.x % 32, warp = threadIdx.x / 32;
+  __syncthreads();  // tmp may be still in use by the previous call
+  if (lane == 0)
+    tmp[warp] = value;
+  __syncthreads();
+  if (warp == 0) {
+    value = lane < blockDim.x / 32 ? tmp[lane] : reduce_max.neutral<T>();
+    kernels::WarpReduce(value, reduce_max);
   }
-};
+  return value;
+}
 
-struct InitPredicateSampleArgs {
-  NotLess<float> *predicate;
-  float *ref_pow;
-  float cutoff_db;
-};
+/**
+ * @brief Calculates the maximum of the moving mean square of each sample (in blockIdx.y)
+ */
+template <typename T>
+__global__ void MaxMMSKernel(const NonsilenceSampleDesc<T> *samples, NonsilenceState *states,
+                             int64_t logical_block, int window, int pow2,
+                             kernels::signal::divide mean) {
+  extern __shared__ char shm[];  // allocated on invocation
+  auto *temp = reinterpret_cast<acc_t<T> *>(shm);
+  const auto &sample = samples[blockIdx.y];
+  float max_mms = 0;
+  kernels::signal::SlidingWindowSumBlocks(
+      temp, sample.in, sample.len, logical_block, window, pow2, kernels::signal::square(),
+      [&](int64_t, acc_t<T> sum) {
+        max_mms = cuda_max(max_mms, mean(sum));
+      });
+  max_mms = BlockMax(max_mms);
+  if (threadIdx.x == 0 && max_mms > 0)
+    atomicMax(reinterpret_cast<int *>(&states[blockIdx.y].max_mms), __float_as_int(max_mms));
+}
 
-__global__ void InitPredicates(InitPredicateSampleArgs *sample_params, int nsamples) {
-  for (int idx = threadIdx.x + blockIdx.x * blockDim.x; idx < nsamples;
-       idx += blockDim.x * gridDim.x) {
-    auto &params = sample_params[idx];
-    kernels::signal::DecibelToMagnitude<float> db2mag(10.f, *params.ref_pow);
-    *(params.predicate) = {db2mag(params.cutoff_db)};
+/**
+ * @brief Finds the first and the last position where the moving mean square of each sample
+ *        (in blockIdx.y) reaches the threshold.
+ *
+ * The moving mean square is computed on the fly and is never stored.
+ */
+template <typename T>
+__global__ void FindNonsilentRegionKernel(const NonsilenceSampleDesc<T> *samples,
+                                          NonsilenceState *states, bool reference_max,
+                                          int64_t logical_block, int window, int pow2,
+                                          kernels::signal::divide mean) {
+  extern __shared__ char shm[];  // allocated on invocation
+  auto *temp = reinterpret_cast<acc_t<T> *>(shm);
+  const auto &sample = samples[blockIdx.y];
+  auto &state = states[blockIdx.y];
+  float threshold = sample.threshold;
+  if (reference_max) {
+    kernels::signal::DecibelToMagnitude<float> db2mag(10.f, state.max_mms);
+    threshold = db2mag(sample.cutoff_db);
+  }
+
+  unsigned long long first_inv = 0, end = 0;  // NOLINT(runtime/int)
+  // the positions visited by a thread are increasing
+  kernels::signal::SlidingWindowSumBlocks(
+      temp, sample.in, sample.len, logical_block, window, pow2, kernels::signal::square(),
+      [&](int64_t idx, acc_t<T> sum) {
+        if (mean(sum) >= threshold) {
+          if (!first_inv)
+            first_inv = ~static_cast<unsigned long long>(idx);  // NOLINT(runtime/int)
+          end = idx + 1;
+        }
+      });
+  first_inv = BlockMax(first_inv);
+  end = BlockMax(end);
+  if (threadIdx.x == 0 && end > 0) {
+    atomicMax(&state.first_inv, first_inv);
+    atomicMax(&state.end, end);
   }
 }
 
-template <typename Idx>
 struct NonsilentRegionPostprocessArgs {
-  Idx *begin;
-  Idx *len;
-  const i64vec2 *region;
-  Idx input_len;
+  int32_t *begin;
+  int32_t *len;
 };
 
-template <typename Idx = int64_t>
-__global__ void NonsilentRegionPostprocess(NonsilentRegionPostprocessArgs<Idx> *args, int nsamples,
+__global__ void NonsilentRegionPostprocess(const NonsilentRegionPostprocessArgs *args,
+                                           const NonsilenceState *states, int nsamples,
                                            int window) {
   for (int idx = threadIdx.x + blockIdx.x * blockDim.x; idx < nsamples;
        idx += blockDim.x * gridDim.x) {
-    auto &sample_args = args[idx];
-    auto region = *(sample_args.region);
-    // `begin` is calculated as `first - window + 1`, meaning that we start counting from the
-    // beginning of the sliding window. The length of the region needs to be extended by the same
-    // amount. We also limit the region to the bounds of the input.
-    Idx start = cuda_max<Idx>(region.x - window + 1, 0);
-    Idx end = region.y;
-    *(sample_args.begin) = start;
-    *(sample_args.len) = end - start;
+    const auto &state = states[idx];
+    int64_t start = 0, end = 0;
+    if (state.end > 0) {
+      // `begin` is calculated as `first - window + 1`, meaning that we start counting from the
+      // beginning of the sliding window. The length of the region needs to be extended by the
+      // same amount. We also limit the region to the bounds of the input.
+      int64_t first = ~state.first_inv;
+      start = cuda_max<int64_t>(first - window + 1, 0);
+      end = state.end;
+    }
+    *args[idx].begin = start;
+    *args[idx].len = end - start;
   }
 }
 
@@ -96,132 +179,68 @@ class NonsilenceOperatorGpu : public NonsilenceOperator<GPUBackend> {
   }
 
  private:
-  kernels::MaxGPU<float, float> max_kernel_;
-  using Predicate = NotLess<float>;
-  kernels::FindRegionGPU<float, Predicate> find_region_;
-
-  /**
-   * @brief Computes mean moving mean square of an audio signal
-   */
-  template <typename T>
-  void CalcMMS(TensorListView<StorageGPU, float, 1> &mms,
-               const TensorListView<StorageGPU, const T, 1> &in,
-               cudaStream_t stream) {
-    kernels::DynamicScratchpad scratchpad({}, stream);
-    kernels::KernelContext ctx;
-    ctx.gpu.stream = stream;
-    ctx.scratchpad = &scratchpad;
-
-    kernels::signal::MovingMeanSquareGpu<T> kernel;
-    kernels::signal::MovingMeanSquareArgs args{window_length_, -1};
-    kernel.Run(ctx, mms, in, args);
-  }
-
-  /**
-   * @brief Calculates the maximum value of an input
-   */
-  void CalcMax(TensorListView<StorageGPU, float, 0> &max,
-               const TensorListView<StorageGPU, float, 1> &in,
-               cudaStream_t stream) {
-    kernels::DynamicScratchpad scratchpad({}, stream);
-    kernels::KernelContext ctx;
-    ctx.gpu.stream = stream;
-    ctx.scratchpad = &scratchpad;
-
-    std::array<int, 1> axes = { 0 };
-    max_kernel_.Setup(ctx, in.shape, make_cspan(axes), false, false);
-    max_kernel_.Run(ctx, max, in);
-  }
-
   /**
    * @brief Calculates the beginning and length of the nonsilent region
+   *
+   * The moving mean square is computed on the fly, in one pass over the input to find the
+   * region - or two, if the reference power is the maximum of the moving mean square.
+   * Apart from the outputs, only a few values per sample are stored in memory.
    */
-  void CalcNonsilentRegion(TensorListView<StorageGPU, int32_t, 0> &begin,
-                           TensorListView<StorageGPU, int32_t, 0> &len,
-                           TensorListView<StorageGPU, float, 1> &mms,
-                           cudaStream_t stream) {
-    kernels::DynamicScratchpad scratchpad({}, stream);
-    kernels::KernelContext ctx;
-    ctx.gpu.stream = stream;
-    ctx.scratchpad = &scratchpad;
-
-    int nsamples = mms.num_samples();
-    int G = div_ceil(nsamples, 256), B = 256;  // for the simpler kernels
-
-    TensorListShape<0> scalar_sh(nsamples);
-    auto predicates =
-        ctx.scratchpad->AllocTensorList<mm::memory_kind::device, NotLess<float>>(scalar_sh);
-
-    if (!reference_max_) {
-      auto predicates_cpu =
-        ctx.scratchpad->AllocTensorList<mm::memory_kind::pinned, NotLess<float>>(scalar_sh);
-      for (int i = 0; i < nsamples; i++) {
-        kernels::signal::DecibelToMagnitude<float> db2mag(10.f, reference_power_[i]);
-        (*predicates_cpu.data[i]) = {db2mag(cutoff_db_[i])};
-      }
-      assert(predicates_cpu.is_contiguous());
-      assert(predicates.is_contiguous());
-      CUDA_CALL(cudaMemcpyAsync(predicates.data[0], predicates_cpu.data[0],
-                                sizeof(Predicate) * nsamples, cudaMemcpyHostToDevice,
-                                ctx.gpu.stream));
-    } else {
-      // Predicates need to initialized on the device, because reference power is on the GPU
-      // (needs to be calculated as a pre-step)
-      auto max_mms = ctx.scratchpad->AllocTensorList<mm::memory_kind::device, float>(scalar_sh);
-      CalcMax(max_mms, mms, stream);
-
-      auto init_predicate_args =
-          ctx.scratchpad->Allocate<mm::memory_kind::pinned, InitPredicateSampleArgs>(nsamples);
-
-      for (int i = 0; i < nsamples; i++) {
-        auto &sample = init_predicate_args[i];
-        sample.predicate = predicates.data[i];
-        sample.ref_pow = max_mms.data[i];
-        sample.cutoff_db = cutoff_db_[i];
-      }
-      auto init_predicate_args_gpu =
-          ctx.scratchpad->ToGPU(ctx.gpu.stream, make_span(init_predicate_args, nsamples));
-
-      InitPredicates<<<G, B, 0, ctx.gpu.stream>>>(init_predicate_args, nsamples);
-    }
-
-    auto region_tmp = ctx.scratchpad->AllocTensorList<mm::memory_kind::device, i64vec2>(scalar_sh);
-    find_region_.Setup(ctx, mms.shape);
-    find_region_.Run(ctx, region_tmp, mms, predicates);
-
-    auto postprocess_args =
-        ctx.scratchpad->Allocate<mm::memory_kind::pinned, NonsilentRegionPostprocessArgs<int32_t>>(
-            nsamples);
-    for (int i = 0; i < nsamples; i++) {
-      auto &sample = postprocess_args[i];
-      sample.region = region_tmp[i].data;
-      sample.begin = begin[i].data;
-      sample.len = len[i].data;
-      sample.input_len = mms[i].shape[0];
-    }
-    auto postprocess_args_gpu =
-        ctx.scratchpad->ToGPU(ctx.gpu.stream, make_span(postprocess_args, nsamples));
-
-    // Postprocess: Deinterleave and adjust region to start of the window
-    NonsilentRegionPostprocess<int32_t>
-        <<<G, B, 0, ctx.gpu.stream>>>(postprocess_args_gpu, nsamples, window_length_);
-  }
-
   template <typename T>
   void RunImplTyped(Workspace &ws) {
     auto input = view<const T, 1>(ws.Input<GPUBackend>(0));
     int nsamples = input.shape.num_samples();
     auto out_begin = view<int32_t, 0>(ws.Output<GPUBackend>(0));
     auto out_len = view<int32_t, 0>(ws.Output<GPUBackend>(1));
+    cudaStream_t stream = ws.stream();
 
-    // 1. Compute MMS
-    kernels::DynamicScratchpad scratchpad({}, ws.stream());
-    auto mms = scratchpad.AllocTensorList<mm::memory_kind::device, float, 1>(input.shape);
-    CalcMMS(mms, input, ws.stream());
+    kernels::DynamicScratchpad scratchpad({}, stream);
+    auto *samples = scratchpad.AllocatePinned<NonsilenceSampleDesc<T>>(nsamples);
+    auto *postprocess_args = scratchpad.AllocatePinned<NonsilentRegionPostprocessArgs>(nsamples);
+    int64_t max_len = 0;
+    for (int i = 0; i < nsamples; i++) {
+      auto &sample = samples[i];
+      sample.in = input[i].data;
+      sample.len = input[i].shape[0];
+      sample.cutoff_db = cutoff_db_[i];
+      if (!reference_max_) {
+        kernels::signal::DecibelToMagnitude<float> db2mag(10.f, reference_power_[i]);
+        sample.threshold = db2mag(cutoff_db_[i]);
+      }
+      max_len = std::max(max_len, sample.len);
+      postprocess_args[i] = { out_begin[i].data, out_len[i].data };
+    }
+    NonsilenceSampleDesc<T> *samples_gpu;
+    NonsilentRegionPostprocessArgs *postprocess_args_gpu;
+    std::tie(samples_gpu, postprocess_args_gpu) = scratchpad.ToContiguousGPU(
+        stream, make_cspan(samples, nsamples), make_cspan(postprocess_args, nsamples));
+
+    auto *states = scratchpad.AllocateGPU<NonsilenceState>(nsamples);
+    CUDA_CALL(cudaMemsetAsync(states, 0, nsamples * sizeof(NonsilenceState), stream));
+
+    // The reset interval is not used - the same as in MovingMeanSquareGpu used so far
+    auto params = kernels::signal::GetSlidingWindowSumParams<T>(window_length_, -1);
+    dim3 grid(std::min<int64_t>(1024, div_ceil(max_len, 32)), nsamples);
+    constexpr int kBlockSize = 512;
+    kernels::signal::divide mean(window_length_);
+    if (nsamples > 0 && max_len > 0) {
+      if (reference_max_) {
+        MaxMMSKernel<T><<<grid, kBlockSize, params.shm_size, stream>>>(
+            samples_gpu, states, params.logical_block, window_length_, params.pow2, mean);
+        CUDA_CALL(cudaGetLastError());
+      }
+      FindNonsilentRegionKernel<T><<<grid, kBlockSize, params.shm_size, stream>>>(
+          samples_gpu, states, reference_max_, params.logical_block, window_length_,
+          params.pow2, mean);
+      CUDA_CALL(cudaGetLastError());
+    }
 
-    // 2. Find the non silent region as the begin and length of the region where the energy is above
-    // a given value.
-    CalcNonsilentRegion(out_begin, out_len, mms, ws.stream());
+    int G = div_ceil(nsamples, 256), B = 256;
+    if (nsamples > 0) {
+      NonsilentRegionPostprocess<<<G, B, 0, stream>>>(postprocess_args_gpu, states, nsamples,
+                                                      window_length_);
+      CUDA_CALL(cudaGetLastError());
+    }
   }
 };
 
@@ -15,6 +15,7 @@
 #ifndef DALI_OPERATORS_BBOX_BBOX_PASTE_H_
 #define DALI_OPERATORS_BBOX_BBOX_PASTE_H_
 
+#include <type_traits>
 #include <vector>
 
 #include "dali/core/common.h"
@@ -33,6 +34,10 @@ class BBoxPaste : public StatelessOperator<Backend> {
     use_ltrb_ = spec.GetArgument<bool>("ltrb");
   }
 
+  bool CanRunPerSample() const override {
+    return std::is_same_v<Backend, CPUBackend>;
+  }
+
  protected:
   bool use_ltrb_ = false;
 
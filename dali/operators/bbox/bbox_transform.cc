@@ -0,0 +1,83 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/bbox/bbox_transform.h"
+#include "dali/kernels/math/transform_boxes.h"
+#include "dali/pipeline/data/views.h"
+
+namespace dali {
+
+DALI_SCHEMA(BBoxTransform)
+  .DocStr(R"(Applies an affine transformation to 2D bounding boxes.
+
+The corners of each box are transformed with::
+
+  out = M * in + T
+
+where ``M`` is a 2x2 matrix and ``T`` is a 2-element translation vector, and the output box is
+the smallest axis-aligned box containing the transformed corners. For flips, scaling,
+translation and rotations by multiples of 90 degrees, this is the exact image of the input box.
+
+A sequence of box transformations can be applied at once by combining them with the
+operators from the ``transforms`` module - the per-sample matrices are combined on the CPU
+and the whole batch of boxes is processed in one pass, which is considerably cheaper than
+running a chain of box operators on small tensors. For example, a horizontal flip followed
+by pasting the image on a canvas twice as large, at the top-left corner::
+
+  flip = fn.transforms.scale(scale=[-1, 1], center=[0.5, 0.5])
+  paste = fn.transforms.scale(scale=[0.5, 0.5])
+  boxes = fn.bbox_transform(boxes, MT=fn.transforms.combine(flip, paste), ltrb=True)
+
+The boxes are stored in the innermost dimension of the input, which must have an extent of 4.
+)")
+  .NumInput(1)
+  .NumOutput(1)
+  .AddOptionalArg("ltrb",
+      R"(True for ``ltrb`` or False for ``xywh``; the output uses the same encoding.)",
+      false)
+  .AddOptionalArg("clip",
+      R"(If True, the output boxes are clipped to the [0, 1] range.)",
+      false)
+  .AddParent("MTTransformAttr");
+
+template <>
+void BBoxTransform<CPUBackend>::RunImpl(Workspace &ws) {
+  auto &in = ws.Input<CPUBackend>(0);
+  auto &out = ws.Output<CPUBackend>(0);
+  out.SetLayout(in.GetLayout());
+  auto in_view = view<const float>(in);
+  auto out_view = view<float>(out);
+  auto &tp = ws.GetThreadPool();
+
+  using Kernel = kernels::TransformBoxesCPU;
+  kmgr_.template Resize<Kernel>(tp.NumThreads());
+
+  auto M = GetMatrices<2, 2>();
+  auto T = GetTranslations<2>();
+
+  for (int idx = 0; idx < in_view.num_samples(); idx++) {
+    tp.AddWork([&, idx](int tid) {
+        kernels::KernelContext ctx;
+        auto in_tensor = in_view[idx];
+        auto out_tensor = out_view[idx];
+        kmgr_.Setup<Kernel>(tid, ctx, in_tensor.shape);
+        kmgr_.Run<Kernel>(tid, ctx, out_tensor, in_tensor, M[idx], T[idx], ltrb_, clip_);
+      }, in_view.shape.tensor_size(idx));
+  }
+  tp.RunAll();
+}
+
+DALI_REGISTER_OPERATOR(BBoxTransform, BBoxTransform<CPUBackend>, CPU);
+
+}  // namespace dali
@@ -0,0 +1,41 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/bbox/bbox_transform.h"
+#include "dali/kernels/math/transform_boxes.cuh"
+#include "dali/pipeline/data/views.h"
+
+namespace dali {
+
+template <>
+void BBoxTransform<GPUBackend>::RunImpl(Workspace &ws) {
+  auto &in = ws.Input<GPUBackend>(0);
+  auto &out = ws.Output<GPUBackend>(0);
+  out.SetLayout(in.GetLayout());
+  auto in_view = view<const float>(in);
+  auto out_view = view<float>(out);
+
+  using Kernel = kernels::TransformBoxesGPU;
+  kmgr_.template Resize<Kernel>(1);
+
+  kernels::KernelContext ctx;
+  ctx.gpu.stream = ws.stream();
+  kmgr_.Setup<Kernel>(0, ctx, in_view.shape);
+  kmgr_.Run<Kernel>(0, ctx, out_view, in_view, GetMatrices<2, 2>(), GetTranslations<2>(),
+                    ltrb_, clip_);
+}
+
+DALI_REGISTER_OPERATOR(BBoxTransform, BBoxTransform<GPUBackend>, GPU);
+
+}  // namespace dali
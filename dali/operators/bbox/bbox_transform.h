@@ -0,0 +1,71 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_BBOX_BBOX_TRANSFORM_H_
+#define DALI_OPERATORS_BBOX_BBOX_TRANSFORM_H_
+
+#include <vector>
+#include "dali/core/format.h"
+#include "dali/core/geom/mat.h"
+#include "dali/kernels/kernel_manager.h"
+#include "dali/operators/geometry/mt_transform_attr.h"
+#include "dali/pipeline/operator/checkpointing/stateless_operator.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+template <typename Backend>
+class BBoxTransform : public StatelessOperator<Backend>, private MTTransformAttr {
+ public:
+  explicit BBoxTransform(const OpSpec &spec)
+      : StatelessOperator<Backend>(spec), MTTransformAttr(spec) {
+    ltrb_ = spec.GetArgument<bool>("ltrb");
+    clip_ = spec.GetArgument<bool>("clip");
+  }
+
+ protected:
+  using StatelessOperator<Backend>::spec_;
+
+  bool SetupImpl(std::vector<OutputDesc> &output_descs, const Workspace &ws) override {
+    auto &input = ws.Input<Backend>(0);
+    const auto &input_shape = input.shape();
+    DALI_ENFORCE(input.type() == DALI_FLOAT,
+                 make_string("Expected the bounding boxes as float; got ", input.type()));
+    DALI_ENFORCE(input_shape.sample_dim() >= 1,
+                 "BBoxTransform expects an input with at least 1 dimension.");
+    int N = input_shape.num_samples();
+    for (int i = 0; i < N; i++) {
+      DALI_ENFORCE(input_shape.tensor_shape_span(i).back() == 4,
+                   make_string("The innermost dimension of the bounding box tensor must have an "
+                               "extent of 4; got shape ", input_shape[i], " in the sample ", i));
+    }
+    SetTransformDims(2, 2);  // the boxes remain 2D
+    ProcessTransformArgs(spec_, ws, N);
+
+    output_descs.resize(1);
+    output_descs[0].type = DALI_FLOAT;
+    output_descs[0].shape = input_shape;
+    return true;
+  }
+
+  void RunImpl(Workspace &ws) override;
+
+  bool ltrb_ = false;
+  bool clip_ = false;
+  kernels::KernelManager kmgr_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_BBOX_BBOX_TRANSFORM_H_
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "dali/operators/decoder/audio/audio_decoder_impl.h"
+#include <algorithm>
+#include <type_traits>
 #include "dali/kernels/signal/downmixing.h"
 
 namespace dali {
@@ -29,7 +31,8 @@ std::pair<int64_t, int64_t> ProcessOffsetAndLength(const AudioMetadata &meta,
     length = static_cast<int64_t>(length_sec * meta.sample_rate);
   }
 
-  // Limit the duration to the bounds of the input
+  // Limit the offset and the duration to the bounds of the input
+  offset = std::min(offset, meta.length);
   if ((offset + length) > meta.length) {
     length = meta.length - offset;
   }
@@ -46,11 +49,20 @@ TensorShape<> DecodedAudioShape(const AudioMetadata &meta, float target_sample_r
   return downmix ? TensorShape<>{len} : TensorShape<>{len, channels};
 }
 
+namespace {
+
+/**
+ * @brief The number of frames decoded at a time, when the data needs further processing
+ */
+constexpr int64_t kDecodeChunkFrames = 1 << 15;
+
+}  // namespace
+
 template <typename T>
 void DecodeAudio(TensorView<StorageCPU, T, DynamicDimensions> audio, AudioDecoderBase &decoder,
                  const AudioMetadata &meta, kernels::signal::resampling::ResamplerCPU &resampler,
-                 span<float> decode_scratch_mem,
-                 span<float> resample_scratch_mem,
+                 std::vector<float> &decode_scratch,
+                 std::vector<float> &resample_scratch,
                  float target_sample_rate, bool downmix,
                  const char *audio_filepath) {  // audio_filepath for debug purposes
   assert(meta.sample_rate > 0 && "Invalid sampling rate");
@@ -71,36 +83,42 @@ void DecodeAudio(TensorView<StorageCPU, T, DynamicDimensions> audio, AudioDecode
     return;
   }
 
-  assert(decode_scratch_mem.size() > 0 &&
-         "Dowmixing or resampling is required but decoder scratch memory is empty.");
-  assert(decode_scratch_mem.size() % meta.channels == 0 &&
-         "Expected to decode full audio frames only.");
-  assert(decode_scratch_mem.size() <= meta.length * meta.channels &&
-         "Requested to decode more data than available.");
-  int64_t decoded_audio_len = decode_scratch_mem.size() / meta.channels;
-  if (should_resample && should_downmix) {
-    // When downmixing, we need an extra buffer for the input of resampling
-    assert(resample_scratch_mem.size() == decoded_audio_len &&
-           "Downmixing and resampling is required but resampler scratch is either empty or doesn't "
-           "have the expected size");
-  }
+  // Decodes the next `nframes` frames to `out`, downmixing them, if needed
+  int64_t decoded = 0;
+  auto decode_chunk = [&](auto *out, int64_t nframes) {
+    assert(decoded + nframes <= meta.length && "Requested to decode more data than available.");
+    float *decode_out = nullptr;
+    if constexpr (std::is_same<decltype(out), float *>::value) {
+      if (!should_downmix)
+        decode_out = out;
+    }
+    if (!decode_out) {
+      decode_scratch.resize(nframes * meta.channels);
+      decode_out = decode_scratch.data();
+    }
+    int64_t ret = decoder.DecodeFrames(decode_out, nframes);
+    DALI_ENFORCE(ret == nframes,
+      make_string("Error decoding audio file ", audio_filepath, ". Requested ", nframes,
+                  " samples at ", decoded, " but got ", ret, " samples."));
+    if (should_downmix)
+      kernels::signal::Downmix(out, decode_out, nframes, meta.channels);
+    decoded += nframes;
+  };
 
-  int64_t ret = decoder.DecodeFrames(decode_scratch_mem.data(), decoded_audio_len);
-  DALI_ENFORCE(ret == decoded_audio_len, make_string("Error decoding audio file ", audio_filepath));
-
-  if (should_resample && should_downmix) {
-    kernels::signal::Downmix(resample_scratch_mem.data(), decode_scratch_mem.data(),
-                             decoded_audio_len, meta.channels);
-    resampler.Resample(audio.data, 0, audio.shape[0], target_sample_rate,
-                       resample_scratch_mem.data(), decoded_audio_len, meta.sample_rate, 1);
-  } else if (should_resample) {  // No downmix
-    resampler.Resample(audio.data, 0, audio.shape[0], target_sample_rate, decode_scratch_mem.data(),
-                       decoded_audio_len, meta.sample_rate, meta.channels);
-  } else if (should_downmix) {  // downmix only
-    kernels::signal::Downmix(audio.data, decode_scratch_mem.data(), decoded_audio_len,
-                             meta.channels);
-  } else {
-    assert(false && "Logic error. This should never happen.");
+  if (should_resample) {
+    int channels = should_downmix ? 1 : meta.channels;
+    auto read_input = [&](float *out, int64_t nframes) {
+      nframes = std::min(nframes, std::min(meta.length - decoded, kDecodeChunkFrames));
+      decode_chunk(out, nframes);
+      return nframes;
+    };
+    resampler.ResampleStream(audio.data, audio.shape[0], target_sample_rate, read_input,
+                             meta.length, meta.sample_rate, channels, resample_scratch);
+  } else {  // downmix only
+    int64_t length = audio.shape[0];
+    assert(length <= meta.length && "Requested to decode more data than available.");
+    for (int64_t pos = 0; pos < length; pos += kDecodeChunkFrames)
+      decode_chunk(audio.data + pos, std::min(kDecodeChunkFrames, length - pos));
   }
 }
 
@@ -108,7 +126,7 @@ void DecodeAudio(TensorView<StorageCPU, T, DynamicDimensions> audio, AudioDecode
   template void DecodeAudio<OutType>(                                                             \
       TensorView<StorageCPU, OutType, DynamicDimensions> audio, AudioDecoderBase & decoder,       \
       const AudioMetadata &meta, kernels::signal::resampling::ResamplerCPU &resampler,            \
-      span<float> decode_scratch_mem, span<float> resample_scratch_mem,                           \
+      std::vector<float> &decode_scratch, std::vector<float> &resample_scratch,                   \
       float target_sample_rate, bool downmix, const char *audio_filepath);
 
 DECLARE_IMPL(float);
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,6 +16,7 @@
 #define DALI_OPERATORS_DECODER_AUDIO_AUDIO_DECODER_IMPL_H_
 
 #include <utility>
+#include <vector>
 #include "dali/operators/decoder/audio/audio_decoder.h"
 #include "dali/operators/decoder/audio/generic_decoder.h"
 #include "dali/pipeline/data/backend.h"
@@ -30,7 +31,8 @@ namespace dali {
  * @param meta Audio metadata
  * @param offset_sec offset, in seconds (optional)
  * @param length_sec length, in seconds. If a negative value is provided, whole buffer is assumed
- * @returns pair containing offset and length in number of samples
+ * @returns pair containing offset and length in number of samples, limited to the bounds
+ *          of the buffer (the length is 0 if the offset is past the end)
  */
 DLL_PUBLIC std::pair<int64_t, int64_t> ProcessOffsetAndLength(const AudioMetadata &meta,
                                                               double offset_sec = 0,
@@ -49,17 +51,18 @@ DLL_PUBLIC TensorShape<> DecodedAudioShape(const AudioMetadata &meta, float targ
 
 /**
  * @brief Decodes audio data, with optional downmixing and resampling
+ *
+ * The data is decoded from the current position of the decoder. When downmixing or resampling
+ * is required, the audio is decoded and processed in chunks, so the scratch memory needed is
+ * bounded and doesn't depend on the length of the recording.
+ *
  * @param audio Destination buffer. The function will decode as many audio samples as the shape of this argument
  * @param decoder Decoder object.
- * @param meta Audio metadata.
+ * @param meta Audio metadata. The `length` is the number of frames to decode.
  * @param resampler ResamplerCPU instance used if resampling is required
- * @param decode_scratch_mem Scratch memory used for decoding, when decoding can't be done directly to the output buffer.
- *                           If downmixing or resampling is required, this buffer should have a positive length, representing
- *                           decoded audio length at the original sampling rate: ``length * nchannels``
- * @param resample_scratch_mem Scratch memory used for the input of resampling.
- *                             If resampling is required, the buffer should have a positive length, representing the
- *                             decoded audio length, ``length`` if downmixing is enabled, or the decoded audio length including
- *                             channels, ``length * nchannels``, otherwise.
+ * @param decode_scratch Scratch memory for the decoded chunks, when decoding can't be done directly
+ *                       to the output buffer. Resized as needed.
+ * @param resample_scratch Scratch memory for the input of resampling. Resized as needed.
  * @param target_sample_rate If a positive value is provided, the signal will be resampled except when its original sampling rate
  *                           is equal to the target.
  * @param downmix If true, the audio channes will be downmixed to a single one
@@ -69,7 +72,8 @@ template <typename T>
 DLL_PUBLIC void DecodeAudio(TensorView<StorageCPU, T, DynamicDimensions> audio,
                             AudioDecoderBase &decoder, const AudioMetadata &meta,
                             kernels::signal::resampling::ResamplerCPU &resampler,
-                            span<float> decode_scratch_mem, span<float> resample_scratch_mem,
+                            std::vector<float> &decode_scratch,
+                            std::vector<float> &resample_scratch,
                             float target_sample_rate, bool downmix, const char *audio_filepath);
 
 }  // namespace dali
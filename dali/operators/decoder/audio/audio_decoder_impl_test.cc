@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -50,6 +50,11 @@ TEST(AudioDecoderImpl, ProcessOffsetAndLength) {
     int64_t duration = total_length - offset;
     ASSERT_EQ(std::make_pair(offset, duration), ProcessOffsetAndLength(meta, 0.45, -1.0));
   }
+
+  {
+    int64_t zero = 0;
+    ASSERT_EQ(std::make_pair(total_length, zero), ProcessOffsetAndLength(meta, 4.0, 1.0));
+  }
 }
 
 }  // namespace test
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "dali/operators/decoder/audio/audio_decoder_op.h"
+#include <tuple>
 #include "dali/operators/decoder/audio/audio_decoder_impl.h"
 #include "dali/pipeline/operator/op_schema.h"
 #include "dali/pipeline/data/views.h"
@@ -46,7 +47,19 @@ Supported types: ``INT16``, ``INT32``, ``FLOAT``.)code", DALI_FLOAT)
 the highest.
 
 0 gives 3 lobes of the sinc filter, 50 gives 16 lobes, and 100 gives 64 lobes.)code",
-          50.0f, false);
+          50.0f, false)
+  .AddOptionalArg("offset", R"code(Start of the decoded part of the recording, in seconds.
+
+The decoder seeks to this position, so the preceding part of the recording is not decoded.)code",
+          0.0f, true)
+  .AddOptionalArg("duration", R"code(Length of the decoded part of the recording, in seconds.
+
+If not provided or negative, the recording is decoded until its end. The decoded part is
+limited to the bounds of the recording.
+
+When ``sample_rate`` is specified, the offset and the duration are still expressed in
+seconds, so the number of decoded samples is scaled accordingly.)code",
+          -1.0f, true);
 
 
 DALI_REGISTER_OPERATOR(AudioDecoder, AudioDecoderCpu, CPU);
@@ -68,6 +81,8 @@ AudioDecoderCpu::SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace
   auto &input = ws.Input<Backend>(0);
   const auto batch_size = input.shape().num_samples();
   GetPerSampleArgument<float>(target_sample_rates_, "sample_rate", ws, batch_size);
+  GetPerSampleArgument<float>(offset_sec_, "offset", ws, batch_size);
+  GetPerSampleArgument<float>(duration_sec_, "duration", ws, batch_size);
 
   for (int i = 0; i < batch_size; i++) {
     DALI_ENFORCE(input.shape()[i].size() == 1, "Raw input must be 1D encoded byte data");
@@ -75,6 +90,7 @@ AudioDecoderCpu::SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace
   DALI_ENFORCE(IsType<uint8_t>(input.type()), "Raw files must be stored as uint8 data.");
   decoders_.resize(batch_size);
   sample_meta_.resize(batch_size);
+  offsets_.resize(batch_size);
   files_names_.resize(batch_size);
 
   decode_type_ = use_resampling_ ? DALI_FLOAT : output_type_;
@@ -90,6 +106,9 @@ AudioDecoderCpu::SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace
     auto &meta = sample_meta_[i] =
         decoders_[i]->Open({static_cast<const char *>(input.raw_tensor(i)),
                             input.tensor_shape(i).num_elements()});
+    // only the requested part of the recording is decoded
+    std::tie(offsets_[i], meta.length) =
+        ProcessOffsetAndLength(meta, offset_sec_[i], duration_sec_[i]);
     TensorShape<> data_sample_shape = DecodedAudioShape(
         meta, use_resampling_ ? target_sample_rates_[i] : -1.0f, downmix_);
     shape_data.set_tensor_shape(i, data_sample_shape);
@@ -108,31 +127,15 @@ AudioDecoderCpu::DecodeSample(const TensorView<StorageCPU, OutputType, DynamicDi
                               int thread_idx, int sample_idx) {
   auto &meta = sample_meta_[sample_idx];
   float target_sr = use_resampling_ ? target_sample_rates_[sample_idx] : meta.sample_rate;
-  bool should_resample = target_sr != meta.sample_rate;
-  bool should_downmix = meta.channels > 1 && downmix_;
-  int64_t decode_scratch_sz = 0;
-  int64_t resample_scratch_sz = 0;
-  if (should_resample || should_downmix)
-    decode_scratch_sz = meta.length * meta.channels;
-
-  // resample scratch is used to prepare a single or multiple (depending if
-  // downmixing is needed) channel float input, required by the resampling
-  // kernel
-  if (should_resample)
-    resample_scratch_sz = should_downmix ? meta.length : meta.length * meta.channels;
-
-  auto &scratch_decoder = scratch_decoder_[thread_idx];
-  scratch_decoder.resize(decode_scratch_sz);
-
-  auto &scratch_resampler = scratch_resampler_[thread_idx];
-  scratch_resampler.resize(resample_scratch_sz);
-
-  // TODO(janton): handle offset and duration
+  auto &decoder = *decoders_[sample_idx];
+  if (offsets_[sample_idx] > 0) {
+    DALI_ENFORCE(decoder.SeekFrames(offsets_[sample_idx], SEEK_SET) == offsets_[sample_idx],
+                 make_string("Could not seek to frame ", offsets_[sample_idx]));
+  }
 
   DecodeAudio<OutputType>(
-    audio, *decoders_[sample_idx], meta, resampler_,
-    {scratch_decoder.data(), decode_scratch_sz},
-    {scratch_resampler.data(), resample_scratch_sz},
+    audio, decoder, meta, resampler_,
+    scratch_decoder_[thread_idx], scratch_resampler_[thread_idx],
     target_sr, downmix_,
     files_names_[sample_idx].c_str());
 }
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -78,6 +78,8 @@ class AudioDecoderCpu : public StatelessOperator<CPUBackend> {
   }
 
   std::vector<float> target_sample_rates_;
+  std::vector<float> offset_sec_, duration_sec_;
+  std::vector<int64_t> offsets_;  // the offsets of the decoded parts, in frames
   kernels::signal::resampling::ResamplerCPU resampler_;
   DALIDataType output_type_ = DALI_NO_TYPE, decode_type_ = DALI_NO_TYPE;
   const bool downmix_ = false, use_resampling_ = false;
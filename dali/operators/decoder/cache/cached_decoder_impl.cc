@@ -35,8 +35,9 @@ CachedDecoderImpl::CachedDecoderImpl(const OpSpec& spec)
     if (cache_size > 0 && cache_size >= cache_threshold) {
       const std::string cache_type = spec.GetArgument<std::string>("cache_type");
       const bool cache_debug = spec.GetArgument<bool>("cache_debug");
+      const std::string cache_path = spec.GetArgument<std::string>("cache_path");
       cache_ = ImageCacheFactory::Instance().Get(
-        device_id_, cache_type, cache_size, cache_debug, cache_threshold);
+        device_id_, cache_type, cache_size, cache_debug, cache_threshold, cache_path);
 
       use_batch_copy_kernel_ = spec.GetArgument<bool>("cache_batch_copy");
       auto batch_size = spec.GetArgument<int>("max_batch_size");
@@ -58,10 +59,17 @@ bool CachedDecoderImpl::CacheLoad(const std::string& file_name,
 bool CachedDecoderImpl::DeferCacheLoad(const std::string& file_name, uint8_t *output_data) {
   if (!cache_ || file_name.empty())
     return false;
+  if (!cache_->IsDeviceAccessible()) {
+    if (!cache_->IsCached(file_name))
+      return false;
+    deferred_reads_.emplace_back(file_name, output_data);
+    return true;
+  }
   auto img = cache_->Get(file_name);
   if (!img.data)
     return false;
   scatter_gather_->AddCopy(output_data, img.data, img.num_elements());
+  deferred_keys_.push_back(file_name);
   return true;
 }
 
@@ -69,11 +77,17 @@ void CachedDecoderImpl::LoadDeferred(cudaStream_t stream) {
   if (!scatter_gather_)
     return;
 
+  for (auto &read : deferred_reads_)
+    DALI_ENFORCE(cache_->Read(read.first, read.second, stream));
+  deferred_reads_.clear();
+
   cache_->SyncToRead(stream);
   using Method = kernels::ScatterGatherGPU::Method;
   auto copy_method = use_batch_copy_kernel_ ? Method::Default
                                             : Method::Memcpy;
   CUDA_CALL((scatter_gather_->Run(stream, true, copy_method), cudaGetLastError()));
+  cache_->Release(make_cspan(deferred_keys_), stream);
+  deferred_keys_.clear();
 }
 
 bool CachedDecoderImpl::IsInCache(const std::string& file_name) {
@@ -81,7 +95,10 @@ bool CachedDecoderImpl::IsInCache(const std::string& file_name) {
 }
 
 ImageCache::ImageShape CachedDecoderImpl::CacheImageShape(const std::string& file_name) {
-  return IsInCache(file_name) ? cache_->GetShape(file_name) : ImageCache::ImageShape{};
+  ImageCache::ImageShape shape{};
+  if (cache_)
+    cache_->TryGetShape(file_name, shape);
+  return shape;
 }
 
 void CachedDecoderImpl::CacheStore(const std::string& file_name, const uint8_t *data,
@@ -131,11 +148,31 @@ Here is a list of the available cache types:
   The warm-up time for threshold policy is 1 epoch.
 * | ``largest``: stores the largest images that can fit in the cache.
   | The warm-up time for largest policy is 2 epochs
+* | ``lru``: caches every image with a size that is larger than ``cache_threshold``. When the
+  | cache is full, the least recently used images are evicted to make room for new ones.
+* | ``lfu``: like ``lru``, but evicts the least frequently used images first.
+* | ``persistent``: caches every image with a size that is larger than ``cache_threshold`` in
+  | the file ``cache_path``, until the file reaches ``cache_size``. The file is memory-mapped
+  | and the images are read from it, so the cache doesn't use the GPU memory and survives
+  | the process - the next pipelines using the same file start with a warm cache.
+
+  The ``lru`` and ``lfu`` policies are useful when the dataset doesn't fit in the cache,
+  for example, when every decoder instance sees all the images.
+
+  The ``persistent`` cache is meant for repeated, deterministic processing of the same data
+  (e.g. an evaluation). The images are identified by their ``source_info`` (usually the file
+  name), so the file must be removed when the data set or the decoding parameters change.
 
   .. note::
     To take advantage of caching, it is recommended to configure readers with `stick_to_shard=True`
     to limit the amount of unique images seen by each decoder instance in a multi node environment.
 )code",
+      std::string())
+  .AddOptionalArg("cache_path",
+      R"code(Applies **only** to the ``mixed`` backend type.
+
+The path of the cache file of the ``persistent`` cache. The file is created, if it doesn't exist.
+Each device (and each process) needs a separate file.)code",
       std::string());
 
 }  // namespace dali
@@ -18,6 +18,8 @@
 #include <cuda_runtime_api.h>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 #include "dali/operators/decoder/cache/image_cache.h"
 #include "dali/pipeline/operator/op_spec.h"
 
@@ -59,6 +61,9 @@ class CachedDecoderImpl {
  private:
   std::shared_ptr<ImageCache> cache_;
   std::unique_ptr<kernels::ScatterGatherGPU> scatter_gather_;
+  std::vector<ImageCache::ImageKey> deferred_keys_;
+  // the loads from caches which aren't device-accessible are done with ImageCache::Read
+  std::vector<std::pair<ImageCache::ImageKey, uint8_t *>> deferred_reads_;
   int device_id_;
   bool use_batch_copy_kernel_ = true;
 };
@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -18,6 +18,7 @@
 #include <cuda_runtime.h>
 #include <string>
 #include "dali/core/api_helper.h"
+#include "dali/core/span.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/core/tensor_view.h"
 
@@ -43,6 +44,21 @@ class DLL_PUBLIC ImageCache {
    */
   DLL_PUBLIC virtual const ImageShape& GetShape(const ImageKey& image_key) const = 0;
 
+  /**
+   * @brief Get image dimensions, if the image is present in the cache
+   * @param image_key key representing the image in cache
+   * @param shape receives the dimensions of the image
+   * @return true if the image is cached, false otherwise
+   * @remarks Unlike IsCached followed by GetShape, it's safe to use with implementations which
+   *          evict images from the cache.
+   */
+  DLL_PUBLIC virtual bool TryGetShape(const ImageKey& image_key, ImageShape &shape) const {
+    if (!IsCached(image_key))
+      return false;
+    shape = GetShape(image_key);
+    return true;
+  }
+
     /**
      * @brief Try to read from cache
      * @param image_key key representing the image in cache
@@ -72,11 +88,30 @@ class DLL_PUBLIC ImageCache {
    * @brief Get a cache entry describing an image
    * @param image_key key of the cached image
    * @return Pointer and shape of the cached image; if not found, data is null
-   * @remarks This function is valid only if the implementation doesn't evict
-   *          images from the cache.
+   * @remarks If the implementation evicts images from the cache, the image is retained
+   *          until it's passed to Release.
    */
   DLL_PUBLIC virtual DecodedImage Get(const ImageKey &image_key) const = 0;
 
+  /**
+   * @brief Releases the images obtained with Get
+   * @param image_keys keys of the images obtained with Get
+   * @param stream cuda stream in which the reads from the images were scheduled
+   * @remarks To be called after launching the memory copies from the pointers provided by Get.
+   *          The images may then be evicted, but their memory is not reused before the work
+   *          scheduled in `stream` completes.
+   */
+  DLL_PUBLIC virtual void Release(span<const ImageKey> image_keys, cudaStream_t stream) const {}
+
+  /**
+   * @brief Whether the images can be obtained with Get
+   * @remarks If false, the images are not kept in device-accessible memory and can be obtained
+   *          only with Read.
+   */
+  DLL_PUBLIC virtual bool IsDeviceAccessible() const {
+    return true;
+  }
+
   /**
    * @brief Synchronizes internal cache CUDA stream with a provided stream before a cache reading
    *        operation
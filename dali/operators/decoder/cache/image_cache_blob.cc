@@ -31,7 +31,10 @@ ImageCacheBlob::ImageCacheBlob(std::size_t cache_size,
     , stats_enabled_(stats_enabled) {
   DALI_ENFORCE(image_size_threshold <= cache_size_, "Cache size should fit at least one image");
 
-  buffer_ = mm::alloc_raw_unique<uint8_t, mm::memory_kind::device>(cache_size_);
+  {
+    mm::MemoryTagScope tag(mm::MemoryTag::Cache);
+    buffer_ = mm::alloc_raw_unique<uint8_t, mm::memory_kind::device>(cache_size_);
+  }
   DALI_ENFORCE(buffer_ != nullptr);
   tail_ = buffer_.get();
   buffer_end_ = buffer_.get() + cache_size_;
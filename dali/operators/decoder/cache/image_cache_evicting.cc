@@ -0,0 +1,270 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/cache/image_cache_evicting.h"
+#include <cassert>
+#include <fstream>
+#include <iostream>
+#include <utility>
+#include "dali/core/error_handling.h"
+#include "dali/core/mm/default_resources.h"
+#include "dali/core/mm/memory_tag.h"
+#include "dali/pipeline/data/backend.h"
+
+namespace dali {
+
+void LRUEvictionPolicy::Insert(const ImageKey &key) {
+  order_.push_front(key);
+  pos_[key] = order_.begin();
+}
+
+void LRUEvictionPolicy::Access(const ImageKey &key) {
+  auto it = pos_.find(key);
+  if (it != pos_.end())
+    order_.splice(order_.begin(), order_, it->second);
+}
+
+void LRUEvictionPolicy::Erase(const ImageKey &key) {
+  auto it = pos_.find(key);
+  if (it == pos_.end())
+    return;
+  order_.erase(it->second);
+  pos_.erase(it);
+}
+
+const EvictionPolicy::ImageKey *LRUEvictionPolicy::Victim(const Evictable &evictable) const {
+  for (auto it = order_.rbegin(); it != order_.rend(); ++it) {
+    if (evictable(*it))
+      return &*it;
+  }
+  return nullptr;
+}
+
+void LFUEvictionPolicy::Insert(const ImageKey &key) {
+  auto &rank = ranks_[key];
+  rank = { 1, clock_++ };
+  order_.emplace(rank.first, rank.second, key);
+}
+
+void LFUEvictionPolicy::Access(const ImageKey &key) {
+  auto it = ranks_.find(key);
+  if (it == ranks_.end())
+    return;
+  auto &rank = it->second;
+  auto node = order_.extract({ rank.first, rank.second, key });
+  rank = { rank.first + 1, clock_++ };
+  std::get<0>(node.value()) = rank.first;
+  std::get<1>(node.value()) = rank.second;
+  order_.insert(std::move(node));
+}
+
+void LFUEvictionPolicy::Erase(const ImageKey &key) {
+  auto it = ranks_.find(key);
+  if (it == ranks_.end())
+    return;
+  order_.erase({ it->second.first, it->second.second, key });
+  ranks_.erase(it);
+}
+
+const EvictionPolicy::ImageKey *LFUEvictionPolicy::Victim(const Evictable &evictable) const {
+  for (auto &rank : order_) {
+    if (evictable(std::get<2>(rank)))
+      return &std::get<2>(rank);
+  }
+  return nullptr;
+}
+
+ImageCacheEvicting::ImageCacheEvicting(std::size_t cache_size,
+                                       std::size_t image_size_threshold,
+                                       std::unique_ptr<EvictionPolicy> policy,
+                                       bool stats_enabled)
+    : cache_size_(cache_size)
+    , image_size_threshold_(image_size_threshold)
+    , stats_enabled_(stats_enabled)
+    , policy_(std::move(policy)) {
+  DALI_ENFORCE(image_size_threshold <= cache_size_, "Cache size should fit at least one image");
+  DALI_ENFORCE(policy_ != nullptr, "The eviction policy must not be null");
+  CUDA_CALL(cudaStreamCreateWithPriority(&cache_stream_, cudaStreamNonBlocking, 0));
+  CUDA_CALL(cudaEventCreate(&cache_read_event_));
+  CUDA_CALL(cudaEventCreate(&cache_write_event_));
+}
+
+ImageCacheEvicting::~ImageCacheEvicting() {
+  if (stats_enabled_ && num_added_ > 0) print_stats();
+
+  // the images are freed in the order of the cache stream, so it must outlive them
+  entries_.clear();
+  CUDA_CALL(cudaStreamSynchronize(cache_stream_));
+  CUDA_CALL(cudaEventDestroy(cache_read_event_));
+  CUDA_CALL(cudaEventDestroy(cache_write_event_));
+  CUDA_CALL(cudaStreamDestroy(cache_stream_));
+}
+
+bool ImageCacheEvicting::IsCached(const ImageKey& image_key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.find(image_key) != entries_.end();
+}
+
+const ImageCache::ImageShape& ImageCacheEvicting::GetShape(const ImageKey& image_key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = entries_.find(image_key);
+  DALI_ENFORCE(it != entries_.end(), "cache entry [" + image_key + "] not found");
+  return it->second.shape;
+}
+
+bool ImageCacheEvicting::TryGetShape(const ImageKey& image_key, ImageShape &shape) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = entries_.find(image_key);
+  if (it == entries_.end())
+    return false;
+  shape = it->second.shape;
+  return true;
+}
+
+bool ImageCacheEvicting::Read(const ImageKey& image_key,
+                              void* destination_buffer,
+                              cudaStream_t stream) const {
+  DALI_ENFORCE(!image_key.empty());
+  DALI_ENFORCE(destination_buffer != nullptr);
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = entries_.find(image_key);
+  if (it == entries_.end())
+    return false;
+  const auto &entry = it->second;
+  SyncToRead(stream);
+  MemCopy(destination_buffer, entry.data.get(), volume(entry.shape), stream);
+  // the image may be evicted right after we leave the mutex
+  SyncCacheStream(stream);
+  policy_->Access(image_key);
+  num_reads_++;
+  return true;
+}
+
+ImageCache::DecodedImage ImageCacheEvicting::Get(const ImageKey& image_key) const {
+  DALI_ENFORCE(!image_key.empty());
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = entries_.find(image_key);
+  if (it == entries_.end())
+    return {};
+  const auto &entry = it->second;
+  entry.pins++;
+  policy_->Access(image_key);
+  num_reads_++;
+  return { entry.data.get(), entry.shape };
+}
+
+void ImageCacheEvicting::Release(span<const ImageKey> image_keys, cudaStream_t stream) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &key : image_keys) {
+    auto it = entries_.find(key);
+    DALI_ENFORCE(it != entries_.end() && it->second.pins > 0,
+                 "cache entry [" + key + "] released without a matching Get");
+    it->second.pins--;
+  }
+  // the memory of the released images is freed in the order of the cache stream - it must not
+  // happen before the reads complete
+  SyncCacheStream(stream);
+}
+
+void ImageCacheEvicting::Add(const ImageKey& image_key, const uint8_t* data,
+                             const ImageShape& data_shape, cudaStream_t stream) {
+  DALI_ENFORCE(!image_key.empty());
+  const std::size_t data_size = volume(data_shape);
+  if (data_size < image_size_threshold_ || data_size > cache_size_ || data_size == 0)
+    return;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (entries_.find(image_key) != entries_.end())
+    return;
+
+  auto evictable = [&](const ImageKey &key) {
+    return entries_.at(key).pins == 0;
+  };
+  if (mm::IsDeviceMemoryUnderPressure()) {
+    // The device memory is close to its budget - give back some memory instead of caching more
+    std::size_t target = bytes_used_ / 2;
+    while (bytes_used_ > target) {
+      const ImageKey *victim = policy_->Victim(evictable);
+      if (!victim)
+        break;
+      Evict(*victim);
+    }
+    return;
+  }
+  while (bytes_used_ + data_size > cache_size_) {
+    const ImageKey *victim = policy_->Victim(evictable);
+    if (!victim) {
+      LOG_LINE << "WARNING: all the cached images are in use. Ignore" << std::endl;
+      return;
+    }
+    Evict(*victim);
+  }
+
+  Entry entry;
+  mm::MemoryTagScope tag(mm::MemoryTag::Cache);
+  entry.data = mm::alloc_raw_async_unique<uint8_t, mm::memory_kind::device>(
+      data_size, cache_stream_, cache_stream_);
+  entry.shape = data_shape;
+  // the memory is ready to use in the cache stream
+  SyncToRead(stream);
+  MemCopy(entry.data.get(), data, data_size, stream);
+  SyncCacheStream(stream);
+
+  entries_.emplace(image_key, std::move(entry));
+  policy_->Insert(image_key);
+  bytes_used_ += data_size;
+  num_added_++;
+}
+
+void ImageCacheEvicting::Evict(const ImageKey &image_key) {
+  auto it = entries_.find(image_key);
+  assert(it != entries_.end() && it->second.pins == 0);
+  LOG_LINE << "Evict: image_key[" << image_key << "]" << std::endl;
+  bytes_used_ -= volume(it->second.shape);
+  num_evicted_++;
+  // the key may be owned by the policy, so erase it from the policy last
+  ImageKey key = image_key;
+  entries_.erase(it);
+  policy_->Erase(key);
+}
+
+void ImageCacheEvicting::SyncToRead(cudaStream_t stream) const {
+  CUDA_CALL(cudaEventRecord(cache_read_event_, cache_stream_));
+  CUDA_CALL(cudaStreamWaitEvent(stream, cache_read_event_, 0));
+}
+
+void ImageCacheEvicting::SyncCacheStream(cudaStream_t stream) const {
+  CUDA_CALL(cudaEventRecord(cache_write_event_, stream));
+  CUDA_CALL(cudaStreamWaitEvent(cache_stream_, cache_write_event_, 0));
+}
+
+void ImageCacheEvicting::print_stats() const {
+  static std::mutex stats_mutex;
+  std::lock_guard<std::mutex> lock(stats_mutex);
+  const char* log_filename = std::getenv("DALI_LOG_FILE");
+  std::ofstream log_file;
+  if (log_filename) log_file.open(log_filename);
+  std::ostream& out = log_filename ? log_file : std::cout;
+  out << "#################### CACHE STATS ####################" << std::endl;
+  out << "cache_size: " << cache_size_ << std::endl;
+  out << "cache_threshold: " << image_size_threshold_ << std::endl;
+  out << "bytes_used: " << bytes_used_ << std::endl;
+  out << "images_cached: " << entries_.size() << std::endl;
+  out << "images_added: " << num_added_ << std::endl;
+  out << "images_evicted: " << num_evicted_ << std::endl;
+  out << "reads: " << num_reads_ << std::endl;
+  out << "#################### END   STATS ####################" << std::endl;
+}
+
+}  // namespace dali
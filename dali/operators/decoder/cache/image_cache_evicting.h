@@ -0,0 +1,190 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_EVICTING_H_
+#define DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_EVICTING_H_
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include "dali/core/common.h"
+#include "dali/core/mm/memory.h"
+#include "dali/core/span.h"
+#include "dali/operators/decoder/cache/image_cache.h"
+
+namespace dali {
+
+/**
+ * @brief Decides which image should be evicted from an `ImageCacheEvicting`.
+ *
+ * The policy only tracks the keys - it doesn't own any data. All the calls are done with
+ * the cache's mutex held.
+ */
+class DLL_PUBLIC EvictionPolicy {
+ public:
+  using ImageKey = ImageCache::ImageKey;
+  using Evictable = std::function<bool(const ImageKey &)>;
+
+  virtual ~EvictionPolicy() = default;
+
+  /**
+   * @brief Registers a new image in the cache.
+   */
+  virtual void Insert(const ImageKey &key) = 0;
+
+  /**
+   * @brief Registers a cache hit.
+   */
+  virtual void Access(const ImageKey &key) = 0;
+
+  /**
+   * @brief Removes an image from the policy.
+   */
+  virtual void Erase(const ImageKey &key) = 0;
+
+  /**
+   * @brief Returns the key of the image to be evicted first, skipping the ones for which
+   *        `evictable` returns false. Returns nullptr if no image can be evicted.
+   */
+  virtual const ImageKey *Victim(const Evictable &evictable) const = 0;
+};
+
+/**
+ * @brief Evicts the least recently used image.
+ */
+class DLL_PUBLIC LRUEvictionPolicy : public EvictionPolicy {
+ public:
+  void Insert(const ImageKey &key) override;
+  void Access(const ImageKey &key) override;
+  void Erase(const ImageKey &key) override;
+  const ImageKey *Victim(const Evictable &evictable) const override;
+
+ private:
+  // the most recently used at the front
+  std::list<ImageKey> order_;
+  std::unordered_map<ImageKey, std::list<ImageKey>::iterator> pos_;
+};
+
+/**
+ * @brief Evicts the least frequently used image; the ties are broken by the last access time.
+ */
+class DLL_PUBLIC LFUEvictionPolicy : public EvictionPolicy {
+ public:
+  void Insert(const ImageKey &key) override;
+  void Access(const ImageKey &key) override;
+  void Erase(const ImageKey &key) override;
+  const ImageKey *Victim(const Evictable &evictable) const override;
+
+ private:
+  // (use count, last access, key)
+  using Rank = std::tuple<int64_t, int64_t, ImageKey>;
+  std::set<Rank> order_;
+  std::unordered_map<ImageKey, std::pair<int64_t, int64_t>> ranks_;
+  int64_t clock_ = 0;
+};
+
+/**
+ * @brief An image cache which, when full, makes room for new images by evicting the old ones,
+ *        as chosen by an `EvictionPolicy`.
+ *
+ * Each image is stored in a separate device allocation, obtained (and released) in stream order
+ * on an internal stream. The images returned by `Get` are protected from eviction until they
+ * are passed to `Release`.
+ * When the device memory approaches its budget (see mm::SetDeviceMemoryBudget), adding an image
+ * evicts half of the cached data instead.
+ */
+class DLL_PUBLIC ImageCacheEvicting : public ImageCache {
+ public:
+  DLL_PUBLIC ImageCacheEvicting(std::size_t cache_size,
+                                std::size_t image_size_threshold,
+                                std::unique_ptr<EvictionPolicy> policy,
+                                bool stats_enabled = false);
+
+  ~ImageCacheEvicting() override;
+
+  DISABLE_COPY_MOVE_ASSIGN(ImageCacheEvicting);
+
+  bool IsCached(const ImageKey& image_key) const override;
+
+  const ImageShape& GetShape(const ImageKey& image_key) const override;
+
+  bool TryGetShape(const ImageKey& image_key, ImageShape &shape) const override;
+
+  bool Read(const ImageKey& image_key,
+            void* destination_data,
+            cudaStream_t stream) const override;
+
+  void Add(const ImageKey& image_key,
+           const uint8_t *data,
+           const ImageShape& data_shape,
+           cudaStream_t stream) override;
+
+  DecodedImage Get(const ImageKey &image_key) const override;
+
+  void Release(span<const ImageKey> image_keys, cudaStream_t stream) const override;
+
+  void SyncToRead(cudaStream_t stream) const override;
+
+  std::size_t bytes_used() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_used_;
+  }
+
+  std::size_t num_evicted() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_evicted_;
+  }
+
+ private:
+  struct Entry {
+    mm::async_uptr<uint8_t> data;
+    ImageShape shape;
+    mutable int pins = 0;  // the number of `Get` calls not yet matched by `Release`
+  };
+
+  /**
+   * @brief Makes the internal stream wait for the work scheduled so far in `stream`
+   */
+  void SyncCacheStream(cudaStream_t stream) const;
+
+  void Evict(const ImageKey &image_key);
+
+  void print_stats() const;
+
+  std::size_t cache_size_ = 0;
+  std::size_t image_size_threshold_ = 0;
+  bool stats_enabled_ = false;
+
+  std::unordered_map<ImageKey, Entry> entries_;
+  std::unique_ptr<EvictionPolicy> policy_;
+  mutable std::mutex mutex_;
+  std::size_t bytes_used_ = 0;
+  std::size_t num_added_ = 0;
+  std::size_t num_evicted_ = 0;
+  mutable std::size_t num_reads_ = 0;
+
+  cudaStream_t cache_stream_;
+  cudaEvent_t cache_read_event_;
+  cudaEvent_t cache_write_event_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_EVICTING_H_
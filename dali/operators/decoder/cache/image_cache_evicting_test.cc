@@ -0,0 +1,176 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dali/operators/decoder/cache/image_cache_evicting.h"
+#include "dali/kernels/common/copy.h"
+
+namespace dali {
+namespace testing {
+
+struct ImageCacheEvictingTest : public ::testing::Test {
+  void SetUpImpl(std::size_t cache_size, std::unique_ptr<EvictionPolicy> policy) {
+    cache_.reset(new ImageCacheEvicting(cache_size, 0, std::move(policy), false));
+
+    for (std::size_t i = 0; i <= 10; i++) {
+      data_.push_back({std::to_string(i), std::vector<uint8_t>(i, i % 256)});
+    }
+  }
+
+  void AddImage(std::size_t i) {
+    cache_->Add(data_[i].first, &data_[i].second[0],
+                {static_cast<int64_t>(data_[i].second.size()), 1, 1}, 0);
+  }
+
+  void TouchImage(std::size_t i) {
+    std::vector<uint8_t> dst(data_[i].second.size());
+    EXPECT_TRUE(cache_->Read(data_[i].first, &dst[0], 0));
+    CUDA_CALL(cudaStreamSynchronize(0));
+    EXPECT_EQ(data_[i].second, dst);
+  }
+
+  bool IsCached(std::size_t i) { return cache_->IsCached(data_[i].first); }
+
+  std::unique_ptr<ImageCacheEvicting> cache_;
+
+  std::vector<std::pair<std::string, std::vector<uint8_t>>> data_;
+};
+
+TEST_F(ImageCacheEvictingTest, LRUEvictsLeastRecentlyUsed) {
+  SetUpImpl(9, std::make_unique<LRUEvictionPolicy>());
+  AddImage(2);
+  AddImage(3);
+  AddImage(4);
+  TouchImage(2);
+  AddImage(5);  // needs 5 bytes - evicts 3 and 4
+
+  EXPECT_TRUE(IsCached(2));
+  EXPECT_FALSE(IsCached(3));
+  EXPECT_FALSE(IsCached(4));
+  EXPECT_TRUE(IsCached(5));
+  EXPECT_EQ(cache_->bytes_used(), 7u);
+  EXPECT_EQ(cache_->num_evicted(), 2u);
+}
+
+TEST_F(ImageCacheEvictingTest, LFUEvictsLeastFrequentlyUsed) {
+  SetUpImpl(11, std::make_unique<LFUEvictionPolicy>());
+  AddImage(2);
+  AddImage(3);
+  AddImage(4);
+  TouchImage(2);
+  TouchImage(2);
+  TouchImage(3);
+  TouchImage(4);
+  TouchImage(4);
+  AddImage(3);  // already cached - no effect
+  AddImage(1);  // fits
+  AddImage(2);  // already cached - no effect
+  AddImage(5);  // evicts 1 (used once), then 3 (used twice, before 4)
+
+  EXPECT_FALSE(IsCached(1));
+  EXPECT_TRUE(IsCached(2));
+  EXPECT_FALSE(IsCached(3));
+  EXPECT_TRUE(IsCached(4));
+  EXPECT_TRUE(IsCached(5));
+}
+
+TEST_F(ImageCacheEvictingTest, TooLargeIsNotCached) {
+  SetUpImpl(4, std::make_unique<LRUEvictionPolicy>());
+  AddImage(3);
+  AddImage(5);
+  EXPECT_TRUE(IsCached(3));
+  EXPECT_FALSE(IsCached(5));
+  EXPECT_EQ(cache_->num_evicted(), 0u);
+}
+
+TEST_F(ImageCacheEvictingTest, GetProtectsFromEviction) {
+  SetUpImpl(4, std::make_unique<LRUEvictionPolicy>());
+  AddImage(4);
+  auto dev = cache_->Get("4");
+  ASSERT_NE(dev.data, nullptr);
+
+  AddImage(3);  // no space and nothing can be evicted
+  EXPECT_TRUE(IsCached(4));
+  EXPECT_FALSE(IsCached(3));
+
+  std::vector<uint8_t> dst(4, 0x00);
+  TensorView<StorageCPU, uint8_t, 3> host(dst.data(), dev.shape);
+  kernels::copy(host, dev);
+  std::vector<std::string> keys = { "4" };
+  cache_->Release(make_cspan(keys), 0);
+  CUDA_CALL(cudaStreamSynchronize(0));
+  EXPECT_EQ(data_[4].second, dst);
+
+  AddImage(3);
+  EXPECT_FALSE(IsCached(4));
+  EXPECT_TRUE(IsCached(3));
+}
+
+TEST_F(ImageCacheEvictingTest, ReadAfterEviction) {
+  SetUpImpl(1 << 9, std::make_unique<LRUEvictionPolicy>());
+  // many more images than fit in the cache - the memory of the evicted ones gets reused
+  for (int round = 0; round < 3; round++) {
+    for (std::size_t i = 1; i <= 10; i++) {
+      std::string key = std::to_string(round) + "_" + std::to_string(i);
+      std::vector<uint8_t> data(i * 20, round * 10 + i);
+      cache_->Add(key, &data[0], {static_cast<int64_t>(data.size()), 1, 1}, 0);
+      std::vector<uint8_t> dst(data.size(), 0x00);
+      ASSERT_TRUE(cache_->Read(key, &dst[0], 0));
+      CUDA_CALL(cudaStreamSynchronize(0));
+      EXPECT_EQ(data, dst);
+    }
+  }
+  EXPECT_LE(cache_->bytes_used(), 1u << 9);
+  EXPECT_GT(cache_->num_evicted(), 0u);
+}
+
+TEST(EvictionPolicyTest, LRUSkipsNonEvictable) {
+  LRUEvictionPolicy policy;
+  policy.Insert("a");
+  policy.Insert("b");
+  policy.Insert("c");
+  policy.Access("a");
+  auto any = [](const std::string &) { return true; };
+  auto not_b = [](const std::string &key) { return key != "b"; };
+  ASSERT_NE(policy.Victim(any), nullptr);
+  EXPECT_EQ(*policy.Victim(any), "b");
+  EXPECT_EQ(*policy.Victim(not_b), "c");
+  policy.Erase("b");
+  policy.Erase("c");
+  EXPECT_EQ(*policy.Victim(any), "a");
+  policy.Erase("a");
+  EXPECT_EQ(policy.Victim(any), nullptr);
+}
+
+TEST(EvictionPolicyTest, LFUBreaksTiesByAge) {
+  LFUEvictionPolicy policy;
+  policy.Insert("a");
+  policy.Insert("b");
+  policy.Insert("c");
+  policy.Access("c");
+  policy.Access("a");
+  auto any = [](const std::string &) { return true; };
+  EXPECT_EQ(*policy.Victim(any), "b");
+  policy.Access("b");
+  EXPECT_EQ(*policy.Victim(any), "c");
+  policy.Erase("c");
+  EXPECT_EQ(*policy.Victim(any), "a");
+}
+
+}  // namespace testing
+}  // namespace dali
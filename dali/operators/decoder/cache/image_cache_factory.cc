@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,7 +15,9 @@
 #include "dali/operators/decoder/cache/image_cache_factory.h"
 #include <memory>
 #include "dali/operators/decoder/cache/image_cache_blob.h"
+#include "dali/operators/decoder/cache/image_cache_evicting.h"
 #include "dali/operators/decoder/cache/image_cache_largest.h"
+#include "dali/operators/decoder/cache/image_cache_persistent.h"
 
 namespace dali {
 
@@ -23,9 +25,10 @@ std::shared_ptr<ImageCache> ImageCacheFactory::Get(int device_id,
                                                    const std::string& cache_policy,
                                                    std::size_t cache_size,
                                                    bool cache_debug,
-                                                   std::size_t cache_threshold) {
+                                                   std::size_t cache_threshold,
+                                                   const std::string& cache_path) {
   std::lock_guard<std::mutex> lock(mutex_);
-  const CacheParams params{cache_policy, cache_size, cache_debug, cache_threshold};
+  const CacheParams params{cache_policy, cache_size, cache_debug, cache_threshold, cache_path};
   auto &instance = caches_[device_id];
   auto cache = instance.cache.lock();
   if (!cache) {
@@ -33,6 +36,15 @@ std::shared_ptr<ImageCache> ImageCacheFactory::Get(int device_id,
       cache.reset(new ImageCacheBlob(cache_size, cache_threshold, cache_debug));
     } else if (cache_policy == "largest") {
       cache.reset(new ImageCacheLargest(cache_size, cache_debug));
+    } else if (cache_policy == "lru") {
+      cache.reset(new ImageCacheEvicting(cache_size, cache_threshold,
+                                         std::make_unique<LRUEvictionPolicy>(), cache_debug));
+    } else if (cache_policy == "lfu") {
+      cache.reset(new ImageCacheEvicting(cache_size, cache_threshold,
+                                         std::make_unique<LFUEvictionPolicy>(), cache_debug));
+    } else if (cache_policy == "persistent") {
+      DALI_ENFORCE(!cache_path.empty(), "The `persistent` cache requires `cache_path`.");
+      cache.reset(new ImageCachePersistent(cache_path, cache_size, cache_threshold, cache_debug));
     } else {
       DALI_FAIL("unexpected cache policy `" + cache_policy + "`");
     }
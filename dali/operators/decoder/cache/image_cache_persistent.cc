@@ -0,0 +1,255 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/cache/image_cache_persistent.h"
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "dali/core/error_handling.h"
+#include "dali/core/util.h"
+#include "dali/pipeline/data/backend.h"
+
+namespace dali {
+
+namespace {
+
+constexpr char kMagic[8] = { 'D', 'A', 'L', 'I', 'I', 'M', 'C', '1' };
+
+struct FileHeader {
+  char magic[8];
+  uint64_t end;  // the end of the last complete record
+};
+
+struct RecordHeader {
+  uint64_t key_size;
+  int64_t shape[3];
+};
+
+constexpr std::size_t kHeaderSize = 64;
+constexpr std::size_t kRecordAlignment = 8;
+// the file is grown in chunks, not to resize it with every image
+constexpr std::size_t kGrowSize = 64 << 20;
+
+static_assert(sizeof(FileHeader) <= kHeaderSize, "The file header doesn't fit");
+
+inline std::size_t RecordSize(std::size_t key_size, std::size_t data_size) {
+  return align_up(sizeof(RecordHeader) + key_size + data_size, kRecordAlignment);
+}
+
+}  // namespace
+
+ImageCachePersistent::ImageCachePersistent(const std::string &path,
+                                           std::size_t cache_size,
+                                           std::size_t image_size_threshold,
+                                           bool stats_enabled)
+    : path_(path)
+    , capacity_(kHeaderSize + cache_size)
+    , image_size_threshold_(image_size_threshold)
+    , stats_enabled_(stats_enabled) {
+  DALI_ENFORCE(!path_.empty(), "The path of the persistent cache file must not be empty");
+  DALI_ENFORCE(image_size_threshold <= cache_size, "Cache size should fit at least one image");
+
+  fd_ = open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  DALI_ENFORCE(fd_ >= 0, make_string("Cannot open the cache file \"", path_, "\": ",
+                                     std::strerror(errno)));
+  try {
+    DALI_ENFORCE(flock(fd_, LOCK_EX | LOCK_NB) == 0, make_string(
+        "The cache file \"", path_, "\" is already in use. Each cache (i.e. each device and "
+        "each process) needs a separate file."));
+
+    struct stat st;
+    DALI_ENFORCE(fstat(fd_, &st) == 0, make_string("Cannot stat the cache file \"", path_,
+                                                   "\": ", std::strerror(errno)));
+    file_size_ = st.st_size;
+    bool is_new = file_size_ == 0;
+    DALI_ENFORCE(is_new || file_size_ >= kHeaderSize,
+                 make_string("\"", path_, "\" is not a DALI image cache file."));
+
+    // Map the whole capacity up front, so that the pointers to the images stay valid when
+    // the file grows. Only the part backed by the file is accessed.
+    mapping_size_ = std::max(capacity_, file_size_);
+    void *ptr = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    DALI_ENFORCE(ptr != MAP_FAILED, make_string("Cannot map the cache file \"", path_, "\": ",
+                                                std::strerror(errno)));
+    mapping_ = static_cast<uint8_t *>(ptr);
+
+    if (is_new) {
+      Reserve(kHeaderSize);
+      FileHeader header{};
+      std::memcpy(header.magic, kMagic, sizeof(kMagic));
+      header.end = end_ = kHeaderSize;
+      std::memcpy(mapping_, &header, sizeof(header));
+    } else {
+      LoadIndex();
+    }
+  } catch (...) {
+    if (mapping_)
+      munmap(mapping_, mapping_size_);
+    close(fd_);
+    throw;
+  }
+}
+
+ImageCachePersistent::~ImageCachePersistent() {
+  if (stats_enabled_) print_stats();
+  msync(mapping_, end_, MS_SYNC);
+  munmap(mapping_, mapping_size_);
+  // drop the preallocated space
+  if (ftruncate(fd_, end_) != 0)
+    std::cerr << "Cannot truncate the cache file \"" << path_ << "\"" << std::endl;
+  close(fd_);
+}
+
+void ImageCachePersistent::LoadIndex() {
+  FileHeader header;
+  std::memcpy(&header, mapping_, sizeof(header));
+  DALI_ENFORCE(std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0,
+               make_string("\"", path_, "\" is not a DALI image cache file."));
+  DALI_ENFORCE(header.end >= kHeaderSize && header.end <= file_size_,
+               make_string("The cache file \"", path_, "\" is corrupted."));
+  end_ = header.end;
+
+  std::size_t offset = kHeaderSize;
+  while (offset < end_) {
+    RecordHeader record;
+    DALI_ENFORCE(offset + sizeof(record) <= end_,
+                 make_string("The cache file \"", path_, "\" is corrupted."));
+    std::memcpy(&record, mapping_ + offset, sizeof(record));
+    ImageShape shape{record.shape[0], record.shape[1], record.shape[2]};
+    std::size_t data_size = volume(shape);
+    std::size_t record_size = RecordSize(record.key_size, data_size);
+    DALI_ENFORCE(offset + record_size <= end_,
+                 make_string("The cache file \"", path_, "\" is corrupted."));
+    const char *key = reinterpret_cast<const char *>(mapping_ + offset + sizeof(record));
+    const uint8_t *data = mapping_ + offset + sizeof(record) + record.key_size;
+    entries_[ImageKey(key, record.key_size)] = { data, shape };
+    offset += record_size;
+  }
+  num_loaded_ = entries_.size();
+}
+
+void ImageCachePersistent::Reserve(std::size_t size) {
+  if (size <= file_size_)
+    return;
+  std::size_t new_size = std::min(std::max(size, file_size_ + kGrowSize), mapping_size_);
+  DALI_ENFORCE(ftruncate(fd_, new_size) == 0, make_string(
+      "Cannot resize the cache file \"", path_, "\": ", std::strerror(errno)));
+  file_size_ = new_size;
+}
+
+bool ImageCachePersistent::IsCached(const ImageKey& image_key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.find(image_key) != entries_.end();
+}
+
+const ImageCache::ImageShape& ImageCachePersistent::GetShape(const ImageKey& image_key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = entries_.find(image_key);
+  DALI_ENFORCE(it != entries_.end(), "cache entry [" + image_key + "] not found");
+  return it->second.shape;
+}
+
+bool ImageCachePersistent::TryGetShape(const ImageKey& image_key, ImageShape &shape) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = entries_.find(image_key);
+  if (it == entries_.end())
+    return false;
+  shape = it->second.shape;
+  return true;
+}
+
+bool ImageCachePersistent::Read(const ImageKey& image_key,
+                                void* destination_buffer,
+                                cudaStream_t stream) const {
+  DALI_ENFORCE(!image_key.empty());
+  DALI_ENFORCE(destination_buffer != nullptr);
+  Entry entry;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = entries_.find(image_key);
+    if (it == entries_.end())
+      return false;
+    entry = it->second;
+    num_reads_++;
+  }
+  // the images are never removed - the data can be read without the lock
+  MemCopy(destination_buffer, entry.data, volume(entry.shape), stream);
+  return true;
+}
+
+void ImageCachePersistent::Add(const ImageKey& image_key, const uint8_t* data,
+                               const ImageShape& data_shape, cudaStream_t stream) {
+  DALI_ENFORCE(!image_key.empty());
+  const std::size_t data_size = volume(data_shape);
+  if (data_size < image_size_threshold_ || data_size == 0)
+    return;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (is_full_ || entries_.find(image_key) != entries_.end())
+    return;
+
+  std::size_t record_size = RecordSize(image_key.size(), data_size);
+  if (end_ + record_size > capacity_) {
+    is_full_ = true;
+    return;
+  }
+  Reserve(end_ + record_size);
+
+  uint8_t *record_ptr = mapping_ + end_;
+  RecordHeader record{};
+  record.key_size = image_key.size();
+  for (int d = 0; d < 3; d++)
+    record.shape[d] = data_shape[d];
+  std::memcpy(record_ptr, &record, sizeof(record));
+  std::memcpy(record_ptr + sizeof(record), image_key.data(), image_key.size());
+  uint8_t *image_data = record_ptr + sizeof(record) + image_key.size();
+  MemCopy(image_data, data, data_size, stream);
+  // the record must be complete before it's committed in the header
+  CUDA_CALL(cudaStreamSynchronize(stream));
+
+  end_ += record_size;
+  uint64_t end = end_;
+  std::memcpy(mapping_ + offsetof(FileHeader, end), &end, sizeof(end));
+  entries_[image_key] = { image_data, data_shape };
+  num_added_++;
+}
+
+void ImageCachePersistent::print_stats() const {
+  static std::mutex stats_mutex;
+  std::lock_guard<std::mutex> lock(stats_mutex);
+  const char* log_filename = std::getenv("DALI_LOG_FILE");
+  std::ofstream log_file;
+  if (log_filename) log_file.open(log_filename);
+  std::ostream& out = log_filename ? log_file : std::cout;
+  out << "#################### CACHE STATS ####################" << std::endl;
+  out << "cache_file: " << path_ << std::endl;
+  out << "cache_size: " << capacity_ - kHeaderSize << std::endl;
+  out << "cache_threshold: " << image_size_threshold_ << std::endl;
+  out << "bytes_used: " << end_ - kHeaderSize << std::endl;
+  out << "images_loaded: " << num_loaded_ << std::endl;
+  out << "images_added: " << num_added_ << std::endl;
+  out << "reads: " << num_reads_ << std::endl;
+  out << "is_full: " << static_cast<int>(is_full_) << std::endl;
+  out << "#################### END   STATS ####################" << std::endl;
+}
+
+}  // namespace dali
@@ -0,0 +1,126 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_PERSISTENT_H_
+#define DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_PERSISTENT_H_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "dali/core/common.h"
+#include "dali/operators/decoder/cache/image_cache.h"
+
+namespace dali {
+
+/**
+ * @brief An image cache stored in a memory-mapped, append-only file.
+ *
+ * The images added to the cache are appended to the file, so they survive the process and
+ * can be served by the next pipelines using the same file (e.g. in the following runs of an
+ * evaluation script). The images are read directly from the mapping - the page cache of the
+ * OS decides what is kept in the host memory.
+ *
+ * The file consists of a header, followed by the records (key, shape and data of an image).
+ * The header holds the size of the complete records, so an interrupted write doesn't
+ * corrupt the file. A file can be used by only one cache at a time.
+ *
+ * The data is not device-accessible - the images must be obtained with Read.
+ */
+class DLL_PUBLIC ImageCachePersistent : public ImageCache {
+ public:
+  /**
+   * @param path                  the path of the cache file; created, if it doesn't exist
+   * @param cache_size            the maximum total size of the records in the file, in bytes
+   * @param image_size_threshold  the images smaller than this are not cached
+   */
+  DLL_PUBLIC ImageCachePersistent(const std::string &path,
+                                  std::size_t cache_size,
+                                  std::size_t image_size_threshold,
+                                  bool stats_enabled = false);
+
+  ~ImageCachePersistent() override;
+
+  DISABLE_COPY_MOVE_ASSIGN(ImageCachePersistent);
+
+  bool IsCached(const ImageKey& image_key) const override;
+
+  const ImageShape& GetShape(const ImageKey& image_key) const override;
+
+  bool TryGetShape(const ImageKey& image_key, ImageShape &shape) const override;
+
+  bool Read(const ImageKey& image_key,
+            void* destination_data,
+            cudaStream_t stream) const override;
+
+  void Add(const ImageKey& image_key,
+           const uint8_t *data,
+           const ImageShape& data_shape,
+           cudaStream_t stream) override;
+
+  DecodedImage Get(const ImageKey &image_key) const override {
+    return {};
+  }
+
+  bool IsDeviceAccessible() const override {
+    return false;
+  }
+
+  void SyncToRead(cudaStream_t stream) const override {}
+
+  std::size_t num_images() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+ private:
+  struct Entry {
+    const uint8_t *data;
+    ImageShape shape;
+  };
+
+  /**
+   * @brief Builds the index of the records already present in the file
+   */
+  void LoadIndex();
+
+  /**
+   * @brief Grows the file, so that it's at least `size` bytes long
+   */
+  void Reserve(std::size_t size);
+
+  void print_stats() const;
+
+  std::string path_;
+  std::size_t capacity_ = 0;  // the maximum size of the file, including the header
+  std::size_t image_size_threshold_ = 0;
+  bool stats_enabled_ = false;
+
+  int fd_ = -1;
+  uint8_t *mapping_ = nullptr;
+  std::size_t mapping_size_ = 0;
+  std::size_t file_size_ = 0;
+  std::size_t end_ = 0;  // the end of the last complete record
+
+  std::unordered_map<ImageKey, Entry> entries_;
+  mutable std::mutex mutex_;
+  std::size_t num_loaded_ = 0;
+  std::size_t num_added_ = 0;
+  mutable std::size_t num_reads_ = 0;
+  bool is_full_ = false;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_PERSISTENT_H_
@@ -0,0 +1,139 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dali/operators/decoder/cache/image_cache_persistent.h"
+
+namespace dali {
+namespace testing {
+
+struct ImageCachePersistentTest : public ::testing::Test {
+  void SetUp() override {
+    filename_ = "/tmp/dali_image_cache_test_XXXXXX";
+    int fd = mkstemp(&filename_[0]);
+    ASSERT_NE(-1, fd);
+    close(fd);
+
+    for (std::size_t i = 0; i <= 10; i++) {
+      data_.push_back({std::to_string(i), std::vector<uint8_t>(i, i % 256)});
+    }
+  }
+
+  void TearDown() override {
+    cache_.reset();
+    std::remove(filename_.c_str());
+  }
+
+  void Open(std::size_t cache_size, std::size_t threshold = 0) {
+    cache_.reset();
+    cache_ = std::make_unique<ImageCachePersistent>(filename_, cache_size, threshold);
+  }
+
+  void AddImage(std::size_t i) {
+    cache_->Add(data_[i].first, &data_[i].second[0],
+                {static_cast<int64_t>(data_[i].second.size()), 1, 1}, 0);
+  }
+
+  void CheckImage(std::size_t i) {
+    std::vector<uint8_t> dst(data_[i].second.size());
+    ASSERT_TRUE(cache_->Read(data_[i].first, &dst[0], 0));
+    CUDA_CALL(cudaStreamSynchronize(0));
+    EXPECT_EQ(data_[i].second, dst);
+    ImageCache::ImageShape shape;
+    ASSERT_TRUE(cache_->TryGetShape(data_[i].first, shape));
+    EXPECT_EQ(shape, ImageCache::ImageShape(data_[i].second.size(), 1, 1));
+  }
+
+  bool IsCached(std::size_t i) { return cache_->IsCached(data_[i].first); }
+
+  std::string filename_;
+  std::unique_ptr<ImageCachePersistent> cache_;
+  std::vector<std::pair<std::string, std::vector<uint8_t>>> data_;
+};
+
+TEST_F(ImageCachePersistentTest, AddAndRead) {
+  Open(1 << 20);
+  EXPECT_FALSE(cache_->IsDeviceAccessible());
+  for (std::size_t i = 1; i <= 10; i++)
+    AddImage(i);
+  for (std::size_t i = 1; i <= 10; i++)
+    CheckImage(i);
+  EXPECT_FALSE(IsCached(0));  // empty images are not cached
+  EXPECT_EQ(cache_->num_images(), 10u);
+}
+
+TEST_F(ImageCachePersistentTest, SurvivesReopening) {
+  Open(1 << 20);
+  for (std::size_t i = 1; i <= 5; i++)
+    AddImage(i);
+  Open(1 << 20);
+  EXPECT_EQ(cache_->num_images(), 5u);
+  for (std::size_t i = 1; i <= 5; i++)
+    CheckImage(i);
+  EXPECT_FALSE(IsCached(6));
+
+  // the images are appended to the existing ones
+  for (std::size_t i = 6; i <= 10; i++)
+    AddImage(i);
+  Open(1 << 20);
+  EXPECT_EQ(cache_->num_images(), 10u);
+  for (std::size_t i = 1; i <= 10; i++)
+    CheckImage(i);
+}
+
+TEST_F(ImageCachePersistentTest, Threshold) {
+  Open(1 << 20, 5);
+  AddImage(4);
+  AddImage(5);
+  EXPECT_FALSE(IsCached(4));
+  EXPECT_TRUE(IsCached(5));
+}
+
+TEST_F(ImageCachePersistentTest, StopsWhenFull) {
+  // each record takes (header + key + data) bytes, aligned to 8
+  Open(128);
+  for (std::size_t i = 1; i <= 10; i++)
+    AddImage(i);
+  std::size_t cached = cache_->num_images();
+  EXPECT_GT(cached, 0u);
+  EXPECT_LT(cached, 10u);
+  for (std::size_t i = 1; i <= cached; i++)
+    CheckImage(i);
+  for (std::size_t i = cached + 1; i <= 10; i++)
+    EXPECT_FALSE(IsCached(i));
+}
+
+TEST_F(ImageCachePersistentTest, FileInUse) {
+  Open(1 << 20);
+  EXPECT_THROW(ImageCachePersistent(filename_, 1 << 20, 0), std::exception);
+}
+
+TEST_F(ImageCachePersistentTest, NotACacheFile) {
+  FILE *f = std::fopen(filename_.c_str(), "wb");
+  ASSERT_NE(f, nullptr);
+  std::vector<char> garbage(100, 'x');
+  std::fwrite(garbage.data(), 1, garbage.size(), f);
+  std::fclose(f);
+  EXPECT_THROW(Open(1 << 20), std::exception);
+}
+
+}  // namespace testing
+}  // namespace dali
@@ -32,6 +32,11 @@ class HostDecoderCrop : public HostDecoder, protected CropAttr {
   void RunImpl(Workspace &ws) override;
   using HostDecoder::RunImpl;
 
+  // the crop windows depend on the batch arguments, processed by the batch RunImpl
+  bool CanRunPerSample() const override {
+    return false;
+  }
+
  protected:
   inline CropWindowGenerator GetCropWindowGenerator(int data_idx) const override {
     return CropAttr::GetCropWindowGenerator(data_idx);
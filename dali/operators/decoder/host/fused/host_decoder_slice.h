@@ -35,6 +35,11 @@ class HostDecoderSlice : public HostDecoder {
     HostDecoder::RunImpl(ws);
   }
 
+  // the crop windows depend on the batch arguments, processed by the batch RunImpl
+  bool CanRunPerSample() const override {
+    return false;
+  }
+
  protected:
   inline CropWindowGenerator GetCropWindowGenerator(int data_idx) const override {
     return slice_attr_.GetCropWindowGenerator(data_idx);
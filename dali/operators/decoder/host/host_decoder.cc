@@ -37,6 +37,7 @@ void HostDecoder::RunImpl(SampleWorkspace &ws) {
     img = ImageFactory::CreateImage(input.data<uint8_t>(), input.size(), output_type_);
     img->SetCropWindowGenerator(GetCropWindowGenerator(ws.data_idx()));
     img->SetUseFastIdct(use_fast_idct_);
+    img->SetMinDecodedSize(min_decoded_size_.first, min_decoded_size_.second);
     img->Decode();
   } catch (std::exception &e) {
     DALI_FAIL(e.what(), ". File: ", file_name);
@@ -15,6 +15,7 @@
 #ifndef DALI_OPERATORS_DECODER_HOST_HOST_DECODER_H_
 #define DALI_OPERATORS_DECODER_HOST_HOST_DECODER_H_
 
+#include <utility>
 #include <vector>
 
 #include "dali/core/common.h"
@@ -30,8 +31,16 @@ class HostDecoder : public StatelessOperator<CPUBackend> {
   explicit inline HostDecoder(const OpSpec &spec) :
       StatelessOperator<CPUBackend>(spec),
       output_type_(spec.GetArgument<DALIImageType>("output_type")),
-      use_fast_idct_(spec.GetArgument<bool>("use_fast_idct"))
-  {}
+      use_fast_idct_(spec.GetArgument<bool>("use_fast_idct")) {
+    // not available in the fused decoders - they decode the ROI, at the original resolution
+    std::vector<int> min_size;
+    if (spec.TryGetRepeatedArgument(min_size, "min_decoded_size") && !min_size.empty()) {
+      DALI_ENFORCE(min_size.size() == 2 && min_size[0] >= 0 && min_size[1] >= 0,
+                   make_string("`min_decoded_size` must consist of two non-negative values "
+                               "(height, width). Got: ", TensorShape<>(min_size)));
+      min_decoded_size_ = {min_size[0], min_size[1]};
+    }
+  }
 
   inline ~HostDecoder() override = default;
   DISABLE_COPY_MOVE_ASSIGN(HostDecoder);
@@ -40,6 +49,10 @@ class HostDecoder : public StatelessOperator<CPUBackend> {
     return false;
   }
 
+  bool CanRunPerSample() const override {
+    return true;
+  }
+
   bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override {
     return false;
   }
@@ -49,12 +62,17 @@ class HostDecoder : public StatelessOperator<CPUBackend> {
   using StatelessOperator<CPUBackend>::RunImpl;
 
  protected:
+  bool BatchedSampleScheduling() const override {
+    return true;
+  }
+
   virtual CropWindowGenerator GetCropWindowGenerator(int data_idx) const {
     return {};
   }
 
   DALIImageType output_type_;
   bool use_fast_idct_ = false;
+  std::pair<int, int> min_decoded_size_ = {0, 0};
 };
 
 }  // namespace dali
@@ -98,6 +98,15 @@ class Image {
     return use_fast_idct_;
   }
 
+  /**
+   * Allows decoding at a reduced resolution, if supported by the format, as long as
+   * the decoded image is not smaller than `height` x `width`.
+   * Ignored if a crop window is set.
+   */
+  inline void SetMinDecodedSize(int height, int width) {
+    min_decoded_size_ = {height, width};
+  }
+
   virtual ~Image() = default;
   DISABLE_COPY_MOVE_ASSIGN(Image);
 
@@ -129,12 +138,20 @@ class Image {
     return crop_window_generator_;
   }
 
+  /**
+   * Gets the minimum size (height, width) of the decoded image - {0, 0} if not set
+   */
+  inline std::pair<int, int> GetMinDecodedSize() const {
+    return min_decoded_size_;
+  }
+
  private:
   const uint8_t *encoded_image_;
   const size_t length_;
   const DALIImageType image_type_;
   bool decoded_ = false;
   bool use_fast_idct_ = false;
+  std::pair<int, int> min_decoded_size_ = {0, 0};
   Shape shape_;
   CropWindowGenerator crop_window_generator_;
   std::shared_ptr<uint8_t> decoded_image_ = nullptr;
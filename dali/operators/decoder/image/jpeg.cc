@@ -18,9 +18,26 @@
 #include "dali/operators/decoder/jpeg/jpeg_mem.h"
 #include "dali/util/ocv.h"
 #include "dali/core/byte_io.h"
+#include "dali/core/util.h"
 
 namespace dali {
 
+namespace {
+
+/**
+ * Picks the largest downscaling ratio supported by libjpeg, for which the decoded image is
+ * not smaller than `min_h` x `min_w`.
+ */
+int DownscalingRatio(int h, int w, int min_h, int min_w) {
+  for (int ratio = 8; ratio > 1; ratio /= 2) {
+    if (div_ceil(h, ratio) >= min_h && div_ceil(w, ratio) >= min_w)
+      return ratio;
+  }
+  return 1;
+}
+
+}  // namespace
+
 JpegImage::JpegImage(const uint8_t *encoded_buffer,
                      size_t length,
                      DALIImageType image_type)
@@ -98,6 +115,14 @@ JpegImage::DecodeImpl(DALIImageType type, const uint8_t *jpeg, size_t length) co
     flags.crop_x = crop.anchor[1];
     flags.crop_height = target_shape[0] = crop.shape[0];
     flags.crop_width  = target_shape[1] = crop.shape[1];
+  } else {
+    auto min_size = GetMinDecodedSize();
+    if (min_size.first > 0 || min_size.second > 0) {
+      // libjpeg scales the DCT, so it decodes a smaller image at a fraction of the cost
+      flags.ratio = DownscalingRatio(h, w, min_size.first, min_size.second);
+      target_shape[0] = div_ceil(h, flags.ratio);
+      target_shape[1] = div_ceil(w, flags.ratio);
+    }
   }
 
   DALI_ENFORCE(type == DALI_RGB || type == DALI_BGR || type == DALI_GRAY,
@@ -102,6 +102,28 @@ if available. The optimal workload depends on the number of threads that are pro
 the DALI pipeline and should be found empirically. More details can be found at
 https://developer.nvidia.com/blog/loading-data-fast-with-dali-and-new-jpeg-decoder-in-a100)code",
       0.65f)
+  .AddOptionalArg("adaptive_hw_decoder_load",
+      R"code(Tunes the load of the HW JPEG decoder during the run.
+
+Applies **only** to the ``mixed`` backend type in NVIDIA Ampere GPU and newer architecture.
+
+If set, ``hw_decoder_load`` is only the initial value. After each iteration, the time it took
+the HW decoder and the rest of the decoding (done in CUDA and on the host) to process their
+parts of the batch is measured, and the load is moved towards the backend with spare capacity.
+The current value can be read from the ``hw_decoder_load`` diagnostic of the operator.)code",
+      false)
+  .AddOptionalArg("double_buffered_decode",
+      R"code(Uses two device buffers per thread for the hybrid (host + CUDA) decoding.
+
+Applies **only** to the ``mixed`` backend type.
+
+With a single buffer, the host (Huffman) decoding of an image can't finish before
+the GPU is done with the previous image of the same thread. With two buffers, the host part
+runs ahead by one more image, so it overlaps with the GPU work of the previous images - also
+between the iterations, as the decoder doesn't wait for the GPU at the end of the iteration.
+Useful when the GPU is shared with other work. Doubles the device memory used by
+the decoding buffers.)code",
+      false)
   .AddOptionalArg("preallocate_width_hint",
       R"code(Image width hint.
 
@@ -190,6 +212,18 @@ Please note that GPU acceleration for JPEG 2000 decoding is only available for C
   EXIF orientation metadata is disregarded.)code")
   .NumInput(1)
   .NumOutput(1)
+  .AddOptionalArg<std::vector<int>>("min_decoded_size",
+      R"code(The minimum size (height, width) of the decoded image.
+
+Applies **only** to JPEG images decoded with the ``cpu`` backend.
+
+If provided, the images are decoded at the reduced resolution of 1/2, 1/4 or 1/8, which takes
+a fraction of the time of the full decoding, choosing the smallest one for which the image is still
+at least as large as requested. Useful when the images are downscaled right after decoding -
+for example, when followed by ``resize`` with ``resize_shorter=224``, pass ``(224, 224)``.
+
+The dimensions of the reduced image are rounded up, so its aspect ratio can differ slightly
+from the original one.)code", {})
   .AddParent("ImageDecoderAttr")
   .AddParent("CachedDecoderAttr");
 
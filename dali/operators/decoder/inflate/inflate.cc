@@ -69,8 +69,20 @@ in the input tensor and the first chunk starts at the beginning of the sample.)c
                                       nullptr, true)
     .AddOptionalArg(inflate::algArgName, R"code(Algorithm to be used to decode the data.
 
-Currently only ``LZ4`` is supported.)code",
+Supported values are ``LZ4``, ``ZSTD`` and ``DEFLATE`` (a raw stream, without the zlib
+or gzip header).)code",
                     "LZ4")
+    .AddOptionalArg(inflate::blockSizeArgName,
+                    R"code(The size, in bytes, of the inflated blocks of a sample.
+
+If positive, the chunks described by ``chunk_offsets`` or ``chunk_sizes`` are not elements
+of a sequence, but independently compressed, consecutive blocks of a single sample: the i-th
+chunk inflates to the bytes ``[i * block_size, (i + 1) * block_size)`` of the output sample
+(the last one may be shorter). The ``shape`` describes the whole sample and no extra
+dimension is added.
+
+Splitting large samples into blocks lets them be decompressed in parallel.)code",
+                    0)
     .AddOptionalArg(inflate::layoutArgName,
                     R"code(Layout of the output (inflated) chunk.
 
@@ -53,7 +53,7 @@ class InflateOpImplBase : public OpImplBase<Backend> {
         make_string("Input must be a buffer with compressed data/data chunks represented as a 1D "
                     "tensor of uint8. Got input with ",
                     input_shape.sample_dim(), " dimensions instead."));
-    params_.ProcessInputArgs(ws, input_shape.num_samples());
+    params_.ProcessInputArgs(ws, input_shape.num_samples(), dtype_);
     output_desc.resize(1);
     output_desc[0].shape = params_.GetOutputShape();
     output_desc[0].type = dtype_;
@@ -12,8 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <nvcomp/deflate.h>
 #include <nvcomp/lz4.h>
+#include <nvcomp/zstd.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -112,9 +115,10 @@ inline void cudaResultCheck<nvcompStatus_t>(nvcompStatus_t status, const string
 
 namespace inflate {
 
-class InflateOpGpuLZ4Impl : public InflateOpImplBase<GPUBackend> {
+class InflateOpGpuImpl : public InflateOpImplBase<GPUBackend> {
  public:
-  explicit InflateOpGpuLZ4Impl(const OpSpec &spec) : InflateOpImplBase<GPUBackend>{spec} {}
+  InflateOpGpuImpl(const OpSpec &spec, InflateAlg alg)
+      : InflateOpImplBase<GPUBackend>{spec}, alg_{alg} {}
 
   void RunImpl(Workspace &ws) override {
     const auto &input = ws.template Input<GPUBackend>(0);
@@ -137,13 +141,11 @@ class InflateOpGpuLZ4Impl : public InflateOpImplBase<GPUBackend> {
         stream, params_.GetInChunkSizes(), input_ptrs_, inflated_sizes_, inflated_ptrs_);
 
     size_t tempSize;
-    CUDA_CALL(nvcompBatchedLZ4DecompressGetTempSize(total_chunks_num, params_.GetMaxOutChunkVol(),
-                                                     &tempSize));
+    CUDA_CALL(DecompressGetTempSize(total_chunks_num, params_.GetMaxOutChunkVol(), &tempSize));
 
     void *temp = scratchpad.AllocateGPU<uint8_t>(tempSize);
-    CUDA_CALL(nvcompBatchedLZ4DecompressAsync(in, in_sizes, out_sizes, actual_out_sizes,
-                                               total_chunks_num, temp, tempSize, out, nullptr,
-                                               stream));
+    CUDA_CALL(DecompressAsync(in, in_sizes, out_sizes, actual_out_sizes, total_chunks_num, temp,
+                              tempSize, out, stream));
 
     // nvCOMP uses ``out_sizes`` to avoid OOB accesses if the actual data size after the compression
     // is greater than what follows from the shapes reported by the user.
@@ -153,6 +155,37 @@ class InflateOpGpuLZ4Impl : public InflateOpImplBase<GPUBackend> {
   }
 
  protected:
+  nvcompStatus_t DecompressGetTempSize(size_t num_chunks, size_t max_out_chunk_size,
+                                       size_t *temp_size) const {
+    switch (alg_) {
+      case InflateAlg::ZSTD:
+        return nvcompBatchedZstdDecompressGetTempSize(num_chunks, max_out_chunk_size, temp_size);
+      case InflateAlg::DEFLATE:
+        return nvcompBatchedDeflateDecompressGetTempSize(num_chunks, max_out_chunk_size,
+                                                         temp_size);
+      default:
+        return nvcompBatchedLZ4DecompressGetTempSize(num_chunks, max_out_chunk_size, temp_size);
+    }
+  }
+
+  nvcompStatus_t DecompressAsync(const void *const *in, const size_t *in_sizes,
+                                 const size_t *out_sizes, size_t *actual_out_sizes,
+                                 size_t num_chunks, void *temp, size_t temp_size,
+                                 void *const *out, cudaStream_t stream) const {
+    switch (alg_) {
+      case InflateAlg::ZSTD:
+        return nvcompBatchedZstdDecompressAsync(in, in_sizes, out_sizes, actual_out_sizes,
+                                                num_chunks, temp, temp_size, out, nullptr, stream);
+      case InflateAlg::DEFLATE:
+        return nvcompBatchedDeflateDecompressAsync(in, in_sizes, out_sizes, actual_out_sizes,
+                                                   num_chunks, temp, temp_size, out, nullptr,
+                                                   stream);
+      default:
+        return nvcompBatchedLZ4DecompressAsync(in, in_sizes, out_sizes, actual_out_sizes,
+                                               num_chunks, temp, temp_size, out, nullptr, stream);
+    }
+  }
+
   template <typename TL>
   void SetupInChunks(const TL &input) {
     auto in_view = view<const uint8_t>(input);
@@ -173,15 +206,44 @@ class InflateOpGpuLZ4Impl : public InflateOpImplBase<GPUBackend> {
 
   template <typename TL>
   void SetupOutChunks(TL &output) {
+    if (params_.HasBlocks()) {
+      SetupOutBlocks(output);
+      return;
+    }
     TYPE_SWITCH(output.type(), type2id, Out, INFLATE_SUPPORTED_TYPES, (
       BOOL_SWITCH(params_.HasChunks(), HasChunks, (
         SetupOutChunksTyped<HasChunks, Out>(output);
       ));  //NOLINT
     ), DALI_FAIL(  //NOLINT
-      make_string("Unsupported output type was specified for GPU inflate LZ4 operator: `",
+      make_string("Unsupported output type was specified for GPU inflate operator: `",
                   output.type(), "`.")));
   }
 
+  /**
+   * @brief Each sample is inflated from several blocks, which are decompressed in parallel.
+   */
+  template <typename TL>
+  void SetupOutBlocks(TL &output) {
+    auto batch_size = output.num_samples();
+    auto total_chunks_num = params_.GetTotalChunkNum();
+    const auto &num_chunks_per_sample = params_.GetChunksNumPerSample();
+    size_t block_size = params_.GetBlockSize();
+    inflated_ptrs_.clear();
+    inflated_ptrs_.reserve(total_chunks_num);
+    inflated_sizes_.clear();
+    inflated_sizes_.reserve(total_chunks_num);
+    for (int sample_idx = 0; sample_idx < batch_size; sample_idx++) {
+      auto *sample_data = static_cast<uint8_t *>(output.raw_mutable_tensor(sample_idx));
+      size_t sample_bytes = output.shape()[sample_idx].num_elements() * output.type_info().size();
+      auto num_blocks = num_chunks_per_sample[sample_idx].num_elements();
+      for (int64_t block_idx = 0; block_idx < num_blocks; block_idx++) {
+        size_t offset = block_idx * block_size;
+        inflated_sizes_.push_back(std::min(block_size, sample_bytes - offset));
+        inflated_ptrs_.push_back(static_cast<void *>(sample_data + offset));
+      }
+    }
+  }
+
   template <bool has_chunks, typename Out, typename TL>
   void SetupOutChunksTyped(TL &output) {
     auto out_view = view<Out>(output);
@@ -205,6 +267,7 @@ class InflateOpGpuLZ4Impl : public InflateOpImplBase<GPUBackend> {
   std::vector<const void *> input_ptrs_;
   std::vector<void *> inflated_ptrs_;
   std::vector<size_t> inflated_sizes_;
+  InflateAlg alg_;
 };
 
 }  // namespace inflate
@@ -212,10 +275,7 @@ class InflateOpGpuLZ4Impl : public InflateOpImplBase<GPUBackend> {
 template <>
 void Inflate<GPUBackend>::SetupOpImpl() {
   if (!impl_) {
-    DALI_ENFORCE(alg_ == inflate::InflateAlg::LZ4,
-                 make_string("Algorithm `", to_string(alg_),
-                             "` is not supported by the GPU inflate operator."));
-    impl_ = std::make_unique<inflate::InflateOpGpuLZ4Impl>(spec_);
+    impl_ = std::make_unique<inflate::InflateOpGpuImpl>(spec_, alg_);
   }
 }
 
@@ -21,6 +21,7 @@
 #include "dali/core/backend_tags.h"
 #include "dali/core/common.h"
 #include "dali/core/tensor_shape.h"
+#include "dali/core/util.h"
 #include "dali/pipeline/data/types.h"
 #include "dali/pipeline/operator/arg_helper.h"
 #include "dali/pipeline/operator/operator.h"
@@ -36,15 +37,22 @@ constexpr static const char *offsetArgName = "chunk_offsets";
 constexpr static const char *sizeArgName = "chunk_sizes";
 constexpr static const char *layoutArgName = "layout";
 constexpr static const char *sequenceLayoutArgName = "sequence_axis_name";
+constexpr static const char *blockSizeArgName = "block_size";
 
 enum class InflateAlg {
-  LZ4
+  LZ4,
+  ZSTD,
+  DEFLATE
 };
 
 inline std::string to_string(InflateAlg alg) {
   switch (alg) {
     case InflateAlg::LZ4:
       return "LZ4";
+    case InflateAlg::ZSTD:
+      return "ZSTD";
+    case InflateAlg::DEFLATE:
+      return "DEFLATE";
     default:
       return "<unknown>";
   }
@@ -55,6 +63,12 @@ inline InflateAlg parse_inflate_alg(std::string str) {
   if (str == "lz4") {
     return InflateAlg::LZ4;
   }
+  if (str == "zstd") {
+    return InflateAlg::ZSTD;
+  }
+  if (str == "deflate") {
+    return InflateAlg::DEFLATE;
+  }
   DALI_FAIL(make_string("Unknown inflate algorithm \"", str, "\"."));
 }
 
@@ -67,21 +81,29 @@ class ShapeParams {
         chunk_offsets_{offsetArgName, spec},
         chunk_sizes_{sizeArgName, spec},
         layout_{spec.GetArgument<TensorLayout>(layoutArgName)},
-        sequence_axis_name_{spec.GetArgument<TensorLayout>(sequenceLayoutArgName)} {
+        sequence_axis_name_{spec.GetArgument<TensorLayout>(sequenceLayoutArgName)},
+        block_size_{spec.GetArgument<int>(blockSizeArgName)} {
     DALI_ENFORCE(sequence_axis_name_.size() == 1,
                  make_string("The `", sequenceLayoutArgName, "` must be a single character, got \"",
                              sequence_axis_name_, "\"."));
+    DALI_ENFORCE(block_size_ >= 0, make_string("The `", blockSizeArgName,
+                                               "` must be non-negative, got ", block_size_, "."));
+    DALI_ENFORCE(!HasBlocks() || HasChunks(),
+                 make_string("The `", blockSizeArgName, "` requires the blocks to be described "
+                             "with `", offsetArgName, "` or `", sizeArgName, "`."));
   }
 
-  void ProcessInputArgs(const Workspace &ws, int batch_size) {
+  void ProcessInputArgs(const Workspace &ws, int batch_size, DALIDataType dtype) {
     SetupOffsetsAndSizes(ws);
     shape_.Acquire(spec_, ws, batch_size, ArgValue_EnforceUniform, ArgShapeFromSize<1>{});
     SetupOutputShape(shape_.get());
+    if (HasBlocks())
+      ValidateBlocks(TypeTable::GetTypeInfo(dtype).size());
     SetupOutputLayout();
   }
 
   auto GetMaxOutChunkVol() const {
-    return max_output_sample_vol_;
+    return HasBlocks() ? static_cast<int64_t>(block_size_) : max_output_sample_vol_;
   }
 
   auto GetTotalChunkNum() const {
@@ -115,6 +137,25 @@ class ShapeParams {
     return HasExplicitChunkOffsets() || HasExplicitChunkSizes();
   }
 
+  /**
+   * @brief If true, the chunks are the consecutive, independently compressed blocks
+   * of a single output sample (rather than the elements of a sequence).
+   */
+  bool HasBlocks() const {
+    return block_size_ > 0;
+  }
+
+  int GetBlockSize() const {
+    return block_size_;
+  }
+
+  /**
+   * @brief Whether the chunks form an extra, outermost dimension of the output.
+   */
+  bool HasSequenceDim() const {
+    return HasChunks() && !HasBlocks();
+  }
+
  private:
   bool HasExplicitChunkOffsets() const {
     return chunk_offsets_.HasExplicitValue();
@@ -128,12 +169,12 @@ class ShapeParams {
     if (layout_.empty()) {
       return;
     }
-    auto sample_dim = GetOutputShape().sample_dim() - HasChunks();
+    auto sample_dim = GetOutputShape().sample_dim() - HasSequenceDim();
     DALI_ENFORCE(
         layout_.size() == sample_dim,
         make_string("The layout \"", layout_, "\" has a different number of dimensions (",
                     layout_.size(), ") than the requested output shape (", sample_dim, ")."));
-    if (!HasChunks()) {
+    if (!HasSequenceDim()) {
       output_layout_ = layout_;
     } else {
       output_layout_ = sequence_axis_name_ + layout_;
@@ -329,7 +370,7 @@ class ShapeParams {
                  make_string("The shape argument must be a scalar or a 1D tensor, got tensor with ",
                              provided_shape.sample_dim(), " extents."));
     auto chunk_shapes = ParseOutputShape(provided_shape);
-    if (!HasChunks()) {
+    if (!HasSequenceDim()) {
       output_shape_ = chunk_shapes;
     } else {
       int batch_size = chunk_shapes.num_samples();
@@ -342,6 +383,18 @@ class ShapeParams {
     }
   }
 
+  void ValidateBlocks(size_t type_size) {
+    for (int sample_idx = 0; sample_idx < output_shape_.num_samples(); sample_idx++) {
+      int64_t sample_bytes = output_shape_[sample_idx].num_elements() * type_size;
+      int64_t num_blocks = div_ceil(sample_bytes, static_cast<uint64_t>(block_size_));
+      DALI_ENFORCE(chunks_per_sample_[sample_idx].num_elements() == num_blocks,
+                   make_string("The sample of idx ", sample_idx, " inflates to ", sample_bytes,
+                               " bytes, which, with the `", blockSizeArgName, "` of ",
+                               block_size_, ", requires ", num_blocks, " blocks. Got ",
+                               chunks_per_sample_[sample_idx].num_elements(), " blocks."));
+    }
+  }
+
   TensorListShape<> ParseOutputShape(const TensorListView<StorageCPU, const int> &provided_shape) {
     auto num_samples = provided_shape.num_samples();
     if (num_samples == 0) {
@@ -372,6 +425,7 @@ class ShapeParams {
   ArgValue<int, 1> chunk_sizes_;
   TensorLayout layout_;
   TensorLayout sequence_axis_name_ = 0;
+  int block_size_ = 0;
 
   TensorListShape<1> chunks_per_sample_;
   std::vector<int64_t> offsets_;
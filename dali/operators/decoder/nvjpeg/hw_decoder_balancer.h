@@ -0,0 +1,85 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_NVJPEG_HW_DECODER_BALANCER_H_
+#define DALI_OPERATORS_DECODER_NVJPEG_HW_DECODER_BALANCER_H_
+
+#include <algorithm>
+#include <cassert>
+
+namespace dali {
+
+/**
+ * @brief Tunes the fraction of the batch processed by the HW JPEG decoder.
+ *
+ * The throughput (samples per second) of the HW decoder and of the other decoding backends
+ * (CUDA and host) is measured in each iteration and smoothed with an exponential moving average.
+ * The load is chosen so that both parts of the batch take the same time to decode. It is kept
+ * within [kMinLoad, kMaxLoad], so that both parts are always measured.
+ */
+class HwDecoderBalancer {
+ public:
+  static constexpr float kMinLoad = 0.05f;
+  static constexpr float kMaxLoad = 0.95f;
+
+  HwDecoderBalancer() = default;
+
+  /**
+   * @param initial_load  the load used until both throughputs are known
+   * @param smoothing     the weight of the latest measurement, in (0, 1]
+   */
+  explicit HwDecoderBalancer(float initial_load, float smoothing = 0.25f)
+      : load_(std::clamp(initial_load, kMinLoad, kMaxLoad)), smoothing_(smoothing) {
+    assert(smoothing > 0 && smoothing <= 1);
+  }
+
+  float load() const {
+    return load_;
+  }
+
+  /**
+   * @brief Updates the load with the measurements of a single iteration.
+   *
+   * Any part may be empty (with 0 samples) - the previous estimate of its throughput is kept then.
+   *
+   * @param hw_samples    the number of samples decoded by the HW decoder
+   * @param hw_time       the time it took, in seconds
+   * @param other_samples the number of samples decoded with the other backends
+   * @param other_time    the time it took, in seconds
+   * @return the new load
+   */
+  float Update(int hw_samples, double hw_time, int other_samples, double other_time) {
+    UpdateRate(hw_rate_, hw_samples, hw_time);
+    UpdateRate(other_rate_, other_samples, other_time);
+    if (hw_rate_ > 0 && other_rate_ > 0)
+      load_ = std::clamp<float>(hw_rate_ / (hw_rate_ + other_rate_), kMinLoad, kMaxLoad);
+    return load_;
+  }
+
+ private:
+  void UpdateRate(double &rate, int samples, double time) const {
+    if (samples <= 0 || time <= 0)
+      return;
+    double current = samples / time;
+    rate = rate > 0 ? rate + smoothing_ * (current - rate) : current;
+  }
+
+  float load_ = 0;
+  float smoothing_ = 0.25f;
+  double hw_rate_ = 0, other_rate_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_NVJPEG_HW_DECODER_BALANCER_H_
@@ -0,0 +1,79 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include "dali/operators/decoder/nvjpeg/hw_decoder_balancer.h"
+
+namespace dali {
+namespace testing {
+
+namespace {
+
+/**
+ * Simulates decoding a batch of `batch_size` samples, where the HW decoder and the other
+ * backends have a fixed throughput (samples per second).
+ */
+void Simulate(HwDecoderBalancer &balancer, int batch_size, double hw_rate, double other_rate,
+              int iters) {
+  for (int i = 0; i < iters; i++) {
+    int hw_samples = std::round(balancer.load() * batch_size);
+    int other_samples = batch_size - hw_samples;
+    balancer.Update(hw_samples, hw_samples / hw_rate, other_samples, other_samples / other_rate);
+  }
+}
+
+}  // namespace
+
+TEST(HwDecoderBalancerTest, InitialLoad) {
+  HwDecoderBalancer balancer(0.65f);
+  EXPECT_EQ(balancer.load(), 0.65f);
+  // only one part measured - not enough to tune the load
+  EXPECT_EQ(balancer.Update(10, 0.1, 0, 0), 0.65f);
+}
+
+TEST(HwDecoderBalancerTest, ConvergesToEqualTime) {
+  HwDecoderBalancer balancer(0.5f);
+  Simulate(balancer, 256, 3000, 1000, 20);
+  EXPECT_NEAR(balancer.load(), 0.75f, 0.01f);
+}
+
+TEST(HwDecoderBalancerTest, FollowsChanges) {
+  HwDecoderBalancer balancer(0.9f);
+  Simulate(balancer, 256, 1000, 1000, 30);
+  EXPECT_NEAR(balancer.load(), 0.5f, 0.01f);
+  // the GPU got busy with other work - the CUDA decoding slows down
+  Simulate(balancer, 256, 1000, 250, 30);
+  EXPECT_NEAR(balancer.load(), 0.8f, 0.01f);
+}
+
+TEST(HwDecoderBalancerTest, KeepsBothPartsBusy) {
+  HwDecoderBalancer balancer(1.0f);
+  EXPECT_EQ(balancer.load(), HwDecoderBalancer::kMaxLoad);
+  Simulate(balancer, 256, 1000, 1, 10);
+  EXPECT_EQ(balancer.load(), HwDecoderBalancer::kMaxLoad);
+  Simulate(balancer, 256, 1, 1000, 30);
+  EXPECT_EQ(balancer.load(), HwDecoderBalancer::kMinLoad);
+}
+
+TEST(HwDecoderBalancerTest, EmptyPartKeepsEstimate) {
+  HwDecoderBalancer balancer(0.5f, 1.0f);
+  balancer.Update(10, 0.01, 10, 0.02);
+  EXPECT_NEAR(balancer.load(), 2.0f / 3, 1e-6);
+  balancer.Update(0, 0, 10, 0.01);
+  EXPECT_NEAR(balancer.load(), 0.5f, 1e-6);
+}
+
+}  // namespace testing
+}  // namespace dali
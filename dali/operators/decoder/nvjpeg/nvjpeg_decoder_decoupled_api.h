@@ -16,6 +16,7 @@
 #define DALI_OPERATORS_DECODER_NVJPEG_NVJPEG_DECODER_DECOUPLED_API_H_
 
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <numeric>
@@ -31,6 +32,7 @@
 #include "dali/core/static_switch.h"
 #include "dali/operators/decoder/image/image_factory.h"
 #include "dali/operators/decoder/cache/cached_decoder_impl.h"
+#include "dali/operators/decoder/nvjpeg/hw_decoder_balancer.h"
 #include "dali/operators/decoder/nvjpeg/nvjpeg2k_helper.h"
 #include "dali/operators/decoder/nvjpeg/nvjpeg_helper.h"
 #include "dali/operators/decoder/nvjpeg/nvjpeg_memory.h"
@@ -70,6 +72,7 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
     hybrid_huffman_threshold_(spec.GetArgument<unsigned int>("hybrid_huffman_threshold")),
     use_fast_idct_(spec.GetArgument<bool>("use_fast_idct")),
     use_jpeg_fancy_upsampling_(spec.GetArgument<bool>("jpeg_fancy_upsampling")),
+    double_buffered_(spec.GetArgument<bool>("double_buffered_decode")),
     output_shape_(max_batch_size_, kOutputDim),
     pinned_buffers_(num_threads_*2),
     jpeg_streams_(num_threads_*2),
@@ -113,6 +116,7 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
     bool try_init_hw_decoder = false;
     if (spec_.GetSchema().HasArgument("hw_decoder_load")) {
       hw_decoder_load_ = spec.GetArgument<float>("hw_decoder_load");
+      adaptive_hw_decoder_load_ = spec.GetArgument<bool>("adaptive_hw_decoder_load");
       try_init_hw_decoder = true;
     } else {
       hw_decoder_load_ = 0;
@@ -128,6 +132,7 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
       if (driverVersion < 455) {
         try_init_hw_decoder = false,
         hw_decoder_load_ = 0;
+        adaptive_hw_decoder_load_ = false;
         CUDA_CALL(nvjpegDestroy(handle_));
         LOG_LINE << "NVJPEG_BACKEND_HARDWARE is disabled due to performance reason" << std::endl;
         CUDA_CALL(nvjpegCreateEx(NVJPEG_BACKEND_DEFAULT, NULL, NULL, nvjpeg_flags, &handle_));
@@ -151,7 +156,7 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
         if (!RestrictPinnedMemUsage()) {
           hw_decoder_images_staging_.set_pinned(true);
           // assume close the worst case size 300kb per image
-          auto shapes = uniform_list_shape(CalcHwDecoderBatchSize(hw_decoder_load_,
+          auto shapes = uniform_list_shape(CalcHwDecoderBatchSize(MaxHwDecoderLoad(),
                                            max_batch_size_), TensorShape<1>{300*1024});
           hw_decoder_images_staging_.Resize(shapes, DALI_UINT8);
         }
@@ -177,7 +182,7 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
           CUDA_CALL(nvjpegDecodeBatchedPreAllocate(
             handle_,
             state_hw_batched_,
-            CalcHwDecoderBatchSize(hw_decoder_load_, max_batch_size_),
+            CalcHwDecoderBatchSize(MaxHwDecoderLoad(), max_batch_size_),
             preallocate_width_hint,
             preallocate_height_hint,
             NVJPEG_CSS_444,
@@ -186,6 +191,12 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
 #endif
         using_hw_decoder_ = true;
         using_hw_decoder_roi_ = nvjpegIsSymbolAvailable("nvjpegDecodeBatchedSupportedEx");
+        if (adaptive_hw_decoder_load_) {
+          hw_balancer_ = HwDecoderBalancer(hw_decoder_load_);
+          hw_decoder_load_ = hw_balancer_.load();
+          hw_start_event_ = CUDAEvent::CreateWithFlags(cudaEventDefault);
+          hw_end_event_ = CUDAEvent::CreateWithFlags(cudaEventDefault);
+        }
         in_data_.reserve(max_batch_size_);
         in_lengths_.reserve(max_batch_size_);
         nvjpeg_destinations_.reserve(max_batch_size_);
@@ -196,6 +207,7 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
     } else {
       LOG_LINE << "NVJPEG_BACKEND_HARDWARE is either disabled or not supported" << std::endl;
       CUDA_CALL(nvjpegCreateEx(NVJPEG_BACKEND_DEFAULT, NULL, NULL, nvjpeg_flags, &handle_));
+      adaptive_hw_decoder_load_ = false;
     }
 #else
     CUDA_CALL(nvjpegCreateEx(NVJPEG_BACKEND_DEFAULT, NULL, NULL, nvjpeg_flags, &handle_));
@@ -216,6 +228,8 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
     for (auto thread_id : thread_pool_.GetThreadIds()) {
       if (device_memory_padding > 0) {
         nvjpeg_memory::AddBuffer<mm::memory_kind::device>(thread_id, device_memory_padding);
+        if (double_buffered_)
+          nvjpeg_memory::AddBuffer<mm::memory_kind::device>(thread_id, device_memory_padding);
       }
       if (host_memory_padding > 0) {
         nvjpeg_memory::AddHostBuffer(thread_id, host_memory_padding);
@@ -235,13 +249,15 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
     for (auto &buffer : pinned_buffers_) {
       CUDA_CALL(nvjpegBufferPinnedCreate(handle_, pinned_allocator_ptr, &buffer));
     }
+    if (double_buffered_)
+      device_buffers_.resize(num_threads_ * 2);
     for (auto &buffer : device_buffers_) {
       CUDA_CALL(nvjpegBufferDeviceCreate(handle_, device_allocator_ptr, &buffer));
     }
     for (auto &stream : streams_) {
-      stream = CUDAStreamPool::instance().Get();
+      stream = CUDAStreamPool::instance().Get(device_id_, default_cuda_stream_priority_);
     }
-    hw_decode_stream_ = CUDAStreamPool::instance().Get();
+    hw_decode_stream_ = CUDAStreamPool::instance().Get(device_id_, default_cuda_stream_priority_);
 
     if (hw_decoder_images_staging_.is_pinned())
       hw_decoder_images_staging_.set_order(hw_decode_stream_);
@@ -250,6 +266,11 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
     for (auto &event : decode_events_) {
       event = CUDAEvent::Create();
     }
+    if (double_buffered_) {
+      buffer_events_.resize(num_threads_ * 2);
+      for (auto &event : buffer_events_)
+        event = CUDAEvent::Create();
+    }
 
     hw_decode_event_ = CUDAEvent::Create();
 
@@ -284,7 +305,8 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
     });
     nvjpeg2k_thread_.RunAll();
 
-    nvjpeg2k_cu_stream_ = CUDAStreamPool::instance().Get();
+    nvjpeg2k_cu_stream_ = CUDAStreamPool::instance().Get(device_id_,
+                                                         default_cuda_stream_priority_);
     nvjpeg2k_decode_event_ = CUDAEvent::Create();
 
     for (auto &stream : nvjpeg2k_streams_) {
@@ -741,6 +763,7 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
         [this, sample, in_data, in_size, output_data](int tid) {
           SampleWorker(sample->sample_idx, sample->file_name, in_size, tid,
             in_data, output_data, streams_[tid]);
+          MarkTaskDone();
         }, task_priority_seq_--);  // FIFO order, since the samples were already ordered
     }
   }
@@ -850,6 +873,7 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
           HostFallback<StorageGPU>(input_data, in_size, output_image_type_, output_data,
                                    streams_[tid], sample->file_name, sample->roi, use_fast_idct_);
           CacheStore(sample->file_name, output_data, shape, streams_[tid]);
+          MarkTaskDone();
         }, task_priority_seq_--);  // FIFO order, since the samples were already ordered
     }
   }
@@ -895,6 +919,11 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
       }
 
       CUDA_CALL(cudaEventSynchronize(hw_decode_event_));
+      if (adaptive_hw_decoder_load_) {
+        // the previous batch is decoded - the events can be reused
+        CollectHwDecoderTiming();
+        CUDA_CALL(cudaEventRecord(hw_start_event_, hw_decode_stream_));
+      }
       // if the input is pinned already we don't need to copy to the staging area
       if (RestrictPinnedMemUsage() || input.is_pinned()) {
         for (size_t k = 0; k < samples_hw_batched_.size(); ++k) {
@@ -938,6 +967,8 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
         CacheStore(sample->file_name, output.mutable_tensor<uint8_t>(i),
                    output_shape_.tensor_shape(i).to_static<3>(), hw_decode_stream_);
       }
+      if (adaptive_hw_decoder_load_)
+        CUDA_CALL(cudaEventRecord(hw_end_event_, hw_decode_stream_));
       CUDA_CALL(cudaEventRecord(hw_decode_event_, hw_decode_stream_));
     }
 #endif
@@ -961,6 +992,8 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
     ProcessImagesCuda(ws);
     ProcessImagesHost(ws);
     ProcessImagesJpeg2k(ws);
+    auto pool_start = std::chrono::steady_clock::now().time_since_epoch();
+    pool_done_ = pool_start.count();
     thread_pool_.RunAll(false);  // don't block
     nvjpeg2k_thread_.RunAll(false);
 
@@ -968,6 +1001,10 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
 
     thread_pool_.WaitForWork();
     nvjpeg2k_thread_.WaitForWork();
+    if (adaptive_hw_decoder_load_) {
+      auto pool_time = std::chrono::steady_clock::duration(pool_done_) - pool_start;
+      UpdateHwDecoderLoad(std::chrono::duration<double>(pool_time).count());
+    }
     // wait for all work in workspace main stream
     for (int tid = 0; tid < num_threads_; tid++) {
       CUDA_CALL(cudaEventRecord(decode_events_[tid], streams_[tid]));
@@ -987,6 +1024,28 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
     return 2*thread_id + page;
   }
 
+  /**
+   * @brief Selects the device buffer for the sample using the pinned buffer `buff_idx`
+   *
+   * By default, each thread has one device buffer, so a sample must wait for the GPU to finish
+   * the previous sample of the thread, before its data can be transferred to the device.
+   * When double-buffered, the device buffers alternate like the pinned ones, so the GPU can be
+   * still busy with the previous sample (e.g. the last one of the previous iteration) while
+   * the current one is decoded on the host and transferred.
+   */
+  inline int GetDeviceBufferIndex(int thread_id, int buff_idx) const {
+    return double_buffered_ ? buff_idx : thread_id;
+  }
+
+  /**
+   * @brief Marks the end of GPU work of the sample using the buffers `buff_idx`
+   */
+  inline void RecordBufferUse(int thread_id, int buff_idx, cudaStream_t stream) {
+    CUDA_CALL(cudaEventRecord(decode_events_[thread_id], stream));
+    if (double_buffered_)
+      CUDA_CALL(cudaEventRecord(buffer_events_[buff_idx], stream));
+  }
+
   // Per sample worker called in a thread of the thread pool.
   // It decodes the encoded image `input_data` (host mem) into `output_data` (device mem) with
   // nvJPEG. If nvJPEG can't handle the image, it falls back to CPU decoder implementation
@@ -1000,6 +1059,12 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
 
     const int buff_idx = GetNextBufferIndex(thread_id);
     const int jpeg_stream_idx = buff_idx;
+    const int device_buff_idx = GetDeviceBufferIndex(thread_id, buff_idx);
+    if (double_buffered_) {
+      // The buffers were last used two samples ago - the transfer from the pinned buffer and
+      // the decoding in the device buffer must be complete before they're reused
+      CUDA_CALL(cudaEventSynchronize(buffer_events_[buff_idx]));
+    }
 
     // At this point sample data should have a valid selected decoder
     auto &decoder = data.selected_decoder->decoder;
@@ -1050,8 +1115,10 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
       nvjpeg_image.channel[0] = output_data;
       nvjpeg_image.pitch[0] = out_shape[1] * out_shape[2];
 
-      CUDA_CALL(cudaEventSynchronize(decode_events_[thread_id]));
-      CUDA_CALL_EX(nvjpegStateAttachDeviceBuffer(state, device_buffers_[thread_id]), file_name);
+      if (!double_buffered_)
+        CUDA_CALL(cudaEventSynchronize(decode_events_[thread_id]));
+      CUDA_CALL_EX(nvjpegStateAttachDeviceBuffer(state, device_buffers_[device_buff_idx]),
+                   file_name);
 
       CUDA_CALL_EX(nvjpegDecodeJpegTransferToDevice(handle_, decoder, state,
                                                       jpeg_streams_[jpeg_stream_idx], stream),
@@ -1070,6 +1137,7 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
         DALI_WARN(warning_msg);
         HostFallback<StorageGPU>(input_data, in_size, output_image_type_, output_data,
                                  stream, file_name, data.roi, use_fast_idct_);
+        RecordBufferUse(thread_id, buff_idx, stream);
         return;
       }
 
@@ -1082,7 +1150,7 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
       }
 
       CacheStore(file_name, output_data, out_shape, stream);
-      CUDA_CALL(cudaEventRecord(decode_events_[thread_id], stream));
+      RecordBufferUse(thread_id, buff_idx, stream);
     }
   }
 
@@ -1096,6 +1164,8 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
   unsigned int hybrid_huffman_threshold_;
   bool use_fast_idct_ = false;
   bool use_jpeg_fancy_upsampling_ = false;
+  // see GetDeviceBufferIndex
+  bool double_buffered_ = false;
 
   TensorListShape<> output_shape_;
 
@@ -1124,6 +1194,8 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
   std::vector<CUDAStreamLease> streams_;
   CUDAStreamLease hw_decode_stream_;
   std::vector<CUDAEvent> decode_events_;
+  // Per pinned buffer - the end of the GPU work of the last sample using it (double-buffered)
+  std::vector<CUDAEvent> buffer_events_;
   CUDAEvent hw_decode_event_;
   std::vector<int> thread_page_ids_;  // page index for double-buffering
 
@@ -1134,6 +1206,20 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
   float hw_decoder_load_ = 0.0f;
   int hw_decoder_bs_ = 0;
 
+  // Tuning of hw_decoder_load_ - see UpdateHwDecoderLoad
+  bool adaptive_hw_decoder_load_ = false;
+  HwDecoderBalancer hw_balancer_;
+  CUDAEvent hw_start_event_, hw_end_event_;
+  // The measurements of the part of the batch decoded in the thread pool, waiting for the
+  // HW decoder to complete the corresponding batch
+  struct PendingTiming {
+    int hw_samples = 0;
+    int other_samples = 0;
+    double other_time = 0;
+  } pending_timing_;
+  // steady_clock time point when the last task in the thread pool was done
+  std::atomic<std::chrono::steady_clock::rep> pool_done_{0};
+
   // Those are used to feed nvjpeg's batched API
   std::vector<const unsigned char*> in_data_;
   std::vector<size_t> in_lengths_;
@@ -1169,6 +1255,50 @@ class nvJPEGDecoder : public StatelessOperator<MixedBackend>, CachedDecoderImpl
     RegisterDiagnostic("nsamples_nvjpeg2k", &nsamples_nvjpeg2k_);
     RegisterDiagnostic("using_hw_decoder", &using_hw_decoder_);
     RegisterDiagnostic("using_hw_decoder_roi", &using_hw_decoder_roi_);
+    RegisterDiagnostic("hw_decoder_load", &hw_decoder_load_);
+  }
+
+  float MaxHwDecoderLoad() const {
+    return adaptive_hw_decoder_load_ ? 1.f : hw_decoder_load_;
+  }
+
+  /**
+   * @brief Records the time when a decoding task in the thread pool was done
+   */
+  void MarkTaskDone() {
+    if (!adaptive_hw_decoder_load_)
+      return;
+    auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    auto done = pool_done_.load(std::memory_order_relaxed);
+    while (done < now &&
+           !pool_done_.compare_exchange_weak(done, now, std::memory_order_relaxed)) {}
+  }
+
+  /**
+   * @brief Tunes hw_decoder_load_, so that the HW decoder and the thread pool (CUDA and host
+   *        decoding) finish their parts of the batch at the same time.
+   *
+   * The HW decoder runs asynchronously - its time is collected in CollectHwDecoderTiming, when
+   * the next batch is submitted to it.
+   */
+  void UpdateHwDecoderLoad(double pool_time) {
+    int hw_samples = samples_hw_batched_.size();
+    int other_samples = samples_single_.size() + samples_host_.size();
+    if (hw_samples > 0)
+      pending_timing_ = { hw_samples, other_samples, pool_time };
+    else
+      hw_decoder_load_ = hw_balancer_.Update(0, 0, other_samples, pool_time);
+  }
+
+  void CollectHwDecoderTiming() {
+    if (pending_timing_.hw_samples == 0)
+      return;
+    float hw_time_ms = 0;
+    CUDA_CALL(cudaEventElapsedTime(&hw_time_ms, hw_start_event_, hw_end_event_));
+    hw_decoder_load_ = hw_balancer_.Update(pending_timing_.hw_samples, hw_time_ms * 1e-3,
+                                           pending_timing_.other_samples,
+                                           pending_timing_.other_time);
+    pending_timing_ = {};
   }
 
   int CalcHwDecoderBatchSize(float hw_decoder_load, int curr_batch_size) {
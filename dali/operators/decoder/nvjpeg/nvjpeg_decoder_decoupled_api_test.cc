@@ -28,12 +28,15 @@ class nvjpegDecodeDecoupledAPITest : public GenericDecoderTest<ImgType> {
       .AddArg("device", "mixed")
       .AddArg("output_type", this->img_type_)
       .AddArg("hybrid_huffman_threshold", hybrid_huffman_threshold_)
+      .AddArg("double_buffered_decode", double_buffered_)
       .AddInput("encoded", "cpu")
       .AddOutput("decoded", "gpu");
   }
 
-  void JpegTestDecode(int num_threads, unsigned int hybrid_huffman_threshold) {
+  void JpegTestDecode(int num_threads, unsigned int hybrid_huffman_threshold,
+                      bool double_buffered = false) {
     hybrid_huffman_threshold_ = hybrid_huffman_threshold;
+    double_buffered_ = double_buffered;
     this->SetNumThreads(num_threads);
     this->RunTestDecode(t_jpegImgType);
   }
@@ -59,6 +62,7 @@ class nvjpegDecodeDecoupledAPITest : public GenericDecoderTest<ImgType> {
 
  private:
   unsigned int hybrid_huffman_threshold_ = std::numeric_limits<unsigned int>::max();
+  bool double_buffered_ = false;
 };
 
 typedef ::testing::Types<RGB, BGR, Gray> Types;
@@ -125,6 +129,21 @@ TYPED_TEST(nvjpegDecodeDecoupledAPITest, TestSingleJPEGDecode4THybridHuffman) {
   this->JpegTestDecode(4, 0);
 }
 
+/***********************************************
+********* Double-buffered JPEG decode **********
+***********************************************/
+TYPED_TEST(nvjpegDecodeDecoupledAPITest, TestSingleJPEGDecodeDoubleBuffered) {
+  this->JpegTestDecode(1, 512u*512u, true);
+}
+
+TYPED_TEST(nvjpegDecodeDecoupledAPITest, TestSingleJPEGDecode3TDoubleBuffered) {
+  this->JpegTestDecode(3, 512u*512u, true);
+}
+
+TYPED_TEST(nvjpegDecodeDecoupledAPITest, TestSingleJPEGDecode4THybridHuffmanDoubleBuffered) {
+  this->JpegTestDecode(4, 0, true);
+}
+
 /***********************************************
 ************* PNG fallback decode **************
 ***********************************************/
@@ -341,6 +360,59 @@ TEST_F(HwDecoderMemoryPoolTest, MemoryPoolTest) {
   this->pipeline_.Run();
 }
 
+class HwDecoderAdaptiveLoadTest : public ::testing::Test {
+ public:
+  void SetUp() final {
+    dali::string list_root(testing::dali_extra_path() + "/db/single/jpeg");
+
+    pipeline_.AddOperator(
+            OpSpec("FileReader")
+                    .AddArg("device", "cpu")
+                    .AddArg("file_root", list_root)
+                    .AddOutput("compressed_images", "cpu")
+                    .AddOutput("labels", "cpu"));
+    auto decoder_spec =
+            OpSpec("ImageDecoder")
+                    .AddArg("device", "mixed")
+                    .AddArg("output_type", DALI_RGB)
+                    .AddArg("hw_decoder_load", 1.f)
+                    .AddArg("adaptive_hw_decoder_load", true)
+                    .AddInput("compressed_images", "cpu")
+                    .AddOutput("images", "gpu");
+    pipeline_.AddOperator(decoder_spec, decoder_name_);
+
+    pipeline_.Build(outputs_);
+
+    auto op = pipeline_.GetOperator(decoder_name_);
+    if (!op->GetDiagnostic<bool>("using_hw_decoder")) {
+      GTEST_SKIP();
+    }
+  }
+
+
+  int batch_size_ = 47;
+  Pipeline pipeline_{batch_size_, 1, 0, -1, false, 2, false};
+  vector<std::pair<string, string>> outputs_ = {{"images", "gpu"}};
+  std::string decoder_name_ = "Lorem Ipsum";
+};
+
+TEST_F(HwDecoderAdaptiveLoadTest, LoadIsTuned) {
+  constexpr int kIters = 10;
+  for (int i = 0; i < kIters; i++)
+    this->pipeline_.Run();
+
+  auto op = this->pipeline_.GetOperator(this->decoder_name_);
+  auto load = op->GetDiagnostic<float>("hw_decoder_load");
+  // both parts were measured, so the load moved away from the initial value
+  EXPECT_GT(load, 0.f);
+  EXPECT_LT(load, 1.f);
+  auto nsamples_hw = op->GetDiagnostic<int64_t>("nsamples_hw");
+  auto nsamples_cuda = op->GetDiagnostic<int64_t>("nsamples_cuda");
+  auto nsamples_host = op->GetDiagnostic<int64_t>("nsamples_host");
+  EXPECT_GT(nsamples_cuda, 0);
+  EXPECT_EQ(nsamples_hw + nsamples_cuda + nsamples_host, kIters * batch_size_);
+}
+
 class HwDecoderSliceUtilizationTest : public ::testing::Test {
  public:
   void SetUp() final {
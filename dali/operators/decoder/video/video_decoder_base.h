@@ -50,14 +50,18 @@ class DLL_PUBLIC VideoDecoderBase {
   }
 
 
-  TensorListShape<4> ReadOutputShape() {
+  /**
+   * @brief The shapes of the decoded sequences - FHWC or, if `planar` is set, FCHW
+   */
+  TensorListShape<4> ReadOutputShape(bool planar = false) {
     TensorListShape<4> shape(frames_decoders_.size());
     for (size_t s = 0; s < frames_decoders_.size(); ++s) {
+      auto &dec = *frames_decoders_[s];
       TensorShape<4> sample_shape;
-      sample_shape[0] = frames_decoders_[s]->NumFrames();
-      sample_shape[1] = frames_decoders_[s]->Height();
-      sample_shape[2] = frames_decoders_[s]->Width();
-      sample_shape[3] = frames_decoders_[s]->Channels();
+      if (planar)
+        sample_shape = { dec.NumFrames(), dec.Channels(), dec.Height(), dec.Width() };
+      else
+        sample_shape = { dec.NumFrames(), dec.Height(), dec.Width(), dec.Channels() };
       shape.set_tensor_shape(s, sample_shape);
     }
     return shape;
@@ -92,21 +96,23 @@ class DLL_PUBLIC VideoDecoderBase {
                  make_string("Provided pad_value has improper number of elements. Expected: ",
                              frame_size, "; Actual: ", pad_value->shape().num_elements()));
 
-    uint8_t *output_data = output.template mutable_data<uint8_t>();
+    // the frames can be of any type, so they're addressed in bytes
+    auto *output_data = static_cast<uint8_t *>(output.raw_mutable_data());
+    int64_t frame_bytes = frame_size * TypeTable::GetTypeInfo(output.type()).size();
 
     int64_t f = 0;
     // Work until:
     //    (a) There are no more frames, or
     //    (b) Sufficient number of frames has been decoded.
     for (; f < num_frames && frames_decoder.NextFrameIdx() != -1; f++) {
-      frames_decoder.ReadNextFrame(output_data + f * frame_size);
+      frames_decoder.ReadNextFrame(output_data + f * frame_bytes);
     }
     assert(f <= num_frames);
     bool full_sequence_decoded = f == num_frames;
     // If there's an insufficient number of frames, pad if requested.
     for (; f < num_frames && pad_value.has_value(); f++) {
       kernels::copy<storage_backend_for_copy_kernel, storage_backend_for_copy_kernel>(
-              output_data + f * frame_size, pad_value->raw_data(), frame_size,
+              output_data + f * frame_bytes, pad_value->raw_data(), frame_bytes,
               std::is_same_v<storage_backend_for_copy_kernel, StorageGPU> ? *stream : 0);
     }
     return full_sequence_decoded;
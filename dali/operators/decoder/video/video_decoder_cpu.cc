@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -71,7 +71,25 @@ The video streams can be in most of the container file formats. FFmpeg is used t
     R"code(Applies only to the mixed backend type.
 
 If set to True, each thread in the internal thread pool will be tied to a specific CPU core.
- Otherwise, the threads can be reassigned to any CPU core by the operating system.)code", true);
+ Otherwise, the threads can be reassigned to any CPU core by the operating system.)code", true)
+    .AddOptionalTypeArg("dtype", R"code(Output data type.
+
+Supported types: `UINT8`, `FLOAT16` and `FLOAT`. Other than `UINT8` is supported only by
+ the mixed backend, where the conversion is done by the same kernel which converts the decoded
+ frames to RGB.)code", DALI_UINT8)
+    .AddOptionalArg("output_layout", R"code(The layout of the output sequences.
+
+Can be ``"FHWC"`` (interleaved) or ``"FCHW"`` (planar). The planar layout is supported only by
+ the mixed backend.)code", TensorLayout("FHWC"))
+    .AddOptionalArg("mean", R"code(Mean pixel values, subtracted from the RGB values of the frames.
+
+It can be a single value or one value per channel; the values are in the range [0, 255], regardless
+ of the output type. Supported only by the mixed backend.)code", std::vector<float>{})
+    .AddOptionalArg("std", R"code(Standard deviation values, by which the RGB values of the frames
+ (after subtracting the `mean`) are divided.
+
+It can be a single value or one value per channel. Supported only by the mixed backend.)code",
+    std::vector<float>{});
 
 DALI_REGISTER_OPERATOR(experimental__decoders__Video, VideoDecoderCpu, CPU);
 
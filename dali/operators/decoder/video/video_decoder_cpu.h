@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -28,7 +28,14 @@ class VideoDecoderCpu
   using VideoDecoderBase::DecodeSample;
 
  public:
-  explicit VideoDecoderCpu(const OpSpec &spec) : Operator<CPUBackend>(spec) {}
+  explicit VideoDecoderCpu(const OpSpec &spec) : Operator<CPUBackend>(spec) {
+    DALI_ENFORCE(spec.GetArgument<DALIDataType>("dtype") == DALI_UINT8 &&
+                 spec.GetArgument<TensorLayout>("output_layout") == "FHWC" &&
+                 spec.GetRepeatedArgument<float>("mean").empty() &&
+                 spec.GetRepeatedArgument<float>("std").empty(),
+                 "The CPU video decoder produces only uint8 FHWC frames; `dtype`, "
+                 "`output_layout`, `mean` and `std` are supported only by the mixed backend.");
+  }
 
 
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,6 +16,39 @@
 
 namespace dali {
 
+FrameOutputFormat VideoDecoderMixed::ParseOutputFormat(const OpSpec &spec) {
+  FrameOutputFormat format;
+  format.type = spec.GetArgument<DALIDataType>("dtype");
+  DALI_ENFORCE(format.type == DALI_UINT8 || format.type == DALI_FLOAT16 ||
+               format.type == DALI_FLOAT, make_string(
+               "Unsupported output type: ", format.type, ". Supported types are: uint8, "
+               "float16 and float."));
+  auto layout = spec.GetArgument<TensorLayout>("output_layout");
+  DALI_ENFORCE(layout == "FHWC" || layout == "FCHW", make_string(
+               "Unsupported output layout: \"", layout, "\". Supported layouts are: "
+               "\"FHWC\" and \"FCHW\"."));
+  format.planar = layout == "FCHW";
+
+  auto mean = spec.GetRepeatedArgument<float>("mean");
+  auto stddev = spec.GetRepeatedArgument<float>("std");
+  format.normalize = !mean.empty() || !stddev.empty();
+  for (auto *values : { &mean, &stddev }) {
+    DALI_ENFORCE(values->size() <= 1 || values->size() == 3, make_string(
+                 "`mean` and `std` must have 1 value or one value per channel (3), got ",
+                 values->size(), " values."));
+  }
+  for (int c = 0; c < 3; c++) {
+    if (!mean.empty())
+      format.mean[c] = mean[mean.size() == 3 ? c : 0];
+    if (!stddev.empty()) {
+      float s = stddev[stddev.size() == 3 ? c : 0];
+      DALI_ENFORCE(s > 0, make_string("`std` must be positive, got: ", s));
+      format.inv_std[c] = 1.0f / s;
+    }
+  }
+  return format;
+}
+
 bool VideoDecoderMixed::SetupImpl(
   std::vector<OutputDesc> &output_desc, const Workspace &ws) {
   ValidateInput(ws);
@@ -31,6 +64,8 @@ bool VideoDecoderMixed::SetupImpl(
       auto source_info = input.GetMeta(i).GetSourceInfo();
       frames_decoders_[i] = std::make_unique<FramesDecoderGpu>(data, size, stream, false, -1,
                                                                source_info);
+      if (frames_decoders_[i]->IsValid())
+        frames_decoders_[i]->SetOutputFormat(output_format_);
     });
   }
   thread_pool_.RunAll();
@@ -39,8 +74,8 @@ bool VideoDecoderMixed::SetupImpl(
                                  dec->Filename(), "\""));
   }
   output_desc.resize(1);
-  output_desc[0].shape = ReadOutputShape();
-  output_desc[0].type = DALI_UINT8;
+  output_desc[0].shape = ReadOutputShape(output_format_.planar);
+  output_desc[0].type = output_format_.type;
   return true;
 }
 
@@ -48,8 +83,11 @@ void VideoDecoderMixed::RunImpl(Workspace &ws) {
   auto &output = ws.Output<GPUBackend>(0);
   const auto &input = ws.Input<CPUBackend>(0);
   int batch_size = input.num_samples();
+  // the output may still be in use in the operator's stream
+  decode_streams_.WaitFor(ws.stream());
   for (int s = 0; s < batch_size; ++s) {
-    thread_pool_.AddWork([this, s, &output](int) {
+    thread_pool_.AddWork([this, s, &output](int tid) {
+      frames_decoders_[s]->SetStream(decode_streams_[tid]);
       DecodeSample(output[s], s);
       // when the decoding is done release the decoder,
       // so it can be reused by the next sample in the batch
@@ -57,6 +95,7 @@ void VideoDecoderMixed::RunImpl(Workspace &ws) {
     }, input[s].shape().num_elements());
   }
   thread_pool_.RunAll();
+  decode_streams_.SignalTo(ws.stream());
 }
 
 DALI_REGISTER_OPERATOR(experimental__decoders__Video, VideoDecoderMixed, Mixed);
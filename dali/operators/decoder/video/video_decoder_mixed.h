@@ -18,6 +18,7 @@
 #include <vector>
 #include <memory>
 #include "dali/operators/decoder/video/video_decoder_base.h"
+#include "dali/operators/reader/loader/video/decode_streams.h"
 #include "dali/operators/reader/loader/video/frames_decoder_gpu.h"
 #include "dali/pipeline/operator/operator.h"
 #include "dali/pipeline/util/thread_pool.h"
@@ -35,7 +36,9 @@ class VideoDecoderMixed
     thread_pool_(num_threads_,
                  spec.GetArgument<int>("device_id"),
                  spec.GetArgument<bool>("affine"),
-                 "mixed video decoder") {}
+                 "mixed video decoder"),
+    decode_streams_(num_threads_, spec.GetArgument<int>("device_id")),
+    output_format_(ParseOutputFormat(spec)) {}
 
 
 
@@ -45,7 +48,13 @@ class VideoDecoderMixed
                  const Workspace &ws) override;
 
  private:
+  static FrameOutputFormat ParseOutputFormat(const OpSpec &spec);
+
   ThreadPool thread_pool_;
+  // Each thread decodes in its own session, so that the samples don't wait for each other
+  DecodeStreams decode_streams_;
+  // The conversion from NV12 produces the frames in this format directly
+  FrameOutputFormat output_format_;
 };
 
 }  // namespace dali
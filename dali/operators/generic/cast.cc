@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -31,13 +31,16 @@ class CastCPU : public Cast<CPUBackend> {
 };
 
 template <typename OType, typename IType>
-inline void CpuHelper(OType *out, const IType *in, size_t N) {
-  for (size_t i = 0; i < N; ++i) {
+inline void CpuHelper(OType *out, const IType *in, int64_t N) {
+  // a plain loop over contiguous data - it's vectorized by the compiler for the numeric types
+  for (int64_t i = 0; i < N; ++i) {
     out[i] = ConvertSat<OType>(in[i]);
   }
 }
 
 void CastCPU::RunImpl(Workspace &ws) {
+  if (RunPassThrough(ws))
+    return;
   const auto &input = ws.Input<CPUBackend>(0);
   const auto &input_shape = input.shape();
   auto &output = ws.Output<CPUBackend>(0);
@@ -46,6 +49,7 @@ void CastCPU::RunImpl(Workspace &ws) {
   auto num_samples = input_shape.num_samples();
 
   auto &tp = ws.GetThreadPool();
+  int64_t chunk_size = CastChunkSize(input_shape, tp.NumThreads());
   TYPE_SWITCH(output.type(), type2id, OType, CAST_ALLOWED_TYPES, (
     TYPE_SWITCH(input.type(), type2id, IType, CAST_ALLOWED_TYPES, (
 
@@ -53,8 +57,12 @@ void CastCPU::RunImpl(Workspace &ws) {
         auto *out = output.mutable_tensor<OType>(sample_id);
         const auto *in = input.tensor<IType>(sample_id);
         auto size = input_shape.tensor_size(sample_id);
-        tp.AddWork([out, in, size](int thread_id) { CpuHelper<OType, IType>(out, in, size); },
-                   size);
+        for (int64_t start = 0; start < size; start += chunk_size) {
+          int64_t n = std::min(chunk_size, size - start);
+          tp.AddWork([out, in, start, n](int thread_id) {
+            CpuHelper<OType, IType>(out + start, in + start, n);
+          }, n);
+        }
       }
 
     ), DALI_FAIL(make_string("Invalid input type: ", input.type())););  // NOLINT(whitespace/parens)
@@ -71,6 +79,9 @@ DALI_SCHEMA(Cast)
     .NumOutput(1)
     .AllowSequences()
     .SupportVolumetric()
+    .Stateless()
+    .PassThrough({{0, 0}})
+    .InPlace(0, 0)
     .AddTypeArg("dtype", R"code(Output data type.)code");
 
 DALI_SCHEMA(CastLike)
@@ -79,6 +90,9 @@ DALI_SCHEMA(CastLike)
     .InputDevice(1, InputDevice::Metadata)
     .NumOutput(1)
     .AllowSequences()
-    .SupportVolumetric();
+    .SupportVolumetric()
+    .Stateless()
+    .PassThrough({{0, 0}})
+    .InPlace(0, 0);
 
 }  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,9 +15,11 @@
 #ifndef DALI_OPERATORS_GENERIC_CAST_H_
 #define DALI_OPERATORS_GENERIC_CAST_H_
 
+#include <algorithm>
 #include <vector>
 
 #include "dali/core/convert.h"
+#include "dali/core/util.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/pipeline/data/types.h"
 #include "dali/pipeline/operator/checkpointing/stateless_operator.h"
@@ -26,7 +28,20 @@ namespace dali {
 
 #define CAST_ALLOWED_TYPES                                                                         \
   (bool, uint8_t, uint16_t, uint32_t, uint64_t, int8_t, int16_t, int32_t, int64_t, float16, float, \
-  double, DALIDataType, DALIImageType, DALIInterpType)
+  double, bfloat16, DALIDataType, DALIImageType, DALIInterpType)
+
+/**
+ * @brief The number of elements converted by a single CPU task
+ *
+ * Large samples are split into chunks of this size, so that the work is balanced across
+ * the threads even when the batch has fewer samples than there are threads.
+ */
+inline int64_t CastChunkSize(const TensorListShape<> &shape, int num_threads) {
+  constexpr int64_t kMinChunkSize = 1 << 16;
+  constexpr int kTasksPerThread = 4;
+  int64_t max_tasks = std::max(num_threads, 1) * kTasksPerThread;
+  return std::max(kMinChunkSize, div_ceil(shape.num_elements(), max_tasks));
+}
 
 template <typename Backend>
 class Cast : public StatelessOperator<Backend> {
@@ -56,14 +71,31 @@ class Cast : public StatelessOperator<Backend> {
                  make_string("Cannot cast from ", input.type(), " to ", out_type,
                              ". Enums can only participate in casts with integral types, "
                              "but not floating point types."));
+    // No conversion - the contiguous input can be passed through as-is
+    pass_through_ = out_type == input.type() && input.IsContiguous();
+    if (pass_through_)
+      return false;
     output_desc.resize(1);
     output_desc[0].shape = input.shape();
     output_desc[0].type = out_type;
     return true;
   }
 
+  /**
+   * @brief Shares the input with the output, if the type doesn't change.
+   *
+   * @return true, if the input was passed through and there's nothing left to do.
+   */
+  bool RunPassThrough(Workspace &ws) {
+    if (!pass_through_)
+      return false;
+    ws.Output<Backend>(0).ShareData(ws.Input<Backend>(0));
+    return true;
+  }
+
  private:
   bool is_cast_like_ = false;
+  bool pass_through_ = false;
   DALIDataType dtype_arg_ = DALI_NO_TYPE;
 };
 
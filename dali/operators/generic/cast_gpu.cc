@@ -31,6 +31,8 @@ class CastGPU : public Cast<GPUBackend> {
 };
 
 void CastGPU::RunImpl(Workspace &ws) {
+  if (RunPassThrough(ws))
+    return;
   const auto &input = ws.Input<GPUBackend>(0);
   auto &output = ws.Output<GPUBackend>(0);
   output.SetLayout(input.GetLayout());
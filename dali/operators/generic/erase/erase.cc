@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -101,6 +101,7 @@ What gives::
 )code")
   .NumInput(1)
   .NumOutput(1)
+  .InPlace(0, 0)
   .AddOptionalArg<float>("anchor",
     R"code(Coordinates for the anchor or the starting point of the erase region.
 
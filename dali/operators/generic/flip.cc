@@ -34,7 +34,8 @@ and depthwise).)code")
     .AddOptionalArg("depthwise", R"code(Flip the depthwise dimension.)code", 0, true)
     .InputLayout({"FDHWC", "FHWC", "DHWC", "HWC", "FCDHW", "FCHW", "CDHW", "CHW"})
     .AllowSequences()
-    .SupportVolumetric();
+    .SupportVolumetric()
+    .Stateless();
 
 
 template <>
@@ -15,8 +15,9 @@
 #ifndef DALI_OPERATORS_GENERIC_FLIP_H_
 #define DALI_OPERATORS_GENERIC_FLIP_H_
 
-#include <vector>
 #include <string>
+#include <type_traits>
+#include <vector>
 #include "dali/core/tensor_shape.h"
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/operator/checkpointing/stateless_operator.h"
@@ -31,6 +32,10 @@ class Flip: public StatelessOperator<Backend> {
   ~Flip() override = default;
   DISABLE_COPY_MOVE_ASSIGN(Flip);
 
+  bool CanRunPerSample() const override {
+    return std::is_same_v<Backend, CPUBackend>;
+  }
+
  protected:
   bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override {
     output_desc.resize(1);
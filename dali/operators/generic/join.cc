@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -28,7 +28,11 @@ namespace dali {
 DALI_SCHEMA(Cat)
   .DocStr(R"(Joins the input tensors along an existing axis.
 
-The shapes of the inputs must match in all dimensions except the concatenation axis.)")
+The shapes of the inputs must match in all dimensions except the concatenation axis.
+
+If, in each sample, the inputs are already stored one after another in the same buffer and
+they're joined along the outermost axis, the output is a view of the inputs and no data is
+copied.)")
   .AddOptionalArg<int>("axis", R"code(Axis along which the input tensors are concatenated.
 
 Accepted range is [-ndim, ndim-1]. Negative indices are counted from the back.)code", 0, false)
@@ -38,12 +42,17 @@ This argument is mutually exclusive with ``axis``.
 This argument requires that at least one input has a non-empty layout and that all non-empty
 input layouts match.)", nullptr, false)
   .NumInput(1, 999)
-  .NumOutput(1);
+  .NumOutput(1)
+  .SamplewisePassThrough();
 
 DALI_SCHEMA(Stack)
   .DocStr(R"(Joins the input tensors along a new axis.
 
-The shapes of respective tensors in the inputs must match.)")
+The shapes of respective tensors in the inputs must match.
+
+If, in each sample, the inputs are already stored one after another in the same buffer and
+they're stacked along the outermost axis, the output is a view of the inputs and no data is
+copied.)")
   .AddOptionalArg<int>("axis", R"code(The axis in the output tensor along which the inputs are stacked.
 
 The axis is inserted before a corresponding axis in the inputs. A value of 0 indicates that whole
@@ -58,7 +67,8 @@ constructed by inserting that character into the input layout at the position in
 For example, specifying ``axis = 0`` and ``axis_name = "C"`` with input layout "HW" will yield
 the output layout "CHW")", nullptr, false)
   .NumInput(1, 999)
-  .NumOutput(1);
+  .NumOutput(1)
+  .SamplewisePassThrough();
 
 #define TENSOR_JOIN_TYPES (bool, uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, \
                           uint64_t, int64_t, float16, float, double)
@@ -94,6 +104,13 @@ bool TensorJoin<Backend, new_axis>::SetupImpl(
   TYPE_SWITCH(dtype, type2id, T, TENSOR_JOIN_TYPES, (
     SetupTyped<T>(output_shape, ws);
   ), (DALI_FAIL(make_string("The element type ", dtype, " is not supported."))));  // NOLINT
+
+  share_inputs_ = CanShareInputs(ws);
+  if (share_inputs_) {
+    // the output is a view of the inputs - it's not allocated by the executor
+    output_shape_ = output_shape;
+    return false;
+  }
   return true;
 }
 
@@ -105,20 +122,18 @@ void TensorJoin<Backend, new_axis>::SetupTyped(
   inputs.clear();
   int ninp = this->spec_.NumRegularInput();
 
-  copy_idx_ = 0;
+  joined_inputs_.clear();
   for (int i = 0; i < ninp; i++) {
     auto tlv = view<const T>(ws.Input<Backend>(i));
     if (new_axis || tlv.num_elements() > 0) {  // when concatenating, we can skip empty inputs
-      if (inputs.empty())
-        copy_idx_ = i;
-      else
-        copy_idx_ = -1;
+      joined_inputs_.push_back(i);
       inputs.push_back(std::move(tlv));
     }
   }
 
   // No non-empty inputs? Use the first one, even if it's empty.
   if (inputs.empty()) {
+    joined_inputs_.push_back(0);
     inputs.push_back(view<const T>(ws.Input<Backend>(0)));
   }
 
@@ -191,21 +206,85 @@ void TensorJoin<Backend, new_axis>::SetupAxis(int ndim) {
 }
 
 template <typename Backend, bool new_axis>
-void TensorJoin<Backend, new_axis>::RunImpl(Workspace &ws) {
+bool TensorJoin<Backend, new_axis>::CanShareInputs(const Workspace &ws) const {
+  int njoin = joined_inputs_.size();
+  if (njoin == 1)
+    return true;  // just one (non-empty) input - the output has the same data
+
+  // Each output sample must be a concatenation of whole input samples, so the volume of the
+  // dimensions preceding the join axis must be 1.
+  for (int idx : joined_inputs_) {
+    const auto &shape = ws.Input<Backend>(idx).shape();
+    for (int i = 0; i < shape.num_samples(); i++) {
+      auto sample_shape = shape.tensor_shape_span(i);
+      for (int d = 0; d < axis_; d++)
+        if (sample_shape[d] != 1)
+          return false;
+    }
+  }
+
+  for (int t = 1; t < njoin; t++) {
+    // unsafe_sample_owner only reads the batch (possibly materializing the views, which is
+    // thread-safe) - the const_cast is fine
+    auto &prev = const_cast<TensorList<Backend> &>(ws.Input<Backend>(joined_inputs_[t - 1]));
+    auto &cur = const_cast<TensorList<Backend> &>(ws.Input<Backend>(joined_inputs_[t]));
+    if (prev.device_id() != cur.device_id() || prev.is_pinned() != cur.is_pinned())
+      return false;
+    size_t type_size = prev.type_info().size();
+    for (int i = 0; i < prev.num_samples(); i++) {
+      auto *prev_end = static_cast<const uint8_t *>(prev.raw_tensor(i)) +
+                       prev.shape().tensor_size(i) * type_size;
+      if (cur.raw_tensor(i) != prev_end)
+        return false;
+      // The adjacent addresses may as well belong to different allocations - the whole
+      // joined sample must be kept alive by a single owner.
+      if (!same_managed_object(unsafe_sample_owner(prev, i), unsafe_sample_owner(cur, i)))
+        return false;
+    }
+  }
+  return true;
+}
+
+template <typename Backend, bool new_axis>
+void TensorJoin<Backend, new_axis>::ShareInputs(Workspace &ws) {
   auto &out = ws.Output<Backend>(0);
-  if (copy_idx_ >= 0) {
-    // just one non-empty input - copy it to the output and return
-    TensorListShape<> shape;
-    if (new_axis)
-      shape = out.shape();
-    out.Copy(ws.Input<Backend>(copy_idx_), ws.has_stream() ? ws.stream()
-                                                                    : AccessOrder::host());
-    if (new_axis)
-      out.Resize(shape);
+  auto &in = ws.Input<Backend>(joined_inputs_[0]);
+  if (joined_inputs_.size() == 1) {
+    out.ShareData(in);
+    // the layout is set after the shape - for stacking, the number of dimensions changes
+    out.SetLayout({});
+    out.Resize(output_shape_);
     out.SetLayout(output_layout_);
     return;
   }
 
+  auto &owner = const_cast<TensorList<Backend> &>(in);
+  int N = output_shape_.num_samples();
+  size_t type_size = in.type_info().size();
+  out.Reset();
+  out.set_type(in.type());
+  out.set_sample_dim(output_shape_.sample_dim());
+  out.SetLayout(output_layout_);
+  out.set_device_id(in.device_id());
+  out.set_pinned(in.is_pinned());
+  out.SetSize(N);
+  for (int i = 0; i < N; i++) {
+    auto shape = output_shape_[i];
+    // the owner may point to the beginning of the allocation - alias it with the sample pointer
+    shared_ptr<void> sample_ptr(unsafe_sample_owner(owner, i), owner.raw_mutable_tensor(i));
+    out.SetSample(i, std::move(sample_ptr), shape.num_elements() * type_size, in.is_pinned(),
+                  shape, in.type(), in.device_id(), in.order(), output_layout_);
+  }
+}
+
+template <typename Backend, bool new_axis>
+void TensorJoin<Backend, new_axis>::RunImpl(Workspace &ws) {
+  if (share_inputs_) {
+    ShareInputs(ws);
+    return;
+  }
+
+  auto &out = ws.Output<Backend>(0);
   out.SetLayout(output_layout_);
   TYPE_SWITCH(auto type_id = out.type(), type2id, T, TENSOR_JOIN_TYPES, (
     RunTyped(view<T>(out), ws, Backend{});
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -74,6 +74,21 @@ class TensorJoin : public StatelessOperator<Backend> {
   void SetupAxis(int ndim);
   void SetOutputLayout(const Workspace &ws);
 
+  /**
+   * @brief Checks whether the output can be a view of the inputs, without copying the data.
+   *
+   * This is the case when there's just one non-empty input or when, in every sample, the
+   * joined inputs are stored one after another in a single allocation and the outer extent
+   * (the volume of the dimensions before the join axis) is 1 - e.g. when joining along
+   * the outermost axis.
+   */
+  bool CanShareInputs(const Workspace &ws) const;
+
+  /**
+   * @brief Sets the output samples as views of the (adjacent) input samples.
+   */
+  void ShareInputs(Workspace &ws);
+
   std::any inputs_;
   kernels::KernelManager kmgr_;
   int axis_ = -1;
@@ -81,7 +96,9 @@ class TensorJoin : public StatelessOperator<Backend> {
 
   bool has_axis_ = false, has_axis_name_ = false;
   int axis_arg_ = 0;
-  int copy_idx_ = -1;
+  bool share_inputs_ = false;
+  std::vector<int> joined_inputs_;
+  TensorListShape<> output_shape_;
   char axis_name_arg_ = 0;
 };
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -35,6 +35,33 @@ __global__ void LookupValuesImpl(const LutSampleDesc *samples, const kernels::Bl
   }
 }
 
+/**
+ * @brief Looks up the values in a table cached in the shared memory
+ *
+ * Only the first `table_size` entries are loaded - the keys above map to the default value.
+ */
+template <typename OutputType, typename InputType>
+__global__ void LookupValuesSharedTable(const LutSampleDesc *samples,
+                                        const kernels::BlockDesc<1> *blocks,
+                                        const OutputType *lookup_table, int table_size,
+                                        const OutputType default_value) {
+  extern __shared__ char lut_shm[];
+  auto *table = reinterpret_cast<OutputType *>(lut_shm);
+  for (int i = threadIdx.x; i < table_size; i += blockDim.x)
+    table[i] = lookup_table[i];
+  __syncthreads();
+
+  const auto &block = blocks[blockIdx.x];
+  const auto &sample = samples[block.sample_idx];
+
+  auto *output = reinterpret_cast<OutputType *>(sample.output);
+  const auto *input = reinterpret_cast<const InputType *>(sample.input);
+  for (int64_t x = threadIdx.x + block.start.x; x < block.end.x; x += blockDim.x) {
+    InputType key = input[x];
+    output[x] = IsInTable(key, table_size) ? table[key] : default_value;
+  }
+}
+
 }  // namespace detail
 
 template<>
@@ -56,8 +83,11 @@ void LookupTable<GPUBackend>::RunImpl(Workspace &ws) {
   }
   samples_dev_.from_host(samples_, stream);
 
-  block_setup_.SetupBlocks(collapsed_shape, true);
-  blocks_dev_.from_host(block_setup_.Blocks(), stream);
+  int64_t shared_table_bytes = table_size_ * TypeTable::GetTypeInfo(output_type_).size();
+  bool use_shared_table = shared_table_bytes <= kMaxSharedTableBytes;
+  auto &block_setup = use_shared_table ? shared_table_block_setup_ : block_setup_;
+  block_setup.SetupBlocks(collapsed_shape, true);
+  blocks_dev_.from_host(block_setup.Blocks(), stream);
 
   TYPE_SWITCH(input.type(), dali::type2id, InputType, LUT_IN_TYPES, (
     TYPE_SWITCH(output_type_, dali::type2id, OutputType, LUT_OUT_TYPES, (
@@ -65,11 +95,17 @@ void LookupTable<GPUBackend>::RunImpl(Workspace &ws) {
       const OutputType *lookup_table = lut_.data<OutputType>();
       OutputType default_value = ConvertSat<OutputType>(default_value_f_);
 
-      dim3 grid_dim = block_setup_.GridDim();
-      dim3 block_dim = block_setup_.BlockDim();
-
-      detail::LookupValuesImpl<OutputType, InputType><<<grid_dim, block_dim, 0, stream>>>(
-          samples_dev_.data(), blocks_dev_.data(), lookup_table, default_value);
+      dim3 grid_dim = block_setup.GridDim();
+      dim3 block_dim = block_setup.BlockDim();
+
+      if (use_shared_table) {
+        detail::LookupValuesSharedTable<OutputType, InputType>
+          <<<grid_dim, block_dim, shared_table_bytes, stream>>>(
+            samples_dev_.data(), blocks_dev_.data(), lookup_table, table_size_, default_value);
+      } else {
+        detail::LookupValuesImpl<OutputType, InputType><<<grid_dim, block_dim, 0, stream>>>(
+            samples_dev_.data(), blocks_dev_.data(), lookup_table, default_value);
+      }
 
     ), DALI_FAIL(make_string("Unsupported output type: ", output_type_)); );       // NOLINT
   ), DALI_FAIL(make_string("Unsupported input type: ", input.type())); );     // NOLINT
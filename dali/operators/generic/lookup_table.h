@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2022, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -56,6 +56,8 @@ class LookupTable : public StatelessOperator<Backend> {
  public:
   static constexpr int kLookupTableSize = 0x10000;
   static constexpr int kMaxKey = kLookupTableSize - 1;
+  /** The largest table (in bytes) which is cached in the shared memory by the GPU kernel */
+  static constexpr int kMaxSharedTableBytes = 16 << 10;
 
   explicit inline LookupTable(const OpSpec &spec)
       : StatelessOperator<Backend>(spec),
@@ -79,6 +81,7 @@ class LookupTable : public StatelessOperator<Backend> {
     }
     DALI_ENFORCE(keys.size() == values_f.size(),
       "`keys` size should match `values` size");
+    table_size_ = max_key + 1;
 
     TYPE_SWITCH(output_type_, dali::type2id, OutputType, LUT_OUT_TYPES, (
         value_mem_ = {new OutputType[kLookupTableSize], detail::value_mem_deleter<OutputType>};
@@ -119,12 +122,16 @@ class LookupTable : public StatelessOperator<Backend> {
  private:
   DALIDataType input_type_, output_type_;
   float default_value_f_ = 0.0f;
+  /** The keys above the highest one specified map to the default value */
+  int table_size_ = 0;
   std::unique_ptr<void, void(*)(void*)> value_mem_ = {nullptr, free};
   Tensor<GPUBackend> lut_;
 
   using GpuBlockSetup = kernels::BlockSetup<1, -1>;
 
   GpuBlockSetup block_setup_;
+  /** With the table in the shared memory, the blocks are larger, so that loading it pays off. */
+  GpuBlockSetup shared_table_block_setup_{64};
   std::vector<LutSampleDesc> samples_;
   DeviceBuffer<GpuBlockSetup::BlockDesc> blocks_dev_;
   DeviceBuffer<LutSampleDesc> samples_dev_;
@@ -149,6 +156,16 @@ void DoLookup(Output &output, Input key, const Output *lookup_table, Output defa
   }
 }
 
+/** Checks whether the key is in the range [0, table_size) */
+template <typename Input>
+DALI_HOST_DEV inline bool IsInTable(Input key, int table_size) {
+  if constexpr (std::is_signed<Input>::value) {
+    if (key < 0)
+      return false;
+  }
+  return static_cast<uint64_t>(key) < static_cast<uint64_t>(table_size);
+}
+
 }  // namespace dali
 
 #endif  // DALI_OPERATORS_GENERIC_LOOKUP_TABLE_H_
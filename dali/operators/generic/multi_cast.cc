@@ -0,0 +1,136 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include "dali/core/small_vector.h"
+#include "dali/core/static_switch.h"
+#include "dali/operators/generic/cast.h"
+#include "dali/operators/generic/multi_cast.h"
+
+namespace dali {
+
+DALI_SCHEMA(experimental__MultiCast)
+    .DocStr(R"code(Casts the input to several data types at once.
+
+The input is read only once, which is faster than casting the same input with multiple calls
+to :meth:`nvidia.dali.fn.cast` - for example, when the float input of a model and an 8-bit
+version of the data for visualization are produced from the same tensor::
+
+  images_f32, images_u8 = fn.experimental.multi_cast(images, dtypes=[types.FLOAT, types.UINT8])
+
+Produces as many outputs as there are types in ``dtypes``. Each output can be additionally
+scaled and shifted::
+
+  out[i] = convert(input * scale[i] + shift[i], dtypes[i])
+
+The conversion rounds to the nearest integer and clamps the values to the range of
+the output type.
+)code")
+    .NumInput(1)
+    .OutputFn([](const OpSpec &spec) {
+      return static_cast<int>(spec.GetRepeatedArgument<DALIDataType>("dtypes").size());
+    })
+    .AllowSequences()
+    .SupportVolumetric()
+    .Stateless()
+    .AddArg("dtypes", R"code(Output data types - one output is produced for each type.
+
+At most 8 types can be specified.)code", DALI_DATA_TYPE_VEC)
+    .AddOptionalArg<float>("scale", R"code(Multipliers applied to the input values.
+
+Either a single value for all outputs or one value per output. When ``scale`` or ``shift`` is
+specified for an output, the values are computed in single precision before the conversion.)code",
+        std::vector<float>{1.0f})
+    .AddOptionalArg<float>("shift", R"code(Values added to the scaled input.
+
+Either a single value for all outputs or one value per output.)code",
+        std::vector<float>{0.0f});
+
+class MultiCastCPU : public MultiCast<CPUBackend> {
+ public:
+  explicit MultiCastCPU(const OpSpec &spec) : MultiCast<CPUBackend>(spec) {}
+
+  void RunImpl(Workspace &ws) override;
+};
+
+namespace {
+
+/**
+ * @brief The inputs are processed in tiles of this many elements; a tile stays in the cache
+ *        while it's converted to all the output types.
+ */
+constexpr int64_t kMultiCastTileSize = 2048;
+
+template <typename Out, typename In>
+void MultiCastTile(void *out, const In *in, int64_t n, float scale, float shift, bool affine) {
+  auto *o = static_cast<Out *>(out);
+  if (affine) {
+    for (int64_t i = 0; i < n; i++)
+      o[i] = MultiCastValue<Out>(in[i], scale, shift, true);
+  } else {
+    for (int64_t i = 0; i < n; i++)
+      o[i] = ConvertSat<Out>(in[i]);
+  }
+}
+
+}  // namespace
+
+void MultiCastCPU::RunImpl(Workspace &ws) {
+  const auto &input = ws.Input<CPUBackend>(0);
+  const auto &shape = input.shape();
+  int num_samples = shape.num_samples();
+  int num_outputs = dtypes_.size();
+  for (int o = 0; o < num_outputs; o++)
+    ws.Output<CPUBackend>(o).SetLayout(input.GetLayout());
+
+  auto &tp = ws.GetThreadPool();
+  int64_t chunk_size = CastChunkSize(shape, tp.NumThreads());
+
+  TYPE_SWITCH(input.type(), type2id, In, MULTI_CAST_TYPES, (
+    using TileFn = void (*)(void *, const In *, int64_t, float, float, bool);
+    SmallVector<TileFn, kMaxOutputs> tile_fns;
+    SmallVector<int, kMaxOutputs> out_type_sizes;
+    for (int o = 0; o < num_outputs; o++) {
+      TYPE_SWITCH(dtypes_[o], type2id, Out, MULTI_CAST_TYPES, (
+        tile_fns.push_back(MultiCastTile<Out, In>);
+        out_type_sizes.push_back(sizeof(Out));
+      ), DALI_FAIL(make_string("Invalid output type: ", dtypes_[o])););  // NOLINT
+    }
+
+    for (int sample_id = 0; sample_id < num_samples; sample_id++) {
+      const In *in = input.tensor<In>(sample_id);
+      SmallVector<uint8_t *, kMaxOutputs> outs;
+      for (int o = 0; o < num_outputs; o++)
+        outs.push_back(static_cast<uint8_t *>(ws.Output<CPUBackend>(o).raw_mutable_tensor(
+            sample_id)));
+      int64_t size = shape.tensor_size(sample_id);
+      for (int64_t start = 0; start < size; start += chunk_size) {
+        int64_t end = std::min(start + chunk_size, size);
+        tp.AddWork([=](int thread_id) {
+          for (int64_t tile = start; tile < end; tile += kMultiCastTileSize) {
+            int64_t n = std::min(kMultiCastTileSize, end - tile);
+            for (int o = 0; o < num_outputs; o++)
+              tile_fns[o](outs[o] + tile * out_type_sizes[o], in + tile, n,
+                          scale_[o], shift_[o], affine_[o]);
+          }
+        }, end - start);
+      }
+    }
+  ), DALI_FAIL(make_string("Invalid input type: ", input.type())););  // NOLINT
+  tp.RunAll();
+}
+
+DALI_REGISTER_OPERATOR(experimental__MultiCast, MultiCastCPU, CPU);
+
+}  // namespace dali
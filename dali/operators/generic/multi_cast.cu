@@ -0,0 +1,125 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include "dali/core/cuda_error.h"
+#include "dali/core/static_switch.h"
+#include "dali/core/util.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/operators/generic/multi_cast.h"
+
+namespace dali {
+
+namespace multi_cast {
+
+constexpr int kMaxOutputs = MultiCast<GPUBackend>::kMaxOutputs;
+
+struct SampleDesc {
+  void *outputs[kMaxOutputs];
+  const void *input;
+  int64_t size;
+};
+
+/**
+ * @brief The parameters of the outputs - they are the same for all samples.
+ */
+struct OutputParams {
+  DALIDataType types[kMaxOutputs];
+  float scale[kMaxOutputs], shift[kMaxOutputs];
+  bool affine[kMaxOutputs];
+  int num_outputs;
+};
+
+/**
+ * @brief Casts a sample (blockIdx.y) to all output types.
+ *
+ * Each input element is loaded once and stored in each of the outputs. The switch over the
+ * output type is uniform across the block and doesn't cause divergence.
+ */
+template <typename In>
+__global__ void MultiCastKernel(const SampleDesc *samples, OutputParams params) {
+  const SampleDesc &sample = samples[blockIdx.y];
+  const In *in = static_cast<const In *>(sample.input);
+  for (int64_t idx = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+       idx < sample.size; idx += static_cast<int64_t>(gridDim.x) * blockDim.x) {
+    In value = in[idx];
+    for (int o = 0; o < params.num_outputs; o++) {
+      TYPE_SWITCH(params.types[o], type2id, Out, MULTI_CAST_TYPES, (
+        static_cast<Out *>(sample.outputs[o])[idx] =
+            MultiCastValue<Out>(value, params.scale[o], params.shift[o], params.affine[o]);
+      ), ());  // NOLINT
+    }
+  }
+}
+
+}  // namespace multi_cast
+
+class MultiCastGPU : public MultiCast<GPUBackend> {
+ public:
+  explicit MultiCastGPU(const OpSpec &spec) : MultiCast<GPUBackend>(spec) {}
+
+  void RunImpl(Workspace &ws) override;
+};
+
+void MultiCastGPU::RunImpl(Workspace &ws) {
+  using multi_cast::SampleDesc;
+  const auto &input = ws.Input<GPUBackend>(0);
+  const auto &shape = input.shape();
+  int num_samples = shape.num_samples();
+  int num_outputs = dtypes_.size();
+
+  multi_cast::OutputParams params{};
+  params.num_outputs = num_outputs;
+  for (int o = 0; o < num_outputs; o++) {
+    ws.Output<GPUBackend>(o).SetLayout(input.GetLayout());
+    params.types[o] = dtypes_[o];
+    params.scale[o] = scale_[o];
+    params.shift[o] = shift_[o];
+    params.affine[o] = affine_[o];
+  }
+
+  kernels::DynamicScratchpad scratchpad({}, ws.stream());
+  auto *samples = scratchpad.AllocatePinned<SampleDesc>(num_samples);
+  int nonempty = 0;
+  int64_t max_size = 0;
+  for (int i = 0; i < num_samples; i++) {
+    int64_t size = shape.tensor_size(i);
+    if (size == 0)
+      continue;
+    auto &sample = samples[nonempty++];
+    sample.input = input.raw_tensor(i);
+    sample.size = size;
+    for (int o = 0; o < num_outputs; o++)
+      sample.outputs[o] = ws.Output<GPUBackend>(o).raw_mutable_tensor(i);
+    max_size = std::max(max_size, size);
+  }
+  if (nonempty == 0)
+    return;
+
+  auto *samples_gpu =
+      scratchpad.ToGPU(ws.stream(), span<const SampleDesc>(samples, nonempty));
+
+  constexpr int kBlockSize = 256;
+  constexpr int64_t kMaxBlocksX = 1024;  // the samples are processed with a grid-stride loop
+  dim3 grid(std::min(div_ceil(max_size, kBlockSize), kMaxBlocksX), nonempty);
+
+  TYPE_SWITCH(input.type(), type2id, In, MULTI_CAST_TYPES, (
+    multi_cast::MultiCastKernel<In><<<grid, kBlockSize, 0, ws.stream()>>>(samples_gpu, params);
+  ), DALI_FAIL(make_string("Invalid input type: ", input.type())););  // NOLINT
+  CUDA_CALL(cudaGetLastError());
+}
+
+DALI_REGISTER_OPERATOR(experimental__MultiCast, MultiCastGPU, GPU);
+
+}  // namespace dali
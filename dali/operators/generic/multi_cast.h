@@ -0,0 +1,105 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_GENERIC_MULTI_CAST_H_
+#define DALI_OPERATORS_GENERIC_MULTI_CAST_H_
+
+#include <vector>
+
+#include "dali/core/convert.h"
+#include "dali/core/format.h"
+#include "dali/core/force_inline.h"
+#include "dali/core/host_dev.h"
+#include "dali/core/static_switch.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/pipeline/data/types.h"
+#include "dali/pipeline/operator/checkpointing/stateless_operator.h"
+
+namespace dali {
+
+#define MULTI_CAST_TYPES                                                                   \
+  (uint8_t, uint16_t, uint32_t, uint64_t, int8_t, int16_t, int32_t, int64_t, float16, float, \
+  double)
+
+/**
+ * @brief Converts a value to `Out`; if `affine` is set, `value * scale + shift` is computed
+ *        in single precision and then rounded and clamped to the range of `Out`.
+ */
+template <typename Out, typename In>
+DALI_HOST_DEV DALI_FORCEINLINE Out MultiCastValue(In value, float scale, float shift,
+                                                  bool affine) {
+  return affine ? ConvertSat<Out>(static_cast<float>(value) * scale + shift)
+                : ConvertSat<Out>(value);
+}
+
+/**
+ * @brief Casts the input to several types, reading the input only once
+ */
+template <typename Backend>
+class MultiCast : public StatelessOperator<Backend> {
+ public:
+  static constexpr int kMaxOutputs = 8;
+
+  explicit MultiCast(const OpSpec &spec) : StatelessOperator<Backend>(spec) {
+    dtypes_ = spec.GetRepeatedArgument<DALIDataType>("dtypes");
+    int n = dtypes_.size();
+    DALI_ENFORCE(n >= 1 && n <= kMaxOutputs, make_string(
+        "The number of output types must be between 1 and ", kMaxOutputs, "; got ", n, "."));
+    for (auto type : dtypes_) {
+      TYPE_SWITCH(type, type2id, Out, MULTI_CAST_TYPES, (),
+        DALI_FAIL(make_string("Unsupported output type: ", type)););  // NOLINT
+    }
+    scale_ = GetPerOutputArg(spec, "scale", 1.0f);
+    shift_ = GetPerOutputArg(spec, "shift", 0.0f);
+    affine_.resize(n);
+    for (int i = 0; i < n; i++)
+      affine_[i] = scale_[i] != 1.0f || shift_[i] != 0.0f;
+  }
+
+  DISABLE_COPY_MOVE_ASSIGN(MultiCast);
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override {
+    const auto &input = ws.Input<Backend>(0);
+    int n = dtypes_.size();
+    output_desc.resize(n);
+    for (int i = 0; i < n; i++) {
+      output_desc[i].shape = input.shape();
+      output_desc[i].type = dtypes_[i];
+    }
+    return true;
+  }
+
+  std::vector<DALIDataType> dtypes_;
+  std::vector<float> scale_, shift_;
+  std::vector<bool> affine_;
+
+ private:
+  std::vector<float> GetPerOutputArg(const OpSpec &spec, const char *name, float default_value) {
+    int n = dtypes_.size();
+    if (!spec.HasArgument(name))
+      return std::vector<float>(n, default_value);
+    auto values = spec.GetRepeatedArgument<float>(name);
+    if (values.size() == 1)
+      values = std::vector<float>(n, values[0]);
+    DALI_ENFORCE(static_cast<int>(values.size()) == n, make_string(
+        "The argument `", name, "` must have one value or one value per output type; got ",
+        values.size(), " values for ", n, " output types."));
+    return values;
+  }
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_GENERIC_MULTI_CAST_H_
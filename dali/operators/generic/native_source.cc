@@ -0,0 +1,96 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/generic/native_source.h"
+#include <string>
+#include <vector>
+#include "dali/pipeline/operator/checkpointing/op_checkpoint.h"
+
+namespace dali {
+
+DALI_DEFINE_OPTYPE_REGISTRY(SampleSource, SampleSource);
+
+DALI_SCHEMA(NativeSource)
+    .DocStr(R"code(Produces the data by calling a native (C++) source, in parallel.
+
+The source is a ``SampleSource`` implementation registered with ``DALI_REGISTER_SAMPLE_SOURCE``,
+usually in a plugin (see :meth:`nvidia.dali.plugin_manager.load_library`). In each iteration,
+the source is asked for the shapes of the samples and then fills the samples, in the
+operator's thread pool, directly in the output buffers.
+
+This is a native counterpart of the parallel ``external_source`` - there are no worker processes
+nor shared memory and the Python interpreter is not involved.)code")
+    .NumInput(0)
+    .NumOutput(1)
+    .AddArg("source", R"code(The name under which the source is registered.)code",
+            DALI_STRING)
+    .AddOptionalArg("source_params",
+                    R"code(Parameters of the source; their meaning is defined by the source.)code",
+                    std::vector<std::string>{});
+
+NativeSource::NativeSource(const OpSpec &spec) : Operator<CPUBackend>(spec) {
+  auto name = spec.GetArgument<std::string>("source");
+  source_ = SampleSourceRegistry::Registry().Create(name, spec);
+  DALI_ENFORCE(source_ != nullptr, make_string("Cannot create the native source \"", name, "\"."));
+}
+
+bool NativeSource::SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) {
+  iteration_ = next_iteration_++;
+  int batch_size = ws.GetRequestedBatchSize(0);
+  int ndim = source_->ndim();
+  output_desc.resize(1);
+  output_desc[0].type = source_->dtype();
+  auto &shape = output_desc[0].shape;
+  shape.resize(batch_size, ndim);
+  for (int i = 0; i < batch_size; i++) {
+    auto sample_shape = source_->Shape(SampleInfo(i));
+    DALI_ENFORCE(sample_shape.sample_dim() == ndim,
+                 make_string("The source returned a ", sample_shape.sample_dim(),
+                             "D shape for sample ", i, "; expected ", ndim, "D."));
+    shape.set_tensor_shape(i, sample_shape);
+  }
+  return true;
+}
+
+void NativeSource::RunImpl(Workspace &ws) {
+  auto &out = ws.Output<CPUBackend>(0);
+  out.SetLayout(source_->layout());
+  auto &tp = ws.GetThreadPool();
+  for (int i = 0; i < out.num_samples(); i++) {
+    tp.AddWork([&, i](int) {
+      source_->Fill(out[i], SampleInfo(i));
+    }, out.tensor_shape(i).num_elements());
+  }
+  tp.RunAll();
+}
+
+void NativeSource::SaveState(OpCheckpoint &cpt, AccessOrder order) {
+  cpt.MutableCheckpointState() = next_iteration_;
+}
+
+void NativeSource::RestoreState(const OpCheckpoint &cpt) {
+  next_iteration_ = cpt.CheckpointState<int64_t>();
+}
+
+std::string NativeSource::SerializeCheckpoint(const OpCheckpoint &cpt) const {
+  return std::to_string(cpt.CheckpointState<int64_t>());
+}
+
+void NativeSource::DeserializeCheckpoint(OpCheckpoint &cpt, const std::string &data) const {
+  cpt.MutableCheckpointState() = static_cast<int64_t>(std::stoll(data));
+}
+
+DALI_REGISTER_OPERATOR(NativeSource, NativeSource, CPU);
+
+}  // namespace dali
@@ -0,0 +1,118 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_GENERIC_NATIVE_SOURCE_H_
+#define DALI_OPERATORS_GENERIC_NATIVE_SOURCE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "dali/core/common.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/pipeline/data/sample_view.h"
+#include "dali/pipeline/operator/operator.h"
+#include "dali/pipeline/operator/operator_factory.h"
+
+namespace dali {
+
+/**
+ * @brief Identifies the sample requested from a SampleSource
+ */
+struct SourceSampleInfo {
+  /** The index of the iteration, starting from 0 */
+  int64_t iteration;
+  /** The index of the sample in the batch */
+  int idx_in_batch;
+  /** The index of the sample since the start, assuming full batches */
+  int64_t idx_in_epoch;
+};
+
+/**
+ * @brief A native (C++) data source used by the NativeSource operator
+ *
+ * The sources are registered with DALI_REGISTER_SAMPLE_SOURCE, typically in a plugin, and
+ * selected by the `source` argument of the operator. The source is constructed with the spec
+ * of the operator - it can read its parameters from `source_params`.
+ *
+ * In each iteration, the operator obtains the shapes of all the samples with `Shape` and then
+ * calls `Fill` for each sample in the operator's thread pool, writing directly to the output.
+ */
+class DLL_PUBLIC SampleSource {
+ public:
+  virtual ~SampleSource() = default;
+
+  /** The type of the samples */
+  virtual DALIDataType dtype() const = 0;
+
+  /** The dimensionality of the samples */
+  virtual int ndim() const = 0;
+
+  /** The layout of the samples; empty if not specified */
+  virtual TensorLayout layout() const {
+    return {};
+  }
+
+  /**
+   * @brief Returns the shape of the sample
+   *
+   * It's called sequentially, for all the samples, before the samples are filled.
+   */
+  virtual TensorShape<> Shape(const SourceSampleInfo &info) = 0;
+
+  /**
+   * @brief Writes the sample to `out`, which has the shape returned by `Shape` for `info`
+   *
+   * It's called in the thread pool - the samples of a batch are filled concurrently.
+   */
+  virtual void Fill(const SampleView<CPUBackend> &out, const SourceSampleInfo &info) = 0;
+};
+
+DALI_DECLARE_OPTYPE_REGISTRY(SampleSource, SampleSource);
+
+#define DALI_REGISTER_SAMPLE_SOURCE(SourceName, SourceType)                               \
+  DALI_DEFINE_OPTYPE_REGISTERER(SourceName, SourceType, ::dali::SampleSource,             \
+                                ::dali::SampleSource, "native source")
+
+/**
+ * @brief Produces batches by calling a registered SampleSource in the thread pool
+ *
+ * Unlike the parallel external source in Python, there are no worker processes nor shared
+ * memory - the samples are written directly to the output buffers and the GIL is not involved.
+ */
+class NativeSource : public Operator<CPUBackend> {
+ public:
+  explicit NativeSource(const OpSpec &spec);
+
+  void SaveState(OpCheckpoint &cpt, AccessOrder order) override;
+  void RestoreState(const OpCheckpoint &cpt) override;
+  std::string SerializeCheckpoint(const OpCheckpoint &cpt) const override;
+  void DeserializeCheckpoint(OpCheckpoint &cpt, const std::string &data) const override;
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override;
+  void RunImpl(Workspace &ws) override;
+
+ private:
+  SourceSampleInfo SampleInfo(int idx_in_batch) const {
+    return {iteration_, idx_in_batch, iteration_ * max_batch_size_ + idx_in_batch};
+  }
+
+  std::unique_ptr<SampleSource> source_;
+  int64_t iteration_ = 0;
+  int64_t next_iteration_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_GENERIC_NATIVE_SOURCE_H_
@@ -0,0 +1,102 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/generic/native_source.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "dali/pipeline/pipeline.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief Produces 1D samples of length `1 + idx_in_epoch % 5`, filled with `idx_in_epoch + offset`
+ */
+class TestCountingSource : public SampleSource {
+ public:
+  explicit TestCountingSource(const OpSpec &spec) {
+    auto params = spec.GetRepeatedArgument<std::string>("source_params");
+    if (!params.empty())
+      offset_ = std::stoi(params[0]);
+  }
+
+  DALIDataType dtype() const override {
+    return DALI_INT32;
+  }
+
+  int ndim() const override {
+    return 1;
+  }
+
+  TensorLayout layout() const override {
+    return "X";
+  }
+
+  TensorShape<> Shape(const SourceSampleInfo &info) override {
+    return TensorShape<>{1 + info.idx_in_epoch % 5};
+  }
+
+  void Fill(const SampleView<CPUBackend> &out, const SourceSampleInfo &info) override {
+    auto *data = out.mutable_data<int>();
+    for (int64_t i = 0; i < out.shape().num_elements(); i++)
+      data[i] = info.idx_in_epoch + offset_;
+  }
+
+ private:
+  int offset_ = 0;
+};
+
+}  // namespace
+
+DALI_REGISTER_SAMPLE_SOURCE(TestCountingSource, TestCountingSource);
+
+TEST(NativeSourceTest, Produce) {
+  constexpr int batch_size = 7;
+  Pipeline pipe(batch_size, 3, CPU_ONLY_DEVICE_ID);
+  pipe.AddOperator(OpSpec("NativeSource")
+                       .AddArg("device", "cpu")
+                       .AddArg("source", "TestCountingSource")
+                       .AddArg("source_params", std::vector<std::string>{"100"})
+                       .AddOutput("data", "cpu"));
+  pipe.Build({{"data", "cpu"}});
+
+  for (int iter = 0; iter < 3; iter++) {
+    pipe.Run();
+    Workspace ws;
+    pipe.Outputs(&ws);
+    auto &out = ws.Output<CPUBackend>(0);
+    ASSERT_EQ(out.num_samples(), batch_size);
+    EXPECT_EQ(out.GetLayout(), "X");
+    for (int i = 0; i < batch_size; i++) {
+      int idx = iter * batch_size + i;
+      ASSERT_EQ(out.tensor_shape(i), TensorShape<>{1 + idx % 5});
+      const int *data = out.tensor<int>(i);
+      for (int j = 0; j <= idx % 5; j++)
+        EXPECT_EQ(data[j], idx + 100) << "iteration " << iter << ", sample " << i;
+    }
+  }
+}
+
+TEST(NativeSourceTest, UnknownSource) {
+  Pipeline pipe(1, 1, CPU_ONLY_DEVICE_ID);
+  pipe.AddOperator(OpSpec("NativeSource")
+                       .AddArg("device", "cpu")
+                       .AddArg("source", "NoSuchSource")
+                       .AddOutput("data", "cpu"));
+  EXPECT_THROW(pipe.Build({{"data", "cpu"}}), std::exception);
+}
+
+}  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -94,7 +94,8 @@ void OneHotGPU::RunImplTyped(Workspace &ws, int axis) {
   const auto *scratch_mem_gpu = scratch_mem_.data<one_hot::SampleDesc>();
 
   const int block = 256;
-  auto grid = one_hot::gridHelper(max_out_vol, num_samples, block);
+  auto grid = one_hot::gridHelper(one_hot::NumOneHotThreads<OutputType>(max_out_vol), num_samples,
+                                  block);
 
   one_hot::PopulateOneHot<OutputType, InputType><<<grid, block, 0, stream>>>(
     on_value_, off_value_, scratch_mem_gpu);
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -17,6 +17,9 @@
 
 #include <cstdint>
 #include <algorithm>
+#include "dali/core/cuda_utils.h"
+#include "dali/core/force_inline.h"
+#include "dali/core/host_dev.h"
 #include "dali/core/util.h"
 
 namespace dali {
@@ -28,22 +31,104 @@ struct SampleDesc {
   const void *in = nullptr;
 };
 
+/** The width of the stores issued by PopulateOneHot */
+constexpr int kVecBytes = 16;
+
+template <typename T>
+struct alignas(kVecBytes) OutputVec {
+  static constexpr int size = kVecBytes / sizeof(T);
+  T values[size];
+};
+
+/**
+ * @brief Position in the output, viewed as a tensor of shape (outer, classes, inner)
+ */
+struct OneHotPos {
+  uint64_t outer, cls, inner;
+
+  DALI_HOST_DEV OneHotPos(const SampleDesc &sample, uint64_t out_index) {
+    outer = out_index / sample.inner_vol_classes;
+    uint64_t rem = out_index - outer * sample.inner_vol_classes;
+    cls = rem / sample.inner_vol;
+    inner = rem - cls * sample.inner_vol;
+  }
+
+  DALI_HOST_DEV void next(const SampleDesc &sample, uint64_t num_classes) {
+    if (++inner == sample.inner_vol) {
+      inner = 0;
+      if (++cls == num_classes) {
+        cls = 0;
+        outer++;
+      }
+    }
+  }
+};
+
+template <typename OutputType, typename InputType>
+__device__ DALI_FORCEINLINE OutputType
+OneHotValue(const SampleDesc &sample, const OneHotPos &pos, OutputType on_value,
+            OutputType off_value) {
+  auto *in = static_cast<const InputType*>(sample.in);
+  uint64_t in_val = in[pos.outer * sample.inner_vol + pos.inner];
+  return in_val == pos.cls ? on_value : off_value;
+}
+
+/**
+ * @brief Fills the samples with the one-hot encoding of the input
+ *
+ * The output is written in contiguous, aligned vectors of kVecBytes bytes - the consecutive
+ * threads write consecutive vectors, each one computed with a single division.
+ * The unaligned head and tail of a sample are written element by element.
+ * The kernel is grid-stride, blockIdx.y is the sample index.
+ */
 template <typename OutputType, typename InputType>
 __global__ void PopulateOneHot(OutputType on_value, OutputType off_value,
                                const SampleDesc *samples) {
-  uint64_t out_index = static_cast<uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
-  uint64_t grid_size = gridDim.x * blockDim.x;
+  using Vec = OutputVec<OutputType>;
   const auto &sample = samples[blockIdx.y];
-  for (; out_index < sample.output_vol; out_index += grid_size) {
-    auto *out = static_cast<OutputType*>(sample.out);
-    auto *in = static_cast<const InputType*>(sample.in);
-    uint64_t i = out_index / sample.inner_vol_classes;
-    uint64_t j = out_index % sample.inner_vol;
-    uint64_t in_index = i * sample.inner_vol + j;
-    uint64_t in_val = in[in_index];
-    uint64_t on_out_index = i * sample.inner_vol_classes + in_val * sample.inner_vol + j;
-    out[out_index] = on_out_index == out_index ? on_value : off_value;
+  if (sample.output_vol == 0)
+    return;
+  auto *out = static_cast<OutputType*>(sample.out);
+  uint64_t num_classes = sample.inner_vol_classes / sample.inner_vol;
+
+  uint64_t misalignment = reinterpret_cast<uintptr_t>(out) % kVecBytes;
+  uint64_t head = misalignment ? (kVecBytes - misalignment) / sizeof(OutputType) : 0;
+  head = cuda_min(head, sample.output_vol);
+  uint64_t num_vecs = (sample.output_vol - head) / Vec::size;
+  uint64_t tail = head + num_vecs * Vec::size;
+
+  uint64_t tid = static_cast<uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  uint64_t grid_size = static_cast<uint64_t>(gridDim.x) * blockDim.x;
+
+  for (uint64_t i = tid; i < head; i += grid_size) {
+    OneHotPos pos(sample, i);
+    out[i] = OneHotValue<OutputType, InputType>(sample, pos, on_value, off_value);
   }
+  for (uint64_t i = tail + tid; i < sample.output_vol; i += grid_size) {
+    OneHotPos pos(sample, i);
+    out[i] = OneHotValue<OutputType, InputType>(sample, pos, on_value, off_value);
+  }
+
+  auto *out_vecs = reinterpret_cast<Vec *>(out + head);
+  for (uint64_t v = tid; v < num_vecs; v += grid_size) {
+    OneHotPos pos(sample, head + v * Vec::size);
+    Vec vec;
+    #pragma unroll
+    for (int k = 0; k < Vec::size; k++) {
+      vec.values[k] = OneHotValue<OutputType, InputType>(sample, pos, on_value, off_value);
+      pos.next(sample, num_classes);
+    }
+    out_vecs[v] = vec;
+  }
+}
+
+/**
+ * @brief The number of threads needed by PopulateOneHot to cover `output_vol` elements
+ *        of type `T` - one per vector
+ */
+template <typename T>
+uint64_t NumOneHotThreads(uint64_t output_vol) {
+  return div_ceil(output_vol, OutputVec<T>::size);
 }
 
 dim3 gridHelper(uint64_t output_vol, int batch_size, int block = 256,
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -80,7 +80,8 @@ struct OneHotOpGpuPerfTest : public ::testing::Test {
     auto output_vol = input_vol * config_.num_classes;
 
     const int block = 256;
-    auto grid = one_hot::gridHelper(output_vol, config_.batch_size, block);
+    auto grid = one_hot::gridHelper(one_hot::NumOneHotThreads<Out>(output_vol), config_.batch_size,
+                                    block);
 
     Out on_value = 1, off_value = 0;
     one_hot::PopulateOneHot<Out, In>
@@ -0,0 +1,76 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/generic/pack_bits.h"
+
+namespace dali {
+
+DALI_SCHEMA(experimental__PackBits)
+  .DocStr(R"code(Packs the elements of the innermost dimension into bits, 8 elements per byte.
+
+Each non-zero element yields a set bit; the first of each 8 elements goes to the most significant
+bit, as in ``numpy.packbits``. The output is of type ``uint8`` and its innermost extent is that
+of the input divided by 8 and rounded up - the unused bits of the last byte in each row are zero.
+
+Packing cuts the memory footprint of large masks (e.g. segmentation labels or 3D mask volumes)
+8 times. For example, a mask can be packed on the CPU, copied to the GPU and unpacked there with
+:meth:`experimental.unpack_bits`, which reduces the size of the host-to-device copy.
+)code")
+  .NumInput(1)
+  .NumOutput(1)
+  .AllowSequences()
+  .SupportVolumetric();
+
+DALI_SCHEMA(experimental__UnpackBits)
+  .DocStr(R"code(Unpacks the bits packed with :meth:`experimental.pack_bits`.
+
+Each bit of the input yields an element equal to 0 or 1. The innermost extent of the output is
+8 times that of the input or ``count``, if specified.
+)code")
+  .NumInput(1)
+  .NumOutput(1)
+  .AllowSequences()
+  .SupportVolumetric()
+  .AddOptionalTypeArg("dtype", R"code(Output data type.)code", DALI_UINT8)
+  .AddOptionalArg<int64_t>("count", R"code(The innermost extent of the output.
+
+It can be used to restore the original extent of the data which wasn't a multiple of 8.
+If negative, the output has 8 elements for each byte of the input.)code", -1);
+
+template <>
+void PackBits<CPUBackend>::RunImpl(Workspace &ws) {
+  const auto &input = ws.Input<CPUBackend>(0);
+  auto &output = ws.Output<CPUBackend>(0);
+  output.SetLayout(input.GetLayout());
+  SetPointers(ws);
+  TYPE_SWITCH(input.type(), type2id, T, PACK_BITS_IN_TYPES, (
+    RunCPU<true, T>(ws.GetThreadPool());
+  ), DALI_FAIL(make_string("Unsupported input type: ", input.type())););  // NOLINT
+}
+
+template <>
+void UnpackBits<CPUBackend>::RunImpl(Workspace &ws) {
+  const auto &input = ws.Input<CPUBackend>(0);
+  auto &output = ws.Output<CPUBackend>(0);
+  output.SetLayout(input.GetLayout());
+  SetPointers(ws);
+  TYPE_SWITCH(dtype_, type2id, T, UNPACK_BITS_OUT_TYPES, (
+    RunCPU<false, T>(ws.GetThreadPool());
+  ), DALI_FAIL(make_string("Unsupported output type: ", dtype_)););  // NOLINT
+}
+
+DALI_REGISTER_OPERATOR(experimental__PackBits, PackBits<CPUBackend>, CPU);
+DALI_REGISTER_OPERATOR(experimental__UnpackBits, UnpackBits<CPUBackend>, CPU);
+
+}  // namespace dali
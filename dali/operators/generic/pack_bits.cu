@@ -0,0 +1,73 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/generic/pack_bits.h"
+
+namespace dali {
+
+namespace detail {
+
+/** Each thread produces (or consumes) one packed byte at a time. */
+template <bool pack, typename T>
+__global__ void BitPackingKernel(const BitPackingSampleDesc *samples,
+                                 const kernels::BlockDesc<1> *blocks) {
+  const auto &block = blocks[blockIdx.x];
+  const auto sample = samples[block.sample_idx];
+  for (int64_t idx = threadIdx.x + block.start.x; idx < block.end.x; idx += blockDim.x)
+    ProcessPackedByte<pack, T>(sample, idx);
+}
+
+}  // namespace detail
+
+template <>
+template <bool pack, typename T>
+void BitPackingBase<GPUBackend>::RunGPU(cudaStream_t stream) {
+  samples_dev_.from_host(samples_, stream);
+  block_setup_.SetupBlocks(collapsed_shape_, true);
+  blocks_dev_.from_host(block_setup_.Blocks(), stream);
+  dim3 grid_dim = block_setup_.GridDim();
+  dim3 block_dim = block_setup_.BlockDim();
+  if (grid_dim.x == 0)
+    return;
+  detail::BitPackingKernel<pack, T><<<grid_dim, block_dim, 0, stream>>>(
+      samples_dev_.data(), blocks_dev_.data());
+  CUDA_CALL(cudaGetLastError());
+}
+
+template <>
+void PackBits<GPUBackend>::RunImpl(Workspace &ws) {
+  const auto &input = ws.Input<GPUBackend>(0);
+  auto &output = ws.Output<GPUBackend>(0);
+  output.SetLayout(input.GetLayout());
+  SetPointers(ws);
+  TYPE_SWITCH(input.type(), type2id, T, PACK_BITS_IN_TYPES, (
+    this->template RunGPU<true, T>(ws.stream());
+  ), DALI_FAIL(make_string("Unsupported input type: ", input.type())););  // NOLINT
+}
+
+template <>
+void UnpackBits<GPUBackend>::RunImpl(Workspace &ws) {
+  const auto &input = ws.Input<GPUBackend>(0);
+  auto &output = ws.Output<GPUBackend>(0);
+  output.SetLayout(input.GetLayout());
+  SetPointers(ws);
+  TYPE_SWITCH(dtype_, type2id, T, UNPACK_BITS_OUT_TYPES, (
+    this->template RunGPU<false, T>(ws.stream());
+  ), DALI_FAIL(make_string("Unsupported output type: ", dtype_)););  // NOLINT
+}
+
+DALI_REGISTER_OPERATOR(experimental__PackBits, PackBits<GPUBackend>, GPU);
+DALI_REGISTER_OPERATOR(experimental__UnpackBits, UnpackBits<GPUBackend>, GPU);
+
+}  // namespace dali
@@ -0,0 +1,224 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_GENERIC_PACK_BITS_H_
+#define DALI_OPERATORS_GENERIC_PACK_BITS_H_
+
+#define PACK_BITS_IN_TYPES \
+  (bool, uint8_t, uint16_t, uint32_t, uint64_t, int8_t, int16_t, int32_t, int64_t, float)
+#define UNPACK_BITS_OUT_TYPES (bool, uint8_t, int32_t, float)
+
+#include <vector>
+#include "dali/core/dev_buffer.h"
+#include "dali/core/host_dev.h"
+#include "dali/core/static_switch.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/kernels/common/block_setup.h"
+#include "dali/pipeline/operator/checkpointing/stateless_operator.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+/** A sample of a mask, viewed as `rows` rows (the innermost dimension) of elements.
+ *
+ * Each row of `row_len` elements is packed into `packed_row_len` == ceil(row_len / 8) bytes.
+ */
+struct BitPackingSampleDesc {
+  void *output;
+  const void *input;
+  int64_t rows;
+  int64_t row_len;
+  int64_t packed_row_len;
+};
+
+/** Packs up to 8 elements into a byte - the first element goes to the most significant bit */
+template <typename T>
+DALI_HOST_DEV DALI_FORCEINLINE uint8_t PackByte(const T *in, int n) {
+  uint8_t byte = 0;
+  for (int b = 0; b < 8; b++)
+    if (b < n && in[b] != T(0))
+      byte |= 0x80u >> b;
+  return byte;
+}
+
+/** Unpacks up to 8 elements from a byte (see PackByte) as 0 or 1 */
+template <typename T>
+DALI_HOST_DEV DALI_FORCEINLINE void UnpackByte(T *out, uint8_t byte, int n) {
+  for (int b = 0; b < 8; b++)
+    if (b < n)
+      out[b] = static_cast<T>((byte >> (7 - b)) & 1);
+}
+
+/** Packs or unpacks the byte with the given (flat) index in the packed sample */
+template <bool pack, typename T>
+DALI_HOST_DEV DALI_FORCEINLINE void ProcessPackedByte(const BitPackingSampleDesc &sample,
+                                                      int64_t idx) {
+  int64_t row = idx / sample.packed_row_len;
+  int64_t col = (idx - row * sample.packed_row_len) * 8;
+  int64_t offset = row * sample.row_len + col;
+  int64_t remaining = sample.row_len - col;
+  int n = remaining < 8 ? remaining : 8;
+  if (pack) {
+    const T *in = static_cast<const T *>(sample.input);
+    static_cast<uint8_t *>(sample.output)[idx] = PackByte(in + offset, n);
+  } else {
+    T *out = static_cast<T *>(sample.output);
+    UnpackByte(out + offset, static_cast<const uint8_t *>(sample.input)[idx], n);
+  }
+}
+
+/**
+ * @brief The common part of PackBits and UnpackBits
+ *
+ * Both operators go over the bytes of the packed samples - the shape of the packed sample is
+ * that of the unpacked one, with the innermost extent divided by 8 (rounded up).
+ */
+template <typename Backend>
+class BitPackingBase : public StatelessOperator<Backend> {
+ public:
+  explicit BitPackingBase(const OpSpec &spec) : StatelessOperator<Backend>(spec) {}
+
+ protected:
+  /** Fills the sample descriptors; the packed and the unpacked shapes can be in either order. */
+  void SetupSamples(const TensorListShape<> &packed_shape, const TensorListShape<> &row_len) {
+    int N = packed_shape.num_samples();
+    samples_.resize(N);
+    collapsed_shape_.resize(N);
+    for (int i = 0; i < N; i++) {
+      auto &s = samples_[i];
+      auto sample_shape = packed_shape.tensor_shape_span(i);
+      s.packed_row_len = sample_shape.back();
+      s.row_len = row_len.tensor_shape_span(i).back();
+      s.rows = s.packed_row_len ? packed_shape.tensor_size(i) / s.packed_row_len : 0;
+      collapsed_shape_.tensor_shape_span(i)[0] = s.rows * s.packed_row_len;
+    }
+  }
+
+  void SetPointers(const Workspace &ws) {
+    const auto &input = ws.Input<Backend>(0);
+    auto &output = ws.Output<Backend>(0);
+    for (int i = 0; i < input.num_samples(); i++) {
+      samples_[i].input = input.raw_tensor(i);
+      samples_[i].output = output.raw_mutable_tensor(i);
+    }
+  }
+
+  /** Runs the per-byte function on the CPU thread pool; used only by the CPU operators */
+  template <bool pack, typename T>
+  void RunCPU(ThreadPool &tp) {
+    for (int i = 0; i < static_cast<int>(samples_.size()); i++) {
+      const auto &sample = samples_[i];
+      int64_t size = collapsed_shape_.tensor_shape_span(i)[0];
+      if (size == 0)
+        continue;
+      tp.AddWork([sample, size](int) {
+        for (int64_t idx = 0; idx < size; idx++)
+          ProcessPackedByte<pack, T>(sample, idx);
+      }, size * 8);
+    }
+    tp.RunAll();
+  }
+
+  /** Runs the per-byte function on the GPU; defined in pack_bits.cu */
+  template <bool pack, typename T>
+  void RunGPU(cudaStream_t stream);
+
+  std::vector<BitPackingSampleDesc> samples_;
+  TensorListShape<1> collapsed_shape_;
+
+  using GpuBlockSetup = kernels::BlockSetup<1, -1>;
+  GpuBlockSetup block_setup_;
+  DeviceBuffer<GpuBlockSetup::BlockDesc> blocks_dev_;
+  DeviceBuffer<BitPackingSampleDesc> samples_dev_;
+};
+
+/**
+ * @brief Packs the elements of the innermost dimension into bits - 8 elements per byte
+ *
+ * A non-zero element yields a set bit.
+ */
+template <typename Backend>
+class PackBits : public BitPackingBase<Backend> {
+ public:
+  explicit PackBits(const OpSpec &spec) : BitPackingBase<Backend>(spec) {}
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override {
+    const auto &input = ws.Input<Backend>(0);
+    const auto &in_shape = input.shape();
+    DALI_ENFORCE(in_shape.sample_dim() >= 1, "The input of PackBits must not be a scalar.");
+    output_desc.resize(1);
+    output_desc[0].type = DALI_UINT8;
+    output_desc[0].shape = in_shape;
+    for (int i = 0; i < in_shape.num_samples(); i++) {
+      auto &len = output_desc[0].shape.tensor_shape_span(i).back();
+      len = (len + 7) / 8;
+    }
+    this->SetupSamples(output_desc[0].shape, in_shape);
+    return true;
+  }
+
+  void RunImpl(Workspace &ws) override;
+};
+
+/**
+ * @brief Unpacks the bits packed with PackBits
+ *
+ * The innermost extent of the output is 8 times that of the input, or `count`, if specified.
+ */
+template <typename Backend>
+class UnpackBits : public BitPackingBase<Backend> {
+ public:
+  explicit UnpackBits(const OpSpec &spec)
+  : BitPackingBase<Backend>(spec)
+  , dtype_(spec.GetArgument<DALIDataType>("dtype"))
+  , count_(spec.GetArgument<int64_t>("count")) {
+    TYPE_SWITCH(dtype_, type2id, T, UNPACK_BITS_OUT_TYPES, (),
+      DALI_FAIL(make_string("Unsupported output type: ", dtype_)));  // NOLINT
+  }
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override {
+    const auto &input = ws.Input<Backend>(0);
+    DALI_ENFORCE(input.type() == DALI_UINT8, make_string(
+        "The input of UnpackBits must be of type uint8, got: ", input.type()));
+    const auto &in_shape = input.shape();
+    DALI_ENFORCE(in_shape.sample_dim() >= 1, "The input of UnpackBits must not be a scalar.");
+    output_desc.resize(1);
+    output_desc[0].type = dtype_;
+    output_desc[0].shape = in_shape;
+    for (int i = 0; i < in_shape.num_samples(); i++) {
+      auto &len = output_desc[0].shape.tensor_shape_span(i).back();
+      if (count_ >= 0) {
+        DALI_ENFORCE(count_ <= len * 8, make_string("The sample ", i, " has only ", len * 8,
+                     " bits in each row, cannot unpack ", count_, " elements."));
+        len = count_;
+      } else {
+        len *= 8;
+      }
+    }
+    this->SetupSamples(in_shape, output_desc[0].shape);
+    return true;
+  }
+
+  void RunImpl(Workspace &ws) override;
+
+ private:
+  DALIDataType dtype_;
+  int64_t count_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_GENERIC_PACK_BITS_H_
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -18,6 +18,7 @@
 #include "dali/core/static_switch.h"
 #include "dali/core/tensor_layout.h"
 #include "dali/kernels/slice/slice_cpu.h"
+#include "dali/kernels/slice/slice_flip_normalize_permute_pad_cpu.h"
 #include "dali/operators/generic/pad.h"
 #include "dali/pipeline/data/views.h"
 
@@ -183,7 +184,89 @@ the aligned size of the largest sample in the batch.
 If the provided extent is smaller than the one of the samples, padding will be applied
 only to match the required alignment. For example, to disable padding in an axis, except
 for the necessary for alignment, you can specify a value of 1.)code",
-    std::vector<int>(), true);
+    std::vector<int>(), true)
+  .AddOptionalTypeArg("dtype", R"code(Output data type.
+
+If specified, the samples are converted to this type in the same pass as the padding, which
+is cheaper than a separate :meth:`nvidia.dali.fn.cast`. By default, the output type is the
+same as the type of the input.)code")
+  .AddOptionalArg<float>("mean",
+    R"code(If specified, the samples are normalized as ``(x - mean) / stddev``, in the same pass
+as the padding.
+
+Either a scalar or one value per channel. The channel axis is the one with the name 'C' in the
+input layout or, if there is none, the innermost axis. The padded region is filled with
+``fill_value``, which is not normalized.)code",
+    std::vector<float>())
+  .AddOptionalArg<float>("stddev",
+    R"code(If specified, the samples are normalized as ``(x - mean) / stddev``, in the same pass
+as the padding.
+
+Either a scalar or one value per channel - see ``mean``.)code",
+    std::vector<float>());
+
+template <>
+void Pad<CPUBackend>::SetupFused(std::vector<OutputDesc> &output_desc, const Workspace &ws) {
+  const auto &input = ws.Input<CPUBackend>(0);
+  auto in_shape = input.shape();
+  auto in_layout = input.GetLayout();
+  int ndim = in_shape.sample_dim();
+  int nsamples = in_shape.num_samples();
+
+  TYPE_SWITCH(input.type(), type2id, InputType, PAD_FUSED_IN_TYPES, (
+    TYPE_SWITCH(out_type_, type2id, OutputType, PAD_FUSED_OUT_TYPES, (
+      VALUE_SWITCH(ndim, Dims, PAD_FUSED_NDIMS, (
+        using Kernel = kernels::SliceFlipNormalizePermutePadCpu<OutputType, InputType, Dims>;
+        using Args = kernels::SliceFlipNormalizePermutePadArgs<Dims>;
+
+        kmgr_.Resize<Kernel>(nsamples);
+        output_desc[0].type = out_type_;
+        output_desc[0].shape.resize(nsamples, Dims);
+
+        auto &kernel_sample_args = FillArgs<Args>(in_shape, in_layout);
+        FillFusedArgs<Dims>(kernel_sample_args, in_shape, in_layout);
+        for (int i = 0; i < nsamples; i++) {
+          auto in_view = view<const InputType, Dims>(input[i]);
+          kernels::KernelContext ctx;
+          auto req = kmgr_.Setup<Kernel>(i, ctx, in_view, kernel_sample_args[i]);
+          output_desc[0].shape.set_tensor_shape(i, req.output_shapes[0][0].shape);
+        }
+      ), DALI_FAIL(make_string("Unsupported number of dimensions with `dtype` or normalization: ",
+                               ndim)));  // NOLINT
+    ), DALI_FAIL(make_string("Unsupported output type: ", out_type_)));  // NOLINT
+  ), DALI_FAIL(make_string("Unsupported input type with `dtype` or normalization: ",
+                           input.type())));  // NOLINT
+}
+
+template <>
+void Pad<CPUBackend>::RunFused(Workspace &ws) {
+  const auto &input = ws.Input<CPUBackend>(0);
+  auto &output = ws.Output<CPUBackend>(0);
+  int nsamples = input.num_samples();
+  int ndim = input.shape().sample_dim();
+  auto& thread_pool = ws.GetThreadPool();
+  auto out_shape = output.shape();
+  TYPE_SWITCH(input.type(), type2id, InputType, PAD_FUSED_IN_TYPES, (
+    TYPE_SWITCH(out_type_, type2id, OutputType, PAD_FUSED_OUT_TYPES, (
+      VALUE_SWITCH(ndim, Dims, PAD_FUSED_NDIMS, (
+        using Kernel = kernels::SliceFlipNormalizePermutePadCpu<OutputType, InputType, Dims>;
+        using Args = kernels::SliceFlipNormalizePermutePadArgs<Dims>;
+
+        for (int i = 0; i < nsamples; i++) {
+          thread_pool.AddWork(
+            [this, &input, &output, i](int thread_id) {
+              kernels::KernelContext ctx;
+              auto in_view = view<const InputType, Dims>(input[i]);
+              auto out_view = view<OutputType, Dims>(output[i]);
+              auto &kernel_sample_args = std::any_cast<std::vector<Args>&>(kernel_sample_args_);
+              kmgr_.Run<Kernel>(i, ctx, out_view, in_view, kernel_sample_args[i]);
+            }, out_shape.tensor_size(i));
+        }
+        thread_pool.RunAll();
+      ), DALI_FAIL(make_string("Unsupported number of dimensions ", ndim)));  // NOLINT
+    ), DALI_FAIL(make_string("Unsupported output type: ", out_type_)));  // NOLINT
+  ), DALI_FAIL(make_string("Unsupported data type: ", input.type())));  // NOLINT
+}
 
 template <>
 bool Pad<CPUBackend>::SetupImpl(std::vector<OutputDesc> &output_desc,
@@ -197,6 +280,12 @@ bool Pad<CPUBackend>::SetupImpl(std::vector<OutputDesc> &output_desc,
   auto nthreads = ws.GetThreadPool().NumThreads();
 
   ReadArguments(spec_, ws);
+  out_type_ = dtype_ != DALI_NO_TYPE ? dtype_ : input.type();
+  fused_ = normalize_ || out_type_ != input.type();
+  if (fused_) {
+    SetupFused(output_desc, ws);
+    return true;
+  }
 
   TYPE_SWITCH(input.type(), type2id, T, PAD_SUPPORTED_TYPES, (
     VALUE_SWITCH(ndim, Dims, PAD_SUPPORTED_NDIMS, (
@@ -227,6 +316,10 @@ void Pad<CPUBackend>::RunImpl(Workspace &ws) {
   output.SetLayout(input.GetLayout());
   int nsamples = input.num_samples();
   int ndim = input.shape().sample_dim();
+  if (fused_) {
+    RunFused(ws);
+    return;
+  }
   auto& thread_pool = ws.GetThreadPool();
   auto out_shape = output.shape();
   TYPE_SWITCH(input.type(), type2id, T, PAD_SUPPORTED_TYPES, (
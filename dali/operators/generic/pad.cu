@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -18,9 +18,64 @@
 #include "dali/core/static_switch.h"
 #include "dali/pipeline/data/views.h"
 #include "dali/kernels/slice/slice_gpu.cuh"
+#include "dali/kernels/slice/slice_flip_normalize_permute_pad_gpu.h"
 
 namespace dali {
 
+template <>
+void Pad<GPUBackend>::SetupFused(std::vector<OutputDesc> &output_desc, const Workspace &ws) {
+  const auto &input = ws.Input<GPUBackend>(0);
+  auto in_shape = input.shape();
+  auto in_layout = input.GetLayout();
+  int ndim = in_shape.sample_dim();
+
+  TYPE_SWITCH(input.type(), type2id, InputType, PAD_FUSED_IN_TYPES, (
+    TYPE_SWITCH(out_type_, type2id, OutputType, PAD_FUSED_OUT_TYPES, (
+      VALUE_SWITCH(ndim, Dims, PAD_FUSED_NDIMS, (
+        using Kernel = kernels::SliceFlipNormalizePermutePadGpu<OutputType, InputType, Dims>;
+        using Args = kernels::SliceFlipNormalizePermutePadArgs<Dims>;
+
+        kernels::KernelContext ctx;
+        ctx.gpu.stream = ws.stream();
+
+        auto in_view = view<const InputType, Dims>(input);
+        auto &kernel_sample_args = FillArgs<Args>(in_shape, in_layout);
+        FillFusedArgs<Dims>(kernel_sample_args, in_shape, in_layout);
+
+        kmgr_.Resize<Kernel>(1);
+        auto req = kmgr_.Setup<Kernel>(0, ctx, in_view, kernel_sample_args);
+
+        output_desc[0].type = out_type_;
+        output_desc[0].shape = req.output_shapes[0];
+      ), DALI_FAIL(make_string("Unsupported number of dimensions with `dtype` or normalization: ",
+                               ndim)));  // NOLINT
+    ), DALI_FAIL(make_string("Unsupported output type: ", out_type_)));  // NOLINT
+  ), DALI_FAIL(make_string("Unsupported input type with `dtype` or normalization: ",
+                           input.type())));  // NOLINT
+}
+
+template <>
+void Pad<GPUBackend>::RunFused(Workspace &ws) {
+  const auto &input = ws.Input<GPUBackend>(0);
+  auto &output = ws.Output<GPUBackend>(0);
+  int ndim = input.shape().sample_dim();
+  TYPE_SWITCH(input.type(), type2id, InputType, PAD_FUSED_IN_TYPES, (
+    TYPE_SWITCH(out_type_, type2id, OutputType, PAD_FUSED_OUT_TYPES, (
+      VALUE_SWITCH(ndim, Dims, PAD_FUSED_NDIMS, (
+        using Kernel = kernels::SliceFlipNormalizePermutePadGpu<OutputType, InputType, Dims>;
+        using Args = kernels::SliceFlipNormalizePermutePadArgs<Dims>;
+
+        auto in_view = view<const InputType, Dims>(input);
+        auto out_view = view<OutputType, Dims>(output);
+        kernels::KernelContext ctx;
+        ctx.gpu.stream = ws.stream();
+        auto &kernel_sample_args = std::any_cast<std::vector<Args>&>(kernel_sample_args_);
+        kmgr_.Run<Kernel>(0, ctx, out_view, in_view, kernel_sample_args);
+      ), DALI_FAIL(make_string("Unsupported number of dimensions ", ndim)));  // NOLINT
+    ), DALI_FAIL(make_string("Unsupported output type: ", out_type_)));  // NOLINT
+  ), DALI_FAIL(make_string("Unsupported data type: ", input.type())));  // NOLINT
+}
+
 template <>
 bool Pad<GPUBackend>::SetupImpl(std::vector<OutputDesc> &output_desc,
                                 const Workspace &ws) {
@@ -32,6 +87,12 @@ bool Pad<GPUBackend>::SetupImpl(std::vector<OutputDesc> &output_desc,
   int nsamples = in_shape.num_samples();
 
   this->ReadArguments(spec_, ws);
+  out_type_ = dtype_ != DALI_NO_TYPE ? dtype_ : input.type();
+  fused_ = normalize_ || out_type_ != input.type();
+  if (fused_) {
+    SetupFused(output_desc, ws);
+    return true;
+  }
 
   TYPE_SWITCH(input.type(), type2id, T, PAD_SUPPORTED_TYPES, (
     VALUE_SWITCH(ndim, Dims, PAD_SUPPORTED_NDIMS, (
@@ -60,6 +121,10 @@ void Pad<GPUBackend>::RunImpl(Workspace &ws) {
   const auto &input = ws.Input<GPUBackend>(0);
   auto &output = ws.Output<GPUBackend>(0);
   output.SetLayout(input.GetLayout());
+  if (fused_) {
+    RunFused(ws);
+    return;
+  }
   int ndim = input.shape().sample_dim();
   TYPE_SWITCH(input.type(), type2id, T, PAD_SUPPORTED_TYPES, (
     VALUE_SWITCH(ndim, Dims, PAD_SUPPORTED_NDIMS, (
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -22,8 +22,10 @@
 #include <vector>
 
 #include "dali/core/error_handling.h"
+#include "dali/core/small_vector.h"
 #include "dali/kernels/kernel_manager.h"
 #include "dali/kernels/scratch.h"
+#include "dali/kernels/slice/slice_flip_normalize_permute_pad_common.h"
 #include "dali/operators/util/axis_args.h"
 #include "dali/pipeline/operator/checkpointing/stateless_operator.h"
 #include "dali/pipeline/operator/operator.h"
@@ -32,6 +34,12 @@
                              uint64_t, int64_t, float, float16, bool)
 #define PAD_SUPPORTED_NDIMS (1, 2, 3, 4, 5)
 
+// The types and dimensionalities supported when the padding is fused with a conversion
+// (``dtype``) and normalization (``mean``, ``stddev``)
+#define PAD_FUSED_IN_TYPES (uint8_t, int8_t, uint16_t, int16_t, int32_t, int64_t, float, float16)
+#define PAD_FUSED_OUT_TYPES (float, float16, int32_t, int64_t)
+#define PAD_FUSED_NDIMS (1, 2, 3)
+
 namespace dali {
 
 template <typename Backend>
@@ -43,6 +51,29 @@ class Pad : public StatelessOperator<Backend> {
       , shape_("shape", spec)
       , align_("align", spec)
       , fill_value_("fill_value", spec) {
+    spec.TryGetArgument(dtype_, "dtype");
+    auto mean = spec.GetRepeatedArgument<float>("mean");
+    auto stddev = spec.GetRepeatedArgument<float>("stddev");
+    normalize_ = !mean.empty() || !stddev.empty();
+    if (normalize_) {
+      if (mean.empty())
+        mean = {0.0f};
+      if (stddev.empty())
+        stddev = {1.0f};
+      DALI_ENFORCE(mean.size() == stddev.size() || mean.size() == 1 || stddev.size() == 1,
+                   make_string("The arguments `mean` and `stddev` must have the same number of "
+                               "elements or one of them must be a scalar. Got ", mean.size(),
+                               " and ", stddev.size(), " elements."));
+      size_t n = std::max(mean.size(), stddev.size());
+      mean_.resize(n);
+      inv_stddev_.resize(n);
+      for (size_t c = 0; c < n; c++) {
+        float s = stddev[stddev.size() == 1 ? 0 : c];
+        DALI_ENFORCE(s > 0, "The values of `stddev` must be positive.");
+        mean_[c] = mean[mean.size() == 1 ? 0 : c];
+        inv_stddev_[c] = 1.0f / s;
+      }
+    }
   }
 
  protected:
@@ -51,6 +82,10 @@ class Pad : public StatelessOperator<Backend> {
   using Operator<Backend>::RunImpl;
   void RunImpl(Workspace &ws) override;
 
+  /** Pads the samples and converts them to `out_type_`, optionally normalizing them */
+  void SetupFused(std::vector<OutputDesc> &output_desc, const Workspace &ws);
+  void RunFused(Workspace &ws);
+
  private:
   void ReadArguments(const OpSpec &spec, const Workspace &ws) {
     const auto &input = ws.Input<Backend>(0);
@@ -144,11 +179,46 @@ class Pad : public StatelessOperator<Backend> {
     return kernel_sample_args;
   }
 
+  /**
+   * @brief Fills the conversion-specific part of the arguments, on top of `FillArgs`
+   *
+   * The per-channel normalization is applied along the 'C' axis or, if there's none,
+   * the innermost one.
+   */
+  template <int Dims>
+  void FillFusedArgs(std::vector<kernels::SliceFlipNormalizePermutePadArgs<Dims>> &args,
+                     const TensorListShape<> &in_shape, TensorLayout in_layout) {
+    int channel_dim = -1;
+    if (mean_.size() > 1) {
+      channel_dim = in_layout.find('C');
+      if (channel_dim < 0)
+        channel_dim = Dims - 1;
+    }
+    for (int sample_idx = 0; sample_idx < in_shape.num_samples(); sample_idx++) {
+      auto &sample_args = args[sample_idx];
+      sample_args.in_shape = in_shape.tensor_shape<Dims>(sample_idx);
+      for (int d = 0; d < Dims; d++) {
+        sample_args.flip[d] = false;
+        sample_args.permuted_dims[d] = d;
+      }
+      sample_args.mean = mean_;
+      sample_args.inv_stddev = inv_stddev_;
+      sample_args.channel_dim = channel_dim;
+    }
+  }
+
   AxisArgs axis_args_;
   ArgValue<int, 1> shape_;
   ArgValue<int, 1> align_;
   ArgValue<float> fill_value_;
 
+  DALIDataType dtype_ = DALI_NO_TYPE;
+  bool normalize_ = false;
+  SmallVector<float, 8> mean_, inv_stddev_;
+  /** The output type and whether the padding is fused with the conversion in this iteration */
+  DALIDataType out_type_ = DALI_NO_TYPE;
+  bool fused_ = false;
+
   kernels::KernelManager kmgr_;
   std::any kernel_sample_args_;
 
@@ -30,46 +30,8 @@ on indices given in ``indices`` argument::
 of scalars representing indices of the tensors in the input batch.
 
 The indices must be within ``[0..batch_size)`` range. Repetitions and omissions are allowed.)",
-    DALI_INT_VEC, true);
-
-void PermuteBatch<CPUBackend>::RunImpl(Workspace &ws) {
-  auto &input = ws.Input<CPUBackend>(0);
-  auto &output = ws.Output<CPUBackend>(0);
-  const auto &output_shape = output.shape();
-  output.SetLayout(input.GetLayout());
-
-  auto &tp = ws.GetThreadPool();
-  int N = indices_.size();
-  for (int i = 0; i < N; i++) {
-    auto size = output_shape.tensor_size(i);
-    int src = indices_[i];
-    tp.AddWork([&, i, src](int tid) {
-      output.SetMeta(i, input.GetMeta(i));
-      // TODO(klecki): SetSample
-      output.CopySample(i, input, src);
-    }, size);
-  }
-  tp.RunAll();
-}
-
-void PermuteBatch<GPUBackend>::RunImpl(Workspace &ws) {
-  auto &input = ws.Input<GPUBackend>(0);
-  auto &output = ws.Output<GPUBackend>(0);
-
-  output.SetLayout(input.GetLayout());
-  int N = indices_.size();
-  for (int i = 0; i < N; i++)
-    output.SetMeta(i, input.GetMeta(indices_[i]));
-
-  const auto &out_shape = output.shape();
-  int element_size = output.type_info().size();
-
-  for (int i = 0; i < N; i++) {
-    auto size = out_shape.tensor_size(i) * element_size;
-    sg_.AddCopy(output.raw_mutable_tensor(i), input.raw_tensor(indices_[i]), size);
-  }
-  sg_.Run(ws.stream());
-}
+    DALI_INT_VEC, true)
+  .SamplewisePassThrough();
 
 DALI_REGISTER_OPERATOR(PermuteBatch, PermuteBatch<CPUBackend>, CPU);
 DALI_REGISTER_OPERATOR(PermuteBatch, PermuteBatch<GPUBackend>, GPU);
@@ -17,22 +17,24 @@
 
 #include <vector>
 #include "dali/pipeline/operator/checkpointing/stateless_operator.h"
-#include "dali/kernels/common/scatter_gather.h"
 
 namespace dali {
 
 template <typename Backend>
-class PermuteBatchBase : public StatelessOperator<Backend> {
+class PermuteBatch : public StatelessOperator<Backend> {
  public:
-  explicit PermuteBatchBase(const OpSpec &spec) : StatelessOperator<Backend>(spec) {
+  explicit PermuteBatch(const OpSpec &spec) : StatelessOperator<Backend>(spec) {
     has_indices_input_ = spec.HasTensorArgument("indices");
   }
 
+  bool HasContiguousOutputs() const override {
+    // The output samples are shared with the input ones, in any order.
+    return false;
+  }
+
   bool SetupImpl(vector<OutputDesc> &outputs, const Workspace &ws) override {
-    outputs.resize(1);
     auto &input = ws.Input<Backend>(0);
     const auto &in_shape = input.shape();
-    outputs[0].type = input.type();
 
     if (has_indices_input_) {
       auto &idx_in = ws.ArgumentInput("indices");
@@ -49,19 +51,29 @@ class PermuteBatchBase : public StatelessOperator<Backend> {
       "The number of sample indices ", indices_.size(), " does not match the current batch size, "
       "which is ", ws.GetRequestedBatchSize(0)));
 
-    auto &out_shape = outputs[0].shape;
-    int D = in_shape.sample_dim();
-    out_shape.resize(indices_.size(), D);
-    for (int i = 0; i < out_shape.num_samples(); i++) {
-      auto out_ts = out_shape.tensor_shape_span(i);
+    for (int i = 0; i < static_cast<int>(indices_.size()); i++) {
       DALI_ENFORCE(indices_[i] >= 0 && indices_[i] < in_shape.num_samples(), make_string(
         "Sample index out of range. indices[", i, "] = ", indices_[i], " is not a valid index for "
         "an input batch of ", in_shape.num_samples(), " tensors."));
-      auto in_ts = in_shape.tensor_shape_span(indices_[i]);
-      for (int d = 0; d < D; d++)
-        out_ts[d] = in_ts[d];
     }
-    return true;
+    // The samples are passed through - no allocation is necessary
+    return false;
+  }
+
+  void RunImpl(Workspace &ws) override {
+    auto &input = ws.Input<Backend>(0);
+    auto &output = ws.Output<Backend>(0);
+    output.Reset();
+    output.set_type(input.type());
+    output.set_sample_dim(input.shape().sample_dim());
+    output.SetLayout(input.GetLayout());
+    output.set_device_id(input.device_id());
+    output.set_pinned(input.is_pinned());
+    // The order is set by the executor, the rest is propagated from the input.
+    int N = indices_.size();
+    output.SetSize(N);
+    for (int i = 0; i < N; i++)
+      output.SetSample(i, input, indices_[i]);
   }
 
 
@@ -70,31 +82,6 @@ class PermuteBatchBase : public StatelessOperator<Backend> {
   bool has_indices_input_ = false;
 };
 
-template <class Backend>
-class PermuteBatch;
-
-template <>
-class PermuteBatch<CPUBackend> : public PermuteBatchBase<CPUBackend> {
- public:
-  using PermuteBatchBase::PermuteBatchBase;
-
-  void RunImpl(Workspace &ws) override;
-};
-
-template <>
-class PermuteBatch<GPUBackend> : public PermuteBatchBase<GPUBackend> {
- public:
-  explicit PermuteBatch(const OpSpec &spec)
-  : PermuteBatchBase<GPUBackend>(spec)
-  , sg_(1<<18) {}
-
-
-  void RunImpl(Workspace &ws) override;
-
- private:
-  kernels::ScatterGatherGPU sg_;
-};
-
 }  // namespace dali
 
 #endif  // DALI_OPERATORS_GENERIC_PERMUTE_BATCH_H_
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -18,6 +18,7 @@
 #include <vector>
 #include <algorithm>
 
+#include "dali/kernels/common/split_shape.h"
 #include "dali/kernels/kernel_manager.h"
 #include "dali/kernels/reduce/reduce_cpu.h"
 #include "dali/kernels/reduce/reduce_gpu.h"
@@ -91,20 +92,31 @@ class Reduce : public StatelessOperator<Backend>, AxesHelper {
     using Kernel = ReductionType<OutputType, InputType>;
     kmgr_.template Resize<Kernel>(num_threads);
 
-    for (int sample = 0; sample < in_view.num_samples(); sample++) {
-      int64_t priority = volume(in_view.shape.tensor_shape_span(sample));
-      thread_pool.AddWork(
-        [&, sample](int thread_id) {
-          auto in_sample_view = in_view[sample];
-          auto out_sample_view = out_view[sample];
-          kernels::KernelContext ctx;
-
-          kmgr_.Setup<Kernel>(
-            thread_id, ctx, out_sample_view, in_sample_view, make_cspan(axes_));
-          kmgr_.Run<Kernel>(thread_id, ctx);
-        },
-        priority);
+    // If the outermost dimension is not reduced, the samples can be split along it
+    int ndim = in_view.sample_dim();
+    bool split_outer = ndim > 0 && std::find(axes_.begin(), axes_.end(), 0) == axes_.end();
+    int nsamples = in_view.num_samples();
+    extents_.resize(nsamples);
+    costs_.resize(nsamples);
+    for (int sample = 0; sample < nsamples; sample++) {
+      extents_[sample] = split_outer ? in_view.shape.tensor_shape_span(sample)[0] : 1;
+      costs_[sample] = volume(in_view.shape.tensor_shape_span(sample));
     }
+
+    kernels::AddSampleRangeWork(thread_pool, make_cspan(extents_), make_cspan(costs_),
+      [&, split_outer](int thread_id, int sample, int64_t begin, int64_t end) {
+        auto in_sample_view = in_view[sample];
+        auto out_sample_view = out_view[sample];
+        if (split_outer) {
+          in_sample_view = OuterRange(in_sample_view, begin, end);
+          out_sample_view = OuterRange(out_sample_view, begin, end);
+        }
+        kernels::KernelContext ctx;
+
+        kmgr_.Setup<Kernel>(
+          thread_id, ctx, out_sample_view, in_sample_view, make_cspan(axes_));
+        kmgr_.Run<Kernel>(thread_id, ctx);
+      });
     thread_pool.RunAll();
   }
 
@@ -147,9 +159,20 @@ class Reduce : public StatelessOperator<Backend>, AxesHelper {
   DALIDataType output_type_ = DALI_NO_TYPE;
 
  private:
+  /** The slices [begin, end) of the outermost dimension of a tensor */
+  template <typename T>
+  static TensorView<StorageCPU, T> OuterRange(const TensorView<StorageCPU, T> &tv,
+                                              int64_t begin, int64_t end) {
+    auto shape = tv.shape;
+    int64_t stride = volume(shape.begin() + 1, shape.end());
+    shape[0] = end - begin;
+    return make_tensor_cpu(tv.data + begin * stride, shape);
+  }
+
   USE_OPERATOR_MEMBERS();
   bool keep_dims_;
   kernels::KernelManager kmgr_;
+  std::vector<int64_t> extents_, costs_;
 };
 
 
@@ -23,6 +23,7 @@ DALI_SCHEMA(Shapes)
     .NumOutput(1)
     .AllowSequences()
     .SupportVolumetric()
+    .Stateless()
     .AddOptionalTypeArg("dtype", "Data type to which the sizes are converted.", DALI_INT64)
     .DeprecateArgInFavorOf("type", "dtype");  // deprecated since 0.27dev
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2022, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <vector>
 #include "dali/kernels/transpose/transpose.h"
+#include "dali/kernels/common/split_shape.h"
 #include "dali/core/static_switch.h"
 #include "dali/core/tensor_layout.h"
 #include "dali/operators/generic/transpose/transpose.h"
@@ -41,20 +43,29 @@ class TransposeCPU : public Transpose<CPUBackend> {
     int nsamples = out_shape.num_samples();
 
     TYPE_SWITCH(input_type, type2id, T, TRANSPOSE_ALLOWED_TYPES, (
+      std::vector<kernels::TiledTranspose<T>> transposes(nsamples);
+      extents_.resize(nsamples);
+      costs_.resize(nsamples);
       for (int i = 0; i < nsamples; i++) {
-        thread_pool.AddWork(
-          [this, &input, &output, i](int thread_id) {
-            TensorShape<> src_ts = input.shape()[i];
-
-            auto dst_ts = permute(src_ts, perm_);
-            kernels::TransposeGrouped(
-                TensorView<StorageCPU, T>{output.mutable_tensor<T>(i), dst_ts},
-                TensorView<StorageCPU, const T>{input.tensor<T>(i), src_ts}, make_cspan(perm_));
-          }, out_shape.tensor_size(i));
+        transposes[i] = kernels::TiledTranspose<T>(output.mutable_tensor<T>(i),
+                                                   input.tensor<T>(i), input.shape()[i],
+                                                   make_cspan(perm_));
+        extents_[i] = transposes[i].NumBlocks();
+        costs_[i] = out_shape.tensor_size(i) * sizeof(T);
       }
+      // the large samples (e.g. the volumes in small batches) are split between the threads
+      kernels::AddSampleRangeWork(thread_pool, make_cspan(extents_), make_cspan(costs_),
+        [&transposes](int thread_id, int i, int64_t begin, int64_t end) {
+          transposes[i].Run(begin, end);
+        }, kMinTaskBytes);
+      thread_pool.RunAll();
     ), DALI_FAIL(make_string("Unsupported input type: ", input_type)));  // NOLINT
-    thread_pool.RunAll();
   }
+
+ private:
+  /** The minimum size of the part of a sample processed in one task */
+  static constexpr int64_t kMinTaskBytes = 1 << 20;
+  std::vector<int64_t> extents_, costs_;
 };
 
 DALI_REGISTER_OPERATOR(Transpose, TransposeCPU, CPU);
@@ -81,6 +92,7 @@ for all valid coordinates.
     .NumOutput(1)
     .AllowSequences()
     .SupportVolumetric()
+    .Stateless()
     .AddOptionalArg<std::vector<int>>("perm",
         R"code(Permutation of the dimensions of the input, for example, [2, 0, 1].
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,12 +13,17 @@
 // limitations under the License.
 
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include "dali/core/format.h"
 #include "dali/core/geom/mat.h"
+#include "dali/core/small_vector.h"
 #include "dali/core/static_switch.h"
+#include "dali/kernels/dynamic_scratchpad.h"
 #include "dali/kernels/kernel_manager.h"
+#include "dali/operators/geometry/affine_transforms/transform_gpu.h"
 #include "dali/pipeline/data/types.h"
 #include "dali/pipeline/operator/checkpointing/stateless_operator.h"
 #include "dali/pipeline/operator/op_spec.h"
@@ -50,10 +55,11 @@ Example: combining [T1, T2, T3] is equivalent to T3(T2(T1(...))) for default ord
   .AllowSequences()
   .AddParent("TransformAttr");
 
-class CombineTransformsCPU : public SequenceOperator<CPUBackend, StatelessOperator> {
+template <typename Backend>
+class CombineTransforms : public SequenceOperator<Backend, StatelessOperator> {
  public:
-  using Base = SequenceOperator<CPUBackend, StatelessOperator>;
-  explicit CombineTransformsCPU(const OpSpec &spec) :
+  using Base = SequenceOperator<Backend, StatelessOperator>;
+  explicit CombineTransforms(const OpSpec &spec) :
       Base(spec),
       reverse_order_(spec.GetArgument<bool>("reverse_order")) {
   }
@@ -63,7 +69,7 @@ class CombineTransformsCPU : public SequenceOperator<CPUBackend, StatelessOperat
   bool SetupImpl(std::vector<OutputDesc> &output_descs,
                  const Workspace &ws) override {
     assert(ws.NumInput() > 1);
-    TensorListShape<> in0_shape = ws.Input<CPUBackend>(0).shape();
+    TensorListShape<> in0_shape = ws.Input<Backend>(0).shape();
     ndim_ = in0_shape[0][0];
     nsamples_ = in0_shape.size();
 
@@ -75,7 +81,7 @@ class CombineTransformsCPU : public SequenceOperator<CPUBackend, StatelessOperat
         "(ndim, ndim+1) representing an affine transform. Got: ", in0_shape));
 
     for (int i = 0; i < ws.NumInput(); i++) {
-      const auto &shape = ws.Input<CPUBackend>(i).shape();
+      const auto &shape = ws.Input<Backend>(i).shape();
       DALI_ENFORCE(shape == in0_shape,
         make_string("All input transforms are expected to have the same shape. Got: ",
                     in0_shape, " and ", shape, " for the ", i, "-th input."));
@@ -99,9 +105,19 @@ class CombineTransformsCPU : public SequenceOperator<CPUBackend, StatelessOperat
       return;
     }
 
+    auto &out = ws.Output<Backend>(0);
+    out.SetLayout({});  // no layout
+    if constexpr (std::is_same_v<Backend, GPUBackend>) {
+      RunGPU<T, ndim>(ws);
+    } else {
+      RunCPU<T, ndim>(ws);
+    }
+  }
+
+  template <typename T, int ndim>
+  void RunCPU(Workspace &ws) {
     constexpr int mat_dim = ndim + 1;
     auto &out = ws.Output<CPUBackend>(0);
-    out.SetLayout({});  // no layout
 
     SmallVector<TensorListView<StorageCPU, const T, 2>, 64> in_views;
     assert(ws.NumInput() > 1);
@@ -148,6 +164,31 @@ class CombineTransformsCPU : public SequenceOperator<CPUBackend, StatelessOperat
     }
   }
 
+  template <typename T, int ndim>
+  void RunGPU(Workspace &ws) {
+    cudaStream_t stream = ws.stream();
+    kernels::DynamicScratchpad scratchpad({}, AccessOrder(stream));
+    int ninputs = ws.NumInput();
+    SmallVector<const T *, 256> in_ptrs;
+    in_ptrs.resize(ninputs * nsamples_);
+    for (int input_idx = 0; input_idx < ninputs; input_idx++) {
+      auto in_view = view<const T>(ws.Input<GPUBackend>(input_idx));
+      for (int sample_idx = 0; sample_idx < nsamples_; sample_idx++)
+        in_ptrs[input_idx * nsamples_ + sample_idx] = in_view[sample_idx].data;
+    }
+    auto out_view = view<T>(ws.Output<GPUBackend>(0));
+    SmallVector<T *, 64> out_ptrs;
+    out_ptrs.resize(nsamples_);
+    for (int sample_idx = 0; sample_idx < nsamples_; sample_idx++)
+      out_ptrs[sample_idx] = out_view[sample_idx].data;
+
+    T **out_gpu;
+    const T **in_gpu;
+    std::tie(out_gpu, in_gpu) = scratchpad.ToContiguousGPU(stream, out_ptrs, in_ptrs);
+    transforms::CombineTransformsGPU<T, ndim>(out_gpu, in_gpu, ninputs, nsamples_,
+                                              reverse_order_, stream);
+  }
+
   void RunImpl(Workspace &ws) override {
     TYPE_SWITCH(dtype_, type2id, T, TRANSFORM_INPUT_TYPES, (
       RunImplTyped<T>(ws, SupportedDims());
@@ -156,7 +197,7 @@ class CombineTransformsCPU : public SequenceOperator<CPUBackend, StatelessOperat
 
   void PostprocessOutputs(Workspace &ws) override {
     if (this->IsExpanding()) {
-      auto &out = ws.Output<CPUBackend>(0);
+      auto &out = ws.Output<Backend>(0);
       int sample_dim = out.sample_dim();
       assert(sample_dim > 0);
       TensorLayout layout;
@@ -174,6 +215,7 @@ class CombineTransformsCPU : public SequenceOperator<CPUBackend, StatelessOperat
   bool reverse_order_ = false;
 };
 
-DALI_REGISTER_OPERATOR(transforms__Combine, CombineTransformsCPU, CPU);
+DALI_REGISTER_OPERATOR(transforms__Combine, CombineTransforms<CPUBackend>, CPU);
+DALI_REGISTER_OPERATOR(transforms__Combine, CombineTransforms<GPUBackend>, GPU);
 
 }  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,13 +16,18 @@
 #define DALI_OPERATORS_GEOMETRY_AFFINE_TRANSFORMS_TRANSFORM_BASE_OP_H_
 
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include "dali/core/error_handling.h"
 #include "dali/core/format.h"
 #include "dali/core/geom/mat.h"
+#include "dali/core/small_vector.h"
 #include "dali/core/static_switch.h"
+#include "dali/kernels/dynamic_scratchpad.h"
 #include "dali/kernels/kernel_manager.h"
+#include "dali/operators/geometry/affine_transforms/transform_gpu.h"
 #include "dali/pipeline/data/types.h"
 #include "dali/pipeline/operator/arg_helper.h"
 #include "dali/pipeline/operator/op_spec.h"
@@ -44,6 +49,10 @@ using affine_mat_t = mat<mat_dim, mat_dim, T>;
  * @brief Base CRTP class for affine transform generators.
  * The matrix definition comes from the actual TransformImpl implementation.
  * As with any CRTP-based system, any non-private method can be shadowed by the TransformImpl class.
+ *
+ * The matrices are always defined on the host, from the arguments. The GPU variant uploads them
+ * and combines them with the input transforms (if any) in a kernel, so that a chain of transforms
+ * whose first element has a GPU input doesn't go through the host.
  */
 template <typename Backend, typename TransformImpl>
 class TransformBaseOp : public SequenceOperator<Backend, StatelessOperator, true> {
@@ -121,18 +130,22 @@ class TransformBaseOp : public SequenceOperator<Backend, StatelessOperator, true
         reinterpret_cast<affine_mat_t<T, mat_dim> *>(matrix_data_.mutable_data<T>()), num_mats};
     This().DefineTransforms(matrices);
 
-    auto out_view = view<T>(out);
-    if (has_input_) {
-      auto &in = ws.Input<Backend>(0);
-      auto in_view = view<const T>(in);
-      for (int i = 0; i < nsamples_; i++) {
-        int mat_idx = num_mats == 1 ? 0 : i;
-        ApplyTransform(out_view[i].data, in_view[i].data, matrices[mat_idx]);
-      }
+    if constexpr (std::is_same_v<Backend, GPUBackend>) {
+      ApplyTransformsGPU<T, mat_dim>(ws, matrices);
     } else {
-      for (int i = 0; i < nsamples_; i++) {
-        int mat_idx = num_mats == 1 ? 0 : i;
-        ApplyTransform(out_view[i].data, matrices[mat_idx]);
+      auto out_view = view<T>(out);
+      if (has_input_) {
+        auto &in = ws.Input<Backend>(0);
+        auto in_view = view<const T>(in);
+        for (int i = 0; i < nsamples_; i++) {
+          int mat_idx = num_mats == 1 ? 0 : i;
+          ApplyTransform(out_view[i].data, in_view[i].data, matrices[mat_idx]);
+        }
+      } else {
+        for (int i = 0; i < nsamples_; i++) {
+          int mat_idx = num_mats == 1 ? 0 : i;
+          ApplyTransform(out_view[i].data, matrices[mat_idx]);
+        }
       }
     }
   }
@@ -166,6 +179,35 @@ class TransformBaseOp : public SequenceOperator<Backend, StatelessOperator, true
   }
 
  private:
+  template <typename T, int mat_dim>
+  void ApplyTransformsGPU(Workspace &ws, span<affine_mat_t<T, mat_dim>> matrices) {
+    constexpr int ndim = mat_dim - 1;
+    cudaStream_t stream = ws.stream();
+    kernels::DynamicScratchpad scratchpad({}, AccessOrder(stream));
+    auto out_view = view<T>(ws.Output<GPUBackend>(0));
+    SmallVector<T *, 64> out_ptrs;
+    out_ptrs.resize(nsamples_);
+    for (int i = 0; i < nsamples_; i++)
+      out_ptrs[i] = out_view[i].data;
+
+    T **out_gpu = nullptr;
+    const T **in_gpu = nullptr;
+    affine_mat_t<T, mat_dim> *mats_gpu = nullptr;
+    if (has_input_) {
+      auto in_view = view<const T>(ws.Input<GPUBackend>(0));
+      SmallVector<const T *, 64> in_ptrs;
+      in_ptrs.resize(nsamples_);
+      for (int i = 0; i < nsamples_; i++)
+        in_ptrs[i] = in_view[i].data;
+      std::tie(out_gpu, in_gpu, mats_gpu) =
+          scratchpad.ToContiguousGPU(stream, out_ptrs, in_ptrs, matrices);
+    } else {
+      std::tie(out_gpu, mats_gpu) = scratchpad.ToContiguousGPU(stream, out_ptrs, matrices);
+    }
+    transforms::ApplyTransformsGPU<T, ndim>(out_gpu, in_gpu, mats_gpu, matrices.size(),
+                                            nsamples_, reverse_order_, stream);
+  }
+
   template <typename T, int mat_dim>
   void ApplyTransform(T *transform_out, const affine_mat_t<T, mat_dim> &M) {
     constexpr int ndim = mat_dim - 1;
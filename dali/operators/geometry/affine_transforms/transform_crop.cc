@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -76,13 +76,17 @@ If another transform matrix is passed as an input, the operator applies the tran
 /**
  * @brief Scale transformation.
  */
-class TransformCropCPU
-    : public TransformBaseOp<CPUBackend, TransformCropCPU> {
+template <typename Backend>
+class TransformCrop
+    : public TransformBaseOp<Backend, TransformCrop<Backend>> {
  public:
+  using Base = TransformBaseOp<Backend, TransformCrop<Backend>>;
+  using Base::ndim_;
+  using Base::nsamples_;
   using SupportedDims = dims<1, 2, 3, 4, 5, 6>;
 
-  explicit TransformCropCPU(const OpSpec &spec) :
-      TransformBaseOp<CPUBackend, TransformCropCPU>(spec),
+  explicit TransformCrop(const OpSpec &spec) :
+      Base(spec),
       from_start_("from_start", spec),
       from_end_("from_end", spec),
       to_start_("to_start", spec),
@@ -152,6 +156,7 @@ class TransformCropCPU
   bool absolute_ = false;
 };
 
-DALI_REGISTER_OPERATOR(transforms__Crop, TransformCropCPU, CPU);
+DALI_REGISTER_OPERATOR(transforms__Crop, TransformCrop<CPUBackend>, CPU);
+DALI_REGISTER_OPERATOR(transforms__Crop, TransformCrop<GPUBackend>, GPU);
 
 }  // namespace dali
@@ -0,0 +1,114 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include "dali/core/cuda_error.h"
+#include "dali/core/util.h"
+#include "dali/operators/geometry/affine_transforms/transform_gpu.h"
+
+namespace dali {
+namespace transforms {
+
+namespace {
+
+template <int ndim, typename T>
+__device__ mat<ndim + 1, ndim + 1, T> LoadTransform(const T *data) {
+  auto m = mat<ndim + 1, ndim + 1, T>::identity();
+  for (int i = 0, k = 0; i < ndim; i++)
+    for (int j = 0; j < ndim + 1; j++, k++)
+      m(i, j) = data[k];
+  return m;
+}
+
+template <int ndim, typename T>
+__device__ void StoreTransform(T *data, const mat<ndim + 1, ndim + 1, T> &m) {
+  for (int i = 0, k = 0; i < ndim; i++)
+    for (int j = 0; j < ndim + 1; j++, k++)
+      data[k] = m(i, j);
+}
+
+template <typename T, int ndim>
+__global__ void ApplyTransformsKernel(T *const *out, const T *const *in,
+                                      const mat<ndim + 1, ndim + 1, T> *mats, int num_mats,
+                                      int nsamples, bool reverse) {
+  for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < nsamples; i += blockDim.x * gridDim.x) {
+    auto m = mats[num_mats == 1 ? 0 : i];
+    if (in) {
+      auto in_mat = LoadTransform<ndim>(in[i]);
+      m = reverse ? in_mat * m : m * in_mat;
+    }
+    StoreTransform<ndim>(out[i], m);
+  }
+}
+
+template <typename T, int ndim>
+__global__ void CombineTransformsKernel(T *const *out, const T *const *in, int num_inputs,
+                                        int nsamples, bool reverse) {
+  for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < nsamples; i += blockDim.x * gridDim.x) {
+    auto m = LoadTransform<ndim>(in[i]);
+    for (int input_idx = 1; input_idx < num_inputs; input_idx++) {
+      auto next = LoadTransform<ndim>(in[input_idx * nsamples + i]);
+      m = reverse ? m * next : next * m;
+    }
+    StoreTransform<ndim>(out[i], m);
+  }
+}
+
+constexpr int kBlockSize = 256;
+
+}  // namespace
+
+template <typename T, int ndim>
+void ApplyTransformsGPU(T *const *out, const T *const *in,
+                        const mat<ndim + 1, ndim + 1, T> *mats, int num_mats, int nsamples,
+                        bool reverse, cudaStream_t stream) {
+  if (nsamples == 0)
+    return;
+  int blocks = div_ceil(nsamples, kBlockSize);
+  int threads = std::min(nsamples, kBlockSize);
+  ApplyTransformsKernel<T, ndim><<<blocks, threads, 0, stream>>>(
+      out, in, mats, num_mats, nsamples, reverse);
+  CUDA_CALL(cudaGetLastError());
+}
+
+template <typename T, int ndim>
+void CombineTransformsGPU(T *const *out, const T *const *in, int num_inputs, int nsamples,
+                          bool reverse, cudaStream_t stream) {
+  if (nsamples == 0)
+    return;
+  int blocks = div_ceil(nsamples, kBlockSize);
+  int threads = std::min(nsamples, kBlockSize);
+  CombineTransformsKernel<T, ndim><<<blocks, threads, 0, stream>>>(
+      out, in, num_inputs, nsamples, reverse);
+  CUDA_CALL(cudaGetLastError());
+}
+
+#define INSTANTIATE_TRANSFORMS_GPU(ndim)                                                     \
+  template void ApplyTransformsGPU<float, ndim>(float *const *, const float *const *,       \
+                                                const mat<ndim + 1, ndim + 1, float> *, int, \
+                                                int, bool, cudaStream_t);                    \
+  template void CombineTransformsGPU<float, ndim>(float *const *, const float *const *, int, \
+                                                  int, bool, cudaStream_t);
+
+INSTANTIATE_TRANSFORMS_GPU(1)
+INSTANTIATE_TRANSFORMS_GPU(2)
+INSTANTIATE_TRANSFORMS_GPU(3)
+INSTANTIATE_TRANSFORMS_GPU(4)
+INSTANTIATE_TRANSFORMS_GPU(5)
+INSTANTIATE_TRANSFORMS_GPU(6)
+
+#undef INSTANTIATE_TRANSFORMS_GPU
+
+}  // namespace transforms
+}  // namespace dali
@@ -0,0 +1,57 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_GEOMETRY_AFFINE_TRANSFORMS_TRANSFORM_GPU_H_
+#define DALI_OPERATORS_GEOMETRY_AFFINE_TRANSFORMS_TRANSFORM_GPU_H_
+
+#include <cuda_runtime_api.h>
+#include "dali/core/geom/mat.h"
+
+namespace dali {
+namespace transforms {
+
+/**
+ * @brief Writes the transforms of the operator to the output, optionally combined with the input.
+ *
+ * The transforms are stored as row-major ndim x (ndim + 1) tensors - the last row of the
+ * homogeneous matrix is omitted.
+ *
+ * @param out       output transforms, one pointer per sample (device memory)
+ * @param in        input transforms, one pointer per sample (device memory); can be null
+ * @param mats      the transforms of the operator (device memory)
+ * @param num_mats  the number of matrices in `mats` - 1 (used for all samples) or `nsamples`
+ * @param reverse   if true, the result is `in * mat`; otherwise it's `mat * in`
+ */
+template <typename T, int ndim>
+void ApplyTransformsGPU(T *const *out, const T *const *in,
+                        const mat<ndim + 1, ndim + 1, T> *mats, int num_mats, int nsamples,
+                        bool reverse, cudaStream_t stream);
+
+/**
+ * @brief Combines `num_inputs` transforms of each sample.
+ *
+ * @param out     output transforms, one pointer per sample (device memory)
+ * @param in      input transforms, `num_inputs * nsamples` pointers, grouped by input
+ *                (device memory)
+ * @param reverse if true, the transforms are multiplied in the order of the inputs;
+ *                otherwise, in the reverse order
+ */
+template <typename T, int ndim>
+void CombineTransformsGPU(T *const *out, const T *const *in, int num_inputs, int nsamples,
+                          bool reverse, cudaStream_t stream);
+
+}  // namespace transforms
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_GEOMETRY_AFFINE_TRANSFORMS_TRANSFORM_GPU_H_
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -55,13 +55,17 @@ If provided, the number of elements should match the dimensionality of the trans
 /**
  * @brief Rotate transformation.
  */
-class TransformRotationCPU
-    : public TransformBaseOp<CPUBackend, TransformRotationCPU> {
+template <typename Backend>
+class TransformRotation
+    : public TransformBaseOp<Backend, TransformRotation<Backend>> {
  public:
+  using Base = TransformBaseOp<Backend, TransformRotation<Backend>>;
+  using Base::ndim_;
+  using Base::nsamples_;
   using SupportedDims = dims<2, 3>;
 
-  explicit TransformRotationCPU(const OpSpec &spec) :
-      TransformBaseOp<CPUBackend, TransformRotationCPU>(spec),
+  explicit TransformRotation(const OpSpec &spec) :
+      Base(spec),
       angle_("angle", spec),
       axis_("axis", spec),
       center_("center", spec) {
@@ -129,6 +133,7 @@ class TransformRotationCPU
   ArgValue<float, 1> center_;
 };
 
-DALI_REGISTER_OPERATOR(transforms__Rotation, TransformRotationCPU, CPU);
+DALI_REGISTER_OPERATOR(transforms__Rotation, TransformRotation<CPUBackend>, CPU);
+DALI_REGISTER_OPERATOR(transforms__Rotation, TransformRotation<GPUBackend>, GPU);
 
 }  // namespace dali
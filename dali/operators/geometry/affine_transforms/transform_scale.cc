@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -53,13 +53,19 @@ when `scale` is a scalar value and there's no input transform.
 /**
  * @brief Scale transformation.
  */
-class TransformScaleCPU
-    : public TransformBaseOp<CPUBackend, TransformScaleCPU> {
+template <typename Backend>
+class TransformScale
+    : public TransformBaseOp<Backend, TransformScale<Backend>> {
  public:
+  using Base = TransformBaseOp<Backend, TransformScale<Backend>>;
+  using Base::has_input_;
+  using Base::input_transform_ndim;
+  using Base::ndim_;
+  using Base::nsamples_;
   using SupportedDims = dims<1, 2, 3, 4, 5, 6>;
 
-  explicit TransformScaleCPU(const OpSpec &spec) :
-      TransformBaseOp<CPUBackend, TransformScaleCPU>(spec),
+  explicit TransformScale(const OpSpec &spec) :
+      Base(spec),
       scale_("scale", spec),
       center_("center", spec) {
     assert(scale_.HasExplicitValue());
@@ -119,6 +125,7 @@ class TransformScaleCPU
   int ndim_arg_ = -1;
 };
 
-DALI_REGISTER_OPERATOR(transforms__Scale, TransformScaleCPU, CPU);
+DALI_REGISTER_OPERATOR(transforms__Scale, TransformScale<CPUBackend>, CPU);
+DALI_REGISTER_OPERATOR(transforms__Scale, TransformScale<GPUBackend>, GPU);
 
 }  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -77,13 +77,17 @@ If provided, the number of elements should match the dimensionality of the trans
 /**
  * @brief Scale transformation.
  */
-class TransformShearCPU
-    : public TransformBaseOp<CPUBackend, TransformShearCPU> {
+template <typename Backend>
+class TransformShear
+    : public TransformBaseOp<Backend, TransformShear<Backend>> {
  public:
+  using Base = TransformBaseOp<Backend, TransformShear<Backend>>;
+  using Base::ndim_;
+  using Base::nsamples_;
   using SupportedDims = dims<2, 3>;
 
-  explicit TransformShearCPU(const OpSpec &spec) :
-      TransformBaseOp<CPUBackend, TransformShearCPU>(spec),
+  explicit TransformShear(const OpSpec &spec) :
+      Base(spec),
       shear_("shear", spec),
       angles_("angles", spec),
       center_("center", spec) {
@@ -206,6 +210,7 @@ class TransformShearCPU
   ArgValue<float, 1> center_;
 };
 
-DALI_REGISTER_OPERATOR(transforms__Shear, TransformShearCPU, CPU);
+DALI_REGISTER_OPERATOR(transforms__Shear, TransformShear<CPUBackend>, CPU);
+DALI_REGISTER_OPERATOR(transforms__Shear, TransformShear<GPUBackend>, GPU);
 
 }  // namespace dali
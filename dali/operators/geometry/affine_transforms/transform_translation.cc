@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -59,13 +59,17 @@ The number of dimensions of the transform is inferred from this argument.)code",
 /**
  * @brief Translation transformation.
  */
-class TransformTranslationCPU
-    : public TransformBaseOp<CPUBackend, TransformTranslationCPU> {
+template <typename Backend>
+class TransformTranslation
+    : public TransformBaseOp<Backend, TransformTranslation<Backend>> {
  public:
+  using Base = TransformBaseOp<Backend, TransformTranslation<Backend>>;
+  using Base::ndim_;
+  using Base::nsamples_;
   using SupportedDims = dims<1, 2, 3, 4, 5, 6>;
 
-  explicit TransformTranslationCPU(const OpSpec &spec) :
-      TransformBaseOp<CPUBackend, TransformTranslationCPU>(spec),
+  explicit TransformTranslation(const OpSpec &spec) :
+      Base(spec),
       offset_("offset", spec) {}
 
   template <typename T, int mat_dim>
@@ -97,7 +101,8 @@ class TransformTranslationCPU
   ArgValue<float, 1> offset_;
 };
 
-DALI_REGISTER_OPERATOR(transforms__Translation, TransformTranslationCPU, CPU);
-DALI_REGISTER_OPERATOR(TransformTranslation, TransformTranslationCPU, CPU);
+DALI_REGISTER_OPERATOR(transforms__Translation, TransformTranslation<CPUBackend>, CPU);
+DALI_REGISTER_OPERATOR(transforms__Translation, TransformTranslation<GPUBackend>, GPU);
+DALI_REGISTER_OPERATOR(TransformTranslation, TransformTranslation<CPUBackend>, CPU);
 
 }  // namespace dali
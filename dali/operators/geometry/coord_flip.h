@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 
+#include "dali/pipeline/operator/arg_helper.h"
 #include "dali/pipeline/operator/common.h"
 #include "dali/pipeline/operator/checkpointing/stateless_operator.h"
 #include "dali/pipeline/operator/operator.h"
@@ -29,7 +30,9 @@ class CoordFlip : public StatelessOperator<Backend> {
  public:
   explicit CoordFlip(const OpSpec &spec)
       : StatelessOperator<Backend>(spec)
-      , layout_(spec.GetArgument<TensorLayout>("layout")) {}
+      , layout_(spec.GetArgument<TensorLayout>("layout"))
+      , flip_x_("flip_x", spec), flip_y_("flip_y", spec), flip_z_("flip_z", spec)
+      , center_x_("center_x", spec), center_y_("center_y", spec), center_z_("center_z", spec) {}
 
   ~CoordFlip() override = default;
   DISABLE_COPY_MOVE_ASSIGN(CoordFlip);
@@ -97,6 +100,8 @@ class CoordFlip : public StatelessOperator<Backend> {
   int ndim_ = -1;
   // Indices of x, y and z dimensions
   int x_dim_ = -1, y_dim_ = -1, z_dim_ = -1;
+  ArgHandle<int> flip_x_, flip_y_, flip_z_;
+  ArgHandle<float> center_x_, center_y_, center_z_;
 };
 
 }  // namespace dali
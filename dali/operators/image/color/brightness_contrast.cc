@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -44,7 +44,8 @@ the type.)code",
 If not set, the input type is used.)code")
     .AllowSequences()
     .SupportVolumetric()
-    .InputLayout({"FHWC", "DHWC", "HWC"});
+    .InputLayout({"FHWC", "DHWC", "HWC"})
+    .AddParent("RandomArgsAttr");
 
 DALI_SCHEMA(Contrast)
     .DocStr(R"code(Adjusts the contrast of the images.
@@ -70,7 +71,8 @@ the half of the input type's positive range (or 0.5 for ``float``) is used.)code
 If not set, the input type is used.)code")
     .AllowSequences()
     .SupportVolumetric()
-    .InputLayout({"FHWC", "DHWC", "HWC"});
+    .InputLayout({"FHWC", "DHWC", "HWC"})
+    .AddParent("RandomArgsAttr");
 
 DALI_SCHEMA(BrightnessContrast)
     .AddParent("Brightness")
@@ -89,7 +91,8 @@ This operator can also change the type of data.)code")
     .NumOutput(1)
     .AllowSequences()
     .SupportVolumetric()
-    .InputLayout({"FHWC", "DHWC", "HWC"});
+    .InputLayout({"FHWC", "DHWC", "HWC"})
+    .AddParent("RandomArgsAttr");
 
 DALI_REGISTER_OPERATOR(BrightnessContrast, BrightnessContrastCpu, CPU)
 DALI_REGISTER_OPERATOR(Brightness, BrightnessContrastCpu, CPU);
@@ -103,28 +106,36 @@ void BrightnessContrastCpu::RunImplHelper(Workspace &ws) {
   output.SetLayout(input.GetLayout());
   auto& tp = ws.GetThreadPool();
   int num_samples = input.num_samples();
-  const auto &contrast_center = GetContrastCenter<InputType>(ws, num_samples);
+  const auto &contrast_center = GetContrastCenter<InputType>(ws);
+  // for sequences, the planes are the frames - otherwise, they share the sample's parameters
+  const auto &frames = this->GetInputExpandDesc(0);
+  bool per_plane = frames.ExpandFrames();
 
   using Kernel = kernels::MultiplyAddCpu<OutputType, InputType, 3>;
   kernel_manager_.template Resize<Kernel>(1);
 
   auto in_view = view<const InputType, ndim>(input);
   auto out_view = view<OutputType, ndim>(output);
+  int64_t frame_idx = 0;
   for (int sample_id = 0; sample_id < num_samples; sample_id++) {
-    float add, mul;
-    OpArgsToKernelArgs<OutputType, InputType>(add, mul, brightness_[sample_id],
-                                              brightness_shift_[sample_id], contrast_[sample_id],
-                                              contrast_center[sample_id]);
     auto planes_range =
         sequence_utils::unfolded_views_range<ndim - 3>(out_view[sample_id], in_view[sample_id]);
     const auto &in_range = planes_range.template get<1>();
+    int64_t idx = frame_idx;
     for (auto &&views : planes_range) {
+      float add, mul;
+      OpArgsToKernelArgs<OutputType, InputType>(add, mul, brightness_[idx],
+                                                brightness_shift_[idx], contrast_[idx],
+                                                contrast_center[idx]);
       tp.AddWork([&, views, add, mul](int thread_id) {
           kernels::KernelContext ctx;
           auto &[tvout, tvin] = views;
           kernel_manager_.Run<Kernel>(0, ctx, tvout, tvin, add, mul);
         }, in_range.SliceSize());
+      if (per_plane)
+        idx++;
     }
+    frame_idx += frames.NumExpanded(sample_id);
   }
   tp.RunAll();
 }
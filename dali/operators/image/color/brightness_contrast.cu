@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "dali/operators/image/color/brightness_contrast.h"
+#include <utility>
 #include <vector>
 #include "dali/kernels/imgproc/pointwise/multiply_add_gpu.h"
 
@@ -29,20 +30,53 @@ void BrightnessContrastGpu::RunImplHelper(Workspace &ws) {
   output.SetLayout(input.GetLayout());
   auto sh = input.shape();
   int num_samples = input.num_samples();
-  const auto &contrast_center = GetContrastCenter<InputType>(ws, num_samples);
+  const auto &contrast_center = GetContrastCenter<InputType>(ws);
   auto num_dims = sh.sample_dim();
 
-  addends_.resize(num_samples);
-  multipliers_.resize(num_samples);
+  // With per-frame arguments, the frames of the sequences are passed to the kernel as separate
+  // samples; otherwise, the outer dimensions are collapsed and the samples are processed whole.
+  const auto &frames = this->GetInputExpandDesc(0);
+  bool per_frame = frames.ExpandFrames() && this->HasPerFrameArgInputs(ws);
+  int64_t frame_idx = 0;
+  addends_.clear();
+  multipliers_.clear();
   for (int i = 0; i < num_samples; i++) {
-    OpArgsToKernelArgs<OutputType, InputType>(addends_[i], multipliers_[i], brightness_[i],
-                                              brightness_shift_[i], contrast_[i],
-                                              contrast_center[i]);
+    int64_t num_frames = frames.NumExpanded(i);
+    for (int64_t f = 0; f < (per_frame ? num_frames : 1); f++) {
+      int64_t idx = frame_idx + f;
+      float add, mul;
+      OpArgsToKernelArgs<OutputType, InputType>(add, mul, brightness_[idx],
+                                                brightness_shift_[idx], contrast_[idx],
+                                                contrast_center[idx]);
+      addends_.push_back(add);
+      multipliers_.push_back(mul);
+    }
+    frame_idx += num_frames;
   }
 
   TensorListView<StorageGPU, const InputType, 3> tvin;
   TensorListView<StorageGPU, OutputType, 3> tvout;
-  if (num_dims == 4) {
+  if (per_frame) {
+    auto in_seq = view<const InputType, 4>(input);
+    auto out_seq = view<OutputType, 4>(output);
+    int num_frames = addends_.size();
+    TensorListShape<3> frame_shape;
+    frame_shape.resize(num_frames);
+    std::vector<const InputType *> in_frames(num_frames);
+    std::vector<OutputType *> out_frames(num_frames);
+    for (int i = 0, k = 0; i < num_samples; i++) {
+      auto sample_frame_shape = in_seq.shape[i].template last<3>();
+      int64_t frame_volume = volume(sample_frame_shape);
+      for (int64_t f = 0; f < in_seq.shape[i][0]; f++, k++) {
+        frame_shape.set_tensor_shape(k, sample_frame_shape);
+        in_frames[k] = in_seq.data[i] + f * frame_volume;
+        out_frames[k] = out_seq.data[i] + f * frame_volume;
+      }
+    }
+    tvin = TensorListView<StorageGPU, const InputType, 3>(std::move(in_frames), frame_shape);
+    tvout = TensorListView<StorageGPU, OutputType, 3>(std::move(out_frames),
+                                                      std::move(frame_shape));
+  } else if (num_dims == 4) {
     auto collapsed_sh = collapse_dim(view<const InputType, 4>(input).shape, 0);
     tvin = reinterpret<const InputType, 3>(view<const InputType, 4>(input), collapsed_sh, true);
     tvout = reinterpret<OutputType, 3>(view<OutputType, 4>(output), collapsed_sh, true);
@@ -56,7 +90,7 @@ void BrightnessContrastGpu::RunImplHelper(Workspace &ws) {
   ctx.gpu.stream = ws.stream();
   kernel_manager_.template Resize<Kernel>(1);
 
-  kernel_manager_.Setup<Kernel>(0, ctx, tvin, brightness_, contrast_);
+  kernel_manager_.Setup<Kernel>(0, ctx, tvin, addends_, multipliers_);
   kernel_manager_.Run<Kernel>(0, ctx, tvout, tvin, addends_, multipliers_);
 }
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -22,6 +22,7 @@
 #include "dali/core/format.h"
 #include "dali/core/static_switch.h"
 #include "dali/kernels/kernel_manager.h"
+#include "dali/operators/random/random_args.h"
 #include "dali/pipeline/data/views.h"
 #include "dali/pipeline/operator/checkpointing/stateless_operator.h"
 #include "dali/pipeline/operator/common.h"
@@ -64,15 +65,31 @@ class BrightnessContrastOp : public SequenceOperator<Backend, StatelessOperator>
 
  protected:
   explicit BrightnessContrastOp(const OpSpec &spec)
-      : Base(spec), output_type_(DALI_NO_TYPE), input_type_(DALI_NO_TYPE) {
+      : Base(spec), random_args_(spec), output_type_(DALI_NO_TYPE), input_type_(DALI_NO_TYPE) {
     spec.TryGetArgument(output_type_arg_, "dtype");
   }
 
-  // The operator needs 4 dim path for DHWC data, so use it to avoid inflating
-  // the number of samples and parameters unnecessarily for FHWC when there are no
-  // per-frame parameters provided.
+  void SaveState(OpCheckpoint &cpt, AccessOrder order) override {
+    random_args_.SaveState(cpt);
+  }
+
+  void RestoreState(const OpCheckpoint &cpt) override {
+    random_args_.RestoreState(cpt);
+  }
+
+  std::string SerializeCheckpoint(const OpCheckpoint &cpt) const override {
+    return random_args_.SerializeCheckpoint(cpt);
+  }
+
+  void DeserializeCheckpoint(OpCheckpoint &cpt, const std::string &data) const override {
+    random_args_.DeserializeCheckpoint(cpt, data);
+  }
+
+  // The arguments are gathered per frame and the frames are processed directly in the
+  // sequences, so the batch is never expanded - that would multiply the per-sample overhead
+  // by the number of frames.
   bool ShouldExpand(const Workspace &ws) override {
-    return Base::ShouldExpand(ws) && this->HasPerFrameArgInputs(ws);
+    return false;
   }
 
   template <typename OutputType, typename InputType>
@@ -93,44 +110,69 @@ class BrightnessContrastOp : public SequenceOperator<Backend, StatelessOperator>
     multiplier = brightness * contrast;
   }
 
-  void AcquireArguments(const Workspace &ws) {
-    auto curr_batch_size = ws.GetInputBatchSize(0);
-    if (this->spec_.ArgumentDefined("brightness")) {
-      this->GetPerSampleArgument(brightness_, "brightness", ws, curr_batch_size);
-    } else {
-      brightness_ = std::vector<float>(curr_batch_size, kDefaultBrightness);
+  /**
+   * @brief Gets the values of an argument for all the frames in the batch
+   *
+   * The random and the per-sample values are repeated for all the frames of a sample, while
+   * the per-frame tensor arguments are unfolded (or broadcast, if they contain a single frame).
+   * The samples that are not sequences count as a single frame.
+   */
+  void GetPerFrameArgument(std::vector<float> &out, const std::string &name,
+                           float default_value, const Workspace &ws) {
+    const auto &frames = this->GetInputExpandDesc(0);
+    int num_samples = frames.NumSamples();
+    if (random_args_.Has(name)) {
+      random_args_.Draw(out, name, frames.DimsToExpand());
+      return;
     }
-
-    if (this->spec_.ArgumentDefined("brightness_shift")) {
-      this->GetPerSampleArgument(brightness_shift_, "brightness_shift", ws, curr_batch_size);
-    } else {
-      brightness_shift_ = std::vector<float>(curr_batch_size, kDefaultBrightnessShift);
+    if (this->spec_.HasTensorArgument(name) && this->IsPerFrameArg(name, ws.ArgumentInput(name))) {
+      const auto &arg = ws.ArgumentInput(name);
+      DALI_ENFORCE(frames.ExpandFrames(), make_string(
+          "Tensor input for argument ", name, " is specified per frame (got ", arg.GetLayout(),
+          " layout). In that case, the input must contain frames too. Got layout `",
+          frames.Layout(), "` that does not contain frames."));
+      out.clear();
+      for (int i = 0; i < num_samples; i++) {
+        int64_t num_frames = frames.NumFrames(i);
+        int64_t num_arg_frames = arg.shape().tensor_size(i);
+        DALI_ENFORCE(num_arg_frames == 1 || num_arg_frames == num_frames, make_string(
+            "The sample ", i, " of tensor argument `", name, "` contains ", num_arg_frames,
+            " per-frame parameters, but there are ", num_frames,
+            " frames in the corresponding sample of the input. The numbers should match."));
+        const float *values = arg.template tensor<float>(i);
+        for (int64_t f = 0; f < num_frames; f++)
+          out.push_back(values[num_arg_frames == 1 ? 0 : f]);
+      }
+      return;
     }
+    if (this->spec_.ArgumentDefined(name))
+      this->GetPerSampleArgument(per_sample_arg_, name, ws, num_samples);
+    else
+      per_sample_arg_.assign(num_samples, default_value);
+    out.clear();
+    for (int i = 0; i < num_samples; i++)
+      out.resize(out.size() + frames.NumExpanded(i), per_sample_arg_[i]);
+  }
 
-    if (this->spec_.ArgumentDefined("contrast")) {
-      this->GetPerSampleArgument(contrast_, "contrast", ws, curr_batch_size);
-    } else {
-      contrast_ = std::vector<float>(curr_batch_size, kDefaultContrast);
-    }
+  void AcquireArguments(const Workspace &ws) {
+    GetPerFrameArgument(brightness_, "brightness", kDefaultBrightness, ws);
+    GetPerFrameArgument(brightness_shift_, "brightness_shift", kDefaultBrightnessShift, ws);
+    GetPerFrameArgument(contrast_, "contrast", kDefaultContrast, ws);
 
     input_type_ = ws.Input<Backend>(0).type();
     output_type_ = output_type_arg_ != DALI_NO_TYPE ? output_type_arg_ : input_type_;
   }
 
   template <typename InputType>
-  const vector<float> &GetContrastCenter(const Workspace &ws, int num_samples) {
-    if (this->spec_.ArgumentDefined("contrast_center")) {
-      this->GetPerSampleArgument(contrast_center_, "contrast_center", ws, num_samples);
-    } else {
-      // argument cannot stop being defined in a built pipeline,
-      // so just fill in missing samples if needed
-      contrast_center_.resize(num_samples, brightness_contrast::HalfRange<InputType>());
-    }
+  const vector<float> &GetContrastCenter(const Workspace &ws) {
+    GetPerFrameArgument(contrast_center_, "contrast_center",
+                        brightness_contrast::HalfRange<InputType>(), ws);
     return contrast_center_;
   }
 
   bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override {
     const auto &input = ws.Input<Backend>(0);
+    random_args_.Advance();
     AcquireArguments(ws);
 
     auto sh = input.shape();
@@ -142,7 +184,10 @@ class BrightnessContrastOp : public SequenceOperator<Backend, StatelessOperator>
   }
 
   USE_OPERATOR_MEMBERS();
+  RandomArgs random_args_;
+  // the arguments, per frame
   std::vector<float> brightness_, brightness_shift_, contrast_, contrast_center_;
+  std::vector<float> per_sample_arg_;
   DALIDataType output_type_arg_ = DALI_NO_TYPE;
   DALIDataType output_type_ = DALI_NO_TYPE;
   DALIDataType input_type_ = DALI_NO_TYPE;
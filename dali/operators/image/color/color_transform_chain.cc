@@ -0,0 +1,166 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/image/color/color_transform_chain.h"
+#include "dali/operators/image/color/brightness_contrast.h"
+#include "dali/operators/image/color/color_twist.h"
+
+namespace dali {
+
+#define COLOR_TRANSFORM_STAGE_ARGS(stage)                                                 \
+    AddOptionalArg("hue_" #stage, "Hue change of the stage " #stage ", in degrees.",     \
+                   0.f, true, true)                                                      \
+    .AddOptionalArg("saturation_" #stage, "Saturation factor of the stage " #stage ".",  \
+                    1.f, true, true)                                                     \
+    .AddOptionalArg("value_" #stage, "Value factor of the stage " #stage ".",            \
+                    1.f, true, true)                                                     \
+    .AddOptionalArg("brightness_" #stage, "Brightness factor of the stage " #stage ".",  \
+                    1.f, true, true)                                                     \
+    .AddOptionalArg("brightness_shift_" #stage,                                          \
+                    "Brightness shift of the stage " #stage ".", 0.f, true, true)        \
+    .AddOptionalArg("contrast_" #stage, "Contrast factor of the stage " #stage ".",      \
+                    1.f, true, true)                                                     \
+    .AddOptionalArg<float>("contrast_center_" #stage,                                    \
+                           "Contrast center of the stage " #stage ".", nullptr, true, true)
+
+static_assert(color::kMaxChainStages == 4, "Update the schema of ColorTransformChain");
+
+DALI_SCHEMA(ColorTransformChain)
+    .DocStr(R"code(Applies a chain of color operators as a single affine transform.
+
+This operator is created by the pipeline when consecutive color operators are merged;
+the arguments of the stage ``k`` are suffixed with ``_k``.)code")
+    .NumInput(1)
+    .NumOutput(1)
+    .AddArg("stages", R"code(The names of the merged operators, in the order of application.)code",
+            DALI_STRING_VEC)
+    .AddOptionalTypeArg(color::kOutputType, R"code(The output data type.
+
+If not set, the input type is used.)code")
+    .COLOR_TRANSFORM_STAGE_ARGS(0)
+    .COLOR_TRANSFORM_STAGE_ARGS(1)
+    .COLOR_TRANSFORM_STAGE_ARGS(2)
+    .COLOR_TRANSFORM_STAGE_ARGS(3)
+    .InputLayout(0, {"HWC", "FHWC", "DHWC"})
+    .AllowSequences()
+    .SupportVolumetric()
+    .MakeInternal();
+
+#undef COLOR_TRANSFORM_STAGE_ARGS
+
+namespace {
+
+float FullRange(DALIDataType type) {
+  float range = 1;
+  TYPE_SWITCH(type, type2id, T, BRIGHTNESS_CONTRAST_SUPPORTED_TYPES, (
+    range = brightness_contrast::FullRange<T>();
+  ), DALI_FAIL(make_string("Unsupported data type in BrightnessContrast: ", type)));  // NOLINT
+  return range;
+}
+
+float HalfRange(DALIDataType type) {
+  float range = 0.5f;
+  TYPE_SWITCH(type, type2id, T, BRIGHTNESS_CONTRAST_SUPPORTED_TYPES, (
+    range = brightness_contrast::HalfRange<T>();
+  ), DALI_FAIL(make_string("Unsupported data type in BrightnessContrast: ", type)));  // NOLINT
+  return range;
+}
+
+}  // namespace
+
+ColorTransformChainGpu::ColorTransformChainGpu(const OpSpec &spec) : Base(spec) {
+  spec.TryGetArgument(output_type_arg_, color::kOutputType);
+  auto stage_names = spec.GetRepeatedArgument<std::string>("stages");
+  DALI_ENFORCE(!stage_names.empty() &&
+               static_cast<int>(stage_names.size()) <= color::kMaxChainStages,
+               make_string("The number of stages must be between 1 and ", color::kMaxChainStages,
+                           ", got: ", stage_names.size()));
+  for (auto &name : stage_names) {
+    if (name == "Hsv" || name == "Hue" || name == "Saturation" || name == "ColorTwist")
+      stages_.push_back(StageKind::ColorTwist);
+    else if (name == "Brightness" || name == "Contrast" || name == "BrightnessContrast")
+      stages_.push_back(StageKind::BrightnessContrast);
+    else
+      DALI_FAIL(make_string("Not a color transform: ", name));
+  }
+}
+
+void ColorTransformChainGpu::GetStageArgument(std::vector<float> &out, const std::string &name,
+                                              float default_value, const Workspace &ws,
+                                              int num_samples) {
+  if (spec_.ArgumentDefined(name))
+    this->GetPerSampleArgument(out, name, ws, num_samples);
+  else
+    out.assign(num_samples, default_value);
+}
+
+void ColorTransformChainGpu::ComposeTransforms(const Workspace &ws, DALIDataType input_type) {
+  using namespace color;  // NOLINT
+  int num_samples = ws.GetInputBatchSize(0);
+  tmatrices_.assign(num_samples, mat3::eye());
+  toffsets_.assign(num_samples, vec3());
+  int num_stages = stages_.size();
+  for (int s = 0; s < num_stages; s++) {
+    // the stage sees the data in the type produced by the previous one
+    DALIDataType stage_in = s == 0 ? input_type : DALI_FLOAT;
+    DALIDataType stage_out = s == num_stages - 1 ? output_type_ : DALI_FLOAT;
+    GetStageArgument(brightness_, StageArgName(kBrightness, s), 1, ws, num_samples);
+    GetStageArgument(contrast_, StageArgName(kContrast, s), 1, ws, num_samples);
+
+    if (stages_[s] == StageKind::ColorTwist) {
+      GetStageArgument(hue_, StageArgName(kHue, s), 0, ws, num_samples);
+      GetStageArgument(saturation_, StageArgName(kSaturation, s), 1, ws, num_samples);
+      GetStageArgument(value_, StageArgName(kValue, s), 1, ws, num_samples);
+      float half_range = IsFloatingPoint(stage_in) ? 0.5f : 128.f;
+      for (int i = 0; i < num_samples; i++) {
+        mat3 m = mat3(brightness_[i]) * mat3(contrast_[i]) *
+                 Yiq2Rgb * hue_mat(hue_[i]) * sat_mat(saturation_[i]) * mat3(value_[i]) * Rgb2Yiq;
+        vec3 offset((half_range - half_range * contrast_[i]) * brightness_[i]);
+        toffsets_[i] = m * toffsets_[i] + offset;
+        tmatrices_[i] = m * tmatrices_[i];
+      }
+    } else {
+      GetStageArgument(brightness_shift_, StageArgName("brightness_shift", s), 0, ws,
+                       num_samples);
+      GetStageArgument(contrast_center_, StageArgName("contrast_center", s),
+                       HalfRange(stage_in), ws, num_samples);
+      float brightness_range = FullRange(stage_out);
+      for (int i = 0; i < num_samples; i++) {
+        float mul = brightness_[i] * contrast_[i];
+        float add = brightness_shift_[i] * brightness_range +
+                    brightness_[i] * (contrast_center_[i] - contrast_[i] * contrast_center_[i]);
+        toffsets_[i] = mul * toffsets_[i] + vec3(add);
+        tmatrices_[i] = mat3(mul) * tmatrices_[i];
+      }
+    }
+  }
+}
+
+bool ColorTransformChainGpu::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                       const Workspace &ws) {
+  const auto &input = ws.Input<GPUBackend>(0);
+  auto sh = input.shape();
+  for (int i = 0; i < sh.num_samples(); i++) {
+    DALI_ENFORCE(sh.tensor_shape_span(i).back() == 3, make_string(
+        "The color transforms require 3 channels, got a sample with shape: ",
+        sh.tensor_shape(i)));
+  }
+  output_type_ = output_type_arg_ != DALI_NO_TYPE ? output_type_arg_ : input.type();
+  ComposeTransforms(ws, input.type());
+  output_desc.resize(1);
+  output_desc[0] = {sh, output_type_};
+  return true;
+}
+
+}  // namespace dali
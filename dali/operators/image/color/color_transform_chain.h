@@ -0,0 +1,97 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_IMAGE_COLOR_COLOR_TRANSFORM_CHAIN_H_
+#define DALI_OPERATORS_IMAGE_COLOR_COLOR_TRANSFORM_CHAIN_H_
+
+#include <string>
+#include <vector>
+#include "dali/core/geom/mat.h"
+#include "dali/kernels/kernel_manager.h"
+#include "dali/pipeline/operator/checkpointing/stateless_operator.h"
+#include "dali/pipeline/operator/operator.h"
+#include "dali/pipeline/operator/sequence_operator.h"
+
+namespace dali {
+namespace color {
+
+/** The maximum number of color operators merged into one ColorTransformChain */
+constexpr int kMaxChainStages = 4;
+
+/** The name of the argument of the given stage of ColorTransformChain, e.g. `hue_1` */
+inline std::string StageArgName(const std::string &name, int stage) {
+  return name + "_" + std::to_string(stage);
+}
+
+}  // namespace color
+
+/**
+ * @brief Applies a chain of color operators as one affine transform of the RGB values
+ *
+ * The operator is not meant to be used directly - it's the result of merging consecutive
+ * Hsv, Hue, Saturation, ColorTwist, Brightness, Contrast and BrightnessContrast operators
+ * in the graph (see graph::FuseColorTransforms). The transforms of all the stages are
+ * composed per sample into a single 3x3 matrix and an offset, so the data is traversed once.
+ *
+ * The stages that follow the first one see floating point data.
+ */
+class ColorTransformChainGpu : public SequenceOperator<GPUBackend, StatelessOperator> {
+ public:
+  using Base = SequenceOperator<GPUBackend, StatelessOperator>;
+
+  explicit ColorTransformChainGpu(const OpSpec &spec);
+
+  ~ColorTransformChainGpu() override = default;
+
+  DISABLE_COPY_MOVE_ASSIGN(ColorTransformChainGpu);
+
+ protected:
+  // As in ColorTwist, the 4D data is processed directly unless there are per-frame arguments.
+  bool ShouldExpand(const Workspace &ws) override {
+    return Base::ShouldExpand(ws) && this->HasPerFrameArgInputs(ws);
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override;
+
+  void RunImpl(Workspace &ws) override;
+
+ private:
+  /** Multiplies (brightness, contrast, brightness_shift) as in Hsv/ColorTwist or as in
+   *  BrightnessContrast (which moves the contrast center and the shift with the data type) */
+  enum class StageKind {
+    ColorTwist,
+    BrightnessContrast
+  };
+
+  void GetStageArgument(std::vector<float> &out, const std::string &name, float default_value,
+                        const Workspace &ws, int num_samples);
+
+  /** Composes the transforms of all the stages for each of the samples */
+  void ComposeTransforms(const Workspace &ws, DALIDataType input_type);
+
+  template <typename OutputType, typename InputType>
+  void RunImplHelper(Workspace &ws);
+
+  std::vector<StageKind> stages_;
+  std::vector<float> hue_, saturation_, value_, brightness_, brightness_shift_, contrast_;
+  std::vector<float> contrast_center_;
+  std::vector<mat3> tmatrices_;
+  std::vector<vec3> toffsets_;
+  DALIDataType output_type_arg_ = DALI_NO_TYPE, output_type_ = DALI_NO_TYPE;
+  kernels::KernelManager kernel_manager_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_IMAGE_COLOR_COLOR_TRANSFORM_CHAIN_H_
@@ -24,82 +24,13 @@
 #include "dali/core/error_handling.h"
 #include "dali/core/geom/box.h"
 #include "dali/core/static_switch.h"
+#include "dali/operators/image/crop/bbox_crop_params.h"
 #include "dali/pipeline/data/views.h"
 #include "dali/pipeline/util/batch_rng.h"
 #include "dali/pipeline/util/bounding_box_utils.h"
 
 namespace dali {
 
-namespace {
-
-// This is the default shape layout that the operator uses internally
-TensorLayout InternalShapeLayout(int ndim) {
-  assert(ndim == 3 || ndim == 2);
-  return ndim == 3 ? "WHD" : "WH";
-}
-
-template <int ndim>
-void CollectShape(std::vector<i64vec<ndim>> &v,
-                  const std::string &name,
-                  const OpSpec& spec,
-                  const Workspace &ws,
-                  span<const int> perm) {
-  int batch_size = spec.GetArgument<int>("max_batch_size");
-  v.clear();
-  v.reserve(batch_size);
-
-  i64vec<ndim> sample_sh;
-  if (spec.HasTensorArgument(name)) {
-    auto arg_view = view<const int>(ws.ArgumentInput(name));
-    DALI_ENFORCE(arg_view.num_samples() == batch_size, make_string(
-      "Unexpected number of samples in argument `", name, "`: ", arg_view.num_samples(),
-      ", expected: ", batch_size));
-
-    for (int sample = 0; sample < batch_size; sample++) {
-      auto shape_len = volume(arg_view.tensor_shape(sample));
-      DALI_ENFORCE(shape_len == ndim, make_string(
-        "Unexpected number of elements in argument `", name, "`: ", shape_len,
-        ", expected: ", ndim));
-      permute(sample_sh, arg_view.tensor_data(sample), perm);
-
-      DALI_ENFORCE(all_coords(sample_sh >= 0),
-                   make_string("``", name,
-                               "`` argument should contain non negative values. Got: ", sample_sh));
-
-      v.push_back(sample_sh);
-    }
-  } else if (spec.HasArgument(name)) {
-    auto tmp = spec.GetRepeatedArgument<int>(name);
-    DALI_ENFORCE(static_cast<int>(tmp.size()) == ndim,
-                 make_string("Argument `", name, "` must be a ", ndim, "D vector. Got ", tmp.size(),
-                             " elements."));
-    permute(sample_sh, tmp, perm);
-
-    DALI_ENFORCE(all_coords(sample_sh >= 0),
-                 make_string("``", name,
-                             "`` argument should contain non negative values. Got: ", sample_sh));
-
-    v.resize(batch_size, sample_sh);
-  } else {
-    DALI_FAIL(make_string("Argument `", name, "` was not found"));
-  }
-}
-
-struct SampleOption {
-  bool no_crop = false;
-  float threshold = 0.0f;
-};
-
-struct Range {
-  bool Contains(float k) const {
-    assert(min <= max);
-    return k >= min && k <= max;
-  }
-  float min = 0.0f, max = 0.0f;
-};
-
-}  // namespace
-
 DALI_SCHEMA(RandomBBoxCrop)
     .DocStr(
         R"code(Applies a prospective random crop to an image coordinate space while keeping
@@ -370,16 +301,6 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
  public:
   static constexpr int coords_size = ndim * 2;
 
-  enum OverlapMetric {
-    IoU = 1,
-    Overlap = 2
-  };
-
-  enum BoxPruneMethod {
-    Centroid,
-    RelativeThresh
-  };
-
   ~RandomBBoxCropImpl() = default;
 
   /**
@@ -388,145 +309,13 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
    */
   RandomBBoxCropImpl(const OpSpec *spec, BatchRNG<std::mt19937_64> &rng)
       : spec_(*spec),
-        num_attempts_{spec_.GetArgument<int>("num_attempts")},
+        params_(spec_),
         has_labels_(spec_.NumRegularInput() > 1),
-        has_crop_shape_(spec_.ArgumentDefined("crop_shape")),
-        has_input_shape_(spec_.ArgumentDefined("input_shape")),
-        bbox_layout_(spec_.GetArgument<TensorLayout>("bbox_layout")),
-        shape_layout_(spec_.GetArgument<TensorLayout>("shape_layout")),
-        all_boxes_above_threshold_(spec_.GetArgument<bool>("all_boxes_above_threshold")),
         output_bbox_indices_(spec_.GetArgument<bool>("output_bbox_indices")),
-        rngs_(rng) {
-    auto scaling_arg = spec_.GetRepeatedArgument<float>("scaling");
-    DALI_ENFORCE(scaling_arg.size() == 2,
-                 make_string("`scaling` must be a range `[min, max]`. Got ",
-                             scaling_arg.size(), " values"));
-    scale_range_.min = scaling_arg[0];
-    scale_range_.max = scaling_arg[1];
-    DALI_ENFORCE(
-        scale_range_.min >= 0 && scale_range_.min <= scale_range_.max,
-        make_string("`scaling` range must be positive and min <= max. Got: ", scale_range_.min,
-                    ", ", scale_range_.max));
-
-    if (spec_.ArgumentDefined("bbox_prune_threshold")) {
-      box_prune_method_ = BoxPruneMethod::RelativeThresh;
-      bbox_prune_threshold_ = spec_.GetArgument<float>("bbox_prune_threshold");
-      DALI_ENFORCE(0 <= bbox_prune_threshold_ && bbox_prune_threshold_ <= 1.f,
-        make_string("`bbox_prune_threshold` must be in range `[0.0,1.0]`. Got: ",
-                    bbox_prune_threshold_));
-    }
-
-    auto aspect_ratio_arg = spec_.GetRepeatedArgument<float>("aspect_ratio");
-    DALI_ENFORCE(aspect_ratio_arg.size() == 2 || aspect_ratio_arg.size() == 6,
-        make_string(
-            "`aspect_ratio` range argument should have 2 elements, or 6 elements in case of "
-            "3D bounding boxes. Got ",
-            aspect_ratio_arg.size(), " elements"));
-    aspect_ratio_ranges_.resize(aspect_ratio_arg.size() / 2);
-    int k = 0;
-    for (auto &range : aspect_ratio_ranges_) {
-      range.min = aspect_ratio_arg[k++];
-      range.max = aspect_ratio_arg[k++];
-      DALI_ENFORCE(range.min >= 0 && range.min <= range.max,
-                   make_string("`aspect_ratio` range must be positive and min <= max. Got: ",
-                               range.min, ", ", range.max));
-    }
-
-    if (has_crop_shape_) {
-      DALI_ENFORCE(has_input_shape_,
-        "``input_shape`` must be provided when providing ``crop_shape``");
-    }
-
-    if (spec_.ArgumentDefined("ltrb")) {
-      if (spec_.ArgumentDefined("bbox_layout")) {
-        DALI_FAIL(
-            "`ltrb` and `bbox_layout` can't be provided at the same time. `ltrb` was deprecated in "
-            "favor of `bbox_layout`.");
-      }
-      DALI_WARN(
-          "WARNING: `ltrb` is deprecated. Please use `bbox_layout` to specify the format of the "
-          "bounding box. E.g. For 2D bounding boxes, `ltrb=True`` is equivalent to "
-          "`bbox_layout=\"xyXY\"`, and `ltrb=False` is equivalent to `bbox_layout=\"xyWH\"`");
-    }
-
-    bool allow_no_crop = spec_.GetArgument<bool>("allow_no_crop");
-    if (has_crop_shape_) {
-      // If it was left default but a crop_shape was provided, disallow no crop silently
-      if (!spec_.HasArgument("allow_no_crop")) {
-        DALI_WARN("Using explicit `crop_shape`, `allow_no_crop` will not take effect.");
-        allow_no_crop = false;
-      }
-
-      DALI_ENFORCE(!allow_no_crop,
-                   "`allow_no_crop` is incompatible with providing the crop shape explicitly");
-      DALI_ENFORCE(!spec_.HasArgument("aspect_ratio"),
-                   "`aspect_ratio` is incompatible with providing the crop shape explicitly");
-      DALI_ENFORCE(!spec_.HasArgument("scaling"),
-                   "`scaling` is incompatible with providing the crop shape explicitly");
-    }
-
-    auto thresholds = spec_.GetRepeatedArgument<float>("thresholds");
-    DALI_ENFORCE(!thresholds.empty(),
-      "At least one threshold value must be provided");
-    DALI_ENFORCE(num_attempts_ > 0,
-      "Minimum number of attempts must be greater than zero");
-    for (const auto &threshold : thresholds) {
-      DALI_ENFORCE(0.0 <= threshold && threshold <= 1.0,
-        make_string("Threshold value must be within the range [0.0, 1.0]. Received: ", threshold));
-      sample_options_.push_back({false, threshold});
-    }
-
-    if (spec_.HasArgument("threshold_type")) {
-      auto threshold_type = spec_.GetArgument<std::string>("threshold_type");
-      if (threshold_type == "iou") {
-        overlap_metric_ = OverlapMetric::IoU;
-      } else  if (threshold_type == "overlap") {
-        overlap_metric_ = OverlapMetric::Overlap;
-      } else {
-        DALI_FAIL(make_string("Not supported ``threshold_type`` value: \"", threshold_type,
-                              "\". Supported values are: \"iou\", \"overlap\"."));
-      }
-    }
-
-    if (allow_no_crop) {
-      sample_options_.push_back({true, 0.0f});
-    }
-
-    total_num_attempts_ = -1;
-    if (spec_.HasArgument("total_num_attempts")) {
-      total_num_attempts_ = spec_.GetArgument<int>("total_num_attempts");
-      DALI_ENFORCE(total_num_attempts_ > 0,
-        "Minimum total number of attempts must be greater than zero");
-    }
-
-    auto default_bbox_layout_start_end = DefaultBBoxLayout<ndim>();
-    auto default_bbox_layout_start_shape = DefaultBBoxAnchorAndShapeLayout<ndim>();
-    if (bbox_layout_.empty()) {
-      auto ltrb = spec_.GetArgument<bool>("ltrb");
-      bbox_layout_ = ltrb ? default_bbox_layout_start_end : default_bbox_layout_start_shape;
-    }
-    DALI_ENFORCE(bbox_layout_.is_permutation_of(default_bbox_layout_start_end) ||
-                 bbox_layout_.is_permutation_of(default_bbox_layout_start_shape),
-      make_string("`bbox_layout` should be a permutation of `", default_bbox_layout_start_end,
-                  "` or `", default_bbox_layout_start_shape, "`. Got: `", bbox_layout_, "`"));
-  }
+        rngs_(rng) {}
 
   bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override {
-    if (has_input_shape_ || has_crop_shape_) {
-      // Converting the shapes to "WHD" or "WH" if necessary
-      auto default_shape_layout = InternalShapeLayout(ndim);
-      const TensorLayout &layout = shape_layout_.empty() ? default_shape_layout : shape_layout_;
-      if (!shape_layout_.empty() && shape_layout_ != default_shape_layout) {
-        DALI_ENFORCE(shape_layout_.is_permutation_of(default_shape_layout),
-                     make_string("`shape_layout` should be a permutation of ", default_shape_layout,
-                                 "` for the provided inputs"));
-      }
-      auto perm = GetDimIndices(layout, default_shape_layout);
-      if (has_crop_shape_)
-        CollectShape(crop_shape_, "crop_shape", spec_, ws, make_cspan(perm));
-      if (has_input_shape_)
-        CollectShape(input_shape_, "input_shape", spec_, ws, make_cspan(perm));
-    }
+    params_.Setup(spec_, ws);
     return false;
   }
 
@@ -547,7 +336,7 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
         ReadBoxes(make_span(data.in_bboxes),
                   make_cspan(in_boxes_view.tensor_data(sample_idx),
                              volume(in_boxes_shape.tensor_size(sample_idx))),
-                  bbox_layout_);
+                  params_.bbox_layout());
         FindProspectiveCrop(data.prospective_crop, make_cspan(data.in_bboxes), sample_idx);
       }, in_boxes_shape.tensor_size(sample_idx));
     }
@@ -583,7 +372,8 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
     for (int sample_idx = 0; sample_idx < num_samples; sample_idx++) {
       WriteBoxes(make_span(bbox_out_view.tensor_data(sample_idx),
                            volume(bbox_out_view.tensor_shape_span(sample_idx))),
-                 make_cspan(sample_data_[sample_idx].prospective_crop.boxes), bbox_layout_);
+                 make_cspan(sample_data_[sample_idx].prospective_crop.boxes),
+                 params_.bbox_layout());
     }
 
     int next_out_idx = 3;
@@ -632,6 +422,7 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
     }
   }
 
+
  private:
   struct ProspectiveCrop {
     bool success = false;
@@ -647,174 +438,50 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
     }
   };
 
-  /**
-   * @brief Fixes shape dimensions to follow aspect ratio constraints in case of ar_min == ar_max
-   * @remarks The dimensions are fixed on a random order
-   * @return true if the shape was modified, false otherwise
-   */
-  bool FixAspectRatios(vec<ndim>& shape) {
-    // If aspect ratio is fixed, fix the required dimensions
-    std::array<float, ndim*ndim> fixed_aspect_ratios;
-    int k = 0;
-
-    bool need_fix = false;
-    for (int d0 = 0; d0 < ndim; d0++) {
-      for (int d1 = d0 + 1; d1 < ndim; d1++) {
-        // to be used later when min==max
-        if (aspect_ratio_ranges_[k].min == aspect_ratio_ranges_[k].max) {
-          fixed_aspect_ratios[d0*ndim+d1] = aspect_ratio_ranges_[k].min;
-          fixed_aspect_ratios[d1*ndim+d0] = 1.0 / aspect_ratio_ranges_[k].min;
-          need_fix = true;
-        } else {
-          fixed_aspect_ratios[d0*ndim+d1] = 0.0f;
-          fixed_aspect_ratios[d1*ndim+d0] = 0.0f;
-        }
-        k = (k + 1) % aspect_ratio_ranges_.size();
-      }
-    }
-
-    if (!need_fix)
-      return false;
-
-    std::array<int, ndim> order;
-    std::iota(order.begin(), order.end(), 0);
-    std::random_shuffle(order.begin(), order.end());
-
-    float max_extent = 0.0f;
-    for (int d = 0; d < ndim; d++) {
-      max_extent = std::max(max_extent, shape[d]);
-    }
-
-    for (int i0 = 0; i0 < ndim; i0++) {
-      for (int i1 = i0 + 1; i1 < ndim; i1++) {
-        int d0 = order[i0], d1 = order[i1];
-        auto fixed_ar = fixed_aspect_ratios[d1*ndim+d0];
-        if (fixed_ar > 0) {
-          shape[d1] = shape[d0] * fixed_ar;
-        }
-      }
-    }
-
-    // Re-scale so that largest extent matches the previous max extent
-    float new_max_extent = 0.0;
-    for (int d = 0; d < ndim; d++)
-      new_max_extent = std::max(new_max_extent, shape[d]);
-
-    for (auto &extent : shape)
-      extent = max_extent * extent / new_max_extent;
-
-    return true;
-  }
-
   void FindProspectiveCrop(ProspectiveCrop &crop, span<const Box<ndim, float>> bounding_boxes,
                            int sample) {
     int count = 0;
     float best_metric = -1.0;
+    int total_num_attempts = params_.total_num_attempts();
 
     crop.clear();
-    while (!crop.success && (total_num_attempts_ < 0 || count < total_num_attempts_)) {
+    while (!crop.success && (total_num_attempts < 0 || count < total_num_attempts)) {
       auto &rng = rngs_[sample];
-      std::uniform_int_distribution<> idx_dist(0, sample_options_.size() - 1);
-      SampleOption option = sample_options_[idx_dist(rng)];
-      bool absolute_crop_dims = has_crop_shape_;
+      bbox_crop::SampleOption option = params_.DrawOption(rng);
 
       if (option.no_crop) {
-        Box<ndim, float> no_crop = Uniform<ndim>(0.0f, 1.0f);
-        if (absolute_crop_dims) {
-          auto &input_shape = input_shape_[sample];
-          for (int d = 0; d < ndim; d++)
-            no_crop.hi[d] *= input_shape[d];
-        }
         crop.success = true;
-        crop.crop = no_crop;
+        crop.crop = params_.NoCropWindow(sample);
         crop.boxes.assign(bounding_boxes.begin(), bounding_boxes.end());
         crop.bbox_indices.resize(crop.boxes.size());
         std::iota(crop.bbox_indices.begin(), crop.bbox_indices.end(), 0);
         break;
       }
 
-      vec<ndim> shape, anchor;
-      Box<ndim, float> rel_crop, out_crop;
-      for (int i = 0; i < num_attempts_; i++, count++) {
-        if (absolute_crop_dims) {
-          auto &crop_shape = crop_shape_[sample];
-          auto &input_shape = input_shape_[sample];
-
-          for (int d = 0; d < ndim; d++) {
-            shape[d] = static_cast<float>(crop_shape[d]);
-            out_crop.hi[d] = shape[d];
-            rel_crop.hi[d] = shape[d] / input_shape[d];
-          }
-
-          for (int d = 0; d < ndim; d++) {
-            auto diff = input_shape[d] - crop_shape[d];
-            if (diff > 0) {
-              anchor[d] = static_cast<float>(
-                  std::uniform_int_distribution<>(0, diff)(rng));
-            } else if (diff < 0) {
-              anchor[d] = static_cast<float>(
-                  std::uniform_int_distribution<>(diff, 0)(rng));
-            } else {
-              anchor[d] = 0.0f;
-            }
-            out_crop.lo[d] = anchor[d];
-            rel_crop.lo[d] = anchor[d] / input_shape[d];
-          }
-          out_crop.hi += out_crop.lo;
-          rel_crop.hi += rel_crop.lo;
-        } else {  // relative dimensions
-          std::uniform_real_distribution<float> extent_dist(scale_range_.min, scale_range_.max);
-          for (int d = 0; d < ndim; d++) {
-            shape[d] = extent_dist(rng);
-          }
-
-          // If input shape is provided, we take it into account for the aspect ratio range check
-          // Otherwise, we use the relative shape for aspect ratio check
-          vec<ndim> tmp_sh = has_input_shape_ ? shape * input_shape_[sample] : shape;
-
-          bool fixed_ar = FixAspectRatios(tmp_sh);
-
-          if (!ValidAspectRatio(tmp_sh))
-            continue;
-
-          if (fixed_ar) {
-            shape = has_input_shape_ ? tmp_sh / input_shape_[sample] : tmp_sh;
-          }
-
-          for (int d = 0; d < ndim; d++) {
-            std::uniform_real_distribution<float> anchor_dist(0.0f, 1.0f - shape[d]);
-            anchor[d] = anchor_dist(rng);
-            rel_crop.lo[d] = anchor[d];
-            rel_crop.hi[d] = anchor[d] + shape[d];
-          }
-          out_crop = rel_crop;
-        }
+      for (int i = 0; i < params_.num_attempts(); i++, count++) {
+        auto candidate = params_.GenerateCandidate(sample, rng);
+        if (!candidate.valid)
+          continue;
+        const auto &rel_crop = candidate.rel_crop;
 
         float min_overlap = 0.0, max_overlap = 0.0;
         std::tie(min_overlap, max_overlap) =
             OverlapMetricRange(rel_crop, make_cspan(bounding_boxes));
-        float metric = all_boxes_above_threshold_ ? min_overlap : max_overlap;
+        float metric = params_.all_boxes_above_threshold() ? min_overlap : max_overlap;
         bool is_valid_overlap = metric >= option.threshold;
         if (metric <= best_metric && !is_valid_overlap)
           continue;
 
         best_metric = metric;
 
-        crop.crop = out_crop;
+        crop.crop = candidate.out_crop;
         crop.boxes.assign(bounding_boxes.begin(), bounding_boxes.end());
         crop.bbox_indices.clear();  // indices will be populated by FilterBboxes
-        if (box_prune_method_ == BoxPruneMethod::Centroid) {
-          FilterBboxes(crop.boxes, crop.bbox_indices,
-            [&](const Box<ndim, float>& bbox) {
-              return rel_crop.contains(bbox.centroid());
-            });
-        } else {  // box_prune_method_ == BoxPruneMethod::RelativeThresh
-          FilterBboxes(crop.boxes, crop.bbox_indices,
-            [&](const Box<ndim, float>& bbox) {
-              const float intersec = volume(intersection(rel_crop, bbox));
-              return intersec != 0.0f && intersec / volume(bbox) >= bbox_prune_threshold_;
-            });
-        }
+        FilterBboxes(crop.boxes, crop.bbox_indices,
+          [&](const Box<ndim, float>& bbox) {
+            return bbox_crop::KeepBox(params_.box_prune_method(), params_.bbox_prune_threshold(),
+                                      rel_crop, bbox);
+          });
 
         for (auto &box : crop.boxes) {
           box = RemapBox(box, rel_crop);
@@ -832,20 +499,6 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
     }
   }
 
-  bool ValidAspectRatio(vec<ndim> shape) {
-    assert(static_cast<int>(shape.size()) == ndim);
-    int k = 0;
-    assert(!aspect_ratio_ranges_.empty());
-    for (int i = 0; i < ndim; i++) {
-      for (int j = i + 1; j < ndim; j++) {
-        if (!aspect_ratio_ranges_[k].Contains(shape[i] / shape[j]))
-          return false;
-        k = (k + 1) % aspect_ratio_ranges_.size();
-      }
-    }
-    return true;
-  }
-
   template <typename Metric>
   std::pair<float, float> MinMaxRange(const Box<ndim, float> &crop,
                                       span<const Box<ndim, float>> boxes,
@@ -866,19 +519,12 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
 
   std::pair<float, float> OverlapMetricRange(const Box<ndim, float> &crop,
                                              span<const Box<ndim, float>> boxes) {
-    if (overlap_metric_ == OverlapMetric::Overlap) {
-      auto f =
-          [](const Box<ndim, float> &crop, const Box<ndim, float> &box) {
-            return volume(intersection(crop, box)) / static_cast<float>(volume(box));
-          };
-      return MinMaxRange(crop, boxes, f);
-    } else {  // IoU
-      auto f =
-          [](const Box<ndim, float> &crop, const Box<ndim, float> &box) {
-            return intersection_over_union(crop, box);
-          };
-      return MinMaxRange(crop, boxes, f);
-    }
+    auto f =
+        [metric = params_.overlap_metric()](const Box<ndim, float> &crop,
+                                            const Box<ndim, float> &box) {
+          return bbox_crop::CropOverlap(metric, crop, box);
+        };
+    return MinMaxRange(crop, boxes, f);
   }
 
   template <class UnaryPredicate>
@@ -899,31 +545,12 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
 
  private:
   const OpSpec &spec_;
-  int num_attempts_;
-  int total_num_attempts_;
+  bbox_crop::RandomBBoxCropParams<ndim> params_;
   bool has_labels_;
-  bool has_crop_shape_;
-  bool has_input_shape_;
-
-  TensorLayout bbox_layout_;
-  TensorLayout shape_layout_;
-
-  OverlapMetric overlap_metric_ = OverlapMetric::IoU;
-  BoxPruneMethod box_prune_method_ = BoxPruneMethod::Centroid;
-  bool all_boxes_above_threshold_ = true;
   bool output_bbox_indices_ = false;
-  float bbox_prune_threshold_ = 0.0f;
 
   BatchRNG<std::mt19937_64> &rngs_;
 
-  std::vector<SampleOption> sample_options_;
-
-  std::vector<i64vec<ndim>> crop_shape_;
-  std::vector<i64vec<ndim>> input_shape_;
-
-  Range scale_range_;
-  std::vector<Range> aspect_ratio_ranges_;
-
   struct SampleData {
     std::vector<Box<ndim, float>> in_bboxes;
     ProspectiveCrop prospective_crop;
@@ -943,23 +570,7 @@ template <>
 bool RandomBBoxCrop<CPUBackend>::SetupImpl(std::vector<OutputDesc> &output_desc,
                                            const Workspace &ws) {
   const auto &boxes = ws.Input<CPUBackend>(0);
-  auto tl_shape = boxes.shape();
-  DALI_ENFORCE(tl_shape.sample_dim() == 2, make_string(
-    "Unexpected number of dimensions for bounding boxes input: ", tl_shape.sample_dim()));
-  // first dim is number of boxes, second is number of coordinates on each box
-  auto ncoords = tl_shape[0][1];  // first sample, second dimension
-  for (int sample = 0; sample < tl_shape.num_samples(); sample++) {
-    auto sh = tl_shape[sample];
-    DALI_ENFORCE(sh[1] == ncoords,
-      make_string("Unexpected number of coordinates for sample ", sample, ". Expected ",
-                  ncoords, ", got ", sh[1]));
-  }
-  DALI_ENFORCE(ncoords % 2 == 0,
-    make_string("Unexpected number of coordinates for bounding boxes: ", ncoords));
-  auto num_dims = ncoords / 2;
-
-  DALI_ENFORCE(num_dims == 2 || num_dims == 3,
-    make_string("Unexpected number of dimensions: ", num_dims));
+  int num_dims = bbox_crop::GetBoxDims(boxes.shape());
 
   if (impl_ == nullptr || impl_ndim_ != num_dims) {
     VALUE_SWITCH(num_dims, ndim, (2, 3),
@@ -0,0 +1,521 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cuda_runtime.h>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "dali/core/cuda_error.h"
+#include "dali/core/geom/box.h"
+#include "dali/core/static_switch.h"
+#include "dali/core/util.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/operators/image/crop/bbox_crop.h"
+#include "dali/operators/image/crop/bbox_crop_params.h"
+#include "dali/operators/random/rng_base_gpu.h"
+#include "dali/pipeline/data/views.h"
+#include "dali/pipeline/util/bounding_box_utils.h"
+
+namespace dali {
+
+namespace bbox_crop {
+
+/**
+ * @brief Describes the conversion between the coordinates in `bbox_layout` and Box
+ *
+ * The coordinate `i` of the ordered layout (start + end or start + shape) is at the index
+ * `perm[i]` in the input/output.
+ */
+template <int ndim>
+struct BoxLayoutDesc {
+  int perm[2 * ndim];
+  bool start_and_shape;
+};
+
+template <int ndim>
+BoxLayoutDesc<ndim> GetBoxLayoutDesc(const TensorLayout &layout) {
+  BoxLayoutDesc<ndim> desc;
+  desc.start_and_shape = layout.is_permutation_of(DefaultBBoxAnchorAndShapeLayout<ndim>());
+  TensorLayout ordered_layout = desc.start_and_shape ? DefaultBBoxAnchorAndShapeLayout<ndim>()
+                                                     : DefaultBBoxLayout<ndim>();
+  for (int i = 0; i < 2 * ndim; i++) {
+    desc.perm[i] = layout.find(ordered_layout[i]);
+    assert(desc.perm[i] >= 0);
+  }
+  return desc;
+}
+
+template <int ndim>
+struct ReadBoxesDesc {
+  Box<ndim, float> *out;
+  const float *in;
+  int nboxes;
+};
+
+/**
+ * @brief Converts the input coordinates to boxes and checks that they're within [0, 1] range
+ *
+ * `gridDim.y` is the number of samples.
+ */
+template <int ndim>
+__global__ void ReadBoxesKernel(const ReadBoxesDesc<ndim> *samples, BoxLayoutDesc<ndim> layout,
+                                int *out_of_bounds) {
+  auto sample = samples[blockIdx.y];
+  for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < sample.nboxes;
+       i += blockDim.x * gridDim.x) {
+    const float *in = sample.in + i * 2 * ndim;
+    Box<ndim, float> box;
+    for (int d = 0; d < ndim; d++) {
+      box.lo[d] = in[layout.perm[d]];
+      box.hi[d] = in[layout.perm[ndim + d]];
+    }
+    if (layout.start_and_shape)
+      box.hi += box.lo;
+    for (int d = 0; d < ndim; d++) {
+      if (!(box.lo[d] >= 0.0f && box.hi[d] <= 1.0f))
+        out_of_bounds[blockIdx.y] = 1;
+    }
+    sample.out[i] = box;
+  }
+}
+
+template <int ndim>
+struct CandidateDesc {
+  Box<ndim, float> crop;
+  const Box<ndim, float> *boxes;
+  int nboxes;
+};
+
+struct CandidateResult {
+  float min_metric, max_metric;
+  int num_kept;
+};
+
+constexpr int kWarpsPerBlock = 8;
+
+/**
+ * @brief Evaluates the crop window candidates, one warp per candidate
+ *
+ * For each candidate, the minimum and maximum overlap metric and the number of boxes that
+ * are not pruned are calculated.
+ *
+ * `blockDim = 32, kWarpsPerBlock`
+ */
+template <int ndim>
+__global__ void EvaluateCandidatesKernel(CandidateResult *results,
+                                         const CandidateDesc<ndim> *candidates,
+                                         int num_candidates, OverlapMetric metric,
+                                         BoxPruneMethod prune_method, float prune_threshold) {
+  int idx = blockIdx.x * blockDim.y + threadIdx.y;
+  if (idx >= num_candidates)
+    return;  // the whole warp exits
+  auto candidate = candidates[idx];
+  float min_metric = std::numeric_limits<float>::infinity();
+  float max_metric = -std::numeric_limits<float>::infinity();
+  int num_kept = 0;
+  for (int i = threadIdx.x; i < candidate.nboxes; i += 32) {
+    auto box = candidate.boxes[i];
+    float m = CropOverlap(metric, candidate.crop, box);
+    min_metric = fminf(min_metric, m);
+    max_metric = fmaxf(max_metric, m);
+    num_kept += KeepBox(prune_method, prune_threshold, candidate.crop, box);
+  }
+  for (int ofs = 16; ofs > 0; ofs >>= 1) {
+    min_metric = fminf(min_metric, __shfl_down_sync(0xffffffffu, min_metric, ofs));
+    max_metric = fmaxf(max_metric, __shfl_down_sync(0xffffffffu, max_metric, ofs));
+    num_kept += __shfl_down_sync(0xffffffffu, num_kept, ofs);
+  }
+  if (threadIdx.x == 0) {
+    bool empty = candidate.nboxes == 0;
+    results[idx] = { empty ? 0.0f : min_metric, empty ? 0.0f : max_metric, num_kept };
+  }
+}
+
+template <int ndim>
+struct OutputDesc {
+  Box<ndim, float> rel_crop;
+  Box<ndim, float> out_crop;
+  const Box<ndim, float> *in_boxes;
+  int nboxes;
+  /// If true, all boxes are kept and they're not remapped
+  bool no_crop;
+  float *anchor;
+  float *shape;
+  float *out_boxes;
+  int *out_indices;
+  int *out_labels;
+  const int *in_labels;
+  int64_t label_stride;
+};
+
+/**
+ * @brief Writes the crop window and the boxes (and labels) kept in it, one warp per sample
+ *
+ * The boxes are compacted with warp ballots, so their order is preserved.
+ *
+ * `blockDim = 32, kWarpsPerBlock`
+ */
+template <int ndim>
+__global__ void WriteOutputKernel(const OutputDesc<ndim> *samples, int num_samples,
+                                  BoxLayoutDesc<ndim> layout,
+                                  BoxPruneMethod prune_method, float prune_threshold) {
+  int s = blockIdx.x * blockDim.y + threadIdx.y;
+  if (s >= num_samples)
+    return;  // the whole warp exits
+  const auto &sample = samples[s];
+  if (threadIdx.x < ndim) {
+    int d = threadIdx.x;
+    sample.anchor[d] = sample.out_crop.lo[d];
+    sample.shape[d] = sample.out_crop.hi[d] - sample.out_crop.lo[d];
+  }
+  int num_out = 0;
+  for (int base = 0; base < sample.nboxes; base += 32) {
+    int i = base + threadIdx.x;
+    Box<ndim, float> box;
+    bool keep = false;
+    if (i < sample.nboxes) {
+      box = sample.in_boxes[i];
+      keep = sample.no_crop || KeepBox(prune_method, prune_threshold, sample.rel_crop, box);
+    }
+    unsigned mask = __ballot_sync(0xffffffffu, keep);
+    if (keep) {
+      int pos = num_out + __popc(mask & ((1u << threadIdx.x) - 1));
+      if (!sample.no_crop)
+        box = RemapBox(box, sample.rel_crop);
+      float *out = sample.out_boxes + pos * 2 * ndim;
+      for (int d = 0; d < ndim; d++) {
+        out[layout.perm[d]] = box.lo[d];
+        out[layout.perm[ndim + d]] = layout.start_and_shape ? box.hi[d] - box.lo[d] : box.hi[d];
+      }
+      if (sample.out_indices)
+        sample.out_indices[pos] = i;
+      if (sample.out_labels) {
+        for (int64_t k = 0; k < sample.label_stride; k++)
+          sample.out_labels[pos * sample.label_stride + k] =
+              sample.in_labels[i * sample.label_stride + k];
+      }
+    }
+    num_out += __popc(mask);
+  }
+}
+
+}  // namespace bbox_crop
+
+/**
+ * @brief GPU implementation of RandomBBoxCrop
+ *
+ * The crop window candidates are generated on the host, exactly as in the CPU implementation,
+ * so both produce the same crop windows for a given seed. The evaluation is done on the GPU,
+ * in rounds: in each round, every sample that hasn't found a valid crop window yet draws
+ * a threshold option and `num_attempts` candidates - and all the candidates in the batch
+ * are evaluated by a single kernel. The results are copied back and the host selects the crop
+ * window with the same rules as the CPU implementation. Typically, all samples are done after
+ * the first round.
+ */
+template <int ndim>
+class RandomBBoxCropImplGPU : public OpImplBase<GPUBackend> {
+ public:
+  /**
+   * @param spec  Pointer to a persistent OpSpec object,
+   *              which is guaranteed to be alive for the entire lifetime of this object
+   */
+  RandomBBoxCropImplGPU(const OpSpec *spec, BatchRNG<std::mt19937_64> &rng)
+      : spec_(*spec),
+        params_(spec_),
+        has_labels_(spec_.NumRegularInput() > 1),
+        output_bbox_indices_(spec_.GetArgument<bool>("output_bbox_indices")),
+        rngs_(rng) {}
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override {
+    params_.Setup(spec_, ws);
+    return false;
+  }
+
+  void RunImpl(Workspace &ws) override {
+    using bbox_crop::CandidateResult;
+    const auto &in_boxes = ws.Input<GPUBackend>(0);
+    auto in_boxes_view = view<const float, 2>(in_boxes);
+    int num_samples = in_boxes_view.num_samples();
+    cudaStream_t stream = ws.stream();
+    kernels::DynamicScratchpad scratchpad({}, AccessOrder(stream));
+    auto layout = bbox_crop::GetBoxLayoutDesc<ndim>(params_.bbox_layout());
+
+    // Convert the input coordinates to boxes
+    read_descs_.resize(num_samples);
+    int64_t total_boxes = 0;
+    int max_boxes = 0;
+    for (int i = 0; i < num_samples; i++) {
+      int nboxes = in_boxes_view.shape[i][0];
+      read_descs_[i].in = in_boxes_view.data[i];
+      read_descs_[i].nboxes = nboxes;
+      total_boxes += nboxes;
+      max_boxes = std::max(max_boxes, nboxes);
+    }
+    auto *boxes_gpu = scratchpad.AllocateGPU<Box<ndim, float>>(total_boxes);
+    auto *out_of_bounds_gpu = scratchpad.AllocateGPU<int>(num_samples);
+    auto *out_of_bounds = scratchpad.AllocatePinned<int>(num_samples);
+    int64_t offset = 0;
+    for (auto &desc : read_descs_) {
+      desc.out = boxes_gpu + offset;
+      offset += desc.nboxes;
+    }
+    CUDA_CALL(cudaMemsetAsync(out_of_bounds_gpu, 0, num_samples * sizeof(int), stream));
+    if (max_boxes > 0) {
+      auto *read_descs_gpu = std::get<0>(scratchpad.ToContiguousGPU(stream, read_descs_));
+      dim3 grid(div_ceil(max_boxes, kReadBlockSize), num_samples);
+      bbox_crop::ReadBoxesKernel<<<grid, kReadBlockSize, 0, stream>>>(
+          read_descs_gpu, layout, out_of_bounds_gpu);
+      CUDA_CALL(cudaGetLastError());
+    }
+    CUDA_CALL(cudaMemcpyAsync(out_of_bounds, out_of_bounds_gpu, num_samples * sizeof(int),
+                              cudaMemcpyDeviceToHost, stream));
+
+    FindCrops(scratchpad, stream, num_samples);
+
+    for (int i = 0; i < num_samples; i++) {
+      DALI_ENFORCE(!out_of_bounds[i], make_string(
+          "Sample ", i, " contains a box which is out of bounds ", Uniform<ndim>(0.0f, 1.0f)));
+    }
+
+    // Allocate the outputs
+    auto &anchor_out = ws.Output<GPUBackend>(0);
+    anchor_out.Resize(uniform_list_shape(num_samples, {ndim}), DALI_FLOAT);
+    auto anchor_out_view = view<float>(anchor_out);
+
+    auto &shape_out = ws.Output<GPUBackend>(1);
+    shape_out.Resize(uniform_list_shape(num_samples, {ndim}), DALI_FLOAT);
+    auto shape_out_view = view<float>(shape_out);
+
+    TensorListShape<> bbox_out_shape;
+    bbox_out_shape.resize(num_samples, 2);
+    for (int i = 0; i < num_samples; i++) {
+      auto sh = bbox_out_shape.tensor_shape_span(i);
+      sh[0] = state_[i].num_kept;
+      sh[1] = 2 * ndim;
+    }
+    auto &bbox_out = ws.Output<GPUBackend>(2);
+    bbox_out.Resize(bbox_out_shape, DALI_FLOAT);
+    auto bbox_out_view = view<float>(bbox_out);
+
+    int next_out_idx = 3;
+    TensorListView<StorageGPU, const int> labels_in_view;
+    TensorListView<StorageGPU, int> labels_out_view, bbox_indices_out_view;
+    if (has_labels_) {
+      const auto &labels_in = ws.Input<GPUBackend>(1);
+      labels_in_view = view<const int>(labels_in);
+      auto &labels_out = ws.Output<GPUBackend>(next_out_idx++);
+      TensorListShape<> labels_out_shape = labels_in.shape();
+      for (int i = 0; i < num_samples; i++)
+        labels_out_shape.tensor_shape_span(i)[0] = state_[i].num_kept;
+      labels_out.Resize(labels_out_shape, DALI_INT32);
+      labels_out_view = view<int>(labels_out);
+    }
+
+    if (output_bbox_indices_) {
+      auto &bbox_indices_out = ws.Output<GPUBackend>(next_out_idx++);
+      TensorListShape<> bbox_indices_out_shape;
+      bbox_indices_out_shape.resize(num_samples, 1);
+      for (int i = 0; i < num_samples; i++)
+        bbox_indices_out_shape.tensor_shape_span(i)[0] = state_[i].num_kept;
+      bbox_indices_out.Resize(bbox_indices_out_shape, DALI_INT32);
+      bbox_indices_out_view = view<int>(bbox_indices_out);
+    }
+
+    output_descs_.resize(num_samples);
+    for (int i = 0; i < num_samples; i++) {
+      const auto &st = state_[i];
+      auto &desc = output_descs_[i];
+      desc.rel_crop = st.rel_crop;
+      desc.out_crop = st.out_crop;
+      desc.in_boxes = read_descs_[i].out;
+      desc.nboxes = st.num_kept > 0 ? read_descs_[i].nboxes : 0;
+      desc.no_crop = st.no_crop;
+      desc.anchor = anchor_out_view.data[i];
+      desc.shape = shape_out_view.data[i];
+      desc.out_boxes = bbox_out_view.data[i];
+      desc.out_indices = output_bbox_indices_ ? bbox_indices_out_view.data[i] : nullptr;
+      desc.out_labels = has_labels_ ? labels_out_view.data[i] : nullptr;
+      desc.in_labels = has_labels_ ? labels_in_view.data[i] : nullptr;
+      if (has_labels_) {
+        auto in_sh = labels_in_view.tensor_shape_span(i);
+        DALI_ENFORCE(in_sh[0] == read_descs_[i].nboxes, make_string(
+            "The number of labels doesn't match the number of boxes in sample ", i, ": ",
+            in_sh[0], " vs ", read_descs_[i].nboxes));
+        desc.label_stride = volume(in_sh.begin() + 1, in_sh.end());
+      }
+    }
+    auto *output_descs_gpu = std::get<0>(scratchpad.ToContiguousGPU(stream, output_descs_));
+    dim3 block(32, bbox_crop::kWarpsPerBlock);
+    dim3 grid(div_ceil(num_samples, bbox_crop::kWarpsPerBlock));
+    bbox_crop::WriteOutputKernel<<<grid, block, 0, stream>>>(
+        output_descs_gpu, num_samples, layout,
+        params_.box_prune_method(), params_.bbox_prune_threshold());
+    CUDA_CALL(cudaGetLastError());
+  }
+
+ private:
+  static constexpr int kReadBlockSize = 256;
+
+  struct SampleState {
+    int count = 0;
+    float best_metric = -1.0f;
+    bool success = false;
+    bool done = false;
+    bool no_crop = false;
+    int num_kept = 0;
+    Box<ndim, float> rel_crop{};
+    Box<ndim, float> out_crop{};
+  };
+
+  struct Attempt {
+    int sample;
+    float threshold;
+    bbox_crop::CropCandidate<ndim> candidate;
+    int result_idx;  ///< index of the evaluation result; -1 for invalid candidates
+  };
+
+  /**
+   * @brief Selects the crop windows for all samples - see the class description
+   */
+  void FindCrops(kernels::DynamicScratchpad &scratchpad, cudaStream_t stream, int num_samples) {
+    using bbox_crop::CandidateResult;
+    state_.clear();
+    state_.resize(num_samples);
+    int total_num_attempts = params_.total_num_attempts();
+    for (;;) {
+      attempts_.clear();
+      candidate_descs_.clear();
+      for (int s = 0; s < num_samples; s++) {
+        auto &st = state_[s];
+        if (st.done)
+          continue;
+        if (st.success || (total_num_attempts >= 0 && st.count >= total_num_attempts)) {
+          st.done = true;
+          continue;
+        }
+        auto &rng = rngs_[s];
+        auto option = params_.DrawOption(rng);
+        if (option.no_crop) {
+          st.success = st.done = st.no_crop = true;
+          st.out_crop = params_.NoCropWindow(s);
+          st.num_kept = read_descs_[s].nboxes;
+          continue;
+        }
+        for (int i = 0; i < params_.num_attempts(); i++) {
+          Attempt attempt{s, option.threshold, params_.GenerateCandidate(s, rng), -1};
+          if (attempt.candidate.valid) {
+            attempt.result_idx = candidate_descs_.size();
+            candidate_descs_.push_back(
+                {attempt.candidate.rel_crop, read_descs_[s].out, read_descs_[s].nboxes});
+          }
+          attempts_.push_back(attempt);
+        }
+      }
+      if (attempts_.empty())
+        break;
+
+      CandidateResult *results = nullptr;
+      if (!candidate_descs_.empty()) {
+        int n = candidate_descs_.size();
+        auto *descs_gpu = std::get<0>(scratchpad.ToContiguousGPU(stream, candidate_descs_));
+        auto *results_gpu = scratchpad.AllocateGPU<CandidateResult>(n);
+        results = scratchpad.AllocatePinned<CandidateResult>(n);
+        dim3 block(32, bbox_crop::kWarpsPerBlock);
+        dim3 grid(div_ceil(n, bbox_crop::kWarpsPerBlock));
+        bbox_crop::EvaluateCandidatesKernel<<<grid, block, 0, stream>>>(
+            results_gpu, descs_gpu, n, params_.overlap_metric(),
+            params_.box_prune_method(), params_.bbox_prune_threshold());
+        CUDA_CALL(cudaGetLastError());
+        CUDA_CALL(cudaMemcpyAsync(results, results_gpu, n * sizeof(CandidateResult),
+                                  cudaMemcpyDeviceToHost, stream));
+        CUDA_CALL(cudaStreamSynchronize(stream));
+      }
+
+      // Replay the selection, in the order in which the CPU implementation would do it
+      for (auto &attempt : attempts_) {
+        auto &st = state_[attempt.sample];
+        st.count++;
+        if (attempt.result_idx < 0)
+          continue;
+        const auto &result = results[attempt.result_idx];
+        float metric = params_.all_boxes_above_threshold() ? result.min_metric
+                                                           : result.max_metric;
+        bool is_valid_overlap = metric >= attempt.threshold;
+        if (metric <= st.best_metric && !is_valid_overlap)
+          continue;
+        st.best_metric = metric;
+        st.rel_crop = attempt.candidate.rel_crop;
+        st.out_crop = attempt.candidate.out_crop;
+        st.num_kept = result.num_kept;
+        st.success = is_valid_overlap && result.num_kept > 0;
+      }
+    }
+    CUDA_CALL(cudaStreamSynchronize(stream));  // for the out-of-bounds flags
+
+    for (auto &st : state_) {
+      if (!st.success) {
+        DALI_WARN(make_string(
+          "Could not find a valid cropping window to satisfy the specified requirements "
+          "(attempted ", st.count, " times). Using the best cropping window so far (best_metric=",
+          st.best_metric, ")"));
+      }
+    }
+  }
+
+  const OpSpec &spec_;
+  bbox_crop::RandomBBoxCropParams<ndim> params_;
+  bool has_labels_;
+  bool output_bbox_indices_ = false;
+
+  BatchRNG<std::mt19937_64> &rngs_;
+
+  std::vector<SampleState> state_;
+  std::vector<Attempt> attempts_;
+  std::vector<bbox_crop::ReadBoxesDesc<ndim>> read_descs_;
+  std::vector<bbox_crop::CandidateDesc<ndim>> candidate_descs_;
+  std::vector<bbox_crop::OutputDesc<ndim>> output_descs_;
+};
+
+template <>
+RandomBBoxCrop<GPUBackend>::~RandomBBoxCrop() = default;
+
+template <>
+RandomBBoxCrop<GPUBackend>::RandomBBoxCrop(const OpSpec &spec)
+    : OperatorWithRng<GPUBackend>(spec) {}
+
+template <>
+bool RandomBBoxCrop<GPUBackend>::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                           const Workspace &ws) {
+  const auto &boxes = ws.Input<GPUBackend>(0);
+  int num_dims = bbox_crop::GetBoxDims(boxes.shape());
+  if (impl_ == nullptr || impl_ndim_ != num_dims) {
+    VALUE_SWITCH(num_dims, ndim, (2, 3),
+      (impl_ = std::make_unique<RandomBBoxCropImplGPU<ndim>>(&spec_, rng_);),
+      (DALI_FAIL(make_string("Not supported number of dimensions", num_dims));));
+    impl_ndim_ = num_dims;
+  }
+  return impl_->SetupImpl(output_desc, ws);
+}
+
+template <>
+void RandomBBoxCrop<GPUBackend>::RunImpl(Workspace &ws) {
+  assert(impl_ != nullptr);
+  impl_->RunImpl(ws);
+}
+
+DALI_REGISTER_OPERATOR(RandomBBoxCrop, RandomBBoxCrop<GPUBackend>, GPU);
+
+}  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,10 +16,13 @@
 #define DALI_OPERATORS_IMAGE_CROP_BBOX_CROP_H_
 
 #include <memory>
+#include <random>
+#include <string>
 #include <vector>
 #include "dali/pipeline/operator/common.h"
 #include "dali/pipeline/operator/operator.h"
 #include "dali/operators/random/rng_base_cpu.h"
+#include "dali/operators/random/rng_checkpointing_utils.h"
 #include "dali/pipeline/util/operator_impl_utils.h"
 
 namespace dali {
@@ -30,6 +33,25 @@ class RandomBBoxCrop : public rng::OperatorWithRng<Backend> {
   explicit inline RandomBBoxCrop(const OpSpec &spec);
   ~RandomBBoxCrop() override;
 
+  // The crop windows are generated on the host with `rng_`, regardless of the backend
+  using RngCheckpointUtils = rng::RngCheckpointUtils<CPUBackend, BatchRNG<std::mt19937_64>>;
+
+  void SaveState(OpCheckpoint &cpt, AccessOrder order) override {
+    RngCheckpointUtils::SaveState(cpt, order, this->rng_);
+  }
+
+  void RestoreState(const OpCheckpoint &cpt) override {
+    RngCheckpointUtils::RestoreState(cpt, this->rng_);
+  }
+
+  std::string SerializeCheckpoint(const OpCheckpoint &cpt) const override {
+    return RngCheckpointUtils::SerializeCheckpoint(cpt);
+  }
+
+  void DeserializeCheckpoint(OpCheckpoint &cpt, const std::string &data) const override {
+    RngCheckpointUtils::DeserializeCheckpoint(cpt, data);
+  }
+
  protected:
   bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override;
   void RunImpl(Workspace &ws) override;
@@ -0,0 +1,522 @@
+// Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_IMAGE_CROP_BBOX_CROP_PARAMS_H_
+#define DALI_OPERATORS_IMAGE_CROP_BBOX_CROP_PARAMS_H_
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/core/error_handling.h"
+#include "dali/core/geom/box.h"
+#include "dali/pipeline/data/views.h"
+#include "dali/pipeline/operator/op_spec.h"
+#include "dali/pipeline/util/bounding_box_utils.h"
+#include "dali/pipeline/workspace/workspace.h"
+
+namespace dali {
+
+/**
+ * @brief The parts of RandomBBoxCrop shared by the CPU and GPU implementations
+ */
+namespace bbox_crop {
+
+// This is the default shape layout that the operator uses internally
+inline TensorLayout InternalShapeLayout(int ndim) {
+  assert(ndim == 3 || ndim == 2);
+  return ndim == 3 ? "WHD" : "WH";
+}
+
+template <int ndim>
+void CollectShape(std::vector<i64vec<ndim>> &v,
+                  const std::string &name,
+                  const OpSpec& spec,
+                  const Workspace &ws,
+                  span<const int> perm) {
+  int batch_size = spec.GetArgument<int>("max_batch_size");
+  v.clear();
+  v.reserve(batch_size);
+
+  i64vec<ndim> sample_sh;
+  if (spec.HasTensorArgument(name)) {
+    auto arg_view = view<const int>(ws.ArgumentInput(name));
+    DALI_ENFORCE(arg_view.num_samples() == batch_size, make_string(
+      "Unexpected number of samples in argument `", name, "`: ", arg_view.num_samples(),
+      ", expected: ", batch_size));
+
+    for (int sample = 0; sample < batch_size; sample++) {
+      auto shape_len = volume(arg_view.tensor_shape(sample));
+      DALI_ENFORCE(shape_len == ndim, make_string(
+        "Unexpected number of elements in argument `", name, "`: ", shape_len,
+        ", expected: ", ndim));
+      permute(sample_sh, arg_view.tensor_data(sample), perm);
+
+      DALI_ENFORCE(all_coords(sample_sh >= 0),
+                   make_string("``", name,
+                               "`` argument should contain non negative values. Got: ", sample_sh));
+
+      v.push_back(sample_sh);
+    }
+  } else if (spec.HasArgument(name)) {
+    auto tmp = spec.GetRepeatedArgument<int>(name);
+    DALI_ENFORCE(static_cast<int>(tmp.size()) == ndim,
+                 make_string("Argument `", name, "` must be a ", ndim, "D vector. Got ", tmp.size(),
+                             " elements."));
+    permute(sample_sh, tmp, perm);
+
+    DALI_ENFORCE(all_coords(sample_sh >= 0),
+                 make_string("``", name,
+                             "`` argument should contain non negative values. Got: ", sample_sh));
+
+    v.resize(batch_size, sample_sh);
+  } else {
+    DALI_FAIL(make_string("Argument `", name, "` was not found"));
+  }
+}
+
+struct SampleOption {
+  bool no_crop = false;
+  float threshold = 0.0f;
+};
+
+struct Range {
+  bool Contains(float k) const {
+    assert(min <= max);
+    return k >= min && k <= max;
+  }
+  float min = 0.0f, max = 0.0f;
+};
+
+enum class OverlapMetric {
+  IoU = 1,
+  Overlap = 2
+};
+
+enum class BoxPruneMethod {
+  Centroid,
+  RelativeThresh
+};
+
+/**
+ * @brief Calculates the overlap metric of a box with a crop window
+ */
+template <int ndim>
+DALI_HOST_DEV inline float CropOverlap(OverlapMetric metric, const Box<ndim, float> &crop,
+                                       const Box<ndim, float> &box) {
+  if (metric == OverlapMetric::Overlap)
+    return volume(intersection(crop, box)) / static_cast<float>(volume(box));
+  else
+    return intersection_over_union(crop, box);
+}
+
+/**
+ * @brief Tells whether a box is kept (not pruned) in a crop window
+ */
+template <int ndim>
+DALI_HOST_DEV inline bool KeepBox(BoxPruneMethod method, float prune_threshold,
+                                  const Box<ndim, float> &crop, const Box<ndim, float> &box) {
+  if (method == BoxPruneMethod::Centroid) {
+    return crop.contains(box.centroid());
+  } else {  // method == BoxPruneMethod::RelativeThresh
+    const float intersec = volume(intersection(crop, box));
+    return intersec != 0.0f && intersec / volume(box) >= prune_threshold;
+  }
+}
+
+/**
+ * @brief Validates the shape of the bounding box input and returns the dimensionality of the boxes
+ */
+inline int GetBoxDims(const TensorListShape<> &tl_shape) {
+  DALI_ENFORCE(tl_shape.sample_dim() == 2, make_string(
+    "Unexpected number of dimensions for bounding boxes input: ", tl_shape.sample_dim()));
+  // first dim is number of boxes, second is number of coordinates on each box
+  auto ncoords = tl_shape[0][1];  // first sample, second dimension
+  for (int sample = 0; sample < tl_shape.num_samples(); sample++) {
+    auto sh = tl_shape[sample];
+    DALI_ENFORCE(sh[1] == ncoords,
+      make_string("Unexpected number of coordinates for sample ", sample, ". Expected ",
+                  ncoords, ", got ", sh[1]));
+  }
+  DALI_ENFORCE(ncoords % 2 == 0,
+    make_string("Unexpected number of coordinates for bounding boxes: ", ncoords));
+  auto num_dims = ncoords / 2;
+
+  DALI_ENFORCE(num_dims == 2 || num_dims == 3,
+    make_string("Unexpected number of dimensions: ", num_dims));
+  return num_dims;
+}
+
+/**
+ * @brief A candidate crop window
+ */
+template <int ndim>
+struct CropCandidate {
+  /// The crop window in relative coordinates - used for evaluating the boxes
+  Box<ndim, float> rel_crop;
+  /// The crop window, as returned by the operator (absolute, if `crop_shape` is used)
+  Box<ndim, float> out_crop;
+  /// False, if the candidate was rejected because of its aspect ratio
+  bool valid = false;
+};
+
+/**
+ * @brief Parses and validates the arguments of RandomBBoxCrop and generates candidate crop windows
+ *
+ * The candidates are generated on the host, so both implementations draw the same
+ * random numbers for a given seed.
+ */
+template <int ndim>
+class RandomBBoxCropParams {
+ public:
+  explicit RandomBBoxCropParams(const OpSpec &spec)
+      : num_attempts_{spec.GetArgument<int>("num_attempts")},
+        has_crop_shape_(spec.ArgumentDefined("crop_shape")),
+        has_input_shape_(spec.ArgumentDefined("input_shape")),
+        bbox_layout_(spec.GetArgument<TensorLayout>("bbox_layout")),
+        shape_layout_(spec.GetArgument<TensorLayout>("shape_layout")),
+        all_boxes_above_threshold_(spec.GetArgument<bool>("all_boxes_above_threshold")) {
+    auto scaling_arg = spec.GetRepeatedArgument<float>("scaling");
+    DALI_ENFORCE(scaling_arg.size() == 2,
+                 make_string("`scaling` must be a range `[min, max]`. Got ",
+                             scaling_arg.size(), " values"));
+    scale_range_.min = scaling_arg[0];
+    scale_range_.max = scaling_arg[1];
+    DALI_ENFORCE(
+        scale_range_.min >= 0 && scale_range_.min <= scale_range_.max,
+        make_string("`scaling` range must be positive and min <= max. Got: ", scale_range_.min,
+                    ", ", scale_range_.max));
+
+    if (spec.ArgumentDefined("bbox_prune_threshold")) {
+      box_prune_method_ = BoxPruneMethod::RelativeThresh;
+      bbox_prune_threshold_ = spec.GetArgument<float>("bbox_prune_threshold");
+      DALI_ENFORCE(0 <= bbox_prune_threshold_ && bbox_prune_threshold_ <= 1.f,
+        make_string("`bbox_prune_threshold` must be in range `[0.0,1.0]`. Got: ",
+                    bbox_prune_threshold_));
+    }
+
+    auto aspect_ratio_arg = spec.GetRepeatedArgument<float>("aspect_ratio");
+    DALI_ENFORCE(aspect_ratio_arg.size() == 2 || aspect_ratio_arg.size() == 6,
+        make_string(
+            "`aspect_ratio` range argument should have 2 elements, or 6 elements in case of "
+            "3D bounding boxes. Got ",
+            aspect_ratio_arg.size(), " elements"));
+    aspect_ratio_ranges_.resize(aspect_ratio_arg.size() / 2);
+    int k = 0;
+    for (auto &range : aspect_ratio_ranges_) {
+      range.min = aspect_ratio_arg[k++];
+      range.max = aspect_ratio_arg[k++];
+      DALI_ENFORCE(range.min >= 0 && range.min <= range.max,
+                   make_string("`aspect_ratio` range must be positive and min <= max. Got: ",
+                               range.min, ", ", range.max));
+    }
+
+    if (has_crop_shape_) {
+      DALI_ENFORCE(has_input_shape_,
+        "``input_shape`` must be provided when providing ``crop_shape``");
+    }
+
+    if (spec.ArgumentDefined("ltrb")) {
+      if (spec.ArgumentDefined("bbox_layout")) {
+        DALI_FAIL(
+            "`ltrb` and `bbox_layout` can't be provided at the same time. `ltrb` was deprecated in "
+            "favor of `bbox_layout`.");
+      }
+      DALI_WARN(
+          "WARNING: `ltrb` is deprecated. Please use `bbox_layout` to specify the format of the "
+          "bounding box. E.g. For 2D bounding boxes, `ltrb=True`` is equivalent to "
+          "`bbox_layout=\"xyXY\"`, and `ltrb=False` is equivalent to `bbox_layout=\"xyWH\"`");
+    }
+
+    bool allow_no_crop = spec.GetArgument<bool>("allow_no_crop");
+    if (has_crop_shape_) {
+      // If it was left default but a crop_shape was provided, disallow no crop silently
+      if (!spec.HasArgument("allow_no_crop")) {
+        DALI_WARN("Using explicit `crop_shape`, `allow_no_crop` will not take effect.");
+        allow_no_crop = false;
+      }
+
+      DALI_ENFORCE(!allow_no_crop,
+                   "`allow_no_crop` is incompatible with providing the crop shape explicitly");
+      DALI_ENFORCE(!spec.HasArgument("aspect_ratio"),
+                   "`aspect_ratio` is incompatible with providing the crop shape explicitly");
+      DALI_ENFORCE(!spec.HasArgument("scaling"),
+                   "`scaling` is incompatible with providing the crop shape explicitly");
+    }
+
+    auto thresholds = spec.GetRepeatedArgument<float>("thresholds");
+    DALI_ENFORCE(!thresholds.empty(),
+      "At least one threshold value must be provided");
+    DALI_ENFORCE(num_attempts_ > 0,
+      "Minimum number of attempts must be greater than zero");
+    for (const auto &threshold : thresholds) {
+      DALI_ENFORCE(0.0 <= threshold && threshold <= 1.0,
+        make_string("Threshold value must be within the range [0.0, 1.0]. Received: ", threshold));
+      sample_options_.push_back({false, threshold});
+    }
+
+    if (spec.HasArgument("threshold_type")) {
+      auto threshold_type = spec.GetArgument<std::string>("threshold_type");
+      if (threshold_type == "iou") {
+        overlap_metric_ = OverlapMetric::IoU;
+      } else  if (threshold_type == "overlap") {
+        overlap_metric_ = OverlapMetric::Overlap;
+      } else {
+        DALI_FAIL(make_string("Not supported ``threshold_type`` value: \"", threshold_type,
+                              "\". Supported values are: \"iou\", \"overlap\"."));
+      }
+    }
+
+    if (allow_no_crop) {
+      sample_options_.push_back({true, 0.0f});
+    }
+
+    total_num_attempts_ = -1;
+    if (spec.HasArgument("total_num_attempts")) {
+      total_num_attempts_ = spec.GetArgument<int>("total_num_attempts");
+      DALI_ENFORCE(total_num_attempts_ > 0,
+        "Minimum total number of attempts must be greater than zero");
+    }
+
+    auto default_bbox_layout_start_end = DefaultBBoxLayout<ndim>();
+    auto default_bbox_layout_start_shape = DefaultBBoxAnchorAndShapeLayout<ndim>();
+    if (bbox_layout_.empty()) {
+      auto ltrb = spec.GetArgument<bool>("ltrb");
+      bbox_layout_ = ltrb ? default_bbox_layout_start_end : default_bbox_layout_start_shape;
+    }
+    DALI_ENFORCE(bbox_layout_.is_permutation_of(default_bbox_layout_start_end) ||
+                 bbox_layout_.is_permutation_of(default_bbox_layout_start_shape),
+      make_string("`bbox_layout` should be a permutation of `", default_bbox_layout_start_end,
+                  "` or `", default_bbox_layout_start_shape, "`. Got: `", bbox_layout_, "`"));
+  }
+
+  /**
+   * @brief Acquires the per-sample crop and input shapes
+   */
+  void Setup(const OpSpec &spec, const Workspace &ws) {
+    if (has_input_shape_ || has_crop_shape_) {
+      // Converting the shapes to "WHD" or "WH" if necessary
+      auto default_shape_layout = InternalShapeLayout(ndim);
+      const TensorLayout &layout = shape_layout_.empty() ? default_shape_layout : shape_layout_;
+      if (!shape_layout_.empty() && shape_layout_ != default_shape_layout) {
+        DALI_ENFORCE(shape_layout_.is_permutation_of(default_shape_layout),
+                     make_string("`shape_layout` should be a permutation of ", default_shape_layout,
+                                 "` for the provided inputs"));
+      }
+      auto perm = GetDimIndices(layout, default_shape_layout);
+      if (has_crop_shape_)
+        CollectShape(crop_shape_, "crop_shape", spec, ws, make_cspan(perm));
+      if (has_input_shape_)
+        CollectShape(input_shape_, "input_shape", spec, ws, make_cspan(perm));
+    }
+  }
+
+  /**
+   * @brief Draws the option for the next round of `num_attempts()` attempts
+   */
+  SampleOption DrawOption(std::mt19937_64 &rng) const {
+    std::uniform_int_distribution<> idx_dist(0, sample_options_.size() - 1);
+    return sample_options_[idx_dist(rng)];
+  }
+
+  /**
+   * @brief The crop window which covers the whole input
+   */
+  Box<ndim, float> NoCropWindow(int sample) const {
+    Box<ndim, float> no_crop = Uniform<ndim>(0.0f, 1.0f);
+    if (has_crop_shape_) {
+      auto &input_shape = input_shape_[sample];
+      for (int d = 0; d < ndim; d++)
+        no_crop.hi[d] *= input_shape[d];
+    }
+    return no_crop;
+  }
+
+  /**
+   * @brief Generates a candidate crop window for a single attempt
+   */
+  CropCandidate<ndim> GenerateCandidate(int sample, std::mt19937_64 &rng) const {
+    CropCandidate<ndim> candidate;
+    auto &rel_crop = candidate.rel_crop;
+    auto &out_crop = candidate.out_crop;
+    vec<ndim> shape, anchor;
+    if (has_crop_shape_) {
+      auto &crop_shape = crop_shape_[sample];
+      auto &input_shape = input_shape_[sample];
+
+      for (int d = 0; d < ndim; d++) {
+        shape[d] = static_cast<float>(crop_shape[d]);
+        out_crop.hi[d] = shape[d];
+        rel_crop.hi[d] = shape[d] / input_shape[d];
+      }
+
+      for (int d = 0; d < ndim; d++) {
+        auto diff = input_shape[d] - crop_shape[d];
+        if (diff > 0) {
+          anchor[d] = static_cast<float>(
+              std::uniform_int_distribution<>(0, diff)(rng));
+        } else if (diff < 0) {
+          anchor[d] = static_cast<float>(
+              std::uniform_int_distribution<>(diff, 0)(rng));
+        } else {
+          anchor[d] = 0.0f;
+        }
+        out_crop.lo[d] = anchor[d];
+        rel_crop.lo[d] = anchor[d] / input_shape[d];
+      }
+      out_crop.hi += out_crop.lo;
+      rel_crop.hi += rel_crop.lo;
+    } else {  // relative dimensions
+      std::uniform_real_distribution<float> extent_dist(scale_range_.min, scale_range_.max);
+      for (int d = 0; d < ndim; d++) {
+        shape[d] = extent_dist(rng);
+      }
+
+      // If input shape is provided, we take it into account for the aspect ratio range check
+      // Otherwise, we use the relative shape for aspect ratio check
+      vec<ndim> tmp_sh = has_input_shape_ ? shape * input_shape_[sample] : shape;
+
+      bool fixed_ar = FixAspectRatios(tmp_sh);
+
+      if (!ValidAspectRatio(tmp_sh))
+        return candidate;
+
+      if (fixed_ar) {
+        shape = has_input_shape_ ? tmp_sh / input_shape_[sample] : tmp_sh;
+      }
+
+      for (int d = 0; d < ndim; d++) {
+        std::uniform_real_distribution<float> anchor_dist(0.0f, 1.0f - shape[d]);
+        anchor[d] = anchor_dist(rng);
+        rel_crop.lo[d] = anchor[d];
+        rel_crop.hi[d] = anchor[d] + shape[d];
+      }
+      out_crop = rel_crop;
+    }
+    candidate.valid = true;
+    return candidate;
+  }
+
+  int num_attempts() const { return num_attempts_; }
+  int total_num_attempts() const { return total_num_attempts_; }
+  const TensorLayout &bbox_layout() const { return bbox_layout_; }
+  OverlapMetric overlap_metric() const { return overlap_metric_; }
+  BoxPruneMethod box_prune_method() const { return box_prune_method_; }
+  float bbox_prune_threshold() const { return bbox_prune_threshold_; }
+  bool all_boxes_above_threshold() const { return all_boxes_above_threshold_; }
+
+ private:
+  /**
+   * @brief Fixes shape dimensions to follow aspect ratio constraints in case of ar_min == ar_max
+   * @remarks The dimensions are fixed on a random order
+   * @return true if the shape was modified, false otherwise
+   */
+  bool FixAspectRatios(vec<ndim>& shape) const {
+    // If aspect ratio is fixed, fix the required dimensions
+    std::array<float, ndim*ndim> fixed_aspect_ratios;
+    int k = 0;
+
+    bool need_fix = false;
+    for (int d0 = 0; d0 < ndim; d0++) {
+      for (int d1 = d0 + 1; d1 < ndim; d1++) {
+        // to be used later when min==max
+        if (aspect_ratio_ranges_[k].min == aspect_ratio_ranges_[k].max) {
+          fixed_aspect_ratios[d0*ndim+d1] = aspect_ratio_ranges_[k].min;
+          fixed_aspect_ratios[d1*ndim+d0] = 1.0 / aspect_ratio_ranges_[k].min;
+          need_fix = true;
+        } else {
+          fixed_aspect_ratios[d0*ndim+d1] = 0.0f;
+          fixed_aspect_ratios[d1*ndim+d0] = 0.0f;
+        }
+        k = (k + 1) % aspect_ratio_ranges_.size();
+      }
+    }
+
+    if (!need_fix)
+      return false;
+
+    std::array<int, ndim> order;
+    std::iota(order.begin(), order.end(), 0);
+    std::random_shuffle(order.begin(), order.end());
+
+    float max_extent = 0.0f;
+    for (int d = 0; d < ndim; d++) {
+      max_extent = std::max(max_extent, shape[d]);
+    }
+
+    for (int i0 = 0; i0 < ndim; i0++) {
+      for (int i1 = i0 + 1; i1 < ndim; i1++) {
+        int d0 = order[i0], d1 = order[i1];
+        auto fixed_ar = fixed_aspect_ratios[d1*ndim+d0];
+        if (fixed_ar > 0) {
+          shape[d1] = shape[d0] * fixed_ar;
+        }
+      }
+    }
+
+    // Re-scale so that largest extent matches the previous max extent
+    float new_max_extent = 0.0;
+    for (int d = 0; d < ndim; d++)
+      new_max_extent = std::max(new_max_extent, shape[d]);
+
+    for (auto &extent : shape)
+      extent = max_extent * extent / new_max_extent;
+
+    return true;
+  }
+
+  bool ValidAspectRatio(vec<ndim> shape) const {
+    assert(static_cast<int>(shape.size()) == ndim);
+    int k = 0;
+    assert(!aspect_ratio_ranges_.empty());
+    for (int i = 0; i < ndim; i++) {
+      for (int j = i + 1; j < ndim; j++) {
+        if (!aspect_ratio_ranges_[k].Contains(shape[i] / shape[j]))
+          return false;
+        k = (k + 1) % aspect_ratio_ranges_.size();
+      }
+    }
+    return true;
+  }
+
+  int num_attempts_;
+  int total_num_attempts_;
+  bool has_crop_shape_;
+  bool has_input_shape_;
+
+  TensorLayout bbox_layout_;
+  TensorLayout shape_layout_;
+
+  OverlapMetric overlap_metric_ = OverlapMetric::IoU;
+  BoxPruneMethod box_prune_method_ = BoxPruneMethod::Centroid;
+  bool all_boxes_above_threshold_ = true;
+  float bbox_prune_threshold_ = 0.0f;
+
+  std::vector<SampleOption> sample_options_;
+
+  std::vector<i64vec<ndim>> crop_shape_;
+  std::vector<i64vec<ndim>> input_shape_;
+
+  Range scale_range_;
+  std::vector<Range> aspect_ratio_ranges_;
+};
+
+}  // namespace bbox_crop
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_IMAGE_CROP_BBOX_CROP_PARAMS_H_
@@ -39,6 +39,7 @@ Normalization takes the input images and produces the output by using the follow
                    "FDHWC", "FCDHW", "CFDHW"})
   .AllowSequences()
   .SupportVolumetric()
+  .Stateless()
   .AddOptionalArg<DALIImageType>("image_type", "Image type", nullptr)
   .DeprecateArg("image_type")  // deprecated since 0.24dev
   .AddOptionalTypeArg("dtype",
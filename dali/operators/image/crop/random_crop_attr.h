@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -21,6 +21,9 @@
 #include <vector>
 #include "dali/core/common.h"
 #include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/core/span.h"
+#include "dali/core/tensor_shape.h"
 #include "dali/pipeline/operator/common.h"
 #include "dali/pipeline/operator/operator.h"
 #include "dali/util/crop_window.h"
@@ -55,23 +58,50 @@ class RandomCropAttr {
 
     random_crop_generators_.reserve(max_batch_size);
     for (int i = 0; i < max_batch_size; i++) {
-      random_crop_generators_.push_back(
-        std::make_shared<RandomCropGenerator>(
+      random_crop_generators_.emplace_back(
           AspectRatioRange{aspect_ratio[0], aspect_ratio[1]},
-          AreaRange{area[0], area[1]}, seeds[i], num_attempts));
+          AreaRange{area[0], area[1]}, seeds[i], num_attempts);
     }
   }
 
   CropWindowGenerator GetCropWindowGenerator(std::size_t idx) const {
     return [idx, this](const TensorShape<>& shape, const TensorLayout&) {
-      return random_crop_generators_[idx]->GenerateCropWindow(shape);
+      return random_crop_generators_[idx].GenerateCropWindow(shape);
     };
   }
 
+  /**
+   * @brief Generates the crop windows for the whole batch
+   *
+   * Only the shapes are needed, so the windows can be obtained before the data is available
+   * (e.g. from the image headers, before decoding). Each sample uses its own generator - the
+   * result is the same as calling the generator returned by GetCropWindowGenerator for each
+   * sample, without the overhead of a type-erased call per sample.
+   *
+   * @param out         the crop windows, one per sample
+   * @param shape       the shapes of the samples
+   * @param height_idx  the index of the height dimension in the sample shape
+   * @param width_idx   the index of the width dimension in the sample shape
+   */
+  void GenerateCropWindows(span<CropWindow> out, const TensorListShape<> &shape,
+                           int height_idx, int width_idx) {
+    int N = shape.num_samples();
+    DALI_ENFORCE(out.size() == N, "The number of crop windows must match the number of samples");
+    DALI_ENFORCE(N <= static_cast<int>(random_crop_generators_.size()), make_string(
+        "The batch size (", N, ") exceeds the maximum batch size (",
+        random_crop_generators_.size(), ")."));
+    for (int i = 0; i < N; i++) {
+      auto sample_shape = shape.tensor_shape_span(i);
+      out[i] = random_crop_generators_[i].GenerateCropWindow(
+          {sample_shape[height_idx], sample_shape[width_idx]});
+    }
+  }
+
   std::vector<std::mt19937> RNGSnapshot() {
     std::vector<std::mt19937> rngs;
+    rngs.reserve(random_crop_generators_.size());
     for (const auto &gen : random_crop_generators_)
-      rngs.push_back(gen->GetRNG());
+      rngs.push_back(gen.GetRNG());
     return rngs;
   }
 
@@ -79,11 +109,12 @@ class RandomCropAttr {
     DALI_ENFORCE(rngs.size() == random_crop_generators_.size(),
                  "Snapshot size does not match the number of generators. ");
     for (size_t i = 0; i < rngs.size(); i++)
-      random_crop_generators_[i]->SetRNG(rngs[i]);
+      random_crop_generators_[i].SetRNG(rngs[i]);
   }
 
  private:
-  std::vector<std::shared_ptr<RandomCropGenerator>> random_crop_generators_;
+  // mutable - the generators returned by the const GetCropWindowGenerator advance the RNGs
+  mutable std::vector<RandomCropGenerator> random_crop_generators_;
 };
 
 }  // namespace dali
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <optional>
+#include <vector>
 #include <nvcv/Image.hpp>
 #include <nvcv/ImageBatch.hpp>
 #include <nvcv/Tensor.hpp>
@@ -25,6 +26,7 @@
 #include "dali/pipeline/operator/operator.h"
 #include "dali/pipeline/operator/arg_helper.h"
 
+#include "dali/operators/image/filter/rank_filter.h"
 #include "dali/operators/nvcvop/nvcvop.h"
 
 namespace dali {
@@ -68,6 +70,9 @@ class MedianBlur : public nvcvop::NVCVSequenceOperator<StatelessOperator> {
     auto &output = ws.Output<GPUBackend>(0);
     output.SetLayout(input.GetLayout());
 
+    if (RunNative(ws))
+      return;
+
     kernels::DynamicScratchpad scratchpad({}, AccessOrder(ws.stream()));
     auto ksize = AcquireTensorArgument<int32_t>(ws, scratchpad, ksize_arg_,
                                                 TensorShape<1>(2),
@@ -83,10 +88,23 @@ class MedianBlur : public nvcvop::NVCVSequenceOperator<StatelessOperator> {
   }
 
  private:
+  /** Runs the native kernel, which handles the common 3x3 and 5x5 windows. */
+  bool RunNative(Workspace &ws) {
+    int nsamples = ws.GetInputBatchSize(0);
+    ksize_arg_.Acquire(spec_, ws, nsamples, TensorShape<1>(2));
+    windows_.resize(nsamples);
+    for (int s = 0; s < nsamples; s++)
+      windows_[s] = ivec2(ksize_arg_[s].data[0], ksize_arg_[s].data[1]);
+    anchors_.resize(nsamples, ivec2(-1, -1));
+    return RunNativeRankFilter(ws, kernels::RankFilterType::Median, make_cspan(windows_),
+                               make_cspan(anchors_), boundary::BoundaryType::CLAMP);
+  }
+
   USE_OPERATOR_MEMBERS();
   ArgValue<int, 1> ksize_arg_{"window_size", spec_};
   int op_batch_size_ = 0;
   std::optional<cvcuda::MedianBlur> median_blur_{};
+  std::vector<ivec2> windows_, anchors_;
 };
 
 DALI_REGISTER_OPERATOR(experimental__MedianBlur, MedianBlur, GPU);
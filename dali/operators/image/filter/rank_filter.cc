@@ -0,0 +1,62 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/image/filter/rank_filter.h"
+#include "dali/core/static_switch.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/pipeline/data/views.h"
+
+namespace dali {
+
+bool RunNativeRankFilter(Workspace &ws, kernels::RankFilterType type, span<const ivec2> windows,
+                         span<const ivec2> anchors, boundary::BoundaryType border) {
+  using Kernel = kernels::RankFilterGPU<uint8_t>;
+  const auto &input = ws.Input<GPUBackend>(0);
+  auto &output = ws.Output<GPUBackend>(0);
+  int nsamples = input.num_samples();
+  int ndim = input.sample_dim();
+  if (ndim != 2 && !(ndim == 3 && input.GetLayout().find('C') == 2))
+    return false;
+  if (type == kernels::RankFilterType::Median && border == boundary::BoundaryType::CONSTANT)
+    return false;
+
+  const auto &in_shape = input.shape();
+  TensorListShape<3> shape(nsamples);
+  for (int s = 0; s < nsamples; s++) {
+    auto sample_shape = in_shape.tensor_shape_span(s);
+    int channels = ndim == 3 ? sample_shape[2] : 1;
+    if (!Kernel::IsSupported(type, windows[s], channels))
+      return false;
+    for (int d = 0; d < 2; d++) {
+      if (anchors[s][d] >= windows[s][d])
+        return false;
+    }
+    shape.set_tensor_shape(s, TensorShape<3>(sample_shape[0], sample_shape[1], channels));
+  }
+
+  bool supported = false;
+  TYPE_SWITCH(input.type(), type2id, T, (uint8_t, uint16_t, int16_t, float), (
+    kernels::DynamicScratchpad scratchpad({}, AccessOrder(ws.stream()));
+    kernels::KernelContext ctx;
+    ctx.gpu.stream = ws.stream();
+    ctx.scratchpad = &scratchpad;
+    auto in_view = reshape<3>(view<const T>(input), shape);
+    auto out_view = reshape<3>(view<T>(output), shape);
+    kernels::RankFilterGPU<T>().Run(ctx, out_view, in_view, type, windows, anchors, border);
+    supported = true;
+  ), ());  // NOLINT
+  return supported;
+}
+
+}  // namespace dali
@@ -0,0 +1,43 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_IMAGE_FILTER_RANK_FILTER_H_
+#define DALI_OPERATORS_IMAGE_FILTER_RANK_FILTER_H_
+
+#include "dali/core/boundary.h"
+#include "dali/core/geom/vec.h"
+#include "dali/core/span.h"
+#include "dali/kernels/imgproc/convolution/rank_filter_gpu.h"
+#include "dali/pipeline/workspace/workspace.h"
+
+namespace dali {
+
+/**
+ * @brief Runs the native rank filter (median, erosion or dilation) on the images in the GPU
+ *        workspace, if the kernel supports all of them.
+ *
+ * The images must be HW or HWC (i.e. the channels and frames of the other layouts need to be
+ * expanded). The small windows (see RankFilterGPU::IsSupported) are handled by the native kernel,
+ * which is faster than the general CV-CUDA implementation.
+ *
+ * @param windows (width, height) of the window, per sample
+ * @param anchors position of the output pixel in the window, per sample; -1 stands for the center
+ * @return false if the native implementation cannot handle the batch; nothing is run then.
+ */
+bool RunNativeRankFilter(Workspace &ws, kernels::RankFilterType type, span<const ivec2> windows,
+                         span<const ivec2> anchors, boundary::BoundaryType border);
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_IMAGE_FILTER_RANK_FILTER_H_
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -29,6 +29,7 @@ consists of squares repeating in x and y directions, with the same spacing in
 both directions. Can be rotated around the origin.)code")
     .NumInput(1)
     .NumOutput(1)
+    .InPlace(0, 0)
     .AddOptionalArg("tile", R"code(The length of a single tile, which is equal to
 width of black squares plus the spacing between them.)code",
                     100, true)
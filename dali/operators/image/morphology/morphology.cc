@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "dali/operators/image/morphology/morphology.h"
+#include <optional>
+#include "dali/operators/image/filter/rank_filter.h"
 
 namespace dali {
 
@@ -29,6 +31,9 @@ void Morphology::RunImpl(Workspace &ws) {
   auto &output = ws.Output<GPUBackend>(0);
   output.SetLayout(input.GetLayout());
 
+  if (RunNative(ws))
+    return;
+
   kernels::DynamicScratchpad scratchpad({}, AccessOrder(ws.stream()));
   auto mask = AcquireTensorArgument<int32_t>(ws, scratchpad, mask_arg_,
                                              TensorShape<1>(2), nvcvop::GetDataType<int32_t>(2));
@@ -50,6 +55,45 @@ void Morphology::RunImpl(Workspace &ws) {
      border_mode_);
 }
 
+namespace {
+
+std::optional<boundary::BoundaryType> ToBoundaryType(NVCVBorderType border_mode) {
+  switch (border_mode) {
+    case NVCV_BORDER_CONSTANT:
+      return boundary::BoundaryType::CONSTANT;
+    case NVCV_BORDER_REPLICATE:
+      return boundary::BoundaryType::CLAMP;
+    case NVCV_BORDER_REFLECT:
+      return boundary::BoundaryType::REFLECT_1001;
+    case NVCV_BORDER_REFLECT101:
+      return boundary::BoundaryType::REFLECT_101;
+    case NVCV_BORDER_WRAP:
+      return boundary::BoundaryType::WRAP;
+    default:
+      return std::nullopt;
+  }
+}
+
+}  // namespace
+
+bool Morphology::RunNative(Workspace &ws) {
+  auto border = ToBoundaryType(border_mode_);
+  if (iteration_ != 1 || !border)
+    return false;
+  int nsamples = ws.GetInputBatchSize(0);
+  mask_arg_.Acquire(spec_, ws, nsamples, TensorShape<1>(2));
+  anchor_arg_.Acquire(spec_, ws, nsamples, TensorShape<1>(2));
+  windows_.resize(nsamples);
+  anchors_.resize(nsamples);
+  for (int s = 0; s < nsamples; s++) {
+    windows_[s] = ivec2(mask_arg_[s].data[0], mask_arg_[s].data[1]);
+    anchors_[s] = ivec2(anchor_arg_[s].data[0], anchor_arg_[s].data[1]);
+  }
+  auto type = morph_type_ == NVCVMorphologyType::NVCV_ERODE ? kernels::RankFilterType::Min
+                                                            : kernels::RankFilterType::Max;
+  return RunNativeRankFilter(ws, type, make_cspan(windows_), make_cspan(anchors_), *border);
+}
+
 DALI_SCHEMA(Morphology)
   .AddOptionalArg("mask_size", "Size of the structuring element.",
                   std::vector<int32_t>({3, 3}), true, true)
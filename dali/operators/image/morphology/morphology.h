@@ -22,6 +22,7 @@
 #include <nvcv/DataType.hpp>
 #include <nvcv/Tensor.hpp>
 
+#include "dali/core/geom/vec.h"
 #include "dali/operators/nvcvop/nvcvop.h"
 #include "dali/kernels/dynamic_scratchpad.h"
 #include "dali/pipeline/operator/arg_helper.h"
@@ -49,6 +50,13 @@ class Morphology : public nvcvop::NVCVSequenceOperator<StatelessOperator> {
 
   void RunImpl(Workspace &ws) override;
 
+  /**
+   * @brief Runs the native kernel, if it supports the batch - the masks up to 5x5, applied once.
+   *
+   * @return false, if CV-CUDA needs to be used
+   */
+  bool RunNative(Workspace &ws);
+
   USE_OPERATOR_MEMBERS();
   NVCVMorphologyType morph_type_;
   ArgValue<int32_t, 1> mask_arg_{"mask_size", spec_};
@@ -56,6 +64,7 @@ class Morphology : public nvcvop::NVCVSequenceOperator<StatelessOperator> {
   nvcv::ImageBatchVarShape op_workspace_{};
   NVCVBorderType border_mode_{NVCV_BORDER_CONSTANT};
   int32_t iteration_ = 1;
+  std::vector<ivec2> windows_, anchors_;
 };
 
 class Dilate : public Morphology {
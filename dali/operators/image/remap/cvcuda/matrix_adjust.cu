@@ -58,5 +58,26 @@ void adjustMatrices(nvcv::Tensor &matrices, cudaStream_t stream) {
   CUDA_CALL(cudaGetLastError());
 }
 
+__global__ void affineToPerspectiveKernel(mat3 *out, const mat2x3 *const *in, int count) {
+  int tid = blockIdx.x * blockDim.x + threadIdx.x;
+  if (tid >= count) {
+    return;
+  }
+  mat2x3 affine = *in[tid];
+  mat3 matrix = mat3::identity();
+  matrix.set_row(0, affine.row(0));
+  matrix.set_row(1, affine.row(1));
+  out[tid] = matrix;
+}
+
+void affineToPerspective(mat3 *out, const mat2x3 *const *in, int count, cudaStream_t stream) {
+  if (count == 0)
+    return;
+  int num_blocks = div_ceil(count, 256);
+  int threads_per_block = std::min(count, 256);
+  affineToPerspectiveKernel<<<num_blocks, threads_per_block, 0, stream>>>(out, in, count);
+  CUDA_CALL(cudaGetLastError());
+}
+
 }  // namespace warp_perspective
 }  // namespace dali
@@ -28,6 +28,15 @@ namespace warp_perspective {
  */
 void adjustMatrices(nvcv::Tensor &matrices, cudaStream_t stream);
 
+/**
+ * @brief Extends 2x3 affine transforms (as produced by `transforms.*` operators)
+ * to 3x3 perspective matrices.
+ *
+ * @param out    contiguous output matrices (device memory)
+ * @param in     pointers to the input matrices (device memory)
+ */
+void affineToPerspective(mat3 *out, const mat2x3 *const *in, int count, cudaStream_t stream);
+
 }  // namespace warp_perspective
 }  // namespace dali
 
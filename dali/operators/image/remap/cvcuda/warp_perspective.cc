@@ -18,6 +18,7 @@
 #include <nvcv/Tensor.hpp>
 #include <optional>
 #include "dali/core/dev_buffer.h"
+#include "dali/core/small_vector.h"
 #include "dali/core/static_switch.h"
 #include "dali/kernels/common/utils.h"
 #include "dali/kernels/dynamic_scratchpad.h"
@@ -38,9 +39,11 @@ Performs a perspective transform on the images.
     .NumInput(1, 2)
     .InputDox(0, "input", "TensorList of uint8, uint16, int16 or float",
               "Input data. Must be images in HWC or CHW layout, or a sequence of those.")
-    .InputDox(1, "matrix_gpu", "1D TensorList of float",
+    .InputDox(1, "matrix_gpu", "2D TensorList of float",
               "Transformation matrix data. Should be used to pass the GPU data. "
-              "For CPU data, the `matrix` argument should be used.")
+              "For CPU data, the `matrix` argument should be used.\n\n"
+              "The matrices can be 3x3 perspective transforms or 2x3 affine transforms, as "
+              "produced by the GPU variants of ``transforms.*`` operators.")
     .NumOutput(1)
     .InputLayout(0, {"HW", "HWC", "FHWC", "CHW", "FCHW"})
     .AddOptionalArg<float>("size",
@@ -188,13 +191,31 @@ class WarpPerspective : public nvcvop::NVCVSequenceOperator<StatelessOperator> {
       DALI_ENFORCE(!matrix_arg_.HasExplicitValue(),
                    "Matrix input and `matrix` argument should not be provided at the same time.");
       auto &matrix_input = ws.Input<GPUBackend>(1);
-      DALI_ENFORCE(matrix_input.shape() ==
-                     uniform_list_shape(matrix_input.num_samples(), TensorShape<2>(3, 3)),
+      int nsamples = matrix_input.num_samples();
+      bool is_affine = matrix_input.shape() ==
+                       uniform_list_shape(nsamples, TensorShape<2>(2, 3));
+      DALI_ENFORCE(is_affine || matrix_input.shape() ==
+                     uniform_list_shape(nsamples, TensorShape<2>(3, 3)),
                    make_string("Expected a uniform list of 3x3 matrices. "
                                "Instead got data with shape: ",
-                               matrix_input.shape()));
+                               matrix_input.shape(),
+                               ". A uniform list of 2x3 affine transforms is also accepted."));
 
-      matrix_data_.Copy(matrix_input, AccessOrder(ws.stream()));
+      if (is_affine) {
+        // The affine transforms (e.g. from GPU `transforms.*` operators) are extended
+        // with the (0, 0, 1) row on the device.
+        SmallVector<const mat2x3 *, 64> affine;
+        affine.resize(nsamples);
+        for (int i = 0; i < nsamples; i++)
+          affine[i] = static_cast<const mat2x3 *>(matrix_input.raw_tensor(i));
+        matrix_data_.set_order(ws.stream());
+        matrix_data_.Resize(uniform_list_shape(nsamples, TensorShape<2>(3, 3)), DALI_FLOAT);
+        warp_perspective::affineToPerspective(
+            reinterpret_cast<mat3 *>(matrix_data_.mutable_tensor<float>(0)),
+            scratchpad.ToGPU(ws.stream(), affine), nsamples, ws.stream());
+      } else {
+        matrix_data_.Copy(matrix_input, AccessOrder(ws.stream()));
+      }
       Tensor<GPUBackend> matrix_tensor = matrix_data_.AsTensor();
       matrix = nvcvop::AsTensor(matrix_tensor, "NW", TensorShape<2>{input.num_samples(), 9});
     } else {
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -39,7 +39,8 @@ axis.)code", DALI_FLOAT, true, true)
 If set to False (default), and the size is not set, the canvas size is adjusted to
 accommodate the rotated image with the least padding possible.
 )code", false, false)
-  .AddParent("WarpAttr");
+  .AddParent("WarpAttr")
+  .AddParent("RandomArgsAttr");
 
 DALI_REGISTER_OPERATOR(Rotate, Rotate<CPUBackend>, CPU);
 
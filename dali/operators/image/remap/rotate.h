@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,12 +16,14 @@
 #define DALI_OPERATORS_IMAGE_REMAP_ROTATE_H_
 
 #include <memory>
+#include <string>
 #include <vector>
 #include <sstream>
 #include "dali/kernels/imgproc/warp/affine.h"
 #include "dali/kernels/imgproc/warp/mapping_traits.h"
 #include "dali/operators/image/remap/warp.h"
 #include "dali/operators/image/remap/rotate_params.h"
+#include "dali/operators/random/random_args.h"
 
 namespace dali {
 
@@ -29,7 +31,29 @@ template <typename Backend>
 class Rotate : public Warp<Backend, Rotate<Backend>> {
  public:
   using Base = Warp<Backend, Rotate<Backend>>;
-  using Base::Base;
+
+  explicit Rotate(const OpSpec &spec) : Base(spec), random_args_(spec) {}
+
+  bool SetupImpl(std::vector<OutputDesc> &outputs, const Workspace &ws) override {
+    random_args_.Advance();
+    return Base::SetupImpl(outputs, ws);
+  }
+
+  void SaveState(OpCheckpoint &cpt, AccessOrder order) override {
+    random_args_.SaveState(cpt);
+  }
+
+  void RestoreState(const OpCheckpoint &cpt) override {
+    random_args_.RestoreState(cpt);
+  }
+
+  std::string SerializeCheckpoint(const OpCheckpoint &cpt) const override {
+    return random_args_.SerializeCheckpoint(cpt);
+  }
+
+  void DeserializeCheckpoint(OpCheckpoint &cpt, const std::string &data) const override {
+    random_args_.DeserializeCheckpoint(cpt, data);
+  }
 
   template <int ndim>
   using Mapping = kernels::AffineMapping<ndim>;
@@ -39,8 +63,11 @@ class Rotate : public Warp<Backend, Rotate<Backend>> {
 
   template <int spatial_ndim, typename BorderType>
   auto CreateParamProvider() {
-    return std::make_unique<ParamProvider<spatial_ndim, BorderType>>();
+    return std::make_unique<ParamProvider<spatial_ndim, BorderType>>(&random_args_);
   }
+
+ private:
+  RandomArgs random_args_;
 };
 
 }  // namespace dali
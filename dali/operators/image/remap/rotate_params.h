@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -25,6 +25,7 @@
 #include "dali/kernels/imgproc/warp/mapping_traits.h"
 #include "dali/kernels/imgproc/roi.h"
 #include "dali/operators/image/remap/warp_param_provider.h"
+#include "dali/operators/random/random_args.h"
 #include "dali/core/tensor_shape_print.h"
 #include "dali/core/format.h"
 
@@ -99,6 +100,13 @@ inline std::tuple<ivec3, ivec3> RotatedCanvasSize(TensorShape<3> input_shape, ve
 template <typename Backend, int spatial_ndim_, typename BorderType>
 class RotateParamProvider
 : public WarpParamProvider<Backend, spatial_ndim_, RotateParams<spatial_ndim_>, BorderType> {
+ public:
+  /**
+   * @param random_args The random arguments of the operator; must outlive the provider
+   */
+  explicit RotateParamProvider(const RandomArgs *random_args = nullptr)
+  : random_args_(random_args) {}
+
  protected:
   static constexpr int spatial_ndim = spatial_ndim_;
   using MappingParams = RotateParams<spatial_ndim>;
@@ -114,7 +122,10 @@ class RotateParamProvider
 
   void SetParams() override {
     input_shape_ = convert_dim<spatial_ndim + 1>(ws_->template Input<Backend>(0).shape());
-    Collect(angles_, "angle", true);
+    if (random_args_ && random_args_->Has("angle"))
+      random_args_->Draw(angles_, "angle", *sequence_extents_);
+    else
+      Collect(angles_, "angle", true);
 
     // For 2D, assume positive CCW rotation when (0,0) denotes top-left corner.
     // For 3D, we just follow the mathematical formula for rotation around arbitrary axis.
@@ -316,6 +327,7 @@ class RotateParamProvider
     return spec_->template GetArgument<bool>("keep_size");
   }
 
+  const RandomArgs *random_args_ = nullptr;
   std::vector<float> angles_;
   std::vector<vec3> axes_;
   TensorListShape<spatial_ndim + 1> input_shape_;
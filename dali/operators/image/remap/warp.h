@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2022, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -24,6 +24,7 @@
 
 #include "dali/core/static_switch.h"
 #include "dali/core/tuple_helpers.h"
+#include "dali/kernels/common/split_shape.h"
 #include "dali/kernels/imgproc/warp_cpu.h"
 #include "dali/kernels/imgproc/warp_gpu.h"
 #include "dali/kernels/kernel_manager.h"
@@ -108,6 +109,7 @@ class WarpOpImpl : public OpImplInterface<Backend> {
   const OpSpec &spec_;
   kernels::KernelManager kmgr_;
   TensorListShape<> sequence_extents_;
+  std::vector<int64_t> extents_, costs_;
 
   TensorListView<Storage, const InputType, tensor_ndim> input_;
 
@@ -166,20 +168,30 @@ class WarpOpImpl : public OpImplInterface<Backend> {
     ThreadPool &pool = ws.GetThreadPool();
     auto interp_types = param_provider_->InterpTypes();
 
-    for (int i = 0; i < input_.num_samples(); i++) {
-      pool.AddWork([&, i](int tid) {
+    int N = input_.num_samples();
+    extents_.resize(N);
+    costs_.resize(N);
+    for (int i = 0; i < N; i++) {
+      extents_[i] = output.shape.tensor_shape_span(i)[0];
+      costs_[i] = output.shape.tensor_size(i);
+    }
+
+    auto params = param_provider_->ParamsCPU();
+    // the output rows (or planes) are independent - large samples are split between the threads
+    kernels::AddSampleRangeWork(pool, make_cspan(extents_), make_cspan(costs_),
+      [&](int tid, int i, int64_t begin, int64_t end) {
         DALIInterpType interp_type = interp_types.size() > 1 ? interp_types[i] : interp_types[0];
         auto context = GetContext(ws);
         kmgr_.Run<Kernel>(
             i, context,
             output[i],
             input_[i],
-            *param_provider_->ParamsCPU()(i),
+            *params(i),
             param_provider_->OutputSizes()[i],
             interp_type,
-            param_provider_->Border());
-      }, output.shape.tensor_size(i));
-    }
+            param_provider_->Border(),
+            begin, end);
+      });
     pool.RunAll();
   }
 
@@ -15,7 +15,10 @@
 #define DALI_RESIZE_BASE_CC
 
 #include "dali/operators/image/resize/experimental/resize.h"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <string>
 #include "dali/pipeline/data/views.h"
 
 namespace dali {
@@ -31,6 +34,20 @@ DALI_SCHEMA(experimental__Resize)
                    "DHWC", "FDHWC", "CDHW", "FCDHW", "CFDHW"  })
   .AddOptionalArg("save_attrs",
       R"code(Save reshape attributes for testing.)code", false)
+  .AddOptionalArg("implementation",
+      R"code(The GPU implementation of resampling.
+
+Possible values are:
+
+* ``"cvcuda"`` - CV-CUDA HQResize,
+* ``"dali"`` - DALI resampling kernels (the same as in :meth:`resize`),
+* ``"auto"`` - the faster of the two. The first iterations with each combination of the data
+  type, number of channels, filters and (approximate) size of the images are used to measure
+  both implementations; the faster one is used from then on. The choice is shared with the other
+  operators in the process running on the same GPU.
+
+.. note::
+  The implementations may produce slightly different results.)code", "cvcuda")
   .AddOptionalArg<DALIImageType>("image_type", "Image type", nullptr)
   .DeprecateArg("image_type")  // deprecated since 0.25dev
   .SupportVolumetric()
@@ -42,6 +59,20 @@ CvCudaResize::CvCudaResize(const OpSpec &spec)
     : StatelessOperator<GPUBackend>(spec)
     , ResizeBase<GPUBackend>(spec) {
   save_attrs_ = this->spec_.HasArgument("save_attrs");
+  auto implementation = spec.GetArgument<std::string>("implementation");
+  if (implementation == "auto") {
+    auto_select_ = true;
+    start_event_ = CUDAEvent::CreateWithFlags(cudaEventDefault);
+    end_event_ = CUDAEvent::CreateWithFlags(cudaEventDefault);
+  } else if (implementation == "dali") {
+    current_impl_ = ResizeImpl::DALI;
+  } else {
+    DALI_ENFORCE(implementation == "cvcuda", make_string("Unknown resize implementation: \"",
+                 implementation, "\". Valid values are: \"cvcuda\", \"dali\" and \"auto\"."));
+  }
+  RegisterDiagnostic("dali_iterations", &dali_iterations_);
+  RegisterDiagnostic("cvcuda_iterations", &cvcuda_iterations_);
+  RegisterDiagnostic("benchmark_iterations", &benchmark_iterations_);
   InitializeBackend();
 }
 
@@ -54,7 +85,19 @@ void CvCudaResize::RunImpl(Workspace &ws) {
   const auto &input = ws.Input<GPUBackend>(0);
   auto &output = ws.Output<GPUBackend>(0);
 
+  bool benchmark = auto_select_ && selector_.IsBenchmarking(shape_class_);
+  if (benchmark)
+    CUDA_CALL(cudaEventRecord(start_event_, ws.stream()));
   RunResize(ws, output, input);
+  if (benchmark) {
+    CUDA_CALL(cudaEventRecord(end_event_, ws.stream()));
+    pending_timing_.emplace(shape_class_, current_impl_);
+    benchmark_iterations_++;
+  }
+  if (current_impl_ == ResizeImpl::DALI)
+    dali_iterations_++;
+  else
+    cvcuda_iterations_++;
   output.SetLayout(input.GetLayout());
 
   if (save_attrs_) {
@@ -74,6 +117,70 @@ void CvCudaResize::RunImpl(Workspace &ws) {
   }
 }
 
+ResizeShapeClass CvCudaResize::GetShapeClass(const TensorListShape<> &in_shape,
+                                             DALIDataType in_type,
+                                             DALIDataType out_type) const {
+  ResizeShapeClass cls;
+  cls.device_id = spec_.GetArgument<int>("device_id");
+  cls.in_type = in_type;
+  cls.out_type = out_type;
+  int D = NumSpatialDims();
+  int first = FirstSpatialDim();
+  cls.spatial_ndim = D;
+  int N = in_shape.num_samples();
+  int64_t total_frames = 0;
+  double total_pixels = 0;
+  cls.uniform = true;
+  int first_sample = -1;
+  for (int i = 0; i < N; i++) {
+    auto sample_shape = in_shape.tensor_shape_span(i);
+    if (volume(sample_shape) == 0)
+      continue;
+    const kernels::ResamplingParams *params = &resample_params_[i * D];
+    int64_t frames = volume(&sample_shape[0], &sample_shape[first]);
+    double pixels = 1;
+    for (int d = 0; d < D; d++)
+      pixels *= params[d].output_size < 0 ? sample_shape[first + d] : params[d].output_size;
+    if (first_sample < 0) {
+      first_sample = i;
+      cls.channels = volume(&sample_shape[first + D], &sample_shape[0] + sample_shape.size());
+    } else {
+      auto *first_params = &resample_params_[first_sample * D];
+      auto first_shape = in_shape.tensor_shape_span(first_sample);
+      for (int d = 0; d < D; d++) {
+        if (params[d].output_size != first_params[d].output_size ||
+            sample_shape[first + d] != first_shape[first + d])
+          cls.uniform = false;
+      }
+    }
+    total_frames += frames;
+    total_pixels += pixels * frames;
+  }
+  if (first_sample >= 0) {
+    auto &params = resample_params_[first_sample * D];
+    cls.min_filter = params.min_filter.type;
+    cls.mag_filter = params.mag_filter.type;
+    cls.antialias = params.min_filter.antialias;
+  }
+  auto log2_bucket = [](double x) {
+    return static_cast<int>(std::round(std::log2(std::max(x, 1.0))));
+  };
+  cls.frame_size_log2 = log2_bucket(total_frames ? total_pixels / total_frames : 0);
+  cls.num_frames_log2 = log2_bucket(total_frames);
+  return cls;
+}
+
+void CvCudaResize::CollectTiming() {
+  if (!pending_timing_)
+    return;
+  // This is the previous iteration, most likely complete by now.
+  CUDA_CALL(cudaEventSynchronize(end_event_));
+  float time_ms = 0;
+  CUDA_CALL(cudaEventElapsedTime(&time_ms, start_event_, end_event_));
+  selector_.Report(pending_timing_->first, pending_timing_->second, time_ms);
+  pending_timing_.reset();
+}
+
 DALI_REGISTER_OPERATOR(experimental__Resize, CvCudaResize, GPU);
 
 }  // namespace dali
@@ -15,16 +15,19 @@
 #ifndef DALI_OPERATORS_IMAGE_RESIZE_EXPERIMENTAL_RESIZE_H_
 #define DALI_OPERATORS_IMAGE_RESIZE_EXPERIMENTAL_RESIZE_H_
 
+#include <memory>
+#include <optional>
 #include <random>
 #include <utility>
 #include <vector>
-#include <memory>
 
 #include "dali/core/common.h"
+#include "dali/core/cuda_event.h"
 #include "dali/core/error_handling.h"
 #include "dali/kernels/context.h"
 #include "dali/kernels/imgproc/resample/params.h"
 #include "dali/kernels/scratch.h"
+#include "dali/operators/image/resize/experimental/resize_impl_selector.h"
 #include "dali/operators/image/resize/experimental/resize_op_impl_cvcuda.h"
 #include "dali/operators/image/resize/resize_attr.h"
 #include "dali/operators/image/resize/resize_base.h"
@@ -42,15 +45,39 @@ class CvCudaResize : public StatelessOperator<GPUBackend>, protected ResizeBase<
                    const TensorListShape<> &in_shape, DALIDataType in_type,
                    span<const kernels::ResamplingParams> params, int spatial_ndim,
                    int first_spatial_dim) {
+    if (current_impl_ == ResizeImpl::DALI) {
+      // the native implementation is kept in ResizeBase::impl_
+      ResizeBase<GPUBackend>::SetupResize(out_shape, out_type, in_shape, in_type, params,
+                                          spatial_ndim, first_spatial_dim);
+      return;
+    }
     VALUE_SWITCH(spatial_ndim, static_spatial_ndim, (2, 3),
     (
       using ImplType = ResizeOpImplCvCuda<static_spatial_ndim>;
-      SetImpl<ImplType>([&]{ return std::make_unique<ImplType>(GetMinibatchSize()); });
-      impl_->Setup(out_shape, in_shape, first_spatial_dim, params);
+      if (!dynamic_cast<ImplType*>(cvcuda_impl_.get())) {
+        cvcuda_impl_.reset();
+        cvcuda_impl_ = std::make_unique<ImplType>(GetMinibatchSize());
+      }
+      cvcuda_impl_->Setup(out_shape, in_shape, first_spatial_dim, params);
     ), // NOLINT
     (DALI_FAIL(make_string("Unsupported number of resized dimensions: ", spatial_ndim))));
   }
 
+  void RunResize(Workspace &ws, TensorList<GPUBackend> &output,
+                 const TensorList<GPUBackend> &input) {
+    if (current_impl_ == ResizeImpl::DALI)
+      ResizeBase<GPUBackend>::RunResize(ws, output, input);
+    else
+      cvcuda_impl_->RunResize(ws, output, input);
+  }
+
+  /** Describes the batch for the selection of the implementation */
+  ResizeShapeClass GetShapeClass(const TensorListShape<> &in_shape, DALIDataType in_type,
+                                 DALIDataType out_type) const;
+
+  /** Reads the time of the last benchmarked iteration, if any, and reports it to the selector */
+  void CollectTiming();
+
 
   int NumSpatialDims() const {
     return resize_attr_.spatial_ndim_;
@@ -100,6 +127,18 @@ class CvCudaResize : public StatelessOperator<GPUBackend>, protected ResizeBase<
 
   ResizeAttr resize_attr_;
   ResamplingFilterAttr resampling_attr_;
+
+  // The selection of the implementation - see the `implementation` argument
+  bool auto_select_ = false;
+  ResizeImpl current_impl_ = ResizeImpl::CvCuda;
+  std::unique_ptr<Impl> cvcuda_impl_;
+  ResizeImplSelector selector_;
+  ResizeShapeClass shape_class_;
+  CUDAEvent start_event_, end_event_;
+  // The benchmarked iteration, whose time hasn't been collected yet
+  std::optional<std::pair<ResizeShapeClass, ResizeImpl>> pending_timing_;
+  // The number of iterations run with each implementation (diagnostics)
+  int64_t dali_iterations_ = 0, cvcuda_iterations_ = 0, benchmark_iterations_ = 0;
 };
 
 bool CvCudaResize::SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) {
@@ -114,6 +153,11 @@ bool CvCudaResize::SetupImpl(std::vector<OutputDesc> &output_desc, const Workspa
   PrepareParams(ws, in_shape, in_layout);
 
   auto out_type = resampling_attr_.GetOutputType(in_type);
+  if (auto_select_) {
+    CollectTiming();
+    shape_class_ = GetShapeClass(in_shape, in_type, out_type);
+    current_impl_ = selector_.Select(shape_class_);
+  }
 
   output_desc[0].type = out_type;
   this->SetupResize(output_desc[0].shape, out_type, in_shape, in_type,
@@ -0,0 +1,169 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_IMAGE_RESIZE_EXPERIMENTAL_RESIZE_IMPL_SELECTOR_H_
+#define DALI_OPERATORS_IMAGE_RESIZE_EXPERIMENTAL_RESIZE_IMPL_SELECTOR_H_
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include "dali/core/api_helper.h"
+#include "dali/core/common.h"
+#include "dali/kernels/imgproc/resample/params.h"
+#include "dali/pipeline/data/types.h"
+
+namespace dali {
+
+/** The GPU implementations of resize */
+enum class ResizeImpl : int {
+  DALI = 0,    ///< ResampleGPU kernel
+  CvCuda = 1,  ///< CV-CUDA HQResize
+};
+
+constexpr int kNumResizeImpls = 2;
+
+/**
+ * @brief The properties of a resize call which affect the relative speed of the implementations.
+ *
+ * The sizes are bucketed (by their logarithm), so that similar batches share the measurements.
+ */
+struct ResizeShapeClass {
+  int device_id = -1;
+  DALIDataType in_type = DALI_NO_TYPE, out_type = DALI_NO_TYPE;
+  int spatial_ndim = 0;
+  int channels = 0;
+  kernels::ResamplingFilterType min_filter = {}, mag_filter = {};
+  bool antialias = false;
+  /** log2 of the average number of output pixels in a frame */
+  int frame_size_log2 = 0;
+  /** log2 of the number of frames in the batch */
+  int num_frames_log2 = 0;
+  /** Whether all the frames have the same size */
+  bool uniform = false;
+
+  auto tie() const {
+    return std::tie(device_id, in_type, out_type, spatial_ndim, channels, min_filter, mag_filter,
+                    antialias, frame_size_log2, num_frames_log2, uniform);
+  }
+
+  bool operator<(const ResizeShapeClass &other) const {
+    return tie() < other.tie();
+  }
+
+  bool operator==(const ResizeShapeClass &other) const {
+    return tie() == other.tie();
+  }
+};
+
+/**
+ * @brief The implementations found to be the fastest, shared by all the operators in the process.
+ */
+class DLL_PUBLIC ResizeImplCache {
+ public:
+  static ResizeImplCache &Global();
+
+  std::optional<ResizeImpl> Get(const ResizeShapeClass &cls) const {
+    std::lock_guard g(mtx_);
+    auto it = winners_.find(cls);
+    if (it == winners_.end())
+      return std::nullopt;
+    return it->second;
+  }
+
+  void Set(const ResizeShapeClass &cls, ResizeImpl impl) {
+    std::lock_guard g(mtx_);
+    winners_[cls] = impl;
+  }
+
+  void Clear() {
+    std::lock_guard g(mtx_);
+    winners_.clear();
+  }
+
+ private:
+  mutable std::mutex mtx_;
+  std::map<ResizeShapeClass, ResizeImpl> winners_;
+};
+
+/**
+ * @brief Chooses the faster resize implementation for each shape class.
+ *
+ * The first iterations in a shape class, which is not in the cache yet, are used for
+ * benchmarking: the implementations are run alternately and their times are reported with
+ * `Report`. The first `warmup` runs of each implementation are discarded (they include the
+ * allocation of the scratch memory, etc). Once each implementation has `trials` measurements,
+ * the one with the lower average time is stored in the cache and used from then on.
+ */
+class ResizeImplSelector {
+ public:
+  explicit ResizeImplSelector(ResizeImplCache &cache = ResizeImplCache::Global(),
+                              int trials = 3, int warmup = 1)
+  : cache_(&cache), trials_(trials), warmup_(warmup) {}
+
+  /** Returns the implementation to use in the next iteration with given shape class. */
+  ResizeImpl Select(const ResizeShapeClass &cls) const {
+    if (auto winner = cache_->Get(cls))
+      return *winner;
+    auto it = trials_in_progress_.find(cls);
+    if (it == trials_in_progress_.end())
+      return ResizeImpl::DALI;
+    auto &runs = it->second.runs;
+    return runs[1] < runs[0] ? ResizeImpl::CvCuda : ResizeImpl::DALI;
+  }
+
+  /** Whether the iteration with given shape class is a part of the benchmark */
+  bool IsBenchmarking(const ResizeShapeClass &cls) const {
+    return !cache_->Get(cls).has_value();
+  }
+
+  /**
+   * @brief Reports the time of an iteration run with `impl`.
+   *
+   * @return true, if that concluded the benchmark of the shape class
+   */
+  bool Report(const ResizeShapeClass &cls, ResizeImpl impl, double time) {
+    if (!IsBenchmarking(cls))
+      return false;
+    auto &trial = trials_in_progress_[cls];
+    int idx = static_cast<int>(impl);
+    if (trial.runs[idx]++ >= warmup_)
+      trial.time[idx] += time;
+    int measured = std::min(trial.runs[0], trial.runs[1]) - warmup_;
+    if (measured < trials_)
+      return false;
+    double avg[kNumResizeImpls];
+    for (int i = 0; i < kNumResizeImpls; i++)
+      avg[i] = trial.time[i] / (trial.runs[i] - warmup_);
+    ResizeImpl winner = avg[1] < avg[0] ? ResizeImpl::CvCuda : ResizeImpl::DALI;
+    cache_->Set(cls, winner);
+    trials_in_progress_.erase(cls);
+    return true;
+  }
+
+ private:
+  struct Trial {
+    int runs[kNumResizeImpls] = {};
+    double time[kNumResizeImpls] = {};
+  };
+
+  ResizeImplCache *cache_;
+  int trials_, warmup_;
+  std::map<ResizeShapeClass, Trial> trials_in_progress_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_IMAGE_RESIZE_EXPERIMENTAL_RESIZE_IMPL_SELECTOR_H_
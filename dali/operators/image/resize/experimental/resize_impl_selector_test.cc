@@ -0,0 +1,108 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include "dali/operators/image/resize/experimental/resize_impl_selector.h"
+
+namespace dali {
+namespace testing {
+
+namespace {
+
+/**
+ * Runs iterations in a shape class until the benchmark is concluded, with the implementations
+ * taking a fixed time; returns the number of iterations.
+ */
+int Benchmark(ResizeImplSelector &selector, const ResizeShapeClass &cls,
+              double dali_time, double cvcuda_time) {
+  for (int i = 1; i < 100; i++) {
+    ResizeImpl impl = selector.Select(cls);
+    if (selector.Report(cls, impl, impl == ResizeImpl::DALI ? dali_time : cvcuda_time))
+      return i;
+  }
+  return -1;
+}
+
+ResizeShapeClass MakeClass(int device_id, int frame_size_log2) {
+  ResizeShapeClass cls;
+  cls.device_id = device_id;
+  cls.in_type = cls.out_type = DALI_UINT8;
+  cls.spatial_ndim = 2;
+  cls.channels = 3;
+  cls.min_filter = cls.mag_filter = kernels::ResamplingFilterType::Linear;
+  cls.frame_size_log2 = frame_size_log2;
+  cls.num_frames_log2 = 5;
+  return cls;
+}
+
+}  // namespace
+
+TEST(ResizeImplSelectorTest, ChoosesFaster) {
+  ResizeImplCache cache;
+  ResizeImplSelector selector(cache, 3, 1);
+  auto small = MakeClass(0, 10), large = MakeClass(0, 20);
+  EXPECT_TRUE(selector.IsBenchmarking(small));
+  // both implementations are run (warmup + trials) times
+  EXPECT_EQ(Benchmark(selector, small, 2, 1), 8);
+  EXPECT_EQ(Benchmark(selector, large, 1, 2), 8);
+  EXPECT_FALSE(selector.IsBenchmarking(small));
+  for (int i = 0; i < 5; i++) {
+    EXPECT_EQ(selector.Select(small), ResizeImpl::CvCuda);
+    EXPECT_EQ(selector.Select(large), ResizeImpl::DALI);
+  }
+  EXPECT_EQ(cache.Get(small), ResizeImpl::CvCuda);
+}
+
+TEST(ResizeImplSelectorTest, Alternates) {
+  ResizeImplCache cache;
+  ResizeImplSelector selector(cache, 2, 0);
+  auto cls = MakeClass(0, 10);
+  int runs[kNumResizeImpls] = {};
+  for (int i = 0; i < 3; i++) {
+    ResizeImpl impl = selector.Select(cls);
+    runs[static_cast<int>(impl)]++;
+    EXPECT_FALSE(selector.Report(cls, impl, 1));
+  }
+  EXPECT_EQ(runs[0], 2);
+  EXPECT_EQ(runs[1], 1);
+}
+
+TEST(ResizeImplSelectorTest, WarmupDiscarded) {
+  ResizeImplCache cache;
+  ResizeImplSelector selector(cache, 1, 1);
+  auto cls = MakeClass(0, 10);
+  // the first run of DALI is slow, but it doesn't count
+  EXPECT_FALSE(selector.Report(cls, ResizeImpl::DALI, 100));
+  EXPECT_FALSE(selector.Report(cls, ResizeImpl::CvCuda, 100));
+  EXPECT_FALSE(selector.Report(cls, ResizeImpl::DALI, 1));
+  EXPECT_TRUE(selector.Report(cls, ResizeImpl::CvCuda, 2));
+  EXPECT_EQ(selector.Select(cls), ResizeImpl::DALI);
+}
+
+TEST(ResizeImplSelectorTest, SharedCache) {
+  ResizeImplCache cache;
+  ResizeImplSelector selector1(cache), selector2(cache);
+  auto cls = MakeClass(0, 10), other_gpu = MakeClass(1, 10);
+  Benchmark(selector1, cls, 2, 1);
+  // another operator uses the result...
+  EXPECT_FALSE(selector2.IsBenchmarking(cls));
+  EXPECT_EQ(selector2.Select(cls), ResizeImpl::CvCuda);
+  // ...but not on another GPU
+  EXPECT_TRUE(selector2.IsBenchmarking(other_gpu));
+  EXPECT_EQ(Benchmark(selector2, other_gpu, 1, 2), 8);
+  EXPECT_EQ(selector1.Select(other_gpu), ResizeImpl::DALI);
+}
+
+}  // namespace testing
+}  // namespace dali
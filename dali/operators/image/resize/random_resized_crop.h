@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -74,13 +74,10 @@ class RandomResizedCrop : public Operator<Backend>
     assert(height_idx >= 0 && "Height dimension not found");
     assert(width_idx == height_idx + 1 && "Width must immediately follow height dim.");
 
-    for (int sample_idx = 0; sample_idx < N; sample_idx++) {
-      auto sample_shape = in_shape.tensor_shape_span(sample_idx);
-      int H = sample_shape[height_idx];
-      int W = sample_shape[width_idx];
-      crops_[sample_idx] = crop_attr_.GetCropWindowGenerator(sample_idx)({H, W}, "HW");
+    // The crop windows only affect the ROI of the resampling - the input is not cropped
+    crop_attr_.GenerateCropWindows(make_span(crops_), in_shape, height_idx, width_idx);
+    for (int sample_idx = 0; sample_idx < N; sample_idx++)
       resample_params_[sample_idx] = CalcResamplingParams(sample_idx);
-    }
     resampling_attr_.ApplyFilterParams(make_span(resample_params_));
 
     output_desc.resize(1);
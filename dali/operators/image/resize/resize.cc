@@ -33,6 +33,7 @@ DALI_SCHEMA(Resize)
   .DeprecateArg("image_type")  // deprecated since 0.25dev
   .SupportVolumetric()
   .AllowSequences()
+  .Stateless()
   .AddParent("ResizeAttr")
   .AddParent("ResamplingFilterAttr");
 
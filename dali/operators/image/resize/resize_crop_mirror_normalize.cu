@@ -0,0 +1,204 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <any>
+#include <cmath>
+#include <vector>
+#include "dali/core/bfloat16.h"
+#include "dali/core/float16.h"
+#include "dali/core/small_vector.h"
+#include "dali/core/span.h"
+#include "dali/core/static_switch.h"
+#include "dali/core/tensor_layout.h"
+#include "dali/core/util.h"
+#include "dali/kernels/imgproc/resample/resize_crop_mirror_normalize_gpu.h"
+#include "dali/kernels/kernel_manager.h"
+#include "dali/operators/image/resize/resampling_attr.h"
+#include "dali/operators/image/resize/resize_crop_mirror.h"
+#include "dali/pipeline/data/views.h"
+#include "dali/pipeline/operator/arg_helper.h"
+#include "dali/pipeline/operator/checkpointing/stateless_operator.h"
+#include "dali/pipeline/operator/common.h"
+#include "dali/pipeline/workspace/workspace.h"
+
+namespace dali {
+
+DALI_SCHEMA(experimental__ResizeCropMirrorNormalize)
+  .DocStr(R"(Performs a fused resize, crop, mirror and normalization, with an optional
+HWC to CHW conversion.
+
+The result is equivalent to applying ``resize_crop_mirror``, followed by ``crop_mirror_normalize``
+(without cropping), but the output is computed in a single pass over the input image, without
+storing the resized image. The output is::
+
+  output = scale * (resized - mean) / std + shift
+
+Only 8-bit images in HWC layout, with up to 4 channels, are supported. The output type
+(``dtype``) can be ``FLOAT`` (the default), ``FLOAT16`` or ``BFLOAT16``.
+
+.. note::
+  The 2D footprint of the resampling filter is evaluated for each output pixel. It's fast for
+  upscaling and moderate downscaling; when an image is scaled down by a large factor with
+  antialiasing, ``resize`` followed by ``crop_mirror_normalize`` may be faster.
+)")
+  .NumInput(1)
+  .NumOutput(1)
+  .InputLayout(0, "HWC")
+  .AddOptionalArg("output_layout",
+    R"(Tensor data layout for the output - ``CHW`` or ``HWC``.)", TensorLayout("CHW"))
+  .AddOptionalArg("pad_output",
+    R"(Determines whether to pad the output with zeros so that the number of channels is a
+power of 2.)", false)
+  .AddOptionalArg("mean",
+    R"(Mean pixel values for image normalization.)",
+    std::vector<float>{0.0f}, true)
+  .AddOptionalArg("std",
+    R"(Standard deviation values for image normalization.)",
+    std::vector<float>{1.0f}, true)
+  .AddOptionalArg("scale", R"(The value by which the result is multiplied.)", 1.0f)
+  .AddOptionalArg("shift", R"(The value added to the (scaled) result.)", 0.0f)
+  .AddParent("ResizeCropMirrorAttr")
+  .AddParent("ResamplingFilterAttr");
+
+class ResizeCropMirrorNormalizeGPU : public StatelessOperator<GPUBackend> {
+ public:
+  explicit ResizeCropMirrorNormalizeGPU(const OpSpec &spec)
+      : StatelessOperator<GPUBackend>(spec),
+        resize_attr_(spec),
+        output_layout_(spec.GetArgument<TensorLayout>("output_layout")),
+        pad_output_(spec.GetArgument<bool>("pad_output")),
+        mean_arg_("mean", spec),
+        std_arg_("std", spec),
+        scale_(spec.GetArgument<float>("scale")),
+        shift_(spec.GetArgument<float>("shift")) {
+    spec.TryGetArgument(output_type_, "dtype");
+    DALI_ENFORCE(output_type_ == DALI_FLOAT || output_type_ == DALI_FLOAT16 ||
+                 output_type_ == DALI_BFLOAT16,
+                 make_string("Unsupported output type: ", output_type_,
+                             ". Supported types are: FLOAT, FLOAT16, BFLOAT16."));
+    DALI_ENFORCE(output_layout_ == "CHW" || output_layout_ == "HWC",
+                 make_string("Unsupported output layout: \"", output_layout_,
+                             "\". Supported layouts are: CHW, HWC."));
+  }
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override {
+    TYPE_SWITCH(output_type_, type2id, Out, (float, float16, bfloat16), (
+      return SetupTyped<Out>(output_desc, ws);
+    ), DALI_FAIL(make_string("Unsupported output type: ", output_type_)););  // NOLINT
+  }
+
+  template <typename Out>
+  bool SetupTyped(std::vector<OutputDesc> &output_desc, const Workspace &ws) {
+    using Kernel = kernels::ResizeCropMirrorNormalizeGPU<Out>;
+    const auto &input = ws.Input<GPUBackend>(0);
+    DALI_ENFORCE(input.type() == DALI_UINT8,
+                 make_string("Unsupported input type: ", input.type(), ". Only UINT8 images are "
+                             "supported."));
+    const auto &in_shape = input.shape();
+    int N = in_shape.num_samples();
+
+    resize_attr_.PrepareResizeParams(spec_, ws, in_shape, input.GetLayout());
+    resampling_attr_.PrepareFilterParams(spec_, ws, N);
+    resample_params_.resize(N);
+    resampling_attr_.GetResamplingParams(make_span(resample_params_),
+                                         make_cspan(resize_attr_.params_));
+
+    ArgValueFlags flags = ArgValue_EnforceUniform;
+    mean_arg_.Acquire(spec_, ws, N, flags);
+    std_arg_.Acquire(spec_, ws, N, flags);
+
+    if (!kernel_args_.has_value())
+      kernel_args_ = std::vector<typename Kernel::SampleArgs>{};
+    auto &args = std::any_cast<std::vector<typename Kernel::SampleArgs> &>(kernel_args_);
+    args.resize(N);
+    for (int i = 0; i < N; i++) {
+      int num_channels = in_shape.tensor_shape_span(i)[2];
+      auto &a = args[i];
+      a.params = resample_params_[i];
+      GetNormParameters(a.mean, a.inv_stddev, i, num_channels);
+      a.fill_values.clear();
+      if (pad_output_)
+        a.fill_values.resize(next_pow2(num_channels), 0.0f);
+    }
+
+    kmgr_.Resize<Kernel>(1);
+    kernels::KernelContext ctx;
+    ctx.gpu.stream = ws.stream();
+    auto &req = kmgr_.Setup<Kernel>(0, ctx, in_shape.to_static<3>(), make_cspan(args),
+                                    output_layout_);
+    output_desc.resize(1);
+    output_desc[0].type = output_type_;
+    output_desc[0].shape = req.output_shapes[0];
+    return true;
+  }
+
+  void RunImpl(Workspace &ws) override {
+    TYPE_SWITCH(output_type_, type2id, Out, (float, float16, bfloat16), (
+      RunTyped<Out>(ws);
+    ), DALI_FAIL(make_string("Unsupported output type: ", output_type_)););  // NOLINT
+  }
+
+  template <typename Out>
+  void RunTyped(Workspace &ws) {
+    using Kernel = kernels::ResizeCropMirrorNormalizeGPU<Out>;
+    const auto &input = ws.Input<GPUBackend>(0);
+    auto &output = ws.Output<GPUBackend>(0);
+    output.SetLayout(output_layout_);
+    auto &args = std::any_cast<std::vector<typename Kernel::SampleArgs> &>(kernel_args_);
+    kernels::KernelContext ctx;
+    ctx.gpu.stream = ws.stream();
+    kmgr_.Run<Kernel>(0, ctx, view<Out, 3>(output), view<const uint8_t, 3>(input),
+                      make_cspan(args));
+  }
+
+  void GetNormParameters(SmallVector<float, 4> &mean, SmallVector<float, 4> &inv_stddev,
+                         int sample_idx, int num_channels) {
+    span<const float> mean_arg(mean_arg_[sample_idx].data, mean_arg_[sample_idx].num_elements());
+    span<const float> std_arg(std_arg_[sample_idx].data, std_arg_[sample_idx].num_elements());
+    DALI_ENFORCE(mean_arg.size() == std_arg.size() || mean_arg.size() == 1 || std_arg.size() == 1,
+                 "``mean`` and ``std`` must either be of the same size, be scalars, or one of "
+                 "them can be a vector and the other a scalar.");
+    mean.resize(num_channels);
+    inv_stddev.resize(num_channels);
+    for (int c = 0; c < num_channels; c++) {
+      double mean_val = mean_arg[c % mean_arg.size()];
+      double std_val = std_arg[c % std_arg.size()];
+      mean[c] = std::fma(-shift_, std_val / scale_, mean_val);
+      inv_stddev[c] = scale_ / std_val;
+    }
+  }
+
+  ResizeCropMirrorAttr resize_attr_;
+  ResamplingFilterAttr resampling_attr_;
+  std::vector<kernels::ResamplingParams2D> resample_params_;
+
+  DALIDataType output_type_ = DALI_FLOAT;
+  TensorLayout output_layout_;
+  bool pad_output_ = false;
+
+  ArgValue<float, 1> mean_arg_;
+  ArgValue<float, 1> std_arg_;
+  float scale_ = 1.0f;
+  float shift_ = 0.0f;
+
+  kernels::KernelManager kmgr_;
+  std::any kernel_args_;
+
+  USE_OPERATOR_MEMBERS();
+};
+
+DALI_REGISTER_OPERATOR(experimental__ResizeCropMirrorNormalize, ResizeCropMirrorNormalizeGPU, GPU);
+
+}  // namespace dali
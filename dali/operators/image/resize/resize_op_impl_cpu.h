@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -21,6 +21,7 @@
 
 #include <cassert>
 #include <cmath>
+#include <utility>
 #include <vector>
 #include "dali/operators/image/resize/resize_op_impl.h"
 #include "dali/kernels/imgproc/resample_cpu.h"
@@ -67,7 +68,10 @@ class ResizeOpImplCPU : public ResizeBase<CPUBackend>::Impl {
     for (int i = 0; i < GetNumFrames(); i++) {
       kernels::InTensorCPU<In, frame_ndim> dummy_input;
       dummy_input.shape = in_shape_[i];
-      kernels::KernelRequirements &req = kmgr_.Setup<Kernel>(i, ctx, dummy_input, params_[i]);
+      // the setup depends only on the shape and the parameters - skip it if they don't change
+      auto key = std::make_pair(dummy_input.shape, params_[i]);
+      kernels::KernelRequirements &req =
+          kmgr_.SetupCached<Kernel>(i, key, ctx, dummy_input, params_[i]);
       assert(req.output_shapes[0][0] == out_shape_[i]);
     }
   }
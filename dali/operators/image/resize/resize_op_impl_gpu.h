@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -76,7 +76,11 @@ class ResizeOpImplGPU : public ResizeBase<GPUBackend>::Impl {
       }
 
       auto param_slice = make_span(&params_[mb.start], mb.count);
-      kernels::KernelRequirements &req = kmgr_.Setup<Kernel>(mb_idx, ctx, mb.input, param_slice);
+      // the setup depends only on the shapes and the parameters - skip it if they don't change
+      setup_key_.shape = in_slice.shape;
+      setup_key_.params.assign(param_slice.begin(), param_slice.end());
+      kernels::KernelRequirements &req =
+          kmgr_.SetupCached<Kernel>(mb_idx, setup_key_, ctx, mb.input, param_slice);
       mb.out_shape = req.output_shapes[0].to_static<frame_ndim>();
     }
   }
@@ -138,6 +142,17 @@ class ResizeOpImplGPU : public ResizeBase<GPUBackend>::Impl {
 
   std::vector<MiniBatch> minibatches_;
 
+  /// The arguments of the kernel's Setup - the setup is cached if they don't change
+  struct SetupKey {
+    TensorListShape<frame_ndim> shape;
+    std::vector<ResamplingParamsND<spatial_ndim>> params;
+
+    bool operator==(const SetupKey &other) const {
+      return shape == other.shape && params == other.params;
+    }
+  };
+  SetupKey setup_key_;
+
   void SubdivideInput(const kernels::InListGPU<In, frame_ndim> &in) {
     for (auto &mb : minibatches_)
       sample_range(mb.input, in, mb.start, mb.start + mb.count);
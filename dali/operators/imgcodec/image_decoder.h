@@ -11,12 +11,14 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // limitations under the License.
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 #include "dali/core/call_at_exit.h"
+#include "dali/core/metrics.h"
 #include "dali/core/mm/memory.h"
 #include "dali/operators.h"
 #include "dali/operators/decoder/cache/cached_decoder_impl.h"
@@ -171,6 +173,9 @@ class ImageDecoder : public StatelessOperator<Backend> {
     nvimgcodecImageInfo_t image_info = {};
     TensorShape<> out_shape = {};
     bool need_processing = true;
+    bool load_from_cache = false;
+    /** The shape was taken from the metadata; the sample is parsed in Run */
+    bool parse_deferred = false;
 
     TensorLayout req_layout;
     DALIImageType orig_img_type;
@@ -226,12 +231,24 @@ class ImageDecoder : public StatelessOperator<Backend> {
     num_threads_ = spec.GetArgument<int>("num_threads");
     GetDecoderSpecificArguments(spec);
 
+    if (metrics::Enabled()) {
+      decode_latency_metric_ = metrics::Metric(
+          "dali_decoder_image_latency_us", metrics::MetricKind::Histogram,
+          metrics::Label("backend", std::is_same<MixedBackend, Backend>::value ? "mixed" : "cpu"),
+          "The decoding time per image (the time of a batch divided by its size), "
+          "in microseconds.");
+    }
+
     if (std::is_same<MixedBackend, Backend>::value) {
       thread_pool_ = std::make_unique<ThreadPool>(num_threads_, device_id_,
                                                   spec.GetArgument<bool>("affine"), "MixedDecoder");
 
       if (spec_.HasArgument("cache_size"))
         cache_ = std::make_unique<CachedDecoderImpl>(spec_);
+      if (cache_ && cache_->IsCacheEnabled()) {
+        this->RegisterDiagnostic("cache_hits", &cache_hits_);
+        this->RegisterDiagnostic("cache_misses", &cache_misses_);
+      }
     }
 
     EnforceMinimumNvimgcodecVersion();
@@ -496,6 +513,39 @@ class ImageDecoder : public StatelessOperator<Backend> {
       throw std::runtime_error(make_string("Invalid sample_type: ", sample_type));
   }
 
+  /**
+   * @brief Calculates the shape of the decoded image (without the ROI)
+   *
+   * @param shape     the shape of the encoded image, as stored
+   * @param rotation  the rotation from the orientation metadata of the image
+   */
+  TensorShape<> DecodedShape(TensorShape<> shape, int rotation) const {
+    shape[2] = NumberOfChannels(format_, shape[2]);
+    if (use_orientation_ && (rotation % 180 != 0))
+      std::swap(shape[0], shape[1]);
+    return shape;
+  }
+
+  /**
+   * @brief Parses a sample, for which the shape was taken from the metadata in Setup
+   */
+  void ParseDeferred(SampleState &st, const TensorList<CPUBackend> &input, int sample_idx) {
+    const auto &input_sample = input[sample_idx];
+    ParseSample(st.parsed_sample,
+                span<const uint8_t>{static_cast<const uint8_t *>(input_sample.raw_data()),
+                                    volume(input_sample.shape())});
+    st.parse_deferred = false;
+    const auto &meta = input.GetMeta(sample_idx);
+    const auto &hint = meta.GetEncodedImageInfo();
+    if (st.parsed_sample.dali_img_info.shape != hint.shape ||
+        st.parsed_sample.nvimgcodec_img_info.orientation.rotated != hint.rotation) {
+      throw std::runtime_error(make_string(
+          "The image info in the metadata of sample #", sample_idx, " (", meta.GetSourceInfo(),
+          ") doesn't match the image: shape ", hint.shape, " vs ",
+          st.parsed_sample.dali_img_info.shape, "."));
+    }
+  }
+
   ThreadPool *GetThreadPool(const Workspace &ws) {
     return std::is_same<MixedBackend, Backend>::value ? thread_pool_.get() : &ws.GetThreadPool();
   }
@@ -531,22 +581,32 @@ class ImageDecoder : public StatelessOperator<Backend> {
           const auto &input_sample = input[i];
 
           auto src_info = input.GetMeta(i).GetSourceInfo();
-          if (use_cache && cache_->IsInCache(src_info)) {
+          st->load_from_cache = false;
+          st->parse_deferred = false;
+          if (use_cache) {
             auto cached_shape = cache_->CacheImageShape(src_info);
-            auto roi = GetRoi(spec_, ws, i, cached_shape);
-            if (!roi.use_roi()) {
-              shapes.set_tensor_shape(i, cached_shape);
-              continue;
+            if (volume(cached_shape) > 0) {
+              ROI &roi = rois_[i] = GetRoi(spec_, ws, i, cached_shape);
+              if (!roi.use_roi()) {
+                st->load_from_cache = true;
+                st->out_shape = cached_shape;
+                shapes.set_tensor_shape(i, cached_shape);
+                continue;
+              }
             }
           }
-          ParseSample(st->parsed_sample,
-                      span<const uint8_t>{static_cast<const uint8_t *>(input_sample.raw_data()),
-                                          volume(input_sample.shape())});
-          st->out_shape = st->parsed_sample.dali_img_info.shape;
-          st->out_shape[2] = NumberOfChannels(format_, st->out_shape[2]);
-          if (use_orientation_ &&
-              (st->parsed_sample.nvimgcodec_img_info.orientation.rotated % 180 != 0)) {
-            std::swap(st->out_shape[0], st->out_shape[1]);
+          const auto &image_info = input.GetMeta(i).GetEncodedImageInfo();
+          if (!image_info.empty()) {
+            // The reader has already parsed the header; the parsing needed for decoding is
+            // done in Run, so that it doesn't delay the allocation of the outputs.
+            st->parse_deferred = true;
+            st->out_shape = DecodedShape(image_info.shape, image_info.rotation);
+          } else {
+            ParseSample(st->parsed_sample,
+                        span<const uint8_t>{static_cast<const uint8_t *>(input_sample.raw_data()),
+                                            volume(input_sample.shape())});
+            st->out_shape = DecodedShape(st->parsed_sample.dali_img_info.shape,
+                                         st->parsed_sample.nvimgcodec_img_info.orientation.rotated);
           }
           ROI &roi = rois_[i] = GetRoi(spec_, ws, i, st->out_shape);
           if (roi.use_roi()) {
@@ -636,6 +696,10 @@ class ImageDecoder : public StatelessOperator<Backend> {
         st.image_info.sample_format = NVIMGCODEC_SAMPLEFORMAT_P_Y;
         st.orig_img_type = DALI_GRAY;
         decode_shape[2] = 1;
+      } else if (format_ == DALI_BGR && version_at_least(0, 3, 0)) {
+        // The codecs produce BGR directly - no need for an intermediate buffer and a conversion
+        st.image_info.sample_format = NVIMGCODEC_SAMPLEFORMAT_I_BGR;
+        st.orig_img_type = DALI_BGR;
       } else {
         st.image_info.sample_format = NVIMGCODEC_SAMPLEFORMAT_I_RGB;
         st.orig_img_type = DALI_RGB;
@@ -679,6 +743,8 @@ class ImageDecoder : public StatelessOperator<Backend> {
     st.decode_out_gpu = {};
 
     if (st.need_processing) {
+      // the image is decoded to an intermediate buffer and then processed into the output
+      mm::MemoryTagScope tag(mm::MemoryTag::Staging);
       if constexpr (std::is_same<MixedBackend, Backend>::value) {
         st.device_buf = mm::alloc_raw_async_unique<uint8_t, mm::memory_kind::device>(
             image_buffer_size, st.image_info.cuda_stream, st.image_info.cuda_stream);
@@ -739,16 +805,26 @@ class ImageDecoder : public StatelessOperator<Backend> {
       int samples_to_load = 0;
       DomainTimeRange tr(make_string("CacheLoad"), DomainTimeRange::kOrange);
       for (int orig_idx = 0; orig_idx < nsamples; orig_idx++) {
-        auto src_info = input.GetMeta(orig_idx).GetSourceInfo();
+        auto &st = *state_[orig_idx];
+        // The decision is made in Setup - the output shape depends on it.
         // To simplify things, we do not allow caching ROIs
-        bool has_roi = rois_[orig_idx].use_roi();
-        if (cache_->IsInCache(src_info) && !has_roi) {
-          cache_->DeferCacheLoad(src_info, output.template mutable_tensor<uint8_t>(orig_idx));
-          samples_to_load++;
-        } else {
-          decode_sample_idxs_.push_back(orig_idx);
+        if (st.load_from_cache) {
+          auto src_info = input.GetMeta(orig_idx).GetSourceInfo();
+          if (cache_->DeferCacheLoad(src_info, output.template mutable_tensor<uint8_t>(orig_idx))) {
+            samples_to_load++;
+            continue;
+          }
+          // The image was evicted by another decoder sharing the cache - decode it.
+          const auto &input_sample = input[orig_idx];
+          ParseSample(st.parsed_sample,
+                      span<const uint8_t>{static_cast<const uint8_t *>(input_sample.raw_data()),
+                                          volume(input_sample.shape())});
+          st.load_from_cache = false;
         }
+        decode_sample_idxs_.push_back(orig_idx);
       }
+      cache_hits_ += samples_to_load;
+      cache_misses_ += nsamples - samples_to_load;
       if (samples_to_load > 0)
         cache_->LoadDeferred(ws.stream());
     } else {
@@ -765,7 +841,10 @@ class ImageDecoder : public StatelessOperator<Backend> {
           int i_end = decode_nsamples * (block_idx + 1) / nblocks;
           for (int i = i_start; i < i_end; i++) {
             int orig_idx = decode_sample_idxs_[i];
-            PrepareOutput(*state_[orig_idx], output[orig_idx], rois_[orig_idx], ws);
+            auto &st = *state_[orig_idx];
+            if (st.parse_deferred)
+              ParseDeferred(st, input, orig_idx);
+            PrepareOutput(st, output[orig_idx], rois_[orig_idx], ws);
           }
         };
       };
@@ -807,6 +886,7 @@ class ImageDecoder : public StatelessOperator<Backend> {
 
     {
       DomainTimeRange tr("Decode", DomainTimeRange::kOrange);
+      auto decode_start = std::chrono::steady_clock::now();
       nvimgcodecFuture_t future;
       decode_status_.resize(decode_nsamples);
       size_t status_size = 0;
@@ -818,6 +898,11 @@ class ImageDecoder : public StatelessOperator<Backend> {
       if (static_cast<int>(status_size) != decode_nsamples)
         throw std::logic_error("Failed to retrieve processing status");
       CHECK_NVIMGCODEC(nvimgcodecFutureDestroy(future));
+      if (decode_nsamples > 0) {
+        std::chrono::duration<double, std::micro> t = std::chrono::steady_clock::now() -
+                                                      decode_start;
+        decode_latency_metric_.Observe(t.count() / decode_nsamples, decode_nsamples);
+      }
 
       for (int i = 0; i < decode_nsamples; i++) {
         if (decode_status_[i] != NVIMGCODEC_PROCESSING_STATUS_SUCCESS) {
@@ -874,6 +959,8 @@ class ImageDecoder : public StatelessOperator<Backend> {
 
   std::unique_ptr<ThreadPool> thread_pool_;
   std::unique_ptr<CachedDecoderImpl> cache_;
+  int64_t cache_hits_ = 0, cache_misses_ = 0;
+  metrics::Metric decode_latency_metric_;
 
   NvImageCodecInstance instance_ = {};
   NvImageCodecDecoder decoder_ = {};
@@ -30,6 +30,31 @@ DALI_SCHEMA(experimental__PeekImageShape)
   .AddOptionalArg("image_type",
     R"code(Color format of the image.)code", DALI_RGB);
 
+NvImageCodecInstance CreatePeekImageShapeInstance() {
+  EnforceMinimumNvimgcodecVersion();
+
+  nvimgcodecInstanceCreateInfo_t instance_create_info = {
+      NVIMGCODEC_STRUCTURE_TYPE_INSTANCE_CREATE_INFO, sizeof(nvimgcodecInstanceCreateInfo_t),
+      nullptr};
+  instance_create_info.load_extension_modules = 1;
+  instance_create_info.load_builtin_modules = 1;
+  instance_create_info.extension_modules_path = nullptr;
+  instance_create_info.create_debug_messenger = 1;
+  instance_create_info.message_severity = NVIMGCODEC_DEBUG_MESSAGE_SEVERITY_FATAL |
+                                          NVIMGCODEC_DEBUG_MESSAGE_SEVERITY_ERROR |
+                                          NVIMGCODEC_DEBUG_MESSAGE_SEVERITY_WARNING;
+  instance_create_info.message_category = NVIMGCODEC_DEBUG_MESSAGE_CATEGORY_ALL;
+  return NvImageCodecInstance::Create(&instance_create_info);
+}
+
+ImageInfo PeekImageInfo(nvimgcodecInstance_t instance, const void *data, size_t data_len) {
+  auto encoded_stream = NvImageCodecCodeStream::FromHostMem(instance, data, data_len);
+  nvimgcodecImageInfo_t nvimgcodec_img_info{NVIMGCODEC_STRUCTURE_TYPE_IMAGE_INFO,
+                                            sizeof(nvimgcodecImageInfo_t), nullptr};
+  CHECK_NVIMGCODEC(nvimgcodecCodeStreamGetImageInfo(encoded_stream, &nvimgcodec_img_info));
+  return to_dali_img_info(nvimgcodec_img_info);
+}
+
 ImgcodecPeekImageShape::ImgcodecPeekImageShape(const OpSpec &spec)
     : StatelessOperator<CPUBackend>(spec) {
   output_type_ = spec.GetArgument<DALIDataType>("dtype");
@@ -52,21 +77,7 @@ ImgcodecPeekImageShape::ImgcodecPeekImageShape(const OpSpec &spec)
   }
   use_orientation_ = spec.GetArgument<bool>("adjust_orientation");
   image_type_ = spec.GetArgument<DALIImageType>("image_type");
-
-  EnforceMinimumNvimgcodecVersion();
-
-  nvimgcodecInstanceCreateInfo_t instance_create_info = {
-      NVIMGCODEC_STRUCTURE_TYPE_INSTANCE_CREATE_INFO, sizeof(nvimgcodecInstanceCreateInfo_t),
-      nullptr};
-  instance_create_info.load_extension_modules = 1;
-  instance_create_info.load_builtin_modules = 1;
-  instance_create_info.extension_modules_path = nullptr;
-  instance_create_info.create_debug_messenger = 1;
-  instance_create_info.message_severity = NVIMGCODEC_DEBUG_MESSAGE_SEVERITY_FATAL |
-                                          NVIMGCODEC_DEBUG_MESSAGE_SEVERITY_ERROR |
-                                          NVIMGCODEC_DEBUG_MESSAGE_SEVERITY_WARNING;
-  instance_create_info.message_category = NVIMGCODEC_DEBUG_MESSAGE_CATEGORY_ALL;
-  instance_ = NvImageCodecInstance::Create(&instance_create_info);
+  instance_ = CreatePeekImageShapeInstance();
 }
 
 bool ImgcodecPeekImageShape::SetupImpl(std::vector<OutputDesc> &output_desc,
@@ -89,11 +100,7 @@ void ImgcodecPeekImageShape::RunImpl(Workspace &ws) {
     thread_pool.AddWork([i, &input, &output, this] (int tid) {
       const void* data = input.raw_tensor(i);
       size_t data_len = input.tensor_shape_span(i)[0];
-      auto encoded_stream = NvImageCodecCodeStream::FromHostMem(instance_, data, data_len);
-      nvimgcodecImageInfo_t nvimgcodec_img_info{NVIMGCODEC_STRUCTURE_TYPE_IMAGE_INFO,
-                                                sizeof(nvimgcodecImageInfo_t), nullptr};
-      CHECK_NVIMGCODEC(nvimgcodecCodeStreamGetImageInfo(encoded_stream, &nvimgcodec_img_info));
-      auto info = to_dali_img_info(nvimgcodec_img_info);
+      auto info = PeekImageInfo(instance_, data, data_len);
 
       TensorShape<> shape;
       OutputShape(shape, info, image_type_, false, use_orientation_, {});
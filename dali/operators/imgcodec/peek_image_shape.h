@@ -27,6 +27,20 @@
 namespace dali {
 namespace imgcodec {
 
+/**
+ * @brief Creates an nvImageCodec instance, which can be used for parsing the image headers
+ */
+DLL_PUBLIC NvImageCodecInstance CreatePeekImageShapeInstance();
+
+/**
+ * @brief Parses the header of an encoded image
+ *
+ * The shape in the returned info is the shape of the image as stored (HWC), without the
+ * orientation applied. Throws if the format is not recognized.
+ */
+DLL_PUBLIC ImageInfo PeekImageInfo(nvimgcodecInstance_t instance, const void *data,
+                                   size_t data_len);
+
 class ImgcodecPeekImageShape : public StatelessOperator<CPUBackend> {
  public:
   ImgcodecPeekImageShape(const ImgcodecPeekImageShape &) = delete;
@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,10 +15,17 @@
 #ifndef DALI_OPERATORS_INPUT_VIDEO_INPUT_H_
 #define DALI_OPERATORS_INPUT_VIDEO_INPUT_H_
 
+#include <condition_variable>
 #include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
+#include "dali/core/cuda_stream_pool.h"
+#include "dali/core/device_guard.h"
 #include "dali/pipeline/operator/builtin/input_operator.h"
 #include "dali/operators/decoder/video/video_decoder_base.h"
 #include "dali/operators/reader/loader/video/frames_decoder.h"
@@ -148,17 +155,27 @@ class VideoInput : public VideoDecoderBase<Backend, FramesDecoder>, public Input
           sequence_length_(spec.GetArgument<int>("sequence_length")),
           device_id_(spec.GetArgument<int>("device_id")),
           batch_size_(spec.GetArgument<int>("max_batch_size")),
-          last_sequence_policy_(spec.GetArgument<std::string>("last_sequence_policy")) {
+          last_sequence_policy_(spec.GetArgument<std::string>("last_sequence_policy")),
+          prefetch_queue_depth_(spec.GetArgument<int>("prefetch_queue_depth")) {
     DALI_ENFORCE(last_sequence_policy_ == "partial" || last_sequence_policy_ == "pad",
                  make_string("Provided `last_sequence_policy` is not supported: ",
                              last_sequence_policy_));
+    DALI_ENFORCE(prefetch_queue_depth_ >= 0, make_string(
+                 "`prefetch_queue_depth` must not be negative; got ", prefetch_queue_depth_));
     if constexpr (!is_cpu) {
       thread_pool_.emplace(this->num_threads_, spec.GetArgument<int>("device_id"),
                            spec.GetArgument<bool>("affine"), "VideoInput<MixedBackend>");
+      if (prefetch_queue_depth_ > 0)
+        decode_stream_ = CUDAStreamPool::instance().Get(device_id_);
     }
   }
 
 
+  ~VideoInput() override {
+    StopDecodeAhead();
+  }
+
+
 
   int NextBatchSize() override {
     return batch_size_;
@@ -201,6 +218,51 @@ class VideoInput : public VideoDecoderBase<Backend, FramesDecoder>, public Input
   }
 
 
+  /// A batch of sequences decoded ahead by the background thread.
+  struct DecodedBatch {
+    std::unique_ptr<TensorList<OutBackend>> frames;
+    /// There won't be any more output using the current input.
+    bool input_depleted = false;
+    std::exception_ptr error;
+  };
+
+
+  /**
+   * Decodes the next batch of sequences of the current input to `output`.
+   *
+   * @return True, if the current input is depleted.
+   */
+  bool DecodeSequences(TensorList<OutBackend> &output, std::optional<cudaStream_t> stream);
+
+  /**
+   * The stream used for decoding - the background thread doesn't use the stream of the workspace.
+   */
+  std::optional<cudaStream_t> DecodeStream(const Workspace &ws) const {
+    if constexpr (is_cpu) {
+      return std::nullopt;
+    } else {
+      return decode_stream_ ? decode_stream_->get() : ws.stream();
+    }
+  }
+
+  /**
+   * Starts decoding the batches described by output_descs_ in a background thread.
+   *
+   * At most `prefetch_queue_depth_` decoded batches are kept, waiting for Run.
+   */
+  void StartDecodeAhead();
+
+  /**
+   * Stops the background thread and discards the batches decoded so far.
+   */
+  void StopDecodeAhead();
+
+  void DecodeAheadLoop(std::deque<OutputDesc> output_descs);
+
+  /// Gets the next batch decoded by the background thread, waiting for it if necessary.
+  DecodedBatch PopDecodedBatch();
+
+
   void LoadDataFromInputOperator(ThreadPool &thread_pool);
 
   void SetNextDataIdTrace(Workspace &ws, std::string next_data_id);
@@ -282,6 +344,8 @@ class VideoInput : public VideoDecoderBase<Backend, FramesDecoder>, public Input
   const int device_id_ = {};
   const int batch_size_ = {};
   const std::string last_sequence_policy_;
+  /// How many batches are decoded ahead in a background thread; 0 - the frames are decoded in Run.
+  const int prefetch_queue_depth_ = {};
 
   /// VideoInput is initialized, when it's ready to return decoded sequences using given input.
   bool initialized_ = false;
@@ -302,6 +366,15 @@ class VideoInput : public VideoDecoderBase<Backend, FramesDecoder>, public Input
   std::optional<ThreadPool> thread_pool_ = std::nullopt;
 
   TensorLayout in_layout_ = "B";  // Byte stream.
+
+  /// The stream used by the background thread, when decoding on the GPU.
+  std::optional<CUDAStreamLease> decode_stream_;
+  std::thread decode_thread_;
+  std::mutex decoded_mtx_;
+  std::condition_variable decoded_cv_;
+  /// The batches decoded ahead (guarded by decoded_mtx_)
+  std::deque<DecodedBatch> decoded_;
+  bool stop_decoding_ = false;
 };
 
 
@@ -351,42 +424,145 @@ bool VideoInput<Backend, FramesDecoder>::SetupImpl(std::vector<OutputDesc> &outp
 
     // This has to be done for every video file, since we need to know the shape of the frames.
     if (last_sequence_policy_ == "pad") {
-      InitializePadValue(0, !is_cpu ? std::make_optional(ws.stream()) : std::nullopt);
+      InitializePadValue(0, DecodeStream(ws));
     }
 
     initialized_ = true;
+    if (prefetch_queue_depth_ > 0)
+      StartDecodeAhead();
   }
   output_desc.resize(1);
   output_desc[0] = output_descs_.front();
   output_descs_.pop_front();
-  return true;
+  // When decoding ahead, the output shares the memory of a batch decoded in the background.
+  return prefetch_queue_depth_ == 0;
 }
 
 
 template<typename Backend, typename FramesDecoder>
-void VideoInput<Backend, FramesDecoder>::VideoInputRunImpl(Workspace &ws) {
-  auto &output = ws.Output<OutBackend>(0);
-  output.SetLayout("FHWC");
-
-  bool full_sequence;
+bool VideoInput<Backend, FramesDecoder>::DecodeSequences(TensorList<OutBackend> &output,
+                                                         std::optional<cudaStream_t> stream) {
+  bool full_sequence = true;
   for (int64_t s = 0; s < output.num_samples(); s++) {
     auto pad_value = last_sequence_policy_ == "pad" ? std::optional<SampleView<OutBackend>>(
             pad_frame_creator_.GetPadFrame()) : std::nullopt;
-    full_sequence = this->DecodeFrames(output[s], 0, sequence_length_, pad_value,
-                                       ws.has_stream() ? std::make_optional(ws.stream())
-                                                       : std::nullopt);
+    full_sequence = this->DecodeFrames(output[s], 0, sequence_length_, pad_value, stream);
     if (!full_sequence) {
       break;
     }
   }
+  return !full_sequence || frames_decoders_[0]->NextFrameIdx() == -1;
+}
 
-  // If true, this operator can be run again, after this Run.
-  bool will_return_next = true;
+
+template<typename Backend, typename FramesDecoder>
+void VideoInput<Backend, FramesDecoder>::StartDecodeAhead() {
+  assert(!decode_thread_.joinable());
+  stop_decoding_ = false;
+  decode_thread_ = std::thread([this, descs = output_descs_]() mutable {
+    DecodeAheadLoop(std::move(descs));
+  });
+}
+
+
+template<typename Backend, typename FramesDecoder>
+void VideoInput<Backend, FramesDecoder>::StopDecodeAhead() {
+  {
+    std::lock_guard<std::mutex> lock(decoded_mtx_);
+    stop_decoding_ = true;
+  }
+  decoded_cv_.notify_all();
+  if (decode_thread_.joinable())
+    decode_thread_.join();
+  decoded_.clear();
+}
+
+
+template<typename Backend, typename FramesDecoder>
+void VideoInput<Backend, FramesDecoder>::DecodeAheadLoop(std::deque<OutputDesc> output_descs) {
+  std::optional<DeviceGuard> device_guard;
+  if constexpr (!is_cpu)
+    device_guard.emplace(device_id_);
+  auto stream = decode_stream_ ? std::make_optional(decode_stream_->get()) : std::nullopt;
+  for (size_t i = 0; i < output_descs.size(); i++) {
+    {
+      std::unique_lock<std::mutex> lock(decoded_mtx_);
+      decoded_cv_.wait(lock, [&]() {
+        return stop_decoding_ || static_cast<int>(decoded_.size()) < prefetch_queue_depth_;
+      });
+      if (stop_decoding_)
+        return;
+    }
+    DecodedBatch batch;
+    try {
+      batch.frames = std::make_unique<TensorList<OutBackend>>();
+      batch.frames->set_order(stream ? AccessOrder(*stream) : AccessOrder::host());
+      batch.frames->Resize(output_descs[i].shape, output_descs[i].type);
+      batch.frames->SetLayout("FHWC");
+      // The last batch depletes the input, even if the decoder could read more frames
+      // than the container metadata tells.
+      batch.input_depleted =
+          DecodeSequences(*batch.frames, stream) || i + 1 == output_descs.size();
+    } catch (...) {
+      batch.error = std::current_exception();
+      batch.input_depleted = true;
+    }
+    bool done = batch.input_depleted;
+    {
+      std::lock_guard<std::mutex> lock(decoded_mtx_);
+      decoded_.push_back(std::move(batch));
+    }
+    decoded_cv_.notify_all();
+    if (done)
+      return;
+  }
+}
+
+
+template<typename Backend, typename FramesDecoder>
+auto VideoInput<Backend, FramesDecoder>::PopDecodedBatch() -> DecodedBatch {
+  DecodedBatch batch;
+  {
+    std::unique_lock<std::mutex> lock(decoded_mtx_);
+    decoded_cv_.wait(lock, [&]() { return !decoded_.empty(); });
+    batch = std::move(decoded_.front());
+    decoded_.pop_front();
+  }
+  decoded_cv_.notify_all();
+  return batch;
+}
+
+
+template<typename Backend, typename FramesDecoder>
+void VideoInput<Backend, FramesDecoder>::VideoInputRunImpl(Workspace &ws) {
+  auto &output = ws.Output<OutBackend>(0);
 
   // There won't be any more output using the current input.
-  bool input_sample_depleted = !full_sequence || frames_decoders_[0]->NextFrameIdx() == -1;
+  bool input_sample_depleted;
+  if (prefetch_queue_depth_ > 0) {
+    auto batch = PopDecodedBatch();
+    if (batch.error) {
+      StopDecodeAhead();
+      Invalidate();
+      std::rethrow_exception(batch.error);
+    }
+    output.ShareData(*batch.frames);
+    // the output order waits for the decoding stream
+    output.set_order(ws.output_order());
+    input_sample_depleted = batch.input_depleted;
+  } else {
+    output.SetLayout("FHWC");
+    input_sample_depleted = DecodeSequences(output, ws.has_stream() ?
+                                                    std::make_optional(ws.stream()) :
+                                                    std::nullopt);
+  }
+
+  // If true, this operator can be run again, after this Run.
+  bool will_return_next = true;
 
   if (input_sample_depleted) {
+    // The decoder uses the input data - the background thread must finish before it's replaced.
+    StopDecodeAhead();
     Invalidate();
     if (this->HasDataInQueue()) {
       /*
@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -115,6 +115,15 @@ be padded with empty frames.
 
 Allowed values are ``'partial'`` and ``'pad'``.
 )code", "partial")
+                .AddOptionalArg("prefetch_queue_depth", R"code(
+Number of batches decoded ahead in a background thread.
+
+The video is demuxed and decoded in the background while the previous batches are processed by
+the pipeline. At most ``prefetch_queue_depth`` decoded batches are buffered, so the memory
+used for buffering is bounded by ``prefetch_queue_depth * max_batch_size * sequence_length``
+frames, regardless of the length of the video. If set to 0, the frames are decoded when
+the operator is run.
+)code", 1)
                 .AddOptionalArg("affine", R"code(
 Applies only to the mixed backend type.
 If set to True, each thread in the internal thread pool will be tied to a specific CPU core.
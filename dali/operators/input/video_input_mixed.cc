@@ -1,4 +1,4 @@
-// Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2023-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -23,8 +23,8 @@ void VideoInput<MixedBackend, dali::FramesDecoderGpu>::CreateDecoder(const Works
   auto sample = encoded_video_[0];
   auto data = reinterpret_cast<const char *>(sample.data<uint8_t>());
   size_t size = sample.shape().num_elements();
-  this->frames_decoders_[0] = std::make_unique<dali::FramesDecoderGpu>(data, size, ws.stream(),
-                                                                       false);
+  this->frames_decoders_[0] = std::make_unique<dali::FramesDecoderGpu>(data, size,
+                                                                       *DecodeStream(ws), false);
   DALI_ENFORCE(this->frames_decoders_[0]->IsValid(),
                "Failed to create video decoder for provided video data");
 }
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -14,6 +14,8 @@
 
 #include <vector>
 
+#include "dali/core/math_util.h"
+#include "dali/core/util.h"
 #include "dali/kernels/type_tag.h"
 #include "dali/operators/math/expressions/arithmetic.h"
 
@@ -21,21 +23,24 @@ namespace dali {
 namespace expr {
 
 template <>
-void ArithmeticGenericOp<CPUBackend>::RunImpl(Workspace &ws) {
-  PrepareSamplesPerTask<CPUBackend>(samples_per_task_, exec_order_, ws, constant_storage_, spec_);
+void ArithmeticGenericOp<CPUBackend>::RunTasks(Workspace &ws, int begin, int end,
+                                               const TensorListShape<> &shape) {
   auto &pool = ws.GetThreadPool();
-  ws.Output<CPUBackend>(0).SetLayout(result_layout_);
-
   int ndim = 1;
-  for (const auto &samples : samples_per_task_) {
-    for (const auto &sample : samples) {
+  for (int i = begin; i < end; i++) {
+    for (const auto &sample : samples_per_task_[i]) {
       ndim = std::max(ndim, sample.output.shape.sample_dim());
     }
   }
   if (ndim == 1) {
-    std::tie(tile_cover_, tile_range_) = GetTiledCover(result_shape_, kTileSize, kTaskSize);
+    // Make enough tasks to keep all the threads busy, if the batch is small
+    int64_t num_tiles = 0;
+    for (int s = 0; s < shape.num_samples(); s++)
+      num_tiles += div_ceil(shape.tensor_size(s), kTileSize);
+    int tiles_per_task = clamp<int64_t>(div_ceil(num_tiles, pool.NumThreads()), 1, kTaskSize);
+    std::tie(tile_cover_, tile_range_) = GetTiledCover(shape, kTileSize, tiles_per_task);
   } else {
-    std::tie(tile_cover_, tile_range_) = GetOneTilePerSample(result_shape_);
+    std::tie(tile_cover_, tile_range_) = GetOneTilePerSample(shape);
   }
 
   int batch_size = ws.GetInputBatchSize(0);
@@ -46,7 +51,7 @@ void ArithmeticGenericOp<CPUBackend>::RunImpl(Workspace &ws) {
           // Go over "tiles"
           for (int extent_idx = range.begin; extent_idx < range.end; extent_idx++) {
             // Go over expression tree in some provided order
-            for (size_t i = 0; i < exec_order_.size(); i++) {
+            for (int i = begin; i < end; i++) {
               assert(batch_size == static_cast<int>(samples_per_task_[i].size()));
               auto samples = make_cspan(samples_per_task_[i]);
               exec_order_[i].impl->Execute(exec_order_[i].ctx, samples,
@@ -54,11 +59,30 @@ void ArithmeticGenericOp<CPUBackend>::RunImpl(Workspace &ws) {
             }
           }
         },
-        -task_idx);  // FIFO order, since the work is already divided to similarly sized chunks
+        // The 1D tasks are similarly sized and run in FIFO order; the whole samples are
+        // processed starting from the largest, so that the threads finish at a similar time.
+        ndim == 1 ? -static_cast<int64_t>(task_idx)
+                  : tile_cover_[tile_range_[task_idx].begin].size);
   }
   pool.RunAll();
 }
 
+template <>
+void ArithmeticGenericOp<CPUBackend>::RunImpl(Workspace &ws) {
+  PrepareSamplesPerTask<CPUBackend>(samples_per_task_, exec_order_, ws, constant_storage_,
+                                    intermediate_, spec_);
+  ws.Output<CPUBackend>(0).SetLayout(result_layout_);
+
+  int ntasks = exec_order_.size();
+  if (uniform_shapes_) {
+    RunTasks(ws, 0, ntasks, result_shape_);
+  } else {
+    // With broadcasting, a tile of a node may need any part of the results of its subexpressions
+    for (int i = 0; i < ntasks; i++)
+      RunTasks(ws, i, i + 1, exec_order_[i].ctx.node->GetShape());
+  }
+}
+
 }  // namespace expr
 
 DALI_SCHEMA(ArithmeticGenericOp)
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -21,14 +21,26 @@ namespace expr {
 
 template <>
 void ArithmeticGenericOp<GPUBackend>::RunImpl(Workspace &ws) {
-  PrepareSamplesPerTask<GPUBackend>(samples_per_task_, exec_order_, ws, constant_storage_, spec_);
+  if (fused_impl_) {
+    samples_per_task_.resize(1);
+    ExtractFusedSampleDescs<GPUBackend>(samples_per_task_[0],
+                                        dynamic_cast<const ExprFunc &>(*expr_), ws,
+                                        constant_storage_);
+  } else {
+    PrepareSamplesPerTask<GPUBackend>(samples_per_task_, exec_order_, ws, constant_storage_,
+                                      intermediate_, spec_);
+  }
   ws.Output<GPUBackend>(0).SetLayout(result_layout_);
-  std::tie(tile_cover_, tile_range_) = GetTiledCover(result_shape_, kTileSize, kTaskSize);
-  assert(tile_range_.size() == 1 && "Expected to cover whole GPU execution by 1 task");
-  auto tiles = make_cspan(tile_cover_);
   for (size_t i = 0; i < exec_order_.size(); i++) {
+    // the intermediate results may have a different shape than the output (broadcasting)
+    auto &shape = exec_order_[i].ctx.node->GetShape();
+    std::tie(tile_cover_, tile_range_) = GetTiledCover(shape, kTileSize, kTaskSize);
+    assert(tile_range_.size() <= 1 && "Expected to cover whole GPU execution by 1 task");
+    if (tile_cover_.empty())
+      continue;
     // call impl for whole batch
-    exec_order_[i].impl->Execute(exec_order_[i].ctx, make_cspan(samples_per_task_[i]), tiles);
+    exec_order_[i].impl->Execute(exec_order_[i].ctx, make_cspan(samples_per_task_[i]),
+                                 make_cspan(tile_cover_));
   }
 }
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -31,6 +31,7 @@
 #include "dali/operators/math/expressions/broadcasting.h"
 #include "dali/operators/math/expressions/arithmetic_meta.h"
 #include "dali/operators/math/expressions/expression_impl_factory.h"
+#include "dali/operators/math/expressions/expression_jit.h"
 #include "dali/pipeline/operator/checkpointing/stateless_operator.h"
 
 namespace dali {
@@ -314,7 +315,10 @@ inline void CheckAllowedOperations(ExprNode &expr) {
  * @brief Arithmetic operator capable of executing expression tree of element-wise
  *        arithmetic operations.
  *
- * Only expressions consisting of one function node with tensor inputs are now supported.
+ * The results of the inner function nodes of the tree are stored in intermediate buffers
+ * and consumed by their parents. If all the nodes produce results of the same shape, the CPU
+ * variant evaluates the whole tree tile by tile, so the intermediate results are consumed
+ * while they're still in the cache.
  *
  * There are 3 levels for unit of work.
  * - Thread (CPUBackend) or CUDA kernel invokation (GPUBackend)
@@ -325,6 +329,10 @@ inline void CheckAllowedOperations(ExprNode &expr) {
  * For CPUBackend we have fixed number of threads that get to process a number of tasks,
  * so the work is evenly distributed. For GPUBackend we pack all tiles into 1 task, to limit
  * the number of CUDA calls.
+ *
+ * If the runtime compilation of the expressions is enabled (see IsExpressionJitEnabled),
+ * the GPU variant evaluates the whole tree with one kernel generated for it, without
+ * the intermediate buffers.
  */
 template <typename Backend>
 class ArithmeticGenericOp : public StatelessOperator<Backend> {
@@ -363,11 +371,20 @@ class ArithmeticGenericOp : public StatelessOperator<Backend> {
       AccessOrder order = ws.has_stream() ? ws.stream() : AccessOrder::host();
       constant_storage_.Initialize(spec_, order, constant_nodes);
       CheckAllowedOperations(*expr_);
+      if constexpr (std::is_same<Backend, GPUBackend>::value) {
+        if (expr_->GetNodeType() == NodeType::Function)
+          fused_impl_ = CreateFusedExprImplGPU(dynamic_cast<ExprFunc &>(*expr_));
+      }
       types_layout_inferred_ = true;
     }
 
-    AllocateIntermediateNodes();
-    exec_order_ = CreateExecutionTasks<Backend>(*expr_, cache_, ws.has_stream() ? ws.stream() : 0);
+    if (fused_impl_) {
+      exec_order_ = {{fused_impl_.get(), {ws.stream(), expr_.get()}}};
+    } else {
+      AllocateIntermediateNodes(ws);
+      exec_order_ =
+          CreateExecutionTasks<Backend>(*expr_, cache_, ws.has_stream() ? ws.stream() : 0);
+    }
 
     output_desc[0] = {result_shape_, result_type_id_};
     return true;
@@ -377,23 +394,45 @@ class ArithmeticGenericOp : public StatelessOperator<Backend> {
   void RunImpl(Workspace &ws) override;
 
  private:
-  void AllocateIntermediateNodes() {
+  void AllocateIntermediateNodes(const Workspace &ws) {
     auto &expr = *expr_;
-    bool is_simple_expression = expr.GetNodeType() == NodeType::Function &&
-                                expr.GetSubexpressionCount() > 0 &&
-                                expr.GetSubexpressionCount() <= kMaxArity;
-    auto &func = dynamic_cast<ExprFunc &>(expr);
+    DALI_ENFORCE(expr.GetNodeType() == NodeType::Function &&
+                 expr.GetSubexpressionCount() > 0 &&
+                 expr.GetSubexpressionCount() <= kMaxArity,
+                 "The root of the expression tree must be a function node with one to three "
+                 "inputs.");
+    AccessOrder order = ws.has_stream() ? ws.stream() : AccessOrder::host();
+    uniform_shapes_ = true;
+    AllocateIntermediateNodes(dynamic_cast<ExprFunc &>(expr), order);
+  }
+
+  void AllocateIntermediateNodes(ExprFunc &func, AccessOrder order) {
     for (int i = 0; i < func.GetSubexpressionCount(); i++) {
-      is_simple_expression = is_simple_expression && func[i].GetNodeType() != NodeType::Function;
+      if (func[i].GetNodeType() != NodeType::Function)
+        continue;
+      auto &subexpr = dynamic_cast<ExprFunc &>(func[i]);
+      auto [it, inserted] = intermediate_.try_emplace(&subexpr);
+      auto &buffer = it->second;
+      if (inserted && std::is_same<Backend, CPUBackend>::value)
+        buffer.set_pinned(false);
+      buffer.set_order(order);
+      buffer.Resize(subexpr.GetShape(), subexpr.GetTypeId());
+      uniform_shapes_ = uniform_shapes_ && subexpr.GetShape() == result_shape_;
+      AllocateIntermediateNodes(subexpr, order);
     }
-
-    DALI_ENFORCE(is_simple_expression,
-                 "Complex expression trees are not yet supported. Only expressions containing one "
-                 "function node with one or two inputs are supported.");
-    // TODO(klecki): allocate memory for intermediate results and point the threads to them
   }
 
+  /**
+   * @brief Executes the tasks [begin, end) of the execution order over a tiled `shape`.
+   *
+   * Each tile is processed by all the tasks before the next one is started.
+   */
+  void RunTasks(Workspace &ws, int begin, int end, const TensorListShape<> &shape);
+
   std::unique_ptr<ExprNode> expr_;
+  IntermediateResults<Backend> intermediate_;
+  /** All the intermediate results have the same shape as the final one */
+  bool uniform_shapes_ = true;
   TensorListShape<> result_shape_;
   bool types_layout_inferred_ = false;
   DALIDataType result_type_id_ = DALIDataType::DALI_NO_TYPE;
@@ -404,6 +443,8 @@ class ArithmeticGenericOp : public StatelessOperator<Backend> {
   std::vector<std::vector<SampleDesc>> samples_per_task_;
   ConstantStorage<Backend> constant_storage_;
   ExprImplCache cache_;
+  /** Evaluates the whole tree in one pass, if the expression was compiled at runtime */
+  std::unique_ptr<ExprImplBase> fused_impl_;
   // For CPU we limit the tile size to limit the sizes of intermediate buffers
   // For GPU it's better to execute more at one time.
   static constexpr int kTileSize =
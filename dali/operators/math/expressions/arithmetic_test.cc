@@ -583,6 +583,57 @@ TEST(ArithmeticOpsTest, ConstantsPipeline) {
   }
 }
 
+TEST(ArithmeticOpsTest, ExpressionTreePipeline) {
+  constexpr int magic_int = 42;
+  constexpr int batch_size = 16;
+  constexpr int num_threads = 4;
+  constexpr int tensor_elements = 16;
+  Pipeline pipe(batch_size, num_threads, 0);
+
+  pipe.AddExternalInput("data0");
+  pipe.AddExternalInput("data1");
+
+  for (std::string device : {"cpu", "gpu"}) {
+    pipe.AddOperator(OpSpec("ArithmeticGenericOp")
+                         .AddArg("device", device)
+                         .AddArg("expression_desc", "mul(add(&0 $0:int32) sub(&1 minus(&0)))")
+                         .AddArg("integer_constants", std::vector<int>{magic_int})
+                         .AddInput("data0", device)
+                         .AddInput("data1", device)
+                         .AddOutput("result_" + device, device),
+                     "arithm_" + device);
+  }
+
+  vector<std::pair<string, string>> outputs = {{"result_cpu", "cpu"}, {"result_gpu", "gpu"}};
+
+  pipe.Build(outputs);
+
+  TensorList<CPUBackend> batch;
+  FillBatch<int>(batch, uniform_list_shape(batch_size, {tensor_elements}));
+
+  pipe.SetExternalInput("data0", batch);
+  pipe.SetExternalInput("data1", batch);
+  pipe.Run();
+  Workspace ws;
+  pipe.Outputs(&ws);
+
+  vector<int32_t> result_gpu_cpu(tensor_elements);
+  for (int sample_id = 0; sample_id < batch_size; sample_id++) {
+    const auto *data = batch.tensor<int>(sample_id);
+    auto *result_cpu = ws.Output<CPUBackend>(0).tensor<int32_t>(sample_id);
+    auto *result_gpu = ws.Output<GPUBackend>(1).tensor<int32_t>(sample_id);
+
+    MemCopy(result_gpu_cpu.data(), result_gpu, tensor_elements * sizeof(int));
+    CUDA_CALL(cudaStreamSynchronize(0));
+
+    for (int i = 0; i < tensor_elements; i++) {
+      int expected = (data[i] + magic_int) * (data[i] + data[i]);
+      EXPECT_EQ(result_cpu[i], expected);
+      EXPECT_EQ(result_gpu_cpu[i], expected);
+    }
+  }
+}
+
 using shape_sequence = std::vector<std::array<TensorListShape<>, 3>>;
 
 int GetBatchSize(const shape_sequence &seq) {
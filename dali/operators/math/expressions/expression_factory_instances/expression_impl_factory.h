@@ -44,7 +44,7 @@ std::unique_ptr<ExprImplBase> ExprImplFactoryUnOp(const ExprFunc &expr) {
   auto input_type = expr[0].GetTypeId();
   TYPE_SWITCH(input_type, type2id, Input_t, ARITHMETIC_ALLOWED_TYPES, (
     using Out_t = typename arithm_meta<op, Backend>::template result_t<Input_t>;
-    if (expr[0].GetNodeType() == NodeType::Tensor) {
+    if (expr[0].GetNodeType() != NodeType::Constant) {
       result.reset(new ImplTensor<op, Out_t, Input_t>());
     } else {
       DALI_FAIL("Expression cannot have a constant operand");
@@ -88,7 +88,7 @@ std::unique_ptr<ExprImplBase> ExprImplFactoryBinOp(const ExprFunc &expr) {
   auto left_type = expr[0].GetTypeId();
   auto right_type = expr[1].GetTypeId();
   auto is_non_scalar = [](const ExprNode& node) {
-    return node.GetNodeType() == NodeType::Tensor && !IsScalarLike(node);
+    return !IsScalarLike(node);
   };
   auto is_scalar = [](const ExprNode& node) {
     return IsScalarLike(node);
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -19,6 +19,7 @@
 
 #include "dali/pipeline/data/types.h"
 #include "dali/operators/math/expressions/arithmetic_meta.h"
+#include "dali/operators/math/expressions/expression_impl_cpu_simd.h"
 #include "dali/operators/math/expressions/expression_impl_factory.h"
 #include "dali/operators/math/expressions/expression_tree.h"
 #include "dali/operators/math/expressions/broadcasting.h"
@@ -48,7 +49,10 @@ class ExprImplCpuT : public ExprImplBase {
 
   static void Execute(Result *result, const Input *i0, int64_t offset, int64_t extent) {
     int64_t end = offset + extent;
-    for (int64_t i = offset; i < end; i++) {
+    int64_t i = offset;
+    if constexpr (simd::is_supported<op, Result, Input>)
+      i += simd::UnarySpan<op>(result + offset, i0 + offset, extent);
+    for (; i < end; i++) {
       result[i] = meta_t::impl(i0[i]);
     }
   }
@@ -91,7 +95,10 @@ class ExprImplCpuTT : public ExprImplBase {
   static void Execute(Result *result, const Left *l, const Right *r,
                       int64_t offset, int64_t extent) {
     int64_t end = offset + extent;
-    for (int64_t i = offset; i < end; i++) {
+    int64_t i = offset;
+    if constexpr (simd::is_supported<op, Result, Left, Right>)
+      i += simd::BinarySpan<op, false, false>(result + offset, l + offset, r + offset, extent);
+    for (; i < end; i++) {
       result[i] = meta_t::impl(l[i], r[i]);
     }
   }
@@ -158,7 +165,10 @@ class ExprImplCpuCT : public ExprImplBase {
 
   static void Execute(Result *result, Left l, const Right *r, int64_t offset, int64_t extent) {
     int64_t end = offset + extent;
-    for (int64_t i = offset; i < end; i++) {
+    int64_t i = offset;
+    if constexpr (simd::is_supported<op, Result, Left, Right>)
+      i += simd::BinarySpan<op, true, false>(result + offset, &l, r + offset, extent);
+    for (; i < end; i++) {
       result[i] = meta_t::impl(l, r[i]);
     }
   }
@@ -185,7 +195,10 @@ class ExprImplCpuTC : public ExprImplBase {
 
   static void Execute(Result *result, const Left *l, Right r, int64_t offset, int64_t extent) {
     int64_t end = offset + extent;
-    for (int64_t i = offset; i < end; i++) {
+    int64_t i = offset;
+    if constexpr (simd::is_supported<op, Result, Left, Right>)
+      i += simd::BinarySpan<op, false, true>(result + offset, l + offset, &r, extent);
+    for (; i < end; i++) {
       result[i] = meta_t::impl(l[i], r);
     }
   }
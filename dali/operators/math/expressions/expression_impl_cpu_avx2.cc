@@ -0,0 +1,65 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/math/expressions/expression_impl_cpu_simd.h"
+
+#if DALI_CPU_DISPATCH_X86
+
+#include <immintrin.h>
+#include <cstdint>
+#include "dali/core/force_inline.h"
+
+// Only the code below is compiled with AVX2 enabled - the functions defined in the headers
+// included above (which may also be instantiated in other translation units) are not.
+DALI_CPU_TARGET_BEGIN_AVX2
+
+namespace dali {
+namespace expr {
+namespace simd {
+
+struct AVX2Vec {
+  using vec = __m256;
+  static constexpr int kLanes = 8;
+
+  DALI_FORCEINLINE static vec set1(float x) { return _mm256_set1_ps(x); }
+  DALI_FORCEINLINE static vec load(const float *in) { return _mm256_loadu_ps(in); }
+  DALI_FORCEINLINE static void store(float *out, vec v) { _mm256_storeu_ps(out, v); }
+
+  DALI_FORCEINLINE static vec add(vec a, vec b) { return _mm256_add_ps(a, b); }
+  DALI_FORCEINLINE static vec sub(vec a, vec b) { return _mm256_sub_ps(a, b); }
+  DALI_FORCEINLINE static vec mul(vec a, vec b) { return _mm256_mul_ps(a, b); }
+  DALI_FORCEINLINE static vec div(vec a, vec b) { return _mm256_div_ps(a, b); }
+  // minps/maxps return the second operand if the comparison is false, as the scalar code does
+  DALI_FORCEINLINE static vec min(vec a, vec b) { return _mm256_min_ps(a, b); }
+  DALI_FORCEINLINE static vec max(vec a, vec b) { return _mm256_max_ps(a, b); }
+
+  DALI_FORCEINLINE static vec sqrt(vec x) { return _mm256_sqrt_ps(x); }
+  DALI_FORCEINLINE static vec neg(vec x) { return _mm256_xor_ps(x, set1(-0.0f)); }
+  DALI_FORCEINLINE static vec fabs(vec x) { return _mm256_andnot_ps(set1(-0.0f), x); }
+  DALI_FORCEINLINE static vec abs(vec x) {
+    return _mm256_blendv_ps(x, neg(x), _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ));
+  }
+};
+
+}  // namespace simd
+}  // namespace expr
+}  // namespace dali
+
+#include "dali/operators/math/expressions/expression_impl_cpu_simd_impl.h"
+
+DALI_CPU_TARGET_END
+
+DALI_ARITHM_SIMD_DEFINE(CpuIsa::AVX2, AVX2Vec)
+
+#endif  // DALI_CPU_DISPATCH_X86
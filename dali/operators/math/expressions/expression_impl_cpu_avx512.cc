@@ -0,0 +1,74 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/math/expressions/expression_impl_cpu_simd.h"
+
+#if DALI_CPU_DISPATCH_X86
+
+#if defined(__GNUC__) && !defined(__clang__)
+// GCC reports the intentionally undefined vectors in avx512fintrin.h as uninitialized
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+#include <immintrin.h>
+#include <cstdint>
+#include "dali/core/force_inline.h"
+
+// Only the code below is compiled with AVX-512 enabled - see expression_impl_cpu_avx2.cc
+DALI_CPU_TARGET_BEGIN_AVX512
+
+namespace dali {
+namespace expr {
+namespace simd {
+
+struct AVX512Vec {
+  using vec = __m512;
+  static constexpr int kLanes = 16;
+
+  DALI_FORCEINLINE static vec set1(float x) { return _mm512_set1_ps(x); }
+  DALI_FORCEINLINE static vec load(const float *in) { return _mm512_loadu_ps(in); }
+  DALI_FORCEINLINE static void store(float *out, vec v) { _mm512_storeu_ps(out, v); }
+
+  DALI_FORCEINLINE static vec add(vec a, vec b) { return _mm512_add_ps(a, b); }
+  DALI_FORCEINLINE static vec sub(vec a, vec b) { return _mm512_sub_ps(a, b); }
+  DALI_FORCEINLINE static vec mul(vec a, vec b) { return _mm512_mul_ps(a, b); }
+  DALI_FORCEINLINE static vec div(vec a, vec b) { return _mm512_div_ps(a, b); }
+  // see AVX2Vec::min
+  DALI_FORCEINLINE static vec min(vec a, vec b) { return _mm512_min_ps(a, b); }
+  DALI_FORCEINLINE static vec max(vec a, vec b) { return _mm512_max_ps(a, b); }
+
+  DALI_FORCEINLINE static vec sqrt(vec x) { return _mm512_sqrt_ps(x); }
+  // the floating point xor needs AVX-512 DQ
+  DALI_FORCEINLINE static vec neg(vec x) {
+    return _mm512_castsi512_ps(
+        _mm512_xor_si512(_mm512_castps_si512(x), _mm512_set1_epi32(0x80000000u)));
+  }
+  DALI_FORCEINLINE static vec fabs(vec x) { return _mm512_abs_ps(x); }
+  DALI_FORCEINLINE static vec abs(vec x) {
+    __mmask16 negative = _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_LT_OQ);
+    return _mm512_mask_blend_ps(negative, x, neg(x));
+  }
+};
+
+}  // namespace simd
+}  // namespace expr
+}  // namespace dali
+
+#include "dali/operators/math/expressions/expression_impl_cpu_simd_impl.h"
+
+DALI_CPU_TARGET_END
+
+DALI_ARITHM_SIMD_DEFINE(CpuIsa::AVX512, AVX512Vec)
+
+#endif  // DALI_CPU_DISPATCH_X86
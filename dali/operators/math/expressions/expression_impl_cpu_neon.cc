@@ -0,0 +1,59 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/math/expressions/expression_impl_cpu_simd.h"
+
+#if DALI_CPU_DISPATCH_NEON
+
+#include <arm_neon.h>
+#include <cstdint>
+#include "dali/core/force_inline.h"
+
+namespace dali {
+namespace expr {
+namespace simd {
+
+struct NEONVec {
+  using vec = float32x4_t;
+  static constexpr int kLanes = 4;
+
+  DALI_FORCEINLINE static vec set1(float x) { return vdupq_n_f32(x); }
+  DALI_FORCEINLINE static vec load(const float *in) { return vld1q_f32(in); }
+  DALI_FORCEINLINE static void store(float *out, vec v) { vst1q_f32(out, v); }
+
+  DALI_FORCEINLINE static vec add(vec a, vec b) { return vaddq_f32(a, b); }
+  DALI_FORCEINLINE static vec sub(vec a, vec b) { return vsubq_f32(a, b); }
+  DALI_FORCEINLINE static vec mul(vec a, vec b) { return vmulq_f32(a, b); }
+  DALI_FORCEINLINE static vec div(vec a, vec b) { return vdivq_f32(a, b); }
+  // vminq/vmaxq propagate NaNs, which the scalar code doesn't - a select is used instead
+  DALI_FORCEINLINE static vec min(vec a, vec b) { return vbslq_f32(vcltq_f32(a, b), a, b); }
+  DALI_FORCEINLINE static vec max(vec a, vec b) { return vbslq_f32(vcgtq_f32(a, b), a, b); }
+
+  DALI_FORCEINLINE static vec sqrt(vec x) { return vsqrtq_f32(x); }
+  DALI_FORCEINLINE static vec neg(vec x) { return vnegq_f32(x); }
+  DALI_FORCEINLINE static vec fabs(vec x) { return vabsq_f32(x); }
+  DALI_FORCEINLINE static vec abs(vec x) {
+    return vbslq_f32(vcltq_f32(x, vdupq_n_f32(0)), vnegq_f32(x), x);
+  }
+};
+
+}  // namespace simd
+}  // namespace expr
+}  // namespace dali
+
+#include "dali/operators/math/expressions/expression_impl_cpu_simd_impl.h"
+
+DALI_ARITHM_SIMD_DEFINE(CpuIsa::NEON, NEONVec)
+
+#endif  // DALI_CPU_DISPATCH_NEON
@@ -0,0 +1,151 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_IMPL_CPU_SIMD_H_
+#define DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_IMPL_CPU_SIMD_H_
+
+#include <cstdint>
+#include <type_traits>
+#include "dali/kernels/common/cpu_isa.h"
+#include "dali/operators/math/expressions/arithmetic_meta.h"
+
+// Wide SIMD variants of the most common element-wise operations on float tensors, selected at
+// run time (see dali/kernels/common/cpu_isa.h). The results are identical to the scalar code
+// in expression_impl_cpu.h, which handles all the other cases and the remaining elements.
+
+namespace dali {
+namespace expr {
+namespace simd {
+
+using kernels::CpuIsa;
+
+template <ArithmeticOp op>
+constexpr bool is_supported_unary_op =
+    op == ArithmeticOp::minus || op == ArithmeticOp::sqrt || op == ArithmeticOp::abs ||
+    op == ArithmeticOp::fabs;
+
+template <ArithmeticOp op>
+constexpr bool is_supported_binary_op =
+    op == ArithmeticOp::add || op == ArithmeticOp::sub || op == ArithmeticOp::mul ||
+    op == ArithmeticOp::div || op == ArithmeticOp::fdiv || op == ArithmeticOp::min ||
+    op == ArithmeticOp::max;
+
+/**
+ * @brief Checks if there's a vectorized variant of `op` with the result and argument types
+ */
+template <ArithmeticOp op, typename Result, typename... Args>
+constexpr bool is_supported =
+    (sizeof...(Args) == 1 ? is_supported_unary_op<op> : is_supported_binary_op<op>) &&
+    std::is_same<Result, float>::value && (std::is_same<Args, float>::value && ...);
+
+/**
+ * @brief Calculates `out[i] = op(in[i])` for i in [0, n)
+ *
+ * @return The number of processed elements - the remaining ones
+ *         (fewer than a few vector widths) are left to the caller.
+ */
+template <CpuIsa isa, ArithmeticOp op>
+int64_t UnarySpanImpl(float *out, const float *in, int64_t n);
+
+/**
+ * @brief Calculates `out[i] = op(l[i], r[i])` for i in [0, n)
+ *
+ * If `left_scalar` (`right_scalar`) is true, `l` (`r`) points to a single value, which is used
+ * for all the elements.
+ *
+ * @return The number of processed elements - the remaining ones
+ *         (fewer than a few vector widths) are left to the caller.
+ */
+template <CpuIsa isa, ArithmeticOp op, bool left_scalar, bool right_scalar>
+int64_t BinarySpanImpl(float *out, const float *l, const float *r, int64_t n);
+
+// X-macros listing the (explicitly specialized) variants of UnarySpanImpl and BinarySpanImpl;
+// `X` is invoked with `(isa, arg, op[, left_scalar, right_scalar])`
+
+#define DALI_ARITHM_SIMD_UNARY_OPS(X, isa, arg)                                                  \
+  X(isa, arg, ArithmeticOp::minus)                                                               \
+  X(isa, arg, ArithmeticOp::sqrt)                                                                \
+  X(isa, arg, ArithmeticOp::abs)                                                                 \
+  X(isa, arg, ArithmeticOp::fabs)
+
+#define DALI_ARITHM_SIMD_BINARY_OPS(X, isa, arg)                                                 \
+  DALI_ARITHM_SIMD_BINARY_ARGS(X, isa, arg, ArithmeticOp::add)                                   \
+  DALI_ARITHM_SIMD_BINARY_ARGS(X, isa, arg, ArithmeticOp::sub)                                   \
+  DALI_ARITHM_SIMD_BINARY_ARGS(X, isa, arg, ArithmeticOp::mul)                                   \
+  DALI_ARITHM_SIMD_BINARY_ARGS(X, isa, arg, ArithmeticOp::div)                                   \
+  DALI_ARITHM_SIMD_BINARY_ARGS(X, isa, arg, ArithmeticOp::fdiv)                                  \
+  DALI_ARITHM_SIMD_BINARY_ARGS(X, isa, arg, ArithmeticOp::min)                                   \
+  DALI_ARITHM_SIMD_BINARY_ARGS(X, isa, arg, ArithmeticOp::max)
+
+#define DALI_ARITHM_SIMD_BINARY_ARGS(X, isa, arg, op)                                            \
+  X(isa, arg, op, false, false)                                                                  \
+  X(isa, arg, op, false, true)                                                                   \
+  X(isa, arg, op, true, false)
+
+#define DALI_ARITHM_SIMD_DECLARE_UNARY(isa, unused, op)                                          \
+  template <>                                                                                    \
+  int64_t UnarySpanImpl<isa, op>(float *, const float *, int64_t);
+
+#define DALI_ARITHM_SIMD_DECLARE_BINARY(isa, unused, op, left_scalar, right_scalar)              \
+  template <>                                                                                    \
+  int64_t BinarySpanImpl<isa, op, left_scalar, right_scalar>(float *, const float *,             \
+                                                             const float *, int64_t);
+
+#define DALI_ARITHM_SIMD_DECLARE(isa)                                                            \
+  DALI_ARITHM_SIMD_UNARY_OPS(DALI_ARITHM_SIMD_DECLARE_UNARY, isa, _)                             \
+  DALI_ARITHM_SIMD_BINARY_OPS(DALI_ARITHM_SIMD_DECLARE_BINARY, isa, _)
+
+#if DALI_CPU_DISPATCH_X86
+DALI_ARITHM_SIMD_DECLARE(CpuIsa::AVX2)
+DALI_ARITHM_SIMD_DECLARE(CpuIsa::AVX512)
+#endif
+#if DALI_CPU_DISPATCH_NEON
+DALI_ARITHM_SIMD_DECLARE(CpuIsa::NEON)
+#endif
+
+/**
+ * @brief Runs the best available variant of `UnarySpanImpl`
+ *
+ * If there's none, nothing is processed and 0 is returned.
+ */
+template <ArithmeticOp op>
+inline int64_t UnarySpan(float *out, const float *in, int64_t n) {
+  return kernels::DispatchCpuIsa([&](auto isa) -> int64_t {
+    if constexpr (isa() == CpuIsa::Baseline)
+      return 0;
+    else
+      return UnarySpanImpl<isa(), op>(out, in, n);
+  });
+}
+
+/**
+ * @brief Runs the best available variant of `BinarySpanImpl`
+ *
+ * If there's none, nothing is processed and 0 is returned.
+ */
+template <ArithmeticOp op, bool left_scalar, bool right_scalar>
+inline int64_t BinarySpan(float *out, const float *l, const float *r, int64_t n) {
+  return kernels::DispatchCpuIsa([&](auto isa) -> int64_t {
+    if constexpr (isa() == CpuIsa::Baseline)
+      return 0;
+    else
+      return BinarySpanImpl<isa(), op, left_scalar, right_scalar>(out, l, r, n);
+  });
+}
+
+}  // namespace simd
+}  // namespace expr
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_IMPL_CPU_SIMD_H_
@@ -0,0 +1,138 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_IMPL_CPU_SIMD_IMPL_H_
+#define DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_IMPL_CPU_SIMD_IMPL_H_
+
+// The code below is generic over the vector type `V` and it's compiled once per instruction set.
+// It must only be included in the translation units which enable that instruction set for the
+// code that follows (see expression_impl_cpu_avx2.cc) - that is, after all the other includes.
+//
+// `V` provides:
+//   vec                                - the vector of floats
+//   kLanes                             - the number of floats in `vec`
+//   set1(x), load(float*), store(float*, v)
+//   add, sub, mul, div, sqrt, neg      - IEEE operations, as in the scalar code
+//   min(a, b), max(a, b)               - a < b ? a : b and a > b ? a : b, respectively
+//   abs(x)                             - x < 0 ? -x : x (keeps the sign of -0 and NaN)
+//   fabs(x)                            - clears the sign bit
+
+namespace dali {
+namespace expr {
+namespace simd {
+
+template <typename V, ArithmeticOp op>
+DALI_FORCEINLINE typename V::vec UnaryOp(typename V::vec x) {
+  if constexpr (op == ArithmeticOp::minus)
+    return V::neg(x);
+  else if constexpr (op == ArithmeticOp::sqrt)
+    return V::sqrt(x);
+  else if constexpr (op == ArithmeticOp::abs)
+    return V::abs(x);
+  else
+    return V::fabs(x);
+}
+
+template <typename V, ArithmeticOp op>
+DALI_FORCEINLINE typename V::vec BinaryOp(typename V::vec l, typename V::vec r) {
+  if constexpr (op == ArithmeticOp::add)
+    return V::add(l, r);
+  else if constexpr (op == ArithmeticOp::sub)
+    return V::sub(l, r);
+  else if constexpr (op == ArithmeticOp::mul)
+    return V::mul(l, r);
+  else if constexpr (op == ArithmeticOp::div || op == ArithmeticOp::fdiv)
+    return V::div(l, r);
+  else if constexpr (op == ArithmeticOp::min)
+    return V::min(l, r);
+  else
+    return V::max(l, r);
+}
+
+template <typename V, ArithmeticOp op>
+inline int64_t UnaryVecSpan(float *out, const float *in, int64_t n) {
+  constexpr int kNumLanes = 4 * V::kLanes;
+  int64_t i = 0;
+  for (; i + kNumLanes <= n; i += kNumLanes) {
+    for (int v = 0; v < 4; v++) {
+      int64_t j = i + v * V::kLanes;
+      V::store(out + j, UnaryOp<V, op>(V::load(in + j)));
+    }
+  }
+  return i;
+}
+
+template <typename V, ArithmeticOp op, bool left_scalar, bool right_scalar>
+inline int64_t BinaryVecSpan(float *out, const float *l, const float *r, int64_t n) {
+  using vec = typename V::vec;
+  constexpr int kNumLanes = 4 * V::kLanes;
+  vec l_scalar, r_scalar;
+  if constexpr (left_scalar)
+    l_scalar = V::set1(*l);
+  if constexpr (right_scalar)
+    r_scalar = V::set1(*r);
+  int64_t i = 0;
+  for (; i + kNumLanes <= n; i += kNumLanes) {
+    for (int v = 0; v < 4; v++) {
+      int64_t j = i + v * V::kLanes;
+      vec a, b;
+      if constexpr (left_scalar)
+        a = l_scalar;
+      else
+        a = V::load(l + j);
+      if constexpr (right_scalar)
+        b = r_scalar;
+      else
+        b = V::load(r + j);
+      V::store(out + j, BinaryOp<V, op>(a, b));
+    }
+  }
+  return i;
+}
+
+}  // namespace simd
+}  // namespace expr
+}  // namespace dali
+
+/**
+ * Defines the specializations of UnarySpanImpl and BinarySpanImpl for instruction set `isa`,
+ * which call UnaryVecSpan and BinaryVecSpan with the vector type `V`.
+ *
+ * This must be used after the instruction set is disabled again - the specializations are called
+ * from the generic code and they're compiled for the baseline instruction set.
+ */
+#define DALI_ARITHM_SIMD_DEFINE(isa, V)                                                          \
+namespace dali {                                                                                 \
+namespace expr {                                                                                 \
+namespace simd {                                                                                 \
+DALI_ARITHM_SIMD_UNARY_OPS(DALI_ARITHM_SIMD_DEFINE_UNARY, isa, V)                                \
+DALI_ARITHM_SIMD_BINARY_OPS(DALI_ARITHM_SIMD_DEFINE_BINARY, isa, V)                              \
+}  /* namespace simd */                                                                          \
+}  /* namespace expr */                                                                          \
+}  /* namespace dali */
+
+#define DALI_ARITHM_SIMD_DEFINE_UNARY(isa, V, op)                                                \
+template <>                                                                                      \
+int64_t UnarySpanImpl<isa, op>(float *out, const float *in, int64_t n) {                         \
+  return UnaryVecSpan<V, op>(out, in, n);                                                        \
+}
+
+#define DALI_ARITHM_SIMD_DEFINE_BINARY(isa, V, op, left_scalar, right_scalar)                    \
+template <>                                                                                      \
+int64_t BinarySpanImpl<isa, op, left_scalar, right_scalar>(float *out, const float *l,           \
+                                                           const float *r, int64_t n) {          \
+  return BinaryVecSpan<V, op, left_scalar, right_scalar>(out, l, r, n);                          \
+}
+
+#endif  // DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_IMPL_CPU_SIMD_IMPL_H_
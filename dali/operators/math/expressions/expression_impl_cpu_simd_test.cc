@@ -0,0 +1,131 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "dali/operators/math/expressions/arithmetic_meta.h"
+#include "dali/operators/math/expressions/expression_impl_cpu_simd.h"
+
+namespace dali {
+namespace expr {
+namespace simd {
+
+namespace {
+
+/**
+ * @brief Checks if the values are bitwise identical; all NaNs are considered equal
+ */
+bool SameValue(float a, float b) {
+  if (std::isnan(a) && std::isnan(b))
+    return true;
+  uint32_t ia, ib;
+  std::memcpy(&ia, &a, sizeof(a));
+  std::memcpy(&ib, &b, sizeof(b));
+  return ia == ib;
+}
+
+class ArithmSimdTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    constexpr int n = 1003;  // not a multiple of the vector width
+    std::mt19937_64 rng(1234);
+    std::uniform_real_distribution<float> dist(-100, 100);
+    l_.resize(n);
+    r_.resize(n);
+    for (int i = 0; i < n; i++) {
+      l_[i] = dist(rng);
+      r_[i] = dist(rng);
+    }
+    // the special values, for which the results depend on the exact semantics of the operations
+    l_[3] = NAN;
+    r_[5] = NAN;
+    l_[7] = -0.0f;
+    r_[7] = 0.0f;
+    l_[8] = 0.0f;
+    r_[8] = -0.0f;
+    l_[9] = -NAN;
+    r_[10] = 0.0f;
+  }
+
+  template <ArithmeticOp op>
+  void TestUnary() {
+    using meta_t = arithm_meta<op, CPUBackend>;
+    int64_t n = l_.size();
+    std::vector<float> out(n);
+    int64_t processed = UnarySpan<op>(out.data(), l_.data(), n);
+    EXPECT_LE(processed, n);
+    for (int64_t i = 0; i < processed; i++)
+      ASSERT_TRUE(SameValue(out[i], meta_t::impl(l_[i])))
+          << "at " << i << ": " << out[i] << " vs " << meta_t::impl(l_[i]);
+  }
+
+  template <ArithmeticOp op, bool left_scalar, bool right_scalar>
+  void TestBinary() {
+    using meta_t = arithm_meta<op, CPUBackend>;
+    int64_t n = l_.size();
+    std::vector<float> out(n);
+    int64_t processed = BinarySpan<op, left_scalar, right_scalar>(out.data(), l_.data(),
+                                                                  r_.data(), n);
+    EXPECT_LE(processed, n);
+    for (int64_t i = 0; i < processed; i++) {
+      float ref = meta_t::impl(l_[left_scalar ? 0 : i], r_[right_scalar ? 0 : i]);
+      ASSERT_TRUE(SameValue(out[i], ref)) << "at " << i << ": " << out[i] << " vs " << ref;
+    }
+  }
+
+  template <ArithmeticOp op>
+  void TestBinary() {
+    TestBinary<op, false, false>();
+    TestBinary<op, true, false>();
+    TestBinary<op, false, true>();
+  }
+
+  std::vector<float> l_, r_;
+};
+
+}  // namespace
+
+TEST_F(ArithmSimdTest, Unary) {
+  TestUnary<ArithmeticOp::minus>();
+  TestUnary<ArithmeticOp::sqrt>();
+  TestUnary<ArithmeticOp::abs>();
+  TestUnary<ArithmeticOp::fabs>();
+}
+
+TEST_F(ArithmSimdTest, Binary) {
+  TestBinary<ArithmeticOp::add>();
+  TestBinary<ArithmeticOp::sub>();
+  TestBinary<ArithmeticOp::mul>();
+  TestBinary<ArithmeticOp::div>();
+  TestBinary<ArithmeticOp::fdiv>();
+  TestBinary<ArithmeticOp::min>();
+  TestBinary<ArithmeticOp::max>();
+}
+
+TEST(ArithmSimd, SupportedTypes) {
+  static_assert(is_supported<ArithmeticOp::add, float, float, float>);
+  static_assert(is_supported<ArithmeticOp::sqrt, float, float>);
+  static_assert(!is_supported<ArithmeticOp::add, double, double, double>);
+  static_assert(!is_supported<ArithmeticOp::add, float, float, int>);
+  static_assert(!is_supported<ArithmeticOp::sqrt, float, float, float>);
+  static_assert(!is_supported<ArithmeticOp::exp, float, float>);
+}
+
+}  // namespace simd
+}  // namespace expr
+}  // namespace dali
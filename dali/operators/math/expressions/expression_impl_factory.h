@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -131,9 +131,19 @@ struct ExprImplTask {
   ExprImplContext ctx;
 };
 
+/**
+ * @brief The results of the inner Function nodes of an expression tree.
+ *
+ * The root node writes directly to the output of the operator.
+ */
+template <typename Backend>
+using IntermediateResults = std::map<const ExprNode *, TensorList<Backend>>;
+
 template <typename Backend>
-inline OutputData GetOutput(const ExprFunc &func, Workspace &ws, int sample_idx) {
-  auto &out = ws.Output<Backend>(0);
+inline OutputData GetOutput(const ExprFunc &func, Workspace &ws,
+                            IntermediateResults<Backend> &intermediate, int sample_idx) {
+  auto it = intermediate.find(&func);
+  auto &out = it != intermediate.end() ? it->second : ws.Output<Backend>(0);
   void *out_ptr = out.raw_mutable_tensor(sample_idx);
   auto shape = out.shape()[sample_idx];
   TensorShape<> strides;
@@ -147,59 +157,69 @@ inline OutputData GetOutput(const ExprFunc &func, Workspace &ws, int sample_idx)
   return ret;
 }
 
+/**
+ * @brief Type erased obtaining pointer to the data of an operand of a function node
+ */
+template <typename Backend>
+inline OperandData GetOperandData(const ExprNode &node, Workspace &ws,
+                                  const ConstantStorage<Backend> &st,
+                                  const IntermediateResults<Backend> &intermediate,
+                                  int sample_idx) {
+  OperandData result;
+  if (node.GetNodeType() == NodeType::Function) {
+    auto it = intermediate.find(&node);
+    DALI_ENFORCE(it != intermediate.end(), "No buffer for the result of a subexpression");
+    auto &in = it->second;
+    result.data = in.raw_tensor(sample_idx);
+    result.dtype = node.GetTypeId();
+    result.shape = in.tensor_shape(sample_idx);
+    kernels::CalcStrides(result.strides, result.shape);
+  } else if (node.GetNodeType() == NodeType::Constant) {
+    const auto &constant = dynamic_cast<const ExprConstant &>(node);
+    result.data = st.GetPointer(constant.GetConstIndex(), constant.GetTypeId());
+    result.dtype = constant.GetTypeId();
+    result.shape = {};
+    result.strides = {};
+  } else if (node.GetNodeType() == NodeType::Tensor) {
+    const auto &tensor = dynamic_cast<const ExprTensor &>(node);
+    auto input_idx = tensor.GetInputIndex();
+    auto &in = ws.Input<Backend>(input_idx);
+    result.data = in.raw_tensor(sample_idx);
+    result.dtype = tensor.GetTypeId();
+    result.shape = in.tensor_shape(sample_idx);
+    kernels::CalcStrides(result.strides, result.shape);
+  }
+  return result;
+}
+
 /**
  * @brief Type erased obtaining pointers to inputs
  */
 template <typename Backend>
 inline ArgPack GetArgPack(const ExprFunc &func, Workspace &ws,
-                          const ConstantStorage<Backend> &st, const OpSpec &spec, int sample_idx) {
+                          const ConstantStorage<Backend> &st,
+                          const IntermediateResults<Backend> &intermediate,
+                          const OpSpec &spec, int sample_idx) {
   ArgPack result;
   result.resize(func.GetSubexpressionCount());
   for (int i = 0; i < func.GetSubexpressionCount(); i++) {
-    DALI_ENFORCE(func[i].GetNodeType() != NodeType::Function,
-                 "Function nodes are not supported as subexpressions");
-    if (func[i].GetNodeType() == NodeType::Constant) {
-      const auto &constant = dynamic_cast<const ExprConstant &>(func[i]);
-      result[i].data = st.GetPointer(constant.GetConstIndex(), constant.GetTypeId());
-      result[i].dtype = constant.GetTypeId();
-      result[i].shape = {};
-      result[i].strides = {};
-    } else if (func[i].GetNodeType() == NodeType::Tensor) {
-      const auto &tensor = dynamic_cast<const ExprTensor &>(func[i]);
-      auto input_idx = tensor.GetInputIndex();
-      auto &in = ws.Input<Backend>(input_idx);
-      result[i].data = in.raw_tensor(sample_idx);
-      result[i].dtype = tensor.GetTypeId();
-      result[i].shape = in.tensor_shape(sample_idx);
-      kernels::CalcStrides(result[i].strides, result[i].shape);
-    }
+    result[i] = GetOperandData(func[i], ws, st, intermediate, sample_idx);
   }
   return result;
 }
 
 /**
- * @brief Extracts sample descriptor (pointer, shape, strides, dtype for inputs/outputs)
+ * @brief Simplifies the shapes of the outputs and arguments of the samples and calculates
+ *        the argument strides used for broadcasting.
  */
-template <typename Backend>
-void ExtractSampleDescs(std::vector<SampleDesc> &out_samples,
-                        const ExprFunc &func,
-                        Workspace &ws, const ConstantStorage<Backend> &st,
-                        const OpSpec &spec) {
-  int nsamples =  ws.GetInputBatchSize(0);
-  out_samples.clear();
-  out_samples.reserve(nsamples);
-  if (nsamples == 0)
-    return;
-
+inline void PrepareForBroadcasting(std::vector<SampleDesc> &out_samples) {
+  int nsamples = out_samples.size();
   for (int s = 0; s < nsamples; s++) {
-    out_samples.emplace_back(GetOutput<Backend>(func, ws, s), GetArgPack(func, ws, st, spec, s));
-
     SmallVector<TensorShape<>*, kMaxArity + 1> shape_ptrs;
-    shape_ptrs.push_back(&(out_samples.back().output.shape));
-    for (auto &arg : out_samples.back().args) {
+    shape_ptrs.push_back(&(out_samples[s].output.shape));
+    for (auto &arg : out_samples[s].args) {
       shape_ptrs.push_back(&arg.shape);
     }
-    span<TensorShape<>*> shape_ptrs_span = make_span(shape_ptrs);
     SimplifyShapesForBroadcasting(make_span(shape_ptrs));
   }
 
@@ -226,6 +246,28 @@ void ExtractSampleDescs(std::vector<SampleDesc> &out_samples,
   CheckBroadcastingSimplifiedDim(max_ndim);
 }
 
+/**
+ * @brief Extracts sample descriptor (pointer, shape, strides, dtype for inputs/outputs)
+ */
+template <typename Backend>
+void ExtractSampleDescs(std::vector<SampleDesc> &out_samples,
+                        const ExprFunc &func,
+                        Workspace &ws, const ConstantStorage<Backend> &st,
+                        IntermediateResults<Backend> &intermediate,
+                        const OpSpec &spec) {
+  int nsamples =  ws.GetInputBatchSize(0);
+  out_samples.clear();
+  out_samples.reserve(nsamples);
+  if (nsamples == 0)
+    return;
+
+  for (int s = 0; s < nsamples; s++) {
+    out_samples.emplace_back(GetOutput<Backend>(func, ws, intermediate, s),
+                             GetArgPack(func, ws, st, intermediate, spec, s));
+  }
+  PrepareForBroadcasting(out_samples);
+}
+
 /**
  * @brief Prepare data needed for execution.
  *        Fills vector of SampleDesc for every task that we have to execute, including
@@ -236,13 +278,15 @@ void PrepareSamplesPerTask(std::vector<std::vector<SampleDesc>> &samples_per_tas
                            const std::vector<ExprImplTask> &task_exec_order,
                            Workspace &ws,
                            const ConstantStorage<Backend> &constant_storage,
+                           IntermediateResults<Backend> &intermediate,
                            const OpSpec &spec) {
   int ntasks = task_exec_order.size();
   samples_per_task.resize(ntasks);
   for (int i = 0; i < ntasks; i++) {
     const auto &expr_task = task_exec_order[i];
     const auto &expr_func = dynamic_cast<const ExprFunc &>(*expr_task.ctx.node);
-    ExtractSampleDescs<Backend>(samples_per_task[i], expr_func, ws, constant_storage, spec);
+    ExtractSampleDescs<Backend>(samples_per_task[i], expr_func, ws, constant_storage,
+                                intermediate, spec);
   }
 }
 
@@ -0,0 +1,600 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cuda_runtime.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/dynlink_cuda.h"
+#include "dali/operators/math/expressions/expression_impl_gpu.cuh"
+#include "dali/operators/math/expressions/expression_jit.h"
+#include "dali/operators/math/expressions/nvrtc_wrap.h"
+
+namespace dali {
+namespace expr {
+
+namespace {
+
+/**
+ * @brief The sample descriptor, as declared in the generated source
+ */
+struct JitSample {
+  void *out;
+  int64_t out_strides[ARITHM_OPS_MAX_DIM];  // NOLINT[runtime/arrays]
+  int ndim;
+};
+
+/**
+ * @brief The leaf (operand) descriptor, as declared in the generated source
+ */
+struct JitArg {
+  const void *data;
+  int64_t strides[ARITHM_OPS_MAX_DIM];  // NOLINT[runtime/arrays]
+};
+
+static_assert(ARITHM_OPS_MAX_DIM == 6, "The generated source assumes up to 6 dimensions");
+
+/**
+ * @brief Device functions with the same semantics as `arithm_meta<op, GPUBackend>::impl`.
+ *
+ * The first template argument of each `op_*` function is the result type of the node;
+ * the operands are passed with their own types.
+ */
+const char kFusedExprPrelude[] = R"code(
+typedef long long i64;
+
+struct Sample {
+  void *out;
+  i64 out_strides[6];
+  int ndim;
+};
+
+struct Arg {
+  const void *data;
+  i64 strides[6];
+};
+
+struct Tile {
+  int sample_idx;
+  i64 offset;
+  i64 size;
+};
+
+#define DEVICE __device__ __forceinline__
+
+template <typename T> struct is_sint { static const bool value = false; };
+template <> struct is_sint<signed char> { static const bool value = true; };
+template <> struct is_sint<short> { static const bool value = true; };
+template <> struct is_sint<int> { static const bool value = true; };
+template <> struct is_sint<long long> { static const bool value = true; };
+
+template <typename T> struct to_unsigned;
+template <> struct to_unsigned<signed char> { typedef unsigned char type; };
+template <> struct to_unsigned<short> { typedef unsigned short type; };
+template <> struct to_unsigned<int> { typedef unsigned int type; };
+template <> struct to_unsigned<long long> { typedef unsigned long long type; };
+
+DEVICE bool mul_(bool a, bool b) { return a && b; }
+template <typename T> DEVICE T mul_(T a, T b) { return a * b; }
+
+template <typename T> DEVICE T abs_(T x) { return x < 0 ? -x : x; }
+DEVICE unsigned char abs_(unsigned char x) { return x; }
+DEVICE unsigned short abs_(unsigned short x) { return x; }
+DEVICE unsigned int abs_(unsigned int x) { return x; }
+DEVICE unsigned long long abs_(unsigned long long x) { return x; }
+
+DEVICE float rsqrt_(float x) { return __frsqrt_rn(x); }
+DEVICE double rsqrt_(double x) { return rsqrt(x); }
+
+template <typename T> DEVICE T pow_(T x, T y) {
+  if (is_sint<T>::value && y < 0)
+    return 0;
+  T acc = 1;
+  while (y > 0) {
+    if (y & 1)
+      acc *= x;
+    x *= x;
+    y >>= 1;
+  }
+  return acc;
+}
+DEVICE float pow_(float x, float y) { return powf(x, y); }
+DEVICE double pow_(double x, double y) { return pow(x, y); }
+
+#define UNARY_OP(NAME, EXPR)                        \
+  template <typename T, typename A>                 \
+  DEVICE T op_##NAME(A a) {                         \
+    T v = static_cast<T>(a);                        \
+    return static_cast<T>(EXPR);                    \
+  }
+
+#define BINARY_OP(NAME, EXPR)                       \
+  template <typename T, typename L, typename R>     \
+  DEVICE T op_##NAME(L l, R r) {                    \
+    T a = static_cast<T>(l), b = static_cast<T>(r); \
+    return static_cast<T>(EXPR);                    \
+  }
+
+#define COMPARE_OP(NAME, EXPR, LEFT_NEGATIVE, RIGHT_NEGATIVE)                                  \
+  template <typename L, typename R, bool LS = is_sint<L>::value, bool RS = is_sint<R>::value> \
+  struct cmp_##NAME {                                                                         \
+    static DEVICE bool cmp(L l, R r) { return l EXPR r; }                                     \
+  };                                                                                          \
+  template <typename L, typename R>                                                           \
+  struct cmp_##NAME<L, R, true, false> {                                                      \
+    static DEVICE bool cmp(L l, R r) {                                                        \
+      if (l < 0)                                                                              \
+        return LEFT_NEGATIVE;                                                                 \
+      return static_cast<typename to_unsigned<L>::type>(l) EXPR r;                            \
+    }                                                                                         \
+  };                                                                                          \
+  template <typename L, typename R>                                                           \
+  struct cmp_##NAME<L, R, false, true> {                                                      \
+    static DEVICE bool cmp(L l, R r) {                                                        \
+      if (r < 0)                                                                              \
+        return RIGHT_NEGATIVE;                                                                \
+      return l EXPR static_cast<typename to_unsigned<R>::type>(r);                            \
+    }                                                                                         \
+  };                                                                                          \
+  template <typename T, typename L, typename R>                                               \
+  DEVICE T op_##NAME(L l, R r) {                                                              \
+    return cmp_##NAME<L, R>::cmp(l, r);                                                       \
+  }
+
+UNARY_OP(plus, +v)
+UNARY_OP(minus, -v)
+UNARY_OP(sqrt, sqrt(v))
+UNARY_OP(rsqrt, rsqrt_(v))
+UNARY_OP(cbrt, cbrt(v))
+UNARY_OP(exp, exp(v))
+UNARY_OP(log, log(v))
+UNARY_OP(log2, log2(v))
+UNARY_OP(log10, log10(v))
+UNARY_OP(abs, abs_(v))
+UNARY_OP(fabs, fabs(v))
+UNARY_OP(floor, floor(v))
+UNARY_OP(ceil, ceil(v))
+UNARY_OP(sin, sin(v))
+UNARY_OP(cos, cos(v))
+UNARY_OP(tan, tan(v))
+UNARY_OP(asin, asin(v))
+UNARY_OP(acos, acos(v))
+UNARY_OP(atan, atan(v))
+UNARY_OP(sinh, sinh(v))
+UNARY_OP(cosh, cosh(v))
+UNARY_OP(tanh, tanh(v))
+UNARY_OP(asinh, asinh(v))
+UNARY_OP(acosh, acosh(v))
+UNARY_OP(atanh, atanh(v))
+
+BINARY_OP(add, a + b)
+BINARY_OP(sub, a - b)
+BINARY_OP(mul, mul_(a, b))
+BINARY_OP(div, a / b)
+BINARY_OP(fdiv, a / b)
+BINARY_OP(min, a < b ? a : b)
+BINARY_OP(max, a > b ? a : b)
+BINARY_OP(pow, pow_(a, b))
+BINARY_OP(fpow, pow_(a, b))
+BINARY_OP(atan2, atan2(a, b))
+BINARY_OP(bitand, a & b)
+BINARY_OP(bitor, a | b)
+BINARY_OP(bitxor, a ^ b)
+
+COMPARE_OP(eq,  ==, false, false)
+COMPARE_OP(neq, !=, true,  true)
+COMPARE_OP(lt,  <,  true,  false)
+COMPARE_OP(leq, <=, true,  false)
+COMPARE_OP(gt,  >,  false, true)
+COMPARE_OP(geq, >=, false, true)
+
+// The modulo is calculated on the operand types, as in the precompiled kernels
+template <typename T, typename L, typename R>
+DEVICE T op_imod(L l, R r) { return static_cast<T>(l % r); }
+template <typename T, typename L, typename R>
+DEVICE T op_fmod(L l, R r) {
+  return static_cast<T>(remainderf(static_cast<float>(l), static_cast<float>(r)));
+}
+template <typename T, typename L, typename R>
+DEVICE T op_dmod(L l, R r) {
+  return static_cast<T>(remainder(static_cast<double>(l), static_cast<double>(r)));
+}
+
+template <typename T, typename V, typename Lo, typename Hi>
+DEVICE T op_clamp(V v, Lo lo, Hi hi) {
+  return static_cast<T>(min(static_cast<T>(hi), max(static_cast<T>(v), static_cast<T>(lo))));
+}
+)code";
+
+/**
+ * @brief The name of the type used in the generated source or nullptr, if the type
+ *        is not supported.
+ */
+const char *GetCTypeName(DALIDataType type) {
+  switch (type) {
+    case DALI_BOOL:
+      return "bool";
+    case DALI_INT8:
+      return "signed char";
+    case DALI_UINT8:
+      return "unsigned char";
+    case DALI_INT16:
+      return "short";
+    case DALI_UINT16:
+      return "unsigned short";
+    case DALI_INT32:
+      return "int";
+    case DALI_UINT32:
+      return "unsigned int";
+    case DALI_INT64:
+      return "long long";
+    case DALI_UINT64:
+      return "unsigned long long";
+    case DALI_FLOAT:
+      return "float";
+    case DALI_FLOAT64:
+      return "double";
+    default:
+      return nullptr;
+  }
+}
+
+/**
+ * @brief The name of the device function (without the `op_` prefix) implementing the function
+ *        node `func`.
+ */
+std::string GetOpFuncName(const ExprFunc &func) {
+  if (NameToOp(func.GetFuncName()) != ArithmeticOp::mod)
+    return func.GetFuncName();
+  auto l = func[0].GetTypeId(), r = func[1].GetTypeId();
+  if (IsIntegral(l) && IsIntegral(r))
+    return "imod";
+  bool is_double = TypeTable::GetTypeInfo(l).size() >= sizeof(double) ||
+                   TypeTable::GetTypeInfo(r).size() >= sizeof(double);
+  return is_double ? "dmod" : "fmod";
+}
+
+/**
+ * @brief Writes the C++ expression evaluating `node`; the leaves are referred to as `v<idx>`.
+ *
+ * @return false, if any of the types is not supported
+ */
+bool GenerateExpr(std::ostream &os, const ExprNode &node, int &leaf_idx) {
+  if (!GetCTypeName(node.GetTypeId()))
+    return false;
+  if (node.GetNodeType() != NodeType::Function) {
+    os << "v" << leaf_idx++;
+    return true;
+  }
+  auto &func = dynamic_cast<const ExprFunc &>(node);
+  os << "op_" << GetOpFuncName(func) << "<" << GetCTypeName(func.GetTypeId()) << ">(";
+  for (int i = 0; i < func.GetSubexpressionCount(); i++) {
+    if (i > 0)
+      os << ", ";
+    if (!GenerateExpr(os, func[i], leaf_idx))
+      return false;
+  }
+  os << ")";
+  return true;
+}
+
+/**
+ * @brief Writes one of the kernels; the constants are read once per block, the tensors
+ *        are indexed with the flat output index or with the broadcast strides.
+ */
+void GenerateKernel(std::ostream &os, const char *name, bool flat, const std::string &expr,
+                    const char *out_type, span<const ExprNode *const> leaves) {
+  int nleaves = leaves.size();
+  os << "\nextern \"C\" __global__ void " << name
+     << "(const Sample *samples, const Arg *args, const Tile *tiles) {\n"
+     << "  const Tile tile = tiles[blockIdx.y];\n"
+     << "  const Sample &sample = samples[tile.sample_idx];\n"
+     << "  const Arg *arg = args + static_cast<i64>(tile.sample_idx) * " << nleaves << ";\n"
+     << "  " << out_type << " *out = static_cast<" << out_type << " *>(sample.out);\n";
+  for (int i = 0; i < nleaves; i++) {
+    const char *type = GetCTypeName(leaves[i]->GetTypeId());
+    if (leaves[i]->GetNodeType() == NodeType::Constant)
+      os << "  const " << type << " v" << i << " = *static_cast<const " << type << " *>(arg["
+         << i << "].data);\n";
+    else
+      os << "  const " << type << " *p" << i << " = static_cast<const " << type << " *>(arg["
+         << i << "].data);\n";
+  }
+  os << "  i64 end = tile.offset + tile.size;\n"
+     << "  i64 step = static_cast<i64>(blockDim.x) * gridDim.x;\n"
+     << "  for (i64 idx = tile.offset + static_cast<i64>(blockDim.x) * blockIdx.x + threadIdx.x;\n"
+     << "       idx < end; idx += step) {\n";
+  if (!flat) {
+    os << "    i64 rem = idx;\n";
+    for (int i = 0; i < nleaves; i++) {
+      if (leaves[i]->GetNodeType() != NodeType::Constant)
+        os << "    i64 o" << i << " = 0;\n";
+    }
+    os << "    for (int d = 0; d < sample.ndim; d++) {\n"
+       << "      i64 i_d = rem / sample.out_strides[d];\n"
+       << "      rem -= i_d * sample.out_strides[d];\n";
+    for (int i = 0; i < nleaves; i++) {
+      if (leaves[i]->GetNodeType() != NodeType::Constant)
+        os << "      o" << i << " += i_d * arg[" << i << "].strides[d];\n";
+    }
+    os << "    }\n";
+  }
+  for (int i = 0; i < nleaves; i++) {
+    if (leaves[i]->GetNodeType() == NodeType::Constant)
+      continue;
+    const char *type = GetCTypeName(leaves[i]->GetTypeId());
+    os << "    const " << type << " v" << i << " = p" << i << "[" << (flat ? "idx" : "o")
+       << (flat ? "" : std::to_string(i)) << "];\n";
+  }
+  os << "    out[idx] = " << expr << ";\n"
+     << "  }\n"
+     << "}\n";
+}
+
+std::string CompileFusedExpr(const std::string &source, int arch) {
+  nvrtcProgram prog;
+  nvrtcResult res = nvrtcCreateProgram(&prog, source.c_str(), "dali_expression.cu",
+                                       0, nullptr, nullptr);
+  if (res != NVRTC_SUCCESS) {
+    DALI_WARN("Cannot create NVRTC program: ", nvrtcGetErrorString(res));
+    return {};
+  }
+  std::string arch_opt = make_string("--gpu-architecture=sm_", arch);
+  const char *opts[] = { arch_opt.c_str() };
+  std::string binary;
+  res = nvrtcCompileProgram(prog, 1, opts);
+  if (res == NVRTC_SUCCESS) {
+    size_t size = 0;
+    res = nvrtcGetCUBINSize(prog, &size);
+    if (res == NVRTC_SUCCESS) {
+      binary.resize(size);
+      res = nvrtcGetCUBIN(prog, &binary[0]);
+    }
+    if (res != NVRTC_SUCCESS) {
+      DALI_WARN("Cannot obtain the compiled arithmetic expression: ", nvrtcGetErrorString(res));
+      binary.clear();
+    }
+  } else {
+    size_t log_size = 0;
+    std::string log;
+    if (nvrtcGetProgramLogSize(prog, &log_size) == NVRTC_SUCCESS && log_size > 0) {
+      log.resize(log_size);
+      nvrtcGetProgramLog(prog, &log[0]);
+    }
+    DALI_WARN("The runtime compilation of an arithmetic expression failed (",
+              nvrtcGetErrorString(res), "), the precompiled kernels will be used instead.\n", log);
+  }
+  nvrtcDestroyProgram(&prog);
+  return binary;
+}
+
+/**
+ * @brief Header of the cached binary, it identifies the compiler and the target architecture
+ */
+std::string CacheFileHeader(const std::string &source, int arch) {
+  int major = 0, minor = 0;
+  nvrtcVersion(&major, &minor);
+  return make_string("DALI expression kernel; NVRTC ", major, ".", minor, "; sm_", arch, "; ",
+                     source.size(), "\n");
+}
+
+/**
+ * @brief Evaluates the whole expression tree with one runtime-compiled kernel.
+ *
+ * The arguments of the samples describe all the leaves of the tree, see ExtractFusedSampleDescs.
+ */
+class ExprImplGPUFused : public ExprImplBase {
+ public:
+  ExprImplGPUFused(std::string source, std::vector<bool> is_constant)
+      : source_(std::move(source)), is_constant_(std::move(is_constant)) {}
+
+  void Execute(ExprImplContext &ctx, span<const SampleDesc> samples,
+               span<const TileDesc> tiles) override {
+    auto *kernels = FusedExprKernelCache::instance().Get(source_);
+    DALI_ENFORCE(kernels, "The runtime compilation of the arithmetic expression failed.");
+    kernels::DynamicScratchpad s({}, ctx.stream);
+
+    int nsamples = samples.size();
+    int nleaves = is_constant_.size();
+    samples_.resize(nsamples);
+    args_.resize(nsamples * nleaves);
+    bool flat = true;
+    for (int i = 0; i < nsamples; i++) {
+      auto &sample = samples[i];
+      auto &desc = samples_[i];
+      int ndim = sample.output.shape.sample_dim();
+      assert(ndim <= ARITHM_OPS_MAX_DIM);  // should be checked earlier
+      assert(static_cast<int>(sample.args.size()) == nleaves);
+      desc.out = sample.output.data;
+      desc.ndim = ndim;
+      for (int d = 0; d < ndim; d++)
+        desc.out_strides[d] = sample.output.strides[d];
+      flat = flat && ndim == 1;
+      for (int a = 0; a < nleaves; a++) {
+        auto &operand = sample.args[a];
+        auto &arg = args_[i * nleaves + a];
+        arg.data = operand.data;
+        for (int d = 0; d < ndim; d++)
+          arg.strides[d] = operand.strides[d];
+        // the tensors must be either of the same shape as the output or trivially broadcast
+        flat = flat && (is_constant_[a] || operand.strides[0] == 1 ||
+                        sample.output.shape[0] == 1);
+      }
+    }
+
+    JitSample *samples_gpu;
+    JitArg *args_gpu;
+    TileDesc *tiles_gpu;
+    std::tie(samples_gpu, args_gpu, tiles_gpu) =
+        s.ToContiguousGPU(ctx.stream, samples_, args_, tiles);
+    void *params[] = { &samples_gpu, &args_gpu, &tiles_gpu };
+    auto grid = GetGridLayout(kBlocksX, tiles.size());
+    CUDA_CALL(cuLaunchKernel(flat ? kernels->flat : kernels->nd,
+                             grid.x, grid.y, grid.z,
+                             kThreadNum, 1, 1,
+                             0, ctx.stream, params, nullptr));
+  }
+
+ private:
+  std::string source_;
+  std::vector<bool> is_constant_;
+  std::vector<JitSample> samples_;
+  std::vector<JitArg> args_;
+};
+
+}  // namespace
+
+bool IsExpressionJitAvailable() {
+  return nvrtcIsSymbolAvailable("nvrtcCompileProgram") && nvrtcIsSymbolAvailable("nvrtcGetCUBIN");
+}
+
+bool IsExpressionJitEnabled() {
+  static bool enabled = []() {
+    const char *env = getenv("DALI_EXPRESSION_JIT");
+    return env && atoi(env) && IsExpressionJitAvailable();
+  }();
+  return enabled;
+}
+
+std::string GenerateFusedExprSource(const ExprFunc &expr) {
+  std::vector<const ExprNode *> leaves;
+  GetLeafNodes(expr, leaves);
+  std::stringstream expr_ss;
+  int leaf_idx = 0;
+  if (!GenerateExpr(expr_ss, expr, leaf_idx))
+    return {};
+  assert(leaf_idx == static_cast<int>(leaves.size()));
+
+  std::stringstream ss;
+  ss << kFusedExprPrelude;
+  const char *out_type = GetCTypeName(expr.GetTypeId());
+  GenerateKernel(ss, "dali_expr_flat", true, expr_ss.str(), out_type, make_cspan(leaves));
+  GenerateKernel(ss, "dali_expr_nd", false, expr_ss.str(), out_type, make_cspan(leaves));
+  return ss.str();
+}
+
+std::string FusedExprKernelCache::CachePath(const std::string &source, int arch) const {
+  std::stringstream ss;
+  ss << cache_dir_ << "/dali_expr_" << std::hex << std::hash<std::string>()(source)
+     << std::dec << "_sm" << arch << ".cubin";
+  return ss.str();
+}
+
+std::string FusedExprKernelCache::LoadBinary(const std::string &source, int arch) const {
+  if (cache_dir_.empty())
+    return {};
+  std::ifstream f(CachePath(source, arch), std::ios::binary);
+  if (!f.is_open())
+    return {};
+  std::string header;
+  std::getline(f, header);
+  if (!f.good() || header + "\n" != CacheFileHeader(source, arch))
+    return {};
+  std::string cached_source(source.size(), '\0');
+  f.read(&cached_source[0], cached_source.size());
+  if (!f.good() || cached_source != source)
+    return {};
+  return std::string(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+void FusedExprKernelCache::StoreBinary(const std::string &source, int arch,
+                                       const std::string &binary) const {
+  if (cache_dir_.empty())
+    return;
+  // write to a temporary file and rename it, so that other processes populating the same
+  // cache never see a partially written binary
+  std::string path = CachePath(source, arch);
+  std::string tmp_path = make_string(path, ".", getpid(), ".tmp");
+  {
+    std::ofstream f(tmp_path, std::ios::binary);
+    if (!f.is_open())
+      return;
+    f << CacheFileHeader(source, arch) << source;
+    f.write(binary.data(), binary.size());
+    if (!f.good()) {
+      f.close();
+      std::remove(tmp_path.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+    std::remove(tmp_path.c_str());
+}
+
+const FusedExprKernels *FusedExprKernelCache::Get(const std::string &source) {
+  int device = 0;
+  CUDA_CALL(cudaGetDevice(&device));
+  std::lock_guard<std::mutex> g(mtx_);
+  auto [it, inserted] = kernels_.try_emplace(std::make_pair(device, source));
+  auto &kernels = it->second;
+  if (!inserted)
+    return kernels.module ? &kernels : nullptr;
+
+  int major = 0, minor = 0;
+  CUDA_CALL(cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, device));
+  CUDA_CALL(cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, device));
+  int arch = major * 10 + minor;
+  std::string binary = LoadBinary(source, arch);
+  if (binary.empty()) {
+    binary = CompileFusedExpr(source, arch);
+    if (binary.empty())
+      return nullptr;
+    StoreBinary(source, arch, binary);
+  }
+  // The modules are never unloaded - the kernels may be used until the end of the process
+  CUDA_CALL(cuModuleLoadDataEx(&kernels.module, binary.data(), 0, nullptr, nullptr));
+  CUDA_CALL(cuModuleGetFunction(&kernels.flat, kernels.module, "dali_expr_flat"));
+  CUDA_CALL(cuModuleGetFunction(&kernels.nd, kernels.module, "dali_expr_nd"));
+  return &kernels;
+}
+
+FusedExprKernelCache &FusedExprKernelCache::instance() {
+  static FusedExprKernelCache instance([]() {
+    const char *dir = getenv("DALI_EXPRESSION_JIT_CACHE_DIR");
+    return std::string(dir ? dir : "");
+  }());
+  return instance;
+}
+
+std::unique_ptr<ExprImplBase> CreateFusedExprImplGPU(const ExprFunc &expr) {
+  if (!IsExpressionJitEnabled())
+    return nullptr;
+  bool nested = false;
+  for (int i = 0; i < expr.GetSubexpressionCount(); i++)
+    nested = nested || expr[i].GetNodeType() == NodeType::Function;
+  if (!nested)
+    return nullptr;
+  auto source = GenerateFusedExprSource(expr);
+  if (source.empty() || !FusedExprKernelCache::instance().Get(source))
+    return nullptr;
+  std::vector<const ExprNode *> leaves;
+  GetLeafNodes(expr, leaves);
+  std::vector<bool> is_constant;
+  for (auto *leaf : leaves)
+    is_constant.push_back(leaf->GetNodeType() == NodeType::Constant);
+  return std::make_unique<ExprImplGPUFused>(std::move(source), std::move(is_constant));
+}
+
+}  // namespace expr
+}  // namespace dali
@@ -0,0 +1,162 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_JIT_H_
+#define DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_JIT_H_
+
+#include <cuda.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dali/operators/math/expressions/constant_storage.h"
+#include "dali/operators/math/expressions/expression_impl_factory.h"
+#include "dali/operators/math/expressions/expression_tree.h"
+
+namespace dali {
+namespace expr {
+
+/**
+ * @brief Checks if NVRTC, which is needed to compile the expressions at runtime, is available.
+ */
+DLL_PUBLIC bool IsExpressionJitAvailable();
+
+/**
+ * @brief Checks if the arithmetic expressions are compiled at runtime.
+ *
+ * The runtime compilation is enabled by setting `DALI_EXPRESSION_JIT=1` and requires NVRTC.
+ * If `DALI_EXPRESSION_JIT_CACHE_DIR` is set, the compiled kernels are stored in that directory
+ * and reused by subsequent processes.
+ */
+DLL_PUBLIC bool IsExpressionJitEnabled();
+
+/**
+ * @brief Collects the leaves (tensor inputs and constants) of the tree in the order in which
+ *        they are passed to the fused kernel.
+ */
+inline void GetLeafNodes(const ExprNode &expr, std::vector<const ExprNode *> &leaves) {
+  if (expr.GetNodeType() != NodeType::Function) {
+    leaves.push_back(&expr);
+    return;
+  }
+  auto &func = dynamic_cast<const ExprFunc &>(expr);
+  for (int i = 0; i < func.GetSubexpressionCount(); i++)
+    GetLeafNodes(func[i], leaves);
+}
+
+/**
+ * @brief Generates the CUDA source of the kernels evaluating the whole `expr` tree in one pass.
+ *
+ * The source defines two `extern "C"` kernels: `dali_expr_flat`, for the samples where all the
+ * tensor leaves have the same (simplified) shape as the output and `dali_expr_nd`, which
+ * handles broadcasting.
+ *
+ * @return The source or an empty string, if the tree contains types that are not supported
+ *         by the fused kernels (float16).
+ */
+DLL_PUBLIC std::string GenerateFusedExprSource(const ExprFunc &expr);
+
+/**
+ * @brief The kernels compiled from one source for one device
+ */
+struct FusedExprKernels {
+  CUmodule module = nullptr;
+  CUfunction flat = nullptr;
+  CUfunction nd = nullptr;
+};
+
+/**
+ * @brief A process-wide cache of the runtime-compiled expression kernels.
+ *
+ * The kernels are kept for the lifetime of the process. If the cache directory is set,
+ * the compiled binaries are also stored on disk and looked up there before compiling.
+ * The files contain the source of the kernels, which is compared on load, so hash collisions
+ * never result in running a wrong kernel.
+ */
+class DLL_PUBLIC FusedExprKernelCache {
+ public:
+  explicit FusedExprKernelCache(std::string cache_dir = {}) : cache_dir_(std::move(cache_dir)) {}
+
+  /**
+   * @brief Gets the kernels compiled from `source` for the current device, compiling them
+   *        if necessary.
+   *
+   * @return The kernels or nullptr, if the compilation failed. The failures are cached as well.
+   */
+  const FusedExprKernels *Get(const std::string &source);
+
+  /**
+   * @brief Returns a reference to the singleton instance, which uses the cache directory
+   *        specified in `DALI_EXPRESSION_JIT_CACHE_DIR`.
+   */
+  static FusedExprKernelCache &instance();
+
+ private:
+  std::string CachePath(const std::string &source, int arch) const;
+  std::string LoadBinary(const std::string &source, int arch) const;
+  void StoreBinary(const std::string &source, int arch, const std::string &binary) const;
+
+  std::string cache_dir_;
+  std::map<std::pair<int, std::string>, FusedExprKernels> kernels_;
+  std::mutex mtx_;
+};
+
+/**
+ * @brief Returns an implementation evaluating the whole `expr` tree with one runtime-compiled
+ *        kernel.
+ *
+ * The kernels are compiled for the current device when the implementation is created.
+ *
+ * @return The implementation or nullptr, if the runtime compilation is disabled or failed,
+ *         the tree is not supported or it consists of just one function node, which is served
+ *         equally well by the precompiled kernels.
+ */
+std::unique_ptr<ExprImplBase> CreateFusedExprImplGPU(const ExprFunc &expr);
+
+/**
+ * @brief Extracts sample descriptors for the fused implementation.
+ *
+ * The output is the output of the operator and the arguments are all the leaves of the tree,
+ * as returned by GetLeafNodes, broadcast against the output.
+ */
+template <typename Backend>
+void ExtractFusedSampleDescs(std::vector<SampleDesc> &out_samples,
+                             const ExprFunc &func,
+                             Workspace &ws, const ConstantStorage<Backend> &st) {
+  int nsamples = ws.GetInputBatchSize(0);
+  out_samples.clear();
+  out_samples.reserve(nsamples);
+  if (nsamples == 0)
+    return;
+
+  std::vector<const ExprNode *> leaves;
+  GetLeafNodes(func, leaves);
+  IntermediateResults<Backend> no_intermediate;
+  for (int s = 0; s < nsamples; s++) {
+    ArgPack args;
+    args.reserve(leaves.size());
+    for (auto *leaf : leaves)
+      args.push_back(GetOperandData(*leaf, ws, st, no_intermediate, s));
+    out_samples.emplace_back(GetOutput<Backend>(func, ws, no_intermediate, s), args);
+  }
+  PrepareForBroadcasting(out_samples);
+}
+
+}  // namespace expr
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_JIT_H_
@@ -0,0 +1,121 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dali/core/small_vector.h"
+#include "dali/operators/math/expressions/arithmetic_meta.h"
+#include "dali/operators/math/expressions/expression_jit.h"
+#include "dali/operators/math/expressions/expression_tree.h"
+
+namespace dali {
+namespace expr {
+
+namespace {
+
+/**
+ * @brief Fills the types of the tensor inputs with `input_types` and propagates them,
+ *        as PropagateTypes does with the types of the operator inputs.
+ */
+DALIDataType SetTypes(ExprNode &expr, const std::vector<DALIDataType> &input_types) {
+  if (expr.GetNodeType() == NodeType::Constant)
+    return expr.GetTypeId();
+  if (expr.GetNodeType() == NodeType::Tensor) {
+    expr.SetTypeId(input_types[dynamic_cast<ExprTensor &>(expr).GetInputIndex()]);
+    return expr.GetTypeId();
+  }
+  auto &func = dynamic_cast<ExprFunc &>(expr);
+  SmallVector<DALIDataType, kMaxArity> types;
+  for (int i = 0; i < func.GetSubexpressionCount(); i++)
+    types.push_back(SetTypes(func[i], input_types));
+  expr.SetTypeId(TypePromotion(NameToOp(func.GetFuncName()), make_span(types)));
+  return expr.GetTypeId();
+}
+
+std::string GenerateSource(const std::string &expr_desc,
+                           const std::vector<DALIDataType> &input_types) {
+  auto expr = ParseExpressionString(expr_desc);
+  SetTypes(*expr, input_types);
+  return GenerateFusedExprSource(dynamic_cast<ExprFunc &>(*expr));
+}
+
+}  // namespace
+
+TEST(ExpressionJitTest, GenerateNestedExpression) {
+  auto source = GenerateSource("mul(add(&0 $0:int32) sub(&1 minus(&0)))",
+                               {DALI_INT32, DALI_UINT8});
+  ASSERT_FALSE(source.empty());
+  EXPECT_NE(source.find("out[idx] = op_mul<int>(op_add<int>(v0, v1), "
+                        "op_sub<int>(v2, op_minus<int>(v3)));"), std::string::npos);
+  // the constant is read once, outside of the loop
+  EXPECT_NE(source.find("const int v1 = *static_cast<const int *>(arg[1].data);"),
+            std::string::npos);
+  EXPECT_NE(source.find("const unsigned char v2 = p2[idx];"), std::string::npos);
+  EXPECT_NE(source.find("const unsigned char v2 = p2[o2];"), std::string::npos);
+  EXPECT_NE(source.find("extern \"C\" __global__ void dali_expr_flat("), std::string::npos);
+  EXPECT_NE(source.find("extern \"C\" __global__ void dali_expr_nd("), std::string::npos);
+}
+
+TEST(ExpressionJitTest, GenerateTypeDependentOps) {
+  EXPECT_NE(GenerateSource("mod(&0 add(&1 &1))", {DALI_INT16, DALI_UINT8})
+                .find("op_imod<short>(v0, op_add<unsigned char>(v1, v2))"), std::string::npos);
+  EXPECT_NE(GenerateSource("mod(&0 add(&1 &1))", {DALI_FLOAT, DALI_INT32})
+                .find("op_fmod<float>(v0, op_add<int>(v1, v2))"), std::string::npos);
+  EXPECT_NE(GenerateSource("mod(&0 add(&1 &1))", {DALI_INT64, DALI_FLOAT})
+                .find("op_dmod<float>(v0, op_add<float>(v1, v2))"), std::string::npos);
+  EXPECT_NE(GenerateSource("fdiv(&0 mul(&1 &1))", {DALI_INT32, DALI_INT8})
+                .find("op_fdiv<float>(v0, op_mul<signed char>(v1, v2))"), std::string::npos);
+  EXPECT_NE(GenerateSource("lt(&0 sqrt(&1))", {DALI_UINT32, DALI_FLOAT64})
+                .find("op_lt<bool>(v0, op_sqrt<double>(v1))"), std::string::npos);
+}
+
+TEST(ExpressionJitTest, UnsupportedTypes) {
+  EXPECT_TRUE(GenerateSource("add(&0 mul(&1 &1))", {DALI_FLOAT16, DALI_FLOAT}).empty());
+  EXPECT_TRUE(GenerateSource("add(&0 mul(&1 &1))", {DALI_FLOAT, DALI_FLOAT16}).empty());
+}
+
+TEST(ExpressionJitTest, CompileAndCache) {
+  if (!IsExpressionJitAvailable())
+    GTEST_SKIP() << "NVRTC is not available";
+  auto source = GenerateSource("clamp(mul(&0 $0:float) $1:int32 $2:int32)",
+                               {DALI_UINT8});
+  ASSERT_FALSE(source.empty());
+
+  std::string cache_dir = "/tmp/dali_expr_cache_XXXXXX";
+  ASSERT_NE(mkdtemp(&cache_dir[0]), nullptr);
+  {
+    FusedExprKernelCache cache(cache_dir);
+    auto *kernels = cache.Get(source);
+    ASSERT_NE(kernels, nullptr);
+    EXPECT_NE(kernels->flat, nullptr);
+    EXPECT_NE(kernels->nd, nullptr);
+    EXPECT_EQ(cache.Get(source), kernels);
+  }
+  {
+    // a fresh cache loads the binary stored by the previous one
+    FusedExprKernelCache cache(cache_dir);
+    auto *kernels = cache.Get(source);
+    ASSERT_NE(kernels, nullptr);
+    EXPECT_NE(kernels->nd, nullptr);
+  }
+  EXPECT_EQ(std::system(("rm -rf " + cache_dir).c_str()), 0);
+}
+
+}  // namespace expr
+}  // namespace dali
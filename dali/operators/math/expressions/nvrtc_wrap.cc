@@ -0,0 +1,69 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <dlfcn.h>
+#include <cuda.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "dali/operators/math/expressions/nvrtc_wrap.h"
+
+namespace {
+
+typedef void* NVRTCDRIVER;
+
+static const char __NvrtcLibName[] = "libnvrtc.so";
+#if CUDA_VERSION >= 12000
+static const char __NvrtcLibNameCuVer[] = "libnvrtc.so.12";
+#else
+// since CUDA 11.2 NVRTC keeps the ABI within the major version
+static const char __NvrtcLibNameCuVer[] = "libnvrtc.so.11.2";
+#endif
+
+NVRTCDRIVER loadNvrtcLibrary() {
+  NVRTCDRIVER ret = nullptr;
+
+  ret = dlopen(__NvrtcLibNameCuVer, RTLD_NOW);
+  if (!ret) {
+    ret = dlopen(__NvrtcLibName, RTLD_NOW);
+    if (!ret) {
+      fprintf(stderr, "dlopen libnvrtc.so failed! The arithmetic expressions will not be "
+                      "compiled at runtime. Please install CUDA toolkit or NVRTC python wheel.\n");
+    }
+  }
+  return ret;
+}
+
+}  // namespace
+
+void *NvrtcLoadSymbol(const char *name) {
+  static NVRTCDRIVER nvrtcDrvLib = loadNvrtcLibrary();
+  void *ret = nvrtcDrvLib ? dlsym(nvrtcDrvLib, name) : nullptr;
+  return ret;
+}
+
+bool nvrtcIsSymbolAvailable(const char *name) {
+  static std::mutex symbol_mutex;
+  static std::unordered_map<std::string, void*> symbol_map;
+  std::lock_guard<std::mutex> lock(symbol_mutex);
+  auto it = symbol_map.find(name);
+  if (it == symbol_map.end()) {
+    auto *ptr = NvrtcLoadSymbol(name);
+    symbol_map.insert({name, ptr});
+    return ptr != nullptr;
+  }
+  return it->second != nullptr;
+}
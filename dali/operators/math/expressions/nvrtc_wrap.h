@@ -0,0 +1,28 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_MATH_EXPRESSIONS_NVRTC_WRAP_H_
+#define DALI_OPERATORS_MATH_EXPRESSIONS_NVRTC_WRAP_H_
+
+#include <nvrtc.h>
+
+/**
+ * @brief Checks if the NVRTC library could be loaded and it provides the symbol `name`
+ *
+ * NVRTC is always loaded dynamically - it is only needed to compile the arithmetic
+ * expressions at runtime, which is an optional feature.
+ */
+bool nvrtcIsSymbolAvailable(const char *name);
+
+#endif  // DALI_OPERATORS_MATH_EXPRESSIONS_NVRTC_WRAP_H_
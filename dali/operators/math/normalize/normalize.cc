@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,8 +13,12 @@
 // limitations under the License.
 
 #include "dali/operators/math/normalize/normalize.h"
+#include <utility>
+#include <vector>
 #include "dali/core/math_util.h"
+#include "dali/core/small_vector.h"
 #include "dali/core/tensor_layout.h"
+#include "dali/kernels/common/split_shape.h"
 #include "dali/kernels/normalize/normalize_cpu.h"
 #include "dali/kernels/reduce/reduce_cpu.h"
 #include "dali/operators/math/normalize/normalize_utils.h"
@@ -76,6 +80,13 @@ across tensors in the batch.
 
 This argument also requires that the input sample shapes in the non-reduced axes match.)code",
     false)
+  .AddOptionalArg("running_stats", R"code(If set to True, the mean and standard deviation are
+accumulated over all the batches processed so far, including the current one.
+
+The statistics of each batch are merged with the accumulated ones, so no additional passes over
+the data are needed. This implies ``batch`` normalization and requires that the shape of the
+statistics is the same in all iterations. The accumulated statistics are a part of the
+checkpoint. The ``mean`` and ``stddev`` cannot be provided in this mode.)code", false)
   .AddOptionalArg<float>("mean", R"code(Mean value to be subtracted from the data.
 
 The value can be a scalar or a batch of tensors with the same dimensionality as the input.
@@ -136,8 +147,19 @@ class Normalize<CPUBackend> : public NormalizeBase<CPUBackend> {
   void AllocTempStorage();
   void FoldMeans();
   void FoldStdDev();
+  void FoldMeanStdDev();
+
+  void SaveRunningStats(OpCheckpoint &cpt, AccessOrder order);
+  void RestoreRunningStats(const NormalizeRunningStats &stats);
+
+  /** The minimum number of elements normalized in one task, when splitting large samples */
+  static constexpr int64_t kMinRangeSize = 1 << 16;
 
   kernels::KernelManager kmgr_;
+  std::vector<int64_t> extents_, costs_;
+  // Per-sample accumulators (for batch normalization) or per-thread ones (otherwise)
+  std::vector<std::vector<normalize::MeanVarAcc>> mean_var_;
+  std::vector<normalize::MeanVarAcc> running_mean_var_;
 };
 
 DALI_REGISTER_OPERATOR(Normalize, Normalize<CPUBackend>, CPU);
@@ -243,6 +265,52 @@ void Normalize<CPUBackend>::FoldStdDev() {
   ScaleRSqrtKeepZero(sample0.data, elems, epsilon_, rdiv, scale);
 }
 
+void Normalize<CPUBackend>::FoldMeanStdDev() {
+  int n = mean_var_.size();
+  assert(n > 0 && mean_.num_samples() > 0 && inv_stddev_.num_samples() > 0);
+  int64_t v = mean_var_[0].size();
+  SmallVector<MeanVarAcc *, 64> arrays;
+  for (auto &acc : mean_var_)
+    arrays.push_back(acc.data());
+  // the accumulators are merged pairwise
+  SumArrays(arrays.data(), n, v);
+  const MeanVarAcc *acc = arrays[0];
+  if (running_stats_) {
+    if (running_mean_var_.empty())
+      running_mean_var_.resize(v);
+    DALI_ENFORCE(static_cast<int64_t>(running_mean_var_.size()) == v, make_string(
+      "Normalize: The shape of the running statistics cannot change. Expected ",
+      running_mean_var_.size(), " values, got ", v, "."));
+    for (int64_t i = 0; i < v; i++)
+      running_mean_var_[i] += acc[i];
+    acc = running_mean_var_.data();
+  }
+  MeanVarToParams(acc, v, mean_.mutable_tensor<float>(0), inv_stddev_.mutable_tensor<float>(0),
+                  degrees_of_freedom_, epsilon_, scale_);
+}
+
+void Normalize<CPUBackend>::SaveRunningStats(OpCheckpoint &cpt, AccessOrder order) {
+  NormalizeRunningStats stats;
+  if (!running_mean_var_.empty())
+    stats.count = running_mean_var_[0].n;
+  for (auto &acc : running_mean_var_) {
+    stats.mean.push_back(acc.mean());
+    stats.m2.push_back(acc.m2());
+  }
+  cpt.MutableCheckpointState() = std::move(stats);
+}
+
+void Normalize<CPUBackend>::RestoreRunningStats(const NormalizeRunningStats &stats) {
+  running_mean_var_.resize(stats.mean.size());
+  for (size_t i = 0; i < stats.mean.size(); i++) {
+    auto &acc = running_mean_var_[i];
+    acc = {};
+    acc.n = stats.count;
+    acc.shift = stats.mean[i];
+    acc.sum_sq = stats.m2[i];
+  }
+}
+
 template <typename OutputType, typename InputType>
 void Normalize<CPUBackend>::RunTyped(Workspace &ws) {
   ThreadPool &tp = ws.GetThreadPool();
@@ -317,7 +385,22 @@ void Normalize<CPUBackend>::RunTyped(Workspace &ws) {
   // between calculating mean and standard deviation and between standard deviation
   // and rescaling the input.
 
-  if (batch_norm_) {
+  if (batch_norm_ && ShouldCalcMeanStdDev()) {
+    // Single pass over the data - the partial results are merged in FoldMeanStdDev
+    mean_var_.resize(nsamples);
+    for (int i = 0; i < nsamples; i++) {
+      tp.AddWork([&, i](int thread_idx) {
+        auto &acc = mean_var_[i];
+        acc.resize(volume(param_shape_[0]));
+        MeanVarCPU<InputType> mean_var;
+        mean_var.Setup(make_tensor_cpu(acc.data(), param_shape_[0]), in_view[i],
+                       make_span(axes_));
+        mean_var.Run();
+      }, in_shape.tensor_size(i));
+    }
+    tp.RunAll();
+    FoldMeanStdDev();
+  } else if (batch_norm_) {
     if (ShouldCalcMean()) {
       for (int i = 0; i < nsamples; i++) {
         tp.AddWork([&, i](int thread_idx) {
@@ -351,44 +434,97 @@ void Normalize<CPUBackend>::RunTyped(Workspace &ws) {
   assert(static_cast<int>(mean_view.data.size()) == mean_view.num_samples());
   assert(static_cast<int>(inv_stddev_view.data.size()) == inv_stddev_view.num_samples());
 
+  if (!batch_norm_ && ShouldCalcMeanStdDev())
+    mean_var_.resize(nthreads);
+
+
+  auto sample_mean = [&](int i) {
+    return mean_view.num_samples() == 1 || batch_norm_ ? mean_view[0] : mean_view[i];
+  };
+
+  auto sample_inv_stddev = [&](int i) {
+    return inv_stddev_view.num_samples() == 1 || batch_norm_ ? inv_stddev_view[0]
+                                                              : inv_stddev_view[i];
+  };
+
+  // Calculates the per-sample statistics, if needed
+  auto calc_sample_stats = [&](int i, int thread_idx) {
+    if (!batch_norm_ && ShouldCalcMeanStdDev()) {
+      // Single pass over the data
+      auto &acc = mean_var_[thread_idx];
+      acc.resize(volume(param_shape_[i]));
+      MeanVarCPU<InputType> mean_var;
+      mean_var.Setup(make_tensor_cpu(acc.data(), param_shape_[i]), in_view[i],
+                     make_span(axes_));
+      mean_var.Run();
+      MeanVarToParams(acc.data(), acc.size(), mutable_mean[i].data, mutable_stddev[i].data,
+                      degrees_of_freedom_, epsilon_, scale_);
+    } else if (!batch_norm_) {
+      if (ShouldCalcMean()) {
+        kernels::MeanCPU<float, InputType> mean;
+        mean.Setup(mutable_mean[i], in_view[i], make_span(axes_));
+        // Reset per-sample values and preprocess
+        mean.Run(true, true);
+        assert(sample_mean(i).data == mutable_mean[i].data);
+      }
+
+      if (ShouldCalcStdDev()) {
+        kernels::VarianceCPU<float, InputType> stddev;
+        stddev.Setup(mutable_stddev[i], in_view[i], make_span(axes_), sample_mean(i));
+        // Reset per-sample values, but don't postprocess
+        stddev.Run(true, false);
+        // Fused postprocessing with inverse square root.
+        SumSquare2InvStdDev(mutable_stddev[i], data_shape_[i],
+                            degrees_of_freedom_, epsilon_, scale_);
+        assert(sample_inv_stddev(i).data == mutable_stddev[i].data);
+      }
+    }
+  };
 
+  using Kernel = kernels::NormalizeCPU<OutputType, InputType, float>;
+  extents_.resize(nsamples);
+  costs_.resize(nsamples);
+  bool split = false;
   for (int i = 0; i < nsamples; i++) {
-    tp.AddWork([&, i](int thread_idx) {
-      auto sample_mean = mean_view.num_samples() == 1 || batch_norm_
-                              ? mean_view[0]
-                              : mean_view[i];
+    extents_[i] = kmgr_.Get<Kernel>(i).NumSlices();
+    costs_[i] = in_shape.tensor_size(i);
+  }
+  for (int i = 0; i < nsamples && !split; i++) {
+    split = kernels::NumSampleRanges(extents_[i], costs_[i], in_shape.num_elements(), nthreads,
+                                     kMinRangeSize) > 1;
+  }
 
-      auto sample_inv_stddev = inv_stddev_view.num_samples() == 1 || batch_norm_
-                              ? inv_stddev_view[0]
-                              : inv_stddev_view[i];
+  if (!split) {
+    // Each sample is processed as a whole - the statistics and the normalization in one task
+    for (int i = 0; i < nsamples; i++) {
+      tp.AddWork([&, i](int thread_idx) {
+        calc_sample_stats(i, thread_idx);
+        kernels::KernelContext ctx;
+        kmgr_.Run<Kernel>(i, ctx,
+            out_view[i], in_view[i], sample_mean(i), sample_inv_stddev(i), shift_);
+      }, in_shape.tensor_size(i));
+    }
+    tp.RunAll();
+    return;
+  }
 
-      if (!batch_norm_) {
-        if (ShouldCalcMean()) {
-          kernels::MeanCPU<float, InputType> mean;
-          mean.Setup(mutable_mean[i], in_view[i], make_span(axes_));
-          // Reset per-sample values and preprocess
-          mean.Run(true, true);
-          assert(sample_mean.data == mutable_mean[i].data);
-        }
+  // There are large samples, which are split between the threads - the statistics
+  // must be known before normalizing any part of the sample.
+  if (!batch_norm_ && (ShouldCalcMeanStdDev() || ShouldCalcMean() || ShouldCalcStdDev())) {
+    for (int i = 0; i < nsamples; i++) {
+      tp.AddWork([&, i](int thread_idx) {
+        calc_sample_stats(i, thread_idx);
+      }, in_shape.tensor_size(i));
+    }
+    tp.RunAll();
+  }
 
-        if (ShouldCalcStdDev()) {
-          kernels::VarianceCPU<float, InputType> stddev;
-          stddev.Setup(mutable_stddev[i], in_view[i], make_span(axes_), sample_mean);
-          // Reset per-sample values, but don't postprocess
-          stddev.Run(true, false);
-          // Fused postprocessing with inverse square root.
-          SumSquare2InvStdDev(mutable_stddev[i], data_shape_[i],
-                              degrees_of_freedom_, epsilon_, scale_);
-          assert(sample_inv_stddev.data == mutable_stddev[i].data);
-        }
-      }
+  kernels::AddSampleRangeWork(tp, make_cspan(extents_), make_cspan(costs_),
+    [&](int thread_idx, int i, int64_t begin, int64_t end) {
       kernels::KernelContext ctx;
-      using Kernel = kernels::NormalizeCPU<OutputType, InputType, float>;
       kmgr_.Run<Kernel>(i, ctx,
-          out_view[i], in_view[i], sample_mean, sample_inv_stddev, shift_);
-    }, in_shape.tensor_size(i));
-  }
-
+          out_view[i], in_view[i], sample_mean(i), sample_inv_stddev(i), shift_, begin, end);
+    }, kMinRangeSize);
   tp.RunAll();
 }
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,8 +16,10 @@
 #define DALI_OPERATORS_MATH_NORMALIZE_NORMALIZE_H_
 
 #include <any>
+#include <iomanip>
 #include <memory>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include "dali/core/tensor_shape.h"
@@ -25,6 +27,7 @@
 #include "dali/kernels/kernel_manager.h"
 #include "dali/operators/util/diag_msg.h"
 #include "dali/pipeline/data/views.h"
+#include "dali/pipeline/operator/checkpointing/op_checkpoint.h"
 #include "dali/pipeline/operator/checkpointing/stateless_operator.h"
 #include "dali/pipeline/operator/operator.h"
 
@@ -36,6 +39,36 @@ namespace dali {
 template <typename Backend>
 class Normalize;
 
+/** The statistics accumulated over all the batches processed so far (see `running_stats`) */
+struct NormalizeRunningStats {
+  /** The number of values contributing to each of the statistics */
+  int64_t count = 0;
+  std::vector<double> mean;
+  /** The sums of squared deviations from the mean */
+  std::vector<double> m2;
+};
+
+inline std::string SerializeRunningStats(const NormalizeRunningStats &stats) {
+  std::stringstream ss;
+  ss << std::setprecision(17) << stats.count << " " << stats.mean.size();
+  for (size_t i = 0; i < stats.mean.size(); i++)
+    ss << " " << stats.mean[i] << " " << stats.m2[i];
+  return ss.str();
+}
+
+inline NormalizeRunningStats DeserializeRunningStats(const std::string &data) {
+  NormalizeRunningStats stats;
+  std::stringstream ss(data);
+  size_t n = 0;
+  ss >> stats.count >> n;
+  stats.mean.resize(n);
+  stats.m2.resize(n);
+  for (size_t i = 0; i < n; i++)
+    ss >> stats.mean[i] >> stats.m2[i];
+  DALI_ENFORCE(!ss.fail(), "Normalize: Invalid checkpoint data.");
+  return stats;
+}
+
 template <typename Backend>
 class NormalizeBase : public StatelessOperator<Backend> {
  public:
@@ -45,7 +78,8 @@ class NormalizeBase : public StatelessOperator<Backend> {
     has_tensor_stddev_ = spec.HasTensorArgument("stddev");
     has_scalar_stddev_ = spec.HasArgument("stddev") && !has_tensor_stddev_;
 
-    batch_norm_ = spec.GetArgument<bool>("batch");
+    running_stats_ = spec.GetArgument<bool>("running_stats");
+    batch_norm_ = spec.GetArgument<bool>("batch") || running_stats_;
     has_axes_arg_ = spec.HasArgument("axes");
     has_axis_names_arg_ = spec.HasArgument("axis_names");
     shift_ = spec.GetArgument<float>("shift");
@@ -66,6 +100,12 @@ class NormalizeBase : public StatelessOperator<Backend> {
       DALI_ENFORCE(!batch_norm_, "Normalize: Batch normalization cannot be used with parameters "
       "specified as TensorList inputs");
     }
+
+    if (running_stats_) {
+      DALI_ENFORCE(!spec.HasArgument("mean") && !spec.HasArgument("stddev"),
+        "Normalize: Running statistics cannot be used with externally provided "
+        "mean or standard deviation");
+    }
     mean_.set_pinned(false);
     inv_stddev_.set_pinned(false);
   }
@@ -102,6 +142,30 @@ class NormalizeBase : public StatelessOperator<Backend> {
   }
 
 
+  void SaveState(OpCheckpoint &cpt, AccessOrder order) override {
+    if (running_stats_)
+      This().SaveRunningStats(cpt, order);
+  }
+
+  void RestoreState(const OpCheckpoint &cpt) override {
+    if (running_stats_)
+      This().RestoreRunningStats(cpt.CheckpointState<NormalizeRunningStats>());
+  }
+
+  std::string SerializeCheckpoint(const OpCheckpoint &cpt) const override {
+    if (!running_stats_)
+      return {};
+    return SerializeRunningStats(cpt.CheckpointState<NormalizeRunningStats>());
+  }
+
+  void DeserializeCheckpoint(OpCheckpoint &cpt, const std::string &data) const override {
+    if (!running_stats_) {
+      StatelessOperator<Backend>::DeserializeCheckpoint(cpt, data);
+      return;
+    }
+    cpt.MutableCheckpointState() = DeserializeRunningStats(data);
+  }
+
   void UseAllAxes() {
     int dim = data_shape_.sample_dim();
     axes_.resize(dim);
@@ -242,6 +306,7 @@ class NormalizeBase : public StatelessOperator<Backend> {
 
   bool ShouldCalcMean() const noexcept { return !has_tensor_mean_ && !has_scalar_mean_; }
   bool ShouldCalcStdDev() const noexcept { return !has_tensor_stddev_ && !has_scalar_stddev_; }
+  bool ShouldCalcMeanStdDev() const noexcept { return ShouldCalcMean() && ShouldCalcStdDev(); }
   bool IsFullReduction() const noexcept {
     int ndim = data_shape_.sample_dim();
     return axis_mask_== ((1_u64 << ndim) - 1);
@@ -260,6 +325,7 @@ class NormalizeBase : public StatelessOperator<Backend> {
   bool has_tensor_mean_, has_tensor_stddev_ = false;
   bool has_scalar_mean_, has_scalar_stddev_ = false;
   bool batch_norm_ = false;
+  bool running_stats_ = false;
   bool has_axes_arg_ = false;
   bool has_axis_names_arg_ = false;
   float shift_ = 0;
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -18,6 +18,7 @@
 #include "dali/kernels/normalize/normalize_gpu.h"
 #include "dali/kernels/reduce/reduce_gpu.h"
 #include "dali/kernels/common/copy.h"
+#include "dali/core/dev_buffer.h"
 
 namespace dali {
 
@@ -56,10 +57,33 @@ class Normalize<GPUBackend> : public NormalizeBase<GPUBackend> {
     return normalize_kernel_.create_or_get<NormalizeGPU<OutputType, InputType>>();
   }
 
+  template <typename ParamType, typename InputType>
+  VarianceGPU<ParamType, InputType> &GetVarianceKernel() {
+    return stddev_kernel_.create_or_get<VarianceGPU<ParamType, InputType>>();
+  }
+
   TensorListView<StorageGPU, float> BroadcastMean(KernelContext &ctx, float value) const;
 
+  /**
+   * @brief Merges the statistics of the batch with the running ones and calculates the mean
+   *        and the inverse standard deviation used for the normalization.
+   *
+   * @param mean      the mean of the batch; overwritten with the running mean
+   * @param var       the (biased) variance of the batch
+   * @param inv_stddev  the output inverse standard deviation
+   */
+  void UpdateRunningStats(cudaStream_t stream, const OutListGPU<float> &mean,
+                          const OutListGPU<float> &var, const OutListGPU<float> &inv_stddev);
+
+  void SaveRunningStats(OpCheckpoint &cpt, AccessOrder order);
+  void RestoreRunningStats(const NormalizeRunningStats &stats);
+
   AnyKernelInstance mean_kernel_, stddev_kernel_, normalize_kernel_;
   ScratchpadAllocator alloc_;
+
+  // The running statistics; the count is the same for all the values
+  int64_t running_count_ = 0;
+  DeviceBuffer<double> running_mean_, running_m2_;
 };
 
 
@@ -122,8 +146,107 @@ __global__ void Fill(T *data, size_t count, T value) {
     data[i] = value;
 }
 
+/**
+ * @brief Merges the batch statistics into the running ones, with the formula of Chan et al.
+ *
+ * Calculates the final mean and `scale / sqrt(m2 * rdiv + epsilon)`, where rdiv is the reciprocal
+ * of the number of values (with Bessel's correction, if requested).
+ */
+__global__ void UpdateRunningStatsKernel(double *running_mean, double *running_m2,
+                                         float *mean, const float *var, float *inv_stddev,
+                                         int64_t n, int64_t count, int64_t batch_count,
+                                         float rdiv, float scale, float epsilon) {
+  auto i = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (i >= n)
+    return;
+  double m = running_mean[i], m2 = running_m2[i];
+  if (batch_count > 0) {
+    double batch_mean = mean[i];
+    double batch_m2 = static_cast<double>(var[i]) * batch_count;
+    if (count == 0) {
+      m = batch_mean;
+      m2 = batch_m2;
+    } else {
+      double total = count + batch_count;
+      double delta = batch_mean - m;
+      m += delta * batch_count / total;
+      m2 += batch_m2 + delta * delta * count * batch_count / total;
+    }
+    running_mean[i] = m;
+    running_m2[i] = m2;
+  }
+  mean[i] = m;
+  float x = m2 * rdiv;
+  inv_stddev[i] = x || epsilon ? scale * rsqrt(x + epsilon) : 0;
+}
+
 }  // namespace
 
+void Normalize<GPUBackend>::UpdateRunningStats(cudaStream_t stream,
+                                               const OutListGPU<float> &mean,
+                                               const OutListGPU<float> &var,
+                                               const OutListGPU<float> &inv_stddev) {
+  assert(mean.num_samples() == 1 && var.num_samples() == 1 && inv_stddev.num_samples() == 1);
+  int64_t n = mean.num_elements();
+  if (running_mean_.size() == 0) {
+    running_mean_.resize(n);
+    running_m2_.resize(n);
+    running_count_ = 0;
+  }
+  DALI_ENFORCE(static_cast<int64_t>(running_mean_.size()) == n, make_string(
+    "Normalize: The shape of the running statistics cannot change. Expected ",
+    running_mean_.size(), " values, got ", n, "."));
+  int64_t batch_count = 0;
+  for (int i = 0; i < data_shape_.num_samples(); i++) {
+    auto sample_shape = data_shape_.tensor_shape_span(i);
+    int64_t v = 1;
+    for (int a : axes_)
+      v *= sample_shape[a];
+    batch_count += v;
+  }
+  int64_t total = running_count_ + batch_count;
+  float rdiv = 0;
+  float scale = scale_;
+  if (total > degrees_of_freedom_) {
+    rdiv = static_cast<float>(1.0 / (total - degrees_of_freedom_));
+  } else if (epsilon_ == 0) {
+    rdiv = 1;
+    scale = 0;
+  }
+  if (n > 0) {
+    int block = std::min<int64_t>(n, 256);
+    int grid = div_ceil(n, block);
+    UpdateRunningStatsKernel<<<grid, block, 0, stream>>>(
+      running_mean_.data(), running_m2_.data(), mean.data[0], var.data[0], inv_stddev.data[0],
+      n, running_count_, batch_count, rdiv, scale, epsilon_);
+    CUDA_CALL(cudaGetLastError());
+  }
+  running_count_ = total;
+}
+
+void Normalize<GPUBackend>::SaveRunningStats(OpCheckpoint &cpt, AccessOrder order) {
+  cpt.SetOrder(order);
+  NormalizeRunningStats stats;
+  stats.count = running_count_;
+  stats.mean.resize(running_mean_.size());
+  stats.m2.resize(running_m2_.size());
+  copyD2H(stats.mean.data(), running_mean_.data(), running_mean_.size(), order);
+  copyD2H(stats.m2.data(), running_m2_.data(), running_m2_.size(), order);
+  // The pipeline will perform host synchronization before serializing the checkpoints.
+  cpt.MutableCheckpointState() = std::move(stats);
+}
+
+void Normalize<GPUBackend>::RestoreRunningStats(const NormalizeRunningStats &stats) {
+  running_count_ = stats.count;
+  if (stats.mean.empty()) {
+    running_mean_.clear();
+    running_m2_.clear();
+    return;
+  }
+  running_mean_.from_host(stats.mean);
+  running_m2_.from_host(stats.m2);
+}
+
 TensorListView<StorageGPU, float>
 Normalize<GPUBackend>::BroadcastMean(KernelContext &ctx, float value) const {
   TensorListView<StorageGPU, float> mean_gpu;
@@ -186,7 +309,14 @@ void Normalize<GPUBackend>::SetupTyped(const Workspace &ws) {
     MaxInPlace(req.scratch_sizes, mean_req.scratch_sizes);
   }
 
-  if (ShouldCalcStdDev()) {
+  if (running_stats_) {
+    // the variance of the batch is merged with the running statistics
+    se.add<mm::memory_kind::device, float>(param_volume);
+    auto &var = GetVarianceKernel<float, InputType>();
+    auto var_req = var.Setup(ctx, data_shape_, make_span(axes_), true, batch_norm_);
+    assert(var_req.output_shapes[0] == param_shape_);
+    MaxInPlace(req.scratch_sizes, var_req.scratch_sizes);
+  } else if (ShouldCalcStdDev()) {
     auto &stddev = GetInvStdDevKernel<float, InputType>();
     auto stddev_req = stddev.Setup(ctx, data_shape_, make_span(axes_), true, batch_norm_);
     assert(stddev_req.output_shapes[0] == param_shape_);
@@ -250,7 +380,18 @@ void Normalize<GPUBackend>::RunTyped(Workspace &ws) {
     kernels::copy(mean_gpu, mean_input_, stream);
   }
 
-  if (ShouldCalcStdDev()) {
+  if (running_stats_) {
+    auto var_gpu =
+        buffer_scratchpad.AllocTensorList<mm::memory_kind::device, float>(param_shape_);
+    {
+      DynamicScratchpad scratchpad({}, stream);
+      ctx.scratchpad = &scratchpad;
+      auto &var_kernel = GetVarianceKernel<float, InputType>();
+      var_kernel.Run(ctx, var_gpu, in_view, mean_gpu);
+      ctx.scratchpad = nullptr;
+    }
+    UpdateRunningStats(stream, mean_gpu, var_gpu, stddev_gpu);
+  } else if (ShouldCalcStdDev()) {
     DynamicScratchpad scratchpad({}, stream);
     ctx.scratchpad = &scratchpad;
     auto &stddev_kernel = GetInvStdDevKernel<float, InputType>();
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2021, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -19,8 +19,10 @@
 #include <xmmintrin.h>
 #endif
 #include <algorithm>
+#include <cassert>
 #include "dali/core/tensor_view.h"
 #include "dali/core/math_util.h"
+#include "dali/kernels/reduce/reduce_cpu.h"
 #include "dali/pipeline/data/tensor_list.h"
 
 namespace dali {
@@ -220,6 +222,115 @@ static void SumSquare2InvStdDev(const TensorView<StorageCPU, float> &inout,
 }
 
 
+/**
+ * @brief Accumulates the mean and the variance of the data in a single pass.
+ *
+ * The data is stored as the number of values and the sums of the values and of their squares,
+ * after subtracting a reference value (`shift`) - the first value added. Thanks to the shift,
+ * the sums don't lose precision when the variance is small compared to the mean.
+ *
+ * The partial results (e.g. of the halves of a sample, or of the samples in a batch) are merged
+ * with the formula of Chan et al. for the pairwise update of the variance, the same as in
+ * Welford's online algorithm.
+ */
+struct MeanVarAcc {
+  int64_t n = 0;
+  double shift = 0;   ///< the reference value, subtracted from the data
+  double sum = 0;     ///< the sum of `x - shift`
+  double sum_sq = 0;  ///< the sum of `(x - shift)^2`
+
+  MeanVarAcc() = default;
+  MeanVarAcc(double x) : n(1), shift(x) {}  // NOLINT - used for reductions along no axes
+
+  double mean() const {
+    return n ? shift + sum / n : 0;
+  }
+
+  /** The sum of squared deviations from the mean */
+  double m2() const {
+    return n ? std::max(sum_sq - sum * sum / n, 0.0) : 0;
+  }
+
+  void add(double x) {
+    if (n == 0)
+      shift = x;
+    double d = x - shift;
+    sum += d;
+    sum_sq += d * d;
+    n++;
+  }
+
+  MeanVarAcc &operator+=(const MeanVarAcc &other) {
+    if (other.n == 0)
+      return *this;
+    if (n == 0)
+      return *this = other;
+    double mean_a = mean(), mean_b = other.mean();
+    double delta = mean_b - mean_a;
+    int64_t total = n + other.n;
+    double m2_total = m2() + other.m2() + delta * delta * n * other.n / total;
+    // Store in the canonical form, with the mean as the reference value
+    shift = mean_a + delta * other.n / total;
+    sum = 0;
+    sum_sq = m2_total;
+    n = total;
+    return *this;
+  }
+};
+
+/** A reduction functor which calculates MeanVarAcc of the input - for use with ReduceBaseCPU */
+struct mean_var {
+  void operator()(MeanVarAcc &acc, const MeanVarAcc &other) const noexcept {
+    acc += other;
+  }
+
+  template <typename T>
+  void operator()(MeanVarAcc &acc, const T &x) const noexcept {
+    acc.add(x);
+  }
+
+  template <typename T>
+  static MeanVarAcc neutral() noexcept { return {}; }
+};
+
+/**
+ * @brief Calculates the mean and the (inverse) standard deviation of the data in a single pass.
+ */
+template <typename In>
+struct MeanVarCPU : kernels::ReduceBaseCPU<MeanVarAcc, In, MeanVarCPU<In>> {
+  mean_var GetReduction() const { return {}; }
+};
+
+/**
+ * @brief Calculates the mean and the scaled, regularized inverse standard deviation
+ *        from the accumulators.
+ *
+ * @param acc         the accumulators - all of them contain the same number of values
+ * @param n           the number of accumulators
+ * @param mean        the output mean
+ * @param inv_stddev  the output `scale / sqrt(var + epsilon)`
+ */
+static void MeanVarToParams(const MeanVarAcc *acc, int64_t n, float *mean, float *inv_stddev,
+                            int degrees_of_freedom, float epsilon, float scale) {
+  if (n == 0)
+    return;
+  int64_t v = acc[0].n;
+  float rdiv = 0;
+  if (v > degrees_of_freedom) {
+    rdiv = static_cast<float>(1.0 / (v - degrees_of_freedom));
+  } else if (epsilon == 0) {
+    rdiv = 1;
+    scale = 0;
+  }
+  for (int64_t i = 0; i < n; i++) {
+    assert(acc[i].n == v);
+    mean[i] = acc[i].mean();
+    inv_stddev[i] = acc[i].m2();
+  }
+  ScaleRSqrtKeepZero(inv_stddev, n, epsilon, rdiv, scale);
+}
+
+
 }  // namespace normalize
 }  // namespace dali
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -109,6 +109,8 @@ class NumbaFuncImpl : public StatelessOperator<Backend> {
   vector<TensorShape<-1>> out_strides_;
   vector<NumbaDevArray> in_arrays_;
   vector<NumbaDevArray> out_arrays_;
+  /// The arguments of the GPU kernel launch
+  vector<void*> launch_args_;
 };
 
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -228,25 +228,25 @@ void NumbaFuncImpl<GPUBackend>::RunImpl(Workspace &ws) {
     }
   }
 
+  CUfunction cu_func = reinterpret_cast<CUfunction>(run_fn_);
   for (int i = 0; i < N; i++) {
-    vector<void*> args;
+    launch_args_.clear();  // the storage is reused between the samples and iterations
 
     for (size_t out_id = 0; out_id < out_types_.size(); out_id++) {
       auto &dev_array = out_arrays_[out_id * N + i];
-      dev_array.PushArgs(args);
+      dev_array.PushArgs(launch_args_);
     }
 
     for (size_t in_id = 0; in_id < in_types_.size(); in_id++) {
       auto &dev_array = in_arrays_[in_id * N + i];
-      dev_array.PushArgs(args);
+      dev_array.PushArgs(launch_args_);
     }
-    CUfunction cu_func = reinterpret_cast<CUfunction>(run_fn_);
     CUDA_CALL(cuLaunchKernel(cu_func,
                              blocks_[0], blocks_[1], blocks_[2],
                              threads_per_block_[0], threads_per_block_[1], threads_per_block_[2],
                              0,
                              ws.stream(),
-                             args.data(),
+                             launch_args_.data(),
                              nullptr));
   }
 }
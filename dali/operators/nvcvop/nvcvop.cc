@@ -15,6 +15,7 @@
 #include "dali/operators/nvcvop/nvcvop.h"
 
 
+#include <algorithm>
 #include <string>
 
 namespace dali::nvcvop {
@@ -161,6 +162,48 @@ void PushImagesToBatch(nvcv::ImageBatchVarShape &batch, const TensorList<GPUBack
   }
 }
 
+const nvcv::ImageFormat &ImageBatchCache::GetFormat(DALIDataType dtype, int num_channels) {
+  if (dtype != format_type_ || num_channels != format_channels_) {
+    format_ = GetImageFormat(dtype, num_channels);
+    format_type_ = dtype;
+    format_channels_ = num_channels;
+  }
+  return format_;
+}
+
+nvcv::ImageBatchVarShape &ImageBatchCache::Get(const TensorList<GPUBackend> &t_list) {
+  int num_samples = t_list.num_samples();
+  int curr_cap = batch_ ? batch_.capacity() : 0;
+  if (curr_cap < num_samples) {
+    batch_ = nvcv::ImageBatchVarShape(std::max(curr_cap * 2, num_samples));
+    entries_.clear();
+  }
+  auto channel_dim = t_list.GetLayout().find('C');
+  auto dtype = t_list.type();
+  int num_valid = 0;
+  int num_cached = std::min<int>(entries_.size(), num_samples);
+  for (; num_valid < num_cached; num_valid++) {
+    auto sample = t_list[num_valid];
+    auto &entry = entries_[num_valid];
+    int num_channels = (channel_dim >= 0) ? sample.shape()[channel_dim] : 1;
+    if (entry.data != sample.raw_data() || entry.shape != sample.shape() ||
+        entry.type != dtype || entry.num_channels != num_channels)
+      break;
+  }
+  if (num_valid < static_cast<int>(entries_.size())) {
+    batch_.popBack(entries_.size() - num_valid);
+    entries_.resize(num_valid);
+  }
+  for (int s = num_valid; s < num_samples; s++) {
+    auto sample = t_list[s];
+    int num_channels = (channel_dim >= 0) ? sample.shape()[channel_dim] : 1;
+    auto image = AsImage(sample, GetFormat(dtype, num_channels));
+    batch_.pushBack(image);
+    entries_.push_back({sample.raw_data(), sample.shape(), dtype, num_channels, std::move(image)});
+  }
+  return batch_;
+}
+
 nvcv::Tensor AsTensor(const Tensor<GPUBackend> &tensor, TensorLayout layout,
                       const std::optional<TensorShape<>> &reshape) {
   auto orig_shape = tensor.shape();
@@ -136,6 +136,41 @@ void PushImagesToBatch(nvcv::ImageBatchVarShape &batch, const TensorList<GPUBack
 void PushTensorsToBatch(nvcv::TensorBatch &batch, const TensorList<GPUBackend> &t_list,
                         TensorLayout layout);
 
+/**
+ * @brief Wraps the samples of a TensorList as nvcv Images in an image batch, which is kept
+ * between the iterations.
+ *
+ * The operators usually get their inputs and outputs in the same buffers, with the same shapes,
+ * in consecutive iterations. The samples which didn't change are not wrapped again - the batch
+ * is rebuilt from the first sample whose address, shape or type changed. The image format,
+ * which is costly to create, is reused as long as the type and the number of channels are
+ * the same.
+ *
+ * The images don't own the memory; the batch must not be used after the TensorList is
+ * reallocated, unless it's updated with `Get` first.
+ */
+class ImageBatchCache {
+ public:
+  nvcv::ImageBatchVarShape &Get(const TensorList<GPUBackend> &t_list);
+
+ private:
+  struct Entry {
+    const void *data;
+    TensorShape<> shape;
+    DALIDataType type;
+    int num_channels;
+    nvcv::Image image;
+  };
+
+  const nvcv::ImageFormat &GetFormat(DALIDataType dtype, int num_channels);
+
+  nvcv::ImageBatchVarShape batch_{nullptr};
+  std::vector<Entry> entries_;
+  DALIDataType format_type_ = DALI_NO_TYPE;
+  int format_channels_ = 0;
+  nvcv::ImageFormat format_{};
+};
+
 class NVCVOpWorkspace {
  public:
   NVCVOpWorkspace() {
@@ -263,63 +298,35 @@ class NVCVOperator: public BaseOp {
 
   /**
    * @brief Get input image batch.
-   * This method allocates the ImageBatchVarShape and wraps the input data as nvcv images.
+   * This method wraps the input data as nvcv images; the images created in the previous
+   * iterations are reused, if the samples didn't change (see ImageBatchCache).
    *
    * The output should be used only within the RunImpl method.
    */
   const nvcv::ImageBatchVarShape &GetInputBatch(Workspace &ws, size_t input_idx) {
     if (inputs_.size() < input_idx + 1) {
-      inputs_.resize(input_idx + 1, nullptr);
-    }
-    const auto &tl_input = ws.Input<GPUBackend>(input_idx);
-    auto &input = inputs_[input_idx];
-    int curr_cap = input ? input.capacity() : 0;
-    if (curr_cap < tl_input.num_samples()) {
-      input = nvcv::ImageBatchVarShape(std::max(curr_cap * 2, tl_input.num_samples()));
+      inputs_.resize(input_idx + 1);
     }
-    PushImagesToBatch(input, tl_input);
-    return input;
+    return inputs_[input_idx].Get(ws.Input<GPUBackend>(input_idx));
   }
 
   /**
    * @brief Get output image batch.
-   * This method allocates the ImageBatchVarShape and wraps the input data as nvcv images.
+   * This method wraps the output data as nvcv images; the images created in the previous
+   * iterations are reused, if the samples didn't change (see ImageBatchCache).
    *
    * The output should be used only within the RunImpl method.
    */
   nvcv::ImageBatchVarShape &GetOutputBatch(Workspace &ws, size_t output_idx) {
     if (outputs_.size() < output_idx + 1) {
-      outputs_.resize(output_idx + 1, nullptr);
+      outputs_.resize(output_idx + 1);
     }
-    const auto &tl_output = ws.Output<GPUBackend>(output_idx);
-    auto &output = outputs_[output_idx];
-    int curr_cap = output ? output.capacity() : 0;
-    if (curr_cap < tl_output.num_samples()) {
-      output = nvcv::ImageBatchVarShape(std::max(curr_cap * 2, tl_output.num_samples()));
-    }
-    PushImagesToBatch(output, tl_output);
-    return output;
-  }
-
-  void Run(Workspace &ws) override {
-    auto atexit = AtScopeExit([this]() { ClearBatches(); });
-    BaseOp::Run(ws);
+    return outputs_[output_idx].Get(ws.Output<GPUBackend>(output_idx));
   }
 
-
  private:
-  void ClearBatches() {
-    for (auto &inp : inputs_) {
-      inp.clear();
-    }
-
-    for (auto &out : outputs_) {
-      out.clear();
-    }
-  }
-
-  std::vector<nvcv::ImageBatchVarShape> inputs_;
-  std::vector<nvcv::ImageBatchVarShape> outputs_;
+  std::vector<ImageBatchCache> inputs_;
+  std::vector<ImageBatchCache> outputs_;
 };
 
 template <template<typename> typename BaseOp>
@@ -28,6 +28,7 @@ DALI_SCHEMA(DLTensorPythonFunctionImpl)
     .AddArg("function_id", R"code(Id of the python function)code", DALI_INT64)
     .AddOptionalArg("num_outputs", R"code(Number of outputs)code", 1)
     .AddArg("batch_processing", "Batch processing.", DALI_BOOL)
+    .AddOptionalArg("no_copy", "Use the memory of the outputs without copying", false)
     .NumInput(0, 256)
     .OutputFn([](const OpSpec &spec) {return spec.GetArgument<int>("num_outputs");})
     .AddOptionalArg<std::vector<TensorLayout>>("output_layouts",
@@ -163,6 +164,80 @@ void CopyOutputData(TensorList<GPUBackend>& output, std::vector<DLMTensorPtr> &d
   CopyDlTensorBatchGpu(output, dl_tensors, workspace.stream());
 }
 
+namespace {
+
+bool IsDense(const DLTensor &dl_tensor) {
+  if (!dl_tensor.strides)
+    return true;
+  int64_t stride = 1;
+  for (int d = dl_tensor.ndim - 1; d >= 0; d--) {
+    if (dl_tensor.shape[d] != 1 && dl_tensor.strides[d] != stride)
+      return false;
+    stride *= dl_tensor.shape[d];
+  }
+  return true;
+}
+
+bool PointsToInputs(const char *data, const Workspace &ws) {
+  for (int idx = 0; idx < ws.NumInput(); idx++) {
+    if (!ws.InputIsType<CPUBackend>(idx))
+      continue;
+    auto &input = ws.Input<CPUBackend>(idx);
+    int64_t type_size = input.type_info().size();
+    for (int s = 0; s < input.num_samples(); s++) {
+      auto *begin = static_cast<const char *>(input.raw_tensor(s));
+      auto *end = begin + input.shape().tensor_size(s) * type_size;
+      if (data >= begin && data < end)
+        return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+template <>
+bool ShareOutputData(TensorList<CPUBackend> &output, std::vector<DLMTensorPtr> &dl_tensors,
+                     const Workspace &ws) {
+  if (output.is_pinned())
+    return false;
+  for (auto &dl_tensor_ptr : dl_tensors) {
+    auto &dl_tensor = dl_tensor_ptr->dl_tensor;
+    auto *data = static_cast<const char *>(dl_tensor.data) + dl_tensor.byte_offset;
+    if (dl_tensor.device.device_type != kDLCPU || !IsDense(dl_tensor) || PointsToInputs(data, ws))
+      return false;
+  }
+
+  auto shape = GetDLTensorListShape(dl_tensors);
+  auto type = ToDALIType(dl_tensors[0]->dl_tensor.dtype);
+  int64_t type_size = TypeTable::GetTypeInfo(type).size();
+  auto layout = output.GetLayout();
+  output.Reset();
+  output.SetSize(shape.num_samples());
+  output.set_sample_dim(shape.sample_dim());
+  output.set_type(type);
+  output.SetLayout(layout);
+  for (int s = 0; s < shape.num_samples(); s++) {
+    auto &dl_tensor = dl_tensors[s]->dl_tensor;
+    void *data = static_cast<char *>(dl_tensor.data) + dl_tensor.byte_offset;
+    // The tensor is typically owned by a Python object - it has to be released with the GIL held
+    std::shared_ptr<DLManagedTensor> owner(dl_tensors[s].release(), [](DLManagedTensor *t) {
+      if (!Py_IsInitialized())
+        return;  // the interpreter is gone - so is the memory
+      py::gil_scoped_acquire interpreter_guard{};
+      DLMTensorPtrDeleter(t);
+    });
+    output.SetSample(s, std::shared_ptr<void>(owner, data), shape.tensor_size(s) * type_size,
+                     false, shape[s], type, output.device_id(), AccessOrder::host());
+  }
+  return true;
+}
+
+template <>
+bool ShareOutputData(TensorList<GPUBackend> &, std::vector<DLMTensorPtr> &, const Workspace &) {
+  return false;
+}
+
 }  // namespace detail
 
 DALI_REGISTER_OPERATOR(DLTensorPythonFunctionImpl, DLTensorPythonFunctionImpl<CPUBackend>, CPU);
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -18,6 +18,7 @@
 #include <pybind11/embed.h>
 #include <pybind11/stl.h>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include "dali/pipeline/operator/checkpointing/stateless_operator.h"
@@ -86,21 +87,42 @@ template <typename Workspace, typename Output>
 void CopyOutputData(Output& output, std::vector<DLMTensorPtr> &dl_tensors,
                     Workspace &workspace);
 
+/**
+ * @brief Uses the data of the DLPack tensors as the samples of the output, without copying
+ *
+ * The data is shared only if it's dense, it's host memory (and the output is not pinned) and it
+ * doesn't point to the operator's inputs - these are passed to Python as non-owning views.
+ * The GPU outputs are always copied: releasing the memory does not wait for the work scheduled
+ * by DALI.
+ *
+ * @return true if the data was shared, false if it has to be copied
+ */
 template <typename Backend>
-void PrepareOutputs(Workspace &ws, const py::object &output_o, int batch_size) {
+bool ShareOutputData(TensorList<Backend> &output, std::vector<DLMTensorPtr> &dl_tensors,
+                     const Workspace &ws);
+
+template <typename Backend>
+void PrepareOutputs(Workspace &ws, const py::object &output_o, int batch_size, bool no_copy) {
   py::tuple return_tuple = (py::tuple::check_(output_o)) ? output_o : py::make_tuple(output_o);
   for (Index idx = 0; idx < ws.NumOutput(); ++idx) {
     py::list dl_list = py::cast<py::list>(return_tuple[idx]);
     auto dl_tensors = CastToDLTensorList<Backend>(dl_list, batch_size, idx);
     if (dl_tensors.empty()) continue;
     auto &tlist = ws.Output<Backend>(idx);
+    if (no_copy && ShareOutputData(tlist, dl_tensors, ws))
+      continue;
     tlist.Resize(GetDLTensorListShape(dl_tensors), ToDALIType(dl_tensors[0]->dl_tensor.dtype));
-    CopyOutputData(tlist, dl_tensors, ws);
+    {
+      // The copy doesn't touch Python objects - let other threads run Python code meanwhile
+      py::gil_scoped_release interpreter_unlock{};
+      CopyOutputData(tlist, dl_tensors, ws);
+    }
   }
 }
 
 template <typename Backend>
-void PrepareOutputsPerSample(Workspace &ws, const py::object &output_o, int batch_size) {
+void PrepareOutputsPerSample(Workspace &ws, const py::object &output_o, int batch_size,
+                             bool no_copy) {
   py::list output = output_o;
   py::tuple output_tuple(ws.NumOutput());
   std::vector<py::list> output_lists(ws.NumOutput());
@@ -117,7 +139,7 @@ void PrepareOutputsPerSample(Workspace &ws, const py::object &output_o, int batc
   for (Index idx = 0; idx < ws.NumOutput(); ++idx) {
     output_tuple[idx] = std::move(output_lists[idx]);
   }
-  PrepareOutputs<Backend>(ws, output_tuple, batch_size);
+  PrepareOutputs<Backend>(ws, output_tuple, batch_size, no_copy);
 }
 
 template <typename Backend>
@@ -152,10 +174,10 @@ class DLTensorPythonFunctionImpl : public StatelessOperator<Backend> {
  public:
   inline explicit DLTensorPythonFunctionImpl(const OpSpec &spec)
       : StatelessOperator<Backend>(spec)
-      , python_function(py::reinterpret_borrow<py::object>(
-          reinterpret_cast<PyObject*>(spec.GetArgument<int64_t>("function_id")))) {
+      , python_function(BorrowPythonObject(spec.GetArgument<int64_t>("function_id"))) {
     synchronize_stream_ = spec.GetArgument<bool>("synchronize_stream");
     batch_processing = spec.GetArgument<bool>("batch_processing");
+    no_copy_ = spec.GetArgument<bool>("no_copy");
     size_t num_outputs = spec.GetArgument<int>("num_outputs");
     bool listed_layouts = spec.TryGetRepeatedArgument(output_layouts_, "output_layouts");
     if (!listed_layouts && spec.HasArgument("output_layouts")) {
@@ -190,7 +212,9 @@ class DLTensorPythonFunctionImpl : public StatelessOperator<Backend> {
       } else {
         input_o_ = detail::PrepareDLTensorInputsPerSample<Backend>(ws);
         py::list out_batch;
-        if (input_o_.size() > 0) {
+        if (RunPerSampleInParallel(ws, out_batch)) {
+          // done
+        } else if (input_o_.size() > 0) {
           for (auto &input_tuple : input_o_) {
             py::object output = python_function(*input_tuple);
             if (!output.is_none()) out_batch.append(output);
@@ -208,9 +232,9 @@ class DLTensorPythonFunctionImpl : public StatelessOperator<Backend> {
     }
     if (!output_o_.is_none()) {
       if (batch_processing) {
-        detail::PrepareOutputs<Backend>(ws, output_o_, curr_batch_size);
+        detail::PrepareOutputs<Backend>(ws, output_o_, curr_batch_size, no_copy_);
       } else {
-        detail::PrepareOutputsPerSample<Backend>(ws, output_o_, curr_batch_size);
+        detail::PrepareOutputsPerSample<Backend>(ws, output_o_, curr_batch_size, no_copy_);
       }
     } else {
       DALI_ENFORCE(ws.NumOutput() == 0, "Python function returned 0 outputs and "
@@ -235,9 +259,51 @@ class DLTensorPythonFunctionImpl : public StatelessOperator<Backend> {
   py::list input_o_;
   bool synchronize_stream_;
   bool batch_processing;
+  bool no_copy_;
   std::vector<TensorLayout> output_layouts_;
 
  private:
+  /**
+   * @brief Calls the function for the samples in the thread pool, if the interpreter is
+   *        free-threaded (no GIL)
+   *
+   * @return false, if the samples must be processed sequentially
+   */
+  bool RunPerSampleInParallel(Workspace &ws, py::list &out_batch) {
+#ifdef Py_GIL_DISABLED
+    if constexpr (std::is_same_v<Backend, CPUBackend>) {
+      int nsamples = input_o_.size();
+      if (nsamples < 2)
+        return false;
+      std::vector<py::object> outputs(nsamples);
+      auto &thread_pool = ws.GetThreadPool();
+      for (int s = 0; s < nsamples; s++) {
+        thread_pool.AddWork([&, s](int) {
+          py::gil_scoped_acquire interpreter_guard{};
+          try {
+            outputs[s] = python_function(*input_o_[s]);
+          } catch (const py::error_already_set &e) {
+            throw std::runtime_error(e.what());
+          }
+        });
+      }
+      {
+        // The workers need the calling thread to be detached from the interpreter
+        py::gil_scoped_release interpreter_unlock{};
+        thread_pool.RunAll();
+      }
+      for (auto &output : outputs) {
+        if (!output.is_none())
+          out_batch.append(std::move(output));
+      }
+      return true;
+    }
+#endif
+    (void)ws;
+    (void)out_batch;
+    return false;
+  }
+
   int GetCurrBatchSize(Workspace &ws) {
     if (ws.NumInput() > 0) {
       auto curr_batch_size = ws.GetInputBatchSize(0);
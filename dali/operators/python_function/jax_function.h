@@ -1,4 +1,4 @@
-// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2024-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -128,8 +128,7 @@ class JaxFunction : public StatelessOperator<Backend> {
  public:
   inline explicit JaxFunction(const OpSpec &spec)
       : StatelessOperator<Backend>(spec),
-        python_function_(py::reinterpret_borrow<py::object>(
-            reinterpret_cast<PyObject *>(spec.GetArgument<int64_t>("function_id")))),
+        python_function_(BorrowPythonObject(spec.GetArgument<int64_t>("function_id"))),
         output_layouts_{} {
     int num_outputs = spec.NumOutput();
     bool has_layouts_list = spec.TryGetRepeatedArgument(output_layouts_, "output_layouts");
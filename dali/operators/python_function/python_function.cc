@@ -33,6 +33,16 @@ DALI_SCHEMA(PythonFunctionBase)
 This argument can be a list that contains a distinct layout for each output. If the list has
 fewer than num_outputs elements, only the first outputs have the layout set and the rest of the
 outputs have no layout assigned.)code", nullptr)
+    .AddOptionalArg("no_copy", R"code(Determines whether DALI should use the memory of the
+CPU outputs returned by the function as the outputs of the operator, instead of copying them.
+
+The memory is used directly only if it's dense and it's not a part of the operator's inputs;
+otherwise, the data is copied. The GPU outputs are always copied.
+
+.. warning::
+    With this option enabled, the function must return new arrays - it must not modify the
+    memory of the returned arrays afterwards (for example, by reusing an output buffer in
+    subsequent calls), because the outputs of the operator may still be in use.)code", false)
     .MakeInternal();
 
 DALI_SCHEMA(PythonFunction)
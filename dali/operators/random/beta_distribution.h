@@ -1,4 +1,4 @@
-// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2024-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,6 +16,7 @@
 #define DALI_OPERATORS_RANDOM_BETA_DISTRIBUTION_H_
 
 #include <random>
+#include <type_traits>
 #include <vector>
 #include "dali/operators/random/rng_base.h"
 #include "dali/pipeline/operator/arg_helper.h"
@@ -24,11 +25,16 @@
 
 namespace dali {
 
-template <typename T>
+template <typename Backend, typename T>
 struct BetaDistributionImpl {
-  BetaDistributionImpl() : BetaDistributionImpl{1, 1} {}
+  static constexpr bool is_gpu = std::is_same_v<Backend, GPUBackend>;
+  using GammaDist = std::conditional_t<is_gpu, curand_gamma_dist<T>, std::gamma_distribution<T>>;
+  using ExpDist =
+      std::conditional_t<is_gpu, curand_exponential_dist<T>, std::exponential_distribution<T>>;
 
-  explicit BetaDistributionImpl(T alpha, T beta)
+  DALI_HOST_DEV BetaDistributionImpl() : BetaDistributionImpl{1, 1} {}
+
+  DALI_HOST_DEV explicit BetaDistributionImpl(T alpha, T beta)
       : has_small_param_{alpha < 1 && beta < 1},
         alpha_{alpha},
         beta_{beta},
@@ -38,13 +44,13 @@ struct BetaDistributionImpl {
         exp_{} {}
 
   template <typename Generator>
-  T Generate(Generator &st) {
+  DALI_HOST_DEV T Generate(Generator &st) {
     return has_small_param_ ? GenerateGammaExp(st) : GenerateGamma(st);
   }
 
  private:
   template <typename Generator>
-  T GenerateGamma(Generator &st) {
+  DALI_HOST_DEV T GenerateGamma(Generator &st) {
     // https://en.wikipedia.org/wiki/Beta_distribution#Random_variate_generation
     T a = a_(st);
     T b = b_(st);
@@ -52,7 +58,7 @@ struct BetaDistributionImpl {
   }
 
   template <typename Generator>
-  T GenerateGammaExp(Generator &st) {
+  DALI_HOST_DEV T GenerateGammaExp(Generator &st) {
     assert(alpha_ < 1 && beta_ < 1);
     // For alpha >= 1 and x in [0, 1], Gamma(alpha).cdf(x) <= Exp(1).cdf(x),
     // i.e., the probability of sampling [0, x] is less than 1 - exp(-x) <= x,
@@ -91,16 +97,15 @@ struct BetaDistributionImpl {
 
   bool has_small_param_;
   T alpha_, beta_, b_div_a_;
-  std::gamma_distribution<T> a_;
-  std::gamma_distribution<T> b_;
-  std::exponential_distribution<T> exp_;
+  GammaDist a_;
+  GammaDist b_;
+  ExpDist exp_;
 };
 
 template <typename Backend>
 class BetaDistribution : public rng::RNGBase<Backend, BetaDistribution<Backend>, false> {
  public:
   using Base = rng::RNGBase<Backend, BetaDistribution<Backend>, false>;
-  static_assert(std::is_same_v<Backend, CPUBackend>, "GPU backend is not implemented");
 
   explicit BetaDistribution(const OpSpec &spec)
       : Base(spec), alpha_("alpha", spec), beta_("beta", spec) {}
@@ -132,19 +137,19 @@ class BetaDistribution : public rng::RNGBase<Backend, BetaDistribution<Backend>,
   }
 
   template <typename T>
-  bool SetupDists(BetaDistributionImpl<T> *dists, const Workspace &ws, int nsamples) {
+  bool SetupDists(BetaDistributionImpl<Backend, T> *dists, const Workspace &ws, int nsamples) {
     for (int sample_idx = 0; sample_idx < nsamples; sample_idx++) {
       auto alpha = alpha_[sample_idx].data[0];
       auto beta = beta_[sample_idx].data[0];
       dists[sample_idx] =
-          BetaDistributionImpl<T>{alpha_[sample_idx].data[0], beta_[sample_idx].data[0]};
+          BetaDistributionImpl<Backend, T>{alpha_[sample_idx].data[0], beta_[sample_idx].data[0]};
     }
     return true;
   }
 
   template <typename T>
   void RunImplTyped(Workspace &ws) {
-    Base::template RunImplTyped<T, BetaDistributionImpl<T>>(ws);
+    Base::template RunImplTyped<T, BetaDistributionImpl<Backend, T>>(ws);
   }
 
   void RunImpl(Workspace &ws) override {
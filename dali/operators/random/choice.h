@@ -1,4 +1,4 @@
-// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2024-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -17,7 +17,12 @@
 
 #include <cstdint>
 #include <random>
+#include <type_traits>
+#include <vector>
+#include "dali/core/dev_buffer.h"
 #include "dali/core/error_handling.h"
+#include "dali/core/util.h"
+#include "dali/kernels/dynamic_scratchpad.h"
 #include "dali/operators/random/rng_base.h"
 #include "dali/operators/random/rng_base_cpu.h"
 #include "dali/operators/random/rng_base_gpu.h"
@@ -98,19 +103,72 @@ struct ChoiceSampleDist<T, uniform, false> {
   DistType dist_ = {};
 };
 
+/**
+ * @brief GPU variant of ChoiceSampleDist - the elements and the cumulative distribution
+ *        reside in device memory.
+ *
+ * @tparam indirect - whether the drawn index is used to select one of the `elements` (true)
+ *                    or returned directly (false).
+ */
+template <typename T, bool uniform, bool indirect = true>
+struct ChoiceSampleDistGPU {
+  DALI_HOST_DEV ChoiceSampleDistGPU() {}
+
+  /**
+   * @param cdf The cumulative distribution, `element_count` values (only if not uniform)
+   */
+  DALI_HOST_DEV ChoiceSampleDistGPU(const T *elements, const float *cdf, int64_t element_count)
+      : elements_(elements), cdf_(cdf), element_count_(element_count) {}
+
+  template <typename State>
+  __device__ T Generate(State *st) const {
+    int64_t idx;
+    if (uniform) {
+      uint64_t r = curand(st);
+      if (element_count_ > 0xffffffffu)
+        r = (r << 32) | curand(st);
+      idx = r % element_count_;
+    } else {
+      float u = curand_uniform(st);  // (0, 1]
+      int64_t lo = 0, hi = element_count_ - 1;
+      while (lo < hi) {
+        int64_t mid = (lo + hi) / 2;
+        if (cdf_[mid] < u)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      idx = lo;
+    }
+    if constexpr (indirect)
+      return elements_[idx];
+    else
+      return static_cast<T>(idx);
+  }
+
+  const T *elements_ = nullptr;
+  const float *cdf_ = nullptr;
+  int64_t element_count_ = 1;
+};
+
 template <typename Backend>
 class Choice : public rng::RNGBase<Backend, Choice<Backend>, false> {
  public:
   using BaseImpl = rng::RNGBase<Backend, Choice<Backend>, false>;
+  static constexpr bool is_gpu = std::is_same_v<Backend, GPUBackend>;
 
   template <typename T, bool uniform, int dim>
-  using Impl = ChoiceSampleDist<T, uniform, dim>;
+  using Impl = std::conditional_t<is_gpu, ChoiceSampleDistGPU<T, uniform, dim>,
+                                  ChoiceSampleDist<T, uniform, dim>>;
 
   explicit Choice(const OpSpec &spec) : BaseImpl(spec), p_dist_("p", spec) {}
 
 
   void AcquireArgs(const OpSpec &spec, const Workspace &ws, int nsamples) {
     const auto &input = ws.Input<CPUBackend>(0);
+    DALI_ENFORCE(!is_gpu || input.sample_dim() <= 1, make_string(
+        "The GPU operator supports only scalar and 1D inputs; got a ", input.sample_dim(),
+        "D input."));
     input_list_shape_.resize(nsamples);
     for (int sample_idx = 0; sample_idx < nsamples; sample_idx++) {
       int64_t num_elements = GetSampleNumElements(ws.Input<CPUBackend>(0), sample_idx);
@@ -169,8 +227,12 @@ class Choice : public rng::RNGBase<Backend, Choice<Backend>, false> {
   template <typename T>
   bool SetupDists(Impl<T, false, false> *dists_data, const Workspace &ws, int nsamples) {
     for (int s = 0; s < nsamples; s++) {
-      dists_data[s] =
-          Impl<T, false, false>{p_dist_[s].data, p_dist_[s].data + p_dist_[s].num_elements()};
+      if constexpr (is_gpu) {
+        dists_data[s] = Impl<T, false, false>{nullptr, cdf_gpu_[s], input_list_shape_[s][0]};
+      } else {
+        dists_data[s] =
+            Impl<T, false, false>{p_dist_[s].data, p_dist_[s].data + p_dist_[s].num_elements()};
+      }
     }
     return true;
   }
@@ -178,7 +240,10 @@ class Choice : public rng::RNGBase<Backend, Choice<Backend>, false> {
   template <typename T>
   bool SetupDists(Impl<T, true, 0> *dists_data, const Workspace &ws, int nsamples) {
     for (int s = 0; s < nsamples; s++) {
-      dists_data[s] = Impl<T, true, false>{input_list_shape_[s][0]};
+      if constexpr (is_gpu)
+        dists_data[s] = Impl<T, true, false>{nullptr, nullptr, input_list_shape_[s][0]};
+      else
+        dists_data[s] = Impl<T, true, false>{input_list_shape_[s][0]};
     }
     return true;
   }
@@ -187,8 +252,14 @@ class Choice : public rng::RNGBase<Backend, Choice<Backend>, false> {
   template <typename T>
   bool SetupDists(Impl<T, false, true> *dists_data, const Workspace &ws, int nsamples) {
     for (int s = 0; s < nsamples; s++) {
-      dists_data[s] = Impl<T, false, true>{ws.Input<CPUBackend>(0).tensor<T>(s), p_dist_[s].data,
-                                           p_dist_[s].data + p_dist_[s].num_elements()};
+      if constexpr (is_gpu) {
+        dists_data[s] = Impl<T, false, true>{static_cast<const T *>(elements_gpu_[s]),
+                                             cdf_gpu_[s], input_list_shape_[s][0]};
+      } else {
+        dists_data[s] = Impl<T, false, true>{ws.Input<CPUBackend>(0).tensor<T>(s),
+                                             p_dist_[s].data,
+                                             p_dist_[s].data + p_dist_[s].num_elements()};
+      }
     }
     return true;
   }
@@ -196,8 +267,13 @@ class Choice : public rng::RNGBase<Backend, Choice<Backend>, false> {
   template <typename T>
   bool SetupDists(Impl<T, true, true> *dists_data, const Workspace &ws, int nsamples) {
     for (int s = 0; s < nsamples; s++) {
-      dists_data[s] =
-          Impl<T, true, true>{ws.Input<CPUBackend>(0).tensor<T>(s), input_list_shape_[s][0]};
+      if constexpr (is_gpu) {
+        dists_data[s] = Impl<T, true, true>{static_cast<const T *>(elements_gpu_[s]), nullptr,
+                                            input_list_shape_[s][0]};
+      } else {
+        dists_data[s] =
+            Impl<T, true, true>{ws.Input<CPUBackend>(0).tensor<T>(s), input_list_shape_[s][0]};
+      }
     }
     return true;
   }
@@ -205,7 +281,9 @@ class Choice : public rng::RNGBase<Backend, Choice<Backend>, false> {
   using BaseImpl::RunImpl;
   void RunImpl(Workspace &ws) override {
     const auto &input = ws.Input<CPUBackend>(0);
-    auto &output = ws.Output<CPUBackend>(0);
+    auto &output = ws.Output<Backend>(0);
+    if constexpr (is_gpu)
+      CopyParamsToGPU(ws);
     if (input.sample_dim() == 0) {
       TYPE_SWITCH(dtype_, type2id, T, (DALI_CHOICE_0D_TYPES), (
         if (p_dist_.HasValue()) {
@@ -228,7 +306,7 @@ class Choice : public rng::RNGBase<Backend, Choice<Backend>, false> {
         DALI_FAIL("Data type ", dtype_, " is not supported for 1D inputs. "
                   "Supported types are: ", ListTypeNames<DALI_CHOICE_1D_TYPES>(), ".");
       ));  // NOLINT
-    } else {
+    } else if constexpr (!is_gpu) {
       ElementCopy(ws);
     }
     if (!input.GetLayout().empty()) {
@@ -297,23 +375,13 @@ class Choice : public rng::RNGBase<Backend, Choice<Backend>, false> {
 
       tp.AddWork(
           [=](int thread_id) {
-            auto &rng = rng_[sample_idx];
-            if (p_dist_.HasValue()) {
-              auto dist = ChoiceSampleDist<int64_t, false, false>(
-                  p_dist_[sample_idx].data,
-                  p_dist_[sample_idx].data + p_dist_[sample_idx].num_elements());
-              for (int64_t i = 0; i < num_output_elements; ++i) {
-                auto source_idx = dist.Generate(rng);
-                memcpy(output_data + i * element_size, input_data + source_idx * element_size,
-                       element_size);
-              }
+            if (counter_based_) {
+              auto rng = this->CounterRng(sample_idx);
+              CopyElements(rng, output_data, input_data, sample_idx, element_size,
+                           num_input_elements, num_output_elements);
             } else {
-              auto dist = ChoiceSampleDist<int64_t, true, false>(num_input_elements);
-              for (int64_t i = 0; i < num_output_elements; ++i) {
-                auto source_idx = dist.Generate(rng);
-                memcpy(output_data + i * element_size, input_data + source_idx * element_size,
-                       element_size);
-              }
+              CopyElements(rng_[sample_idx], output_data, input_data, sample_idx, element_size,
+                           num_input_elements, num_output_elements);
             }
           },
           volume(output.tensor_shape(sample_idx)));
@@ -321,17 +389,107 @@ class Choice : public rng::RNGBase<Backend, Choice<Backend>, false> {
     tp.RunAll();
   }
 
+  /**
+   * @brief Copies the elements to choose from (1D input) and the cumulative distributions
+   *        (if `p` is given) to the GPU, in one transfer.
+   *
+   * The input and `p` are tiny CPU tensors - the numbers are drawn on the device, so the output
+   * is produced without any further host-to-device copies.
+   */
+  void CopyParamsToGPU(Workspace &ws) {
+    const auto &input = ws.Input<CPUBackend>(0);
+    int nsamples = input_list_shape_.num_samples();
+    bool indirect = input.sample_dim() == 1;
+    size_t type_size = input.type_info().size();
+    constexpr size_t kAlign = alignof(double);
+    size_t total = 0;
+    std::vector<size_t> elements_offset(nsamples), cdf_offset(nsamples);
+    for (int s = 0; s < nsamples; s++) {
+      int64_t n = input_list_shape_[s][0];
+      if (indirect) {
+        elements_offset[s] = total;
+        total = align_up(total + n * type_size, kAlign);
+      }
+      if (p_dist_.HasValue()) {
+        cdf_offset[s] = total;
+        total = align_up(total + n * sizeof(float), kAlign);
+      }
+    }
+    elements_gpu_.assign(nsamples, nullptr);
+    cdf_gpu_.assign(nsamples, nullptr);
+    if (total == 0)
+      return;
+
+    kernels::DynamicScratchpad scratch({}, ws.stream());
+    auto *params_cpu = scratch.Allocate<mm::memory_kind::pinned, uint8_t>(total);
+    for (int s = 0; s < nsamples; s++) {
+      int64_t n = input_list_shape_[s][0];
+      if (indirect)
+        memcpy(params_cpu + elements_offset[s], input.raw_tensor(s), n * type_size);
+      if (p_dist_.HasValue()) {
+        // normalized, so that the last non-zero probability ends the distribution
+        auto *cdf = reinterpret_cast<float *>(params_cpu + cdf_offset[s]);
+        double sum = 0, total_p = 0;
+        for (int64_t i = 0; i < n; i++)
+          total_p += p_dist_[s].data[i];
+        for (int64_t i = 0; i < n; i++) {
+          sum += p_dist_[s].data[i];
+          cdf[i] = sum / total_p;
+        }
+      }
+    }
+    params_gpu_.from_host(params_cpu, total, ws.stream());
+    for (int s = 0; s < nsamples; s++) {
+      if (indirect)
+        elements_gpu_[s] = params_gpu_.data() + elements_offset[s];
+      if (p_dist_.HasValue())
+        cdf_gpu_[s] = reinterpret_cast<const float *>(params_gpu_.data() + cdf_offset[s]);
+    }
+  }
+
+  /**
+   * @brief Fills the output sample with elements of the input sample, drawn with `rng`
+   */
+  template <typename RNG>
+  void CopyElements(RNG &rng, uint8_t *output_data, const uint8_t *input_data, int sample_idx,
+                    int64_t element_size, int64_t num_input_elements,
+                    int64_t num_output_elements) {
+    if (p_dist_.HasValue()) {
+      auto dist = ChoiceSampleDist<int64_t, false, false>(
+          p_dist_[sample_idx].data,
+          p_dist_[sample_idx].data + p_dist_[sample_idx].num_elements());
+      for (int64_t i = 0; i < num_output_elements; ++i) {
+        auto source_idx = dist.Generate(rng);
+        memcpy(output_data + i * element_size, input_data + source_idx * element_size,
+               element_size);
+      }
+    } else {
+      auto dist = ChoiceSampleDist<int64_t, true, false>(num_input_elements);
+      for (int64_t i = 0; i < num_output_elements; ++i) {
+        auto source_idx = dist.Generate(rng);
+        memcpy(output_data + i * element_size, input_data + source_idx * element_size,
+               element_size);
+      }
+    }
+  }
+
 
   using Operator<Backend>::max_batch_size_;
   using BaseImpl::backend_data_;
   using BaseImpl::dtype_;
   using BaseImpl::rng_;
+  using BaseImpl::counter_based_;
   using BaseImpl::shape_;
 
 
   ArgValue<float, 1> p_dist_;
   // The shape of input as interpreted as the flat list of elements to be sampled.
   TensorListShape<1> input_list_shape_;
+
+  // GPU only: the elements to choose from and the cumulative distributions, per sample
+  DeviceBuffer<uint8_t> params_gpu_;
+  std::vector<const void *> elements_gpu_;
+  std::vector<const float *> cdf_gpu_;
 };
 
 }  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -34,6 +34,9 @@ For scalar inputs, only integral types are supported, otherwise any type can be
 The operator supports selection from an input containing elements of one of DALI enum types,
 that is: :meth:`nvidia.dali.types.DALIDataType`, :meth:`nvidia.dali.types.DALIImageType`, or
 :meth:`nvidia.dali.types.DALIInterpType`.
+
+The GPU operator takes the input ``__a`` and the probabilities on the CPU and draws the numbers on
+the device. Only scalar and 1D inputs are supported there.
 )code")
     .NumInput(1, 2)
     .InputDox(0, "a", "scalar or TensorList",
@@ -42,13 +45,15 @@ that is: :meth:`nvidia.dali.types.DALIDataType`, :meth:`nvidia.dali.types.DALIIm
               "Otherwise ``__a`` is treated as 1D array of input samples.")
     .InputDox(1, "shape_like", "TensorList",
               "Shape of this input will be used to infer the shape of the output, if provided.")
+    .InputDevice(0, InputDevice::CPU)
     .InputDevice(1, InputDevice::Metadata)
     .NumOutput(1)
     .AddOptionalArg<std::vector<float>>("p",
                                         "Distribution of the probabilities. "
                                         "If not specified, uniform distribution is assumed.",
                                         nullptr, true)
-    .AddOptionalArg<std::vector<int>>("shape", "Shape of the output data.", nullptr, true);
+    .AddOptionalArg<std::vector<int>>("shape", "Shape of the output data.", nullptr, true)
+    .AddParent("CounterBasedRNGAttr");
 
 DALI_REGISTER_OPERATOR(random__Choice, Choice<CPUBackend>, CPU);
 
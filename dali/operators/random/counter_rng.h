@@ -0,0 +1,46 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_RANDOM_COUNTER_RNG_H_
+#define DALI_OPERATORS_RANDOM_COUNTER_RNG_H_
+
+#include <cstdint>
+#include "dali/core/host_dev.h"
+#include "dali/core/philox.h"
+
+namespace dali {
+namespace rng {
+
+/**
+ * @brief The Philox subsequence used by the counter-based generator for given sample and iteration
+ *
+ * The generators of a sample in an iteration are `Philox4x32_10(seed, subsequence, offset)`,
+ * where the offset is the index of the first element generated, shifted by
+ * `kCounterRngOffsetShift` (see CounterRngOffset) - the streams don't overlap as long as fewer
+ * than 2^32 numbers are drawn per element.
+ */
+DALI_HOST_DEV constexpr uint64_t CounterRngSubsequence(uint64_t iteration, int sample_idx) {
+  return iteration << 32 | static_cast<uint32_t>(sample_idx);
+}
+
+constexpr int kCounterRngOffsetShift = 32;
+
+DALI_HOST_DEV constexpr uint64_t CounterRngOffset(int64_t element_idx) {
+  return static_cast<uint64_t>(element_idx) << kCounterRngOffsetShift;
+}
+
+}  // namespace rng
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_RANDOM_COUNTER_RNG_H_
@@ -1,4 +1,4 @@
-// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -30,7 +30,8 @@ The shape and data type of the output will match the input.
       0.f, true)
     .AddOptionalArg<float>("stddev",
       R"code(Standard deviation of the distribution.)code",
-      1.f, true);
+      1.f, true)
+    .AddParent("CounterBasedRNGAttr");
 
 DALI_REGISTER_OPERATOR(noise__Gaussian, GaussianNoise<CPUBackend>, CPU);
 
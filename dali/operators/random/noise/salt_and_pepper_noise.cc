@@ -1,4 +1,4 @@
-// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -53,7 +53,8 @@ kept intact, take the "pepper" value, or the "salt" value.
 
 Note: Per-channel noise generation requires the input layout to contain a channels ('C') dimension,
 or be empty. In the case of the layout being empty, channel-last layout is assumed.)code",
-      false);
+      false)
+    .AddParent("CounterBasedRNGAttr");
 
 DALI_REGISTER_OPERATOR(noise__SaltAndPepper, SaltAndPepperNoise<CPUBackend>, CPU);
 
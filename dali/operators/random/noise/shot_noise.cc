@@ -1,4 +1,4 @@
-// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -44,7 +44,8 @@ The shape and data type of the output will match the input.
     .NumOutput(1)
     .AddOptionalArg<float>("factor",
       R"code(Factor parameter.)code",
-     20.0f, true);
+     20.0f, true)
+    .AddParent("CounterBasedRNGAttr");
 
 DALI_REGISTER_OPERATOR(noise__Shot, ShotNoise<CPUBackend>, CPU);
 
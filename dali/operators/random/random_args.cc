@@ -0,0 +1,200 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/random/random_args.h"
+#include <cctype>
+#include <random>
+#include <string>
+#include <vector>
+#include "dali/core/philox.h"
+#include "dali/operators/random/counter_rng.h"
+#include "dali/pipeline/operator/op_schema.h"
+
+namespace dali {
+
+DALI_SCHEMA(RandomArgsAttr)
+    .DocStr(R"code(Random arguments drawn by the operator.
+
+It should be added as parent to the operators that use RandomArgs.)code")
+    .AddOptionalArg("random_args",
+      R"code(Per-sample arguments drawn by the operator from the given distributions.
+
+Each entry has the form ``"name=distribution(parameters)"``, for example
+``["angle=uniform(-30, 30)"]``. Supported distributions:
+
+* ``uniform(lo, hi)`` - a value from the range ``[lo, hi)``,
+* ``normal(mean, stddev)``,
+* ``choice(v0, v1, ...)`` - one of the listed values, with equal probability,
+* ``coin_flip(p)`` - 1 with probability ``p``, 0 otherwise.
+
+This is equivalent to passing the output of a random operator as the argument input, but
+the values are drawn from a counter-based generator inside the operator - there's no separate
+operator to run and no argument data to transfer. The values depend on the seed of this
+operator, the iteration and the index of the sample; the CPU and GPU variants of the operator
+produce the same values.
+
+The arguments listed here must not be specified otherwise.
+)code", std::vector<std::string>{});
+
+namespace {
+
+std::string Trim(const std::string &s) {
+  size_t b = 0, e = s.size();
+  while (b < e && std::isspace(static_cast<unsigned char>(s[b])))
+    b++;
+  while (e > b && std::isspace(static_cast<unsigned char>(s[e - 1])))
+    e--;
+  return s.substr(b, e - b);
+}
+
+}  // namespace
+
+RandomArgDist ParseRandomArg(const std::string &desc, std::string &name) {
+  auto invalid = [&](const char *what) {
+    return make_string("Invalid random argument \"", desc, "\": ", what,
+                       " Expected \"name=distribution(parameters)\".");
+  };
+  size_t eq = desc.find('=');
+  DALI_ENFORCE(eq != std::string::npos, invalid("missing \"=\"."));
+  name = Trim(desc.substr(0, eq));
+  DALI_ENFORCE(!name.empty(), invalid("missing argument name."));
+
+  std::string dist_desc = Trim(desc.substr(eq + 1));
+  size_t open = dist_desc.find('(');
+  DALI_ENFORCE(open != std::string::npos && dist_desc.back() == ')',
+               invalid("missing parameter list."));
+  std::string kind = Trim(dist_desc.substr(0, open));
+
+  RandomArgDist dist;
+  std::string params = dist_desc.substr(open + 1, dist_desc.size() - open - 2);
+  size_t pos = 0;
+  while (!Trim(params).empty()) {
+    size_t comma = params.find(',', pos);
+    std::string param = Trim(params.substr(pos, comma == std::string::npos ? comma : comma - pos));
+    size_t parsed = 0;
+    float value = 0;
+    try {
+      value = std::stof(param, &parsed);
+    } catch (const std::exception &) {
+      parsed = 0;
+    }
+    DALI_ENFORCE(!param.empty() && parsed == param.size(),
+                 invalid("the parameters must be numbers."));
+    dist.params.push_back(value);
+    if (comma == std::string::npos)
+      break;
+    pos = comma + 1;
+  }
+
+  size_t nparams = dist.params.size();
+  if (kind == "uniform") {
+    dist.kind = RandomArgDist::Uniform;
+    DALI_ENFORCE(nparams == 2 && dist.params[0] < dist.params[1],
+                 invalid("uniform expects two parameters: lo < hi."));
+  } else if (kind == "normal") {
+    dist.kind = RandomArgDist::Normal;
+    DALI_ENFORCE(nparams == 2 && dist.params[1] >= 0,
+                 invalid("normal expects two parameters: mean and a non-negative stddev."));
+  } else if (kind == "choice") {
+    dist.kind = RandomArgDist::Choice;
+    DALI_ENFORCE(nparams >= 1, invalid("choice expects at least one value."));
+  } else if (kind == "coin_flip") {
+    dist.kind = RandomArgDist::CoinFlip;
+    DALI_ENFORCE(nparams == 1 && dist.params[0] >= 0 && dist.params[0] <= 1,
+                 invalid("coin_flip expects one parameter: a probability in range [0, 1]."));
+  } else {
+    DALI_FAIL(invalid("unknown distribution; supported are: uniform, normal, choice, coin_flip."));
+  }
+  return dist;
+}
+
+RandomArgs::RandomArgs(const OpSpec &spec)
+    : seed_(spec.GetArgument<int64_t>("seed")) {
+  std::vector<std::string> descs;
+  if (!spec.TryGetRepeatedArgument(descs, "random_args"))
+    return;
+  const auto &schema = spec.GetSchema();
+  for (auto &desc : descs) {
+    std::string name;
+    auto dist = ParseRandomArg(desc, name);
+    DALI_ENFORCE(schema.HasArgument(name) && schema.IsTensorArgument(name),
+                 make_string("Invalid random argument \"", desc, "\": `", name,
+                             "` is not a per-sample argument of the operator."));
+    DALI_ENFORCE(!spec.ArgumentDefined(name),
+                 make_string("The argument `", name, "` cannot be specified both directly "
+                             "and in `random_args`."));
+    int index = args_.size();
+    bool inserted = args_.emplace(name, Arg{index, std::move(dist)}).second;
+    DALI_ENFORCE(inserted, make_string("The argument `", name,
+                                       "` appears more than once in `random_args`."));
+  }
+}
+
+const RandomArgs::Arg &RandomArgs::GetArg(const std::string &name) const {
+  auto it = args_.find(name);
+  DALI_ENFORCE(it != args_.end(), make_string("`", name, "` is not a random argument."));
+  return it->second;
+}
+
+float RandomArgs::Value(const Arg &arg, int sample_idx) const {
+  // Each argument of a sample has its own stream
+  Philox4x32_10 rng(seed_, rng::CounterRngSubsequence(iteration_, sample_idx),
+                    rng::CounterRngOffset(arg.index));
+  auto &p = arg.dist.params;
+  switch (arg.dist.kind) {
+    case RandomArgDist::Uniform: {
+      std::uniform_real_distribution<float> dist(p[0], p[1]);
+      float value;
+      do {
+        value = dist(rng);
+      } while (value >= p[1]);  // guard against rounding at the end of the range
+      return value;
+    }
+    case RandomArgDist::Normal:
+      return std::normal_distribution<float>(p[0], p[1])(rng);
+    case RandomArgDist::Choice:
+      return p[std::uniform_int_distribution<int>(0, p.size() - 1)(rng)];
+    case RandomArgDist::CoinFlip:
+    default:
+      return std::bernoulli_distribution(p[0])(rng) ? 1.0f : 0.0f;
+  }
+}
+
+void RandomArgs::SaveState(OpCheckpoint &cpt) const {
+  if (!empty())
+    cpt.MutableCheckpointState() = next_iteration_;
+}
+
+void RandomArgs::RestoreState(const OpCheckpoint &cpt) {
+  if (!empty())
+    next_iteration_ = cpt.CheckpointState<uint64_t>();
+}
+
+std::string RandomArgs::SerializeCheckpoint(const OpCheckpoint &cpt) const {
+  if (empty())
+    return {};
+  return std::to_string(cpt.CheckpointState<uint64_t>());
+}
+
+void RandomArgs::DeserializeCheckpoint(OpCheckpoint &cpt, const std::string &data) const {
+  if (empty()) {
+    DALI_ENFORCE(data.empty(),
+                 "Provided checkpoint contains non-empty data for a stateless operator. "
+                 "The checkpoint might come from another pipeline. ");
+    return;
+  }
+  cpt.MutableCheckpointState() = static_cast<uint64_t>(std::stoull(data));
+}
+
+}  // namespace dali
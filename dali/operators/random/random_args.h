@@ -0,0 +1,129 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_RANDOM_RANDOM_ARGS_H_
+#define DALI_OPERATORS_RANDOM_RANDOM_ARGS_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include "dali/core/common.h"
+#include "dali/core/convert.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/pipeline/operator/checkpointing/op_checkpoint.h"
+#include "dali/pipeline/operator/op_spec.h"
+
+namespace dali {
+
+/**
+ * @brief A distribution of a random argument, e.g. `uniform(-30, 30)`
+ */
+struct RandomArgDist {
+  enum Kind {
+    Uniform,   // uniform(lo, hi)
+    Normal,    // normal(mean, stddev)
+    Choice,    // choice(v0, v1, ...)
+    CoinFlip,  // coin_flip(probability)
+  };
+  Kind kind = Uniform;
+  std::vector<float> params;
+};
+
+/**
+ * @brief Parses a `name=distribution(params...)` entry of the `random_args` argument
+ */
+DLL_PUBLIC RandomArgDist ParseRandomArg(const std::string &desc, std::string &name);
+
+/**
+ * @brief Per-sample argument values drawn by the consumer operator itself
+ *
+ * Instead of passing the output of a random operator as an argument input, the user can
+ * specify the distribution of the argument in `random_args` (see RandomArgsAttr). The values
+ * are drawn in the operator's Setup from the counter-based generator of the sample, derived
+ * from the operator's seed, the iteration and the index of the sample - there's no separate
+ * operator to run and the values don't have to be transferred as argument inputs.
+ * The CPU and GPU variants of an operator obtain the same values.
+ *
+ * The only state is the iteration counter, which is checkpointed.
+ */
+class DLL_PUBLIC RandomArgs {
+ public:
+  RandomArgs() = default;
+  explicit RandomArgs(const OpSpec &spec);
+
+  bool empty() const noexcept {
+    return args_.empty();
+  }
+
+  bool Has(const std::string &name) const {
+    return args_.count(name) > 0;
+  }
+
+  /**
+   * @brief Moves to the next iteration; must be called once per iteration, before `Draw`.
+   */
+  void Advance() {
+    iteration_ = next_iteration_++;
+  }
+
+  /**
+   * @brief Draws the values of the argument `name` for `nsamples` samples of the current iteration
+   */
+  template <typename T>
+  void Draw(std::vector<T> &out, const std::string &name, int nsamples) const {
+    auto &arg = GetArg(name);
+    out.resize(nsamples);
+    for (int s = 0; s < nsamples; s++)
+      out[s] = ConvertSat<T>(Value(arg, s));
+  }
+
+  /**
+   * @brief Draws the values of the argument `name` for the frames of the samples of a sequence
+   *        operator
+   *
+   * The value is drawn once per sample and repeated for all `volume(sequence_extents[i])`
+   * frames of the i-th sample.
+   */
+  template <typename T>
+  void Draw(std::vector<T> &out, const std::string &name,
+            const TensorListShape<> &sequence_extents) const {
+    auto &arg = GetArg(name);
+    out.clear();
+    for (int s = 0; s < sequence_extents.num_samples(); s++)
+      out.resize(out.size() + volume(sequence_extents[s]), ConvertSat<T>(Value(arg, s)));
+  }
+
+  void SaveState(OpCheckpoint &cpt) const;
+  void RestoreState(const OpCheckpoint &cpt);
+  std::string SerializeCheckpoint(const OpCheckpoint &cpt) const;
+  void DeserializeCheckpoint(OpCheckpoint &cpt, const std::string &data) const;
+
+ private:
+  struct Arg {
+    int index;
+    RandomArgDist dist;
+  };
+
+  const Arg &GetArg(const std::string &name) const;
+  float Value(const Arg &arg, int sample_idx) const;
+
+  std::map<std::string, Arg> args_;
+  uint64_t seed_ = 0;
+  uint64_t iteration_ = 0;
+  uint64_t next_iteration_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_RANDOM_RANDOM_ARGS_H_
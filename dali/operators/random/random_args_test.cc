@@ -0,0 +1,127 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "dali/operators/random/random_args.h"
+
+namespace dali {
+
+namespace {
+
+OpSpec BrightnessSpec(std::vector<std::string> random_args, int64_t seed = 42) {
+  return OpSpec("Brightness")
+      .AddArg("seed", seed)
+      .AddArg("random_args", random_args);
+}
+
+}  // namespace
+
+TEST(RandomArgsTest, Parse) {
+  std::string name;
+  auto dist = ParseRandomArg(" angle = uniform(-30, 30.5) ", name);
+  EXPECT_EQ(name, "angle");
+  EXPECT_EQ(dist.kind, RandomArgDist::Uniform);
+  EXPECT_EQ(dist.params, (std::vector<float>{-30.0f, 30.5f}));
+
+  dist = ParseRandomArg("contrast=normal(1,0.1)", name);
+  EXPECT_EQ(name, "contrast");
+  EXPECT_EQ(dist.kind, RandomArgDist::Normal);
+  EXPECT_EQ(dist.params, (std::vector<float>{1.0f, 0.1f}));
+
+  dist = ParseRandomArg("angle=choice(0, 90, 180, 270)", name);
+  EXPECT_EQ(dist.kind, RandomArgDist::Choice);
+  EXPECT_EQ(dist.params.size(), 4u);
+
+  dist = ParseRandomArg("brightness=coin_flip(0.25)", name);
+  EXPECT_EQ(dist.kind, RandomArgDist::CoinFlip);
+  EXPECT_EQ(dist.params, (std::vector<float>{0.25f}));
+}
+
+TEST(RandomArgsTest, ParseErrors) {
+  std::string name;
+  for (const char *desc : {"uniform(0, 1)", "=uniform(0, 1)", "angle=uniform",
+                           "angle=uniform(1, 0)", "angle=uniform(0)", "angle=normal(0, -1)",
+                           "angle=choice()", "angle=coin_flip(2)", "angle=uniform(0, x)",
+                           "angle=gamma(1, 2)"}) {
+    EXPECT_THROW(ParseRandomArg(desc, name), std::exception) << desc;
+  }
+}
+
+TEST(RandomArgsTest, Draw) {
+  RandomArgs args(BrightnessSpec({"brightness=uniform(0.5, 1.5)",
+                                  "brightness_shift=choice(0, 1)"}));
+  EXPECT_TRUE(args.Has("brightness"));
+  EXPECT_TRUE(args.Has("brightness_shift"));
+  EXPECT_FALSE(args.Has("contrast"));
+
+  constexpr int nsamples = 64;
+  std::vector<float> b0, b1, s0;
+  args.Advance();
+  args.Draw(b0, "brightness", nsamples);
+  args.Draw(s0, "brightness_shift", nsamples);
+  ASSERT_EQ(b0.size(), static_cast<size_t>(nsamples));
+  for (int i = 0; i < nsamples; i++) {
+    EXPECT_GE(b0[i], 0.5f);
+    EXPECT_LT(b0[i], 1.5f);
+    EXPECT_TRUE(s0[i] == 0 || s0[i] == 1);
+  }
+  EXPECT_NE(b0[0], b0[1]);
+
+  // the values of a sample don't depend on the batch size
+  args.Draw(b1, "brightness", nsamples / 2);
+  EXPECT_EQ(b1, std::vector<float>(b0.begin(), b0.begin() + nsamples / 2));
+
+  // ...but they change with the iteration
+  args.Advance();
+  args.Draw(b1, "brightness", nsamples);
+  EXPECT_NE(b0, b1);
+
+  // the same seed gives the same values
+  RandomArgs same(BrightnessSpec({"brightness=uniform(0.5, 1.5)"}));
+  same.Advance();
+  same.Draw(b1, "brightness", nsamples);
+  EXPECT_EQ(b0, b1);
+
+  RandomArgs other(BrightnessSpec({"brightness=uniform(0.5, 1.5)"}, 43));
+  other.Advance();
+  other.Draw(b1, "brightness", nsamples);
+  EXPECT_NE(b0, b1);
+}
+
+TEST(RandomArgsTest, DrawSequence) {
+  RandomArgs args(BrightnessSpec({"brightness=normal(1, 0.5)"}));
+  args.Advance();
+  TensorListShape<> extents = uniform_list_shape(3, TensorShape<>{4});
+  extents.set_tensor_shape(1, TensorShape<>{2});
+  std::vector<float> per_sample, per_frame;
+  args.Draw(per_sample, "brightness", 3);
+  args.Draw(per_frame, "brightness", extents);
+  EXPECT_EQ(per_frame, (std::vector<float>{
+      per_sample[0], per_sample[0], per_sample[0], per_sample[0],
+      per_sample[1], per_sample[1],
+      per_sample[2], per_sample[2], per_sample[2], per_sample[2]}));
+}
+
+TEST(RandomArgsTest, InvalidArguments) {
+  EXPECT_THROW(RandomArgs(BrightnessSpec({"angle=uniform(0, 1)"})), std::exception);
+  EXPECT_THROW(RandomArgs(BrightnessSpec({"dtype=uniform(0, 1)"})), std::exception);
+  EXPECT_THROW(RandomArgs(BrightnessSpec({"brightness=uniform(0, 1)",
+                                          "brightness=normal(0, 1)"})), std::exception);
+  EXPECT_THROW(RandomArgs(BrightnessSpec({"brightness=uniform(0, 1)"})
+                              .AddArg("brightness", 1.0f)), std::exception);
+}
+
+}  // namespace dali
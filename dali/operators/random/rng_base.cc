@@ -17,6 +17,23 @@
 
 namespace dali {
 
+DALI_SCHEMA(CounterBasedRNGAttr)
+    .DocStr(R"code(Selection of the counter-based random number generator.
+
+It should be added as parent to all operators based on RNGBase.)code")
+    .AddOptionalArg("counter_based_rng",
+      R"code(Draws the random numbers from a counter-based Philox4x32-10 generator.
+
+The stream of each sample is derived from the seed, the iteration index and the index of
+the sample in the batch, so the operator keeps no generator state other than the iteration
+counter. Initialization, especially on the GPU, is much faster and the checkpoints are tiny.
+The results for a sample don't depend on the batch size.
+
+.. note::
+  The generated numbers differ from the ones produced with the default generator for the same
+  seed.
+)code", false);
+
 // Note that random.choice does not inherit from RNGAttr as it does not support "dtype".
 DALI_SCHEMA(RNGAttr)
     .DocStr(R"code(Random Number Generator attributes.
@@ -29,6 +46,7 @@ It should be added as parent to all RNG operators.)code")
 
 .. note::
   The generated numbers are converted to the output data type, rounding and clamping if necessary.
-)code", nullptr);
+)code", nullptr)
+    .AddParent("CounterBasedRNGAttr");
 
 }  // namespace dali
@@ -27,6 +27,7 @@
 #include "dali/pipeline/util/batch_rng.h"
 #include "dali/core/static_switch.h"
 #include "dali/operators/util/randomizer.cuh"
+#include "dali/operators/random/counter_rng.h"
 #include "dali/operators/random/rng_checkpointing_utils.h"
 
 namespace dali {
@@ -42,9 +43,12 @@ class OperatorWithRng : public Operator<Backend>{
   using CheckpointType = std::conditional_t<std::is_same_v<Backend, CPUBackend>,
                                             BatchRNG<std::mt19937_64>, curand_states>;
   using CheckpointUtils = RngCheckpointUtils<Backend, CheckpointType>;
+  using CounterCheckpointUtils = RngCheckpointUtils<Backend, uint64_t>;
 
   void SaveState(OpCheckpoint &cpt, AccessOrder order) override {
-    if constexpr (std::is_same_v<Backend, CPUBackend>) {
+    if (counter_based_) {
+      CounterCheckpointUtils::SaveState(cpt, order, next_iteration_);
+    } else if constexpr (std::is_same_v<Backend, CPUBackend>) {
       CheckpointUtils::SaveState(cpt, order, rng_);
     } else {
       static_assert(std::is_same_v<Backend, GPUBackend>);
@@ -53,7 +57,9 @@ class OperatorWithRng : public Operator<Backend>{
   }
 
   void RestoreState(const OpCheckpoint &cpt) override {
-    if constexpr (std::is_same_v<Backend, CPUBackend>) {
+    if (counter_based_) {
+      CounterCheckpointUtils::RestoreState(cpt, next_iteration_);
+    } else if constexpr (std::is_same_v<Backend, CPUBackend>) {
       CheckpointUtils::RestoreState(cpt, rng_);
     } else {
       static_assert(std::is_same_v<Backend, GPUBackend>);
@@ -62,11 +68,16 @@ class OperatorWithRng : public Operator<Backend>{
   }
 
   std::string SerializeCheckpoint(const OpCheckpoint &cpt) const override {
+    if (counter_based_)
+      return CounterCheckpointUtils::SerializeCheckpoint(cpt);
     return CheckpointUtils::SerializeCheckpoint(cpt);
   }
 
   void DeserializeCheckpoint(OpCheckpoint &cpt, const std::string &data) const override {
-    CheckpointUtils::DeserializeCheckpoint(cpt, data);
+    if (counter_based_)
+      CounterCheckpointUtils::DeserializeCheckpoint(cpt, data);
+    else
+      CheckpointUtils::DeserializeCheckpoint(cpt, data);
   }
 
  protected:
@@ -78,14 +89,43 @@ class OperatorWithRng : public Operator<Backend>{
     }
   }
 
-  explicit OperatorWithRng(const OpSpec &spec)
+  /**
+   * @param counter_based If true, the operator doesn't use `rng_` nor the GPU generator states -
+   *                      the numbers are obtained from `CounterRng` and the only state is
+   *                      the iteration counter.
+   */
+  explicit OperatorWithRng(const OpSpec &spec, bool counter_based = false)
       : Operator<Backend>(spec),
-        rng_(spec.GetArgument<int64_t>("seed"), RngsCount()),
-        backend_data_(spec.GetArgument<int64_t>("seed"), RngsCount()) {}
+        seed_(spec.GetArgument<int64_t>("seed")),
+        counter_based_(counter_based),
+        rng_(seed_, counter_based_ ? 1 : RngsCount()),
+        backend_data_(seed_, RngsCount(), counter_based_) {}
+
+  /**
+   * @brief Moves the counter-based generators to the next iteration; called once per iteration
+   */
+  void AdvanceCounterRng() {
+    iteration_ = next_iteration_++;
+  }
+
+  /**
+   * @brief Returns the counter-based generator of the sample in the current iteration,
+   *        positioned at the element `element_idx`.
+   */
+  Philox4x32_10 CounterRng(int sample_idx, int64_t element_idx = 0) const {
+    return Philox4x32_10(seed_, CounterRngSubsequence(iteration_, sample_idx),
+                         CounterRngOffset(element_idx));
+  }
 
   using Operator<Backend>::max_batch_size_;
   using Operator<Backend>::spec_;
 
+  uint64_t seed_;
+  bool counter_based_ = false;
+  /// The iteration used by the counter-based generators
+  uint64_t iteration_ = 0;
+  /// The index of the next iteration - the whole checkpointed state in the counter-based mode
+  uint64_t next_iteration_ = 0;
   BatchRNG<std::mt19937_64> rng_;
   OperatorWithRngFields<Backend> backend_data_;
 };
@@ -100,7 +140,7 @@ template <typename Backend, typename Impl, bool IsNoiseGen>
 class RNGBase : public OperatorWithRng<Backend> {
  protected:
   explicit RNGBase(const OpSpec &spec)
-      : OperatorWithRng<Backend>(spec) {}
+      : OperatorWithRng<Backend>(spec, spec.GetArgument<bool>("counter_based_rng")) {}
 
   Impl &This() noexcept { return static_cast<Impl&>(*this); }
   const Impl &This() const noexcept { return static_cast<const Impl&>(*this); }
@@ -163,6 +203,9 @@ class RNGBase : public OperatorWithRng<Backend> {
 
   bool SetupImpl(std::vector<OutputDesc> &output_desc,
                  const Workspace &ws) override {
+    if (counter_based_)
+      this->AdvanceCounterRng();
+
     if (IsNoiseGen)
       dtype_ = ws.Input<Backend>(0).type();
     else if (!spec_.TryGetArgument(dtype_, "dtype"))
@@ -216,6 +259,9 @@ class RNGBase : public OperatorWithRng<Backend> {
   using OperatorWithRng<Backend>::max_batch_size_;
   using OperatorWithRng<Backend>::rng_;
   using OperatorWithRng<Backend>::backend_data_;
+  using OperatorWithRng<Backend>::counter_based_;
+  using OperatorWithRng<Backend>::seed_;
+  using OperatorWithRng<Backend>::iteration_;
 
   DALIDataType dtype_ = DALI_NO_TYPE;
   TensorListShape<> shape_;
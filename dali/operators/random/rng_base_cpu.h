@@ -30,7 +30,7 @@ namespace rng {
 
 template<>
 struct OperatorWithRngFields<CPUBackend> {
-  OperatorWithRngFields(int64_t seed, int nsamples) {}
+  OperatorWithRngFields(int64_t seed, int nsamples, bool counter_based = false) {}
 
   template <typename Dist>
   std::vector<Dist> &dists_cpu() {
@@ -169,16 +169,33 @@ void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(Workspace &ws, CPUBackend)
       p_stride = channel_dim == 0 ? 1 : nchannels;
     }
 
-    if (total_p_count < kThreshold) {
+    auto generate = [=](auto &rng, int64_t p_offset, int64_t p_count) {
+      auto dist = use_default_dist ? Dist() : dists[sample_id];
+      if (independent_channels) {
+        dist_gen_.template gen<T>(out_span, in_span, dist, rng, p_offset, p_count);
+      } else {
+        dist_gen_.template gen_all_channels<T>(out_span, in_span, dist, rng, p_offset,
+                                               p_count, nchannels, c_stride, p_stride);
+      }
+    };
+
+    if (counter_based_) {
+      // Each chunk starts at its own position in the stream of the sample - there's no need
+      // to seed the chunks sequentially.
+      int chunks = total_p_count < kThreshold ? 1 : div_ceil(total_p_count, kChunkSize);
+      for (int c = 0; c < chunks; c++) {
+        int64_t p_offset, p_count;
+        std::tie(p_offset, p_count) = get_chunk<T>(total_p_count, c, chunks);
+        auto chunk_rng = this->CounterRng(sample_id, p_offset);
+        tp.AddWork(
+          [=](int thread_id) mutable {
+            generate(chunk_rng, p_offset, p_count);
+          }, p_count);
+      }
+    } else if (total_p_count < kThreshold) {
       tp.AddWork(
         [=](int thread_id) {
-          auto dist = use_default_dist ? Dist() : dists[sample_id];
-          if (independent_channels) {
-            dist_gen_.template gen<T>(out_span, in_span, dist, rng_[sample_id], 0, total_p_count);
-          } else {
-            dist_gen_.template gen_all_channels<T>(out_span, in_span, dist, rng_[sample_id], 0,
-                                                   total_p_count, nchannels, c_stride, p_stride);
-          }
+          generate(rng_[sample_id], 0, total_p_count);
         }, total_p_count);
     } else {
       int chunks = div_ceil(total_p_count, kChunkSize);
@@ -192,14 +209,7 @@ void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(Workspace &ws, CPUBackend)
           [=](int thread_id) {
             std::seed_seq seq(seed.begin(), seed.end());
             std::mt19937_64 chunk_rng(seq);
-            auto dist = use_default_dist ? Dist() : dists[sample_id];
-            if (independent_channels) {
-              dist_gen_.template gen<T>(out_span, in_span, dist, chunk_rng,
-                                        p_offset, p_count);
-            } else {
-              dist_gen_.template gen_all_channels<T>(out_span, in_span, dist, chunk_rng, p_offset,
-                                                     p_count, nchannels, c_stride, p_stride);
-            }
+            generate(chunk_rng, p_offset, p_count);
           }, p_count);
       }
     }
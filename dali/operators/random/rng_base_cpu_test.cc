@@ -25,7 +25,7 @@ namespace dali {
 class RNGCheckpointingTest : public ::testing::Test {
  protected:
   template<class DataType>
-  void RunOperatorTest(const std::string &name) {
+  void RunOperatorTest(const std::string &name, bool counter_based = false) {
     constexpr int batch_size = 16;
     constexpr int iterations = 10;
 
@@ -34,6 +34,7 @@ class RNGCheckpointingTest : public ::testing::Test {
     for (Pipeline *pipe : {&original_pipe, &restored_pipe}) {
       pipe->AddOperator(
         OpSpec(name)
+        .AddArg("counter_based_rng", counter_based)
         .AddOutput("data_out", "cpu"), "rng_op");
       std::vector<std::pair<string, string>> outputs = {{"data_out", "cpu"}};
       pipe->Build(outputs);
@@ -63,6 +64,12 @@ class RNGCheckpointingTest : public ::testing::Test {
     auto op = original_pipe.GetOperator("rng_op");
     OpCheckpoint cpt("rng_op");
     op->SaveState(cpt, {});
+    if (counter_based) {
+      // the state is small enough to survive serialization unchanged
+      auto data = op->SerializeCheckpoint(cpt);
+      EXPECT_LE(data.size(), 20u);
+      op->DeserializeCheckpoint(cpt, data);
+    }
     restored_pipe.GetOperator("rng_op")->RestoreState(cpt);
 
     // make sure the restored pipeline has the same internal state
@@ -83,4 +90,44 @@ TEST_F(RNGCheckpointingTest, Normal) {
   RunOperatorTest<float>("random__Normal");
 }
 
+TEST_F(RNGCheckpointingTest, CounterBasedCoinFlip) {
+  RunOperatorTest<int32_t>("random__CoinFlip", true);
+}
+
+TEST_F(RNGCheckpointingTest, CounterBasedNormal) {
+  RunOperatorTest<float>("random__Normal", true);
+}
+
+TEST(CounterBasedRNGTest, IndependentOfBatchSize) {
+  // The stream of a sample depends only on the seed, the iteration and the sample index
+  auto run = [](int batch_size, int iterations) {
+    Pipeline pipe(batch_size, 1, 0);
+    pipe.AddOperator(
+      OpSpec("random__Uniform")
+      .AddArg("counter_based_rng", true)
+      .AddArg("seed", int64_t(123))
+      .AddArg("shape", std::vector<int>{1000})
+      .AddOutput("data_out", "cpu"), "rng_op");
+    std::vector<std::pair<string, string>> outputs = {{"data_out", "cpu"}};
+    pipe.Build(outputs);
+    Workspace ws;
+    std::vector<std::vector<float>> samples;
+    for (int i = 0; i < iterations; i++) {
+      pipe.Run();
+      pipe.Outputs(&ws);
+      auto &out = ws.Output<CPUBackend>(0);
+      for (int s = 0; s < 4; s++) {
+        const float *data = out.tensor<float>(s);
+        samples.emplace_back(data, data + 1000);
+      }
+    }
+    return samples;
+  };
+  auto a = run(4, 3);
+  auto b = run(16, 3);
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a[0], a[1]);
+  EXPECT_NE(a[0], a[4]);
+}
+
 }  // namespace dali
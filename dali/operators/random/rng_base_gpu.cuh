@@ -32,11 +32,11 @@ namespace {  // NOLINT
 template <bool value>
 using bool_const = std::integral_constant<bool, value>;
 
-template <typename T, typename Dist>
+template <typename T, typename Dist, typename State>
 __device__ __inline__ void Generate(const SampleDesc &sample,
                                     const BlockDesc &block,
                                     Dist& dist,
-                                    curandState* __restrict__ rng,
+                                    State* __restrict__ rng,
                                     bool_const<true>,     // is_noise_gen
                                     bool_const<true>) {   // is_per_channel
   auto out = static_cast<T*>(sample.output);
@@ -48,11 +48,11 @@ __device__ __inline__ void Generate(const SampleDesc &sample,
   }
 }
 
-template <typename T, typename Dist>
+template <typename T, typename Dist, typename State>
 __device__ __inline__ void Generate(const SampleDesc &sample,
                                     const BlockDesc &block,
                                     Dist& dist,
-                                    curandState* __restrict__ rng,
+                                    State* __restrict__ rng,
                                     bool_const<true>,     // is_noise_gen
                                     bool_const<false>) {  // is_per_channel
   auto out = static_cast<T*>(sample.output);
@@ -69,11 +69,11 @@ __device__ __inline__ void Generate(const SampleDesc &sample,
   }
 }
 
-template <typename T, typename Dist>
+template <typename T, typename Dist, typename State>
 __device__ __inline__ void Generate(const SampleDesc &sample,
                                     const BlockDesc &block,
                                     Dist& dist,
-                                    curandState* __restrict__ rng,
+                                    State* __restrict__ rng,
                                     bool_const<false>,     // is_noise_gen
                                     bool_const<true>) {    // is_per_channel
   auto out = static_cast<T*>(sample.output);
@@ -84,11 +84,11 @@ __device__ __inline__ void Generate(const SampleDesc &sample,
   }
 }
 
-template <typename T, typename Dist>
+template <typename T, typename Dist, typename State>
 __device__ __inline__ void Generate(const SampleDesc &sample,
                                     const BlockDesc &block,
                                     Dist& dist,
-                                    curandState* __restrict__ rng,
+                                    State* __restrict__ rng,
                                     bool_const<false>,      // is_noise_gen
                                     bool_const<false>) {    // is_per_channel
   auto out = static_cast<T*>(sample.output);
@@ -122,6 +122,27 @@ __global__ void RNGKernel(SampleDesc* __restrict__ sample_descs,
   }
 }
 
+template <typename T, typename Dist, bool DefaultDist, bool IsNoiseGen, bool IsPerChannel>
+__global__ void CounterRNGKernel(SampleDesc* __restrict__ sample_descs,
+                                 BlockDesc* __restrict__ block_descs,
+                                 uint64_t seed, uint64_t iteration,
+                                 const Dist* __restrict__ dists, int nblocks) {
+  int blk_stride = blockDim.y * gridDim.y;
+  int blk = blockIdx.y * blockDim.y + threadIdx.y;
+  for (; blk < nblocks; blk += blk_stride) {
+    auto block = block_descs[blk];
+    auto sample = sample_descs[block.sample_idx];
+    Dist dist = DefaultDist ? Dist() : dists[block.sample_idx];
+    // The stream of the thread starts at the first element it generates - the result
+    // doesn't depend on the previous iterations nor on the other samples.
+    curandStatePhilox4_32_10_t rng;
+    curand_init(seed, CounterRngSubsequence(iteration, block.sample_idx),
+                CounterRngOffset(block.p_offset + threadIdx.x), &rng);
+    Generate<T, Dist>(sample, block, dist, &rng,
+                      bool_const<IsNoiseGen>(), bool_const<IsPerChannel>());
+  }
+}
+
 }  // namespace
 
 template <typename Backend, typename Impl, bool IsNoiseGen>
@@ -131,7 +152,7 @@ void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(Workspace &ws, GPUBackend)
   auto &output = ws.Output<GPUBackend>(0);
   auto rngs = backend_data_.randomizer_.states();
   int block_sz = backend_data_.block_size_;
-  int max_nblocks = backend_data_.max_blocks_;
+  int64_t max_nblocks = backend_data_.max_blocks_;
   int blockdesc_count = -1;
   TensorListView<StorageGPU, const T> in_view;
   auto out_view = view<T>(output);
@@ -161,10 +182,20 @@ void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(Workspace &ws, GPUBackend)
   samples_cpu.resize(nsamples);
   SetupSampleDescs(samples_cpu.data(), out_view, in_view, channel_dim);
 
+  // The counter-based generators use a fixed partitioning of the samples, so that the streams
+  // of the threads (and the results) don't depend on the rest of the batch.
+  int64_t blockdesc_sz = block_sz;
+  if (counter_based_) {
+    blockdesc_sz = kCounterRngBlockDescSize;
+    max_nblocks = 0;
+    for (int s = 0; s < nsamples; s++)
+      max_nblocks += div_ceil(out_view.shape.tensor_size(s), blockdesc_sz);
+  }
+
   auto &blocks_cpu = backend_data_.block_descs_cpu_;
   blocks_cpu.resize(max_nblocks);
   blockdesc_count =
-      SetupBlockDescs(blocks_cpu.data(), block_sz, max_nblocks, out_view.shape, channel_dim);
+      SetupBlockDescs(blocks_cpu.data(), blockdesc_sz, max_nblocks, out_view.shape, channel_dim);
   if (blockdesc_count == 0) {
     return;
   }
@@ -198,13 +229,19 @@ void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(Workspace &ws, GPUBackend)
   blockDim.x = std::min<int>(block_sz, blockdesc_max_sz);
   blockDim.y = std::min<int>(blockdesc_count, std::max<int>(1, block_sz / blockDim.x));
   gridDim.x = 1;
-  gridDim.y = div_ceil(blockdesc_count, blockDim.y);
+  gridDim.y = std::min<int>(div_ceil(blockdesc_count, blockDim.y), backend_data_.max_blocks_);
 
   VALUE_SWITCH(use_default_dist ? 1 : 0, DefaultDist, (false, true), (
     VALUE_SWITCH(independent_channels ? 1 : 0, IsPerChannel, (false, true), (
-      RNGKernel<T, Dist, DefaultDist, IsNoiseGen, IsPerChannel>
-        <<<gridDim, blockDim, 0, ws.stream()>>>(samples_gpu, blocks_gpu,
-                                                rngs, dists_gpu, blockdesc_count);
+      if (counter_based_) {
+        CounterRNGKernel<T, Dist, DefaultDist, IsNoiseGen, IsPerChannel>
+          <<<gridDim, blockDim, 0, ws.stream()>>>(samples_gpu, blocks_gpu, seed_, iteration_,
+                                                  dists_gpu, blockdesc_count);
+      } else {
+        RNGKernel<T, Dist, DefaultDist, IsNoiseGen, IsPerChannel>
+          <<<gridDim, blockDim, 0, ws.stream()>>>(samples_gpu, blocks_gpu,
+                                                  rngs, dists_gpu, blockdesc_count);
+      }
     ), ());  // NOLINT
   ), ());  // NOLINT
   CUDA_CALL(cudaGetLastError());
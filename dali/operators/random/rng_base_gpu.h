@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -43,16 +43,30 @@ struct BlockDesc {
   int64_t p_count;
 };
 
+/**
+ * @brief The number of elements in a block of work with the counter-based generators
+ *
+ * The partitioning doesn't depend on the batch, which makes the streams of the threads depend
+ * only on the sample and the position within it.
+ */
+constexpr int64_t kCounterRngBlockDescSize = 1 << 14;
+
 template<>
 struct OperatorWithRngFields<GPUBackend> {
+  /**
+   * @param counter_based If true, the generator states are not allocated nor initialized - the
+   *                      counter-based generators are created in the kernel.
+   */
   OperatorWithRngFields<GPUBackend>(int64_t seed, int max_batch_size,
+                                        bool counter_based = false,
                                         int64_t static_sample_size = -1)
       : block_size_(static_sample_size < 0 ? 256 : std::min<int64_t>(static_sample_size, 256)),
         max_blocks_(static_sample_size < 0 ?
                         1024 :
                         std::min<int64_t>(
                             max_batch_size * div_ceil(static_sample_size, block_size_), 1024)),
-        randomizer_(seed, block_size_ * max_blocks_) {
+        randomizer_(counter_based ? curand_states(0) : curand_states(seed,
+                                                                     block_size_ * max_blocks_)) {
     sample_descs_cpu_.resize(max_batch_size);
     block_descs_cpu_.resize(max_blocks_);
   }
@@ -35,7 +35,7 @@ template <typename Rng>
 class RngCheckpointUtils<CPUBackend, BatchRNG<Rng>> {
  public:
   static void SaveState(OpCheckpoint &cpt, AccessOrder order, const BatchRNG<Rng> &rng) {
-    cpt.MutableCheckpointState() = rng;
+    cpt.UpdateCheckpointState(rng);
   }
 
   static void RestoreState(const OpCheckpoint &cpt, BatchRNG<Rng> &rng) {
@@ -63,7 +63,14 @@ class RngCheckpointUtils<GPUBackend, curand_states> {
  public:
   static void SaveState(OpCheckpoint &cpt, AccessOrder order, const curand_states &rng) {
     cpt.SetOrder(order);
-    cpt.MutableCheckpointState() = rng.copy(order);
+    auto &state = cpt.MutableCheckpointState();
+    auto *prev = std::any_cast<curand_states>(&state);
+    // The states are shared by the copies of the checkpoint - reuse the buffer only if this
+    // checkpoint is its sole owner.
+    if (prev && prev->length() == rng.length() && prev->unique())
+      rng.copy_to(*prev, order);
+    else
+      state = rng.copy(order);
     // The pipeline will perform host synchronization before serializing the checkpoints.
     // TODO(skarpinski) Move synchronization out from pipeline's GetCheckpoint.
   }
@@ -97,6 +104,29 @@ class RngCheckpointUtils<GPUBackend, curand_states> {
   }
 };
 
+/**
+ * @brief Checkpointing of the counter-based generators - the state is just the iteration index.
+ */
+template <typename Backend>
+class RngCheckpointUtils<Backend, uint64_t> {
+ public:
+  static void SaveState(OpCheckpoint &cpt, AccessOrder order, uint64_t iteration) {
+    cpt.MutableCheckpointState() = iteration;
+  }
+
+  static void RestoreState(const OpCheckpoint &cpt, uint64_t &iteration) {
+    iteration = cpt.CheckpointState<uint64_t>();
+  }
+
+  static std::string SerializeCheckpoint(const OpCheckpoint &cpt) {
+    return std::to_string(cpt.CheckpointState<uint64_t>());
+  }
+
+  static void DeserializeCheckpoint(OpCheckpoint &cpt, const std::string &data) {
+    cpt.MutableCheckpointState() = static_cast<uint64_t>(std::stoull(data));
+  }
+};
+
 }  // namespace rng
 }  // namespace dali
 
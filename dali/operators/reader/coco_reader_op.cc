@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -164,6 +164,15 @@ preprocessed COCO annotations.)code",
     std::string())
   .DeprecateArgInFavorOf("dump_meta_files_path",
                          "save_preprocessed_annotations_dir")  // deprecated since 0.28dev
+  .AddOptionalArg<string>("annotations_cache_dir",
+      R"code(A directory where the preprocessed annotations are cached.
+
+When set, the annotations preprocessed from ``annotations_file`` are saved in this directory
+and reused by the subsequent runs (and by other readers, for example, the other ranks on the same
+node) instead of parsing the JSON file again. The cached annotations are used only if the
+annotations file was not modified and the arguments which affect the preprocessing are the same.
+
+This argument is mutually exclusive with ``preprocessed_annotations``.)code", nullptr)
   .AdditionalOutputsFn(COCOReaderOutputFn)
   .AddParent("LoaderBase");
 
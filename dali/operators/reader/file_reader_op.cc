@@ -98,6 +98,19 @@ This argument is mutually exclusive with ``files``.)", nullptr)
 
 ``stick_to_shard`` and ``random_shuffle`` cannot be used when this argument is set to True.)",
       false)
+.AddOptionalArg("elastic_sharding",
+      R"(If set to True, the shards take the samples of the dataset in turns, instead of reading
+contiguous parts of it.
+
+The checkpoint then records the position in the epoch reached by all the shards, so it can be
+restored with a different ``num_shards`` - the epoch is resumed at that position, without
+repeating or skipping samples. Combined with ``shuffle_after_epoch``, the order of the whole
+dataset is shuffled in every epoch.
+
+Restoring assumes that all the shards consumed the same number of samples, as in synchronous
+data-parallel training. ``stick_to_shard`` and ``random_shuffle`` cannot be used when this
+argument is set to True.)",
+      false)
   .AddOptionalArg<vector<string>>("files", R"(A list of file paths to read the data from.
 
 If ``file_root`` is provided, the paths are treated as being relative to it.
@@ -120,6 +133,35 @@ list of sub-directories under ``file_root``.
 This argument is ignored when file paths are taken from ``file_list`` or ``files``.)", nullptr)
   .AddOptionalArg<bool>("case_sensitive_filter", R"(If set to True, the filter will be matched
 case-sensitively, otherwise case-insensitively.)", false)
+  .AddOptionalArg("file_discovery_threads",
+      R"(The number of threads used to list the sub-directories of ``file_root``.
+
+Listing the sub-directories (or S3 prefixes) concurrently shortens the start-up of the reader
+for datasets with many files.
+
+This argument is ignored when file paths are taken from ``file_list`` or ``files``.)", 1)
+  .AddOptionalArg<string>("file_discovery_cache_dir",
+      R"(A directory where the list of files found under ``file_root`` is stored.
+
+When set, the list is saved after the first traversal and reused by subsequent runs (and by
+other readers with the same ``file_root`` and filters), as long as the modification times of
+``file_root`` and its sub-directories didn't change. Not supported for S3.
+
+This argument is ignored when file paths are taken from ``file_list`` or ``files``.)", nullptr)
+  .AddOptionalArg("use_io_uring",
+      R"(If set to True, the files are read with io_uring - the reads of the whole batch are
+submitted to the kernel at once, which reduces the number of system calls and increases the
+I/O parallelism on fast storage.
+
+If io_uring is not available in the system, the reader falls back to regular reads.
+Mutually exclusive with ``dont_use_mmap=False``.)", false)
+  .AddOptionalArg("peek_image_shape",
+      R"(If set to True, the headers of the images are parsed when the files are read, in the
+prefetching thread, and the shapes are passed to the image decoder with the data.
+
+The decoder then doesn't need to parse the headers before allocating its outputs, and the
+parsing overlaps with the processing of the previous batches. The files, which are not images
+in a format supported by the decoder, are passed without the shape.)", false)
   .AddParent("LoaderBase");
 
 
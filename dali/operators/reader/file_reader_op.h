@@ -20,7 +20,9 @@
 #include <utility>
 #include <vector>
 
+#include "dali/core/nvtx.h"
 #include "dali/core/small_vector.h"
+#include "dali/operators/imgcodec/peek_image_shape.h"
 #include "dali/operators/reader/loader/file_label_loader.h"
 #include "dali/operators/reader/reader_op.h"
 
@@ -33,12 +35,22 @@ class FileReader : public DataReader<CPUBackend, ImageLabelWrapper, ImageLabelWr
     bool shuffle_after_epoch = spec.GetArgument<bool>("shuffle_after_epoch");
     loader_ = InitLoader<FileLabelLoader>(spec, shuffle_after_epoch);
     this->SetInitialSnapshot();
+    if (spec.GetArgument<bool>("peek_image_shape"))
+      peek_instance_ = imgcodec::CreatePeekImageShapeInstance();
   }
 
   bool HasContiguousOutputs() const override {
     return true;
   }
 
+  void Prefetch() override {
+    DataReader<CPUBackend, ImageLabelWrapper, ImageLabelWrapper, true>::Prefetch();
+    // complete the reads batched by the loader before the batch is handed to the consumer
+    static_cast<FileLabelLoader *>(loader_.get())->SubmitPendingReads();
+    if (peek_instance_)
+      PeekImageShapes();
+  }
+
   bool SetupImpl(std::vector<OutputDesc>& output_desc, const Workspace& ws) override {
     // If necessary start prefetching thread and wait for a consumable batch
     DataReader<CPUBackend, ImageLabelWrapper, ImageLabelWrapper, true>::SetupImpl(output_desc, ws);
@@ -95,6 +107,7 @@ class FileReader : public DataReader<CPUBackend, ImageLabelWrapper, ImageLabelWr
                       sample.image.size());
         }
         file_output.SetSourceInfo(sample_idx, sample.image.GetSourceInfo());
+        file_output.SetEncodedImageInfo(sample_idx, sample.image.GetEncodedImageInfo());
         label_output.mutable_tensor<int>(sample_idx)[0] = sample.label;
 
         // Now copy the sample we read to any repeated samples
@@ -105,6 +118,8 @@ class FileReader : public DataReader<CPUBackend, ImageLabelWrapper, ImageLabelWr
                       file_output.shape().tensor_size(sample_idx));
           file_output.SetSourceInfo(repeated_sample_idx,
                                     file_output.GetMeta(sample_idx).GetSourceInfo());
+          file_output.SetEncodedImageInfo(repeated_sample_idx,
+                                          file_output.GetMeta(sample_idx).GetEncodedImageInfo());
           label_output.mutable_tensor<int>(repeated_sample_idx)[0] =
               label_output.mutable_tensor<int>(sample_idx)[0];
         }
@@ -115,6 +130,34 @@ class FileReader : public DataReader<CPUBackend, ImageLabelWrapper, ImageLabelWr
 
  protected:
   USE_READER_OPERATOR_MEMBERS(CPUBackend, ImageLabelWrapper, ImageLabelWrapper, true);
+
+ private:
+  /**
+   * @brief Parses the headers of the images in the prefetched batch and attaches the shapes
+   *        to the samples, so that the decoder doesn't have to parse them in its Setup.
+   *
+   * Runs in the prefetch thread, overlapping with the processing of the previous batches.
+   */
+  void PeekImageShapes() {
+    DomainTimeRange tr("[DALI][FileReader] Peek image shapes", DomainTimeRange::kRed);
+    for (auto &sample : prefetched_batch_queue_[this->curr_batch_producer_]) {
+      auto &image = sample->image;
+      EncodedImageInfo info;
+      // The files which are not read yet (remote files) and the skipped samples are omitted
+      if (sample->file_stream == nullptr && image.size() > 0) {
+        try {
+          auto img_info = imgcodec::PeekImageInfo(peek_instance_, image.raw_data(), image.size());
+          info.shape = img_info.shape;
+          info.rotation = img_info.orientation.rotated;
+        } catch (const std::exception &) {
+          // Not an image, or an unsupported format - it's up to the consumer to handle it
+        }
+      }
+      image.SetEncodedImageInfo(info);
+    }
+  }
+
+  imgcodec::NvImageCodecInstance peek_instance_;
 };
 
 }  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <numeric>
 #include <string>
 
 #include "dali/core/backend_tags.h"
@@ -98,6 +99,12 @@ void FitsReaderCPU::RunImpl(Workspace &ws) {
     auto &output = ws.Output<CPUBackend>(output_idx);
     for (int file_idx = 0; file_idx < num_samples; file_idx++) {
       auto &sample = GetSample(file_idx);
+      const auto &header = sample.header[output_idx];
+      if (header.rice_tiles) {
+        AddDecodeTasks(ws, static_cast<uint8_t *>(output.raw_mutable_tensor(file_idx)), sample,
+                       output_idx, threaded);
+        continue;
+      }
       ThreadPool::Work copy_task = [output_idx = output_idx, data_idx = file_idx, &output,
                                     &sample](int) {
         std::memcpy(output.raw_mutable_tensor(data_idx), sample.data[output_idx].raw_data(),
@@ -115,4 +122,42 @@ void FitsReaderCPU::RunImpl(Workspace &ws) {
   }
 }
 
+void FitsReaderCPU::AddDecodeTasks(Workspace &ws, uint8_t *out, const FitsFileWrapper &sample,
+                                   int output_idx, bool threaded) {
+  // The tiles are usually small (by default, a single row), so they're grouped into tasks
+  constexpr int64_t kMinTaskBytes = 1 << 18;
+  const auto &header = sample.header[output_idx];
+  const auto &tile_offset = sample.tile_offset[output_idx];
+  const auto &tile_size = sample.tile_size[output_idx];
+  const uint8_t *in = static_cast<const uint8_t *>(sample.data[output_idx].raw_data());
+  int64_t ntiles = tile_size.size();
+  int64_t bytepix = header.bytepix;
+  int blocksize = header.blocksize;
+
+  int64_t total_size = std::accumulate(tile_size.begin(), tile_size.end(), int64_t(0));
+  DALI_ENFORCE(total_size * bytepix == static_cast<int64_t>(header.nbytes()),
+               make_string("The tiles of \"", sample.filename, "\" don't match the image size."));
+
+  int64_t out_offset = 0;
+  for (int64_t begin = 0; begin < ntiles;) {
+    int64_t end = begin, task_offset = out_offset;
+    while (end < ntiles && (out_offset - task_offset) * bytepix < kMinTaskBytes)
+      out_offset += tile_size[end++];
+    ThreadPool::Work decode_task = [=, &tile_offset, &tile_size](int) {
+      uint8_t *tile_out = out + task_offset * bytepix;
+      for (int64_t t = begin; t < end; t++) {
+        fits::DecodeRiceTile(tile_out, tile_size[t], in + tile_offset[t],
+                             tile_offset[t + 1] - tile_offset[t], bytepix, blocksize);
+        tile_out += tile_size[t] * bytepix;
+      }
+    };
+    if (threaded) {
+      ws.GetThreadPool().AddWork(std::move(decode_task), (out_offset - task_offset) * bytepix);
+    } else {
+      decode_task(0);
+    }
+    begin = end;
+  }
+}
+
 }  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -111,6 +111,10 @@ class FitsReaderCPU : public FitsReader<CPUBackend, FitsFileWrapper> {
   void RunImpl(Workspace& ws) override;
   using Operator<CPUBackend>::RunImpl;
 
+  /** @brief Decodes the Rice-coded tiles of the sample into `out`, in the thread pool */
+  void AddDecodeTasks(Workspace& ws, uint8_t* out, const FitsFileWrapper& sample, int output_idx,
+                      bool threaded);
+
  private:
   USE_READER_OPERATOR_MEMBERS(CPUBackend, FitsFileWrapper, FitsFileWrapper, true);
 };
@@ -1,4 +1,4 @@
-// Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -259,6 +259,17 @@ void GDSStagingEngine::copy_to_client(void *client_buffer, size_t nbytes,
     commit_no_lock();
 }
 
+void GDSStagingEngine::copy_to_client(span<const CopyRange> ranges,
+                                      GDSStagingBuffer &&staging_buffer) {
+  std::lock_guard g(lock_);
+  assert(staging_buffer.at(0) != nullptr && "Staging buffer already released.");
+  for (auto &r : ranges)
+    copy_engine_.AddCopy(r.client_buffer, staging_buffer.at(r.staging_offset), r.nbytes);
+  unscheduled_.push_back(staging_buffer.release());
+  if (unscheduled_.size() > static_cast<size_t>(commit_after_))
+    commit_no_lock();
+}
+
 void GDSStagingEngine::return_ready() {
   cudaError_t ret = cudaEventQuery(ready_);
   if (ret == cudaErrorNotReady)
@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -23,6 +23,7 @@
 #include <vector>
 #include "dali/core/mm/memory.h"
 #include "dali/core/int_literals.h"
+#include "dali/core/span.h"
 #include "dali/core/spinlock.h"
 #include "dali/core/cuda_event.h"
 #include "dali/core/cuda_event_pool.h"
@@ -147,6 +148,19 @@ class DLL_PUBLIC GDSStagingEngine {
   void copy_to_client(void *client_buffer, size_t nbytes,
                       GDSStagingBuffer &&staging_buffer, ptrdiff_t staging_offset = 0);
 
+  struct CopyRange {
+    void *client_buffer;
+    size_t nbytes;
+    ptrdiff_t staging_offset;
+  };
+
+  /**
+   * @brief Enqueues copies of several parts of a staging buffer to client-provided buffers.
+   *
+   * The staging buffer is returned to the pool when all the copies complete.
+   */
+  void copy_to_client(span<const CopyRange> ranges, GDSStagingBuffer &&staging_buffer);
+
   /**
    * @brief Immediately returns an unused buffer to the staging engine's buffer pool.
    */
@@ -159,6 +173,8 @@ class DLL_PUBLIC GDSStagingEngine {
 
   size_t chunk_size() const { return chunk_size_; }
 
+  int max_buffers() const { return max_buffers_; }
+
  private:
   int allocate_buffers();
   void wait_buffers(std::unique_lock<std::mutex> &lock);
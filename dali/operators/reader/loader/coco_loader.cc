@@ -12,14 +12,19 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <sys/stat.h>
+#include <unistd.h>
+#include <filesystem>
 #include <list>
 #include <map>
 #include <unordered_map>
 #include <iomanip>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 #include "dali/operators/reader/loader/coco_loader.h"
+#include "dali/operators/reader/loader/filesystem.h"
 #include "dali/pipeline/util/lookahead_parser.h"
 
 namespace dali {
@@ -387,7 +392,7 @@ void ParseJsonFile(const OpSpec &spec, std::vector<detail::ImageInfo> &image_inf
   f.seekg(0, std::ios::end);
   size_t file_size = f.tellg();
   std::unique_ptr<char, std::function<void(char*)>> buff(
-    new char[file_size + 1],
+    new char[file_size + 1 + detail::kJsonPadding],
     [](char* data) {delete [] data;});
   f.seekg(0, std::ios::beg);
   buff.get()[file_size] = '\0';
@@ -415,6 +420,42 @@ void ParseJsonFile(const OpSpec &spec, std::vector<detail::ImageInfo> &image_inf
   }
 }
 
+/**
+ * @brief Describes the annotations file and the arguments which affect the preprocessing, so
+ *        that the cached annotations are reused only when parsing the file would give the same.
+ *
+ * The file is identified by its path, size and modification time - hashing the contents would
+ * take a good part of the time that the cache is meant to save.
+ */
+std::string AnnotationsCacheKey(const OpSpec &spec, const std::vector<std::string> &images,
+                                bool polygon_masks, bool pixelwise_masks, bool image_ids) {
+  const auto annotations_file = spec.GetArgument<string>("annotations_file");
+  struct stat s;
+  DALI_ENFORCE(stat(annotations_file.c_str(), &s) == 0,
+               "Could not open JSON annotations file: \"" + annotations_file + "\"");
+  std::error_code ec;
+  auto abs_path = std::filesystem::absolute(annotations_file, ec);
+  size_t images_hash = images.size();
+  for (auto &image : images)
+    images_hash = images_hash * 31 + std::hash<std::string>()(image);
+
+  std::stringstream ss;
+  ss << (ec ? annotations_file : abs_path.string()) << " size=" << s.st_size
+     << " mtime=" << s.st_mtim.tv_sec << "." << s.st_mtim.tv_nsec
+     << " skip_empty=" << spec.GetArgument<bool>("skip_empty")
+     << " ratio=" << spec.GetArgument<bool>("ratio")
+     << " ltrb=" << spec.GetArgument<bool>("ltrb")
+     << " include_iscrowd=" << spec.GetArgument<bool>("include_iscrowd")
+     << " avoid_class_remapping=" << spec.GetArgument<bool>("avoid_class_remapping")
+     << " size_threshold=" << std::setprecision(9) << spec.GetArgument<float>("size_threshold")
+     << " polygon_masks=" << polygon_masks << " pixelwise_masks=" << pixelwise_masks
+     << " image_ids=" << image_ids
+     << " images=" << images.size() << ":" << std::hex << images_hash;
+  return ss.str();
+}
+
+constexpr const char kCacheKeyFile[] = "/key.txt";
+
 }  // namespace detail
 
 void CocoLoader::SavePreprocessedAnnotations(
@@ -449,11 +490,7 @@ void CocoLoader::SavePreprocessedAnnotations(
   }
 }
 
-void CocoLoader::ParsePreprocessedAnnotations() {
-  assert(HasPreprocessedAnnotations(spec_));
-  const auto path = spec_.HasArgument("meta_files_path")
-      ? spec_.GetArgument<string>("meta_files_path")
-      : spec_.GetArgument<string>("preprocessed_annotations");
+void CocoLoader::ParsePreprocessedAnnotations(const std::string &path) {
   using detail::LoadFromFile;
   LoadFromFile(offsets_, path + "/offsets.dat");
   LoadFromFile(boxes_, path + "/boxes.dat");
@@ -643,4 +680,51 @@ void CocoLoader::ParseJsonAnnotations() {
   }
 }
 
+void CocoLoader::ParseCachedJsonAnnotations() {
+  auto key = detail::AnnotationsCacheKey(spec_, images_, output_polygon_masks_,
+                                         output_pixelwise_masks_, output_image_ids_);
+  std::stringstream name;
+  name << "dali_coco_" << std::hex << std::hash<std::string>()(key);
+  auto path = filesystem::join_path(annotations_cache_dir_, name.str());
+
+  std::ifstream key_file(path + detail::kCacheKeyFile);
+  std::string cached_key;
+  if (key_file.is_open() && std::getline(key_file, cached_key) && cached_key == key) {
+    LOG_LINE << "reading the preprocessed COCO annotations from " << path << "\n";
+    ParsePreprocessedAnnotations(path);
+    images_.clear();
+    return;
+  }
+
+  ParseJsonAnnotations();
+  if (SizeImpl() == 0)
+    return;
+
+  // write to a temporary directory and rename it, so that concurrent readers (e.g. other ranks
+  // starting at the same time) never see partially written annotations
+  std::string tmp_path = make_string(path, ".", getpid(), ".tmp");
+  std::error_code ec;
+  std::filesystem::create_directories(tmp_path, ec);
+  if (ec) {
+    DALI_WARN(make_string("Cannot write the COCO annotations cache: ", tmp_path));
+    return;
+  }
+  try {
+    SavePreprocessedAnnotations(tmp_path, file_label_entries_);
+    std::ofstream f(tmp_path + detail::kCacheKeyFile);
+    f << key << "\n";
+    DALI_ENFORCE(f.good(), make_string("Error writing to path: ", tmp_path));
+  } catch (const std::exception &e) {
+    DALI_WARN(make_string("Failed to write the COCO annotations cache: ", e.what()));
+    std::filesystem::remove_all(tmp_path, ec);
+    return;
+  }
+  std::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    // most likely, another reader has just saved the same annotations - or, in the unlikely
+    // case of a hash collision, different ones, which are then simply not cached
+    std::filesystem::remove_all(tmp_path, ec);
+  }
+}
+
 }  // namespace dali
@@ -105,7 +105,8 @@ class DLL_PUBLIC CocoLoader : public FileLabelLoaderBase<true> {
         "Either ``annotations_file`` or ``preprocessed_annotations`` must be provided");
     if (has_preprocessed_annotations_) {
       for (const char* arg_name : {"annotations_file", "skip_empty", "ratio", "ltrb", "images",
-                                   "size_threshold", "dump_meta_files", "dump_meta_files_path"}) {
+                                   "size_threshold", "dump_meta_files", "dump_meta_files_path",
+                                   "annotations_cache_dir"}) {
         if (spec.HasArgument(arg_name))
           DALI_FAIL(make_string("When reading data from preprocessed annotation files, \"",
                                 arg_name, "\" is not supported."));
@@ -113,6 +114,7 @@ class DLL_PUBLIC CocoLoader : public FileLabelLoaderBase<true> {
     }
 
     spec.TryGetRepeatedArgument(images_, "images");
+    spec.TryGetArgument(annotations_cache_dir_, "annotations_cache_dir");
     output_polygon_masks_ = OutPolygonMasksEnabled(spec);
     output_pixelwise_masks_ = OutPixelwiseMasksEnabled(spec);
     output_image_ids_ = OutImageIdsEnabled(spec);
@@ -177,7 +179,11 @@ class DLL_PUBLIC CocoLoader : public FileLabelLoaderBase<true> {
  protected:
   void PrepareMetadataImpl() override {
     if (has_preprocessed_annotations_) {
-      ParsePreprocessedAnnotations();
+      ParsePreprocessedAnnotations(spec_.HasArgument("meta_files_path")
+          ? spec_.GetArgument<string>("meta_files_path")
+          : spec_.GetArgument<string>("preprocessed_annotations"));
+    } else if (!annotations_cache_dir_.empty()) {
+      ParseCachedJsonAnnotations();
     } else {
       ParseJsonAnnotations();
     }
@@ -197,10 +203,16 @@ class DLL_PUBLIC CocoLoader : public FileLabelLoaderBase<true> {
     Reset(true);
   }
 
-  void ParsePreprocessedAnnotations();
+  void ParsePreprocessedAnnotations(const std::string &path);
 
   void ParseJsonAnnotations();
 
+  /**
+   * @brief Reads the annotations preprocessed earlier from `annotations_cache_dir_`, if they
+   *        are still valid; otherwise, parses the JSON file and stores the result there.
+   */
+  void ParseCachedJsonAnnotations();
+
   void SavePreprocessedAnnotations(
     const std::string &path, const std::vector<FileLabelEntry> &image_id_pairs);
 
@@ -236,6 +248,7 @@ class DLL_PUBLIC CocoLoader : public FileLabelLoaderBase<true> {
   bool has_preprocessed_annotations_ = false;
 
   std::vector<std::string> images_;
+  std::string annotations_cache_dir_;
 };
 
 }  // namespace dali
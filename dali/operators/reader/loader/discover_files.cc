@@ -18,10 +18,16 @@
 #include <fnmatch.h>
 #include <glob.h>
 #include <sys/stat.h>
+#include <unistd.h>
 #include <algorithm>
+#include <cstdio>
 #include <cstring>
+#include <ctime>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <optional>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -30,6 +36,7 @@
 #include "dali/core/error_handling.h"
 #include "dali/operators/reader/loader/filesystem.h"
 #include "dali/operators/reader/loader/utils.h"
+#include "dali/pipeline/util/thread_pool.h"
 #if AWSSDK_ENABLED
 #include "dali/operators/reader/loader/discover_files_s3.h"
 #endif
@@ -110,6 +117,149 @@ std::vector<std::string> list_files(const std::string &parent_dir,
   return files;
 }
 
+namespace detail {
+
+void discovery_parallel_for(int n, int num_threads, const std::function<void(int)> &func) {
+  num_threads = std::min(num_threads, n);
+  if (num_threads <= 1) {
+    for (int i = 0; i < n; i++)
+      func(i);
+    return;
+  }
+  ThreadPool tp(num_threads, CPU_ONLY_DEVICE_ID, false, "File discovery");
+  for (int i = 0; i < n; i++)
+    tp.AddWork([&func, i](int) { func(i); }, -i);
+  tp.RunAll();
+}
+
+}  // namespace detail
+
+namespace {
+
+constexpr const char kManifestHeader[] = "DALI file list v1";
+constexpr int64_t kRacyTimeSec = 2;
+
+struct DirTime {
+  int64_t sec = -1, nsec = -1;
+
+  bool operator==(const DirTime &other) const {
+    return sec == other.sec && nsec == other.nsec;
+  }
+};
+
+DirTime dir_mtime(const std::string &path) {
+  struct stat s;
+  if (stat(path.c_str(), &s) != 0)
+    return {};
+  return {static_cast<int64_t>(s.st_mtim.tv_sec), static_cast<int64_t>(s.st_mtim.tv_nsec)};
+}
+
+/**
+ * @brief Describes the discovery request, so that a manifest is reused only for the same root
+ *        and the same options.
+ */
+std::string manifest_key(const std::string &file_root, const FileDiscoveryOptions &opts) {
+  std::stringstream ss;
+  std::error_code ec;
+  auto abs_root = std::filesystem::absolute(file_root, ec);
+  ss << (ec ? file_root : abs_root.string()) << " label_from_subdir=" << opts.label_from_subdir
+     << " case_sensitive=" << opts.case_sensitive_filter << " files=";
+  for (auto &f : opts.file_filters)
+    ss << f << ";";
+  ss << " dirs=";
+  for (auto &f : opts.dir_filters)
+    ss << f << ";";
+  return ss.str();
+}
+
+std::string manifest_path(const std::string &cache_dir, const std::string &key) {
+  std::stringstream ss;
+  ss << "dali_file_list_" << std::hex << std::hash<std::string>()(key) << ".txt";
+  return filesystem::join_path(cache_dir, ss.str());
+}
+
+/**
+ * @brief Loads the entries from the manifest, if it exists and is still valid.
+ *
+ * The manifest is valid when the modification times of all the directories visited by
+ * the discovery are unchanged - adding, removing or renaming a file or a subdirectory updates
+ * the modification time of its parent directory.
+ */
+std::optional<std::vector<FileLabelEntry>> load_manifest(const std::string &path,
+                                                         const std::string &file_root,
+                                                         const std::string &key) {
+  std::ifstream f(path);
+  if (!f.is_open())
+    return std::nullopt;
+  std::string line;
+  if (!std::getline(f, line) || line != kManifestHeader)
+    return std::nullopt;
+  if (!std::getline(f, line) || line != key)
+    return std::nullopt;
+  int64_t num_dirs = -1, num_entries = -1;
+  if (!std::getline(f, line) || sscanf(line.c_str(), "%ld %ld", &num_dirs, &num_entries) != 2)
+    return std::nullopt;
+  for (int64_t i = 0; i < num_dirs; i++) {
+    DirTime t;
+    int pos = 0;
+    if (!std::getline(f, line) ||
+        sscanf(line.c_str(), "%ld %ld\t%n", &t.sec, &t.nsec, &pos) != 2 || pos == 0)
+      return std::nullopt;
+    if (!(dir_mtime(filesystem::join_path(file_root, line.substr(pos))) == t))
+      return std::nullopt;
+  }
+  std::vector<FileLabelEntry> entries;
+  entries.reserve(num_entries);
+  for (int64_t i = 0; i < num_entries; i++) {
+    int label = -1, pos = 0;
+    if (!std::getline(f, line) || sscanf(line.c_str(), "%d\t%n", &label, &pos) != 1 || pos == 0)
+      return std::nullopt;
+    entries.push_back({line.substr(pos), label >= 0 ? std::optional<int>{label} : std::nullopt});
+  }
+  return entries;
+}
+
+void save_manifest(const std::string &path, const std::string &key,
+                   const std::vector<std::pair<std::string, DirTime>> &dirs,
+                   const std::vector<FileLabelEntry> &entries) {
+  // A directory modified at about the same time as it was listed could be modified again
+  // without a visible change of its (coarse-grained) modification time - don't trust it.
+  int64_t now = time(nullptr);
+  for (auto &[dir, t] : dirs) {
+    if (t.sec < 0 || t.sec + kRacyTimeSec >= now) {
+      LOG_LINE << "not caching the file list - " << dir << " was modified recently\n";
+      return;
+    }
+  }
+  // write to a temporary file and rename it, so that concurrent readers (e.g. other ranks
+  // starting at the same time) never see a partially written manifest
+  std::string tmp_path = make_string(path, ".", getpid(), ".tmp");
+  {
+    std::ofstream f(tmp_path);
+    if (!f.is_open()) {
+      DALI_WARN(make_string("Cannot write the file list cache: ", tmp_path));
+      return;
+    }
+    f << kManifestHeader << "\n" << key << "\n" << dirs.size() << " " << entries.size() << "\n";
+    for (auto &[dir, t] : dirs)
+      f << t.sec << " " << t.nsec << "\t" << dir << "\n";
+    for (auto &e : entries)
+      f << (e.label ? *e.label : -1) << "\t" << e.filename << "\n";
+    if (!f.good()) {
+      DALI_WARN(make_string("Failed to write the file list cache: ", tmp_path));
+      f.close();
+      std::remove(tmp_path.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    DALI_WARN(make_string("Failed to write the file list cache: ", path));
+    std::remove(tmp_path.c_str());
+  }
+}
+
+}  // namespace
+
 std::vector<FileLabelEntry> discover_files(const std::string &file_root,
                                            const FileDiscoveryOptions &opts) {
   bool is_s3 = starts_with(file_root, "s3://");
@@ -121,28 +271,63 @@ std::vector<FileLabelEntry> discover_files(const std::string &file_root,
 #endif
   }
 
+  std::string cache_key, cache_path;
+  if (!opts.cache_dir.empty()) {
+    cache_key = manifest_key(file_root, opts);
+    cache_path = manifest_path(opts.cache_dir, cache_key);
+    if (auto cached = load_manifest(cache_path, file_root, cache_key)) {
+      LOG_LINE << "read " << cached->size() << " files from " << cache_path << "\n";
+      return std::move(*cached);
+    }
+  }
+
+  // the times are taken before listing, so that a modification during the discovery
+  // invalidates the manifest
+  auto root_mtime = dir_mtime(file_root);
   std::vector<std::string> subdirs;
   subdirs = list_subdirectories(file_root, opts.dir_filters, opts.case_sensitive_filter);
-  std::vector<FileLabelEntry> entries;
-  auto process_dir = [&](const std::string &rel_dirpath, std::optional<int> label = {}) {
+
+  // if we are in "label_from_subdir" mode, we need a subdir to infer the label, therefore we don't
+  // visit the current directory
+  std::vector<std::pair<std::string, DirTime>> dirs;
+  if (!opts.label_from_subdir)
+    dirs.emplace_back(".", root_mtime);
+  for (auto &subdir : subdirs)
+    dirs.emplace_back(subdir, DirTime{});
+
+  std::vector<std::vector<FileLabelEntry>> dir_entries(dirs.size());
+  int first_subdir = opts.label_from_subdir ? 0 : 1;
+  detail::discovery_parallel_for(dirs.size(), opts.num_threads, [&](int i) {
+    const auto &rel_dirpath = dirs[i].first;
     auto full_dirpath = filesystem::join_path(file_root, rel_dirpath);
+    if (i >= first_subdir)
+      dirs[i].second = dir_mtime(full_dirpath);
+    std::optional<int> label;
+    if (opts.label_from_subdir)
+      label = i - first_subdir;
     auto tmp_files = list_files(full_dirpath, opts.file_filters, opts.case_sensitive_filter);
+    auto &out = dir_entries[i];
+    out.reserve(tmp_files.size());
     for (const auto &f : tmp_files) {
-      entries.push_back({filesystem::join_path(rel_dirpath, f), label});
+      out.push_back({filesystem::join_path(rel_dirpath, f), label});
     }
-  };
+  });
 
-  // if we are in "label_from_subdir" mode, we need a subdir to infer the label, therefore we don't
-  // visit the current directory
-  if (!opts.label_from_subdir) {
-    process_dir(".");
-  }
-  for (unsigned dir_idx = 0; dir_idx < subdirs.size(); ++dir_idx) {
-    process_dir(subdirs[dir_idx],
-                opts.label_from_subdir ? std::optional<int>{dir_idx} : std::nullopt);
+  size_t total_entries = 0;
+  for (auto &e : dir_entries)
+    total_entries += e.size();
+  std::vector<FileLabelEntry> entries;
+  entries.reserve(total_entries);
+  for (auto &e : dir_entries)
+    std::move(e.begin(), e.end(), std::back_inserter(entries));
+
+  LOG_LINE << "read " << entries.size() << " files from " << dirs.size() << "directories\n";
+
+  if (!cache_path.empty()) {
+    if (opts.label_from_subdir)
+      dirs.emplace_back(".", root_mtime);
+    save_manifest(cache_path, cache_key, dirs, entries);
   }
-  size_t total_dir_count = opts.label_from_subdir ? subdirs.size() : subdirs.size() + 1;
-  LOG_LINE << "read " << entries.size() << " files from " << total_dir_count << "directories\n";
   return entries;
 }
 
@@ -15,6 +15,7 @@
 #ifndef DALI_OPERATORS_READER_LOADER_DISCOVER_FILES_H_
 #define DALI_OPERATORS_READER_LOADER_DISCOVER_FILES_H_
 
+#include <functional>
 #include <optional>
 #include <string>
 #include <utility>
@@ -44,10 +45,30 @@ struct FileDiscoveryOptions {
   bool case_sensitive_filter = false;     // whether the filter patterns are case-sensitive
   std::vector<std::string> file_filters;  // pattern to apply to filenames
   std::vector<std::string> dir_filters;   // pattern to apply to subdirectories
+  int num_threads = 1;                    // number of threads listing the subdirectories
+                                          // (or S3 prefixes) concurrently
+  std::string cache_dir;                  // if not empty, the discovered file list is stored in
+                                          // (and reused from) a manifest file in this directory
 };
 
+namespace detail {
+
+/**
+ * @brief Runs `func(i)` for every `i` in [0, n), using up to `num_threads` threads.
+ *
+ * Used to list many directories (or S3 prefixes) concurrently; with one thread (or one item)
+ * it runs in the calling thread.
+ */
+DLL_PUBLIC void discovery_parallel_for(int n, int num_threads, const std::function<void(int)> &func);
+
+}  // namespace detail
+
 /**
  * @brief Finds all (file, label, size) information, following the criteria given by opts.
+ *
+ * When `opts.cache_dir` is set, the result for a local `file_root` is saved in a manifest file
+ * and reused by subsequent calls, as long as the modification times of `file_root` and the
+ * visited subdirectories didn't change. S3 locations are always listed.
  */
 DLL_PUBLIC vector<FileLabelEntry> discover_files(const std::string &file_root,
                                                  const FileDiscoveryOptions &opts);
@@ -14,9 +14,8 @@
 
 #include "dali/operators/reader/loader/discover_files_s3.h"
 #include <fnmatch.h>
-#include <filesystem>
 #include <string>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 #include "dali/operators/reader/loader/discover_files.h"
 #include "dali/util/s3_client_manager.h"
@@ -24,72 +23,65 @@
 
 namespace dali {
 
-// We are using std::filesystem to analyze URI relative paths, which wouldn't be OK in non-UNIX
-// based systems
-#ifndef __unix__
-#error This code works only in UNIX-based systems
-#endif
-
 std::vector<FileLabelEntry> s3_discover_files(const std::string &file_root,
                                               const FileDiscoveryOptions &opts) {
   assert(starts_with(file_root, "s3://"));
   auto s3_object_location = s3_filesystem::parse_uri(file_root);
-  std::filesystem::path parent_object_key(s3_object_location.object);
-  auto count_elems = [](const std::filesystem::path &p) {
-    size_t k = 0;
-    for (auto &elem : p)
-      k++;
-    return k;
+  auto *s3_client = S3ClientManager::Instance().client();
+  std::string prefix = s3_object_location.object;
+  if (!prefix.empty() && prefix.back() != '/')
+    prefix.push_back('/');
+
+  auto matches = [&](const std::vector<std::string> &filters, const std::string &name) {
+    for (auto &filter : filters) {
+      if (fnmatch(filter.c_str(), name.c_str(),
+                  opts.case_sensitive_filter ? 0 : FNM_CASEFOLD) == 0)
+        return true;
+    }
+    return filters.empty();
   };
-  std::vector<FileLabelEntry> entries;
-  // in case that files are not visited in lexicographical order, we remember previously assigned
-  // labels
-  std::unordered_map<std::string, int> labels;
-  int next_label = 0;  // next free-label to be assigned
-  s3_filesystem::list_objects_f(
-      S3ClientManager::Instance().client(), s3_object_location,
-      [&](const std::string &object_key, size_t object_size) {
-        auto p = std::filesystem::relative(object_key, parent_object_key);
-        auto path_elems = count_elems(p);
-        assert(path_elems >= 2);
-        if (path_elems > 2)
-          return;  // we only look at one subdir level
-        const auto& subdir = p.begin()->native();
-        const auto& fname = (++p.begin())->native();
-        bool subdir_ok = opts.dir_filters.empty();
-        bool fname_ok = opts.file_filters.empty();
-        for (auto &filter : opts.dir_filters) {
-          if (fnmatch(filter.c_str(), subdir.c_str(),
-                      opts.case_sensitive_filter ? 0 : FNM_CASEFOLD) == 0) {
-            subdir_ok |= true;
-            break;
-          }
-        }
+  auto ignore_objects = [](const std::string &, size_t) {};
+  auto ignore_prefixes = [](const std::string &) {};
 
-        for (auto &filter : opts.file_filters) {
-          if (fnmatch(filter.c_str(), fname.c_str(),
-                      opts.case_sensitive_filter ? 0 : FNM_CASEFOLD) == 0) {
-            fname_ok |= true;
-            break;
-          }
-        }
+  // We only look at one subdir level: the top level is listed non-recursively to find the
+  // subdirectories, which are then listed concurrently (each one is a separate sequence of
+  // paginated requests).
+  std::vector<std::string> subdirs;
+  s3_filesystem::list_objects_f(s3_client, s3_object_location, ignore_objects,
+                                [&](const std::string &subdir_prefix) {
+    auto subdir = subdir_prefix.substr(prefix.size(), subdir_prefix.size() - prefix.size() - 1);
+    if (matches(opts.dir_filters, subdir))
+      subdirs.push_back(subdir);
+  });
 
-        if (!subdir_ok || !fname_ok)
-          return;
+  std::vector<std::vector<FileLabelEntry>> subdir_entries(subdirs.size());
+  detail::discovery_parallel_for(subdirs.size(), opts.num_threads, [&](int i) {
+    s3_filesystem::S3ObjectLocation subdir_location{s3_object_location.bucket,
+                                                    prefix + subdirs[i] + '/'};
+    auto &out = subdir_entries[i];
+    s3_filesystem::list_objects_f(s3_client, subdir_location,
+                                  [&](const std::string &object_key, size_t object_size) {
+      auto fname = object_key.substr(subdir_location.object.size());
+      if (fname.empty() || !matches(opts.file_filters, fname))
+        return;  // skip "directory marker" objects
+      out.push_back({subdirs[i] + '/' + fname, std::nullopt, object_size});
+    }, ignore_prefixes);
+  });
 
-        if (opts.label_from_subdir) {
-          int curr_label = -1;
-          auto it = labels.find(subdir);
-          if (it == labels.end()) {
-            curr_label = labels[subdir] = next_label++;
-          } else {
-            curr_label = it->second;
-          }
-          entries.push_back({p, curr_label, object_size});
-        } else {
-          entries.push_back({p, std::nullopt, object_size});
-        }
-      });
+  // S3 lists the keys in lexicographical order, so the labels are assigned in the order
+  // of the subdirectories; a subdirectory without matching files doesn't get a label
+  std::vector<FileLabelEntry> entries;
+  int next_label = 0;  // next free-label to be assigned
+  for (auto &dir_entries : subdir_entries) {
+    if (dir_entries.empty())
+      continue;
+    int label = next_label++;
+    for (auto &entry : dir_entries) {
+      if (opts.label_from_subdir)
+        entry.label = label;
+      entries.push_back(std::move(entry));
+    }
+  }
   return entries;
 }
 
@@ -14,10 +14,13 @@
 
 #include <glob.h>
 #include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <string>
 #include <vector>
 
+#include "dali/core/call_at_exit.h"
 #include "dali/core/error_handling.h"
 #include "dali/operators/reader/loader/filesystem.h"
 #include "dali/operators/reader/loader/discover_files.h"
@@ -151,4 +154,55 @@ TEST_F(DiscoverFilesTest, CaseInsensitiveFilters) {
   }
 }
 
+TEST_F(DiscoverFilesTest, ParallelDiscovery) {
+  FileDiscoveryOptions opts{true, false, kKnownExtensionsGlob, {}};
+  auto reference = discover_files(file_root, opts);
+  opts.num_threads = 4;
+  auto parallel = discover_files(file_root, opts);
+  ASSERT_EQ(reference.size(), parallel.size());
+  for (size_t i = 0; i < reference.size(); ++i) {
+    EXPECT_EQ(reference[i].filename, parallel[i].filename);
+    EXPECT_EQ(reference[i].label, parallel[i].label);
+  }
+}
+
+TEST(DiscoverFilesCacheTest, ReuseAndInvalidate) {
+  char tmpl[] = "/tmp/dali_discover_files_XXXXXX";
+  ASSERT_NE(mkdtemp(tmpl), nullptr);
+  std::filesystem::path tmp_dir(tmpl);
+  auto cleanup = AtScopeExit([&] { std::filesystem::remove_all(tmp_dir); });
+  auto root = tmp_dir / "root";
+  auto cache = tmp_dir / "cache";
+  std::filesystem::create_directories(root / "a");
+  std::filesystem::create_directories(root / "b");
+  std::filesystem::create_directories(cache);
+  std::ofstream(root / "a" / "0.jpg") << "x";
+  std::ofstream(root / "b" / "1.jpg") << "x";
+
+  // recently modified directories are not cached
+  auto past = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+  for (auto &dir : {root, root / "a", root / "b"})
+    std::filesystem::last_write_time(dir, past);
+
+  FileDiscoveryOptions opts{true, false, {"*.jpg"}, {}};
+  opts.cache_dir = cache;
+  auto first = discover_files(root, opts);
+  ASSERT_EQ(first.size(), 2u);
+  ASSERT_FALSE(std::filesystem::is_empty(cache));
+
+  auto cached = discover_files(root, opts);
+  ASSERT_EQ(cached.size(), 2u);
+  for (size_t i = 0; i < first.size(); ++i) {
+    EXPECT_EQ(first[i].filename, cached[i].filename);
+    EXPECT_EQ(first[i].label, cached[i].label);
+  }
+
+  // adding a file updates the modification time of the subdirectory
+  std::ofstream(root / "b" / "2.jpg") << "x";
+  auto updated = discover_files(root, opts);
+  ASSERT_EQ(updated.size(), 3u);
+  EXPECT_EQ(updated[2].filename, "b/2.jpg");
+  EXPECT_EQ(updated[2].label, 1);
+}
+
 }  // namespace dali
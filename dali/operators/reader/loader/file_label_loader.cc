@@ -32,11 +32,23 @@ void FileLabelLoaderBase<checkpointing_supported>::PrepareEmpty(ImageLabelWrappe
 
 template<bool checkpointing_supported>
 void FileLabelLoaderBase<checkpointing_supported>::ReadSample(ImageLabelWrapper &image_label) {
-  auto entry = file_label_entries_[current_index_++];
+  auto entry = file_label_entries_[EntryIndex(current_index_++)];
 
   // handle wrap-around
   MoveToNextShard(current_index_);
 
+  ReadEntry(image_label, entry);
+}
+
+template<bool checkpointing_supported>
+void FileLabelLoaderBase<checkpointing_supported>::ReadSampleAt(ImageLabelWrapper &image_label,
+                                                                Index handle) {
+  ReadEntry(image_label, file_label_entries_[handle]);
+}
+
+template<bool checkpointing_supported>
+void FileLabelLoaderBase<checkpointing_supported>::ReadEntry(ImageLabelWrapper &image_label,
+                                                             const FileLabelEntry &entry) {
   // should be cleared by now
   assert(image_label.file_stream == nullptr);
 
@@ -60,8 +72,36 @@ void FileLabelLoaderBase<checkpointing_supported>::ReadSample(ImageLabelWrapper
   opts.read_ahead = read_ahead_;
   opts.use_mmap = !copy_read_data_;
   opts.use_odirect = false;
+  opts.use_io_uring = use_io_uring_;
   auto uri = URI::Parse(path, URI::ParseOpts::AllowNonEscaped);
   bool local_file = !uri.valid() || uri.scheme() == "file";
+
+  if (local_file && this->ReadFromSharedCache(path, image_label.image)) {
+    image_label.image.SetMeta(meta);
+    return;
+  }
+
+  if (local_file && copy_read_data_ && !use_io_uring_ && this->ShouldDeferReads()) {
+    // Opening and reading the file is left to the reader's loader threads
+    if (image_label.image.shares_data()) {
+      image_label.image.Reset();
+    }
+    image_label.image.SetMeta(meta);
+    auto *image = &image_label.image;
+    this->DeferRead([image, path, opts, meta, filename = entry.filename]() {
+      auto file = FileStream::Open(path, opts);
+      auto file_cleanup = AtScopeExit([&file] {
+        file->Close();
+      });
+      Index file_size = file->Size();
+      image->Resize({file_size}, DALI_UINT8);
+      int64_t read_nbytes = file->Read(image->mutable_data<uint8_t>(), file_size);
+      DALI_ENFORCE(read_nbytes == file_size, make_string("Failed to read file: ", filename));
+      image->SetMeta(meta);
+    });
+    this->AddToSharedCache(path, image_label.image);
+    return;
+  }
   auto current_file = FileStream::Open(path, opts, entry.size);
   auto current_file_cleanup = AtScopeExit([&current_file] {
     if (current_file)
@@ -73,7 +113,12 @@ void FileLabelLoaderBase<checkpointing_supported>::ReadSample(ImageLabelWrapper
     if (image_label.image.shares_data()) {
       image_label.image.Reset();
     }
-    if (local_file) {
+    if (local_file && use_io_uring_) {
+      // the read is batched with the other samples and submitted at once
+      image_label.image.Resize({file_size}, DALI_UINT8);
+      pending_reads_.Add(std::move(current_file), image_label.image.mutable_data<uint8_t>(),
+                         file_size, 0);
+    } else if (local_file) {
       // if local file, read right away
       image_label.image.Resize({file_size}, DALI_UINT8);
       int64_t read_nbytes =
@@ -90,6 +135,8 @@ void FileLabelLoaderBase<checkpointing_supported>::ReadSample(ImageLabelWrapper
     image_label.image.ShareData(p, file_size, false, {file_size}, DALI_UINT8, CPU_ONLY_DEVICE_ID);
   }
   image_label.image.SetMeta(meta);
+  if (local_file)
+    this->AddToSharedCache(path, image_label.image);
 }
 
 template<bool checkpointing_supported>
@@ -33,6 +33,7 @@
 #include "dali/operators/reader/loader/filesystem.h"
 #include "dali/operators/reader/loader/loader.h"
 #include "dali/util/file.h"
+#include "dali/util/uring_file.h"
 
 namespace dali {
 
@@ -74,6 +75,10 @@ class DLL_PUBLIC FileLabelLoaderBase : public Loader<CPUBackend, ImageLabelWrapp
     // TODO(ksztenderski): CocoLoader inherits after FileLabelLoader and it doesn't work with
     // GetArgument.
     spec.TryGetArgument(file_discovery_opts_.case_sensitive_filter, "case_sensitive_filter");
+    spec.TryGetArgument(file_discovery_opts_.num_threads, "file_discovery_threads");
+    spec.TryGetArgument(file_discovery_opts_.cache_dir, "file_discovery_cache_dir");
+    spec.TryGetArgument(use_io_uring_, "use_io_uring");
+    spec.TryGetArgument(elastic_sharding_, "elastic_sharding");
 
     DALI_ENFORCE(has_file_root_arg_ || has_files_arg_ || has_file_list_arg_,
       "``file_root`` argument is required when not using ``files`` or ``file_list``.");
@@ -89,6 +94,8 @@ class DLL_PUBLIC FileLabelLoaderBase : public Loader<CPUBackend, ImageLabelWrapp
                  "``file_filters`` list cannot be empty.");
     DALI_ENFORCE(!has_dir_filters_arg || file_discovery_opts_.dir_filters.size() > 0,
                  "``dir_filters`` list cannot be empty.");
+    DALI_ENFORCE(file_discovery_opts_.num_threads >= 1,
+                 "``file_discovery_threads`` must be positive.");
 
     if (has_file_list_arg_) {
       DALI_ENFORCE(!file_list_.empty(), "``file_list`` argument cannot be empty");
@@ -124,6 +131,11 @@ class DLL_PUBLIC FileLabelLoaderBase : public Loader<CPUBackend, ImageLabelWrapp
                   "shuffle_after_epoch and stick_to_shard cannot be both true");
     DALI_ENFORCE(!(shuffle_after_epoch_ && shuffle_),
                   "shuffle_after_epoch and random_shuffle cannot be both true");
+    // the samples taken from the shuffling buffer don't form a prefix of the shard
+    DALI_ENFORCE(!(elastic_sharding_ && shuffle_),
+                  "elastic_sharding and random_shuffle cannot be both true");
+    DALI_ENFORCE(!(elastic_sharding_ && stick_to_shard_),
+                  "elastic_sharding and stick_to_shard cannot be both true");
     /*
      * Imply `stick_to_shard` from  `shuffle_after_epoch`
      */
@@ -135,10 +147,22 @@ class DLL_PUBLIC FileLabelLoaderBase : public Loader<CPUBackend, ImageLabelWrapp
                                   static_cast<unsigned int>(initial_buffer_fill_));
     }
     copy_read_data_ = dont_use_mmap_ || !mmap_reserver_.CanShareMappedData();
+    DALI_ENFORCE(dont_use_mmap_ || !use_io_uring_,
+                 "Cannot use ``use_io_uring`` with ``dont_use_mmap=False``.");
   }
 
   void PrepareEmpty(ImageLabelWrapper &tensor) override;
   void ReadSample(ImageLabelWrapper &tensor) override;
+  void ReadSampleAt(ImageLabelWrapper &tensor, Index handle) override;
+
+  /**
+   * @brief Reads the contents of all the samples scheduled for io_uring reading by ReadSample.
+   *
+   * Must be called before the samples read since the last call are consumed.
+   */
+  void SubmitPendingReads() {
+    pending_reads_.Submit();
+  }
 
  protected:
   Index SizeImpl() override;
@@ -212,8 +236,24 @@ class DLL_PUBLIC FileLabelLoaderBase : public Loader<CPUBackend, ImageLabelWrapp
     MoveToNextShard(++current_index_);
   }
 
+  Index SkipWithHandle() override {
+    // with `shuffle_after_epoch`, the entries are reordered in every epoch
+    Index handle = shuffle_after_epoch_ ? -1 : EntryIndex(current_index_);
+    Skip();
+    return handle;
+  }
+
+  void ReadEntry(ImageLabelWrapper &image_label, const FileLabelEntry &entry);
+
+  /** The index of the entry read at the given position of the loader */
+  Index EntryIndex(Index current_index) const {
+    return elastic_sharding_ ? ElasticPosition(current_index) : current_index;
+  }
+
   void Reset(bool wrap_to_shard) override {
-    if (wrap_to_shard) {
+    if (elastic_sharding_) {
+      current_index_ = 0;  // counts the samples of the shard, see EntryIndex
+    } else if (wrap_to_shard) {
       current_index_ = start_index(virtual_shard_id_, num_shards_, SizeImpl());
     } else {
       current_index_ = 0;
@@ -248,6 +288,8 @@ class DLL_PUBLIC FileLabelLoaderBase : public Loader<CPUBackend, ImageLabelWrapp
   using Base::IsCheckpointingEnabled;
   using Base::PrepareEmptyTensor;
   using Base::MoveToNextShard;
+  using Base::ElasticPosition;
+  using Base::elastic_sharding_;
   using Base::ShouldSkipImage;
 
   string file_root_, file_list_;
@@ -260,6 +302,9 @@ class DLL_PUBLIC FileLabelLoaderBase : public Loader<CPUBackend, ImageLabelWrapp
   bool has_file_list_arg_ = false;
   bool has_file_root_arg_ = false;
 
+  bool use_io_uring_ = false;
+  UringReadBatch pending_reads_;
+
   bool shuffle_after_epoch_;
   Index current_index_;
   int current_epoch_;
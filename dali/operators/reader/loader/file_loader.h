@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2021, 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2021, 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -170,6 +170,23 @@ class FileLoader : public Loader<Backend, Target, true> {
     current_epoch_ = state.current_epoch;
   }
 
+  void Skip() override {
+    MoveToNextShard(++current_index_);
+  }
+
+  /**
+   * @brief Skips a sample and returns its index in `file_entries_`, which can be used by
+   *        ReadSampleAt in the derived loaders.
+   *
+   * With `shuffle_after_epoch` the entries are reordered in every epoch and the index wouldn't
+   * be valid in the next one - no handle is returned then.
+   */
+  Index SkipWithIndex() {
+    Index index = shuffle_after_epoch_ ? -1 : current_index_;
+    Skip();
+    return index;
+  }
+
   using Loader<Backend, Target, true>::shard_id_;
   using Loader<Backend, Target, true>::virtual_shard_id_;
   using Loader<Backend, Target, true>::num_shards_;
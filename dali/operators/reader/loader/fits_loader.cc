@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -17,6 +17,7 @@
 #include <fitsio.h>
 
 #include <cstdlib>
+#include <cstring>
 #include <memory>
 
 #include "dali/core/common.h"
@@ -34,6 +35,18 @@ void FitsLoaderCPU::ReadDataFromHDU(const fits::FitsHandle& current_file,
   int status = 0, anynul = 0, nulval = 0;
   Index nelem = header.size();
 
+  if (header.rice_tiles) {
+    // the tiles are decoded by the reader, in parallel
+    vector<uint8_t> raw_data;
+    fits::ExtractUndecodedData(current_file, raw_data, target.tile_offset[output_idx],
+                               target.tile_size[output_idx], header.rows, &status);
+    FITS_CALL(status);
+
+    target.data[output_idx].Resize(TensorShape<1>(raw_data.size()), DALI_UINT8);
+    memcpy(target.data[output_idx].raw_mutable_data(), raw_data.data(), raw_data.size());
+    return;
+  }
+
   FITS_CALL(fits_read_img(current_file, header.datatype_code, 1, nelem, &nulval,
                                 static_cast<uint8_t*>(target.data[output_idx].raw_mutable_data()),
                                 &anynul, &status));
@@ -42,6 +55,8 @@ void FitsLoaderCPU::ReadDataFromHDU(const fits::FitsHandle& current_file,
 void FitsLoaderCPU::ResizeTarget(FitsFileWrapper& target, size_t new_size) {
   target.data.resize(new_size);
   target.header.resize(new_size);
+  target.tile_offset.resize(new_size);
+  target.tile_size.resize(new_size);
 }
 
 }  // namespace dali
@@ -33,7 +33,9 @@ namespace dali {
 
 struct FitsFileWrapper {
   std::vector<fits::HeaderData> header;
+  /// The decoded images or, for the outputs with `header.rice_tiles`, the undecoded tiles
   std::vector<Tensor<CPUBackend>> data;
+  std::vector<std::vector<int64_t>> tile_offset, tile_size;
   std::string filename;
 };
 
@@ -0,0 +1,90 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_INDEX_PERMUTATION_H_
+#define DALI_OPERATORS_READER_LOADER_INDEX_PERMUTATION_H_
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+namespace dali {
+
+/**
+ * @brief A pseudo-random permutation of the indices [0, n), computed on the fly.
+ *
+ * The permutation is a Feistel network over the smallest domain of 4^k >= n elements; the values
+ * out of range are permuted again (cycle walking) until they fall into [0, n). Unlike a shuffled
+ * array of indices, it takes constant memory and can be evaluated for any index in any order,
+ * which makes it suitable for shuffling large datasets that are read by (random-access) index.
+ *
+ * The same size and seed always give the same permutation.
+ */
+class IndexPermutation {
+ public:
+  IndexPermutation() = default;
+
+  IndexPermutation(uint64_t n, uint64_t seed) : n_(n) {
+    while (half_bits_ < 32 && (uint64_t(1) << (2 * half_bits_)) < n)
+      half_bits_++;
+    mask_ = (uint64_t(1) << half_bits_) - 1;
+    for (auto &key : keys_) {
+      seed = Mix(seed);
+      key = seed;
+    }
+  }
+
+  uint64_t size() const noexcept { return n_; }
+
+  /** Returns the element at the position `i` of the permutation; `i` must be less than size() */
+  uint64_t operator()(uint64_t i) const noexcept {
+    assert(i < n_);
+    // The network is a bijection of the domain, so the walk, starting from a value in range,
+    // returns to the range - on average, in fewer than 4 steps.
+    do {
+      i = Encrypt(i);
+    } while (i >= n_);
+    return i;
+  }
+
+ private:
+  static constexpr int kRounds = 4;
+
+  /** The finalizer of splitmix64 - a cheap function with a good avalanche effect */
+  static uint64_t Mix(uint64_t x) noexcept {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+  }
+
+  uint64_t Encrypt(uint64_t x) const noexcept {
+    uint64_t l = x >> half_bits_, r = x & mask_;
+    for (uint64_t key : keys_) {
+      uint64_t next_r = l ^ (Mix(r ^ key) & mask_);
+      l = r;
+      r = next_r;
+    }
+    return (l << half_bits_) | r;
+  }
+
+  uint64_t n_ = 0;
+  int half_bits_ = 0;
+  uint64_t mask_ = 0;
+  std::array<uint64_t, kRounds> keys_{};
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_INDEX_PERMUTATION_H_
@@ -0,0 +1,49 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "dali/operators/reader/loader/index_permutation.h"
+
+namespace dali {
+
+TEST(IndexPermutationTest, IsPermutation) {
+  for (uint64_t n : {1, 2, 3, 4, 5, 15, 16, 17, 100, 1000, 4097, 65537}) {
+    IndexPermutation perm(n, 1234);
+    ASSERT_EQ(perm.size(), n);
+    std::vector<bool> seen(n, false);
+    for (uint64_t i = 0; i < n; i++) {
+      uint64_t p = perm(i);
+      ASSERT_LT(p, n);
+      ASSERT_FALSE(seen[p]) << "duplicate " << p << " for n = " << n;
+      seen[p] = true;
+    }
+  }
+}
+
+TEST(IndexPermutationTest, Seed) {
+  const uint64_t n = 1000;
+  IndexPermutation a(n, 1), b(n, 1), c(n, 2);
+  int same_as_c = 0, fixed_points = 0;
+  for (uint64_t i = 0; i < n; i++) {
+    EXPECT_EQ(a(i), b(i));
+    same_as_c += a(i) == c(i);
+    fixed_points += a(i) == i;
+  }
+  // a random permutation has, on average, one fixed point and one element in common with another
+  EXPECT_LT(same_as_c, 10);
+  EXPECT_LT(fixed_points, 10);
+}
+
+}  // namespace dali
@@ -15,10 +15,15 @@
 #ifndef DALI_OPERATORS_READER_LOADER_INDEXED_FILE_LOADER_H_
 #define DALI_OPERATORS_READER_LOADER_INDEXED_FILE_LOADER_H_
 
+#include <algorithm>
+#include <cassert>
 #include <fstream>
+#include <list>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <queue>
+#include <random>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -27,10 +32,12 @@
 #include "dali/core/call_at_exit.h"
 #include "dali/core/common.h"
 #include "dali/core/mm/memory.h"
+#include "dali/operators/reader/loader/index_permutation.h"
 #include "dali/operators/reader/loader/loader.h"
 #include "dali/pipeline/util/thread_pool.h"
 #include "dali/util/file.h"
 #include "dali/util/odirect_file.h"
+#include "dali/util/uring_file.h"
 #include "dali/util/uri.h"
 
 namespace dali {
@@ -49,9 +56,42 @@ class IndexedFileLoader : public Loader<CPUBackend, IndexedFileLoaderSample, tru
         current_index_(0),
         current_file_index_(0),
         current_file_(nullptr),
-        use_o_direct_(spec.HasArgument("use_o_direct") && spec.GetArgument<bool>("use_o_direct")) {
+        use_o_direct_(spec.HasArgument("use_o_direct") && spec.GetArgument<bool>("use_o_direct")),
+        use_io_uring_(spec.HasArgument("use_io_uring") && spec.GetArgument<bool>("use_io_uring")),
+        coalesced_read_bytes_(spec.HasArgument("coalesced_read_bytes")
+                              ? spec.GetArgument<int64_t>("coalesced_read_bytes") : 0),
+        shuffle_block_size_(spec.HasArgument("shuffle_block_size")
+                            ? spec.GetArgument<int64_t>("shuffle_block_size") : 0),
+        shuffle_interleave_(spec.HasArgument("shuffle_interleave")
+                            ? spec.GetArgument<int>("shuffle_interleave") : 1),
+        shuffle_after_epoch_(spec.HasArgument("shuffle_after_epoch") &&
+                             spec.GetArgument<bool>("shuffle_after_epoch")),
+        prefetch_horizon_(spec.HasArgument("prefetch_horizon")
+                          ? spec.GetArgument<int64_t>("prefetch_horizon") : 0) {
+    DALI_ENFORCE(coalesced_read_bytes_ >= 0, make_string(
+                 "``coalesced_read_bytes`` must not be negative, got ", coalesced_read_bytes_));
+    DALI_ENFORCE(shuffle_block_size_ >= 0, make_string(
+                 "``shuffle_block_size`` must not be negative, got ", shuffle_block_size_));
+    DALI_ENFORCE(shuffle_interleave_ >= 1, make_string(
+                 "``shuffle_interleave`` must be positive, got ", shuffle_interleave_));
+    DALI_ENFORCE(prefetch_horizon_ >= 0, make_string(
+                 "``prefetch_horizon`` must not be negative, got ", prefetch_horizon_));
+    // The global shuffling makes every shard look different in every epoch, so (like in the file
+    // reader) it implies `stick_to_shard`, which cannot be set explicitly.
+    DALI_ENFORCE(!(shuffle_after_epoch_ && stick_to_shard_),
+                 "shuffle_after_epoch and stick_to_shard cannot be both true");
+    DALI_ENFORCE(!(shuffle_after_epoch_ && shuffle_),
+                 "shuffle_after_epoch and random_shuffle cannot be both true");
+    DALI_ENFORCE(!(shuffle_after_epoch_ && shuffle_block_size_ > 0),
+                 "shuffle_after_epoch and shuffle_block_size cannot be used together");
+    if (shuffle_after_epoch_)
+      stick_to_shard_ = true;
     DALI_ENFORCE(dont_use_mmap_ || !use_o_direct_,
                  make_string("Cannot use use_o_direct with ", "``dont_use_mmap=False``."));
+    DALI_ENFORCE(dont_use_mmap_ || !use_io_uring_,
+                 make_string("Cannot use use_io_uring with ", "``dont_use_mmap=False``."));
+    DALI_ENFORCE(!use_o_direct_ || !use_io_uring_,
+                 "``use_o_direct`` and ``use_io_uring`` are mutually exclusive.");
     if (use_o_direct_) {
       o_direct_chunk_size_ = ODirectFileStream::GetChunkSize();
       o_direct_alignm_ = ODirectFileStream::GetAlignment();
@@ -66,11 +106,27 @@ class IndexedFileLoader : public Loader<CPUBackend, IndexedFileLoaderSample, tru
 
   void ReadSample(IndexedFileLoaderSample& sample) override {
     MoveToNextShard(current_index_);
+    size_t record_index = RecordIndex(current_index_);
+    ++current_index_;
+    auto prefetch = AtScopeExit([this] { PrefetchAhead(); });
+    ReadRecord(sample, record_index);
+  }
+
+  /** The handle is the index of the record in `indices_` */
+  Index SkipWithHandle() override {
+    MoveToNextShard(current_index_);
+    return RecordIndex(current_index_++);  // keeps the shuffling of the shards in sync
+  }
+
+  void ReadSampleAt(IndexedFileLoaderSample& sample, Index handle) override {
+    ReadRecord(sample, handle);
+  }
 
+  /** Reads the record with the given index in `indices_` */
+  void ReadRecord(IndexedFileLoaderSample& sample, size_t record_index) {
     int64_t seek_pos, size;
     size_t file_index;
-    std::tie(seek_pos, size, file_index) = indices_[current_index_];
-    ++current_index_;
+    std::tie(seek_pos, size, file_index) = indices_[record_index];
 
     const auto& path = paths_[file_index];
     std::string image_key = path + " at index " + to_string(seek_pos);
@@ -82,20 +138,22 @@ class IndexedFileLoader : public Loader<CPUBackend, IndexedFileLoaderSample, tru
     opts.read_ahead = read_ahead_;
     opts.use_mmap = !copy_read_data_;
     opts.use_odirect = use_o_direct_;
+    opts.use_io_uring = use_io_uring_;
 
     auto uri = URI::Parse(path, URI::ParseOpts::AllowNonEscaped);
     bool local_file = !uri.valid() || uri.scheme() == "file";
 
-    if (file_index != current_file_index_) {
-      current_file_.reset();
-      current_file_ = FileStream::Open(path, opts);
-      current_file_sz_ = current_file_->Size();
-      current_file_index_ = file_index;
-      // invalidate the buffer
-      if (use_o_direct_)
-        read_buffer_.reset();
+    // a sample in the shared cache doesn't need the file at all
+    if (local_file && !ShouldSkipImage(image_key) &&
+        ReadFromSharedCache(image_key, sample.tensor)) {
+      should_seek_ = true;
+      sample.tensor.SetMeta(meta);
+      return;
     }
 
+    if (file_index != current_file_index_)
+      OpenFile(file_index, opts);
+
     // if image is cached, skip loading
     if (ShouldSkipImage(image_key)) {
       meta.SetSkipSample(true);
@@ -142,8 +200,10 @@ class IndexedFileLoader : public Loader<CPUBackend, IndexedFileLoaderSample, tru
         if (!read_buffer_ || !(after_buffer_start && before_buffer_end)) {
           // check how much we need to allocate to house the required sample, but no less than
           // o_direct_chunk_size_
+          // with coalescing enabled, the read covers the adjacent records as well
+          int64_t read_end = CoalescedReadEnd(record_index);
           auto block_start = align_down(seek_pos, o_direct_alignm_);
-          auto block_end = align_up(seek_pos + size, o_direct_alignm_);
+          auto block_end = align_up(read_end, o_direct_alignm_);
           auto aligned_len = align_up(block_end - block_start, o_direct_chunk_size_);
           // make the staging buffer as big as the biggest sample so far
           if (aligned_len > static_cast<int64_t>(read_buffer_size_)) {
@@ -151,6 +211,7 @@ class IndexedFileLoader : public Loader<CPUBackend, IndexedFileLoaderSample, tru
           }
           // the old memory will be used as long as any piece of it uses its, so it is safe
           // to release the old buffer from read_buffer_
+          mm::MemoryTagScope tag(mm::MemoryTag::Staging);
           read_buffer_ = mm::alloc_raw_shared<char, mm::memory_kind::host>(read_buffer_size_,
                                                                            o_direct_alignm_);
           read_buffer_pos_ = block_start;
@@ -167,7 +228,7 @@ class IndexedFileLoader : public Loader<CPUBackend, IndexedFileLoaderSample, tru
             auto dst_ptr = read_buffer_.get() + read_off;
             auto read_start = block_start + read_off;
             // we should read either the chunk size or the reminder of the file
-            auto min_read = std::min(o_direct_chunk_size_tmp, seek_pos + size - read_start);
+            auto min_read = std::min(o_direct_chunk_size_tmp, read_end - read_start);
             auto work = [tmp_file_ptr, file, dst_ptr, o_direct_chunk_size_tmp, min_read, read_start,
                          file_name]() {
               auto ret = file->ReadAt(dst_ptr, o_direct_chunk_size_tmp, read_start);
@@ -199,6 +260,38 @@ class IndexedFileLoader : public Loader<CPUBackend, IndexedFileLoaderSample, tru
           DALI_ENFORCE(n_read == size, "Error reading from a file: " + path);
         };
         sample.work = std::move(work);
+      } else if (coalesced_read_bytes_ > 0) {
+        /*
+         * A single read fills the buffer with this record and the adjacent ones that follow it
+         * in the same file. The samples alias the buffer, which is released when the last one
+         * of them is.
+         */
+        bool in_buffer = read_buffer_ &&
+            seek_pos >= static_cast<int64_t>(read_buffer_pos_) &&
+            seek_pos + size <= static_cast<int64_t>(read_buffer_pos_ + read_buffer_data_size_);
+        if (!in_buffer) {
+          int64_t read_len = CoalescedReadEnd(record_index) - seek_pos;
+          mm::MemoryTagScope tag(mm::MemoryTag::Staging);
+          read_buffer_ = mm::alloc_raw_shared<char, mm::memory_kind::host>(read_len);
+          read_buffer_pos_ = seek_pos;
+          read_buffer_data_size_ = read_len;
+          if (use_io_uring_) {
+            pending_reads_.Add(current_file_, read_buffer_.get(), read_len, seek_pos);
+          } else {
+            current_file_->SeekRead(seek_pos);
+            int64_t n_read = current_file_->Read(read_buffer_.get(), read_len);
+            DALI_ENFORCE(n_read == read_len,
+                         "Error reading from a file " + paths_[current_file_index_]);
+          }
+          // the file position no longer follows the consecutive records
+          should_seek_ = true;
+        }
+        shared_ptr<void> tmp_mem(read_buffer_, read_buffer_.get() + (seek_pos - read_buffer_pos_));
+        sample.tensor.ShareData(tmp_mem, size, false, {size}, DALI_UINT8, CPU_ONLY_DEVICE_ID);
+      } else if (use_io_uring_) {
+        // the read is batched with the other samples and submitted at once
+        sample.tensor.Resize({size}, DALI_UINT8);
+        pending_reads_.Add(current_file_, sample.tensor.raw_mutable_data(), size, seek_pos);
       } else {
         sample.tensor.Resize({size}, DALI_UINT8);
         int64_t n_read =
@@ -207,11 +300,14 @@ class IndexedFileLoader : public Loader<CPUBackend, IndexedFileLoaderSample, tru
       }
     }
     sample.tensor.SetMeta(meta);
+    if (local_file)
+      AddToSharedCache(image_key, sample.tensor);
     return;
   }
 
   void Skip() override {
-    MoveToNextShard(current_index_++);
+    MoveToNextShard(current_index_);
+    RecordIndex(current_index_++);  // keeps the shuffling of the shards in sync
   }
 
   ~IndexedFileLoader() override {
@@ -244,6 +340,30 @@ class IndexedFileLoader : public Loader<CPUBackend, IndexedFileLoaderSample, tru
     return indices_.size();
   }
 
+  /**
+   * @brief Returns the end offset of a read that starts at the record `index` and covers
+   *        the records that directly follow it in the same file, within `coalesced_read_bytes_`.
+   *
+   * If coalescing is disabled (or the next record is not adjacent), the end of the record
+   * itself is returned.
+   */
+  int64_t CoalescedReadEnd(size_t index) const {
+    int64_t start, size;
+    size_t file_index;
+    std::tie(start, size, file_index) = indices_[index];
+    int64_t end = start + size;
+    for (size_t i = index + 1; i < indices_.size(); i++) {
+      int64_t next_pos, next_size;
+      size_t next_file_index;
+      std::tie(next_pos, next_size, next_file_index) = indices_[i];
+      if (next_file_index != file_index || next_pos != end ||
+          end + next_size - start > coalesced_read_bytes_)
+        break;
+      end += next_size;
+    }
+    return end;
+  }
+
   void PrepareMetadataImpl() override {
     if (!dont_use_mmap_) {
       mmap_reserver_ = FileStream::MappingReserver(static_cast<unsigned int>(initial_buffer_fill_));
@@ -265,22 +385,168 @@ class IndexedFileLoader : public Loader<CPUBackend, IndexedFileLoaderSample, tru
     } else {
       current_index_ = 0;
     }
-    std::tie(seek_pos, size, file_index) = indices_[current_index_];
+    if (shuffle_after_epoch_) {
+      // the seed doesn't depend on the shard, so that all the shards use the same permutation
+      permutation_ = IndexPermutation(indices_.size(), kDaliDataloaderSeed + ++shuffle_epoch_);
+    }
+    std::tie(seek_pos, size, file_index) = indices_[RecordIndex(current_index_)];
     if (file_index != current_file_index_) {
-      current_file_.reset();
-      const auto& path = paths_[file_index];
       FileStream::Options opts;
       opts.read_ahead = read_ahead_;
       opts.use_mmap = !copy_read_data_;
       opts.use_odirect = use_o_direct_;
-      current_file_ = FileStream::Open(path, opts);
-      current_file_sz_ = current_file_->Size();
-      current_file_index_ = file_index;
-      // invalidate the buffer
-      if (use_o_direct_)
-        read_buffer_.reset();
+      opts.use_io_uring = use_io_uring_;
+      OpenFile(file_index, opts);
     }
     current_file_->SeekRead(seek_pos);
+    prefetched_until_ = current_index_;
+  }
+
+  void RestoreStateImpl(const LoaderStateSnapshot &state) override {
+    // the snapshot is taken at the beginning of an epoch, which is when the records are shuffled
+    shuffle_epoch_ = state.current_epoch;
+    shuffled_begin_ = shuffled_end_ = 0;
+  }
+
+  /**
+   * @brief Makes the file `file_index` the current one.
+   *
+   * With interleaved blocks, the recently used files are kept open, so that reading the records
+   * of several files in turns doesn't reopen the files for every record.
+   */
+  void OpenFile(size_t file_index, const FileStream::Options &opts) {
+    if (current_file_ && shuffle_interleave_ > 1) {
+      recent_files_.push_front({current_file_index_, current_file_sz_, std::move(current_file_)});
+      if (static_cast<int>(recent_files_.size()) >= shuffle_interleave_)
+        recent_files_.pop_back();
+    }
+    current_file_.reset();
+    auto it = std::find_if(recent_files_.begin(), recent_files_.end(),
+                           [&](const RecentFile &f) { return f.index == file_index; });
+    if (it != recent_files_.end()) {
+      current_file_ = std::move(it->file);
+      current_file_sz_ = it->size;
+      recent_files_.erase(it);
+    } else {
+      current_file_ = FileStream::Open(paths_[file_index], opts);
+      current_file_sz_ = current_file_->Size();
+    }
+    current_file_index_ = file_index;
+    // the position of the file doesn't follow the previously read record
+    should_seek_ = true;
+    // invalidate the buffer
+    if (use_o_direct_ || coalesced_read_bytes_ > 0)
+      read_buffer_.reset();
+  }
+
+  /**
+   * @brief Returns the index of the record read at the position `pos` of the epoch.
+   *
+   * Without shuffling, the records are read in the order of the index files.
+   *
+   * With `shuffle_after_epoch_`, the position is mapped through a permutation of the whole
+   * dataset, which is different in every epoch, but the same in all the shards.
+   *
+   * With block shuffling, entering a shard (which starts an epoch) shuffles it: the shard is
+   * divided into blocks of `shuffle_block_size_` consecutive records, which are permuted and read
+   * in groups of `shuffle_interleave_` blocks, taking a record from each block of the group
+   * in turns.
+   */
+  size_t RecordIndex(size_t pos) {
+    if (shuffle_after_epoch_)
+      return permutation_(pos);
+    if (shuffle_block_size_ == 0)
+      return pos;
+    // the same position can be asked for more than once (e.g. by Reset and then ReadSample)
+    bool entered_shard = pos == shuffled_begin_ && last_shuffled_pos_ != pos;
+    if (entered_shard || pos < shuffled_begin_ || pos >= shuffled_end_)
+      ShuffleShard(pos);
+    last_shuffled_pos_ = pos;
+    return shuffled_records_[pos - shuffled_begin_];
+  }
+
+  /**
+   * @brief Like RecordIndex, but without shuffling the next shard - returns false if the record
+   *        read at `pos` is not known yet.
+   */
+  bool PeekRecordIndex(size_t pos, size_t &record) const {
+    if (shuffle_after_epoch_) {
+      record = permutation_(pos);
+    } else if (shuffle_block_size_ == 0) {
+      record = pos;
+    } else {
+      if (pos < shuffled_begin_ || pos >= shuffled_end_)
+        return false;
+      record = shuffled_records_[pos - shuffled_begin_];
+    }
+    return true;
+  }
+
+  /**
+   * @brief Hints the files about the records that are going to be read next.
+   *
+   * The read order is known in advance (also when shuffling blocks or the whole dataset), so
+   * the storage can load the records of the next `prefetch_horizon_` positions, until the end of
+   * the shard, while the current ones are processed. Only the records of the open files are
+   * hinted - the others are hinted once their file is opened, if they're still within the horizon.
+   */
+  void PrefetchAhead() {
+    // O_DIRECT reads bypass the page cache, which is what the hints fill
+    if (prefetch_horizon_ == 0 || use_o_direct_)
+      return;
+    size_t end = current_index_ + prefetch_horizon_;
+    size_t pos = prefetched_until_;
+    if (pos < current_index_ || pos > end)
+      pos = current_index_;
+    for (; pos < end && !IsNextShard(pos); pos++) {
+      size_t record;
+      if (!PeekRecordIndex(pos, record))
+        break;
+      int64_t seek_pos, size;
+      size_t file_index;
+      std::tie(seek_pos, size, file_index) = indices_[record];
+      if (file_index == current_file_index_) {
+        current_file_->Prefetch(seek_pos, size);
+        continue;
+      }
+      auto it = std::find_if(recent_files_.begin(), recent_files_.end(),
+                             [&](const RecentFile &f) { return f.index == file_index; });
+      if (it == recent_files_.end())
+        break;
+      it->file->Prefetch(seek_pos, size);
+    }
+    prefetched_until_ = pos;
+  }
+
+  void ShuffleShard(size_t pos) {
+    size_t N = indices_.size();
+    int shard = 0;
+    while (shard + 1 < num_shards_ && start_index(shard + 1, num_shards_, N) <= pos)
+      shard++;
+    shuffled_begin_ = start_index(shard, num_shards_, N);
+    shuffled_end_ = shard + 1 < num_shards_ ? start_index(shard + 1, num_shards_, N) : N;
+
+    size_t n = shuffled_end_ - shuffled_begin_;
+    size_t block_size = shuffle_block_size_;
+    std::vector<size_t> blocks((n + block_size - 1) / block_size);
+    std::iota(blocks.begin(), blocks.end(), 0);
+    std::seed_seq seq({seed_, static_cast<Index>(shuffle_epoch_++)});
+    std::mt19937 g(seq);
+    std::shuffle(blocks.begin(), blocks.end(), g);
+
+    shuffled_records_.clear();
+    shuffled_records_.reserve(n);
+    for (size_t group = 0; group < blocks.size(); group += shuffle_interleave_) {
+      size_t group_end = std::min<size_t>(group + shuffle_interleave_, blocks.size());
+      for (size_t i = 0; i < block_size; i++) {
+        for (size_t b = group; b < group_end; b++) {
+          size_t offset = blocks[b] * block_size + i;
+          if (offset < n)  // the last block can be shorter
+            shuffled_records_.push_back(shuffled_begin_ + offset);
+        }
+      }
+    }
+    assert(shuffled_records_.size() == n);
   }
 
   std::vector<std::string> paths_;
@@ -294,6 +560,31 @@ class IndexedFileLoader : public Loader<CPUBackend, IndexedFileLoaderSample, tru
   bool should_seek_ = false;
   int64_t next_seek_pos_ = 0;
   bool use_o_direct_ = false;
+  bool use_io_uring_ = false;
+  UringReadBatch pending_reads_;
+  // maximum size of a read that merges adjacent records; 0 disables coalescing
+  int64_t coalesced_read_bytes_ = 0;
+  // the number of consecutive records shuffled as a whole; 0 disables block shuffling
+  int64_t shuffle_block_size_ = 0;
+  // the number of blocks read at the same time
+  int shuffle_interleave_ = 1;
+  // the records of the last shuffled shard, [shuffled_begin_, shuffled_end_), in the read order
+  std::vector<size_t> shuffled_records_;
+  size_t shuffled_begin_ = 0, shuffled_end_ = 0;
+  size_t last_shuffled_pos_ = 0;
+  int shuffle_epoch_ = 0;
+  // a permutation of all the records, computed on the fly, different in every epoch
+  bool shuffle_after_epoch_ = false;
+  IndexPermutation permutation_;
+  struct RecentFile {
+    size_t index;
+    size_t size;
+    std::shared_ptr<FileStream> file;
+  };
+  std::list<RecentFile> recent_files_;
+  // the number of records ahead of the current one that are hinted to the storage
+  int64_t prefetch_horizon_ = 0;
+  size_t prefetched_until_ = 0;
   size_t o_direct_chunk_size_ = 0;
   size_t o_direct_alignm_ = 0;
   size_t o_direct_read_len_alignm_ = 0;
@@ -320,6 +611,15 @@ class IndexedFileLoader : public Loader<CPUBackend, IndexedFileLoaderSample, tru
     return work;
   }
 
+  /**
+   * @brief Reads the contents of all the samples scheduled for io_uring reading by ReadSample.
+   *
+   * Must be called before the samples read since the last call are consumed.
+   */
+  void SubmitPendingReads() {
+    pending_reads_.Submit();
+  }
+
   bool AnyWorkLeft() {
     std::lock_guard<std::mutex> lock(mutex_);
     return jobs_.size();
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,6 +16,9 @@
 #define DALI_OPERATORS_READER_LOADER_LMDB_H_
 
 #include <lmdb.h>
+#include <sys/mman.h>
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <vector>
@@ -43,13 +46,21 @@ class IndexedLMDB {
   Index mdb_size_;
 
  public:
-  void Open(const std::string& path, int num) {
+  /**
+   * @brief Opens the database and places the cursor at the first entry.
+   *
+   * @param read_ahead if true, the kernel is advised to read the memory-mapped database
+   *                   sequentially, ahead of the accessed pages
+   */
+  void Open(const std::string& path, int num, bool read_ahead = false) {
     DALI_ENFORCE(mdb_env_ == nullptr, "Previous MDB environment was not closed");
     db_path_ = path;
     num_ = num;
     CHECK_LMDB(mdb_env_create(&mdb_env_), db_path_);
     auto mdb_flags = MDB_RDONLY | MDB_NOTLS | MDB_NOLOCK;
     CHECK_LMDB(mdb_env_open(mdb_env_, path.c_str(), mdb_flags, 0664), db_path_);
+    if (read_ahead)
+      AdviseSequential();
 
     // Create transaction and cursor
     CHECK_LMDB(mdb_txn_begin(mdb_env_, NULL, MDB_RDONLY, &mdb_transaction_), db_path_);
@@ -124,6 +135,26 @@ class IndexedLMDB {
       mdb_env_ = nullptr;
     }
   }
+
+ private:
+  /**
+   * @brief Advises sequential access to the used part of the memory map
+   *
+   * The loader visits the entries in the key order, which, for a database written in bulk,
+   * is mostly the order of the pages in the file - the aggressive readahead turns the
+   * page faults into large sequential reads.
+   */
+  void AdviseSequential() {
+    MDB_envinfo info;
+    MDB_stat stat;
+    CHECK_LMDB(mdb_env_info(mdb_env_, &info), db_path_);
+    CHECK_LMDB(mdb_env_stat(mdb_env_, &stat), db_path_);
+    size_t used_size = (info.me_last_pgno + 1) * static_cast<size_t>(stat.ms_psize);
+    used_size = std::min(used_size, info.me_mapsize);
+    // it's only a hint - the failure is not an error
+    if (madvise(info.me_mapaddr, used_size, MADV_SEQUENTIAL) != 0)
+      LOG_LINE << "lmdb " << num_ << " " << db_path_ << " madvise failed" << std::endl;
+  }
 };
 
 static int find_lower_bound(const std::vector<Index>& a, Index x) {
@@ -199,6 +230,15 @@ class LMDBLoader : public Loader<CPUBackend, Tensor<CPUBackend>, true> {
 
     tensor.SetMeta(meta);
     tensor.Resize({static_cast<Index>(value.mv_size)}, DALI_UINT8);
+    if (ShouldDeferReads()) {
+      // The value stays mapped for the lifetime of the read transaction - only the copy,
+      // which is where the pages are faulted in, is left to the loader threads.
+      auto *out = &tensor;
+      DeferRead([out, value]() {
+        std::memcpy(out->raw_mutable_data(), value.mv_data, value.mv_size);
+      });
+      return;
+    }
     std::memcpy(tensor.raw_mutable_data(),
                 reinterpret_cast<uint8_t*>(value.mv_data),
                 value.mv_size * sizeof(uint8_t));
@@ -218,7 +258,7 @@ class LMDBLoader : public Loader<CPUBackend, Tensor<CPUBackend>, true> {
     offsets_[0] = 0;
     mdb_.resize(db_paths_.size());
     for (size_t i = 0; i < db_paths_.size(); i++) {
-      mdb_[i].Open(db_paths_[i], i);
+      mdb_[i].Open(db_paths_[i], i, read_ahead_);
       offsets_[i + 1] = offsets_[i] + mdb_[i].GetSize();
     }
     Reset(true);
@@ -45,12 +45,41 @@ might affect accuracy of the training.)code", false)
       R"code(Determines whether the accessed data should be read ahead.
 
 For large files such as LMDB, RecordIO, or TFRecord, this argument slows down the first access but
-decreases the time of all of the following accesses.)code", false)
+decreases the time of all of the following accesses.
+
+For files in S3 storage, the parts of the object that follow the last read are requested
+in the background, so that sequential reads don't pay a full round trip each.)code", false)
   .AddOptionalArg("prefetch_queue_depth",
       R"code(Specifies the number of batches to be prefetched by the internal Loader.
 
 This value should be increased when the pipeline is CPU-stage bound, trading memory
 consumption for better interleaving with the Loader thread.)code", 1)
+  .AddOptionalArg("num_loader_threads",
+      R"code(Number of threads that read the sample data while a batch is being prefetched.
+
+With the default value of 1, the samples are read one after another by the prefetch thread.
+Larger values help when the per-sample latency of the storage (for example, of a network file
+system) dominates. The order of the samples does not depend on this value.
+
+Only the readers which can defer reading the sample contents make use of it,
+other readers ignore this argument.)code", 1)
+  .AddOptionalArg<int64_t>("shared_cache_size",
+      R"code(Size, in bytes, of the node-wide cache of raw samples.
+
+The cache is kept in shared memory and is used by all the readers (in all the processes) on
+the node which use the same ``shared_cache_name``, so the samples read by one of them are
+not read from the storage again - for example, by the other ranks of a multi-GPU job or
+in the subsequent epochs. When the cache is full, new samples are not added to it.
+
+With the default value of 0, the cache is disabled. Only the readers of local files which
+support it (like :meth:`readers.file` and :meth:`readers.tfrecord`) make use of it.)code", 0)
+  .AddOptionalArg("shared_cache_name",
+      R"code(Name of the shared memory object holding the cache enabled with
+``shared_cache_size``.
+
+The readers using the same name share the cached samples. The object is removed when the
+reader is destroyed - the processes which still use it are not affected.)code",
+      "dali_sample_cache")
   .AddOptionalArg("skip_cached_images",
       R"code(If set to True, the loading data will be skipped when the sample is
 in the decoder cache.
@@ -26,15 +26,18 @@
 #include <vector>
 #include <deque>
 #include <atomic>
+#include <functional>
 #include <unordered_set>
 
 #include "dali/core/call_once.h"
 #include "dali/core/nvtx.h"
 #include "dali/core/common.h"
 #include "dali/core/error_handling.h"
+#include "dali/core/metrics.h"
 #include "dali/pipeline/operator/op_spec.h"
 #include "dali/pipeline/data/tensor.h"
 #include "dali/operators/decoder/cache/image_cache_factory.h"
+#include "dali/operators/reader/loader/shared_sample_cache.h"
 
 namespace dali {
 
@@ -52,6 +55,10 @@ struct LoaderStateSnapshot {
   std::default_random_engine rng;
   int current_epoch;
   Index age;
+  // With elastic sharding: the position in the epoch at which the loader started reading it
+  // (non-zero only in an epoch resumed from a checkpoint) and the number of shards reading it
+  Index epoch_start = 0;
+  int num_shards = 1;
 };
 
 /**
@@ -72,6 +79,8 @@ class Loader {
   struct IndexedLoadTargetSharedPtr {
     Index idx;
     LoadTargetSharedPtr ptr;
+    // A handle to read the sample later, if it was skipped (see SkipWithHandle)
+    Index handle = -1;
   };
 
   explicit Loader(const OpSpec& options)
@@ -93,15 +102,33 @@ class Loader {
       pad_last_batch_(options.GetArgument<bool>("pad_last_batch")),
       dont_use_mmap_(options.GetArgument<bool>("dont_use_mmap")),
       checkpointing_(options.GetArgument<bool>("checkpointing")),
-      max_batch_size_(options.GetArgument<int>("max_batch_size")) {
+      max_batch_size_(options.GetArgument<int>("max_batch_size")),
+      num_loader_threads_(options.GetArgument<int>("num_loader_threads")) {
     DALI_ENFORCE(initial_empty_size_ > 0, "Batch size needs to be greater than 0");
+    DALI_ENFORCE(num_loader_threads_ > 0, make_string(
+                 "``num_loader_threads`` must be positive, got ", num_loader_threads_));
     DALI_ENFORCE(num_shards_ > shard_id_, "num_shards needs to be greater than shard_id");
+    auto shared_cache_size = options.GetArgument<int64_t>("shared_cache_size");
+    DALI_ENFORCE(shared_cache_size >= 0, make_string(
+                 "``shared_cache_size`` cannot be negative, got ", shared_cache_size));
+    if (shared_cache_size > 0) {
+      shared_cache_ = GetSharedSampleCache(options.GetArgument<std::string>("shared_cache_name"),
+                                           shared_cache_size);
+    }
     // initialize a random distribution -- this will be
     // used to pick from our sample buffer
     std::seed_seq seq({seed_});
     e_ = std::default_random_engine(seq);
     virtual_shard_id_ = shard_id_;
     last_sample_ptr_tmp = {0, nullptr};
+    if (metrics::Enabled()) {
+      std::string reader = options.SchemaName();
+      if (options.ArgumentDefined("name"))
+        reader = options.GetArgument<std::string>("name");
+      bytes_read_metric_ = metrics::Metric(
+          "dali_loader_read_bytes", metrics::MetricKind::Counter, metrics::Label("reader", reader),
+          "The number of bytes read by the reader; the count is the number of samples.");
+    }
   }
 
   virtual ~Loader() {
@@ -175,6 +202,11 @@ class Loader {
                  "Checkpointing was not enabled. Please make sure you set"
                  " enable_checkpointing to True when creating the pipeline.");
 
+    if (elastic_sharding_) {
+      RestoreElasticState(state);
+      return;
+    }
+
     RestoreEpochState(state);
     SaveStateSnapshot(current_snapshot_);
 
@@ -186,16 +218,19 @@ class Loader {
       Index pos_in_batch = (returned_sample_counter_ + i) % max_batch_size_;
       ReadOne(pos_in_batch == 0, pos_in_batch == max_batch_size_ - 1, [](Index i){ return false; });
     }
-    auto missing = GetMissingSamples();
 
-    // 2. Restore the state and run reading again, this time reading the needed samples.
-    RestoreEpochState(state);
-    for (Index i = 0; i < state.age; i++) {
-      Index pos_in_batch = (returned_sample_counter_ + i) % max_batch_size_;
-      auto filter = [&missing](Index idx) {
-        return missing.find(idx) != missing.end();
-      };
-      ReadOne(pos_in_batch == 0, pos_in_batch == max_batch_size_ - 1, filter);
+    // 2. With random access, read the samples left in the buffer directly. Otherwise, restore
+    //    the state and run reading again, this time reading the needed samples.
+    if (!ReadSkippedSamples()) {
+      auto missing = GetMissingSamples();
+      RestoreEpochState(state);
+      for (Index i = 0; i < state.age; i++) {
+        Index pos_in_batch = (returned_sample_counter_ + i) % max_batch_size_;
+        auto filter = [&missing](Index idx) {
+          return missing.find(idx) != missing.end();
+        };
+        ReadOne(pos_in_batch == 0, pos_in_batch == max_batch_size_ - 1, filter);
+      }
     }
 
     DALI_ENFORCE(GetMissingSamples().empty(), "Internal error: reading missing samples failed");
@@ -212,8 +247,9 @@ class Loader {
     // First part of this condition makes sure that the same number of batches is returned in each
     // shard. Second makes sure that padding is done up to the full batch. For the first sample in
     // the batch is_new_batch is set so it means that padding may be no longer needed
-    return (returned_sample_counter_  < num_samples(num_shards_, Size()) || !is_new_batch) &&
-            pad_last_batch_;
+    Index shard_samples = elastic_sharding_ ? ElasticShardSize(0, consumer_epoch_start_)
+                                            : num_samples(num_shards_, Size());
+    return (returned_sample_counter_ < shard_samples || !is_new_batch) && pad_last_batch_;
   }
 
   // Get a random read sample
@@ -237,6 +273,7 @@ class Loader {
       int skipped_initial_samples = 0;
       for (int i = 0; i < initial_buffer_fill_; ++i) {
         LoadTargetSharedPtr tensor_ptr = nullptr;
+        Index handle = -1;
         if (filter(total_read_sample_counter_)) {
           tensor_ptr = LoadTargetSharedPtr(
             new LoadTarget,
@@ -246,11 +283,12 @@ class Loader {
             });
           PrepareEmpty(*tensor_ptr);
           ReadSample(*tensor_ptr);
+          RecordBytesRead(*tensor_ptr);
         } else {
-          Skip();
+          handle = SkipWithHandle();
           skipped_initial_samples++;
         }
-        sample_buffer_.push_back({total_read_sample_counter_, std::move(tensor_ptr)});
+        sample_buffer_.push_back({total_read_sample_counter_, std::move(tensor_ptr), handle});
         IncreaseReadSampleCounter();
         ++shards_.back().end;
       }
@@ -290,6 +328,7 @@ class Loader {
       // remove shard that was fully consumed
       shards_.pop_front();
       returned_sample_counter_ = 0;
+      consumer_epoch_start_ = 0;
     }
 
     // choose the random index
@@ -301,28 +340,16 @@ class Loader {
 
     std::swap(sample_buffer_[idx], sample_buffer_[shards_.front().start % sample_buffer_.size()]);
     LoadTargetSharedPtr tensor_ptr = nullptr;
+    Index handle = -1;
     if (filter(total_read_sample_counter_)) {
       // now grab an empty tensor, fill it and add to filled buffers
-      // empty_tensors_ needs to be thread-safe w.r.t. RecycleTensor()
-      // being called by multiple consumer threads
-      {
-        std::lock_guard<std::mutex> lock(empty_tensors_mutex_);
-        DALI_ENFORCE(empty_tensors_.size() > 0,
-                     "No empty tensors - did you forget to return them?");
-        tensor_ptr = {
-          empty_tensors_.back().release(),
-          [this](LoadTarget* sample){
-            LoadTargetUniquePtr recycle_ptr(sample);
-            RecycleTensor(std::move(recycle_ptr));
-          }
-        };
-        empty_tensors_.pop_back();
-      }
+      tensor_ptr = TakeEmptyTensor();
       ReadSample(*tensor_ptr);
+      RecordBytesRead(*tensor_ptr);
     } else {
-      Skip();
+      handle = SkipWithHandle();
     }
-    IndexedLoadTargetSharedPtr sample = {total_read_sample_counter_, tensor_ptr};
+    IndexedLoadTargetSharedPtr sample = {total_read_sample_counter_, tensor_ptr, handle};
     IncreaseReadSampleCounter();
     std::swap(sample_buffer_[shards_.back().end % sample_buffer_.size()], sample);
     ++shards_.back().end;
@@ -365,6 +392,29 @@ class Loader {
     ReadSample(*tensor_ptr);
   }
 
+  /**
+   * @brief Skips a sample, like Skip, and returns a handle, with which it can be read later
+   *        by ReadSampleAt.
+   *
+   * Loaders with random access to the samples can override it, together with ReadSampleAt,
+   * so that restoring a checkpoint reads just the samples left in the shuffling buffer instead
+   * of replaying the reads since the beginning of the epoch. The handle must stay valid when
+   * the loader moves to the next epoch or shard.
+   *
+   * @return The handle or -1, if the sample cannot be read out of order.
+   */
+  virtual Index SkipWithHandle() {
+    Skip();
+    return -1;
+  }
+
+  /**
+   * @brief Reads a sample skipped with SkipWithHandle, without changing the loader's position.
+   */
+  virtual void ReadSampleAt(LoadTarget& tensor, Index handle) {
+    DALI_FAIL("This loader cannot read the samples out of order.");
+  }
+
   void PrepareMetadata() {
     if (!loading_flag_) {
       std::lock_guard<std::mutex> l(prepare_metadata_mutex_);
@@ -405,6 +455,35 @@ class Loader {
     return stick_to_shard_;
   }
 
+  int NumLoaderThreads() const {
+    return num_loader_threads_;
+  }
+
+  using DeferredRead = std::function<void()>;
+
+  /**
+   * @brief Returns the reads deferred by ReadSample since the last call.
+   *
+   * The samples are not complete until the returned work is executed. The reads are
+   * independent of each other and can be run concurrently.
+   */
+  std::vector<DeferredRead> TakeDeferredReads() {
+    std::vector<DeferredRead> ret;
+    ret.swap(deferred_reads_);
+    return ret;
+  }
+
+  /**
+   * @brief Copies the samples scheduled with AddToSharedCache to the shared sample cache.
+   *
+   * Must be called when the reads of the samples are complete.
+   */
+  void FlushSharedCache() {
+    for (auto &[key, tensor] : pending_cache_inserts_)
+      shared_cache_->Insert(key, tensor->raw_data(), tensor->nbytes());
+    pending_cache_inserts_.clear();
+  }
+
  protected:
   virtual Index SizeImpl() = 0;
 
@@ -412,6 +491,7 @@ class Loader {
 
   virtual void MoveToNextShard(Index current_index) {
     if (IsNextShard(current_index)) {
+      elastic_start_ = 0;
       Reset(stick_to_shard_);
     }
   }
@@ -424,14 +504,54 @@ class Loader {
   // Method for saving the state to the checkpoint in subclasses
   virtual void SaveStateImpl(LoaderStateSnapshot &state) {}
 
+  // True if ReadSample should leave the actual I/O to the loader threads of the reader
+  bool ShouldDeferReads() const {
+    return num_loader_threads_ > 1;
+  }
+
+  // Schedules the I/O part of ReadSample to be run by one of the reader's loader threads
+  void DeferRead(DeferredRead read) {
+    deferred_reads_.push_back(std::move(read));
+  }
+
+  /**
+   * @brief Wraps the sample from the node-wide shared cache in the tensor, if it's there.
+   *
+   * @return true if the sample was found in the cache
+   */
+  bool ReadFromSharedCache(const std::string &key, Tensor<CPUBackend> &tensor) {
+    if (!shared_cache_)
+      return false;
+    auto data = shared_cache_->Find(key);
+    if (data.empty())
+      return false;
+    // the cached data is never moved nor freed, it's enough to keep the cache alive
+    std::shared_ptr<void> p(shared_cache_, const_cast<uint8_t *>(data.data()));
+    tensor.ShareData(p, data.size(), false, {data.size()}, DALI_UINT8, CPU_ONLY_DEVICE_ID);
+    return true;
+  }
+
+  /**
+   * @brief Schedules the contents of the tensor to be put in the shared cache once the reads
+   *        of the current batch are complete (see FlushSharedCache).
+   */
+  void AddToSharedCache(std::string key, const Tensor<CPUBackend> &tensor) {
+    if (shared_cache_)
+      pending_cache_inserts_.emplace_back(std::move(key), &tensor);
+  }
+
   // Check if given reader moved to the next shard
   virtual inline bool IsNextShard(Index current_index) {
+     if (elastic_sharding_)
+       return current_index >= ElasticShardSize(shard_id_, elastic_start_);
      return current_index >= Size() ||
             (stick_to_shard_ && shard_id_ + 1 < num_shards_ &&
             current_index >= static_cast<Index>(start_index(shard_id_ + 1, num_shards_, Size())));
   }
 
   inline bool IsNextShardRelative(Index already_read, int virtual_shard_id) {
+     if (elastic_sharding_)
+       return already_read >= ElasticShardSize(shard_id_, read_epoch_start_);
      Index current_index = already_read
                          + static_cast<Index>(start_index(virtual_shard_id, num_shards_, Size()));
      return current_index >= Size() ||
@@ -448,6 +568,7 @@ class Loader {
         ++virtual_shard_id_;
       }
       read_sample_counter_ = 1;
+      read_epoch_start_ = 0;
       if (virtual_shard_id_ == num_shards_) {
         virtual_shard_id_ = 0;
       }
@@ -460,6 +581,28 @@ class Loader {
     snapshot.rng = e_;
     snapshot.current_epoch = consumer_epoch_;
     snapshot.age = 0;
+    snapshot.epoch_start = 0;
+    snapshot.num_shards = num_shards_;
+  }
+
+  /**
+   * @brief Elastic sharding: the number of samples read by the given shard in an epoch, which is
+   *        started at the given position.
+   */
+  Index ElasticShardSize(int shard_id, Index epoch_start) {
+    Index remaining = Size() - epoch_start - shard_id;
+    return remaining > 0 ? (remaining + num_shards_ - 1) / num_shards_ : 0;
+  }
+
+  /**
+   * @brief Elastic sharding: the position in the epoch (i.e. in the order of the whole dataset)
+   *        of the given sample of this shard.
+   *
+   * The shards take the samples in turns, so, as long as they read at the same pace, the samples
+   * consumed by all the shards form a prefix of the epoch, regardless of the number of shards.
+   */
+  Index ElasticPosition(Index shard_sample) const {
+    return elastic_start_ + shard_id_ + shard_sample * num_shards_;
   }
 
 
@@ -478,6 +621,28 @@ class Loader {
     return cache_ && cache_->IsCached(key);
   }
 
+  /**
+   * @brief Restores the state saved with elastic sharding, possibly with a different number
+   *        of shards.
+   *
+   * The epoch is resumed at the position reached by all the shards, which read the rest of it
+   * in turns, just like a whole epoch.
+   */
+  void RestoreElasticState(const LoaderStateSnapshot &state) {
+    LoaderStateSnapshot epoch_state = state;
+    Index start = state.epoch_start + state.age * state.num_shards;
+    if (ElasticShardSize(shard_id_, start) == 0) {
+      // nothing left for this shard - it starts the next epoch
+      epoch_state.current_epoch++;
+      start = 0;
+    }
+    epoch_state.age = 0;
+    elastic_start_ = read_epoch_start_ = consumer_epoch_start_ = start;
+    RestoreEpochState(epoch_state);
+    SaveStateSnapshot(current_snapshot_);
+    current_snapshot_.epoch_start = start;
+  }
+
   // Restores state from snapshot, ignoring its age.
   void RestoreEpochState(const LoaderStateSnapshot &state) {
     e_ = state.rng;
@@ -497,6 +662,33 @@ class Loader {
     Reset(true);
   }
 
+  /**
+   * @brief Reads the skipped samples present in the buffer with ReadSampleAt.
+   *
+   * @return false (and nothing is read) if any of those samples has no handle.
+   */
+  bool ReadSkippedSamples() {
+    bool has_last = initial_buffer_filled_ && !last_sample_ptr_tmp.ptr;
+    if (has_last && last_sample_ptr_tmp.handle < 0)
+      return false;
+    for (auto &sample : sample_buffer_) {
+      if (!sample.ptr && sample.handle < 0)
+        return false;
+    }
+    auto read = [&](IndexedLoadTargetSharedPtr &sample) {
+      sample.ptr = TakeEmptyTensor();
+      ReadSampleAt(*sample.ptr, sample.handle);
+      RecordBytesRead(*sample.ptr);
+    };
+    for (auto &sample : sample_buffer_) {
+      if (!sample.ptr)
+        read(sample);
+    }
+    if (has_last)
+      read(last_sample_ptr_tmp);
+    return true;
+  }
+
   /* Returns indices of samples present in the buffer but with no content read. */
   std::unordered_set<Index> GetMissingSamples() {
     std::unordered_set<Index> missing;
@@ -573,8 +765,18 @@ class Loader {
   // The epoch number the next returned sample belongs to,
   // tracked only if checkpointing is enabled
   int consumer_epoch_ = 0;
+  // If true, the shards take the samples of the epoch in turns, instead of reading contiguous
+  // parts of it, so that the checkpoint can be restored with a different number of shards.
+  // Only the loaders which read the samples at ElasticPosition support it.
+  bool elastic_sharding_ = false;
   // Batch size
   int max_batch_size_;
+  // Number of threads the reader uses to run the deferred reads
+  int num_loader_threads_;
+  std::vector<DeferredRead> deferred_reads_;
+  // Node-wide cache of the raw samples, shared by the readers of all the processes
+  std::shared_ptr<SharedSampleCache> shared_cache_;
+  std::vector<std::pair<std::string, const Tensor<CPUBackend> *>> pending_cache_inserts_;
   // Number of data shards that were actually read by the reader
   // TODO(skarpinski) Make it private to prevent ReadSample from depending on it
   int virtual_shard_id_;
@@ -589,11 +791,43 @@ class Loader {
   std::deque<ShardBoundaries> shards_;
 
  private:
+  /** Takes a tensor from the empty pile; the tensor returns there when released. */
+  LoadTargetSharedPtr TakeEmptyTensor() {
+    // empty_tensors_ needs to be thread-safe w.r.t. RecycleTensor()
+    // being called by multiple consumer threads
+    std::lock_guard<std::mutex> lock(empty_tensors_mutex_);
+    DALI_ENFORCE(empty_tensors_.size() > 0,
+                 "No empty tensors - did you forget to return them?");
+    LoadTargetSharedPtr tensor_ptr = {
+      empty_tensors_.back().release(),
+      [this](LoadTarget* sample){
+        LoadTargetUniquePtr recycle_ptr(sample);
+        RecycleTensor(std::move(recycle_ptr));
+      }
+    };
+    empty_tensors_.pop_back();
+    return tensor_ptr;
+  }
+
+  /** Adds the size of the sample to the metrics; the deferred reads are counted when deferred. */
+  void RecordBytesRead(const LoadTarget &target) {
+    if constexpr (std::is_same_v<LoadTarget, Tensor<CPUBackend>> ||
+                  std::is_same_v<LoadTarget, Tensor<GPUBackend>>)
+      bytes_read_metric_.Add(target.nbytes());
+  }
+
+  // Registered only if the metrics are enabled when the loader is created
+  metrics::Metric bytes_read_metric_;
   bool initial_buffer_filled_ = false;
   // Counts how many samples the reader have read already from this epoch
   Index read_sample_counter_ = 0;
   // Counts how many samples the reader has read already from all epochs
   Index total_read_sample_counter_ = 0;
+  // Elastic sharding: the positions at which the epochs being read (by the derived loader and
+  // by ReadOne) and consumed were started
+  Index elastic_start_ = 0;
+  Index read_epoch_start_ = 0;
+  Index consumer_epoch_start_ = 0;
 
   LoaderStateSnapshot current_snapshot_;
 };
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 #include "dali/core/common.h"
@@ -62,6 +64,34 @@ TYPED_TEST(DataLoadStoreTest, LMDBTest) {
     auto sample = reader->ReadOne(false, false);
   }
 }
+
+TYPED_TEST(DataLoadStoreTest, LMDBDeferredReads) {
+  auto make_spec = [](int num_loader_threads) {
+    return OpSpec("CaffeReader")
+        .AddArg("max_batch_size", 32)
+        .AddArg("path", testing::dali_extra_path() + "/db/c2lmdb/")
+        .AddArg("device_id", 0)
+        .AddArg("read_ahead", true)
+        .AddArg("num_loader_threads", num_loader_threads);
+  };
+  shared_ptr<dali::LMDBLoader> reader(new LMDBLoader(make_spec(4)));
+  shared_ptr<dali::LMDBLoader> ref_reader(new LMDBLoader(make_spec(1)));
+  reader->PrepareMetadata();
+  ref_reader->PrepareMetadata();
+
+  for (int i = 0; i < 10; i++) {
+    auto sample = reader->ReadOne(i == 0, false);
+    auto ref_sample = ref_reader->ReadOne(i == 0, false);
+    EXPECT_TRUE(ref_reader->TakeDeferredReads().empty());
+    auto reads = reader->TakeDeferredReads();
+    ASSERT_FALSE(reads.empty());
+    for (auto &read : reads)
+      read();
+    ASSERT_EQ(sample->shape(), ref_sample->shape());
+    EXPECT_EQ(sample->GetSourceInfo(), ref_sample->GetSourceInfo());
+    EXPECT_EQ(std::memcmp(sample->raw_data(), ref_sample->raw_data(), sample->nbytes()), 0);
+  }
+}
 #endif
 
 TYPED_TEST(DataLoadStoreTest, FileLabelLoaderMmmap) {
@@ -81,6 +111,36 @@ TYPED_TEST(DataLoadStoreTest, FileLabelLoaderMmmap) {
   }
 }
 
+TYPED_TEST(DataLoadStoreTest, FileLabelLoaderDeferredReads) {
+  auto make_spec = [](int num_loader_threads) {
+    return OpSpec("FileReader")
+        .AddArg("file_root", loader_test_image_folder)
+        .AddArg("max_batch_size", 32)
+        .AddArg("device_id", 0)
+        .AddArg("dont_use_mmap", true)
+        .AddArg("num_loader_threads", num_loader_threads);
+  };
+  shared_ptr<dali::FileLabelLoader> reader(new FileLabelLoader(make_spec(4), false));
+  shared_ptr<dali::FileLabelLoader> ref_reader(new FileLabelLoader(make_spec(1), false));
+  reader->PrepareMetadata();
+  ref_reader->PrepareMetadata();
+
+  for (int i = 0; i < 10; i++) {
+    auto sample = reader->ReadOne(i == 0, false);
+    auto ref_sample = ref_reader->ReadOne(i == 0, false);
+    EXPECT_TRUE(ref_reader->TakeDeferredReads().empty());
+    auto reads = reader->TakeDeferredReads();
+    ASSERT_FALSE(reads.empty());
+    for (auto &read : reads)
+      read();
+    ASSERT_EQ(sample->image.shape(), ref_sample->image.shape());
+    EXPECT_EQ(sample->image.GetSourceInfo(), ref_sample->image.GetSourceInfo());
+    EXPECT_EQ(sample->label, ref_sample->label);
+    EXPECT_EQ(std::memcmp(sample->image.raw_data(), ref_sample->image.raw_data(),
+                          sample->image.nbytes()), 0);
+  }
+}
+
 TYPED_TEST(DataLoadStoreTest, RecordIOLoaderMmmap) {
   for (bool dont_use_mmap : {true, false}) {
     std::vector<std::string> path =  {testing::dali_extra_path() + "/db/recordio/train.rec"};
@@ -306,4 +366,77 @@ TEST(LoaderCheckpointingTest, TestCheckpointShortEpoch) {
   32);
 }
 
+/* Reads the positions of the samples in the epoch (see Loader::ElasticPosition) */
+class ElasticCountingLoader : public Loader<CPUBackend, Tensor<CPUBackend>, true> {
+ public:
+  ElasticCountingLoader(const OpSpec& spec, Index size) :
+    Loader<CPUBackend, Tensor<CPUBackend>, true>(spec), size_(size) {
+    elastic_sharding_ = true;
+  }
+
+  void ReadSample(Tensor<CPUBackend> &t) override {
+    t.Resize({1}, DALI_INT64);
+    *t.mutable_data<int64_t>() = ElasticPosition(counter_++);
+    MoveToNextShard(counter_);
+  }
+
+  Index SizeImpl() override {
+    return size_;
+  }
+
+  void Reset(bool wrap_to_shard) override {
+    counter_ = 0;
+  }
+
+  int64_t ReadInt() {
+    return *ReadOne(false, false)->data<int64_t>();
+  }
+
+ private:
+  Index size_;
+  Index counter_ = 0;
+};
+
+TEST(LoaderCheckpointingTest, TestElasticSharding) {
+  constexpr int kSize = 23;
+  auto make_loaders = [&](int num_shards) {
+    std::vector<std::unique_ptr<ElasticCountingLoader>> loaders;
+    for (int i = 0; i < num_shards; i++) {
+      auto spec = OpSpec("FileReader")
+                    .AddArg("device_id", 0)
+                    .AddArg("max_batch_size", 4)
+                    .AddArg("seed", 123)
+                    .AddArg("checkpointing", true)
+                    .AddArg("num_shards", num_shards)
+                    .AddArg("shard_id", i);
+      loaders.push_back(InitLoader<ElasticCountingLoader>(spec, kSize));
+    }
+    return loaders;
+  };
+
+  std::vector<int> read(kSize, 0);
+  auto loaders = make_loaders(3);
+  for (int i = 0; i < 5; i++) {
+    for (auto &loader : loaders)
+      read[loader->ReadInt()]++;
+  }
+  auto snapshot = loaders[0]->GetStateSnapshot();
+
+  // the checkpoint of any of the shards resumes the epoch with a different number of shards
+  auto resumed = make_loaders(4);
+  for (auto &loader : resumed)
+    loader->RestoreStateFromSnapshot(snapshot);
+  for (int i = 0; i < 2; i++) {
+    for (auto &loader : resumed)
+      read[loader->ReadInt()]++;
+  }
+  EXPECT_EQ(std::count(read.begin(), read.end(), 1), kSize);
+
+  // the shards which depleted the epoch start the next one
+  auto next_epoch = resumed[0]->GetStateSnapshot();
+  EXPECT_EQ(next_epoch.current_epoch, 1);
+  EXPECT_EQ(next_epoch.epoch_start, 0);
+  EXPECT_EQ(resumed[3]->ReadInt(), 3);
+}
+
 };  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <string>
+#include <iterator>
 #include <numeric>
 #include "dali/core/common.h"
 #include "dali/core/error_handling.h"
@@ -30,12 +31,26 @@ namespace dali {
 
 namespace detail {
 
-void ParseManifest(std::vector<NemoAsrEntry> &entries, std::istream& manifest_file,
-                   double min_duration, double max_duration, bool read_text) {
-  std::string line;
+namespace {
+
+// the smallest part of a manifest worth parsing in a separate thread
+constexpr size_t kMinManifestChunk = 1 << 20;
+
+/**
+ * @brief Parses the lines in [begin, end) - the parsing is done in situ, so the lines are
+ *        overwritten.
+ *
+ * The indices of the entries start at 0.
+ */
+void ParseManifestLines(std::vector<NemoAsrEntry> &entries, char *begin, char *end,
+                        double min_duration, double max_duration, bool read_text) {
   int64_t index = 0;
-  while (std::getline(manifest_file, line)) {
-    detail::LookaheadParser parser(const_cast<char*>(line.c_str()));
+  while (begin < end) {
+    char *line = begin;
+    char *line_end = std::find(begin, end, '\n');
+    *line_end = '\0';  // the buffer has a terminator past `end`
+    begin = line_end + 1;
+    detail::LookaheadParser parser(line);
     if (parser.PeekType() != kObjectType) {
       DALI_WARN(make_string("Skipping invalid manifest line: ", line));
       continue;
@@ -71,6 +86,48 @@ void ParseManifest(std::vector<NemoAsrEntry> &entries, std::istream& manifest_fi
   }
 }
 
+}  // namespace
+
+void ParseManifest(std::vector<NemoAsrEntry> &entries, std::istream& manifest_file,
+                   double min_duration, double max_duration, bool read_text, int num_threads) {
+  std::string content{std::istreambuf_iterator<char>(manifest_file),
+                      std::istreambuf_iterator<char>()};
+  content.reserve(content.size() + kJsonPadding);
+  char *begin = &content[0], *end = begin + content.size();
+  int num_chunks = std::max<int>(1, std::min<size_t>(num_threads,
+                                                     content.size() / kMinManifestChunk));
+  if (num_chunks == 1) {
+    ParseManifestLines(entries, begin, end, min_duration, max_duration, read_text);
+    return;
+  }
+
+  // the chunks are split at line boundaries
+  std::vector<char *> bounds(num_chunks + 1, end);
+  bounds[0] = begin;
+  for (int i = 1; i < num_chunks; i++) {
+    char *split = std::max(bounds[i - 1], begin + content.size() * i / num_chunks);
+    split = std::find(split, end, '\n');
+    bounds[i] = split == end ? end : split + 1;
+  }
+  std::vector<std::vector<NemoAsrEntry>> chunk_entries(num_chunks);
+  ThreadPool tp(num_chunks, CPU_ONLY_DEVICE_ID, false, "NEMO ASR manifest");
+  for (int i = 0; i < num_chunks; i++) {
+    tp.AddWork([&, i](int) {
+      ParseManifestLines(chunk_entries[i], bounds[i], bounds[i + 1],
+                         min_duration, max_duration, read_text);
+    });
+  }
+  tp.RunAll();
+
+  int64_t index = 0;
+  for (auto &chunk : chunk_entries) {
+    for (auto &entry : chunk) {
+      entry.index = index++;
+      entries.emplace_back(std::move(entry));
+    }
+  }
+}
+
 }  // namespace detail
 
 void NemoAsrLoader::PrepareMetadataImpl() {
@@ -78,7 +135,8 @@ void NemoAsrLoader::PrepareMetadataImpl() {
     std::ifstream fstream(manifest_filepath);
     DALI_ENFORCE(fstream,
                  make_string("Could not open NEMO ASR manifest file: \"", manifest_filepath, "\""));
-    detail::ParseManifest(entries_, fstream, min_duration_, max_duration_, read_text_);
+    detail::ParseManifest(entries_, fstream, min_duration_, max_duration_, read_text_,
+                          num_threads_);
   }
   shuffled_indices_.resize(entries_.size());
   std::iota(shuffled_indices_.begin(), shuffled_indices_.end(), 0);
@@ -120,31 +178,30 @@ void NemoAsrLoader::ReadAudio(SampleView<CPUBackend> audio,
                               AudioDecoderBase &decoder,
                               std::vector<float> &decode_scratch,
                               std::vector<float> &resample_scratch) {
-  bool should_resample = sample_rate_ > 0 && audio_meta.sample_rate != sample_rate_;
-  bool should_downmix = audio_meta.channels > 1 && downmix_;
-
-  int64_t decode_scratch_sz = 0;
-  if (should_resample || should_downmix)
-    decode_scratch_sz = audio_meta.length * audio_meta.channels;
-  decode_scratch.resize(decode_scratch_sz);
-
-  // resample scratch is used to prepare a single or multiple (depending if
-  // downmixing is needed) channel float input, required by the resampling
-  // kernel
-  int64_t resample_scratch_sz = 0;
-  if (should_resample)
-    resample_scratch_sz =
-        should_downmix ? audio_meta.length : audio_meta.length * audio_meta.channels;
-  resample_scratch.resize(resample_scratch_sz);
-
   DecodeAudio<OutputType>(
     view<OutputType>(audio), decoder, audio_meta, resampler_,
-    {decode_scratch.data(), decode_scratch_sz},
-    {resample_scratch.data(), resample_scratch_sz},
+    decode_scratch, resample_scratch,
     sample_rate_, downmix_,
     entry.audio_filepath.c_str());
 }
 
+AudioMetadata NemoAsrLoader::GetAudioMetadata(const NemoAsrEntry &entry,
+                                              AudioDecoderBase &decoder) {
+  // Segments usually come in many per file - their file is opened only once. Whole files are
+  // not cached, to keep the cache small.
+  bool is_segment = entry.offset > 0 || entry.duration > 0;
+  if (is_segment) {
+    auto it = segment_file_meta_.find(entry.audio_filepath);
+    if (it != segment_file_meta_.end())
+      return it->second;
+  }
+  auto meta = decoder.OpenFromFile(entry.audio_filepath);
+  decoder.Close();  // avoid keeping too many files open at the same time.
+  if (is_segment)
+    segment_file_meta_.emplace(entry.audio_filepath, meta);
+  return meta;
+}
+
 void NemoAsrLoader::ReadSample(AsrSample& sample) {
   auto &entry = entries_[shuffled_indices_[current_index_]];
 
@@ -161,7 +218,7 @@ void NemoAsrLoader::ReadSample(AsrSample& sample) {
   bool use_resampling = sample_rate_ > 0;
   sample.decoder_ = make_generic_audio_decoder();
 
-  auto &meta = sample.audio_meta_ = sample.decoder().OpenFromFile(entry.audio_filepath);
+  auto &meta = sample.audio_meta_ = GetAudioMetadata(entry, sample.decoder());
   assert(meta.channels_interleaved);  // it's always true
 
   int64_t offset, length;
@@ -172,7 +229,6 @@ void NemoAsrLoader::ReadSample(AsrSample& sample) {
 
   sample.shape_ = DecodedAudioShape(meta, sample_rate_, downmix_);
   assert(sample.shape_.size() > 0);
-  sample.decoder().Close();  // avoid keeping too many files open at the same time.
 
   TYPE_SWITCH(dtype_, type2id, OutputType, (int16_t, int32_t, float), (
     // Audio decoding will be run in the prefetch function, once the batch is formed
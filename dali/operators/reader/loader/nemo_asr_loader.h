@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -20,6 +20,7 @@
 #include <istream>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -99,11 +100,14 @@ namespace detail {
  * @param max_duration Maximum audio duration, in seconds. Longer samples will be filtered out.
  * @param read_text If True, the parser will read the text transcript from the manifest.
  *                  If False, the text field is ignored.
+ * @param num_threads The number of threads used to parse a big manifest - it is split into
+ *                    chunks of whole lines. The order of the entries doesn't depend on it.
  */
 DLL_PUBLIC void ParseManifest(std::vector<NemoAsrEntry> &entries, std::istream &manifest_file,
                               double min_duration = kDefaultDuration,
                               double max_duration = kDefaultDuration,
-                              bool read_text = true);
+                              bool read_text = true,
+                              int num_threads = 1);
 
 }  // namespace detail
 
@@ -167,9 +171,16 @@ class DLL_PUBLIC NemoAsrLoader : public Loader<CPUBackend, AsrSample, true> {
                  std::vector<float> &decode_scratch,
                  std::vector<float> &resample_scratch);
 
+  /**
+   * @brief Returns the metadata of the whole audio file of the entry.
+   */
+  AudioMetadata GetAudioMetadata(const NemoAsrEntry &entry, AudioDecoderBase &decoder);
+
   std::vector<std::string> manifest_filepaths_;
   std::vector<NemoAsrEntry> entries_;
   std::vector<size_t> shuffled_indices_;
+  // the metadata of the files that contain the segments read so far
+  std::unordered_map<std::string, AudioMetadata> segment_file_meta_;
 
   bool shuffle_after_epoch_;
   Index current_index_ = 0;
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -135,6 +135,31 @@ void tempfile(std::string& filename, std::string content = "") {
   close(fd);
 }
 
+TEST(NemoAsrLoaderTest, ParseManifestParallel) {
+  // big enough to be split into several chunks
+  std::stringstream ss;
+  int n = 50000;
+  for (int i = 0; i < n; i++) {
+    ss << "{\"audio_filepath\": \"path/to/audio" << i % 17 << ".wav\", "
+       << "\"duration\": " << (i % 10) * 0.5 << ", \"offset\": " << i << ", "
+       << "\"text\": \"sample " << i << "\"}\n";
+    if (i % 10000 == 0)
+      ss << "not json\n";
+  }
+  std::vector<NemoAsrEntry> ref, entries;
+  detail::ParseManifest(ref, ss, 1.0, 4.0);
+  ss.clear();
+  ss.seekg(0);
+  detail::ParseManifest(entries, ss, 1.0, 4.0, true, 4);
+  ASSERT_EQ(ref.size(), entries.size());
+  for (size_t i = 0; i < ref.size(); i++) {
+    EXPECT_EQ(ref[i].audio_filepath, entries[i].audio_filepath);
+    EXPECT_EQ(ref[i].offset, entries[i].offset);
+    EXPECT_EQ(ref[i].text, entries[i].text);
+    EXPECT_EQ(static_cast<int64_t>(i), entries[i].index);
+  }
+}
+
 TEST(NemoAsrLoaderTest, ParseManifestContent) {
   std::string manifest_filepath =
       "/tmp/nemo_asr_manifest_XXXXXX";  // XXXXXX is replaced in tempfile()
@@ -50,13 +50,19 @@ void NumpyHeaderCache::UpdateCache(const string &file_name, const numpy::HeaderD
 }  // namespace detail
 
 void NumpyLoader::ReadSample(NumpyFileWrapper& target) {
-  const auto& entry = file_entries_[current_index_++];
-  auto filename = entry.filename;
-  auto size = entry.size;
+  // copy the entry - the wrap-around can reorder them
+  auto entry = file_entries_[current_index_++];
 
   // handle wrap-around
   MoveToNextShard(current_index_);
 
+  ReadEntry(target, entry);
+}
+
+void NumpyLoader::ReadEntry(NumpyFileWrapper& target, const FileLabelEntry& entry) {
+  auto filename = entry.filename;
+  auto size = entry.size;
+
   // metadata info
   DALIMeta meta;
   meta.SetSourceInfo(filename);
@@ -104,6 +110,8 @@ void NumpyLoader::ReadSample(NumpyFileWrapper& target) {
   target.data_offset = header.data_offset;
   target.nbytes = nbytes;
   target.filename = std::move(path);
+  target.roi_applied = false;
+  target.roi_ranges.clear();
 
   if (!opts.use_mmap || !current_file->CanMemoryMap()) {
     target.current_file = std::move(current_file);
@@ -122,8 +130,4 @@ void NumpyLoader::ReadSample(NumpyFileWrapper& target) {
   target.fortran_order = header.fortran_order;
 }
 
-void NumpyLoader::Skip() {
-  MoveToNextShard(++current_index_);
-}
-
 }  // namespace dali
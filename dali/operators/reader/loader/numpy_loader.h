@@ -48,6 +48,10 @@ struct NumpyFileWrapper {
   DALIMeta meta = {};
   size_t nbytes = 0;
   bool fortran_order = false;
+  // if set, only the region of interest is read - the ranges of the file to read and
+  // the shape of the region replace the full array
+  bool roi_applied = false;
+  std::vector<numpy::FileRange> roi_ranges;
   std::unique_ptr<FileStream> current_file = {};
 
   DALIDataType get_type() const {
@@ -100,9 +104,19 @@ class NumpyLoader : public FileLoader<CPUBackend, NumpyFileWrapper> {
 
   // we want to make it possible to override this function as well
   void ReadSample(NumpyFileWrapper& target) override;
-  void Skip() override;
+
+  Index SkipWithHandle() override {
+    return SkipWithIndex();
+  }
+
+  void ReadSampleAt(NumpyFileWrapper& target, Index handle) override {
+    ReadEntry(target, file_entries_[handle]);
+  }
 
  private:
+  void ReadEntry(NumpyFileWrapper& target, const FileLabelEntry& entry);
+
+
   detail::NumpyHeaderCache header_cache_;
   bool use_o_direct_;
   size_t o_direct_alignm_ = 0;
@@ -89,6 +89,8 @@ void NumpyLoaderGPU::ReadSample(NumpyFileWrapperGPU& target) {
   // set metadata
   target.meta = meta;
   target.read_ahead = read_ahead_;
+  target.roi_applied = false;
+  target.roi_ranges.clear();
 }
 
 }  // namespace dali
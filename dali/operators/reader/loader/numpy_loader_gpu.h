@@ -50,6 +50,9 @@ struct NumpyFileWrapperGPU {
   DALIDataType type;
   DALIMeta meta;
   int source_sample_idx = -1;
+  // see NumpyFileWrapper
+  bool roi_applied = false;
+  std::vector<numpy::FileRange> roi_ranges;
 
   std::unique_ptr<CUFileStream> file_stream_;
   bool read_ahead = false;
@@ -83,6 +83,13 @@ class RecordIOLoader : public IndexedFileLoader {
     index_file.close();
   }
 
+  // The records can span several files, which are read one after another - the records cannot
+  // be read out of order.
+  Index SkipWithHandle() override {
+    Skip();
+    return -1;
+  }
+
   void ReadSample(IndexedFileLoaderSample& sample) override {
     // if we moved to next shard wrap up
     MoveToNextShard(current_index_);
@@ -13,9 +13,12 @@
 // limitations under the License.
 
 #include <glob.h>
+#include <sys/stat.h>
 #include <algorithm>
 #include <map>
+#include "dali/core/call_at_exit.h"
 #include "dali/core/common.h"
+#include "dali/core/mm/memory.h"
 #include "dali/operators/decoder/image/image.h"
 #include "dali/operators/reader/loader/sequence_loader.h"
 #include "dali/operators/reader/loader/utils.h"
@@ -104,8 +107,6 @@ void SequenceLoader::PrepareEmpty(TensorSequence &sequence) {
 void SequenceLoader::ReadSample(TensorSequence &sequence) {
   // TODO(klecki) this is written as a prototype for video handling
   const auto &sequence_paths = sequences_[current_sequence_];
-  // TODO(klecki) we probably should buffer the "stream", or recently used
-  // frames
   for (int i = 0; i < sequence_length_; i++) {
     LoadFrame(sequence_paths, i, &sequence.tensors[i]);
   }
@@ -138,28 +139,87 @@ void SequenceLoader::LoadFrame(const std::vector<std::string> &s, Index frame_id
     return;
   }
 
+  if (frame_cache_size_ > 0) {
+    auto it = frame_cache_index_.find(frame_filename);
+    if (it != frame_cache_index_.end()) {
+      frame_cache_.splice(frame_cache_.begin(), frame_cache_, it->second);
+      const auto &cached = it->second->second;
+      target->ShareData(cached.data, cached.size, false, {cached.size}, DALI_UINT8,
+                        CPU_ONLY_DEVICE_ID);
+      target->SetMeta(meta);
+      return;
+    }
+  }
+
   FileStream::Options opts;
   opts.read_ahead = read_ahead_;
   opts.use_mmap = !copy_read_data_;
   opts.use_odirect = false;
+
+  if (copy_read_data_ && ShouldDeferReads()) {
+    // The frames are read by the reader's loader threads, in parallel
+    struct stat st;
+    DALI_ENFORCE(stat(frame_filename.c_str(), &st) == 0,
+                 make_string("Failed to read file: ", frame_filename));
+    Index frame_size = st.st_size;
+    auto *data = AllocateFrame(frame_filename, frame_size, target);
+    target->SetMeta(meta);
+    DeferRead([data, frame_size, frame_filename, opts]() {
+      auto frame = FileStream::Open(frame_filename, opts);
+      auto frame_cleanup = AtScopeExit([&frame] {
+        frame->Close();
+      });
+      Index ret = frame->Read(data, frame_size);
+      DALI_ENFORCE(ret == frame_size, make_string("Failed to read file: ", frame_filename));
+    });
+    return;
+  }
+
   auto frame = FileStream::Open(frame_filename, opts);
   Index frame_size = frame->Size();
   // Release and unmap memory previously obtained by Get call
   if (copy_read_data_ || !frame->CanMemoryMap()) {
-    if (target->shares_data()) {
-      target->Reset();
-    }
-    target->Resize({frame_size}, DALI_UINT8);
-    Index ret = frame->Read(target->mutable_data<uint8_t>(), frame_size);
+    auto *data = AllocateFrame(frame_filename, frame_size, target);
+    Index ret = frame->Read(data, frame_size);
     DALI_ENFORCE(ret == frame_size, make_string("Failed to read file: ", frame_filename));
   } else {
     auto p = frame->Get(frame_size);
     DALI_ENFORCE(p != nullptr, make_string("Failed to read file: ", frame_filename));
     // Wrap the raw data in the Tensor object.
     target->ShareData(p, frame_size, false, {frame_size}, DALI_UINT8, CPU_ONLY_DEVICE_ID);
+    CacheFrame(frame_filename, std::move(p), frame_size);
   }
   target->SetMeta(meta);
   frame->Close();
 }
 
+uint8_t *SequenceLoader::AllocateFrame(const std::string &path, Index size,
+                                       Tensor<CPUBackend> *target) {
+  if (frame_cache_size_ == 0 || size == 0) {
+    if (target->shares_data()) {
+      target->Reset();
+    }
+    target->Resize({size}, DALI_UINT8);
+    return target->mutable_data<uint8_t>();
+  }
+  // The cached frame is complete by the time it's used by another sequence - the deferred reads
+  // of the whole batch are run before the batch is parsed.
+  auto buffer = mm::alloc_raw_shared<uint8_t, mm::memory_kind::host>(size);
+  target->ShareData(buffer, size, false, {size}, DALI_UINT8, CPU_ONLY_DEVICE_ID);
+  CacheFrame(path, buffer, size);
+  return buffer.get();
+}
+
+void SequenceLoader::CacheFrame(const std::string &path, std::shared_ptr<void> data,
+                                Index size) {
+  if (frame_cache_size_ == 0)
+    return;
+  frame_cache_.emplace_front(path, CachedFrame{std::move(data), size});
+  frame_cache_index_[path] = frame_cache_.begin();
+  if (static_cast<int>(frame_cache_.size()) > frame_cache_size_) {
+    frame_cache_index_.erase(frame_cache_.back().first);
+    frame_cache_.pop_back();
+  }
+}
+
 }  // namespace dali
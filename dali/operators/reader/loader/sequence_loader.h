@@ -15,8 +15,11 @@
 #ifndef DALI_OPERATORS_READER_LOADER_SEQUENCE_LOADER_H_
 #define DALI_OPERATORS_READER_LOADER_SEQUENCE_LOADER_H_
 
+#include <list>
+#include <memory>
 #include <numeric>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -91,8 +94,11 @@ class SequenceLoader : public Loader<CPUBackend, TensorSequence, true> {
         sequence_length_(spec.GetArgument<int32_t>("sequence_length")),
         step_(spec.GetArgument<int32_t>("step")),
         stride_(spec.GetArgument<int32_t>("stride")),
+        frame_cache_size_(spec.GetArgument<int>("frame_cache_size")),
         total_size_(0),
         current_sequence_(0) {
+    DALI_ENFORCE(frame_cache_size_ >= 0, make_string(
+                 "``frame_cache_size`` must not be negative, got ", frame_cache_size_));
   }
 
   void PrepareEmpty(TensorSequence &tensor) override;
@@ -141,11 +147,30 @@ class SequenceLoader : public Loader<CPUBackend, TensorSequence, true> {
   int32_t stride_;
   std::vector<filesystem::Stream> streams_;
   std::vector<std::vector<std::string>> sequences_;
+  int frame_cache_size_;
   Index total_size_;
   Index current_sequence_;
   FileStream::MappingReserver mmap_reserver_;
 
+  // The encoded frames read recently, most recent first - the overlapping sequences share them
+  struct CachedFrame {
+    std::shared_ptr<void> data;
+    Index size;
+  };
+  using FrameCache = std::list<std::pair<std::string, CachedFrame>>;
+  FrameCache frame_cache_;
+  std::unordered_map<std::string, FrameCache::iterator> frame_cache_index_;
+
   void LoadFrame(const std::vector<std::string> &s, Index frame, Tensor<CPUBackend> *target);
+
+  /**
+   * @brief Makes `target` the owner of a buffer for an encoded frame of the given size.
+   *
+   * With the frame cache enabled, the buffer is shared with the cache.
+   */
+  uint8_t *AllocateFrame(const std::string &path, Index size, Tensor<CPUBackend> *target);
+
+  void CacheFrame(const std::string &path, std::shared_ptr<void> data, Index size);
 };
 
 }  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2018-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
 
 #include "dali/operators/reader/loader/sequence_loader.h"
 #include "dali/test/dali_test.h"
@@ -88,4 +90,38 @@ TEST(GenerateSequencesTest, Test) {
   ASSERT_EQ(seq_2_2_2, exp_2_2_2);
 }
 
+TEST(SequenceLoaderTest, FrameCacheAndDeferredReads) {
+  auto make_spec = [](int frame_cache_size, int num_loader_threads, bool dont_use_mmap) {
+    return OpSpec("SequenceReader")
+        .AddArg("file_root", testing::dali_extra_path() + "/db/sequence/frames")
+        .AddArg("sequence_length", 5)
+        .AddArg("max_batch_size", 4)
+        .AddArg("device_id", 0)
+        .AddArg("dont_use_mmap", dont_use_mmap)
+        .AddArg("frame_cache_size", frame_cache_size)
+        .AddArg("num_loader_threads", num_loader_threads);
+  };
+  for (bool dont_use_mmap : {true, false}) {
+    auto ref_loader = std::make_shared<SequenceLoader>(make_spec(0, 1, dont_use_mmap));
+    auto loader = std::make_shared<SequenceLoader>(make_spec(8, 4, dont_use_mmap));
+    ref_loader->PrepareMetadata();
+    loader->PrepareMetadata();
+    // more than an epoch, so that some sequences are read both from the storage and the cache
+    for (int i = 0; i < 40; i++) {
+      auto sequence = loader->ReadOne(i == 0, false);
+      auto ref_sequence = ref_loader->ReadOne(i == 0, false);
+      for (auto &read : loader->TakeDeferredReads())
+        read();
+      ASSERT_EQ(sequence->tensors.size(), 5);
+      for (int f = 0; f < 5; f++) {
+        auto &frame = sequence->tensors[f];
+        auto &ref_frame = ref_sequence->tensors[f];
+        ASSERT_EQ(frame.shape(), ref_frame.shape());
+        EXPECT_EQ(frame.GetSourceInfo(), ref_frame.GetSourceInfo());
+        EXPECT_EQ(std::memcmp(frame.raw_data(), ref_frame.raw_data(), frame.nbytes()), 0);
+      }
+    }
+  }
+}
+
 }  // namespace dali
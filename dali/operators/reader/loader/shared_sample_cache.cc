@@ -0,0 +1,214 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/loader/shared_sample_cache.h"
+#include <sys/stat.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/core/util.h"
+
+namespace dali {
+
+namespace {
+
+constexpr uint64_t kMagic = 0x45484341435f4944;  // "DI_CACHE"
+constexpr uint32_t kUninitialized = 0, kInitializing = 1, kReady = 2;
+// a zero-filled slot is empty
+constexpr uint32_t kSlotWriting = 1, kSlotReady = 2, kSlotFailed = 3;
+constexpr size_t kAlignment = 64;
+// the number of slots is chosen for an average sample of this size
+constexpr size_t kExpectedSampleSize = 4096;
+constexpr size_t kMinSlots = 1024;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+              std::atomic<uint32_t>::is_always_lock_free,
+              "The cache needs lock-free atomics to be shared between processes.");
+
+uint64_t key_hash(const std::string &key) {
+  // 0 marks an empty slot
+  return std::hash<std::string>()(key) | 1;
+}
+
+}  // namespace
+
+struct SharedSampleCache::Header {
+  std::atomic<uint32_t> state;
+  uint32_t reserved;
+  uint64_t magic;
+  uint64_t capacity;
+  uint64_t num_slots;
+  uint64_t data_offset;
+  std::atomic<uint64_t> data_end;
+};
+
+struct SharedSampleCache::Slot {
+  std::atomic<uint64_t> hash;
+  std::atomic<uint32_t> state;
+  uint32_t key_size;
+  uint64_t offset;  // the key is stored at offset, followed by the sample data
+  uint64_t size;
+};
+
+SharedSampleCache::SharedSampleCache(const std::string &name, size_t capacity)
+    : name_(name) {
+  size_t num_slots = std::max(kMinSlots, capacity / kExpectedSampleSize);
+  size_t data_offset = align_up(sizeof(Header) + num_slots * sizeof(Slot), kAlignment);
+  DALI_ENFORCE(capacity > data_offset, make_string(
+      "The shared sample cache capacity is too small: ", capacity, " bytes."));
+
+  bool created = false;
+  handle_ = ShmHandle::OpenNamed(name_, &created);
+  if (created) {
+    POSIX_CALL_EX(ftruncate(handle_, capacity), "Failed to resize the shared sample cache.");
+    capacity_ = capacity;
+  } else {
+    // the object exists - it may still be being resized by its creator
+    struct stat st;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    for (;;) {
+      POSIX_CALL(fstat(handle_, &st));
+      if (st.st_size > 0)
+        break;
+      DALI_ENFORCE(std::chrono::steady_clock::now() < deadline, make_string(
+          "Timed out waiting for the shared sample cache \"", name_, "\" to be created."));
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    capacity_ = st.st_size;
+  }
+  mapping_ = MemoryMapping(handle_, capacity_);
+
+  auto *hdr = header();
+  uint32_t expected = kUninitialized;
+  if (hdr->state.compare_exchange_strong(expected, kInitializing)) {
+    // the memory of a new object is zero-filled, so all the slots are already empty
+    hdr->magic = kMagic;
+    hdr->capacity = capacity_;
+    hdr->num_slots = num_slots;
+    hdr->data_offset = data_offset;
+    hdr->data_end.store(data_offset);
+    hdr->state.store(kReady, std::memory_order_release);
+  } else {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (hdr->state.load(std::memory_order_acquire) != kReady) {
+      DALI_ENFORCE(std::chrono::steady_clock::now() < deadline, make_string(
+          "Timed out waiting for the shared sample cache \"", name_, "\" to be initialized."));
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    DALI_ENFORCE(hdr->magic == kMagic && hdr->capacity == capacity_, make_string(
+        "The shared memory object \"", name_, "\" is not a valid sample cache."));
+  }
+}
+
+SharedSampleCache::~SharedSampleCache() {
+  // Removing the name doesn't affect the processes which already use the cache, but it makes
+  // sure that the memory is released when the job ends.
+  mapping_.reset();
+  handle_.reset();
+  try {
+    ShmHandle::Unlink(name_);
+  } catch (const std::exception &e) {
+    DALI_WARN(make_string("Cannot remove the shared sample cache: ", e.what()));
+  }
+}
+
+SharedSampleCache::Header *SharedSampleCache::header() const {
+  return reinterpret_cast<Header *>(const_cast<MemoryMapping &>(mapping_).get_raw_ptr());
+}
+
+SharedSampleCache::Slot *SharedSampleCache::slots() const {
+  return reinterpret_cast<Slot *>(header() + 1);
+}
+
+span<const uint8_t> SharedSampleCache::Find(const std::string &key) const {
+  auto *hdr = header();
+  auto *base = reinterpret_cast<const uint8_t *>(hdr);
+  uint64_t h = key_hash(key);
+  uint64_t n = hdr->num_slots;
+  for (uint64_t i = 0; i < n; i++) {
+    auto &slot = slots()[(h + i) % n];
+    uint64_t slot_hash = slot.hash.load(std::memory_order_acquire);
+    if (slot_hash == 0)
+      return {};
+    if (slot_hash != h || slot.state.load(std::memory_order_acquire) != kSlotReady)
+      continue;
+    if (slot.key_size == key.size() && !memcmp(base + slot.offset, key.data(), key.size()))
+      return {base + slot.offset + slot.key_size, static_cast<span_extent_t>(slot.size)};
+  }
+  return {};
+}
+
+bool SharedSampleCache::Insert(const std::string &key, const void *data, size_t size) {
+  auto *hdr = header();
+  auto *base = reinterpret_cast<uint8_t *>(hdr);
+  uint64_t h = key_hash(key);
+  uint64_t n = hdr->num_slots;
+  for (uint64_t i = 0; i < n; i++) {
+    auto &slot = slots()[(h + i) % n];
+    uint64_t slot_hash = 0;
+    if (!slot.hash.compare_exchange_strong(slot_hash, h)) {
+      if (slot_hash == h) {
+        // Probably the same key, inserted (or being inserted) by another reader - don't wait
+        // for it to finish, just check the key if possible.
+        if (slot.state.load(std::memory_order_acquire) != kSlotReady)
+          return false;
+        if (slot.key_size == key.size() && !memcmp(base + slot.offset, key.data(), key.size()))
+          return false;
+      }
+      continue;
+    }
+    // the slot is ours
+    slot.state.store(kSlotWriting, std::memory_order_relaxed);
+    uint64_t total = align_up(key.size() + size, kAlignment);
+    uint64_t offset = hdr->data_end.load();
+    do {
+      if (offset + total > hdr->capacity) {
+        // no space left - the slot stays occupied, but is never reported as a hit
+        slot.state.store(kSlotFailed, std::memory_order_release);
+        return false;
+      }
+    } while (!hdr->data_end.compare_exchange_weak(offset, offset + total));
+    memcpy(base + offset, key.data(), key.size());
+    memcpy(base + offset + key.size(), data, size);
+    slot.key_size = key.size();
+    slot.offset = offset;
+    slot.size = size;
+    slot.state.store(kSlotReady, std::memory_order_release);
+    return true;
+  }
+  return false;
+}
+
+std::shared_ptr<SharedSampleCache> GetSharedSampleCache(const std::string &name,
+                                                        size_t capacity) {
+  static std::mutex mtx;
+  static std::map<std::string, std::weak_ptr<SharedSampleCache>> caches;
+  std::lock_guard<std::mutex> g(mtx);
+  auto &entry = caches[name];
+  auto cache = entry.lock();
+  if (!cache) {
+    cache = std::make_shared<SharedSampleCache>(name, capacity);
+    entry = cache;
+  }
+  return cache;
+}
+
+}  // namespace dali
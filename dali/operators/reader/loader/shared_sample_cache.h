@@ -0,0 +1,95 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_SHARED_SAMPLE_CACHE_H_
+#define DALI_OPERATORS_READER_LOADER_SHARED_SAMPLE_CACHE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "dali/core/common.h"
+#include "dali/core/os/shared_mem.h"
+#include "dali/core/span.h"
+
+namespace dali {
+
+/**
+ * @brief A cache of raw (encoded) samples, kept in a named POSIX shared memory object,
+ *        so that all the readers on a node - also in different processes - can use it.
+ *
+ * The samples are identified by a string key (e.g. the file path and the offset of the sample
+ * in the file). The cache is append-only: the samples are never evicted nor moved, so the memory
+ * returned by `Find` stays valid for the lifetime of the cache object. When the cache is full,
+ * new samples are simply not inserted.
+ *
+ * Both lookup and insertion are lock-free, so the processes don't need any other means
+ * of synchronization. The first process to open the object initializes it.
+ */
+class DLL_PUBLIC SharedSampleCache {
+ public:
+  /**
+   * @param name      the name of the shared memory object; all the caches opened with the same
+   *                  name (and capacity) share the contents
+   * @param capacity  the total size of the shared memory object, in bytes
+   */
+  SharedSampleCache(const std::string &name, size_t capacity);
+  ~SharedSampleCache();
+
+  SharedSampleCache(const SharedSampleCache &) = delete;
+  SharedSampleCache &operator=(const SharedSampleCache &) = delete;
+
+  /**
+   * @brief Returns the cached data or an empty span, if the sample is not (yet) in the cache.
+   */
+  span<const uint8_t> Find(const std::string &key) const;
+
+  /**
+   * @brief Copies the sample into the cache.
+   *
+   * @return false if the sample is already cached or there's not enough space left.
+   */
+  bool Insert(const std::string &key, const void *data, size_t size);
+
+  const std::string &name() const {
+    return name_;
+  }
+
+  size_t capacity() const {
+    return capacity_;
+  }
+
+ private:
+  struct Header;
+  struct Slot;
+
+  Header *header() const;
+  Slot *slots() const;
+
+  std::string name_;
+  size_t capacity_ = 0;
+  ShmHandle handle_;
+  MemoryMapping mapping_;
+};
+
+/**
+ * @brief Returns the cache with given name, opening it on first use.
+ *
+ * The cache is shared by all the readers in the process and closed when no longer referenced.
+ */
+DLL_PUBLIC std::shared_ptr<SharedSampleCache> GetSharedSampleCache(const std::string &name,
+                                                                   size_t capacity);
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_SHARED_SAMPLE_CACHE_H_
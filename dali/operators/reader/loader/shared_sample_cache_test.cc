@@ -0,0 +1,93 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include "dali/core/format.h"
+#include "dali/operators/reader/loader/shared_sample_cache.h"
+
+namespace dali {
+
+namespace {
+
+std::string unique_cache_name(const char *test_name) {
+  return make_string("dali_test_sample_cache_", test_name, "_", getpid());
+}
+
+std::string as_string(span<const uint8_t> data) {
+  return std::string(reinterpret_cast<const char *>(data.data()), data.size());
+}
+
+}  // namespace
+
+TEST(SharedSampleCacheTest, InsertAndFind) {
+  SharedSampleCache cache(unique_cache_name("InsertAndFind"), 1 << 20);
+  std::string a = "sample a", b = "another sample";
+  EXPECT_TRUE(cache.Find("a").empty());
+  EXPECT_TRUE(cache.Insert("a", a.data(), a.size()));
+  EXPECT_TRUE(cache.Insert("b", b.data(), b.size()));
+  EXPECT_FALSE(cache.Insert("a", b.data(), b.size()));
+  EXPECT_EQ(as_string(cache.Find("a")), a);
+  EXPECT_EQ(as_string(cache.Find("b")), b);
+  EXPECT_TRUE(cache.Find("c").empty());
+}
+
+TEST(SharedSampleCacheTest, SharedBetweenInstances) {
+  auto name = unique_cache_name("SharedBetweenInstances");
+  SharedSampleCache cache1(name, 1 << 20);
+  SharedSampleCache cache2(name, 1 << 20);
+  std::string data = "data";
+  EXPECT_TRUE(cache1.Insert("key", data.data(), data.size()));
+  EXPECT_EQ(as_string(cache2.Find("key")), data);
+  EXPECT_FALSE(cache2.Insert("key", data.data(), data.size()));
+}
+
+TEST(SharedSampleCacheTest, SharedBetweenProcesses) {
+  auto name = unique_cache_name("SharedBetweenProcesses");
+  SharedSampleCache cache(name, 1 << 20);
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    SharedSampleCache child_cache(name, 1 << 20);
+    std::string data = "from the child";
+    bool ok = child_cache.Insert("key", data.data(), data.size());
+    _exit(ok ? 0 : 1);
+  }
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  ASSERT_TRUE(WIFEXITED(status));
+  ASSERT_EQ(WEXITSTATUS(status), 0);
+  EXPECT_EQ(as_string(cache.Find("key")), "from the child");
+}
+
+TEST(SharedSampleCacheTest, Full) {
+  SharedSampleCache cache(unique_cache_name("Full"), 1 << 16);
+  std::vector<char> data(1000, 'x');
+  int inserted = 0;
+  for (int i = 0; i < 1000; i++) {
+    if (cache.Insert(std::to_string(i), data.data(), data.size()))
+      inserted++;
+  }
+  EXPECT_GT(inserted, 0);
+  EXPECT_LT(inserted, 1000);
+  for (int i = 0; i < 1000; i++) {
+    auto found = cache.Find(std::to_string(i));
+    EXPECT_EQ(found.size(), i < inserted ? data.size() : 0u);
+  }
+}
+
+}  // namespace dali
@@ -0,0 +1,96 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_VIDEO_DECODE_STREAMS_H_
+#define DALI_OPERATORS_READER_LOADER_VIDEO_DECODE_STREAMS_H_
+
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/cuda_event.h"
+#include "dali/core/cuda_stream_pool.h"
+
+namespace dali {
+
+/**
+ * @brief The streams of the concurrent video decoding sessions.
+ *
+ * FramesDecoderGpu synchronizes its stream after each decoded frame. When the videos of a batch
+ * are decoded by several threads sharing one stream, the threads wait for each other and only
+ * one NVDEC engine is busy at a time. With a stream per thread, the sessions are independent and
+ * the decoding is spread over all the engines of the GPU.
+ */
+class DecodeStreams {
+ public:
+  DecodeStreams() = default;
+
+  /**
+   * @param num_streams         the number of the sessions, usually the number of threads
+   * @param device_id           the device of the streams
+   * @param use_default_stream  if true, all the sessions use the default stream
+   *                            (a workaround for some drivers)
+   */
+  DecodeStreams(int num_streams, int device_id, bool use_default_stream = false) {
+    if (use_default_stream)
+      num_streams = 1;
+    streams_.resize(num_streams);
+    events_.reserve(num_streams);
+    for (int i = 0; i < num_streams; i++) {
+      if (!use_default_stream)
+        streams_[i] = CUDAStreamPool::instance().Get(device_id);
+      events_.push_back(CUDAEvent::Create(device_id));
+    }
+    ready_ = CUDAEvent::Create(device_id);
+  }
+
+  int size() const {
+    return streams_.size();
+  }
+
+  cudaStream_t operator[](int idx) const {
+    return streams_[idx % streams_.size()];
+  }
+
+  /**
+   * @brief Makes all the sessions wait for the work already scheduled in `stream`
+   */
+  void WaitFor(cudaStream_t stream) {
+    CUDA_CALL(cudaEventRecord(ready_, stream));
+    for (auto &s : streams_)
+      CUDA_CALL(cudaStreamWaitEvent(s, ready_, 0));
+  }
+
+  /**
+   * @brief Makes `stream` wait for the work scheduled in all the sessions
+   */
+  void SignalTo(cudaStream_t stream) {
+    for (size_t i = 0; i < streams_.size(); i++) {
+      CUDA_CALL(cudaEventRecord(events_[i], streams_[i]));
+      CUDA_CALL(cudaStreamWaitEvent(stream, events_[i], 0));
+    }
+  }
+
+  void Synchronize() {
+    for (auto &s : streams_)
+      CUDA_CALL(cudaStreamSynchronize(s));
+  }
+
+ private:
+  std::vector<CUDAStreamLease> streams_;
+  std::vector<CUDAEvent> events_;
+  CUDAEvent ready_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_VIDEO_DECODE_STREAMS_H_
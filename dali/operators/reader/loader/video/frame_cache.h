@@ -0,0 +1,97 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_VIDEO_FRAME_CACHE_H_
+#define DALI_OPERATORS_READER_LOADER_VIDEO_FRAME_CACHE_H_
+
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace dali {
+
+/**
+ * @brief A least recently used cache of the decoded frames of a video.
+ *
+ * Overlapping sequences (e.g. when `step` is smaller than the sequence length) share frames,
+ * so the frames decoded for one sequence can be copied, instead of decoded again, for the next.
+ * The buffers of the evicted frames are reused for the new ones.
+ *
+ * @tparam Buffer the storage of a frame, e.g. DeviceBuffer<uint8_t>
+ */
+template <typename Buffer>
+class FrameCache {
+ public:
+  explicit FrameCache(int capacity = 0) : capacity_(capacity) {}
+
+  int capacity() const {
+    return capacity_;
+  }
+
+  int size() const {
+    return frames_.size();
+  }
+
+  /**
+   * @brief Returns the cached frame, or nullptr if it's not cached
+   */
+  const Buffer *Get(int frame_id) {
+    auto it = index_.find(frame_id);
+    if (it == index_.end())
+      return nullptr;
+    frames_.splice(frames_.begin(), frames_, it->second);
+    return &it->second->second;
+  }
+
+  /**
+   * @brief Returns the buffer to store the given frame in
+   *
+   * If the cache is full, the least recently used frame is evicted and its buffer is returned.
+   * Returns nullptr, if the capacity is 0.
+   */
+  Buffer *Put(int frame_id) {
+    if (capacity_ <= 0)
+      return nullptr;
+    auto it = index_.find(frame_id);
+    if (it != index_.end()) {
+      frames_.splice(frames_.begin(), frames_, it->second);
+      return &it->second->second;
+    }
+    if (static_cast<int>(frames_.size()) < capacity_) {
+      frames_.emplace_front(frame_id, Buffer());
+    } else {
+      auto last = std::prev(frames_.end());
+      index_.erase(last->first);
+      last->first = frame_id;
+      frames_.splice(frames_.begin(), frames_, last);
+    }
+    index_[frame_id] = frames_.begin();
+    return &frames_.front().second;
+  }
+
+  void Clear() {
+    index_.clear();
+    frames_.clear();
+  }
+
+ private:
+  int capacity_ = 0;
+  // the most recently used at the front
+  std::list<std::pair<int, Buffer>> frames_;
+  std::unordered_map<int, typename std::list<std::pair<int, Buffer>>::iterator> index_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_VIDEO_FRAME_CACHE_H_
@@ -0,0 +1,71 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "dali/operators/reader/loader/video/frame_cache.h"
+
+namespace dali {
+
+using Frame = std::vector<int>;
+
+TEST(FrameCacheTest, Disabled) {
+  FrameCache<Frame> cache;
+  EXPECT_EQ(cache.Put(0), nullptr);
+  EXPECT_EQ(cache.Get(0), nullptr);
+}
+
+TEST(FrameCacheTest, GetPut) {
+  FrameCache<Frame> cache(4);
+  for (int i = 0; i < 4; i++)
+    *cache.Put(i) = {i};
+  EXPECT_EQ(cache.size(), 4);
+  for (int i = 0; i < 4; i++) {
+    auto *frame = cache.Get(i);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(*frame, Frame{i});
+  }
+  EXPECT_EQ(cache.Get(4), nullptr);
+}
+
+TEST(FrameCacheTest, EvictsLeastRecentlyUsed) {
+  FrameCache<Frame> cache(3);
+  *cache.Put(0) = {0};
+  *cache.Put(1) = {1};
+  *cache.Put(2) = {2};
+  EXPECT_NE(cache.Get(0), nullptr);
+  // evicts 1 and reuses its buffer
+  auto *frame = cache.Put(3);
+  ASSERT_NE(frame, nullptr);
+  EXPECT_EQ(*frame, Frame{1});
+  *frame = {3};
+  EXPECT_EQ(cache.size(), 3);
+  EXPECT_EQ(cache.Get(1), nullptr);
+  EXPECT_EQ(*cache.Get(0), Frame{0});
+  EXPECT_EQ(*cache.Get(2), Frame{2});
+  EXPECT_EQ(*cache.Get(3), Frame{3});
+}
+
+TEST(FrameCacheTest, PutExisting) {
+  FrameCache<Frame> cache(2);
+  *cache.Put(0) = {0};
+  *cache.Put(1) = {1};
+  EXPECT_EQ(*cache.Put(0), Frame{0});
+  // 1 is the least recently used now
+  *cache.Put(2) = {2};
+  EXPECT_EQ(cache.Get(1), nullptr);
+  EXPECT_NE(cache.Get(0), nullptr);
+}
+
+}  // namespace dali
@@ -509,16 +509,41 @@ void FramesDecoder::Reset() {
   }
 }
 
+bool FramesDecoder::CanDecodeForward(int frame_id) const {
+  // The frame follows the next one, but there's no keyframe between them - decoding forward
+  // is never more work than seeking (to the same keyframe or a previous one)
+  return next_frame_idx_ >= 0 && next_frame_idx_ <= frame_id && frame_id < NumFrames() &&
+         Index(frame_id).last_keyframe_id <= next_frame_idx_;
+}
+
+bool FramesDecoder::DecodeForward(int frame_id) {
+  if (!CanDecodeForward(frame_id))
+    return false;
+  LOG_LINE << "Decoding forward to frame " << frame_id << std::endl;
+  while (next_frame_idx_ < frame_id) {
+    int prev_frame_idx = next_frame_idx_;
+    ReadNextFrame(nullptr, false);
+    // the end of the stream was reached - fall back to seeking
+    if (next_frame_idx_ <= prev_frame_idx)
+      return false;
+  }
+  return next_frame_idx_ == frame_id;
+}
+
 void FramesDecoder::SeekFrame(int frame_id) {
   // TODO(awolant): Optimize seeking:
-  //  - when we seek next frame,
-  //  - when we seek frame with the same keyframe as the current frame
   //  - for CFR, when we know pts, but don't know keyframes
 
   DALI_ENFORCE(
     frame_id >= 0 && frame_id < NumFrames(),
     make_string("Invalid seek frame id. frame_id = ", frame_id, ", num_frames = ", NumFrames()));
 
+  if (DecodeForward(frame_id))
+    return;
+  SeekFromKeyframe(frame_id);
+}
+
+void FramesDecoder::SeekFromKeyframe(int frame_id) {
   auto &frame_entry = Index(frame_id);
   int keyframe_id = frame_entry.last_keyframe_id;
   auto &keyframe_entry = Index(keyframe_id);
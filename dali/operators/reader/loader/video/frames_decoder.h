@@ -213,6 +213,24 @@ class DLL_PUBLIC FramesDecoder {
 
   const IndexEntry &Index(int frame_id) const;
 
+  /**
+   * @brief Whether the frame can be reached by decoding forward from the next frame, without
+   *        seeking. It's the case, when there's no keyframe between them.
+   */
+  bool CanDecodeForward(int frame_id) const;
+
+  /**
+   * @brief Decodes (and discards) the frames up to the given one, if CanDecodeForward
+   *
+   * @return true, if the next call to ReadNextFrame will return the frame `frame_id`
+   */
+  bool DecodeForward(int frame_id);
+
+  /**
+   * @brief Seeks to the keyframe preceding the given frame and decodes forward from there
+   */
+  void SeekFromKeyframe(int frame_id);
+
   int next_frame_idx_ = 0;
 
   bool is_full_range_ = false;
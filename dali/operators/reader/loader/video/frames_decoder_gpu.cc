@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -17,6 +17,7 @@
 #include <string>
 #include <memory>
 #include <iomanip>
+#include <cassert>
 #include <map>
 #include <mutex>
 #include "dali/core/error_handling.h"
@@ -402,7 +403,7 @@ void FramesDecoderGpu::InitGpuParser() {
   // Init internal frame buffer
   // TODO(awolant): Check, if continuous buffer would be faster
   for (size_t i = 0; i < frame_buffer_.size(); ++i) {
-    frame_buffer_[i].frame_.resize(FrameSize());
+    frame_buffer_[i].frame_.resize(FrameBytes());
     frame_buffer_[i].pts_ = -1;
   }
 }
@@ -432,6 +433,14 @@ FramesDecoderGpu::FramesDecoderGpu(
   InitGpuParser();
 }
 
+void FramesDecoderGpu::SetOutputFormat(const FrameOutputFormat &format) {
+  output_format_ = format;
+  for (auto &frame : frame_buffer_) {
+    assert(frame.pts_ == -1);
+    frame.frame_.resize(FrameBytes());
+  }
+}
+
 int FramesDecoderGpu::ProcessPictureDecode(CUVIDPICPARAMS *picture_params) {
   // Sending empty packet will call this callback.
   // If we want to flush the decoder, we do not need to do anything here
@@ -506,10 +515,10 @@ int FramesDecoderGpu::HandlePictureDisplay(CUVIDPARSERDISPINFO *picture_display_
     reinterpret_cast<uint8_t *>(frame),
     pitch,
     frame_output,
-    Width()* 3,
     Width(),
     Height(),
     is_full_range_,
+    output_format_,
     stream_);
   // TODO(awolant): Alterantive is to copy the data to a buffer
   // and then process it on the stream. Check, if this is faster, when
@@ -521,9 +530,11 @@ int FramesDecoderGpu::HandlePictureDisplay(CUVIDPARSERDISPINFO *picture_display_
 }
 
 void FramesDecoderGpu::SeekFrame(int frame_id) {
-  // TODO(awolant): This seek can be optimized - for consecutive frames not needed etc.
+  // consecutive frames, or frames without a keyframe between them, don't need flushing
+  if (DecodeForward(frame_id))
+    return;
   SendLastPacket(true);
-  FramesDecoder::SeekFrame(frame_id);
+  SeekFromKeyframe(frame_id);
 }
 
 bool FramesDecoderGpu::ReadNextFrameWithIndex(uint8_t *data, bool copy_to_output) {
@@ -531,7 +542,7 @@ bool FramesDecoderGpu::ReadNextFrameWithIndex(uint8_t *data, bool copy_to_output
   for (auto &frame : frame_buffer_) {
     if (frame.pts_ != -1 && frame.pts_ == Index(next_frame_idx_).pts) {
       if (copy_to_output) {
-        copyD2D(data, frame.frame_.data(), FrameSize(), stream_);
+        copyD2D(data, frame.frame_.data(), FrameBytes(), stream_);
       }
       LOG_LINE << "Read frame, index " << next_frame_idx_ << ", timestamp " <<
         std::setw(5) << frame.pts_ << ", current copy " << copy_to_output << std::endl;
@@ -682,7 +693,7 @@ bool FramesDecoderGpu::ReadNextFrameWithoutIndex(uint8_t *data, bool copy_to_out
   copyD2D(
     current_frame_output_,
     frame_buffer_[frame_to_return_index].frame_.data(),
-    FrameSize(),
+    FrameBytes(),
     stream_);
   LOG_LINE << "Read frame, index " << next_frame_idx_ << ", timestamp " <<
           std::setw(5) << frame_buffer_[frame_to_return_index].pts_ <<
@@ -750,7 +761,7 @@ BufferedFrame& FramesDecoderGpu::FindEmptySlot() {
   }
   frame_buffer_ = std::move(new_frame_buffer);
   auto &new_frame = frame_buffer_.back();
-  new_frame.frame_.resize(FrameSize());
+  new_frame.frame_.resize(FrameBytes());
   new_frame.pts_ = -1;
   return new_frame;
 }
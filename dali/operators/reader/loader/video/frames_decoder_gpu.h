@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -33,6 +33,7 @@ extern "C" {
 #include "dali/core/unique_handle.h"
 
 #include "dali/core/dev_buffer.h"
+#include "dali/operators/reader/loader/video/nvdecode/color_space.h"
 
 namespace dali {
 
@@ -162,6 +163,35 @@ class DLL_PUBLIC FramesDecoderGpu : public FramesDecoder {
 
   int NextFramePts() { return Index(NextFrameIdx()).pts; }
 
+  /**
+   * @brief The stream, in which the frames are decoded and copied to the output
+   */
+  cudaStream_t Stream() const { return stream_; }
+
+  /**
+   * @brief Sets the stream used by the subsequent calls
+   *
+   * The decoding of the previous frames must be complete, so it can be called between
+   * the calls to ReadNextFrame, e.g. to decode the file in a different session.
+   */
+  void SetStream(cudaStream_t stream) { stream_ = stream; }
+
+  /**
+   * @brief Sets the type, the layout and the normalization of the frames returned by
+   *        the subsequent calls to ReadNextFrame
+   *
+   * The conversion from NV12 is fused with the format change, so that no separate pass over
+   * the decoded frames is needed. It must be called before any frame is read.
+   */
+  void SetOutputFormat(const FrameOutputFormat &format);
+
+  const FrameOutputFormat &OutputFormat() const { return output_format_; }
+
+  /**
+   * @brief The size of a frame in bytes, in the current output format
+   */
+  int64_t FrameBytes() const { return output_format_.FrameBytes(Width(), Height()); }
+
   int ProcessPictureDecode(CUVIDPICPARAMS *picture_params);
 
   int HandlePictureDisplay(CUVIDPARSERDISPINFO *picture_display_info);
@@ -193,6 +223,8 @@ class DLL_PUBLIC FramesDecoderGpu : public FramesDecoder {
 
   std::vector<BufferedFrame> frame_buffer_;
 
+  FrameOutputFormat output_format_;
+
   std::queue<int> piped_pts_;
 
   cudaStream_t stream_;
@@ -1,30 +1,72 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
-//
-// Licensed under the Apache License, Version 2.0 (the "License");
-// you may not use this file except in compliance with the License.
-// You may obtain a copy of the License at
-//
-//     http://www.apache.org/licenses/LICENSE-2.0
-//
-// Unless required by applicable law or agreed to in writing, software
-// distributed under the License is distributed on an "AS IS" BASIS,
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-// See the License for the specific language governing permissions and
-// limitations under the License.
-
-#ifndef DALI_OPERATORS_READER_LOADER_VIDEO_NVDECODE_COLOR_SPACE_GPU_H_
-#define DALI_OPERATORS_READER_LOADER_VIDEO_NVDECODE_COLOR_SPACE_GPU_H_
-
-#include <stdint.h>
-
-void yuv_to_rgb(
-    uint8_t *yuv,
-    int yuv_pitch,
-    uint8_t *rgb,
-    int rgb_pitch,
-    int width,
-    int height,
-    bool full_range,
-    cudaStream_t stream);
-
-#endif  // DALI_OPERATORS_READER_LOADER_VIDEO_NVDECODE_COLOR_SPACE_GPU_H_
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_VIDEO_NVDECODE_COLOR_SPACE_GPU_H_
+#define DALI_OPERATORS_READER_LOADER_VIDEO_NVDECODE_COLOR_SPACE_GPU_H_
+
+#include <cuda_runtime_api.h>
+#include <stdint.h>
+#include "dali/core/common.h"
+#include "dali/pipeline/data/types.h"
+
+namespace dali {
+
+/**
+ * @brief The format of the frames produced from the decoded NV12 surfaces
+ *
+ * The conversion produces RGB frames of the given type, either interleaved (HWC) or planar (CHW).
+ * When `normalize` is set, the values are computed as `(rgb - mean) * inv_std`, with `rgb`
+ * in the range [0, 255].
+ */
+struct FrameOutputFormat {
+  DALIDataType type = DALI_UINT8;
+  bool planar = false;
+  bool normalize = false;
+  float mean[3] = { 0, 0, 0 };
+  float inv_std[3] = { 1, 1, 1 };
+
+  /** The number of bytes taken by a frame of given size */
+  int64_t FrameBytes(int width, int height) const {
+    return int64_t(width) * height * 3 * TypeTable::GetTypeInfo(type).size();
+  }
+};
+
+/**
+ * @brief Converts an NV12 surface to an RGB frame in the given format
+ *
+ * Supported output types are uint8, float16 and float.
+ */
+DLL_PUBLIC void yuv_to_rgb(
+    const uint8_t *yuv,
+    int yuv_pitch,
+    void *out,
+    int width,
+    int height,
+    bool full_range,
+    const FrameOutputFormat &format,
+    cudaStream_t stream);
+
+}  // namespace dali
+
+void yuv_to_rgb(
+    uint8_t *yuv,
+    int yuv_pitch,
+    uint8_t *rgb,
+    int rgb_pitch,
+    int width,
+    int height,
+    bool full_range,
+    cudaStream_t stream);
+
+#endif  // DALI_OPERATORS_READER_LOADER_VIDEO_NVDECODE_COLOR_SPACE_GPU_H_
@@ -29,22 +29,35 @@ void VideoSampleGpu::Decode() {
     DALIDataType::DALI_UINT8);
   data_.SetSourceInfo(video_file_->Filename());
 
+  int frame_size = video_file_->FrameSize();
   for (int i = 0; i < sequence_len_; ++i) {
     int frame_id = span_->start_ + i * span_->stride_;
+    auto *frame = static_cast<uint8_t *>(data_.raw_mutable_data()) + i * frame_size;
+    if (frame_cache_) {
+      if (auto *cached = frame_cache_->Get(frame_id)) {
+        copyD2D(frame, cached->data(), frame_size, video_file_->Stream());
+        continue;
+      }
+    }
     video_file_->SeekFrame(frame_id);
-    video_file_->ReadNextFrame(
-      static_cast<uint8_t *>(data_.raw_mutable_data()) + i * video_file_->FrameSize());
+    video_file_->ReadNextFrame(frame);
+    if (frame_cache_) {
+      if (auto *cached = frame_cache_->Put(frame_id)) {
+        cached->resize(frame_size, video_file_->Stream());
+        copyD2D(cached->data(), frame, frame_size, video_file_->Stream());
+      }
+    }
   }
 }
 
-void VideoLoaderDecoderGpu::InitCudaStream() {
+bool VideoLoaderDecoderGpu::DefaultStreamRequired() {
   #if NVML_ENABLED
   {
     auto nvml_handle = nvml::NvmlInstance::CreateNvmlInstance();
     static float driver_version = nvml::GetDriverVersion();
     if (driver_version > 460 && driver_version < 470.21) {
       DALI_WARN_ONCE("Warning: Decoding on a default stream. Performance may be affected.");
-      return;
+      return true;
     }
   }
   #else
@@ -53,12 +66,16 @@ void VideoLoaderDecoderGpu::InitCudaStream() {
     CUDA_CALL(cuDriverGetVersion(&driver_cuda_version));
     if (driver_cuda_version >= 11030 && driver_cuda_version < 11040) {
       DALI_WARN_ONCE("Warning: Decoding on a default stream. Performance may be affected.");
-      return;
+      return true;
     }
   }
   #endif
+  return false;
+}
 
-  // TODO(awolant): Check per decoder stream
+void VideoLoaderDecoderGpu::InitCudaStream() {
+  if (DefaultStreamRequired())
+    return;
   cuda_stream_ = CUDAStreamPool::instance().Get(device_id_);
 }
 
@@ -72,6 +89,7 @@ void VideoLoaderDecoderGpu::ReadSample(VideoSampleGpu &sample) {
   // Bind sample to the video and span, so it can be decoded later
   sample.span_ = &sample_span;
   sample.video_file_ = &video_files_[sample_span.video_idx_];
+  sample.frame_cache_ = frame_cache_size_ > 0 ? &frame_caches_[sample_span.video_idx_] : nullptr;
   sample.sequence_len_ = sequence_len_;
 
   if (has_labels_) {
@@ -94,6 +112,9 @@ void VideoLoaderDecoderGpu::PrepareMetadataImpl() {
       video_files_.pop_back();
     }
   }
+  frame_caches_.clear();
+  for (size_t i = 0; i < video_files_.size(); i++)
+    frame_caches_.emplace_back(frame_cache_size_);
 
   for (size_t video_idx = 0; video_idx < video_files_.size(); ++video_idx) {
     for (int start = 0;
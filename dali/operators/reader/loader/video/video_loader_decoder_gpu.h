@@ -19,17 +19,22 @@
 #include <vector>
 
 #include "dali/core/cuda_stream_pool.h"
+#include "dali/core/dev_buffer.h"
 #include "dali/operators/reader/loader/loader.h"
+#include "dali/operators/reader/loader/video/frame_cache.h"
 #include "dali/operators/reader/loader/video/video_loader_decoder_base.h"
 #include "dali/operators/reader/loader/video/video_loader_decoder_cpu.h"
 #include "dali/operators/reader/loader/video/frames_decoder_gpu.h"
 
 namespace dali {
+using GpuFrameCache = FrameCache<DeviceBuffer<uint8_t>>;
+
 class VideoSampleGpu {
  public:
   void Decode();
 
   FramesDecoderGpu *video_file_ = nullptr;
+  GpuFrameCache *frame_cache_ = nullptr;
   VideoSampleDesc *span_ = nullptr;
   int sequence_len_ = 0;
   Tensor<GPUBackend> data_;
@@ -43,7 +48,10 @@ class VideoLoaderDecoderGpu
  public:
   explicit inline VideoLoaderDecoderGpu(const OpSpec &spec) :
     Loader<GPUBackend, VideoSampleGpu, true>(spec),
-    VideoLoaderDecoderBase(spec) {
+    VideoLoaderDecoderBase(spec),
+    frame_cache_size_(spec.GetArgument<int>("frame_cache_size")) {
+    DALI_ENFORCE(frame_cache_size_ >= 0, make_string(
+        "`frame_cache_size` must not be negative. Got: ", frame_cache_size_));
     InitCudaStream();
   }
 
@@ -53,6 +61,11 @@ class VideoLoaderDecoderGpu
 
   void Skip() override;
 
+  /**
+   * @brief Returns true, if the driver requires decoding on the default stream
+   */
+  static bool DefaultStreamRequired();
+
  protected:
   Index SizeImpl() override;
 
@@ -64,6 +77,9 @@ class VideoLoaderDecoderGpu
   void InitCudaStream();
 
   std::vector<FramesDecoderGpu> video_files_;
+  // Per video file
+  std::vector<GpuFrameCache> frame_caches_;
+  int frame_cache_size_ = 0;
 
   CUDAStreamLease cuda_stream_;
 };
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -25,6 +25,7 @@ extern "C" {
 }
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <random>
 #include <string>
@@ -169,7 +170,8 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper, true> {
         spec.GetArgument<bool>("file_list_include_preceding_frame")),
       pad_sequences_(spec.GetArgument<bool>("pad_sequences")),
       stats_({0, 0, 0, 0, 0}),
-      thread_file_reader_(device_id_, false, "Video read_file thread"),
+      thread_file_reader_(device_id_, spec.GetArgument<bool>("set_affinity"),
+                          "Video read_file thread"),
       current_frame_idx_(-1),
       stop_(false) {
     DALI_ENFORCE(stride_ > 0, "Stride should be > 0");
@@ -180,6 +182,9 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper, true> {
                 "future releases, the default value will be changed to True.");
     }
 
+    if (spec.HasArgument("hw_resize") && spec.GetArgument<bool>("hw_resize"))
+      hw_resize_shape_ = HardwareResizeShape(spec);
+
     bool use_labels = spec.TryGetRepeatedArgument(labels_, "labels");
     file_info_ = filesystem::get_file_label_pair(file_root_, filenames_, use_labels, labels_,
                                                  file_list_);
@@ -216,6 +221,14 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper, true> {
   void push_sequence_to_read(std::string filename, int frame, int count);
   void receive_frames(SequenceWrapper& sequence);
 
+  /**
+   * @brief True if the frames are scaled by the decoder to the size requested by the resize
+   *        arguments - valid after PrepareMetadata.
+   */
+  bool uses_hw_resize() const {
+    return uses_hw_resize_;
+  }
+
  protected:
   Index SizeImpl() override;
 
@@ -312,6 +325,23 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper, true> {
                  "dataset, check the length of the available videos and the requested sequence "
                  "length.");
 
+    if (hw_resize_shape_[0] > 0) {
+      auto is_downscale = [&](const sequence_meta &s) {
+        return s.height >= hw_resize_shape_[0] && s.width >= hw_resize_shape_[1];
+      };
+      // the decoder is shared by all the videos, so they all need to be scaled down
+      uses_hw_resize_ = std::all_of(frame_starts_.begin(), frame_starts_.end(), is_downscale);
+      if (uses_hw_resize_) {
+        for (auto &s : frame_starts_) {
+          s.height = hw_resize_shape_[0];
+          s.width = hw_resize_shape_[1];
+        }
+      } else {
+        DALI_WARN("Some of the videos are smaller than the requested size, so the frames can't "
+                  "be scaled by the decoder - using the resize kernels instead.");
+      }
+    }
+
     // get first valid video
     const auto& file = get_or_open_file(file_info_[frame_starts_[0].filename_idx].video_file);
     DALI_ENFORCE(!file.empty(), "Cannot open video file");
@@ -324,7 +354,9 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper, true> {
                                                normalized_,
                                                ALIGN32(max_height_),
                                                ALIGN32(max_width_),
-                                               additional_decode_surfaces_);
+                                               additional_decode_surfaces_,
+                                               uses_hw_resize_ ? hw_resize_shape_[0] : 0,
+                                               uses_hw_resize_ ? hw_resize_shape_[1] : 0);
 
     if (shuffle_) {
       // TODO(spanev) decide of a policy for multi-gpu here and SequenceLoader
@@ -345,6 +377,36 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper, true> {
       current_frame_idx_ = 0;
     }
   }
+
+  /**
+   * @brief Returns the (height, width) of the resize requested with the resize arguments, if it
+   *        can be done by the decoder, or zeros otherwise.
+   *
+   * The decoder can only scale the whole frame to a fixed size, so it's used only for a resize
+   * with constant ``resize_x`` and ``resize_y`` and no other size, mode or RoI arguments.
+   */
+  static std::array<int, 2> HardwareResizeShape(const OpSpec &spec) {
+    bool plain = spec.HasArgument("resize_x") && spec.HasArgument("resize_y");
+    for (const char *arg : {"size", "resize_shorter", "resize_longer", "max_size",
+                            "roi_start", "roi_end"})
+      plain = plain && !spec.ArgumentDefined(arg);
+    if (plain && spec.ArgumentDefined("mode")) {
+      auto mode = spec.GetArgument<std::string>("mode");
+      plain = mode == "default" || mode == "stretch";
+    }
+    if (plain) {
+      float x = spec.GetArgument<float>("resize_x");
+      float y = spec.GetArgument<float>("resize_y");
+      // the decoder produces 4:2:0 surfaces, which need even sizes
+      int w = static_cast<int>(x), h = static_cast<int>(y);
+      if (w == x && h == y && w > 0 && h > 0 && w % 2 == 0 && h % 2 == 0)
+        return {h, w};
+    }
+    DALI_WARN("``hw_resize`` requires constant, even ``resize_x`` and ``resize_y`` and no "
+              "other resize arguments - using the resize kernels instead.");
+    return {0, 0};
+  }
+
   // Params
   std::string file_root_;
   std::string file_list_;
@@ -354,6 +416,9 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper, true> {
   int max_height_;
   int max_width_;
   int additional_decode_surfaces_;
+  // the size to which the decoder scales the frames, if requested with ``hw_resize``
+  std::array<int, 2> hw_resize_shape_ = {0, 0};
+  bool uses_hw_resize_ = false;
   static constexpr int channels_ = 3;
   // 10 is rather an arbitrary decision
   static constexpr int kStartupFrameThreshold = 10;
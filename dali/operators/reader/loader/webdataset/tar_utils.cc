@@ -14,6 +14,7 @@
 
 #include "dali/operators/reader/loader/webdataset/tar_utils.h"
 #include <algorithm>
+#include <atomic>
 #include <cstdarg>
 #include <cstdlib>
 #include <cstring>
@@ -39,7 +40,9 @@ constexpr uint64_t kTarArchiveBufferInitSize = 1;
 std::mutex instances_mutex;
 std::list<std::vector<TarArchive*>> instances_registry = {
     std::vector<TarArchive*>(kTarArchiveBufferInitSize)};
-TarArchive** instances = instances_registry.back().data();
+// the archives can be read concurrently (e.g. when indexing many archives at once), while
+// the registry grows in Register
+std::atomic<TarArchive**> instances = instances_registry.back().data();
 
 int Register(TarArchive* archive) {
   std::lock_guard<std::mutex> instances_lock(instances_mutex);
@@ -48,7 +51,7 @@ int Register(TarArchive* archive) {
       continue;
     }
     instances_entry = archive;
-    return &instances_entry - instances;
+    return &instances_entry - instances.load();
   }
   std::vector<TarArchive*>& old = instances_registry.back();
   instances_registry.emplace_back();
@@ -62,7 +65,8 @@ int Register(TarArchive* archive) {
 }
 
 inline void Unregister(int instance_handle_) {
-  instances[instance_handle_] = nullptr;
+  std::lock_guard<std::mutex> instances_lock(instances_mutex);
+  instances.load()[instance_handle_] = nullptr;
 }
 
 inline TAR* ToTarHandle(void* handle) {
@@ -76,7 +80,7 @@ inline TAR** ToTarHandle(void** handle) {
 }  // namespace
 
 ssize_t LibtarReadTarArchive(int instance_handle_, void* buf, size_t count) {
-  const auto current_archive = instances[instance_handle_];
+  const auto current_archive = instances.load()[instance_handle_];
   const ssize_t num_read = current_archive->stream_->Read(reinterpret_cast<uint8_t*>(buf), count);
   return num_read;
 }
@@ -122,7 +126,7 @@ TarArchive& TarArchive::operator=(TarArchive&& other) {
     std::swap(instance_handle_, other.instance_handle_);
     if (instance_handle_ >= 0) {
       std::lock_guard<std::mutex> instances_lock(instances_mutex);
-      instances[instance_handle_] = this;
+      instances.load()[instance_handle_] = this;
     }
     other.Release();
   }
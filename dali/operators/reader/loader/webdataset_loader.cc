@@ -13,15 +13,22 @@
 // limitations under the License.
 
 #include "dali/operators/reader/loader/webdataset_loader.h"
+#include <unistd.h>
+#include <algorithm>
+#include <cctype>
 #include <cstddef>
+#include <cstdio>
 #include <cstring>
+#include <filesystem>
 #include <limits>
 #include <memory>
+#include <sstream>
 #include <tuple>
 #include <utility>
 #include "dali/core/common.h"
 #include "dali/core/version_util.h"
 #include "dali/core/error_handling.h"
+#include "dali/operators/reader/loader/discover_files.h"
 #include "dali/operators/reader/loader/webdataset/tar_utils.h"
 #include "dali/pipeline/data/types.h"
 #include "dali/util/uri.h"
@@ -201,6 +208,86 @@ inline void ParseTarFile(std::vector<SampleDesc>& samples_container,
   tar_file = tar_archive.Release();
 }
 
+/**
+ * @brief Writes the index in the format read by ParseIndexFile.
+ *
+ * Returns false if the index cannot be represented in that format (e.g. when the file names
+ * contain whitespace) or written.
+ */
+inline bool WriteIndexFile(std::vector<SampleDesc>& samples_container,
+                           const std::string& index_path) {
+  size_t num_samples = 0;
+  for (auto& sample : samples_container) {
+    if (sample.components.num == 0)
+      continue;
+    num_samples++;
+    for (auto& component : sample.components) {
+      auto has_space = [](const std::string& s) {
+        return std::any_of(s.begin(), s.end(), [](unsigned char c) { return std::isspace(c); });
+      };
+      if (component.ext.empty() || has_space(component.ext) || has_space(component.filename))
+        return false;
+    }
+  }
+  if (num_samples == 0)
+    return false;
+
+  // write to a temporary file and rename it, so that other readers indexing the same archive
+  // at the same time never see a partially written index
+  std::string tmp_path = make_string(index_path, ".", getpid(), ".tmp");
+  {
+    std::ofstream index_file(tmp_path);
+    if (!index_file.is_open())
+      return false;
+    index_file << kCurrentIndexVersion << " " << num_samples << "\n";
+    for (auto& sample : samples_container) {
+      if (sample.components.num == 0)
+        continue;
+      const char* sep = "";
+      for (auto& component : sample.components) {
+        index_file << sep << component.ext << " " << component.offset << " " << component.size
+                   << " " << component.filename;
+        sep = " ";
+      }
+      index_file << "\n";
+    }
+    if (!index_file.good()) {
+      index_file.close();
+      std::remove(tmp_path.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), index_path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief The location of the cached index of an archive, unique for the archive path.
+ */
+inline std::string CachedIndexPath(const std::string& cache_dir, const std::string& tar_path) {
+  std::error_code ec;
+  auto abs_path = std::filesystem::absolute(tar_path, ec);
+  std::stringstream name;
+  name << std::filesystem::path(tar_path).filename().string() << "." << std::hex
+       << std::hash<std::string>()(ec ? tar_path : abs_path.string()) << ".idx";
+  return (std::filesystem::path(cache_dir) / name.str()).string();
+}
+
+/**
+ * @brief Checks if the cached index exists and is not older than the archive.
+ */
+inline bool IsCachedIndexValid(const std::string& index_path, const std::string& tar_path) {
+  std::error_code ec;
+  auto index_time = std::filesystem::last_write_time(index_path, ec);
+  if (ec)
+    return false;
+  auto tar_time = std::filesystem::last_write_time(tar_path, ec);
+  return !ec && index_time >= tar_time;
+}
+
 }  // namespace wds
 }  // namespace detail
 
@@ -226,6 +313,8 @@ WebdatasetLoader::WebdatasetLoader(const OpSpec& spec)
       missing_component_behavior_(detail::wds::ParseMissingExtBehavior(
           spec.GetArgument<std::string>("missing_component_behavior"))),
       case_sensitive_extensions_(spec.GetArgument<bool>("case_sensitive_extensions")) {
+  spec.TryGetArgument(index_cache_dir_, "index_cache_dir");
+  index_threads_ = std::max(1, spec.GetArgument<int>("num_threads"));
   DALI_ENFORCE(paths_.size() == index_paths_.size() || index_paths_.size() == 0,
                make_string("The number of index files, if any, must match the number of archives ",
                "in the dataset"));
@@ -286,6 +375,36 @@ std::string WebdatasetLoader::GetSampleSource(const detail::wds::SampleDesc& sam
 }
 
 
+void WebdatasetLoader::LoadShardIndex(size_t wds_shard_index,
+                                      std::vector<detail::wds::SampleDesc>& samples,
+                                      std::vector<detail::wds::ComponentDesc>& components) {
+  if (!generate_index_) {
+    detail::wds::ParseIndexFile(samples, components, index_paths_[wds_shard_index]);
+    return;
+  }
+  const auto& path = paths_[wds_shard_index];
+  auto uri = URI::Parse(path, URI::ParseOpts::AllowNonEscaped);
+  bool local_file = !uri.valid() || uri.scheme() == "file";
+  std::string cached_index;
+  if (!index_cache_dir_.empty() && local_file) {
+    cached_index = detail::wds::CachedIndexPath(index_cache_dir_, path);
+    if (detail::wds::IsCachedIndexValid(cached_index, path)) {
+      try {
+        detail::wds::ParseIndexFile(samples, components, cached_index);
+        return;
+      } catch (const std::exception& e) {
+        // e.g. a partially written index - infer it again
+        DALI_WARN(make_string("Ignoring the cached index of \"", path, "\": ", e.what()));
+        samples.clear();
+        components.clear();
+      }
+    }
+  }
+  detail::wds::ParseTarFile(samples, components, wds_shards_[wds_shard_index]);
+  if (!cached_index.empty() && !detail::wds::WriteIndexFile(samples, cached_index))
+    DALI_WARN(make_string("Could not save the index of \"", path, "\" in ", index_cache_dir_));
+}
+
 void WebdatasetLoader::ReadSample(vector<Tensor<CPUBackend>>& sample) {
   MoveToNextShard(sample_index_);
   detail::wds::SampleDesc& current_sample = samples_[sample_index_];
@@ -402,8 +521,6 @@ void WebdatasetLoader::PrepareMetadataImpl() {
   }
 
   // collecting and filtering the index files
-  std::vector<detail::wds::SampleDesc> unfiltered_samples;
-  std::vector<detail::wds::ComponentDesc> unfiltered_components;
   bitmask was_output_set;
   was_output_set.resize(ext_.size(), false);
   output_indicies_.reserve(ext_.size());
@@ -413,18 +530,17 @@ void WebdatasetLoader::PrepareMetadataImpl() {
     dtype_sizes_[i] = TypeTable::GetTypeInfo(dtypes_[i]).size();
   }
 
-  for (size_t wds_shard_index = 0; wds_shard_index < paths_.size(); wds_shard_index++) {
-    unfiltered_samples.resize(0);
-    unfiltered_components.resize(0);
-    if (generate_index_) {
-      detail::wds::ParseTarFile(unfiltered_samples, unfiltered_components,
-                                wds_shards_[wds_shard_index]);
-    } else {
-      detail::wds::ParseIndexFile(unfiltered_samples, unfiltered_components,
-                                  index_paths_[wds_shard_index]);
-    }
+  // the indices of all the archives are loaded (or inferred) concurrently and then filtered
+  // in the order of the archives
+  std::vector<std::vector<detail::wds::SampleDesc>> unfiltered_samples(paths_.size());
+  std::vector<std::vector<detail::wds::ComponentDesc>> unfiltered_components(paths_.size());
+  detail::discovery_parallel_for(paths_.size(), index_threads_, [&](int wds_shard_index) {
+    LoadShardIndex(wds_shard_index, unfiltered_samples[wds_shard_index],
+                   unfiltered_components[wds_shard_index]);
+  });
 
-    for (auto& sample : unfiltered_samples) {
+  for (size_t wds_shard_index = 0; wds_shard_index < paths_.size(); wds_shard_index++) {
+    for (auto& sample : unfiltered_samples[wds_shard_index]) {
       detail::wds::SampleDesc new_sample{
           detail::wds::VectorRange<detail::wds::ComponentDesc>(components_, components_.size()),
           detail::wds::VectorRange<size_t>(empty_outputs_, empty_outputs_.size()), wds_shard_index,
@@ -486,6 +602,9 @@ void WebdatasetLoader::PrepareMetadataImpl() {
       }
       was_output_set.fill(false);
     }
+    // release the memory as soon as possible
+    unfiltered_samples[wds_shard_index] = {};
+    unfiltered_components[wds_shard_index] = {};
   }
   sample_index_ = start_index(shard_id_, num_shards_, samples_.size());
 }
@@ -121,7 +121,11 @@ class DLL_PUBLIC WebdatasetLoader : public Loader<CPUBackend, vector<Tensor<CPUB
   dali::once_flag multiple_files_single_component;
 
   bool generate_index_ = true;
+  std::string index_cache_dir_;  // where the inferred indices are persisted, if not empty
+  int index_threads_ = 1;        // the number of threads indexing the archives
   std::string GetSampleSource(const detail::wds::SampleDesc& sample);
+  void LoadShardIndex(size_t wds_shard_index, std::vector<detail::wds::SampleDesc>& samples,
+                      std::vector<detail::wds::ComponentDesc>& components);
   bool case_sensitive_extensions_ = true;
 };
 
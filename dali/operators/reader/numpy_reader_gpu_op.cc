@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include "dali/core/mm/memory.h"
@@ -33,10 +34,16 @@ NumpyReaderGPU::NumpyReaderGPU(const OpSpec& spec)
   // make the device current
   DeviceGuard g(device_id_);
 
-  staging_stream_ = CUDAStreamPool::instance().Get();
+  staging_stream_ = CUDAStreamPool::instance().Get(device_id_, default_cuda_stream_priority_);
   staging_ready_ = CUDAEventPool::instance().Get();
   staging_.set_stream(staging_stream_);
 
+  // at most half of the staging buffers can wait for the reads, so that the staging engine
+  // always has some buffers to recycle
+  int queue_depth = std::min(spec.GetArgument<int>("gds_queue_depth"), staging_.max_buffers() / 2);
+  if (queue_depth > 0 && CUFileBatchReader::IsSupported())
+    batch_reader_ = std::make_unique<CUFileBatchReader>(queue_depth);
+
   // init loader
   bool shuffle_after_epoch = spec.GetArgument<bool>("shuffle_after_epoch");
   loader_ = InitLoader<NumpyLoaderGPU>(spec, shuffle_after_epoch);
@@ -70,6 +77,11 @@ void NumpyReaderGPU::Prefetch() {
   }
   thread_pool_.RunAll();
 
+  for (size_t data_idx = 0; data_idx < curr_batch.size(); ++data_idx) {
+    if (data_idx > 0 && curr_batch[data_idx - 1] == curr_batch[data_idx]) continue;
+    ApplyPrefetchRoi(*curr_batch[data_idx]);
+  }
+
   // resize the current batch
   auto ref_type = curr_batch[0]->get_type();
   auto ref_shape = curr_batch[0]->get_shape();
@@ -108,12 +120,17 @@ void NumpyReaderGPU::Prefetch() {
         first_padded = data_idx;
       }
       curr_batch[data_idx]->source_sample_idx = first_padded - 1;
+    } else if (curr_batch[data_idx]->roi_applied) {
+      ScheduleRoiRead(sample, *curr_batch[data_idx]);
+      curr_batch[data_idx]->source_sample_idx = data_idx;
     } else {
       ScheduleChunkedRead(sample, *curr_batch[data_idx]);
       curr_batch[data_idx]->source_sample_idx = data_idx;
     }
   }
   thread_pool_.RunAll();
+  if (batch_reader_)
+    batch_reader_->Wait();
   staging_.commit();
   CUDA_CALL(cudaEventRecord(staging_ready_, staging_stream_));
 
@@ -141,13 +158,9 @@ void NumpyReaderGPU::ScheduleChunkedRead(SampleView<GPUBackend> &out_sample,
     ssize_t copy_skip = copy_start - file_offset;
     ssize_t copy_end = file_offset + chunk_read_length;
     ssize_t chunk_copy_length = copy_end - copy_start;
-    thread_pool_.AddWork([=, &load_target](int tid) {
-      assert(chunk_read_length <= static_cast<ssize_t>(staging_.chunk_size()));
-      auto buffer = staging_.get_staging_buffer();
-      load_target.ReadRawChunk(buffer.at(0), chunk_read_length, 0, file_offset);
-      assert(dst_ptr >= base_ptr && dst_ptr + chunk_copy_length <= base_ptr + data_bytes);
-      staging_.copy_to_client(dst_ptr, chunk_copy_length, std::move(buffer), copy_skip);
-    });
+    assert(dst_ptr >= base_ptr && dst_ptr + chunk_copy_length <= base_ptr + data_bytes);
+    ScheduleChunk(load_target, file_offset, chunk_read_length,
+                  {{ dst_ptr, static_cast<size_t>(chunk_copy_length), copy_skip }});
 
     // update addresses
     dst_ptr += chunk_copy_length;
@@ -157,6 +170,56 @@ void NumpyReaderGPU::ScheduleChunkedRead(SampleView<GPUBackend> &out_sample,
   assert(dst_ptr == base_ptr + data_bytes);
 }
 
+void NumpyReaderGPU::ScheduleRoiRead(SampleView<GPUBackend> &out_sample,
+                                     NumpyFileWrapperGPU &load_target) {
+  uint8_t *dst_ptr = static_cast<uint8_t*>(out_sample.raw_mutable_data());
+  const auto &ranges = load_target.roi_ranges;
+  size_t i = 0;
+  int64_t range_done = 0;  // the part of the current range that's already scheduled
+  while (i < ranges.size()) {
+    // A chunk starts at an aligned offset and covers as many ranges (or their parts) as fit.
+    // The gaps between the ranges are read, too - it's cheaper than issuing separate reads.
+    ssize_t file_offset = (ranges[i].offset + range_done) & -gds::kGDSAlignment;
+    ssize_t chunk_end = file_offset + chunk_size_;
+    ssize_t read_end = file_offset;
+    std::vector<gds::GDSStagingEngine::CopyRange> copies;
+    while (i < ranges.size() && ranges[i].offset + range_done < chunk_end) {
+      ssize_t start = ranges[i].offset + range_done;
+      ssize_t end = std::min<ssize_t>(ranges[i].offset + ranges[i].size, chunk_end);
+      copies.push_back({ dst_ptr, static_cast<size_t>(end - start), start - file_offset });
+      dst_ptr += end - start;
+      range_done += end - start;
+      read_end = end;
+      if (range_done == ranges[i].size) {
+        i++;
+        range_done = 0;
+      }
+    }
+    ScheduleChunk(load_target, file_offset, read_end - file_offset, std::move(copies));
+  }
+}
+
+void NumpyReaderGPU::ScheduleChunk(NumpyFileWrapperGPU &load_target, ssize_t file_offset,
+                                   ssize_t length,
+                                   std::vector<gds::GDSStagingEngine::CopyRange> copies) {
+  assert(length <= static_cast<ssize_t>(staging_.chunk_size()));
+  if (batch_reader_) {
+    // the callback must be copyable
+    auto buffer = std::make_shared<gds::GDSStagingBuffer>(staging_.get_staging_buffer());
+    batch_reader_->Read(load_target.file_stream_.get(), buffer->at(0), length, 0,
+                        file_offset, [this, buffer, copies = std::move(copies)]() {
+      staging_.copy_to_client(make_cspan(copies), std::move(*buffer));
+    });
+  } else {
+    thread_pool_.AddWork([this, &load_target, file_offset, length,
+                          copies = std::move(copies)](int tid) {
+      auto buffer = staging_.get_staging_buffer();
+      load_target.ReadRawChunk(buffer.at(0), length, 0, file_offset);
+      staging_.copy_to_client(make_cspan(copies), std::move(buffer));
+    });
+  }
+}
+
 DALI_REGISTER_OPERATOR(readers__Numpy, NumpyReaderGPU, GPU);
 
 // Deprecated alias
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -24,6 +24,7 @@
 #include "dali/core/cuda_stream_pool.h"
 #include "dali/kernels/kernel_manager.h"
 #include "dali/kernels/common/scatter_gather.h"
+#include "dali/util/cufile_batch.h"
 #include "dali/util/cufile_helper.h"
 #include "dali/kernels/transpose/transpose_gpu.h"
 #include "dali/operators/reader/loader/numpy_loader_gpu.h"
@@ -81,12 +82,16 @@ class NumpyReaderGPU : gds::GDSLazyInit, public NumpyReader<GPUBackend, NumpyFil
   TensorList<GPUBackend> tmp_buf_;
 
   void ScheduleChunkedRead(SampleView<GPUBackend> &out_sample, NumpyFileWrapperGPU &target);
+  void ScheduleRoiRead(SampleView<GPUBackend> &out_sample, NumpyFileWrapperGPU &target);
+  void ScheduleChunk(NumpyFileWrapperGPU &target, ssize_t file_offset, ssize_t length,
+                     std::vector<gds::GDSStagingEngine::CopyRange> copies);
 
   size_t chunk_size_ = gds::GetGDSChunkSize();
   detail::NumpyHeaderCache header_cache_;
   gds::GDSStagingEngine staging_;
   CUDAStreamLease staging_stream_;
   CUDAEvent staging_ready_;
+  std::unique_ptr<CUFileBatchReader> batch_reader_;
   std::vector<int> source_data_index_;
 };
 
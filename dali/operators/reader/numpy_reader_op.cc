@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -151,6 +151,13 @@ This argument is mutually exclusive with ``file_list``.)", nullptr)
 
 If true, the device I/O buffers will be registered with cuFile. It is not recommended if the sample
 sizes vary a lot.)code", true)
+  .AddOptionalArg("gds_queue_depth",
+      R"code(Applies **only** to the ``gpu`` backend type.
+
+The maximum number of GPUDirect Storage reads in flight. The reads of a whole batch are submitted
+with cuFile batch API, keeping up to this many requests queued in the driver.
+If set to 0 or if the batch API is not available, the reads are issued one by one by the reader
+threads.)code", 32)
   .AddOptionalArg("cache_header_information",
       R"code(If set to True, the header information for each file is cached, improving access
 speed.)code",
@@ -314,13 +321,20 @@ void NumpyReaderCPU::Prefetch() {
       }
       target->data.ShareData(tmp_mem, target->nbytes, false, target->shape, target->type, -1);
     } else {
+      ApplyPrefetchRoi(*target);
+      if (target->roi_applied)
+        target->nbytes = volume(target->shape) * TypeTable::GetTypeInfo(target->type).size();
       if (!target->data.has_data()) target->data.set_pinned(false);
       target->data.Resize(target->shape, target->type);
       auto data_ptr = static_cast<uint8_t*>(target->data.raw_mutable_data());
-      Index ret = target->current_file->Read(data_ptr, target->nbytes);
-      DALI_ENFORCE(ret == static_cast<Index>(target->nbytes),
-                  make_string("Failed to read file: ", target->filename,
-                              ", read: ", ret, " while it should be ", target->nbytes));
+      if (target->roi_applied) {
+        ReadRoi(*target, data_ptr);
+      } else {
+        Index ret = target->current_file->Read(data_ptr, target->nbytes);
+        DALI_ENFORCE(ret == static_cast<Index>(target->nbytes),
+                    make_string("Failed to read file: ", target->filename,
+                                ", read: ", ret, " while it should be ", target->nbytes));
+      }
     }
   }
   thread_pool_.RunAll();
@@ -329,6 +343,46 @@ void NumpyReaderCPU::Prefetch() {
   }
 }
 
+void NumpyReaderCPU::ReadRoi(NumpyFileWrapper &target, uint8_t *dst) {
+  // The ranges which are close to each other (e.g. the rows of a plane) are read together,
+  // to limit the number of calls.
+  constexpr int64_t kMaxGap = 256 << 10;
+  constexpr int64_t kMaxReadSize = 16 << 20;
+  const auto &ranges = target.roi_ranges;
+  auto *file = target.current_file.get();
+  for (size_t i = 0; i < ranges.size(); ) {
+    int64_t read_start = ranges[i].offset;
+    int64_t read_end = ranges[i].offset + ranges[i].size;
+    size_t end = i + 1;
+    for (; end < ranges.size(); end++) {
+      int64_t next_end = ranges[end].offset + ranges[end].size;
+      if (ranges[end].offset - read_end > kMaxGap || next_end - read_start > kMaxReadSize)
+        break;
+      read_end = next_end;
+    }
+    int64_t read_size = read_end - read_start;
+    bool merged = end - i > 1;
+    uint8_t *buf = dst;
+    if (merged) {
+      roi_read_buffer_.resize(read_size);
+      buf = roi_read_buffer_.data();
+    }
+    file->SeekRead(read_start);
+    Index ret = file->Read(buf, read_size);
+    DALI_ENFORCE(ret == read_size, make_string("Failed to read file: ", target.filename,
+                                               ", read: ", ret, " while it should be ", read_size));
+    if (merged) {
+      for (size_t k = i; k < end; k++) {
+        std::memcpy(dst, buf + (ranges[k].offset - read_start), ranges[k].size);
+        dst += ranges[k].size;
+      }
+    } else {
+      dst += read_size;
+    }
+    i = end;
+  }
+}
+
 void NumpyReaderCPU::RunImpl(Workspace &ws) {
   auto &output = ws.Output<CPUBackend>(0);
   const auto &out_sh = output.shape();
@@ -17,6 +17,7 @@
 
 #define NUMPY_ALLOWED_DIMS (0, 1, 2, 3, 4, 5, 6)
 
+#include <cstring>
 #include <string>
 #include <utility>
 #include <vector>
@@ -37,11 +38,23 @@ class NumpyReader : public DataReader<Backend, Target, Target, true> {
   explicit NumpyReader(const OpSpec& spec)
       : DataReader<Backend, Target, Target, true>(spec),
         slice_attr_(spec, "roi_start", "rel_roi_start", "roi_end", "rel_roi_end", "roi_shape",
-                    "rel_roi_shape", "roi_axes", nullptr) {
+                    "rel_roi_shape", "roi_axes", nullptr),
+        prefetch_slice_attr_(spec, "roi_start", "rel_roi_start", "roi_end", "rel_roi_end",
+                             "roi_shape", "rel_roi_shape", "roi_axes", nullptr) {
     out_of_bounds_policy_ = GetOutOfBoundsPolicy(spec);
     if (out_of_bounds_policy_ == OutOfBoundsPolicy::Pad) {
       fill_value_ = spec.GetArgument<float>("fill_value");
     }
+    // the ROI can be calculated before the data is read only if it doesn't depend on other
+    // operators
+    bool has_roi = false, has_roi_inputs = false;
+    for (const char *name : { "roi_start", "rel_roi_start", "roi_end", "rel_roi_end",
+                              "roi_shape", "rel_roi_shape", "roi_axes" }) {
+      has_roi_inputs |= spec.HasTensorArgument(name);
+      if (strcmp(name, "roi_axes"))
+        has_roi |= spec.HasArgument(name);
+    }
+    prefetch_roi_ = has_roi && !has_roi_inputs;
   }
 
   bool HasContiguousOutputs() const override {
@@ -102,7 +115,7 @@ class NumpyReader : public DataReader<Backend, Target, Target, true> {
       }
 
       bool need_slice = false;
-      if (has_roi_args) {
+      if (has_roi_args && !file_i.roi_applied) {
         // Calculate the cropping window, based on the final layout (user provides axes in that
         // layout)
         auto full_sample_sh = sh.tensor_shape(i);  // already permuted dims
@@ -142,7 +155,40 @@ class NumpyReader : public DataReader<Backend, Target, Target, true> {
     return true;
   }
 
+  /**
+   * @brief Limits the read of the sample to its region of interest, if the region can be
+   *        calculated before reading.
+   *
+   * This is possible when the ROI arguments are not argument inputs, the array is stored
+   * in C order and the ROI needs no padding. Then, the shape of the sample is replaced with
+   * the shape of the ROI and `roi_ranges` tell which parts of the file to read.
+   * Must be called from the prefetching thread.
+   */
+  void ApplyPrefetchRoi(Target &target) {
+    if (!prefetch_roi_ || target.fortran_order)
+      return;
+    TensorShape<> shape = target.shape;
+    prefetch_slice_attr_.template ProcessArguments<Backend>(spec_, prefetch_ws_, 1,
+                                                            shape.sample_dim());
+    auto roi = prefetch_slice_attr_.GetCropWindowGenerator(0)(shape, {});
+    ApplySliceBoundsPolicy(out_of_bounds_policy_, shape, roi.anchor, roi.shape);
+    if (!roi.IsInRange(shape))
+      return;  // the padding is done when slicing
+    numpy::HeaderData header;
+    header.shape = shape;
+    header.type_info = &TypeTable::GetTypeInfo(target.type);
+    header.data_offset = target.data_offset;
+    target.roi_ranges = numpy::GetRoiRanges(header, make_cspan(roi.anchor),
+                                            make_cspan(roi.shape));
+    target.shape = roi.shape;
+    target.roi_applied = true;
+  }
+
   NamedSliceAttr slice_attr_;
+  // used by the prefetching thread, with an empty workspace
+  NamedSliceAttr prefetch_slice_attr_;
+  Workspace prefetch_ws_;
+  bool prefetch_roi_ = false;
   std::vector<CropWindow> rois_;
   OutOfBoundsPolicy out_of_bounds_policy_ = OutOfBoundsPolicy::Error;
   float fill_value_ = 0;
@@ -196,6 +242,9 @@ class NumpyReaderCPU : public NumpyReader<CPUBackend, NumpyFileWrapper> {
   size_t o_direct_read_len_alignm_ = 0;
   // ThreadPool for prefetch which is a separate thread
   ThreadPool thread_pool_;
+
+  void ReadRoi(NumpyFileWrapper &target, uint8_t *dst);
+  std::vector<uint8_t> roi_read_buffer_;
 };
 
 }  // namespace dali
@@ -23,7 +23,12 @@ namespace dali {
 class CUVideoDecoder {
  public:
   CUVideoDecoder();
-  CUVideoDecoder(int, int, int);
+  /**
+   * @param target_height, target_width If positive, the decoder scales the frames to this size
+   *                                    in its post-processing (cuvidMapVideoFrame output).
+   */
+  CUVideoDecoder(int max_height, int max_width, int additional_decode_surfaces,
+                 int target_height = 0, int target_width = 0);
   explicit CUVideoDecoder(CUvideodecoder);
   ~CUVideoDecoder();
 
@@ -51,6 +56,8 @@ class CUVideoDecoder {
   int max_height_;
   int max_width_;
   int additional_decode_surfaces_;
+  int target_height_;
+  int target_width_;
 };
 
 }  // namespace dali
@@ -44,10 +44,13 @@ NvDecoder::NvDecoder(int device_id,
                      bool normalized,
                      int max_height,
                      int max_width,
-                     int additional_decode_surfaces)
+                     int additional_decode_surfaces,
+                     int target_height,
+                     int target_width)
     : device_id_(device_id),
       rgb_(image_type == DALI_RGB), dtype_(dtype), normalized_(normalized),
-      device_(), parser_(), decoder_(max_height, max_width, additional_decode_surfaces),
+      device_(), parser_(),
+      decoder_(max_height, max_width, additional_decode_surfaces, target_height, target_width),
       frame_in_use_(32),  // 32 is cuvid's max number of decode surfaces
       frame_full_range_(32),  // 32 is cuvid's max number of decode surfaces
       recv_queue_(), frame_queue_(),
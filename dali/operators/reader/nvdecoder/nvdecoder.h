@@ -95,7 +95,9 @@ class NvDecoder {
             bool normalized,
             int max_height,
             int max_width,
-            int additional_decode_surfaces);
+            int additional_decode_surfaces,
+            int target_height = 0,
+            int target_width = 0);
 
   // Some of the members are non-movable or non-copyable so the constructors below still end up
   // implicitly deleted, thus marking them explicitly deleted as this class in managed through
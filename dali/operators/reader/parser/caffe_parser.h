@@ -15,11 +15,18 @@
 #ifndef DALI_OPERATORS_READER_PARSER_CAFFE_PARSER_H_
 #define DALI_OPERATORS_READER_PARSER_CAFFE_PARSER_H_
 
+#include "dali/core/span.h"
 #include "dali/operators/reader/parser/parser.h"
-#include "dali/operators/reader/parser/caffe.pb.h"
+#include "dali/operators/reader/parser/proto_wire.h"
 
 namespace dali {
 
+/**
+ * @brief Extracts the image and the label from serialized `caffe.Datum` records
+ *
+ * The record is read directly from the protobuf wire format and the image data is copied
+ * straight to the output, without constructing the protobuf object.
+ */
 class CaffeParser : public Parser<Tensor<CPUBackend>> {
  public:
   explicit CaffeParser(const OpSpec& spec) :
@@ -28,9 +35,9 @@ class CaffeParser : public Parser<Tensor<CPUBackend>> {
     label_available_(spec.GetArgument<bool>("label_available")) {}
 
   void Parse(const Tensor<CPUBackend>& data, SampleWorkspace* ws) override {
-    caffe::Datum datum;
+    Datum datum;
     int out_tensors = 0;
-    DALI_ENFORCE(datum.ParseFromArray(data.raw_data(), data.size()),
+    DALI_ENFORCE(ParseDatum(span<const uint8_t>(data.data<uint8_t>(), data.size()), datum),
       make_string("Error while parsing Caffe file: ", data.GetSourceInfo(),
                   " (raw data length: ", data.size(), " bytes)."));
 
@@ -38,32 +45,30 @@ class CaffeParser : public Parser<Tensor<CPUBackend>> {
       bool encoded_data = true;
       int data_size = 0;
       auto& image = ws->Output<CPUBackend>(out_tensors);
-      if (datum.has_encoded() && !datum.encoded()) {
+      if (datum.has_encoded && !datum.encoded) {
         encoded_data = false;
       }
-      if (datum.has_data()) {
-        data_size = datum.data().size();
-      }
+      data_size = datum.data.size();
       // copy image
       if (encoded_data) {
         image.Resize({static_cast<Index>(data_size)}, DALI_UINT8);
       } else {
-        DALI_ENFORCE(datum.height() * datum.width() * datum.channels() == data_size,
+        DALI_ENFORCE(int64_t(datum.height) * datum.width * datum.channels == data_size,
                     "The content size of the raw image in LMDB caffe entry doesn't"
                     " match its dimensions");
-        image.Resize({datum.height(), datum.width(), datum.channels()}, DALI_UINT8);
+        image.Resize({datum.height, datum.width, datum.channels}, DALI_UINT8);
       }
-      std::memcpy(image.mutable_data<uint8_t>(), datum.data().data(), data_size * sizeof(uint8_t));
+      std::memcpy(image.mutable_data<uint8_t>(), datum.data.data(), data_size * sizeof(uint8_t));
       image.SetSourceInfo(data.GetSourceInfo());
       out_tensors++;
     }
 
     if (label_available_) {
       auto& label = ws->Output<CPUBackend>(out_tensors);
-      if (datum.has_label()) {
+      if (datum.has_label) {
         // copy label
         label.Resize({1}, DALI_INT32);
-        label.mutable_data<int>()[0] = datum.label();
+        label.mutable_data<int>()[0] = datum.label;
       } else {
         label.Resize({0}, DALI_INT32);
       }
@@ -72,6 +77,52 @@ class CaffeParser : public Parser<Tensor<CPUBackend>> {
   }
 
  private:
+  /** The fields of caffe.Datum used by the parser */
+  struct Datum {
+    int channels = 0, height = 0, width = 0, label = 0;
+    bool has_label = false, has_encoded = false, encoded = false;
+    span<const uint8_t> data;
+  };
+
+  static bool ParseDatum(span<const uint8_t> serialized, Datum &datum) {
+    using namespace proto_wire;  // NOLINT
+    enum { kChannels = 1, kHeight = 2, kWidth = 3, kData = 4, kLabel = 5, kEncoded = 7 };
+    WireReader r(serialized);
+    while (r.Next()) {
+      int field = r.field();
+      if (r.wire_type() == kVarint && field != kData) {
+        // int32 values are sign-extended to 64 bits; truncating them restores the value
+        auto value = static_cast<int32_t>(r.ReadVarint());
+        switch (field) {
+          case kChannels:
+            datum.channels = value;
+            break;
+          case kHeight:
+            datum.height = value;
+            break;
+          case kWidth:
+            datum.width = value;
+            break;
+          case kLabel:
+            datum.label = value;
+            datum.has_label = true;
+            break;
+          case kEncoded:
+            datum.encoded = value != 0;
+            datum.has_encoded = true;
+            break;
+          default:
+            break;
+        }
+      } else if (r.wire_type() == kLengthDelimited && field == kData) {
+        datum.data = r.ReadBytes();
+      } else {
+        r.Skip();
+      }
+    }
+    return r.ok();
+  }
+
   bool image_available_;
   bool label_available_;
 };
@@ -0,0 +1,162 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_PARSER_PROTO_WIRE_H_
+#define DALI_OPERATORS_READER_PARSER_PROTO_WIRE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include "dali/core/span.h"
+
+namespace dali {
+namespace proto_wire {
+
+/** The wire types of the protobuf encoding (the groups are not supported) */
+enum WireType : int {
+  kVarint = 0,
+  kFixed64 = 1,
+  kLengthDelimited = 2,
+  kFixed32 = 5,
+};
+
+/**
+ * @brief A cursor over a serialized protobuf message
+ *
+ * It reads the fields in the order of appearance, without constructing any objects; the
+ * length-delimited values are returned as views of the serialized data.
+ * Upon encountering malformed data, the reader stops and `ok()` returns false.
+ *
+ * Typical use:
+ * ```
+ * WireReader r(data);
+ * while (r.Next()) {
+ *   if (r.field() == 1 && r.wire_type() == kLengthDelimited)
+ *     auto bytes = r.ReadBytes();
+ *   else
+ *     r.Skip();
+ * }
+ * if (!r.ok()) ...
+ * ```
+ */
+class WireReader {
+ public:
+  WireReader(const uint8_t *begin, const uint8_t *end) : pos_(begin), end_(end) {}
+  explicit WireReader(span<const uint8_t> data) : WireReader(data.begin(), data.end()) {}
+
+  bool ok() const noexcept { return ok_; }
+
+  /** True at the end of the data or after an error */
+  bool at_end() const noexcept { return !ok_ || pos_ == end_; }
+
+  /** The position of the next field - it can be used to resume reading from that field. */
+  const uint8_t *position() const noexcept { return pos_; }
+
+  /** Reads the tag of the next field; returns false at the end of the message or on error. */
+  bool Next() {
+    if (!ok_ || pos_ == end_)
+      return false;
+    uint64_t tag = ReadVarint();
+    field_ = static_cast<int>(tag >> 3);
+    wire_type_ = static_cast<int>(tag & 7);
+    if (field_ == 0 || (wire_type_ != kVarint && wire_type_ != kFixed64 &&
+                        wire_type_ != kLengthDelimited && wire_type_ != kFixed32))
+      ok_ = false;
+    return ok_;
+  }
+
+  int field() const noexcept { return field_; }
+  int wire_type() const noexcept { return wire_type_; }
+
+  uint64_t ReadVarint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (pos_ == end_)
+        break;
+      uint8_t byte = *pos_++;
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        return value;
+    }
+    ok_ = false;
+    return 0;
+  }
+
+  uint32_t ReadFixed32() {
+    uint32_t value = 0;
+    ReadRaw(&value, sizeof(value));
+    return value;
+  }
+
+  uint64_t ReadFixed64() {
+    uint64_t value = 0;
+    ReadRaw(&value, sizeof(value));
+    return value;
+  }
+
+  /** Reads a length-delimited value: bytes, a string, a message or a packed repeated field. */
+  span<const uint8_t> ReadBytes() {
+    uint64_t length = ReadVarint();
+    if (!ok_ || length > static_cast<uint64_t>(end_ - pos_)) {
+      ok_ = false;
+      return {};
+    }
+    span<const uint8_t> bytes(pos_, length);
+    pos_ += length;
+    return bytes;
+  }
+
+  /** Skips the value of the current field */
+  void Skip() {
+    switch (wire_type_) {
+      case kVarint:
+        ReadVarint();
+        break;
+      case kFixed64:
+        ReadFixed64();
+        break;
+      case kLengthDelimited:
+        ReadBytes();
+        break;
+      case kFixed32:
+        ReadFixed32();
+        break;
+      default:
+        ok_ = false;
+    }
+  }
+
+ private:
+  void ReadRaw(void *out, size_t size) {
+    if (static_cast<size_t>(end_ - pos_) < size) {
+      ok_ = false;
+      return;
+    }
+    std::memcpy(out, pos_, size);  // the wire format is little-endian, just like the host
+    pos_ += size;
+  }
+
+  const uint8_t *pos_, *end_;
+  int field_ = 0, wire_type_ = 0;
+  bool ok_ = true;
+};
+
+inline std::string_view AsStringView(span<const uint8_t> bytes) {
+  return { reinterpret_cast<const char *>(bytes.data()), static_cast<size_t>(bytes.size()) };
+}
+
+}  // namespace proto_wire
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_PARSER_PROTO_WIRE_H_
@@ -15,9 +15,12 @@
 #ifndef DALI_OPERATORS_READER_PARSER_RECORDIO_PARSER_H_
 #define DALI_OPERATORS_READER_PARSER_RECORDIO_PARSER_H_
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <vector>
 
+#include "dali/core/util.h"
 #include "dali/operators/reader/parser/parser.h"
 
 namespace dali {
@@ -37,7 +40,7 @@ class RecordIOParser : public Parser<Tensor<CPUBackend>> {
   void Parse(const Tensor<CPUBackend>& tensor, SampleWorkspace* ws) override {
     auto& image = ws->Output<CPUBackend>(0);
     auto& label = ws->Output<CPUBackend>(1);
-    ReadSingleImageRecordIO(image, label, tensor.data<uint8_t>());
+    ReadSingleImageRecordIO(image, label, tensor.data<uint8_t>(), tensor.size());
     image.SetSourceInfo(tensor.GetSourceInfo());
   }
 
@@ -50,6 +53,36 @@ class RecordIOParser : public Parser<Tensor<CPUBackend>> {
     return rec & ((1U << 29U) - 1U);
   }
 
+  /** The parts of the records are padded to a multiple of 4 bytes */
+  static inline size_t PaddedLength(uint32_t length) {
+    return align_up(length, 4U);
+  }
+
+  /**
+   * @brief Copies the consecutive parts of a record to the outputs
+   *
+   * The first `label_size` bytes go to the label, the rest go to the image.
+   */
+  struct OutputWriter {
+    uint8_t* label;
+    int64_t label_size;
+    uint8_t* image;
+
+    void Write(const void* data, int64_t size) {
+      auto* src = static_cast<const uint8_t*>(data);
+      if (label_size > 0) {
+        int64_t n = std::min(size, label_size);
+        memcpy(label, src, n);
+        label += n;
+        label_size -= n;
+        src += n;
+        size -= n;
+      }
+      memcpy(image, src, size);
+      image += size;
+    }
+  };
+
   template <typename T>
   void ReadSingle(const uint8_t** in, T* out) {
     memcpy(out, *in, sizeof(T));
@@ -58,7 +91,8 @@ class RecordIOParser : public Parser<Tensor<CPUBackend>> {
 
   inline void ReadSingleImageRecordIO(Tensor<CPUBackend>& o_image,
                 Tensor<CPUBackend>& o_label,
-                const uint8_t* input) {
+                const uint8_t* input, int64_t input_size) {
+    const uint8_t* end = input + input_size;
     uint32_t magic;
     const uint32_t kMagic = 0xced7230a;
     ReadSingle<uint32_t>(&input, &magic);
@@ -81,47 +115,39 @@ class RecordIOParser : public Parser<Tensor<CPUBackend>> {
     int64_t data_size = clength - sizeof(ImageRecordIOHeader);
     int64_t label_size = hdr.flag * sizeof(float);
     int64_t image_size = data_size - label_size;
-    if (cflag == 0) {
-      o_image.Resize({image_size}, DALI_UINT8);
-      uint8_t* data = o_image.mutable_data<uint8_t>();
-      memcpy(data, input + label_size, image_size);
-      if (hdr.flag > 0) {
-        float * label = o_label.mutable_data<float>();
-        memcpy(label, input, label_size);
-      }
-    } else {
-      std::vector<uint8_t> temp_vec(data_size);
-      memcpy(&temp_vec[0], input, data_size);
-      input += data_size;
-
-      while (true) {
-        size_t pad = clength - (((clength + 3U) >> 2U) << 2U);
-        input += pad;
-
-        if (cflag != 3) {
-          size_t s = temp_vec.size();
-          temp_vec.resize(static_cast<int64_t>(s + sizeof(kMagic)));
-          memcpy(&temp_vec[s], &kMagic, sizeof(kMagic));
-        } else {
-          break;
-        }
-        ReadSingle(&input, &magic);
-        ReadSingle(&input, &length_flag);
-        cflag = DecodeFlag(length_flag);
-        clength = DecodeLength(length_flag);
-        size_t s = temp_vec.size();
-        temp_vec.resize(static_cast<int64_t>(s + clength));
-        memcpy(&temp_vec[s], input, clength);
-        input += clength;
-      }
-      o_image.Resize({static_cast<Index>(temp_vec.size() - label_size)}, DALI_UINT8);
-      uint8_t* data = o_image.mutable_data<uint8_t>();
-      memcpy(data, (&temp_vec[0]) + label_size, temp_vec.size() - label_size);
-      if (hdr.flag > 0) {
-        float * label = o_label.mutable_data<float>();
-        memcpy(label, &temp_vec[0], label_size);
+    if (cflag != 0) {
+      // A split record - the parts are joined with the magic number, which they were split at.
+      // Compute the total size first, so that the parts can be copied directly to the outputs.
+      const uint8_t* part = input + PaddedLength(clength) - sizeof(ImageRecordIOHeader);
+      for (uint32_t part_flag = cflag; part_flag != 3;) {
+        DALI_ENFORCE(part + 2 * sizeof(uint32_t) <= end,
+                     "Invalid RecordIO: the record is truncated");
+        part += sizeof(magic);
+        ReadSingle(&part, &length_flag);
+        part_flag = DecodeFlag(length_flag);
+        uint32_t part_length = DecodeLength(length_flag);
+        DALI_ENFORCE(part + part_length <= end, "Invalid RecordIO: the record is truncated");
+        image_size += sizeof(kMagic) + part_length;
+        part += PaddedLength(part_length);
       }
     }
+    DALI_ENFORCE(data_size >= 0 && image_size >= 0 && input + data_size <= end,
+                 "Invalid RecordIO: the record is shorter than its header");
+    o_image.Resize({image_size}, DALI_UINT8);
+
+    OutputWriter out{reinterpret_cast<uint8_t*>(o_label.mutable_data<float>()), label_size,
+                     o_image.mutable_data<uint8_t>()};
+    out.Write(input, data_size);
+    input += PaddedLength(clength) - sizeof(ImageRecordIOHeader);
+    while (cflag != 0 && cflag != 3) {
+      out.Write(&kMagic, sizeof(kMagic));
+      ReadSingle(&input, &magic);
+      ReadSingle(&input, &length_flag);
+      cflag = DecodeFlag(length_flag);
+      clength = DecodeLength(length_flag);
+      out.Write(input, clength);
+      input += PaddedLength(clength);
+    }
   }
 };
 
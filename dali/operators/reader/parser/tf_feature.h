@@ -72,7 +72,7 @@ class Feature {
   const std::vector<Index>& Shape() const {
     return shape_;
   }
-  std::vector<Index> PartialShape() const {
+  const std::vector<Index>& PartialShape() const {
     return partial_shape_;
   }
   const Value GetValue() const { return val_; }
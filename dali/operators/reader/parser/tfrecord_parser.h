@@ -17,20 +17,32 @@
 
 #ifdef DALI_BUILD_PROTO3
 
-#include <vector>
+#include <optional>
 #include <string>
-#include <exception>
-#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 #include "dali/core/common.h"
+#include "dali/core/small_vector.h"
+#include "dali/core/span.h"
 #include "dali/pipeline/operator/argument.h"
 #include "dali/pipeline/operator/op_spec.h"
 #include "dali/operators/reader/parser/parser.h"
+#include "dali/operators/reader/parser/proto_wire.h"
 #include "dali/operators/reader/parser/tf_feature.h"
-#include "dali/operators/reader/parser/example.pb.h"
 
 namespace dali {
 
+/**
+ * @brief Extracts the requested features from serialized `tensorflow.Example` records
+ *
+ * The parser reads the protobuf wire format directly. It skips the features which weren't
+ * requested and copies the values of the requested ones straight to the outputs, without
+ * constructing the protobuf objects. The result is the same as that of parsing the message
+ * with protobuf: the last map entry with a given key wins and so does the last list in a
+ * Feature, with the values of consecutive lists of the same kind merged.
+ */
 class TFRecordParser : public Parser<Tensor<CPUBackend>> {
  public:
   using FeatureType = TFUtil::FeatureType;
@@ -47,8 +59,6 @@ class TFRecordParser : public Parser<Tensor<CPUBackend>> {
   }
 
   void Parse(const Tensor<CPUBackend>& tensor, SampleWorkspace* ws) override {
-    tensorflow::Example example;
-
     uint64_t length;
     uint32_t crc;
 
@@ -58,16 +68,21 @@ class TFRecordParser : public Parser<Tensor<CPUBackend>> {
 
     // Omit length and crc
     raw_data = raw_data + sizeof(length) + sizeof(crc);
-    DALI_ENFORCE(example.ParseFromArray(raw_data, length),
-      make_string("Error while parsing TFRecord file: ", tensor.GetSourceInfo(),
-                  " (raw data length: ", length, " bytes)."));
+    auto parse_error = [&]() {
+      return make_string("Error while parsing TFRecord file: ", tensor.GetSourceInfo(),
+                         " (raw data length: ", length, " bytes).");
+    };
+    DALI_ENFORCE(length <= static_cast<uint64_t>(tensor.size()), parse_error());
+
+    // The serialized Feature messages of the requested features, if present
+    SmallVector<std::optional<span<const uint8_t>>, 8> encoded;
+    encoded.resize(features_.size());
+    DALI_ENFORCE(FindFeatures(span<const uint8_t>(raw_data, length), make_span(encoded)),
+                 parse_error());
 
     for (size_t i = 0; i < features_.size(); ++i) {
       auto& output = ws->Output<CPUBackend>(i);
       Feature& f = features_[i];
-      std::string& name = feature_names_[i];
-      auto& feature = example.features().feature();
-      auto it = feature.find(name);
       // set type
       switch (f.GetType()) {
         case FeatureType::int64:
@@ -80,50 +95,34 @@ class TFRecordParser : public Parser<Tensor<CPUBackend>> {
             output.set_type(DALI_FLOAT);
           break;
       }
-      if (it == feature.end()) {
+      if (!encoded[i]) {
         output.Resize({});
         output.SetSourceInfo(tensor.GetSourceInfo());
         continue;
       }
-      auto& encoded_feature = it->second;
+      ValueList list;
+      DALI_ENFORCE(FindValues(*encoded[i], f.GetType(), list), parse_error());
       if (f.HasShape() && f.GetType() != FeatureType::string) {
         output.Resize(f.Shape());
       }
-      ssize_t number_of_elms = 0;
-      switch (f.GetType()) {
-        case FeatureType::int64:
-          number_of_elms = encoded_feature.int64_list().value().size();
-          if (!f.HasShape()) {
-            output.Resize(InferShape(f, number_of_elms));
-          }
-          DALI_ENFORCE(number_of_elms <= output.size(), make_string("Output tensor shape is too "
-                       "small: [", output.shape(), "]. Expected at least ", number_of_elms,
-                       " elements."));
-          std::memcpy(output.mutable_data<int64_t>(),
-              encoded_feature.int64_list().value().data(),
-              encoded_feature.int64_list().value().size()*sizeof(int64_t));
-          break;
-        case FeatureType::string:
-          if (!f.HasShape() || volume(f.Shape()) > 1) {
-            DALI_FAIL("Tensors of strings are not supported.");
-          }
-          output.Resize({static_cast<Index>(encoded_feature.bytes_list().value(0).size())});
-          std::memcpy(output.mutable_data<uint8_t>(),
-              encoded_feature.bytes_list().value(0).c_str(),
-              encoded_feature.bytes_list().value(0).size()*sizeof(uint8_t));
-          break;
-        case FeatureType::float32:
-          number_of_elms = encoded_feature.float_list().value().size();
-          if (!f.HasShape()) {
-            output.Resize(InferShape(f, number_of_elms));
-          }
-          DALI_ENFORCE(number_of_elms <= output.size(), make_string("Output tensor shape is too "
-                       "small: [", output.shape(), "]. Expected at least ", number_of_elms,
-                       " elements."));
-          std::memcpy(output.mutable_data<float>(),
-              encoded_feature.float_list().value().data(),
-              number_of_elms * sizeof(float));
-          break;
+      if (f.GetType() == FeatureType::string) {
+        if (!f.HasShape() || volume(f.Shape()) > 1) {
+          DALI_FAIL("Tensors of strings are not supported.");
+        }
+        output.Resize({static_cast<Index>(list.first_bytes.size())});
+        std::memcpy(output.mutable_data<uint8_t>(), list.first_bytes.data(),
+                    list.first_bytes.size());
+      } else {
+        if (!f.HasShape()) {
+          output.Resize(InferShape(f, list.count));
+        }
+        DALI_ENFORCE(list.count <= output.size(), make_string("Output tensor shape is too "
+                     "small: [", output.shape(), "]. Expected at least ", list.count,
+                     " elements."));
+        if (f.GetType() == FeatureType::int64)
+          CopyValues(*encoded[i], list, output.mutable_data<int64_t>());
+        else
+          CopyValues(*encoded[i], list, output.mutable_data<float>());
       }
       output.SetSourceInfo(tensor.GetSourceInfo());
     }
@@ -133,21 +132,191 @@ class TFRecordParser : public Parser<Tensor<CPUBackend>> {
   std::vector<std::string> feature_names_;
   std::vector<Feature> features_;
 
-  std::vector<Index> InferShape(Feature& feature, size_t feature_size) {
+  // The field numbers in tensorflow.Example, Features (a map entry) and Feature messages
+  static constexpr int kExampleFeatures = 1;
+  static constexpr int kFeaturesEntry = 1;
+  static constexpr int kEntryKey = 1, kEntryValue = 2;
+  static constexpr int kBytesList = 1, kFloatList = 2, kInt64List = 3;
+  static constexpr int kListValue = 1;
+
+  /** The location of the values in a serialized Feature message */
+  struct ValueList {
+    int kind = 0;  // kBytesList, kFloatList, kInt64List or 0, if none
+    const uint8_t *start = nullptr;  // the first list of the kind whose values are used
+    int64_t count = 0;
+    span<const uint8_t> first_bytes;  // the first value of a bytes list
+  };
+
+  static int ListKind(FeatureType type) {
+    switch (type) {
+      case FeatureType::string:
+        return kBytesList;
+      case FeatureType::float32:
+        return kFloatList;
+      default:
+        return kInt64List;
+    }
+  }
+
+  /** Finds the (last) map entries with the requested keys; returns false on malformed data. */
+  bool FindFeatures(span<const uint8_t> example_data,
+                    span<std::optional<span<const uint8_t>>> encoded) const {
+    using namespace proto_wire;  // NOLINT
+    WireReader example(example_data);
+    while (example.Next()) {
+      if (example.field() != kExampleFeatures || example.wire_type() != kLengthDelimited) {
+        example.Skip();
+        continue;
+      }
+      WireReader features(example.ReadBytes());
+      while (features.Next()) {
+        if (features.field() != kFeaturesEntry || features.wire_type() != kLengthDelimited) {
+          features.Skip();
+          continue;
+        }
+        auto entry_data = features.ReadBytes();
+        WireReader entry(entry_data);
+        std::string_view key;
+        // an entry without a value maps to an empty Feature
+        span<const uint8_t> value(entry_data.data(), entry_data.data());
+        while (entry.Next()) {
+          if (entry.field() == kEntryKey && entry.wire_type() == kLengthDelimited)
+            key = AsStringView(entry.ReadBytes());
+          else if (entry.field() == kEntryValue && entry.wire_type() == kLengthDelimited)
+            value = entry.ReadBytes();
+          else
+            entry.Skip();
+        }
+        if (!entry.ok())
+          return false;
+        for (size_t i = 0; i < feature_names_.size(); i++) {
+          if (key == feature_names_[i])
+            encoded[i] = value;
+        }
+      }
+      if (!features.ok())
+        return false;
+    }
+    return example.ok();
+  }
+
+  /** Finds the list of the requested kind in a Feature message and counts its values. */
+  static bool FindValues(span<const uint8_t> feature_data, FeatureType type, ValueList &list) {
+    using namespace proto_wire;  // NOLINT
+    WireReader feature(feature_data);
+    while (true) {
+      const uint8_t *field_start = feature.position();
+      if (!feature.Next())
+        break;
+      int kind = feature.field();
+      if ((kind != kBytesList && kind != kFloatList && kind != kInt64List) ||
+          feature.wire_type() != kLengthDelimited) {
+        feature.Skip();
+        continue;
+      }
+      // Setting a different member of the oneof discards the previous one, while
+      // the consecutive occurrences of the same member are merged.
+      if (kind != list.kind) {
+        list = {};
+        list.kind = kind;
+        list.start = field_start;
+      }
+      WireReader values(feature.ReadBytes());
+      while (values.Next()) {
+        if (values.field() != kListValue) {
+          values.Skip();
+          continue;
+        }
+        if (kind == kBytesList && values.wire_type() == kLengthDelimited) {
+          auto bytes = values.ReadBytes();
+          if (list.count++ == 0)
+            list.first_bytes = bytes;
+        } else if (kind == kFloatList && values.wire_type() == kLengthDelimited) {
+          auto packed = values.ReadBytes();
+          if (packed.size() % sizeof(float))
+            return false;
+          list.count += packed.size() / sizeof(float);
+        } else if (kind == kInt64List && values.wire_type() == kLengthDelimited) {
+          WireReader packed(values.ReadBytes());
+          for (; !packed.at_end(); list.count++)
+            packed.ReadVarint();
+          if (!packed.ok())
+            return false;
+        } else if ((kind == kFloatList && values.wire_type() == kFixed32) ||
+                   (kind == kInt64List && values.wire_type() == kVarint)) {
+          values.Skip();  // a non-packed value
+          list.count++;
+        } else {
+          values.Skip();
+        }
+      }
+      if (!values.ok())
+        return false;
+    }
+    if (!feature.ok())
+      return false;
+    if (list.kind != ListKind(type))
+      list = {};  // there are no values of the requested type
+    return true;
+  }
+
+  /** Decodes the values found with FindValues */
+  template <typename T>
+  static void CopyValues(span<const uint8_t> feature_data, const ValueList &list, T *out) {
+    using namespace proto_wire;  // NOLINT
+    if (!list.kind)
+      return;
+    // the data has already been validated by FindValues
+    WireReader feature(list.start, feature_data.end());
+    while (feature.Next()) {
+      if (feature.field() != list.kind || feature.wire_type() != kLengthDelimited) {
+        feature.Skip();
+        continue;
+      }
+      WireReader values(feature.ReadBytes());
+      while (values.Next()) {
+        if (values.field() != kListValue) {
+          values.Skip();
+        } else if (values.wire_type() == kLengthDelimited) {
+          auto packed = values.ReadBytes();
+          if (std::is_same_v<T, float>) {
+            std::memcpy(out, packed.data(), packed.size());
+            out += packed.size() / sizeof(T);
+          } else {
+            WireReader packed_values(packed);
+            while (!packed_values.at_end())
+              *out++ = static_cast<T>(packed_values.ReadVarint());
+          }
+        } else if (std::is_same_v<T, float> && values.wire_type() == kFixed32) {
+          uint32_t bits = values.ReadFixed32();
+          std::memcpy(out++, &bits, sizeof(float));
+        } else if (!std::is_same_v<T, float> && values.wire_type() == kVarint) {
+          *out++ = static_cast<T>(values.ReadVarint());
+        } else {
+          values.Skip();
+        }
+      }
+    }
+  }
+
+  TensorShape<> InferShape(const Feature& feature, int64_t feature_size) {
     if (feature.HasPartialShape()) {
-      auto partial_shape = feature.PartialShape();
-      auto m = std::accumulate(
-        partial_shape.begin(), partial_shape.end(), 1, std::multiplies<int>());
-      DALI_ENFORCE(feature_size % m == 0, "Feature size not matching partial shape");
-      partial_shape.insert(partial_shape.begin(), feature_size / m);
-      return partial_shape;
+      auto &partial_shape = feature.PartialShape();
+      int64_t m = volume(partial_shape);
+      DALI_ENFORCE(m > 0 && feature_size % m == 0, "Feature size not matching partial shape");
+      TensorShape<> shape;
+      shape.resize(partial_shape.size() + 1);
+      shape[0] = feature_size / m;
+      for (size_t i = 0; i < partial_shape.size(); i++)
+        shape[i + 1] = partial_shape[i];
+      return shape;
     } else {
-      return {static_cast<Index>(feature_size)};
+      return {feature_size};
     }
   }
 };
 
-};  // namespace dali
+}  // namespace dali
 
 #endif  // DALI_BUILD_PROTO3
 
@@ -0,0 +1,186 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef DALI_BUILD_PROTO3
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "dali/operators/reader/parser/tfrecord_parser.h"
+#include "dali/pipeline/workspace/sample_workspace.h"
+
+namespace dali {
+
+namespace {
+
+// A minimal protobuf encoder, which can produce the encodings that protobuf itself doesn't emit
+// (e.g. the non-packed repeated scalars or duplicate map entries).
+
+void PutVarint(std::string &out, uint64_t value) {
+  do {
+    uint8_t byte = value & 0x7f;
+    value >>= 7;
+    out.push_back(static_cast<char>(byte | (value ? 0x80 : 0)));
+  } while (value);
+}
+
+void PutTag(std::string &out, int field, int wire_type) {
+  PutVarint(out, (field << 3) | wire_type);
+}
+
+std::string LengthDelimited(int field, const std::string &payload) {
+  std::string out;
+  PutTag(out, field, proto_wire::kLengthDelimited);
+  PutVarint(out, payload.size());
+  return out + payload;
+}
+
+std::string PackedInt64List(const std::vector<int64_t> &values) {
+  std::string packed;
+  for (auto v : values)
+    PutVarint(packed, static_cast<uint64_t>(v));
+  return LengthDelimited(3, LengthDelimited(1, packed));
+}
+
+std::string NonPackedFloatList(const std::vector<float> &values) {
+  std::string list;
+  for (float v : values) {
+    PutTag(list, 1, proto_wire::kFixed32);
+    list.append(reinterpret_cast<const char *>(&v), sizeof(v));
+  }
+  return LengthDelimited(2, list);
+}
+
+std::string PackedFloatList(const std::vector<float> &values) {
+  std::string packed(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(float));
+  return LengthDelimited(2, LengthDelimited(1, packed));
+}
+
+std::string BytesList(const std::vector<std::string> &values) {
+  std::string list;
+  for (auto &v : values)
+    list += LengthDelimited(1, v);
+  return LengthDelimited(1, list);
+}
+
+std::string Entry(const std::string &key, const std::string &feature) {
+  return LengthDelimited(1, LengthDelimited(1, key) + LengthDelimited(2, feature));
+}
+
+/** Wraps the map entries in Example.features and frames it as a TFRecord */
+Tensor<CPUBackend> MakeRecord(const std::vector<std::string> &entries) {
+  std::string features;
+  for (auto &e : entries)
+    features += e;
+  // an unknown field in Example, which should be skipped
+  std::string example = LengthDelimited(1, features);
+  PutTag(example, 7, proto_wire::kVarint);
+  PutVarint(example, 42);
+
+  Tensor<CPUBackend> record;
+  uint64_t length = example.size();
+  uint32_t crc = 0;
+  record.Resize({static_cast<int64_t>(sizeof(length) + sizeof(crc) + length + sizeof(crc))},
+                DALI_UINT8);
+  auto *data = record.mutable_data<uint8_t>();
+  std::memcpy(data, &length, sizeof(length));
+  std::memcpy(data + sizeof(length) + sizeof(crc), example.data(), length);
+  return record;
+}
+
+template <typename T>
+std::vector<T> Values(const Tensor<CPUBackend> &t) {
+  return std::vector<T>(t.data<T>(), t.data<T>() + t.size());
+}
+
+}  // namespace
+
+TEST(TFRecordParserTest, WireFormat) {
+  using TFUtil::Feature;
+  std::vector<std::string> names = { "a", "b", "c", "d", "e", "p", "d_float" };
+  std::vector<Feature> features = {
+    Feature(TFUtil::int64, {}),
+    Feature(TFUtil::float32, {}),
+    Feature({1}, TFUtil::string, {}),
+    Feature(TFUtil::int64, {}),
+    Feature(TFUtil::int64, {}),
+    Feature(TFUtil::float32, {}, {3}),
+    Feature({4}, TFUtil::float32, {}),
+  };
+  OpSpec spec("TFRecordParser");
+  spec.AddArg("feature_names", names);
+  spec.AddArg("features", features);
+  TFRecordParser parser(spec);
+
+  auto record = MakeRecord({
+    Entry("a", PackedInt64List({7})),  // replaced by the next entry with the same key
+    Entry("skipped", BytesList({std::string(1000, 'x')})),
+    Entry("a", PackedInt64List({1, -2, 300})),
+    Entry("b", NonPackedFloatList({1.5f, 2.5f})),
+    Entry("c", BytesList({"hello", "world"})),
+    // a float list, replaced by two int64 lists, which are merged
+    Entry("d", PackedFloatList({1}) + PackedInt64List({5}) + PackedInt64List({6, 7})),
+    Entry("p", PackedFloatList({1, 2, 3, 4, 5, 6})),
+    Entry("d_float", PackedInt64List({1})),
+  });
+
+  Workspace workspace;
+  SampleWorkspace ws;
+  MakeSampleView(ws, workspace, 0, 0);
+  std::vector<std::unique_ptr<Tensor<CPUBackend>>> outputs;
+  for (size_t i = 0; i < names.size(); i++) {
+    outputs.push_back(std::make_unique<Tensor<CPUBackend>>());
+    ws.AddOutput(outputs.back().get());
+  }
+
+  parser.Parse(record, &ws);
+
+  EXPECT_EQ(outputs[0]->type(), DALI_INT64);
+  EXPECT_EQ(Values<int64_t>(*outputs[0]), (std::vector<int64_t>{1, -2, 300}));
+  EXPECT_EQ(outputs[1]->type(), DALI_FLOAT);
+  EXPECT_EQ(Values<float>(*outputs[1]), (std::vector<float>{1.5f, 2.5f}));
+  EXPECT_EQ(outputs[2]->type(), DALI_UINT8);
+  auto c = Values<uint8_t>(*outputs[2]);
+  EXPECT_EQ(std::string(c.begin(), c.end()), "hello");
+  EXPECT_EQ(Values<int64_t>(*outputs[3]), (std::vector<int64_t>{5, 6, 7}));
+  EXPECT_EQ(outputs[4]->shape(), TensorShape<>());  // missing
+  EXPECT_EQ(outputs[5]->shape(), TensorShape<>(2, 3));
+  EXPECT_EQ(Values<float>(*outputs[5]), (std::vector<float>{1, 2, 3, 4, 5, 6}));
+  // a list of a different type - no values are copied
+  EXPECT_EQ(outputs[6]->shape(), TensorShape<>(4));
+}
+
+TEST(TFRecordParserTest, Malformed) {
+  OpSpec spec("TFRecordParser");
+  spec.AddArg("feature_names", std::vector<std::string>{"a"});
+  spec.AddArg("features", std::vector<TFUtil::Feature>{TFUtil::Feature(TFUtil::int64, {})});
+  TFRecordParser parser(spec);
+
+  Workspace workspace;
+  SampleWorkspace ws;
+  MakeSampleView(ws, workspace, 0, 0);
+  Tensor<CPUBackend> output;
+  ws.AddOutput(&output);
+
+  std::string entry = Entry("a", PackedInt64List({1, 2, 3}));
+  entry.resize(entry.size() - 1);  // truncated in the middle of the packed values
+  auto record = MakeRecord({entry});
+  EXPECT_THROW(parser.Parse(record, &ws), std::runtime_error);
+}
+
+}  // namespace dali
+
+#endif  // DALI_BUILD_PROTO3
@@ -16,6 +16,7 @@
 #define DALI_OPERATORS_READER_READER_OP_H_
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <memory>
 #include <optional>
@@ -25,6 +26,7 @@
 #include <vector>
 #include <unordered_map>
 
+#include "dali/core/mm/memory_tag.h"
 #include "dali/core/nvtx.h"
 #include "dali/operators/reader/loader/loader.h"
 #include "dali/operators/reader/parser/parser.h"
@@ -32,6 +34,10 @@
 #include "dali/pipeline/operator/checkpointing/op_checkpoint.h"
 #include "dali/pipeline/operator/name_utils.h"
 #include "dali/pipeline/operator/operator.h"
+#include "dali/pipeline/util/thread_pool.h"
+#if NVML_ENABLED
+#include "dali/util/nvml.h"
+#endif
 
 namespace dali {
 
@@ -99,6 +105,7 @@ class DataReader : public Operator<Backend> {
     for (int i = 0; i < max_batch_size_; ++i) {
       curr_batch.push_back(loader_->ReadOne(i == 0, i == max_batch_size_ - 1));
     }
+    RunDeferredReads();
     if (IsCheckpointingEnabled()) {
       SaveLoaderSnapshot();
     }
@@ -112,7 +119,7 @@ class DataReader : public Operator<Backend> {
                    "Cannot save the checkpoint, because "
                    "checkpointing was not enabled.");
       const auto &snapshot = loader_snapshot_queue_[snapshot_consumer_];
-      cpt.MutableCheckpointState() = snapshot;
+      cpt.UpdateCheckpointState(snapshot);
     }
   }
 
@@ -146,6 +153,7 @@ class DataReader : public Operator<Backend> {
     while (!finished_) {
       try {
         Prefetch();
+        loader_->FlushSharedCache();
       } catch (const std::exception& e) {
         ProducerStop(std::current_exception());
         return;
@@ -160,7 +168,20 @@ class DataReader : public Operator<Backend> {
     std::lock_guard<std::mutex> lock(prefetch_access_mutex_);
     // if thread hasn't been started yet, start it
     if (prefetch_thread_.joinable()) return;
-    prefetch_thread_ = std::thread(&DataReader::PrefetchWorker, this);
+    // the prefetch thread is pinned like the pipeline's worker threads
+    int device_id = this->spec_.template GetArgument<int>("device_id");
+    bool set_affinity = device_id != CPU_ONLY_DEVICE_ID &&
+                        this->spec_.template GetArgument<bool>("set_affinity");
+    // the loader's allocations are attributed to the operator, like the ones made in Run
+    prefetch_thread_ = std::thread([this, ctx = mm::GetMemoryTagContext(), device_id,
+                                    set_affinity]() {
+#if NVML_ENABLED
+      if (set_affinity)
+        nvml::SetDeviceLocalAffinity(device_id);
+#endif
+      mm::MemoryTagScope scope(ctx);
+      PrefetchWorker();
+    });
   }
 
   // to be called in destructor
@@ -250,6 +271,7 @@ class DataReader : public Operator<Backend> {
     ret.shard_id = loader_->GetShardId();
     ret.pad_last_batch = loader_->PadLastBatch();
     ret.stick_to_shard = loader_->StickToShard();
+    ret.loader_wait_time = loader_wait_ns_.load(std::memory_order_relaxed) * 1e-3;
     return ret;
   }
 
@@ -307,6 +329,30 @@ class DataReader : public Operator<Backend> {
     }
   }
 
+  /**
+   * @brief Runs the reads deferred by the loader on the loader threads and waits for them.
+   *
+   * The loader decides which samples are read (and in which order) sequentially, so the
+   * contents of the batch don't depend on the number of loader threads - only the I/O is
+   * done concurrently.
+   */
+  void RunDeferredReads() {
+    auto reads = loader_->TakeDeferredReads();
+    if (reads.empty())
+      return;
+    if (!loader_thread_pool_) {
+      loader_thread_pool_ = std::make_unique<ThreadPool>(
+          loader_->NumLoaderThreads(), device_id_, false,
+          make_string("LoaderThread ", spec_.SchemaName()));
+    }
+    for (int64_t i = 0; i < static_cast<int64_t>(reads.size()); i++) {
+      loader_thread_pool_->AddWork([read = std::move(reads[i])](int tid) {
+        read();
+      }, -i);  // -i for FIFO order
+    }
+    loader_thread_pool_->RunAll();
+  }
+
   void SaveLoaderSnapshot() {
     loader_snapshot_queue_[snapshot_producer_] = loader_->GetStateSnapshot();
   }
@@ -390,7 +436,15 @@ class DataReader : public Operator<Backend> {
     DomainTimeRange tr("[DALI][DataReader] ConsumerWait #" + to_string(curr_batch_consumer_),
                  DomainTimeRange::kMagenta);
     std::unique_lock<std::mutex> prefetch_lock(prefetch_access_mutex_);
-    consumer_.wait(prefetch_lock, [this]() { return finished_ || !IsPrefetchQueueEmpty(); });
+    if (!finished_ && IsPrefetchQueueEmpty()) {
+      // the loader is behind - measure the time the pipeline is stalled by it
+      auto start = std::chrono::steady_clock::now();
+      consumer_.wait(prefetch_lock, [this]() { return finished_ || !IsPrefetchQueueEmpty(); });
+      int64_t wait_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start).count();
+      loader_wait_ns_.store(loader_wait_ns_.load(std::memory_order_relaxed) + wait_ns,
+                            std::memory_order_relaxed);
+    }
     if (prefetch_error_) std::rethrow_exception(prefetch_error_);
   }
 
@@ -429,6 +483,9 @@ class DataReader : public Operator<Backend> {
   // signal that the prefetch thread has finished
   std::atomic<bool> finished_;
 
+  // the total time spent in ConsumerWait, waiting for the prefetch thread
+  std::atomic<int64_t> loader_wait_ns_{0};
+
   // prefetched batch
   int prefetch_queue_depth_;
   bool skip_cached_images_;
@@ -450,6 +507,9 @@ class DataReader : public Operator<Backend> {
   // stores any catched exceptions in the prefetch worker
   std::exception_ptr prefetch_error_;
 
+  // Threads which run the reads deferred by the loader, created on first use
+  std::unique_ptr<ThreadPool> loader_thread_pool_;
+
   // Loader
   std::unique_ptr<Loader<Backend, LoadTarget, supports_checkpointing>> loader_;
 
@@ -17,6 +17,7 @@
 #include <chrono>
 #include <cstdio>
 #include <fstream>
+#include <future>
 #include <string>
 #include <thread>
 #include <utility>
@@ -544,12 +545,13 @@ class FileReaderTest : public DALITest {
     return {RunEpoch(pipe, batch_size, num_shards, stick_to_shard), cpt};
   }
 
-  void TestCheckpointMidEpoch(bool pad_last_batch, int batch_size, int iters) {
-    auto prepare_pipeline = [this, pad_last_batch](Pipeline &pipe) {
+  void TestCheckpointMidEpoch(bool pad_last_batch, int batch_size, int iters,
+                              bool random_shuffle = false) {
+    auto prepare_pipeline = [this, pad_last_batch, random_shuffle](Pipeline &pipe) {
       pipe.EnableCheckpointing();
       pipe.AddOperator(
           MakeOpSpec(pad_last_batch)
-          .AddArg("shuffle_after_epoch", true)
+          .AddArg(random_shuffle ? "random_shuffle" : "shuffle_after_epoch", true)
           .AddArg("prefetch_queue_depth", 2)
           .AddArg("initial_fill", 3), "file_reader");
       BuildPipeline(pipe);
@@ -799,6 +801,11 @@ TEST_F(FileReaderTest, CheckpointingMidEpoch) {
   TestCheckpointMidEpoch(true, 7, 20);
 }
 
+TEST_F(FileReaderTest, CheckpointingMidEpochRandomShuffle) {
+  // the samples left in the shuffling buffer are read directly, without replaying the epoch
+  TestCheckpointMidEpoch(true, 5, 20, true);
+}
+
 TEST_F(FileReaderTest, CheckpointingNoPadLastBatch) {
   constexpr int batch_size = 3;
   constexpr int iters = 7;
@@ -810,4 +817,41 @@ TEST_F(FileReaderTest, CheckpointingNoPadLastBatch) {
   TestCheckpointMidEpoch(false, batch_size, iters);
 }
 
+TEST_F(FileReaderTest, CheckpointingSerializeAsync) {
+  constexpr int batch_size = 3;
+  constexpr int iters = 12;
+
+  auto prepare_pipeline = [this](Pipeline &pipe) {
+    pipe.EnableCheckpointing();
+    pipe.AddOperator(
+        MakeOpSpec()
+        .AddArg("shuffle_after_epoch", true)
+        .AddArg("initial_fill", 3), "file_reader");
+    BuildPipeline(pipe);
+  };
+
+  Pipeline pipe(batch_size, 1, 0);
+  prepare_pipeline(pipe);
+
+  std::vector<uint8_t> reference;
+  std::vector<std::shared_future<std::string>> checkpoints;
+  for (int i = 0; i < iters; i++) {
+    // the pipeline keeps running while the checkpoints are serialized
+    checkpoints.push_back(pipe.SerializedCheckpointAsync({std::to_string(i), ""}));
+    auto data = RunIter(pipe, batch_size);
+    reference.insert(reference.end(), data.begin(), data.end());
+  }
+
+  for (int i = 0; i < iters; i++) {
+    Pipeline fresh_pipe(batch_size, 1, 0);
+    prepare_pipeline(fresh_pipe);
+    auto ctx = fresh_pipe.RestoreFromSerializedCheckpoint(checkpoints[i].get());
+    EXPECT_EQ(ctx.pipeline_data, std::to_string(i));
+    auto data = RunIter(fresh_pipe, batch_size);
+    std::vector<uint8_t> expected = {reference.begin() + i * batch_size,
+                                     reference.begin() + (i + 1) * batch_size};
+    EXPECT_EQ(data, expected);
+  }
+}
+
 };  // namespace dali
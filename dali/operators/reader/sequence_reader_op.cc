@@ -72,6 +72,12 @@ represent streams.)code",
                     R"code(Distance between consecutive frames in a sequence.)code", 1, false)
     .AddOptionalArg("image_type",
                     R"code(The color space of input and output image.)code", DALI_RGB, false)
+    .AddOptionalArg("frame_cache_size",
+                    R"code(The number of recently read (encoded) frames that are kept in memory.
+
+The overlapping sequences (with ``step`` smaller than the span of a sequence) share their
+frames, so with a cache big enough to hold a sequence, each frame is read from the storage
+only once, instead of up to ``sequence_length`` times.)code", 0, false)
     .AddParent("LoaderBase")
     .AllowSequences()
     .Deprecate(
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2018, 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2018, 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -52,7 +52,58 @@ that is distributed with DALI.)code",
 cache.
 
 Mutually exclusive with ``dont_use_mmap=False``.)code",
-      false);
+      false)
+  .AddOptionalArg("use_io_uring",
+      R"code(If set to True, the records are read with io_uring - the reads of the whole batch
+are submitted to the kernel at once, which reduces the number of system calls and increases the
+I/O parallelism on fast storage.
+
+If io_uring is not available in the system, the reader falls back to regular reads.
+Mutually exclusive with ``dont_use_mmap=False`` and ``use_o_direct``.)code",
+      false)
+  .AddOptionalArg("coalesced_read_bytes",
+      R"code(If greater than 0, reads of records that are adjacent in the same file are merged into
+a single read of up to this many bytes. The samples then refer to slices of that read,
+without copying.
+
+This turns many small reads into a few large sequential ones, which helps especially with
+``use_o_direct`` and network file systems. Ignored when the file is memory mapped
+(``dont_use_mmap=False``), which is zero-copy already.)code",
+      0)
+  .AddOptionalArg<int64_t>("shuffle_block_size",
+      R"code(If greater than 0, the records of each shard are shuffled in blocks of this many
+consecutive records, anew in every epoch.
+
+The order of the blocks is random, but the records of a block are read in the order in which they
+are stored, so the storage is still read sequentially. Combined with ``shuffle_interleave`` and
+the shuffling buffer of ``random_shuffle``, this gives a randomness close to that of a global
+shuffle without a large buffer. The shards contain the same records as without it.)code",
+      0)
+  .AddOptionalArg("shuffle_interleave",
+      R"code(The number of blocks (see ``shuffle_block_size``) that are read at the same time.
+
+The records of these blocks are interleaved, so that the shuffling buffer of ``random_shuffle``
+contains the records of several blocks. The files of the interleaved blocks are kept open.)code",
+      1)
+  .AddOptionalArg("shuffle_after_epoch",
+      R"code(If set to True, the reader shuffles the entire dataset after each epoch.
+
+The records are read in the order of a pseudo-random permutation of their indices, which is
+computed on the fly, so no shuffling buffer is needed and the first batch is available right
+away. The permutation is the same in all shards, so that each epoch is split between the shards.
+
+``stick_to_shard``, ``random_shuffle`` and ``shuffle_block_size`` cannot be used when this
+argument is set to True.)code",
+      false)
+  .AddOptionalArg<int64_t>("prefetch_horizon",
+      R"code(The number of records, following the one being read, that the storage is asked to
+load in the background.
+
+The reader knows the order of the records in advance (also with ``shuffle_block_size`` and
+``shuffle_after_epoch``), so it can hint the operating system to bring them to the page cache
+before they are needed, which hides the latency of the storage. Unlike ``prefetch_queue_depth``,
+this doesn't keep any additional batches in memory. It has no effect with ``use_o_direct``.)code",
+      0);
 
 // Internal readers._tfrecord schema.
 DALI_SCHEMA(readers___TFRecord)
@@ -129,6 +180,7 @@ void TFRecordReader::Prefetch() {
                         });
   }
   thread_pool_.RunAll();
+  idx_loader->SubmitPendingReads();
 }
 
 }  // namespace dali
@@ -90,6 +90,15 @@ When the value is less than 0, ``step`` is set to ``sequence_length``.)code",
       -1)
   .AddOptionalArg("stride",
       R"code(Distance between consecutive frames in the sequence.)code", 1u, false)
+  .AddOptionalArg("frame_cache_size",
+      R"code(The number of decoded frames kept per video file, to be reused by the sequences
+that share them.
+
+Applies **only** to the ``gpu`` backend type.
+
+Useful when the sequences overlap (when ``step`` is smaller than ``sequence_length * stride``),
+for example, with dense sampling. Each cached frame takes ``H * W * C`` bytes of device memory.
+The frames are evicted in the least recently used order.)code", 0)
   .AddParent("LoaderBase");
 
 }  // namespace dali
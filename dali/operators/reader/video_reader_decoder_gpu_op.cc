@@ -14,6 +14,7 @@
 #include "dali/operators/reader/video_reader_decoder_gpu_op.h"
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace dali {
@@ -21,7 +22,11 @@ namespace dali {
 VideoReaderDecoderGpu::VideoReaderDecoderGpu(const OpSpec &spec)
     : DataReader<GPUBackend, VideoSampleGpu, VideoSampleGpu, true>(spec),
       has_labels_(spec.HasArgument("labels")),
-      has_frame_idx_(spec.GetArgument<bool>("enable_frame_num")) {
+      has_frame_idx_(spec.GetArgument<bool>("enable_frame_num")),
+      thread_pool_(num_threads_, spec.GetArgument<int>("device_id"), false,
+                   "VideoReaderDecoderGpu"),
+      decode_streams_(num_threads_, spec.GetArgument<int>("device_id"),
+                      VideoLoaderDecoderGpu::DefaultStreamRequired()) {
       loader_ = InitLoader<VideoLoaderDecoderGpu>(spec);
       this->SetInitialSnapshot();
 }
@@ -30,9 +35,31 @@ void VideoReaderDecoderGpu::Prefetch() {
   DataReader<GPUBackend, VideoSampleGpu, VideoSampleGpu, true>::Prefetch();
 
   auto &current_batch = prefetched_batch_queue_[curr_batch_producer_];
+  // A decoder can't be shared between the threads - the samples from the same file are
+  // decoded one after another (in the batch order), the different files concurrently.
+  std::vector<std::vector<VideoSampleGpu *>> per_file;
+  std::unordered_map<FramesDecoderGpu *, int> file_idx;
   for (auto &sample : current_batch) {
-    sample->Decode();
+    auto it = file_idx.emplace(sample->video_file_, per_file.size()).first;
+    if (it->second == static_cast<int>(per_file.size()))
+      per_file.emplace_back();
+    per_file[it->second].push_back(sample.get());
   }
+
+  for (auto &samples : per_file) {
+    int64_t num_frames = 0;
+    for (auto *sample : samples)
+      num_frames += sample->sequence_len_;
+    thread_pool_.AddWork([this, &samples](int tid) {
+      auto stream = decode_streams_[tid];
+      samples[0]->video_file_->SetStream(stream);
+      for (auto *sample : samples)
+        sample->Decode();
+    }, num_frames);
+  }
+  thread_pool_.RunAll();
+  // the decoded samples are consumed in a different stream
+  decode_streams_.Synchronize();
 }
 
 bool VideoReaderDecoderGpu::SetupImpl(
@@ -18,7 +18,9 @@
 #include <vector>
 
 #include "dali/operators/reader/reader_op.h"
+#include "dali/operators/reader/loader/video/decode_streams.h"
 #include "dali/operators/reader/loader/video/video_loader_decoder_gpu.h"
+#include "dali/pipeline/util/thread_pool.h"
 
 namespace dali {
 class VideoReaderDecoderGpu : public DataReader<GPUBackend, VideoSampleGpu, VideoSampleGpu, true> {
@@ -36,6 +38,10 @@ class VideoReaderDecoderGpu : public DataReader<GPUBackend, VideoSampleGpu, Vide
  private:
   bool has_labels_ = false;
   bool has_frame_idx_  = false;
+
+  // The videos of a batch are decoded concurrently, each thread in its own session
+  ThreadPool thread_pool_;
+  DecodeStreams decode_streams_;
 };
 
 }  // namespace dali
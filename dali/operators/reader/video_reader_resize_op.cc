@@ -41,6 +41,16 @@ This operator combines the features of :meth:`nvidia.dali.fn.video_reader` and :
 )code")
   .NumInput(0)
   .OutputFn(detail::VideoReaderOutputFn)
+  .AddOptionalArg("hw_resize",
+      R"code(If set to True, the frames are scaled by the hardware decoder, as a part of decoding,
+instead of being decoded at full resolution and resized afterwards.
+
+This is possible only for a plain downscale to a fixed size: constant, even ``resize_x`` and
+``resize_y``, with no other size, ``mode`` (other than "stretch") or RoI arguments, and when all
+the videos are at least that large. Otherwise, the regular resize is used. The scaling is done
+with the decoder's own filter, so the interpolation arguments have no effect and the result
+can differ slightly from that of the regular resize.)code",
+      false)
   .AddParent("VideoReader")
   .AddParent("ResizeAttr")
   .AddParent("ResamplingFilterAttr");
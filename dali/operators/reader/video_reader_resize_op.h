@@ -41,7 +41,16 @@ class VideoReaderResize : public VideoReader,
   inline ~VideoReaderResize() override = default;
 
  protected:
+  bool UsesHardwareResize() const {
+    return static_cast<const VideoLoader &>(*loader_).uses_hw_resize();
+  }
+
   void SetOutputShapeType(TensorList<GPUBackend> &output, Workspace &ws) override {
+    if (UsesHardwareResize()) {
+      // the decoder has already scaled the frames to the requested size
+      VideoReader::SetOutputShapeType(output, ws);
+      return;
+    }
     input_shape_ = prefetched_batch_tensors_[curr_batch_consumer_].shape();
 
     resize_attr_.PrepareResizeParams(spec_, ws, input_shape_, "FHWC");
@@ -68,6 +77,10 @@ class VideoReaderResize : public VideoReader,
     TensorList<GPUBackend> &video_output,
     TensorList<GPUBackend> &video_batch,
     Workspace &ws) override {
+    if (UsesHardwareResize()) {
+      VideoReader::ProcessVideo(video_output, video_batch, ws);
+      return;
+    }
     TensorListShape<> input_shape(1, sequence_dim);
     for (int data_idx = 0; data_idx < video_batch.num_samples(); ++data_idx) {
       TensorList<GPUBackend> input;
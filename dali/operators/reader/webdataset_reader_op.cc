@@ -136,8 +136,18 @@ is undefined.
             R"code(The list of the index files corresponding to the respective webdataset archives.
 
 Has to be the same length as the ``paths`` argument. In case it is not provided,
-it will be inferred automatically from the webdataset archive.)code",
+it will be inferred automatically from the webdataset archive.
+
+The archives are indexed concurrently, using the threads of the pipeline.)code",
             std::vector<std::string>())
+    .AddOptionalArg<std::string>("index_cache_dir",
+            R"code(A directory where the indices inferred from the archives are stored.
+
+Used only when ``index_paths`` is not provided. The index of each archive is saved after it is
+inferred and reused in the subsequent runs, unless the archive is modified afterwards.
+The files follow the format of the index files accepted by ``index_paths``.
+To store the indices next to the archives, pass the directory which contains them.)code",
+            nullptr)
     .AddOptionalArg(
         "missing_component_behavior",
         R"code(Specifies what to do in case there is not any file in a sample corresponding to a certain output.
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -17,13 +17,11 @@
 #include "dali/core/static_switch.h"
 #include "dali/pipeline/operator/operator.h"
 #include "dali/operators/random/rng_base_cpu.h"
+#include "dali/operators/segmentation/random_mask_pixel.h"
 #include "dali/operators/segmentation/utils/searchable_rle_mask.h"
 #include "dali/kernels/common/utils.h"
 #include "dali/core/boundary.h"
 
-#define MASK_SUPPORTED_TYPES (uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, \
-                              uint64_t, int64_t, float, bool)
-
 namespace dali {
 
 DALI_SCHEMA(segmentation__RandomMaskPixel)
@@ -53,10 +51,9 @@ If 0, the pixel position is sampled uniformly from all available pixels.)code",
     .NumInput(1)
     .NumOutput(1);
 
-class RandomMaskPixelCPU : public rng::OperatorWithRng<CPUBackend> {
+class RandomMaskPixelCPU : public RandomMaskPixel<CPUBackend> {
  public:
-  explicit RandomMaskPixelCPU(const OpSpec &spec);
-  bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override;
+  explicit RandomMaskPixelCPU(const OpSpec &spec) : RandomMaskPixel<CPUBackend>(spec) {}
   void RunImpl(Workspace &ws) override;
 
  private:
@@ -64,48 +61,8 @@ class RandomMaskPixelCPU : public rng::OperatorWithRng<CPUBackend> {
   void RunImplTyped(Workspace &ws);
 
   std::vector<SearchableRLEMask> rle_;
-
-  std::vector<int> foreground_;
-  std::vector<int> value_;
-  std::vector<float> threshold_;
-
-  bool has_value_ = false;
-
-  USE_OPERATOR_MEMBERS();
 };
 
-RandomMaskPixelCPU::RandomMaskPixelCPU(const OpSpec &spec)
-    : rng::OperatorWithRng<CPUBackend>(spec),
-      has_value_(spec.ArgumentDefined("value")) {
-  if (has_value_) {
-    DALI_ENFORCE(!spec.ArgumentDefined("threshold"),
-                 "Arguments ``value`` and ``threshold`` can not be provided together");
-  }
-}
-
-bool RandomMaskPixelCPU::SetupImpl(std::vector<OutputDesc> &output_desc,
-                                    const Workspace &ws) {
-  const auto &in_masks = ws.Input<CPUBackend>(0);
-  int nsamples = in_masks.num_samples();
-  auto in_masks_shape = in_masks.shape();
-  int ndim = in_masks_shape.sample_dim();
-  output_desc.resize(1);
-  output_desc[0].shape = uniform_list_shape(nsamples, {ndim});
-  output_desc[0].type = DALI_INT64;
-
-  foreground_.resize(nsamples);
-  value_.clear();
-  threshold_.clear();
-
-  GetPerSampleArgument(foreground_, "foreground", ws, nsamples);
-  if (spec_.ArgumentDefined("value")) {
-    GetPerSampleArgument(value_, "value", ws, nsamples);
-  } else {
-    GetPerSampleArgument(threshold_, "threshold", ws, nsamples);
-  }
-  return true;
-}
-
 template <typename T>
 void RandomMaskPixelCPU::RunImplTyped(Workspace &ws) {
   const auto &in_masks = ws.Input<CPUBackend>(0);
@@ -0,0 +1,78 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_SEGMENTATION_RANDOM_MASK_PIXEL_H_
+#define DALI_OPERATORS_SEGMENTATION_RANDOM_MASK_PIXEL_H_
+
+#include <vector>
+#include "dali/operators/random/rng_base.h"
+#include "dali/pipeline/operator/operator.h"
+
+#define MASK_SUPPORTED_TYPES (uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, \
+                              uint64_t, int64_t, float, bool)
+
+namespace dali {
+
+/**
+ * @brief Common argument handling for the CPU and GPU variants of RandomMaskPixel
+ *
+ * Both variants draw the random numbers on the host, with the same sequence of calls,
+ * so they return the same pixel positions for the same seed.
+ */
+template <typename Backend>
+class RandomMaskPixel : public rng::OperatorWithRng<Backend> {
+ public:
+  explicit RandomMaskPixel(const OpSpec &spec)
+      : rng::OperatorWithRng<Backend>(spec),
+        has_value_(spec.ArgumentDefined("value")) {
+    if (has_value_) {
+      DALI_ENFORCE(!spec.ArgumentDefined("threshold"),
+                   "Arguments ``value`` and ``threshold`` can not be provided together");
+    }
+  }
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override {
+    auto in_masks_shape = ws.GetInputShape(0);
+    int nsamples = in_masks_shape.num_samples();
+    int ndim = in_masks_shape.sample_dim();
+    output_desc.resize(1);
+    output_desc[0].shape = uniform_list_shape(nsamples, {ndim});
+    output_desc[0].type = DALI_INT64;
+
+    foreground_.resize(nsamples);
+    value_.clear();
+    threshold_.clear();
+
+    this->GetPerSampleArgument(foreground_, "foreground", ws, nsamples);
+    if (has_value_) {
+      this->GetPerSampleArgument(value_, "value", ws, nsamples);
+    } else {
+      this->GetPerSampleArgument(threshold_, "threshold", ws, nsamples);
+    }
+    return true;
+  }
+
+  std::vector<int> foreground_;
+  std::vector<int> value_;
+  std::vector<float> threshold_;
+
+  bool has_value_ = false;
+
+  USE_OPERATOR_MEMBERS();
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_SEGMENTATION_RANDOM_MASK_PIXEL_H_
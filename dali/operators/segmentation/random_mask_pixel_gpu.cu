@@ -0,0 +1,300 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cuda_runtime.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/static_switch.h"
+#include "dali/core/util.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/operators/random/rng_base_gpu.h"
+#include "dali/operators/random/rng_checkpointing_utils.h"
+#include "dali/operators/segmentation/random_mask_pixel.h"
+#include "dali/pipeline/data/views.h"
+
+namespace dali {
+
+namespace random_mask_pixel {
+
+constexpr int kBlockSize = 256;
+constexpr int kItemsPerThread = 8;
+constexpr int kTileSize = kBlockSize * kItemsPerThread;
+
+template <typename T>
+struct SampleDesc {
+  const T *in;
+  int64_t volume;
+  /// 0, if the foreground is not searched for in this sample
+  int num_tiles;
+  int64_t *tile_counts;
+  bool use_value;
+  T value;
+  float threshold;
+};
+
+/**
+ * @brief Describes the pixel to be written to the output
+ *
+ * If `tile` is non-negative, the output is the position of the `rank`-th foreground pixel
+ * in that tile; otherwise the coordinates drawn on the host are copied from `coords`.
+ */
+struct PixelDesc {
+  int64_t *out;
+  const int64_t *shape;
+  const int64_t *coords;
+  int ndim;
+  int64_t tile;
+  int64_t rank;
+};
+
+template <typename T>
+DALI_DEVICE DALI_FORCEINLINE bool IsForeground(const SampleDesc<T> &sample, T x) {
+  return sample.use_value ? x == sample.value : x > sample.threshold;
+}
+
+/**
+ * @brief Counts the foreground pixels in each tile of the samples
+ */
+template <typename T>
+__global__ void CountForegroundKernel(const SampleDesc<T> *samples) {
+  const auto &sample = samples[blockIdx.y];
+  if (static_cast<int>(blockIdx.x) >= sample.num_tiles)
+    return;
+  int64_t start = static_cast<int64_t>(blockIdx.x) * kTileSize;
+  int count = 0;
+  for (int k = 0; k < kItemsPerThread; k++) {
+    int64_t i = start + k * kBlockSize + threadIdx.x;
+    count += __syncthreads_count(i < sample.volume && IsForeground(sample, sample.in[i]));
+  }
+  if (threadIdx.x == 0)
+    sample.tile_counts[blockIdx.x] = count;
+}
+
+/**
+ * @brief Finds the selected foreground pixel in its tile and writes its coordinates,
+ *        one block per sample
+ */
+template <typename T>
+__global__ void FindPixelKernel(const SampleDesc<T> *samples, const PixelDesc *pixels) {
+  const auto &sample = samples[blockIdx.x];
+  const auto &pixel = pixels[blockIdx.x];
+  if (pixel.tile < 0) {
+    for (int d = threadIdx.x; d < pixel.ndim; d += blockDim.x)
+      pixel.out[d] = pixel.coords[d];
+    return;
+  }
+
+  constexpr int kNumWarps = kBlockSize / 32;
+  __shared__ int warp_counts[kNumWarps];
+  __shared__ int64_t flat_idx;
+  int lane = threadIdx.x % 32;
+  int warp = threadIdx.x / 32;
+  int64_t start = pixel.tile * kTileSize;
+  int64_t base = 0;  // the number of foreground pixels in the preceding chunks of the tile
+  for (int k = 0; k < kItemsPerThread; k++) {
+    int64_t i = start + k * kBlockSize + threadIdx.x;
+    bool fg = i < sample.volume && IsForeground(sample, sample.in[i]);
+    unsigned mask = __ballot_sync(0xffffffffu, fg);
+    if (lane == 0)
+      warp_counts[warp] = __popc(mask);
+    __syncthreads();
+    int64_t rank = base + __popc(mask & ((1u << lane) - 1));
+    for (int w = 0; w < kNumWarps; w++) {
+      if (w < warp)
+        rank += warp_counts[w];
+      base += warp_counts[w];
+    }
+    if (fg && rank == pixel.rank)
+      flat_idx = i;
+    __syncthreads();
+    if (base > pixel.rank)
+      break;
+  }
+
+  if (threadIdx.x == 0) {
+    int64_t idx = flat_idx;
+    for (int d = pixel.ndim - 1; d >= 0; d--) {
+      pixel.out[d] = idx % pixel.shape[d];
+      idx /= pixel.shape[d];
+    }
+  }
+}
+
+}  // namespace random_mask_pixel
+
+/**
+ * @brief GPU variant of RandomMaskPixel
+ *
+ * The foreground pixels are counted per tile on the GPU. The host then draws the index of
+ * the pixel with the same random number generator calls as the CPU variant, so the results are
+ * identical, and the GPU finds the coordinates of the pixel within the selected tile.
+ */
+class RandomMaskPixelGPU : public RandomMaskPixel<GPUBackend> {
+ public:
+  explicit RandomMaskPixelGPU(const OpSpec &spec) : RandomMaskPixel<GPUBackend>(spec) {}
+
+  // The pixels are drawn on the host with `rng_`
+  using RngCheckpointUtils = rng::RngCheckpointUtils<CPUBackend, BatchRNG<std::mt19937_64>>;
+
+  void SaveState(OpCheckpoint &cpt, AccessOrder order) override {
+    RngCheckpointUtils::SaveState(cpt, order, this->rng_);
+  }
+
+  void RestoreState(const OpCheckpoint &cpt) override {
+    RngCheckpointUtils::RestoreState(cpt, this->rng_);
+  }
+
+  std::string SerializeCheckpoint(const OpCheckpoint &cpt) const override {
+    return RngCheckpointUtils::SerializeCheckpoint(cpt);
+  }
+
+  void DeserializeCheckpoint(OpCheckpoint &cpt, const std::string &data) const override {
+    RngCheckpointUtils::DeserializeCheckpoint(cpt, data);
+  }
+
+  void RunImpl(Workspace &ws) override;
+
+ private:
+  template <typename T>
+  void RunImplTyped(Workspace &ws);
+
+  std::vector<random_mask_pixel::PixelDesc> pixels_;
+  std::vector<int64_t> coords_;
+};
+
+template <typename T>
+void RandomMaskPixelGPU::RunImplTyped(Workspace &ws) {
+  using random_mask_pixel::kBlockSize;
+  using random_mask_pixel::kTileSize;
+  const auto &in_masks = ws.Input<GPUBackend>(0);
+  auto &out_pixel_pos = ws.Output<GPUBackend>(0);
+  int nsamples = in_masks.num_samples();
+  const auto &in_masks_shape = in_masks.shape();
+  int ndim = in_masks_shape.sample_dim();
+  auto masks_view = view<const T>(in_masks);
+  auto pixel_pos_view = view<int64_t>(out_pixel_pos);
+  if (nsamples == 0)
+    return;
+
+  cudaStream_t stream = ws.stream();
+  kernels::DynamicScratchpad scratchpad({}, AccessOrder(stream));
+
+  std::vector<random_mask_pixel::SampleDesc<T>> samples(nsamples);
+  int64_t total_tiles = 0;
+  int max_tiles = 0;
+  for (int i = 0; i < nsamples; i++) {
+    auto &s = samples[i];
+    s.in = masks_view.data[i];
+    s.volume = in_masks_shape.tensor_size(i);
+    s.use_value = has_value_;
+    s.value = {};
+    s.threshold = 0;
+    s.tile_counts = nullptr;
+    bool search = foreground_[i];
+    if (has_value_) {
+      s.value = static_cast<T>(value_[i]);
+      // checking if the value is representable by T, otherwise we
+      // just fall back to pick a random pixel.
+      search = search && static_cast<int>(s.value) == value_[i];
+    } else {
+      s.threshold = threshold_[i];
+    }
+    s.num_tiles = search ? div_ceil(s.volume, kTileSize) : 0;
+    total_tiles += s.num_tiles;
+    max_tiles = std::max(max_tiles, s.num_tiles);
+  }
+
+  const int64_t *tile_counts = nullptr;
+  if (max_tiles > 0) {
+    auto *tile_counts_gpu = scratchpad.AllocateGPU<int64_t>(total_tiles);
+    auto *counts = tile_counts_gpu;
+    for (auto &s : samples) {
+      s.tile_counts = counts;
+      counts += s.num_tiles;
+    }
+    auto *samples_gpu = scratchpad.ToGPU(stream, samples);
+    dim3 grid(max_tiles, nsamples);
+    random_mask_pixel::CountForegroundKernel<<<grid, kBlockSize, 0, stream>>>(samples_gpu);
+    CUDA_CALL(cudaGetLastError());
+    auto *tile_counts_cpu = scratchpad.AllocatePinned<int64_t>(total_tiles);
+    CUDA_CALL(cudaMemcpyAsync(tile_counts_cpu, tile_counts_gpu, total_tiles * sizeof(int64_t),
+                              cudaMemcpyDeviceToHost, stream));
+    CUDA_CALL(cudaStreamSynchronize(stream));
+    tile_counts = tile_counts_cpu;
+  }
+
+  pixels_.resize(nsamples);
+  coords_.resize(nsamples * ndim);
+  for (int i = 0; i < nsamples; i++) {
+    auto &rng = this->rng_[i];
+    auto &s = samples[i];
+    auto &pixel = pixels_[i];
+    pixel.out = pixel_pos_view.data[i];
+    pixel.ndim = ndim;
+    pixel.tile = -1;
+    pixel.rank = 0;
+    if (s.num_tiles > 0) {
+      int64_t count = 0;
+      for (int t = 0; t < s.num_tiles; t++)
+        count += tile_counts[t];
+      if (count > 0) {
+        int64_t k = std::uniform_int_distribution<int64_t>(0, count - 1)(rng);
+        int t = 0;
+        for (; k >= tile_counts[t]; t++)
+          k -= tile_counts[t];
+        pixel.tile = t;
+        pixel.rank = k;
+      }
+      tile_counts += s.num_tiles;
+    }
+    if (pixel.tile < 0) {
+      // Either foreground == 0 or no foreground pixels found. Get a random center
+      auto mask_sh = in_masks_shape.tensor_shape_span(i);
+      for (int d = 0; d < ndim; d++)
+        coords_[i * ndim + d] = std::uniform_int_distribution<int64_t>(0, mask_sh[d] - 1)(rng);
+    }
+  }
+
+  const int64_t *shapes_gpu = nullptr, *coords_gpu = nullptr;
+  if (ndim > 0)
+    std::tie(shapes_gpu, coords_gpu) =
+        scratchpad.ToContiguousGPU(stream, in_masks_shape.shapes, coords_);
+  for (int i = 0; i < nsamples; i++) {
+    pixels_[i].shape = shapes_gpu + i * ndim;
+    pixels_[i].coords = coords_gpu + i * ndim;
+  }
+  random_mask_pixel::SampleDesc<T> *samples_gpu;
+  random_mask_pixel::PixelDesc *pixels_gpu;
+  std::tie(samples_gpu, pixels_gpu) = scratchpad.ToContiguousGPU(stream, samples, pixels_);
+  random_mask_pixel::FindPixelKernel<<<nsamples, kBlockSize, 0, stream>>>(samples_gpu,
+                                                                          pixels_gpu);
+  CUDA_CALL(cudaGetLastError());
+}
+
+void RandomMaskPixelGPU::RunImpl(Workspace &ws) {
+  const auto &in_masks = ws.Input<GPUBackend>(0);
+  TYPE_SWITCH(in_masks.type(), type2id, T, MASK_SUPPORTED_TYPES, (
+    RunImplTyped<T>(ws);
+  ), (  // NOLINT
+    DALI_FAIL(make_string("Unexpected data type: ", in_masks.type()));
+  ));  // NOLINT
+}
+
+DALI_REGISTER_OPERATOR(segmentation__RandomMaskPixel, RandomMaskPixelGPU, GPU);
+
+}  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -28,10 +28,13 @@ For example, for ``element_map = [2, 0, 3]`` there will be three outputs, contai
 
 The input layout, if provided, must begin with ``F`` dimension. The outputs will have one less
 dimension than the input, that is for ``FHWC`` inputs, the outputs will be ``HWC`` elements.
+
+The outputs are views of the input - the elements are not copied.
 )code")
     .NumInput(1)
     .NumOutput(1)
     .SequenceOperator()
+    .SamplewisePassThrough()
     .AddArg("element_map",
         R"code(Indices of the elements to extract.)code",
         DALI_INT_VEC)
@@ -44,11 +47,6 @@ dimension than the input, that is for ``FHWC`` inputs, the outputs will be ``HWC
         });
 
 
-template <>
-void ElementExtract<CPUBackend>::RunCopies(Workspace &ws) {
-  scatter_gather_.Run(ws.GetThreadPool(), true);
-}
-
 DALI_REGISTER_OPERATOR(ElementExtract, ElementExtract<CPUBackend>, CPU);
 
 }  // namespace dali
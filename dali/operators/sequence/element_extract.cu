@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -12,17 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <utility>
-#include <vector>
 #include "dali/operators/sequence/element_extract.h"
 
 namespace dali {
 
-template <>
-void ElementExtract<GPUBackend>::RunCopies(Workspace &ws) {
-  scatter_gather_.Run(ws.stream(), true);
-}
-
 DALI_REGISTER_OPERATOR(ElementExtract, ElementExtract<GPUBackend>, GPU);
 
 }  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,13 +16,12 @@
 #ifndef DALI_OPERATORS_SEQUENCE_ELEMENT_EXTRACT_H_
 #define DALI_OPERATORS_SEQUENCE_ELEMENT_EXTRACT_H_
 
-#include <type_traits>
 #include <vector>
 #include "dali/core/common.h"
 #include "dali/core/format.h"
 #include "dali/core/tensor_layout.h"
 #include "dali/core/tensor_shape.h"
-#include "dali/kernels/common/scatter_gather.h"
+#include "dali/operators/sequence/frame_views.h"
 #include "dali/pipeline/operator/checkpointing/stateless_operator.h"
 #include "dali/pipeline/operator/operator.h"
 
@@ -70,7 +69,7 @@ template <typename Backend>
 class ElementExtract : public StatelessOperator<Backend> {
  public:
   inline explicit ElementExtract(const OpSpec &spec)
-      : StatelessOperator<Backend>(spec), scatter_gather_(kMaxSizePerBlock) {
+      : StatelessOperator<Backend>(spec) {
     element_map_ = spec.GetRepeatedArgument<int>("element_map");
 
     DALI_ENFORCE(!element_map_.empty(), "No `element_map` indicies provided");
@@ -83,54 +82,37 @@ class ElementExtract : public StatelessOperator<Backend> {
   }
 
  protected:
+  /**
+   * @brief The outputs are views of the input frames - nothing is allocated
+   */
   bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override {
     const auto &input = ws.Input<Backend>(0);
-    output_desc.resize(element_map_.size());
-    auto output_shape = detail::GetOutputShape(input.shape(), element_map_, input.GetLayout());
-    for (auto &desc : output_desc) {
-      desc.shape = output_shape;
-      desc.type = input.type();
-    }
-    return true;
+    detail::GetOutputShape(input.shape(), element_map_, input.GetLayout());
+    return false;
   }
 
   void RunImpl(Workspace &ws) override {
     auto &input = ws.Input<Backend>(0);
     auto element_layout = VideoLayoutInfo::GetFrameLayout(input.GetLayout());
     int elements_per_sample = element_map_.size();
-    auto data_type = input.type_info();
+    int num_samples = input.num_samples();
+    int element_dim = input.sample_dim() - 1;
     for (int k = 0; k < elements_per_sample; k++) {
       int element = element_map_[k];
       auto &output = ws.Output<Backend>(k);
-      for (int i = 0; i < input.num_samples(); i++) {
+      SetupFrameViews(output, input, num_samples, element_dim, element_layout);
+      for (int i = 0; i < num_samples; i++) {
         auto tensor_shape = input.tensor_shape(i);
-        auto element_size = volume(tensor_shape.begin() + 1, tensor_shape.end());
-        auto input_offset_bytes = element * element_size * data_type.size();
-        scatter_gather_.AddCopy(
-            output.raw_mutable_tensor(i),
-            static_cast<const uint8_t *>(input.raw_tensor(i)) + input_offset_bytes,
-            element_size * data_type.size());
+        ShareFrames(output, i, input, i, element, tensor_shape.last(element_dim));
       }
-      output.SetLayout(element_layout);
     }
-    RunCopies(ws);
   }
 
-  void RunCopies(Workspace &ws);
-
   USE_OPERATOR_MEMBERS();
   using Operator<Backend>::RunImpl;
 
  private:
   std::vector<int> element_map_;
-
-  std::conditional_t<
-      std::is_same<Backend, CPUBackend>::value,
-      kernels::ScatterGatherCPU,
-      kernels::ScatterGatherGPU> scatter_gather_;
-  // 256 kB per block for GPU
-  static constexpr size_t kMaxSizePerBlock =
-      std::is_same<Backend, CPUBackend>::value ? kernels::ScatterGatherCPU::kAnyBlockSize : 1 << 18;
 };
 
 }  // namespace dali
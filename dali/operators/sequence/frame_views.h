@@ -0,0 +1,68 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_SEQUENCE_FRAME_VIEWS_H_
+#define DALI_OPERATORS_SEQUENCE_FRAME_VIEWS_H_
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include "dali/core/tensor_layout.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/pipeline/data/tensor_list.h"
+
+namespace dali {
+
+/**
+ * @brief Prepares `out` to hold `num_samples` views of the input samples (see ShareFrames).
+ *
+ * The output becomes non-contiguous; its order is left intact, as it's set by the executor.
+ */
+template <typename Backend>
+void SetupFrameViews(TensorList<Backend> &out, const TensorList<Backend> &in, int num_samples,
+                     int sample_dim, const TensorLayout &layout) {
+  out.Reset();
+  out.set_type(in.type());
+  out.set_sample_dim(sample_dim);
+  out.SetLayout(layout);
+  out.set_device_id(in.device_id());
+  out.set_pinned(in.is_pinned());
+  out.SetSize(num_samples);
+}
+
+/**
+ * @brief Sets the output sample as a view of consecutive frames of an input sample.
+ *
+ * The outermost dimension of the input sample is the frame index. The view begins at
+ * `first_frame` and has `shape` - either a range of frames or a single frame with the
+ * frame dimension removed. The output sample shares the ownership of the input allocation.
+ */
+template <typename Backend>
+void ShareFrames(TensorList<Backend> &out, int out_idx, const TensorList<Backend> &in,
+                 int in_idx, int64_t first_frame, const TensorShape<> &shape) {
+  auto in_shape = in.tensor_shape_span(in_idx);
+  int64_t frame_size = volume(in_shape.begin() + 1, in_shape.end());
+  size_t type_size = in.type_info().size();
+  // unsafe_sample_owner only reads the batch (materializing the sample views is thread-safe)
+  auto &owner = const_cast<TensorList<Backend> &>(in);
+  auto *data = static_cast<uint8_t *>(owner.raw_mutable_tensor(in_idx)) +
+               first_frame * frame_size * type_size;
+  std::shared_ptr<void> ptr(unsafe_sample_owner(owner, in_idx), data);
+  out.SetSample(out_idx, std::move(ptr), volume(shape) * type_size, in.is_pinned(), shape,
+                in.type(), in.device_id(), in.order(), out.GetLayout());
+}
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_SEQUENCE_FRAME_VIEWS_H_
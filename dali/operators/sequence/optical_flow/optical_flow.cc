@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -101,87 +101,55 @@ constexpr int kNInputDims = 4;
 
 template<>
 void OpticalFlow<GPUBackend>::RunImpl(Workspace &ws) {
-  // This is a workaround for an issue with nvcuvid in drivers >460 and < 470.21 where concurrent
-  // use on default context and non-default streams may lead to memory corruption.
-  cudaStream_t of_stream = ws.stream();
-#if NVML_ENABLED
-  {
-    static float driver_version = nvml::GetDriverVersion();
-    if (driver_version > 460 && driver_version < 470.21)
-      of_stream = 0;
-  }
-#else
-  {
-    int driver_cuda_version = 0;
-    CUDA_CALL(cuDriverGetVersion(&driver_cuda_version));
-    if (driver_cuda_version >= 11030 && driver_cuda_version < 11040)
-      of_stream = 0;
-  }
-#endif
-  if (of_stream != ws.stream()) {
+  if (RequiresDefaultStream()) {
     DALI_WARN_ONCE("Warning: Running optical flow on a default stream.\n"
                    "Performance may be affected.");
   }
 
-  if (of_stream != ws.stream()) {
-    CUDA_CALL(cudaEventRecord(sync_, ws.stream()));
-    CUDA_CALL(cudaStreamWaitEvent(of_stream, sync_, 0));
-  }
   const auto &input = ws.Input<GPUBackend>(0);
   auto &output = ws.Output<GPUBackend>(0);
   output.SetLayout("FHWC");  // Channels represent the two flow vector components (x and y)
 
-  auto input_sh = input.shape();
-
+  // Prepare input and output TensorViews
+  auto tvlin = view<const uint8_t, kNInputDims>(input);
+  auto tvlout = view<float, kNInputDims>(output);
+  TensorListView<StorageGPU, const float, kNInputDims> tvlhints;
   if (enable_external_hints_) {
-    const auto &hints = ws.Input<GPUBackend>(1);
-
-    // Prepare input and output TensorViews
-    auto tvlin = view<const uint8_t, kNInputDims>(input);
-    auto tvlout = view<float, kNInputDims>(output);
-    auto tvlhints = view<const float, kNInputDims>(hints);
+    tvlhints = view<const float, kNInputDims>(ws.Input<GPUBackend>(1));
     DALI_ENFORCE(tvlhints.size() == nsequences_,
                  "Number of tensors for hints and inputs doesn't match");
-    for (int j = 0; j < nsequences_; j++) {
-      int sequence_idx = processing_order_[j].idx;
-      auto sequence_tv = tvlin[sequence_idx];
-      auto output_tv = tvlout[sequence_idx];
-      auto hints_tv = tvlhints[sequence_idx];
-
-      for (int i = 1; i < sequence_tv.shape[0]; i++) {
-        auto ref = subtensor(sequence_tv, i - 1);
-        auto in = subtensor(sequence_tv, i);
-        auto h = subtensor(hints_tv, i);
-        auto out = subtensor(output_tv, i - 1);
-
-        optical_flow_->Prepare(input_sh[sequence_idx][2], input_sh[sequence_idx][1]);
-        optical_flow_->CalcOpticalFlow(ref, in, out, h);
-      }
+  }
+
+  auto process_sequence = [&](optical_flow::OpticalFlowAdapter<ComputeGPU> &flow,
+                              int sequence_idx) {
+    auto sequence_tv = tvlin[sequence_idx];
+    auto output_tv = tvlout[sequence_idx];
+    for (int i = 1; i < sequence_tv.shape[0]; i++) {
+      auto ref = subtensor(sequence_tv, i - 1);
+      auto in = subtensor(sequence_tv, i);
+      auto out = subtensor(output_tv, i - 1);
+      if (enable_external_hints_)
+        flow.CalcOpticalFlow(ref, in, out, subtensor(tvlhints[sequence_idx], i));
+      else
+        flow.CalcOpticalFlow(ref, in, out);
     }
-  } else {
-    // Prepare input and output TensorViews
-    auto tvlin = view<const uint8_t, kNInputDims>(input);
-    auto tvlout = view<float, kNInputDims>(output);
-
-    for (int j = 0; j < nsequences_; j++) {
-      int sequence_idx = processing_order_[j].idx;
-      auto sequence_tv = tvlin[sequence_idx];
-      auto output_tv = tvlout[sequence_idx];
-
-      for (int i = 1; i < sequence_tv.shape[0]; i++) {
-        auto ref = subtensor(sequence_tv, i - 1);
-        auto in = subtensor(sequence_tv, i);
-        auto out = subtensor(output_tv, i - 1);
-
-        optical_flow_->Prepare(input_sh[sequence_idx][2], input_sh[sequence_idx][1]);
-        optical_flow_->CalcOpticalFlow(ref, in, out);
-      }
+  };
+
+  // The sequences of each size are distributed among the sessions for that size; the sessions
+  // run on separate streams, which are synchronized with the operator's stream.
+  CUDA_CALL(cudaEventRecord(sync_, ws.stream()));
+  for (auto &[size, sequences] : size_groups_) {
+    auto &sessions = sessions_[size].sessions;
+    int num_sessions = std::min<int>(sequences.size(), sessions.size());
+    for (int s = 0; s < num_sessions; s++)
+      CUDA_CALL(cudaStreamWaitEvent(sessions[s].stream.get(), sync_, 0));
+    for (size_t j = 0; j < sequences.size(); j++)
+      process_sequence(*sessions[j % num_sessions].flow, sequences[j]);
+    for (int s = 0; s < num_sessions; s++) {
+      CUDA_CALL(cudaEventRecord(sessions[s].done, sessions[s].stream.get()));
+      CUDA_CALL(cudaStreamWaitEvent(ws.stream(), sessions[s].done, 0));
     }
   }
-  if (of_stream != ws.stream()) {
-    CUDA_CALL(cudaEventRecord(sync_, of_stream));
-    CUDA_CALL(cudaStreamWaitEvent(ws.stream(), sync_, 0));
-  }
 }
 
 template <>
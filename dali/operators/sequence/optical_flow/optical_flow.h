@@ -15,10 +15,13 @@
 #ifndef DALI_OPERATORS_SEQUENCE_OPTICAL_FLOW_OPTICAL_FLOW_H_
 #define DALI_OPERATORS_SEQUENCE_OPTICAL_FLOW_OPTICAL_FLOW_H_
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
 #include "dali/core/cuda_event.h"
+#include "dali/core/cuda_stream_pool.h"
 #include "dali/operators/sequence/optical_flow/optical_flow_adapter/optical_flow_stub.h"
 #include "dali/operators/sequence/optical_flow/optical_flow_impl/optical_flow_impl.h"
 #include "dali/pipeline/data/backend.h"
@@ -91,38 +94,26 @@ class OpticalFlow : public StatelessOperator<Backend> {
       ExtractParams(input);
     }
 
-    cudaStream_t of_stream = ws.stream();
-    #if NVML_ENABLED
-      {
-        static float driver_version = nvml::GetDriverVersion();
-        if (driver_version > 460 && driver_version < 470.21)
-          of_stream = 0;
-      }
-    #else
-      {
-        int driver_cuda_version = 0;
-        CUDA_CALL(cuDriverGetVersion(&driver_cuda_version));
-        if (driver_cuda_version >= 11030 && driver_cuda_version < 11040)
-          of_stream = 0;
-      }
-    #endif
-
     auto input_sh = input.shape();
 
-    // sort all sequences by size, to make sure that samples are processed grouped by shape to avoid
-    // NV OF reconfiguration as  much as possible
-    processing_order_.resize(nsequences_);
-    for (int sequence_idx = 0; sequence_idx < nsequences_; sequence_idx++) {
-      processing_order_[sequence_idx] = {{input_sh[sequence_idx][2], input_sh[sequence_idx][1]},
-                                          sequence_idx};
-    }
-    std::sort(processing_order_.begin(), processing_order_.end());
+    // group the sequences by the frame size - each size is processed by its own sessions,
+    // so that the NV OF doesn't need to be reconfigured
+    ++iteration_;
+    size_groups_.clear();
+    for (int sequence_idx = 0; sequence_idx < nsequences_; sequence_idx++)
+      size_groups_[{input_sh[sequence_idx][2], input_sh[sequence_idx][1]}].push_back(sequence_idx);
 
-    of_lazy_init(input_sh[0][2], input_sh[0][1], depth_, image_type_, device_id_, of_stream);
+    bool default_stream = RequiresDefaultStream();
+    for (auto &[size, sequences] : size_groups_) {
+      int num_sessions = std::min<int>(sequences.size(), kMaxSessionsPerSize);
+      AcquireSessions(size.first, size.second, num_sessions, default_stream);
+    }
+    EvictUnusedSessions();
 
+    auto &flow = *sessions_.begin()->second.sessions[0].flow;
     TensorListShape<> new_sizes(nsequences_, 4);
     for (int i = 0; i < nsequences_; i++) {
-      auto out_shape = optical_flow_->CalcOutputShape(input_sh[i][1], input_sh[i][2]);
+      auto out_shape = flow.CalcOutputShape(input_sh[i][1], input_sh[i][2]);
       auto shape = shape_cat(sequence_sizes_[i] - 1, out_shape);
       new_sizes.set_tensor_shape(i, shape);
     }
@@ -135,15 +126,76 @@ class OpticalFlow : public StatelessOperator<Backend> {
 
  private:
   /**
-   * Optical flow lazy initialization
+   * This is a workaround for an issue with nvcuvid in drivers >460 and < 470.21 where concurrent
+   * use on default context and non-default streams may lead to memory corruption.
    */
-  void of_lazy_init(size_t width, size_t height, size_t channels, DALIImageType image_type,
-                    int device_id, cudaStream_t stream) {
-    if (!optical_flow_) {
+  static bool RequiresDefaultStream() {
+#if NVML_ENABLED
+    static float driver_version = nvml::GetDriverVersion();
+    return driver_version > 460 && driver_version < 470.21;
+#else
+    int driver_cuda_version = 0;
+    CUDA_CALL(cuDriverGetVersion(&driver_cuda_version));
+    return driver_cuda_version >= 11030 && driver_cuda_version < 11040;
+#endif
+  }
+
+  /**
+   * An NV OF instance configured for one frame size. Each session has its own stream,
+   * so that the sessions can run concurrently on the available NV OF engines.
+   */
+  struct Session {
+    std::unique_ptr<optical_flow::OpticalFlowAdapter<ComputeBackend>> flow;
+    CUDAStreamLease stream;  // not leased when running on the default stream
+    CUDAEvent done;
+  };
+
+  struct SessionGroup {
+    std::vector<Session> sessions;
+    int64_t last_used = 0;
+  };
+
+  /**
+   * Makes sure there are at least `count` sessions for the given frame size
+   */
+  void AcquireSessions(int width, int height, int count, bool default_stream) {
+    auto &group = sessions_[{width, height}];
+    group.last_used = iteration_;
+    while (static_cast<int>(group.sessions.size()) < count) {
+      Session session;
+      if (!default_stream)
+        session.stream = CUDAStreamPool::instance().Get(device_id_);
       auto flow = std::make_unique<optical_flow::OpticalFlowImpl>(
-        of_params_, width, height, channels, image_type, device_id, stream);
+        of_params_, width, height, depth_, image_type_, device_id_, session.stream.get());
       flow->Init(of_params_);
-      optical_flow_ = std::move(flow);
+      session.flow = std::move(flow);
+      session.done = CUDAEvent::Create(device_id_);
+      group.sessions.push_back(std::move(session));
+    }
+  }
+
+  /**
+   * Destroys the least recently used sessions (not needed in the current iteration) until
+   * the total number of the sessions fits in the limit
+   */
+  void EvictUnusedSessions() {
+    int total = 0;
+    for (auto &entry : sessions_)
+      total += entry.second.sessions.size();
+    while (total > kMaxSessions) {
+      auto lru = sessions_.end();
+      for (auto it = sessions_.begin(); it != sessions_.end(); ++it) {
+        if (it->second.last_used < iteration_ &&
+            (lru == sessions_.end() || it->second.last_used < lru->second.last_used))
+          lru = it;
+      }
+      if (lru == sessions_.end())
+        break;
+      // the sessions may still be in use by the previous iteration
+      for (auto &session : lru->second.sessions)
+        CUDA_CALL(cudaStreamSynchronize(session.stream.get()));
+      total -= lru->second.sessions.size();
+      sessions_.erase(lru);
     }
   }
 
@@ -192,13 +244,8 @@ class OpticalFlow : public StatelessOperator<Backend> {
                  "Width, height and depth must be equal for all hints");
   }
 
-  struct DimsOrder {
-    std::pair<int, int> dims;
-    int idx;
-    bool operator<(const DimsOrder &rhs) const {
-      return dims < rhs.dims;
-    }
-  };
+  static constexpr int kMaxSessionsPerSize = 2;
+  static constexpr int kMaxSessions = 8;
 
   const float quality_factor_;
   const int out_grid_size_;
@@ -206,13 +253,15 @@ class OpticalFlow : public StatelessOperator<Backend> {
   const bool enable_temporal_hints_;
   const bool enable_external_hints_;
   optical_flow::OpticalFlowParams of_params_;
-  std::unique_ptr<optical_flow::OpticalFlowAdapter<ComputeBackend>> optical_flow_;
   DALIImageType image_type_;
   int device_id_;
   int frames_width_ = -1, frames_height_ = -1, depth_ = -1, nsequences_ = -1;
   int hints_width_ = -1, hints_height_ = -1, hints_depth_ = -1;
   std::vector<int> sequence_sizes_;
-  std::vector<DimsOrder> processing_order_;
+  // the sessions and the sequences to process in the current iteration, keyed by (width, height)
+  std::map<std::pair<int, int>, SessionGroup> sessions_;
+  std::map<std::pair<int, int>, std::vector<int>> size_groups_;
+  int64_t iteration_ = 0;
   CUDAEvent sync_;
 
 #if NVML_ENABLED
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -22,10 +22,14 @@ DALI_SCHEMA(SequenceRearrange)
     .DocStr(R"code(Rearranges frames in a sequence.
 
 Assumes that the outermost dimension represents the frame index in the sequence.
-If the input has a non-empty layout description, it must start with ``F`` (frame).)code")
+If the input has a non-empty layout description, it must start with ``F`` (frame).
+
+If, in all samples, ``new_order`` is a range of consecutive elements (e.g. a temporal window
+``[3, 4, 5, 6]``), the output is a view of the input and the frames are not copied.)code")
     .NumInput(1)
     .NumOutput(1)
     .AllowSequences()
+    .SamplewisePassThrough()
     .AddArg("new_order", R"code(List that describes the new order for the elements in each sample.
 
 Output sequence at position ``i`` will contain element ``new_order[i]`` from input sequence::
@@ -59,6 +63,14 @@ TensorShape<> GetSeqRearrangedShape(const TensorShape<> &in_sample_shape,
   return result;
 }
 
+bool IsSeqRange(const TensorView<StorageCPU, const int, 1> &new_order) {
+  for (int i = 1; i < new_order.num_elements(); i++) {
+    if (new_order.data[i] != new_order.data[i - 1] + 1)
+      return false;
+  }
+  return true;
+}
+
 copy_desc GetCopyDesc(char *output_sample, const char *input_sample, int out_elem_idx,
                       int in_elem_idx, int64_t element_sizeof) {
   copy_desc result;
@@ -70,6 +82,10 @@ copy_desc GetCopyDesc(char *output_sample, const char *input_sample, int out_ele
 
 template <>
 void SequenceRearrange<CPUBackend>::RunImpl(Workspace &ws) {
+  if (share_frames_) {
+    ShareFrameRanges(ws);
+    return;
+  }
   const auto &input = ws.Input<CPUBackend>(0);
   auto &output = ws.Output<CPUBackend>(0);
   auto &thread_pool = ws.GetThreadPool();
@@ -84,15 +100,7 @@ void SequenceRearrange<CPUBackend>::RunImpl(Workspace &ws) {
       const auto &in_shape = input.tensor_shape(sample_idx);
       auto element_sizeof = volume(in_shape.last(in_shape.sample_dim() - 1)) * type.size();
 
-      TensorView<StorageCPU, const int, 1> new_order = {};
-
-      if (single_order_) {
-        new_order = TensorView<StorageCPU, const int, 1>(new_order_.data(),
-                                                         TensorShape<1>(new_order_.size()));
-      } else {
-        auto &new_orders = ws.ArgumentInput("new_order");
-        new_order = view<const int, 1>(new_orders[sample_idx]);
-      }
+      auto new_order = GetNewOrder(ws, sample_idx);
       for (int i = 0; i < new_order.shape.num_elements(); i++) {
         auto copy_desc = GetCopyDesc(out_sample, in_sample, i, new_order.data[i], element_sizeof);
         memcpy(copy_desc.to, copy_desc.from, copy_desc.size);
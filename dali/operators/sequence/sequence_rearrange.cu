@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -22,6 +22,10 @@ namespace dali {
 
 template <>
 void SequenceRearrange<GPUBackend>::RunImpl(Workspace &ws) {
+  if (share_frames_) {
+    ShareFrameRanges(ws);
+    return;
+  }
   scatter_gather_.Reset();
   const auto &input = ws.Input<GPUBackend>(0);
   auto &output = ws.Output<GPUBackend>(0);
@@ -34,15 +38,7 @@ void SequenceRearrange<GPUBackend>::RunImpl(Workspace &ws) {
     const auto &in_shape = input.shape()[sample_idx];
     auto element_sizeof = volume(in_shape.last(in_shape.sample_dim() - 1)) * type.size();
 
-    TensorView<StorageCPU, const int, 1> new_order = {};
-
-    if (single_order_) {
-      new_order = TensorView<StorageCPU, const int, 1>(new_order_.data(),
-                                                       TensorShape<1>(new_order_.size()));
-    } else {
-      auto &new_orders = ws.ArgumentInput("new_order");
-      new_order = view<const int, 1>(new_orders[sample_idx]);
-    }
+    auto new_order = GetNewOrder(ws, sample_idx);
     for (int i = 0; i < new_order.shape.num_elements(); i++) {
       auto copy_desc = GetCopyDesc(out_sample, in_sample, i, new_order.data[i], element_sizeof);
       scatter_gather_.AddCopy(copy_desc.to, copy_desc.from, copy_desc.size);
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,12 +16,14 @@
 #define DALI_OPERATORS_SEQUENCE_SEQUENCE_REARRANGE_H_
 
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "dali/core/format.h"
 #include "dali/core/tensor_layout.h"
 #include "dali/core/tensor_view.h"
 #include "dali/kernels/common/scatter_gather.h"
+#include "dali/operators/sequence/frame_views.h"
 #include "dali/pipeline/data/views.h"
 #include "dali/pipeline/operator/checkpointing/stateless_operator.h"
 #include "dali/pipeline/operator/operator.h"
@@ -38,6 +40,13 @@ void ValidateSeqRearrange(const TensorShape<>& in_sample_shape,
 TensorShape<> GetSeqRearrangedShape(const TensorShape<>& in_sample_shape,
                                     const TensorView<StorageCPU, const int, 1>& new_order);
 
+/**
+ * @brief Returns true if `new_order` is a range of consecutive elements, e.g. {3, 4, 5}.
+ *
+ * Such a rearranged sequence is a view of the input sample.
+ */
+bool IsSeqRange(const TensorView<StorageCPU, const int, 1>& new_order);
+
 struct copy_desc {
   const void* from;
   void* to;
@@ -70,20 +79,12 @@ class SequenceRearrange : public StatelessOperator<Backend> {
     output_desc[0].type = input.type();
     output_desc[0].shape = TensorListShape<>(in_shape.num_samples(), in_shape.sample_dim());
     auto curr_batch_size = ws.GetInputBatchSize(0);
-    if (single_order_) {
-      TensorView<StorageCPU, const int, 1> new_order(new_order_.data(),
-                                                     TensorShape<1>(new_order_.size()));
-      for (int i = 0; i < curr_batch_size; i++) {
-        ValidateSeqRearrange(in_shape[i], new_order, i);
-        output_desc[0].shape.set_tensor_shape(i, GetSeqRearrangedShape(in_shape[i], new_order));
-      }
-    } else {
-      const auto& new_orders = ws.ArgumentInput("new_order");
-      for (int i = 0; i < curr_batch_size; i++) {
-        auto new_order = view<const int, 1>(new_orders[i]);
-        ValidateSeqRearrange(in_shape[i], new_order, i);
-        output_desc[0].shape.set_tensor_shape(i, GetSeqRearrangedShape(in_shape[i], new_order));
-      }
+    share_frames_ = true;
+    for (int i = 0; i < curr_batch_size; i++) {
+      auto new_order = GetNewOrder(ws, i);
+      ValidateSeqRearrange(in_shape[i], new_order, i);
+      output_desc[0].shape.set_tensor_shape(i, GetSeqRearrangedShape(in_shape[i], new_order));
+      share_frames_ = share_frames_ && IsSeqRange(new_order);
     }
 
     auto layout = input.GetLayout();
@@ -92,15 +93,38 @@ class SequenceRearrange : public StatelessOperator<Backend> {
                              "frames dimension `F`, got data with layout = \"",
                              layout, "\"."));
 
+    if (share_frames_) {
+      // The output sequences are views of the input - the executor doesn't allocate them
+      output_shape_ = std::move(output_desc[0].shape);
+      return false;
+    }
     return true;
   }
 
+  TensorView<StorageCPU, const int, 1> GetNewOrder(const Workspace &ws, int sample_idx) const {
+    if (single_order_)
+      return TensorView<StorageCPU, const int, 1>(new_order_.data(),
+                                                  TensorShape<1>(new_order_.size()));
+    return view<const int, 1>(ws.ArgumentInput("new_order")[sample_idx]);
+  }
+
+  void ShareFrameRanges(Workspace &ws) {
+    const auto& input = ws.Input<Backend>(0);
+    auto& output = ws.Output<Backend>(0);
+    int num_samples = output_shape_.num_samples();
+    SetupFrameViews(output, input, num_samples, output_shape_.sample_dim(), input.GetLayout());
+    for (int i = 0; i < num_samples; i++)
+      ShareFrames(output, i, input, i, GetNewOrder(ws, i).data[0], output_shape_[i]);
+  }
+
   void RunImpl(Workspace &ws) override;
 
  private:
   USE_OPERATOR_MEMBERS();
   bool single_order_ = false;
+  bool share_frames_ = false;
   std::vector<int> new_order_;
+  TensorListShape<> output_shape_;
   kernels::ScatterGatherGPU scatter_gather_;
   static constexpr size_t kMaxSizePerBlock = 1 << 18;  // 256 kB per block
 };
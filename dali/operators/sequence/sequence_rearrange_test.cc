@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -77,6 +77,7 @@ struct SequenceRearrangeInvalidTest : public SequenceRearrangeBaseTest {
 std::vector<testing::Arguments> reorders = {
     {{"new_order", std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}}},
     {{"new_order", std::vector<int>{0, 1, 2, 3, 4, 5, 6}}},
+    {{"new_order", std::vector<int>{2, 3, 4, 5}}},
     {{"new_order", std::vector<int>{0, 7}}},
     {{"new_order", std::vector<int>{3}}},
     {{"new_order", std::vector<int>{2, 0, 1}}},
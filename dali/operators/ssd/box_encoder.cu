@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -14,8 +14,10 @@
 
 #include "dali/operators/ssd/box_encoder.cuh"
 #include <cuda.h>
+#include <algorithm>
 #include <vector>
 #include <utility>
+#include "dali/core/util.h"
 
 namespace dali {
 __host__ __device__ inline float4 ToCenterWidthHeight(const float4 &box) {
@@ -65,20 +67,31 @@ __device__ __forceinline__ float CalculateIou(const float4 &b1, const float4 &b2
   return intersection / (area1 + area2 - intersection);
 }
 
-__device__ inline void FindBestMatch(const int N, volatile float *vals, volatile int *idx) {
-  for (unsigned int stride = blockDim.x / 2; stride > 0; stride >>= 1) {
-    if (threadIdx.x < stride) {
-      if (vals[threadIdx.x] <= vals[threadIdx.x + stride]) {
-        if (vals[threadIdx.x] == vals[threadIdx.x + stride]) {
-          idx[threadIdx.x] = cuda_max(idx[threadIdx.x], idx[threadIdx.x + stride]);
-        } else {
-          vals[threadIdx.x] = vals[threadIdx.x + stride];
-          idx[threadIdx.x] = idx[threadIdx.x + stride];
-        }
-      }
-    }
-    __syncthreads();
-  }
+/**
+ * @brief Packs an IoU and an index so that comparing the packed values compares the IoUs first
+ *        and, for equal IoUs, prefers the higher index.
+ *
+ * The float bits are mapped to a totally ordered unsigned integer, so that the maximum can be
+ * found with a 64-bit atomicMax.
+ */
+__device__ __forceinline__ uint64_t PackMatch(float iou, int idx) {
+  uint32_t bits = __float_as_uint(iou);
+  bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+  return (static_cast<uint64_t>(bits) << 32) | static_cast<uint32_t>(idx);
+}
+
+__device__ __forceinline__ float UnpackIou(uint64_t match) {
+  uint32_t bits = match >> 32;
+  bits = (bits & 0x80000000u) ? (bits & 0x7fffffffu) : ~bits;
+  return __uint_as_float(bits);
+}
+
+__device__ __forceinline__ int UnpackIdx(uint64_t match) {
+  return static_cast<int>(static_cast<uint32_t>(match));
+}
+
+__device__ __forceinline__ void AtomicMaxMatch(uint64_t *match, uint64_t value) {
+  atomicMax(reinterpret_cast<unsigned long long *>(match), value);  // NOLINT
 }
 
 // Scale argument is used to maintain numerical consistency with reference implementation:
@@ -96,153 +109,120 @@ __device__ float4 MatchOffsets(
   return {x, y, z, w};
 }
 
-__device__ void WriteMatchesToOutput(
-  unsigned int anchor_count, float criteria, int *labels_out, const int *labels_in,
-  float4 *boxes_out, const float4 *boxes_in,
-  volatile int *best_box_idx, volatile float *best_box_iou, bool offset,
-  const float* means, const float* stds, float scale, const float4 *anchors_as_cwh) {
-  for (unsigned int anchor = threadIdx.x; anchor < anchor_count; anchor += blockDim.x) {
-    if (best_box_iou[anchor] > criteria) {
-      int box_idx = best_box_idx[anchor];
-      labels_out[anchor] = labels_in[box_idx];
-      float4 box = boxes_in[box_idx];
-
-      if (!offset)
-        boxes_out[anchor] = ToCenterWidthHeight(box);
-      else
-        boxes_out[anchor] = MatchOffsets(
-          ToCenterWidthHeight(box), anchors_as_cwh[anchor], means, stds, scale);
-    }
-  }
-}
-
-__device__ void MatchBoxWithAnchors(
-  const float4 &box, const int box_idx, unsigned int anchor_count, const float4 *anchors,
-  volatile int *best_anchor_idx_tmp, volatile float *best_anchor_iou_tmp,
-  volatile int *best_box_idx, volatile float *best_box_iou) {
-  float best_anchor_iou = -1.0f;
-  int best_anchor_idx = -1;
-
-  for (unsigned int anchor = threadIdx.x; anchor < anchor_count; anchor += blockDim.x) {
-    float new_val = CalculateIou(box, anchors[anchor]);
-
-    if (new_val >= best_anchor_iou) {
-        best_anchor_iou = new_val;
-        best_anchor_idx = anchor;
-    }
-
-    if (new_val >= best_box_iou[anchor]) {
-        best_box_iou[anchor] = new_val;
-        best_box_idx[anchor] = box_idx;
-    }
+/**
+ * @brief Calculates the IoU of the boxes with a tile of anchors
+ *
+ * Each thread evaluates kAnchorsPerThread anchors; the boxes are processed in chunks, which are
+ * loaded to shared memory and shared by all the anchors in the tile.
+ * For each anchor, the best box is stored in `anchor_matches` (the box with the highest index
+ * wins a tie). For each box, the best anchor in the tile is merged into `box_matches` with
+ * an atomic operation (the anchor with the highest index wins a tie).
+ *
+ * `gridDim.x` is the number of anchor tiles, `gridDim.y` - the number of samples.
+ */
+template <int kBlockSize, int kAnchorsPerThread>
+__global__ void MatchAnchorsKernel(const BoxEncoderSampleDesc *samples, int anchor_count,
+                                   const float4 *anchors) {
+  const auto &sample = samples[blockIdx.y];
+  __shared__ float4 boxes[kBlockSize];
+  __shared__ uint64_t box_matches[kBlockSize];
+
+  int tile_start = blockIdx.x * kBlockSize * kAnchorsPerThread;
+  float4 anchor[kAnchorsPerThread];
+  uint64_t best_box[kAnchorsPerThread];
+  #pragma unroll
+  for (int k = 0; k < kAnchorsPerThread; k++) {
+    int a = tile_start + k * kBlockSize + threadIdx.x;
+    if (a < anchor_count)
+      anchor[k] = anchors[a];
+    best_box[k] = PackMatch(0.0f, 0);
   }
 
-  best_anchor_iou_tmp[threadIdx.x] = best_anchor_iou;
-  best_anchor_idx_tmp[threadIdx.x] = best_anchor_idx;
-}
-
-template <int BLOCK_SIZE>
-__global__ void Encode(const BoxEncoderSampleDesc *samples, const int anchor_count,
-                       const float4 *anchors, const float criteria, int *box_idx_buffer,
-                       float *box_iou_buffer, bool offset, const float *means, const float *stds,
-                       float scale, const float4 *anchors_as_cwh) {
-  const int sample_idx = blockIdx.x;
-  const auto &sample = samples[sample_idx];
-
-  // Remark: This algorithm is very fragile to floating point arithmetic effects.
-  // For now, excessive use of volatile in this code,
-  // makes it conform to reference solution in terms of resulting encoding.
-
-  __shared__ volatile int best_anchor_idx_tmp[BLOCK_SIZE];
-  __shared__ volatile float best_anchor_iou_tmp[BLOCK_SIZE];
-
-  volatile int *best_box_idx = box_idx_buffer + sample_idx * anchor_count;
-  volatile float *best_box_iou = box_iou_buffer + sample_idx * anchor_count;
-
-  for (int box_idx = 0; box_idx < sample.in_box_count; ++box_idx) {
-    MatchBoxWithAnchors(
-      sample.boxes_in[box_idx],
-      box_idx,
-      anchor_count,
-      anchors,
-      best_anchor_idx_tmp,
-      best_anchor_iou_tmp,
-      best_box_idx,
-      best_box_iou);
-
+  const int lane = threadIdx.x % 32;
+  for (int chunk_start = 0; chunk_start < sample.in_box_count; chunk_start += kBlockSize) {
+    int chunk_size = cuda_min(kBlockSize, sample.in_box_count - chunk_start);
     __syncthreads();
-
-    FindBestMatch(blockDim.x, best_anchor_iou_tmp, best_anchor_idx_tmp);
+    if (threadIdx.x < chunk_size) {
+      boxes[threadIdx.x] = sample.boxes_in[chunk_start + threadIdx.x];
+      box_matches[threadIdx.x] = 0;
+    }
     __syncthreads();
 
-    if (threadIdx.x == 0) {
-      int idx = best_anchor_idx_tmp[0];
-      best_box_idx[idx] = box_idx;
-      best_box_iou[idx] = 2.f;
+    for (int i = 0; i < chunk_size; i++) {
+      float4 box = boxes[i];
+      int box_idx = chunk_start + i;
+      uint64_t best_anchor = 0;
+      #pragma unroll
+      for (int k = 0; k < kAnchorsPerThread; k++) {
+        int a = tile_start + k * kBlockSize + threadIdx.x;
+        if (a < anchor_count) {
+          float iou = CalculateIou(box, anchor[k]);
+          if (iou >= 0.0f) {  // excludes NaNs
+            best_box[k] = cuda_max(best_box[k], PackMatch(iou, box_idx));
+            best_anchor = cuda_max(best_anchor, PackMatch(iou, a));
+          }
+        }
+      }
+      for (int ofs = 16; ofs > 0; ofs >>= 1)
+        best_anchor = cuda_max(best_anchor, __shfl_xor_sync(0xffffffffu, best_anchor, ofs));
+      if (lane == 0 && best_anchor)
+        AtomicMaxMatch(&box_matches[i], best_anchor);
     }
     __syncthreads();
+    if (threadIdx.x < chunk_size && box_matches[threadIdx.x])
+      AtomicMaxMatch(&sample.box_matches[chunk_start + threadIdx.x], box_matches[threadIdx.x]);
   }
-  __syncthreads();
-
-  WriteMatchesToOutput(
-    anchor_count,
-    criteria,
-    sample.labels_out,
-    sample.labels_in,
-    sample.boxes_out,
-    sample.boxes_in,
-    best_box_idx,
-    best_box_iou,
-    offset,
-    means,
-    stds,
-    scale,
-    anchors_as_cwh);
-}
-
-std::pair<int *, float *> BoxEncoder<GPUBackend>::ClearBuffers(const cudaStream_t &stream) {
-  auto best_box_idx_data = best_box_idx_.mutable_data<int>();
-  auto best_box_iou_data = best_box_iou_.mutable_data<float>();
-
-  CUDA_CALL(cudaMemsetAsync(
-    best_box_idx_data, 0, curr_batch_size_ * anchor_count_ * sizeof(int), stream));
-  CUDA_CALL(cudaMemsetAsync(
-    best_box_iou_data, 0, curr_batch_size_ * anchor_count_ * sizeof(float), stream));
 
-  return {best_box_idx_data, best_box_iou_data};
-}
-
-void BoxEncoder<GPUBackend>::ClearLabels(TensorList<GPUBackend> &labels_out,
-                                         const cudaStream_t &stream) {
-  for (int sample = 0; sample < curr_batch_size_; ++sample) {
-    CUDA_CALL(cudaMemsetAsync(labels_out.mutable_tensor<int>(sample), 0,
-                              anchor_count_ * sizeof(int), stream));
+  #pragma unroll
+  for (int k = 0; k < kAnchorsPerThread; k++) {
+    int a = tile_start + k * kBlockSize + threadIdx.x;
+    if (a < anchor_count)
+      sample.anchor_matches[a] = best_box[k];
   }
 }
 
-void BoxEncoder<GPUBackend>::WriteAnchorsToOutput(TensorList<GPUBackend> &boxes_out,
-                                                  const cudaStream_t &stream) {
-  if (!curr_batch_size_)
-    return;
-  const auto *anchors_to_copy = anchors_as_center_wh_.data<float>();
-  auto *first_sample_boxes_out = boxes_out.mutable_tensor<float>(0);
-  // Host -> device copy of anchors for first sample
-  MemCopy(first_sample_boxes_out, anchors_to_copy,
-          anchor_count_ * BoundingBox::size * sizeof(float), stream);
-  // Device -> device copy for the rest
-  for (int sample = 1; sample < curr_batch_size_; ++sample) {
-    auto *boxes_out_data = boxes_out.mutable_tensor<float>(sample);
-    MemCopy(boxes_out_data, first_sample_boxes_out,
-            anchor_count_ * BoundingBox::size * sizeof(float), stream);
+/**
+ * @brief Assigns each box to its best anchor, regardless of the IoU
+ *
+ * The IoU of such a match is set to 2, so that it takes precedence over any regular match.
+ * If several boxes share the best anchor, the one with the highest index is assigned.
+ */
+__global__ void ForceMatchesKernel(const BoxEncoderSampleDesc *samples) {
+  const auto &sample = samples[blockIdx.y];
+  for (int box_idx = blockIdx.x * blockDim.x + threadIdx.x; box_idx < sample.in_box_count;
+       box_idx += blockDim.x * gridDim.x) {
+    uint64_t match = sample.box_matches[box_idx];
+    if (match)
+      AtomicMaxMatch(&sample.anchor_matches[UnpackIdx(match)], PackMatch(2.0f, box_idx));
   }
 }
 
-void BoxEncoder<GPUBackend>::ClearOutput(TensorList<GPUBackend> &boxes_out,
-                                         const cudaStream_t &stream) {
-  for (int sample = 0; sample < curr_batch_size_; ++sample) {
-    auto *boxes_out_data = boxes_out.mutable_tensor<float>(sample);
-    CUDA_CALL(cudaMemsetAsync(boxes_out_data, 0, anchor_count_ * BoundingBox::size * sizeof(float),
-                              stream));
+/**
+ * @brief Writes the encoded boxes and labels for all anchors
+ *
+ * Anchors without a match get label 0 and either the (center-width-height) anchor itself or,
+ * when encoding offsets, zeros.
+ */
+__global__ void WriteOutputKernel(const BoxEncoderSampleDesc *samples, int anchor_count,
+                                  float criteria, bool offset, const float *means,
+                                  const float *stds, float scale, const float4 *anchors_as_cwh) {
+  const auto &sample = samples[blockIdx.y];
+  for (int anchor = blockIdx.x * blockDim.x + threadIdx.x; anchor < anchor_count;
+       anchor += blockDim.x * gridDim.x) {
+    uint64_t match = sample.anchor_matches[anchor];
+    if (sample.in_box_count > 0 && UnpackIou(match) > criteria) {
+      int box_idx = UnpackIdx(match);
+      sample.labels_out[anchor] = sample.labels_in[box_idx];
+      float4 box = sample.boxes_in[box_idx];
+      if (!offset)
+        sample.boxes_out[anchor] = ToCenterWidthHeight(box);
+      else
+        sample.boxes_out[anchor] = MatchOffsets(
+          ToCenterWidthHeight(box), anchors_as_cwh[anchor], means, stds, scale);
+    } else {
+      sample.labels_out[anchor] = 0;
+      sample.boxes_out[anchor] = offset ? float4{0, 0, 0, 0} : anchors_as_cwh[anchor];
+    }
   }
 }
 
@@ -271,8 +251,6 @@ void BoxEncoder<GPUBackend>::RunImpl(Workspace &ws) {
   const auto anchors_as_cwh_data =
     reinterpret_cast<const float4 *>(anchors_as_center_wh_.data<float>());
 
-  const auto buffers = ClearBuffers(ws.stream());
-
   auto dims = CalculateDims(boxes_input);
 
   auto &boxes_output = ws.Output<GPUBackend>(kBoxesOutId);
@@ -281,6 +259,10 @@ void BoxEncoder<GPUBackend>::RunImpl(Workspace &ws) {
   auto &labels_output = ws.Output<GPUBackend>(kLabelsOutId);
   labels_output.Resize(dims.second, labels_input.type());
 
+  auto *anchor_matches = best_anchor_match_.mutable_data<uint64_t>();
+  auto *box_matches = best_box_match_.mutable_data<uint64_t>();
+  int64_t total_box_count = 0;
+  int max_box_count = 0;
   samples.resize(curr_batch_size_);
   for (int sample_idx = 0; sample_idx < curr_batch_size_; sample_idx++) {
     auto &sample = samples[sample_idx];
@@ -289,32 +271,46 @@ void BoxEncoder<GPUBackend>::RunImpl(Workspace &ws) {
     sample.boxes_in = reinterpret_cast<const float4 *>(boxes_input.tensor<float>(sample_idx));
     sample.labels_in = labels_input.tensor<int>(sample_idx);
     sample.in_box_count = boxes_input.shape().tensor_shape_span(sample_idx)[0];
+    sample.anchor_matches = anchor_matches + sample_idx * anchor_count_;
+    sample.box_matches = box_matches + total_box_count;
+    total_box_count += sample.in_box_count;
+    max_box_count = std::max(max_box_count, sample.in_box_count);
   }
+  if (curr_batch_size == 0 || anchor_count_ == 0)
+    return;
 
   const auto means_data = means_.data<float>();
   const auto stds_data = stds_.data<float>();
 
-  ClearLabels(labels_output, ws.stream());
+  samples_dev.from_host(samples, ws.stream());
 
-  if (!offset_)
-    WriteAnchorsToOutput(boxes_output, ws.stream());
-  else
-    ClearOutput(boxes_output, ws.stream());
+  if (total_box_count > 0)
+    CUDA_CALL(cudaMemsetAsync(box_matches, 0, total_box_count * sizeof(uint64_t), ws.stream()));
 
-  samples_dev.from_host(samples, ws.stream());
+  dim3 grid(div_ceil(anchor_count_, kAnchorsPerBlock), curr_batch_size);
+  MatchAnchorsKernel<BlockSize, kAnchorsPerThread><<<grid, BlockSize, 0, ws.stream()>>>(
+    samples_dev.data(),
+    anchor_count_,
+    anchors_data);
+  CUDA_CALL(cudaGetLastError());
+
+  if (max_box_count > 0) {
+    dim3 force_grid(div_ceil(max_box_count, BlockSize), curr_batch_size);
+    ForceMatchesKernel<<<force_grid, BlockSize, 0, ws.stream()>>>(samples_dev.data());
+    CUDA_CALL(cudaGetLastError());
+  }
 
-  Encode<BlockSize><<<curr_batch_size, BlockSize, 0, ws.stream()>>>(
+  dim3 write_grid(div_ceil(anchor_count_, BlockSize), curr_batch_size);
+  WriteOutputKernel<<<write_grid, BlockSize, 0, ws.stream()>>>(
     samples_dev.data(),
     anchor_count_,
-    anchors_data,
     criteria_,
-    buffers.first,
-    buffers.second,
     offset_,
     means_data,
     stds_data,
     scale_,
     anchors_as_cwh_data);
+  CUDA_CALL(cudaGetLastError());
 }
 
 DALI_REGISTER_OPERATOR(BoxEncoder, BoxEncoder<GPUBackend>, GPU);
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,6 +15,8 @@
 #ifndef DALI_OPERATORS_SSD_BOX_ENCODER_CUH_
 #define DALI_OPERATORS_SSD_BOX_ENCODER_CUH_
 
+#include <algorithm>
+#include <cstdint>
 #include <utility>
 #include <vector>
 
@@ -32,12 +34,18 @@ struct BoxEncoderSampleDesc {
   const float4 *boxes_in;
   const int *labels_in;
   int in_box_count;
+  /// The best box for each anchor, packed as (IoU, box index) - see PackMatch
+  uint64_t *anchor_matches;
+  /// The best anchor for each box, packed as (IoU, anchor index) - see PackMatch
+  uint64_t *box_matches;
 };
 
 template <>
 class BoxEncoder<GPUBackend> : public StatelessOperator<GPUBackend> {
  public:
   static constexpr int BlockSize = 256;
+  static constexpr int kAnchorsPerThread = 4;
+  static constexpr int kAnchorsPerBlock = BlockSize * kAnchorsPerThread;
   using BoundingBox = Box<2, float>;
 
   explicit BoxEncoder(const OpSpec &spec)
@@ -80,8 +88,10 @@ class BoxEncoder<GPUBackend> : public StatelessOperator<GPUBackend> {
   bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override {
     curr_batch_size_ = ws.GetInputBatchSize(0);
 
-    best_box_idx_.Resize({curr_batch_size_ * anchor_count_}, DALI_INT32);
-    best_box_iou_.Resize({curr_batch_size_ * anchor_count_}, DALI_FLOAT);
+    const auto &boxes_shape = ws.GetInputShape(kBoxesInId);
+    best_anchor_match_.Resize({curr_batch_size_ * anchor_count_}, DALI_UINT64);
+    best_box_match_.Resize({std::max<int64_t>(boxes_shape.num_elements() / BoundingBox::size, 1)},
+                           DALI_UINT64);
     return false;
   }
 
@@ -95,8 +105,8 @@ class BoxEncoder<GPUBackend> : public StatelessOperator<GPUBackend> {
   int64_t anchor_count_;
   Tensor<GPUBackend> anchors_;
   Tensor<GPUBackend> anchors_as_center_wh_;
-  Tensor<GPUBackend> best_box_idx_;
-  Tensor<GPUBackend> best_box_iou_;
+  Tensor<GPUBackend> best_anchor_match_;
+  Tensor<GPUBackend> best_box_match_;
 
   std::vector<BoxEncoderSampleDesc> samples;
   DeviceBuffer<BoxEncoderSampleDesc> samples_dev;
@@ -106,16 +116,8 @@ class BoxEncoder<GPUBackend> : public StatelessOperator<GPUBackend> {
   Tensor<GPUBackend> stds_;
   float scale_;
 
-  std::pair<int*, float*> ClearBuffers(const cudaStream_t &stream);
-
   void PrepareAnchors(const vector<float> &anchors);
 
-  void ClearLabels(TensorList<GPUBackend> &labels_out, const cudaStream_t &stream);
-
-  void WriteAnchorsToOutput(TensorList<GPUBackend> &boxes_out, const cudaStream_t &stream);
-
-  void ClearOutput(TensorList<GPUBackend> &boxes_out, const cudaStream_t &stream);
-
   std::pair<TensorListShape<>, TensorListShape<>> CalculateDims(
     const TensorList<GPUBackend> &boxes_input);
 
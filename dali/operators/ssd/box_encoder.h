@@ -69,6 +69,10 @@ class BoxEncoder<CPUBackend>: public StatelessOperator<CPUBackend> {
 
   DISABLE_COPY_MOVE_ASSIGN(BoxEncoder);
 
+  bool CanRunPerSample() const override {
+    return true;
+  }
+
  protected:
   bool HasContiguousOutputs() const override {
     return false;
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -19,6 +19,7 @@
 #include <math.h>
 #include <cassert>
 #include <memory>
+#include <type_traits>
 #include "dali/core/host_dev.h"
 #include "dali/core/device_guard.h"
 #include "dali/core/mm/memory.h"
@@ -58,6 +59,18 @@ struct curand_states {
     return states;
   }
 
+  /** Copies the states to an existing buffer of the same length */
+  DALI_HOST inline void copy_to(curand_states &dst, AccessOrder order) const {
+    assert(dst.len_ == len_);
+    CUDA_CALL(cudaMemcpyAsync(dst.states_, states_, sizeof(curandState) * len_,
+                              cudaMemcpyDeviceToDevice, order.stream()));
+  }
+
+  /** Whether no other copy of this object shares the states */
+  DALI_HOST inline bool unique() const {
+    return states_mem_.use_count() == 1;
+  }
+
   DALI_HOST inline void set(const curand_states &other) {
     CUDA_CALL(cudaMemcpyAsync(states_, other.states_, sizeof(curandState) * len_,
                               cudaMemcpyDeviceToDevice, cudaStreamDefault));
@@ -70,6 +83,9 @@ struct curand_states {
   curandState* states_;  // std::shared_ptr::get can't be called from __device__ functions
 };
 
+// The distributions below accept any curand generator state, in particular `curandState`
+// and `curandStatePhilox4_32_10_t`.
+
 template <typename T>
 struct curand_normal_dist;
 
@@ -77,7 +93,8 @@ template <>
 struct curand_normal_dist<float> {
   float mean = 0.0f, stddev = 1.0f;
 
-  __device__ inline float operator()(curandState *state) const {
+  template <typename State>
+  __device__ inline float operator()(State *state) const {
     return mean + curand_normal(state) * stddev;
   }
 };
@@ -86,7 +103,8 @@ template <>
 struct curand_normal_dist<double> {
   double mean = 0.0f, stddev = 1.0f;
 
-  __device__ inline double operator()(curandState *state) const {
+  template <typename State>
+  __device__ inline double operator()(State *state) const {
     return mean + curand_normal_double(state) * stddev;
   }
 };
@@ -103,7 +121,8 @@ struct curand_uniform_dist {
     assert(end > start);
   }
 
-  __device__ inline T operator()(curandState *state) const {
+  template <typename State>
+  __device__ inline T operator()(State *state) const {
     T val;
     if (std::is_same<T, double>::value) {
       do {
@@ -127,7 +146,8 @@ struct curand_uniform_int_range_dist {
     assert(end > start);
   }
 
-  __device__ inline int operator()(curandState *state) const {
+  template <typename State>
+  __device__ inline int operator()(State *state) const {
     return range_start_ + (curand(state) % range_size_);
   }
 
@@ -147,7 +167,8 @@ struct curand_uniform_int_values_dist {
   DALI_HOST_DEV curand_uniform_int_values_dist(const T *values, int64_t nvalues)
     : values_(values), nvalues_(nvalues) {}
 
-  __device__ inline double operator()(curandState *state) const {
+  template <typename State>
+  __device__ inline double operator()(State *state) const {
     return values_[curand(state) % nvalues_];
   }
 
@@ -161,7 +182,8 @@ struct curand_bernoulli_dist {
   explicit DALI_HOST_DEV curand_bernoulli_dist(float probability = 0.5f)
     : probability_(probability) {}
 
-  __device__ inline bool operator()(curandState *state) const {
+  template <typename State>
+  __device__ inline bool operator()(State *state) const {
     return curand_uniform(state) <= probability_;
   }
 
@@ -169,12 +191,84 @@ struct curand_bernoulli_dist {
   float probability_ = 0.5f;
 };
 
+/**
+ * @brief Exponential distribution with the rate of 1
+ */
+template <typename T>
+struct curand_exponential_dist {
+  template <typename State>
+  __device__ inline T operator()(State *state) const {
+    if constexpr (std::is_same_v<T, double>)
+      return -log(curand_uniform_double(state));  // the uniform value is in (0, 1]
+    else
+      return -logf(curand_uniform(state));
+  }
+};
+
+/**
+ * @brief Gamma distribution with the shape `alpha` and the scale of 1
+ *
+ * Uses the method of Marsaglia and Tsang, which requires `alpha >= 1`; smaller shapes
+ * are handled with Gamma(alpha) = Gamma(alpha + 1) * U^(1 / alpha), for U ~ Uniform(0, 1).
+ */
+template <typename T>
+struct curand_gamma_dist {
+  static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "Unexpected data type");
+
+  DALI_HOST_DEV explicit curand_gamma_dist(T alpha = 1)
+      : alpha_(alpha), boost_(alpha < 1), d_((alpha < 1 ? alpha + 1 : alpha) - T(1) / 3),
+        c_(1 / sqrt(9 * static_cast<double>(d_))) {}
+
+  template <typename State>
+  __device__ inline T operator()(State *state) const {
+    T x, v;
+    for (;;) {
+      do {
+        x = normal(state);
+        v = 1 + c_ * x;
+      } while (v <= 0);
+      v = v * v * v;
+      T u = uniform(state);
+      if (u < 1 - T(0.0331) * (x * x) * (x * x))
+        break;
+      if (log(u) < T(0.5) * x * x + d_ * (1 - v + log(v)))
+        break;
+    }
+    T g = d_ * v;
+    if (boost_)
+      g *= pow(uniform(state), 1 / alpha_);
+    return g;
+  }
+
+ private:
+  template <typename State>
+  __device__ inline T normal(State *state) const {
+    if constexpr (std::is_same_v<T, double>)
+      return curand_normal_double(state);
+    else
+      return curand_normal(state);
+  }
+
+  template <typename State>
+  __device__ inline T uniform(State *state) const {
+    if constexpr (std::is_same_v<T, double>)
+      return curand_uniform_double(state);
+    else
+      return curand_uniform(state);
+  }
+
+  T alpha_;
+  bool boost_;
+  T d_, c_;
+};
+
 struct curand_poisson_dist {
  public:
   explicit DALI_HOST_DEV curand_poisson_dist(float lambda)
     : lambda_(lambda) {}
 
-  __device__ inline unsigned int operator()(curandState *state) const {
+  template <typename State>
+  __device__ inline unsigned int operator()(State *state) const {
     return curand_poisson(state, lambda_);
   }
 
@@ -12,17 +12,131 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
+#include <vector>
 #include "dali/pipeline/data/buffer.h"
 #include "dali/pipeline/data/backend.h"
+#include "dali/core/cuda_event_pool.h"
+#include "dali/core/dynlink_cuda.h"
+#include "dali/core/mm/cu_vm.h"
 #include "dali/core/mm/memory.h"
 
 namespace dali {
 
+namespace {
+
+#if DALI_USE_CUDA_VM_MAP
+
+/**
+ * @brief Device memory mapped, on demand, to a reserved virtual address range.
+ *
+ * The address range is reserved for the maximum size up front and the physical memory is mapped
+ * to its beginning as the allocation grows - the address and the contents don't change.
+ */
+class GrowableAllocation {
+ public:
+  GrowableAllocation(size_t max_bytes, int device_id) : device_id_(device_id) {
+    DeviceGuard dg(device_id);
+    va_ = mm::cuvm::CUMemAddressRange::Reserve(max_bytes);
+  }
+
+  ~GrowableAllocation() {
+    DeviceGuard dg(device_id_);
+    CUdeviceptr ptr = va_.ptr();
+    for (auto &chunk : chunks_) {
+      mm::cuvm::Unmap(ptr, chunk.size());
+      ptr += chunk.size();
+    }
+  }
+
+  uint8_t *data() const {
+    return reinterpret_cast<uint8_t *>(va_.ptr());
+  }
+
+  /** The size of the mapped memory */
+  size_t capacity() const {
+    return mapped_;
+  }
+
+  /**
+   * @brief Maps physical memory so that at least `bytes` are usable.
+   *
+   * @return false, if `bytes` exceeds the reserved address range
+   */
+  bool grow(size_t bytes) {
+    if (bytes <= mapped_)
+      return true;
+    if (bytes > va_.size())
+      return false;
+    DeviceGuard dg(device_id_);
+    size_t new_mapped = align_up(bytes, mm::cuvm::GetAddressGranularity());
+    auto chunk = mm::cuvm::CUMem::Create(new_mapped - mapped_, device_id_);
+    mm::cuvm::Map(va_.ptr() + mapped_, chunk);
+    mapped_ += chunk.size();
+    chunks_.push_back(std::move(chunk));
+    return true;
+  }
+
+ private:
+  mm::cuvm::CUMemAddressRange va_;
+  std::vector<mm::cuvm::CUMem> chunks_;
+  size_t mapped_ = 0;
+  int device_id_ = -1;
+};
+
+/**
+ * @brief Frees a GrowableAllocation, waiting for the work pending in `release_on_stream`.
+ *
+ * The physical memory is released immediately, not in stream order.
+ */
+struct GrowableDeleter {
+  std::shared_ptr<GrowableAllocation> allocation;
+  cudaStream_t release_on_stream;
+
+  void operator()(void *) {
+    if (release_on_stream != AccessOrder::host_sync_stream())
+      CUDA_DTOR_CALL(cudaStreamSynchronize(release_on_stream));
+    allocation.reset();
+  }
+};
+
+#endif  // DALI_USE_CUDA_VM_MAP
+
+/**
+ * @brief Hands an external buffer back to its owner, with an event recorded in
+ *        `release_on_stream`, unless it's the host order.
+ */
+struct ExternalBufferDeleter {
+  ExternalBufferReleaseFn release;
+  void *user_data;
+  int device_id;
+  cudaStream_t release_on_stream;
+
+  void operator()(void *ptr) {
+    if (release_on_stream == AccessOrder::host_sync_stream()) {
+      release(ptr, user_data, nullptr);
+      return;
+    }
+    DeviceGuard dg(device_id);
+    CUDAEvent event = CUDAEventPool::instance().Get(device_id);
+    CUDA_DTOR_CALL(cudaEventRecord(event, release_on_stream));
+    release(ptr, user_data, event);
+    CUDAEventPool::instance().Put(std::move(event), device_id);
+  }
+};
+
+}  // namespace
+
 DLL_PUBLIC AccessOrder get_deletion_order(const std::shared_ptr<void> &ptr) {
   if (auto *del = std::get_deleter<mm::AsyncDeleter>(ptr))
     return AccessOrder(del->release_on_stream);
-  else
-    return {};
+  if (auto *del = std::get_deleter<ExternalBufferDeleter>(ptr))
+    return AccessOrder(del->release_on_stream);
+#if DALI_USE_CUDA_VM_MAP
+  if (auto *del = std::get_deleter<GrowableDeleter>(ptr))
+    return AccessOrder(del->release_on_stream);
+#endif
+  return {};
 }
 
 DLL_PUBLIC bool set_deletion_order(const std::shared_ptr<void> &ptr, AccessOrder order) {
@@ -33,10 +147,57 @@ DLL_PUBLIC bool set_deletion_order(const std::shared_ptr<void> &ptr, AccessOrder
         throw std::logic_error("Race condition detected - the pointer is no longer unique.");
       return true;
     }
+    if (auto *del = std::get_deleter<ExternalBufferDeleter>(ptr)) {
+      del->release_on_stream = order.get();
+      if (ptr.use_count() != 1)
+        throw std::logic_error("Race condition detected - the pointer is no longer unique.");
+      return true;
+    }
+#if DALI_USE_CUDA_VM_MAP
+    if (auto *del = std::get_deleter<GrowableDeleter>(ptr)) {
+      del->release_on_stream = order.get();
+      if (ptr.use_count() != 1)
+        throw std::logic_error("Race condition detected - the pointer is no longer unique.");
+      return true;
+    }
+#endif
   }
   return false;
 }
 
+DLL_PUBLIC shared_ptr<void> WrapExternalBuffer(void *ptr, ExternalBufferReleaseFn release,
+                                               void *user_data, int device_id,
+                                               AccessOrder order) {
+  DALI_ENFORCE(release != nullptr, "The release callback must not be null.");
+  cudaStream_t stream = order.has_value() ? order.get() : AccessOrder::host_sync_stream();
+  return shared_ptr<void>(ptr, ExternalBufferDeleter{release, user_data, device_id, stream});
+}
+
+DLL_PUBLIC shared_ptr<uint8_t> AllocGrowableBuffer(size_t bytes, size_t max_bytes, int device_id,
+                                                   AccessOrder order) {
+#if DALI_USE_CUDA_VM_MAP
+  if (bytes > max_bytes || !mm::cuvm::IsSupported())
+    return nullptr;
+  auto allocation = std::make_shared<GrowableAllocation>(max_bytes, device_id);
+  allocation->grow(bytes);
+  cudaStream_t s = order.has_value() ? order.get() : AccessOrder::host_sync_stream();
+  uint8_t *data = allocation->data();
+  return shared_ptr<uint8_t>(data, GrowableDeleter{ std::move(allocation), s });
+#else
+  return nullptr;
+#endif
+}
+
+DLL_PUBLIC size_t GrowBuffer(const std::shared_ptr<void> &ptr, size_t bytes) {
+#if DALI_USE_CUDA_VM_MAP
+  if (auto *del = std::get_deleter<GrowableDeleter>(ptr)) {
+    if (del->allocation->grow(bytes))
+      return del->allocation->capacity();
+  }
+#endif
+  return 0;
+}
+
 
 DLL_PUBLIC shared_ptr<uint8_t> AllocBuffer(size_t bytes, bool /* device_ordinal */,
                                            int device_id,
@@ -65,7 +226,11 @@ DLL_PUBLIC shared_ptr<uint8_t> AllocBuffer(size_t bytes, bool pinned,
 DLL_PUBLIC bool RestrictPinnedMemUsage() {
   static const bool val = []() {
     const char *env = getenv("DALI_RESTRICT_PINNED_MEM");
-    return env && atoi(env);
+    if (env)
+      return atoi(env) != 0;
+    // Without a driver or a device (CPU-only deployments), pinned memory can't be allocated and
+    // the host buffers don't need to go through CUDA at all.
+    return !cuInitChecked();
   }();
   return val;
 }
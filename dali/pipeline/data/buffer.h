@@ -62,9 +62,58 @@ DLL_PUBLIC shared_ptr<uint8_t> AllocBuffer(size_t bytes,
                                            bool pinned, int device_id,
                                            AccessOrder order, CPUBackend *);
 
+/**
+ * @brief Allocates device memory which can grow in place, up to `max_bytes` (see GrowBuffer).
+ *
+ * A virtual address range of `max_bytes` is reserved and physical memory is mapped to it
+ * on demand.
+ *
+ * @return The pointer to the memory or null, if the CUDA virtual memory management is not
+ *         available.
+ */
+DLL_PUBLIC shared_ptr<uint8_t> AllocGrowableBuffer(size_t bytes, size_t max_bytes, int device_id,
+                                                   AccessOrder order);
+
+/**
+ * @brief Grows, in place, a buffer allocated with AllocGrowableBuffer.
+ *
+ * The address and the contents of the buffer don't change.
+ *
+ * @return The new capacity of the buffer or 0, if the buffer cannot grow to `bytes` bytes.
+ */
+DLL_PUBLIC size_t GrowBuffer(const std::shared_ptr<void> &ptr, size_t bytes);
+
+/**
+ * @brief Notifies the owner of an external buffer that DALI no longer uses it.
+ *
+ * @param ptr       The buffer.
+ * @param user_data The value passed to WrapExternalBuffer.
+ * @param done      If the buffer was last used in a device order - an event recorded in that
+ *                  order; the buffer must not be reused before the event completes (the owner can
+ *                  e.g. make its stream wait for it). The event is valid only until the callback
+ *                  returns. Null, if the buffer was released in host order.
+ *
+ * @remarks The callback must not throw.
+ */
+typedef void (*ExternalBufferReleaseFn)(void *ptr, void *user_data, cudaEvent_t done);
+
+/**
+ * @brief Wraps an externally owned buffer in a shared pointer which calls `release` once the last
+ *        owner drops it.
+ *
+ * Like the buffers allocated by DALI, the release is ordered after the work pending in the order
+ * in which the buffer was used for the last time (see set_deletion_order).
+ *
+ * @param order The order in which the buffer is used initially.
+ */
+DLL_PUBLIC shared_ptr<void> WrapExternalBuffer(void *ptr, ExternalBufferReleaseFn release,
+                                               void *user_data, int device_id, AccessOrder order);
 
 /**
  * @brief Indicates, based on environment cues, whether pinned memory allocations should be avoided.
+ *
+ * The pinned memory is avoided when the `DALI_RESTRICT_PINNED_MEM` environment variable is set
+ * to a non-zero value or, if it's not set at all, when CUDA is not available.
  */
 DLL_PUBLIC bool RestrictPinnedMemUsage();
 
@@ -451,6 +500,20 @@ class DLL_PUBLIC Buffer {
       return;
     }
 
+    if (data_) {
+      if (size_t grown = GrowBuffer(data_, new_num_bytes)) {
+        if (order) {
+          set_order(order);
+        }
+        num_bytes_ = grown;
+        return;
+      }
+    }
+
+    // A buffer which needs to grow is likely to grow again - it's allocated as growable.
+    bool growable = std::is_same<Backend, GPUBackend>::value && !allocate_ && num_bytes_ > 0 &&
+                    new_num_bytes <= grow_in_place_limit_;
+
     free_storage();
     if (order) {
       set_order(order);
@@ -471,8 +534,13 @@ class DLL_PUBLIC Buffer {
       }
     }
 
-    data_ = allocate_ ? allocate_(new_num_bytes)
-                      : AllocBuffer<Backend>(new_num_bytes, pinned_, device_, order_);
+    if (growable)
+      data_ = AllocGrowableBuffer(new_num_bytes, grow_in_place_limit_, device_, order_);
+
+    if (!data_) {
+      data_ = allocate_ ? allocate_(new_num_bytes)
+                        : AllocBuffer<Backend>(new_num_bytes, pinned_, device_, order_);
+    }
 
     num_bytes_ = new_num_bytes;
   }
@@ -585,6 +653,20 @@ class DLL_PUBLIC Buffer {
   static double GetShrinkThreshold() {
     return shrink_threshold_;
   }
+  /**
+   * @brief Sets the maximum size of the buffers which grow in place (GPU buffers only).
+   *
+   * When a GPU buffer needs to grow, it's reallocated as a reservation of `max_bytes` of virtual
+   * address space, with physical memory mapped on demand. Subsequent growth only maps more memory,
+   * without reallocating the buffer. 0 disables the mode.
+   * It has no effect if the CUDA virtual memory management is not available.
+   */
+  static void SetGrowInPlaceLimit(size_t max_bytes) {
+    grow_in_place_limit_ = max_bytes;
+  }
+  static size_t GetGrowInPlaceLimit() {
+    return grow_in_place_limit_;
+  }
 
   DLL_PUBLIC static constexpr double kMaxGrowthFactor = 4;
 
@@ -673,6 +755,7 @@ class DLL_PUBLIC Buffer {
 
   static double growth_factor_;
   static double shrink_threshold_;
+  static size_t grow_in_place_limit_;
 
   static bool default_pinned() {
     static const bool pinned = !RestrictPinnedMemUsage();
@@ -697,6 +780,9 @@ template <typename Backend>
 DLL_PUBLIC double Buffer<Backend>::shrink_threshold_ =
   std::is_same<Backend, CPUBackend>::value ? 0.5 : 0;
 
+template <typename Backend>
+DLL_PUBLIC size_t Buffer<Backend>::grow_in_place_limit_ = 0;
+
 template <typename Backend>
 constexpr double Buffer<Backend>::kMaxGrowthFactor;
 
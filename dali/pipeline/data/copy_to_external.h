@@ -47,6 +47,9 @@ inline void CopyToExternalImpl(void* dst,
                                const Tensor<SrcBackend> &src,
                                AccessOrder order, bool use_copy_kernel) {
   DeviceGuard d(src.device_id());
+  // The data may already be in the destination buffer (see Pipeline::SetOutputBuffer)
+  if (src.raw_data() == dst)
+    return;
   const auto &type_info = src.type_info();
   type_info.template Copy<DstBackend, SrcBackend>(dst, src.raw_data(), src.size(), order.stream(),
                                                   use_copy_kernel);
@@ -65,10 +68,16 @@ inline void CopyToExternalImpl(void* dst,
   constexpr bool is_gpu_copy = std::is_same_v<DstBackend, GPUBackend> ||
                                std::is_same_v<SrcBackend, GPUBackend>;
   if constexpr (is_gpu_copy) {
+    // The outputs of an asynchronous pipeline may still be computed (see EnableAsyncOutputs)
+    if (src.ready_event())
+      order.wait(src.ready_event());
     src.order().wait(order);
   }
 
   if (src.IsContiguous()) {
+    // The data may already be in the destination buffer (see Pipeline::SetOutputBuffer)
+    if (contiguous_raw_data(src) == dst)
+      return;
     type_info.template Copy<DstBackend, SrcBackend>(dst, contiguous_raw_data(src),
                                                     src._num_elements(),
                                                     order.stream(), use_copy_kernel);
@@ -98,6 +107,9 @@ inline void CopyToExternalImpl(void** dsts,
   constexpr bool is_gpu_copy = std::is_same_v<DstBackend, GPUBackend> ||
                                std::is_same_v<SrcBackend, GPUBackend>;
   if constexpr (is_gpu_copy) {
+    // The outputs of an asynchronous pipeline may still be computed (see EnableAsyncOutputs)
+    if (src.ready_event())
+      order.wait(src.ready_event());
     src.order().wait(order);
   }
 
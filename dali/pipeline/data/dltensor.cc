@@ -21,10 +21,12 @@ namespace dali {
 
 DLDataType ToDLType(DALIDataType type) {
   DLDataType dl_type{};
-  TYPE_SWITCH(type, type2id, T, (DALI_NUMERIC_TYPES_FP16, bool), (
+  TYPE_SWITCH(type, type2id, T, (DALI_NUMERIC_TYPES_FP16, bfloat16, bool), (
     dl_type.bits = sizeof(T) * 8;
       dl_type.lanes = 1;
-      if constexpr (dali::is_fp_or_half<T>::value) {
+      if constexpr (dali::is_bfloat16<T>::value) {
+        dl_type.code = kDLBfloat;
+      } else if constexpr (dali::is_fp_or_half<T>::value) {
         dl_type.code = kDLFloat;
       } else if constexpr (std::is_same_v<T, bool>) {
         dl_type.code = kDLBool;
@@ -75,6 +77,11 @@ DALIDataType ToDALIType(const DLDataType &dl_type) {
       }
       break;
     }
+    case kDLBfloat: {
+      if (dl_type.bits == 16)
+        return DALI_BFLOAT16;
+      break;
+    }
     case kDLBool: {
       return DALI_BOOL;
       break;
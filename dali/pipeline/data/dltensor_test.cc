@@ -25,7 +25,7 @@ TEST(DLPackTest, DLType) {
   DLDataType dl;
   for (DALIDataType dali : {
       DALI_BOOL,
-      DALI_FLOAT16, DALI_FLOAT, DALI_FLOAT64,
+      DALI_FLOAT16, DALI_BFLOAT16, DALI_FLOAT, DALI_FLOAT64,
       DALI_INT8, DALI_UINT8,
       DALI_INT16, DALI_UINT16,
       DALI_INT32, DALI_UINT32,
@@ -38,6 +38,8 @@ TEST(DLPackTest, DLType) {
       EXPECT_EQ(dl.code, kDLUInt);
     } else if (info.name().find("int") == 0) {
       EXPECT_EQ(dl.code, kDLInt);
+    } else if (info.name().find("bfloat") == 0) {
+      EXPECT_EQ(dl.code, kDLBfloat);
     } else if (info.name().find("float") == 0) {
       EXPECT_EQ(dl.code, kDLFloat);
     } else if (info.name().find("bool") == 0) {
@@ -0,0 +1,154 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "dali/pipeline/data/ipc_tensor_list.h"
+#include "dali/core/device_guard.h"
+#include "dali/core/mm/async_pool.h"
+#include "dali/core/mm/cuda_ipc_resource.h"
+#include "dali/core/mm/memory.h"
+#include "dali/core/spinlock.h"
+
+namespace dali {
+
+#if DALI_USE_CUDA_VM_MAP
+
+namespace {
+
+using ipc_pool_t = mm::async_pool_resource<mm::memory_kind::device,
+    mm::pool_resource<mm::memory_kind::device, mm::coalescing_free_tree, spinlock>>;
+
+struct IPCDeviceResources {
+  explicit IPCDeviceResources(int device_id)
+  : upstream(device_id), pool(&upstream) {}
+
+  mm::cuda_ipc_memory_resource upstream;
+  ipc_pool_t pool;
+};
+
+IPCDeviceResources &GetIPCResources(int device_id) {
+  static std::mutex mtx;
+  static std::vector<std::unique_ptr<IPCDeviceResources>> resources;
+  std::lock_guard<std::mutex> g(mtx);
+  if (resources.empty()) {
+    int ndev = 0;
+    CUDA_CALL(cudaGetDeviceCount(&ndev));
+    resources.resize(ndev);
+  }
+  DALI_ENFORCE(device_id >= 0 && device_id < static_cast<int>(resources.size()),
+               make_string("Invalid device ordinal: ", device_id));
+  auto &res = resources[device_id];
+  if (!res) {
+    DALI_ENFORCE(mm::cuda_ipc_memory_resource::is_supported(device_id), make_string(
+        "Sharing the memory between processes is not supported on device ", device_id, "."));
+    DeviceGuard dg(device_id);
+    res = std::make_unique<IPCDeviceResources>(device_id);
+  }
+  return *res;
+}
+
+}  // namespace
+
+bool IsIPCSupported(int device_id) {
+  return mm::cuda_ipc_memory_resource::is_supported(device_id);
+}
+
+shared_ptr<uint8_t> AllocIPCBuffer(size_t bytes, int device_id, AccessOrder order) {
+  const size_t kDevAlignment = 256;  // the same as in regular device buffers
+  cudaStream_t s = order.has_value() ? order.get() : AccessOrder::host_sync_stream();
+  mm::device_async_resource *rsrc = &GetIPCResources(device_id).pool;
+  return mm::alloc_raw_async_shared<uint8_t>(rsrc, bytes, s, s, kDevAlignment);
+}
+
+std::vector<std::optional<IPCTensorListDesc>> ExportIPC(Workspace &ws) {
+  std::vector<std::optional<IPCTensorListDesc>> descs(ws.NumOutput());
+  for (int i = 0; i < ws.NumOutput(); i++) {
+    if (!ws.OutputIsType<GPUBackend>(i))
+      continue;
+    auto *out = &ws.Output<GPUBackend>(i);
+    int device_id = out->device_id();
+    auto &ipc = GetIPCResources(device_id);
+    if (out->nbytes() > 0 &&
+        !(out->IsContiguousInMemory() && ipc.upstream.owns(contiguous_raw_data(*out)))) {
+      AccessOrder order = out->order();
+      auto copy = std::make_shared<TensorList<GPUBackend>>();
+      copy->set_order(order, false);
+      copy->set_device_id(device_id);
+      copy->SetContiguity(BatchContiguity::Contiguous);
+      copy->set_alloc_func([device_id, order](size_t bytes) {
+        return AllocIPCBuffer(bytes, device_id, order);
+      });
+      copy->Copy(*out, order);
+      ws.SetOutput(i, copy);
+      out = copy.get();
+    }
+    AccessOrder::host().wait(out->order());
+
+    auto &desc = descs[i].emplace();
+    if (out->nbytes() > 0) {
+      mm::ipc_mem_handle handle = ipc.upstream.export_handle(contiguous_raw_data(*out));
+      desc.fd = handle.fd;
+      desc.size = handle.size;
+      desc.offset = handle.offset;
+    }
+    desc.device_id = device_id;
+    desc.type = out->type();
+    desc.shape = out->shape();
+    desc.layout = out->GetLayout();
+  }
+  return descs;
+}
+
+void ImportIPC(TensorList<GPUBackend> &tl, const IPCTensorListDesc &desc) {
+  size_t bytes = desc.shape.num_elements() * TypeTable::GetTypeInfo(desc.type).size();
+  if (bytes == 0) {
+    tl.Reset();
+    tl.Resize(desc.shape, desc.type);
+    tl.SetLayout(desc.layout);
+    return;
+  }
+  DALI_ENFORCE(desc.offset + bytes <= desc.size,
+               "The shared memory is too small to contain the described batch.");
+  auto mapping = std::make_shared<mm::cuda_ipc_mapping>(
+      mm::ipc_mem_handle{ desc.fd, desc.size, desc.offset });
+  // The device ordinals may differ between the processes - use the one of the mapped memory
+  int device_id = mapping->device_id();
+  void *data = mapping->data();
+  tl.ShareData(shared_ptr<void>(std::move(mapping), data), bytes, false, desc.shape, desc.type,
+               device_id, AccessOrder::host(), desc.layout);
+}
+
+#else  // DALI_USE_CUDA_VM_MAP
+
+bool IsIPCSupported(int) {
+  return false;
+}
+
+shared_ptr<uint8_t> AllocIPCBuffer(size_t, int, AccessOrder) {
+  throw std::logic_error("Sharing the memory between processes requires CUDA 10.2 or newer.");
+}
+
+std::vector<std::optional<IPCTensorListDesc>> ExportIPC(Workspace &) {
+  throw std::logic_error("Sharing the memory between processes requires CUDA 10.2 or newer.");
+}
+
+void ImportIPC(TensorList<GPUBackend> &, const IPCTensorListDesc &) {
+  throw std::logic_error("Sharing the memory between processes requires CUDA 10.2 or newer.");
+}
+
+#endif  // DALI_USE_CUDA_VM_MAP
+
+}  // namespace dali
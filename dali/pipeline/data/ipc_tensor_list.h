@@ -0,0 +1,81 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_DATA_IPC_TENSOR_LIST_H_
+#define DALI_PIPELINE_DATA_IPC_TENSOR_LIST_H_
+
+#include <memory>
+#include <optional>
+#include <vector>
+#include "dali/core/access_order.h"
+#include "dali/core/api_helper.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/pipeline/data/tensor_list.h"
+#include "dali/pipeline/workspace/workspace.h"
+
+namespace dali {
+
+/**
+ * @brief The information needed to recreate a GPU TensorList in another process.
+ *
+ * `fd` is a POSIX file descriptor of the physical allocation which contains the data; it's owned
+ * by the producer and must be passed to the consumer process by means of a UNIX domain socket
+ * (SCM_RIGHTS) or pidfd_getfd. The data occupies `shape.num_elements()` elements, starting
+ * `offset` bytes after the beginning of the allocation, which has `size` bytes.
+ */
+struct IPCTensorListDesc {
+  int fd = -1;
+  size_t size = 0;
+  size_t offset = 0;
+  int device_id = -1;
+  DALIDataType type = DALI_NO_TYPE;
+  TensorListShape<> shape;
+  TensorLayout layout;
+};
+
+/**
+ * @brief Tells whether the outputs can be shared with other processes on given device.
+ */
+DLL_PUBLIC bool IsIPCSupported(int device_id);
+
+/**
+ * @brief Allocates device memory which can be shared with other processes.
+ *
+ * The memory comes from a per-device pool of CUDA IPC-exportable allocations.
+ */
+DLL_PUBLIC shared_ptr<uint8_t> AllocIPCBuffer(size_t bytes, int device_id, AccessOrder order);
+
+/**
+ * @brief Describes the GPU outputs in `ws` so that they can be mapped in another process.
+ *
+ * The outputs which are not contiguous or not located in IPC-exportable memory are copied to
+ * such memory and replaced in the workspace. The function waits for the outputs to be ready.
+ *
+ * The memory is reused when the outputs are released - the consumer must be done with the data
+ * before that.
+ *
+ * @return The descriptors of the outputs; empty for the CPU outputs.
+ */
+DLL_PUBLIC std::vector<std::optional<IPCTensorListDesc>> ExportIPC(Workspace &ws);
+
+/**
+ * @brief Maps the memory described by `desc` and makes `tl` use it.
+ *
+ * The mapping is kept alive for as long as the `tl` (or anything that shares its data) uses it.
+ */
+DLL_PUBLIC void ImportIPC(TensorList<GPUBackend> &tl, const IPCTensorListDesc &desc);
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_DATA_IPC_TENSOR_LIST_H_
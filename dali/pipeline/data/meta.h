@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2017-2018, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,10 +16,25 @@
 #define DALI_PIPELINE_DATA_META_H_
 
 #include <string>
+#include "dali/core/tensor_shape.h"
 #include "dali/pipeline/data/types.h"
 
 namespace dali {
 
+/**
+ * @brief The properties of an encoded image, read from its header without decoding it
+ */
+struct EncodedImageInfo {
+  /** The shape (HWC) of the image as stored - without the orientation applied */
+  TensorShape<> shape;
+  /** The rotation (in degrees, counterclockwise) from the orientation metadata of the image */
+  int rotation = 0;
+
+  bool empty() const {
+    return shape.sample_dim() == 0;
+  }
+};
+
 class DALIMeta {
  public:
   DALIMeta() = default;
@@ -51,10 +66,20 @@ class DALIMeta {
     return skip_sample_;
   }
 
+  /** The image info attached by the reader, if the sample is an encoded image; can be empty */
+  inline const EncodedImageInfo &GetEncodedImageInfo() const {
+    return encoded_image_info_;
+  }
+
+  inline void SetEncodedImageInfo(const EncodedImageInfo &info) {
+    encoded_image_info_ = info;
+  }
+
  private:
   TensorLayout layout_;
   std::string source_info_;
   bool skip_sample_ = false;
+  EncodedImageInfo encoded_image_info_;
 };
 
 }  // namespace dali
@@ -446,6 +446,14 @@ class Tensor : public Buffer<Backend> {
     meta_.SetSourceInfo(source_info);
   }
 
+  inline const EncodedImageInfo &GetEncodedImageInfo() const {
+    return meta_.GetEncodedImageInfo();
+  }
+
+  inline void SetEncodedImageInfo(const EncodedImageInfo &info) {
+    meta_.SetEncodedImageInfo(info);
+  }
+
   inline void SetSkipSample(bool skip_sample) {
     meta_.SetSkipSample(skip_sample);
   }
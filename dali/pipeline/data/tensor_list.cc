@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <string>
 
 #include "dali/core/access_order.h"
@@ -195,6 +196,8 @@ TensorList<Backend> &TensorList<Backend>::operator=(TensorList<Backend> &&other)
   if (&other != this) {
     contiguous_buffer_ = std::move(other.contiguous_buffer_);
     tensors_ = std::move(other.tensors_);
+    sample_offsets_ = std::move(other.sample_offsets_);
+    views_materialized_ = other.views_materialized_.load();
 
     state_ = other.state_;
     curr_num_tensors_ = other.curr_num_tensors_;
@@ -251,6 +254,7 @@ void TensorList<Backend>::SetSample(int sample_idx, const TensorList<Backend> &s
   MakeNoncontiguous();
   if (&src.tensors_[src_sample_idx] == &tensors_[sample_idx])
     return;
+  src.materialize_views();
   VerifySampleShareCompatibility(src.type(), src.shape().sample_dim(), src.GetLayout(),
                                  src.is_pinned(), src.device_id(),
                                  make_string(" for source sample idx: ", src_sample_idx,
@@ -370,6 +374,8 @@ void TensorList<Backend>::CopySample(int sample_idx, const TensorList<Backend> &
                                 make_string(" for source sample idx: ", src_sample_idx,
                                             " and target sample idx: ", sample_idx, "."));
 
+  materialize_views();
+  src.materialize_views();
   shape_.set_tensor_shape(sample_idx, src.shape()[src_sample_idx]);
   tensors_[sample_idx].Copy(src.tensors_[src_sample_idx], order);
   if (src.GetLayout().empty() && !GetLayout().empty()) {
@@ -387,6 +393,7 @@ void TensorList<Backend>::CopySample(int sample_idx, const Tensor<Backend> &src,
                                 shape()[sample_idx], src.shape(),
                                 make_string(" for sample idx: ", sample_idx, "."));
 
+  materialize_views();
   shape_.set_tensor_shape(sample_idx, src.shape());
   tensors_[sample_idx].Copy(src, order);
   if (src.GetLayout().empty() && !GetLayout().empty()) {
@@ -491,14 +498,14 @@ void TensorList<Backend>::set_order(AccessOrder order, bool synchronize) {
 template <typename Backend>
 SampleView<Backend> TensorList<Backend>::operator[](size_t pos) {
   DALI_ENFORCE(pos < static_cast<size_t>(curr_num_tensors_), "Out of bounds access");
-  return {tensors_[pos].raw_mutable_data(), shape().tensor_shape_span(pos), tensors_[pos].type()};
+  return {raw_mutable_tensor(pos), shape().tensor_shape_span(pos), type()};
 }
 
 
 template <typename Backend>
 ConstSampleView<Backend> TensorList<Backend>::operator[](size_t pos) const {
   DALI_ENFORCE(pos < static_cast<size_t>(curr_num_tensors_), "Out of bounds access");
-  return {tensors_[pos].raw_data(), shape().tensor_shape_span(pos), tensors_[pos].type()};
+  return {raw_tensor(pos), shape().tensor_shape_span(pos), type()};
 }
 
 
@@ -566,6 +573,7 @@ void TensorList<Backend>::Resize(const TensorListShape<> &new_shape, DALIDataTyp
     return;
   }
 
+  sample_offsets_.clear();
   for (int i = 0; i < curr_num_tensors_; i++) {
     tensors_[i].Resize(new_shape[i], new_type);
   }
@@ -644,6 +652,11 @@ void TensorList<Backend>::SetSourceInfo(int idx, const std::string &source_info)
   tensors_[idx].SetSourceInfo(source_info);
 }
 
+template <typename Backend>
+void TensorList<Backend>::SetEncodedImageInfo(int idx, const EncodedImageInfo &info) {
+  tensors_[idx].SetEncodedImageInfo(info);
+}
+
 template <typename Backend>
 const DALIMeta &TensorList<Backend>::GetMeta(int idx) const {
   assert(idx < curr_num_tensors_);
@@ -684,6 +697,7 @@ void TensorList<Backend>::reserve(size_t total_bytes) {
   int batch_size_bkp = curr_num_tensors_;
   if (!state_.IsContiguous()) {
     tensors_.clear();
+    sample_offsets_.clear();
     resize_tensors(0);
   }
   state_.Setup(BatchContiguity::Contiguous);
@@ -698,6 +712,8 @@ void TensorList<Backend>::reserve(size_t total_bytes) {
 template <typename Backend>
 void TensorList<Backend>::reserve(size_t bytes_per_sample, int batch_size) {
   assert(batch_size > 0);
+  materialize_views();
+  sample_offsets_.clear();
   state_.Setup(BatchContiguity::Noncontiguous);
   resize_tensors(batch_size);
   for (int i = 0; i < curr_num_tensors_; i++) {
@@ -708,19 +724,49 @@ void TensorList<Backend>::reserve(size_t bytes_per_sample, int batch_size) {
 template <typename Backend>
 void TensorList<Backend>::recreate_views() {
   // precondition: type, shape are configured
-  uint8_t *sample_ptr = static_cast<uint8_t *>(contiguous_buffer_.raw_mutable_data());
+  release_views();
   int64_t num_samples = shape().num_samples();
-  auto &data_ptr = contiguous_buffer_.get_data_ptr();
+  sample_offsets_.resize(num_samples);
+  int64_t offset = 0;
   for (int64_t i = 0; i < num_samples; i++) {
-    // or any other way
-    auto tensor_size = shape().tensor_size(i);
+    sample_offsets_[i] = offset;
+    offset += shape().tensor_size(i);
+  }
+}
+
 
-    tensors_[i].ShareData(std::shared_ptr<void>(data_ptr, sample_ptr),
+template <typename Backend>
+void TensorList<Backend>::materialize_views() const {
+  if (!state_.IsContiguous() || sample_offsets_.empty() ||
+      views_materialized_.load(std::memory_order_acquire))
+    return;
+  std::lock_guard<std::mutex> guard(views_mutex_);
+  if (views_materialized_.load(std::memory_order_relaxed))
+    return;
+  auto &data_ptr = contiguous_buffer_.get_data_ptr();
+  for (int i = 0; i < static_cast<int>(sample_offsets_.size()); i++) {
+    auto tensor_size = shape().tensor_size(i);
+    tensors_[i].ShareData(std::shared_ptr<void>(data_ptr, lazy_sample_ptr(i)),
                           tensor_size * type_info().size(), is_pinned(), shape()[i],
                           type(), device_id(), order());
-    tensors_[i].SetLayout(GetLayout());
-    sample_ptr += tensor_size * type_info().size();
+    // the layout is set only if needed - the metadata of the samples may be read concurrently
+    if (tensors_[i].GetLayout() != GetLayout())
+      tensors_[i].SetLayout(GetLayout());
+  }
+  views_materialized_.store(true, std::memory_order_release);
+}
+
+
+template <typename Backend>
+void TensorList<Backend>::release_views() {
+  if (views_materialized_.load(std::memory_order_relaxed)) {
+    size_t n = std::min(sample_offsets_.size(), tensors_.size());
+    for (size_t i = 0; i < n; i++) {
+      tensors_[i].data_.reset();
+      tensors_[i].shares_data_ = false;
+    }
   }
+  views_materialized_.store(false, std::memory_order_relaxed);
 }
 
 
@@ -759,6 +805,10 @@ void TensorList<Backend>::MakeNoncontiguous() {
 
 template <typename Backend>
 void TensorList<Backend>::DoMakeNoncontiguous() {
+  // The samples keep the views of the contiguous buffer, so they have to be materialized
+  materialize_views();
+  sample_offsets_.clear();
+  views_materialized_ = false;
   auto &contiguous_ptr = contiguous_buffer_.get_data_ptr();
   for (auto &t : tensors_) {
     // If the Tensor was aliasing the contiguous buffer, mark it as not sharing any data.
@@ -778,6 +828,8 @@ void TensorList<Backend>::Reset() {
   contiguous_buffer_.reset();
   // TODO(klecki): Is there any benefit to call Reset on all?
   tensors_.clear();
+  sample_offsets_.clear();
+  views_materialized_ = false;
 
   curr_num_tensors_ = 0;
   type_ = {};
@@ -872,6 +924,7 @@ void TensorList<Backend>::ShareData(const TensorList<Backend> &tl) {
     tensors_.resize(shape().num_samples());
     recreate_views();
   } else {
+    sample_offsets_.clear();
     if (!same_data) {
       int batch_size = tl.num_samples();
       tensors_.resize(shape().num_samples());
@@ -968,6 +1021,23 @@ Tensor<Backend> TensorList<Backend>::AsTensor() {
 }
 
 
+template <typename Backend>
+std::vector<int64_t> TensorList<Backend>::RaggedOffsets() const {
+  std::vector<int64_t> offsets(num_samples() + 1);
+  for (int i = 0; i < num_samples(); i++)
+    offsets[i + 1] = offsets[i] + shape().tensor_size(i);
+  return offsets;
+}
+
+
+template <typename Backend>
+Tensor<Backend> TensorList<Backend>::AsRaggedValues() {
+  auto values = AsReshapedTensor(TensorShape<1>(shape().num_elements()));
+  values.SetLayout({});
+  return values;
+}
+
+
 template <typename Backend>
 void TensorList<Backend>::ShareData(shared_ptr<void> ptr, size_t bytes, bool pinned,
                                     const TensorListShape<> &shape, DALIDataType type,
@@ -1034,6 +1104,8 @@ void TensorList<Backend>::resize_tensors(int new_size) {
       tensors_[i].SetLayout(GetLayout());
     }
   } else if (new_size < curr_num_tensors_) {
+    if (static_cast<int>(sample_offsets_.size()) > new_size)
+      sample_offsets_.resize(new_size);
     // TODO(klecki): Do not keep the invalidated tensors - this prevents memory hogging but
     // also gets rid of reserved memory. For now keeping the old behaviour.
     for (int i = new_size; i < curr_num_tensors_; i++) {
@@ -1048,6 +1120,7 @@ void TensorList<Backend>::resize_tensors(int new_size) {
 
 template <typename Backend>
 void TensorList<Backend>::UpdatePropertiesFromSamples(bool contiguous) {
+  materialize_views();
   if (contiguous) {
     bool is_really_contiguous = true;
 
@@ -1117,6 +1190,15 @@ void TensorList<Backend>::UpdatePropertiesFromSamples(bool contiguous) {
                              " got: ", tensors_[i].device_id(), " at ", i, "."));
     shape_.set_tensor_shape(i, tensors_[i].shape());
   }
+  // The samples hold the actual data, the offsets are needed only for the contiguous batch
+  views_materialized_ = false;
+  if (contiguous) {
+    recreate_views();
+    views_materialized_ = true;
+  } else {
+    sample_offsets_.clear();
+    views_materialized_ = false;
+  }
 }
 
 
@@ -18,6 +18,7 @@
 #include <atomic>
 #include <cassert>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -152,8 +153,8 @@ class DLL_PUBLIC TensorList {
    *
    * [shape_access]
    */
-  const TensorShape<> &tensor_shape(int idx) const & {
-    return tensors_[idx].shape();
+  TensorShape<> tensor_shape(int idx) const & {
+    return shape_[idx];
   }
 
   /**
@@ -186,6 +187,8 @@ class DLL_PUBLIC TensorList {
    */
   template <typename T>
   DLL_PUBLIC inline T *mutable_tensor(int idx) {
+    if (is_lazy_sample(idx))
+      return contiguous_buffer_.template mutable_data<T>() + sample_offsets_[idx];
     return tensors_[idx].template mutable_data<T>();
   }
 
@@ -194,6 +197,8 @@ class DLL_PUBLIC TensorList {
    */
   template <typename T>
   DLL_PUBLIC inline const T *tensor(int idx) const {
+    if (is_lazy_sample(idx))
+      return contiguous_buffer_.template data<T>() + sample_offsets_[idx];
     return tensors_[idx].template data<T>();
   }
 
@@ -201,6 +206,8 @@ class DLL_PUBLIC TensorList {
    * @brief Returns a raw pointer to the tensor with the given index.
    */
   DLL_PUBLIC inline void *raw_mutable_tensor(int idx) {
+    if (is_lazy_sample(idx))
+      return lazy_sample_ptr(idx);
     return tensors_[idx].raw_mutable_data();
   }
 
@@ -208,6 +215,8 @@ class DLL_PUBLIC TensorList {
    * @brief Returns a const raw pointer to the tensor with the given index.
    */
   DLL_PUBLIC inline const void *raw_tensor(int idx) const {
+    if (is_lazy_sample(idx))
+      return lazy_sample_ptr(idx);
     return tensors_[idx].raw_data();
   }
   /** @} */
@@ -505,6 +514,18 @@ class DLL_PUBLIC TensorList {
     return device_;
   }
 
+  /**
+   * @brief Sets a custom allocation function for the contiguous buffer.
+   *
+   * The function is used by subsequent allocations, as long as the batch remains contiguous.
+   * It's reset along with the buffer (see Reset).
+   *
+   * @remarks Experimental - subject to change
+   */
+  void set_alloc_func(typename Buffer<Backend>::AllocFunc alloc) {
+    contiguous_buffer_.set_alloc_func(std::move(alloc));
+  }
+
   bool has_data() const;
 
   bool shares_data() const;
@@ -535,6 +556,22 @@ class DLL_PUBLIC TensorList {
    */
   DLL_PUBLIC Tensor<Backend> AsTensor();
 
+  /**
+   * @brief Return the offsets of the samples in the flattened batch (in elements), followed by
+   * the total number of elements.
+   *
+   * Together with AsRaggedValues, it's the ragged representation of the batch (values and
+   * offsets), e.g. for token sequences of different lengths, without padding. For
+   * multidimensional samples, the offsets refer to whole samples - see shape().
+   */
+  DLL_PUBLIC std::vector<int64_t> RaggedOffsets() const;
+
+  /**
+   * @brief Return a 1D view of the values of all samples - see RaggedOffsets.
+   * The batch must be in contiguous memory.
+   */
+  DLL_PUBLIC Tensor<Backend> AsRaggedValues();
+
   /**
    * @name Metadata access
    * @{
@@ -561,6 +598,11 @@ class DLL_PUBLIC TensorList {
    */
   void SetSourceInfo(int idx, const std::string &source_info);
 
+  /**
+   * @brief Set the encoded image properties (see EncodedImageInfo) for given sample
+   */
+  void SetEncodedImageInfo(int idx, const EncodedImageInfo &info);
+
   /**
    * @brief Get the metadata for given sample
    */
@@ -698,13 +740,41 @@ class DLL_PUBLIC TensorList {
   friend class test::TensorListVariableBatchSizeTest_UpdatePropertiesFromSamples_Test;
 
   auto &tensor_handle(size_t pos) {
+    materialize_views();
     return tensors_[pos];
   }
 
-  auto &tensor_handle(size_t pos) const {
+  const auto &tensor_handle(size_t pos) const {
+    materialize_views();
     return tensors_[pos];
   }
 
+  /**
+   * @brief Whether the sample is a view of the contiguous buffer, described only by its offset.
+   *
+   * The data pointers of such samples are calculated from the offsets; the Tensor objects
+   * in tensors_ hold the actual views only after materialize_views.
+   */
+  bool is_lazy_sample(int idx) const noexcept {
+    return state_.IsContiguous() && idx < static_cast<int>(sample_offsets_.size());
+  }
+
+  void *lazy_sample_ptr(int idx) const {
+    auto *base = static_cast<const uint8_t *>(contiguous_buffer_.raw_data());
+    return const_cast<uint8_t *>(base) + sample_offsets_[idx] * type_.size();
+  }
+
+  /**
+   * @brief Fill the Tensors in tensors_ with the views (sharing part of the contiguous buffer)
+   * that represent the lazy samples. Thread-safe, so it can be used from the const accessors.
+   */
+  void materialize_views() const;
+
+  /**
+   * @brief Drop the previously materialized views, so they don't keep the buffer alive.
+   */
+  void release_views();
+
   template <typename T>
   void SetupLikeImpl(const T &other) {
     DALI_ENFORCE(!has_data(),
@@ -746,8 +816,8 @@ class DLL_PUBLIC TensorList {
   void setup_tensor_allocation(int index);
 
   /**
-   * @brief When using one contiguous allocation, rebuild the view Tensors (sharing part of the
-   * contiguous buffer) that represent samples.
+   * @brief When using one contiguous allocation, recalculate the offsets of the samples
+   * in the contiguous buffer. The view Tensors are created lazily, see materialize_views.
    */
   void recreate_views();
 
@@ -785,12 +855,18 @@ class DLL_PUBLIC TensorList {
   // Memory, sample aliases and metadata
   // TODO(klecki): Remove SampleWorkspace (only place where we actually need those Tensor objects)
   // and swap to plain Buffer instead of using actual Tensors.
-  std::vector<Tensor<Backend>> tensors_;
+  // In contiguous mode the data of the samples is described by sample_offsets_ and the Tensors
+  // hold only the metadata until materialize_views is called (hence mutable).
+  mutable std::vector<Tensor<Backend>> tensors_;
+  // Offsets (in elements) of the samples in the contiguous buffer
+  std::vector<int64_t> sample_offsets_;
+  mutable std::atomic<bool> views_materialized_{false};
+  mutable std::mutex views_mutex_;
 
   // State and metadata that should be uniform regardless of the contiguity state.
   // Sample aliases should match the information stored below.
   State state_;
-  bool pinned_ = true;
+  bool pinned_ = !RestrictPinnedMemUsage();
   int curr_num_tensors_ = 0;
   int sample_dim_ = -1;
   int device_ = CPU_ONLY_DEVICE_ID;
@@ -848,6 +924,9 @@ class DLL_PUBLIC TensorList {
    * Sample 0 is aliased with the whole buffer, if it is contiguous.
    */
   friend const shared_ptr<void> &unsafe_sample_owner(TensorList<Backend> &batch, int sample_idx) {
+    if (sample_idx == 0 && batch.is_lazy_sample(0))
+      return batch.contiguous_buffer_.get_data_ptr();
+    batch.materialize_views();
     return batch.tensors_[sample_idx].get_data_ptr();
   }
 
@@ -22,9 +22,11 @@
 #include <type_traits>
 
 #include "dali/core/access_order.h"
+#include "dali/core/call_at_exit.h"
 #include "dali/core/common.h"
 #include "dali/core/error_handling.h"
 #include "dali/core/format.h"
+#include "dali/core/mm/cu_vm.h"
 #include "dali/core/tensor_layout.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/pipeline/data/backend.h"
@@ -1993,6 +1995,79 @@ TEST_F(TensorListVariableBatchSizeTest, UpdatePropertiesFromSamples) {
   tv.SetSample(1, tv.tensor_handle(2));
 }
 
+TEST(TensorList, LazySampleViews) {
+  TensorList<CPUBackend> tl;
+  tl.SetContiguity(BatchContiguity::Contiguous);
+  tl.Resize({{2, 3}, {4, 5}, {1, 1}}, DALI_FLOAT);
+  // the samples don't share the ownership of the buffer until they're accessed as Tensors
+  EXPECT_EQ(unsafe_owner(tl).use_count(), 1);
+  auto *base = static_cast<float *>(contiguous_raw_mutable_data(tl));
+  EXPECT_EQ(tl.mutable_tensor<float>(0), base);
+  EXPECT_EQ(tl.raw_tensor(1), base + 6);
+  EXPECT_EQ(tl[2].raw_data(), base + 26);
+  EXPECT_EQ(tl.tensor_shape(1), TensorShape<>(4, 5));
+
+  // accessing the owner of a sample other than the first one materializes the views
+  EXPECT_EQ(unsafe_sample_owner(tl, 1).get(), base + 6);
+  EXPECT_EQ(unsafe_owner(tl).use_count(), 4);
+
+  // resizing drops the materialized views
+  tl.Resize({{3, 3}, {5, 5}}, DALI_FLOAT);
+  EXPECT_EQ(unsafe_owner(tl).use_count(), 1);
+  base = static_cast<float *>(contiguous_raw_mutable_data(tl));
+  EXPECT_EQ(tl.raw_tensor(1), base + 9);
+  EXPECT_EQ(unsafe_sample_owner(tl, 1).get(), base + 9);
+
+  // the views are kept when switching to non-contiguous mode
+  tl.MakeNoncontiguous();
+  EXPECT_EQ(tl.raw_tensor(1), base + 9);
+  EXPECT_EQ(tl.tensor_shape(1), TensorShape<>(5, 5));
+}
+
+TEST(TensorList, Ragged) {
+  TensorList<CPUBackend> tl;
+  tl.Resize({{3}, {0}, {5}}, DALI_INT32);
+  tl.SetLayout("T");
+  EXPECT_EQ(tl.RaggedOffsets(), (std::vector<int64_t>{0, 3, 3, 8}));
+  auto values = tl.AsRaggedValues();
+  EXPECT_EQ(values.shape(), TensorShape<>(8));
+  EXPECT_EQ(values.GetLayout(), "");
+  EXPECT_EQ(values.raw_data(), tl.raw_tensor(0));
+  EXPECT_EQ(values.data<int32_t>() + 3, tl.tensor<int32_t>(2));
+}
+
+TEST(TensorList, GrowInPlace) {
+#if DALI_USE_CUDA_VM_MAP
+  if (!mm::cuvm::IsSupported())
+    GTEST_SKIP() << "CUDA virtual memory management is not supported.";
+  size_t prev_limit = Buffer<GPUBackend>::GetGrowInPlaceLimit();
+  auto restore = AtScopeExit([&]() {
+    Buffer<GPUBackend>::SetGrowInPlaceLimit(prev_limit);
+  });
+  Buffer<GPUBackend>::SetGrowInPlaceLimit(256 << 20);
+
+  TensorList<GPUBackend> tl;
+  tl.Resize(uniform_list_shape(4, {256 << 10}), DALI_UINT8);
+  // the first growth reallocates the buffer as growable...
+  tl.Resize(uniform_list_shape(4, {1 << 20}), DALI_UINT8);
+  const void *ptr = tl.raw_tensor(0);
+  CUDA_CALL(cudaMemset(tl.raw_mutable_tensor(0), 42, 4 << 20));
+  // ...which grows in place and keeps its contents
+  tl.Resize(uniform_list_shape(4, {8 << 20}), DALI_UINT8);
+  EXPECT_EQ(tl.raw_tensor(0), ptr);
+  EXPECT_GE(tl.capacity(), 32u << 20);
+  std::vector<uint8_t> host(4 << 20);
+  CUDA_CALL(cudaMemcpy(host.data(), ptr, host.size(), cudaMemcpyDeviceToHost));
+  EXPECT_TRUE(std::all_of(host.begin(), host.end(), [](uint8_t x) { return x == 42; }));
+
+  // exceeding the limit falls back to a regular allocation
+  tl.Resize(uniform_list_shape(4, {128 << 20}), DALI_UINT8);
+  EXPECT_GE(tl.capacity(), 512u << 20);
+#else
+  GTEST_SKIP() << "CUDA virtual memory management is not available.";
+#endif
+}
+
 TEST(TensorList, ResizeOverheadPerf) {
   (void)cudaFree(0);
 #ifdef DALI_DEBUG
@@ -19,6 +19,7 @@
 #include <stdexcept>
 
 #include "dali/core/common.h"
+#include "dali/core/dynlink_cuda.h"
 #include "dali/core/mm/malloc_resource.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/pipeline/data/backend.h"
@@ -742,4 +743,18 @@ TYPED_TEST(TensorTest, TestSubspaceTensor) {
   }
 }
 
+TEST(TensorTest_CpuOnlyTests, NotPinnedWithoutCuda) {
+  if (cuInitChecked() || getenv("DALI_RESTRICT_PINNED_MEM"))
+    GTEST_SKIP() << "This test requires a system without CUDA.";
+  Tensor<CPUBackend> t;
+  EXPECT_FALSE(t.is_pinned());
+  t.Resize({16}, DALI_FLOAT);
+  EXPECT_EQ(t.device_id(), CPU_ONLY_DEVICE_ID);
+
+  TensorList<CPUBackend> tl;
+  EXPECT_FALSE(tl.is_pinned());
+  tl.Resize(TensorListShape<>({{4}, {8}}), DALI_UINT8);
+  EXPECT_EQ(tl.device_id(), CPU_ONLY_DEVICE_ID);
+}
+
 }  // namespace dali
@@ -43,17 +43,51 @@ ScatterGatherPool& ScatterGatherPoolInstance() {
   return scatter_gather_pool_;
 }
 
+template <typename DstBackend, typename SrcBackend>
+constexpr cudaMemcpyKind CopyKind() {
+  if (std::is_same_v<SrcBackend, CPUBackend>)
+    return cudaMemcpyHostToDevice;
+  else if (std::is_same_v<DstBackend, CPUBackend>)
+    return cudaMemcpyDeviceToHost;
+  else
+    return cudaMemcpyDeviceToDevice;
+}
+
+/**
+ * Without the copy kernel, the host memory may be pageable. The sources in pageable memory can
+ * still be copied in one batch; the pageable destinations are copied one by one.
+ */
+template <typename DstBackend, typename SrcBackend>
+constexpr kernels::ScatterGatherGPU::Method CopyMethod(bool use_copy_kernel) {
+  using Method = kernels::ScatterGatherGPU::Method;
+  if (use_copy_kernel)
+    return Method::Default;
+  return std::is_same_v<SrcBackend, CPUBackend> ? Method::PageableMemcpy : Method::Memcpy;
+}
+
+/**
+ * The batched copy is used if the copy kernel can access both sides or if only the sources
+ * are in host memory.
+ */
+template <typename DstBackend, typename SrcBackend>
+constexpr bool UseScatterGather(bool use_copy_kernel) {
+  return use_copy_kernel || !std::is_same_v<DstBackend, CPUBackend>;
+}
+
+template <typename DstBackend, typename SrcBackend>
 void ScatterGatherCopy(void **dsts, const void **srcs, const Index *sizes, int n, int element_size,
-                       cudaStream_t stream) {
+                       cudaStream_t stream, bool use_copy_kernel) {
   auto sc = ScatterGatherPoolInstance().Get(stream, kMaxSizePerBlock);
   for (int i = 0; i < n; i++) {
     sc->AddCopy(dsts[i], srcs[i], sizes[i] * element_size);
   }
-  sc->Run(stream, true, kernels::ScatterGatherGPU::Method::Kernel);
+  sc->Run(stream, true, CopyMethod<DstBackend, SrcBackend>(use_copy_kernel),
+          CopyKind<DstBackend, SrcBackend>());
 }
 
+template <typename DstBackend, typename SrcBackend>
 void ScatterGatherCopy(void *dst, const void **srcs, const Index *sizes, int n, int element_size,
-                       cudaStream_t stream) {
+                       cudaStream_t stream, bool use_copy_kernel) {
   auto sc = ScatterGatherPoolInstance().Get(stream, kMaxSizePerBlock);
   auto *sample_dst = reinterpret_cast<uint8_t*>(dst);
   for (int i = 0; i < n; i++) {
@@ -61,11 +95,13 @@ void ScatterGatherCopy(void *dst, const void **srcs, const Index *sizes, int n,
     sc->AddCopy(sample_dst, srcs[i], nbytes);
     sample_dst += nbytes;
   }
-  sc->Run(stream, true, kernels::ScatterGatherGPU::Method::Kernel);
+  sc->Run(stream, true, CopyMethod<DstBackend, SrcBackend>(use_copy_kernel),
+          CopyKind<DstBackend, SrcBackend>());
 }
 
+template <typename DstBackend, typename SrcBackend>
 void ScatterGatherCopy(void **dsts, const void *src, const Index *sizes, int n, int element_size,
-                       cudaStream_t stream) {
+                       cudaStream_t stream, bool use_copy_kernel) {
   auto sc = ScatterGatherPoolInstance().Get(stream, kMaxSizePerBlock);
   auto *sample_src = reinterpret_cast<const uint8_t*>(src);
   for (int i = 0; i < n; i++) {
@@ -73,7 +109,8 @@ void ScatterGatherCopy(void **dsts, const void *src, const Index *sizes, int n,
     sc->AddCopy(dsts[i], sample_src, nbytes);
     sample_src += nbytes;
   }
-  sc->Run(stream, true, kernels::ScatterGatherGPU::Method::Kernel);
+  sc->Run(stream, true, CopyMethod<DstBackend, SrcBackend>(use_copy_kernel),
+          CopyKind<DstBackend, SrcBackend>());
 }
 
 }  // namespace detail
@@ -121,8 +158,9 @@ void TypeInfo::Copy(void **dsts, const void** srcs, const Index* sizes, int n,
                     cudaStream_t stream, bool use_copy_kernel) const {
   constexpr bool is_host_to_host = std::is_same<DstBackend, CPUBackend>::value &&
                                    std::is_same<SrcBackend, CPUBackend>::value;
-  if (!is_host_to_host && use_copy_kernel) {
-    detail::ScatterGatherCopy(dsts, srcs, sizes, n, size(), stream);
+  if (!is_host_to_host && detail::UseScatterGather<DstBackend, SrcBackend>(use_copy_kernel)) {
+    detail::ScatterGatherCopy<DstBackend, SrcBackend>(dsts, srcs, sizes, n, size(), stream,
+                                                      use_copy_kernel);
   } else {
     for (int i = 0; i < n; i++) {
       Copy<DstBackend, SrcBackend>(dsts[i], srcs[i], sizes[i], stream);
@@ -148,8 +186,9 @@ void TypeInfo::Copy(void *dst, const void** srcs, const Index* sizes, int n,
                     cudaStream_t stream, bool use_copy_kernel) const {
   constexpr bool is_host_to_host = std::is_same<DstBackend, CPUBackend>::value &&
                                    std::is_same<SrcBackend, CPUBackend>::value;
-  if (!is_host_to_host && use_copy_kernel) {
-    detail::ScatterGatherCopy(dst, srcs, sizes, n, size(), stream);
+  if (!is_host_to_host && detail::UseScatterGather<DstBackend, SrcBackend>(use_copy_kernel)) {
+    detail::ScatterGatherCopy<DstBackend, SrcBackend>(dst, srcs, sizes, n, size(), stream,
+                                                      use_copy_kernel);
   } else {
     auto sample_dst = static_cast<uint8_t*>(dst);
     for (int i = 0; i < n; i++) {
@@ -178,8 +217,9 @@ void TypeInfo::Copy(void **dsts, const void* src, const Index* sizes, int n,
                     cudaStream_t stream, bool use_copy_kernel) const {
   constexpr bool is_host_to_host = std::is_same<DstBackend, CPUBackend>::value &&
                                    std::is_same<SrcBackend, CPUBackend>::value;
-  if (!is_host_to_host && use_copy_kernel) {
-    detail::ScatterGatherCopy(dsts, src, sizes, n, size(), stream);
+  if (!is_host_to_host && detail::UseScatterGather<DstBackend, SrcBackend>(use_copy_kernel)) {
+    detail::ScatterGatherCopy<DstBackend, SrcBackend>(dsts, src, sizes, n, size(), stream,
+                                                      use_copy_kernel);
   } else {
     auto sample_src = reinterpret_cast<const uint8_t*>(src);
     for (int i = 0; i < n; i++) {
@@ -31,6 +31,7 @@
 #include "dali/core/util.h"
 #include "dali/core/common.h"
 #include "dali/core/spinlock.h"
+#include "dali/core/bfloat16.h"
 #include "dali/core/float16.h"
 #include "dali/core/cuda_error.h"
 #include "dali/core/tensor_layout.h"
@@ -127,6 +128,7 @@ enum DALIDataType : int {
   DALI_PYTHON_OBJECT     = 24,
   DALI_TENSOR_LAYOUT_VEC = 25,
   DALI_DATA_TYPE_VEC     = 26,
+  DALI_BFLOAT16          = 27,
   DALI_NUM_BUILTIN_TYPES,
   DALI_CUSTOM_TYPE_START = 1001
 };
@@ -218,6 +220,9 @@ inline const char *GetBuiltinTypeName(DALIDataType t) {
       break;
     case DALI_DATA_TYPE_VEC:
       return "list of DALIDataType";
+      break;
+    case DALI_BFLOAT16:
+      return "bfloat16";
     default:
       return nullptr;
   }
@@ -229,6 +234,7 @@ inline std::ostream &operator<<(std::ostream &, DALIDataType dtype);
 constexpr bool IsFloatingPoint(DALIDataType type) {
   switch (type) {
     case DALI_FLOAT16:
+    case DALI_BFLOAT16:
     case DALI_FLOAT:
     case DALI_FLOAT64:
       return true;
@@ -257,6 +263,7 @@ constexpr bool IsIntegral(DALIDataType type) {
 constexpr bool IsSigned(DALIDataType type) {
   switch (type) {
     case DALI_FLOAT16:
+    case DALI_BFLOAT16:
     case DALI_FLOAT:
     case DALI_FLOAT64:
     case DALI_INT8:
@@ -637,6 +644,7 @@ DALI_REGISTER_TYPE(int16_t,        DALI_INT16);
 DALI_REGISTER_TYPE(int32_t,        DALI_INT32);
 DALI_REGISTER_TYPE(int64_t,        DALI_INT64);
 DALI_REGISTER_TYPE(float16,        DALI_FLOAT16);
+DALI_REGISTER_TYPE(bfloat16,       DALI_BFLOAT16);
 DALI_REGISTER_TYPE(float,          DALI_FLOAT);
 DALI_REGISTER_TYPE(double,         DALI_FLOAT64);
 DALI_REGISTER_TYPE(bool,           DALI_BOOL);
@@ -15,11 +15,15 @@
 #ifndef DALI_PIPELINE_EXECUTOR_EXECUTOR_H_
 #define DALI_PIPELINE_EXECUTOR_EXECUTOR_H_
 
+#include <map>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 #include "dali/core/common.h"
+#include "dali/core/mm/memory_tag.h"
 #include "dali/pipeline/workspace/workspace.h"
 #include "dali/pipeline/operator/checkpointing/checkpoint.h"
 #include "dali/pipeline/graph/op_graph2.h"
@@ -28,15 +32,84 @@ namespace dali {
 
 class OperatorBase;
 
+/** The profile of an operator, accumulated over the iterations. The times are in microseconds. */
+struct DLL_PUBLIC ExecutorOpProfile {
+  int64_t iterations = 0;
+  /** The host time spent in Setup and Run */
+  double cpu_time = 0;
+  /** The time of the operator's work on its stream (GPU and mixed operators only) */
+  double gpu_time = 0;
+  /** The time spent waiting for the inputs (and the other preconditions, e.g. the queue) */
+  double wait_time = 0;
+  size_t input_bytes = 0;
+  size_t output_bytes = 0;
+};
+
+/** The memory used by an operator, broken down by purpose and memory kind. In bytes. */
+struct DLL_PUBLIC ExecutorOpMemory {
+  /** The current and the peak usage, indexed with mm::MemoryTag and mm::memory_kind_id */
+  mm::MemoryTracker::Usage usage[static_cast<int>(mm::MemoryTag::Count)]
+                                [mm::memory_kind_id::count] = {};
+  /** The capacity of one set of the operator's outputs, i.e. one slot of its output queue */
+  size_t queue_slot_size = 0;
+  /** The number of slots of the output queue (the current and the maximum one) */
+  int queue_slots = 1, max_queue_slots = 1;
+};
+
 struct DLL_PUBLIC ExecutorMeta {
   size_t real_size;
   size_t max_real_size;
   size_t reserved;
   size_t max_reserved;
+  /** The depth of the operator's output queue (0 if the queue is not adaptive) */
+  int queue_depth = 0;
+  /** The number of times the consumers waited for the operator's outputs */
+  size_t queue_stalls = 0;
+  /** The number of times the consumers found the queue full */
+  size_t queue_idle = 0;
+  /** Whether the output is stored in pinned host memory.
+   *
+   * The CPU outputs consumed by mixed or GPU operators are; the other CPU outputs are pageable.
+   */
+  bool pinned = false;
+  /** The profile of the operator - the same in the entries of all outputs of an operator */
+  ExecutorOpProfile profile = {};
+  /** The memory usage breakdown of the operator - the same in the entries of all outputs */
+  ExecutorOpMemory memory = {};
+  /** The integer diagnostic counters of the operator - the same in the entries of all outputs */
+  std::map<std::string, int64_t> diagnostics;
 };
 
 using ExecutorMetaMap = std::unordered_map<std::string, std::vector<ExecutorMeta>>;
 
+/** The utilization of the pipeline stages over a window of time, with a verdict which stage
+ *  limits the throughput.
+ *
+ * The utilizations are fractions of the length of the window.
+ */
+struct DLL_PUBLIC ExecutorDiagnostics {
+  /** The length of the window, in microseconds */
+  double window_time = 0;
+  /** The number of iterations whose outputs were returned in the window */
+  int64_t iterations = 0;
+  /** The time the readers waited for their loaders (the reader which waited the most) */
+  double loader_wait = 0;
+  /** The time when CPU operators were running, excluding the loader wait */
+  double cpu_busy = 0;
+  /** The mean utilization of the threads of the operators' thread pool */
+  double thread_pool_busy = 0;
+  /** The time the busiest stream was running; negative if unknown (requires profiling) */
+  double gpu_busy = -1;
+  /** The time the consumer waited for the pipeline outputs */
+  double consumer_wait = 0;
+  /** The fraction of the outputs which were complete when the consumer requested them */
+  double outputs_ready = 0;
+  /** The limiting stage: "io", "cpu", "gpu" or "consumer"; empty if there are no iterations */
+  std::string bottleneck;
+  /** A one-line verdict with the supporting numbers */
+  std::string verdict;
+};
+
 class OpGraph;
 
 class DLL_PUBLIC ExecutorBase {
@@ -60,6 +133,96 @@ class DLL_PUBLIC ExecutorBase {
   DLL_PUBLIC virtual int InputFeedCount(std::string_view input_name) = 0;
   DLL_PUBLIC virtual OperatorBase *GetOperator(std::string_view name) = 0;
 
+  /**
+   * @brief Makes the GPU pipeline outputs allocated in memory which can be shared with
+   *        other processes (see ExportIPC). Must be called before Build.
+   */
+  DLL_PUBLIC virtual void EnableIPCOutputs(bool enable = true) {
+    if (enable)
+      throw std::invalid_argument("This executor doesn't support sharing outputs between "
+                                  "processes. Use the dynamic executor.");
+  }
+
+  /**
+   * @brief Makes the outputs returned without waiting on the host for the GPU work - the consumer
+   *        must wait for the outputs' access order (or ready event) instead.
+   *
+   * The CPU outputs written by the GPU (in pinned memory) are still waited for.
+   */
+  DLL_PUBLIC virtual void EnableAsyncOutputs(bool enable = true) {
+    if (enable)
+      throw std::invalid_argument("This executor doesn't support asynchronous outputs. "
+                                  "Use the dynamic executor.");
+  }
+
+  /**
+   * @brief Sets the output queue depth policy and the operator concurrency of the dynamic
+   *        executor (see exec2::QueueDepthPolicy and exec2::OperatorConcurrency).
+   *
+   * The policies are given by name: "fully_buffered", "backend_change" or "output_only" and
+   * "none", "backend" or "full", respectively; an empty name keeps the default.
+   * Must be called before Build.
+   */
+  DLL_PUBLIC virtual void SetSchedulingPolicies(std::string_view queue_policy,
+                                                std::string_view concurrency) {
+    if (!queue_policy.empty() || !concurrency.empty())
+      throw std::invalid_argument("This executor doesn't support the scheduling policies. "
+                                  "Use the dynamic executor.");
+  }
+
+  /**
+   * @brief Provides a buffer in which a GPU pipeline output of the next iteration, which doesn't
+   *        have a buffer for this output yet, is to be produced.
+   *
+   * The buffer is used if it's large enough and the output is produced by an operator
+   * (rather than passed through); otherwise, the output is allocated as usual.
+   * The output is written after the work scheduled in `order` up to this call.
+   */
+  DLL_PUBLIC virtual void SetOutputBuffer(int output_idx, void *data, size_t size,
+                                          AccessOrder order) {
+    throw std::invalid_argument("This executor doesn't support user-provided output buffers. "
+                                "Use the dynamic executor.");
+  }
+
+  /**
+   * @brief Checks, without blocking, whether the outputs of the oldest pending iteration are
+   *        complete - i.e. whether Outputs or ShareOutputs would return without waiting.
+   */
+  DLL_PUBLIC virtual bool OutputsReady() {
+    throw std::invalid_argument("This executor doesn't support polling the outputs. "
+                                "Use the dynamic executor.");
+  }
+
+  /**
+   * @brief Computes the utilization of the pipeline stages since the previous reset (or since
+   *        the executor was built) and tells which stage limits the throughput.
+   *
+   * If `reset` is true, a new window is started.
+   */
+  DLL_PUBLIC virtual ExecutorDiagnostics GetDiagnostics(bool reset = true) {
+    throw std::invalid_argument("This executor doesn't support the bottleneck diagnostics. "
+                                "Use the dynamic executor.");
+  }
+
+  /**
+   * @brief Starts (or stops) recording the execution timeline; starting discards the timeline
+   *        recorded so far.
+   */
+  DLL_PUBLIC virtual void EnableTrace(bool enable = true) {
+    if (enable)
+      throw std::invalid_argument("This executor doesn't support execution traces. "
+                                  "Use the dynamic executor.");
+  }
+
+  /**
+   * @brief Writes the timeline recorded so far to a file, in the Chrome trace (JSON) format,
+   *        which can be opened in chrome://tracing or in the Perfetto UI.
+   */
+  DLL_PUBLIC virtual void WriteTrace(const std::string &path) {
+    throw std::invalid_argument("This executor doesn't support execution traces. "
+                                "Use the dynamic executor.");
+  }
+
  protected:
   /**
    * @brief Returns true if conditionals are used in the executed graph, @see DetectConditionals().
@@ -12,15 +12,29 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
 #include <functional>
+#include <iostream>
 #include <map>
 #include <queue>
+#include <string>
+#include <string_view>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include "dali/core/cuda_stream_pool.h"
+#include "dali/core/mm/default_resources.h"
 #include "dali/pipeline/executor/executor2/exec2.h"
 #include "dali/pipeline/executor/executor2/exec_graph.h"
+#include "dali/pipeline/executor/executor2/exec_trace.h"
 #include "dali/pipeline/executor/executor2/stream_assignment.h"
+#if NVML_ENABLED
+#include "dali/util/nvml.h"
+#endif
 
 namespace dali {
 namespace exec2 {
@@ -60,6 +74,28 @@ void ApplyConcurrencyLimit(ExecGraph &graph, OperatorConcurrency concurrency) {
   }
 }
 
+QueueDepthPolicy ParseQueueDepthPolicy(std::string_view name) {
+  if (name == "fully_buffered")
+    return QueueDepthPolicy::FullyBuffered;
+  if (name == "backend_change")
+    return QueueDepthPolicy::BackendChange;
+  if (name == "output_only")
+    return QueueDepthPolicy::OutputOnly;
+  throw std::invalid_argument(make_string("Unknown queue depth policy: \"", name, "\". "
+      "Valid values are: \"fully_buffered\", \"backend_change\" and \"output_only\"."));
+}
+
+OperatorConcurrency ParseOperatorConcurrency(std::string_view name) {
+  if (name == "none")
+    return OperatorConcurrency::None;
+  if (name == "backend")
+    return OperatorConcurrency::Backend;
+  if (name == "full")
+    return OperatorConcurrency::Full;
+  throw std::invalid_argument(make_string("Unknown operator concurrency: \"", name, "\". "
+      "Valid values are: \"none\", \"backend\" and \"full\"."));
+}
+
 }  // namespace
 
 class Executor2::Impl {
@@ -104,20 +140,32 @@ class Executor2::Impl {
 
     state_ = State::Building;
     DeviceGuard dg(config_.device.value_or(CPU_ONLY_DEVICE_ID));
-    graph_.Lower(graph);
+    graph_.Lower(graph, config_.sample_major_chains);
     BuildNodeDict();
     AnalyzeGraph();
     CheckNodeTypes();
     CalculatePrefetchDepth();
     ApplyConcurrencyLimit(graph_, config_.concurrency);
+    MarkPipelineOutputs();
+    if (config_.ipc_outputs)
+      MarkIPCOutputs();
+    if (config_.adaptive_queue_depth)
+      SetupAdaptiveQueues();
+    EnableProfiling(config_.profiling);
+    if (const char *trace_file = std::getenv("DALI_EXEC_TRACE_FILE"); trace_file && *trace_file) {
+      trace_file_ = trace_file;
+      trace_.Enable(true);
+    }
     SetupStreams();
     SetupThreadPool();
+    SetupReplicas();
 
     last_iter_data_ = InitIterationData(-1);
     if (last_iter_data_->checkpoint)
       PopulateInitialCheckpoint(*last_iter_data_->checkpoint);
 
     state_ = State::Built;
+    ResetDiagnostics();
     Start();
   }
 
@@ -126,7 +174,9 @@ class Executor2::Impl {
     if (state_ != State::Running)
       throw std::runtime_error("The executor is not initialized.");
     InitIteration();
+    auto launched = std::chrono::steady_clock::now();
     pending_outputs_.push(graph_.Launch(*exec_));
+    launch_times_.push(launched);
   }
 
   void Prefetch() {
@@ -140,21 +190,69 @@ class Executor2::Impl {
     if (pending_outputs_.empty())
       throw std::out_of_range("All pending outputs were already popped.");
     DeviceGuard dg(config_.device.value_or(CPU_ONLY_DEVICE_ID));
+    auto request_time = std::chrono::steady_clock::now();
+    bool ready = OutputsReady();
+    if (output_node_) {
+      // The iterations are launched in order - the oldest pending one is at the front.
+      int64_t oldest_iter = iter_index_ - static_cast<int64_t>(pending_outputs_.size());
+      output_node_->queue_stats.Sample(oldest_iter);
+    }
     auto fut = std::move(pending_outputs_.front());
     pending_outputs_.pop();
+    auto launched = launch_times_.front();
+    launch_times_.pop();
     auto &pipe_out = fut.Value<const PipelineOutput &>();
+    if (output_node_)
+      output_node_->output_queue_limit->Release(*exec_);
     auto ws = pipe_out.workspace;
     last_iter_data_ = ws.GetIterationData();
-    if (ws.has_event())
+    if (ws.has_event() && (!config_.async_output || HasDeviceWrittenHostOutputs(ws)))
       CUDA_CALL(cudaEventSynchronize(ws.event()));
     ws.set_event(nullptr);
+    auto return_time = std::chrono::steady_clock::now();
+    if (trace_.IsEnabled() && last_iter_data_)
+      trace_.AddIteration(last_iter_data_->iteration_index, launched, return_time);
+    diag_.iterations++;
+    diag_.outputs_ready += ready;
+    diag_.consumer_wait += ToNs(return_time - request_time);
     return ws;
   }
 
+  /** Checks whether any of the CPU outputs is written by the GPU, e.g. in a GPU-to-CPU copy */
+  static bool HasDeviceWrittenHostOutputs(const Workspace &ws) {
+    for (int i = 0; i < ws.NumOutput(); i++) {
+      if (ws.OutputIsType<CPUBackend>(i) && ws.Output<CPUBackend>(i).order().is_device())
+        return true;
+    }
+    return false;
+  }
+
+  bool OutputsReady() {
+    if (pending_outputs_.empty())
+      throw std::out_of_range("There are no pending outputs.");
+    auto &fut = pending_outputs_.front();
+    if (!fut.Ready())
+      return false;
+    // The task is complete, but the GPU work it scheduled may still be running
+    auto &pipe_out = fut.Value<const PipelineOutput &>();
+    if (!pipe_out.workspace.has_event())
+      return true;
+    DeviceGuard dg(config_.device.value_or(CPU_ONLY_DEVICE_ID));
+    cudaError_t res = cudaEventQuery(pipe_out.workspace.event());
+    if (res == cudaErrorNotReady)
+      return false;
+    CUDA_CALL(res);
+    return true;
+  }
+
   void InitIteration() {
+    if (config_.adaptive_queue_depth)
+      AdjustQueueDepths();
     WorkspaceParams params{};
     params.max_batch_size = config_.max_batch_size;
     params.iter_data = InitIterationData(iter_index_++);
+    params.trace = trace_.IsEnabled() ? &trace_ : nullptr;
+    TakeOutputBuffers(*params.iter_data);
     graph_.PrepareIteration(params);
   }
 
@@ -181,6 +279,14 @@ class Executor2::Impl {
         exec_->Shutdown();
     }
     state_ = State::ShutDown;
+    if (!trace_file_.empty()) {
+      try {
+        WriteTrace(trace_file_);
+      } catch (const std::exception &e) {
+        std::cerr << "Cannot write the execution trace: " << e.what() << std::endl;
+      }
+      trace_file_.clear();
+    }
   }
 
   void RestoreFromCheckpoint(const Checkpoint &cpt) {
@@ -209,6 +315,255 @@ class Executor2::Impl {
     return config_.checkpointing;
   }
 
+  void SetOutputBuffer(int output_idx, void *data, size_t size, AccessOrder order) {
+    if (state_ != State::Running)
+      throw std::logic_error("The output buffers can be set only after the executor is built.");
+    if (output_idx < 0 || output_idx >= static_cast<int>(output_buffers_.size()))
+      throw std::out_of_range(make_string("The output index ", output_idx, " is out of range. "
+          "Valid range is [0..", output_buffers_.size(), ")."));
+    ExternalOutputBuffer buf;
+    buf.data = data;
+    buf.size = size;
+    if (order.is_device()) {
+      buf.ready = CUDASharedEvent::GetFromPool(order.device_id());
+      CUDA_CALL(cudaEventRecord(buf.ready, order.stream()));
+    }
+    output_buffers_[output_idx].push(std::move(buf));
+  }
+
+  void EnableIPCOutputs(bool enabled) {
+    if (state_ != State::New)
+      throw std::logic_error("IPC outputs must be enabled before the executor is built.");
+    config_.ipc_outputs = enabled;
+  }
+
+  void SetSchedulingPolicies(std::string_view queue_policy, std::string_view concurrency) {
+    if (state_ != State::New)
+      throw std::logic_error("The scheduling policies must be set before the executor is built.");
+    if (!queue_policy.empty())
+      config_.queue_policy = ParseQueueDepthPolicy(queue_policy);
+    if (!concurrency.empty())
+      config_.concurrency = ParseOperatorConcurrency(concurrency);
+  }
+
+  void EnableAsyncOutputs(bool enabled) {
+    config_.async_output = enabled;
+  }
+
+  void EnableProfiling(bool enabled) {
+    config_.profiling = enabled;
+    for (auto &n : graph_.Nodes())
+      n.profile.enabled = enabled;
+  }
+
+  void EnableTrace(bool enabled) {
+    trace_.Enable(enabled);
+  }
+
+  void WriteTrace(const std::string &path) {
+    DeviceGuard dg(config_.device.value_or(CPU_ONLY_DEVICE_ID));
+    std::ofstream f(path);
+    if (!f)
+      throw std::runtime_error(make_string("Cannot open the trace file \"", path, "\"."));
+    trace_.Write(f);
+    if (!f)
+      throw std::runtime_error(make_string("Error writing the trace file \"", path, "\"."));
+  }
+
+  ExecutorDiagnostics GetDiagnostics(bool reset) {
+    ExecutorDiagnostics d;
+    auto now = std::chrono::steady_clock::now();
+    double window = ToNs(now - diag_.start);
+    d.window_time = window * 1e-3;
+    d.iterations = diag_.iterations;
+    if (window > 0 && d.iterations > 0) {
+      int64_t cpu_busy = 0, max_loader_wait = 0;
+      bool has_gpu = false, gpu_measured = false;
+      std::map<cudaStream_t, double> stream_busy;
+      for (auto &n : graph_.Nodes()) {
+        if (!n.op)
+          continue;
+        NodeCounters c = GetCounters(n);
+        const NodeCounters &c0 = diag_.nodes[&n];
+        int64_t loader_wait = c.loader_wait - c0.loader_wait;
+        max_loader_wait = std::max(max_loader_wait, loader_wait);
+        if (n.backend == OpType::CPU) {
+          // the reader waits for the loader in its Setup
+          cpu_busy += std::max<int64_t>(c.busy - c0.busy - loader_wait, 0);
+        } else {
+          has_gpu = true;
+          // The GPU time is not measured while the previous measurement is pending;
+          // it's extrapolated to all iterations.
+          int64_t gpu_iters = c.gpu_iterations - c0.gpu_iterations;
+          if (gpu_iters > 0) {
+            gpu_measured = true;
+            stream_busy[n.env.order.stream()] +=
+                static_cast<double>(c.gpu_time - c0.gpu_time) / gpu_iters *
+                (c.iterations - c0.iterations);
+          }
+        }
+      }
+      d.loader_wait = max_loader_wait / window;
+      d.cpu_busy = cpu_busy / window;
+      if (tp_)
+        d.thread_pool_busy = (tp_->GetBusyTime() - diag_.thread_pool_busy) /
+                             (window * tp_->NumThreads());
+      if (!has_gpu) {
+        d.gpu_busy = 0;
+      } else if (gpu_measured) {
+        d.gpu_busy = 0;
+        for (auto &[stream, busy] : stream_busy)
+          d.gpu_busy = std::max(d.gpu_busy, busy / window);
+      }
+      d.consumer_wait = diag_.consumer_wait / window;
+      d.outputs_ready = static_cast<double>(diag_.outputs_ready) / d.iterations;
+    }
+    std::tie(d.bottleneck, d.verdict) = Verdict(d);
+    if (reset)
+      ResetDiagnostics();
+    return d;
+  }
+
+  ExecutorMetaMap GetExecutorMeta() const {
+    ExecutorMetaMap meta;
+    for (auto &node : graph_.Nodes()) {
+      if (node.is_pipeline_output)
+        continue;
+      auto &stats = node.queue_stats;
+      bool adaptive = stats.depth > 0;
+      if (!adaptive && node.profile.iterations == 0)
+        continue;
+      const QueueStage *stage = nullptr;
+      if (adaptive)
+        stage = &queue_stages_[node.backend == OpType::CPU ? 0 : 1];
+      auto sizes = stats.OutputSizes();
+      // an operator without outputs still needs an entry for its profile
+      auto &entries = meta[node.instance_name];
+      entries.resize(std::max<size_t>(sizes.size(), 1), ExecutorMeta{});
+      for (size_t i = 0; i < sizes.size(); i++) {
+        auto &m = entries[i];
+        m.real_size = sizes[i].size;
+        m.max_real_size = sizes[i].size;
+        m.reserved = sizes[i].capacity * (stage ? stage->depth : 1);
+        m.max_reserved = sizes[i].capacity * (stage ? stage->max_depth : 1);
+      }
+      for (size_t i = 0; i < entries.size() && i < node.outputs.size(); i++)
+        entries[i].pinned = node.outputs[i].pinned;
+      ExecutorOpProfile profile = GetProfile(node);
+      ExecutorOpMemory memory = GetMemory(node);
+      auto diagnostics = node.op ? node.op->GetDiagnostics<int64_t>()
+                                 : std::map<std::string, int64_t>{};
+      if (stage) {
+        memory.queue_slots = stage->depth;
+        memory.max_queue_slots = stage->max_depth;
+      }
+      for (auto &m : entries) {
+        if (adaptive) {
+          m.queue_depth = stats.depth;
+          m.queue_stalls = stats.stalls;
+          m.queue_idle = stats.idle;
+        }
+        m.profile = profile;
+        m.memory = memory;
+        m.diagnostics = diagnostics;
+      }
+    }
+    return meta;
+  }
+
+  /** The cumulative counters of a node, used for computing the utilization in a window. */
+  struct NodeCounters {
+    int64_t busy = 0, loader_wait = 0;
+    int64_t iterations = 0, gpu_time = 0, gpu_iterations = 0;
+  };
+
+  static NodeCounters GetCounters(const ExecNode &n) {
+    NodeCounters c;
+    c.busy = n.busy_time;
+    if (n.op) {
+      ReaderMeta meta = n.op->GetReaderMeta();
+      if (meta)
+        c.loader_wait = static_cast<int64_t>(meta.loader_wait_time * 1e+3);
+    }
+    c.iterations = n.profile.iterations;
+    c.gpu_time = n.profile.gpu_time;
+    c.gpu_iterations = n.profile.gpu_iterations;
+    return c;
+  }
+
+  void ResetDiagnostics() {
+    diag_ = {};
+    for (auto &n : graph_.Nodes())
+      diag_.nodes[&n] = GetCounters(n);
+    if (tp_)
+      diag_.thread_pool_busy = tp_->GetBusyTime();
+  }
+
+  static std::string Percent(double fraction) {
+    return std::to_string(std::lround(fraction * 100)) + "%";
+  }
+
+  static std::pair<std::string, std::string> Verdict(const ExecutorDiagnostics &d) {
+    if (d.iterations == 0)
+      return { "", "No outputs were returned in the window." };
+    std::string gpu = d.gpu_busy < 0 ? "unknown" : Percent(d.gpu_busy);
+    std::string numbers = make_string(
+        "loader wait ", Percent(d.loader_wait),
+        ", CPU operators ", Percent(d.cpu_busy),
+        ", thread pool ", Percent(d.thread_pool_busy),
+        ", GPU ", gpu,
+        ", consumer waiting ", Percent(d.consumer_wait),
+        ", outputs ready on request ", Percent(d.outputs_ready));
+    // The consumer doesn't wait - the output queue is full when the next batch is requested.
+    if (d.consumer_wait < 0.1) {
+      return { "consumer", make_string(
+          "Consumer-bound: the outputs are ready before they're requested (", numbers, ")") };
+    }
+    if (d.loader_wait >= d.cpu_busy && d.loader_wait >= d.gpu_busy && d.loader_wait > 0.1) {
+      return { "io", make_string(
+          "I/O-bound: the readers wait for the data to be loaded (", numbers, ")") };
+    }
+    if (d.gpu_busy < 0 && d.cpu_busy < 0.5) {
+      return { "gpu", make_string(
+          "Probably GPU-bound: the CPU stage is not saturated, enable the executor statistics "
+          "to measure the GPU time (", numbers, ")") };
+    }
+    if (d.cpu_busy >= d.gpu_busy) {
+      return { "cpu", make_string(
+          "CPU-bound: the CPU operators run most of the time (", numbers, ")") };
+    }
+    return { "gpu", make_string(
+        "GPU-bound: the GPU operators keep the stream busy most of the time (", numbers, ")") };
+  }
+
+  static double ToNs(std::chrono::steady_clock::duration d) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+  }
+
+  static ExecutorOpMemory GetMemory(const ExecNode &node) {
+    ExecutorOpMemory ret;
+    for (int tag = 0; tag < static_cast<int>(mm::MemoryTag::Count); tag++) {
+      for (int kind = 0; kind < mm::memory_kind_id::count; kind++)
+        ret.usage[tag][kind] = node.memory_tracker->Get(static_cast<mm::MemoryTag>(tag),
+                                                        static_cast<mm::memory_kind_id>(kind));
+    }
+    for (auto &size : node.queue_stats.OutputSizes())
+      ret.queue_slot_size += size.capacity;
+    return ret;
+  }
+
+  static ExecutorOpProfile GetProfile(const ExecNode &node) {
+    auto &prof = node.profile;
+    ExecutorOpProfile ret;
+    ret.iterations = prof.iterations;
+    ret.cpu_time = prof.cpu_time * 1e-3;
+    ret.gpu_time = prof.gpu_time * 1e-3;
+    ret.wait_time = prof.wait_time * 1e-3;
+    ret.input_bytes = prof.input_bytes;
+    ret.output_bytes = prof.output_bytes;
+    return ret;
+  }
+
  private:
   State state_ = State::New;
 
@@ -221,12 +576,26 @@ class Executor2::Impl {
     return iter_data;
   }
 
+  /** Assigns the oldest pending user-provided output buffers to an iteration. */
+  void TakeOutputBuffers(IterationData &iter_data) {
+    for (size_t i = 0; i < output_buffers_.size(); i++) {
+      auto &q = output_buffers_[i];
+      if (q.empty())
+        continue;
+      iter_data.output_buffers.resize(output_buffers_.size());
+      iter_data.output_buffers[i] = std::move(q.front());
+      q.pop();
+    }
+  }
+
   std::shared_ptr<Checkpoint> CreateCheckpoint(int64_t iteration_index) {
     auto cpt = std::make_shared<Checkpoint>();
     cpt->SetIterationId(iter_index_ + 1);
     for (auto &n : graph_.Nodes()) {
       if (!n.instance_name.empty())
         cpt->AddOperator(n.instance_name);
+      for (auto &name : n.fused_names)
+        cpt->AddOperator(name);
     }
     return cpt;
   }
@@ -239,15 +608,60 @@ class Executor2::Impl {
   }
 
   void BuildNodeDict() {
-    for (auto &n : graph_.Nodes())
+    for (auto &n : graph_.Nodes()) {
       if (!n.instance_name.empty())
         node_map_[n.instance_name] = &n;
+      for (auto &name : n.fused_names)
+        node_map_[name] = &n;
+    }
   }
 
   void AnalyzeGraph() {
     CountNodes();
   }
 
+  /** Tells the producers of the GPU pipeline outputs which outputs they produce.
+   *
+   * This is where the user-provided output buffers are used (see SetOutputBuffer).
+   */
+  void MarkPipelineOutputs() {
+    for (auto &n : graph_.Nodes()) {
+      if (n.is_pipeline_output)
+        output_buffers_.resize(n.inputs.size());
+      for (auto &out : n.outputs) {
+        if (out.device != StorageDevice::GPU)
+          continue;
+        for (auto *e : out.consumers) {
+          if (e->consumer->is_pipeline_output) {
+            out.pipeline_output_idx = e->consumer_input_idx;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  /** Makes the producers of the GPU pipeline outputs allocate them in IPC-exportable memory.
+   *
+   * The in-place execution is disabled for such outputs, since the input buffer would be
+   * allocated in regular memory.
+   */
+  void MarkIPCOutputs() {
+    for (auto &n : graph_.Nodes()) {
+      for (auto &out : n.outputs) {
+        if (out.device != StorageDevice::GPU)
+          continue;
+        for (auto *e : out.consumers) {
+          if (e->consumer->is_pipeline_output) {
+            out.ipc = true;
+            out.in_place_input = -1;
+            break;
+          }
+        }
+      }
+    }
+  }
+
   void CountNodes() {
     for (auto &n : graph_.Nodes()) {
       switch (NodeType(&n)) {
@@ -310,13 +724,42 @@ class Executor2::Impl {
     }
   }
 
+  void SetupReplicas() {
+    if (config_.operator_replicas <= 1)
+      return;
+    for (auto &n : graph_.Nodes()) {
+      if (n.backend != OpType::CPU || !n.op || n.is_batch_size_provider ||
+          !n.op->GetSpec().GetSchemaOrDefault().IsStateless())
+        continue;
+      for (int i = 1; i < config_.operator_replicas; i++) {
+        auto replica = std::make_unique<ExecNode::Replica>();
+        {
+          mm::MemoryTagScope memory_scope(n.memory_tracker, mm::MemoryTag::Other);
+          replica->op = InstantiateOperator(n.op->GetSpec());
+        }
+        replica->thread_pool = std::make_unique<ThreadPool>(
+          config_.thread_pool_threads,
+          config_.device.value_or(CPU_ONLY_DEVICE_ID),
+          config_.set_affinity,
+          "Executorv_v2 replica");
+        n.replicas.push_back(std::move(replica));
+      }
+    }
+  }
+
   void Start() {
     if (state_ != State::Built)
       throw std::logic_error("Incorrect state transition.");
     exec_ = std::make_unique<tasking::Executor>(config_.operator_threads);
     exec_->Start([this](){
-      if (config_.device)
+      if (config_.device) {
         CUDA_CALL(cudaSetDevice(*config_.device));
+#if NVML_ENABLED
+        // the operator threads are pinned like the ones in the thread pool
+        if (config_.set_affinity)
+          nvml::SetDeviceLocalAffinity(*config_.device);
+#endif
+      }
     });
     state_ = State::Running;
   }
@@ -332,7 +775,145 @@ class Executor2::Impl {
     case StreamPolicy::PerOperator:
       SetupStreamsImpl<StreamPolicy::PerOperator>();
       break;
+    case StreamPolicy::PerIteration:
+      SetupCycledStreams();
+      break;
+    }
+  }
+
+  void SetupCycledStreams() {
+    StreamAssignment<StreamPolicy::PerIteration> assignment(graph_, config_.gpu_queue_depth);
+    int num_streams = assignment.NumStreams();
+    if (num_streams == 0)
+      return;
+    for (int i = 0; i < num_streams; i++)
+      streams_.push_back(CUDAStreamPool::instance().Get(-1, config_.stream_priority));
+    for (auto &node : graph_.Nodes()) {
+      auto stream_idx = assignment[&node];
+      node.env.order = stream_idx.has_value()
+                     ? AccessOrder(streams_[*stream_idx].get())
+                     : AccessOrder::host();
+      node.iteration_orders.clear();
+      if (!stream_idx.has_value() || !CanCycleStreams(&node))
+        continue;
+      for (int i = 0; i < assignment.NumSets(); i++)
+        node.iteration_orders.push_back(AccessOrder(streams_[*assignment(&node, i)].get()));
+    }
+  }
+
+  /** The operators of one backend (CPU or GPU and mixed), sharing the output queue depth. */
+  struct QueueStage {
+    std::vector<ExecNode *> nodes;
+    int min_depth = 1;
+    int depth = 1;
+    int max_depth = 1;  // the maximum depth reached so far
+    // the totals of the node statistics at the last adjustment
+    int64_t samples = 0, stalls = 0, idle = 0;
+  };
+
+  /** The number of consumer checks between the adjustments of a queue. */
+  static constexpr int kQueueSampleWindow = 16;
+
+  void SetupAdaptiveQueues() {
+    if (config_.max_queue_depth < 1)
+      throw std::invalid_argument(make_string(
+          "The maximum queue depth must be positive. Got: ", config_.max_queue_depth));
+    bool has_gpu = graph_info_.num_gpu + graph_info_.num_mixed > 0;
+    for (auto &node : graph_.Nodes()) {
+      if (node.is_pipeline_output) {
+        // The pipeline outputs are queued in the last stage.
+        output_node_ = &node;
+        queue_stages_[has_gpu ? 1 : 0].nodes.push_back(&node);
+      } else {
+        bool cpu = node.backend == OpType::CPU;
+        queue_stages_[cpu ? 0 : 1].nodes.push_back(&node);
+      }
+    }
+    int depths[2] = { config_.cpu_queue_depth, config_.gpu_queue_depth };
+    for (int s = 0; s < 2; s++) {
+      auto &stage = queue_stages_[s];
+      stage.min_depth = std::clamp(depths[s], 1, config_.max_queue_depth);
+      stage.depth = stage.max_depth = stage.min_depth;
+      for (auto *node : stage.nodes) {
+        node->output_queue_limit = std::make_shared<tasking::Semaphore>(
+            config_.max_queue_depth, stage.depth);
+        node->queue_stats.depth = stage.depth;
+      }
+    }
+    // The iterations must be launched ahead of time, so the queues can actually grow.
+    prefetch_depth_ = std::max(prefetch_depth_, config_.max_queue_depth);
+    graph_.Invalidate();
+  }
+
+  /** The total size of the buffers needed for one more slot in the stage's queue. */
+  static size_t SlotSize(const QueueStage &stage) {
+    size_t size = 0;
+    for (auto *node : stage.nodes)
+      for (auto &out : node->queue_stats.OutputSizes())
+        size += out.capacity;
+    return size;
+  }
+
+  bool FitsInMemoryBudget(const QueueStage &grown) const {
+    if (config_.queue_memory_budget == 0)
+      return true;
+    size_t total = SlotSize(grown);
+    for (auto &stage : queue_stages_)
+      total += SlotSize(stage) * stage.depth;
+    return total <= config_.queue_memory_budget;
+  }
+
+  /** Tells whether the memory pools used by the pipeline are close to their budgets. */
+  bool UnderMemoryPressure() const {
+    if (config_.device.has_value() && mm::IsDeviceMemoryUnderPressure(*config_.device))
+      return true;
+    return mm::IsPinnedMemoryUnderPressure();
+  }
+
+  void AdjustQueueDepths() {
+    bool pressure = UnderMemoryPressure();
+    for (auto &stage : queue_stages_) {
+      int64_t samples = 0, stalls = 0, idle = 0;
+      for (auto *node : stage.nodes) {
+        samples += node->queue_stats.samples;
+        stalls += node->queue_stats.stalls;
+        idle += node->queue_stats.idle;
+      }
+      int64_t window = samples - stage.samples;
+      if (window < kQueueSampleWindow)
+        continue;
+      bool stalled = (stalls - stage.stalls) * 2 > window;
+      bool idling = (idle - stage.idle) * 10 > window * 9;
+      stage.samples = samples;
+      stage.stalls = stalls;
+      stage.idle = idle;
+      if (pressure) {
+        // Close to the memory budget - give up prefetching, down to a single buffer
+        if (stage.depth > 1)
+          SetQueueDepth(stage, stage.depth - 1);
+        continue;
+      }
+      if (stalled && stage.depth < config_.max_queue_depth && FitsInMemoryBudget(stage))
+        SetQueueDepth(stage, stage.depth + 1);
+      else if (idling && stage.depth > stage.min_depth)
+        SetQueueDepth(stage, stage.depth - 1);
+    }
+  }
+
+  void SetQueueDepth(QueueStage &stage, int depth) {
+    for (auto *node : stage.nodes) {
+      if (depth > stage.depth) {
+        node->output_queue_limit->Release(*exec_);
+      } else {
+        // A task that acquires the semaphore and never releases it, shrinking the queue.
+        auto take_slot = tasking::Task::Create([]() {});
+        take_slot->Succeed(node->output_queue_limit);
+        exec_->AddSilentTask(std::move(take_slot));
+      }
+      node->queue_stats.depth = depth;
     }
+    stage.depth = depth;
+    stage.max_depth = std::max(stage.max_depth, depth);
   }
 
   template <StreamPolicy policy>
@@ -342,7 +923,7 @@ class Executor2::Impl {
     if (num_streams == 0)
       return;
     for (int i = 0; i < num_streams; i++)
-      streams_.push_back(CUDAStreamPool::instance().Get());
+      streams_.push_back(CUDAStreamPool::instance().Get(-1, config_.stream_priority));
     for (auto &node : graph_.Nodes()) {
       auto stream_idx = assignment[&node];
 
@@ -370,14 +951,35 @@ class Executor2::Impl {
 
   // Runtime environment
 
+  /** Must outlive graph_ and exec_ - the tasks record their spans in it. */
+  ExecTrace trace_;
+  /** The file to which the trace is written at shutdown (see DALI_EXEC_TRACE_FILE) */
+  std::string trace_file_;
+
   std::unique_ptr<ThreadPool> tp_;
   std::queue<tasking::TaskFuture> pending_outputs_;
+  /** The launch times of the pending iterations */
+  std::queue<std::chrono::steady_clock::time_point> launch_times_;
   std::vector<CUDAStreamLease> streams_;
   std::map<std::string, ExecNode *, std::less<>> node_map_;
+  QueueStage queue_stages_[2];  // CPU, GPU
+  ExecNode *output_node_ = nullptr;
+  /** The user-provided output buffers for the next iterations, per pipeline output */
+  std::vector<std::queue<ExternalOutputBuffer>> output_buffers_;
 
   ExecGraph graph_;
   std::unique_ptr<tasking::Executor> exec_;
 
+  /** The diagnostics collected since the start of the window */
+  struct DiagnosticsWindow {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    int64_t iterations = 0;
+    int64_t outputs_ready = 0;
+    double consumer_wait = 0;  // ns
+    int64_t thread_pool_busy = 0;
+    std::unordered_map<const ExecNode *, NodeCounters> nodes;
+  } diag_;
+
   // dynamic data
 
   int64_t iter_index_ = 0;
@@ -425,17 +1027,52 @@ void Executor2::ReleaseOutputs() {
   // no-op
 }
 
+bool Executor2::OutputsReady() {
+  return impl_->OutputsReady();
+}
+
 void Executor2::EnableMemoryStats(bool enable_memory_stats) {
-  // no-op
+  // Executor2 doesn't keep the memory statistics - the operator profile is collected instead.
+  impl_->EnableProfiling(enable_memory_stats);
+}
+
+void Executor2::EnableTrace(bool enable) {
+  impl_->EnableTrace(enable);
+}
+
+void Executor2::WriteTrace(const std::string &path) {
+  impl_->WriteTrace(path);
 }
 
 void Executor2::EnableCheckpointing(bool checkpointing) {
   impl_->EnableCheckpointing(checkpointing);
 }
 
+void Executor2::EnableIPCOutputs(bool enable) {
+  impl_->EnableIPCOutputs(enable);
+}
+
+void Executor2::SetSchedulingPolicies(std::string_view queue_policy,
+                                      std::string_view concurrency) {
+  impl_->SetSchedulingPolicies(queue_policy, concurrency);
+}
+
+void Executor2::EnableAsyncOutputs(bool enable) {
+  impl_->EnableAsyncOutputs(enable);
+}
+
+void Executor2::SetOutputBuffer(int output_idx, void *data, size_t size, AccessOrder order) {
+  impl_->SetOutputBuffer(output_idx, data, size, order);
+}
+
 ExecutorMetaMap Executor2::GetExecutorMeta() {
-  // not supported - the "meta" thing assumed persistence of allocations
-  return {};
+  // The memory statistics are not supported - they assumed persistence of allocations.
+  // Only the operators with adaptive output queues are reported.
+  return impl_->GetExecutorMeta();
+}
+
+ExecutorDiagnostics Executor2::GetDiagnostics(bool reset) {
+  return impl_->GetDiagnostics(reset);
 }
 
 void Executor2::Shutdown() {
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include "dali/pipeline/graph/op_graph2.h"
 #include "dali/pipeline/workspace/workspace.h"
@@ -58,10 +59,8 @@ enum class OperatorConcurrency : int {
 enum class StreamPolicy : int {
   Single,       //< There's just one stream that's used by all operators
   PerBackend,   //< Operators are scheduled on a stream specific to their backend (mixed or GPU)
-  PerOperator   //< Independent operators are executed on separate streams.
-
-  // TODO(michalz): Check if this is legal with existing operator implementations - likely not
-  // PerIteration, //< Streams are cycled on a per-iteration basis
+  PerOperator,  //< Independent operators are executed on separate streams.
+  PerIteration  //< As PerBackend, but the stream-safe operators cycle the streams every iteration
 };
 
 class DLL_PUBLIC Executor2 : public ExecutorBase {
@@ -78,20 +77,67 @@ class DLL_PUBLIC Executor2 : public ExecutorBase {
     int thread_pool_threads = 0;
     /** Whether the thread pool should set thread affinity with NVML */
     bool set_affinity = false;
+    /** The priority of the CUDA streams used by the executor; see cudaStreamCreateWithPriority */
+    int stream_priority = 0;
+    /** The number of instances of each stateless CPU operator
+     *
+     * The operators whose schema is marked as Stateless get additional instances, each with its
+     * own thread pool of `thread_pool_threads` threads. The instances run consecutive iterations
+     * in turns, so up to this many iterations of such an operator can run concurrently - this
+     * requires a CPU queue depth of at least this value.
+     */
+    int operator_replicas = 1;
+    /** If true, the chains of CPU operators which support it run sample by sample
+     *
+     * All operators of a chain are applied to a sample in one task of the thread pool, so the
+     * intermediate results stay in the cache (see SampleMajorChain). Only the operators which
+     * implement the per-sample API and declare it with OperatorBase::CanRunPerSample are chained.
+     */
+    bool sample_major_chains = false;
     /** The number of pending results CPU operators produce */
     int cpu_queue_depth = 2;
     /** The number of pending results GPU (and mixed) operators produce */
     int gpu_queue_depth = 2;
+    /** If true, the queue depths are adjusted at run time
+     *
+     * The queues of the CPU and the GPU (and mixed) stages start with cpu_queue_depth and
+     * gpu_queue_depth, respectively, and never get shallower than that. A stage's queue grows
+     * (up to max_queue_depth) when its consumers repeatedly wait for it and shrinks back when
+     * its buffers sit idle.
+     * When the memory pools approach their budgets (see mm::SetDeviceMemoryBudget), the queues
+     * shrink, down to a single buffer.
+     */
+    bool adaptive_queue_depth = false;
+    /** The maximum depth of an adaptive queue */
+    int max_queue_depth = 4;
+    /** The maximum total size, in bytes, of the outputs buffered in adaptive queues.
+     *
+     * A queue doesn't grow if it would exceed this budget. 0 means no limit.
+     */
+    size_t queue_memory_budget = 0;
     /** Maximum batch size */
     int max_batch_size = 1;
     /** If true, checkpoints are generated */
     bool checkpointing = false;
     /** If true, pipeline outputs are returned on a stream (no sync with host) */
     bool async_output = false;
+    /** If true, per-operator timings and data sizes are collected (see GetExecutorMeta) */
+    bool profiling = false;
+    /** If true, the GPU pipeline outputs are allocated in memory which can be shared with
+     * other processes (see ExportIPC) */
+    bool ipc_outputs = false;
 
     QueueDepthPolicy queue_policy = QueueDepthPolicy::Legacy;
     OperatorConcurrency concurrency = OperatorConcurrency::Backend;
     StreamPolicy stream_policy = StreamPolicy::PerBackend;
+
+    // TODO(michalz): CUDA graph capture and replay of the GPU operators.
+    // It's not possible with the current operator contract: operators stage their per-iteration
+    // parameters (sample descriptors, pointers) in a DynamicScratchpad, whose host, pinned and
+    // device memory is returned to the pool when Run completes. A replayed graph would read
+    // and write released memory. The parameters would also have to be updated in the graph
+    // nodes, which only the operator knows how to do. It requires an opt-in operator API
+    // (persistent, per-graph scratch memory and a parameter update hook).
   };
 
   explicit Executor2(const Config &config);
@@ -112,7 +158,16 @@ class DLL_PUBLIC Executor2 : public ExecutorBase {
   void ReleaseOutputs() override;
   void EnableMemoryStats(bool enable_memory_stats = false) override;
   void EnableCheckpointing(bool checkpointing = false) override;
+  void EnableIPCOutputs(bool enable = true) override;
+  void EnableAsyncOutputs(bool enable = true) override;
+  void SetSchedulingPolicies(std::string_view queue_policy,
+                             std::string_view concurrency) override;
+  void SetOutputBuffer(int output_idx, void *data, size_t size, AccessOrder order) override;
+  bool OutputsReady() override;
+  void EnableTrace(bool enable = true) override;
+  void WriteTrace(const std::string &path) override;
   ExecutorMetaMap GetExecutorMeta() override;
+  ExecutorDiagnostics GetDiagnostics(bool reset = true) override;
   void Shutdown() override;
   Checkpoint& GetCurrentCheckpoint() override;
   void RestoreStateFromCheckpoint(const Checkpoint &cpt) override;
@@ -25,12 +25,22 @@ DALI_SCHEMA(Exec2TestOp)  // DALI_SCHEMA can't take a macro :(
   .NumInput(0, 99)
   .NumOutput(1)
   .AddOptionalArg("delay", "[CPU-only] in milliseconds, to wait inside the operator's Run", 1.0f)
-  .AddArg("addend", "a value added to the sum of inputs", DALI_INT32, true);
+  .AddArg("addend", "a value added to the sum of inputs", DALI_INT32, true)
+  .StreamSafe()
+  .Stateless();
 
 // DALI_REGISTER_OPERATOR can't take a macro for the name
 DALI_REGISTER_OPERATOR(Exec2TestOp, exec2::test::DummyOpCPU, CPU);
 DALI_REGISTER_OPERATOR(Exec2TestOp, exec2::test::DummyOpGPU, GPU);
 
+DALI_SCHEMA(Exec2InPlaceTestOp)
+  .NumInput(1, 99)
+  .NumOutput(1)
+  .AddParent("Exec2TestOp")
+  .InPlace(0, 0);
+
+DALI_REGISTER_OPERATOR(Exec2InPlaceTestOp, exec2::test::DummyOpCPU, CPU);
+
 DALI_SCHEMA(Exec2Counter)
   .NumInput(0)
   .NumOutput(1);
@@ -44,6 +54,13 @@ DALI_SCHEMA(Exec2Sink)
 
 DALI_REGISTER_OPERATOR(Exec2Sink, exec2::test::SinkOp, CPU);
 
+DALI_SCHEMA(Exec2PerSample)
+  .NumInput(1)
+  .NumOutput(1)
+  .Stateless();
+
+DALI_REGISTER_OPERATOR(Exec2PerSample, exec2::test::PerSampleOp, CPU);
+
 namespace exec2 {
 namespace test {
 
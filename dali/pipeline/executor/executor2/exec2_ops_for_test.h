@@ -30,6 +30,8 @@ namespace exec2 {
 namespace test {
 
 constexpr char kTestOpName[] = "Exec2TestOp";
+/** The same as kTestOpName, but the output can reuse the buffer of the first input. */
+constexpr char kInPlaceTestOpName[] = "Exec2InPlaceTestOp";
 
 /** A dummy operator that takes a bunch of scalar inputs and returns their sum.
  *
@@ -173,6 +175,38 @@ class SinkOp : public Operator<CPUBackend> {
   int64_t acc = 0;
 };
 
+constexpr char kPerSampleOpName[] = "Exec2PerSample";
+
+/** A stateless operator with a per-sample implementation, which can run in a SampleMajorChain.
+ *
+ * The output is the doubled input plus the sample index.
+ */
+class PerSampleOp : public Operator<CPUBackend> {
+ public:
+  explicit PerSampleOp(const OpSpec &spec) : Operator<CPUBackend>(spec) {
+  }
+
+  bool CanRunPerSample() const override {
+    return true;
+  }
+
+  bool HasContiguousOutputs() const override {
+    return false;
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &outs, const Workspace &ws) override {
+    return false;
+  }
+
+  void RunImpl(SampleWorkspace &ws) override {
+    auto &out = ws.Output<CPUBackend>(0);
+    out.Resize(TensorShape<>{}, DALI_INT32);
+    *out.mutable_data<int>() = 2 * *ws.Input<CPUBackend>(0).data<int>() + ws.data_idx();
+  }
+
+  using Operator<CPUBackend>::RunImpl;
+};
+
 }  // namespace test
 }  // namespace exec2
 }  // namespace dali
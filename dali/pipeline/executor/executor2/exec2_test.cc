@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include "dali/pipeline/executor/executor2/exec2_test.h"
+#include <thread>
 #include "dali/pipeline/executor/executor2/exec2.h"
+#include "dali/pipeline/executor/executor2/sample_major_chain.h"
 
 namespace std {
 template <typename T>
@@ -36,6 +38,7 @@ inline std::ostream &operator<<(std::ostream &os, StreamPolicy value) {
     PRINT_ENUM_VALUE(Single);
     PRINT_ENUM_VALUE(PerBackend);
     PRINT_ENUM_VALUE(PerOperator);
+    PRINT_ENUM_VALUE(PerIteration);
     default:
       os << static_cast<std::underlying_type_t<decltype(value)>>(value);
   }
@@ -75,6 +78,9 @@ inline std::ostream &operator<<(std::ostream &os, const Executor2::Config &cfg)
     PRINT_CONFIG_FIELD(stream_policy),
     PRINT_CONFIG_FIELD(cpu_queue_depth),
     PRINT_CONFIG_FIELD(gpu_queue_depth),
+    PRINT_CONFIG_FIELD(adaptive_queue_depth),
+    PRINT_CONFIG_FIELD(operator_replicas),
+    PRINT_CONFIG_FIELD(sample_major_chains),
     PRINT_CONFIG_FIELD(set_affinity));
   return os;
 }
@@ -147,6 +153,120 @@ TEST_P(Exec2Test, Graph3_SinkOnly) {
 }
 
 
+TEST_P(Exec2Test, SampleMajorChain) {
+  for (bool sample_major : { false, true }) {
+    config_.sample_major_chains = sample_major;
+    Executor2 exec(config_);
+    graph::OpGraph graph = GetSampleMajorTestGraph();
+    exec.Build(graph);
+    auto *chain = dynamic_cast<SampleMajorChain *>(exec.GetOperator("op3"));
+    if (sample_major) {
+      ASSERT_NE(chain, nullptr);
+      EXPECT_EQ(chain->NumOperators(), 3);
+      EXPECT_EQ(exec.GetOperator("op1"), chain);
+      EXPECT_EQ(exec.GetOperator("op2"), chain);
+      EXPECT_NE(dynamic_cast<DummyOpCPU *>(exec.GetOperator("op0")), nullptr);
+    } else {
+      EXPECT_EQ(chain, nullptr);
+    }
+    for (int i = 0; i < 5; i++) {
+      exec.Run();
+    }
+    Workspace ws;
+    for (int i = 0; i < 5; i++) {
+      ws.Clear();
+      exec.Outputs(&ws);
+      CheckSampleMajorTestResults(ws, config_.max_batch_size);
+    }
+  }
+}
+
+TEST_P(Exec2Test, OutputsReady) {
+  Executor2 exec(config_);
+  graph::OpGraph graph = GetTestGraph2();
+  exec.Build(graph);
+  EXPECT_THROW(exec.OutputsReady(), std::out_of_range);
+  for (int i = 0; i < 3; i++) {
+    exec.Run();
+  }
+  Workspace ws;
+  for (int i = 0; i < 3; i++) {
+    while (!exec.OutputsReady())
+      std::this_thread::yield();
+    ws.Clear();
+    exec.Outputs(&ws);
+    CheckTestGraph2Results(ws, config_.max_batch_size);
+  }
+  EXPECT_THROW(exec.OutputsReady(), std::out_of_range);
+}
+
+TEST_P(Exec2Test, AsyncOutputs) {
+  Executor2 exec(config_);
+  graph::OpGraph graph = GetTestGraph2();
+  exec.Build(graph);
+  exec.EnableAsyncOutputs();
+  for (int i = 0; i < 3; i++) {
+    exec.Run();
+  }
+  Workspace ws;
+  for (int i = 0; i < 3; i++) {
+    ws.Clear();
+    exec.Outputs(&ws);
+    for (int o = 0; o < ws.NumOutput(); o++) {
+      auto &ready = ws.Output<GPUBackend>(o).ready_event();
+      ASSERT_TRUE(ready);
+      AccessOrder::host().wait(ready);
+    }
+    CheckTestGraph2Results(ws, config_.max_batch_size);
+  }
+}
+
+TEST_P(Exec2Test, AdaptiveQueueStats) {
+  if (!config_.adaptive_queue_depth)
+    GTEST_SKIP() << "The queue depth is not adaptive";
+  Executor2 exec(config_);
+  graph::OpGraph graph = GetTestGraph2();
+  exec.Build(graph);
+  exec.Prefetch();
+  Workspace ws;
+  for (int i = 0; i < 100; i++) {
+    ws.Clear();
+    exec.Outputs(&ws);
+    CheckTestGraph2Results(ws, config_.max_batch_size);
+    exec.Run();
+  }
+  auto meta = exec.GetExecutorMeta();
+  EXPECT_FALSE(meta.empty());
+  for (auto &[name, outputs] : meta) {
+    ASSERT_FALSE(outputs.empty()) << name;
+    for (auto &out : outputs) {
+      EXPECT_GE(out.queue_depth, config_.cpu_queue_depth) << name;
+      EXPECT_LE(out.queue_depth, config_.max_queue_depth) << name;
+    }
+  }
+}
+
+TEST_P(Exec2Test, PinnedOutputs) {
+  auto config = config_;
+  config.profiling = true;
+  for (bool gpu : { false, true }) {
+    Executor2 exec(config);
+    graph::OpGraph graph = gpu ? GetTestGraph2() : GetTestGraph1();
+    exec.Build(graph);
+    exec.Run();
+    Workspace ws;
+    exec.Outputs(&ws);
+    auto meta = exec.GetExecutorMeta();
+    for (const char *name : { "op0", "op1", "op2", "op3" }) {
+      ASSERT_EQ(meta[name].size(), 1u) << name;
+      // The CPU outputs are pinned only if they are consumed by the mixed operators;
+      // op3 is either a GPU operator or a CPU one, consumed only by the pipeline output.
+      bool expect_pinned = gpu && name != std::string_view("op3");
+      EXPECT_EQ(meta[name][0].pinned, expect_pinned) << name;
+    }
+  }
+}
+
 Executor2::Config MakeCfg(QueueDepthPolicy q, OperatorConcurrency c, StreamPolicy s) {
   Executor2::Config cfg;
   cfg.queue_policy = q;
@@ -163,6 +283,20 @@ std::vector<Executor2::Config> configs = {
   MakeCfg(QueueDepthPolicy::FullyBuffered, OperatorConcurrency::Full, StreamPolicy::Single),
   MakeCfg(QueueDepthPolicy::BackendChange, OperatorConcurrency::Backend, StreamPolicy::PerBackend),
   MakeCfg(QueueDepthPolicy::FullyBuffered, OperatorConcurrency::Full, StreamPolicy::PerOperator),
+  MakeCfg(QueueDepthPolicy::FullyBuffered, OperatorConcurrency::Full, StreamPolicy::PerIteration),
+  []() {
+    auto cfg = MakeCfg(QueueDepthPolicy::FullyBuffered, OperatorConcurrency::Full,
+                       StreamPolicy::PerBackend);
+    cfg.adaptive_queue_depth = true;
+    return cfg;
+  }(),
+  []() {
+    auto cfg = MakeCfg(QueueDepthPolicy::FullyBuffered, OperatorConcurrency::Backend,
+                       StreamPolicy::PerBackend);
+    cfg.operator_replicas = 2;
+    cfg.cpu_queue_depth = 3;
+    return cfg;
+  }(),
 };
 
 INSTANTIATE_TEST_SUITE_P(Exec2Test, Exec2Test, testing::ValuesIn(configs));
@@ -169,6 +169,37 @@ inline auto GetTestGraph3() {
   return std::move(b).GetGraph(true);
 }
 
+/** A chain of 3 per-sample operators, fed by a batch operator. */
+inline auto GetSampleMajorTestGraph() {
+  auto spec0 = OpSpec(kTestOpName)
+    .AddArg("name", "op0")
+    .AddOutput("op0_0", "cpu")
+    .AddArg("addend", 10);
+  graph::OpGraph::Builder b;
+  b.Add("op0", std::move(AddCommonArgs(spec0, 32, "cpu", 4)));
+  for (int i = 1; i <= 3; i++) {
+    auto spec = OpSpec(kPerSampleOpName)
+      .AddArg("name", make_string("op", i))
+      .AddInput(make_string("op", i - 1, "_0"), "cpu")
+      .AddOutput(make_string("op", i, "_0"), "cpu");
+    b.Add(make_string("op", i), std::move(AddCommonArgs(spec, 32, "cpu", 4)));
+  }
+  b.AddOutput("op3_0_cpu");
+  return std::move(b).GetGraph(true);
+}
+
+inline void CheckSampleMajorTestResults(const Workspace &ws, int batch_size) {
+  auto &o0 = ws.Output<CPUBackend>(0);
+  ASSERT_EQ(o0.num_samples(), batch_size);
+  for (int i = 0; i < batch_size; i++) {
+    // op0 produces 10 + i and each of the following operators doubles it and adds i
+    int expected = 10 + i;
+    for (int k = 0; k < 3; k++)
+      expected = 2 * expected + i;
+    EXPECT_EQ(*o0[i].data<int>(), expected);
+  }
+}
+
 }  // namespace test
 }  // namespace exec2
 }  // namespace dali
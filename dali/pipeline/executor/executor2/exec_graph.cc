@@ -21,6 +21,7 @@
 #include "dali/pipeline/graph/op_graph2.h"
 #include "dali/pipeline/operator/batch_size_provider.h"
 #include "dali/pipeline/operator/error_reporting.h"
+#include "dali/pipeline/operator/name_utils.h"
 
 namespace dali {
 namespace exec2 {
@@ -54,13 +55,42 @@ ExecNode::ExecNode(std::unique_ptr<OperatorBase> op, const graph::OpNode *def)
     assert(!def || def->inputs.size() == static_cast<size_t>(spec.NumInput()));
     outputs.resize(std::max<size_t>(outputs.size(), spec.NumOutput()));
     inputs.resize(std::max<size_t>(inputs.size(), spec.NumInput()));
+    output_descs.reserve(outputs.size());
+    setup_range_name = "[DALI][OpTask] Setup " + GetOpDisplayName(spec);
   }
+  if (this->op)
+    RegisterMetrics();
+}
+
+ExecNode::ExecNode(std::unique_ptr<OperatorBase> op, std::string instance_name)
+: op(std::move(op))
+, instance_name(std::move(instance_name))
+, backend(BackendFromOp(this->op.get()))
+, is_batch_size_provider(dynamic_cast<BatchSizeProvider *>(this->op.get()) != nullptr) {
+  auto &spec = this->op->GetSpec();
+  outputs.resize(spec.NumOutput());
+  inputs.resize(spec.NumInput());
+  output_descs.reserve(outputs.size());
+  setup_range_name = "[DALI][OpTask] Setup " + GetOpDisplayName(spec);
+  RegisterMetrics();
+}
+
+void ExecNode::RegisterMetrics() {
+  if (!metrics::Enabled())
+    return;
+  auto label = metrics::Label("op", instance_name);
+  run_time_metric = metrics::Metric(
+      "dali_operator_run_time_us", metrics::MetricKind::Histogram, label,
+      "The host time of the operator's Setup and Run, in microseconds.");
+  wait_time_metric = metrics::Metric(
+      "dali_operator_wait_time_us", metrics::MetricKind::Histogram, label,
+      "The time from scheduling the operator's task to its start, in microseconds.");
 }
 
 void ExecNode::CreateMainTask(const WorkspaceParams &params) {
-  main_task_ = ExecNodeTask::CreateTask(this, params);
-  if (prev_task_)
-    main_task_->Succeed(prev_task_);
+  main_task_ = ExecNodeTask::CreateTask(this, params, instance_);
+  if (static_cast<int>(prev_tasks_.size()) == NumInstances())
+    main_task_->Succeed(prev_tasks_.front());
 }
 
 void ExecNode::CreateAuxTasks() {
@@ -68,7 +98,8 @@ void ExecNode::CreateAuxTasks() {
   // one concurrency semaphore.
   // Note that operator cannot run parallel to its previous iterations and we add a temporal
   // dependency between the previous and current iteration.
-  if (concurrency)
+  // The replicas have their own thread pools, so they're not subject to this limit.
+  if (concurrency && instance_ == 0)
     main_task_->GuardWith(concurrency);
 
   // The output queue depth may be limited - this is guarded by a semaphore with initial count
@@ -77,7 +108,11 @@ void ExecNode::CreateAuxTasks() {
   // The semaphore is released when all consumers of the current task's outputs are complete.
   // This means that nobody is accessing those outputs and they've been disposed of (unless
   // forwarded down the pipeline, but we're ok with that).
-  if (output_queue_limit) {
+  // The outputs of the pipeline are consumed by the user - whoever pops them must release
+  // the semaphore.
+  if (output_queue_limit && is_pipeline_output) {
+    main_task_->Succeed(output_queue_limit);
+  } else if (output_queue_limit) {
     release_outputs_ = Task::Create([]() {});
     release_outputs_->ReleaseAfterRun(output_queue_limit);
     release_outputs_->Succeed(main_task_);
@@ -116,11 +151,12 @@ std::unique_ptr<Workspace> ExecNode::CreateOutputWorkspace() {
   return ws;
 }
 
-std::unique_ptr<Workspace> ExecNode::CreateOpWorkspace() {
+std::unique_ptr<Workspace> ExecNode::CreateOpWorkspace(mm::host_arena &arena) {
   assert(op);
   const OpSpec &spec = op->GetSpec();
   auto ws = std::make_unique<Workspace>();
   ws->SetOperatorInstanceName(instance_name);
+  ws->SetHostArena(&arena);
   for (int i = 0, ninp = inputs.size(); i < ninp; i++) {
     bool arg = spec.IsArgumentInput(i);
     bool gpu = inputs[i]->device == StorageDevice::GPU;
@@ -144,20 +180,36 @@ std::unique_ptr<Workspace> ExecNode::CreateOpWorkspace() {
 }
 
 std::pair<std::unique_ptr<Workspace>, CUDASharedEvent>
-ExecNode::GetWorkspace(WorkspaceParams params) {
+ExecNode::GetWorkspace(WorkspaceParams params, int instance) {
+  if (instance > 0) {
+    // only CPU operators are replicated - there's no stream nor event to set up
+    auto &replica = *replicas[instance - 1];
+    auto ws = std::move(replica.ws);
+    if (!ws)
+      ws = CreateOpWorkspace(replica.host_arena);
+    if (!params.env)
+      params.env = &env;
+    ApplyWorkspaceParams(*ws, params);
+    ws->SetThreadPool(replica.thread_pool.get());
+    ws->set_event(nullptr);
+    return { std::move(ws), CUDASharedEvent() };
+  }
   if (!ws_) {
     assert(!has_workspace_);
     if (op) {
-      ws_ = CreateOpWorkspace();
+      ws_ = CreateOpWorkspace(host_arena);
     } else {
       ws_ = CreateOutputWorkspace();
     }
     has_workspace_ = true;
   }
-  if (!params.env)
+  bool own_env = !params.env;
+  if (own_env)
     params.env = &env;
 
   ApplyWorkspaceParams(*ws_, params);
+  if (own_env && !iteration_orders.empty() && params.iter_data)
+    ws_->set_output_order(GetOrder(params.iter_data->iteration_index));
 
   if (ws_->output_order().is_device())
     ws_event_ = CUDASharedEvent::GetFromPool();
@@ -168,7 +220,12 @@ ExecNode::GetWorkspace(WorkspaceParams params) {
   return { std::move(ws_), ws_event_ };
 }
 
-void ExecNode::PutWorkspace(std::unique_ptr<Workspace> &&ws) {
+void ExecNode::PutWorkspace(std::unique_ptr<Workspace> &&ws, int instance) {
+  if (instance > 0) {
+    assert(ws && !replicas[instance - 1]->ws);
+    replicas[instance - 1]->ws = std::move(ws);
+    return;
+  }
   assert(has_workspace_);
   assert(ws);
   assert(!ws_);
@@ -193,6 +250,8 @@ void ExecGraph::PrepareIteration(const WorkspaceParams &params) {
   Sort();
   Validate();
   Analyze();
+  // the run times change, so the priorities are updated in every iteration
+  ComputePriorities();
 
   // Create a special task that checks the predicted batch size
   // and populates the respective field in IterationData
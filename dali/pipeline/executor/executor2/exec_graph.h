@@ -15,18 +15,26 @@
 #ifndef DALI_PIPELINE_EXECUTOR_EXECUTOR2_EXEC_GRAPH_H_
 #define DALI_PIPELINE_EXECUTOR_EXECUTOR2_EXEC_GRAPH_H_
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <deque>
 #include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <utility>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "dali/core/cuda_event.h"
 #include "dali/core/cuda_shared_event.h"
+#include "dali/core/metrics.h"
+#include "dali/core/mm/memory_tag.h"
 #include "dali/pipeline/operator/operator.h"
+#include "dali/pipeline/util/thread_pool.h"
 #include "dali/pipeline/workspace/workspace.h"
 
 #include "dali/core/exec/tasking.h"
@@ -43,10 +51,14 @@ struct ExecEnv {
   AccessOrder order = AccessOrder::host();
 };
 
+class ExecTrace;
+
 struct WorkspaceParams {
   ExecEnv *env = nullptr;
   std::shared_ptr<IterationData> iter_data;
   int max_batch_size = -1;
+  /** The timeline recorder; null if the iteration is not traced. */
+  ExecTrace *trace = nullptr;
 };
 
 inline void ApplyWorkspaceParams(Workspace &ws, const WorkspaceParams &params) {
@@ -117,6 +129,98 @@ struct ExecOutputDesc {
   bool pinned = false;
 
   bool parallel_consumers = true;
+
+  /** The input whose buffer can be reused for this output or -1.
+   *
+   * It's set if the operator can compute the output in place (see OpSchema::InPlace) and the
+   * source of that input has no other consumers. The shape and type are checked at run time.
+   */
+  int in_place_input = -1;
+
+  /** If true, the output is allocated in memory which can be shared with other processes */
+  bool ipc = false;
+
+  /** The index of the pipeline output (the first one, if many) to which this output is passed.
+   *
+   * The output can be placed in a user-provided buffer (see ExternalOutputBuffer).
+   */
+  int pipeline_output_idx = -1;
+};
+
+/** The statistics of the output queue of a node, used for adjusting the depth of the queue.
+ *
+ * When a consumer (from a different stage of the pipeline) starts, it checks how many iterations
+ * ahead of it the producer is. If it's just the one the consumer needs, then the consumer has
+ * likely waited for the producer (a stall). If the queue is full, the buffers sit idle.
+ */
+struct OutputQueueStats {
+  /** The current depth of the queue; 0 means that the queue is not adaptive. */
+  std::atomic_int depth{0};
+  /** The index of the most recent iteration in which the node has run. */
+  std::atomic<int64_t> last_iteration{-1};
+
+  std::atomic<int64_t> samples{0};
+  std::atomic<int64_t> stalls{0};
+  std::atomic<int64_t> idle{0};
+
+  /** Records the state of the queue at the beginning of the consumer's iteration. */
+  void Sample(int64_t consumer_iteration) {
+    int64_t ahead = last_iteration.load(std::memory_order_acquire) - consumer_iteration + 1;
+    if (ahead <= 1)
+      stalls.fetch_add(1, std::memory_order_relaxed);
+    else if (ahead >= depth.load(std::memory_order_relaxed))
+      idle.fetch_add(1, std::memory_order_relaxed);
+    samples.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /** The (maximum) sizes of the outputs, in bytes, and the capacities of their buffers. */
+  struct OutputSize {
+    size_t size = 0, capacity = 0;
+  };
+
+  void RecordOutputSize(int idx, size_t size, size_t capacity) {
+    std::lock_guard g(mtx);
+    if (static_cast<size_t>(idx) >= output_sizes.size())
+      output_sizes.resize(idx + 1);
+    output_sizes[idx].size = std::max(output_sizes[idx].size, size);
+    output_sizes[idx].capacity = std::max(output_sizes[idx].capacity, capacity);
+  }
+
+  SmallVector<OutputSize, 4> OutputSizes() const {
+    std::lock_guard g(mtx);
+    return output_sizes;
+  }
+
+ private:
+  mutable std::mutex mtx;
+  SmallVector<OutputSize, 4> output_sizes;
+};
+
+/** The profiling data of a node, accumulated over the iterations in which profiling was enabled.
+ *
+ * The times are in nanoseconds.
+ */
+struct NodeProfile {
+  std::atomic_bool enabled{false};
+
+  std::atomic<int64_t> iterations{0};
+  /** The host time of Setup and Run */
+  std::atomic<int64_t> cpu_time{0};
+  /** The time between the start and the end of the operator's work on its stream */
+  std::atomic<int64_t> gpu_time{0};
+  /** The number of iterations in which gpu_time was measured */
+  std::atomic<int64_t> gpu_iterations{0};
+  /** The time the task waited for its inputs (and other preconditions) */
+  std::atomic<int64_t> wait_time{0};
+  std::atomic<int64_t> input_bytes{0};
+  std::atomic<int64_t> output_bytes{0};
+
+  /** The time (since the clock's epoch) when the most recent iteration was complete */
+  std::atomic<int64_t> last_end{0};
+
+  // The events are used only by the node's tasks, which never run concurrently.
+  CUDAEvent gpu_start, gpu_end;
+  bool gpu_pending = false;
 };
 
 /** An execution node.
@@ -134,6 +238,9 @@ class DLL_PUBLIC ExecNode {
  public:
   ExecNode() = default;
   explicit ExecNode(std::unique_ptr<OperatorBase> op, const graph::OpNode *def = nullptr);
+  /** Creates a node for an operator which doesn't appear in the pipeline definition graph,
+   *  e.g. a SampleMajorChain. */
+  ExecNode(std::unique_ptr<OperatorBase> op, std::string instance_name);
   explicit ExecNode(PipelineOutputTag) : is_pipeline_output(true) {}
 
   /** Inputs of the operator.
@@ -167,29 +274,133 @@ class DLL_PUBLIC ExecNode {
    */
   std::shared_ptr<tasking::Semaphore> output_queue_limit;
 
+  /** The statistics of the output queue (see output_queue_limit) */
+  OutputQueueStats queue_stats;
+
+  /** The profiling data; collected only if enabled. */
+  NodeProfile profile;
+
+  /** The total host time of Setup and Run, in nanoseconds; always collected. */
+  std::atomic<int64_t> busy_time{0};
+
+  /** Tracks the memory allocated by the operator, by purpose (see mm::MemoryTag). */
+  std::shared_ptr<mm::MemoryTracker> memory_tracker = std::make_shared<mm::MemoryTracker>();
+
+  /** The always-on metrics; registered if the metrics are enabled when the node is created. */
+  metrics::Metric run_time_metric, wait_time_metric;
+
+  /** The arena for the temporary host allocations of the operator; reset after each Run. */
+  mm::host_arena host_arena;
+
+  /** The output descriptors filled by the operator's Setup; the storage is reused in each run. */
+  std::vector<OutputDesc> output_descs;
+
+  /** The name of the profiler range of the operator's Setup. */
+  std::string setup_range_name;
+
   /** The instance of the operator (or null for output node) */
   const std::unique_ptr<OperatorBase> op;
 
+  /** An additional instance of the operator, which runs the iterations in turns with `op`.
+   *
+   * Only stateless CPU operators are replicated. Each replica has its own thread pool, so it can
+   * run concurrently with the other CPU operators, which share the executor's thread pool.
+   */
+  struct Replica {
+    std::unique_ptr<OperatorBase> op;
+    std::unique_ptr<ThreadPool> thread_pool;
+    mm::host_arena host_arena;
+    std::vector<OutputDesc> output_descs;
+    std::unique_ptr<Workspace> ws;
+  };
+
+  /** The replicas of the operator; the instance `i` (i > 0) is `replicas[i - 1]`.
+   *
+   * The iterations are assigned to the instances in a round-robin fashion and each instance
+   * waits only for its own previous iteration, so up to `NumInstances()` iterations can run
+   * concurrently.
+   */
+  std::vector<std::unique_ptr<Replica>> replicas;
+
+  int NumInstances() const {
+    return replicas.size() + 1;
+  }
+
+  OperatorBase *GetOp(int instance) const {
+    return instance > 0 ? replicas[instance - 1]->op.get() : op.get();
+  }
+
+  mm::host_arena &GetHostArena(int instance) {
+    return instance > 0 ? replicas[instance - 1]->host_arena : host_arena;
+  }
+
+  std::vector<OutputDesc> &GetOutputDescs(int instance) {
+    return instance > 0 ? replicas[instance - 1]->output_descs : output_descs;
+  }
+
   /** Data-independent execution environment (thread pool, stream, etc). */
   ExecEnv env = {};
 
+  /** The orders used in consecutive iterations, if the node cycles its streams.
+   *
+   * If empty, `env.order` is used in all iterations.
+   */
+  std::vector<AccessOrder> iteration_orders;
+
+  /** The estimated length of the path from this node to the pipeline output.
+   *
+   * It's the sum of the run times of the nodes along the longest path (the critical path)
+   * and it's used as the priority of the node's tasks - the nodes at the beginning of long
+   * chains are started first.
+   */
+  double priority = 0;
+
+  /** The moving average of the host time of Setup and Run, in microseconds.
+   *
+   * Zero, if the node hasn't run yet.
+   */
+  std::atomic<double> avg_run_time{0};
+
+  /** Updates the average run time with a new measurement. */
+  void AddRunTime(double run_time) {
+    double avg = avg_run_time.load(std::memory_order_relaxed);
+    // a lost update (in case of concurrent runs) is harmless - no need for a CAS loop
+    avg_run_time.store(avg > 0 ? avg + (run_time - avg) * 0.1 : run_time,
+                       std::memory_order_relaxed);
+  }
+
+  /** Returns the order in which the node runs in the given iteration. */
+  AccessOrder GetOrder(int64_t iteration) const {
+    if (iteration_orders.empty() || iteration < 0)
+      return env.order;
+    return iteration_orders[iteration % iteration_orders.size()];
+  }
+
   /** Obtains the cached workspace, if present, or creates a new one.
    *
-   * There can be only one workspace per node. The workspace is removed and then put back.
-   * Requesting multiple workspaces is a coding error.
+   * There can be only one workspace per instance of the operator. The workspace is removed
+   * and then put back. Requesting multiple workspaces is a coding error.
    * The workspace is updated with the WorkspaceParams supplied to this function.
    */
-  std::pair<std::unique_ptr<Workspace>, CUDASharedEvent> GetWorkspace(WorkspaceParams params);
+  std::pair<std::unique_ptr<Workspace>, CUDASharedEvent>
+  GetWorkspace(WorkspaceParams params, int instance = 0);
 
   /** Puts the workspace back into the node for later reuse.
    *
    * The workspace must not contain any TensorLists.
    */
-  void PutWorkspace(std::unique_ptr<Workspace> &&ws);
+  void PutWorkspace(std::unique_ptr<Workspace> &&ws, int instance = 0);
 
   /** The instance name of the operator. */
   const std::string instance_name;
 
+  /** The names of the other operators which run in this node (see SampleMajorChain).
+   *
+   * These operators are stateless; in the checkpoints and when looked up by name, they're
+   * represented by this node.
+   */
+  std::vector<std::string> fused_names;
+
   /** The backend on which the operator runs. */
   const OpType backend = OpType::CPU;
 
@@ -203,8 +414,18 @@ class DLL_PUBLIC ExecNode {
   mutable bool visited = false;
 
  private:
-  /** The task from the previous iteration - kept in order to maintain execution order */
-  tasking::SharedTask prev_task_;
+  /** The tasks from the previous iterations - kept in order to maintain execution order
+   *
+   * The task of an iteration succeeds the task which ran on the same instance of the operator,
+   * that is, the oldest of the NumInstances() previous tasks.
+   */
+  std::deque<tasking::SharedTask> prev_tasks_;
+
+  /** The number of the iterations prepared so far - used to pick the instance of the operator */
+  int64_t iteration_count_ = 0;
+
+  /** The instance of the operator which runs the current iteration */
+  int instance_ = 0;
 
   /** The task from the current iteration */
   tasking::SharedTask main_task_;
@@ -233,7 +454,7 @@ class DLL_PUBLIC ExecNode {
    */
   std::unique_ptr<Workspace> CreateOutputWorkspace();
   /** Creates a workspace suitable for running the operator `op`. */
-  std::unique_ptr<Workspace> CreateOpWorkspace();
+  std::unique_ptr<Workspace> CreateOpWorkspace(mm::host_arena &arena);
 
   /** The workspace.
    *
@@ -246,10 +467,17 @@ class DLL_PUBLIC ExecNode {
   /** The event associated with the workspace */
   CUDASharedEvent ws_event_;
 
+  /** Registers the always-on metrics of the operator, if the metrics are enabled. */
+  void RegisterMetrics();
+
   /** Moves to a new iteration. */
   void NextIter() {
-    prev_task_ = std::move(main_task_);
+    if (main_task_)
+      prev_tasks_.push_back(std::move(main_task_));
+    while (static_cast<int>(prev_tasks_.size()) > NumInstances())
+      prev_tasks_.pop_front();
     release_outputs_.reset();
+    instance_ = iteration_count_++ % NumInstances();
   }
 
   friend class ExecGraph;
@@ -362,14 +590,21 @@ class DLL_PUBLIC ExecGraph {
   /** Executes the recently prepared iteration */
   tasking::TaskFuture Launch(tasking::Scheduler &sched);
 
-  /** Populates the graph based on a pipeline definiton graph. */
-  void Lower(const graph::OpGraph &def);
+  /** Populates the graph based on a pipeline definiton graph.
+   *
+   * @param sample_major_chains If true, the chains of CPU operators which can run sample by
+   *                            sample are lowered to SampleMajorChain nodes.
+   */
+  void Lower(const graph::OpGraph &def, bool sample_major_chains = false);
 
  private:
   /** Sorts the graph topologically. */
   void Sort();
   /** Runs various analyses on the graph. */
   void Analyze();
+
+  /** Computes the priorities of the nodes from the graph structure and the measured run times */
+  void ComputePriorities();
   /** A bugcheck for graph inconsitency. It throws upon detecting misconneted nodes. */
   void Validate();
 
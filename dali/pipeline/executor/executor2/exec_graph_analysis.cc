@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <cassert>
 #include <list>
 #include <unordered_map>
@@ -48,6 +49,32 @@ class ExecGraph::Analyzer {
     }
   }
 
+  /** Computes the lengths of the critical paths from each node to the output.
+   *
+   * The nodes which haven't run yet weigh as much as the fastest node that has (or 1, if none
+   * has), so that, initially, the priority is the number of nodes along the longest path.
+   */
+  void ComputePriorities(ExecGraph &g) {
+    double min_time = 0;
+    for (auto &n : g.nodes_) {
+      double t = n.avg_run_time.load(std::memory_order_relaxed);
+      if (t > 0 && (min_time == 0 || t < min_time))
+        min_time = t;
+    }
+    double default_time = min_time > 0 ? min_time : 1;
+
+    // go in reverse topological order, from outputs to inputs
+    for (auto it = g.nodes_.rbegin(); it != g.nodes_.rend(); ++it) {
+      ExecNode &n = *it;
+      double t = n.avg_run_time.load(std::memory_order_relaxed);
+      double longest_tail = 0;
+      for (auto &out : n.outputs)
+        for (auto *e : out.consumers)
+          longest_tail = std::max(longest_tail, e->consumer->priority);
+      n.priority = (t > 0 ? t : default_time) + longest_tail;
+    }
+  }
+
   void SetMakeContiguousMode(ExecGraph &g) {
     for (auto &node : g.Nodes()) {
       if (node.op)
@@ -87,6 +114,33 @@ class ExecGraph::Analyzer {
     }
   }
 
+  /** Finds the outputs which can be computed in the buffers of the inputs.
+   *
+   * The input buffer must not be used after the operator runs - it must be consumed only by
+   * this operator (and not be a pipeline output). It must be stored in the same way as
+   * the output.
+   */
+  void MarkInPlaceOutputs(ExecGraph &g) {
+    for (auto &n : g.nodes_) {
+      if (!n.op)
+        continue;
+      auto &schema = n.op->GetSpec().GetSchemaOrDefault();
+      for (int o = 0; o < static_cast<int>(n.outputs.size()); o++) {
+        auto &out = n.outputs[o];
+        out.in_place_input = -1;
+        int i = schema.GetInPlaceInput(o);
+        if (i < 0 || i >= static_cast<int>(n.inputs.size()))
+          continue;
+        const ExecEdge *e = n.inputs[i];
+        if (!e || !e->producer || e->metadata)
+          continue;
+        auto &src = e->producer->outputs[e->producer_output_idx];
+        if (src.consumers.size() == 1 && src.device == out.device && src.pinned == out.pinned)
+          out.in_place_input = i;
+      }
+    }
+  }
+
  private:
   /** Sets pinnedness of the input sources
    *
@@ -202,9 +256,15 @@ void ExecGraph::Analyze() {
   a.SetMakeContiguousMode(*this);
   a.MarkPinnedBuffers(*this);
   a.MarkOutputsWithParallelConsumers(*this);
+  a.MarkInPlaceOutputs(*this);
   analyzed_ = true;
 }
 
+void ExecGraph::ComputePriorities() {
+  Analyzer a;
+  a.ComputePriorities(*this);
+}
+
 void ExecGraph::Validate() {
   // The checks here are extremely defensive, but they're only run once.
   auto err = [](auto &&... msg) {
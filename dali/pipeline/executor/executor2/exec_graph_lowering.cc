@@ -13,44 +13,155 @@
 // limitations under the License.
 
 #include <cassert>
+#include <memory>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 #include "dali/pipeline/executor/executor2/exec_graph.h"
+#include "dali/pipeline/executor/executor2/sample_major_chain.h"
 #include "dali/pipeline/graph/op_graph2.h"
+#include "dali/pipeline/operator/batch_size_provider.h"
 #include "dali/pipeline/operator/error_reporting.h"
 
 namespace dali {
 namespace exec2 {
 
-void ExecGraph::Lower(const graph::OpGraph &def) {
+namespace {
+
+/** Checks whether the operator can be a part of a SampleMajorChain. */
+bool CanRunPerSample(const graph::OpNode &node, const OperatorBase *op) {
+  if (node.op_type != OpType::CPU || !op || !op->CanRunPerSample() ||
+      dynamic_cast<const BatchSizeProvider *>(op) ||
+      !node.spec.GetSchemaOrDefault().IsStateless())
+    return false;
+  if (node.spec.NumRegularInput() < 1)
+    return false;  // the batch size is that of the first input
+  for (auto *input : node.inputs) {
+    if (input->device != StorageDevice::CPU)
+      return false;
+  }
+  return true;
+}
+
+/** Returns the operator which reads the only output of `node` as its only input, if any. */
+const graph::OpNode *GetOnlyConsumer(const graph::OpNode &node) {
+  if (node.outputs.size() != 1)
+    return nullptr;
+  const graph::DataNode *out = node.outputs[0];
+  if (out->pipeline_output || out->consumers.size() != 1)
+    return nullptr;
+  const graph::DataEdge &consumer = out->consumers[0];
+  if (!consumer.op || consumer.idx != 0 || consumer.op->inputs.size() != 1)
+    return nullptr;
+  return consumer.op;
+}
+
+}  // namespace
+
+void ExecGraph::Lower(const graph::OpGraph &def, bool sample_major_chains) {
   Invalidate();
+  struct Instance {
+    std::unique_ptr<OperatorBase> op;
+    std::shared_ptr<mm::MemoryTracker> memory_tracker;
+  };
+  std::unordered_map<const graph::OpNode *, Instance> instances(def.OpNodes().size());
+  for (const graph::OpNode &op_node : def.OpNodes()) {
+    auto &inst = instances[&op_node];
+    // the memory allocated by the operator's constructor (e.g. a cache) is attributed to it
+    inst.memory_tracker = std::make_shared<mm::MemoryTracker>();
+    try {
+      mm::MemoryTagScope memory_scope(inst.memory_tracker, mm::MemoryTag::Other);
+      inst.op = InstantiateOperator(op_node.spec);
+    } catch (...) {
+      PropagateError({std::current_exception(),
+                      "Critical error when building pipeline:\n" +
+                          GetErrorContextMessage(op_node.spec),
+                      "\nCurrent pipeline object is no longer valid."});
+    }
+  }
+
+  // The chains of operators which run sample by sample, keyed by the first operator
+  std::unordered_map<const graph::OpNode *, std::vector<const graph::OpNode *>> chains;
+  // The operators in the chains, other than the first ones
+  std::unordered_set<const graph::OpNode *> chained;
+  if (sample_major_chains) {
+    std::unordered_map<const graph::OpNode *, const graph::OpNode *> next;
+    for (const graph::OpNode &op_node : def.OpNodes()) {
+      if (!CanRunPerSample(op_node, instances[&op_node].op.get()))
+        continue;
+      auto *consumer = GetOnlyConsumer(op_node);
+      if (consumer && CanRunPerSample(*consumer, instances[consumer].op.get())) {
+        next[&op_node] = consumer;
+        chained.insert(consumer);
+      }
+    }
+    for (const graph::OpNode &op_node : def.OpNodes()) {
+      if (!next.count(&op_node) || chained.count(&op_node))
+        continue;
+      auto &chain = chains[&op_node];
+      chain.push_back(&op_node);
+      for (auto it = next.find(&op_node); it != next.end(); it = next.find(it->second))
+        chain.push_back(it->second);
+    }
+  }
+
   std::unordered_map<const graph::OpNode *, ExecNode *> def2exec(def.OpNodes().size());
   for (const graph::OpNode &op_node : def.OpNodes()) {
-    std::unique_ptr<OperatorBase> op;
+    if (chained.count(&op_node))
+      continue;  // added along with the first operator of the chain
+    auto &inst = instances[&op_node];
+    auto chain_it = chains.find(&op_node);
+    if (chain_it == chains.end()) {
+      ExecNode *exec_node = AddNode(std::move(inst.op), &op_node);
+      exec_node->memory_tracker = std::move(inst.memory_tracker);
+      def2exec.emplace(&op_node, exec_node);
+      continue;
+    }
+
+    const auto &chain = chain_it->second;
+    std::vector<std::unique_ptr<OperatorBase>> ops;
+    std::vector<std::string> names;
+    for (auto *member : chain) {
+      ops.push_back(std::move(instances[member].op));
+      names.push_back(member->instance_name);
+    }
+    std::unique_ptr<OperatorBase> chain_op;
     try {
-      op = InstantiateOperator(op_node.spec);
+      chain_op = std::make_unique<SampleMajorChain>(std::move(ops), names);
     } catch (...) {
       PropagateError({std::current_exception(),
                       "Critical error when building pipeline:\n" +
                           GetErrorContextMessage(op_node.spec),
                       "\nCurrent pipeline object is no longer valid."});
     }
-    ExecNode *exec_node = AddNode(std::move(op), &op_node);
-    def2exec.emplace(&op_node, exec_node);
+    // The node is named after the last operator, which produces its outputs.
+    ExecNode *exec_node = AddNode(std::move(chain_op), names.back());
+    exec_node->memory_tracker = std::move(inst.memory_tracker);
+    names.pop_back();
+    exec_node->fused_names = std::move(names);
+    for (auto &name : exec_node->fused_names)
+      name2node_.emplace(name, exec_node);
+    for (auto *member : chain)
+      def2exec.emplace(member, exec_node);
   }
 
-  auto it_def = def.OpNodes().begin();
-  for (ExecNode &exec_node : nodes_) {
-    assert(it_def != def.OpNodes().end());
-    auto op_node = *it_def++;
-    assert(exec_node.outputs.size() == op_node.outputs.size());
+  for (const graph::OpNode &op_node : def.OpNodes()) {
+    ExecNode *exec_node = def2exec[&op_node];
+    assert(exec_node);
+    // Only the last operator of a chain has outputs which are visible outside of it.
+    if (exec_node->instance_name != op_node.instance_name)
+      continue;
+    assert(exec_node->outputs.size() == op_node.outputs.size());
     for (int o = 0, nout = op_node.outputs.size(); o < nout; o++) {
       const auto &out = op_node.outputs[o];
       auto dev = out->device;
       for (auto &consumer : out->consumers) {
         auto *exec_con = def2exec[consumer.op];
         assert(exec_con != nullptr);
-        auto *edge = Link(&exec_node, o, exec_con, consumer.idx);
+        // the inputs of a chain are the inputs of its first operator
+        auto *edge = Link(exec_node, o, exec_con, consumer.idx);
         edge->device = dev;
         if (consumer.op) {
           auto &consumer_spec = consumer.op->spec;
@@ -61,7 +172,7 @@ void ExecGraph::Lower(const graph::OpGraph &def) {
           }
         }
       }
-      exec_node.outputs[o].device = dev;
+      exec_node->outputs[o].device = dev;
     }
   }
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <string>
+#include <vector>
 #include "dali/pipeline/executor/executor2/exec2_test.h"
 #include "dali/pipeline/operator/arg_helper.h"
 #include "dali/pipeline/executor/executor2/exec_graph.h"
@@ -105,6 +106,123 @@ TEST(ExecGraphTest, SimpleGraph) {
     EXPECT_EQ(*out[i].data<int>(), 1110 + 3 * i);
 }
 
+TEST(ExecGraphTest, CriticalPathPriority) {
+  int batch_size = 32;
+  auto make_op = [&](const char *name, std::vector<std::string> inputs) {
+    OpSpec spec(kTestOpName);
+    spec.AddArg("addend", 1)
+        .AddArg("num_threads", 1)
+        .AddArg("device", "cpu")
+        .AddArg("max_batch_size", batch_size);
+    for (auto &inp : inputs)
+      spec.AddInput(inp, "cpu");
+    spec.AddOutput(std::string(name) + "o0", "cpu")
+        .AddArg("name", name);
+    return std::make_unique<DummyOpCPU>(spec);
+  };
+  // op0 -> op1 -> op3 -> output
+  //           op2 -/
+  ExecGraph g;
+  ExecNode *n0 = g.AddNode(make_op("op0", {}));
+  ExecNode *n1 = g.AddNode(make_op("op1", { "op0o0" }));
+  ExecNode *n2 = g.AddNode(make_op("op2", {}));
+  ExecNode *n3 = g.AddNode(make_op("op3", { "op1o0", "op2o0" }));
+  ExecNode *no = g.AddOutputNode();
+  g.Link(n0, 0, n1, 0);
+  g.Link(n1, 0, n3, 0);
+  g.Link(n2, 0, n3, 1);
+  g.Link(n3, 0, no, 0);
+
+  WorkspaceParams params = {};
+  auto tp = std::make_unique<ThreadPool>(std::thread::hardware_concurrency(), 0, false, "test");
+  ExecEnv env;
+  env.thread_pool = tp.get();
+  params.env = &env;
+  params.max_batch_size = batch_size;
+  tasking::Executor ex(4);
+  ex.Start();
+
+  for (int iter = 0; iter < 2; iter++) {
+    params.iter_data = std::make_shared<IterationData>();
+    g.PrepareIteration(params);
+    if (iter == 0) {
+      // nothing was measured yet - the priority is the number of nodes on the longest path
+      EXPECT_EQ(no->priority, 1);
+      EXPECT_EQ(n3->priority, 2);
+      EXPECT_EQ(n2->priority, 3);
+      EXPECT_EQ(n1->priority, 3);
+      EXPECT_EQ(n0->priority, 4);
+    } else {
+      EXPECT_GT(n0->avg_run_time.load(), 0);
+      EXPECT_GT(n0->priority, n1->priority);
+      EXPECT_GT(n1->priority, n3->priority);
+      EXPECT_GT(n2->priority, n3->priority);
+      EXPECT_GT(n3->priority, no->priority);
+    }
+    auto fut = g.Launch(ex);
+    fut.Value<const PipelineOutput &>();
+  }
+}
+
+TEST(ExecGraphTest, InPlaceOutputs) {
+  int batch_size = 32;
+  auto make_op = [&](const char *schema, const char *name, std::vector<std::string> inputs) {
+    OpSpec spec(schema);
+    spec.AddArg("addend", 1)
+        .AddArg("num_threads", 1)
+        .AddArg("device", "cpu")
+        .AddArg("max_batch_size", batch_size);
+    for (auto &inp : inputs)
+      spec.AddInput(inp, "cpu");
+    spec.AddOutput(std::string(name) + "o0", "cpu")
+        .AddArg("name", name);
+    return std::make_unique<DummyOpCPU>(spec);
+  };
+  // op0 -> op1 (in place) -> output 0
+  // op2 -> op3 (in place) -> output 1
+  //    \-------------------> output 2
+  ExecGraph g;
+  ExecNode *n0 = g.AddNode(make_op(kTestOpName, "op0", {}));
+  ExecNode *n1 = g.AddNode(make_op(kInPlaceTestOpName, "op1", { "op0o0" }));
+  ExecNode *n2 = g.AddNode(make_op(kTestOpName, "op2", {}));
+  ExecNode *n3 = g.AddNode(make_op(kInPlaceTestOpName, "op3", { "op2o0" }));
+  ExecNode *no = g.AddOutputNode();
+  g.Link(n0, 0, n1, 0);
+  g.Link(n2, 0, n3, 0);
+  g.Link(n1, 0, no, 0);
+  g.Link(n3, 0, no, 1);
+  g.Link(n2, 0, no, 2);
+
+  WorkspaceParams params = {};
+  auto tp = std::make_unique<ThreadPool>(std::thread::hardware_concurrency(), 0, false, "test");
+  ExecEnv env;
+  env.thread_pool = tp.get();
+  params.env = &env;
+  params.max_batch_size = batch_size;
+  tasking::Executor ex(4);
+  ex.Start();
+
+  for (int iter = 0; iter < 2; iter++) {
+    params.iter_data = std::make_shared<IterationData>();
+    g.PrepareIteration(params);
+    // the output of op2 is used after op3 runs
+    EXPECT_EQ(n1->outputs[0].in_place_input, 0);
+    EXPECT_EQ(n3->outputs[0].in_place_input, -1);
+    auto fut = g.Launch(ex);
+    auto &ws = fut.Value<const PipelineOutput &>().workspace;
+    auto &out0 = ws.Output<CPUBackend>(0);
+    auto &out1 = ws.Output<CPUBackend>(1);
+    auto &out2 = ws.Output<CPUBackend>(2);
+    EXPECT_TRUE(out0.shares_data()) << "The output of op1 should use the buffer of op0";
+    EXPECT_FALSE(out1.shares_data());
+    for (int i = 0; i < batch_size; i++) {
+      EXPECT_EQ(*out0[i].data<int>(), 2 + 2 * i);
+      EXPECT_EQ(*out1[i].data<int>(), 2 + 2 * i);
+      EXPECT_EQ(*out2[i].data<int>(), 1 + i);
+    }
+  }
+}
+
 TEST(ExecGraphTest, SimpleGraphRepeat) {
   int batch_size = 256;
   OpSpec spec0(kTestOpName);
@@ -156,6 +274,7 @@ TEST(ExecGraphTest, SimpleGraphRepeat) {
     tasking::Executor ex(4);
     ex.Start();
     auto start = dali::test::perf_timer::now();
+    const OutputDesc *output_descs = nullptr;
     for (int i = 0; i < N; i++) {
       params.iter_data = std::make_shared<IterationData>();
       g.PrepareIteration(params);
@@ -166,6 +285,11 @@ TEST(ExecGraphTest, SimpleGraphRepeat) {
       ASSERT_EQ(out.shape(), uniform_list_shape(batch_size, TensorShape<0>()));
       for (int i = 0; i < batch_size; i++)
         EXPECT_EQ(*out[i].data<int>(), 1110 + 3 * i);
+      // the storage of the output descriptors is reused - it's not reallocated in each run
+      if (i == 0)
+        output_descs = n2->output_descs.data();
+      else
+        EXPECT_EQ(n2->output_descs.data(), output_descs);
     }
     auto end = dali::test::perf_timer::now();
     print(std::cerr, "Average iteration time over ", N, " iterations is ",
@@ -12,13 +12,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 #include "dali/pipeline/executor/executor2/exec_node_task.h"
 #include "dali/pipeline/executor/executor2/exec_graph.h"
+#include "dali/pipeline/executor/executor2/exec_trace.h"
 #include "dali/pipeline/executor/source_info_propagation.h"
+#include "dali/pipeline/data/ipc_tensor_list.h"
 #include "dali/core/nvtx.h"
 #include "dali/pipeline/operator/operator.h"
 #include "dali/pipeline/operator/checkpointing/checkpoint.h"
@@ -28,6 +31,17 @@
 namespace dali {
 namespace exec2 {
 
+namespace {
+
+/** Adds an event to a (short) list, unless it's already there. */
+template <typename Events>
+void AddUnique(Events &events, cudaEvent_t event) {
+  if (std::find(events.begin(), events.end(), event) == events.end())
+    events.push_back(event);
+}
+
+}  // namespace
+
 //////////////////////////////////////////////////////////////////////////////////
 // OpTask
 
@@ -77,6 +91,19 @@ class OpTask : public ExecNodeTask {
   /** Resets the layouts of inputs from reset_input_layouts_ to an empty one. */
   void ResetInputLayouts();
 
+  /** Makes the output use the buffer of the input, if it matches the output descriptor.
+   *
+   * The input must own its buffer (it must not be passed through from elsewhere), be stored
+   * in the same way as the output and have the same shape and element size.
+   *
+   * @return true, if the output shares the input's buffer
+   */
+  template <typename Backend>
+  bool ReuseInputBuffer(int output_idx, int input_idx, const OutputDesc &desc);
+
+  /** Gets the user-provided buffer for given output in the current iteration, if any. */
+  const ExternalOutputBuffer *GetOutputBuffer(int output_idx) const;
+
   friend class ExecNodeTask;
   using ExecNodeTask::ExecNodeTask;
 
@@ -94,6 +121,17 @@ class OpTask : public ExecNodeTask {
   void RunOp();
   OpTaskOutputs GetWorkspaceOutputs();
 
+  /** Samples the adaptive output queues of the producers from other stages (backends). */
+  void SampleInputQueues();
+
+  /** Marks the iteration as done and records the output sizes (for adaptive queues). */
+  void UpdateQueueStats();
+
+  /** Records the wait time, the input sizes and the start of the GPU work */
+  void ProfileStart(std::chrono::steady_clock::time_point start);
+  /** Records the CPU time, the output sizes and the end of the GPU work */
+  void ProfileEnd(std::chrono::steady_clock::time_point start);
+
 
   /** If true, the operator's Setup and Run are skipped. */
   bool skip_ = false;
@@ -102,13 +140,40 @@ class OpTask : public ExecNodeTask {
 };
 
 OpTask::OpTaskOutputs OpTask::Run() {
+  mm::MemoryTagScope memory_scope(node_->memory_tracker, mm::MemoryTag::Other);
   auto workspace_scope = GetWorkspace();
   // SetWorkspaceInputs must not go into the try/catch because it rethrows errors
   // from the inputs and we don't want them to be wrapped again as this operator's error.
   SetWorkspaceInputs();
+  SampleInputQueues();
   try {
+    auto start = std::chrono::steady_clock::now();
+    bool profile = node_->profile.enabled.load(std::memory_order_relaxed);
+    if (profile)
+      ProfileStart(start);
     SetupOp();
+    ExecTrace *trace = ws_params_.trace;
+    ExecTrace::GPURange gpu_range;
+    if (trace && !skip_ && ws_->has_stream())
+      gpu_range = trace->BeginGPU(ws_->stream(), ws_->output_order().device_id());
     RunOp();
+    if (!skip_) {
+      std::chrono::duration<double, std::micro> run_time = std::chrono::steady_clock::now() - start;
+      node_->AddRunTime(run_time.count());
+      node_->busy_time += static_cast<int64_t>(run_time.count() * 1e+3);
+      node_->run_time_metric.Observe(run_time.count());
+      std::chrono::duration<double, std::micro> wait_time = start - created_;
+      node_->wait_time_metric.Observe(wait_time.count());
+    }
+    if (profile)
+      ProfileEnd(start);
+    if (trace) {
+      trace->EndGPU(gpu_range);
+      int64_t iteration = ws_params_.iter_data ? ws_params_.iter_data->iteration_index : 0;
+      trace->AddSpan(node_, iteration, created_, start, std::chrono::steady_clock::now(),
+                     std::move(gpu_range));
+    }
+    UpdateQueueStats();
     auto &&ret = GetWorkspaceOutputs();
     return ret;
   } catch (...) {
@@ -224,6 +289,22 @@ void OpTask::SetupOp() {
       if (device < 0)
         CUDA_CALL(cudaGetDevice(&device));
       tl->set_device_id(device);
+      if (node_->outputs[i].ipc) {
+        tl->set_alloc_func([device, order = ws.output_order()](size_t bytes) {
+          return AllocIPCBuffer(bytes, device, order);
+        });
+      } else if (auto *buf = GetOutputBuffer(i)) {
+        tl->set_alloc_func(
+          [buf = *buf, used = false, device, order = ws.output_order()](size_t bytes) mutable {
+            if (used || bytes > buf.size)
+              return AllocBuffer<GPUBackend>(bytes, false, device, order);
+            used = true;
+            if (buf.ready)
+              order.wait(buf.ready.get());
+            // The buffer is owned by the user - the TensorList only refers to it.
+            return shared_ptr<uint8_t>(static_cast<uint8_t *>(buf.data), [](uint8_t *) {});
+          });
+      }
       ws.SetOutput(i, tl);
     } else {
       assert(!"Unreachable code - unknown backend.");
@@ -231,19 +312,29 @@ void OpTask::SetupOp() {
   }
 
   if (!skip_) {
-    DomainTimeRange tr("[DALI][OpTask] Setup " + GetOpDisplayName(node_->op->GetSpec()));
+    DomainTimeRange tr(node_->setup_range_name);
     ApplyDefaultLayouts();
-    std::vector<OutputDesc> output_descs;
-    output_descs.reserve(nout);
+    // an instance of the operator runs one iteration at a time, so the descriptors can be
+    // stored in the node
+    auto &output_descs = node_->GetOutputDescs(instance_);
+    output_descs.clear();
     // If Setup returns true, we must resize the outputs;
-    if (node_->op->Setup(output_descs, ws)) {
+    if (node_->GetOp(instance_)->Setup(output_descs, ws)) {
       assert(output_descs.size() == static_cast<size_t>(nout));
+      mm::MemoryTagScope output_tag(mm::MemoryTag::Output);
       for (int i = 0; i < nout; i++) {
+        int in_place_input = node_->outputs[i].in_place_input;
         if (ws.OutputIsType<CPUBackend>(i)) {
-          ws.Output<CPUBackend>(i).Resize(output_descs[i].shape, output_descs[i].type);
+          if (in_place_input < 0 ||
+              !ReuseInputBuffer<CPUBackend>(i, in_place_input, output_descs[i]))
+            ws.Output<CPUBackend>(i).Resize(output_descs[i].shape, output_descs[i].type);
         } else if (ws.OutputIsType<GPUBackend>(i)) {
-          auto &output = ws.Output<GPUBackend>(i);
-          output.Resize(output_descs[i].shape, output_descs[i].type);
+          // The user-provided buffer takes precedence over the in-place execution.
+          if (in_place_input < 0 || GetOutputBuffer(i) ||
+              !ReuseInputBuffer<GPUBackend>(i, in_place_input, output_descs[i])) {
+            auto &output = ws.Output<GPUBackend>(i);
+            output.Resize(output_descs[i].shape, output_descs[i].type);
+          }
         } else {
           assert(!"Unreachable code - unknown backend.");
         }
@@ -252,16 +343,49 @@ void OpTask::SetupOp() {
   }
 }
 
+template <typename Backend>
+bool OpTask::ReuseInputBuffer(int output_idx, int input_idx, const OutputDesc &desc) {
+  auto &ws = *ws_;
+  if (!ws.InputIsType<Backend>(input_idx))
+    return false;
+  const auto &in = ws.Input<Backend>(input_idx);
+  auto &out = ws.Output<Backend>(output_idx);
+  // A shared buffer may be used elsewhere (e.g. it's passed through by the producer);
+  // an input with a different order (or pinnedness) would be released in an unexpected order.
+  if (in.shares_data() || in.order() != out.order() || in.is_pinned() != out.is_pinned())
+    return false;
+  if (in.shape() != desc.shape ||
+      TypeTable::GetTypeInfo(in.type()).size() != TypeTable::GetTypeInfo(desc.type).size())
+    return false;
+  out.ShareData(in);
+  out.Resize(desc.shape, desc.type);
+  out.SetLayout({});
+  return true;
+}
+
+const ExternalOutputBuffer *OpTask::GetOutputBuffer(int output_idx) const {
+  int idx = node_->outputs[output_idx].pipeline_output_idx;
+  if (idx < 0)
+    return nullptr;
+  auto iter_data = ws_->GetIterationData();
+  if (!iter_data || idx >= static_cast<int>(iter_data->output_buffers.size()))
+    return nullptr;
+  auto &buf = iter_data->output_buffers[idx];
+  return buf.data ? &buf : nullptr;
+}
+
 void OpTask::RunOp() {
   if (!skip_) {
     DomainTimeRange tr("[DALI][Executor] Run");
-    node_->op->Run(*ws_);
+    node_->GetOp(instance_)->Run(*ws_);
+    node_->GetHostArena(instance_).reset();
     ResetInputLayouts();
     PropagateSourceInfo(*ws_);
   }
   assert(ws_->GetIterationData());
   if (auto cpt = ws_->GetIterationData()->checkpoint) {
-    node_->op->SaveState(cpt->GetOpCheckpoint(node_->instance_name), ws_->output_order());
+    node_->GetOp(instance_)->SaveState(cpt->GetOpCheckpoint(node_->instance_name),
+                                       ws_->output_order());
   }
   if (ws_->has_stream()) {
     assert(ws_->has_event());
@@ -269,11 +393,110 @@ void OpTask::RunOp() {
   }
 }
 
+void OpTask::SampleInputQueues() {
+  if (!ws_params_.iter_data)
+    return;
+  int64_t iter = ws_params_.iter_data->iteration_index;
+  SmallVector<ExecNode *, 8> sampled;
+  for (auto *e : node_->inputs) {
+    ExecNode *producer = e->producer;
+    if (producer->backend == node_->backend || producer->queue_stats.depth == 0)
+      continue;
+    if (std::find(sampled.begin(), sampled.end(), producer) != sampled.end())
+      continue;
+    producer->queue_stats.Sample(iter);
+    sampled.push_back(producer);
+  }
+}
+
+namespace {
+
+int64_t ToNanoseconds(std::chrono::steady_clock::time_point t) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+}  // namespace
+
+void OpTask::ProfileStart(std::chrono::steady_clock::time_point start) {
+  auto &prof = node_->profile;
+  // The task could have started when it was created or when the previous iteration ended,
+  // whichever is later.
+  int64_t ready = std::max(ToNanoseconds(created_), prof.last_end.load());
+  prof.wait_time += std::max<int64_t>(ToNanoseconds(start) - ready, 0);
+
+  int64_t input_bytes = 0;
+  for (int i = 0; i < ws_->NumInput(); i++) {
+    if (ws_->InputIsType<CPUBackend>(i))
+      input_bytes += ws_->Input<CPUBackend>(i).nbytes();
+    else
+      input_bytes += ws_->Input<GPUBackend>(i).nbytes();
+  }
+  prof.input_bytes += input_bytes;
+
+  if (ws_->has_stream()) {
+    if (prof.gpu_pending && cudaEventQuery(prof.gpu_end) == cudaSuccess) {
+      float ms = 0;
+      CUDA_CALL(cudaEventElapsedTime(&ms, prof.gpu_start, prof.gpu_end));
+      prof.gpu_time += static_cast<int64_t>(ms * 1e+6);
+      prof.gpu_iterations++;
+      prof.gpu_pending = false;
+    }
+    // If the previous measurement is still pending, this iteration is not measured.
+    if (!prof.gpu_pending) {
+      int device = ws_->output_order().device_id();
+      if (!prof.gpu_start) {
+        prof.gpu_start = CUDAEvent::CreateWithFlags(cudaEventDefault, device);
+        prof.gpu_end = CUDAEvent::CreateWithFlags(cudaEventDefault, device);
+      }
+      CUDA_CALL(cudaEventRecord(prof.gpu_start, ws_->stream()));
+    }
+  }
+}
+
+void OpTask::ProfileEnd(std::chrono::steady_clock::time_point start) {
+  auto &prof = node_->profile;
+  auto end = std::chrono::steady_clock::now();
+  prof.cpu_time += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+  int64_t output_bytes = 0;
+  for (int o = 0; o < ws_->NumOutput(); o++) {
+    if (ws_->OutputIsType<CPUBackend>(o))
+      output_bytes += ws_->Output<CPUBackend>(o).nbytes();
+    else
+      output_bytes += ws_->Output<GPUBackend>(o).nbytes();
+  }
+  prof.output_bytes += output_bytes;
+
+  if (ws_->has_stream() && !prof.gpu_pending && prof.gpu_start) {
+    CUDA_CALL(cudaEventRecord(prof.gpu_end, ws_->stream()));
+    prof.gpu_pending = true;
+  }
+  prof.last_end = ToNanoseconds(end);
+  prof.iterations++;
+}
+
+void OpTask::UpdateQueueStats() {
+  auto &stats = node_->queue_stats;
+  if (stats.depth > 0 || node_->profile.enabled.load(std::memory_order_relaxed)) {
+    for (int o = 0; o < ws_->NumOutput(); o++) {
+      if (ws_->OutputIsType<CPUBackend>(o)) {
+        auto &out = ws_->Output<CPUBackend>(o);
+        stats.RecordOutputSize(o, out.nbytes(), out.capacity());
+      } else {
+        auto &out = ws_->Output<GPUBackend>(o);
+        stats.RecordOutputSize(o, out.nbytes(), out.capacity());
+      }
+    }
+  }
+  if (ws_params_.iter_data)
+    stats.last_iteration.store(ws_params_.iter_data->iteration_index, std::memory_order_release);
+}
+
 void OpTask::SetWorkspaceInputs() {
   int ti = 0;
   assert(ws_->NumInput() + ws_->NumArgumentInput() == static_cast<int>(node_->inputs.size()));
   auto order = ws_->output_order();
-  std::unordered_set<cudaEvent_t> events(ws_->NumInput() + ws_->NumArgumentInput());
+  SmallVector<cudaEvent_t, 8> events;
   auto &schema = node_->op->GetSpec().GetSchema();
 
   auto process_input = [&](int i, auto backend) {
@@ -282,7 +505,7 @@ void OpTask::SetWorkspaceInputs() {
     bool is_meta = node_->inputs[i]->metadata;
     // metadata-only inputs don't need to be synchronized
     if (!is_meta && inp.event() && inp.order != order)
-      events.insert(inp.event());
+      AddUnique(events, inp.event());
 
     bool is_plain_host = std::is_same_v<Backend, CPUBackend> && !inp.data->is_pinned();
 
@@ -311,7 +534,7 @@ void OpTask::SetWorkspaceInputs() {
   for (int i = 0; i < ws_->NumArgumentInput(); i++, ti++) {
     auto &inp = TaskInput<CPUBackend>(ti);
     if (inp.event())
-      events.insert(inp.event());
+      AddUnique(events, inp.event());
     ws_->SetArgumentInput(i, inp.data);
   }
 
@@ -343,8 +566,10 @@ AccessOrder OpTask::OutputConsumerStream(int output_idx) const {
   if (consumers.empty())
     return {};  // definitely no consumer
   AccessOrder order = {};
+  // the consumers run in the same iteration
+  int64_t iteration = ws_params_.iter_data ? ws_params_.iter_data->iteration_index : -1;
   for (size_t i = 0; i < consumers.size(); i++) {
-    AccessOrder consumer_order = consumers[i]->consumer->env.order;
+    AccessOrder consumer_order = consumers[i]->consumer->GetOrder(iteration);
     if (consumer_order.is_device()) {
       if (!order)  // not set yet? just use the first one found
         order = consumer_order;
@@ -425,20 +650,20 @@ PipelineOutput OutputTask::Run() {
   auto workspace_scope = GetWorkspace();
   assert(ws_->NumInput() == 0);
   assert(ws_->NumArgumentInput() == 0);
-  std::unordered_set<cudaEvent_t> events(ws_->NumOutput());
+  SmallVector<cudaEvent_t, 8> events;
   assert(ws_->NumOutput() == static_cast<int>(node_->inputs.size()));
 
   for (int o = 0; o < ws_->NumOutput(); o++) {
     if (ws_->OutputIsType<CPUBackend>(o)) {
       auto &inp = TaskInput<CPUBackend>(o);
       if (inp.event())
-        events.insert(inp.event());
+        AddUnique(events, inp.event());
       ws_->SetOutput(o, inp.data);
     } else {
       assert(ws_->OutputIsType<GPUBackend>(o));
       auto &inp = TaskInput<GPUBackend>(o);
       if (inp.event())
-        events.insert(inp.event());
+        AddUnique(events, inp.event());
       ws_->SetOutput(o, inp.data);
     }
   }
@@ -469,6 +694,11 @@ PipelineOutput OutputTask::Run() {
     CUDA_CALL(cudaEventRecord(ws_->event(), ws_->output_order().stream()));
   }
 
+  if (ws_params_.iter_data) {
+    node_->queue_stats.last_iteration.store(ws_params_.iter_data->iteration_index,
+                                           std::memory_order_release);
+  }
+
   PipelineOutput ret{ *ws_, event_, device };
   return ret;
 }
@@ -476,15 +706,17 @@ PipelineOutput OutputTask::Run() {
 //////////////////////////////////////////////////////////////////////////////////
 // ExecNodeTask
 
-tasking::SharedTask ExecNodeTask::CreateTask(ExecNode *node, const WorkspaceParams &params) {
+tasking::SharedTask ExecNodeTask::CreateTask(ExecNode *node, const WorkspaceParams &params,
+                                             int instance) {
   if (node->is_pipeline_output) {
     return tasking::Task::Create(
-      OutputTask(node, params).GetRunnable());
+      OutputTask(node, params).GetRunnable(), node->priority);
   } else {
     int nout = node->outputs.size();
     return tasking::Task::Create(
       nout,
-      OpTask(node, params).GetRunnable());
+      OpTask(node, params, instance).GetRunnable(),
+      node->priority);
   }
 }
 
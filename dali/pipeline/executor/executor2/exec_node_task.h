@@ -15,6 +15,7 @@
 #ifndef DALI_PIPELINE_EXECUTOR_EXECUTOR2_EXEC_NODE_TASK_H_
 #define DALI_PIPELINE_EXECUTOR_EXECUTOR2_EXEC_NODE_TASK_H_
 
+#include <chrono>
 #include <memory>
 #include <utility>
 #include "dali/core/exec/tasking.h"
@@ -46,16 +47,22 @@ class ExecNodeTask {
    * There are two possible tasks:
    * - operator task
    * - output task.
+   *
+   * @param instance The instance of the operator (see ExecNode::replicas) which runs the task.
    */
-  static tasking::SharedTask CreateTask(ExecNode *node, const WorkspaceParams &params);
+  static tasking::SharedTask CreateTask(ExecNode *node, const WorkspaceParams &params,
+                                        int instance = 0);
 
  protected:
-  ExecNodeTask(ExecNode *node, WorkspaceParams ws_params)
-  : node_(node), ws_params_(std::move(ws_params)) {}
+  ExecNodeTask(ExecNode *node, WorkspaceParams ws_params, int instance = 0)
+  : node_(node), ws_params_(std::move(ws_params)), instance_(instance) {}
 
   tasking::Task *task_ = nullptr;
   ExecNode *node_ = nullptr;
+  /** When the task was created - used in profiling to compute the time spent waiting. */
+  std::chrono::steady_clock::time_point created_ = std::chrono::steady_clock::now();
   WorkspaceParams ws_params_{};
+  int instance_ = 0;
   std::unique_ptr<Workspace> ws_ = nullptr;
   CUDASharedEvent event_;
 
@@ -78,12 +85,12 @@ class ExecNodeTask {
 
   auto GetWorkspace() {
     assert(!ws_);
-    std::tie(ws_, event_) = node_->GetWorkspace(ws_params_);
+    std::tie(ws_, event_) = node_->GetWorkspace(ws_params_, instance_);
     assert(ws_ != nullptr);
     assert(ws_->output_order() && "Workspace must have a valid order");
     return AtScopeExit([this]() {
       ClearWorkspace();
-      node_->PutWorkspace(std::move(ws_));
+      node_->PutWorkspace(std::move(ws_), instance_);
     });
   }
 };
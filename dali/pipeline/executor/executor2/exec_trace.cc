@@ -0,0 +1,308 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "dali/pipeline/executor/executor2/exec_trace.h"
+#include "dali/pipeline/executor/executor2/exec_graph.h"
+#include "dali/core/cuda_error.h"
+#include "dali/core/cuda_stream.h"
+#include "dali/core/device_guard.h"
+#include "dali/core/format.h"
+
+namespace dali {
+namespace exec2 {
+
+namespace {
+
+constexpr int kHostPid = 1;
+constexpr int kGPUPid = 2;
+
+void WriteEscaped(std::ostream &os, std::string_view s) {
+  os << '"';
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "\\u%04x", c);
+      os << buf;
+    } else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+
+std::string_view SpanName(const ExecNode &node) {
+  if (!node.instance_name.empty())
+    return node.instance_name;
+  return node.op ? std::string_view(node.op->GetSpec().SchemaName()) : "<output>";
+}
+
+/** Chrome trace timestamps are in microseconds */
+double Us(int64_t ns) {
+  return ns * 1e-3;
+}
+
+class EventWriter {
+ public:
+  explicit EventWriter(std::ostream &os) : os_(os) {
+    os_ << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  }
+
+  ~EventWriter() {
+    os_ << "\n]}\n";
+  }
+
+  /** Starts an event; the caller may append more fields and must call End. */
+  std::ostream &Begin(char phase, int pid, int64_t tid) {
+    os_ << (first_ ? "\n" : ",\n");
+    first_ = false;
+    os_ << "{\"ph\":\"" << phase << "\",\"pid\":" << pid << ",\"tid\":" << tid;
+    return os_;
+  }
+
+  void End() {
+    os_ << "}";
+  }
+
+  void Metadata(const char *what, int pid, int64_t tid, std::string_view name) {
+    Begin('M', pid, tid) << ",\"name\":\"" << what << "\",\"args\":{\"name\":";
+    WriteEscaped(os_, name);
+    os_ << "}";
+    End();
+  }
+
+  void Complete(int pid, int64_t tid, std::string_view name, const char *cat,
+                int64_t start, int64_t end, int64_t iteration) {
+    Begin('X', pid, tid) << ",\"name\":";
+    WriteEscaped(os_, name);
+    os_ << ",\"cat\":\"" << cat << "\",\"ts\":" << Us(start) << ",\"dur\":" << Us(end - start)
+        << ",\"args\":{\"iteration\":" << iteration;
+  }
+
+  void Flow(char phase, int64_t id, int64_t tid, int64_t ts) {
+    Begin(phase, kHostPid, tid) << ",\"name\":\"wait\",\"cat\":\"dependency\",\"id\":" << id
+                                << ",\"ts\":" << Us(ts);
+    if (phase == 'f')
+      os_ << ",\"bp\":\"e\"";
+    End();
+  }
+
+ private:
+  std::ostream &os_;
+  bool first_ = true;
+};
+
+}  // namespace
+
+ExecTrace::~ExecTrace() {
+  try {
+    std::lock_guard g(mtx_);
+    ReleaseEvents(spans_);
+    for (auto &[device, clock] : gpu_clocks_)
+      events_.Put(std::move(clock.ref), device);
+  } catch (...) {
+    // The CUDA context may be already gone at exit.
+  }
+}
+
+void ExecTrace::Enable(bool enable) {
+  std::lock_guard g(mtx_);
+  if (enable && !IsEnabled()) {
+    ReleaseEvents(spans_);
+    iterations_.clear();
+    for (auto &[device, clock] : gpu_clocks_)
+      events_.Put(std::move(clock.ref), device);
+    gpu_clocks_.clear();
+    origin_ = std::chrono::steady_clock::now();
+  }
+  enabled_ = enable;
+}
+
+const ExecTrace::GPUClock &ExecTrace::GetGPUClock(int device) {
+  auto it = gpu_clocks_.find(device);
+  if (it != gpu_clocks_.end())
+    return it->second;
+  // The reference event is recorded in an idle stream, so it completes immediately and
+  // the host time taken after the synchronization is (almost) the time of the event.
+  DeviceGuard dg(device);
+  CUDAStream stream = CUDAStream::Create(true, device);
+  GPUClock clock;
+  clock.ref = events_.Get(device);
+  CUDA_CALL(cudaEventRecord(clock.ref, stream));
+  CUDA_CALL(cudaEventSynchronize(clock.ref));
+  clock.host_time = Relative(std::chrono::steady_clock::now());
+  return gpu_clocks_.emplace(device, std::move(clock)).first->second;
+}
+
+ExecTrace::GPURange ExecTrace::BeginGPU(cudaStream_t stream, int device) {
+  GPURange range;
+  range.stream = stream;
+  range.device = device;
+  {
+    std::lock_guard g(mtx_);
+    GetGPUClock(device);
+  }
+  range.start = events_.Get(device);
+  range.end = events_.Get(device);
+  CUDA_CALL(cudaEventRecord(range.start, stream));
+  return range;
+}
+
+void ExecTrace::EndGPU(GPURange &range) {
+  if (range.end)
+    CUDA_CALL(cudaEventRecord(range.end, range.stream));
+}
+
+void ExecTrace::AddSpan(const ExecNode *node, int64_t iteration,
+                        std::chrono::steady_clock::time_point created,
+                        std::chrono::steady_clock::time_point start,
+                        std::chrono::steady_clock::time_point end,
+                        GPURange gpu) {
+  int64_t tid = syscall(SYS_gettid);
+  std::lock_guard g(mtx_);
+  if (!IsEnabled()) {
+    if (gpu.start) {
+      events_.Put(std::move(gpu.start), gpu.device);
+      events_.Put(std::move(gpu.end), gpu.device);
+    }
+    return;
+  }
+  if (!thread_names_.count(tid)) {
+    char name[16] = {};
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+    thread_names_[tid] = name;
+  }
+  spans_.push_back({ node, iteration, Relative(created), Relative(start), Relative(end), tid,
+                     std::move(gpu) });
+}
+
+void ExecTrace::AddIteration(int64_t iteration,
+                             std::chrono::steady_clock::time_point launched,
+                             std::chrono::steady_clock::time_point finished) {
+  std::lock_guard g(mtx_);
+  if (IsEnabled())
+    iterations_.push_back({ iteration, Relative(launched), Relative(finished) });
+}
+
+void ExecTrace::ReleaseEvents(std::vector<Span> &spans) {
+  for (auto &s : spans) {
+    if (s.gpu.start) {
+      events_.Put(std::move(s.gpu.start), s.gpu.device);
+      events_.Put(std::move(s.gpu.end), s.gpu.device);
+    }
+  }
+  spans.clear();
+}
+
+void ExecTrace::Write(std::ostream &os) {
+  std::vector<Span> spans;
+  std::vector<Iteration> iterations;
+  std::map<int64_t, std::string> thread_names;
+  std::map<int, int64_t> gpu_ref_times;
+  std::map<int, cudaEvent_t> gpu_refs;
+  {
+    std::lock_guard g(mtx_);
+    spans.swap(spans_);
+    iterations.swap(iterations_);
+    thread_names = thread_names_;
+    for (auto &[device, clock] : gpu_clocks_) {
+      gpu_ref_times[device] = clock.host_time;
+      gpu_refs[device] = clock.ref;
+    }
+  }
+
+  EventWriter w(os);
+  w.Metadata("process_name", kHostPid, 0, "DALI host");
+  for (auto &[tid, name] : thread_names)
+    w.Metadata("thread_name", kHostPid, tid, name.empty() ? "worker" : name);
+
+  // The iterations overlap, so they're written as asynchronous events.
+  if (!iterations.empty())
+    w.Metadata("thread_name", kHostPid, 0, "iterations");
+  for (auto &it : iterations) {
+    auto name = make_string("iteration ", it.index);
+    for (auto [phase, ts] : { std::pair('b', it.launched), std::pair('e', it.finished) }) {
+      w.Begin(phase, kHostPid, 0) << ",\"name\":\"" << name << "\",\"cat\":\"iteration\""
+                                  << ",\"id\":" << it.index << ",\"ts\":" << Us(ts);
+      w.End();
+    }
+  }
+
+  std::map<std::pair<const ExecNode *, int64_t>, size_t> span_idx;
+  for (size_t i = 0; i < spans.size(); i++)
+    span_idx[{ spans[i].node, spans[i].iteration }] = i;
+
+  std::map<cudaStream_t, int64_t> stream_ids;
+  for (auto &s : spans) {
+    // The time the task spent after being created, before it started, is shown as an argument;
+    // the actual dependencies are shown as flow arrows (below).
+    w.Complete(kHostPid, s.tid, SpanName(*s.node), "cpu", s.start, s.end, s.iteration);
+    os << ",\"wait_us\":" << Us(s.start - s.created) << "}";
+    w.End();
+
+    auto ref_it = gpu_refs.find(s.gpu.device);
+    if (s.gpu.start && ref_it != gpu_refs.end()) {
+      DeviceGuard dg(s.gpu.device);
+      CUDA_CALL(cudaEventSynchronize(s.gpu.end));
+      float start_ms = 0, end_ms = 0;
+      CUDA_CALL(cudaEventElapsedTime(&start_ms, ref_it->second, s.gpu.start));
+      CUDA_CALL(cudaEventElapsedTime(&end_ms, ref_it->second, s.gpu.end));
+      int64_t ref = gpu_ref_times[s.gpu.device];
+      auto [it, inserted] = stream_ids.emplace(s.gpu.stream, stream_ids.size());
+      if (inserted) {
+        w.Metadata("thread_name", kGPUPid, it->second,
+                   make_string("device ", s.gpu.device, " stream ",
+                               reinterpret_cast<uintptr_t>(s.gpu.stream)));
+      }
+      w.Complete(kGPUPid, it->second, SpanName(*s.node), "gpu",
+                 ref + static_cast<int64_t>(start_ms * 1e+6),
+                 ref + static_cast<int64_t>(end_ms * 1e+6), s.iteration);
+      os << "}";
+      w.End();
+    }
+  }
+  if (!stream_ids.empty())
+    w.Metadata("process_name", kGPUPid, 0, "DALI GPU");
+
+  // The data dependencies are the preconditions the scheduler waits for before it runs a task.
+  int64_t flow_id = 0;
+  for (auto &s : spans) {
+    for (auto *e : s.node->inputs) {
+      auto it = span_idx.find({ e->producer, s.iteration });
+      if (it == span_idx.end())
+        continue;
+      auto &producer = spans[it->second];
+      // the flow must start within the producer's span to be bound to it
+      w.Flow('s', flow_id, producer.tid, std::max(producer.start, producer.end - 1));
+      w.Flow('f', flow_id, s.tid, s.start);
+      flow_id++;
+    }
+  }
+
+  ReleaseEvents(spans);
+}
+
+}  // namespace exec2
+}  // namespace dali
@@ -0,0 +1,143 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_EXECUTOR_EXECUTOR2_EXEC_TRACE_H_
+#define DALI_PIPELINE_EXECUTOR_EXECUTOR2_EXEC_TRACE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "dali/core/api_helper.h"
+#include "dali/core/cuda_event.h"
+#include "dali/core/cuda_event_pool.h"
+
+namespace dali {
+namespace exec2 {
+
+class ExecNode;
+
+/** Records a timeline of the execution of the graph nodes.
+ *
+ * The timeline contains:
+ * - the host spans of the nodes' tasks, on the threads which actually ran them,
+ * - the GPU spans of the nodes, measured with CUDA events recorded in the nodes' streams,
+ * - the iterations, from the launch until the outputs are returned,
+ * - the data dependencies between the tasks (the precondition edges seen by the scheduler).
+ *
+ * It's written in the Chrome trace event (JSON) format, which can be opened in
+ * chrome://tracing and in the Perfetto UI.
+ *
+ * The recording is meant for debugging - it takes a lock for each span.
+ */
+class DLL_PUBLIC ExecTrace {
+ public:
+  ExecTrace() : events_(cudaEventDefault) {}
+  ~ExecTrace();
+
+  /** Starts (or stops) the recording; starting discards the spans recorded so far. */
+  void Enable(bool enable);
+
+  bool IsEnabled() const noexcept {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /** The GPU part of a span; empty if the node doesn't run on a stream. */
+  struct GPURange {
+    CUDAEvent start, end;
+    cudaStream_t stream = nullptr;
+    int device = -1;
+  };
+
+  /** Records an event in the stream, marking the start of the node's GPU work.
+   *
+   * The returned range must be passed to EndGPU and then to AddSpan.
+   */
+  GPURange BeginGPU(cudaStream_t stream, int device);
+
+  /** Records an event in the stream, marking the end of the node's GPU work. */
+  void EndGPU(GPURange &range);
+
+  /** Adds a span of a node's task, executed by the calling thread.
+   *
+   * @param node      the node
+   * @param iteration the iteration index
+   * @param created   when the task was created
+   * @param start     when the task started running
+   * @param end       when the task finished running
+   * @param gpu       the GPU part of the span (see BeginGPU)
+   */
+  void AddSpan(const ExecNode *node, int64_t iteration,
+               std::chrono::steady_clock::time_point created,
+               std::chrono::steady_clock::time_point start,
+               std::chrono::steady_clock::time_point end,
+               GPURange gpu);
+
+  /** Adds an iteration, from its launch until its outputs were returned. */
+  void AddIteration(int64_t iteration,
+                    std::chrono::steady_clock::time_point launched,
+                    std::chrono::steady_clock::time_point finished);
+
+  /** Writes the spans recorded so far in the Chrome trace format and discards them.
+   *
+   * The function waits for the GPU work of the recorded spans to complete.
+   * The node pointers stored in the spans must be valid.
+   */
+  void Write(std::ostream &os);
+
+ private:
+  struct Span {
+    const ExecNode *node;
+    int64_t iteration;
+    int64_t created, start, end;  // ns, relative to origin_
+    int64_t tid;
+    GPURange gpu;
+  };
+
+  struct Iteration {
+    int64_t index, launched, finished;  // ns, relative to origin_
+  };
+
+  struct GPUClock {
+    CUDAEvent ref;
+    int64_t host_time;  // ns, relative to origin_
+  };
+
+  int64_t Relative(std::chrono::steady_clock::time_point t) const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t - origin_).count();
+  }
+
+  /** Aligns the device's event time with the host clock; called with mtx_ held. */
+  const GPUClock &GetGPUClock(int device);
+
+  void ReleaseEvents(std::vector<Span> &spans);
+
+  std::atomic_bool enabled_{false};
+  std::mutex mtx_;
+  std::chrono::steady_clock::time_point origin_ = std::chrono::steady_clock::now();
+  std::vector<Span> spans_;
+  std::vector<Iteration> iterations_;
+  std::map<int64_t, std::string> thread_names_;
+  std::map<int, GPUClock> gpu_clocks_;
+  CUDAEventPool events_;
+};
+
+}  // namespace exec2
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_EXECUTOR_EXECUTOR2_EXEC_TRACE_H_
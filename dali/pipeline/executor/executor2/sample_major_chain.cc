@@ -0,0 +1,171 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/executor/executor2/sample_major_chain.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dali/core/call_at_exit.h"
+#include "dali/pipeline/operator/name_utils.h"
+#include "dali/pipeline/operator/op_schema.h"
+#include "dali/pipeline/workspace/sample_workspace.h"
+
+namespace dali {
+
+DALI_SCHEMA(SampleMajorChain)
+    .DocStr(R"code(Runs a chain of CPU operators sample by sample.
+
+This operator is created by the executor when lowering the pipeline; it's not meant to be used
+directly.)code")
+    .NumInput(1, 99)
+    .OutputFn([](const OpSpec &spec) { return spec.NumOutput(); })
+    .AddArg("operators", R"code(The instance names of the chained operators, in the order of
+application.)code", DALI_STRING_VEC)
+    .MakeInternal();
+
+namespace exec2 {
+
+SampleMajorChain::SampleMajorChain(std::vector<std::unique_ptr<OperatorBase>> ops,
+                                   std::vector<std::string> names)
+: Operator<CPUBackend>(MakeSpec(ops, names))
+, ops_(std::move(ops))
+, names_(std::move(names)) {
+  for (auto &op : ops_) {
+    DALI_ENFORCE(dynamic_cast<Operator<CPUBackend> *>(op.get()) && op->CanRunPerSample(),
+                 make_string("The operator `", GetOpDisplayName(op->GetSpec(), true),
+                             "` cannot run sample by sample."));
+  }
+  workspaces_.resize(ops_.size());
+  for (size_t i = 0; i + 1 < ops_.size(); i++) {
+    auto tl = std::make_shared<TensorList<CPUBackend>>();
+    tl->set_pinned(false);
+    intermediate_.push_back(std::move(tl));
+  }
+}
+
+OpSpec SampleMajorChain::MakeSpec(const std::vector<std::unique_ptr<OperatorBase>> &ops,
+                                  const std::vector<std::string> &names) {
+  DALI_ENFORCE(ops.size() >= 2 && names.size() == ops.size(),
+               "A chain consists of at least two named operators.");
+  const OpSpec &first = ops.front()->GetSpec();
+  const OpSpec &last = ops.back()->GetSpec();
+  OpSpec spec(kSampleMajorChainName);
+  // The common arguments (e.g. the batch size or the origin, used in error messages) are taken
+  // from the last operator, which produces the outputs of the chain.
+  for (auto &arg : last.Arguments()) {
+    if (OpSchema::Default().HasArgument(arg->get_name(), true))
+      spec.SetInitializedArg(arg->get_name(), arg);
+  }
+  spec.AddArg("operators", names);
+  for (int i = 0; i < first.NumInput(); i++)
+    spec.AddInput(first.InputName(i), first.InputDevice(i));
+  for (int o = 0; o < last.NumOutput(); o++)
+    spec.AddOutput(last.OutputName(o), last.OutputDevice(o));
+  return spec;
+}
+
+void SampleMajorChain::DeserializeCheckpoint(OpCheckpoint &cpt, const std::string &data) const {
+  DALI_ENFORCE(data.empty(),
+               "Provided checkpoint contains non-empty data for a stateless operator. "
+               "The checkpoint might come from another pipeline. ");
+}
+
+void SampleMajorChain::PrepareWorkspaces(const Workspace &ws) {
+  int nops = ops_.size();
+  int batch_size = ws.GetInputBatchSize(0);
+  const OpSpec &first_spec = ops_[0]->GetSpec();
+  const OpSchema &first_schema = first_spec.GetSchemaOrDefault();
+  for (int k = 0; k < nops; k++) {
+    auto &op_ws = workspaces_[k];
+    op_ws.Clear();
+    op_ws.SetOperatorInstanceName(names_[k]);
+    op_ws.SetThreadPool(ws.HasThreadPool() ? &ws.GetThreadPool() : nullptr);
+    op_ws.SetHostArena(ws.HostArena());
+    op_ws.set_output_order(ws.output_order());
+    op_ws.InjectIterationData(ws.GetIterationData());
+    if (k == 0) {
+      for (int i = 0; i < ws.NumInput(); i++) {
+        auto input = ws.InputPtr<CPUBackend>(i);
+        if (first_spec.IsArgumentInput(i)) {
+          op_ws.AddArgumentInput(first_spec.ArgumentInputName(i), std::move(input));
+          continue;
+        }
+        // The executor applies the default layouts of the chain, which has none.
+        // The input may have other consumers, so the layout is set in a view.
+        auto layout = first_schema.GetInputLayout(i, input->sample_dim(), input->GetLayout());
+        if (layout != input->GetLayout()) {
+          auto view = std::make_shared<TensorList<CPUBackend>>();
+          view->ShareData(*input);
+          view->SetLayout(layout);
+          input = std::move(view);
+        }
+        op_ws.AddInput(std::move(input));
+      }
+    } else {
+      op_ws.AddInput(intermediate_[k - 1]);
+    }
+    if (k + 1 < nops) {
+      op_ws.AddOutput(intermediate_[k]);
+    } else {
+      for (int o = 0; o < ws.NumOutput(); o++)
+        op_ws.AddOutput(ws.OutputPtr<CPUBackend>(o));
+    }
+    op_ws.SetBatchSizes(batch_size);
+  }
+}
+
+void SampleMajorChain::ClearWorkspaces() {
+  for (auto &op_ws : workspaces_)
+    op_ws.Clear();
+}
+
+bool SampleMajorChain::SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) {
+  PrepareWorkspaces(ws);
+  // Only the inputs of the first operator are available. The outputs are sized by the
+  // per-sample RunImpl, so the descriptors are not used.
+  first_output_desc_.clear();
+  ops_[0]->Setup(first_output_desc_, workspaces_[0]);
+  return false;
+}
+
+void SampleMajorChain::RunImpl(Workspace &ws) {
+  auto cleanup = AtScopeExit([&]() { ClearWorkspaces(); });
+  int nops = ops_.size();
+  int batch_size = ws.GetInputBatchSize(0);
+  for (auto &op_ws : workspaces_) {
+    for (int o = 0; o < op_ws.NumOutput(); o++)
+      op_ws.Output<CPUBackend>(o).SetSize(batch_size);
+  }
+
+  auto &tp = ws.GetThreadPool();
+  auto input_shape = ws.GetInputShape(0);
+  for (int s = 0; s < batch_size; s++) {
+    // the largest samples go first, so that they don't end up being processed last
+    tp.AddWork([this, s, nops](int tid) {
+      SampleWorkspace sample;
+      for (int k = 0; k < nops; k++) {
+        MakeSampleView(sample, workspaces_[k], s, tid);
+        static_cast<Operator<CPUBackend> &>(*ops_[k]).RunImpl(sample);
+      }
+    }, input_shape.tensor_size(s));
+  }
+  tp.RunAll();
+
+  for (auto &op_ws : workspaces_)
+    FixBatchPropertiesConsistency(op_ws, false);
+}
+
+}  // namespace exec2
+}  // namespace dali
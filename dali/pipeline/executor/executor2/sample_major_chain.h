@@ -0,0 +1,102 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_EXECUTOR_EXECUTOR2_SAMPLE_MAJOR_CHAIN_H_
+#define DALI_PIPELINE_EXECUTOR_EXECUTOR2_SAMPLE_MAJOR_CHAIN_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "dali/pipeline/operator/operator.h"
+#include "dali/pipeline/workspace/workspace.h"
+
+namespace dali {
+namespace exec2 {
+
+constexpr char kSampleMajorChainName[] = "SampleMajorChain";
+
+/** Runs a chain of CPU operators sample by sample.
+ *
+ * Each operator in the chain consumes the only output of the previous one. Instead of running
+ * the operators one after another on the whole batch, all of them are applied to a sample in
+ * one task of the thread pool, so the intermediate results are still in the cache when the next
+ * operator reads them.
+ *
+ * The operators must support this mode (see OperatorBase::CanRunPerSample). Only the first
+ * operator is set up - with the inputs of the chain; the others run their per-sample RunImpl
+ * directly.
+ *
+ * The inputs of the chain are the inputs of the first operator (the argument inputs are passed
+ * as regular inputs) and the outputs are the outputs of the last one.
+ */
+class DLL_PUBLIC SampleMajorChain : public Operator<CPUBackend> {
+ public:
+  /**
+   * @param ops   the operators, in the order of application
+   * @param names the instance names of the operators
+   */
+  SampleMajorChain(std::vector<std::unique_ptr<OperatorBase>> ops,
+                   std::vector<std::string> names);
+
+  int NumOperators() const {
+    return ops_.size();
+  }
+
+  OperatorBase *GetOperator(int idx) const {
+    return ops_[idx].get();
+  }
+
+  bool HasContiguousOutputs() const override {
+    return false;
+  }
+
+  // The chained operators are stateless.
+  void SaveState(OpCheckpoint &cpt, AccessOrder order) override {}
+
+  void RestoreState(const OpCheckpoint &cpt) override {}
+
+  std::string SerializeCheckpoint(const OpCheckpoint &cpt) const override {
+    return {};
+  }
+
+  void DeserializeCheckpoint(OpCheckpoint &cpt, const std::string &data) const override;
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override;
+
+  void RunImpl(Workspace &ws) override;
+  using Operator<CPUBackend>::RunImpl;
+
+ private:
+  static OpSpec MakeSpec(const std::vector<std::unique_ptr<OperatorBase>> &ops,
+                         const std::vector<std::string> &names);
+
+  /** Populates the workspaces of the operators with the inputs and outputs of the chain */
+  void PrepareWorkspaces(const Workspace &ws);
+
+  /** Removes the references to the inputs and outputs of the chain */
+  void ClearWorkspaces();
+
+  std::vector<std::unique_ptr<OperatorBase>> ops_;
+  std::vector<std::string> names_;
+  std::vector<Workspace> workspaces_;
+  /** The outputs of all but the last operator; reused in consecutive iterations */
+  std::vector<std::shared_ptr<TensorList<CPUBackend>>> intermediate_;
+  std::vector<OutputDesc> first_output_desc_;
+};
+
+}  // namespace exec2
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_EXECUTOR_EXECUTOR2_SAMPLE_MAJOR_CHAIN_H_
@@ -161,6 +161,58 @@ class StreamAssignment<StreamPolicy::PerBackend> {
   bool has_mixed_ = false;
 };
 
+/** Whether the node can use a different stream in each iteration. */
+inline bool CanCycleStreams(const ExecNode *node) {
+  return node->op && node->op->GetSpec().GetSchemaOrDefault().IsStreamSafe();
+}
+
+/** A stream policy where the stream-safe operators cycle through several sets of streams.
+ *
+ * The streams are assigned as in the PerBackend policy, but there are `num_sets` copies of them.
+ * The operators marked as StreamSafe in their schema run consecutive iterations on consecutive
+ * sets, so that the GPU work of one iteration doesn't queue up behind the previous one.
+ * The remaining operators always use the first set. The data passed between the streams is
+ * synchronized by the executor, as with any other policy.
+ *
+ * Example, 2 sets - GPU operator "a" is stream-safe, "b" is not
+ * ```
+ * iteration: 0  1  2  3
+ * a:         0  1  0  1
+ * b:         0  0  0  0
+ * ```
+ */
+template <>
+class StreamAssignment<StreamPolicy::PerIteration> {
+ public:
+  explicit StreamAssignment(ExecGraph &graph, int num_sets = 2)
+  : per_backend_(graph), num_sets_(std::max(num_sets, 1)) {}
+
+  /** Returns the stream index for the first iteration. */
+  std::optional<int> operator[](const ExecNode *node) const {
+    return per_backend_[node];
+  }
+
+  /** Returns the stream index for the given iteration. */
+  std::optional<int> operator()(const ExecNode *node, int64_t iteration) const {
+    auto idx = per_backend_[node];
+    if (idx.has_value() && CanCycleStreams(node))
+      *idx += (iteration % num_sets_) * per_backend_.NumStreams();
+    return idx;
+  }
+
+  int NumStreams() const {
+    return per_backend_.NumStreams() * num_sets_;
+  }
+
+  int NumSets() const {
+    return num_sets_;
+  }
+
+ private:
+  StreamAssignment<StreamPolicy::PerBackend> per_backend_;
+  int num_sets_ = 1;
+};
+
 /** Implements per-operator stream assignment.
  *
  * This policy implements stream assingment such that independent GPU/Mixed operators get
@@ -53,6 +53,19 @@ DALI_REGISTER_OPERATOR(StreamAssignmentDummyOp, StreamAssignmentDummyOp<CPUBacke
 DALI_REGISTER_OPERATOR(StreamAssignmentDummyOp, StreamAssignmentDummyOp<MixedBackend>, Mixed);
 DALI_REGISTER_OPERATOR(StreamAssignmentDummyOp, StreamAssignmentDummyOp<GPUBackend>, GPU);
 
+DALI_SCHEMA(StreamAssignmentStreamSafeOp)
+  .NumInput(0, 999)
+  .InputDevice(0, 999, InputDevice::Any)
+  .NumOutput(0)
+  .AdditionalOutputsFn([](const OpSpec &spec) {
+    return spec.NumOutput();
+  })
+  .StreamSafe();
+
+DALI_REGISTER_OPERATOR(StreamAssignmentStreamSafeOp, StreamAssignmentDummyOp<CPUBackend>, CPU);
+DALI_REGISTER_OPERATOR(StreamAssignmentStreamSafeOp, StreamAssignmentDummyOp<MixedBackend>, Mixed);
+DALI_REGISTER_OPERATOR(StreamAssignmentStreamSafeOp, StreamAssignmentDummyOp<GPUBackend>, GPU);
+
 
 template <typename Backend>
 class StreamAssignmentMetaOp : public Operator<Backend> {
@@ -101,6 +114,13 @@ OpSpec SpecMixed() {
   return SpecDev("mixed");
 }
 
+OpSpec SpecStreamSafeDev(const std::string &device) {
+  return OpSpec("StreamAssignmentStreamSafeOp")
+    .AddArg("device", device)
+    .AddArg("num_threads", 1)
+    .AddArg("max_batch_size", 1);
+}
+
 
 OpSpec SpecMetaDev(const std::string &device) {
   return OpSpec("StreamAssignmentMetaOp")
@@ -285,6 +305,49 @@ TEST(Exec2Test, StreamAssignment_OperOperator_GPU2CPU) {
   TestGPU2CPUAssignment<StreamPolicy::PerOperator>();
 }
 
+TEST(Exec2Test, StreamAssignment_PerIteration_GPU2CPU) {
+  TestGPU2CPUAssignment<StreamPolicy::PerIteration>();
+}
+
+TEST(Exec2Test, StreamAssignment_PerIteration) {
+  graph::OpGraph::Builder b;
+  b.Add("a",
+        SpecCPU()
+        .AddOutput("a->b", "cpu"));
+  b.Add("b",
+        SpecStreamSafeDev("mixed")
+        .AddInput("a->b", "cpu")
+        .AddOutput("b->c", "gpu"));
+  b.Add("c",
+        SpecStreamSafeDev("gpu")
+        .AddInput("b->c", "gpu")
+        .AddOutput("c->d", "gpu"));
+  b.Add("d",
+        SpecGPU()
+        .AddInput("c->d", "gpu")
+        .AddOutput("d->out", "gpu"));
+  b.AddOutput("d->out_gpu");
+  auto g = std::move(b).GetGraph(true);
+  ExecGraph eg;
+  eg.Lower(g);
+
+  StreamAssignment<StreamPolicy::PerIteration> assignment(eg, 3);
+  auto map = MakeNodeMap(eg);
+  EXPECT_EQ(assignment.NumStreams(), 6);
+  EXPECT_EQ(assignment.NumSets(), 3);
+  EXPECT_EQ(assignment[map["a"]], std::nullopt);
+  EXPECT_EQ(assignment[map["b"]], 0);
+  EXPECT_EQ(assignment[map["c"]], 1);
+  EXPECT_EQ(assignment[map["d"]], 1);
+  for (int64_t i = 0; i < 7; i++) {
+    int set = i % 3;
+    EXPECT_EQ(assignment(map["a"], i), std::nullopt);
+    EXPECT_EQ(assignment(map["b"], i), 0 + 2 * set);
+    EXPECT_EQ(assignment(map["c"], i), 1 + 2 * set);
+    EXPECT_EQ(assignment(map["d"], i), 1) << "Not stream-safe - the stream must not change";
+  }
+}
+
 TEST(Exec2Test, StreamAssignment_PerOperator_1) {
   ExecGraph eg;
   /*
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cstdlib>
 #include <memory>
 #include <sstream>
 #include <utility>
@@ -34,6 +36,7 @@ auto MakeExec2Config(int batch_size, int num_thread, int device_id,
   exec2::Executor2::Config cfg{};
   cfg.async_output = false;
   cfg.set_affinity = set_affinity;
+  cfg.stream_priority = default_cuda_stream_priority;
   cfg.thread_pool_threads = num_thread;
   cfg.operator_threads = num_thread;
   if (device_id != CPU_ONLY_DEVICE_ID)
@@ -44,6 +47,10 @@ auto MakeExec2Config(int batch_size, int num_thread, int device_id,
   cfg.queue_policy = exec2::QueueDepthPolicy::Legacy;
   cfg.stream_policy = exec2::StreamPolicy::PerBackend;
   cfg.concurrency = exec2::OperatorConcurrency::Backend;
+  if (const char *replicas = getenv("DALI_EXEC2_OPERATOR_REPLICAS"))
+    cfg.operator_replicas = std::max(atoi(replicas), 1);
+  if (const char *sample_major = getenv("DALI_EXEC2_SAMPLE_MAJOR"))
+    cfg.sample_major_chains = atoi(sample_major) != 0;
   return cfg;
 }
 
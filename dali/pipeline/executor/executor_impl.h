@@ -208,6 +208,7 @@ class DLL_PUBLIC Executor : public ExecutorBase, public QueuePolicy {
             out_size = out.nbytes();
             reserved_size = out.capacity();
             GetMaxSizes(out, max_out_size, max_reserved_size);
+            stats[i].pinned = out.is_pinned();
           } else {
             auto &out = ws.Output<GPUBackend>(i);
             out_size = out.nbytes();
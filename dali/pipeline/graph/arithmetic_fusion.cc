@@ -0,0 +1,199 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/graph/arithmetic_fusion.h"
+#include <cctype>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dali {
+namespace graph {
+
+namespace {
+
+constexpr const char *kArithmeticOp = "ArithmeticGenericOp";
+/** The maximum number of inputs of ArithmeticGenericOp, as declared in its schema. */
+constexpr int kMaxInputs = 64;
+
+bool IsRealType(const std::string &type_name) {
+  return type_name == "float16" || type_name == "float32" || type_name == "float64";
+}
+
+/** Renumbers the inputs and constants of an expression description.
+ *
+ * The syntax is described in the schema of ArithmeticGenericOp. The input `&i` is replaced with
+ * `&input_map[i]` or, if the entry is negative, with `subexpr`. The index of a constant is
+ * shifted by `int_offset` or `real_offset`, depending on its type.
+ *
+ * @return false if the description is malformed - the operator reports the error, then.
+ */
+bool RewriteExpression(std::string &out, const std::string &expr,
+                       const std::vector<int> &input_map, const std::string &subexpr,
+                       int int_offset, int real_offset) {
+  out.clear();
+  size_t pos = 0;
+  auto parse_uint = [&](int &value) {
+    size_t start = pos;
+    while (pos < expr.size() && std::isdigit(expr[pos]))
+      pos++;
+    if (pos == start)
+      return false;
+    value = std::stoi(expr.substr(start, pos - start));
+    return true;
+  };
+
+  while (pos < expr.size()) {
+    char c = expr[pos++];
+    if (c == '&') {
+      int idx;
+      if (!parse_uint(idx) || idx >= static_cast<int>(input_map.size()))
+        return false;
+      if (input_map[idx] < 0)
+        out += subexpr;
+      else
+        out += "&" + std::to_string(input_map[idx]);
+    } else if (c == '$') {
+      int idx;
+      if (!parse_uint(idx) || pos >= expr.size() || expr[pos] != ':')
+        return false;
+      size_t type_start = ++pos;
+      while (pos < expr.size() && std::isalnum(expr[pos]))
+        pos++;
+      std::string type_name = expr.substr(type_start, pos - type_start);
+      idx += IsRealType(type_name) ? real_offset : int_offset;
+      out += "$" + std::to_string(idx) + ":" + type_name;
+    } else {
+      out += c;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+std::vector<T> GetConstants(const OpSpec &spec, const char *arg_name) {
+  return spec.HasArgument(arg_name) ? spec.GetRepeatedArgument<T>(arg_name) : std::vector<T>{};
+}
+
+class ArithmeticFusion {
+ public:
+  explicit ArithmeticFusion(OpGraph &graph) : graph_(graph) {}
+
+  int Run() {
+    // the graph is modified while processing the operators - collect them first
+    std::vector<OpNode *> ops;
+    for (auto &op : graph_.OpNodes()) {
+      if (op.spec.SchemaName() == kArithmeticOp)
+        ops.push_back(&op);
+    }
+
+    // The operators are visited in topological order, so the producers have already absorbed
+    // their own producers when they're merged into the consumer. Only the producers (which
+    // precede the current operator) are removed.
+    int removed = 0;
+    for (auto *op : ops) {
+      for (int i = 0; i < static_cast<int>(op->inputs.size()); i++) {
+        if (CanFuse(*op, i) && Fuse(*op, i)) {
+          removed++;
+          i = -1;  // the inputs have changed - start over
+        }
+      }
+    }
+    return removed;
+  }
+
+ private:
+  static bool CanFuse(const OpNode &consumer, int input_idx) {
+    const DataNode *data = consumer.inputs[input_idx];
+    if (!data || data->pipeline_output || data->consumers.size() != 1)
+      return false;
+    const OpNode *producer = data->producer.op;
+    return producer && !producer->keep &&
+           producer->spec.SchemaName() == kArithmeticOp &&
+           producer->op_type == consumer.op_type &&
+           producer->outputs.size() == 1;
+  }
+
+  bool Fuse(OpNode &consumer, int input_idx) {
+    const OpSpec &cspec = consumer.spec;
+    OpNode &producer = *consumer.inputs[input_idx]->producer.op;
+    const OpSpec &pspec = producer.spec;
+
+    // The consumer's inputs go first, the producer's inputs are appended; duplicates are merged
+    std::vector<std::pair<std::string, std::string>> inputs;
+    auto add_input = [&](const OpSpec &spec, int i) {
+      for (int j = 0; j < static_cast<int>(inputs.size()); j++) {
+        if (inputs[j].first == spec.InputName(i) && inputs[j].second == spec.InputDevice(i))
+          return j;
+      }
+      inputs.emplace_back(spec.InputName(i), spec.InputDevice(i));
+      return static_cast<int>(inputs.size()) - 1;
+    };
+    std::vector<int> consumer_map(cspec.NumInput()), producer_map(pspec.NumInput());
+    for (int i = 0; i < cspec.NumInput(); i++)
+      consumer_map[i] = i == input_idx ? -1 : add_input(cspec, i);
+    for (int i = 0; i < pspec.NumInput(); i++)
+      producer_map[i] = add_input(pspec, i);
+    if (static_cast<int>(inputs.size()) > kMaxInputs)
+      return false;
+
+    auto integers = GetConstants<int>(cspec, "integer_constants");
+    auto reals = GetConstants<float>(cspec, "real_constants");
+    std::string subexpr, expr;
+    if (!RewriteExpression(subexpr, pspec.GetArgument<std::string>("expression_desc"),
+                           producer_map, {}, integers.size(), reals.size()))
+      return false;
+    if (!RewriteExpression(expr, cspec.GetArgument<std::string>("expression_desc"),
+                           consumer_map, subexpr, 0, 0))
+      return false;
+    for (int x : GetConstants<int>(pspec, "integer_constants"))
+      integers.push_back(x);
+    for (float x : GetConstants<float>(pspec, "real_constants"))
+      reals.push_back(x);
+
+    OpSpec fused(kArithmeticOp);
+    for (auto &arg : cspec.Arguments()) {
+      auto name = arg->get_name();
+      if (name != "expression_desc" && name != "integer_constants" && name != "real_constants")
+        fused.SetInitializedArg(name, arg);
+    }
+    fused.AddArg("expression_desc", expr);
+    if (!integers.empty())
+      fused.AddArg("integer_constants", integers);
+    if (!reals.empty())
+      fused.AddArg("real_constants", reals);
+    for (auto &[name, device] : inputs)
+      fused.AddInput(name, device);
+    for (int o = 0; o < cspec.NumOutput(); o++)
+      fused.AddOutput(cspec.OutputName(o), cspec.OutputDevice(o));
+
+    std::string intermediate = consumer.inputs[input_idx]->name;
+    std::string producer_name = producer.instance_name;
+    graph_.SetSpec(consumer, std::move(fused));
+    graph_.EraseOp(producer_name);
+    graph_.EraseData(intermediate);
+    return true;
+  }
+
+  OpGraph &graph_;
+};
+
+}  // namespace
+
+int FuseArithmeticExpressions(OpGraph &graph) {
+  return ArithmeticFusion(graph).Run();
+}
+
+}  // namespace graph
+}  // namespace dali
@@ -0,0 +1,46 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_GRAPH_ARITHMETIC_FUSION_H_
+#define DALI_PIPELINE_GRAPH_ARITHMETIC_FUSION_H_
+
+#include "dali/core/api_helper.h"
+#include "dali/pipeline/graph/op_graph2.h"
+
+namespace dali {
+namespace graph {
+
+/** Merges chains of arithmetic operators into single expressions.
+ *
+ * Each arithmetic operation in Python (e.g. `a * b + c`) becomes a separate `ArithmeticGenericOp`,
+ * which materializes its result in a full batch. When the result of such an operator is used
+ * only by another `ArithmeticGenericOp` with the same backend, the producer's expression is
+ * substituted for the consumer's input and the producer is removed. The tensor inputs and
+ * the constants are renumbered accordingly.
+ *
+ * The operators are not merged when:
+ * - the intermediate result is a pipeline output or has other consumers,
+ * - the producer is marked with `preserve`,
+ * - the merged operator would have more inputs than `ArithmeticGenericOp` supports.
+ *
+ * The graph must be sorted. It remains sorted after the operation.
+ *
+ * @return The number of removed operators
+ */
+DLL_PUBLIC int FuseArithmeticExpressions(OpGraph &graph);
+
+}  // namespace graph
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_GRAPH_ARITHMETIC_FUSION_H_
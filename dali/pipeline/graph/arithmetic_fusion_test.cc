@@ -0,0 +1,114 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "dali/core/int_literals.h"
+#include "dali/pipeline/graph/arithmetic_fusion.h"
+
+namespace dali {
+namespace graph {
+namespace test {
+
+namespace {
+
+OpSpec ArithmSpec(const std::string &expr, const std::vector<std::string> &inputs,
+                  const std::string &output, const std::string &device = "cpu") {
+  OpSpec spec("ArithmeticGenericOp");
+  spec.AddArg("device", device);
+  spec.AddArg("expression_desc", expr);
+  for (auto &in : inputs)
+    spec.AddInput(in, device);
+  spec.AddOutput(output, device);
+  return spec;
+}
+
+}  // namespace
+
+TEST(ArithmeticFusionTest, Chain) {
+  OpGraph::Builder b;
+  // ((a + 1.5) * b - 2) * a
+  b.Add("add", ArithmSpec("add(&0 $0:float32)", { "a", "b" }, "add")
+               .AddArg("real_constants", std::vector<float>{1.5f}));
+  b.Add("mul", ArithmSpec("mul(&1 &0)", { "b", "add" }, "mul"));
+  b.Add("sub", ArithmSpec("sub(&0 $0:int32)", { "mul" }, "sub")
+               .AddArg("integer_constants", std::vector<int>{2}));
+  b.Add("mul2", ArithmSpec("mul(&0 &1)", { "sub", "a" }, "out"));
+  b.AddOutput("out_cpu");
+  OpGraph g = std::move(b).GetGraph(true);
+
+  EXPECT_EQ(FuseArithmeticExpressions(g), 3);
+  ASSERT_EQ(g.OpNodes().size(), 1_uz);
+  auto &op = g.OpNodes().front();
+  EXPECT_EQ(op.instance_name, "mul2");
+  EXPECT_EQ(op.spec.GetArgument<std::string>("expression_desc"),
+            "mul(sub(mul(add(&0 $0:float32) &1) $0:int32) &0)");
+  EXPECT_EQ(op.spec.GetRepeatedArgument<int>("integer_constants"), std::vector<int>{2});
+  EXPECT_EQ(op.spec.GetRepeatedArgument<float>("real_constants"), std::vector<float>{1.5f});
+  ASSERT_EQ(op.spec.NumInput(), 2);
+  EXPECT_EQ(op.spec.Input(0), "a_cpu");
+  EXPECT_EQ(op.spec.Input(1), "b_cpu");
+  ASSERT_EQ(op.inputs.size(), 2_uz);
+  EXPECT_EQ(op.inputs[0], g.GetData("a_cpu"));
+  EXPECT_EQ(g.GetData("mul_cpu"), nullptr);
+  EXPECT_EQ(g.DataNodes().size(), 3_uz);
+}
+
+TEST(ArithmeticFusionTest, ConstantIndices) {
+  OpGraph::Builder b;
+  b.Add("p", ArithmSpec("add(&0 mul($0:int32 $0:float32))", { "a" }, "p")
+             .AddArg("integer_constants", std::vector<int>{1})
+             .AddArg("real_constants", std::vector<float>{2}));
+  b.Add("c", ArithmSpec("sub(div(&0 $0:float32) $0:int64)", { "p" }, "c")
+             .AddArg("integer_constants", std::vector<int>{3})
+             .AddArg("real_constants", std::vector<float>{4}));
+  b.AddOutput("c_cpu");
+  OpGraph g = std::move(b).GetGraph(true);
+
+  EXPECT_EQ(FuseArithmeticExpressions(g), 1);
+  auto *op = g.GetOp("c");
+  ASSERT_NE(op, nullptr);
+  EXPECT_EQ(op->spec.GetArgument<std::string>("expression_desc"),
+            "sub(div(add(&0 mul($1:int32 $1:float32)) $0:float32) $0:int64)");
+  EXPECT_EQ(op->spec.GetRepeatedArgument<int>("integer_constants"), (std::vector<int>{3, 1}));
+  EXPECT_EQ(op->spec.GetRepeatedArgument<float>("real_constants"),
+            (std::vector<float>{4, 2}));
+}
+
+TEST(ArithmeticFusionTest, NoFusion) {
+  OpGraph::Builder b;
+  // used twice
+  b.Add("shared", ArithmSpec("add(&0 &1)", { "a", "b" }, "shared"));
+  b.Add("c1", ArithmSpec("minus(&0)", { "shared" }, "c1"));
+  b.Add("c2", ArithmSpec("plus(&0)", { "shared" }, "c2"));
+  // pipeline output
+  b.Add("out", ArithmSpec("add(&0 &1)", { "a", "b" }, "out"));
+  b.Add("c3", ArithmSpec("minus(&0)", { "out" }, "c3"));
+  // a different backend
+  b.Add("cpu", ArithmSpec("add(&0 &1)", { "a", "b" }, "cpu"));
+  OpSpec gpu_spec = ArithmSpec("minus(&0)", {}, "c4", "gpu");
+  gpu_spec.AddInput("cpu", "cpu");
+  b.Add("c4", gpu_spec);
+  for (auto *out : { "c1_cpu", "c2_cpu", "out_cpu", "c3_cpu", "c4_gpu" })
+    b.AddOutput(out);
+  OpGraph g = std::move(b).GetGraph(true);
+
+  EXPECT_EQ(FuseArithmeticExpressions(g), 0);
+  EXPECT_EQ(g.OpNodes().size(), 7_uz);
+}
+
+}  // namespace test
+}  // namespace graph
+}  // namespace dali
@@ -0,0 +1,199 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/graph/color_fusion.h"
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "dali/pipeline/operator/op_schema.h"
+
+namespace dali {
+namespace graph {
+
+namespace {
+
+constexpr const char *kChainOp = "ColorTransformChain";
+
+/** The parameters of a stage of ColorTransformChain - named like in the original operators */
+constexpr const char *kStageParams[] = {
+  "hue", "saturation", "value", "brightness", "brightness_shift", "contrast", "contrast_center"
+};
+
+bool IsColorOp(const std::string &schema_name) {
+  static const std::unordered_set<std::string> ops = {
+    "Hsv", "Hue", "Saturation", "ColorTwist", "Brightness", "Contrast", "BrightnessContrast"
+  };
+  return ops.count(schema_name);
+}
+
+bool IsHsvOp(const std::string &schema_name) {
+  return schema_name == "Hsv" || schema_name == "Hue" || schema_name == "Saturation" ||
+         schema_name == "ColorTwist";
+}
+
+std::string StageArgName(const std::string &name, int stage) {
+  return name + "_" + std::to_string(stage);
+}
+
+/** A color operator or a stage of a chain, with the arguments renamed to the original ones */
+struct Stage {
+  std::string op;
+  std::vector<std::pair<std::string, float>> args;
+  std::vector<std::pair<std::string, std::string>> arg_inputs;  // argument -> input name
+};
+
+class ColorFusion {
+ public:
+  explicit ColorFusion(OpGraph &graph) : graph_(graph) {}
+
+  int Run() {
+    auto *chain_schema = SchemaRegistry::TryGetSchema(kChainOp);
+    if (!chain_schema)
+      return 0;  // no operators registered
+    while (chain_schema->HasArgument(StageArgName(kStageParams[0], max_stages_), true))
+      max_stages_++;
+
+    // the graph is modified while processing the operators - collect them first
+    std::vector<OpNode *> ops;
+    for (auto &op : graph_.OpNodes()) {
+      if (op.op_type == OpType::GPU && IsColorOrChain(op.spec.SchemaName()))
+        ops.push_back(&op);
+    }
+
+    // As in arithmetic fusion, the operators are visited in topological order, so the producer
+    // has already absorbed its own producers; only the preceding operators are removed.
+    int removed = 0;
+    for (auto *op : ops) {
+      while (TryFuse(*op))
+        removed++;
+    }
+    return removed;
+  }
+
+ private:
+  static bool IsColorOrChain(const std::string &schema_name) {
+    return schema_name == kChainOp || IsColorOp(schema_name);
+  }
+
+  /** Gets the stages of a color operator or a chain; returns false if they can't be merged. */
+  static bool GetStages(std::vector<Stage> &stages, const OpSpec &spec) {
+    bool is_chain = spec.SchemaName() == kChainOp;
+    std::vector<std::string> ops = is_chain
+        ? spec.GetRepeatedArgument<std::string>("stages")
+        : std::vector<std::string>{ spec.SchemaName() };
+
+    // any other argument (e.g. `random_args`) has no counterpart in the chain
+    for (auto &arg : spec.Arguments()) {
+      const std::string &name = arg->get_name();
+      if (OpSchema::Default().HasArgument(name, true) ||
+          name == "dtype" || name == "image_type" || name == "stages")
+        continue;
+      bool is_param = false;
+      for (int s = 0; s < static_cast<int>(ops.size()) && !is_param; s++) {
+        for (const char *param : kStageParams)
+          is_param |= name == (is_chain ? StageArgName(param, s) : param);
+      }
+      if (!is_param)
+        return false;
+    }
+
+    for (int s = 0; s < static_cast<int>(ops.size()); s++) {
+      Stage stage;
+      stage.op = ops[s];
+      for (const char *param : kStageParams) {
+        std::string name = is_chain ? StageArgName(param, s) : param;
+        if (spec.HasTensorArgument(name))
+          stage.arg_inputs.emplace_back(param, spec.InputName(spec.ArgumentInputIdx(name)));
+        else if (spec.HasArgument(name))
+          stage.args.emplace_back(param, spec.GetArgument<float>(name));
+      }
+      stages.push_back(std::move(stage));
+    }
+    return true;
+  }
+
+  bool TryFuse(OpNode &consumer) {
+    const OpSpec &cspec = consumer.spec;
+    if (cspec.NumRegularInput() != 1 || consumer.inputs.empty())
+      return false;
+    const DataNode *data = consumer.inputs[0];
+    if (!data || data->pipeline_output || data->consumers.size() != 1)
+      return false;
+    OpNode *producer = data->producer.op;
+    if (!producer || producer->keep || producer->op_type != OpType::GPU ||
+        producer->outputs.size() != 1 || !IsColorOrChain(producer->spec.SchemaName()))
+      return false;
+    const OpSpec &pspec = producer->spec;
+
+    // Rounding and saturation of the intermediate result can't be expressed in the chain.
+    DALIDataType intermediate_type = DALI_NO_TYPE;
+    if (!pspec.TryGetArgument(intermediate_type, "dtype") || intermediate_type != DALI_FLOAT)
+      return false;
+
+    std::vector<Stage> stages;
+    if (!GetStages(stages, pspec) || !GetStages(stages, cspec))
+      return false;
+    if (static_cast<int>(stages.size()) > max_stages_)
+      return false;
+    bool has_hsv = false;
+    for (auto &stage : stages)
+      has_hsv |= IsHsvOp(stage.op);
+    if (!has_hsv)
+      return false;
+
+    OpSpec fused(kChainOp);
+    for (auto &arg : cspec.Arguments()) {
+      if (OpSchema::Default().HasArgument(arg->get_name(), true))
+        fused.SetInitializedArg(arg->get_name(), arg);
+    }
+    // The consumer sees float data, so that's its output type, unless specified otherwise.
+    DALIDataType output_type = DALI_FLOAT;
+    cspec.TryGetArgument(output_type, "dtype");
+    fused.AddArg("dtype", output_type);
+    std::vector<std::string> stage_ops;
+    for (auto &stage : stages)
+      stage_ops.push_back(stage.op);
+    fused.AddArg("stages", stage_ops);
+
+    fused.AddInput(pspec.InputName(0), pspec.InputDevice(0));
+    for (int s = 0; s < static_cast<int>(stages.size()); s++) {
+      for (auto &[name, value] : stages[s].args)
+        fused.AddArg(StageArgName(name, s), value);
+      for (auto &[name, input] : stages[s].arg_inputs)
+        fused.AddArgumentInput(StageArgName(name, s), input);
+    }
+    for (int o = 0; o < cspec.NumOutput(); o++)
+      fused.AddOutput(cspec.OutputName(o), cspec.OutputDevice(o));
+
+    std::string intermediate = data->name;
+    std::string producer_name = producer->instance_name;
+    graph_.SetSpec(consumer, std::move(fused));
+    graph_.EraseOp(producer_name);
+    graph_.EraseData(intermediate);
+    return true;
+  }
+
+  OpGraph &graph_;
+  int max_stages_ = 0;
+};
+
+}  // namespace
+
+int FuseColorTransforms(OpGraph &graph) {
+  return ColorFusion(graph).Run();
+}
+
+}  // namespace graph
+}  // namespace dali
@@ -0,0 +1,50 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_GRAPH_COLOR_FUSION_H_
+#define DALI_PIPELINE_GRAPH_COLOR_FUSION_H_
+
+#include "dali/core/api_helper.h"
+#include "dali/pipeline/graph/op_graph2.h"
+
+namespace dali {
+namespace graph {
+
+/** Merges chains of GPU color operators into single `ColorTransformChain` operators.
+ *
+ * Hsv, Hue, Saturation, ColorTwist, Brightness, Contrast and BrightnessContrast apply an affine
+ * transform to the color of each pixel. When the result of one of them is used only by
+ * another one, the two are replaced with a `ColorTransformChain`, which composes the transforms
+ * per sample and traverses the data once. The arguments (also the argument inputs) of
+ * the merged operators become the arguments of the respective stages of the chain.
+ *
+ * The operators are merged only if it doesn't change the result:
+ * - the intermediate result is of type float - otherwise it would be rounded and clamped,
+ * - it's not a pipeline output and it has no other consumers,
+ * - the producer is not marked with `preserve`,
+ * - none of the operators uses arguments that the chain doesn't support (e.g. `random_args`),
+ * - there is at least one Hsv/Hue/Saturation/ColorTwist in the chain - the chain works only
+ *   with 3-channel images,
+ * - the chain doesn't exceed the maximum number of stages.
+ *
+ * The graph must be sorted. It remains sorted after the operation.
+ *
+ * @return The number of removed operators
+ */
+DLL_PUBLIC int FuseColorTransforms(OpGraph &graph);
+
+}  // namespace graph
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_GRAPH_COLOR_FUSION_H_
@@ -0,0 +1,97 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "dali/core/int_literals.h"
+#include "dali/pipeline/graph/color_fusion.h"
+
+namespace dali {
+namespace graph {
+namespace test {
+
+namespace {
+
+OpSpec ColorSpec(const std::string &schema, const std::string &input, const std::string &output,
+                 const std::string &device = "gpu") {
+  OpSpec spec(schema);
+  spec.AddArg("device", device);
+  spec.AddInput(input, device);
+  spec.AddOutput(output, device);
+  return spec;
+}
+
+}  // namespace
+
+TEST(ColorFusionTest, Chain) {
+  OpGraph::Builder b;
+  b.Add("hue", ColorSpec("Hue", "images", "hue")
+               .AddArg("hue", 30.0f)
+               .AddArg("dtype", DALI_FLOAT));
+  b.Add("sat", ColorSpec("Saturation", "hue", "sat")
+               .AddArgumentInput("saturation", "sat_arg")
+               .AddArg("dtype", DALI_FLOAT));
+  b.Add("bc", ColorSpec("BrightnessContrast", "sat", "out")
+              .AddArg("contrast", 1.5f)
+              .AddArg("dtype", DALI_UINT8));
+  b.AddOutput("out_gpu");
+  OpGraph g = std::move(b).GetGraph(true);
+
+  EXPECT_EQ(FuseColorTransforms(g), 2);
+  ASSERT_EQ(g.OpNodes().size(), 1_uz);
+  auto &op = g.OpNodes().front();
+  EXPECT_EQ(op.instance_name, "bc");
+  const OpSpec &spec = op.spec;
+  EXPECT_EQ(spec.SchemaName(), "ColorTransformChain");
+  EXPECT_EQ(spec.GetRepeatedArgument<std::string>("stages"),
+            (std::vector<std::string>{ "Hue", "Saturation", "BrightnessContrast" }));
+  EXPECT_EQ(spec.GetArgument<DALIDataType>("dtype"), DALI_UINT8);
+  EXPECT_EQ(spec.GetArgument<float>("hue_0"), 30.0f);
+  EXPECT_TRUE(spec.HasTensorArgument("saturation_1"));
+  EXPECT_EQ(spec.GetArgument<float>("contrast_2"), 1.5f);
+  EXPECT_FALSE(spec.ArgumentDefined("contrast_center_2"));
+  ASSERT_EQ(spec.NumRegularInput(), 1);
+  EXPECT_EQ(spec.Input(0), "images_gpu");
+  EXPECT_EQ(g.GetData("hue_gpu"), nullptr);
+  EXPECT_EQ(g.GetData("sat_gpu"), nullptr);
+}
+
+TEST(ColorFusionTest, NoFusion) {
+  OpGraph::Builder b;
+  // the intermediate result is rounded to the input type
+  b.Add("hue", ColorSpec("Hue", "images", "hue"));
+  b.Add("sat", ColorSpec("Saturation", "hue", "sat"));
+  // the brightness is drawn by the operator
+  b.Add("random", ColorSpec("Brightness", "sat", "random")
+                  .AddArg("random_args", std::vector<std::string>{ "brightness=uniform(0, 2)" })
+                  .AddArg("dtype", DALI_FLOAT));
+  b.Add("hsv", ColorSpec("Hsv", "random", "hsv"));
+  // only brightness and contrast - the number of channels is not restricted
+  b.Add("b", ColorSpec("Brightness", "hsv", "b").AddArg("dtype", DALI_FLOAT));
+  b.Add("c", ColorSpec("Contrast", "b", "c"));
+  // CPU
+  b.Add("cpu_hue", ColorSpec("Hue", "cpu_images", "cpu_hue", "cpu").AddArg("dtype", DALI_FLOAT));
+  b.Add("cpu_sat", ColorSpec("Saturation", "cpu_hue", "cpu_sat", "cpu"));
+  for (auto *out : { "c_gpu", "cpu_sat_cpu" })
+    b.AddOutput(out);
+  OpGraph g = std::move(b).GetGraph(true);
+
+  EXPECT_EQ(FuseColorTransforms(g), 0);
+  EXPECT_EQ(g.OpNodes().size(), 8_uz);
+}
+
+}  // namespace test
+}  // namespace graph
+}  // namespace dali
@@ -0,0 +1,160 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/graph/cse.h"
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "dali/pipeline/operator/op_schema.h"
+
+namespace dali {
+namespace graph {
+
+namespace {
+
+class CSE {
+ public:
+  explicit CSE(OpGraph &graph) : graph_(graph) {}
+
+  int Run() {
+    // the graph is modified while processing the operators - collect them first
+    std::vector<OpNode *> ops;
+    for (auto &op : graph_.OpNodes())
+      ops.push_back(&op);
+
+    int removed = 0;
+    for (auto *op : ops) {
+      if (!IsCandidate(*op))
+        continue;
+      auto [it, inserted] = visited_.emplace(Key(*op), op);
+      if (!inserted) {
+        Merge(*it->second, *op);
+        removed++;
+      }
+    }
+    return removed;
+  }
+
+ private:
+  static bool IsCandidate(const OpNode &op) {
+    if (op.keep)
+      return false;
+    if (!op.spec.GetSchemaOrDefault().IsStateless())
+      return false;
+    for (auto *out : op.outputs) {
+      if (!out || out->pipeline_output)
+        return false;
+    }
+    for (auto *in : op.inputs) {
+      if (!in)
+        return false;
+    }
+    return true;
+  }
+
+  /** Arguments which don't affect the results of an operator. */
+  static bool IsIgnored(const std::string &arg_name) {
+    return arg_name == "name" || arg_name == "seed" || arg_name == "preserve" ||
+           arg_name == "bytes_per_sample_hint" || arg_name[0] == '_';
+  }
+
+  /** Stringifies an argument. The floating point values are stored exactly. */
+  static std::string ArgValue(Argument &arg) {
+    std::stringstream ss;
+    ss << std::hexfloat;
+    switch (arg.GetTypeId()) {
+      case DALI_FLOAT:
+        ss << arg.Get<float>();
+        break;
+      case DALI_FLOAT64:
+        ss << arg.Get<double>();
+        break;
+      case DALI_FLOAT_VEC:
+        for (float x : arg.Get<std::vector<float>>())
+          ss << x << ",";
+        break;
+      default:
+        return arg.ToString();
+    }
+    return ss.str();
+  }
+
+  /** Creates a string which is equal for operators which compute the same thing. */
+  static std::string Key(const OpNode &op) {
+    const OpSpec &spec = op.spec;
+    std::stringstream ss;
+    ss << spec.SchemaName() << "|" << static_cast<int>(op.op_type) << "|";
+
+    std::vector<std::string> args;
+    for (auto &arg : spec.Arguments()) {
+      if (!IsIgnored(arg->get_name()))
+        args.push_back(arg->get_name() + "=" + ArgValue(*arg));
+    }
+    std::sort(args.begin(), args.end());
+    for (auto &arg : args)
+      ss << arg << ";";
+
+    ss << "|";
+    for (int i = 0; i < spec.NumRegularInput(); i++)
+      ss << op.inputs[i]->name << ";";
+    // the order of argument inputs doesn't matter
+    std::vector<std::string> arg_inputs;
+    for (int i = spec.NumRegularInput(); i < spec.NumInput(); i++)
+      arg_inputs.push_back(spec.ArgumentInputName(i) + "=" + op.inputs[i]->name);
+    std::sort(arg_inputs.begin(), arg_inputs.end());
+    for (auto &arg_input : arg_inputs)
+      ss << arg_input << ";";
+
+    ss << "|";
+    for (auto *out : op.outputs)
+      ss << static_cast<int>(out->device) << ";";
+    return ss.str();
+  }
+
+  /** Redirects the consumers of the outputs of `duplicate` to the outputs of `op`. */
+  void Merge(OpNode &op, OpNode &duplicate) {
+    assert(op.outputs.size() == duplicate.outputs.size());
+    for (size_t o = 0; o < duplicate.outputs.size(); o++) {
+      DataNode *src = op.outputs[o];
+      DataNode *dup = duplicate.outputs[o];
+      for (auto &e : dup->consumers) {
+        e.op->inputs[e.idx] = src;
+        e.op->spec.RenameInput(e.idx, op.spec.OutputName(o));
+        src->consumers.push_back(e);
+      }
+      dup->consumers.clear();
+    }
+
+    std::vector<std::string> outputs;
+    for (auto *out : duplicate.outputs)
+      outputs.push_back(out->name);
+    graph_.EraseOp(duplicate.instance_name);
+    for (auto &name : outputs)
+      graph_.EraseData(name);
+  }
+
+  OpGraph &graph_;
+  std::unordered_map<std::string, OpNode *> visited_;
+};
+
+}  // namespace
+
+int EliminateCommonSubexpressions(OpGraph &graph) {
+  return CSE(graph).Run();
+}
+
+}  // namespace graph
+}  // namespace dali
@@ -0,0 +1,46 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_GRAPH_CSE_H_
+#define DALI_PIPELINE_GRAPH_CSE_H_
+
+#include "dali/core/api_helper.h"
+#include "dali/pipeline/graph/op_graph2.h"
+
+namespace dali {
+namespace graph {
+
+/** Merges the operators which compute the same thing.
+ *
+ * Two operators are equivalent if they have the same schema and backend, the same arguments
+ * and consume the same data nodes. Only operators with a `Stateless` schema are merged - the
+ * outputs of such operators depend only on the inputs and arguments. The consumers of the
+ * outputs of a duplicate are connected to the outputs of the first equivalent operator and
+ * the duplicate is removed. Since the graph is processed in topological order, chains of
+ * duplicates are merged, too.
+ *
+ * An operator is not merged if it's marked with `preserve` or any of its outputs is a pipeline
+ * output. The arguments which don't affect the results (e.g. the instance name, the seed or
+ * memory hints) are not compared.
+ *
+ * The graph must be sorted. It remains sorted after the operation.
+ *
+ * @return The number of removed operators
+ */
+DLL_PUBLIC int EliminateCommonSubexpressions(OpGraph &graph);
+
+}  // namespace graph
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_GRAPH_CSE_H_
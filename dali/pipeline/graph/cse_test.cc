@@ -0,0 +1,111 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include "dali/core/int_literals.h"
+#include "dali/pipeline/graph/cse.h"
+#include "dali/pipeline/operator/op_schema.h"
+
+namespace dali {
+
+DALI_SCHEMA(CSETestStateless)
+  .NumInput(1)
+  .NumOutput(1)
+  .Stateless()
+  .AddOptionalArg("scale", "", 1.0f);
+
+DALI_SCHEMA(CSETestStateful)
+  .NumInput(1)
+  .NumOutput(1);
+
+namespace graph {
+namespace test {
+
+namespace {
+
+OpSpec MakeSpec(const std::string &schema, const std::string &in, const std::string &out,
+                float scale = 1.0f) {
+  OpSpec spec(schema);
+  spec.AddArg("device", "cpu");
+  spec.AddArg("name", out);
+  spec.AddInput(in, "cpu");
+  spec.AddOutput(out, "cpu");
+  if (schema == "CSETestStateless")
+    spec.AddArg("scale", scale);
+  return spec;
+}
+
+}  // namespace
+
+TEST(CSETest, MergeDuplicates) {
+  OpGraph::Builder b;
+  b.Add("src", MakeSpec("CSETestStateful", "in", "src"));
+  b.Add("a1", MakeSpec("CSETestStateless", "src", "a1"));
+  b.Add("a2", MakeSpec("CSETestStateless", "src", "a2"));
+  // the duplicates of the consumers of the merged operators are merged, too
+  b.Add("b1", MakeSpec("CSETestStateless", "a1", "b1", 2));
+  b.Add("b2", MakeSpec("CSETestStateless", "a2", "b2", 2));
+  b.Add("c1", MakeSpec("CSETestStateful", "b1", "c1"));
+  b.Add("c2", MakeSpec("CSETestStateful", "b2", "c2"));
+  b.AddOutput("c1_cpu");
+  b.AddOutput("c2_cpu");
+  OpGraph g = std::move(b).GetGraph(true);
+
+  EXPECT_EQ(EliminateCommonSubexpressions(g), 2);
+  EXPECT_EQ(g.OpNodes().size(), 5_uz);
+  EXPECT_EQ(g.GetOp("a2"), nullptr);
+  EXPECT_EQ(g.GetOp("b2"), nullptr);
+  EXPECT_EQ(g.GetData("a2_cpu"), nullptr);
+  EXPECT_EQ(g.GetData("b2_cpu"), nullptr);
+
+  DataNode *b1 = g.GetData("b1_cpu");
+  ASSERT_NE(b1, nullptr);
+  ASSERT_EQ(b1->consumers.size(), 2_uz);
+  OpNode *c2 = g.GetOp("c2");
+  ASSERT_NE(c2, nullptr);
+  EXPECT_EQ(c2->inputs[0], b1);
+  EXPECT_EQ(c2->spec.Input(0), "b1_cpu");
+  EXPECT_EQ(g.GetData("a1_cpu")->consumers.size(), 1_uz);
+}
+
+TEST(CSETest, KeepDifferent) {
+  OpGraph::Builder b;
+  b.Add("src", MakeSpec("CSETestStateful", "in", "src"));
+  b.Add("a1", MakeSpec("CSETestStateless", "src", "a1", 1));
+  b.Add("a2", MakeSpec("CSETestStateless", "src", "a2", 1.0000001f));
+  b.Add("s1", MakeSpec("CSETestStateful", "src", "s1"));
+  b.Add("s2", MakeSpec("CSETestStateful", "src", "s2"));
+  for (auto *out : { "a1_cpu", "a2_cpu", "s1_cpu", "s2_cpu" })
+    b.AddOutput(out);
+  OpGraph g = std::move(b).GetGraph(true);
+  EXPECT_EQ(EliminateCommonSubexpressions(g), 0);
+  EXPECT_EQ(g.OpNodes().size(), 5_uz);
+}
+
+TEST(CSETest, KeepPipelineOutputs) {
+  OpGraph::Builder b;
+  b.Add("src", MakeSpec("CSETestStateful", "in", "src"));
+  b.Add("a1", MakeSpec("CSETestStateless", "src", "a1"));
+  b.Add("a2", MakeSpec("CSETestStateless", "src", "a2"));
+  b.AddOutput("a1_cpu");
+  b.AddOutput("a2_cpu");
+  OpGraph g = std::move(b).GetGraph(true);
+  EXPECT_EQ(EliminateCommonSubexpressions(g), 0);
+  EXPECT_NE(g.GetOp("a2"), nullptr);
+}
+
+}  // namespace test
+}  // namespace graph
+}  // namespace dali
@@ -121,6 +121,52 @@ int OpGraph::AddOutput(std::string_view name) {
   return outputs_.size() - 1;
 }
 
+void OpGraph::SetSpec(OpNode &op, OpSpec spec) {
+  RemoveDataNodeReferences(op);
+  op.inputs.clear();
+  op.outputs.clear();
+  op.spec = std::move(spec);
+  LinkDataNodes(op);
+}
+
+void OpGraph::LinkDataNodes(OpNode &op_node) {
+  const OpSpec &spec = op_node.spec;
+
+  for (int i = 0; i < spec.NumInput(); i++) {
+    std::string name = spec.Input(i);
+    auto it = name2data_.find(name);
+    DataNode *node;
+    if (it != name2data_.end()) {
+      node = it->second;
+    } else {
+      auto dev = ParseStorageDevice(spec.InputDevice(i));
+      node = &AddData(name, dev);
+    }
+    node->consumers.push_back({ &op_node, i });
+    op_node.inputs.push_back(node);
+  }
+
+  for (int o = 0; o < spec.NumOutput(); o++) {
+    std::string name = spec.Output(o);
+    auto it = name2data_.find(name);
+    DataNode *node;
+    if (it != name2data_.end()) {
+      node = it->second;
+      if (node->producer.op != nullptr) {
+        throw std::invalid_argument(make_string(
+          "The data node \"", name, "\" has more than one producer:"
+          "\n 1: ", node->producer.op->instance_name, ", output ", node->producer.idx,
+          "\n 2: ", op_node.instance_name, ", output ", o));
+      }
+    } else {
+      auto dev = ParseStorageDevice(spec.OutputDevice(o));
+      node = &AddData(std::move(name), dev);
+    }
+    node->producer = { &op_node, o };
+    op_node.outputs.push_back(node);
+  }
+}
+
 /** Implements topological sorting via depth-first search */
 class OpGraph::SortHelper {
  public:
@@ -224,42 +270,7 @@ void OpGraph::Builder::AddOutput(std::string name) {
 
 void OpGraph::Builder::Add(std::string instance_name, OpSpec new_spec) {
   auto &op_node = graph_.AddOp(std::move(instance_name), std::move(new_spec));
-
-  const OpSpec &spec = op_node.spec;
-
-  for (int i = 0; i < spec.NumInput(); i++) {
-    std::string name = spec.Input(i);
-    auto it = graph_.name2data_.find(name);
-    DataNode *node;
-    if (it != graph_.name2data_.end()) {
-      node = it->second;
-    } else {
-      auto dev = ParseStorageDevice(spec.InputDevice(i));
-      node = &graph_.AddData(name, dev);
-    }
-    node->consumers.push_back({ &op_node, i });
-    op_node.inputs.push_back(node);
-  }
-
-  for (int o = 0; o < spec.NumOutput(); o++) {
-    std::string name = spec.Output(o);
-    auto it = graph_.name2data_.find(name);
-    DataNode *node;
-    if (it != graph_.name2data_.end()) {
-      node = it->second;
-      if (node->producer.op != nullptr) {
-        throw std::invalid_argument(make_string(
-          "The data node \"", name, "\" has more than one producer:"
-          "\n 1: ", node->producer.op->instance_name, ", output ", node->producer.idx,
-          "\n 2: ", op_node.instance_name, ", output ", o));
-      }
-    } else {
-      auto dev = ParseStorageDevice(spec.OutputDevice(o));
-      node = &graph_.AddData(std::move(name), dev);
-    }
-    node->producer = { &op_node, o };
-    op_node.outputs.push_back(node);
-  }
+  graph_.LinkDataNodes(op_node);
 }
 
 void OpGraph::Builder::Build(bool prune) {
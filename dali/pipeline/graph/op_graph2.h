@@ -203,6 +203,16 @@ class DLL_PUBLIC OpGraph {
    */
   int AddOutput(std::string_view name);
 
+  /** Replaces the specification of an operator and reconnects it accordingly.
+   *
+   * The operator is removed from the consumers of its current inputs and stops being the producer
+   * of its current outputs. Then it's connected to the inputs and outputs named in the new spec.
+   * Missing data nodes are created. The instance name and the type of the operator don't change.
+   *
+   * @throws std::invalid_argument if an output in the new spec already has a producer.
+   */
+  void SetSpec(OpNode &op, OpSpec spec);
+
   span<const std::string_view> Outputs() const {
     return make_cspan(outputs_);
   }
@@ -226,6 +236,9 @@ class DLL_PUBLIC OpGraph {
 
   void RemoveDataNodeReferences(OpNode &op);
 
+  /** Connects the operator to (possibly new) data nodes, as specified in its spec. */
+  void LinkDataNodes(OpNode &op);
+
   OpNodeList op_nodes_;
   DataNodeList data_nodes_;
   // The maps are keyed with `string_view` to avoid creation of temporary strings for lookup.
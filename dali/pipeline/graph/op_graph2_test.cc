@@ -377,6 +377,61 @@ TEST(NewOpGraphBuilderTest, SortAndPrune) {
   EXPECT_EQ(op2->outputs[1], o1);
 }
 
+TEST(NewOpGraphTest, SetSpec) {
+  /*
+  i0         i0
+  |          |
+  op1        |
+  |     ->   |
+  m0        op2
+  |          |
+  op2        o0
+  |
+  o0
+  */
+  OpSpec spec1("dummy");
+  spec1.AddInput("i0", "cpu");
+  spec1.AddOutput("m0", "cpu");
+
+  OpSpec spec2("dummy");
+  spec2.AddInput("m0", "cpu");
+  spec2.AddOutput("o0", "cpu");
+
+  OpGraph::Builder b;
+  b.Add("op1", spec1);
+  b.Add("op2", spec2);
+  b.AddOutput("o0_cpu");
+  OpGraph g = std::move(b).GetGraph();
+
+  OpSpec new_spec2("dummy2");
+  new_spec2.AddInput("i0", "cpu");
+  new_spec2.AddOutput("o0", "cpu");
+  OpNode *op2 = g.GetOp("op2");
+  ASSERT_NE(op2, nullptr);
+  g.SetSpec(*op2, new_spec2);
+  EXPECT_EQ(op2->spec.SchemaName(), "dummy2");
+
+  DataNode *i0 = g.GetData("i0_cpu");
+  DataNode *m0 = g.GetData("m0_cpu");
+  DataNode *o0 = g.GetData("o0_cpu");
+  ASSERT_NE(i0, nullptr);
+  ASSERT_NE(m0, nullptr);
+  ASSERT_NE(o0, nullptr);
+  ASSERT_EQ(op2->inputs.size(), 1_uz);
+  ASSERT_EQ(op2->outputs.size(), 1_uz);
+  EXPECT_EQ(op2->inputs[0], i0);
+  EXPECT_EQ(op2->outputs[0], o0);
+  EXPECT_EQ(o0->producer.op, op2);
+  ASSERT_EQ(i0->consumers.size(), 2_uz);
+  EXPECT_EQ(i0->consumers[1].op, op2);
+  EXPECT_EQ(i0->consumers[1].idx, 0);
+  EXPECT_TRUE(m0->consumers.empty());
+
+  g.Sort(true);
+  EXPECT_EQ(g.GetOp("op1"), nullptr) << "The operator op1 should have been pruned";
+  EXPECT_EQ(g.GetData("m0_cpu"), nullptr) << "The data node m0 should have been pruned";
+}
+
 }  // namespace test
 }  // namespace graph
 }  // namespace dali
@@ -0,0 +1,202 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/graph/roi_pushdown.h"
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "dali/pipeline/operator/op_schema.h"
+
+namespace dali {
+namespace graph {
+
+namespace {
+
+/** Maps a decoder to its variant with a fixed-size cropping window. */
+const std::unordered_map<std::string, std::string> &CropDecoders() {
+  static const std::unordered_map<std::string, std::string> decoders = {
+    { "decoders__Image", "decoders__ImageCrop" },
+    { "ImageDecoder", "ImageDecoderCrop" },
+    { "experimental__decoders__Image", "experimental__decoders__ImageCrop" },
+  };
+  return decoders;
+}
+
+class RoiPushdown {
+ public:
+  explicit RoiPushdown(OpGraph &graph) : graph_(graph) {}
+
+  int Run() {
+    crop_attr_ = SchemaRegistry::TryGetSchema("CropAttr");
+    if (!crop_attr_)
+      return 0;  // no operators registered
+
+    // the graph is modified while processing the candidates - collect them first
+    std::vector<OpNode *> decoders;
+    for (auto &op : graph_.OpNodes()) {
+      if (CropDecoders().count(op.spec.SchemaName()))
+        decoders.push_back(&op);
+    }
+
+    int rewritten = 0;
+    for (auto *decoder : decoders) {
+      if (TryRewrite(*decoder))
+        rewritten++;
+    }
+    if (rewritten)
+      graph_.Sort(true);
+    return rewritten;
+  }
+
+ private:
+  enum class ArgKind {
+    Window,   // defines the cropping window - moved to the decoder
+    Generic,  // common to all operators
+    Other
+  };
+
+  ArgKind Classify(const std::string &arg_name) const {
+    // every schema has the generic arguments, so check them first
+    if (OpSchema::Default().HasArgument(arg_name, true))
+      return ArgKind::Generic;
+    if (crop_attr_->HasArgument(arg_name, true))
+      return ArgKind::Window;
+    return ArgKind::Other;
+  }
+
+  static bool IsVolumetricArg(const std::string &arg_name) {
+    return arg_name == "crop_d" || arg_name == "crop_pos_z";
+  }
+
+  bool TryRewrite(OpNode &decoder) {
+    if (decoder.keep || decoder.outputs.size() != 1 || !decoder.outputs[0])
+      return false;
+    DataNode &decoded = *decoder.outputs[0];
+    if (decoded.pipeline_output || decoded.consumers.size() != 1)
+      return false;
+    OpNode *crop = decoded.consumers[0].op;
+    if (!crop || crop->keep || decoded.consumers[0].idx != 0 || crop->spec.NumRegularInput() != 1)
+      return false;
+
+    const std::string &crop_schema = crop->spec.SchemaName();
+    bool remove_crop;
+    if (crop_schema == "Crop")
+      remove_crop = true;
+    else if (crop_schema == "CropMirrorNormalize")
+      remove_crop = false;
+    else
+      return false;
+
+    auto *fused_schema = SchemaRegistry::TryGetSchema(CropDecoders().at(decoder.spec.SchemaName()));
+    if (!fused_schema)
+      return false;
+
+    // The fused decoder must support all the arguments of the original one (e.g. it doesn't
+    // support caching).
+    for (auto &arg : decoder.spec.Arguments()) {
+      if (!fused_schema->HasArgument(arg->get_name(), true))
+        return false;
+    }
+    for (auto &arg_input : decoder.spec.ArgumentInputs()) {
+      if (!fused_schema->HasArgument(arg_input.first, true))
+        return false;
+    }
+
+    const OpSpec &crop_spec = crop->spec;
+    bool has_window = false;
+    auto check_crop_arg = [&](const std::string &name) {
+      switch (Classify(name)) {
+        case ArgKind::Window:
+          has_window = true;
+          return !IsVolumetricArg(name);
+        case ArgKind::Generic:
+          return true;
+        default:
+          // A crop outside of the image produces an error with the fused decoder. Any other
+          // argument of Crop changes the result.
+          return name == "out_of_bounds_policy"
+              ? crop_spec.GetArgument<std::string>(name) == "error"
+              : !remove_crop;
+      }
+    };
+    for (auto &arg : crop_spec.Arguments()) {
+      if (!check_crop_arg(arg->get_name()))
+        return false;
+    }
+    for (auto &arg_input : crop_spec.ArgumentInputs()) {
+      if (!check_crop_arg(arg_input.first))
+        return false;
+    }
+    if (!has_window)
+      return false;
+
+    // Create the fused decoder
+    const OpSpec &decoder_spec = decoder.spec;
+    OpSpec fused(fused_schema->name());
+    for (int i = 0; i < decoder_spec.NumRegularInput(); i++)
+      fused.AddInput(decoder_spec.InputName(i), decoder_spec.InputDevice(i));
+    CopyArguments(fused, decoder_spec, [](const std::string &) { return true; });
+    CopyArguments(fused, crop_spec, [&](const std::string &name) {
+      return Classify(name) == ArgKind::Window;
+    });
+    const OpSpec &output_spec = remove_crop ? crop_spec : decoder_spec;
+    fused.AddOutput(output_spec.OutputName(0), output_spec.OutputDevice(0));
+
+    if (remove_crop) {
+      std::string decoded_name = decoded.name;
+      std::string crop_name = crop->instance_name;
+      graph_.EraseOp(crop_name);
+      graph_.SetSpec(decoder, std::move(fused));
+      graph_.EraseData(decoded_name);
+    } else {
+      // Keep the rest of the processing, without the cropping window
+      OpSpec rest(crop_spec.SchemaName());
+      rest.AddInput(crop_spec.InputName(0), crop_spec.InputDevice(0));
+      CopyArguments(rest, crop_spec, [&](const std::string &name) {
+        return Classify(name) != ArgKind::Window;
+      });
+      for (int o = 0; o < crop_spec.NumOutput(); o++)
+        rest.AddOutput(crop_spec.OutputName(o), crop_spec.OutputDevice(o));
+      graph_.SetSpec(decoder, std::move(fused));
+      graph_.SetSpec(*crop, std::move(rest));
+    }
+    return true;
+  }
+
+  /** Copies the arguments and argument inputs, for which the predicate is true. */
+  template <typename Predicate>
+  static void CopyArguments(OpSpec &dst, const OpSpec &src, Predicate &&pred) {
+    for (auto &arg : src.Arguments()) {
+      if (pred(arg->get_name()))
+        dst.SetInitializedArg(arg->get_name(), arg);
+    }
+    for (auto &arg_input : src.ArgumentInputs()) {
+      if (pred(arg_input.first))
+        dst.AddArgumentInput(arg_input.first, src.InputName(arg_input.second));
+    }
+  }
+
+  OpGraph &graph_;
+  const OpSchema *crop_attr_ = nullptr;
+};
+
+}  // namespace
+
+int PushDownDecoderRoi(OpGraph &graph) {
+  return RoiPushdown(graph).Run();
+}
+
+}  // namespace graph
+}  // namespace dali
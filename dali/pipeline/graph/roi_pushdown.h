@@ -0,0 +1,46 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_GRAPH_ROI_PUSHDOWN_H_
+#define DALI_PIPELINE_GRAPH_ROI_PUSHDOWN_H_
+
+#include "dali/core/api_helper.h"
+#include "dali/pipeline/graph/op_graph2.h"
+
+namespace dali {
+namespace graph {
+
+/** Moves the cropping window of crops applied to decoded images into the decoders.
+ *
+ * An image decoder whose only consumer is a `Crop` or a `CropMirrorNormalize` is replaced with
+ * its `...ImageCrop` counterpart, which takes the crop arguments and can decode just the region
+ * of interest. A `Crop` is removed altogether, while a `CropMirrorNormalize` keeps the remaining
+ * processing (mirroring, normalization, layout and type conversion, padding).
+ *
+ * The rewrite is done only if it doesn't change the result:
+ * - the decoded images are not used anywhere else (also not as a pipeline output),
+ * - the crop doesn't use any arguments that the fused decoder doesn't support
+ *   (e.g. `out_of_bounds_policy` other than "error" or a custom output type),
+ * - neither of the operators is marked with `preserve`.
+ *
+ * The graph is sorted (and pruned) again if modified.
+ *
+ * @return The number of rewritten decoders
+ */
+DLL_PUBLIC int PushDownDecoderRoi(OpGraph &graph);
+
+}  // namespace graph
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_GRAPH_ROI_PUSHDOWN_H_
@@ -14,6 +14,7 @@
 
 #include <signal.h>
 #include <cstring>
+#include <algorithm>
 #include <cstdlib>
 #include "dali/pipeline/init.h"
 #include "dali/core/error_handling.h"
@@ -61,6 +62,9 @@ void InitializeBufferPolicies() {
     const double max_factor = Buffer<GPUBackend>::kMaxGrowthFactor;
     Buffer<GPUBackend>::SetGrowthFactor(clamp(atof(factor), 1.0, max_factor));
   }
+  if (const char *limit = std::getenv("DALI_DEVICE_BUFFER_GROW_IN_PLACE_LIMIT")) {
+    Buffer<GPUBackend>::SetGrowInPlaceLimit(std::max(atoll(limit), 0ll));
+  }
 }
 
 void DALIInit(const OpSpec &cpu_allocator,
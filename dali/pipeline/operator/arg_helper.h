@@ -172,9 +172,10 @@ class ArgValue {
       if (orig_constant_sz_ == 1 && expected_len != 1) {
         // broadcast single values to whatever shape, including empty tensors
         data_.resize(std::max(expected_len, 1_i64), data_[0]);
-        view_ = TLV(data_.data(), expected_shape);
+        view_.shape = expected_shape;
+        calculate_pointers(view_.data, static_cast<const T *>(data_.data()), view_.shape);
       } else if (orig_constant_sz_ == 0 && (flags & ArgValue_AllowEmpty)) {
-        view_ = constant_view(nsamples, data_.data(), TensorShape<ndim>{});
+        SetConstantView(nsamples, data_.data(), TensorShape<ndim>{});
       } else {
         if (!is_uniform(expected_shape)) {
           DALI_FAIL(make_string("Can't interpret argument ", arg_name_,
@@ -187,7 +188,7 @@ class ArgValue {
               make_string("Argument \"", arg_name_, "\" expected shape ", expected_sample_sh,
                           " but got ", orig_constant_sz_,
                           " values, which can't be interpreted as the expected shape."));
-        view_ = constant_view(nsamples, data_.data(), expected_sample_sh);
+        SetConstantView(nsamples, data_.data(), expected_sample_sh);
       }
     }
   }
@@ -230,15 +231,15 @@ class ArgValue {
       if (orig_constant_sz_ == 1 && expected_len != 1) {
         // broadcast single values to whatever shape, including empty tensors
         data_.resize(std::max(expected_len, 1_i64), data_[0]);
-        view_ = constant_view(nsamples, data_.data(), expected_shape);
+        SetConstantView(nsamples, data_.data(), expected_shape);
       } else if (orig_constant_sz_ == 0 && (flags & ArgValue_AllowEmpty)) {
-        view_ = constant_view(nsamples, data_.data(), TensorShape<ndim>{});
+        SetConstantView(nsamples, data_.data(), TensorShape<ndim>{});
       } else {
         DALI_ENFORCE(orig_constant_sz_ == volume(expected_shape),
               make_string("Argument \"", arg_name_, "\" expected shape ", expected_shape,
                           " but got ", orig_constant_sz_,
                           " values, which can't be interpreted as the expected shape."));
-        view_ = constant_view(nsamples, data_.data(), expected_shape);
+        SetConstantView(nsamples, data_.data(), expected_shape);
       }
     }
   }
@@ -271,7 +272,7 @@ class ArgValue {
         ReadConstant(spec);  // just to raise the appropriate error
 
       auto sh = shape_from_size(orig_constant_sz_);
-      view_ = constant_view(nsamples, data_.data(), std::move(sh));
+      SetConstantView(nsamples, data_.data(), sh);
     }
   }
 
@@ -338,13 +339,17 @@ class ArgValue {
   }
 
   /**
-   * @brief Creates a TensorListView out of a constant arguments by assigning the same
+   * @brief Makes the view point to a constant argument by assigning the same
    *        data pointer to all the samples. This way, the user code can be shared regardless
    *        of whether the source of the data was a build time constant or an argument input.
+   *
+   * The storage of the view is reused, so there are no allocations in the steady state.
    */
-  TLV constant_view(int nsamples, const T* sample, const TensorShape<ndim>& shape) {
-    std::vector<const T*> ptrs(nsamples, sample);
-    return TLV(std::move(ptrs), uniform_list_shape(nsamples, shape));
+  void SetConstantView(int nsamples, const T* sample, const TensorShape<ndim>& shape) {
+    view_.data.assign(nsamples, sample);
+    view_.shape.resize(nsamples, shape.size());
+    for (int i = 0; i < nsamples; i++)
+      view_.shape.set_tensor_shape(i, shape);
   }
 
   std::string arg_name_;
@@ -359,6 +364,73 @@ class ArgValue {
   bool has_constant_value_ = false;  // has a constant (explicit or default) defined
 };
 
+/**
+ * @brief A scalar, per-sample argument resolved when the operator is created.
+ *
+ * OpSpec::GetArgument finds the argument by name (in a hash map) and, for argument inputs,
+ * validates the shape of the whole batch in each call. ArgHandle reads the constant value
+ * (explicit or default) once and, for argument inputs, caches the index of the input in the
+ * workspace, so that getting a sample's value doesn't involve any map lookups.
+ * Since it caches the index, a handle must not be used by multiple threads at once.
+ *
+ * @tparam T  the type of the argument, as in OpSpec::GetArgument
+ */
+template <typename T>
+class ArgHandle {
+ public:
+  ArgHandle(std::string arg_name, const OpSpec &spec)
+      : arg_name_(std::move(arg_name)), has_arg_input_(spec.HasTensorArgument(arg_name_)) {
+    if (!has_arg_input_)
+      value_ = spec.GetArgument<T>(arg_name_);
+  }
+
+  /**
+   * @brief Gets the value of the argument for the sample with the given index.
+   */
+  T operator()(const ArgumentWorkspace &ws, int sample_idx) const {
+    if (!has_arg_input_)
+      return value_;
+    const auto &input = ws.ArgumentInput(InputIndex(ws));
+    DALI_ENFORCE(IsType<T>(input.type()), make_string(
+        "Unexpected type of argument \"", arg_name_, "\". Expected ",
+        TypeTable::GetTypeName<T>(), " and got ", input.type()));
+    DALI_ENFORCE(volume(input.tensor_shape_span(sample_idx)) == 1, make_string(
+        "Unexpected shape of argument \"", arg_name_, "\". Expected a batch of scalars or "
+        "a batch of tensors containing one element per sample. Got:\n", input.shape()));
+    return input.template tensor<T>(sample_idx)[0];
+  }
+
+  bool HasArgumentInput() const {
+    return has_arg_input_;
+  }
+
+  const std::string &name() const {
+    return arg_name_;
+  }
+
+ private:
+  /** Returns the index of the argument input in the workspace, looking it up only on a miss. */
+  int InputIndex(const ArgumentWorkspace &ws) const {
+    if (input_idx_ < 0 || input_idx_ >= ws.NumArgumentInput() ||
+        ws.ArgumentInputName(input_idx_) != arg_name_) {
+      input_idx_ = -1;
+      for (int i = 0; i < ws.NumArgumentInput(); i++) {
+        if (ws.ArgumentInputName(i) == arg_name_) {
+          input_idx_ = i;
+          break;
+        }
+      }
+      DALI_ENFORCE(input_idx_ >= 0, "Argument \"" + arg_name_ + "\" not found.");
+    }
+    return input_idx_;
+  }
+
+  std::string arg_name_;
+  bool has_arg_input_ = false;
+  T value_{};
+  mutable int input_idx_ = -1;
+};
+
 }  // namespace dali
 
 #endif  // DALI_PIPELINE_OPERATOR_ARG_HELPER_H_
@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 #include "dali/pipeline/operator/op_spec.h"
 #include "dali/pipeline/workspace/workspace.h"
+#include "dali/test/allocation_counter.h"
 
 namespace dali {
 
@@ -237,6 +238,61 @@ TEST(ArgValueTests, Constant_2D) {
   }
 }
 
+TEST(ArgValueTests, Constant_NoAllocationsInSteadyState) {
+  int nsamples = 5;
+  auto spec = OpSpec("ArgHelperTestOp")
+                .AddArg("scalar", 0.5f)
+                .AddArg("arg", vector<float>{0.1f, 0.2f, 0.3f});
+  Workspace ws;
+  ArgValue<float, 0> scalar("scalar", spec);
+  ArgValue<float, 1> vec("arg", spec);
+  auto spec1 = OpSpec("ArgHelperTestOp").AddArg("arg", vector<float>{0.5f});
+  ArgValue<float, 1> broadcast("arg", spec1);
+  TensorShape<1> vec_shape{3};
+  auto broadcast_shape = uniform_list_shape<1>(nsamples, TensorShape<1>{4});
+  // the first iteration allocates the storage
+  scalar.Acquire(spec, ws, nsamples);
+  vec.Acquire(spec, ws, nsamples, vec_shape);
+  broadcast.Acquire(spec1, ws, nsamples, broadcast_shape);
+
+  EXPECT_ALLOCATIONS_AT_MOST(0, scalar.Acquire(spec, ws, nsamples));
+  EXPECT_ALLOCATIONS_AT_MOST(0, vec.Acquire(spec, ws, nsamples, vec_shape));
+  EXPECT_ALLOCATIONS_AT_MOST(0, broadcast.Acquire(spec1, ws, nsamples, broadcast_shape));
+  ASSERT_EQ(nsamples, broadcast.size());
+  for (int i = 0; i < nsamples; i++) {
+    ASSERT_EQ(broadcast[i].shape, TensorShape<1>{4});
+    EXPECT_EQ(broadcast[i].data[3], 0.5f);
+  }
+}
+
+TEST(ArgHandle, ConstantAndTensorInput) {
+  auto spec = OpSpec("ArgHelperTestOp").AddArg("max_batch_size", kNumSamples);
+  ArgHandle<float> default_scalar("scalar", OpSpec("ArgHelperTestOp").AddArg("scalar", 0.25f));
+  Workspace ws;
+  EXPECT_FALSE(default_scalar.HasArgumentInput());
+  EXPECT_EQ(default_scalar(ws, 3), 0.25f);
+
+  auto arg_data = std::make_shared<TensorList<CPUBackend>>();
+  SetupData(*arg_data, uniform_list_shape(kNumSamples, TensorShape<0>()));
+  ws.AddArgumentInput("other", std::make_shared<TensorList<CPUBackend>>());
+  ws.AddArgumentInput("scalar", arg_data);
+  spec.AddArgumentInput("scalar", "scalar");
+  ArgHandle<float> scalar("scalar", spec);
+  ASSERT_TRUE(scalar.HasArgumentInput());
+  for (int i = 0; i < kNumSamples; i++) {
+    EXPECT_EQ(scalar(ws, i), spec.GetArgument<float>("scalar", &ws, i));
+    EXPECT_EQ(scalar(ws, i), 100 * i);
+  }
+
+  // a workspace with a different order of the argument inputs
+  Workspace ws2;
+  ws2.AddArgumentInput("scalar", arg_data);
+  EXPECT_EQ(scalar(ws2, 2), 200);
+
+  ArgHandle<int> wrong_type("scalar", spec);
+  EXPECT_THROW(wrong_type(ws, 0), std::runtime_error);
+}
+
 TEST(ArgValue, TensorInput_1D_ExpectedShape_AllowEmpty) {
   ArgValueTestAllowEmpty<1>(uniform_list_shape(kNumSamples, TensorShape<1>{3}));
 }
@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -71,6 +71,7 @@ bool Merge<Backend>::SetupImpl(std::vector<OutputDesc> &output_desc, const Works
       make_string("Merge description must cover whole input, got ", input_sample_count_,
                   " input samples and ", predicate.num_samples(), " elements denoting the merge."));
   DALI_ENFORCE(predicate.shape().sample_dim() == 0, "Only scalar indexing is supported.");
+  get_group_indices(group_idx_, predicate);
   return false;
 }
 
@@ -78,7 +79,6 @@ bool Merge<Backend>::SetupImpl(std::vector<OutputDesc> &output_desc, const Works
 template <typename Backend>
 void Merge<Backend>::RunImpl(Workspace &ws) {
   auto &output = ws.template Output<Backend>(0);
-  const auto &predicate = ws.ArgumentInput("predicate");
   auto sample_idx_in_input = uniform_array<kMaxGroups>(0);
 
   WriteTestsDiagnostics(ws);
@@ -99,8 +99,21 @@ void Merge<Backend>::RunImpl(Workspace &ws) {
     device_id_ = CPU_ONLY_DEVICE_ID;
   }
 
+  for (int input_group = 0; input_group < kMaxGroups; input_group++) {
+    const auto &input = ws.template Input<Backend>(input_group);
+    if (input.num_samples() == input_sample_count_ && input_sample_count_ > 0 &&
+        (std::is_same_v<Backend, GPUBackend> || input.is_pinned() == *pinned_)) {
+      // All the samples come from one branch - pass that batch as a whole, keeping
+      // its contiguity.
+      ShareWhole(output, input);
+      WriteTestsDiagnostics(ws);
+      return;
+    }
+  }
+
   // We propagate views only, so just don't care about what is here and reset
   output.Reset();
+  output.SetContiguity(BatchContiguity::Automatic);
   for (int input_group = 0; input_group < kMaxGroups; input_group++) {
     const auto &input = ws.template Input<Backend>(input_group);
     if (input.num_samples() > 0) {
@@ -118,9 +131,10 @@ void Merge<Backend>::RunImpl(Workspace &ws) {
 
   output.SetSize(input_sample_count_);
 
-  for (int output_sample_idx = 0; output_sample_idx < predicate.num_samples();
+  copies_.clear();
+  for (int output_sample_idx = 0; output_sample_idx < input_sample_count_;
        output_sample_idx++) {
-    int input_group_idx = get_group_index(predicate, output_sample_idx);
+    int input_group_idx = group_idx_[output_sample_idx];
     auto &input = ws.template Input<Backend>(input_group_idx);
 
     // get the index within input group and increment for the next occurrence.
@@ -130,10 +144,29 @@ void Merge<Backend>::RunImpl(Workspace &ws) {
     if (std::is_same_v<Backend, GPUBackend> || input.is_pinned() == *pinned_) {
       output.SetSample(output_sample_idx, input, input_sample_idx);
     } else {
-      // Pessimistic variant, we need to copy.
-      // TODO(klecki): Do one allocation, where samples that we share are 0-volumed - this might
-      // be perf optimization reducing the number of allocations to 1.
-      CopySampleToOutput(output, output_sample_idx, input, input_sample_idx, ws);
+      copies_.push_back({ output_sample_idx, input_group_idx, input_sample_idx });
+    }
+  }
+
+  if (!copies_.empty()) {
+    // Pessimistic variant, we need to copy. All the copied samples get one allocation,
+    // which they share.
+    TensorListShape<> copy_shape(copies_.size(), output.sample_dim());
+    for (size_t i = 0; i < copies_.size(); i++) {
+      const auto &input = ws.template Input<Backend>(copies_[i].input_group);
+      copy_shape.set_tensor_shape(i, input.tensor_shape(copies_[i].input_sample));
+    }
+    TensorList<Backend> copy_buffer;
+    copy_buffer.set_pinned(*pinned_);
+    copy_buffer.set_device_id(device_id_);
+    copy_buffer.set_order(output.order());
+    copy_buffer.SetContiguity(BatchContiguity::Contiguous);
+    copy_buffer.Resize(copy_shape, output.type());
+    copy_buffer.SetLayout(output.GetLayout());
+    for (size_t i = 0; i < copies_.size(); i++) {
+      output.SetSample(copies_[i].output_sample, copy_buffer, i);
+      const auto &input = ws.template Input<Backend>(copies_[i].input_group);
+      CopySampleToOutput(output, copies_[i].output_sample, input, copies_[i].input_sample, ws);
     }
   }
   FinalizeCopy(ws);
@@ -145,9 +178,9 @@ void Merge<CPUBackend>::CopySampleToOutput(TensorList<CPUBackend> &output, int o
                                            const TensorList<CPUBackend> &input,
                                            int input_sample_idx, Workspace &ws) {
   auto &tp = ws.GetThreadPool();
+  // the output sample is already allocated with the right shape
   tp.AddWork(
       [&output, &input, output_sample_idx, input_sample_idx](int thread_idx) {
-        output.ResizeSample(output_sample_idx, input.shape()[input_sample_idx]);
         output.CopySample(output_sample_idx, input, input_sample_idx, output.order());
       },
       volume(input.tensor_shape_span(input_sample_idx)));
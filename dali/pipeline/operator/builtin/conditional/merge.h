@@ -1,4 +1,4 @@
-// Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -48,6 +48,8 @@ class Merge : public StatelessOperator<Backend> {
  private:
   /**
    * @brief Fallback for scheduling copy in a thread pool or on a stream
+   *
+   * The output sample must already be allocated (see RunImpl).
    */
   void CopySampleToOutput(TensorList<Backend> &output, int output_idx,
                           const TensorList<Backend> &input, int input_idx,
@@ -66,6 +68,14 @@ class Merge : public StatelessOperator<Backend> {
   // We can only merge two batches based on a boolean predicate.
   static constexpr int kMaxGroups = 2;
   int input_sample_count_ = 0;
+  // the input group of each output sample, evaluated once per iteration
+  std::vector<int> group_idx_;
+
+  /** A sample which cannot be shared and has to be copied to the output */
+  struct SampleCopy {
+    int output_sample, input_group, input_sample;
+  };
+  std::vector<SampleCopy> copies_;
   std::optional<bool> pinned_;
   int device_id_ = CPU_ONLY_DEVICE_ID;
   std::optional<AccessOrder> order_;
@@ -1,4 +1,4 @@
-// Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -38,11 +38,9 @@ bool Split<Backend>::SetupImpl(std::vector<OutputDesc> &output_desc, const Works
   DALI_ENFORCE(predicate.shape().sample_dim() == 0, "Only scalar indexing is supported.");
 
   group_counts_.fill(0);
-
-  for (int i = 0; i < predicate.num_samples(); i++) {
-    int output_group_idx = get_group_index(predicate, i);
-    group_counts_[output_group_idx]++;
-  }
+  get_group_indices(group_idx_, predicate);
+  for (int group : group_idx_)
+    group_counts_[group]++;
 
   // TODO(klecki): we can construct the output_desc, it won't be useful now
   return false;
@@ -52,12 +50,25 @@ bool Split<Backend>::SetupImpl(std::vector<OutputDesc> &output_desc, const Works
 template <typename Backend>
 void Split<Backend>::RunImpl(Workspace &ws) {
   const auto &input = ws.template Input<Backend>(0);
-  const auto &predicate = ws.ArgumentInput("predicate");
   auto sample_idx_in_output = uniform_array<kMaxGroups>(0);
+  int num_samples = group_idx_.size();
 
   for (int output_group_idx = 0; output_group_idx < kMaxGroups; output_group_idx++) {
     auto &output = ws.template Output<Backend>(output_group_idx);
 
+    if (group_counts_[output_group_idx] == num_samples && num_samples > 0) {
+      // The whole batch goes into one branch - pass it as a whole, keeping the contiguity.
+      ShareWhole(output, input);
+      shared_whole_[output_group_idx] = true;
+      continue;
+    }
+    if (shared_whole_[output_group_idx]) {
+      // The output aliased the whole input batch in the previous iteration, start over.
+      output.Reset();
+      output.SetContiguity(BatchContiguity::Automatic);
+      shared_whole_[output_group_idx] = false;
+    }
+
     // We can (and need to) do it only once, for each new output instance, when it doesn't have
     // data yet. It should be consistent across iterations.
     if (!output.has_data()) {
@@ -71,8 +82,10 @@ void Split<Backend>::RunImpl(Workspace &ws) {
     output.SetSize(group_counts_[output_group_idx]);
   }
 
-  for (int input_sample_idx = 0; input_sample_idx < predicate.num_samples(); input_sample_idx++) {
-    int output_group_idx = get_group_index(predicate, input_sample_idx);
+  for (int input_sample_idx = 0; input_sample_idx < num_samples; input_sample_idx++) {
+    int output_group_idx = group_idx_[input_sample_idx];
+    if (shared_whole_[output_group_idx])
+      continue;
     auto &output = ws.template Output<Backend>(output_group_idx);
 
     // get the output index and increment for the next sample.
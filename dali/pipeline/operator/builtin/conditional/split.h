@@ -1,4 +1,4 @@
-// Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,6 +15,7 @@
 #ifndef DALI_PIPELINE_OPERATOR_BUILTIN_CONDITIONAL_SPLIT_H_
 #define DALI_PIPELINE_OPERATOR_BUILTIN_CONDITIONAL_SPLIT_H_
 
+#include <array>
 #include <vector>
 
 #include "dali/pipeline/operator/checkpointing/stateless_operator.h"
@@ -54,6 +55,10 @@ class Split : public StatelessOperator<Backend> {
   // We can only split two batches based on a boolean predicate.
   static constexpr int kMaxGroups = 2;
   std::array<int, kMaxGroups> group_counts_;
+  // the output group of each input sample, evaluated once per iteration
+  std::vector<int> group_idx_;
+  // whether the output is a view of the whole input batch
+  std::array<bool, kMaxGroups> shared_whole_ = {};
 
   bool if_stmt_implementation_ = false;
 
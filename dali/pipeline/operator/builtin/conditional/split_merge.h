@@ -1,4 +1,4 @@
-// Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,6 +16,7 @@
 #define DALI_PIPELINE_OPERATOR_BUILTIN_CONDITIONAL_SPLIT_MERGE_H_
 
 #include <string>
+#include <vector>
 #include "dali/core/static_switch.h"
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/data/tensor_list.h"
@@ -46,6 +47,32 @@ inline int get_group_index(const TensorList<CPUBackend> &condition, int conditio
   return cond_val ? 0 : 1;
 }
 
+/**
+ * @brief Evaluates the group indices (see get_group_index) of all the samples at once.
+ */
+inline void get_group_indices(std::vector<int> &groups, const TensorList<CPUBackend> &condition) {
+  int n = condition.num_samples();
+  groups.resize(n);
+  TYPE_SWITCH(condition.type(), type2id, T, LOGICALLY_EVALUATABLE_TYPES, (
+    for (int i = 0; i < n; i++)
+      groups[i] = *condition.tensor<T>(i) ? 0 : 1;
+  ), (DALI_FAIL(make_string("Can't evaluate ", condition.type(), " as boolean value."))));  // NOLINT
+}
+
+/**
+ * @brief Passes the whole batch through a split or merge, keeping its contiguity.
+ *
+ * The order of the output is preserved and it waits for the work in the order of the input,
+ * just like when the samples are shared individually.
+ */
+template <typename Backend>
+void ShareWhole(TensorList<Backend> &output, const TensorList<Backend> &input) {
+  auto order = output.order();
+  output.ShareData(input);
+  if (order)
+    output.set_order(order);
+}
+
 inline bool IsSplit(const OpSchema &schema) {
   return schema.name() == "_conditional__Split";
 }
@@ -181,7 +181,8 @@ class InputOperator : public Operator<Backend>, virtual public BatchSizeProvider
           no_copy_(spec.GetArgument<bool>("no_copy")),
           sync_worker_(device_id_, false, "InputOperator sync_worker_") {
     if (std::is_same<Backend, GPUBackend>::value) {
-      internal_copy_stream_ = CUDAStreamPool::instance().Get(device_id_);
+      internal_copy_stream_ = CUDAStreamPool::instance().Get(
+          device_id_, this->default_cuda_stream_priority_);
       internal_copy_order_ = internal_copy_stream_;
     }
     sync_worker_.WaitForInit();
@@ -377,6 +378,10 @@ class InputOperator : public Operator<Backend>, virtual public BatchSizeProvider
                      std::list<uptr_cuda_event_type> *cuda_event = nullptr,
                      std::list<uptr_cuda_event_type> *copy_to_gpu = nullptr) {
     // No need to synchronize on copy_to_gpu - it was already synchronized before
+    // Drop the shared (not owned) data right away, so that its owner can be notified
+    // (see WrapExternalBuffer) instead of waiting for the buffer to be reused.
+    if (data.front()->shares_data())
+      data.front()->Reset();
     std::lock_guard<std::mutex> busy_lock(busy_m_);
     tl_data_.Recycle(data);
     if (copy_to_gpu) {
@@ -54,18 +54,49 @@ void MakeContiguousMixed::RunImpl(Workspace &ws) {
            "Copy between backends is needed, executor cannot mark this MakeContiguous as "
            "PassThrough node.");
     auto &output = ws.Output<GPUBackend>(0);
-    if (coalesced) {
-      DomainTimeRange tr("[DALI][MakeContiguousMixed] H2D coalesced", DomainTimeRange::kBlue);
-      cpu_output_buff.Copy(input);
-      output.Copy(cpu_output_buff, ws.stream());
-    } else {
+    if (!coalesced && input.is_pinned()) {
+      // Large samples in pinned memory can be transferred directly
       DomainTimeRange tr("[DALI][MakeContiguousMixed] H2D non coalesced", DomainTimeRange::kGreen);
       output.Copy(input, ws.stream());
+    } else {
+      DomainTimeRange tr("[DALI][MakeContiguousMixed] H2D staged", DomainTimeRange::kBlue);
+      StagedCopy(output, input, ws);
     }
     coalesced = true;
   }
 }
 
+void MakeContiguousMixed::StagedCopy(TensorList<GPUBackend> &output,
+                                     const TensorList<CPUBackend> &input, Workspace &ws) {
+  if (!IsValidType(input.type())) {
+    output.Copy(input, ws.stream());  // no data - just copy the metadata
+    return;
+  }
+  int batch_size = input.num_samples();
+  output.Resize(input.shape(), input.type());
+  AccessOrder order = ws.stream();
+  order.wait(output.order());
+
+  staging_dst_.resize(batch_size);
+  staging_src_.resize(batch_size);
+  staging_sizes_.resize(batch_size);
+  size_t type_size = input.type_info().size();
+  for (int i = 0; i < batch_size; i++) {
+    staging_dst_[i] = output.raw_mutable_tensor(i);
+    staging_src_[i] = input.raw_tensor(i);
+    staging_sizes_[i] = input.shape().tensor_size(i) * type_size;
+  }
+  // The previous stage may still be writing the input
+  AccessOrder::host().wait(input.order());
+  staging_.Copy(make_cspan(staging_dst_), make_cspan(staging_src_), make_cspan(staging_sizes_),
+                ws.stream(), ws.HasThreadPool() ? &ws.GetThreadPool() : nullptr);
+
+  output.SetLayout(input.GetLayout());
+  for (int i = 0; i < batch_size; i++)
+    output.SetMeta(i, input.GetMeta(i));
+  output.order().wait(order);
+}
+
 void MakeContiguousGPU::RunImpl(Workspace &ws) {
   const auto& input = ws.Input<GPUBackend>(0);
   auto& output = ws.Output<GPUBackend>(0);
@@ -22,6 +22,7 @@
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/operator/checkpointing/stateless_operator.h"
 #include "dali/pipeline/operator/common.h"
+#include "dali/pipeline/util/staging_ring.h"
 #include "dali/core/common.h"
 
 // Found by benchmarking coalesced vs non coalesced on diff size images
@@ -98,7 +99,6 @@ class MakeContiguousBase : public StatelessOperator<Backend> {
 
  protected:
   USE_OPERATOR_MEMBERS();
-  TensorList<CPUBackend> cpu_output_buff;
   bool coalesced = true;
   // Whether the next batch would be passed through - this value is changed in Setup.
   bool pass_through_ = false;
@@ -126,6 +126,21 @@ class MakeContiguousMixed : public MakeContiguousBase<MixedBackend> {
   void RunImpl(Workspace &ws) override;
 
   DISABLE_COPY_MOVE_ASSIGN(MakeContiguousMixed);
+
+ private:
+  /**
+   * @brief Copies the samples to the device through a pinned staging ring
+   *
+   * The host-side gathering of the samples overlaps with the transfer of the previously
+   * gathered data.
+   */
+  void StagedCopy(TensorList<GPUBackend> &output, const TensorList<CPUBackend> &input,
+                  Workspace &ws);
+
+  PinnedStagingRing staging_;
+  std::vector<void *> staging_dst_;
+  std::vector<const void *> staging_src_;
+  std::vector<size_t> staging_sizes_;
 };
 
 class MakeContiguousCPU : public MakeContiguousBase<CPUBackend> {
@@ -53,6 +53,20 @@ class OpCheckpoint {
 
   DLL_PUBLIC std::any &MutableCheckpointState();
 
+  /**
+   * @brief Stores the value as the checkpoint state
+   *
+   * If the state already holds an object of the same type, it's assigned in place, reusing the
+   * storage of the previous value - the operators saving their state in every iteration
+   * don't need to allocate.
+   */
+  template<class T> void UpdateCheckpointState(const T &value) {
+    if (auto *current = std::any_cast<T>(&state_))
+      *current = value;
+    else
+      state_ = value;
+  }
+
   /**
    * @brief Sets the access order of the checkpoint data, synchronizing if necessary.
    *
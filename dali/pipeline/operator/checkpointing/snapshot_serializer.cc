@@ -109,6 +109,8 @@ std::string SnapshotSerializer::Serialize(const LoaderStateSnapshot &snapshot) {
   proto_snapshot.mutable_loader_state()->set_rng(SerializeToString(snapshot.rng));
   proto_snapshot.mutable_loader_state()->set_current_epoch(snapshot.current_epoch);
   proto_snapshot.mutable_loader_state()->set_age(snapshot.age);
+  proto_snapshot.mutable_loader_state()->set_epoch_start(snapshot.epoch_start);
+  proto_snapshot.mutable_loader_state()->set_num_shards(snapshot.num_shards);
   return proto_snapshot.SerializeAsString();
 }
 
@@ -120,6 +122,8 @@ LoaderStateSnapshot SnapshotSerializer::Deserialize(const std::string &data) {
     DeserializeFromString<std::default_random_engine>(proto_snapshot.loader_state().rng()),
     proto_snapshot.loader_state().current_epoch(),
     proto_snapshot.loader_state().age(),
+    proto_snapshot.loader_state().epoch_start(),
+    proto_snapshot.loader_state().num_shards(),
   };
 }
 
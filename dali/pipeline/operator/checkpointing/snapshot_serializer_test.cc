@@ -52,7 +52,9 @@ TEST_F(SnapshotSerializerTest, LoaderStateSnapshot) {
   LoaderStateSnapshot snapshot = {
     std::default_random_engine(123),
     321,
-    567
+    567,
+    89,
+    4
   };
 
   std::string serialized = SnapshotSerializer().Serialize(snapshot);
@@ -61,6 +63,8 @@ TEST_F(SnapshotSerializerTest, LoaderStateSnapshot) {
   EXPECT_EQ(snapshot.rng, deserialized.rng);
   EXPECT_EQ(snapshot.current_epoch, deserialized.current_epoch);
   EXPECT_EQ(snapshot.age, deserialized.age);
+  EXPECT_EQ(snapshot.epoch_start, deserialized.epoch_start);
+  EXPECT_EQ(snapshot.num_shards, deserialized.num_shards);
 }
 
 }  // namespace dali
@@ -14,6 +14,7 @@
 
 
 #include <string>
+#include <utility>
 
 #include "dali/core/error_handling.h"
 #include "dali/core/python_util.h"
@@ -42,18 +43,28 @@ OpSchema &SchemaRegistry::RegisterSchema(const std::string &name) {
 }
 
 const OpSchema &SchemaRegistry::GetSchema(const std::string &name) {
-  auto &schema_map = registry();
-  auto it = schema_map.find(name);
-  DALI_ENFORCE(it != schema_map.end(), "Schema for operator '" + name + "' not registered");
-  return it->second;
+  auto *schema = TryGetSchema(name);
+  DALI_ENFORCE(schema != nullptr, "Schema for operator '" + name + "' not registered");
+  return *schema;
 }
 
-const OpSchema *SchemaRegistry::TryGetSchema(const std::string &name) {
+const OpSchema *SchemaRegistry::TryGetSchema(const std::string &name, bool load) {
   auto &schema_map = registry();
   auto it = schema_map.find(name);
+  if (it == schema_map.end() && load && schema_loader() && schema_loader()(name))
+    it = schema_map.find(name);
   return it != schema_map.end() ? &it->second : nullptr;
 }
 
+std::function<bool(const std::string &)> &SchemaRegistry::schema_loader() {
+  static std::function<bool(const std::string &)> loader;
+  return loader;
+}
+
+void SchemaRegistry::SetSchemaLoader(std::function<bool(const std::string &)> loader) {
+  schema_loader() = std::move(loader);
+}
+
 const OpSchema &OpSchema::Default() {
   static OpSchema default_schema("");
   return default_schema;
@@ -69,6 +80,9 @@ OpSchema::OpSchema(const std::string &name) : name_(name) {
   AddInternalArg("inplace", "Whether Op can be run in place", false);
   AddInternalArg("default_cuda_stream_priority", "Default cuda stream priority", 0);
   AddInternalArg("checkpointing", "Setting to `true` enables checkpointing", false);
+  AddInternalArg("set_affinity",
+                 "Whether the threads started by the Op are pinned to the CPUs close to the device",
+                 false);
 
   AddOptionalArg("seed", R"code(Random seed.
 
@@ -471,6 +485,18 @@ OpSchema &OpSchema::NoPrune() {
 }
 
 
+OpSchema &OpSchema::StreamSafe() {
+  stream_safe_ = true;
+  return *this;
+}
+
+
+OpSchema &OpSchema::Stateless() {
+  stateless_ = true;
+  return *this;
+}
+
+
 OpSchema &OpSchema::PassThrough(const std::map<int, int> &inout) {
   std::set<int> outputs;
   for (const auto &elems : inout) {
@@ -492,6 +518,12 @@ OpSchema &OpSchema::SamplewisePassThrough() {
 }
 
 
+OpSchema &OpSchema::InPlace(int input_idx, int output_idx) {
+  in_place_[output_idx] = input_idx;
+  return *this;
+}
+
+
 const vector<std::string> &OpSchema::GetParents() const {
   return parents_;
 }
@@ -672,6 +704,16 @@ bool OpSchema::IsNoPrune() const {
 }
 
 
+bool OpSchema::IsStreamSafe() const {
+  return stream_safe_;
+}
+
+
+bool OpSchema::IsStateless() const {
+  return stateless_;
+}
+
+
 bool OpSchema::IsSerializable() const {
   return serializable_;
 }
@@ -719,6 +761,12 @@ bool OpSchema::HasSamplewisePassThrough() const {
 }
 
 
+int OpSchema::GetInPlaceInput(int output_idx) const {
+  auto it = in_place_.find(output_idx);
+  return it != in_place_.end() ? it->second : -1;
+}
+
+
 int OpSchema::CalculateOutputs(const OpSpec &spec) const {
   if (!output_fn_) {
     return num_output_;
@@ -479,6 +479,26 @@ used with DALIDataType, to avoid confusion with `AddOptionalArg<type>(name, doc,
    */
   DLL_PUBLIC OpSchema &NoPrune();
 
+  /**
+   * @brief Notes that the operator can run consecutive iterations on different CUDA streams.
+   *
+   * The operator must not keep any device-side state (e.g. scratch buffers reused across
+   * iterations) that is only valid in the stream of the previous iteration. Such operators
+   * can overlap the GPU work of consecutive iterations with StreamPolicy::PerIteration.
+   */
+  DLL_PUBLIC OpSchema &StreamSafe();
+
+  /**
+   * @brief Notes that the outputs of the operator depend only on its inputs and arguments.
+   *
+   * The operator must not keep any state between iterations (no random number generators,
+   * no readers) and must not have side effects. Invocations of such an operator with the same
+   * inputs and arguments produce the same results and can be merged into one.
+   * The executor may also create multiple instances of such an operator, which run consecutive
+   * iterations concurrently.
+   */
+  DLL_PUBLIC OpSchema &Stateless();
+
   /**
    * @brief Informs that the data passes through this operator unchanged, only
    *        the metadata is affected.
@@ -490,6 +510,11 @@ used with DALIDataType, to avoid confusion with `AddOptionalArg<type>(name, doc,
    * own the storage and the associated input should be included in double-buffering
    * whenever the output should.
    *
+   * The operator doesn't have to pass the data through in every configuration (e.g. a cast
+   * shares the input only when the type doesn't change) - the property only tells that the
+   * output _may_ alias the input. Since the data isn't modified, the aliased buffer is subject
+   * to copy-on-write: it's not reused for the in-place outputs of the consumers.
+   *
    * @param inout - tells which inputs are passed through to which outputs.
    *                Only (partial - as in partial function) bijective mappings are allowed.
    */
@@ -502,6 +527,18 @@ used with DALIDataType, to avoid confusion with `AddOptionalArg<type>(name, doc,
    */
   DLL_PUBLIC OpSchema &SamplewisePassThrough();
 
+  /**
+   * @brief Informs that the operator can write an output to the memory of an input.
+   *
+   * Each element of the output must depend only on the element at the same position in the
+   * input (e.g. an elementwise type conversion). The executor may reuse the input buffer if
+   * nothing else uses it and it has the same shape and element size as the output.
+   *
+   * It can be combined with PassThrough - the executor offers the input buffer only when the
+   * operator requests the allocation of the output (i.e. its Setup returns true).
+   */
+  DLL_PUBLIC OpSchema &InPlace(int input_idx, int output_idx);
+
   /**
    * @brief Get parent schemas (non-recursive)
    */
@@ -648,6 +685,16 @@ used with DALIDataType, to avoid confusion with `AddOptionalArg<type>(name, doc,
    */
   DLL_PUBLIC bool IsNoPrune() const;
 
+  /**
+   * @brief Check whether the operator can run consecutive iterations on different streams.
+   */
+  DLL_PUBLIC bool IsStreamSafe() const;
+
+  /**
+   * @brief Check whether the outputs of the operator depend only on its inputs and arguments.
+   */
+  DLL_PUBLIC bool IsStateless() const;
+
   DLL_PUBLIC bool IsSerializable() const;
 
   /**
@@ -678,6 +725,11 @@ used with DALIDataType, to avoid confusion with `AddOptionalArg<type>(name, doc,
    */
   DLL_PUBLIC bool HasSamplewisePassThrough() const;
 
+  /**
+   * @brief Returns the index of the input whose memory can be reused for the output, or -1.
+   */
+  DLL_PUBLIC int GetInPlaceInput(int output_idx) const;
+
   /**
    * @brief Return the static number of outputs or calculate regular outputs using output_fn
    */
@@ -827,10 +879,16 @@ used with DALIDataType, to avoid confusion with `AddOptionalArg<type>(name, doc,
 
   bool no_prune_ = false;
 
+  bool stream_safe_ = false;
+
+  bool stateless_ = false;
+
   bool serializable_ = true;
 
   std::map<int, int> passthrough_map_;
   bool samplewise_any_passthrough_ = false;
+  /** Maps outputs to the inputs whose memory they can reuse */
+  std::map<int, int> in_place_;
 
   bool is_deprecated_ = false;
   std::string deprecated_in_favor_of_;
@@ -852,11 +910,27 @@ class SchemaRegistry {
  public:
   DLL_PUBLIC static OpSchema &RegisterSchema(const std::string &name);
   DLL_PUBLIC static const OpSchema &GetSchema(const std::string &name);
-  DLL_PUBLIC static const OpSchema *TryGetSchema(const std::string &name);
+  /**
+   * @brief Returns the schema or nullptr, if it's not registered
+   *
+   * @param load If true and the schema is not registered, the schema loader (if any) is asked
+   *             to load it.
+   */
+  DLL_PUBLIC static const OpSchema *TryGetSchema(const std::string &name, bool load = true);
+
+  /**
+   * @brief Sets the function called when a schema is not registered.
+   *
+   * The loader may register the schema (e.g. by loading the library which defines it) and
+   * returns true if it did. It's used for lazily loaded plugins (see PluginManager).
+   */
+  DLL_PUBLIC static void SetSchemaLoader(std::function<bool(const std::string &)> loader);
 
  private:
   inline SchemaRegistry() {}
 
+  DLL_PUBLIC static std::function<bool(const std::string &)> &schema_loader();
+
   DLL_PUBLIC static std::map<string, OpSchema> &registry();
 };
 
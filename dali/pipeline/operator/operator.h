@@ -17,6 +17,7 @@
 
 #include <any>
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -50,6 +51,7 @@ struct ReaderMeta {
   int shard_id = -1;              // shard id of given reader
   int pad_last_batch = -1;        // if given reader should pad last batch
   int stick_to_shard = -1;        // if given reader should stick to its shard
+  double loader_wait_time = 0;    // total time (us) the reader waited for the loader
 
   constexpr operator bool() const {
     return epoch_size != -1 && epoch_size_padded != -1 && number_of_shards != -1 &&
@@ -129,6 +131,21 @@ class DLL_PUBLIC OperatorBase {
     return true;
   }
 
+  /**
+   * @brief If true, the CPU operator can run sample by sample, chained with other operators.
+   *
+   * The executor may then apply a chain of such operators to a sample in one task, so that
+   * the intermediate results stay in the cache (see exec2::SampleMajorChain). The operator must:
+   * - implement the legacy per-sample `RunImpl(SampleWorkspace &)` and use the default batch
+   *   `RunImpl(Workspace &)`, which runs it for each sample,
+   * - not need `Setup` - only the first operator of a chain is set up; the outputs are sized
+   *   by the per-sample `RunImpl`,
+   * - not share the data of the inputs with the outputs.
+   */
+  virtual bool CanRunPerSample() const {
+    return false;
+  }
+
   /**
    * @brief For reader Ops, returns the metadata of the reader and dataset,
    * See ReaderMeta strucutre for the data returned
@@ -160,6 +177,17 @@ class DLL_PUBLIC OperatorBase {
     }
   }
 
+  /** Returns the current values of all the diagnostic entries of type T */
+  template<typename T>
+  std::map<std::string, T> GetDiagnostics() const {
+    std::map<std::string, T> ret;
+    for (auto &[name, ptr] : diagnostics_) {
+      if (auto *val = std::any_cast<T *>(&ptr))
+        ret.emplace(name, **val);
+    }
+    return ret;
+  }
+
   template<typename T>
   void RegisterDiagnostic(std::string name, T *val) {
     using namespace std;  // NOLINT
@@ -297,12 +325,29 @@ class DLL_PUBLIC Operator<CPUBackend> : public OperatorBase {
       output.SetSize(curr_batch_size);
     }
     auto &thread_pool = ws.GetThreadPool();
-    for (int data_idx = 0; data_idx < curr_batch_size; ++data_idx) {
-      thread_pool.AddWork([this, &ws, data_idx](int tid) {
-        SampleWorkspace sample;
-        MakeSampleView(sample, ws, data_idx, tid);
-        this->RunImpl(sample);
-      }, -data_idx);  // -data_idx for FIFO order
+    auto run_sample = [this, &ws](int data_idx, int tid) {
+      SampleWorkspace sample;
+      MakeSampleView(sample, ws, data_idx, tid);
+      this->RunImpl(sample);
+    };
+    if (BatchedSampleScheduling()) {
+      // The largest samples go first, so that they don't end up being processed last
+      bool by_size = ws.NumInput() > 0;
+      std::vector<ThreadPool::PrioritizedWork> work;
+      work.reserve(curr_batch_size);
+      for (int data_idx = 0; data_idx < curr_batch_size; ++data_idx) {
+        int64_t priority = by_size ? ws.GetInputShape(0).tensor_size(data_idx) : -data_idx;
+        work.emplace_back(priority, [run_sample, data_idx](int tid) {
+          run_sample(data_idx, tid);
+        });
+      }
+      thread_pool.AddWorkBatch(make_span(work));
+    } else {
+      for (int data_idx = 0; data_idx < curr_batch_size; ++data_idx) {
+        thread_pool.AddWork([run_sample, data_idx](int tid) {
+          run_sample(data_idx, tid);
+        }, -data_idx);  // -data_idx for FIFO order
+      }
     }
     // Run all tasks and wait for them to finish
     thread_pool.RunAll();
@@ -310,6 +355,17 @@ class DLL_PUBLIC Operator<CPUBackend> : public OperatorBase {
     // breaks metadata consistency - it sets it only to samples
     FixBatchPropertiesConsistency(ws, HasContiguousOutputs());
   }
+
+ protected:
+  /**
+   * @brief Whether the per-sample work should be submitted to the thread pool as one batch
+   *
+   * The batch is ordered by the size of the samples of the first input. Worth it for operators
+   * with many short samples and a large variance of the sample processing time.
+   */
+  virtual bool BatchedSampleScheduling() const {
+    return false;
+  }
 };
 
 // Create registries for CPU & GPU Operators
@@ -509,6 +509,7 @@ class SequenceOperator : public BaseOp<Backend>, protected SampleBroadcasting<Ba
   void InitializeExpandedWorkspace(const Workspace &ws) {
     if (ws.HasThreadPool())
       expanded_.SetThreadPool(&ws.GetThreadPool());
+    expanded_.SetHostArena(ws.HostArena());
     expanded_.set_output_order(ws.output_order());
 
     InitializeExpandedInputs(ws);
@@ -18,6 +18,7 @@
 #include <google/protobuf/io/coded_stream.h>
 
 #include <algorithm>
+#include <cstring>
 #include <exception>
 #include <fstream>
 #include <functional>
@@ -32,6 +33,10 @@
 #include "dali/pipeline/operator/error_reporting.h"
 #include "dali/pipeline/operator/name_utils.h"
 #include "dali/pipeline/graph/graph2dot.h"
+#include "dali/pipeline/graph/arithmetic_fusion.h"
+#include "dali/pipeline/graph/color_fusion.h"
+#include "dali/pipeline/graph/cse.h"
+#include "dali/pipeline/graph/roi_pushdown.h"
 
 namespace dali {
 
@@ -151,12 +156,24 @@ Pipeline::Pipeline(const string &serialized_pipe,
       this->AddExternalInput(ex);
     }
     // all operators
-    for (auto& op_def : def.op()) {
-      OpSpec spec;
-      dali::DeserializeOpSpec(op_def, &spec);
+    if (def.lowered()) {
+      // The graph is used as-is, with no validation, in BuildLoweredGraph
+      lowered_ = true;
+      for (auto& op_def : def.op()) {
+        OpSpec spec;
+        dali::DeserializeOpSpec(op_def, &spec);
+        op_specs_for_serialization_.push_back({op_def.inst_name(), spec, op_def.logical_id()});
+        op_specs_.push_back({op_def.inst_name(), std::move(spec), op_def.logical_id()});
+      }
+      lowered_outputs_ = {def.lowered_outputs().begin(), def.lowered_outputs().end()};
+    } else {
+      for (auto& op_def : def.op()) {
+        OpSpec spec;
+        dali::DeserializeOpSpec(op_def, &spec);
 
-      this->AddOperator(spec, op_def.inst_name(),
-                        op_def.logical_id() == -1 ? GetNextLogicalId() : op_def.logical_id());
+        this->AddOperator(spec, op_def.inst_name(),
+                          op_def.logical_id() == -1 ? GetNextLogicalId() : op_def.logical_id());
+      }
     }
     // output names
     for (auto &output : def.pipe_outputs()) {
@@ -476,8 +493,32 @@ void Pipeline::Build(std::vector<PipelineOutputDesc> output_descs) {
                   max_num_stream_, default_cuda_stream_priority_, prefetch_queue_depth_);
   executor_->EnableMemoryStats(enable_memory_stats_);
   executor_->EnableCheckpointing(checkpointing_);
+  executor_->EnableIPCOutputs(ipc_outputs_);
+  if (async_outputs_)
+    executor_->EnableAsyncOutputs(async_outputs_);
+  if (!queue_policy_.empty() || !concurrency_.empty())
+    executor_->SetSchedulingPolicies(queue_policy_, concurrency_);
+  if (trace_)
+    executor_->EnableTrace(trace_);
   executor_->Init();
 
+  if (lowered_)
+    BuildLoweredGraph();
+  else
+    BuildGraph();
+
+  // Load the final graph into the executor
+  executor_->Build(graph_);
+  // CAUTION: Do not insert anything that can throw between `executor_->Build()` and
+  //          `DiscoverInputOperators`.
+  DiscoverInputOperators();
+
+  repeat_last_.FindNodes(graph_, *executor_);
+
+  built_ = true;
+}
+
+void Pipeline::BuildGraph() {
   // Validate the output tensors names
   vector<string> outputs;
   for (const auto &out_desc : output_descs_) {
@@ -542,21 +583,49 @@ void Pipeline::Build(std::vector<PipelineOutputDesc> output_descs) {
 
   graph_ = std::move(graph_builder_).GetGraph(true);
 
+  // Compute the results of duplicate stateless operators only once
+  graph::EliminateCommonSubexpressions(graph_);
+
+  // Evaluate chains of arithmetic operators as single expressions
+  graph::FuseArithmeticExpressions(graph_);
+
+  // Apply chains of color operators as single color transforms
+  graph::FuseColorTransforms(graph_);
+
+  // Decode only the regions of interest of the images which are cropped right after decoding
+  graph::PushDownDecoderRoi(graph_);
+
   for (auto &node : graph_.OpNodes()) {
     if (node.spec.SchemaName() == "MakeContiguous") {
       PropagateMemoryHint(node);
     }
   }
+}
 
-  // Load the final graph into the executor
-  executor_->Build(graph_);
-  // CAUTION: Do not insert anything that can throw between `executor_->Build()` and
-  //          `DiscoverInputOperators`.
-  DiscoverInputOperators();
-
-  repeat_last_.FindNodes(graph_, *executor_);
-
-  built_ = true;
+void Pipeline::BuildLoweredGraph() {
+  // The operators were validated and the graph was lowered and optimized when the pipeline
+  // was serialized - only the parameters of this instance are set.
+  DALI_ENFORCE(lowered_outputs_.size() == output_descs_.size(),
+               make_string("The lowered pipeline has ", lowered_outputs_.size(), " outputs, but ",
+                           output_descs_.size(), " were requested."));
+  for (auto &op : op_specs_) {
+    OpSpec spec = op.spec;
+    spec.SetArg("max_batch_size", max_batch_size_)
+        .SetArg("num_threads", num_threads_)
+        .SetArg("device_id", device_id_)
+        .SetArg("checkpointing", checkpointing_)
+        .SetArg("set_affinity", set_affinity_ != 0)
+        .SetArg("default_cuda_stream_priority", default_cuda_stream_priority_);
+    string dev = spec.GetArgument<string>("device");
+    if (dev == "cpu" || dev == "mixed")
+      spec.SetArg("cpu_prefetch_queue_depth", prefetch_queue_depth_.cpu_size);
+    if (dev == "gpu" || dev == "mixed")
+      spec.SetArg("gpu_prefetch_queue_depth", prefetch_queue_depth_.gpu_size);
+    graph_builder_.Add(op.instance_name, std::move(spec));
+  }
+  for (auto &out : lowered_outputs_)
+    graph_builder_.AddOutput(out);
+  graph_ = std::move(graph_builder_).GetGraph(true);
 }
 
 
@@ -629,6 +698,43 @@ void Pipeline::ShareOutputs(Workspace *ws) {
   ValidateOutputs(*ws);
 }
 
+bool Pipeline::OutputsReady() {
+  DALI_ENFORCE(built_, "\"Build()\" must be called prior to executing the pipeline.");
+  try {
+    return executor_->OutputsReady();
+  } catch (...) {
+    ProcessException(std::current_exception());
+  }
+  return false;
+}
+
+std::vector<std::optional<IPCTensorListDesc>> Pipeline::ShareOutputsIPC(Workspace *ws) {
+  DALI_ENFORCE(ipc_outputs_, "The pipeline was built without IPC outputs enabled.");
+  ShareOutputs(ws);
+  return ExportIPC(*ws);
+}
+
+void Pipeline::SetOutputBuffer(int output_idx, void *data, size_t size, AccessOrder order) {
+  DALI_ENFORCE(built_, "\"Build()\" must be called before setting the output buffers.");
+  DALI_ENFORCE(output_idx >= 0 && output_idx < num_outputs(), make_string(
+      "The output index ", output_idx, " is out of range. The pipeline has ", num_outputs(),
+      " outputs."));
+  DALI_ENFORCE(output_device(output_idx) == "gpu", make_string(
+      "The output ", output_idx, " is not a GPU output."));
+  executor_->SetOutputBuffer(output_idx, data, size, order);
+}
+
+void Pipeline::EnableTrace(bool enable) {
+  trace_ = enable;
+  if (built_)
+    executor_->EnableTrace(enable);
+}
+
+void Pipeline::WriteTrace(const std::string &path) {
+  DALI_ENFORCE(built_, "\"Build()\" must be called before writing the execution trace.");
+  executor_->WriteTrace(path);
+}
+
 void Pipeline::ReleaseOutputs() {
   DALI_ENFORCE(built_, "\"Build()\" must be called prior to executing the pipeline.");
   try {
@@ -638,6 +744,45 @@ void Pipeline::ReleaseOutputs() {
   }
 }
 
+void Pipeline::WarmUp(const std::map<std::string, TensorListShape<>, std::less<>> &max_shapes,
+                      int iterations) {
+  DALI_ENFORCE(built_, "\"Build()\" must be called prior to calling \"WarmUp()\".");
+  DALI_ENFORCE(iterations >= 0, make_string(
+      "The number of warm-up iterations must not be negative. Got: ", iterations));
+  for (auto &[name, shape] : max_shapes) {
+    DALI_ENFORCE(input_operators_.count(name), make_string(
+        "Could not find an input operator named \"", name, "\"."));
+  }
+
+  std::map<std::string, TensorList<CPUBackend>, std::less<>> inputs;
+  for (auto &[name, node] : input_operators_) {
+    auto it = max_shapes.find(name);
+    DALI_ENFORCE(it != max_shapes.end(), make_string(
+        "The shape of the input \"", name, "\" is required to warm up the pipeline."));
+    DALIDataType dtype = GetInputDtype(name);
+    DALI_ENFORCE(dtype != DALI_NO_TYPE, make_string(
+        "The input \"", name, "\" doesn't declare its data type. Specify the `dtype` of the "
+        "input operator to warm up the pipeline."));
+    auto &data = inputs[name];
+    data.set_pinned(false);
+    data.Resize(it->second, dtype);
+    const auto &layout = GetInputLayout(name);
+    if (layout.ndim() == data.sample_dim())
+      data.SetLayout(layout);
+    size_t element_size = TypeTable::GetTypeInfo(dtype).size();
+    for (int i = 0; i < data.num_samples(); i++)
+      std::memset(data.raw_mutable_tensor(i), 0, it->second[i].num_elements() * element_size);
+  }
+
+  for (int i = 0; i < iterations; i++) {
+    for (auto &[name, data] : inputs)
+      SetExternalInput(name, data, AccessOrder::host(), true);
+    Run();
+    Workspace ws;
+    Outputs(&ws);
+  }
+}
+
 void Pipeline::ToCPU(std::map<string, EdgeMeta>::iterator it) {
   // Insert a D2H copy, if needed
   if (it->second.has_cpu)
@@ -676,6 +821,8 @@ void Pipeline::PrepareOpSpec(OpSpec *spec, int logical_id) {
     .AddArg("num_threads", num_threads_)
     .AddArg("device_id", device_id_)
     .AddArg("checkpointing", checkpointing_)
+    .AddArg("set_affinity", set_affinity_ != 0)
+    .AddArg("default_cuda_stream_priority", default_cuda_stream_priority_)
     .AddArgIfNotExisting("seed", logical_id_to_seed_[logical_id]);
   string dev = spec->GetArgument<string>("device");
   if (dev == "cpu" || dev == "mixed")
@@ -690,7 +837,7 @@ void Pipeline::PrepareOpSpec(OpSpec *spec, int logical_id) {
  * decouples spec class from dali_proto
  */
 void SerializeToProtobuf(dali_proto::OpDef *op, const string &inst_name, const OpSpec &spec,
-                         int logical_id) {
+                         int logical_id, bool lowered = false) {
   op->set_name(spec.SchemaName());
   op->set_inst_name(inst_name);
   op->set_logical_id(logical_id);
@@ -716,9 +863,10 @@ void SerializeToProtobuf(dali_proto::OpDef *op, const string &inst_name, const O
     // filter out args that need to be dealt with on
     // loading a serialized pipeline
     auto &name = a->get_name();
+    // the memory hints of a lowered graph have already been propagated
     if (name == "max_batch_size" ||
         name == "num_threads" ||
-        name == "bytes_per_sample_hint") {
+        (name == "bytes_per_sample_hint" && !lowered)) {
       continue;
     }
 
@@ -730,6 +878,22 @@ void SerializeToProtobuf(dali_proto::OpDef *op, const string &inst_name, const O
 }
 
 string Pipeline::SerializeToProtobuf() const {
+  return SerializeToProtobuf(op_specs_for_serialization_, lowered_, lowered_outputs_);
+}
+
+string Pipeline::SerializeLowered() const {
+  DALI_ENFORCE(built_, "The pipeline must be built before it's serialized in the lowered form.");
+  if (lowered_)
+    return SerializeToProtobuf();
+  std::vector<OpDefinition> ops;
+  for (auto &node : graph_.OpNodes())
+    ops.push_back({node.instance_name, node.spec, -1});
+  std::vector<std::string> outputs(graph_.Outputs().begin(), graph_.Outputs().end());
+  return SerializeToProtobuf(ops, true, outputs);
+}
+
+string Pipeline::SerializeToProtobuf(const std::vector<OpDefinition> &ops, bool lowered,
+                                     const std::vector<std::string> &lowered_outputs) const {
   dali_proto::PipelineDef pipe;
   pipe.set_num_threads(this->num_threads());
   pipe.set_batch_size(this->max_batch_size());
@@ -738,16 +902,15 @@ string Pipeline::SerializeToProtobuf() const {
   pipe.set_enable_checkpointing(this->checkpointing_);
 
   // loop over ops, create messages and append
-  for (size_t i = 0; i < this->op_specs_for_serialization_.size(); ++i) {
+  for (const auto &p : ops) {
     dali_proto::OpDef *op_def = pipe.add_op();
 
-    const auto& p = this->op_specs_for_serialization_[i];
     const OpSpec& spec = p.spec;
 
     DALI_ENFORCE(spec.GetSchema().IsSerializable(), "Could not serialize the operator: `"
                                                     + GetOpDisplayName(spec, true) + "`.");
 
-    dali::SerializeToProtobuf(op_def, p.instance_name, spec, p.logical_id);
+    dali::SerializeToProtobuf(op_def, p.instance_name, spec, p.logical_id, lowered);
   }
 
   // loop over outputs used to create the graph
@@ -760,6 +923,11 @@ string Pipeline::SerializeToProtobuf() const {
     out->set_dtype(output.dtype);
     out->set_ndim(output.ndim);
   }
+  if (lowered) {
+    pipe.set_lowered(true);
+    for (auto &output : lowered_outputs)
+      pipe.add_lowered_outputs(output);
+  }
   pipe.set_device_id(this->device_id_);
   string output = pipe.SerializeAsString();
 
@@ -957,6 +1125,9 @@ bool Pipeline::IsDeserializable(const std::string &serialized_pipeline) {
 
 void Pipeline::Shutdown() {
   DeviceGuard dg(device_id_);
+  for (auto &pending : pending_checkpoints_)
+    pending.wait();
+  pending_checkpoints_.clear();
   for (auto &[name, node] : input_operators_) {
     OperatorBase *op_ptr = executor_->GetOperator(name);
     if (!op_ptr)
@@ -976,6 +1147,24 @@ void Pipeline::Shutdown() {
     executor_->Shutdown();
 }
 
+std::shared_future<std::string> Pipeline::SerializedCheckpointAsync(
+    const ExternalContextCheckpoint &external_ctx_cpt) {
+  auto cpt = GetCheckpoint();
+  cpt.external_ctx_cpt_ = external_ctx_cpt;
+  // Forget the serializations that have already completed.
+  pending_checkpoints_.erase(
+      std::remove_if(pending_checkpoints_.begin(), pending_checkpoints_.end(), [](auto &f) {
+        return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+      }), pending_checkpoints_.end());
+  auto future = std::async(std::launch::async, [this, cpt = std::move(cpt)]() {
+    // The GPU operators copy their state from the device when serializing.
+    DeviceGuard dg(device_id_);
+    return cpt.SerializeToProtobuf(*executor_);
+  }).share();
+  pending_checkpoints_.push_back(future);
+  return future;
+}
+
 std::tuple<OpSpec, std::string, std::string> Pipeline::PrepareMakeContiguousNode(
     EdgeMeta &meta, const std::string &input_name, const std::string &input_dev,
     const std::string &device, const std::string &output_dev) {
@@ -18,9 +18,11 @@
 #include <chrono>
 #include <exception>
 #include <functional>
+#include <future>
 #include <limits>
 #include <map>
 #include <memory>
+#include <optional>
 #include <random>
 #include <set>
 #include <string>
@@ -31,6 +33,7 @@
 
 #include "dali/core/common.h"
 #include "dali/pipeline/data/backend.h"
+#include "dali/pipeline/data/ipc_tensor_list.h"
 #include "dali/pipeline/data/tensor.h"
 #include "dali/pipeline/data/tensor_list.h"
 #include "dali/pipeline/executor/executor.h"
@@ -319,6 +322,43 @@ class DLL_PUBLIC Pipeline {
     }
   }
 
+  /**
+   * @brief Set if the GPU outputs should be allocated in memory which can be shared with other
+   *        processes (see ShareOutputsIPC). Must be called before Build.
+   *
+   * Requires the dynamic executor.
+   */
+  DLL_PUBLIC void EnableIPCOutputs(bool enable = true) {
+    DALI_ENFORCE(!built_, "IPC outputs must be enabled before the pipeline is built.");
+    ipc_outputs_ = enable;
+  }
+
+  /**
+   * @brief Sets the output queue depth policy and the operator concurrency of the executor.
+   *
+   * See ExecutorBase::SetSchedulingPolicies for the valid values; an empty string keeps
+   * the default. Must be called before Build. Requires the dynamic executor.
+   */
+  DLL_PUBLIC void SetSchedulingPolicies(const std::string &queue_policy,
+                                        const std::string &concurrency) {
+    DALI_ENFORCE(!built_, "The scheduling policies must be set before the pipeline is built.");
+    queue_policy_ = queue_policy;
+    concurrency_ = concurrency;
+  }
+
+  /**
+   * @brief Set if the outputs should be returned without waiting on the host for the GPU work.
+   *
+   * The consumers of the GPU outputs must then wait for the outputs' access order - e.g. copying
+   * an output with a non-blocking copy_to_external makes the copy stream wait for it.
+   * Requires the dynamic executor.
+   */
+  DLL_PUBLIC void EnableAsyncOutputs(bool enable = true) {
+    async_outputs_ = enable;
+    if (built_)
+      executor_->EnableAsyncOutputs(enable);
+  }
+
   /**
    * @brief Returns a serialized Checkpoint
    *
@@ -330,6 +370,18 @@ class DLL_PUBLIC Pipeline {
     return cpt.SerializeToProtobuf(*executor_);
   }
 
+  /**
+   * @brief Starts serializing a Checkpoint on a background thread
+   *
+   * The snapshot of the pipeline state is taken immediately - the (potentially costly)
+   * serialization doesn't stall the calling thread and the pipeline keeps running meanwhile.
+   * The pipeline waits for all pending serializations when it's shut down.
+   *
+   * @param external_ctx_cpt Additional information from python side to be included
+   */
+  DLL_PUBLIC std::shared_future<string> SerializedCheckpointAsync(
+      const ExternalContextCheckpoint &external_ctx_cpt);
+
   /**
    * @brief Returns an unserialized Checkpoint
   */
@@ -382,6 +434,18 @@ class DLL_PUBLIC Pipeline {
     }
   }
 
+  /**
+   * @brief Tells which stage limits the throughput of the pipeline, based on the utilization
+   *        of the stages since the previous reset (see ExecutorBase::GetDiagnostics)
+   *
+   * Requires the dynamic executor. The GPU utilization is measured only with the executor
+   * statistics enabled (see EnableExecutorMemoryStats).
+   */
+  DLL_PUBLIC ExecutorDiagnostics GetDiagnostics(bool reset = true) {
+    DALI_ENFORCE(built_, "\"Build()\" must be called before getting the diagnostics.");
+    return executor_->GetDiagnostics(reset);
+  }
+
   /**
    * @brief Set queue sizes for Pipeline using Separated Queues
    *
@@ -455,6 +519,66 @@ class DLL_PUBLIC Pipeline {
    */
   DLL_PUBLIC void ShareOutputs(Workspace *ws);
 
+  /**
+   * @brief Works like ShareOutputs and describes the GPU outputs so that they can be mapped
+   *        in another process (see ExportIPC and ImportIPC).
+   *
+   * The shared memory is reused when the outputs are released - the consumer process must be
+   * done with the data before ReleaseOutputs is called.
+   *
+   * @return The descriptors of the outputs; empty for the CPU outputs.
+   */
+  DLL_PUBLIC std::vector<std::optional<IPCTensorListDesc>> ShareOutputsIPC(Workspace *ws);
+
+  /**
+   * @brief Checks, without blocking, whether the next batch is complete
+   *
+   * If it returns true, the next call to Outputs or ShareOutputs doesn't wait - this allows one
+   * thread to serve multiple pipelines. The GPU outputs are ready when the work producing them
+   * is complete on the device.
+   * Run must be called prior to calling this method.
+   *
+   * Requires the dynamic executor.
+   */
+  DLL_PUBLIC bool OutputsReady();
+
+  /**
+   * @brief Provides a device buffer in which a GPU output is to be produced, avoiding a copy.
+   *
+   * The buffer is taken by the next scheduled iteration which doesn't have a buffer for this
+   * output yet - to cover the prefetched iterations, call this function before each Run.
+   * The buffer is used if it's large enough and the output is produced by an operator (rather
+   * than passed through from the input); otherwise, the output is allocated as usual.
+   * When the buffer was used, CopyToExternal to the same address is a no-op.
+   *
+   * The output is written after the work scheduled in `order` up to this call. The buffer must
+   * remain valid until the outputs of the iteration are released.
+   *
+   * Requires the dynamic executor.
+   */
+  DLL_PUBLIC void SetOutputBuffer(int output_idx, void *data, size_t size,
+                                  AccessOrder order = {});
+
+  /**
+   * @brief Starts (or stops) recording the execution timeline; starting discards the timeline
+   *        recorded so far.
+   *
+   * The timeline contains the host spans of the operators on the threads which ran them,
+   * their GPU spans and the data dependencies between them. Can be called before Build.
+   * The trace can be also recorded by setting DALI_EXEC_TRACE_FILE - it's then written
+   * to that file when the pipeline is destroyed.
+   * Requires the dynamic executor.
+   */
+  DLL_PUBLIC void EnableTrace(bool enable = true);
+
+  /**
+   * @brief Writes the timeline recorded so far in the Chrome trace (JSON) format, which can be
+   *        opened in chrome://tracing or in the Perfetto UI, and discards it.
+   *
+   * The function waits for the GPU work of the recorded operators to complete.
+   */
+  DLL_PUBLIC void WriteTrace(const std::string &path);
+
   /**
    * @brief Release buffers returned by the Output call
    * This method is meant for cases where buffers are coppied out
@@ -463,11 +587,41 @@ class DLL_PUBLIC Pipeline {
    */
   DLL_PUBLIC void ReleaseOutputs();
 
+  /**
+   * @brief Runs the pipeline on dummy data, so that the first real iterations don't allocate
+   *
+   * The buffers, the operators' scratch memory and the memory pools grow lazily, which makes
+   * the first iterations slow. This function feeds all input operators with zero-filled batches
+   * of the given shapes, runs the pipeline and discards the outputs, so the memory pools
+   * already hold enough memory when the actual processing starts.
+   *
+   * The shapes should be the largest ones expected. The data types and layouts are taken from
+   * the input operators, so the inputs must declare their `dtype`.
+   *
+   * @remark The warm-up iterations are regular iterations - the readers and random number
+   *         generators advance and the inputs with `repeat_last` repeat the dummy data until
+   *         they're fed again.
+   *
+   * @param max_shapes  the shapes of the batches fed to the inputs, by input name
+   * @param iterations  the number of iterations to run
+   */
+  DLL_PUBLIC void WarmUp(const std::map<std::string, TensorListShape<>, std::less<>> &max_shapes,
+                         int iterations = 1);
+
   /**
    * @brief serializes the pipe to a protobuf
    */
   DLL_PUBLIC string SerializeToProtobuf() const;
 
+  /**
+   * @brief Serializes the graph of a built pipeline - lowered and optimized - to a protobuf
+   *
+   * A pipeline deserialized from this form is built without validating the operators, lowering
+   * the graph or running the graph optimizations again. The batch size, the number of threads,
+   * the device and the queue depths can still be changed; the seeds of the operators are kept.
+   */
+  DLL_PUBLIC string SerializeLowered() const;
+
   /**
    * @brief Save graph in DOT direct graph format
    * in filename.
@@ -638,6 +792,12 @@ class DLL_PUBLIC Pipeline {
   // Helper to add pipeline meta-data
   void PrepareOpSpec(OpSpec *spec, int logical_id);
 
+  /** Validates the outputs, lowers and optimizes the graph of the operators added */
+  void BuildGraph();
+
+  /** Builds the graph of a pipeline deserialized in the lowered form, see SerializeLowered */
+  void BuildLoweredGraph();
+
   void PropagateMemoryHint(graph::OpNode &node);
 
   inline void AddToOpSpecs(const std::string &inst_name, const OpSpec &spec, int logical_id);
@@ -722,6 +882,11 @@ class DLL_PUBLIC Pipeline {
   QueueSizes prefetch_queue_depth_{};
   bool enable_memory_stats_ = false;
   bool checkpointing_ = false;
+  std::vector<std::shared_future<std::string>> pending_checkpoints_;
+  bool ipc_outputs_ = false;
+  bool async_outputs_ = false;
+  bool trace_ = false;
+  std::string queue_policy_, concurrency_;
 
   std::vector<int64_t> seed_;
   int64_t original_seed_ = 0;
@@ -740,6 +905,13 @@ class DLL_PUBLIC Pipeline {
 
   std::vector<OpDefinition> op_specs_;
   std::vector<OpDefinition> op_specs_for_serialization_;
+
+  string SerializeToProtobuf(const std::vector<OpDefinition> &ops, bool lowered,
+                             const std::vector<std::string> &lowered_outputs) const;
+
+  // If true, op_specs_ hold the lowered graph with lowered_outputs_ (see SerializeLowered)
+  bool lowered_ = false;
+  std::vector<std::string> lowered_outputs_;
   std::set<std::string> instance_names_;
 
   std::vector<PipelineOutputDesc> output_descs_;
@@ -0,0 +1,101 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/pipeline_group.h"
+#include <set>
+#include <string>
+#include <utility>
+
+namespace dali {
+
+PipelineGroup::PipelineGroup(std::unique_ptr<Pipeline> host_stage,
+                             std::vector<std::unique_ptr<Pipeline>> device_stages)
+    : host_stage_(std::move(host_stage)), device_stages_(std::move(device_stages)) {
+  DALI_ENFORCE(host_stage_, "The host stage must not be null.");
+  DALI_ENFORCE(!device_stages_.empty(), "The group must contain at least one device stage.");
+  int noutputs = host_stage_->num_outputs();
+  for (int o = 0; o < noutputs; o++) {
+    DALI_ENFORCE(host_stage_->output_device(o) == "cpu",
+                 make_string("The outputs of the host stage must be CPU outputs. The output \"",
+                             host_stage_->output_name(o), "\" is a ",
+                             host_stage_->output_device(o), " output."));
+  }
+  for (size_t i = 0; i < device_stages_.size(); i++) {
+    auto &stage = device_stages_[i];
+    DALI_ENFORCE(stage, make_string("The device stage ", i, " must not be null."));
+    DALI_ENFORCE(stage->max_batch_size() >= host_stage_->max_batch_size(),
+                 make_string("The batch size of the device stage ", i, " (",
+                             stage->max_batch_size(), ") is smaller than the batch size of the "
+                             "host stage (", host_stage_->max_batch_size(), ")."));
+    std::set<std::string> inputs;
+    for (int n = 0; n < stage->num_inputs(); n++)
+      inputs.insert(stage->input_name(n));
+    for (int o = 0; o < noutputs; o++) {
+      DALI_ENFORCE(inputs.count(host_stage_->output_name(o)),
+                   make_string("The device stage ", i, " has no input named \"",
+                               host_stage_->output_name(o), "\", which is an output of the host "
+                               "stage."));
+    }
+    DALI_ENFORCE(static_cast<int>(inputs.size()) == noutputs,
+                 make_string("The device stage ", i, " has inputs which are not fed by the host "
+                             "stage."));
+  }
+}
+
+void PipelineGroup::Prefetch() {
+  DALI_ENFORCE(!prefetched_, "The pipeline group has already been prefetched.");
+  host_stage_->Prefetch();
+  // The batches are dealt round-robin, like in Run
+  int feed_count = device_stages_[0]->InputFeedCount(host_stage_->output_name(0));
+  for (int i = 1; i < num_device_stages(); i++) {
+    DALI_ENFORCE(device_stages_[i]->InputFeedCount(host_stage_->output_name(0)) == feed_count,
+                 "All the device stages must have the same prefetch queue depth.");
+  }
+  for (int f = 0; f < feed_count; f++) {
+    for (int i = 0; i < num_device_stages(); i++)
+      Feed(i);
+  }
+  for (auto &stage : device_stages_)
+    stage->Prefetch();
+  prefetched_ = true;
+}
+
+void PipelineGroup::Run() {
+  DALI_ENFORCE(prefetched_, "\"Prefetch()\" must be called before running the pipeline group.");
+  for (int i = 0; i < num_device_stages(); i++) {
+    Feed(i);
+    device_stages_[i]->Run();
+  }
+}
+
+void PipelineGroup::Outputs(int idx, Workspace *ws) {
+  device_stage(idx).Outputs(ws);
+}
+
+void PipelineGroup::Feed(int idx) {
+  auto &stage = *device_stages_[idx];
+  host_stage_->ShareOutputs(&host_ws_);
+  // The copy is synchronous: the buffers of the host stage are returned before it runs again.
+  // When the input operator of the device stage is placed on the GPU, it's the only copy -
+  // the host-to-device transfer, which the stand-alone pipelines do as well.
+  for (int o = 0; o < host_ws_.NumOutput(); o++) {
+    stage.SetExternalInput(host_stage_->output_name(o), host_ws_.Output<CPUBackend>(o),
+                           AccessOrder::host(), true, false, InputOperatorNoCopyMode::FORCE_COPY);
+  }
+  host_ws_.Clear();
+  host_stage_->ReleaseOutputs();
+  host_stage_->Run();
+}
+
+}  // namespace dali
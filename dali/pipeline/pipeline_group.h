@@ -0,0 +1,97 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_PIPELINE_GROUP_H_
+#define DALI_PIPELINE_PIPELINE_GROUP_H_
+
+#include <memory>
+#include <vector>
+#include "dali/core/common.h"
+#include "dali/pipeline/pipeline.h"
+#include "dali/pipeline/workspace/workspace.h"
+
+namespace dali {
+
+/**
+ * @brief A data-parallel group of pipelines sharing one host stage
+ *
+ * Instead of running one complete pipeline per GPU, each with its own sharded reader, the group
+ * runs a single host stage (readers, CPU decoding and processing) and distributes its batches,
+ * round-robin, to the device stages - one pipeline per GPU. There's only one reader, one file
+ * list and one thread pool for the CPU work and the shuffling is global.
+ *
+ * The host stage must produce only CPU outputs. Each device stage must have an input operator
+ * (e.g. ExternalSource, preferably placed on the GPU) for every output of the host stage, named
+ * like that output. The device stages should be created with few threads, since they don't run
+ * the CPU part of the processing.
+ *
+ * The consecutive batches of the host stage go to the device stages 0, 1, ..., N-1, 0, 1, ...;
+ * The outputs of the i-th device stage are obtained with `Outputs(i, ws)`.
+ */
+class DLL_PUBLIC PipelineGroup {
+ public:
+  /**
+   * @param host_stage    the pipeline producing the data; must be built
+   * @param device_stages the pipelines consuming the data, typically one per GPU; must be built
+   */
+  PipelineGroup(std::unique_ptr<Pipeline> host_stage,
+                std::vector<std::unique_ptr<Pipeline>> device_stages);
+
+  int num_device_stages() const noexcept {
+    return device_stages_.size();
+  }
+
+  Pipeline &host_stage() {
+    return *host_stage_;
+  }
+
+  Pipeline &device_stage(int idx) {
+    DALI_ENFORCE_VALID_INDEX(idx, device_stages_.size());
+    return *device_stages_[idx];
+  }
+
+  /**
+   * @brief Fills the prefetch queues of all the stages
+   *
+   * It must be called once, before calling `Run` and `Outputs`.
+   */
+  void Prefetch();
+
+  /**
+   * @brief Feeds each device stage with the next batch of the host stage and runs it
+   */
+  void Run();
+
+  /**
+   * @brief Obtains the outputs of the device stage `idx`; see Pipeline::Outputs
+   */
+  void Outputs(int idx, Workspace *ws);
+
+ private:
+  /**
+   * @brief Passes the next batch of the host stage to the device stage `idx`
+   *
+   * The host stage is scheduled to run again, so that its queue stays full.
+   */
+  void Feed(int idx);
+
+  std::unique_ptr<Pipeline> host_stage_;
+  std::vector<std::unique_ptr<Pipeline>> device_stages_;
+  Workspace host_ws_;
+  bool prefetched_ = false;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_PIPELINE_GROUP_H_
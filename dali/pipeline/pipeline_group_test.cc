@@ -0,0 +1,137 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/pipeline_group.h"
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "dali/test/dali_test_utils.h"
+
+namespace dali {
+
+namespace {
+
+std::unique_ptr<Pipeline> MakeHostStage(int batch_size) {
+  auto pipe = std::make_unique<Pipeline>(batch_size, 2, CPU_ONLY_DEVICE_ID);
+  pipe->AddExternalInput("raw");
+  pipe->AddOperator(OpSpec("Copy")
+          .AddArg("device", "cpu")
+          .AddInput("raw", "cpu")
+          .AddOutput("data", "cpu"));
+  pipe->Build({{"data", "cpu"}});
+  return pipe;
+}
+
+std::unique_ptr<Pipeline> MakeDeviceStage(int batch_size, int device_id,
+                                          const char *input_name = "data") {
+  auto pipe = std::make_unique<Pipeline>(batch_size, 1, device_id);
+  pipe->AddOperator(OpSpec("ExternalSource")
+          .AddArg("device", "gpu")
+          .AddArg("name", input_name)
+          .AddOutput(input_name, "gpu"));
+  pipe->AddOperator(OpSpec("Copy")
+          .AddArg("device", "gpu")
+          .AddInput(input_name, "gpu")
+          .AddOutput("out", "gpu"));
+  pipe->Build({{"out", "gpu"}});
+  return pipe;
+}
+
+/**
+ * @brief Splits `tl` into batches of `batch_size` samples
+ */
+std::vector<TensorList<CPUBackend>> SplitBatch(const TensorList<CPUBackend> &tl, int batch_size) {
+  std::vector<TensorList<CPUBackend>> batches(tl.num_samples() / batch_size);
+  for (size_t b = 0; b < batches.size(); b++) {
+    std::vector<TensorShape<>> shapes;
+    for (int j = 0; j < batch_size; j++)
+      shapes.push_back(tl.tensor_shape(b * batch_size + j));
+    batches[b].Resize(TensorListShape<>(shapes), DALI_UINT8);
+    for (int j = 0; j < batch_size; j++) {
+      std::memcpy(batches[b].mutable_tensor<uint8_t>(j),
+                  tl.tensor<uint8_t>(b * batch_size + j),
+                  volume(tl.tensor_shape(b * batch_size + j)));
+    }
+  }
+  return batches;
+}
+
+}  // namespace
+
+TEST(PipelineGroupTest, RoundRobin) {
+  constexpr int batch_size = 4;
+  constexpr int num_stages = 3;
+  constexpr int iters = 4;
+  // prefetching + running the host stage ahead of the device stages
+  constexpr int num_batches = 32;
+
+  TensorList<CPUBackend> tl;
+  test::MakeRandomBatch(tl, batch_size * num_batches);
+  auto batches = SplitBatch(tl, batch_size);
+
+  auto host = MakeHostStage(batch_size);
+  for (auto &batch : batches)
+    host->SetExternalInput("raw", batch);
+
+  int device_id = 0;
+  CUDA_CALL(cudaGetDevice(&device_id));
+  std::vector<std::unique_ptr<Pipeline>> stages;
+  for (int i = 0; i < num_stages; i++)
+    stages.push_back(MakeDeviceStage(batch_size, device_id));
+
+  PipelineGroup group(std::move(host), std::move(stages));
+  EXPECT_EQ(group.num_device_stages(), num_stages);
+  group.Prefetch();
+  for (int iter = 0; iter < iters; iter++) {
+    for (int i = 0; i < num_stages; i++) {
+      Workspace ws;
+      group.Outputs(i, &ws);
+      // the host batches are dealt round-robin
+      test::CheckResults(ws, batch_size, iter * num_stages + i, tl);
+    }
+    group.Run();
+  }
+}
+
+TEST(PipelineGroupTest, Validation) {
+  constexpr int batch_size = 4;
+  int device_id = 0;
+  CUDA_CALL(cudaGetDevice(&device_id));
+
+  {
+    std::vector<std::unique_ptr<Pipeline>> stages;
+    EXPECT_THROW(PipelineGroup(MakeHostStage(batch_size), std::move(stages)), std::exception);
+  }
+  {
+    std::vector<std::unique_ptr<Pipeline>> stages;
+    stages.push_back(MakeDeviceStage(batch_size, device_id, "other"));
+    EXPECT_THROW(PipelineGroup(MakeHostStage(batch_size), std::move(stages)), std::exception);
+  }
+  {
+    std::vector<std::unique_ptr<Pipeline>> stages;
+    stages.push_back(MakeDeviceStage(batch_size / 2, device_id));
+    EXPECT_THROW(PipelineGroup(MakeHostStage(batch_size), std::move(stages)), std::exception);
+  }
+  {
+    std::vector<std::unique_ptr<Pipeline>> stages;
+    stages.push_back(MakeDeviceStage(batch_size, device_id));
+    PipelineGroup group(MakeHostStage(batch_size), std::move(stages));
+    EXPECT_THROW(group.Run(), std::exception);
+  }
+}
+
+}  // namespace dali
@@ -277,6 +277,50 @@ TYPED_TEST(PipelineTest, TestSerialization) {
   EXPECT_EQ(CountNodes(loaded_graph, OpType::GPU), CountNodes(original_graph, OpType::GPU));
 }
 
+TYPED_TEST(PipelineTest, TestLoweredSerialization) {
+  int num_thread = TypeParam::nt;
+  int batch_size = this->jpegs_.nImages();
+
+  Pipeline pipe(batch_size, num_thread, 0);
+
+  pipe.AddExternalInput("data");
+
+  pipe.AddOperator(
+      OpSpec("Copy")
+      .AddArg("device", "gpu")
+      .AddInput("data", "gpu")
+      .AddOutput("copied", "gpu"));
+
+  vector<std::pair<string, string>> outputs = {{"copied", "gpu"}, {"data", "cpu"}};
+  EXPECT_THROW(pipe.SerializeLowered(), std::exception);
+  pipe.Build(outputs);
+  auto serialized = pipe.SerializeLowered();
+
+  Pipeline loaded_pipe(serialized, batch_size * 2, num_thread, 0);
+  loaded_pipe.Build(outputs);
+  EXPECT_EQ(loaded_pipe.max_batch_size(), batch_size * 2);
+
+  auto &original_graph = this->GetGraph(&pipe);
+  auto &loaded_graph = this->GetGraph(&loaded_pipe);
+
+  // The graph is the same, including the nodes added when it was lowered
+  ASSERT_EQ(loaded_graph.OpNodes().size(), original_graph.OpNodes().size());
+  auto it = loaded_graph.OpNodes().begin();
+  for (const graph::OpNode &node : original_graph.OpNodes()) {
+    const graph::OpNode &loaded = *it++;
+    EXPECT_EQ(loaded.instance_name, node.instance_name);
+    EXPECT_EQ(loaded.op_type, node.op_type);
+    EXPECT_EQ(loaded.spec.GetArgument<int64_t>("seed"), node.spec.GetArgument<int64_t>("seed"));
+    EXPECT_EQ(loaded.spec.GetArgument<int>("max_batch_size"), batch_size * 2);
+  }
+  ASSERT_EQ(loaded_graph.Outputs().size(), original_graph.Outputs().size());
+  for (size_t i = 0; i < original_graph.Outputs().size(); i++)
+    EXPECT_EQ(loaded_graph.Outputs()[i], original_graph.Outputs()[i]);
+
+  // A lowered pipeline is serialized in the same form
+  EXPECT_EQ(loaded_pipe.SerializeToProtobuf(), loaded_pipe.SerializeLowered());
+}
+
 class DummyPresizeOpCPU : public Operator<CPUBackend> {
  public:
   explicit DummyPresizeOpCPU(const OpSpec &spec)
@@ -895,5 +939,37 @@ TEST(PipelineTest, AutoName) {
   EXPECT_EQ(pipe.GetOperatorNode(name + "_3"), nullptr);
 }
 
+TEST(PipelineTest, WarmUp) {
+  int batch_size = 4;
+  Pipeline pipe(batch_size, 1, 0);
+  pipe.AddExternalInput("data", "cpu", DALI_INT32, 1);
+  pipe.AddOperator(
+      OpSpec("Copy")
+      .AddArg("device", "cpu")
+      .AddInput("data", "cpu")
+      .AddOutput("copied", "cpu"));
+  pipe.Build({{"copied", "cpu"}});
+
+  EXPECT_THROW(pipe.WarmUp({}), std::exception);  // no shape for "data"
+  EXPECT_THROW(pipe.WarmUp({{"data", uniform_list_shape(batch_size, {10})},
+                            {"other", uniform_list_shape(batch_size, {10})}}),
+               std::exception);
+  pipe.WarmUp({{"data", uniform_list_shape(batch_size, {1000})}}, 2);
+
+  TensorList<CPUBackend> data;
+  data.Resize(uniform_list_shape(batch_size, {3}), DALI_INT32);
+  for (int i = 0; i < batch_size; i++)
+    for (int j = 0; j < 3; j++)
+      data.mutable_tensor<int>(i)[j] = i * 3 + j;
+  pipe.SetExternalInput("data", data);
+  pipe.Run();
+  Workspace ws;
+  pipe.Outputs(&ws);
+  auto &out = ws.Output<CPUBackend>(0);
+  ASSERT_EQ(out.shape(), data.shape());
+  for (int i = 0; i < batch_size; i++)
+    for (int j = 0; j < 3; j++)
+      EXPECT_EQ(out.tensor<int>(i)[j], i * 3 + j);
+}
 
 }  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020, 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -247,7 +247,8 @@ void WriteBox(span<float> coords,
  * @brief Remaps relative bounding box coordinates to the coordinate space of a subwindow
  */
 template <int ndim>
-Box<ndim, float> RemapBox(const Box<ndim, float> &box, const Box<ndim, float> &crop) {
+DALI_HOST_DEV Box<ndim, float> RemapBox(const Box<ndim, float> &box,
+                                        const Box<ndim, float> &crop) {
   Box<ndim, float> mapped_box = box;
   auto rel_extent = crop.extent();
   auto start = (max(crop.lo, box.lo) - crop.lo) / rel_extent;
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <vector>
 #include "dali/pipeline/util/copy_with_stride.h"
+#include "dali/kernels/common/scatter_gather.h"
 
 namespace dali {
 
@@ -331,9 +332,9 @@ void ValidateBatch(int &element_size, int &ndim, std::vector<DLMTensorPtr> &dl_t
  * @brief Copies batch of DlTensors (which may be strided) into a batch of DALI tensors (which are
  * dense/compact).
  *
- * For the input DlTensors that are not strided, we simply run the cudaMemcpyAsync. Otherwise, a
- * copy kernel is used. The copy kernel will go over the output DALI tensors linearly (the tensor is
- * compact/dese) and translate the flat output indicies into input indicies.
+ * The input DlTensors that are not strided are copied as one scatter-gather batch. Otherwise, a
+ * strided copy kernel is used. The copy kernel will go over the output DALI tensors linearly
+ * (the tensor is compact/dese) and translate the flat output indicies into input indicies.
  *
  * The input batch is validated against some of DALI batch requirements, such as uniform data
  * type and dimensionality.
@@ -352,11 +353,12 @@ void CopyDlTensorBatchGpu(TensorList<GPUBackend> &output, std::vector<DLMTensorP
   int element_size, ndim;
   ValidateBatch(element_size, ndim, dl_tensors, batch_size);
   SmallVector<strided_copy::StridedCopyDesc, 32> sample_descs;
-  const auto cuda_mem_copy = [&output, element_size, stream](int sample_idx,
-                                                             const auto &dl_tensor) {
+  kernels::ScatterGatherGPU sg(1 << 18);  // 256 kB per block
+  const auto cuda_mem_copy = [&output, &sg, element_size](int sample_idx,
+                                                          const auto &dl_tensor) {
     void *out_data = output.raw_mutable_tensor(sample_idx);
     auto size = volume(dl_tensor.shape, dl_tensor.shape + dl_tensor.ndim) * element_size;
-    CUDA_CALL(cudaMemcpyAsync(out_data, dl_tensor.data, size, cudaMemcpyDeviceToDevice, stream));
+    sg.AddCopy(out_data, dl_tensor.data, size);
   };
   // If some innermost (the smallest in DALI tensor) strides match the strides of the incoming
   // DlPack tensor, we can stop the translation from output index to input index early. For that,
@@ -407,6 +409,7 @@ void CopyDlTensorBatchGpu(TensorList<GPUBackend> &output, std::vector<DLMTensorP
     // to the vector with samples for the kernel
     sample_descs.push_back(sample_desc);
   }
+  sg.Run(stream, true, kernels::ScatterGatherGPU::Method::Default, cudaMemcpyDeviceToDevice);
   if (sample_descs.size() > 0) {
     strided_copy::CopyBatch(make_span(sample_descs), max_mismatched_ndim, element_size, stream);
   }
@@ -15,6 +15,20 @@
 #ifndef DALI_PIPELINE_UTIL_LOOKAHEAD_PARSER_H_
 #define DALI_PIPELINE_UTIL_LOOKAHEAD_PARSER_H_
 
+// With SIMD enabled, RapidJSON skips the whitespace (i.e. the indentation of pretty-printed
+// annotation files) 16 bytes at a time. The loads are aligned, so they never cross a page boundary,
+// but they may read up to 15 bytes past the terminating null (see kJsonPadding).
+#if !defined(RAPIDJSON_SSE2) && !defined(RAPIDJSON_SSE42) && !defined(RAPIDJSON_NEON)
+#if defined(__SSE4_2__)
+#define RAPIDJSON_SSE42
+#elif defined(__SSE2__)
+#define RAPIDJSON_SSE2
+#elif defined(__ARM_NEON)
+#define RAPIDJSON_NEON
+#endif
+#endif
+
+#include <cstddef>
 #include <rapidjson/reader.h>
 #include <rapidjson/document.h>
 #include "dali/core/api_helper.h"
@@ -37,6 +51,9 @@ using rapidjson::kArrayType;
 using rapidjson::kObjectType;
 using rapidjson::kStringType;
 
+/** The number of bytes to allocate after the terminating null of the JSON text */
+constexpr size_t kJsonPadding = 16;
+
 // taken from https://github.com/Tencent/rapidjson/blob/master/example/lookaheadparser/lookaheadparser.cpp
 
 class LookaheadParserHandler {
@@ -0,0 +1,132 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/util/staging_ring.h"
+#include <algorithm>
+#include <cstring>
+#include "dali/core/cuda_error.h"
+#include "dali/core/device_guard.h"
+#include "dali/core/error_handling.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * The pieces are not larger than this, so that the gathering of large samples can be split
+ * between the threads; the pieces which are smaller are grouped into tasks of about this size.
+ */
+constexpr size_t kGatherGrain = 256 << 10;
+
+}  // namespace
+
+PinnedStagingRing::PinnedStagingRing(size_t chunk_size, int num_chunks)
+: chunk_size_(chunk_size), num_chunks_(num_chunks) {
+  DALI_ENFORCE(chunk_size > 0 && num_chunks > 0,
+               "The staging ring must have a positive number of non-empty chunks.");
+}
+
+PinnedStagingRing::~PinnedStagingRing() {
+  try {
+    DeviceGuard dg(device_id_);
+    for (int i = 0; i < static_cast<int>(events_.size()); i++)
+      if (pending_[i])
+        CUDA_CALL(cudaEventSynchronize(events_[i]));
+  } catch (const CUDAError &e) {
+    if (!e.is_unloading())
+      std::terminate();
+  }
+}
+
+void PinnedStagingRing::Copy(span<void * const> dst, span<const void * const> src,
+                             span<const size_t> sizes, cudaStream_t stream,
+                             ThreadPool *thread_pool) {
+  DALI_ENFORCE(dst.size() == src.size() && src.size() == sizes.size(),
+               "The number of the sources, destinations and sizes must match.");
+  if (!buffer_) {
+    CUDA_CALL(cudaGetDevice(&device_id_));
+    buffer_ = mm::alloc_raw_unique<uint8_t, mm::memory_kind::pinned>(chunk_size_ * num_chunks_);
+    events_.resize(num_chunks_);
+    for (auto &e : events_)
+      e = CUDAEvent::Create(device_id_);
+    pending_.resize(num_chunks_, false);
+  }
+
+  pieces_.clear();
+  chunk_used_ = 0;
+  for (int64_t i = 0; i < sizes.size(); i++) {
+    auto *s = static_cast<const uint8_t *>(src[i]);
+    auto *d = static_cast<uint8_t *>(dst[i]);
+    size_t remaining = sizes[i];
+    while (remaining > 0) {
+      size_t n = std::min({ remaining, chunk_size_ - chunk_used_, kGatherGrain });
+      pieces_.push_back({ s, d, n, chunk_used_ });
+      s += n;
+      d += n;
+      remaining -= n;
+      chunk_used_ += n;
+      if (chunk_used_ == chunk_size_)
+        Flush(stream, thread_pool);
+    }
+  }
+  if (chunk_used_ > 0)
+    Flush(stream, thread_pool);
+}
+
+void PinnedStagingRing::Flush(cudaStream_t stream, ThreadPool *thread_pool) {
+  int idx = next_chunk_;
+  next_chunk_ = (next_chunk_ + 1) % num_chunks_;
+  if (pending_[idx]) {
+    CUDA_CALL(cudaEventSynchronize(events_[idx]));
+    pending_[idx] = false;
+  }
+  uint8_t *chunk = buffer_.get() + idx * chunk_size_;
+  Gather(chunk, thread_pool);
+
+  for (size_t i = 0; i < pieces_.size(); ) {
+    uint8_t *dst = pieces_[i].dst;
+    size_t offset = pieces_[i].offset;
+    size_t size = pieces_[i].size;
+    // The pieces are laid out in the chunk one after another - merge the ones which are also
+    // adjacent in the destination
+    for (i++; i < pieces_.size() && pieces_[i].dst == dst + size; i++)
+      size += pieces_[i].size;
+    CUDA_CALL(cudaMemcpyAsync(dst, chunk + offset, size, cudaMemcpyHostToDevice, stream));
+  }
+  CUDA_CALL(cudaEventRecord(events_[idx], stream));
+  pending_[idx] = true;
+  pieces_.clear();
+  chunk_used_ = 0;
+}
+
+void PinnedStagingRing::Gather(uint8_t *chunk, ThreadPool *thread_pool) {
+  if (!thread_pool || thread_pool->NumThreads() < 2 || chunk_used_ <= kGatherGrain) {
+    for (auto &p : pieces_)
+      std::memcpy(chunk + p.offset, p.src, p.size);
+    return;
+  }
+  for (size_t begin = 0; begin < pieces_.size(); ) {
+    size_t end = begin, bytes = 0;
+    while (end < pieces_.size() && bytes < kGatherGrain)
+      bytes += pieces_[end++].size;
+    thread_pool->AddWork([this, chunk, begin, end](int) {
+      for (size_t i = begin; i < end; i++)
+        std::memcpy(chunk + pieces_[i].offset, pieces_[i].src, pieces_[i].size);
+    }, bytes);
+    begin = end;
+  }
+  thread_pool->RunAll();
+}
+
+}  // namespace dali
@@ -0,0 +1,101 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_UTIL_STAGING_RING_H_
+#define DALI_PIPELINE_UTIL_STAGING_RING_H_
+
+#include <cuda_runtime_api.h>
+#include <cstdint>
+#include <vector>
+#include "dali/core/api_helper.h"
+#include "dali/core/cuda_event.h"
+#include "dali/core/mm/memory.h"
+#include "dali/core/span.h"
+#include "dali/pipeline/util/thread_pool.h"
+
+namespace dali {
+
+/**
+ * @brief A persistent pinned buffer through which scattered host data is copied to the device.
+ *
+ * The buffer is divided into a few chunks. The source data is gathered into a chunk (in parallel,
+ * if a thread pool is given) and the chunk is copied to the device asynchronously, while the next
+ * chunk is being gathered - the host-side gathering overlaps with the DMA transfer.
+ * A chunk is reused only after its previous transfer has completed.
+ *
+ * The transfers of the pieces that land next to each other in the device memory are merged,
+ * so a batch copied to a contiguous buffer needs one transfer per chunk.
+ *
+ * The ring is meant to be owned by an object which issues its copies on one stream (e.g. an
+ * operator); it's not thread-safe.
+ */
+class DLL_PUBLIC PinnedStagingRing {
+ public:
+  static constexpr size_t kDefaultChunkSize = 2 << 20;
+  static constexpr int kDefaultNumChunks = 4;
+
+  explicit PinnedStagingRing(size_t chunk_size = kDefaultChunkSize,
+                             int num_chunks = kDefaultNumChunks);
+
+  /**
+   * @brief Waits for the pending transfers.
+   */
+  ~PinnedStagingRing();
+
+  PinnedStagingRing(const PinnedStagingRing &) = delete;
+  PinnedStagingRing &operator=(const PinnedStagingRing &) = delete;
+
+  /**
+   * @brief Copies `sizes[i]` bytes from host memory at `src[i]` to device memory at `dst[i]`.
+   *
+   * The function returns when all the data has been gathered and all the transfers have been
+   * issued on `stream`; the source buffers can be reused then, but the destination is ready
+   * only in `stream` order.
+   */
+  void Copy(span<void * const> dst, span<const void * const> src, span<const size_t> sizes,
+            cudaStream_t stream, ThreadPool *thread_pool = nullptr);
+
+  size_t chunk_size() const noexcept {
+    return chunk_size_;
+  }
+
+  int num_chunks() const noexcept {
+    return num_chunks_;
+  }
+
+ private:
+  struct Piece {
+    const uint8_t *src;
+    uint8_t *dst;
+    size_t size;
+    size_t offset;  // within the chunk
+  };
+
+  void Flush(cudaStream_t stream, ThreadPool *thread_pool);
+  void Gather(uint8_t *chunk, ThreadPool *thread_pool);
+
+  size_t chunk_size_;
+  int num_chunks_;
+  int next_chunk_ = 0;
+  int device_id_ = -1;
+  mm::uptr<uint8_t> buffer_;
+  std::vector<CUDAEvent> events_;
+  std::vector<bool> pending_;
+  std::vector<Piece> pieces_;
+  size_t chunk_used_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_UTIL_STAGING_RING_H_
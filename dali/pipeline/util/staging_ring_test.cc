@@ -0,0 +1,96 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/util/staging_ring.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "dali/core/cuda_stream.h"
+#include "dali/core/dev_buffer.h"
+
+namespace dali {
+namespace test {
+
+namespace {
+
+void TestStagedCopy(PinnedStagingRing &ring, ThreadPool *tp, bool contiguous_dst) {
+  std::mt19937_64 rng(1234);
+  std::uniform_int_distribution<size_t> size_dist(0, 3 * ring.chunk_size() / 2);
+  int num_samples = 20;
+  std::vector<std::vector<uint8_t>> samples(num_samples);
+  std::vector<size_t> sizes(num_samples);
+  size_t total = 0;
+  for (int i = 0; i < num_samples; i++) {
+    sizes[i] = i % 5 == 0 ? size_dist(rng) : size_dist(rng) / 100;
+    samples[i].resize(sizes[i]);
+    for (auto &x : samples[i])
+      x = rng();
+    total += sizes[i];
+  }
+
+  // leave gaps between the samples, if the destination is not contiguous
+  size_t gap = contiguous_dst ? 0 : 16;
+  DeviceBuffer<uint8_t> out;
+  out.resize(total + gap * num_samples);
+  std::vector<void *> dst(num_samples);
+  std::vector<const void *> src(num_samples);
+  size_t offset = 0;
+  for (int i = 0; i < num_samples; i++) {
+    dst[i] = out.data() + offset;
+    src[i] = samples[i].data();
+    offset += sizes[i] + gap;
+  }
+
+  CUDAStream stream = CUDAStream::Create(true);
+  ring.Copy(make_cspan(dst), make_cspan(src), make_cspan(sizes), stream, tp);
+  // the sources can be overwritten once Copy returns
+  for (auto &s : samples)
+    for (auto &x : s)
+      x = ~x;
+
+  std::vector<uint8_t> host(out.size());
+  CUDA_CALL(cudaMemcpyAsync(host.data(), out.data(), out.size(), cudaMemcpyDeviceToHost, stream));
+  CUDA_CALL(cudaStreamSynchronize(stream));
+  offset = 0;
+  for (int i = 0; i < num_samples; i++) {
+    for (size_t j = 0; j < sizes[i]; j++)
+      ASSERT_EQ(host[offset + j], static_cast<uint8_t>(~samples[i][j]))
+          << "at sample " << i << " byte " << j;
+    offset += sizes[i] + gap;
+  }
+}
+
+}  // namespace
+
+TEST(PinnedStagingRing, ContiguousDestination) {
+  PinnedStagingRing ring(64 << 10, 3);
+  for (int iter = 0; iter < 3; iter++)
+    TestStagedCopy(ring, nullptr, true);
+}
+
+TEST(PinnedStagingRing, ScatteredDestination) {
+  PinnedStagingRing ring(64 << 10, 3);
+  for (int iter = 0; iter < 3; iter++)
+    TestStagedCopy(ring, nullptr, false);
+}
+
+TEST(PinnedStagingRing, ParallelGather) {
+  ThreadPool tp(4, 0, false, "PinnedStagingRing test");
+  PinnedStagingRing ring(1 << 20, 2);
+  for (int iter = 0; iter < 3; iter++)
+    TestStagedCopy(ring, &tp, iter % 2 == 0);
+}
+
+}  // namespace test
+}  // namespace dali
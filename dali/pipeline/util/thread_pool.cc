@@ -12,23 +12,50 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <utility>
 #include "dali/pipeline/util/thread_pool.h"
+#include "dali/pipeline/util/worker_slots.h"
 #if NVML_ENABLED
 #include "dali/util/nvml.h"
 #endif
 #include "dali/core/format.h"
 #include "dali/core/cuda_error.h"
 #include "dali/core/device_guard.h"
+#include "dali/core/mm/memory_tag.h"
 #include "dali/core/nvtx.h"
 
 namespace dali {
 
+namespace {
+
+/** Makes the work run in the caller's memory tracking context (see mm::MemoryTagScope). */
+void PropagateMemoryTagContext(ThreadPool::Work &work) {
+  auto &ctx = mm::GetMemoryTagContext();
+  if (!ctx.tracker)
+    return;
+  work = [ctx, inner = std::move(work)](int thread_id) {
+    mm::MemoryTagScope scope(ctx);
+    inner(thread_id);
+  };
+}
+
+}  // namespace
+
 ThreadPool::ThreadPool(int num_thread, int device_id, bool set_affinity, const char* name)
     : threads_(num_thread), running_(true), work_complete_(true), started_(false)
     , active_threads_(0) {
   DALI_ENFORCE(num_thread > 0, "Thread pool must have non-zero size");
+  worker_queues_.resize(num_thread);
+  for (auto &q : worker_queues_)
+    q = std::make_unique<WorkerQueue>();
+  if (metrics::Enabled()) {
+    queue_length_metric_ = metrics::Metric(
+        "dali_thread_pool_queue_length", metrics::MetricKind::Gauge,
+        metrics::Label("pool", name), "The number of tasks waiting in the thread pool.");
+  }
 #if NVML_ENABLED
   // We use NVML only for setting thread affinity
   if (device_id != CPU_ONLY_DEVICE_ID && set_affinity) {
@@ -57,13 +84,16 @@ ThreadPool::~ThreadPool() {
 }
 
 void ThreadPool::AddWork(Work work, int64_t priority, bool start_immediately) {
+  PropagateMemoryTagContext(work);
   bool started_before = false;
   {
     std::lock_guard<std::mutex> lock(mutex_);
     work_queue_.push({priority, std::move(work)});
+    UpdateQueueLengthMetric();
     work_complete_ = false;
     started_before = started_;
-    started_ |= start_immediately;
+    if (start_immediately)
+      started_ = true;
   }
   if (started_) {
     if (!started_before)
@@ -73,8 +103,40 @@ void ThreadPool::AddWork(Work work, int64_t priority, bool start_immediately) {
   }
 }
 
+void ThreadPool::AddWorkBatch(span<PrioritizedWork> work, bool start_immediately) {
+  if (work.empty())
+    return;
+  for (auto &w : work)
+    PropagateMemoryTagContext(w.second);
+  std::stable_sort(work.begin(), work.end(), [](const auto &a, const auto &b) {
+    return a.first > b.first;
+  });
+  int nthreads = worker_queues_.size();
+  int64_t n = work.size();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    batch_outstanding_ += n;
+    // Deal the work round-robin, so that each thread starts with the highest priority
+    // work it got and the lowest priority work is left for stealing.
+    for (int t = 0; t < nthreads; t++) {
+      std::lock_guard<std::mutex> queue_lock(worker_queues_[t]->mutex);
+      for (int64_t i = t; i < n; i += nthreads)
+        worker_queues_[t]->work.push_back(std::move(work[i].second));
+    }
+    batch_queued_ += n;
+    UpdateQueueLengthMetric();
+    work_complete_ = false;
+    if (start_immediately)
+      started_ = true;
+  }
+  if (started_)
+    condition_.notify_all();
+}
+
 // Blocks until all work issued to the thread pool is complete
 void ThreadPool::WaitForWork(bool checkForErrors) {
+  // Waiting in a worker of another pool mustn't hold a slot needed by the workers of this one
+  WorkerSlots::YieldGuard yield(WorkerSlots::Global());
   std::unique_lock<std::mutex> lock(mutex_);
   completed_.wait(lock, [this] { return this->work_complete_; });
   started_ = false;
@@ -115,6 +177,70 @@ std::vector<std::thread::id> ThreadPool::GetThreadIds() const {
 }
 
 
+bool ThreadPool::TryGetBatchWork(int thread_id, Work &work) {
+  if (batch_queued_ <= 0)
+    return false;
+  int nthreads = worker_queues_.size();
+  for (int i = 0; i < nthreads; i++) {
+    auto &q = *worker_queues_[(thread_id + i) % nthreads];
+    std::lock_guard<std::mutex> queue_lock(q.mutex);
+    if (q.work.empty())
+      continue;
+    if (i == 0) {
+      // own queue - take the highest priority work
+      work = std::move(q.work.front());
+      q.work.pop_front();
+    } else {
+      // someone else's queue - steal the lowest priority work
+      work = std::move(q.work.back());
+      q.work.pop_back();
+    }
+    --batch_queued_;
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::FinishBatchWork() {
+  if (--batch_outstanding_ > 0)
+    return;
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (work_queue_.empty() && active_threads_ == 0 && batch_outstanding_ == 0) {
+    work_complete_ = true;
+    lock.unlock();
+    completed_.notify_one();
+  }
+}
+
+void ThreadPool::RunWork(int thread_id, Work &work) {
+  // Don't exceed the process-wide number of running workers, if set
+  WorkerSlots::Guard slot(WorkerSlots::Global());
+  auto start = std::chrono::steady_clock::now();
+  // If an error occurs, we save it in tl_errors_. When
+  // WaitForWork is called, we will check for any errors
+  // in the threads and return an error if one occured.
+  try {
+    work(thread_id);
+  } catch (std::exception &e) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tl_errors_[thread_id].push(e.what());
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tl_errors_[thread_id].push("Caught unknown exception");
+  }
+  auto &busy = worker_queues_[thread_id]->busy_ns;
+  int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start).count();
+  busy.store(busy.load(std::memory_order_relaxed) + elapsed, std::memory_order_relaxed);
+}
+
+int64_t ThreadPool::GetBusyTime() const {
+  int64_t total = 0;
+  for (auto &q : worker_queues_)
+    total += q->busy_ns.load(std::memory_order_relaxed);
+  return total;
+}
+
 void ThreadPool::ThreadMain(int thread_id, int device_id, bool set_affinity,
                             const std::string &name) {
   SetThreadName(name.c_str());
@@ -144,40 +270,40 @@ void ThreadPool::ThreadMain(int thread_id, int device_id, bool set_affinity,
   }
 
   while (running_) {
+    // The batch work doesn't need the pool's lock
+    Work work;
+    if (started_ && TryGetBatchWork(thread_id, work)) {
+      RunWork(thread_id, work);
+      FinishBatchWork();
+      continue;
+    }
+
     // Block on the condition to wait for work
     std::unique_lock<std::mutex> lock(mutex_);
-    condition_.wait(lock, [this] { return !running_ || (!work_queue_.empty() && started_); });
+    condition_.wait(lock, [this] {
+      return !running_ || (started_ && (!work_queue_.empty() || batch_queued_ > 0));
+    });
     // If we're no longer running, exit the run loop
     if (!running_) break;
+    // Only the batch work is available - go and get it
+    if (work_queue_.empty()) continue;
 
     // Get work from the queue & mark
     // this thread as active
-    Work work = std::move(work_queue_.top().second);
+    work = std::move(work_queue_.top().second);
     work_queue_.pop();
+    UpdateQueueLengthMetric();
     ++active_threads_;
 
     // Unlock the lock
     lock.unlock();
 
-    // If an error occurs, we save it in tl_errors_. When
-    // WaitForWork is called, we will check for any errors
-    // in the threads and return an error if one occured.
-    try {
-      work(thread_id);
-    } catch (std::exception &e) {
-      lock.lock();
-      tl_errors_[thread_id].push(e.what());
-      lock.unlock();
-    } catch (...) {
-      lock.lock();
-      tl_errors_[thread_id].push("Caught unknown exception");
-      lock.unlock();
-    }
+    RunWork(thread_id, work);
 
     // Mark this thread as idle & check for complete work
     lock.lock();
     --active_threads_;
-    if (work_queue_.empty() && active_threads_ == 0) {
+    if (work_queue_.empty() && active_threads_ == 0 && batch_outstanding_ == 0) {
       work_complete_ = true;
       lock.unlock();
       completed_.notify_one();
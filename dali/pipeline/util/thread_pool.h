@@ -15,16 +15,21 @@
 #ifndef DALI_PIPELINE_UTIL_THREAD_POOL_H_
 #define DALI_PIPELINE_UTIL_THREAD_POOL_H_
 
+#include <atomic>
 #include <cstdlib>
 #include <utility>
 #include <condition_variable>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
 #include <vector>
 #include <string>
 #include "dali/core/common.h"
+#include "dali/core/metrics.h"
+#include "dali/core/span.h"
 #if NVML_ENABLED
 #include "dali/util/nvml.h"
 #endif
@@ -36,6 +41,7 @@ class DLL_PUBLIC ThreadPool {
  public:
   // Basic unit of work that our threads do
   typedef std::function<void(int)> Work;
+  using PrioritizedWork = std::pair<int64_t, Work>;
 
   DLL_PUBLIC ThreadPool(int num_thread, int device_id, bool set_affinity, const char* name);
 
@@ -54,6 +60,20 @@ class DLL_PUBLIC ThreadPool {
    */
   DLL_PUBLIC void AddWork(Work work, int64_t priority = 0, bool start_immediately = false);
 
+  /**
+   * @brief Adds a batch of work (priority, work) and optionally starts processing
+   *
+   * The work is moved out of `work`, ordered by decreasing priority and dealt to per-thread
+   * queues, so the whole batch takes the pool's lock only once. Each thread processes its own
+   * queue first and, once it's empty, steals the lowest priority work from the other threads.
+   * Useful for many small tasks, when the contention on the shared queue of AddWork is
+   * significant.
+   *
+   * The priorities order the work within the batch only - there's no ordering guarantee
+   * between the batches or with respect to the work added with AddWork.
+   */
+  DLL_PUBLIC void AddWorkBatch(span<PrioritizedWork> work, bool start_immediately = false);
+
   /**
    * @brief Wakes up all the threads to complete all the queued work,
    *        optionally not waiting for the work to be finished before return
@@ -70,15 +90,36 @@ class DLL_PUBLIC ThreadPool {
 
   DLL_PUBLIC std::vector<std::thread::id> GetThreadIds() const;
 
+  /**
+   * @brief Returns the total time, in nanoseconds, the threads spent running the work
+   */
+  DLL_PUBLIC int64_t GetBusyTime() const;
+
   DISABLE_COPY_MOVE_ASSIGN(ThreadPool);
 
  private:
   DLL_PUBLIC void ThreadMain(int thread_id, int device_id, bool set_affinity,
                              const std::string &name);
 
+  /**
+   * @brief Takes the work from the thread's own queue or steals it from another thread
+   */
+  bool TryGetBatchWork(int thread_id, Work &work);
+
+  /**
+   * @brief Marks a piece of the batch work as done and checks if all the work is complete
+   */
+  void FinishBatchWork();
+
+  void RunWork(int thread_id, Work &work);
+
+  /** Reports the number of queued pieces of work; must be called with `mutex_` held */
+  void UpdateQueueLengthMetric() {
+    queue_length_metric_.Set(work_queue_.size() + batch_queued_);
+  }
+
   vector<std::thread> threads_;
 
-  using PrioritizedWork = std::pair<int64_t, Work>;
   struct SortByPriority {
     bool operator() (const PrioritizedWork &a, const PrioritizedWork &b) {
       return a.first < b.first;
@@ -86,9 +127,22 @@ class DLL_PUBLIC ThreadPool {
   };
   std::priority_queue<PrioritizedWork, std::vector<PrioritizedWork>, SortByPriority> work_queue_;
 
+  // The per-thread queues of AddWorkBatch
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Work> work;
+    // The time the thread spent running the work (of any kind); written only by the thread
+    std::atomic<int64_t> busy_ns{0};
+  };
+  vector<std::unique_ptr<WorkerQueue>> worker_queues_;
+  // The number of pieces of batch work waiting in the queues
+  std::atomic<int64_t> batch_queued_{0};
+  // The number of pieces of batch work not yet complete
+  std::atomic<int64_t> batch_outstanding_{0};
+
   bool running_;
   bool work_complete_;
-  bool started_;
+  std::atomic<bool> started_;
   int active_threads_;
   std::mutex mutex_;
   std::condition_variable condition_;
@@ -96,6 +150,9 @@ class DLL_PUBLIC ThreadPool {
 
   //  Stored error strings for each thread
   vector<std::queue<string>> tl_errors_;
+
+  // Registered only if the metrics are enabled when the pool is created
+  metrics::Metric queue_length_metric_;
 #if NVML_ENABLED
   nvml::NvmlInstance nvml_handle_;
 #endif
@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -14,7 +14,13 @@
 
 #include "dali/pipeline/util/thread_pool.h"
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "dali/pipeline/util/worker_slots.h"
 
 namespace dali {
 
@@ -68,6 +74,60 @@ TEST(ThreadPool, AddWorkWithPriority) {
   ASSERT_EQ(((1+1) << 3) + 1, count);
 }
 
+TEST(ThreadPool, AddWorkBatch) {
+  ThreadPool tp(16, 0, false, "ThreadPool test");
+  std::atomic<int> count{0};
+  auto increase = [&count](int thread_id) { count++; };
+  std::vector<ThreadPool::PrioritizedWork> work;
+  for (int i = 0; i < 1000; i++)
+    work.emplace_back(i % 7, increase);
+  tp.AddWorkBatch(make_span(work));
+  ASSERT_EQ(count, 0);
+  tp.RunAll();
+  ASSERT_EQ(count, 1000);
+}
+
+TEST(ThreadPool, AddWorkBatchImmediateStart) {
+  ThreadPool tp(16, 0, false, "ThreadPool test");
+  std::atomic<int> count{0};
+  auto increase = [&count](int thread_id) { count++; };
+  for (int b = 0; b < 10; b++) {
+    std::vector<ThreadPool::PrioritizedWork> work(100, {0, increase});
+    tp.AddWorkBatch(make_span(work), true);
+    tp.AddWork(increase, 0, true);
+  }
+  tp.WaitForWork();
+  ASSERT_EQ(count, 1010);
+}
+
+TEST(ThreadPool, AddWorkBatchWithPriority) {
+  // only one thread to ensure deterministic behavior
+  ThreadPool tp(1, 0, false, "ThreadPool test");
+  std::vector<int> order;
+  std::vector<ThreadPool::PrioritizedWork> work;
+  for (int i : {3, 1, 4, 1, 5, 9, 2, 6}) {
+    work.emplace_back(i, [&order, i](int thread_id) { order.push_back(i); });
+  }
+  tp.AddWorkBatch(make_span(work));
+  tp.RunAll();
+  ASSERT_EQ(order, (std::vector<int>{9, 6, 5, 4, 3, 2, 1, 1}));
+}
+
+TEST(ThreadPool, AddWorkBatchError) {
+  ThreadPool tp(4, 0, false, "ThreadPool test");
+  std::atomic<int> count{0};
+  std::vector<ThreadPool::PrioritizedWork> work;
+  for (int i = 0; i < 64; i++) {
+    work.emplace_back(0, [&count, i](int thread_id) {
+      count++;
+      if (i == 42)
+        throw std::runtime_error("Test error");
+    });
+  }
+  tp.AddWorkBatch(make_span(work));
+  ASSERT_THROW(tp.RunAll(), std::runtime_error);
+  ASSERT_EQ(count, 64);
+}
 
 TEST(ThreadPool, CheckName) {
   const char given_thread_pool_name[] = "ThreadPool test";
@@ -87,6 +147,39 @@ TEST(ThreadPool, CheckName) {
                       std::min(sizeof(full_thread_pool_name), sizeof(read_thread_pool_name)) - 1));
 }
 
+TEST(ThreadPool, WorkerSlots) {
+  auto &slots = WorkerSlots::Global();
+  int prev_limit = slots.Limit();
+  slots.SetLimit(3);
+  ThreadPool tp1(4, 0, false, "ThreadPool test 1");
+  ThreadPool tp2(4, 0, false, "ThreadPool test 2");
+  std::atomic<int> active{0}, max_active{0};
+  auto work = [&](int) {
+    int now = ++active;
+    int prev = max_active.load();
+    while (now > prev && !max_active.compare_exchange_weak(prev, now)) {}
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    --active;
+  };
+  for (int i = 0; i < 32; i++) {
+    tp1.AddWork(work);
+    tp2.AddWork(work);
+  }
+  tp1.RunAll(false);
+  // a worker of tp1 waits for nested work - it must not hold a slot while waiting
+  ThreadPool nested(2, 0, false, "ThreadPool nested");
+  tp1.AddWork([&](int) {
+    for (int i = 0; i < 8; i++)
+      nested.AddWork(work);
+    nested.RunAll();
+  }, 0, true);
+  tp2.RunAll();
+  tp1.WaitForWork();
+  slots.SetLimit(prev_limit);
+  EXPECT_LE(max_active, 3);
+  EXPECT_GT(max_active, 0);
+}
+
 }  // namespace test
 
 }  // namespace dali
@@ -0,0 +1,92 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/util/worker_slots.h"
+#include <cstdlib>
+#include "dali/core/error_handling.h"
+
+namespace dali {
+
+namespace {
+
+// The number of slots held by the current thread - more than one if a worker runs the work
+// of another pool inline.
+thread_local int tls_held_slots = 0;
+
+}  // namespace
+
+WorkerSlots &WorkerSlots::Global() {
+  static WorkerSlots slots;
+  return slots;
+}
+
+WorkerSlots::WorkerSlots() {
+  if (const char *env = std::getenv("DALI_MAX_ACTIVE_WORKERS")) {
+    int limit = atoi(env);
+    if (limit > 0)
+      limit_ = limit;
+  }
+}
+
+void WorkerSlots::SetLimit(int limit) {
+  DALI_ENFORCE(limit >= 0, make_string("The limit of active workers must not be negative, got: ",
+                                       limit));
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    limit_ = limit;
+  }
+  cv_.notify_all();
+}
+
+bool WorkerSlots::Acquire() {
+  if (limit_.load(std::memory_order_relaxed) == 0)
+    return false;
+  WaitForSlot();
+  return true;
+}
+
+void WorkerSlots::WaitForSlot() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [&]() {
+    int limit = limit_.load(std::memory_order_relaxed);
+    return limit == 0 || active_ < limit;
+  });
+  // the slot is counted even if the limit was lifted in the meantime - it's returned anyway
+  active_++;
+  tls_held_slots++;
+}
+
+void WorkerSlots::Release() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    active_--;
+    tls_held_slots--;
+  }
+  cv_.notify_one();
+}
+
+WorkerSlots::YieldGuard::YieldGuard(WorkerSlots &slots) : slots_(slots) {
+  if (tls_held_slots > 0) {
+    slots_.Release();
+    yielded_ = true;
+  }
+}
+
+WorkerSlots::YieldGuard::~YieldGuard() {
+  // the owner of the slot will release it - take it back even if the limit was lifted
+  if (yielded_)
+    slots_.WaitForSlot();
+}
+
+}  // namespace dali
@@ -0,0 +1,93 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_UTIL_WORKER_SLOTS_H_
+#define DALI_PIPELINE_UTIL_WORKER_SLOTS_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include "dali/core/api_helper.h"
+#include "dali/core/common.h"
+
+namespace dali {
+
+/**
+ * @brief A process-wide limit of the number of worker threads that run work at the same time
+ *
+ * Each pipeline has its own thread pool (and the decoders may have more), so with several
+ * pipelines in a process, there are many more worker threads than cores. When a limit is set,
+ * the workers of all the ThreadPools take a slot before running a piece of work and return it
+ * afterwards - the excess threads wait instead of contending for the cores.
+ *
+ * A thread which holds a slot and waits for other work (e.g. a nested ThreadPool) should give
+ * up its slot for the time of waiting (see YieldGuard); otherwise the slots could be exhausted
+ * by the waiting threads.
+ *
+ * The initial limit is taken from the DALI_MAX_ACTIVE_WORKERS environment variable;
+ * 0 (the default) means no limit.
+ */
+class DLL_PUBLIC WorkerSlots {
+ public:
+  DLL_PUBLIC static WorkerSlots &Global();
+
+  /** Sets the maximum number of workers running at the same time; 0 disables the limit. */
+  DLL_PUBLIC void SetLimit(int limit);
+
+  int Limit() const noexcept { return limit_.load(std::memory_order_relaxed); }
+
+  /** Takes a slot for the calling thread, for the lifetime of the object */
+  class DLL_PUBLIC Guard {
+   public:
+    explicit Guard(WorkerSlots &slots) : slots_(slots), acquired_(slots.Acquire()) {}
+    ~Guard() {
+      if (acquired_)
+        slots_.Release();
+    }
+    DISABLE_COPY_MOVE_ASSIGN(Guard);
+
+   private:
+    WorkerSlots &slots_;
+    bool acquired_;
+  };
+
+  /** Returns the slot held by the calling thread (if any) for the lifetime of the object */
+  class DLL_PUBLIC YieldGuard {
+   public:
+    explicit YieldGuard(WorkerSlots &slots);
+    ~YieldGuard();
+    DISABLE_COPY_MOVE_ASSIGN(YieldGuard);
+
+   private:
+    WorkerSlots &slots_;
+    bool yielded_ = false;
+  };
+
+ private:
+  WorkerSlots();
+
+  /** Waits for a free slot; returns false (without waiting) if there's no limit. */
+  DLL_PUBLIC bool Acquire();
+  DLL_PUBLIC void Release();
+  void WaitForSlot();
+
+  std::atomic<int> limit_{0};
+  int active_ = 0;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_UTIL_WORKER_SLOTS_H_
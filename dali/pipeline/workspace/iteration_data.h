@@ -19,6 +19,8 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
+#include "dali/core/cuda_shared_event.h"
 
 namespace dali {
 
@@ -69,6 +71,18 @@ class OperatorTraces {
   > map_;
 };
 
+/**
+ * A user-provided buffer in which a GPU pipeline output is to be produced.
+ *
+ * @see Pipeline::SetOutputBuffer
+ */
+struct ExternalOutputBuffer {
+  void *data = nullptr;
+  size_t size = 0;
+  /** If set, the buffer can be written to only after this event */
+  CUDASharedEvent ready;
+};
+
 /**
  * Contains the data of an iteration. This data is shared across all Workspaces that belong to
  * a single iteration.
@@ -87,6 +101,9 @@ struct IterationData {
 
   OperatorTraces operator_traces;
   std::shared_ptr<Checkpoint> checkpoint;
+
+  /** The user-provided buffers for the pipeline outputs, indexed by the output; may be empty. */
+  std::vector<ExternalOutputBuffer> output_buffers;
 };
 
 using SharedIterData = std::shared_ptr<IterationData>;
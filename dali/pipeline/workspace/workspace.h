@@ -23,6 +23,7 @@
 #include <unordered_map>
 
 #include "dali/core/common.h"
+#include "dali/core/mm/host_arena.h"
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/data/tensor.h"
 #include "dali/pipeline/data/tensor_list.h"
@@ -350,6 +351,28 @@ class WorkspaceBase : public ArgumentWorkspace {
     return *thread_pool_;
   }
 
+  /**
+   * @brief Sets the arena used for the temporary host allocations of the operator.
+   *
+   * @see HostArena
+   */
+  inline void SetHostArena(mm::host_memory_resource *arena) {
+    host_arena_ = arena;
+  }
+
+  /**
+   * @brief Returns a memory resource for the temporary host allocations of the operator.
+   *
+   * The executor resets the arena after the operator's Run, so the memory must not be used
+   * afterwards. The arena is not thread-safe - use it only in the thread which calls Setup and
+   * Run, not in the thread pool tasks.
+   * If there's no arena, the memory is allocated on the heap and must be freed as usual
+   * (e.g. by using mm::arena_allocator).
+   */
+  inline mm::host_memory_resource *HostArena() const {
+    return host_arena_ ? host_arena_ : &mm::malloc_memory_resource::instance();
+  }
+
   /**
    * @brief Returns true if this workspace has CUDA stream available
    */
@@ -703,6 +726,7 @@ class WorkspaceBase : public ArgumentWorkspace {
 
   AccessOrder output_order_ = AccessOrder::host();
   ThreadPool *thread_pool_ = nullptr;
+  mm::host_memory_resource *host_arena_ = nullptr;
   cudaEvent_t event_ = nullptr;
   SmallVector<cudaEvent_t, 4> parent_events_;
 
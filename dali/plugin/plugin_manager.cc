@@ -14,10 +14,17 @@
 
 #include "dali/plugin/plugin_manager.h"
 #include <dlfcn.h>
+#include <algorithm>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <utility>
 #include "dali/core/error_handling.h"
+#include "dali/pipeline/operator/op_schema.h"
 
 namespace fs = std::filesystem;
 
@@ -40,6 +47,108 @@ void PluginManager::LoadLibrary(const std::string& lib_path, bool global_symbols
   }
 }
 
+namespace {
+
+struct LazyLibrary {
+  std::string path;
+  bool global_symbols;
+  bool allow_fail;
+};
+
+struct LazyOp {
+  std::shared_ptr<LazyLibrary> lib;
+  std::vector<std::string> devices;
+};
+
+struct LazyRegistry {
+  // recursive, because loading a library may look up other schemas
+  std::recursive_mutex mtx;
+  std::map<std::string, LazyOp> ops;
+};
+
+LazyRegistry& GetLazyRegistry() {
+  static LazyRegistry registry;
+  return registry;
+}
+
+bool LoadLazySchema(const std::string& schema_name) {
+  auto& registry = GetLazyRegistry();
+  std::lock_guard<std::recursive_mutex> guard(registry.mtx);
+  auto it = registry.ops.find(schema_name);
+  if (it == registry.ops.end())
+    return false;
+  auto lib = it->second.lib;
+  // the library is loaded once - remove all of its operators, not only the requested one
+  for (auto op = registry.ops.begin(); op != registry.ops.end();) {
+    if (op->second.lib == lib)
+      op = registry.ops.erase(op);
+    else
+      ++op;
+  }
+  PluginManager::LoadLibrary(lib->path, lib->global_symbols, lib->allow_fail);
+  return true;
+}
+
+}  // namespace
+
+void PluginManager::RegisterLazyLibrary(const std::string& lib_path, bool global_symbols,
+                                        bool allow_fail) {
+  std::string manifest_path = lib_path + ".ops";
+  std::ifstream manifest(manifest_path);
+  if (!manifest) {
+    LoadLibrary(lib_path, global_symbols, allow_fail);
+    return;
+  }
+
+  static bool loader_set = []() {
+    SchemaRegistry::SetSchemaLoader(LoadLazySchema);
+    return true;
+  }();
+  (void) loader_set;
+
+  auto lib = std::make_shared<LazyLibrary>(LazyLibrary{lib_path, global_symbols, allow_fail});
+  std::map<std::string, LazyOp> ops;
+  std::string line;
+  for (int line_no = 1; std::getline(manifest, line); line_no++) {
+    std::istringstream ss(line);
+    std::string schema_name, device;
+    if (!(ss >> schema_name) || schema_name[0] == '#')
+      continue;
+    LazyOp op{lib, {}};
+    while (ss >> device) {
+      DALI_ENFORCE(device == "cpu" || device == "gpu" || device == "mixed",
+                   make_string("Invalid backend \"", device, "\" of the operator \"",
+                               schema_name, "\" in ", manifest_path, ":", line_no,
+                               ". Expected \"cpu\", \"gpu\" or \"mixed\"."));
+      op.devices.push_back(device);
+    }
+    DALI_ENFORCE(!op.devices.empty(),
+                 make_string("No backends listed for the operator \"", schema_name, "\" in ",
+                             manifest_path, ":", line_no, "."));
+    // already registered - the library (or another one defining the operator) is loaded
+    if (SchemaRegistry::TryGetSchema(schema_name, false))
+      continue;
+    ops.emplace(schema_name, std::move(op));
+  }
+
+  LOG_LINE << "Registering " << ops.size() << " operators of " << lib_path << "\n";
+  auto& registry = GetLazyRegistry();
+  std::lock_guard<std::recursive_mutex> guard(registry.mtx);
+  for (auto& op : ops)
+    registry.ops.insert(std::move(op));
+}
+
+std::vector<std::string> PluginManager::LazyOperators(const std::string& device) {
+  auto& registry = GetLazyRegistry();
+  std::lock_guard<std::recursive_mutex> guard(registry.mtx);
+  std::vector<std::string> names;
+  for (auto& [name, op] : registry.ops) {
+    if (std::find(op.devices.begin(), op.devices.end(), device) != op.devices.end())
+      names.push_back(name);
+  }
+  return names;
+}
+
 inline const std::string& DefaultPluginPath() {
   static const std::string path = [&]() -> std::string {
     Dl_info info;
@@ -71,7 +180,10 @@ inline void PluginManager::LoadDirectory(const std::string& path, bool global_sy
         fpath.path().extension() == ".so") {
       // filename starts with libdali_ and ends with .so
       auto p = fpath.path().string();
-      PluginManager::LoadLibrary(std::move(p), global_symbols, allow_fail);
+      if (fs::exists(p + ".ops"))
+        PluginManager::RegisterLazyLibrary(std::move(p), global_symbols, allow_fail);
+      else
+        PluginManager::LoadLibrary(std::move(p), global_symbols, allow_fail);
     }
   }
 }
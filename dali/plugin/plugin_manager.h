@@ -47,6 +47,31 @@ class DLL_PUBLIC PluginManager {
   static DLL_PUBLIC void LoadDirectory(const std::string& lib_path, bool global_symbols = false,
                                        bool allow_fail = false);
 
+  /**
+   * @brief Register a plugin library to be loaded when one of its operators is first used
+   * @remarks The operators are read from the manifest file {lib_path}.ops, which lists one
+   * operator per line: the schema name followed by the backends it's registered for, e.g.
+   * "CustomDummy cpu gpu". The library is loaded when the schema of any of the listed operators
+   * is looked up for the first time. If there's no manifest, the library is loaded immediately.
+   * The directories loaded with LoadDirectory register the libraries which have a manifest
+   * this way.
+   * @param [in] lib_path path to the plugin library, e.g. "/usr/lib/libcustomplugin.so"
+   * @param [in] global_symbols if true, the library is loaded with RTLD_GLOBAL flag or equivalent
+   *                            otherwise, RTLD_LOCAL is used
+   * @param [in] allow_fail if true, not being able to load a library won't result in a hard error
+   * @throws std::runtime_error if the manifest could not be parsed
+   */
+  static DLL_PUBLIC void RegisterLazyLibrary(const std::string& lib_path,
+                                             bool global_symbols = false,
+                                             bool allow_fail = false);
+
+  /**
+   * @brief The names of the operators of the lazily registered libraries which have not been
+   *        loaded yet
+   * @param [in] device "cpu", "gpu" or "mixed"
+   */
+  static DLL_PUBLIC std::vector<std::string> LazyOperators(const std::string& device);
+
   /**
    * @brief Load default plugin library
    * @remarks DALI_PRELOAD_PLUGINS are environment variables that can be used to control what
@@ -13,6 +13,12 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "dali/pipeline/operator/op_schema.h"
 #include "dali/plugin/plugin_manager.h"
 #include "dali/test/dali_test_utils.h"
 
@@ -58,3 +64,44 @@ TEST(PluginManagerTest, LoadingSameLibraryTwiceShouldBeOk) {
       });
   }
 }
+
+static bool Contains(const std::vector<std::string> &names, const std::string &name) {
+  return std::find(names.begin(), names.end(), name) != names.end();
+}
+
+TEST(PluginManagerTest, LazyLibrary) {
+  auto dir = std::filesystem::temp_directory_path();
+  // the library doesn't exist - we can see when it's being loaded, because it fails
+  auto lib_path = (dir / "libdali_lazy_test_plugin.so").string();
+  {
+    std::ofstream manifest(lib_path + ".ops");
+    manifest << "# operators of the plugin\n"
+             << "LazyTestOp cpu gpu\n"
+             << "\n"
+             << "LazyTestOp2 mixed\n";
+  }
+  dali::PluginManager::RegisterLazyLibrary(lib_path, false, true);
+  EXPECT_TRUE(Contains(dali::PluginManager::LazyOperators("cpu"), "LazyTestOp"));
+  EXPECT_TRUE(Contains(dali::PluginManager::LazyOperators("gpu"), "LazyTestOp"));
+  EXPECT_FALSE(Contains(dali::PluginManager::LazyOperators("mixed"), "LazyTestOp"));
+  EXPECT_TRUE(Contains(dali::PluginManager::LazyOperators("mixed"), "LazyTestOp2"));
+
+  EXPECT_EQ(dali::SchemaRegistry::TryGetSchema("LazyTestOp", false), nullptr);
+  EXPECT_TRUE(Contains(dali::PluginManager::LazyOperators("cpu"), "LazyTestOp"));
+
+  // the lookup tries to load the library, which removes all of its operators
+  EXPECT_EQ(dali::SchemaRegistry::TryGetSchema("LazyTestOp"), nullptr);
+  EXPECT_FALSE(Contains(dali::PluginManager::LazyOperators("cpu"), "LazyTestOp"));
+  EXPECT_FALSE(Contains(dali::PluginManager::LazyOperators("mixed"), "LazyTestOp2"));
+
+  // without allow_fail, the failure to load the library is reported by the lookup
+  dali::PluginManager::RegisterLazyLibrary(lib_path);
+  EXPECT_THROW(dali::SchemaRegistry::GetSchema("LazyTestOp2"), std::runtime_error);
+
+  {
+    std::ofstream manifest(lib_path + ".ops");
+    manifest << "LazyTestOp tpu\n";
+  }
+  EXPECT_THROW(dali::PluginManager::RegisterLazyLibrary(lib_path), std::runtime_error);
+  std::filesystem::remove(lib_path + ".ops");
+}
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -19,11 +19,13 @@
 #include "dali/core/common.h"
 #include "dali/core/cuda_utils.h"
 #include "dali/core/device_guard.h"
+#include "dali/core/metrics.h"
 #include "pybind11/pybind11.h"
 #include "pybind11/pytypes.h"
 #include "pyerrors.h"  // NOLINT(build/include)
 #if SHM_WRAPPER_ENABLED
 #include "dali/core/os/shared_mem.h"
+#include "dali/core/os/shm_ring_buffer.h"
 #endif
 #include "dali/core/python_util.h"
 #include "dali/core/mm/default_resources.h"
@@ -32,6 +34,7 @@
 #include "dali/operators/reader/parser/tfrecord_parser.h"
 #include "dali/pipeline/data/copy_to_external.h"
 #include "dali/pipeline/data/dltensor.h"
+#include "dali/pipeline/data/ipc_tensor_list.h"
 #include "dali/pipeline/data/tensor.h"
 #include "dali/pipeline/data/tensor_list.h"
 #include "dali/pipeline/init.h"
@@ -44,6 +47,7 @@
 #include "dali/pipeline/pipeline_debug.h"
 #include "dali/plugin/plugin_manager.h"
 #include "dali/python/python3_compat.h"
+#include "dali/util/batch_file.h"
 #include "dali/util/pybind.h"
 #include "dali/util/user_stream.h"
 
@@ -119,6 +123,41 @@ std::vector<py::tuple> py_shape_list(const TensorList<Backend> &tl) {
   return ret;
 }
 
+/**
+ * @brief Converts the IPC descriptor to a dict of plain Python values, so that it can be pickled
+ */
+py::dict IPCDescToPy(const IPCTensorListDesc &desc) {
+  py::dict d;
+  d["fd"] = desc.fd;
+  d["size"] = desc.size;
+  d["offset"] = desc.offset;
+  d["device_id"] = desc.device_id;
+  d["dtype"] = static_cast<int>(desc.type);
+  std::vector<py::tuple> shape(desc.shape.num_samples());
+  for (int i = 0; i < desc.shape.num_samples(); i++)
+    shape[i] = py::tuple(as_py_list(desc.shape.tensor_shape(i)));
+  d["shape"] = shape;
+  d["layout"] = desc.layout.str();
+  return d;
+}
+
+IPCTensorListDesc IPCDescFromPy(const py::dict &d) {
+  IPCTensorListDesc desc;
+  desc.fd = d["fd"].cast<int>();
+  desc.size = d["size"].cast<size_t>();
+  desc.offset = d["offset"].cast<size_t>();
+  desc.device_id = d["device_id"].cast<int>();
+  desc.type = static_cast<DALIDataType>(d["dtype"].cast<int>());
+  auto shapes = d["shape"].cast<std::vector<std::vector<int64_t>>>();
+  for (auto &sample_shape : shapes) {
+    if (sample_shape.size() != shapes[0].size())
+      throw py::value_error("All samples must have the same number of dimensions.");
+  }
+  desc.shape = TensorListShape<>(shapes);
+  desc.layout = d["layout"].cast<std::string>();
+  return desc;
+}
+
 static string TensorLayoutRepr(const TensorLayout &tl) {
   std::stringstream ss;
   ss << "nvidia.dali.types.TensorLayout('";
@@ -706,6 +745,47 @@ void ExposeTensor(py::module &m) {
         As private this API may change without notice.
       )code"
     )
+    .def(
+      "__dlpack__",
+      [](Tensor<GPUBackend> &t, py::object stream, py::kwargs) -> py::capsule {
+        // the producer must make the consumer's stream wait until the data is ready
+        if (const auto &ready = t.ready_event()) {
+          if (stream.is_none()) {
+            CUDA_CALL(cudaEventSynchronize(ready));
+          } else {
+            auto stream_value = stream.cast<int64_t>();
+            DALI_ENFORCE(stream_value != 0, "Provided stream is not a valid CUDA stream based "
+                         "on DLPack. `0` value is ambiguous and disallowed");
+            if (stream_value != -1) {  // -1 means "don't synchronize"
+              cudaStream_t s = stream_value == 1 ? cudaStreamLegacy
+                             : stream_value == 2 ? cudaStreamPerThread
+                             : reinterpret_cast<cudaStream_t>(stream_value);
+              CUDA_CALL(cudaStreamWaitEvent(s, ready, 0));
+            }
+          }
+        }
+        return DLTensorToCapsule(GetSharedDLTensor(t));
+      },
+      py::kw_only(),
+      "stream"_a = py::none(),
+      R"code(
+      Exports the tensor as a DLPack capsule, following the DLPack protocol.
+
+      The capsule shares the ownership of the data with the tensor, so the data remains valid
+      after the tensor is destroyed.
+
+      stream : int, optional
+            The stream in which the consumer accesses the data. It waits (without blocking
+            the host) until the data is ready. If not provided, the host waits instead.
+      )code")
+    .def(
+      "__dlpack_device__",
+      [](const Tensor<GPUBackend> &t) {
+        return py::make_tuple(py::int_(static_cast<int>(kDLCUDA)), py::int_(t.device_id()));
+      },
+      R"code(
+      Returns the DLPack device type and id of the tensor.
+      )code")
     .def(py::init([](const py::object &object, string layout = "", int device_id = -1) {
           auto t = std::make_unique<Tensor<GPUBackend>>();
           FillTensorFromCudaArray(object, t.get(), device_id, layout);
@@ -1204,6 +1284,19 @@ void ExposeTensorList(py::module &m) {
 
       This function can only be called if `is_dense_tensor` returns `True`.
       )code")
+    .def("as_ragged",
+        [](TensorList<CPUBackend> &tl) {
+          auto offsets = tl.RaggedOffsets();
+          return py::make_tuple(tl.AsRaggedValues(),
+                                py::array_t<int64_t>(offsets.size(), offsets.data()));
+        },
+      R"code(
+      Returns the ragged representation of this `TensorList`: a tuple of a flat tensor with
+      the values of all samples and an array of ``len(self) + 1`` offsets.
+
+      The sample ``i`` occupies the elements ``[offsets[i], offsets[i + 1])`` of the values.
+      This function can only be called if `TensorList` is contiguous in memory.
+      )code")
     .def("data_ptr",
         [](TensorList<CPUBackend> &tl) {
           return py::reinterpret_borrow<py::object>(
@@ -1410,6 +1503,19 @@ void ExposeTensorList(py::module &m) {
 
       This function can only be called if `is_dense_tensor` returns `True`.
       )code")
+    .def("as_ragged",
+        [](TensorList<GPUBackend> &tl) {
+          auto offsets = tl.RaggedOffsets();
+          return py::make_tuple(tl.AsRaggedValues(),
+                                py::array_t<int64_t>(offsets.size(), offsets.data()));
+        },
+      R"code(
+      Returns the ragged representation of this `TensorList`: a tuple of a flat tensor with
+      the values of all samples and an array of ``len(self) + 1`` offsets.
+
+      The sample ``i`` occupies the elements ``[offsets[i], offsets[i + 1])`` of the values.
+      This function can only be called if `TensorList` is contiguous in memory.
+      )code")
     .def("data_ptr",
         [](TensorList<GPUBackend> &tl) {
           return py::reinterpret_borrow<py::object>(
@@ -1449,8 +1555,8 @@ static const OpSchema &GetSchema(const string &name) {
   return SchemaRegistry::GetSchema(name);
 }
 
-static const OpSchema *TryGetSchema(const string &name) {
-  return SchemaRegistry::TryGetSchema(name);
+static const OpSchema *TryGetSchema(const string &name, bool load) {
+  return SchemaRegistry::TryGetSchema(name, load);
 }
 
 static constexpr int GetCxx11AbiFlag() {
@@ -1492,6 +1598,45 @@ TFValue ConvertTFRecordDefaultValue(TFFeatureType type, py::object val) {
 }
 #endif  // DALI_BUILD_PROTO3
 
+py::dict PoolStatsToDict(const mm::pool_stats &stats) {
+  py::dict d;
+  d["reserved"] = stats.reserved;
+  d["allocated"] = stats.allocated;
+  d["peak_allocated"] = stats.peak_allocated;
+  d["free"] = stats.free;
+  d["largest_free_block"] = stats.largest_free_block;
+  d["free_blocks"] = stats.free_blocks;
+  d["upstream_blocks"] = stats.upstream_blocks;
+  d["pending_free"] = stats.pending_free;
+  d["pending_free_blocks"] = stats.pending_free_blocks;
+  d["pending_free_streams"] = stats.pending_free_streams;
+  return d;
+}
+
+py::dict MetricsToDict(const std::vector<metrics::MetricSnapshot> &snapshot) {
+  py::dict ret;
+  for (auto &m : snapshot) {
+    py::str name(m.name);
+    if (!ret.contains(name))
+      ret[name] = py::dict();
+    py::dict d;
+    d["kind"] = m.kind == metrics::MetricKind::Counter ? "counter" :
+                m.kind == metrics::MetricKind::Gauge ? "gauge" : "histogram";
+    d["count"] = m.count;
+    d["value"] = m.value;
+    if (m.kind == metrics::MetricKind::Histogram) {
+      d["min"] = m.min;
+      d["max"] = m.max;
+      py::list buckets;
+      for (int b = 0; b < static_cast<int>(m.buckets.size()); b++)
+        buckets.append(py::make_tuple(metrics::BucketUpperBound(b), m.buckets[b]));
+      d["buckets"] = buckets;
+    }
+    ret[name].cast<py::dict>()[py::str(m.labels)] = d;
+  }
+  return ret;
+}
+
 void ExposeBufferPolicyFunctions(py::module &m) {
   m.def("SetHostBufferShrinkThreshold", [](double ratio) {
     if (ratio < 0 || ratio > 1)
@@ -1532,6 +1677,27 @@ void ExposeBufferPolicyFunctions(py::module &m) {
   m.def("GetHostBufferShrinkThreshold", Buffer<CPUBackend>::GetShrinkThreshold);
   m.def("GetHostBufferGrowthFactor", Buffer<CPUBackend>::GetGrowthFactor);
   m.def("GetDeviceBufferGrowthFactor", Buffer<GPUBackend>::GetGrowthFactor);
+
+  m.def("SetDeviceBufferGrowInPlaceLimit", Buffer<GPUBackend>::SetGrowInPlaceLimit,
+R"(Sets the maximum size of the GPU buffers which grow in place.
+
+A GPU buffer that needs to grow is reallocated as a reservation of `max_bytes` of virtual
+address space and the physical memory is mapped to it on demand. Subsequent growth of the
+buffer doesn't require a reallocation. 0 disables this mode.
+It has no effect if the platform doesn't support CUDA virtual memory management.
+)", "max_bytes"_a);
+  m.def("GetDeviceBufferGrowInPlaceLimit", Buffer<GPUBackend>::GetGrowInPlaceLimit);
+  m.def("IsIPCSupported", IsIPCSupported, "device_id"_a);
+  m.def("ImportTensorListIPC", [](const py::dict &desc) {
+    auto tl = std::make_shared<TensorList<GPUBackend>>();
+    ImportIPC(*tl, IPCDescFromPy(desc));
+    return tl;
+  },
+R"(Maps the GPU pipeline output shared by another process (see Pipeline.ShareOutputsIPC).
+
+The file descriptor in `desc` must be valid in this process (i.e. it must have been received
+through a UNIX domain socket). It can be closed once this function returns.
+)", "desc"_a);
   m.def("RestrictPinnedMemUsage", RestrictPinnedMemUsage);
 
   m.def("PreallocateDeviceMemory", mm::PreallocateDeviceMemory,
@@ -1562,6 +1728,78 @@ Only blocks that are completely free are released. The function frees the memory
 pools as well as from the host pinned memory pool.
 
 This function is safe to use while DALI pipelines are running.)");
+
+  m.def("GetDevicePoolStats", [](int device_id) {
+    return PoolStatsToDict(mm::GetDevicePoolStats(device_id));
+  },
+R"(Returns the statistics of the device memory pool as a dictionary
+
+The statistics include the memory reserved from the upstream resource, the memory currently
+allocated and its peak value, the free memory, the size of the largest free block and the
+memory deallocated on streams that hasn't returned to the pool yet.
+All values are zero, if the pool for the device hasn't been created yet.
+)", "device_id"_a = -1);
+  m.def("GetPinnedPoolStats", [](int device_id) {
+    return PoolStatsToDict(mm::GetPinnedPoolStats(device_id));
+  },
+R"(Returns the statistics of the host pinned memory pool used with given device as a dictionary
+
+See GetDevicePoolStats for the description of the statistics.
+)", "device_id"_a = -1);
+  m.def("SetMetricsEnabled", metrics::SetEnabled,
+R"(Enables or disables the collection of the always-on metrics
+
+The metrics can also be enabled with the environment variable DALI_METRICS=1.
+The operators, readers and thread pools register their metrics when they're created, so
+the metrics should be enabled before the pipeline is built.
+)", "enabled"_a);
+  m.def("SetMetricsSamplingInterval", metrics::SetSamplingInterval,
+R"(Measures the latency of every `interval`-th timed event in each thread
+
+The counters are not sampled.
+)", "interval"_a);
+  m.def("GetMetrics", []() {
+    return MetricsToDict(metrics::Snapshot());
+  },
+R"(Returns the current values of the metrics as a dictionary
+
+The dictionary maps the names of the metrics to dictionaries keyed by the labels
+(e.g. ``'op="Resize_3"'``). Each entry contains the ``kind`` (counter, gauge or histogram),
+the ``count`` of the updates and the ``value`` (the sum of the observations for histograms).
+The histograms also contain ``min``, ``max`` and ``buckets`` - a list of
+``(upper_bound, count)`` pairs.
+)");
+  m.def("GetMetricsPrometheus", []() {
+    return metrics::ToPrometheusText(metrics::Snapshot());
+  },
+R"(Returns the current values of the metrics in the Prometheus text exposition format)");
+  m.def("SetPoolStatsLogInterval", mm::SetPoolStatsLogInterval,
+R"(Prints the statistics of the memory pools to stderr every `interval_seconds`
+
+A non-positive interval stops the logging.
+)", "interval_seconds"_a);
+
+  m.def("SetDeviceMemoryBudget", mm::SetDeviceMemoryBudget,
+R"(Limits the amount of memory which the device memory pool can obtain on each device.
+
+When an allocation would exceed the budget, the pool releases its unused blocks before the
+allocation fails. When the usage approaches the budget, DALI reduces the memory held by
+adaptive queues and image caches.
+The budget must be set before DALI allocates any device memory, unless CUDA VMM is disabled
+(``DALI_USE_VMM=0``).
+
+`bytes` : int
+    The budget in bytes; 0 means no limit.
+)", "bytes"_a);
+  m.def("GetDeviceMemoryBudget", mm::GetDeviceMemoryBudget);
+
+  m.def("SetPinnedMemoryBudget", mm::SetPinnedMemoryBudget,
+R"(Limits the total amount of memory which the pinned memory pools can obtain.
+
+`bytes` : int
+    The budget in bytes; 0 means no limit.
+)", "bytes"_a);
+  m.def("GetPinnedMemoryBudget", mm::GetPinnedMemoryBudget);
 }
 
 py::dict DeprecatedArgMetaToDict(const DeprecatedArgDef & meta) {
@@ -1591,16 +1829,71 @@ py::dict ExecutorMetaToDict(const ExecutorMetaMap &meta) {
     py::list reserved_memory_size;
     py::list max_real_memory_size;
     py::list max_reserved_memory_size;
+    py::list queue_depth;
+    py::list queue_stall_count;
+    py::list queue_idle_count;
+    py::list pinned;
+    bool adaptive_queue = false;
     for (const auto &entry : stat.second) {
       real_memory_size.append(entry.real_size);
       max_real_memory_size.append(entry.max_real_size);
       reserved_memory_size.append(entry.reserved);
       max_reserved_memory_size.append(entry.max_reserved);
+      queue_depth.append(entry.queue_depth);
+      queue_stall_count.append(entry.queue_stalls);
+      queue_idle_count.append(entry.queue_idle);
+      pinned.append(entry.pinned);
+      adaptive_queue |= entry.queue_depth > 0;
     }
     op_dict["real_memory_size"] = real_memory_size;
     op_dict["max_real_memory_size"] = max_real_memory_size;
     op_dict["reserved_memory_size"] = reserved_memory_size;
     op_dict["max_reserved_memory_size"] = max_reserved_memory_size;
+    op_dict["pinned"] = pinned;
+    if (adaptive_queue) {
+      op_dict["queue_depth"] = queue_depth;
+      op_dict["queue_stall_count"] = queue_stall_count;
+      op_dict["queue_idle_count"] = queue_idle_count;
+    }
+    if (!stat.second.empty() && stat.second[0].profile.iterations > 0) {
+      auto &profile = stat.second[0].profile;
+      op_dict["iterations"] = profile.iterations;
+      op_dict["cpu_time_us"] = profile.cpu_time;
+      op_dict["gpu_time_us"] = profile.gpu_time;
+      op_dict["wait_time_us"] = profile.wait_time;
+      op_dict["input_bytes"] = profile.input_bytes;
+      op_dict["output_bytes"] = profile.output_bytes;
+    }
+    if (!stat.second.empty()) {
+      static const char *kind_names[mm::memory_kind_id::count] = {
+        "host", "pinned", "device", "managed"
+      };
+      auto &memory = stat.second[0].memory;
+      py::dict memory_dict;
+      for (int tag = 0; tag < static_cast<int>(mm::MemoryTag::Count); tag++) {
+        py::dict tag_dict;
+        for (int kind = 0; kind < mm::memory_kind_id::count; kind++) {
+          auto &usage = memory.usage[tag][kind];
+          if (usage.peak > 0)
+            tag_dict[kind_names[kind]] = py::dict("current"_a = usage.current,
+                                                  "peak"_a = usage.peak);
+        }
+        if (!tag_dict.empty())
+          memory_dict[mm::MemoryTagName(static_cast<mm::MemoryTag>(tag))] = tag_dict;
+      }
+      if (!memory_dict.empty() || memory.queue_slot_size > 0) {
+        op_dict["memory"] = memory_dict;
+        op_dict["queue_slot_size"] = memory.queue_slot_size;
+        op_dict["queue_slots"] = memory.queue_slots;
+        op_dict["max_queue_slots"] = memory.max_queue_slots;
+      }
+      if (!stat.second[0].diagnostics.empty()) {
+        py::dict diagnostics;
+        for (auto &[name, value] : stat.second[0].diagnostics)
+          diagnostics[name.c_str()] = value;
+        op_dict["diagnostics"] = diagnostics;
+      }
+    }
     d[stat.first.c_str()] = op_dict;
   }
   return d;
@@ -1618,7 +1911,9 @@ void ExposeEagerOperator(py::module &m, const char *name) {
               const std::vector<
                   std::shared_ptr<TensorList<typename Backend2Types<Backend>::InBackend>>> &inputs,
               const std::unordered_map<std::string, std::shared_ptr<TensorList<CPUBackend>>>
-                  &kwargs) { return op.Run(inputs, kwargs); })
+                  &kwargs,
+              int batch_size) { return op.Run(inputs, kwargs, batch_size); },
+           "inputs"_a, "kwargs"_a, "batch_size"_a = -1)
       .def("reader_meta",
            [](EagerOperator<Backend> &op) { return ReaderMetaToDict(op.GetReaderMeta()); });
 }
@@ -1686,6 +1981,13 @@ PYBIND11_MODULE(backend_impl, m) {
     py::arg("global_symbols") = false,
     py::arg("allow_fail") = false);
 
+  m.def("RegisterLazyLibrary", &PluginManager::RegisterLazyLibrary,
+    py::arg("lib_path"),
+    py::arg("global_symbols") = false,
+    py::arg("allow_fail") = false);
+
+  m.def("LazyOperators", &PluginManager::LazyOperators, py::arg("device"));
+
   m.def("LoadDefaultPlugins", &PluginManager::LoadDefaultPlugins);
 
   m.def("GetCxx11AbiFlag", &GetCxx11AbiFlag);
@@ -1769,8 +2071,65 @@ PYBIND11_MODULE(backend_impl, m) {
       .def("close_handle", &SharedMem::close_handle)
       .def("close", &SharedMem::close);
 
+  py::class_<ShmRingBuffer>(m, "ShmRingBuffer")
+      .def_static("create", &ShmRingBuffer::Create, "capacity"_a)
+      .def_static("attach", &ShmRingBuffer::Attach, "handle"_a)
+      .def_property_readonly("handle", &ShmRingBuffer::handle)
+      .def_property_readonly("capacity", &ShmRingBuffer::capacity)
+      .def_property_readonly("max_record_size", &ShmRingBuffer::max_record_size)
+      .def("reserve",
+           [](ShmRingBuffer *rb, uint64_t size) -> py::object {
+             uint8_t *ptr = rb->TryReserve(size);
+             if (!ptr)
+               return py::none();
+             return py::memoryview::from_buffer(ptr, {size}, {sizeof(uint8_t)}, false);
+           }, "size"_a,
+           R"(Reserves a record of `size` bytes and returns a writable memoryview of it
+or None, if there's not enough free space. The record is published by `commit`.)")
+      .def("commit", &ShmRingBuffer::Commit)
+      .def("read",
+           [](ShmRingBuffer *rb) -> py::object {
+             auto record = rb->TryRead();
+             if (!record.data())
+               return py::none();
+             return py::memoryview::from_buffer(record.data(), {record.size()},
+                                                {sizeof(uint8_t)}, true);
+           },
+           R"(Returns a read-only memoryview of the next record or None, if there are no new
+records. The memory is valid until the record is released.)")
+      .def("release", &ShmRingBuffer::Release);
+
 #endif
 
+  py::class_<BatchFileWriter>(m, "BatchFileWriter")
+      .def(py::init<std::string>(), "path"_a,
+           R"(Creates (or truncates) a batch file - a file holding a sequence of batches, e.g.
+a shard of a preprocessed dataset.)")
+      .def("write", &BatchFileWriter::Write, "batch"_a,
+           R"(Appends a TensorListCPU to the file.
+
+The GPU batches need to be copied with as_cpu() first.)")
+      .def("close", &BatchFileWriter::Close)
+      .def_property_readonly("num_batches", &BatchFileWriter::num_batches)
+      .def("__enter__", [](BatchFileWriter &w) -> BatchFileWriter & { return w; },
+           py::return_value_policy::reference)
+      .def("__exit__", [](BatchFileWriter &w, py::args) { w.Close(); });
+
+  py::class_<BatchFileReader>(m, "BatchFileReader")
+      .def(py::init<std::string>(), "path"_a)
+      .def("__len__", &BatchFileReader::num_batches)
+      .def("__getitem__",
+           [](const BatchFileReader &r, int idx) {
+             if (idx < 0)
+               idx += r.num_batches();
+             if (idx < 0 || idx >= r.num_batches())
+               throw py::index_error(make_string("Batch index out of range: ", idx));
+             return std::make_shared<TensorList<CPUBackend>>(r.Batch(idx));
+           }, "idx"_a,
+           R"(Returns the batch with the given index as a TensorListCPU.
+
+The data isn't copied - the batch refers to the memory-mapped file.)");
+
   // Types
   py::module types_m = m.def_submodule("types");
   types_m.doc() = "Datatypes and options used by DALI";
@@ -1810,6 +2169,7 @@ PYBIND11_MODULE(backend_impl, m) {
     .value("PYTHON_OBJECT", DALI_PYTHON_OBJECT)
     .value("_TENSOR_LAYOUT_VEC", DALI_TENSOR_LAYOUT_VEC)
     .value("_DATA_TYPE_VEC", DALI_DATA_TYPE_VEC)
+    .value("BFLOAT16",      DALI_BFLOAT16)
     .export_values();
 
   // Placeholder data type allowing to use legacy __call__ method on dtype (to be deprecated).
@@ -1946,8 +2306,9 @@ PYBIND11_MODULE(backend_impl, m) {
                build_args.emplace_back(to_struct<PipelineOutputDesc>(out));
              }
              p->Build(build_args);
-         })
-    .def("Build", [](Pipeline *p) { p->Build(); })
+         },
+         py::call_guard<py::gil_scoped_release>())
+    .def("Build", [](Pipeline *p) { p->Build(); }, py::call_guard<py::gil_scoped_release>())
     .def("Shutdown", &Pipeline::Shutdown, py::call_guard<py::gil_scoped_release>())
     .def("SetExecutionTypes",
         [](Pipeline *p, bool exec_pipelined, bool exec_separated, bool exec_async) {
@@ -1993,6 +2354,20 @@ PYBIND11_MODULE(backend_impl, m) {
         })
     .def("Run", &Pipeline::Run, py::call_guard<py::gil_scoped_release>())
     .def("Prefetch", &Pipeline::Prefetch, py::call_guard<py::gil_scoped_release>())
+    .def("WarmUp",
+        [](Pipeline *p, const py::dict &max_shapes, int iterations) {
+          std::map<std::string, TensorListShape<>, std::less<>> shapes;
+          for (auto [name, samples] : max_shapes) {
+            std::vector<TensorShape<>> sample_shapes;
+            for (auto sample : samples) {
+              py::tuple extents(py::reinterpret_borrow<py::object>(sample));
+              sample_shapes.push_back(shape_from_py(extents));
+            }
+            shapes[name.cast<std::string>()] = TensorListShape<>(sample_shapes);
+          }
+          py::gil_scoped_release interpreter_unlock{};
+          p->WarmUp(shapes, iterations);
+        }, "max_shapes"_a, "iterations"_a = 1)
     .def("Outputs",
         [](Pipeline *p) {
           Workspace ws;
@@ -2028,7 +2403,79 @@ PYBIND11_MODULE(backend_impl, m) {
           }
           return outs;
         }, py::return_value_policy::take_ownership)
+    .def("ShareOutputsIPC",
+        [](Pipeline *p) {
+          Workspace ws;
+          std::vector<std::optional<IPCTensorListDesc>> descs;
+          {
+            py::gil_scoped_release interpreter_unlock{};
+            descs = p->ShareOutputsIPC(&ws);
+          }
+
+          py::tuple outs(ws.NumOutput());
+          py::list py_descs;
+          for (int i = 0; i < ws.NumOutput(); ++i) {
+            if (ws.OutputIsType<CPUBackend>(i)) {
+              outs[i] = ws.OutputPtr<CPUBackend>(i);
+            } else {
+              outs[i] = ws.OutputPtr<GPUBackend>(i);
+            }
+            if (descs[i])
+              py_descs.append(IPCDescToPy(*descs[i]));
+            else
+              py_descs.append(py::none());
+          }
+          return py::make_tuple(outs, py_descs);
+        },
+        R"(Returns the outputs, like ShareOutputs, along with the descriptors of the GPU outputs,
+which can be passed to ImportTensorListIPC in another process. The file descriptors must be sent
+to that process by means of a UNIX domain socket. The descriptor of a CPU output is None.)")
+    .def("EnableIPCOutputs",
+        [](Pipeline *p, bool enable) {
+          p->EnableIPCOutputs(enable);
+        },
+        "enable"_a = true)
+    .def("SetOutputBuffer",
+        [](Pipeline *p, int output_idx, py::object ptr, size_t size, py::object cuda_stream) {
+          AccessOrder order;
+          if (!cuda_stream.is_none())
+            order = AccessOrder(static_cast<cudaStream_t>(ctypes_void_ptr(cuda_stream)),
+                                p->device_id());
+          p->SetOutputBuffer(output_idx, ctypes_void_ptr(ptr), size, order);
+        },
+        "output_idx"_a, "ptr"_a, "size"_a, "cuda_stream"_a = py::none())
     .def("ReleaseOutputs", &Pipeline::ReleaseOutputs, py::call_guard<py::gil_scoped_release>())
+    .def("EnableAsyncOutputs",
+        [](Pipeline *p, bool enable) {
+          p->EnableAsyncOutputs(enable);
+        },
+        "enable"_a = true)
+    .def("SetSchedulingPolicies", &Pipeline::SetSchedulingPolicies,
+         "queue_policy"_a = "", "concurrency"_a = "")
+    .def("GetDiagnostics",
+        [](Pipeline *p, bool reset) {
+          auto d = p->GetDiagnostics(reset);
+          py::dict ret;
+          ret["window_time_us"] = d.window_time;
+          ret["iterations"] = d.iterations;
+          ret["loader_wait"] = d.loader_wait;
+          ret["cpu_busy"] = d.cpu_busy;
+          ret["thread_pool_busy"] = d.thread_pool_busy;
+          ret["gpu_busy"] = d.gpu_busy < 0 ? py::object(py::none()) : py::cast(d.gpu_busy);
+          ret["consumer_wait"] = d.consumer_wait;
+          ret["outputs_ready"] = d.outputs_ready;
+          ret["bottleneck"] = d.bottleneck;
+          ret["verdict"] = d.verdict;
+          return ret;
+        },
+        "reset"_a = true)
+    .def("EnableTrace",
+        [](Pipeline *p, bool enable) {
+          p->EnableTrace(enable);
+        },
+        "enable"_a = true)
+    .def("WriteTrace", &Pipeline::WriteTrace, "path"_a,
+         py::call_guard<py::gil_scoped_release>())
     .def("batch_size", &Pipeline::batch_size)
     .def("num_threads", &Pipeline::num_threads)
     .def("device_id", &Pipeline::device_id)
@@ -2118,6 +2565,10 @@ PYBIND11_MODULE(backend_impl, m) {
           string s = p->SerializeToProtobuf();
           return s;
           }, py::return_value_policy::take_ownership)
+    .def("SerializeLowered",
+        [](Pipeline *p) -> py::bytes {
+          return p->SerializeLowered();
+        })
     .def("SaveGraphToDotFile", &Pipeline::SaveGraphToDotFile,
         "path"_a,
         "show_tensors"_a = false,
@@ -2205,7 +2656,10 @@ PYBIND11_MODULE(backend_impl, m) {
 
   // Registry for OpSchema
   m.def("GetSchema", &GetSchema, py::return_value_policy::reference);
-  m.def("TryGetSchema", &TryGetSchema, py::return_value_policy::reference);
+  // Doesn't load the lazily registered plugins by default - it's used when populating the
+  // operator modules and it would defeat the purpose of lazy loading.
+  m.def("TryGetSchema", &TryGetSchema, py::arg("name"), py::arg("load") = false,
+        py::return_value_policy::reference);
 
   py::class_<OpSchema>(m, "OpSchema")
     .def("OperatorName", &OpSchema::OperatorName)
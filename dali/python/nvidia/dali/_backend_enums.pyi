@@ -1,4 +1,4 @@
-# Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -25,6 +25,7 @@ class DALIDataType(Enum):
     INT32 = ...
     INT64 = ...
     FLOAT16 = ...
+    BFLOAT16 = ...
     FLOAT = ...
     FLOAT64 = ...
     BOOL = ...
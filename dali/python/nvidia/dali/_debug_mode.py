@@ -1,4 +1,4 @@
-# Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -743,11 +743,19 @@ class _OperatorManager:
 
 
 class _PipelineDebug(_pipeline.Pipeline):
-    """Debug mode for pipeline. Allows access to data inside the pipeline execution."""
+    """Debug mode for pipeline. Allows access to data inside the pipeline execution.
 
-    def __init__(self, exec_func, **kwargs):
+    If `graph_factory` is provided (the lazy debug mode), only the first iteration is run
+    operator by operator; the subsequent ones are run by the pipeline returned by the factory.
+    """
+
+    def __init__(self, exec_func, graph_factory=None, **kwargs):
         super().__init__(**kwargs)
         self._debug_on = False
+        self._graph_factory = graph_factory
+        self._graph_pipe = None
+        self._materialization_points = {}
+        self._materialized = {}
         self._external_sources = {}
         self._feed_input_data = {}
         self._exec_func = exec_func
@@ -793,7 +801,11 @@ class _PipelineDebug(_pipeline.Pipeline):
         if not self._built:
             raise RuntimeError("Pipeline must be built first.")
 
+        if self._graph_pipe is not None:
+            return self._run_graph()
+
         self._debug_on = True
+        self._materialization_points = {}
         self._cur_operator_id = -1
         self._cur_iter_batch_info.reset()
         _pipeline.Pipeline.push_current(self)
@@ -828,14 +840,44 @@ class _PipelineDebug(_pipeline.Pipeline):
                 )
         # Reset the stack, so we retrace for the next iteration
         self._condition_stack = _conditionals._ConditionStack()
+        self._materialized = {
+            name: val.get() if isinstance(val, DataNodeDebug) else val
+            for name, val in self._materialization_points.items()
+        }
+        if self._graph_factory is not None:
+            self._graph_pipe = self._graph_factory()
+            self._graph_pipe.build()
+            # The graph starts from the beginning of the data - skip the traced iteration.
+            self._graph_pipe.run()
         return tuple(outputs)
 
+    def _run_graph(self):
+        outputs = self._graph_pipe.run()
+        names = list(self._graph_pipe._materialization_points.keys())
+        num_outputs = len(outputs) - len(names)
+        self._materialized = dict(zip(names, outputs[num_outputs:]))
+        return outputs[:num_outputs]
+
+    def materialized(self, name):
+        """Returns the value of the materialization point `name` in the most recent iteration.
+
+        Refer to :meth:`materialize <nvidia.dali.pipeline.experimental.materialize>` for
+        details."""
+        if name not in self._materialized:
+            raise KeyError(f'No data was materialized under the name "{name}".')
+        return self._materialized[name]
+
     def feed_input(self, data_node, data, **kwargs):
         """Pass data to an ExternalSource operator inside the pipeline.
 
         Refer to :meth:`Pipeline.feed_input() <nvidia.dali.Pipeline.feed_input>` for details."""
         if not self._built:
             raise RuntimeError("Pipeline must be built first.")
+        if self._graph_pipe is not None:
+            raise RuntimeError(
+                "Feeding the data is supported only in the first iteration of a pipeline in "
+                "the lazy debug mode."
+            )
         if isinstance(data_node, str):
             name = data_node
         else:
@@ -506,9 +506,13 @@ def _create_state_submodule(name):
 
 def _callable_op_factory(op_class, op_name, num_inputs, call_args_names):
     class EagerOperator(_eager_op_base_factory(op_class, op_name, num_inputs, call_args_names)):
-        def __call__(self, inputs, kwargs):
+        def __init__(self, *, max_batch_size, **kwargs):
+            super().__init__(max_batch_size=max_batch_size, **kwargs)
+            self.max_batch_size = max_batch_size
+
+        def __call__(self, inputs, kwargs, batch_size=-1):
             # Here all kwargs are supposed to be TensorLists.
-            output = self._backend_op(inputs, kwargs)
+            output = self._backend_op(inputs, kwargs, batch_size)
 
             if len(output) == 1:
                 return output[0]
@@ -713,14 +717,19 @@ def _wrap_stateless(op_class, op_name, wrapper_name):
             inputs, kwargs, op_name, wrapper_name, _callable_op_factory.disqualified_arguments
         )
 
+        # The batch size is not a part of the key - an operator instance (along with its kernels
+        # and scratch memory) is reused for all the batches that don't exceed its max_batch_size.
+        batch_size = init_args.pop("max_batch_size")
         key = _gen_cache_key(op_name, inputs, init_args, call_args)
 
-        if key not in _stateless_operators_cache:
-            _stateless_operators_cache[key] = _callable_op_factory(
-                op_class, wrapper_name, len(inputs), call_args.keys()
-            )(**init_args)
+        op = _stateless_operators_cache.get(key)
+        if op is None or op.max_batch_size < batch_size:
+            op = _callable_op_factory(op_class, wrapper_name, len(inputs), call_args.keys())(
+                max_batch_size=batch_size, **init_args
+            )
+            _stateless_operators_cache[key] = op
 
-        return _stateless_operators_cache[key](inputs, call_args)
+        return op(inputs, call_args, batch_size)
 
     return wrapper
 
@@ -829,7 +838,7 @@ def _wrap_eager_op(op_class, submodules, parent_module, wrapper_name, wrapper_do
     op_name = op_class.schema_name
     op_schema = _b.TryGetSchema(op_name)
 
-    if op_schema.IsDeprecated() or op_name in _excluded_operators:
+    if (op_schema is not None and op_schema.IsDeprecated()) or op_name in _excluded_operators:
         return
     elif op_name in _stateful_operators:
         wrapper = _wrap_stateful(op_class, op_name, wrapper_name)
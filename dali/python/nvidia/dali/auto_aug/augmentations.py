@@ -1,4 +1,4 @@
-# Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -59,12 +59,8 @@ def shear_x(data, shear, fill_value=128, interp_type=None):
     )
 
 
-@augmentation(mag_range=(0, 0.3), randomly_negate=True, mag_to_param=warp_y_param)
-def shear_y(data, shear, fill_value=128, interp_type=None):
-    mt = fn.transforms.shear(shear=shear)
-    return fn.warp_affine(
-        data, matrix=mt, fill_value=fill_value, interp_type=interp_type, inverse_map=False
-    )
+# The y variants reuse the op of the x ones, so that they can be applied together (see `select`)
+shear_y = shear_x.augmentation(mag_to_param=warp_y_param, name="shear_y")
 
 
 @augmentation(mag_range=(0.0, 1.0), randomly_negate=True, mag_to_param=warp_x_param)
@@ -95,14 +91,9 @@ def translate_y(data, rel_offset, shape, fill_value=128, interp_type=None):
     )
 
 
-@augmentation(
-    mag_range=(0, 250), randomly_negate=True, mag_to_param=warp_y_param, name="translate_y"
+translate_y_no_shape = translate_x_no_shape.augmentation(
+    mag_to_param=warp_y_param, name="translate_y"
 )
-def translate_y_no_shape(data, offset, fill_value=128, interp_type=None):
-    mt = fn.transforms.translation(offset=offset)
-    return fn.warp_affine(
-        data, matrix=mt, fill_value=fill_value, interp_type=interp_type, inverse_map=False
-    )
 
 
 @augmentation(mag_range=(0, 30), randomly_negate=True)
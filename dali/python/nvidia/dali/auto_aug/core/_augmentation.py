@@ -1,4 +1,4 @@
-# Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -206,9 +206,12 @@ class Augmentation:
         DataNode
             A batch of transformed samples.
         """
-        num_mandatory_positional_args = 2
         param_device = self._infer_param_device(data)
         params = self._get_param(magnitude_bin, num_magnitude_bins, param_device)
+        return self._apply(data, params, kwargs)
+
+    def _apply(self, data, params, kwargs):
+        num_mandatory_positional_args = 2
         op_kwargs = filter_extra_accepted_kwargs(self.op, kwargs, num_mandatory_positional_args)
         missing_args = get_missing_kwargs(self.op, kwargs, num_mandatory_positional_args)
         if missing_args:
@@ -353,15 +356,14 @@ class Augmentation:
         return np.linspace(lo, hi, num_magnitude_bins, dtype=np.float32)
 
     def _get_param(self, magnitude_bin, num_magnitude_bins, param_device):
-        magnitudes = self._get_magnitudes(num_magnitude_bins)
-        if magnitudes is None:
+        table = self._get_param_table(magnitude_bin, num_magnitude_bins)
+        if table is None:
             return None
-        if magnitude_bin is None:
-            raise Exception(
-                f"The augmentation `{self.name}` has `mag_range` specified, "  # nosec B608
-                f"so when called, it requires `magnitude_bin` parameter to select "
-                f"the magnitude from the `mag_range`.\nError in augmentation: {self}."
-            )
+        params, param_idx = table
+        params = types.Constant(params, device=param_device)
+        return params if param_idx is None else params[param_idx]
+
+    def _signed_bin(self, magnitude_bin):
         if self.randomly_negate and not isinstance(magnitude_bin, _SignedMagnitudeBin):
             magnitude_bin = signed_bin(magnitude_bin)
             warnings.warn(
@@ -374,17 +376,34 @@ class Augmentation:
                 f"and pass the signed bins instead.",
                 Warning,
             )
+        return magnitude_bin
+
+    def _get_param_table(self, magnitude_bin, num_magnitude_bins):
+        """
+        Returns a pair `(params, param_idx)` - a numpy array of all the parameters
+        the samples can get and the (batch of) indices into it. The `param_idx` is None,
+        if `params` is the single parameter for all the samples.
+        Returns None for augmentations without the magnitudes.
+        """
+        magnitudes = self._get_magnitudes(num_magnitude_bins)
+        if magnitudes is None:
+            return None
+        if magnitude_bin is None:
+            raise Exception(
+                f"The augmentation `{self.name}` has `mag_range` specified, "  # nosec B608
+                f"so when called, it requires `magnitude_bin` parameter to select "
+                f"the magnitude from the `mag_range`.\nError in augmentation: {self}."
+            )
+        magnitude_bin = self._signed_bin(magnitude_bin)
         if self.randomly_negate:
-            assert isinstance(magnitude_bin, _SignedMagnitudeBin)  # by the two checks above
+            assert isinstance(magnitude_bin, _SignedMagnitudeBin)  # by the check above
             if isinstance(magnitude_bin.bin, int):
                 magnitudes = [magnitudes[magnitude_bin.bin]]
                 param_idx = magnitude_bin.random_sign
             else:
                 param_idx = magnitude_bin.signed_magnitude_idx
             magnitudes = _SignedMagnitudeBin._remap_to_signed_magnitudes(magnitudes)
-            params = self._map_mags_to_params(magnitudes)
-            params = types.Constant(params, device=param_device)
-            return params[param_idx]
+            return self._map_mags_to_params(magnitudes), param_idx
         else:
             # other augmentations in the suite may need sign and we got it along the magnitude bin,
             # just unpack the plain magnitude bin
@@ -395,12 +414,9 @@ class Augmentation:
             )
             if isinstance(bin_idx, int):
                 magnitude = magnitudes[bin_idx]
-                param = self._map_mag_to_param(magnitude)
-                return types.Constant(param, device=param_device)
+                return self._map_mag_to_param(magnitude), None
             else:
-                params = self._map_mags_to_params(magnitudes)
-                params = types.Constant(params, device=param_device)
-                return params[bin_idx]
+                return self._map_mags_to_params(magnitudes), bin_idx
 
     def _validate_op_sig(self):
         num_positional = get_num_positional_args(self.op)
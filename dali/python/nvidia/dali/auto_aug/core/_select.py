@@ -1,4 +1,4 @@
-# Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -13,10 +13,93 @@
 # limitations under the License.
 
 from typing import List
+
+import numpy as np
+
+from nvidia.dali import types
 from nvidia.dali.data_node import DataNode as _DataNode
 from nvidia.dali.auto_aug.core._augmentation import Augmentation
 
 
+class _FusedAugmentation:
+    """
+    Applies one of the augmentations that share the same `op` (and differ only in the way
+    the magnitudes are mapped to parameters) as a single call of the `op`. The parameter of each
+    sample is looked up in the concatenated parameter tables of the fused augmentations.
+    """
+
+    def __init__(self, augmentations: List[Augmentation], member_idx: _DataNode):
+        self._augmentations = augmentations
+        self._member_idx = member_idx
+
+    def __call__(self, data, *, magnitude_bin=None, num_magnitude_bins=None, **kwargs):
+        first = self._augmentations[0]
+        magnitude_bin = first._signed_bin(magnitude_bin)
+        tables = [
+            aug._get_param_table(magnitude_bin, num_magnitude_bins) for aug in self._augmentations
+        ]
+        param_idx = tables[0][1]
+        if param_idx is None:
+            params = np.stack([params for params, _ in tables])
+            param_idx = self._member_idx
+        else:
+            params = np.concatenate([params for params, _ in tables])
+            param_idx = self._member_idx * len(tables[0][0]) + param_idx
+        params = types.Constant(params, device=first._infer_param_device(data))
+        return first._apply(data, params[param_idx], kwargs)
+
+
+def _can_fuse(aug: Augmentation, other: Augmentation, num_magnitude_bins) -> bool:
+    if aug.op is not other.op or aug.mag_range is None or other.mag_range is None:
+        return False
+    if aug.randomly_negate != other.randomly_negate or aug.param_device != other.param_device:
+        return False
+    try:
+        mags, other_mags = (a._get_magnitudes(num_magnitude_bins) for a in (aug, other))
+        # the parameter tables can be concatenated only if the params are of the same shape
+        # and type
+        param, other_param = aug._map_mag_to_param(mags[0]), other._map_mag_to_param(other_mags[0])
+    except Exception:
+        # let the augmentation report the problem when it's called
+        return False
+    return (
+        len(mags) == len(other_mags)
+        and param.shape == other_param.shape
+        and param.dtype == other_param.dtype
+    )
+
+
+def _fuse_ops(ops: List[Augmentation], selected_op_idx: _DataNode, num_magnitude_bins):
+    """
+    Groups the augmentations that can be applied with a single call (see `_FusedAugmentation`).
+    Returns None if there's nothing to fuse, otherwise the list of (possibly fused) augmentations
+    and the index of the (fused) augmentation to be applied to each sample.
+    """
+    groups = []
+    group_of_op = []
+    member_of_op = []
+    for op in ops:
+        for group_idx, group in enumerate(groups):
+            if _can_fuse(group[0], op, num_magnitude_bins):
+                group_of_op.append(group_idx)
+                member_of_op.append(len(group))
+                group.append(op)
+                break
+        else:
+            group_of_op.append(len(groups))
+            member_of_op.append(0)
+            groups.append([op])
+    if len(groups) == len(ops):
+        return None
+    group_of_op = types.Constant(np.array(group_of_op, dtype=np.int32))[selected_op_idx]
+    member_of_op = types.Constant(np.array(member_of_op, dtype=np.int32))[selected_op_idx]
+    fused = [
+        group[0] if len(group) == 1 else _FusedAugmentation(group, member_of_op)
+        for group in groups
+    ]
+    return fused, group_of_op
+
+
 def split_samples_among_ops(
     op_range_lo: int,
     op_range_hi: int,
@@ -44,5 +127,12 @@ def select(ops: List[Augmentation], selected_op_idx: _DataNode, *op_args, **op_k
 
     The `selected_op_idx` must be a batch of indices from [0, len(ops) - 1] range. The `op_kwargs`
     can contain other data nodes, they will be split into partial batches accordingly.
+
+    The augmentations that apply the same `op` with different parameters (e.g. `shear_x`
+    and `shear_y`) are run in a single branch, with per-sample parameters, which reduces
+    the number of conditional branches and the operator launches.
     """
+    fused = _fuse_ops(ops, selected_op_idx, op_kwargs.get("num_magnitude_bins"))
+    if fused is not None:
+        ops, selected_op_idx = fused
     return split_samples_among_ops(0, len(ops) - 1, ops, selected_op_idx, op_args, op_kwargs)
@@ -0,0 +1,251 @@
+# Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Searches for the pipeline configuration which gives the best throughput on the current
+hardware, by running short trials of the pipeline with different settings. Example::
+
+    @pipeline_def(batch_size=128, device_id=0)
+    def train_pipe(hw_decoder_load=0.65):
+        jpegs, labels = fn.readers.file(file_root=root, random_shuffle=True, name="Reader")
+        images = fn.decoders.image(jpegs, device="mixed", hw_decoder_load=hw_decoder_load)
+        ...
+
+    space = dict(autotune.default_search_space(), hw_decoder_load=[0.0, 0.5, 0.75, 0.9])
+    result = autotune.autotune(train_pipe, space, iterations=50)
+    print(result.report())
+    pipe = result.create_pipeline()
+"""
+
+import gc
+import itertools
+import os
+import time
+from dataclasses import dataclass, field
+from typing import Any, Callable, Dict, List, Optional, Sequence
+
+from nvidia.dali.pipeline import Pipeline
+
+
+def default_search_space() -> Dict[str, List[Any]]:
+    """Returns the default search space: the number of threads, the prefetch queue depth and
+    the scheduling policies of the dynamic executor.
+
+    The first value of each parameter is the starting point of the search.
+    """
+    cpus = os.cpu_count() or 1
+    threads = list(dict.fromkeys(min(t, cpus) for t in (4, 2, 8, 16)))
+    return {
+        "num_threads": threads,
+        "prefetch_queue_depth": [2, 1, 3, 4],
+        "experimental_exec_queue_policy": ["backend_change", "fully_buffered", "output_only"],
+        "experimental_exec_concurrency": ["backend", "full"],
+    }
+
+
+@dataclass
+class Trial:
+    """The result of running the pipeline with one configuration."""
+
+    config: Dict[str, Any]
+    #: Samples per second; 0 if the trial failed
+    throughput: float = 0.0
+    #: The error raised by the trial, if any
+    error: Optional[str] = None
+
+
+@dataclass
+class AutotuneResult:
+    """The outcome of :func:`autotune`."""
+
+    pipeline_fn: Callable[..., Pipeline]
+    #: The parameters passed to every trial
+    fixed_kwargs: Dict[str, Any]
+    #: The tuned parameters of the best trial
+    best_config: Dict[str, Any]
+    best_throughput: float
+    trials: List[Trial] = field(default_factory=list)
+    #: The executor statistics (see :meth:`Pipeline.executor_statistics`) of the best
+    #: configuration, with the operators' profile
+    profile: Dict[str, Any] = field(default_factory=dict)
+
+    def create_pipeline(self, **kwargs) -> Pipeline:
+        """Creates the pipeline with the best configuration; `kwargs` override the settings."""
+        return self.pipeline_fn(**{**self.fixed_kwargs, **self.best_config, **kwargs})
+
+    def report(self) -> str:
+        """Returns a human-readable summary of the trials and the most expensive operators."""
+        lines = [f"Best configuration ({self.best_throughput:.1f} samples/s):"]
+        lines += [f"    {k} = {v!r}" for k, v in self.best_config.items()]
+        lines.append("Trials:")
+        for t in sorted(self.trials, key=lambda t: -t.throughput):
+            cfg = ", ".join(f"{k}={v!r}" for k, v in t.config.items())
+            result = f"{t.throughput:10.1f} samples/s" if t.error is None else "    failed"
+            lines.append(f"  {result}  {cfg}" + (f"  ({t.error})" if t.error else ""))
+        ops = [(name, p) for name, p in self.profile.items() if p.get("iterations", 0) > 0]
+        if ops:
+            lines.append("Operators of the best configuration (time per iteration, us):")
+            lines.append(f"    {'operator':32} {'cpu':>10} {'gpu':>10} {'wait':>10}")
+
+            def per_iter(p, key):
+                return p[key] / p["iterations"]
+
+            def cost(op):
+                return max(per_iter(op[1], "cpu_time_us"), per_iter(op[1], "gpu_time_us"))
+
+            for name, p in sorted(ops, key=cost, reverse=True):
+                lines.append(
+                    f"    {name[:32]:32} {per_iter(p, 'cpu_time_us'):10.1f} "
+                    f"{per_iter(p, 'gpu_time_us'):10.1f} {per_iter(p, 'wait_time_us'):10.1f}"
+                )
+        return "\n".join(lines)
+
+
+def _run_trial(pipeline_fn, kwargs, warmup, iterations, collect_profile=False):
+    pipe = pipeline_fn(**kwargs)
+    try:
+        pipe.build()
+        for _ in range(warmup):
+            pipe.run()
+        samples = 0
+        start = time.perf_counter()
+        for _ in range(iterations):
+            outputs = pipe.run()
+            samples += len(outputs[0])
+        elapsed = time.perf_counter() - start
+        profile = pipe.executor_statistics() if collect_profile else {}
+        return samples / elapsed, profile
+    finally:
+        del pipe
+        gc.collect()
+
+
+def autotune(
+    pipeline_fn: Callable[..., Pipeline],
+    search_space: Optional[Dict[str, Sequence[Any]]] = None,
+    *,
+    iterations: int = 50,
+    warmup: int = 10,
+    exhaustive: bool = False,
+    max_passes: int = 2,
+    verbose: bool = False,
+    **pipeline_kwargs,
+) -> AutotuneResult:
+    """Finds the configuration of a pipeline with the highest throughput.
+
+    Each trial creates the pipeline with ``pipeline_fn(**pipeline_kwargs, **config)``, builds it,
+    runs `warmup` iterations and then measures the throughput of `iterations` iterations.
+    The pipelines are rebuilt from scratch in each trial, so the readers start over and
+    the trials should be short compared to the epoch.
+
+    By default, the parameters are tuned one at a time (each one is set to its best value
+    before the next one is tried) in up to `max_passes` passes over the search space;
+    with `exhaustive`, all combinations are tried.
+
+    Parameters
+    ----------
+    pipeline_fn : callable
+        A pipeline factory - typically a function decorated with
+        :func:`~nvidia.dali.pipeline_def`. It receives the keyword arguments of :class:`Pipeline`
+        as well as the arguments of the decorated function, so the search space may contain
+        operator arguments, like ``hw_decoder_load``, which the function forwards to the
+        operators.
+    search_space : dict, optional
+        Maps the parameters to the lists of values to try. The first value is the starting
+        point. Defaults to :func:`default_search_space`. Useful additions are
+        ``bytes_per_sample`` (the memory padding hint) or the decoder's ``hw_decoder_load``.
+    iterations : int
+        The number of measured iterations of each trial.
+    warmup : int
+        The number of iterations run before the measurement.
+    exhaustive : bool
+        If True, the whole grid is searched.
+    max_passes : int
+        The maximum number of passes over the parameters (if not exhaustive).
+    verbose : bool
+        If True, the result of each trial is printed.
+    pipeline_kwargs
+        The arguments passed to all trials. Unless given, ``experimental_exec_dynamic=True``
+        is used, which is required by the scheduling policies.
+
+    Returns
+    -------
+    AutotuneResult
+        The best configuration, all trials and the executor statistics of the best
+        configuration.
+    """
+    if search_space is None:
+        search_space = default_search_space()
+    space = {k: list(v) for k, v in search_space.items()}
+    for name, values in space.items():
+        if not values:
+            raise ValueError(f"The search space of `{name}` is empty.")
+    pipeline_kwargs.setdefault("experimental_exec_dynamic", True)
+
+    trials = {}
+
+    def evaluate(config):
+        key = tuple(config.items())
+        if key not in trials:
+            trial = Trial(dict(config))
+            try:
+                trial.throughput, _ = _run_trial(
+                    pipeline_fn, {**pipeline_kwargs, **config}, warmup, iterations
+                )
+            except Exception as e:
+                trial.error = str(e).split("\n")[0]
+            if verbose:
+                status = f"{trial.throughput:.1f} samples/s" if trial.error is None else "failed"
+                print(f"[autotune] {config}: {status}", flush=True)
+            trials[key] = trial
+        return trials[key].throughput
+
+    names = list(space.keys())
+    if exhaustive:
+        for values in itertools.product(*space.values()):
+            evaluate(dict(zip(names, values)))
+        best = max(trials.values(), key=lambda t: t.throughput).config
+    else:
+        best = {name: values[0] for name, values in space.items()}
+        best_throughput = evaluate(best)
+        for _ in range(max_passes):
+            improved = False
+            for name in names:
+                for value in space[name]:
+                    candidate = {**best, name: value}
+                    throughput = evaluate(candidate)
+                    if throughput > best_throughput:
+                        best, best_throughput, improved = candidate, throughput, True
+            if not improved:
+                break
+
+    best_trial = trials[tuple(best.items())]
+    if best_trial.error is not None:
+        raise RuntimeError(f"All trials failed. The first error: {best_trial.error}")
+
+    # The profile is collected in a separate run, so that it doesn't affect the measurements.
+    _, profile = _run_trial(
+        pipeline_fn,
+        {**pipeline_kwargs, **best, "enable_memory_stats": True},
+        warmup,
+        iterations,
+        collect_profile=True,
+    )
+    return AutotuneResult(
+        pipeline_fn=pipeline_fn,
+        fixed_kwargs=pipeline_kwargs,
+        best_config=best,
+        best_throughput=best_trial.throughput,
+        trials=list(trials.values()),
+        profile=profile,
+    )
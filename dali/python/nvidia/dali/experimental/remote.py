@@ -0,0 +1,260 @@
+# Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Runs the CPU part of the processing on another node and streams the batches to the pipeline
+which runs on the GPU node. On the CPU node::
+
+    @pipeline_def(batch_size=128, num_threads=32, device_id=None, enable_checkpointing=True)
+    def cpu_pipe():
+        jpegs, labels = fn.readers.file(file_root=root, random_shuffle=True)
+        images = fn.decoders.image(jpegs, device="cpu")
+        return fn.resize(images, size=[224, 224]), labels
+
+    remote.PipelineServer(lambda checkpoint: cpu_pipe(checkpoint=checkpoint),
+                          ("0.0.0.0", 5555)).serve_forever()
+
+On the GPU node, the batches are fed with external_source::
+
+    source = remote.RemoteSource(("cpu-node", 5555), checkpoint=saved_checkpoint)
+
+    @pipeline_def(batch_size=128, device_id=0)
+    def gpu_pipe():
+        images, labels = fn.external_source(source, num_outputs=2, batch=True, device="gpu")
+        ...
+
+The stream is resumable: ``source.checkpoint()`` returns the checkpoint of the remote pipeline
+at the batch most recently returned by the source - a new ``RemoteSource`` created with it
+continues the stream right after that batch (the remote pipeline must be created with
+``enable_checkpointing=True``).
+
+The batches are sent over TCP, with TCP flow control limiting how far the remote pipeline
+runs ahead of the consumer.
+"""
+
+import json
+import queue
+import socket
+import struct
+import threading
+from typing import Callable, Optional
+
+import numpy as np
+
+from nvidia.dali.pipeline import Pipeline
+
+_header_size = struct.Struct("<Q")
+
+
+def _send(sock, header, blobs=()):
+    blobs = [memoryview(b).cast("B") for b in blobs]
+    header = dict(header, sizes=[b.nbytes for b in blobs])
+    data = json.dumps(header).encode()
+    sock.sendall(_header_size.pack(len(data)) + data)
+    for b in blobs:
+        sock.sendall(b)
+
+
+def _recv_into(sock, buffer):
+    view = memoryview(buffer).cast("B")
+    while view.nbytes:
+        n = sock.recv_into(view)
+        if n == 0:
+            raise ConnectionError("The connection was closed by the peer.")
+        view = view[n:]
+
+
+def _recv_header(sock):
+    size = bytearray(_header_size.size)
+    _recv_into(sock, size)
+    data = bytearray(_header_size.unpack(size)[0])
+    _recv_into(sock, data)
+    return json.loads(data)
+
+
+def _send_batch(sock, outputs, checkpoint):
+    header = {"type": "batch", "outputs": []}
+    blobs = []
+    for out in outputs:
+        if hasattr(out, "as_cpu"):
+            out = out.as_cpu()
+        # the samples stay valid until the next run of the pipeline, so they aren't copied
+        samples = [np.asarray(out[i]) for i in range(len(out))]
+        dtype = samples[0].dtype.str if samples else "|u1"
+        header["outputs"].append({"dtype": dtype, "shapes": [s.shape for s in samples]})
+        blobs += [np.ascontiguousarray(s).reshape(-1) for s in samples]
+    if checkpoint is not None:
+        header["checkpoint"] = True
+        blobs.append(checkpoint if isinstance(checkpoint, bytes) else checkpoint.encode())
+    _send(sock, header, blobs)
+
+
+def _recv_batch(sock, header):
+    outputs = []
+    for out in header["outputs"]:
+        dtype = np.dtype(out["dtype"])
+        samples = []
+        for shape in out["shapes"]:
+            sample = np.empty(shape, dtype=dtype)
+            _recv_into(sock, sample.reshape(-1))
+            samples.append(sample)
+        outputs.append(samples)
+    checkpoint = None
+    if header.get("checkpoint"):
+        checkpoint = bytearray(header["sizes"][-1])
+        _recv_into(sock, checkpoint)
+        checkpoint = bytes(checkpoint)
+    return tuple(outputs), checkpoint
+
+
+class PipelineServer:
+    """Runs DALI pipelines for the :class:`RemoteSource` objects which connect to it.
+
+    Each connection gets its own pipeline, created with ``pipeline_factory(checkpoint)``, where
+    `checkpoint` is the checkpoint sent by the client (or None, if the client starts from the
+    beginning). The pipeline is built by the server, if needed. The outputs of the pipeline
+    are sent to the client in every iteration; the GPU outputs are copied to the host first.
+
+    Parameters
+    ----------
+    pipeline_factory : callable
+        Creates the pipeline for a connection; the pipeline should be restored from the
+        checkpoint passed to it (e.g. with the `checkpoint` argument of the pipeline).
+    address : tuple
+        The (host, port) to listen on. With the port 0, a free port is picked - the actual
+        address is available as :attr:`address`.
+    """
+
+    def __init__(self, pipeline_factory: Callable[[Optional[bytes]], Pipeline], address):
+        self._pipeline_factory = pipeline_factory
+        self._sock = socket.create_server(address)
+        self.address = self._sock.getsockname()[:2]
+        self._threads = []
+
+    def serve(self, num_connections):
+        """Serves the given number of connections and returns when all of them are closed."""
+        for _ in range(num_connections):
+            conn, _ = self._sock.accept()
+            thread = threading.Thread(target=self._serve_connection, args=(conn,), daemon=True)
+            thread.start()
+            self._threads.append(thread)
+        for thread in self._threads:
+            thread.join()
+        self._threads = []
+
+    def serve_forever(self):
+        """Serves the connections until the process is terminated."""
+        while True:
+            conn, _ = self._sock.accept()
+            threading.Thread(target=self._serve_connection, args=(conn,), daemon=True).start()
+
+    def close(self):
+        self._sock.close()
+
+    def _serve_connection(self, conn):
+        with conn:
+            try:
+                conn.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+                request = _recv_header(conn)
+                checkpoint = None
+                if request.get("checkpoint"):
+                    checkpoint = bytearray(request["sizes"][0])
+                    _recv_into(conn, checkpoint)
+                    checkpoint = bytes(checkpoint)
+                pipe = self._pipeline_factory(checkpoint)
+                pipe.build()
+                self._run(conn, pipe)
+            except ConnectionError:
+                pass  # the client is gone
+            except Exception as e:
+                try:
+                    _send(conn, {"type": "error", "message": f"{type(e).__name__}: {e}"})
+                except OSError:
+                    pass
+
+    @staticmethod
+    def _run(conn, pipe):
+        checkpointing = pipe._enable_checkpointing
+        while True:
+            try:
+                outputs = pipe.run()
+            except StopIteration:
+                _send(conn, {"type": "end"})
+                pipe.reset()
+                continue
+            _send_batch(conn, outputs, pipe.checkpoint() if checkpointing else None)
+
+
+class RemoteSource:
+    """A source for ``fn.external_source`` (with ``batch=True``), which returns the batches
+    produced by the pipeline run by a :class:`PipelineServer`.
+
+    The source returns a tuple with the batches of all the outputs of the remote pipeline,
+    each being a list of NumPy arrays - use ``num_outputs`` of external_source to get them as
+    separate outputs. When the remote pipeline reaches the end of the epoch, the source raises
+    StopIteration.
+
+    Parameters
+    ----------
+    address : tuple
+        The (host, port) of the server.
+    checkpoint : bytes, optional
+        The checkpoint obtained with :meth:`checkpoint`, from which the stream is resumed.
+    prefetch : int, optional
+        The number of batches received ahead of the consumer.
+    """
+
+    def __init__(self, address, checkpoint: Optional[bytes] = None, prefetch: int = 2):
+        self._sock = socket.create_connection(address)
+        self._sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        if checkpoint is not None:
+            _send(self._sock, {"type": "start", "checkpoint": True}, [checkpoint])
+        else:
+            _send(self._sock, {"type": "start"})
+        self._checkpoint = checkpoint
+        self._queue = queue.Queue(maxsize=max(prefetch, 1))
+        self._receiver = threading.Thread(target=self._receive, daemon=True)
+        self._receiver.start()
+
+    def __call__(self):
+        kind, value = self._queue.get()
+        if kind == "end":
+            raise StopIteration
+        if kind == "error":
+            raise RuntimeError(f"The remote pipeline failed: {value}")
+        outputs, checkpoint = value
+        if checkpoint is not None:
+            self._checkpoint = checkpoint
+        return outputs
+
+    def checkpoint(self) -> Optional[bytes]:
+        """The checkpoint of the remote pipeline at the batch most recently returned by the
+        source (or the checkpoint the source was created with)."""
+        return self._checkpoint
+
+    def close(self):
+        self._sock.close()
+
+    def _receive(self):
+        try:
+            while True:
+                header = _recv_header(self._sock)
+                if header["type"] == "batch":
+                    self._queue.put(("batch", _recv_batch(self._sock, header)))
+                elif header["type"] == "end":
+                    self._queue.put(("end", None))
+                else:
+                    self._queue.put(("error", header.get("message", "unknown error")))
+                    return
+        except OSError as e:
+            self._queue.put(("error", str(e)))
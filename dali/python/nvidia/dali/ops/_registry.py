@@ -58,6 +58,6 @@ def _discover_ops():
     global _cpu_ops
     global _gpu_ops
     global _mixed_ops
-    _cpu_ops = _cpu_ops.union(set(_b.RegisteredCPUOps()))
-    _gpu_ops = _gpu_ops.union(set(_b.RegisteredGPUOps()))
-    _mixed_ops = _mixed_ops.union(set(_b.RegisteredMixedOps()))
+    _cpu_ops = _cpu_ops.union(set(_b.RegisteredCPUOps()), _b.LazyOperators("cpu"))
+    _gpu_ops = _gpu_ops.union(set(_b.RegisteredGPUOps()), _b.LazyOperators("gpu"))
+    _mixed_ops = _mixed_ops.union(set(_b.RegisteredMixedOps()), _b.LazyOperators("mixed"))
@@ -532,7 +532,7 @@ def _build_module_tree():
     module_tree = {}
     processed = set()
     for schema_name in _registry._all_registered_ops():
-        schema = _b.TryGetSchema(schema_name)
+        schema = _b.TryGetSchema(schema_name, load=True)
         if schema is None:
             continue
         if schema.IsDocHidden() or schema.IsInternal():
@@ -588,7 +588,7 @@ def _group_signatures(api: str):
     api_module = fn if api == "fn" else ops
 
     for schema_name in sorted(_registry._all_registered_ops()):
-        schema = _b.TryGetSchema(schema_name)
+        schema = _b.TryGetSchema(schema_name, load=True)
 
         _, module_nesting, op_name = _names._process_op_name(schema_name, api=api)
         op = _get_op(api_module, module_nesting + [op_name])
@@ -679,7 +679,7 @@ def gen_all_signatures(nvidia_dali_path, api):
         # Runtime generated classes use fully specified stubs.
         for schema_name, op in sig_groups["generated"]:
             _, module_nesting, op_name = _names._process_op_name(schema_name, api=api)
-            schema = _b.TryGetSchema(schema_name)
+            schema = _b.TryGetSchema(schema_name, load=True)
 
             if api == "fn":
                 stub_manager.get(module_nesting).write(
@@ -1,4 +1,4 @@
-# Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2017-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -24,6 +24,7 @@ from nvidia.dali import _conditionals
 from nvidia.dali._utils import dali_trace as _dali_trace
 from nvidia.dali._utils.external_source_impl import SourceKind as _SourceKind
 from threading import local as tls
+from concurrent.futures import ThreadPoolExecutor
 from . import data_node as _data_node
 import atexit
 import copy
@@ -117,6 +118,8 @@ class Pipeline(object):
         unrestricted number of streams is assumed).
     `default_cuda_stream_priority` : int, optional, default = 0
         CUDA stream priority used by DALI. See `cudaStreamCreateWithPriority` in CUDA documentation
+        Applies to all the streams used by the pipeline, including the ones used by the decoders
+        and for copying the data. Note that 0 is the lowest priority.
     `enable_memory_stats`: bool, optional, default = False
         If DALI should print operator output buffer statistics.
         Useful for `bytes_per_sample_hint` operator parameter.
@@ -204,7 +207,24 @@ class Pipeline(object):
         raised.
 
         If the ``output_ndim`` value is a single value (not a list), it will be broadcast to the
-        number of outputs from the pipeline."""
+        number of outputs from the pipeline.
+    `experimental_ipc_outputs` : bool, default = False
+        If True, the GPU outputs are allocated in memory which can be shared with other processes
+        through CUDA IPC - see :meth:`share_outputs_ipc`. Requires the dynamic executor.
+    `experimental_exec_queue_policy` : str, default = None
+        Determines which operators of the dynamic executor can run ahead of their consumers:
+
+          * ``"fully_buffered"`` - all operators,
+          * ``"backend_change"`` - the operators whose outputs are consumed by an operator
+            with a different backend (the default),
+          * ``"output_only"`` - only the producers of the pipeline outputs.
+
+    `experimental_exec_concurrency` : str, default = None
+        Determines which operators of the dynamic executor can run in parallel:
+
+          * ``"none"`` - no two operators,
+          * ``"backend"`` - operators with different backends (the default),
+          * ``"full"`` - all independent operators."""
 
     def __init__(
         self,
@@ -229,6 +249,9 @@ class Pipeline(object):
         output_dtype=None,
         output_ndim=None,
         experimental_exec_dynamic=False,
+        experimental_ipc_outputs=False,
+        experimental_exec_queue_policy=None,
+        experimental_exec_concurrency=None,
     ):
         self._pipe = None
         self._sinks = []
@@ -258,6 +281,9 @@ class Pipeline(object):
         self._names_and_devices = None
         self._exec_async = exec_async
         self._exec_dynamic = experimental_exec_dynamic
+        self._ipc_outputs = experimental_ipc_outputs
+        self._exec_queue_policy = experimental_exec_queue_policy
+        self._exec_concurrency = experimental_exec_concurrency
         self._bytes_per_sample = bytes_per_sample
         self._set_affinity = set_affinity
         self._max_streams = max_streams
@@ -501,6 +527,56 @@ class Pipeline(object):
             * ``max_reserved_memory_size`` - list of maximum memory sizes per tensor that is
               reserved for each of the operator outputs. Index in the list corresponds to
               the output index.
+
+            * ``pinned`` - list of flags telling whether the operator outputs are stored in
+              pinned host memory. The CPU outputs consumed by mixed or GPU operators are pinned,
+              so that they can be copied to the GPU without staging; the rest is pageable.
+
+        When the executor adjusts the depths of the operators' output queues at run time,
+        the following keys are also present:
+
+            * ``queue_depth`` - the current depth of the operator's output queue.
+
+            * ``queue_stall_count`` - how many times the consumers of the operator had to wait
+              for its outputs.
+
+            * ``queue_idle_count`` - how many times the consumers found the operator's output
+              queue full, with the buffers waiting for them.
+
+        With the dynamic executor (``experimental_exec_dynamic=True``), the operators' profile
+        is reported as well:
+
+            * ``iterations`` - the number of profiled iterations.
+
+            * ``cpu_time_us`` - the total host time spent in the operator's Setup and Run.
+
+            * ``gpu_time_us`` - the total time of the operator's work on its CUDA stream
+              (GPU and mixed operators only).
+
+            * ``wait_time_us`` - the total time the operator waited for its inputs and
+              the other preconditions (e.g. a full output queue).
+
+            * ``input_bytes``, ``output_bytes`` - the total size of the (regular) inputs and
+              the outputs of the operator.
+
+        as well as the breakdown of the memory used by the operator:
+
+            * ``memory`` - the memory allocated by the operator (including its loader and its
+              thread pool tasks), by purpose - ``"output"``, ``"scratch"``, ``"staging"``,
+              ``"cache"`` and ``"other"`` (e.g. the outputs which the operator allocates itself) -
+              and by memory kind (``"host"``, ``"pinned"``, ``"device"``, ``"managed"``). Each
+              entry contains the ``current`` and the ``peak`` size, in bytes; the current size
+              after the warmup is the steady state.
+
+            * ``queue_slot_size`` - the capacity of one set of the operator's outputs, i.e. of
+              one slot of its output queue.
+
+            * ``queue_slots``, ``max_queue_slots`` - the current and the maximum number of slots
+              of the operator's output queue.
+
+            * ``diagnostics`` - the operator-specific counters, if the operator has any (e.g.
+              the number of iterations run with each implementation by
+              :meth:`experimental.resize` with ``implementation="auto"``).
         """
         if not self._built:
             raise RuntimeError("Pipeline must be built first.")
@@ -878,6 +954,10 @@ class Pipeline(object):
         self._pipe.SetQueueSizes(self._cpu_queue_size, self._gpu_queue_size)
         self._pipe.EnableExecutorMemoryStats(self._enable_memory_stats)
         self._pipe.EnableCheckpointing(self._enable_checkpointing)
+        self._pipe.EnableIPCOutputs(self._ipc_outputs)
+        self._pipe.SetSchedulingPolicies(
+            self._exec_queue_policy or "", self._exec_concurrency or ""
+        )
 
         # Add the ops to the graph and build the backend
         related_logical_id = {}
@@ -1025,6 +1105,63 @@ class Pipeline(object):
         if self._built:
             return
 
+        self._prepare_build()
+        self._pipe.Build(self._generate_build_args())
+        self._finish_build()
+
+    @staticmethod
+    def build_all(pipelines, max_threads=None):
+        """Builds multiple pipelines concurrently.
+
+        Building a pipeline instantiates its operators (including, for example, the creation of
+        the image decoders) and sets up the executor. Most of this work is done in the native
+        code and doesn't hold the GIL, so when a process uses several pipelines - for example,
+        one per GPU - building them in parallel shortens the startup considerably.
+
+        The Python part of the build - defining the graph and starting the Python workers - runs
+        sequentially in the calling thread before any of the pipelines is built. This way all
+        the workers are started before the CUDA context is acquired, which is required for
+        ``py_start_method="fork"``.
+
+        The pipelines which are already built are skipped. If building any of the pipelines
+        fails, the first error is raised after all the builds have finished.
+
+        Parameters
+        ----------
+        pipelines : list of :class:`Pipeline`
+            The pipelines to build.
+        max_threads : int, optional
+            The maximum number of threads used for building; by default, each pipeline is
+            built in a separate thread.
+        """
+        pending = []
+        for pipe in pipelines:
+            if pipe._built or any(pipe is p for p in pending):
+                continue
+            if type(pipe).build is not Pipeline.build:
+                pipe.build()  # e.g. the debug mode pipelines, which are built when they're run
+            else:
+                pending.append(pipe)
+        for pipe in pending:
+            pipe.start_py_workers()
+        for pipe in pending:
+            pipe._prepare_build()
+        if not pending:
+            return
+        num_threads = len(pending) if max_threads is None else max(1, max_threads)
+        with ThreadPoolExecutor(num_threads, thread_name_prefix="dali_build") as executor:
+            futures = [
+                executor.submit(pipe._pipe.Build, pipe._generate_build_args()) for pipe in pending
+            ]
+        errors = [future.exception() for future in futures]
+        for pipe, error in zip(pending, errors):
+            if error is None:
+                pipe._finish_build()
+        for error in errors:
+            if error is not None:
+                raise error
+
+    def _prepare_build(self):
         if self.num_threads < 1:
             raise ValueError(
                 "Pipeline created with `num_threads` < 1 can only be used " "for serialization."
@@ -1035,13 +1172,40 @@ class Pipeline(object):
             self._init_pipeline_backend()
         self._setup_pipe_pool_dependency()
 
-        self._pipe.Build(self._generate_build_args())
+    def _finish_build(self):
         self._restore_state_from_checkpoint()
         self._built = True
 
     def input_feed_count(self, input_name):
         return self._pipe.InputFeedCount(input_name)
 
+    def warm_up(self, max_shapes, iterations=1):
+        """Runs the pipeline on dummy data, so that the first actual iterations don't need to
+        allocate memory.
+
+        All the inputs of the pipeline (see :meth:`feed_input`) are fed with zero-filled
+        batches and the outputs are discarded. The inputs must declare their ``dtype``.
+        The warm-up iterations are regular iterations - the readers and random number
+        generators advance.
+
+        Parameters
+        ----------
+        max_shapes : dict
+            Maps the names of the inputs to the largest expected shapes. A shape can be
+            given either for the whole batch, as a list of sample shapes, or as a single
+            sample shape (a tuple), used for ``max_batch_size`` samples.
+        iterations : int, optional, default = 1
+            The number of iterations to run.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        shapes = {}
+        for name, shape in max_shapes.items():
+            if isinstance(shape, tuple):
+                shape = [shape] * self._max_batch_size
+            shapes[name] = [tuple(sample_shape) for sample_shape in shape]
+        self._pipe.WarmUp(shapes, iterations)
+
     def _feed_input(self, name, data, layout=None, cuda_stream=None, use_copy_kernel=False):
         from nvidia.dali.external_source import _prep_data_for_feed_input
 
@@ -1215,6 +1379,141 @@ class Pipeline(object):
             self._batches_to_consume -= 1
             return self._pipe.ShareOutputs()
 
+    def share_outputs_ipc(self):
+        """Returns the outputs of the pipeline, along with the descriptors which allow another
+        process to map the GPU outputs.
+
+        Works like :meth:`share_outputs`. The pipeline must be created with
+        ``experimental_ipc_outputs=True``. The descriptors are dictionaries of plain Python
+        values, which can be passed to :func:`nvidia.dali.backend.ImportTensorListIPC` in the
+        consumer process. The file descriptor (the ``"fd"`` entry) must be sent to that process
+        by means of a UNIX domain socket (e.g. with :func:`socket.send_fds`).
+
+        The memory is reused once the outputs are released - the consumer must be done with
+        the data before :meth:`release_outputs` is called.
+
+        :return:
+            A tuple of a list of `TensorList` objects for respective pipeline outputs and
+            a list of the descriptors (``None`` for the CPU outputs)
+        """
+        with self._check_api_type_scope(types.PipelineAPIType.SCHEDULED):
+            self._consumer_iter += 1
+            if self._batches_to_consume == 0:
+                raise StopIteration
+            self._batches_to_consume -= 1
+            return self._pipe.ShareOutputsIPC()
+
+    def set_output_buffer(self, output_idx, ptr, size, cuda_stream=None):
+        """Provides a device buffer in which a GPU output of a future iteration is to be produced,
+        so that it doesn't have to be copied.
+
+        The buffer is taken by the next scheduled iteration which doesn't have a buffer for this
+        output yet - to cover the prefetched iterations, call this function before each
+        :meth:`schedule_run` (or once per iteration, before the first one, which prefetches).
+        The buffer is used if it's large enough and the output is produced by an operator
+        (rather than passed through from the input); otherwise, the output is allocated as usual.
+        When the buffer was used, the output's data pointer is equal to `ptr` and copying the
+        output to `ptr` (e.g. with ``copy_to_external``) is a no-op.
+
+        The buffer must remain valid until the outputs of the iteration are released.
+        Requires ``experimental_exec_dynamic=True``.
+
+        Parameters
+        ----------
+        output_idx : int
+            The index of the GPU output.
+        ptr : int or ctypes.c_void_p
+            The address of the device buffer.
+        size : int
+            The size of the buffer, in bytes.
+        cuda_stream : int or ctypes.c_void_p, optional
+            If provided, the buffer is written after the work scheduled in this stream up to
+            this call.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        if not isinstance(ptr, ctypes.c_void_p):
+            ptr = ctypes.c_void_p(ptr)
+        if cuda_stream is not None and not isinstance(cuda_stream, ctypes.c_void_p):
+            cuda_stream = ctypes.c_void_p(cuda_stream)
+        self._pipe.SetOutputBuffer(output_idx, ptr, size, cuda_stream)
+
+    def _enable_async_outputs(self, enable=True):
+        """Makes :meth:`share_outputs` and :meth:`outputs` return without waiting on the host for
+        the GPU outputs to be computed.
+
+        The consumer must then wait for the outputs in its stream - the non-blocking
+        ``copy_to_external`` of a :class:`TensorListGPU` does that. The CPU outputs are
+        always complete. Requires ``experimental_exec_dynamic=True``.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        self._pipe.EnableAsyncOutputs(enable)
+
+    def diagnose_bottleneck(self, reset=True):
+        """Tells which stage limits the throughput of the pipeline.
+
+        The diagnosis is based on the utilization of the pipeline stages since the previous
+        call with ``reset=True`` (or since the pipeline was built). It returns a dictionary with:
+
+            * ``bottleneck`` - ``"io"``, ``"cpu"``, ``"gpu"`` or ``"consumer"`` (the pipeline
+              outputs are ready before they're requested - DALI is not the bottleneck),
+            * ``verdict`` - a one-line description with the supporting numbers,
+            * ``window_time_us`` and ``iterations`` - the length of the window and the number
+              of iterations whose outputs were returned in it,
+            * ``loader_wait`` - the fraction of the time the readers waited for the data,
+            * ``cpu_busy`` - the fraction of the time the CPU operators were running,
+            * ``thread_pool_busy`` - the mean utilization of the threads of the thread pool,
+            * ``gpu_busy`` - the fraction of the time the busiest stream was running; it's
+              measured only when ``enable_memory_stats=True`` (otherwise it's None),
+            * ``consumer_wait`` - the fraction of the time the consumer waited for the outputs,
+            * ``outputs_ready`` - the fraction of the outputs which were ready when requested.
+
+        Requires ``experimental_exec_dynamic=True``.
+
+        Parameters
+        ----------
+        reset : bool, default = True
+            If True, the next diagnosis covers the time since this call.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        return self._pipe.GetDiagnostics(reset)
+
+    def enable_trace(self, enable=True):
+        """Starts (or stops) recording the execution timeline of the pipeline. Starting the
+        recording discards the timeline recorded so far.
+
+        The timeline contains the iterations, the host-side execution of each operator on the
+        thread which actually ran it, the GPU execution of the operators on their streams and
+        the data dependencies between the operators. Unlike NVTX ranges, it doesn't require a
+        profiler. Use :meth:`write_trace` to save it.
+
+        Setting the environment variable ``DALI_EXEC_TRACE_FILE`` records the whole run and
+        writes it to the given file when the pipeline is destroyed.
+        Requires ``experimental_exec_dynamic=True``.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        self._pipe.EnableTrace(enable)
+
+    def write_trace(self, path):
+        """Writes the execution timeline recorded so far (see :meth:`enable_trace`) to a file
+        and discards it.
+
+        The file is in the Chrome trace event (JSON) format, which can be opened in
+        ``chrome://tracing`` or in the Perfetto UI (https://ui.perfetto.dev).
+        The function waits for the GPU work of the recorded operators to complete.
+
+        Parameters
+        ----------
+        path : str
+            The path of the output file.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        self._pipe.WriteTrace(str(path))
+
     # for the backward compatibility
     def _share_outputs(self):
         """Deprecated. Use :meth:`share_outputs` instead"""
@@ -1441,7 +1740,7 @@ class Pipeline(object):
         """If there is any work scheduled in the pipeline but not yet consumed"""
         return self._batches_to_consume == 0
 
-    def serialize(self, define_graph=None, filename=None):
+    def serialize(self, define_graph=None, filename=None, lowered=False):
         """Serialize the pipeline to a Protobuf string.
 
         Additionally, you can pass file name, so that serialized pipeline will be written there.
@@ -1455,6 +1754,12 @@ class Pipeline(object):
                 :meth:`set_outputs`.
         filename : str
                 The file that the serialized pipeline will be written to.
+        lowered : bool, optional, default = False
+                If True, the graph of the built pipeline (the pipeline is built, if it's not yet)
+                is serialized - after the data transfers are inserted and the graph is optimized.
+                :meth:`deserialize` builds such a pipeline without validating the operators and
+                optimizing the graph again, which makes it faster to start.
+                The seeds of the operators are preserved.
         kwargs : dict
                 Refer to Pipeline constructor for full list of arguments.
         """
@@ -1472,7 +1777,12 @@ class Pipeline(object):
         if not self._backend_prepared:
             self._init_pipeline_backend()
             self._pipe.SetOutputDescs(self._generate_build_args())
-        ret = self._pipe.SerializeToProtobuf()
+        if lowered:
+            if not self._built:
+                self.build()
+            ret = self._pipe.SerializeLowered()
+        else:
+            ret = self._pipe.SerializeToProtobuf()
         if filename is not None:
             with open(filename, "wb") as pipeline_file:
                 pipeline_file.write(ret)
@@ -1537,6 +1847,10 @@ class Pipeline(object):
         pipeline._pipe.SetQueueSizes(pipeline._cpu_queue_size, pipeline._gpu_queue_size)
         pipeline._pipe.EnableExecutorMemoryStats(pipeline._enable_memory_stats)
         pipeline._pipe.EnableCheckpointing(pipeline._enable_checkpointing)
+        pipeline._pipe.EnableIPCOutputs(pipeline._ipc_outputs)
+        pipeline._pipe.SetSchedulingPolicies(
+            pipeline._exec_queue_policy or "", pipeline._exec_concurrency or ""
+        )
         pipeline._backend_prepared = True
         pipeline._pipe.Build()
         pipeline._restore_state_from_checkpoint()
@@ -1581,6 +1895,10 @@ class Pipeline(object):
         self._pipe.SetQueueSizes(self._cpu_queue_size, self._gpu_queue_size)
         self._pipe.EnableExecutorMemoryStats(self._enable_memory_stats)
         self._pipe.EnableCheckpointing(self._enable_checkpointing)
+        self._pipe.EnableIPCOutputs(self._ipc_outputs)
+        self._pipe.SetSchedulingPolicies(
+            self._exec_queue_policy or "", self._exec_concurrency or ""
+        )
         self._backend_prepared = True
         self._pipe.Build()
         self._restore_state_from_checkpoint()
@@ -1922,6 +2240,10 @@ def _generate_graph(pipe, func, fn_args, fn_kwargs):
             po = ()
         else:
             po = (pipe_outputs,)
+        # The materialization points marked in a lazy debug mode become additional outputs
+        materialization_points = getattr(pipe, "_materialization_points", None)
+        if materialization_points:
+            po = po + tuple(materialization_points.values())
         pipe.set_outputs(*po)
 
 
@@ -2225,7 +2547,7 @@ def _pipeline_def_experimental(fn=None, *, enable_conditionals=False, **pipeline
 
     Keyword args
     ------------
-    debug : bool, optional
+    debug : bool or str, optional
         Enable pipeline debug mode - allowing for step-by-step execution and intermediate data
         inspection of the pipeline definition, by default False.
 
@@ -2233,6 +2555,13 @@ def _pipeline_def_experimental(fn=None, *, enable_conditionals=False, **pipeline
             This mode is intended only for debugging purposes - the pipeline performance will be
             significantly worse than the non-debug mode.
 
+        When set to ``"lazy"``, only the first iteration is run step-by-step. From the second
+        iteration on, the pipeline definition is run as a regular pipeline graph, without
+        synchronizing after each operator. The intermediate data can be inspected at the points
+        marked with :meth:`materialize <nvidia.dali.pipeline.experimental.materialize>`.
+        The graph starts with the data source positions matching those after the first
+        iteration, but the operators are seeded independently of the step-by-step run.
+
     .. note::
 
         The features enabled by this decorator are experimental. The API may change and the
@@ -2252,8 +2581,24 @@ def _pipeline_def_experimental(fn=None, *, enable_conditionals=False, **pipeline
             # TODO(klecki): Use pipe_func here after similar todo is resolved in regular decorator.
             pipeline_args, fn_kwargs = _regroup_args(func, pipeline_kwargs, kwargs)
             if debug_mode_on:
+                graph_factory = None
+                if debug_mode_on == "lazy":
+
+                    def graph_factory():
+                        graph_pipe = Pipeline(**pipeline_args)
+                        graph_pipe._materialization_points = {}
+                        _preprocess_pipe_object(graph_pipe, conditionals_on, args, fn_kwargs)
+                        _generate_graph(graph_pipe, pipe_func, args, fn_kwargs)
+                        return graph_pipe
+
+                elif debug_mode_on is not True:
+                    raise ValueError(
+                        f'The `debug` argument must be a boolean or "lazy", got: {debug_mode_on}.'
+                    )
                 pipe = _PipelineDebug(
-                    functools.partial(pipe_func, *args, **fn_kwargs), **pipeline_args
+                    functools.partial(pipe_func, *args, **fn_kwargs),
+                    graph_factory=graph_factory,
+                    **pipeline_args,
                 )
             else:
                 pipe = Pipeline(**pipeline_args)
@@ -2272,11 +2617,40 @@ def _pipeline_def_experimental(fn=None, *, enable_conditionals=False, **pipeline
     return actual_decorator(fn) if fn else actual_decorator
 
 
+def _materialize_experimental(data, name):
+    """Marks `data` as a materialization point of a pipeline in the debug mode.
+
+    The value of `data` in the most recent iteration can be retrieved by calling
+    ``pipe.materialized(name)``. In the ``debug="lazy"`` mode, the materialization points are
+    computed as additional outputs of the pipeline graph, so they must be defined outside of
+    the conditional branches. In a pipeline that is not in the debug mode, the call has no effect.
+
+    Parameters
+    ----------
+    data : DataNode
+        The data to be materialized.
+    name : str
+        The name used to retrieve the data.
+
+    Returns
+    -------
+    The `data`, so the call can be used inline.
+    """
+    materialization_points = getattr(Pipeline.current(), "_materialization_points", None)
+    if materialization_points is not None:
+        if name in materialization_points:
+            raise ValueError(f'The materialization point "{name}" is already defined.')
+        materialization_points[name] = data
+    return data
+
+
 def _insert_experimental_pipeline_def():
     current_module = sys.modules[__name__]
     experimental_module = internal.get_submodule(current_module, "experimental")
     _pipeline_def_experimental.__module__ = experimental_module
     setattr(experimental_module, "pipeline_def", _pipeline_def_experimental)
+    _materialize_experimental.__module__ = experimental_module
+    setattr(experimental_module, "materialize", _materialize_experimental)
 
 
 _insert_experimental_pipeline_def()
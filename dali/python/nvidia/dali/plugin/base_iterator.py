@@ -1,4 +1,4 @@
-# Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2020-2024, 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -33,6 +33,17 @@ def _iterator_deprecation_warning():
     )
 
 
+def _require_dynamic_executor(pipelines, option):
+    """Checks that the pipelines use the dynamic executor, which the iterator `option`
+    requires - for example, to share the output memory, which it doesn't reuse."""
+    for p in pipelines if isinstance(pipelines, list) else [pipelines]:
+        if not p._exec_dynamic:
+            raise ValueError(
+                f"`{option}` requires the pipelines to be created with "
+                "`experimental_exec_dynamic=True`."
+            )
+
+
 @unique
 class LastBatchPolicy(Enum):
     """
@@ -133,6 +133,7 @@ class DALIGenericPeekableIterator(DALIGenericIterator):
         last_batch_policy: LastBatchPolicy = LastBatchPolicy.FILL,
         prepare_first_batch: bool = True,
         sharding: Optional[Sharding] = None,
+        experimental_async_outputs: bool = False,
     ):
         super().__init__(
             pipelines,
@@ -144,6 +145,7 @@ class DALIGenericPeekableIterator(DALIGenericIterator):
             last_batch_policy,
             prepare_first_batch,
             sharding,
+            experimental_async_outputs,
         )
         self._mutex = threading.Lock()
         self._pool = None
@@ -1,4 +1,4 @@
-# Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -18,15 +18,19 @@ import jax.dlpack
 from nvidia.dali.backend import TensorGPU
 
 
-def _to_jax_array(dali_tensor: TensorGPU) -> jax.Array:
+def _to_jax_array(dali_tensor: TensorGPU, copy: bool = True) -> jax.Array:
     """Converts input DALI tensor to JAX array.
 
     Args:
         dali_tensor (TensorGPU): DALI GPU tensor to be converted to JAX array.
+        copy (bool): Whether the data should be copied. If False, the JAX array shares the
+            memory with the DALI tensor (keeping it alive) and, if the tensor is not ready yet,
+            JAX waits for it in its stream, instead of the host waiting. Sharing is safe
+            only if DALI doesn't reuse the memory for the subsequent iterations, as is the
+            case with the dynamic executor.
 
     Note:
-        This function performs deep copy of the underlying data. That will change in
-        future releases.
+        By default, this function performs deep copy of the underlying data.
 
     Warning:
         As private this API may change without notice.
@@ -35,6 +39,11 @@ def _to_jax_array(dali_tensor: TensorGPU) -> jax.Array:
         jax.Array: JAX array with the same values and backing device as
         input DALI tensor.
     """
+    if not copy:
+        # The DLPack protocol: JAX passes its stream to `__dlpack__`, which makes it wait
+        # for DALI's work; the capsule holds a reference to the DALI buffer.
+        return jax.dlpack.from_dlpack(dali_tensor)
+
     jax_array = jax.dlpack.from_dlpack(dali_tensor._expose_dlpack_capsule())
 
     # For now we need this copy to make sure that underlying memory is available.
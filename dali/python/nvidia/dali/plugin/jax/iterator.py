@@ -1,4 +1,4 @@
-# Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2023-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -18,6 +18,7 @@ from jax.sharding import NamedSharding, PositionalSharding, Sharding
 
 from nvidia.dali.plugin.base_iterator import _DaliBaseIterator
 from nvidia.dali.plugin.base_iterator import LastBatchPolicy
+from nvidia.dali.plugin.base_iterator import _require_dynamic_executor
 from nvidia.dali.pipeline import pipeline_def
 from nvidia.dali.pipeline import Pipeline, DataNode
 
@@ -85,6 +86,15 @@ class DALIGenericIterator(_DaliBaseIterator):
                 `jax.sharding.Sharding` compatible object that, if present, will be used to
                 build an output jax.Array for each category. If ``None``, the iterator returns
                 values compatible with pmapped JAX functions, if multiple pipelines are provided.
+    experimental_async_outputs : bool, optional, default = False
+                Whether the GPU outputs should be returned as soon as the iteration is scheduled,
+                without copying them and without any host synchronization. The returned arrays
+                share the memory with DALI's outputs and JAX waits for them in its stream, so
+                the next steps can be enqueued while DALI is still computing.
+                The pipelines keep computing ahead as many batches as their
+                ``prefetch_queue_depth``; these batches stay resident on the devices.
+                Requires the pipelines to use the dynamic executor
+                (``experimental_exec_dynamic=True``), which doesn't reuse the output memory.
 
     Example
     -------
@@ -117,6 +127,7 @@ class DALIGenericIterator(_DaliBaseIterator):
         last_batch_policy: LastBatchPolicy = LastBatchPolicy.FILL,
         prepare_first_batch: bool = True,
         sharding: Optional[Sharding] = None,
+        experimental_async_outputs: bool = False,
     ):
         # check the assert first as _DaliBaseIterator would run the prefetch
         if len(set(output_map)) != len(output_map):
@@ -124,6 +135,10 @@ class DALIGenericIterator(_DaliBaseIterator):
         self._output_categories = set(output_map)
         self.output_map = output_map
 
+        self._async_outputs = experimental_async_outputs
+        if self._async_outputs:
+            _require_dynamic_executor(pipelines, "experimental_async_outputs")
+
         if sharding is not None:
             assert isinstance(
                 sharding, (NamedSharding, PositionalSharding)
@@ -146,6 +161,10 @@ class DALIGenericIterator(_DaliBaseIterator):
             prepare_first_batch=prepare_first_batch,
         )
 
+        if self._async_outputs:
+            for p in self._pipes:
+                p._enable_async_outputs()
+
         self._first_batch = None
         if self._prepare_first_batch:
             try:
@@ -193,7 +212,10 @@ class DALIGenericIterator(_DaliBaseIterator):
 
         for pipeline_id in range(self._num_gpus):
             category_outputs.append(
-                _to_jax_array(pipelines_outputs[pipeline_id][category_id].as_tensor())
+                _to_jax_array(
+                    pipelines_outputs[pipeline_id][category_id].as_tensor(),
+                    copy=not self._async_outputs,
+                )
             )
 
         return category_outputs
@@ -266,6 +288,7 @@ def _data_iterator_impl(
     prepare_first_batch: bool = True,
     sharding: Optional[Sharding] = None,
     devices: Optional[List[jax.Device]] = None,
+    experimental_async_outputs: bool = False,
 ):
     """Implementation of the data_iterator decorator. It is extracted to a separate function
     to be reused by the peekable iterator decorator.
@@ -299,6 +322,7 @@ def _data_iterator_impl(
                     last_batch_padded=last_batch_padded,
                     last_batch_policy=last_batch_policy,
                     prepare_first_batch=prepare_first_batch,
+                    experimental_async_outputs=experimental_async_outputs,
                 )
             else:
                 pipelines = []
@@ -353,6 +377,7 @@ def _data_iterator_impl(
                         last_batch_policy=last_batch_policy,
                         prepare_first_batch=prepare_first_batch,
                         sharding=sharding,
+                        experimental_async_outputs=experimental_async_outputs,
                     )
                 elif devices is not None:
                     return iterator_type(
@@ -364,6 +389,7 @@ def _data_iterator_impl(
                         last_batch_padded=last_batch_padded,
                         last_batch_policy=last_batch_policy,
                         prepare_first_batch=prepare_first_batch,
+                        experimental_async_outputs=experimental_async_outputs,
                     )
 
                 raise AssertionError(
@@ -386,6 +412,7 @@ def data_iterator(
     prepare_first_batch: bool = True,
     sharding: Optional[Sharding] = None,
     devices: Optional[List[jax.Device]] = None,
+    experimental_async_outputs: bool = False,
 ):
     """Decorator for DALI iterator for JAX. Decorated function when called returns DALI
     iterator for JAX.
@@ -464,6 +491,10 @@ def data_iterator(
     checkpoints : list of str, optional, default = None
                 Checkpoints obtained with `.checkpoints()` method of the iterator.
                 If provided, they will be used to restore the state of the pipelines.
+    experimental_async_outputs : bool, optional, default = False
+                Whether the GPU outputs should be returned without copying them and without
+                host synchronization, see :class:`DALIGenericIterator`. Requires
+                ``experimental_exec_dynamic=True`` to be passed to the decorated function.
 
     Example
     -------
@@ -496,4 +527,5 @@ def data_iterator(
         prepare_first_batch,
         sharding,
         devices,
+        experimental_async_outputs,
     )
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import os
 from packaging.version import Version
 
 from nvidia.dali.pipeline import Pipeline
@@ -62,6 +63,23 @@ minimal_numba_version = {
 }
 
 
+# The functions compiled in this process, shared by the operator instances. The operator refers
+# to the compiled code by its address only - the entries keep the code alive.
+_compiled_fns = {}
+
+
+def _can_cache_on_disk(fn):
+    """Numba can store the compiled function in its on-disk cache only if the function's source
+    lives in a file."""
+    code = getattr(fn, "__code__", None)
+    return code is not None and os.path.isfile(code.co_filename)
+
+
+def _current_device_id():
+    pipeline = Pipeline.current()
+    return pipeline.device_id if pipeline is not None else None
+
+
 @nb.extending.intrinsic
 def address_as_void_pointer(typingctx, src):
     from numba.core import types, cgutils
@@ -167,7 +185,10 @@ class NumbaFunction(
     def _get_setup_fn_cpu(self, setup_fn):
         setup_fn_address = None
         if setup_fn is not None:
-            setup_fn = njit(setup_fn)
+            key = ("setup", setup_fn)
+            if key in _compiled_fns:
+                return _compiled_fns[key][0]
+            setup_fn = njit(setup_fn, cache=_can_cache_on_disk(setup_fn))
 
             @cfunc(self._setup_fn_sig(), nopython=True)
             def setup_cfunc(
@@ -186,10 +207,14 @@ class NumbaFunction(
                 setup_fn(out_shapes_np, in_shapes_np)
 
             setup_fn_address = setup_cfunc.address
+            _compiled_fns[key] = (setup_fn_address, setup_cfunc)
 
         return setup_fn_address
 
     def _get_run_fn_gpu(self, run_fn, types, dims):
+        key = ("gpu", run_fn, tuple(types), tuple(dims), _current_device_id())
+        if key in _compiled_fns:
+            return _compiled_fns[key][0]
         nvvm_options = {"fastmath": False, "opt": 3}
 
         cuda_arguments = []
@@ -222,9 +247,21 @@ class NumbaFunction(
             )
 
         handle = lib.get_cufunc().handle
+        _compiled_fns[key] = (handle.value, lib)
         return handle.value
 
     def _get_run_fn_cpu(self, run_fn, out_types, in_types, outs_ndim, ins_ndim, batch_processing):
+        key = (
+            "cpu",
+            run_fn,
+            tuple(out_types),
+            tuple(in_types),
+            tuple(outs_ndim),
+            tuple(ins_ndim),
+            batch_processing,
+        )
+        if key in _compiled_fns:
+            return _compiled_fns[key][0]
         (
             out0_lambda,
             out1_lambda,
@@ -241,7 +278,7 @@ class NumbaFunction(
             in4_lambda,
             in5_lambda,
         ) = self._get_carrays_eval_lambda(in_types, ins_ndim)
-        run_fn = njit(run_fn)
+        run_fn = njit(run_fn, cache=_can_cache_on_disk(run_fn))
         run_fn_lambda = self._get_run_fn_lambda(len(out_types), len(in_types))
         if batch_processing:
 
@@ -384,6 +421,7 @@ class NumbaFunction(
                     run_fn, out0, out1, out2, out3, out4, out5, in0, in1, in2, in3, in4, in5
                 )
 
+        _compiled_fns[key] = (run_cfunc.address, run_cfunc)
         return run_cfunc.address
 
     def __call__(self, *inputs, **kwargs):
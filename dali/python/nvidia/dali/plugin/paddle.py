@@ -1,5 +1,5 @@
 # Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
-# Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2017-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -24,6 +24,7 @@ from nvidia.dali import types
 from nvidia.dali.backend import TensorListCPU, TensorGPU, TensorListGPU
 from nvidia.dali.plugin.base_iterator import _DaliBaseIterator
 from nvidia.dali.plugin.base_iterator import LastBatchPolicy
+from nvidia.dali.plugin.base_iterator import _require_dynamic_executor
 
 if isinstance(paddle.__version__, str):
     assert Version(paddle.__version__) == Version("0.0.0") or Version(
@@ -196,6 +197,19 @@ class DALIGenericIterator(_DaliBaseIterator):
     prepare_first_batch : bool, optional, default = True
                 Whether DALI should buffer the first batch right after the creation of the iterator,
                 so one batch is already prepared when the iterator is prompted for the data
+    experimental_async_outputs : bool, optional, default = False
+                Whether the GPU outputs with LoD level 0 should be returned without copying them
+                and without any host synchronization. The returned tensors share the memory with
+                DALI's outputs (through DLPack) and Paddle's current stream waits for them, so
+                the next steps can be enqueued while DALI is still computing.
+                The pipelines keep computing ahead as many batches as their
+                ``prefetch_queue_depth``; these batches stay resident on the devices.
+                Requires the pipelines to use the dynamic executor
+                (``experimental_exec_dynamic=True``), which doesn't reuse the output memory.
+    pin_memory : bool, optional, default = False
+                Whether the CPU outputs should be returned in page-locked memory
+                (``paddle.CUDAPinnedPlace``), so that they can be copied to the GPU
+                asynchronously.
 
     Example
     -------
@@ -232,6 +246,8 @@ class DALIGenericIterator(_DaliBaseIterator):
         last_batch_padded=False,
         last_batch_policy=LastBatchPolicy.FILL,
         prepare_first_batch=True,
+        experimental_async_outputs=False,
+        pin_memory=False,
     ):
         normalized_map = {}
         for v in output_map:
@@ -245,6 +261,10 @@ class DALIGenericIterator(_DaliBaseIterator):
         output_map = [isinstance(v, str) and v or v[0] for v in output_map]
         assert len(set(output_map)) == len(output_map), "output_map names should be distinct"
         self.output_map = output_map
+        self._async_outputs = experimental_async_outputs
+        self._pin_memory = pin_memory
+        if self._async_outputs:
+            _require_dynamic_executor(pipelines, "experimental_async_outputs")
 
         _DaliBaseIterator.__init__(
             self,
@@ -258,6 +278,10 @@ class DALIGenericIterator(_DaliBaseIterator):
             prepare_first_batch=prepare_first_batch,
         )
 
+        if self._async_outputs:
+            for p in self._pipes:
+                p._enable_async_outputs()
+
         self._first_batch = None
         if self._prepare_first_batch:
             try:
@@ -289,7 +313,7 @@ class DALIGenericIterator(_DaliBaseIterator):
                 category_outputs[self.output_map[j]] = out
 
             pd_gpu_place = paddle.CUDAPlace(dev_id)
-            pd_cpu_place = paddle.CPUPlace()
+            pd_cpu_place = paddle.CUDAPinnedPlace() if self._pin_memory else paddle.CPUPlace()
 
             category_pd_type = dict()
             category_place = dict()
@@ -321,18 +345,30 @@ class DALIGenericIterator(_DaliBaseIterator):
                 else:
                     category_place[cat] = pd_cpu_place
 
+            stream = paddle.device.cuda.current_stream(dev_id).cuda_stream
             pd_tensors = {}
+            to_copy = {}
             for cat, tensor in category_tensors.items():
+                if (
+                    self._async_outputs
+                    and self.normalized_map[cat] == 0
+                    and category_place[cat] is pd_gpu_place
+                ):
+                    # The tensor shares DALI's output; the stream waits for it to be ready
+                    pd_tensors[cat] = paddle.framework.core.from_dlpack(
+                        tensor.__dlpack__(stream=stream)
+                    )
+                    continue
                 lod_tensor = paddle.framework.core.LoDTensor()
                 pd_tensors[cat] = lod_tensor
                 lod_tensor._set_dims(category_shapes[cat])
                 seq_len = category_lengths[cat]
                 lod_tensor.set_recursive_sequence_lengths(seq_len)
                 lod_tensor._mutable_data(category_place[cat], category_pd_type[cat])
+                to_copy[cat] = tensor
             data_batches[i] = pd_tensors
 
-            stream = paddle.device.cuda.current_stream(dev_id).cuda_stream
-            for cat, tensor in category_tensors.items():
+            for cat, tensor in to_copy.items():
                 ptr = pd_tensors[cat]._mutable_data(category_place[cat], category_pd_type[cat])
                 feed_ndarray(tensor, ptr, stream)
 
@@ -1,4 +1,4 @@
-# Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2017-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import collections
 import sys
 
 from typing import Union, Optional
@@ -25,6 +26,7 @@ from nvidia.dali.pipeline import Pipeline
 
 from nvidia.dali.plugin.base_iterator import _DaliBaseIterator
 from nvidia.dali.plugin.base_iterator import LastBatchPolicy
+from nvidia.dali.plugin.base_iterator import _require_dynamic_executor
 
 import torch
 import torch.utils.dlpack as torch_dlpack  # noqa: F401
@@ -44,6 +46,7 @@ to_torch_type = {
     types.DALIDataType.FLOAT: torch.float32,
     types.DALIDataType.FLOAT64: torch.float64,
     types.DALIDataType.FLOAT16: torch.float16,
+    types.DALIDataType.BFLOAT16: torch.bfloat16,
     types.DALIDataType.UINT8: torch.uint8,
     types.DALIDataType.INT8: torch.int8,
     types.DALIDataType.BOOL: torch.bool,
@@ -63,7 +66,7 @@ def feed_ndarray(
 
     Parameters
     ----------
-    `dali_tensor` : nvidia.dali.backend.TensorCPU or nvidia.dali.backend.TensorGPU
+    `dali_tensor` : nvidia.dali.backend.TensorCPU, nvidia.dali.backend.TensorGPU or a dense batch
                     Tensor from which to copy
     `arr` : torch.Tensor
             Destination of the copy
@@ -80,10 +83,15 @@ def feed_ndarray(
         " doesn't match the element type of the target PyTorch Tensor: "
         "{} vs {}".format(dali_type, arr.dtype)
     )
-    assert dali_tensor.shape() == list(
+    # a batch is copied as the tensor it can be viewed as
+    if isinstance(dali_tensor, (TensorListCPU, TensorListGPU)):
+        dali_shape = dali_tensor.as_tensor().shape()
+    else:
+        dali_shape = dali_tensor.shape()
+    assert dali_shape == list(
         arr.size()
     ), "Shapes do not match: DALI tensor has size {0}, but PyTorch Tensor has size {1}".format(
-        dali_tensor.shape(), list(arr.size())
+        dali_shape, list(arr.size())
     )
 
     non_blocking = cuda_stream is not None
@@ -164,6 +172,24 @@ class DALIGenericIterator(_DaliBaseIterator):
     prepare_first_batch : bool, optional, default = True
                 Whether DALI should buffer the first batch right after the creation of the iterator,
                 so one batch is already prepared when the iterator is prompted for the data
+    experimental_zero_copy : bool, optional, default = False
+                Whether the GPU outputs should be produced directly in the memory of the returned
+                PyTorch tensors, instead of being copied there. The tensors for an iteration are
+                allocated ahead of time, shaped like the outputs of the previous iteration; an
+                output which doesn't fit (or is not produced by an operator) is copied as usual.
+                Requires the pipelines to use the dynamic executor
+                (``experimental_exec_dynamic=True``).
+    experimental_async_outputs : bool, optional, default = False
+                Whether the GPU outputs should be returned without waiting on the host for DALI
+                to compute them. Instead, PyTorch's current stream waits for them on the GPU, so
+                no host synchronization takes place. The returned tensors must be used in
+                that stream (or in a stream synchronized with it).
+                Requires the pipelines to use the dynamic executor
+                (``experimental_exec_dynamic=True``).
+    pin_memory : bool, optional, default = False
+                Whether the CPU outputs should be returned in page-locked memory, so that they
+                can be copied to the GPU asynchronously (``.cuda(non_blocking=True)``).
+                The memory is taken from PyTorch's caching host allocator.
 
     Example
     -------
@@ -200,11 +226,30 @@ class DALIGenericIterator(_DaliBaseIterator):
         last_batch_padded: bool = False,
         last_batch_policy: LastBatchPolicy = LastBatchPolicy.FILL,
         prepare_first_batch: bool = True,
+        experimental_zero_copy: bool = False,
+        experimental_async_outputs: bool = False,
+        pin_memory: bool = False,
     ) -> None:
         # check the assert first as _DaliBaseIterator would run the prefetch
         assert len(set(output_map)) == len(output_map), "output_map names should be distinct"
         self._output_categories = set(output_map)
         self.output_map = output_map
+        self._zero_copy = experimental_zero_copy
+        self._async_outputs = experimental_async_outputs
+        self._pin_memory = pin_memory
+        for option, enabled in [
+            ("experimental_zero_copy", self._zero_copy),
+            ("experimental_async_outputs", self._async_outputs),
+        ]:
+            if enabled:
+                _require_dynamic_executor(pipelines, option)
+        if self._zero_copy:
+            # the tensors registered as the output buffers of the scheduled iterations,
+            # per pipeline and output, oldest first
+            self._output_buffers = [
+                [collections.deque() for _ in output_map]
+                for _ in range(len(pipelines) if isinstance(pipelines, list) else 1)
+            ]
 
         _DaliBaseIterator.__init__(
             self,
@@ -218,6 +263,10 @@ class DALIGenericIterator(_DaliBaseIterator):
             prepare_first_batch=prepare_first_batch,
         )
 
+        if self._async_outputs:
+            for p in self._pipes:
+                p._enable_async_outputs()
+
         self._first_batch = None
         if self._prepare_first_batch:
             try:
@@ -270,11 +319,18 @@ class DALIGenericIterator(_DaliBaseIterator):
 
             pyt_tensors = dict()
             for category in self._output_categories:
-                pyt_tensors[category] = torch.empty(
-                    category_shapes[category],
-                    dtype=category_torch_type[category],
-                    device=category_device[category],
-                )
+                if self._zero_copy and category_device[category] is torch_gpu_device:
+                    pyt_tensors[category] = self._take_output_buffer(
+                        i, category, category_tensors[category], category_torch_type[category]
+                    )
+                if pyt_tensors.get(category) is None:
+                    pyt_tensors[category] = torch.empty(
+                        category_shapes[category],
+                        dtype=category_torch_type[category],
+                        device=category_device[category],
+                        pin_memory=self._pin_memory
+                        and category_device[category] is torch_cpu_device,
+                    )
 
             data_batches[i] = pyt_tensors
 
@@ -283,10 +339,15 @@ class DALIGenericIterator(_DaliBaseIterator):
                 if isinstance(tensor, (TensorGPU, TensorListGPU)):
                     # Using same cuda_stream used by torch.zeros to set the memory
                     stream = torch.cuda.current_stream(device=pyt_tensors[category].device)
-                    feed_ndarray(tensor, pyt_tensors[category], cuda_stream=stream)
+                    # The batch (unlike the tensor view) carries the event marking its readiness,
+                    # which the stream waits for if the outputs are asynchronous
+                    batch = category_outputs[category]
+                    feed_ndarray(batch, pyt_tensors[category], cuda_stream=stream)
                 else:
                     feed_ndarray(tensor, pyt_tensors[category])
 
+        if self._zero_copy:
+            self._register_output_buffers(data_batches)
         self._schedule_runs()
 
         self._advance_and_check_drop_last()
@@ -331,6 +392,47 @@ class DALIGenericIterator(_DaliBaseIterator):
         return data_batches
 
 
+    def _register_output_buffers(self, data_batches):
+        """Provides the pipelines with the tensors in which the GPU outputs of the next scheduled
+        iteration are to be produced, shaped like the outputs in `data_batches`."""
+        for i, p in enumerate(self._pipes):
+            depth = p.prefetch_queue_depth
+            if isinstance(depth, dict):
+                depth = depth["cpu_size"] + depth["gpu_size"]
+            for j, category in enumerate(self.output_map):
+                t = data_batches[i][category]
+                if t.device.type != "cuda":
+                    continue
+                buffers = self._output_buffers[i][j]
+                # the iterations for which the oldest tensors were registered are surely over
+                while len(buffers) > depth:
+                    buffers.popleft()
+                buf = torch.empty_like(t)
+                stream = torch.cuda.current_stream(device=buf.device)
+                p.set_output_buffer(
+                    j, buf.data_ptr(), buf.numel() * buf.element_size(), stream.cuda_stream
+                )
+                buffers.append(buf)
+
+    def _take_output_buffer(self, pipe_idx, category, dali_tensor, dtype):
+        """Returns the registered tensor (or its view) in which `dali_tensor` was produced
+        or None, if it was produced elsewhere."""
+        buffers = self._output_buffers[pipe_idx][self.output_map.index(category)]
+        ptr = dali_tensor.data_ptr()
+        for k, buf in enumerate(buffers):
+            if buf.data_ptr() == ptr:
+                # the tensors registered earlier were not used by their iterations
+                for _ in range(k + 1):
+                    buffers.popleft()
+                shape = dali_tensor.shape()
+                if list(buf.shape) == shape and buf.dtype == dtype:
+                    return buf
+                # the output is smaller than the previous one - it occupies the front of the buffer
+                nbytes = int(np.prod(shape)) * torch.empty(0, dtype=dtype).element_size()
+                return buf.view(-1).view(torch.uint8)[:nbytes].view(dtype).view(shape)
+        return None
+
+
 class DALIClassificationIterator(DALIGenericIterator):
     """
     DALI iterator for classification tasks for PyTorch. It returns 2 outputs
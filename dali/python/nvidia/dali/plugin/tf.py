@@ -1,4 +1,4 @@
-# Copyright (c) 2017-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -436,6 +436,7 @@ if dataset_compatible_tensorflow():
             num_threads=4,
             device_id=0,
             exec_separated=False,
+            exec_dynamic=None,
             prefetch_queue_depth=2,
             cpu_prefetch_queue_depth=2,
             gpu_prefetch_queue_depth=2,
@@ -475,6 +476,9 @@ if dataset_compatible_tensorflow():
                 device_id = types.CPU_ONLY_DEVICE_ID
             self._device_id = device_id
             self._exec_separated = exec_separated
+            if exec_dynamic is None:
+                exec_dynamic = getattr(pipeline, "_exec_dynamic", False)
+            self._exec_dynamic = exec_dynamic
             self._prefetch_queue_depth = prefetch_queue_depth
             self._cpu_prefetch_queue_depth = cpu_prefetch_queue_depth
             self._gpu_prefetch_queue_depth = gpu_prefetch_queue_depth
@@ -805,6 +809,7 @@ if dataset_compatible_tensorflow():
                 num_threads=self._num_threads,
                 device_id=self._device_id,
                 exec_separated=self._exec_separated,
+                exec_dynamic=self._exec_dynamic,
                 prefetch_queue_depth=self._prefetch_queue_depth,
                 cpu_prefetch_queue_depth=self._cpu_prefetch_queue_depth,
                 gpu_prefetch_queue_depth=self._gpu_prefetch_queue_depth,
@@ -865,6 +870,7 @@ else:
             num_threads=4,
             device_id=0,
             exec_separated=False,
+            exec_dynamic=None,
             prefetch_queue_depth=2,
             cpu_prefetch_queue_depth=2,
             gpu_prefetch_queue_depth=2,
@@ -984,6 +990,13 @@ DALIDataset.__doc__ = """Creates a ``DALIDataset`` compatible with
         Whether to execute the pipeline in a way that enables
         overlapping CPU and GPU computation, typically resulting
         in faster execution speed, but larger memory consumption.
+    exec_dynamic : bool, optional, default = None
+        Whether to run the pipeline with the dynamic executor. If not set, the value of
+        ``experimental_exec_dynamic`` of the pipeline is used.
+        With the dynamic executor and ``exec_separated=False``, the GPU outputs are produced
+        directly in the memory of the TensorFlow tensors, with no additional copy, provided that
+        their shapes are known in advance - either fully defined in ``output_shapes`` or the
+        same as in the previous iteration.
     prefetch_queue_depth : int, optional, default = 2
         depth of the executor queue. Deeper queue makes DALI more
         resistant to uneven execution time of each batch, but it also
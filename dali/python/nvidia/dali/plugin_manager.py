@@ -16,7 +16,7 @@ from nvidia.dali import backend as b
 from nvidia.dali import ops as ops
 
 
-def load_library(library_path: str, global_symbols: bool = False):
+def load_library(library_path: str, global_symbols: bool = False, lazy: bool = False):
     """Loads a DALI plugin, containing one or more operators.
 
     Args:
@@ -24,6 +24,11 @@ def load_library(library_path: str, global_symbols: bool = False):
         global_symbols: If ``True``, the library is loaded with ``RTLD_GLOBAL`` flag or equivalent;
             otherwise ``RTLD_LOCAL`` is used. Some libraries (for example Halide) require being
             loaded with ``RTLD_GLOBAL`` - use this setting if your plugin uses any such library.
+        lazy: If ``True`` and there's a manifest file ``{library_path}.ops`` next to the library,
+            the operators listed in the manifest are registered, but the library is loaded only
+            when one of them is used for the first time. Each line of the manifest contains the
+            name of an operator followed by its backends, for example ``CustomDummy cpu gpu``.
+            Without the manifest, the library is loaded immediately.
 
     Returns:
         None.
@@ -31,7 +36,10 @@ def load_library(library_path: str, global_symbols: bool = False):
     Raises:
         RuntimeError: when unable to load the library.
     """
-    b.LoadLibrary(library_path, global_symbols)
+    if lazy:
+        b.RegisterLazyLibrary(library_path, global_symbols)
+    else:
+        b.LoadLibrary(library_path, global_symbols)
     ops.Reload()
 
 
@@ -39,6 +47,8 @@ def load_directory(plugin_dir_path: str, global_symbols: bool = False):
     """Loads a DALI plugin directory, containing one or more DALI plugins, following the pattern:
     {plugin_dir_path}/{sub_path}/libdali_{plugin_name}.so
 
+    The libraries with a manifest file (see :meth:`load_library`) are loaded lazily.
+
     Args:
         plugin_dir_path: Path to the directory to search for plugins
         global_symbols: If ``True``, the library is loaded with ``RTLD_GLOBAL`` flag or equivalent;
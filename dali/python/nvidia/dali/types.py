@@ -1,4 +1,4 @@
-# Copyright (c) 2017-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -449,6 +449,7 @@ _type_name_to_dali_type = {
     "ulong": DALIDataType.UINT64,
     "half": DALIDataType.FLOAT16,
     "float16": DALIDataType.FLOAT16,
+    "bfloat16": DALIDataType.BFLOAT16,
     "float": DALIDataType.FLOAT,
     "float32": DALIDataType.FLOAT,
     "float64": DALIDataType.FLOAT64,
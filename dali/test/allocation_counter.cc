@@ -0,0 +1,85 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/test/allocation_counter.h"
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+namespace dali {
+namespace test {
+
+namespace {
+
+thread_local AllocationCounter *current_counter = nullptr;
+
+}  // namespace
+
+AllocationCounter::AllocationCounter() : parent_(current_counter) {
+  current_counter = this;
+}
+
+AllocationCounter::~AllocationCounter() {
+  assert(current_counter == this && "The allocation counters must be destroyed in LIFO order");
+  current_counter = parent_;
+}
+
+void AllocationCounter::OnAllocation(size_t bytes) noexcept {
+  for (auto *c = current_counter; c; c = c->parent_) {
+    c->count_++;
+    c->bytes_ += bytes;
+  }
+}
+
+}  // namespace test
+}  // namespace dali
+
+// The replacements of the global allocation functions, linked into the test binary.
+// The aligned variants aren't replaced - they don't forward to these.
+
+void *operator new(std::size_t size) {
+  dali::test::AllocationCounter::OnAllocation(size);
+  if (void *ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+  return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  dali::test::AllocationCounter::OnAllocation(size);
+  return std::malloc(size ? size : 1);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept {
+  return operator new(size, tag);
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
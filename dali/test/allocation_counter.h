@@ -0,0 +1,71 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_TEST_ALLOCATION_COUNTER_H_
+#define DALI_TEST_ALLOCATION_COUNTER_H_
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace dali {
+namespace test {
+
+/**
+ * @brief Counts the heap allocations (calls to the global operator new) made by the calling
+ *        thread during the lifetime of the object.
+ *
+ * The counters can be nested - an allocation is counted by all active counters of the thread.
+ * The counters must be destroyed in the reverse order of construction.
+ */
+class AllocationCounter {
+ public:
+  AllocationCounter();
+  ~AllocationCounter();
+
+  AllocationCounter(const AllocationCounter &) = delete;
+  AllocationCounter &operator=(const AllocationCounter &) = delete;
+
+  /** The number of allocations made so far */
+  int64_t count() const noexcept { return count_; }
+
+  /** The total size, in bytes, of the allocations made so far */
+  int64_t bytes() const noexcept { return bytes_; }
+
+  /** Records an allocation in the active counters; called by the global operator new. */
+  static void OnAllocation(size_t bytes) noexcept;
+
+ private:
+  AllocationCounter *parent_ = nullptr;
+  int64_t count_ = 0;
+  int64_t bytes_ = 0;
+};
+
+}  // namespace test
+}  // namespace dali
+
+/**
+ * @brief Expects that the statement makes at most `budget` heap allocations in the calling thread.
+ */
+#define EXPECT_ALLOCATIONS_AT_MOST(budget, ...) do {                              \
+    int64_t _dali_allocs = 0;                                                     \
+    {                                                                             \
+      ::dali::test::AllocationCounter _dali_alloc_counter;                        \
+      __VA_ARGS__;                                                                \
+      _dali_allocs = _dali_alloc_counter.count();                                 \
+    }                                                                             \
+    EXPECT_LE(_dali_allocs, (budget)) << "Too many heap allocations in: " #__VA_ARGS__; \
+  } while (0)
+
+#endif  // DALI_TEST_ALLOCATION_COUNTER_H_
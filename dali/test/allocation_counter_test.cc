@@ -0,0 +1,51 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/test/allocation_counter.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace dali {
+namespace test {
+
+TEST(AllocationCounter, CountsAndNests) {
+  std::vector<int> v;
+  v.reserve(100);
+  AllocationCounter outer;
+  {
+    AllocationCounter inner;
+    auto p = std::make_unique<int64_t>(42);
+    EXPECT_EQ(inner.count(), 1);
+    EXPECT_GE(inner.bytes(), static_cast<int64_t>(sizeof(int64_t)));
+  }
+  for (int i = 0; i < 100; i++)
+    v.push_back(i);  // within the capacity
+  EXPECT_EQ(outer.count(), 1);
+  EXPECT_ALLOCATIONS_AT_MOST(0, v.clear());
+}
+
+TEST(AllocationCounter, ThreadLocal) {
+  AllocationCounter counter;
+  std::thread t([]() {
+    std::vector<int> v(1000);
+  });
+  t.join();
+  // the thread object's state may be allocated, but not the vector in the thread
+  EXPECT_LE(counter.count(), 1);
+}
+
+}  // namespace test
+}  // namespace dali
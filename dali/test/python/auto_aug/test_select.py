@@ -1,4 +1,4 @@
-# Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -88,3 +88,66 @@ def test_select(dev):
     ref_batches = _collect_batch(pipeline_refs())
     ref_batch = [ref_batches[idx % len(ops)][idx] for idx in range(batch_size)]
     check_batch(batch_select, ref_batch, max_allowed_error=1e-6)
+
+
+def square_shape_half(edge_len):
+    return [edge_len, edge_len / 2]
+
+
+@params(
+    ("cpu",),
+    ("gpu",),
+)
+def test_select_fused(dev):
+    # the augmentations sharing the op are applied in a single branch, with per-sample params,
+    # check that each sample still gets the parameter of the augmentation selected for it
+    from nvidia.dali.auto_aug import augmentations as a
+    from nvidia.dali.auto_aug.core import signed_bin
+
+    def _collect_batch(p):
+        p.build()
+        batches = p.run()
+        if dev == "gpu":
+            batches = (batch.as_cpu() for batch in batches)
+        return tuple([np.array(sample) for sample in batch] for batch in batches)
+
+    ops = [
+        overexpose,
+        a.shear_x,
+        cutout,
+        a.translate_x_no_shape,
+        overexpose.augmentation(mag_range=(0.5, 0.9)),
+        a.shear_y,
+        cutout.augmentation(mag_to_param=square_shape_half),
+        a.translate_y_no_shape,
+    ]
+    num_magnitude_bins = 3
+    batch_size = 2 * len(ops)
+
+    def get_mag_bin():
+        mag_bin = sample_info(lambda info: info.idx_in_batch % num_magnitude_bins)
+        sign = sample_info(lambda info: (info.idx_in_batch // len(ops)) % 2)
+        return signed_bin(mag_bin, random_sign=sign)
+
+    @pipeline_def(enable_conditionals=True, batch_size=batch_size, num_threads=4, device_id=0)
+    def pipeline_select():
+        op_idx = sample_info(lambda info: info.idx_in_batch % len(ops))
+        image, _ = fn.readers.file(name="Reader", file_root=images_dir)
+        image = fn.decoders.image(image, device="cpu" if dev == "cpu" else "mixed")
+        return select(
+            ops, op_idx, image, magnitude_bin=get_mag_bin(), num_magnitude_bins=num_magnitude_bins
+        )
+
+    @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0)
+    def pipeline_refs():
+        image, _ = fn.readers.file(name="Reader", file_root=images_dir)
+        image = fn.decoders.image(image, device="cpu" if dev == "cpu" else "mixed")
+        mag_bin = get_mag_bin()
+        return tuple(
+            op(image, magnitude_bin=mag_bin, num_magnitude_bins=num_magnitude_bins) for op in ops
+        )
+
+    (batch_select,) = _collect_batch(pipeline_select())
+    ref_batches = _collect_batch(pipeline_refs())
+    ref_batch = [ref_batches[idx % len(ops)][idx] for idx in range(batch_size)]
+    check_batch(batch_select, ref_batch, max_allowed_error=1e-6)
@@ -336,6 +336,72 @@ def test_tfrecord_reader(
     )
 
 
+@params(
+    (3, 4, 0, 1, True, True, 5, 1, None),
+    (4, 3, 1, 3, False, True, 1, 3, 1),
+    (5, 5, 2, 4, True, False, 8, 2, 2),
+    (3, 6, 0, 2, False, False, 3, 4, None),
+)
+def test_tfrecord_reader_block_shuffle(
+    num_epochs,
+    batch_size,
+    shard_id,
+    num_shards,
+    random_shuffle,
+    stick_to_shard,
+    shuffle_block_size,
+    shuffle_interleave,
+    iters_into_epoch=None,
+):
+    tfrecord_dir = os.path.join(data_root, "db", "tfrecord")
+
+    def tfrecord_wrapper(*args, **kwargs):
+        return fn.readers.tfrecord(*args, **kwargs)["image/encoded"]
+
+    check_reader_checkpointing(
+        tfrecord_wrapper,
+        num_epochs,
+        batch_size,
+        iters_into_epoch,
+        path=os.path.join(tfrecord_dir, "train"),
+        index_path=os.path.join(tfrecord_dir, "train.idx"),
+        features={"image/encoded": tfrec.FixedLenFeature((), tfrec.string, "")},
+        random_shuffle=random_shuffle,
+        shard_id=shard_id,
+        num_shards=num_shards,
+        stick_to_shard=stick_to_shard,
+        shuffle_block_size=shuffle_block_size,
+        shuffle_interleave=shuffle_interleave,
+    )
+
+
+@params(
+    (3, 4, 0, 1, None),
+    (4, 3, 1, 3, 1),
+    (2, 7, 2, 4, 2),
+)
+def test_tfrecord_reader_shuffle_after_epoch(
+    num_epochs, batch_size, shard_id, num_shards, iters_into_epoch=None
+):
+    tfrecord_dir = os.path.join(data_root, "db", "tfrecord")
+
+    def tfrecord_wrapper(*args, **kwargs):
+        return fn.readers.tfrecord(*args, **kwargs)["image/encoded"]
+
+    check_reader_checkpointing(
+        tfrecord_wrapper,
+        num_epochs,
+        batch_size,
+        iters_into_epoch,
+        path=os.path.join(tfrecord_dir, "train"),
+        index_path=os.path.join(tfrecord_dir, "train.idx"),
+        features={"image/encoded": tfrec.FixedLenFeature((), tfrec.string, "")},
+        shard_id=shard_id,
+        num_shards=num_shards,
+        shuffle_after_epoch=True,
+    )
+
+
 @params(
     (1, 1, 0, 3, False, False, False, None),
     (2, 2, 0, 1, False, False, True, 1),
@@ -904,6 +970,11 @@ def test_random_mask_pixel():
     check_single_input_operator(fn.segmentation.random_mask_pixel, "cpu")
 
 
+@random_signed_off("segmentation.random_mask_pixel")
+def test_random_mask_pixel_gpu():
+    check_single_input_operator(fn.segmentation.random_mask_pixel, "gpu")
+
+
 @random_signed_off("roi_random_crop")
 def test_roi_random_crop():
     check_single_input_operator(
@@ -434,6 +434,18 @@ def test_lookup_table_stateless(device):
     check_single_input(fn.lookup_table, device, keys=[0], values=[1], default_value=123)
 
 
+@params("cpu", "gpu")
+@stateless_signed_off("experimental.pack_bits")
+def test_pack_bits_stateless(device):
+    check_single_input(fn.experimental.pack_bits, device)
+
+
+@params("cpu", "gpu")
+@stateless_signed_off("experimental.unpack_bits")
+def test_unpack_bits_stateless(device):
+    check_single_input(fn.experimental.unpack_bits, device)
+
+
 @params("cpu", "gpu")
 @stateless_signed_off("transpose")
 def test_transpose_stateless(device):
@@ -601,6 +613,13 @@ def test_spectrogram_stateless(device):
     check_single_1d_input(fn.spectrogram, device)
 
 
+@stateless_signed_off("experimental.log_mel_spectrogram")
+def test_log_mel_spectrogram_stateless():
+    check_single_1d_input(
+        fn.experimental.log_mel_spectrogram, "cpu", nfft=60, window_length=50, window_step=25
+    )
+
+
 @stateless_signed_off("power_spectrum")
 def test_power_spectrum_stateless():
     check_single_signal_input(fn.power_spectrum, "cpu")
@@ -1012,6 +1031,18 @@ def test_experimental_resize(device):
     check_single_input(fn.experimental.resize, device, resize_x=50, resize_y=50)
 
 
+@params("gpu")
+@stateless_signed_off("experimental.resize_crop_mirror_normalize")
+def test_resize_crop_mirror_normalize_stateless(device):
+    check_single_input(
+        fn.experimental.resize_crop_mirror_normalize,
+        device,
+        size=(35, 55),
+        crop=(20, 20),
+        mirror=True,
+    )
+
+
 @params("cpu")
 @stateless_signed_off("zeros", "ones", "full", "zeros_like", "ones_like", "full_like")
 def test_full_operator_family(device):
@@ -1,4 +1,4 @@
-# Copyright (c) 2019-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -215,3 +215,36 @@ def test_audio_decoder_correctness():
     dtype = types.INT16
     for fmt in ["wav", "flac", "ogg"]:
         yield check_audio_decoder_correctness, fmt, dtype
+
+
+@pipeline_def(batch_size=len(names), device_id=None, num_threads=3)
+def offset_duration_pipe(offset, duration, downmix):
+    encoded, _ = fn.readers.file(files=names)
+    full, rates = fn.decoders.audio(encoded, downmix=downmix)
+    part, _ = fn.decoders.audio(encoded, downmix=downmix, offset=offset, duration=duration)
+    resampled_part, _ = fn.decoders.audio(
+        encoded, downmix=downmix, offset=offset, duration=duration, sample_rate=rate2
+    )
+    resampled_ref = fn.audio_resample(part, in_rate=rates, out_rate=rate2)
+    return full, rates, part, resampled_part, resampled_ref
+
+
+def check_offset_duration(offset, duration, downmix):
+    pipe = offset_duration_pipe(offset, duration, downmix)
+    pipe.build()
+    full, rates, part, resampled_part, resampled_ref = pipe.run()
+    for i in range(len(names)):
+        full_i = np.array(full[i])
+        rate = float(np.array(rates[i]))
+        begin = min(int(offset * rate), len(full_i))
+        end = len(full_i) if duration < 0 else min(begin + int(duration * rate), len(full_i))
+        np.testing.assert_array_equal(np.array(part[i]), full_i[begin:end])
+        np.testing.assert_allclose(
+            np.array(resampled_part[i]), np.array(resampled_ref[i]), rtol=0, atol=1e-5
+        )
+
+
+def test_offset_duration():
+    for offset, duration in [(0, 0.2), (0.1, -1), (0.25, 0.5), (10, 1)]:
+        for downmix in [False, True]:
+            yield check_offset_duration, offset, duration, downmix
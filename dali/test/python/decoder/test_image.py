@@ -139,11 +139,42 @@ def create_decoder_crop_pipeline(data_path, device):
 
     images = fn.decoders.image(jpegs, device=device, hw_decoder_load=0.7, output_type=types.RGB)
 
-    images_crop_2 = fn.crop(images, crop=(w, h), crop_pos_x=crop_pos_x, crop_pos_y=crop_pos_y)
+    # preserve=True keeps the crop from being pushed down into the decoder
+    images_crop_2 = fn.crop(
+        images, crop=(w, h), crop_pos_x=crop_pos_x, crop_pos_y=crop_pos_y, preserve=True
+    )
 
     return images_crop_1, images_crop_2
 
 
+@pipeline_def
+def create_decoder_crop_pushdown_pipeline(data_path, device):
+    jpegs, _ = fn.readers.file(file_root=data_path, shard_id=0, num_shards=1, name="Reader")
+
+    crop_pos_x = fn.random.uniform(range=[0.1, 0.9])
+    crop_pos_y = fn.random.uniform(range=[0.1, 0.9])
+    w = 242
+    h = 230
+
+    # the crop window of the first one is pushed down into the decoder
+    images_1 = fn.decoders.image(jpegs, device=device, hw_decoder_load=0.7, output_type=types.RGB)
+    images_cmn_1 = fn.crop_mirror_normalize(
+        images_1, crop=(h, w), crop_pos_x=crop_pos_x, crop_pos_y=crop_pos_y, mirror=1
+    )
+
+    images_2 = fn.decoders.image(jpegs, device=device, hw_decoder_load=0.7, output_type=types.RGB)
+    images_cmn_2 = fn.crop_mirror_normalize(
+        images_2,
+        crop=(h, w),
+        crop_pos_x=crop_pos_x,
+        crop_pos_y=crop_pos_y,
+        mirror=1,
+        preserve=True,
+    )
+
+    return images_cmn_1, images_cmn_2
+
+
 @pipeline_def
 def create_decoder_random_crop_pipeline(data_path, device):
     seed = 1234
@@ -188,6 +219,7 @@ def test_image_decoder_fused():
     for test_fun in [
         create_decoder_slice_pipeline,
         create_decoder_crop_pipeline,
+        create_decoder_crop_pushdown_pipeline,
         create_decoder_random_crop_pipeline,
     ]:
         # before CUDA 11.4 HW decoder API doesn't support ROI so we get slightly different results
@@ -520,3 +552,30 @@ def test_tiff_palette():
 
     delta = np.abs(imgs.at(0).astype("float") - imgs.at(1).astype("float")) / 256
     assert np.quantile(delta, 0.9) < 0.05, "Original and palette TIFF differ significantly"
+
+
+@params((0, 0), (100, 100), (224, 224), (50, 300), (1000, 1000))
+def test_min_decoded_size(min_h, min_w):
+    data_path = os.path.join(test_data_root, good_path, "jpeg")
+
+    @pipeline_def(batch_size=8, device_id=0, num_threads=3)
+    def pipe():
+        encoded, _ = fn.readers.file(file_root=data_path, name="Reader")
+        peeked_shapes = fn.peek_image_shape(encoded)
+        decoded = fn.decoders.image(encoded, device="cpu", min_decoded_size=(min_h, min_w))
+        return decoded, peeked_shapes
+
+    p = pipe()
+    p.build()
+    for _ in range(math.ceil(p.epoch_size("Reader") / 8)):
+        imgs, peeked_shapes = p.run()
+        for img, orig_shape in zip(imgs, peeked_shapes):
+            h, w = np.array(orig_shape)[:2]
+            out_h, out_w = np.array(img).shape[:2]
+            # the largest downscaling ratio, for which the image is not smaller than requested
+            expected_ratio = 1
+            for ratio in [8, 4, 2]:
+                if math.ceil(h / ratio) >= min_h and math.ceil(w / ratio) >= min_w:
+                    expected_ratio = ratio
+                    break
+            assert (out_h, out_w) == (math.ceil(h / expected_ratio), math.ceil(w / expected_ratio))
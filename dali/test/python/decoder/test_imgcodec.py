@@ -551,3 +551,20 @@ def test_image_decoder_lossless_jpeg_cpu_not_supported():
     p.build()
 
     assert_raises(RuntimeError, p.run, glob="*Failed to decode*")
+
+
+@pipeline_def(batch_size=8, num_threads=3, device_id=0, prefetch_queue_depth=1)
+def peek_shape_decoder_pipe(data_path, device, peek_image_shape):
+    inputs, _ = fn.readers.file(file_root=data_path, peek_image_shape=peek_image_shape)
+    return fn.experimental.decoders.image(inputs, device=device, output_type=types.RGB)
+
+
+@params(*[(dev, img_type) for dev in ["cpu", "mixed"] for img_type in ["jpeg", "png", "tiff"]])
+def test_image_decoder_peek_shape_in_reader(device, img_type):
+    data_path = os.path.join(test_data_root, good_path, img_type)
+    compare_pipelines(
+        peek_shape_decoder_pipe(data_path, device, False),
+        peek_shape_decoder_pipe(data_path, device, True),
+        batch_size=8,
+        N_iterations=3,
+    )
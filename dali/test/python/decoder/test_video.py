@@ -1,4 +1,4 @@
-# Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -107,6 +107,67 @@ def test_video_decoder(device, module):
         assert np.array_equal(seq, ref_seq)
 
 
+@params(
+    (types.UINT8, "FCHW", None, None),
+    (types.FLOAT, "FHWC", None, None),
+    (types.FLOAT, "FCHW", [128.0], [64.0]),
+    (types.FLOAT16, "FCHW", [124.0, 116.0, 104.0], [58.0, 57.0, 57.0]),
+)
+def test_video_decoder_output_format(dtype, layout, mean, std):
+    skip_if_m60()
+    batch_size = 2
+    kwargs = {}
+    if mean is not None:
+        kwargs["mean"] = mean
+    if std is not None:
+        kwargs["std"] = std
+
+    @pipeline_def(batch_size=batch_size, num_threads=2, device_id=0)
+    def pipeline():
+        data = fn.external_source(source=video_loader(batch_size, 1), dtype=types.UINT8, ndim=1)
+        ref = fn.experimental.decoders.video(data, device="mixed")
+        out = fn.experimental.decoders.video(
+            data, device="mixed", dtype=dtype, output_layout=layout, **kwargs
+        )
+        return ref, out
+
+    pipe = pipeline()
+    pipe.build()
+    for _ in range(len(files) // batch_size):
+        ref, out = pipe.run()
+        ref, out = ref.as_cpu(), out.as_cpu()
+        for i in range(batch_size):
+            expected = np.array(ref[i]).astype(np.float32)
+            if layout == "FCHW":
+                expected = expected.transpose(0, 3, 1, 2)
+            if mean is not None:
+                expected = (expected - np.array(mean, dtype=np.float32).reshape(-1, 1, 1)) / (
+                    np.array(std, dtype=np.float32).reshape(-1, 1, 1)
+                )
+            actual = np.array(out[i])
+            assert actual.dtype == {
+                types.UINT8: np.uint8,
+                types.FLOAT16: np.float16,
+                types.FLOAT: np.float32,
+            }[dtype]
+            assert actual.shape == expected.shape
+            atol = 1e-2 if dtype == types.FLOAT16 else 1e-5
+            np.testing.assert_allclose(actual.astype(np.float32), expected, atol=atol)
+
+
+@params(("output_layout", "FCHW"), ("dtype", types.FLOAT), ("mean", [128.0]))
+def test_video_decoder_output_format_cpu(arg, value):
+    @pipeline_def(batch_size=1, num_threads=1, device_id=0)
+    def pipeline():
+        data = fn.external_source(source=video_loader(1, 1), dtype=types.UINT8, ndim=1)
+        return fn.experimental.decoders.video(data, device="cpu", **{arg: value})
+
+    with assert_raises(RuntimeError, glob="supported only by the mixed backend"):
+        pipe = pipeline()
+        pipe.build()
+        pipe.run()
+
+
 def test_full_range_video():
     skip_if_m60()
 
@@ -1,4 +1,4 @@
-# Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -70,3 +70,29 @@ def test_dali_sequential_tensors_to_jax_array():
                     np.int32,
                 ),
             )
+
+
+def test_dali_sequential_tensors_to_jax_array_no_copy():
+    batch_size = 4
+    shape = (1, 5)
+
+    # the dynamic executor doesn't reuse the output memory, so it can be shared
+    pipe = sequential_pipeline(batch_size, shape, experimental_exec_dynamic=True)
+    pipe.build()
+    pipe._enable_async_outputs()
+
+    jax_arrays = []
+    for batch_id in range(10):
+        # given
+        dali_tensor_gpu = pipe.run()[0].as_tensor()
+
+        # when
+        jax_arrays.append(dax.integration._to_jax_array(dali_tensor_gpu, copy=False))
+
+    # then - the arrays remain valid after DALI is done with the outputs
+    for batch_id, jax_array in enumerate(jax_arrays):
+        assert jax_array.device() == jax.devices()[0]
+        for i in range(batch_size):
+            assert jax.numpy.array_equal(
+                jax_array[i], jax.numpy.full(shape[1:], batch_id * batch_size + i, np.int32)
+            )
@@ -1,4 +1,4 @@
-# Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -64,3 +64,22 @@ def test_iterator_last_batch_policy_partial_exception():
     DALIGenericIterator(
         [pipe], ["data"], reader_name="reader", last_batch_policy=LastBatchPolicy.PARTIAL
     )
+
+
+def test_dali_sequential_iterator_async_outputs():
+    # given
+    pipe = pipeline_def(iterator_function_def)(
+        batch_size=batch_size, num_threads=4, device_id=0, experimental_exec_dynamic=True
+    )
+    iter = DALIGenericIterator(
+        [pipe], ["data"], reader_name="reader", experimental_async_outputs=True
+    )
+
+    # then
+    run_and_assert_sequential_iterator(iter)
+
+
+@raises(ValueError, glob="*requires the pipelines to be created with*exec_dynamic*")
+def test_iterator_async_outputs_require_dynamic_executor():
+    pipe = pipeline_def(iterator_function_def)(batch_size=batch_size, num_threads=4, device_id=0)
+    DALIGenericIterator([pipe], ["data"], reader_name="reader", experimental_async_outputs=True)
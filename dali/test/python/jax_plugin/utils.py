@@ -1,4 +1,4 @@
-# Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -49,12 +49,13 @@ def get_dali_tensor_gpu(value, shape, dtype, device_id=0) -> TensorGPU:
     return dali_output[0][0]
 
 
-def sequential_pipeline(batch_size, shape):
+def sequential_pipeline(batch_size, shape, **pipeline_kwargs):
     """Helper to create DALI pipelines that return GPU tensors with sequential values.
 
     Args:
         batch_size: Batch size for the pipeline.
         shape : Shape for the output tensor.
+        pipeline_kwargs : Additional arguments for the pipeline.
     """
 
     def numpy_sequential_tensors(sample_info):
@@ -68,7 +69,7 @@ def sequential_pipeline(batch_size, shape):
         data = data[0].gpu()
         return data
 
-    return sequential_pipeline_def()
+    return sequential_pipeline_def(**pipeline_kwargs)
 
 
 def pipeline_with_variable_shape_output(batch_size):
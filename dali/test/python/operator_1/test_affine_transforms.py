@@ -878,3 +878,88 @@ def test_rotate_shape_mismatch():
         pipe = pipeline(batch_size=batch_size, num_threads=4, device_id=0)
         pipe.build()
         pipe.run()
+
+
+def check_transform_gpu_vs_cpu(transform_fn, kwargs, ndim, has_input, reverse_order, batch_size):
+    @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0, seed=1234)
+    def pipe():
+        args = {name: arg() if callable(arg) else arg for name, arg in kwargs.items()}
+        if has_input:
+            T0 = fn.random.uniform(range=(-1, 1), shape=(ndim, ndim + 1))
+            T_cpu = transform_fn(T0, **args, reverse_order=reverse_order)
+            T_gpu = transform_fn(T0.gpu(), **args, reverse_order=reverse_order, device="gpu")
+        else:
+            T_cpu = transform_fn(**args)
+            T_gpu = transform_fn(**args, device="gpu")
+        return T_cpu, T_gpu
+
+    p = pipe()
+    p.build()
+    for _ in range(3):
+        T_cpu, T_gpu = p.run()
+        T_gpu = T_gpu.as_cpu()
+        for idx in range(batch_size):
+            assert np.allclose(T_cpu.at(idx), T_gpu.at(idx), atol=1e-5)
+
+
+def test_transforms_gpu_vs_cpu():
+    def random_angle():
+        return fn.random.uniform(range=(-180, 180))
+
+    def random_vec(ndim):
+        return lambda: fn.random.uniform(range=(-10, 10), shape=(ndim,))
+
+    for ndim in [2, 3]:
+        cases = [
+            (fn.transforms.translation, {"offset": random_vec(ndim)}),
+            (fn.transforms.translation, {"offset": [1.0] * ndim}),
+            (fn.transforms.scale, {"scale": random_vec(ndim), "center": [2.0] * ndim}),
+            (fn.transforms.shear, {"angles": [10.0] * (ndim * (ndim - 1))}),
+            (
+                fn.transforms.crop,
+                {"from_start": [0.5] * ndim, "to_start": random_vec(ndim), "to_end": [1.0] * ndim},
+            ),
+        ]
+        if ndim == 2:
+            cases.append((fn.transforms.rotation, {"angle": random_angle, "center": (1.0, 2.0)}))
+        else:
+            cases.append((fn.transforms.rotation, {"angle": random_angle, "axis": (1.0, 0.0, 1.0)}))
+        for transform_fn, kwargs in cases:
+            for has_input in [False, True]:
+                for reverse_order in [False, True] if has_input else [False]:
+                    yield (
+                        check_transform_gpu_vs_cpu,
+                        transform_fn,
+                        kwargs,
+                        ndim,
+                        has_input,
+                        reverse_order,
+                        5,
+                    )
+
+
+def check_combine_transforms_gpu_vs_cpu(num_transforms, ndim, reverse_order, batch_size):
+    @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0, seed=1234)
+    def pipe():
+        transforms = [
+            fn.random.uniform(range=(-1, 1), shape=(ndim, ndim + 1)) for _ in range(num_transforms)
+        ]
+        T_cpu = fn.transforms.combine(*transforms, reverse_order=reverse_order)
+        T_gpu = fn.transforms.combine(
+            *[t.gpu() for t in transforms], reverse_order=reverse_order, device="gpu"
+        )
+        return T_cpu, T_gpu
+
+    p = pipe()
+    p.build()
+    T_cpu, T_gpu = p.run()
+    T_gpu = T_gpu.as_cpu()
+    for idx in range(batch_size):
+        assert np.allclose(T_cpu.at(idx), T_gpu.at(idx), atol=1e-5)
+
+
+def test_combine_transforms_gpu_vs_cpu():
+    for num_transforms in [2, 3, 10]:
+        for ndim in [2, 3, 6]:
+            for reverse_order in [False, True]:
+                yield check_combine_transforms_gpu_vs_cpu, num_transforms, ndim, reverse_order, 5
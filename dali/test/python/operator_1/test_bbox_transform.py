@@ -0,0 +1,103 @@
+# Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+import nvidia.dali.fn as fn
+import nvidia.dali.types as types
+from nvidia.dali import pipeline_def
+from nose2.tools import params
+from nose_utils import assert_raises
+
+batch_size = 8
+
+
+def random_boxes(ltrb):
+    rng = np.random.default_rng(1234)
+
+    def gen():
+        batch = []
+        for _ in range(batch_size):
+            n = rng.integers(0, 20)
+            lo = rng.uniform(0, 0.5, size=(n, 2))
+            size = rng.uniform(0, 0.5, size=(n, 2))
+            hi = lo + size if ltrb else size
+            batch.append(np.concatenate([lo, hi], axis=1).astype(np.float32))
+        return batch
+
+    return gen
+
+
+@pipeline_def(batch_size=batch_size, num_threads=4, device_id=0, seed=42)
+def box_chain_pipe(device, ltrb):
+    boxes = fn.external_source(source=random_boxes(ltrb), batch=True, cycle=False)
+    boxes = boxes.gpu() if device == "gpu" else boxes
+    flip = fn.random.coin_flip()
+    ratio = fn.random.uniform(range=(1, 3))
+    paste_x = fn.random.uniform(range=(0, 1))
+    paste_y = fn.random.uniform(range=(0, 1))
+
+    # the reference: a chain of dedicated operators
+    ref = fn.bb_flip(boxes, horizontal=flip, ltrb=ltrb)
+    ref = fn.bbox_paste(ref.cpu(), ratio=ratio, paste_x=paste_x, paste_y=paste_y, ltrb=ltrb)
+
+    # the same chain, as one transform
+    sign = 1 - 2 * fn.cast(flip, dtype=types.FLOAT)
+    flip_mt = fn.transforms.scale(scale=fn.stack(sign, fn.ones_like(sign)), center=[0.5, 0.5])
+    scale = 1 / ratio
+    offset = fn.stack(paste_x, paste_y) * (ratio - 1) / ratio
+    paste_mt = fn.transforms.combine(
+        fn.transforms.scale(scale=fn.stack(scale, scale)), fn.transforms.translation(offset=offset)
+    )
+    mt = fn.transforms.combine(flip_mt, paste_mt)
+    out = fn.bbox_transform(boxes, MT=mt, ltrb=ltrb)
+    return ref, out
+
+
+@params(("cpu", False), ("cpu", True), ("gpu", False), ("gpu", True))
+def test_bbox_transform_chain(device, ltrb):
+    pipe = box_chain_pipe(device, ltrb)
+    pipe.build()
+    ref, out = pipe.run()
+    if device == "gpu":
+        out = out.as_cpu()
+    for i in range(batch_size):
+        np.testing.assert_allclose(np.array(out[i]), np.array(ref[i]), atol=1e-6)
+
+
+@params("cpu", "gpu")
+def test_bbox_transform_clip(device):
+    @pipeline_def(batch_size=1, num_threads=1, device_id=0)
+    def pipe():
+        boxes = types.Constant(np.array([[0.1, 0.2, 0.3, 0.6]], dtype=np.float32), device=device)
+        # crop the window [0.2, 0.2] - [0.7, 0.7]
+        return fn.bbox_transform(boxes, M=2.0, T=[-0.4, -0.4], ltrb=True, clip=True)
+
+    p = pipe()
+    p.build()
+    (out,) = p.run()
+    if device == "gpu":
+        out = out.as_cpu()
+    np.testing.assert_allclose(np.array(out[0]), [[0.0, 0.0, 0.2, 0.8]], atol=1e-6)
+
+
+def test_bbox_transform_wrong_shape():
+    @pipeline_def(batch_size=1, num_threads=1, device_id=0)
+    def pipe():
+        boxes = types.Constant(np.zeros((3, 5), dtype=np.float32), device="cpu")
+        return fn.bbox_transform(boxes, M=2.0)
+
+    p = pipe()
+    p.build()
+    with assert_raises(RuntimeError, glob="innermost dimension*extent of 4"):
+        p.run()
@@ -0,0 +1,62 @@
+# Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+from nose2.tools import params
+from nvidia.dali import fn, pipeline_def
+
+
+def random_ltrb(rng, n):
+    lt = rng.uniform(0, 0.9, size=(n, 2))
+    wh = rng.uniform(0.01, 0.3, size=(n, 2))
+    return np.concatenate([lt, np.minimum(lt + wh, 1)], axis=1).astype(np.float32)
+
+
+@params(
+    (1000, 10, False),
+    (20000, 300, False),
+    (20000, 300, True),
+    (5000, 0, True),
+)
+def test_box_encoder_cpu_vs_gpu(num_anchors, max_boxes, offset):
+    batch_size = 4
+    rng = np.random.default_rng(1234)
+    anchors = random_ltrb(rng, num_anchors)
+
+    def get_data():
+        boxes, labels = [], []
+        for _ in range(batch_size):
+            n = rng.integers(0, max_boxes + 1)
+            boxes.append(random_ltrb(rng, n))
+            labels.append(rng.integers(1, 100, size=(n,), dtype=np.int32))
+        return boxes, labels
+
+    @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0)
+    def pipe():
+        boxes, labels = fn.external_source(source=get_data, num_outputs=2)
+        args = dict(criteria=0.5, anchors=anchors.flatten().tolist(), offset=offset)
+        cpu_boxes, cpu_labels = fn.box_encoder(boxes, labels, **args)
+        gpu_boxes, gpu_labels = fn.box_encoder(boxes.gpu(), labels.gpu(), **args)
+        return cpu_boxes, cpu_labels, gpu_boxes, gpu_labels
+
+    p = pipe()
+    p.build()
+    for _ in range(3):
+        cpu_boxes, cpu_labels, gpu_boxes, gpu_labels = p.run()
+        gpu_boxes, gpu_labels = gpu_boxes.as_cpu(), gpu_labels.as_cpu()
+        for i in range(batch_size):
+            np.testing.assert_array_equal(np.array(cpu_labels[i]), np.array(gpu_labels[i]))
+            np.testing.assert_allclose(
+                np.array(cpu_boxes[i]), np.array(gpu_boxes[i]), rtol=1e-5, atol=1e-5
+            )
@@ -1,4 +1,4 @@
-# Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -282,3 +282,33 @@ def test_video():
     ]
 
     yield from video_suite_helper(video_test_cases, test_channel_first=False)
+
+
+@pipeline_def(num_threads=4, device_id=0, seed=1234)
+def random_args_pipe(dev, random_args, op_seed=42):
+    inp = fn.external_source(
+        source=lambda: [np.full((4, 4, 3), 0.5, dtype=np.float32)] * 7, batch=True
+    )
+    if dev == "gpu":
+        inp = inp.gpu()
+    return fn.brightness_contrast(inp, random_args=random_args, seed=op_seed)
+
+
+def test_random_args_cpu_vs_gpu():
+    random_args = ["brightness=uniform(0.5, 1.5)", "contrast=normal(1, 0.2)"]
+    pipe_cpu = random_args_pipe("cpu", random_args, batch_size=7)
+    pipe_gpu = random_args_pipe("gpu", random_args, batch_size=7)
+    compare_pipelines(pipe_cpu, pipe_gpu, batch_size=7, N_iterations=3, eps=1e-5)
+
+
+def test_random_args_values():
+    pipe = random_args_pipe("cpu", ["brightness=choice(0, 2)"], batch_size=7)
+    pipe.build()
+    outputs = []
+    for _ in range(5):
+        (out,) = pipe.run()
+        for sample in out:
+            value = np.array(sample)[0, 0, 0]
+            assert value == 0 or value == 1, value
+            outputs.append(value)
+    assert 0 in outputs and 1 in outputs
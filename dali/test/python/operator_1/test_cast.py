@@ -1,4 +1,4 @@
-# Copyright (c) 2019-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2019-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -18,6 +18,7 @@ import nvidia.dali.types as types
 from nose.tools import nottest
 from nvidia.dali import pipeline_def
 from test_utils import np_type_to_dali
+from nose_utils import assert_raises
 import itertools
 from nose2.tools import params
 
@@ -236,3 +237,79 @@ def test_cast_like(devices, dtype_in, dtype_out):
     (out,) = p.run()
     expected_type = np_type_to_dali(dtype_out)
     assert out.dtype == expected_type, f"{out.dtype} != {expected_type}"
+
+
+@params("cpu", "gpu")
+def test_cast_same_type_copy_on_write(device):
+    # The cast to the same type passes the input through; the buffer, which is also a pipeline
+    # output, must not be reused by the consumer which can compute its output in place.
+    @pipeline_def(batch_size=4, num_threads=4, device_id=0, exec_dynamic=True)
+    def pipe():
+        x = fn.random.uniform(range=[0, 100], shape=[10], dtype=types.FLOAT, device=device)
+        same = fn.cast(x, dtype=types.FLOAT)
+        converted = fn.cast(same, dtype=types.INT32)
+        return x, converted
+
+    p = pipe()
+    p.build()
+    for _ in range(3):
+        x, converted = tuple(out.as_cpu() if device == "gpu" else out for out in p.run())
+        for i in range(len(x)):
+            x_i = np.array(x[i])
+            assert np.all((x_i >= 0) & (x_i <= 100)), "The input was modified"
+            assert np.array_equal(np.array(converted[i]), ref_cast(x_i, np.int32))
+
+
+@params(
+    *itertools.product(
+        ("cpu", "gpu"),
+        (np.uint8, np.int16, np.float32),
+        ((np.float32, np.uint8), (np.float16, np.int32, np.uint16)),
+    )
+)
+def test_multi_cast(device, in_dtype, out_dtypes):
+    batch_size = 5
+
+    def src():
+        return generate(rng, 3, batch_size, in_dtype, out_dtypes[-1], None)
+
+    @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0)
+    def pipe():
+        inp = fn.external_source(src)
+        inp_dev = inp.gpu() if device == "gpu" else inp
+        dtypes = [np_type_to_dali(t) for t in out_dtypes]
+        plain = fn.experimental.multi_cast(inp_dev, dtypes=dtypes)
+        scaled = fn.experimental.multi_cast(inp_dev, dtypes=dtypes, scale=0.25, shift=-10.5)
+        return (inp, *plain, *scaled)
+
+    p = pipe()
+    p.build()
+    n = len(out_dtypes)
+    for _ in range(3):
+        inp, *outs = tuple(out.as_cpu() if device == "gpu" else out for out in p.run())
+        for i in range(batch_size):
+            x = np.array(inp[i])
+            # avoid comparing the values which are exactly halfway after scaling
+            y = x.astype(np.float32) * np.float32(0.25) + np.float32(-10.5)
+            mask = y - np.floor(y) != 0.5
+            for k, dtype in enumerate(out_dtypes):
+                plain, scaled = np.array(outs[k][i]), np.array(outs[n + k][i])
+                assert plain.dtype == dtype and scaled.dtype == dtype
+                assert np.array_equal(plain, ref_cast(x, dtype))
+                if np.issubdtype(dtype, np.floating):
+                    # the device code may use fused multiply-add
+                    np.testing.assert_allclose(scaled, ref_cast(y, dtype), rtol=1e-3)
+                else:
+                    np.testing.assert_array_equal(scaled[mask], ref_cast(y, dtype)[mask])
+
+
+def test_multi_cast_wrong_scale():
+    @pipeline_def(batch_size=1, num_threads=1, device_id=types.CPU_ONLY_DEVICE_ID)
+    def pipe():
+        x = fn.random.uniform(range=[0, 1], shape=[10])
+        return fn.experimental.multi_cast(x, dtypes=[types.UINT8, types.INT16], scale=[1, 2, 3])
+
+    with assert_raises(RuntimeError, glob="must have one value or one value per output type"):
+        p = pipe()
+        p.build()
+        p.run()
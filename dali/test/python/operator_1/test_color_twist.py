@@ -1,4 +1,4 @@
-# Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -221,3 +221,33 @@ def test_color_twist_default_dtype():
         for type in np_types:
             for op in [fn.hue]:
                 yield impl, op, device, type
+
+
+def test_color_chain_fusion():
+    # Consecutive color operators with float intermediate results are merged into a single
+    # transform - it should produce the same results as the operators applied one by one.
+    batch_size = 8
+
+    @pipeline_def(batch_size=batch_size, num_threads=3, device_id=0, seed=1234)
+    def pipeline(preserve):
+        data = fn.random.uniform(range=[0, 255], shape=(20, 30, 3)).gpu()
+        data = fn.cast(data, dtype=types.UINT8)
+        hue = fn.random.uniform(range=[-20, 20])
+        out = fn.hue(data, hue=hue, dtype=types.FLOAT, preserve=preserve)
+        out = fn.hsv(out, saturation=0.7, value=1.2, dtype=types.FLOAT, preserve=preserve)
+        out = fn.brightness_contrast(
+            out, brightness=fn.random.uniform(range=[0.5, 1.5]), contrast=1.3, dtype=types.FLOAT
+        )
+        return out
+
+    fused = pipeline(preserve=False)
+    reference = pipeline(preserve=True)
+    fused.build()
+    reference.build()
+    for _ in range(2):
+        (out,) = fused.run()
+        (ref,) = reference.run()
+        for i in range(batch_size):
+            np.testing.assert_allclose(
+                np.array(out[i].as_cpu()), np.array(ref[i].as_cpu()), rtol=1e-4, atol=1e-2
+            )
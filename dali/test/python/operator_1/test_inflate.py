@@ -27,6 +27,24 @@ def sample_to_lz4(sample):
     return np.frombuffer(deflated_buf, dtype=np.uint8)
 
 
+def sample_to_deflate(sample):
+    import zlib
+
+    # raw deflate stream, without the zlib header
+    compressor = zlib.compressobj(wbits=-15)
+    deflated_buf = compressor.compress(sample) + compressor.flush()
+    return np.frombuffer(deflated_buf, dtype=np.uint8)
+
+
+compressors = {"LZ4": sample_to_lz4, "DEFLATE": sample_to_deflate}
+
+
+def sample_to_blocks(sample, block_size, compress):
+    buf = sample.tobytes()
+    blocks = [compress(buf[i : i + block_size]) for i in range(0, len(buf), block_size)]
+    return np.concatenate(blocks), np.array([len(block) for block in blocks], dtype=np.int32)
+
+
 def check_batch(inflated, baseline, batch_size, layout=None, oversized_shape=False):
     layout = layout or ""
     assert inflated.layout() == layout, (
@@ -309,6 +327,74 @@ def test_total_no_chunks(ex_kwargs):
         check_batch(inflated, [baseline] * batch_size, batch_size, layout="FHWC")
 
 
+@has_operator("experimental.inflate")
+@restrict_platform(min_compute_cap=6.0, platforms=["x86_64"])
+@params("LZ4", "DEFLATE")
+def test_algorithm(algorithm):
+    shape = (31, 101, 3)
+
+    def sample_source(sample_info):
+        x = sample_info.idx_in_epoch + 1
+        return (np.arange(0, np.prod(shape), dtype=np.uint16).reshape(shape) * x) % 1000
+
+    def deflated_source(sample_info):
+        return compressors[algorithm](sample_source(sample_info))
+
+    @pipeline_def
+    def pipeline():
+        baseline = fn.external_source(source=sample_source, batch=False)
+        deflated = fn.external_source(source=deflated_source, batch=False, device="gpu")
+        inflated = fn.experimental.inflate(
+            deflated, shape=shape, dtype=types.UINT16, layout="HWC", algorithm=algorithm
+        )
+        return inflated, baseline
+
+    batch_size = 8
+    pipe = pipeline(batch_size=batch_size, num_threads=4, device_id=0)
+    pipe.build()
+    for _ in range(2):
+        inflated, baseline = pipe.run()
+        check_batch(inflated, baseline, batch_size, "HWC")
+
+
+@has_operator("experimental.inflate")
+@restrict_platform(min_compute_cap=6.0, platforms=["x86_64"])
+@params(("LZ4", 1024), ("LZ4", 1000), ("LZ4", 1 << 20), ("DEFLATE", 4096))
+def test_blocks(algorithm, block_size):
+    shape = (97, 33)
+
+    def sample_source(sample_info):
+        x = sample_info.idx_in_epoch + 1
+        return np.arange(0, np.prod(shape), dtype=np.float32).reshape(shape) * x
+
+    def deflated_source(sample_info):
+        return sample_to_blocks(sample_source(sample_info), block_size, compressors[algorithm])
+
+    @pipeline_def
+    def pipeline():
+        baseline = fn.external_source(source=sample_source, batch=False)
+        deflated, block_sizes = fn.external_source(
+            source=deflated_source, batch=False, num_outputs=2
+        )
+        inflated = fn.experimental.inflate(
+            deflated.gpu(),
+            shape=shape,
+            dtype=types.FLOAT,
+            layout="HW",
+            chunk_sizes=block_sizes,
+            block_size=block_size,
+            algorithm=algorithm,
+        )
+        return inflated, baseline
+
+    batch_size = 8
+    pipe = pipeline(batch_size=batch_size, num_threads=4, device_id=0)
+    pipe.build()
+    for _ in range(2):
+        inflated, baseline = pipe.run()
+        check_batch(inflated, baseline, batch_size, "HW")
+
+
 def _test_validation(pipeline, error_glob, kwargs=None):
     with assert_raises(RuntimeError, glob=error_glob):
         pipe = pipeline(batch_size=4, num_threads=4, device_id=0, **(kwargs or {}))
@@ -447,6 +533,22 @@ def test_validation():
         inflated = fn.experimental.inflate(inp.gpu(), shape=5, sequence_axis_name="AB")
         return inflated
 
+    @pipeline_def
+    def pipeline_blocks_no_chunks():
+        inp = fn.external_source(
+            source=lambda: np.array([1, 2, 3, 4, 5], dtype=np.uint8), batch=False
+        )
+        inflated = fn.experimental.inflate(inp.gpu(), shape=5, block_size=4)
+        return inflated
+
+    @pipeline_def
+    def pipeline_blocks_mismatched():
+        inp = fn.external_source(
+            source=lambda: np.array([1, 2, 3, 4, 5], dtype=np.uint8), batch=False
+        )
+        inflated = fn.experimental.inflate(inp.gpu(), shape=9, block_size=4, chunk_sizes=[2, 3])
+        return inflated
+
     yield (
         _test_validation,
         pipeline_2d_shape,
@@ -503,3 +605,13 @@ def test_validation():
         pipeline_sequence_axis_too_long_name,
         'The `sequence_axis_name` must be a single character, got "AB"',
     )
+    yield (
+        _test_validation,
+        pipeline_blocks_no_chunks,
+        "The `block_size` requires the blocks to be described*",
+    )
+    yield (
+        _test_validation,
+        pipeline_blocks_mismatched,
+        "*requires 3 blocks. Got 2 blocks.",
+    )
@@ -128,11 +128,13 @@ def anchor_src(bs, seed):
     ("dilate", 32, "HWC", np.uint16, 1, 5, "reflect"),
     ("dilate", 4, "FHWC", np.float32, 3, 5, "reflect_101"),
     ("dilate", 4, "FCHW", np.uint8, 4, 9, "replicate"),
+    ("dilate", 32, "HWC", np.uint8, 4, 6, "reflect_101"),
     ("erode", 32, "HWC", np.uint8, 3, 9, "constant"),
     ("erode", 32, "CHW", np.float32, 1, 4, "constant"),
     ("erode", 32, "HWC", np.uint16, 1, 5, "reflect"),
     ("erode", 4, "FHWC", np.float32, 3, 5, "reflect_101"),
     ("erode", 4, "FCHW", np.uint8, 4, 9, "replicate"),
+    ("erode", 32, "HWC", np.uint16, 2, 6, "replicate"),
 )
 def test_dilate_vs_ocv(morph_type, bs, layout, dtype, channels, max_ksize, border_mode):
     cdim = layout.find("C")
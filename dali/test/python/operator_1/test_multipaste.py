@@ -963,3 +963,59 @@ def test_var_channels(device, use_positional):
             out_sizes,
             types.UINT8,
         )
+
+
+@params((types.UINT8, True), (types.FLOAT, True), (types.FLOAT, False))
+def test_mosaic(out_dtype, full_cover):
+    # Non-overlapping tiles - the GPU operator copies the regions directly (and zeroes the
+    # uncovered part of the output, if any), which must match the CPU operator
+    batch_size = 8
+    tile = (50, 70)
+    rng = np.random.default_rng(321)
+
+    def get_images():
+        return [rng.integers(0, 256, size=(100, 120, 3), dtype=np.uint8) for _ in range(batch_size)]
+
+    num_tiles = 4 if full_cover else 3
+
+    def get_in_ids():
+        return [np.int32(rng.permutation(batch_size)[:num_tiles]) for _ in range(batch_size)]
+
+    out_anchors = np.array([[0, 0], [0, tile[1]], [tile[0], 0], [tile[0], tile[1]]], np.int32)
+    in_anchors = np.array([[0, 0], [10, 5], [20, 30], [50, 50]], np.int32)
+    shapes = np.array([tile] * num_tiles, np.int32)
+
+    @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0)
+    def pipeline():
+        images, in_ids = fn.external_source(
+            source=lambda: (get_images(), get_in_ids()), num_outputs=2
+        )
+        cpu = fn.multi_paste(
+            images,
+            in_ids=in_ids,
+            in_anchors=in_anchors[:num_tiles],
+            out_anchors=out_anchors[:num_tiles],
+            shapes=shapes,
+            output_size=[2 * tile[0], 2 * tile[1]],
+            dtype=out_dtype,
+        )
+        gpu = fn.multi_paste(
+            images.gpu(),
+            in_ids=in_ids,
+            in_anchors=in_anchors[:num_tiles],
+            out_anchors=out_anchors[:num_tiles],
+            shapes=shapes,
+            output_size=[2 * tile[0], 2 * tile[1]],
+            dtype=out_dtype,
+        )
+        return cpu, gpu
+
+    p = pipeline()
+    p.build()
+    for _ in range(2):
+        cpu, gpu = p.run()
+        gpu = gpu.as_cpu()
+        for i in range(batch_size):
+            np.testing.assert_array_equal(np.array(cpu[i]), np.array(gpu[i]))
+            if not full_cover:
+                assert np.all(np.array(gpu[i])[tile[0]:, tile[1]:] == 0)
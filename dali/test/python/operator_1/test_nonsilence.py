@@ -1,4 +1,4 @@
-# Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2020-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -170,3 +170,40 @@ def test_cpu_vs_gpu():
 
             np.testing.assert_array_equal(begin_cpu, begin_gpu)
             np.testing.assert_array_equal(len_cpu, len_gpu)
+
+
+def test_cpu_vs_gpu_long_signals():
+    # the signals span many GPU blocks; the bursts can fall at block boundaries
+    batch_size = 6
+    rng = np.random.default_rng(1234)
+
+    def gen():
+        batch = []
+        for i in range(batch_size):
+            length = rng.integers(100000, 300000)
+            x = np.zeros([length], dtype=np.int16)
+            for _ in range(i):  # the first sample is silent
+                start = rng.integers(0, length - 100)
+                x[start : start + rng.integers(1, 100)] = rng.integers(-5000, 5000)
+            batch.append(x)
+        return batch
+
+    @pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+    def pipe():
+        audio = fn.external_source(gen)
+        outs = []
+        for reference_power in [None, 1e3]:
+            for dev_audio in [audio, audio.gpu()]:
+                outs += fn.nonsilent_region(
+                    dev_audio, cutoff_db=-40, window_length=512, reference_power=reference_power
+                )
+        return tuple(outs)
+
+    p = pipe()
+    p.build()
+    for _ in range(2):
+        outs = [test_utils.to_array(o) for o in p.run()]
+        for k in range(0, len(outs), 4):
+            begin_cpu, len_cpu, begin_gpu, len_gpu = outs[k : k + 4]
+            np.testing.assert_array_equal(begin_cpu, begin_gpu)
+            np.testing.assert_array_equal(len_cpu, len_gpu)
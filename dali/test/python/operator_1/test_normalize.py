@@ -1,4 +1,4 @@
-# Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -517,3 +517,37 @@ def test_batch_of_empty_samples(device):
     p = pipeline(batch_size=4, device_id=0, num_threads=4)
     p.build()
     p.run()
+
+
+@params("cpu", "gpu")
+def test_running_stats(device):
+    batch_size = 5
+    num_iters = 4
+    rng = np.random.default_rng(1234)
+    batches = [
+        [
+            rng.normal(1000, 3, size=(rng.integers(1, 20), 3)).astype(np.float32)
+            for _ in range(batch_size)
+        ]
+        for _ in range(num_iters)
+    ]
+
+    @pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+    def pipeline():
+        data = fn.external_source(source=batches, cycle=False, layout="XC")
+        if device == "gpu":
+            data = data.gpu()
+        return fn.normalize(data, axes=0, running_stats=True)
+
+    p = pipeline()
+    p.build()
+    seen = []
+    for batch in batches:
+        (out,) = p.run()
+        out = to_list(out)
+        seen += batch
+        everything = np.concatenate(seen, axis=0).astype(np.float64)
+        mean = everything.mean(axis=0, keepdims=True)
+        stddev = everything.std(axis=0, keepdims=True)
+        ref = [(x - mean) / stddev for x in batch]
+        check_float(out, ref)
@@ -0,0 +1,83 @@
+# Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+import nvidia.dali.fn as fn
+import nvidia.dali.types as types
+from nvidia.dali import pipeline_def
+from nose2.tools import params
+from nose_utils import assert_raises
+from test_utils import as_array
+
+batch_size = 8
+rng = np.random.default_rng(1234)
+
+
+def random_masks(shapes, dtype):
+    def source():
+        return [
+            (rng.random(shapes[i % len(shapes)]) < 0.3).astype(dtype) for i in range(batch_size)
+        ]
+
+    return source
+
+
+@params(
+    *[
+        (device, dtype, shapes)
+        for device in ["cpu", "gpu"]
+        for dtype in [np.bool_, np.uint8, np.int32, np.float32]
+        for shapes in [[(16,), (13,), (0,), (1,)], [(7, 9), (3, 0), (5, 16)], [(4, 5, 33)]]
+    ]
+)
+def test_pack_unpack(device, dtype, shapes):
+    @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0)
+    def pipe():
+        data = fn.external_source(source=random_masks(shapes, dtype), device=device)
+        packed = fn.experimental.pack_bits(data)
+        unpacked = fn.experimental.unpack_bits(packed)
+        count = min(shape[-1] for shape in shapes)
+        trimmed = fn.experimental.unpack_bits(packed, count=count, dtype=types.BOOL)
+        return data, packed, unpacked, trimmed
+
+    p = pipe()
+    p.build()
+    for _ in range(2):
+        data, packed, unpacked, trimmed = [as_array_list(out) for out in p.run()]
+        for i in range(batch_size):
+            ref = np.packbits(data[i] != 0, axis=-1)
+            np.testing.assert_array_equal(packed[i], ref)
+            ref_unpacked = np.unpackbits(ref, axis=-1)
+            assert unpacked[i].dtype == np.uint8
+            np.testing.assert_array_equal(unpacked[i], ref_unpacked)
+            assert trimmed[i].dtype == np.bool_
+            count = min(shape[-1] for shape in shapes)
+            np.testing.assert_array_equal(trimmed[i], data[i][..., :count] != 0)
+
+
+def as_array_list(out):
+    return [as_array(out[i]) for i in range(len(out))]
+
+
+@params("cpu", "gpu")
+def test_unpack_bits_count_too_large(device):
+    @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0)
+    def pipe():
+        data = fn.external_source(source=random_masks([(3, 2)], np.uint8), device=device)
+        return fn.experimental.unpack_bits(data, count=17)
+
+    p = pipe()
+    p.build()
+    with assert_raises(RuntimeError, glob="cannot unpack 17 elements"):
+        p.run()
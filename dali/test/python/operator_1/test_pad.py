@@ -1,4 +1,4 @@
-# Copyright (c) 2019-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -27,6 +27,7 @@ from test_utils import (
     generator_random_axes_for_3d_input,
     generator_random_data,
     as_array,
+    dali_type_to_np,
 )
 
 
@@ -384,3 +385,64 @@ def test_wrong_axes():
     for device in ["cpu", "gpu"]:
         for wrong_axes_range in [(-10, -4), (3, 10)]:
             yield check_pad_wrong_axes, device, wrong_axes_range
+
+
+def check_pad_fused_normalize(device, in_dtype, out_dtype, mean, stddev):
+    batch_size = 6
+    fill_value = -1
+    data_gen = generator_random_data(
+        batch_size, min_sh=(5, 3), max_sh=(40, 3), dtype=in_dtype, val_range=[0, 100]
+    )
+
+    @pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+    def make_pipe():
+        data = fn.external_source(source=data_gen, layout="XC")
+        if device == "gpu":
+            data = data.gpu()
+        padded = fn.pad(
+            data, axes=(0,), fill_value=fill_value, dtype=out_dtype, mean=mean, stddev=stddev
+        )
+        return data, padded
+
+    pipe = make_pipe()
+    pipe.build()
+    np_out_type = dali_type_to_np(out_dtype)
+    for _ in range(3):
+        data, padded = pipe.run()
+        max_len = max(as_array(data[i]).shape[0] for i in range(batch_size))
+        for i in range(batch_size):
+            x = as_array(data[i])
+            out = as_array(padded[i])
+            assert out.dtype == np_out_type
+            assert out.shape == (max_len, 3)
+            ref = (x.astype(np.float64) - np.float64(mean)) / np.float64(stddev)
+            # integer outputs are rounded, float16 has limited precision
+            atol = 1 if np.issubdtype(np_out_type, np.integer) else 1e-3
+            rtol = 1e-2 if np_out_type == np.float16 else 1e-5
+            np.testing.assert_allclose(out[: x.shape[0]], ref, atol=atol, rtol=rtol)
+            np.testing.assert_array_equal(out[x.shape[0] :], fill_value)
+
+
+def test_pad_fused_normalize():
+    for device in ["cpu", "gpu"]:
+        for in_dtype, out_dtype in [
+            (np.uint8, types.FLOAT),
+            (np.int16, types.FLOAT16),
+            (np.int32, types.INT64),
+            (np.float32, types.FLOAT),
+        ]:
+            for mean, stddev in [(10.0, 4.0), ([1.0, 2.0, 3.0], [1.0, 2.0, 0.5])]:
+                yield check_pad_fused_normalize, device, in_dtype, out_dtype, mean, stddev
+
+
+def test_pad_dtype_only():
+    @pipeline_def(batch_size=2, num_threads=1, device_id=0)
+    def make_pipe():
+        data = types.Constant(np.array([1, 2, 3], dtype=np.int32), device="cpu")
+        return fn.pad(data, shape=(5,), fill_value=7, dtype=types.INT64)
+
+    pipe = make_pipe()
+    pipe.build()
+    (out,) = pipe.run()
+    for i in range(2):
+        np.testing.assert_array_equal(as_array(out[i]), np.array([1, 2, 3, 7, 7], dtype=np.int64))
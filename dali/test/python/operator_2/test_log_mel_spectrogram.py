@@ -0,0 +1,174 @@
+# Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+import nvidia.dali.fn as fn
+import nvidia.dali.types as types
+from nvidia.dali import pipeline_def
+from nose2.tools import params
+from nose_utils import assert_raises
+from test_utils import check_batch
+
+batch_size = 8
+
+
+def audio_source(min_len=1000, max_len=20000, seed=42):
+    rng = np.random.default_rng(seed)
+
+    def gen():
+        while True:
+            lengths = rng.integers(min_len, max_len, size=batch_size)
+            t = [np.arange(n, dtype=np.float32) for n in lengths]
+            f = rng.uniform(50, 4000, size=batch_size)
+            yield [
+                (np.sin(2 * np.pi * f[i] / 16000 * t[i]) + 0.1 * rng.standard_normal(len(t[i])))
+                .astype(np.float32)
+                for i in range(batch_size)
+            ]
+
+    return gen()
+
+
+@pipeline_def(batch_size=batch_size, num_threads=4, device_id=None)
+def log_mel_pipe(
+    sample_rate,
+    resample_rate,
+    preemph_coeff,
+    border,
+    feature_normalization,
+    layout,
+    **kwargs,
+):
+    data = fn.external_source(source=audio_source(), batch=True)
+    fused = fn.experimental.log_mel_spectrogram(
+        data,
+        sample_rate=sample_rate,
+        resample_rate=resample_rate,
+        preemph_coeff=preemph_coeff,
+        border=border,
+        feature_normalization=feature_normalization,
+        layout=layout,
+        **kwargs,
+    )
+
+    spectrogram_keys = [
+        "nfft",
+        "window_length",
+        "window_step",
+        "window_fn",
+        "power",
+        "center_windows",
+        "reflect_padding",
+    ]
+    mel_keys = ["nfilter", "freq_low", "freq_high", "normalize", "mel_formula"]
+    db_keys = ["multiplier", "reference", "cutoff_db"]
+
+    def select(keys):
+        return {k: v for k, v in kwargs.items() if k in keys}
+
+    signal = data
+    rate = sample_rate
+    if resample_rate is not None:
+        signal = fn.audio_resample(signal, in_rate=sample_rate, out_rate=resample_rate)
+        rate = resample_rate
+    signal = fn.preemphasis_filter(signal, preemph_coeff=preemph_coeff, border=border)
+    spectrum = fn.spectrogram(signal, layout=layout, **select(spectrogram_keys))
+    mel = fn.mel_filter_bank(spectrum, sample_rate=rate, **select(mel_keys))
+    ref = fn.to_decibels(mel, **select(db_keys))
+    if feature_normalization == "per_feature":
+        ref = fn.normalize(ref, axis_names="t")
+    elif feature_normalization == "all":
+        ref = fn.normalize(ref)
+    return fused, ref
+
+
+@params(
+    (16000, None, 0.97, "clamp", "none", "ft", {}),
+    (16000, None, 0.0, "zero", "none", "tf", {"nfft": 512, "window_length": 400}),
+    (
+        22050,
+        16000,
+        0.97,
+        "reflect",
+        "per_feature",
+        "ft",
+        {"window_length": 400, "window_step": 160, "nfilter": 64},
+    ),
+    (
+        44100,
+        16000,
+        0.9,
+        "clamp",
+        "per_feature",
+        "tf",
+        {"power": 1, "multiplier": 20.0, "mel_formula": "htk", "center_windows": False},
+    ),
+    (
+        16000,
+        None,
+        0.97,
+        "clamp",
+        "all",
+        "ft",
+        {"reflect_padding": False, "reference": 1.0, "cutoff_db": -80.0, "freq_high": 6000.0},
+    ),
+)
+def test_log_mel_spectrogram_vs_chain(
+    sample_rate, resample_rate, preemph_coeff, border, feature_normalization, layout, kwargs
+):
+    pipe = log_mel_pipe(
+        sample_rate,
+        resample_rate,
+        preemph_coeff,
+        border,
+        feature_normalization,
+        layout,
+        **kwargs,
+    )
+    pipe.build()
+    for _ in range(3):
+        fused, ref = pipe.run()
+        assert fused.layout() == layout
+        eps = 1e-3 if feature_normalization == "none" else 1e-4
+        check_batch(fused, ref, batch_size, eps=eps, max_allowed_error=eps)
+
+
+def test_log_mel_spectrogram_per_sample_rate():
+    @pipeline_def(batch_size=batch_size, num_threads=4, device_id=None)
+    def pipe():
+        data = fn.external_source(source=audio_source(), batch=True)
+        rate = fn.random.choice([16000.0, 22050.0, 44100.0], seed=123)
+        fused = fn.experimental.log_mel_spectrogram(data, sample_rate=rate, resample_rate=16000)
+        signal = fn.audio_resample(data, in_rate=rate, out_rate=16000)
+        signal = fn.preemphasis_filter(signal)
+        ref = fn.to_decibels(fn.mel_filter_bank(fn.spectrogram(signal), sample_rate=16000))
+        return fused, ref
+
+    p = pipe()
+    p.build()
+    for _ in range(3):
+        fused, ref = p.run()
+        check_batch(fused, ref, batch_size, eps=1e-3, max_allowed_error=1e-3)
+
+
+def test_log_mel_spectrogram_too_short():
+    @pipeline_def(batch_size=1, num_threads=1, device_id=None)
+    def pipe():
+        data = types.Constant(np.zeros([100], dtype=np.float32), device="cpu")
+        return fn.experimental.log_mel_spectrogram(data, center_windows=False)
+
+    p = pipe()
+    p.build()
+    with assert_raises(RuntimeError, glob="Signal is too short"):
+        p.run()
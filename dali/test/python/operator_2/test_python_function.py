@@ -705,3 +705,22 @@ def test_delete_pipe_while_function_running():
             pipe.build()
             pipe.run()
         del pipe
+
+
+@params(
+    (lambda x: x * 2,),  # a new array - used without copying
+    (lambda x: x,),  # the input - must be copied
+    (lambda x: (x * 2)[::2],),  # strided - must be copied
+)
+def test_no_copy(func):
+    @pipeline_def(batch_size=4, num_threads=2, device_id=None, prefetch_queue_depth=1)
+    def pipe():
+        data = fn.random.uniform(range=[0, 10], shape=[10, 3], seed=1234)
+        return data, fn.python_function(data, function=func, no_copy=True)
+
+    p = pipe()
+    p.build()
+    for _ in range(3):
+        data, out = p.run()
+        for i in range(len(data)):
+            numpy.testing.assert_array_equal(out.at(i), func(data.at(i)))
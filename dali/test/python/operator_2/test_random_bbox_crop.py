@@ -1,4 +1,4 @@
-# Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -538,3 +538,67 @@ def _testimpl_random_bbox_crop_square(use_input_shape):
 def test_random_bbox_crop_square():
     for use_input_shape in [False, True]:
         yield _testimpl_random_bbox_crop_square, use_input_shape
+
+
+def _testimpl_random_bbox_crop_cpu_vs_gpu(ndim, use_labels, crop_shape, extra_args=None):
+    batch_size = 8
+    rng = np.random.default_rng(4321)
+
+    def get_data():
+        boxes, labels = [], []
+        for _ in range(batch_size):
+            nboxes = rng.integers(0, 50)
+            lo = rng.uniform(0, 0.9, size=(nboxes, ndim))
+            hi = lo + rng.uniform(0.01, 1, size=(nboxes, ndim)) * (1 - lo)
+            boxes.append(np.concatenate([lo, hi], axis=1).astype(np.float32))
+            labels.append(rng.integers(0, 100, size=(nboxes,), dtype=np.int32))
+        return boxes, labels
+
+    args = dict(
+        thresholds=[0.1, 0.3, 0.5, 0.7, 0.9],
+        bbox_layout="xyzXYZ" if ndim == 3 else "xyXY",
+        output_bbox_indices=True,
+        seed=5678,
+        **(extra_args or {}),
+    )
+    if crop_shape is not None:
+        args.update(crop_shape=crop_shape, input_shape=[400, 300, 64][:ndim])
+    else:
+        # non-uniform ranges - a fixed aspect ratio is not guaranteed to match the CPU operator
+        args.update(aspect_ratio=[0.5, 2.0] * (1 if ndim == 2 else 3), scaling=[0.3, 1.0])
+
+    @pipeline_def(num_threads=4, batch_size=batch_size, device_id=0, seed=1234)
+    def pipe():
+        inputs = fn.external_source(source=get_data, num_outputs=2)
+        if not use_labels:
+            inputs = inputs[:1]
+        cpu = fn.random_bbox_crop(*inputs, device="cpu", **args)
+        gpu = fn.random_bbox_crop(*[x.gpu() for x in inputs], device="gpu", **args)
+        return (*cpu, *gpu)
+
+    p = pipe()
+    p.build()
+    for _ in range(5):
+        outputs = p.run()
+        n = len(outputs) // 2
+        for cpu_out, gpu_out in zip(outputs[:n], outputs[n:]):
+            gpu_out = gpu_out.as_cpu()
+            for sample in range(batch_size):
+                np.testing.assert_allclose(
+                    np.array(cpu_out[sample]), np.array(gpu_out[sample]), rtol=1e-5, atol=1e-6
+                )
+
+
+def test_random_bbox_crop_cpu_vs_gpu():
+    for ndim in [2, 3]:
+        for use_labels in [True, False]:
+            yield _testimpl_random_bbox_crop_cpu_vs_gpu, ndim, use_labels, None
+        yield _testimpl_random_bbox_crop_cpu_vs_gpu, ndim, True, None, dict(allow_no_crop=True)
+        yield _testimpl_random_bbox_crop_cpu_vs_gpu, ndim, True, [150, 150, 32][:ndim]
+        yield (
+            _testimpl_random_bbox_crop_cpu_vs_gpu,
+            ndim,
+            True,
+            None,
+            dict(bbox_prune_threshold=0.5, threshold_type="overlap", total_num_attempts=20),
+        )
@@ -1,4 +1,4 @@
-# Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2024-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -55,7 +55,7 @@ from nose_utils import assert_raises
     (29, 12345, 10000, np.float32),
     (30, 1e15, 123 * 1e15, np.float64),
 )
-def test_beta_distribution(case_idx, alpha, beta, dtype):
+def test_beta_distribution(case_idx, alpha, beta, dtype, device="cpu"):
 
     shape = (10, 5, 2, 5, 5, 2, 2, 10)
     size = math.prod(shape)
@@ -83,11 +83,15 @@ def test_beta_distribution(case_idx, alpha, beta, dtype):
             alpha=alpha,
             beta=beta,
             dtype=dali_dtype,
+            device=device,
         )
 
     p = pipeline()
     p.build()
-    batch = [np.array(s) for s in p.run()[0]]
+    (out,) = p.run()
+    if device == "gpu":
+        out = out.as_cpu()
+    batch = [np.array(s) for s in out]
     assert all(s.dtype == dtype for s in batch)
     assert all(s.shape == shape for s in batch)
     batch = [s.reshape(-1) for s in batch]
@@ -122,6 +126,22 @@ def test_beta_distribution(case_idx, alpha, beta, dtype):
     assert df <= min(o, 0.01), f"{expected_mean}, {actual_mean}, {o}"
 
 
+@params(
+    (0, 1, 1, np.float32),
+    (1, 1, 1, np.float64),
+    (5, 7, 4, np.float32),
+    (9, 1011, 13, np.float64),
+    (10, 0.81, 100, np.float32),
+    (14, 0.2, 0.5, np.float32),
+    (16, 0.713, 0.621, np.float64),
+    (17, 0.003, 0.002, np.float32),
+    (19, 1e35, 0.8, np.float64),
+    (29, 12345, 10000, np.float32),
+)
+def test_beta_distribution_gpu(case_idx, alpha, beta, dtype):
+    test_beta_distribution(case_idx, alpha, beta, dtype, "gpu")
+
+
 @params(
     (0, 1, 200, np.float32),
     (1, 200, 400, np.float32),
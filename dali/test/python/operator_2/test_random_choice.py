@@ -1,4 +1,4 @@
-# Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2024-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -78,7 +78,7 @@ def check_sample(sample, size, a, p, idx):
         ),
     )
 )
-def test_choice_dist(kind, elem_shape, use_p, output_shape, shape_like):
+def test_choice_dist(kind, elem_shape, use_p, output_shape, shape_like, device="cpu"):
     """Test if fn.random.choice distribution is matching the np.random.Generator.choice.
 
     Parameters
@@ -94,6 +94,8 @@ def test_choice_dist(kind, elem_shape, use_p, output_shape, shape_like):
     output_shape : tuple
         Parameter requesting the shape of output, the resulting shape will be
         `output_shape + elem_shape`.
+    device : str
+        The backend of the operator.
     """
 
     if kind in {"scalar", "0d"}:
@@ -129,9 +131,11 @@ def test_choice_dist(kind, elem_shape, use_p, output_shape, shape_like):
     def choice_pipe():
         a, p = fn.external_source(inp, batch=False, num_outputs=2)
         if not shape_like:
-            choice = fn.random.choice(a, p=p if use_p else None, shape=output_shape)
+            choice = fn.random.choice(a, p=p if use_p else None, shape=output_shape, device=device)
         else:
-            choice = fn.random.choice(a, np.full(output_shape, 42), p=p if use_p else None)
+            choice = fn.random.choice(
+                a, np.full(output_shape, 42), p=p if use_p else None, device=device
+            )
         return choice, a, p
 
     tuple_output_shape = output_shape if output_shape is not None else ()
@@ -141,6 +145,8 @@ def test_choice_dist(kind, elem_shape, use_p, output_shape, shape_like):
     choices = [[] for _ in range(batch_size)]
     for _ in range(n_iters):
         ch, a, p = pipe.run()
+        if device == "gpu":
+            ch = ch.as_cpu()
         for i in range(batch_size):
             assert tuple(ch[i].shape()) == tuple_output_shape + elem_shape
             # Extract and accumulate values in samplewise fashion
@@ -156,6 +162,31 @@ def test_choice_dist(kind, elem_shape, use_p, output_shape, shape_like):
         )
 
 
+@params(
+    *product(
+        ["scalar", "0d"],
+        [()],
+        [True, False],
+        [None, (1000,), (500, 4)],
+        [False],
+        ["gpu"],
+    )
+)
+def test_choice_dist_gpu(kind, elem_shape, use_p, output_shape, shape_like, device):
+    test_choice_dist(kind, elem_shape, use_p, output_shape, shape_like, device)
+
+
+def test_choice_gpu_nd_input():
+    @pipeline_def(batch_size=2, device_id=0, num_threads=4, seed=1234)
+    def choice_pipe():
+        return fn.random.choice(np.zeros((3, 2), dtype=np.int32), device="gpu")
+
+    with assert_raises(RuntimeError, glob="supports only scalar and 1D inputs"):
+        pipe = choice_pipe()
+        pipe.build()
+        pipe.run()
+
+
 def test_choice_0_prob():
     @pipeline_def(batch_size=2, device_id=0, num_threads=4, seed=1234)
     def choice_pipe():
@@ -1035,3 +1035,43 @@ def test_checkerboard_dali_vs_onnx_ref():
         for interp_type in [types.INTERP_LINEAR, types.INTERP_CUBIC]:
             for antialias in [antialias_OFF, antialias_ON]:
                 yield impl, device, interp_type, antialias
+
+
+@params("dali", "auto")
+def test_cvcuda_implementation(implementation):
+    batch_size = 8
+    iters = 12
+
+    @pipeline_def(
+        batch_size=batch_size,
+        num_threads=3,
+        device_id=0,
+        seed=1234,
+        experimental_exec_dynamic=True,
+        enable_memory_stats=True,
+    )
+    def pipe():
+        files, labels = fn.readers.caffe(path=db_2d_folder)
+        images = fn.decoders.image(files, device="gpu")
+        ref = fn.experimental.resize(images, size=(120, 160), implementation="cvcuda")
+        out = fn.experimental.resize(
+            images, size=(120, 160), implementation=implementation, name="resize"
+        )
+        return ref, out
+
+    p = pipe()
+    p.build()
+    for _ in range(iters):
+        ref, out = p.run()
+        # the implementations may differ slightly
+        check_batch(out, ref, batch_size, max_allowed_error=2)
+
+    diagnostics = p.executor_statistics()["resize"]["diagnostics"]
+    assert diagnostics["dali_iterations"] + diagnostics["cvcuda_iterations"] == iters
+    if implementation == "dali":
+        assert diagnostics["dali_iterations"] == iters
+        assert diagnostics["benchmark_iterations"] == 0
+    else:
+        # a single shape class - both implementations are run in the benchmark
+        assert 0 < diagnostics["benchmark_iterations"] < iters
+        assert diagnostics["dali_iterations"] > 0 and diagnostics["cvcuda_iterations"] > 0
@@ -76,3 +76,53 @@ def test_vs_separate_ops(dev, mode, roi_start, roi_end):
     for _ in range(5):
         rcm, separate = pipe.run()
         check_batch(rcm, separate, len(rcm), 1e-3, 1)
+
+
+@pipeline_def(num_threads=4, batch_size=8, device_id=0, seed=1234)
+def rcmn_pipe(output_layout, dtype, pad_output, interp_type):
+    files, labels = fn.readers.caffe(path=db_2d_folder, random_shuffle=True)
+    images = fn.decoders.image(files, device="mixed")
+    flip_x = fn.random.coin_flip(dtype=types.INT32)
+    size = fn.random.uniform(range=(224, 480), shape=(2,), dtype=types.FLOAT)
+    crop_x = fn.random.uniform(range=(0, 1))
+    crop_y = fn.random.uniform(range=(0, 1))
+    mean = [0.485 * 255, 0.456 * 255, 0.406 * 255]
+    std = [0.229 * 255, 0.224 * 255, 0.225 * 255]
+    rcm_args = dict(size=size, crop=(200, 200), crop_pos_x=crop_x, crop_pos_y=crop_y)
+    fused = fn.experimental.resize_crop_mirror_normalize(
+        images,
+        **rcm_args,
+        mirror=flip_x,
+        interp_type=interp_type,
+        mean=mean,
+        std=std,
+        dtype=dtype,
+        output_layout=output_layout,
+        pad_output=pad_output,
+    )
+    resized = fn.resize_crop_mirror(
+        images, **rcm_args, mirror=flip_x, interp_type=interp_type, dtype=types.FLOAT
+    )
+    normalized = fn.crop_mirror_normalize(
+        resized,
+        mean=mean,
+        std=std,
+        dtype=dtype,
+        output_layout=output_layout,
+        pad_output=pad_output,
+    )
+    return fused, normalized
+
+
+@params(
+    ("CHW", types.FLOAT, False, types.INTERP_LINEAR),
+    ("HWC", types.FLOAT, True, types.INTERP_CUBIC),
+    ("CHW", types.FLOAT16, False, types.INTERP_NN),
+)
+def test_rcmn_vs_separate_ops(output_layout, dtype, pad_output, interp_type):
+    pipe = rcmn_pipe(output_layout, dtype, pad_output, interp_type)
+    pipe.build()
+    max_err = 5e-2 if dtype == types.FLOAT16 else 1e-2
+    for _ in range(3):
+        fused, separate = pipe.run()
+        check_batch(fused, separate, len(fused), 1e-3, max_err)
@@ -1,4 +1,4 @@
-# Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -18,6 +18,7 @@ import nvidia.dali as dali
 import nvidia.dali.fn as fn
 import nvidia.dali.types as types
 import nvidia.dali.math as math
+from nose2.tools import params
 
 np.random.seed(4321)
 
@@ -92,3 +93,41 @@ def check_random_mask_pixel(ndim=2, batch_size=3, min_extent=20, max_extent=50):
 def test_random_mask_pixel():
     for ndim in (2, 3):
         yield check_random_mask_pixel, ndim
+
+
+@params(
+    (np.uint8, 2, {"foreground": 1}),
+    (np.int32, 3, {"foreground": 1, "value": 2}),
+    (np.int32, 2, {"foreground": 1, "value": 300}),
+    (np.uint8, 2, {"foreground": 1, "value": 300}),
+    (np.float32, 2, {"foreground": 1, "threshold": 0.7}),
+    (np.int16, 1, {"foreground": 0}),
+)
+def test_random_mask_pixel_cpu_vs_gpu(dtype, ndim, args):
+    batch_size = 5
+    rng = np.random.default_rng(1234)
+
+    def get_data():
+        masks = []
+        for i in range(batch_size):
+            shape = rng.integers(1, 3000 if ndim == 1 else 200, size=ndim)
+            # some samples have no foreground at all
+            num_values = 1 if i == 0 else 4
+            mask = rng.integers(0, num_values, size=shape) * (rng.uniform(size=shape) > 0.9)
+            masks.append(mask.astype(dtype))
+        return masks
+
+    @dali.pipeline_def(batch_size=batch_size, num_threads=4, device_id=0)
+    def pipe():
+        mask = fn.external_source(source=get_data)
+        cpu_pixel = fn.segmentation.random_mask_pixel(mask, seed=4321, **args)
+        gpu_pixel = fn.segmentation.random_mask_pixel(mask.gpu(), seed=4321, **args)
+        return cpu_pixel, gpu_pixel
+
+    p = pipe()
+    p.build()
+    for _ in range(3):
+        cpu_pixel, gpu_pixel = p.run()
+        gpu_pixel = gpu_pixel.as_cpu()
+        for i in range(batch_size):
+            np.testing.assert_array_equal(np.array(cpu_pixel[i]), np.array(gpu_pixel[i]))
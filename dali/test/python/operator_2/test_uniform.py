@@ -1,4 +1,4 @@
-# Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -112,3 +112,39 @@ def test_uniform_discrete():
     for device in ["cpu", "gpu"]:
         for values in [(0, 1, 2, 3, 4, 5), (200, 400, 5000, 1)]:
             yield check_uniform_discrete, device, batch_size, shape, values, niter
+
+
+def check_uniform_counter_based(device, shape):
+    def run(batch_size, niter):
+        pipe = Pipeline(batch_size=batch_size, device_id=0, num_threads=3, seed=123456)
+        with pipe:
+            pipe.set_outputs(
+                dali.fn.random.uniform(device=device, shape=shape, counter_based_rng=True)
+            )
+        pipe.build()
+        result = []
+        for _ in range(niter):
+            (out,) = pipe.run()
+            out = out.as_cpu() if isinstance(out, TensorListGPU) else out
+            result.append([np.array(out[i]) for i in range(4)])
+        return result
+
+    # the stream of a sample doesn't depend on the batch size
+    small, large = run(4, 3), run(16, 3)
+    pvs = []
+    for it in range(3):
+        for i in range(4):
+            np.testing.assert_array_equal(small[it][i], large[it][i])
+            data = small[it][i]
+            assert (data >= -1).all() and (data < 1).all()
+            _, pv = st.kstest(rvs=(data + 1) / 2, cdf="uniform")
+            pvs.append(pv)
+        assert not np.array_equal(small[it][0], small[it][1]), "Samples should differ"
+    assert not np.array_equal(small[0][0], small[1][0]), "Iterations should differ"
+    assert np.mean(pvs) > 0.05, f"data is not a uniform distribution. pv = {np.mean(pvs)}"
+
+
+def test_uniform_counter_based():
+    for device in ["cpu", "gpu"]:
+        for shape in [[1000], [300000]]:
+            yield check_uniform_counter_based, device, shape
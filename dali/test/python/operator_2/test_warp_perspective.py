@@ -565,6 +565,78 @@ def test_warp_perspective_const_matrix_vs_warp_affine(
     compare_pipelines(pipe1, pipe2, bs, dtype)
 
 
+@dali.pipeline_def(num_threads=NUM_THREADS, device_id=DEV_ID)
+def warp_perspective_pipe_gpu_affine_matrix(data_src, matrix_src, layout, size):
+    img = fn.external_source(source=data_src, batch=True, layout=layout, device="gpu")
+    matrix = fn.external_source(source=matrix_src, batch=True, device="gpu")[0:2, :]
+    return fn.experimental.warp_perspective(
+        img,
+        matrix,
+        size=size,
+        border_mode="replicate",
+        interp_type=types.DALIInterpType.INTERP_LINEAR,
+    )
+
+
+@params(
+    (32, "HWC", np.uint8, 3, (200, 300)),
+    (4, "FHWC", np.float32, 1, None),
+)
+def test_warp_perspective_gpu_affine_matrix(bs, layout, dtype, channels, size):
+    data1 = input_iterator(bs, layout, dtype, channels)
+    data2 = input_iterator(bs, layout, dtype, channels)
+
+    pipe1 = warp_perspective_pipe_gpu_affine_matrix(
+        data1,
+        affine_matrix_src(bs, SEED),
+        layout,
+        size,
+        batch_size=bs,
+        prefetch_queue_depth=1,
+    )
+    pipe2 = warp_perspective_pipe_arg_inp_matrix(
+        data2,
+        affine_matrix_src(bs, SEED),
+        size,
+        layout,
+        "replicate",
+        types.DALIInterpType.INTERP_LINEAR,
+        True,
+        None,
+        batch_size=bs,
+        prefetch_queue_depth=1,
+    )
+    compare_pipelines(pipe1, pipe2, bs, dtype)
+
+
+@dali.pipeline_def(num_threads=NUM_THREADS, device_id=DEV_ID, seed=SEED)
+def warp_gpu_transforms_pipe(data_src, layout):
+    img = fn.external_source(source=data_src, batch=True, layout=layout, device="gpu")
+    angle = fn.random.uniform(range=(-30, 30))
+    scale = fn.random.uniform(range=(0.8, 1.2), shape=2)
+    mtx_gpu = fn.transforms.rotation(
+        fn.transforms.scale(scale=scale, device="gpu"), angle=angle, center=(32, 32), device="gpu"
+    )
+    mtx_cpu = fn.transforms.rotation(fn.transforms.scale(scale=scale), angle=angle, center=(32, 32))
+    interp_type = types.DALIInterpType.INTERP_LINEAR
+    persp = fn.experimental.warp_perspective(
+        img, mtx_gpu, border_mode="replicate", interp_type=interp_type
+    )
+    affine = fn.warp_affine(img, matrix=mtx_cpu, interp_type=interp_type)
+    return persp, affine
+
+
+def test_warp_perspective_gpu_transforms():
+    bs = 8
+    pipe = warp_gpu_transforms_pipe(
+        input_iterator(bs, "HWC", np.uint8, 3), "HWC", batch_size=bs, prefetch_queue_depth=1
+    )
+    pipe.build()
+    for _ in range(3):
+        persp, affine = pipe.run()
+        test_utils.check_batch(persp, affine, bs, eps=1)
+
+
 @raises(
     RuntimeError, glob="*Expected a uniform list of 3x3 matrices. Instead got data with shape: *"
 )
@@ -1,4 +1,4 @@
-# Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -209,6 +209,39 @@ def test_invalid_args():
     pipeline.build()
 
 
+@pipeline_def(batch_size=4, device_id=0, num_threads=4)
+def coco_cache_pipe(masks, ratio, annotations_cache_dir=None):
+    kwargs = {"annotations_cache_dir": annotations_cache_dir} if annotations_cache_dir else {}
+    _, boxes, labels, *rest = fn.readers.coco(
+        file_root=file_root,
+        annotations_file=train_annotations,
+        image_ids=True,
+        polygon_masks=masks == "polygon",
+        pixelwise_masks=masks == "pixelwise",
+        ratio=ratio,
+        **kwargs,
+    )
+    return boxes, labels, *rest
+
+
+@params("none", "polygon", "pixelwise")
+def test_annotations_cache_dir(masks):
+    with tempfile.TemporaryDirectory() as cache_dir:
+        for ratio in [False, True]:
+            # the first run fills the cache, the second one reads from it
+            for _ in range(2):
+                compare_pipelines(
+                    coco_cache_pipe(masks, ratio),
+                    coco_cache_pipe(masks, ratio, cache_dir),
+                    batch_size=4,
+                    N_iterations=3,
+                )
+        entries = os.listdir(cache_dir)
+        # different arguments produce different annotations
+        assert len(entries) == 2, entries
+        assert all(e.startswith("dali_coco_") for e in entries), entries
+
+
 batch_size_alias_test = 64
 
 
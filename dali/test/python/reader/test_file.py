@@ -1,4 +1,4 @@
-# Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -98,6 +98,34 @@ def test_file_reader():
                 yield _test_reader_files_arg, use_root, use_labels, shuffle
 
 
+def test_file_reader_io_uring():
+    batch_size = 3
+    fnames = [os.path.join(g_root, f) for f in g_files]
+
+    pipe = Pipeline(batch_size, 1, 0)
+    files, labels = fn.readers.file(
+        files=fnames, random_shuffle=True, dont_use_mmap=True, use_io_uring=True
+    )
+    pipe.set_outputs(files, labels)
+    pipe.build()
+
+    num_iters = (len(fnames) + 2 * batch_size) // batch_size
+    for i in range(num_iters):
+        out_f, out_l = pipe.run()
+        for j in range(batch_size):
+            contents = bytes(out_f.at(j)).decode("utf-8")
+            index = out_l.at(j)[0]
+            assert contents == ref_contents(fnames[index])
+
+
+def test_file_reader_io_uring_mmap():
+    pipe = Pipeline(1, 1, 0)
+    files, labels = fn.readers.file(file_root=g_root, use_io_uring=True)
+    pipe.set_outputs(files, labels)
+    with assert_raises(RuntimeError, glob="Cannot use ``use_io_uring``*"):
+        pipe.build()
+
+
 def test_file_reader_relpath():
     batch_size = 3
     rel_root = os.path.relpath(g_root, os.getcwd())
@@ -198,6 +226,49 @@ def test_file_reader_filters():
     ], 3, 1, "db/single/case_sensitive", False
 
 
+def test_file_reader_discovery_threads_and_cache():
+    root = os.path.join(os.environ["DALI_EXTRA_PATH"], "db/single/mixed")
+    batch_size = 7
+
+    @pipeline_def(batch_size=batch_size, device_id=None, num_threads=4)
+    def discovery_pipe(**kwargs):
+        files, labels = fn.readers.file(file_root=root, **kwargs)
+        return files, labels
+
+    with tempfile.TemporaryDirectory() as cache_dir:
+        for kwargs in [
+            {"file_discovery_threads": 4},
+            {"file_discovery_cache_dir": cache_dir},
+            {"file_discovery_cache_dir": cache_dir, "file_discovery_threads": 3},
+        ]:
+            compare_pipelines(discovery_pipe(), discovery_pipe(**kwargs), batch_size, 10)
+
+
+def test_file_reader_shared_cache():
+    batch_size = 3
+    cache_name = "dali_test_file_reader_cache_{}".format(os.getpid())
+
+    @pipeline_def(batch_size=batch_size, device_id=None, num_threads=4)
+    def cache_pipe(**kwargs):
+        files, labels = fn.readers.file(file_root=g_root, **kwargs)
+        return files, labels
+
+    # both readers share one cache - the second one reads the samples cached by the first one
+    for dont_use_mmap in [False, True]:
+        pipes = [
+            cache_pipe(
+                shared_cache_size=1 << 20,
+                shared_cache_name=cache_name,
+                dont_use_mmap=dont_use_mmap,
+            )
+            for _ in range(2)
+        ]
+        ref = cache_pipe(dont_use_mmap=dont_use_mmap)
+        iters = 2 * len(g_files) // batch_size + 1
+        compare_pipelines(ref, pipes[0], batch_size, iters)
+        compare_pipelines(ref, pipes[1], batch_size, iters)
+
+
 batch_size_alias_test = 64
 
 
@@ -235,3 +306,21 @@ def test_invalid_number_of_shards():
             " needs to be at least equal to the requested number of shards:*."
         ),
     )
+
+
+def test_file_reader_peek_image_shape_non_images():
+    # the files are not images - they should be passed unchanged
+    batch_size = 3
+    fnames = [os.path.join(g_root, f) for f in g_files]
+
+    pipe = Pipeline(batch_size, 1, 0)
+    files, labels = fn.readers.file(files=fnames, peek_image_shape=True)
+    pipe.set_outputs(files, labels)
+    pipe.build()
+
+    for i in range(2):
+        out_f, out_l = pipe.run()
+        for j in range(batch_size):
+            contents = bytes(out_f.at(j)).decode("utf-8")
+            index = out_l.at(j)[0]
+            assert contents == ref_contents(fnames[index])
@@ -106,6 +106,238 @@ def test_tfrecord_odirect():
             assert np.array_equal(a.as_array(), b.as_array())
 
 
+def test_tfrecord_io_uring():
+    batch_size = 16
+
+    @pipeline_def(batch_size=batch_size, device_id=0, num_threads=4)
+    def tfrecord_pipe(path, index_path, dont_use_mmap, use_io_uring, shuffle):
+        input = fn.readers.tfrecord(
+            path=path,
+            index_path=index_path,
+            dont_use_mmap=dont_use_mmap,
+            use_io_uring=use_io_uring,
+            random_shuffle=shuffle,
+            seed=1234,
+            features={"image/encoded": tfrec.FixedLenFeature((), tfrec.string, "")},
+            name="Reader",
+        )
+        return input["image/encoded"]
+
+    tfrecord = os.path.join(get_dali_extra_path(), "db", "tfrecord", "train")
+    tfrecord_idx = os.path.join(get_dali_extra_path(), "db", "tfrecord", "train.idx")
+
+    for shuffle in [False, True]:
+        pipe = tfrecord_pipe(tfrecord, tfrecord_idx, True, True, shuffle)
+        pipe_ref = tfrecord_pipe(tfrecord, tfrecord_idx, True, False, shuffle)
+        pipe.build()
+        pipe_ref.build()
+        iters = (pipe.epoch_size("Reader") + batch_size) // batch_size
+        for _ in range(iters):
+            out = pipe.run()
+            out_ref = pipe_ref.run()
+            for a, b in zip(out, out_ref):
+                for i in range(len(a)):
+                    assert np.array_equal(a.at(i), b.at(i))
+
+
+@cartesian_params((1000, 1 << 20), (False, True), (False, True))
+def test_tfrecord_coalesced_reads(coalesced_read_bytes, use_o_direct, shuffle):
+    batch_size = 16
+
+    @pipeline_def(batch_size=batch_size, device_id=0, num_threads=4)
+    def tfrecord_pipe(path, index_path, dont_use_mmap, use_o_direct, coalesced_read_bytes):
+        input = fn.readers.tfrecord(
+            path=path,
+            index_path=index_path,
+            dont_use_mmap=dont_use_mmap,
+            use_o_direct=use_o_direct,
+            coalesced_read_bytes=coalesced_read_bytes,
+            random_shuffle=shuffle,
+            seed=1234,
+            features={"image/encoded": tfrec.FixedLenFeature((), tfrec.string, "")},
+            name="Reader",
+        )
+        return input["image/encoded"]
+
+    tfrecord = os.path.join(get_dali_extra_path(), "db", "tfrecord", "train")
+    tfrecord_idx = os.path.join(get_dali_extra_path(), "db", "tfrecord", "train.idx")
+
+    pipe = tfrecord_pipe(tfrecord, tfrecord_idx, True, use_o_direct, coalesced_read_bytes)
+    pipe_ref = tfrecord_pipe(tfrecord, tfrecord_idx, False, False, 0)
+    pipe.build()
+    pipe_ref.build()
+    iters = (pipe.epoch_size("Reader") + batch_size) // batch_size
+    for _ in range(iters):
+        out = pipe.run()
+        out_ref = pipe_ref.run()
+        for a, b in zip(out, out_ref):
+            for i in range(len(a)):
+                assert np.array_equal(a.at(i), b.at(i))
+
+
+@cartesian_params((1, 7), (1, 3), (1, 2), (False, True))
+def test_tfrecord_block_shuffle(shuffle_block_size, shuffle_interleave, num_shards, stick):
+    batch_size = 8
+
+    @pipeline_def(batch_size=batch_size, device_id=0, num_threads=4)
+    def tfrecord_pipe(shard_id, **kwargs):
+        input = fn.readers.tfrecord(
+            path=os.path.join(get_dali_extra_path(), "db", "tfrecord", "train"),
+            index_path=os.path.join(get_dali_extra_path(), "db", "tfrecord", "train.idx"),
+            shard_id=shard_id,
+            num_shards=num_shards,
+            stick_to_shard=stick,
+            features={"image/encoded": tfrec.FixedLenFeature((), tfrec.string, "")},
+            name="Reader",
+            **kwargs,
+        )
+        return input["image/encoded"]
+
+    def read_epochs(pipe, shard_id, num_epochs):
+        pipe.build()
+        size = pipe.reader_meta("Reader")["epoch_size"]
+        epoch_sizes = []
+        for epoch in range(num_epochs):
+            shard = shard_id if stick else (shard_id + epoch) % num_shards
+            epoch_sizes.append(size * (shard + 1) // num_shards - size * shard // num_shards)
+        records = []
+        while len(records) < sum(epoch_sizes):
+            (out,) = pipe.run()
+            records += [out[i].source_info() for i in range(len(out))]
+        epochs = []
+        for epoch_size in epoch_sizes:
+            epochs.append(records[:epoch_size])
+            records = records[epoch_size:]
+        return epochs
+
+    for shard_id in range(num_shards):
+        ref = read_epochs(tfrecord_pipe(shard_id), shard_id, 2)
+        shuffled = read_epochs(
+            tfrecord_pipe(
+                shard_id,
+                shuffle_block_size=shuffle_block_size,
+                shuffle_interleave=shuffle_interleave,
+                seed=123,
+            ),
+            shard_id,
+            2,
+        )
+        for epoch in range(2):
+            # a shard contains the same records, only the order changes
+            assert sorted(ref[epoch]) == sorted(shuffled[epoch])
+        assert shuffled[0] != ref[0]
+        if stick:
+            # the same shard is shuffled differently in every epoch
+            assert shuffled[0] != shuffled[1]
+
+
+@cartesian_params((1, 3), (8, 13))
+def test_tfrecord_shuffle_after_epoch(num_shards, batch_size):
+    @pipeline_def(batch_size=batch_size, device_id=0, num_threads=4)
+    def tfrecord_pipe(shard_id):
+        input = fn.readers.tfrecord(
+            path=os.path.join(get_dali_extra_path(), "db", "tfrecord", "train"),
+            index_path=os.path.join(get_dali_extra_path(), "db", "tfrecord", "train.idx"),
+            shard_id=shard_id,
+            num_shards=num_shards,
+            shuffle_after_epoch=True,
+            features={"image/encoded": tfrec.FixedLenFeature((), tfrec.string, "")},
+            name="Reader",
+        )
+        return input["image/encoded"]
+
+    pipes = [tfrecord_pipe(shard_id) for shard_id in range(num_shards)]
+    for pipe in pipes:
+        pipe.build()
+    size = pipes[0].reader_meta("Reader")["epoch_size"]
+    streams = [[] for _ in pipes]
+    num_epochs = 2
+    for pipe, stream in zip(pipes, streams):
+        while len(stream) < num_epochs * size:
+            (out,) = pipe.run()
+            stream += [out[i].source_info() for i in range(len(out))]
+
+    epochs = []
+    for epoch in range(num_epochs):
+        records = []
+        for shard_id, stream in enumerate(streams):
+            # the shards stick to their part of the permuted dataset
+            shard_size = size * (shard_id + 1) // num_shards - size * shard_id // num_shards
+            records += stream[epoch * shard_size : (epoch + 1) * shard_size]
+        # together, the shards read every record exactly once
+        assert len(set(records)) == size
+        epochs.append(records)
+    assert epochs[0] != epochs[1]
+    assert sorted(epochs[0]) == sorted(epochs[1])
+
+
+@raises(RuntimeError, glob="shuffle_after_epoch and random_shuffle cannot be both true")
+def test_tfrecord_shuffle_after_epoch_random_shuffle():
+    @pipeline_def(batch_size=1, device_id=0, num_threads=1)
+    def tfrecord_pipe():
+        input = fn.readers.tfrecord(
+            path=os.path.join(get_dali_extra_path(), "db", "tfrecord", "train"),
+            index_path=os.path.join(get_dali_extra_path(), "db", "tfrecord", "train.idx"),
+            shuffle_after_epoch=True,
+            random_shuffle=True,
+            features={"image/encoded": tfrec.FixedLenFeature((), tfrec.string, "")},
+        )
+        return input["image/encoded"]
+
+    tfrecord_pipe().build()
+
+
+@cartesian_params(
+    (True, False),
+    ({}, {"shuffle_block_size": 5, "shuffle_interleave": 2}, {"shuffle_after_epoch": True}),
+)
+def test_tfrecord_prefetch_horizon(dont_use_mmap, shuffling):
+    batch_size = 8
+
+    @pipeline_def(batch_size=batch_size, device_id=0, num_threads=4)
+    def tfrecord_pipe(**kwargs):
+        input = fn.readers.tfrecord(
+            path=os.path.join(get_dali_extra_path(), "db", "tfrecord", "train"),
+            index_path=os.path.join(get_dali_extra_path(), "db", "tfrecord", "train.idx"),
+            dont_use_mmap=dont_use_mmap,
+            seed=123,
+            features={"image/encoded": tfrec.FixedLenFeature((), tfrec.string, "")},
+            name="Reader",
+            **shuffling,
+            **kwargs,
+        )
+        return input["image/encoded"]
+
+    pipe = tfrecord_pipe(prefetch_horizon=20)
+    pipe_ref = tfrecord_pipe()
+    pipe.build()
+    pipe_ref.build()
+    # the hints don't change what is read
+    iters = 2 * (pipe.epoch_size("Reader") + batch_size) // batch_size
+    for _ in range(iters):
+        (out,) = pipe.run()
+        (out_ref,) = pipe_ref.run()
+        for i in range(batch_size):
+            assert out[i].source_info() == out_ref[i].source_info()
+            assert np.array_equal(out.at(i), out_ref.at(i))
+
+
+@raises(RuntimeError, glob="``shuffle_interleave`` must be positive, got 0")
+def test_tfrecord_shuffle_interleave_invalid():
+    @pipeline_def(batch_size=1, device_id=0, num_threads=1)
+    def tfrecord_pipe():
+        input = fn.readers.tfrecord(
+            path=os.path.join(get_dali_extra_path(), "db", "tfrecord", "train"),
+            index_path=os.path.join(get_dali_extra_path(), "db", "tfrecord", "train.idx"),
+            shuffle_block_size=4,
+            shuffle_interleave=0,
+            features={"image/encoded": tfrec.FixedLenFeature((), tfrec.string, "")},
+        )
+        return input["image/encoded"]
+
+    tfrecord_pipe().build()
+
+
 @cartesian_params(((1, 2, 1), (3, 1, 2)), (True, False), (True, False))
 def test_tfrecord_pad_last_batch(batch_description, dont_use_mmap, use_o_direct):
     if not dont_use_mmap and use_o_direct:
@@ -1,4 +1,4 @@
-# Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -1095,3 +1095,87 @@ def test_shuffling(shuffling, pad_last_batch):
         for _ in range(num_samples // batch_size * 2):
             (cpu_arr, gpu_arr) = pipe.run()
             assert_array_equal(to_array(cpu_arr), to_array(gpu_arr))
+
+
+@params(0, 1, 4, 32)
+def test_gds_queue_depth(gds_queue_depth):
+    if not is_gds_supported():
+        raise SkipTest("GDS is not supported in this platform")
+
+    with tempfile.TemporaryDirectory(prefix=gds_data_root) as test_data_root:
+        # the arrays span many GDS chunks, so the reads of a batch don't fit in a short queue
+        num_samples = 6
+        batch_size = 3
+        filenames = []
+        for index in range(0, num_samples):
+            filename = os.path.join(test_data_root, "test_{:02d}.npy".format(index))
+            filenames.append(filename)
+            create_numpy_file(filename, (3 + index, 517, 1031), np.float32, False)
+
+        pipe = Pipeline(batch_size=batch_size, num_threads=4, device_id=0)
+        with pipe:
+            data_cpu = fn.readers.numpy(device="cpu", files=filenames)
+            data_gpu = fn.readers.numpy(
+                device="gpu", files=filenames, gds_queue_depth=gds_queue_depth
+            )
+            pipe.set_outputs(data_cpu, data_gpu)
+
+        pipe.build()
+        for _ in range(num_samples // batch_size * 2):
+            (cpu_arr, gpu_arr) = pipe.run()
+            for i in range(batch_size):
+                assert_array_equal(np.array(cpu_arr[i]), np.array(gpu_arr[i].as_cpu()))
+
+
+@params(
+    *[
+        (device, dont_use_mmap, roi)
+        for device in (["cpu", "gpu"] if is_gds_supported() else ["cpu"])
+        for dont_use_mmap in ([True, False] if device == "cpu" else [True])
+        for roi in [
+            dict(roi_start=(5, 10, 20), roi_shape=(8, 100, 200)),
+            dict(roi_start=(3, 7), roi_end=(17, 200), roi_axes=(0, 1)),
+            dict(rel_roi_start=(0.25,), rel_roi_shape=(0.5,), roi_axes=(0,)),
+            dict(roi_start=(0, 0, 499), roi_shape=(40, 300, 1)),
+        ]
+    ]
+)
+def test_numpy_reader_roi_partial_read(device, dont_use_mmap, roi):
+    # the arrays are large enough to span many rows, planes and GDS chunks
+    shapes = [(40, 300, 500), (44, 310, 520), (40, 300, 501)]
+    with tempfile.TemporaryDirectory(prefix=gds_data_root) as test_data_root:
+        for index, sh in enumerate(shapes):
+            filename = os.path.join(test_data_root, "test_{:02d}.npy".format(index))
+            create_numpy_file(filename, sh, np.uint16, False)
+
+        @pipeline_def(batch_size=len(shapes), device_id=0, num_threads=4)
+        def pipe():
+            full = fn.readers.numpy(device=device, file_root=test_data_root)
+            roi_data = fn.readers.numpy(
+                device=device, file_root=test_data_root, dont_use_mmap=dont_use_mmap, **roi
+            )
+            return full, roi_data
+
+        p = pipe()
+        p.build()
+        full, roi_data = p.run()
+        for i in range(len(shapes)):
+            full_arr = to_array(full[i])
+            start = [0] * full_arr.ndim
+            end = list(full_arr.shape)
+            axes = roi.get("roi_axes", range(full_arr.ndim))
+            for j, axis in enumerate(axes):
+                if "roi_start" in roi:
+                    start[axis] = roi["roi_start"][j]
+                if "rel_roi_start" in roi:
+                    start[axis] = int(roi["rel_roi_start"][j] * full_arr.shape[axis])
+                if "roi_shape" in roi:
+                    end[axis] = start[axis] + roi["roi_shape"][j]
+                if "roi_end" in roi:
+                    end[axis] = roi["roi_end"][j]
+                if "rel_roi_shape" in roi:
+                    end[axis] = int(
+                        (roi["rel_roi_start"][j] + roi["rel_roi_shape"][j]) * full_arr.shape[axis]
+                    )
+            ref = full_arr[tuple(slice(s, e) for s, e in zip(start, end))]
+            assert_array_equal(to_array(roi_data[i]), ref)
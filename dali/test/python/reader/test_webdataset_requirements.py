@@ -15,6 +15,7 @@
 import os
 from glob import glob
 import math
+import tempfile
 import nvidia.dali as dali
 from test_utils import compare_pipelines, get_dali_extra_path
 from nose_utils import assert_raises
@@ -473,3 +474,41 @@ def test_index_generation():
             test_batch_size,
             math.ceil(num_samples / num_shards / test_batch_size) * 2,
         )
+
+
+def test_index_cache_dir():
+    num_samples = 3000
+    tar_file_paths = [
+        os.path.join(get_dali_extra_path(), "db/webdataset/MNIST/devel-0.tar"),
+        os.path.join(get_dali_extra_path(), "db/webdataset/MNIST/devel-1.tar"),
+        os.path.join(get_dali_extra_path(), "db/webdataset/MNIST/devel-2.tar"),
+    ]
+    index_files = [generate_temp_index_file(tar_file_path) for tar_file_path in tar_file_paths]
+
+    with tempfile.TemporaryDirectory() as cache_dir:
+        # the first run parses the archives and stores the indices, the second one reuses them
+        for _ in range(2):
+            compare_pipelines(
+                webdataset_raw_pipeline(
+                    tar_file_paths,
+                    [],
+                    ["jpg", "cls"],
+                    missing_component_behavior="error",
+                    index_cache_dir=cache_dir,
+                    batch_size=test_batch_size,
+                    device_id=0,
+                    num_threads=4,
+                ),
+                webdataset_raw_pipeline(
+                    tar_file_paths,
+                    [index_file.name for index_file in index_files],
+                    ["jpg", "cls"],
+                    missing_component_behavior="error",
+                    batch_size=test_batch_size,
+                    device_id=0,
+                    num_threads=1,
+                ),
+                test_batch_size,
+                math.ceil(num_samples / test_batch_size),
+            )
+            assert_equals(len(glob(os.path.join(cache_dir, "*.idx"))), len(tar_file_paths))
@@ -0,0 +1,58 @@
+# Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import nvidia.dali.fn as fn
+from nvidia.dali import pipeline_def
+from nvidia.dali.experimental import autotune
+from nose_utils import assert_raises
+
+
+@pipeline_def(batch_size=4, device_id=None, seed=123)
+def uniform_pipe(sample_size=10):
+    return fn.random.uniform(range=[0, 1], shape=[sample_size], name="autotune_uniform")
+
+
+def test_autotune_coordinate_search():
+    space = {
+        "num_threads": [1, 2],
+        "prefetch_queue_depth": [1, 2],
+        "experimental_exec_queue_policy": ["backend_change", "bogus"],
+        "sample_size": [10, 100],
+    }
+    result = autotune.autotune(uniform_pipe, space, iterations=3, warmup=1)
+    failed = [t for t in result.trials if t.error is not None]
+    assert len(failed) == 1 and failed[0].config["experimental_exec_queue_policy"] == "bogus"
+    assert result.best_config["experimental_exec_queue_policy"] == "backend_change"
+    best = max(result.trials, key=lambda t: t.throughput)
+    assert best.config == result.best_config
+    assert result.best_throughput > 0
+    assert "autotune_uniform" in result.profile
+    assert "autotune_uniform" in result.report()
+
+    pipe = result.create_pipeline()
+    pipe.build()
+    (out,) = pipe.run()
+    assert out.as_array().shape == (4, result.best_config["sample_size"])
+
+
+def test_autotune_exhaustive():
+    space = {"num_threads": [1, 2], "sample_size": [10, 20, 30]}
+    result = autotune.autotune(uniform_pipe, space, iterations=2, warmup=1, exhaustive=True)
+    assert len(result.trials) == 6
+
+
+def test_autotune_all_failed():
+    space = {"experimental_exec_concurrency": ["bogus"]}
+    with assert_raises(RuntimeError, glob="All trials failed*"):
+        autotune.autotune(uniform_pipe, space, iterations=2, warmup=1)
@@ -238,6 +238,45 @@ def test_tensorlist_shape():
         assert tl_gpu.shape() == [shape[1:]] * shape[0]
 
 
+def test_tensorlist_as_ragged():
+    np_arrays = [np.arange(n, dtype=np.int32) for n in [3, 0, 7, 1]]
+    tl_cpu = TensorListCPU([TensorCPU(a) for a in np_arrays])
+    for tl in [tl_cpu, tl_cpu._as_gpu()]:
+        values, offsets = tl.as_ragged()
+        if tl is not tl_cpu:
+            values = values.as_cpu()
+        np.testing.assert_array_equal(offsets, [0, 3, 3, 10, 11])
+        np.testing.assert_array_equal(np.array(values), np.concatenate(np_arrays))
+
+
+def test_batch_file():
+    import os
+    import tempfile
+    from nvidia.dali.backend_impl import BatchFileReader, BatchFileWriter
+
+    batches = [
+        [np.full((i + 1, 3), i, dtype=np.uint8) for i in range(4)],
+        [np.arange(n, dtype=np.float32) for n in [5, 0, 2]],
+    ]
+    fd, path = tempfile.mkstemp()
+    os.close(fd)
+    try:
+        with BatchFileWriter(path) as writer:
+            writer.write(TensorListCPU([TensorCPU(a) for a in batches[0]], "HW"))
+            writer.write(TensorListCPU([TensorCPU(a) for a in batches[1]]))
+            assert writer.num_batches == 2
+        reader = BatchFileReader(path)
+        assert len(reader) == 2
+        for tl, arrays in zip(reader, batches):
+            assert len(tl) == len(arrays)
+            for t, a in zip(tl, arrays):
+                assert_array_equal(np.array(t), a)
+        assert reader[0].layout() == "HW"
+        with assert_raises(IndexError):
+            reader[2]
+    finally:
+        os.remove(path)
+
 def test_tl_from_list_of_tensors_same_shape():
     for shape in [(10, 1), (4, 5, 6), (13, 1), (1, 1)]:
         arr = np.random.rand(*shape)
@@ -538,6 +538,17 @@ def test_spectrogram_cpu():
     )
 
 
+def test_log_mel_spectrogram_cpu():
+    check_single_input(
+        fn.experimental.log_mel_spectrogram,
+        get_data=get_audio_data,
+        input_layout=None,
+        nfft=60,
+        window_length=50,
+        window_step=25,
+    )
+
+
 def test_mel_filter_bank_cpu():
     pipe = Pipeline(batch_size=batch_size, num_threads=4, device_id=None)
     data = fn.external_source(source=get_audio_data)
@@ -668,6 +679,20 @@ def test_lookup_table_cpu():
     )
 
 
+def test_pack_bits_cpu():
+    def get_data():
+        return [np.random.randint(0, 2, size=[10, 13], dtype=np.uint8) for _ in range(batch_size)]
+
+    pipe = Pipeline(batch_size=batch_size, num_threads=4, device_id=None)
+    with pipe:
+        data = fn.external_source(source=get_data)
+        packed = fn.experimental.pack_bits(data)
+        pipe.set_outputs(packed, fn.experimental.unpack_bits(packed, count=13))
+    pipe.build()
+    for _ in range(3):
+        pipe.run()
+
+
 def test_slice_cpu():
     anch_shape = [2]
 
@@ -1534,6 +1559,7 @@ tested_methods = [
     "preemphasis_filter",
     "power_spectrum",
     "spectrogram",
+    "experimental.log_mel_spectrogram",
     "to_decibels",
     "sequence_rearrange",
     "normal_distribution",
@@ -1549,6 +1575,8 @@ tested_methods = [
     "transpose",
     "mfcc",
     "lookup_table",
+    "experimental.pack_bits",
+    "experimental.unpack_bits",
     "element_extract",
     "arithmetic_generic_op",
     "box_encoder",
@@ -1629,6 +1657,7 @@ excluded_methods = [
     "experimental.erode",  # not supported for CPU
     "experimental.warp_perspective",  # not supported for CPU
     "experimental.resize",  # not supported for CPU
+    "experimental.resize_crop_mirror_normalize",  # not supported for CPU
     "plugin.video.decoder",  # not supported for CPU
 ]
 
@@ -376,6 +376,10 @@ ops_image_custom_args = [
     (fn.experimental.erode, {"devices": ["gpu"]}),
     (fn.experimental.warp_perspective, {"matrix": np.eye(3), "devices": ["gpu"]}),
     (fn.experimental.resize, {"resize_x": 50, "resize_y": 50, "devices": ["gpu"]}),
+    (
+        fn.experimental.resize_crop_mirror_normalize,
+        {"resize_shorter": 10, "crop": [5, 5], "devices": ["gpu"]},
+    ),
     (fn.zeros_like, {"devices": ["cpu"]}),
     (fn.ones_like, {"devices": ["cpu"]}),
 ]
@@ -425,6 +429,10 @@ float_array_ops = [
     (fn.power_spectrum, {"devices": ["cpu"]}),
     (fn.preemphasis_filter, {}),
     (fn.spectrogram, {"nfft": 60, "window_length": 50, "window_step": 25}),
+    (
+        fn.experimental.log_mel_spectrogram,
+        {"devices": ["cpu"], "nfft": 60, "window_length": 50, "window_step": 25},
+    ),
     (fn.to_decibels, {}),
     (fn.audio_resample, {"devices": ["cpu"], "scale": 1.2}),
 ]
@@ -441,7 +449,7 @@ random_ops = [
     (fn.noise.gaussian, {}),
     (fn.noise.shot, {}),
     (fn.noise.salt_and_pepper, {}),
-    (fn.segmentation.random_mask_pixel, {"devices": ["cpu"]}),
+    (fn.segmentation.random_mask_pixel, {"devices": ["cpu", "gpu"]}),
     (
         fn.roi_random_crop,
         {
@@ -880,7 +888,7 @@ def test_random_bbox_crop_op():
         return (bboxes, labels)
 
     input_data = [get_data(random.randint(5, 31)) for _ in range(13)]
-    run_pipeline(input_data, pipeline_fn=pipe, devices=["cpu"])
+    run_pipeline(input_data, pipeline_fn=pipe, devices=["cpu", "gpu"])
 
 
 def test_ssd_random_crop_op():
@@ -995,6 +1003,19 @@ def test_lookup_table():
     # TODO sequence
 
 
+def test_pack_bits():
+    def pipe(max_batch_size, input_data, device):
+        pipe = Pipeline(batch_size=max_batch_size, num_threads=4, device_id=0)
+        data = fn.external_source(source=input_data, cycle=False, device=device)
+        packed = fn.experimental.pack_bits(data)
+        pipe.set_outputs(packed, fn.experimental.unpack_bits(packed, dtype=types.BOOL))
+        return pipe
+
+    check_pipeline(
+        generate_data(31, 13, array_1d_shape_generator, lo=0, hi=2, dtype=np.uint8), pipe
+    )
+
+
 def test_reduce():
     reduce_fns = [fn.reductions.std_dev, fn.reductions.variance]
 
@@ -1699,6 +1720,7 @@ tested_methods = [
     "experimental.peek_image_shape",
     "experimental.remap",
     "experimental.resize",
+    "experimental.resize_crop_mirror_normalize",
     "experimental.warp_perspective",
     "external_source",
     "fast_resize_crop_mirror",
@@ -1716,6 +1738,8 @@ tested_methods = [
     "jpeg_compression_distortion",
     "laplacian",
     "lookup_table",
+    "experimental.pack_bits",
+    "experimental.unpack_bits",
     "math.abs",
     "math.acos",
     "math.acosh",
@@ -1795,6 +1819,7 @@ tested_methods = [
     "shapes",
     "slice",
     "spectrogram",
+    "experimental.log_mel_spectrogram",
     "sphere",
     "squeeze",
     "ssd_random_crop",
@@ -610,6 +610,19 @@ def test_spectrogram():
     )
 
 
+def test_log_mel_spectrogram():
+    get_data = GetData(audio_data)
+    check_single_input(
+        "experimental.log_mel_spectrogram",
+        fn_source=get_data.fn_source,
+        eager_source=get_data.eager_source,
+        layout=None,
+        nfft=60,
+        window_length=50,
+        window_step=25,
+    )
+
+
 @pipeline_def(batch_size=batch_size, num_threads=4, device_id=None)
 def mel_filter_pipeline(source):
     data = fn.external_source(source=source)
@@ -768,6 +781,37 @@ def test_lookup_table():
     )
 
 
+def test_pack_bits():
+    get_data = GetData(
+        [
+            [rng.integers(0, 2, size=[20, 10], dtype=np.uint8) for _ in range(batch_size)]
+            for _ in range(data_size)
+        ]
+    )
+    check_single_input(
+        "experimental.pack_bits",
+        fn_source=get_data.fn_source,
+        eager_source=get_data.eager_source,
+        layout=None,
+    )
+
+
+def test_unpack_bits():
+    get_data = GetData(
+        [
+            [rng.integers(0, 256, size=[20, 2], dtype=np.uint8) for _ in range(batch_size)]
+            for _ in range(data_size)
+        ]
+    )
+    check_single_input(
+        "experimental.unpack_bits",
+        count=10,
+        fn_source=get_data.fn_source,
+        eager_source=get_data.eager_source,
+        layout=None,
+    )
+
+
 @pipeline_def(batch_size=batch_size, num_threads=4, device_id=None)
 def slice_pipeline(get_anchor, get_shape):
     data = fn.external_source(source=get_data, layout="HWC")
@@ -1595,6 +1639,7 @@ tested_methods = [
     "preemphasis_filter",
     "power_spectrum",
     "spectrogram",
+    "experimental.log_mel_spectrogram",
     "mel_filter_bank",
     "to_decibels",
     "audio_resample",
@@ -1607,6 +1652,8 @@ tested_methods = [
     "warp_affine",
     "normalize",
     "lookup_table",
+    "experimental.pack_bits",
+    "experimental.unpack_bits",
     "slice",
     "pad",
     "readers.file",
@@ -1697,6 +1744,7 @@ excluded_methods = [
     "experimental.erode",  # not supported for CPU
     "experimental.warp_perspective",  # not supported for CPU
     "experimental.resize",  # not supported for CPU
+    "experimental.resize_crop_mirror_normalize",  # not supported for CPU
     "plugin.video.decoder",  # not supported for CPU
 ]
 
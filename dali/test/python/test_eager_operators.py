@@ -170,3 +170,22 @@ def test_mixed_devices_decoder():
     with eager.arithmetic():
         for comp_tensor in pipe_out == eager_out:
             assert np.all(comp_tensor.as_cpu())
+
+
+def test_operator_reused_for_smaller_batches():
+    from nvidia.dali._utils import eager_utils
+
+    def crop(batch_size):
+        data = tensors.TensorListCPU(np.full((batch_size, 16, 16, 3), batch_size, dtype=np.uint8))
+        return eager.crop(data, crop=[4, 4])
+
+    crop(8)
+    num_cached = len(eager_utils._stateless_operators_cache)
+    for batch_size in [5, 8, 1]:
+        out = crop(batch_size)
+        assert len(out) == batch_size
+        assert np.array_equal(out.as_array(), np.full((batch_size, 4, 4, 3), batch_size))
+    assert len(eager_utils._stateless_operators_cache) == num_cached
+    # a bigger batch needs a new instance, which replaces the old one
+    assert len(crop(10)) == 10
+    assert len(eager_utils._stateless_operators_cache) == num_cached
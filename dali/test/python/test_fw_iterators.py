@@ -1,4 +1,4 @@
-# Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2019-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -2738,6 +2738,66 @@ def test_mxnet_feed_ndarray():
     )
 
 
+@pipeline_def(batch_size=4, num_threads=2, device_id=0, experimental_exec_dynamic=True)
+def async_outputs_test_pipeline():
+    idx = fn.external_source(
+        source=lambda info: np.full((3,), info.idx_in_epoch, dtype=np.int32), batch=False
+    )
+    return idx.gpu() * 2, idx
+
+
+@attr("pytorch")
+def test_pytorch_async_outputs_pin_memory():
+    from nvidia.dali.plugin.pytorch import DALIGenericIterator as PyTorchIterator
+
+    pipe = async_outputs_test_pipeline()
+    it = PyTorchIterator(
+        pipe, output_map=["gpu", "cpu"], experimental_async_outputs=True, pin_memory=True
+    )
+    for i, data in zip(range(5), it):
+        out = data[0]
+        assert out["cpu"].is_pinned()
+        assert out["gpu"].is_cuda
+        expected = np.repeat(np.arange(i * 4, i * 4 + 4, dtype=np.int32)[:, np.newaxis], 3, axis=1)
+        np.testing.assert_equal(out["cpu"].numpy(), expected)
+        np.testing.assert_equal(out["gpu"].cpu().numpy(), expected * 2)
+
+
+@attr("pytorch")
+def test_pytorch_async_outputs_require_dynamic_executor():
+    from nvidia.dali.plugin.pytorch import DALIGenericIterator as PyTorchIterator
+
+    pipe = async_outputs_test_pipeline(experimental_exec_dynamic=False)
+    with assert_raises(ValueError, glob="*experimental_exec_dynamic=True*"):
+        PyTorchIterator(pipe, output_map=["gpu", "cpu"], experimental_async_outputs=True)
+
+
+@attr("paddle")
+def test_paddle_async_outputs_pin_memory():
+    from nvidia.dali.plugin.paddle import DALIGenericIterator as PaddleIterator
+
+    pipe = async_outputs_test_pipeline()
+    it = PaddleIterator(
+        pipe, output_map=["gpu", "cpu"], experimental_async_outputs=True, pin_memory=True
+    )
+    for i, data in zip(range(5), it):
+        out = data[0]
+        assert out["cpu"]._place().is_cuda_pinned_place()
+        assert out["gpu"]._place().is_gpu_place()
+        expected = np.repeat(np.arange(i * 4, i * 4 + 4, dtype=np.int32)[:, np.newaxis], 3, axis=1)
+        np.testing.assert_equal(np.array(out["cpu"]), expected)
+        np.testing.assert_equal(np.array(out["gpu"]), expected * 2)
+
+
+@attr("paddle")
+def test_paddle_async_outputs_require_dynamic_executor():
+    from nvidia.dali.plugin.paddle import DALIGenericIterator as PaddleIterator
+
+    pipe = async_outputs_test_pipeline(experimental_exec_dynamic=False)
+    with assert_raises(ValueError, glob="*experimental_exec_dynamic=True*"):
+        PaddleIterator(pipe, output_map=["gpu", "cpu"], experimental_async_outputs=True)
+
+
 @attr("pytorch")
 def test_pytorch_feed_ndarray():
     from nvidia.dali.plugin.pytorch import feed_ndarray
@@ -12,6 +12,8 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import os
+import tempfile
 from nvidia.dali.pipeline import Pipeline
 import nvidia.dali.ops as ops
 import nvidia.dali.types as types
@@ -37,12 +39,21 @@ def compare(tl1, tl2):
 
 
 class HybridDecoderPipeline(Pipeline):
-    def __init__(self, batch_size, num_threads, device_id, cache_size, decoder_type):
+    def __init__(
+        self,
+        batch_size,
+        num_threads,
+        device_id,
+        cache_size,
+        decoder_type,
+        policy="threshold",
+        cache_path="",
+        skip_cached_images=False,
+    ):
         super(HybridDecoderPipeline, self).__init__(batch_size, num_threads, device_id, seed=seed)
-        self.input = ops.readers.File(file_root=image_dir)
-        policy = None
-        if cache_size > 0:
-            policy = "threshold"
+        self.input = ops.readers.File(file_root=image_dir, skip_cached_images=skip_cached_images)
+        if cache_size == 0:
+            policy = None
         print("Decoder type:", decoder_type)
         decoder_module = (
             ops.experimental.decoders if "experimental" in decoder_type else ops.decoders
@@ -54,6 +65,7 @@ class HybridDecoderPipeline(Pipeline):
             cache_type=policy,
             cache_debug=False,
             cache_batch_copy=True,
+            cache_path=cache_path,
         )
 
     def define_graph(self):
@@ -64,9 +76,32 @@ class HybridDecoderPipeline(Pipeline):
 
 @params(("legacy",), ("experimental",))
 def test_nvjpeg_cached(decoder_type):
+    _test_cached(decoder_type, 100, "threshold")
+
+
+# the cache is too small for the whole dataset, so the images get evicted
+@params(("legacy", "lru"), ("experimental", "lru"), ("experimental", "lfu"))
+def test_nvjpeg_cached_evicting(decoder_type, policy):
+    _test_cached(decoder_type, 8, policy)
+
+
+@params(("legacy",), ("experimental",))
+def test_nvjpeg_cached_persistent(decoder_type):
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        cache_path = os.path.join(tmp_dir, "cache.bin")
+        # the first pipeline fills the cache file
+        _test_cached(decoder_type, 100, "persistent", cache_path)
+        assert os.path.getsize(cache_path) > 0
+        # the next one starts with all the images cached - the reader doesn't even read them
+        _test_cached(decoder_type, 100, "persistent", cache_path, skip_cached_images=True)
+
+
+def _test_cached(decoder_type, cache_size, policy, cache_path="", skip_cached_images=False):
     ref_pipe = HybridDecoderPipeline(batch_size, 1, 0, 0, decoder_type)
     ref_pipe.build()
-    cached_pipe = HybridDecoderPipeline(batch_size, 1, 0, 100, decoder_type)
+    cached_pipe = HybridDecoderPipeline(
+        batch_size, 1, 0, cache_size, decoder_type, policy, cache_path, skip_cached_images
+    )
     cached_pipe.build()
     epoch_size = ref_pipe.epoch_size("Reader")
 
@@ -81,6 +116,8 @@ def test_nvjpeg_cached(decoder_type):
         ref_images, _ = ref_pipe.run()
         out_images, _ = cached_pipe.run()
         compare(ref_images, out_images)
+    # release the cache
+    del cached_pipe
 
 
 def main():
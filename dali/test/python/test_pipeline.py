@@ -1,4 +1,4 @@
-# Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2017-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -1717,6 +1717,139 @@ def test_executor_meta():
             assert calc_avg_max(v["reserved_memory_size"]) == v["max_reserved_memory_size"]
 
 
+def test_executor_profile():
+    batch_size = 8
+    pipe = Pipeline(
+        batch_size, 1, 0, experimental_exec_dynamic=True, enable_memory_stats=True, seed=123
+    )
+    with pipe:
+        data = fn.random.uniform(range=[0, 1], shape=[100], name="uniform")
+        pipe.set_outputs(fn.cast(data.gpu(), dtype=types.FLOAT16, name="cast"))
+    pipe.build()
+    iters = 5
+    for _ in range(iters):
+        pipe.run()
+    meta = pipe.executor_statistics()
+    uniform = meta["uniform"]
+    cast = meta["cast"]
+    for op_meta in (uniform, cast):
+        assert op_meta["iterations"] >= iters
+        assert op_meta["cpu_time_us"] > 0
+        assert op_meta["wait_time_us"] >= 0
+    assert uniform["input_bytes"] == 0
+    assert uniform["output_bytes"] == uniform["iterations"] * batch_size * 100 * 4
+    assert cast["input_bytes"] == cast["iterations"] * batch_size * 100 * 4
+    assert cast["output_bytes"] == cast["iterations"] * batch_size * 100 * 2
+    assert cast["gpu_time_us"] > 0
+
+
+def test_executor_memory_breakdown():
+    batch_size = 8
+    pipe = Pipeline(
+        batch_size, 1, 0, experimental_exec_dynamic=True, enable_memory_stats=True, seed=123
+    )
+    with pipe:
+        data = fn.random.uniform(range=[0, 1], shape=[100], name="uniform")
+        pipe.set_outputs(fn.cast(data.gpu(), dtype=types.FLOAT16, name="cast"))
+    pipe.build()
+    for _ in range(5):
+        pipe.run()
+    meta = pipe.executor_statistics()
+    uniform = meta["uniform"]
+    cast = meta["cast"]
+    uniform_outputs = sum(u["peak"] for u in uniform["memory"]["output"].values())
+    assert uniform_outputs >= batch_size * 100 * 4
+    device_outputs = cast["memory"]["output"]["device"]
+    assert device_outputs["peak"] >= batch_size * 100 * 2
+    assert 0 <= device_outputs["current"] <= device_outputs["peak"]
+    assert cast["queue_slot_size"] >= batch_size * 100 * 2
+    assert 1 <= cast["queue_slots"] <= cast["max_queue_slots"]
+    # the output of "uniform" is copied to the GPU, so it's allocated in pinned memory
+    assert uniform["pinned"] == [True]
+    assert cast["pinned"] == [False]
+    assert "pinned" in uniform["memory"]["output"]
+
+
+def test_metrics():
+    from nvidia.dali import backend
+
+    backend.SetMetricsEnabled(True)
+    try:
+        pipe = Pipeline(8, 2, None, experimental_exec_dynamic=True, seed=123)
+        with pipe:
+            data = fn.random.uniform(range=[0, 1], shape=[100], name="metrics_uniform")
+            pipe.set_outputs(data)
+        pipe.build()
+        iters = 5
+        for _ in range(iters):
+            pipe.run()
+        metrics = backend.GetMetrics()
+        run_time = metrics["dali_operator_run_time_us"]['op="metrics_uniform"']
+        assert run_time["kind"] == "histogram"
+        assert run_time["count"] >= iters
+        assert sum(count for _, count in run_time["buckets"]) == run_time["count"]
+        text = backend.GetMetricsPrometheus()
+        assert "# TYPE dali_operator_run_time_us histogram" in text
+        assert 'dali_operator_run_time_us_count{op="metrics_uniform"}' in text
+    finally:
+        backend.SetMetricsEnabled(False)
+
+
+
+def test_exec_trace():
+    import json
+    import tempfile
+
+    pipe = Pipeline(8, 2, 0, experimental_exec_dynamic=True, seed=123)
+    with pipe:
+        data = fn.random.uniform(range=[0, 1], shape=[100], name="trace_uniform")
+        pipe.set_outputs(fn.cast(data.gpu(), dtype=types.FLOAT16, name="trace_cast"))
+    pipe.build()
+    pipe.enable_trace()
+    iters = 5
+    for _ in range(iters):
+        pipe.run()
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, "trace.json")
+        pipe.write_trace(path)
+        with open(path) as f:
+            events = json.load(f)["traceEvents"]
+
+    def spans(name, cat):
+        return [e for e in events if e["ph"] == "X" and e["name"] == name and e["cat"] == cat]
+
+    # the prefetched iterations may be recorded as well
+    assert len(spans("trace_uniform", "cpu")) >= iters
+    assert len(spans("trace_cast", "cpu")) >= iters
+    assert len(spans("trace_cast", "gpu")) >= iters
+    assert len([e for e in events if e["ph"] == "b" and e["cat"] == "iteration"]) == iters
+    # uniform -> gpu copy -> cast
+    assert len([e for e in events if e["ph"] == "f"]) >= 2 * iters
+
+
+def test_diagnose_bottleneck_consumer():
+    import time
+
+    pipe = Pipeline(8, 2, None, experimental_exec_dynamic=True, seed=123)
+    with pipe:
+        pipe.set_outputs(fn.random.uniform(range=[0, 1], shape=[100]))
+    pipe.build()
+    pipe.run()
+    pipe.diagnose_bottleneck(reset=True)
+    iters = 5
+    for _ in range(iters):
+        time.sleep(0.05)  # a slow consumer
+        pipe.run()
+    diag = pipe.diagnose_bottleneck()
+    assert diag["iterations"] == iters
+    assert diag["bottleneck"] == "consumer", diag
+    assert diag["verdict"].startswith("Consumer-bound")
+    assert diag["gpu_busy"] == 0  # there are no GPU operators
+    assert diag["window_time_us"] >= iters * 50000
+    # the window was reset
+    assert pipe.diagnose_bottleneck()["iterations"] == 0
+
+
 def test_bytes_per_sample_hint():
     import nvidia.dali.backend
 
@@ -2349,3 +2482,43 @@ def test_gpu2cpu_conditionals():
         (ref,) = ref_pipe.run()
         check_batch(cpu, ref, bs, 0, 0, "HWC")
         check_batch(gpu, ref, bs, 0, 0, "HWC")
+
+
+def test_build_all():
+    bs = 4
+    num_pipes = 4
+
+    @pipeline_def(batch_size=bs, num_threads=2, device_id=0)
+    def pdef(shard_id):
+        enc, label = fn.readers.file(file_root=jpeg_folder, shard_id=shard_id, num_shards=num_pipes)
+        img = fn.decoders.image(enc, device="mixed")
+        return fn.resize(img, size=(64, 64)), label
+
+    pipes = [pdef(i) for i in range(num_pipes)]
+    Pipeline.build_all(pipes + pipes[:1])  # duplicates are built once
+    Pipeline.build_all(pipes)  # the pipelines are already built - nothing happens
+    ref_pipes = [pdef(i) for i in range(num_pipes)]
+    for ref in ref_pipes:
+        ref.build()
+    for _ in range(3):
+        for pipe, ref in zip(pipes, ref_pipes):
+            img, label = pipe.run()
+            ref_img, ref_label = ref.run()
+            check_batch(img, ref_img, bs, 0, 0)
+            check_batch(label, ref_label, bs, 0, 0)
+
+
+def test_build_all_error():
+    @pipeline_def(batch_size=1, num_threads=1, device_id=None)
+    def pdef(fail):
+        data = fn.external_source(source=[np.zeros(3)], batch=False, cycle=True)
+        # the mutually exclusive arguments are rejected when the operator is instantiated
+        return fn.cat(data, axis=0, axis_name="A") if fail else data
+
+    pipes = [pdef(False), pdef(True), pdef(False)]
+    with assert_raises(RuntimeError):
+        Pipeline.build_all(pipes)
+    assert pipes[0]._built and pipes[2]._built
+    assert not pipes[1]._built
+    (out,) = pipes[0].run()
+    assert_array_equal(out.as_array(), np.zeros((1, 3)))
@@ -19,7 +19,7 @@ from nose.plugins.attrib import attr
 from nvidia.dali import fn
 from nvidia.dali import tensors
 from nvidia.dali import types
-from nvidia.dali.pipeline.experimental import pipeline_def
+from nvidia.dali.pipeline.experimental import pipeline_def, materialize
 from nose_utils import raises
 from test_utils import compare_pipelines, get_dali_extra_path
 from nose_utils import assert_raises
@@ -64,6 +64,36 @@ def test_debug_pipeline_base():
     compare_pipelines(pipe_standard, pipe_debug, 8, 10)
 
 
+def test_lazy_debug_pipeline_base():
+    pipe_standard = rn50_pipeline_base()
+    pipe_debug = rn50_pipeline_base(debug="lazy")
+    compare_pipelines(pipe_standard, pipe_debug, 8, 10)
+
+
+@pipeline_def(batch_size=8, num_threads=3, device_id=0)
+def materialized_pipeline():
+    jpegs, labels = fn.readers.file(file_root=file_root, shard_id=0, num_shards=2)
+    images = materialize(fn.decoders.image(jpegs, output_type=types.RGB), "images")
+    resized = fn.resize(images, resize_x=50, resize_y=50)
+    return resized, labels
+
+
+def test_lazy_debug_materialize():
+    for debug in [True, "lazy"]:
+        pipe_standard = load_images_pipeline()
+        pipe_standard.build()
+        pipe_debug = materialized_pipeline(debug=debug)
+        pipe_debug.build()
+        for _ in range(3):
+            ref_images, ref_labels = pipe_standard.run()
+            outputs = pipe_debug.run()
+            assert len(outputs) == 2
+            np.testing.assert_array_equal(ref_labels.as_array(), outputs[1].as_array())
+            images = pipe_debug.materialized("images")
+            for ref, img in zip(ref_images, images):
+                np.testing.assert_array_equal(np.array(ref), np.array(img))
+
+
 @pipeline_def(batch_size=8, num_threads=3, device_id=0, debug=True)
 def rn50_pipeline():
     rng = fn.random.coin_flip(probability=0.5, seed=47)
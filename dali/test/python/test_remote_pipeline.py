@@ -0,0 +1,99 @@
+# Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import threading
+
+import numpy as np
+import nvidia.dali.fn as fn
+import nvidia.dali.types as types
+from nvidia.dali import pipeline_def
+from nvidia.dali.experimental import remote
+from nose_utils import assert_raises
+
+
+@pipeline_def(batch_size=4, num_threads=2, device_id=None, seed=123, enable_checkpointing=True)
+def remote_pipe():
+    shape = fn.random.uniform(range=[1, 5], shape=[2], dtype=types.INT32)
+    data = fn.random.uniform(range=[0, 1], shape=shape)
+    return data, fn.shapes(data)
+
+
+def start_server(num_connections, factory=None):
+    if factory is None:
+
+        def factory(checkpoint):
+            return remote_pipe(checkpoint=checkpoint)
+
+    server = remote.PipelineServer(factory, ("localhost", 0))
+    thread = threading.Thread(target=server.serve, args=(num_connections,), daemon=True)
+    thread.start()
+    return server
+
+
+def check_batch(batch, ref_pipe):
+    data, shapes = ref_pipe.run()
+    assert len(batch) == 2
+    for i in range(4):
+        np.testing.assert_array_equal(batch[0][i], np.array(data[i]))
+        np.testing.assert_array_equal(batch[1][i], np.array(shapes[i]))
+
+
+def test_remote_source_resume():
+    server = start_server(2)
+    ref_pipe = remote_pipe()
+    ref_pipe.build()
+
+    source = remote.RemoteSource(server.address)
+    for _ in range(3):
+        check_batch(source(), ref_pipe)
+    checkpoint = source.checkpoint()
+    source.close()
+
+    # the new connection continues right after the last batch returned by the source
+    source = remote.RemoteSource(server.address, checkpoint=checkpoint)
+    for _ in range(2):
+        check_batch(source(), ref_pipe)
+    source.close()
+    server.close()
+
+
+def test_remote_source_external_source():
+    server = start_server(1)
+    source = remote.RemoteSource(server.address)
+
+    @pipeline_def(batch_size=4, num_threads=2, device_id=None)
+    def consumer_pipe():
+        data, shapes = fn.external_source(source, num_outputs=2, batch=True)
+        return fn.shapes(data), shapes
+
+    pipe = consumer_pipe()
+    pipe.build()
+    for _ in range(2):
+        shapes, ref_shapes = pipe.run()
+        for i in range(4):
+            np.testing.assert_array_equal(np.array(shapes[i]), np.array(ref_shapes[i]))
+    source.close()
+    server.close()
+
+
+def test_remote_source_error():
+    def factory(checkpoint):
+        raise ValueError("no pipeline")
+
+    server = start_server(1, factory)
+    source = remote.RemoteSource(server.address)
+    with assert_raises(RuntimeError, glob="*ValueError: no pipeline*"):
+        source()
+    source.close()
+    server.close()
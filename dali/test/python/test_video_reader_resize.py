@@ -146,3 +146,34 @@ def test_video_resize(batch_size=2):
     for vp in video_reader_params:
         for rp in resize_params:
             yield run_for_params, batch_size, vp, rp
+
+
+def test_video_resize_hw():
+    batch_size = 2
+    vp = video_reader_params[0]
+    rp = {"resize_x": 224, "resize_y": 128}
+    pipeline = video_reader_resize_pipeline(batch_size, vp, {**rp, "hw_resize": True})
+    gt_pipeline = ground_truth_pipeline(batch_size, vp, rp)
+    (batch_gpu,) = pipeline.run()
+    batch = batch_gpu.as_cpu()
+    for sample_id in range(batch_size):
+        sample = batch.at(sample_id)
+        for frame_id in range(vp["sequence_length"]):
+            frame = sample[frame_id]
+            gt_frame = gt_pipeline.run()[0].as_cpu().as_array()[0]
+            assert gt_frame.shape == frame.shape, f"{gt_frame.shape} != {frame.shape}"
+            # the decoder uses its own filter
+            diff = np.abs(gt_frame.astype(np.float32) - frame.astype(np.float32))
+            assert np.mean(diff) < 8, f"Mean difference too large: {np.mean(diff)}"
+    gc.collect()
+
+
+def test_video_resize_hw_fallback():
+    # not a resize to a fixed size - the regular resize is used
+    rp = {"resize_shorter": 300, "interp_type": types.DALIInterpType.INTERP_CUBIC}
+    batch_size = 2
+    vp = video_reader_params[0]
+    pipeline = video_reader_resize_pipeline(batch_size, vp, {**rp, "hw_resize": True})
+    gt_pipeline = ground_truth_pipeline(batch_size, vp, rp)
+    compare_video_resize_pipelines(pipeline, gt_pipeline, batch_size, vp["sequence_length"])
+    gc.collect()
@@ -40,6 +40,7 @@ def webdataset_raw_pipeline(
     lazy_init=False,
     read_ahead=False,
     stick_to_shard=False,
+    index_cache_dir=None,
 ):
     out = readers.webdataset(
         paths=paths,
@@ -57,6 +58,7 @@ def webdataset_raw_pipeline(
         pad_last_batch=pad_last_batch,
         lazy_init=lazy_init,
         read_ahead=read_ahead,
+        index_cache_dir=index_cache_dir,
     )
     return out if not isinstance(out, list) else tuple(out)
 
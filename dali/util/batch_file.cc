@@ -0,0 +1,257 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/util/batch_file.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include "dali/core/error_handling.h"
+#include "dali/core/util.h"
+#include "dali/pipeline/data/types.h"
+
+namespace dali {
+
+namespace {
+
+constexpr char kMagic[8] = { 'D', 'A', 'L', 'I', 'B', 'A', 'T', 'F' };
+constexpr uint32_t kVersion = 1;
+
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t alignment;
+};
+
+struct RecordHeader {
+  uint64_t record_size;  // the size of the whole record, including the padding
+  uint64_t data_offset;  // the offset of the sample data, relative to the record
+  uint64_t data_size;
+  int32_t num_samples;
+  int32_t sample_dim;
+  int32_t type;
+  int32_t layout_size;
+};
+
+/** The size of the record header, the layout and the shapes. */
+inline int64_t MetadataSize(int layout_size, int num_samples, int sample_dim) {
+  return align_up<int64_t>(sizeof(RecordHeader) + layout_size, sizeof(int64_t)) +
+         static_cast<int64_t>(num_samples) * sample_dim * sizeof(int64_t);
+}
+
+inline int64_t ShapesOffset(int layout_size) {
+  return align_up<int64_t>(sizeof(RecordHeader) + layout_size, sizeof(int64_t));
+}
+
+}  // namespace
+
+BatchFileWriter::BatchFileWriter(const std::string &path) : path_(path) {
+  fd_ = open(path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  DALI_ENFORCE(fd_ >= 0, make_string("Cannot open the batch file \"", path_, "\": ",
+                                     std::strerror(errno)));
+  FileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.alignment = kBatchFileAlignment;
+  try {
+    WriteBytes(&header, sizeof(header));
+    Pad();
+  } catch (...) {
+    close(fd_);
+    throw;
+  }
+}
+
+BatchFileWriter::~BatchFileWriter() {
+  try {
+    Close();
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+  }
+}
+
+void BatchFileWriter::Close() {
+  if (fd_ < 0)
+    return;
+  int ret = close(fd_);
+  fd_ = -1;
+  DALI_ENFORCE(ret == 0, make_string("Cannot close the batch file \"", path_, "\": ",
+                                     std::strerror(errno)));
+}
+
+void BatchFileWriter::WriteBytes(const void *data, int64_t size) {
+  auto *bytes = static_cast<const uint8_t *>(data);
+  while (size > 0) {
+    ssize_t written = write(fd_, bytes, size);
+    if (written < 0 && errno == EINTR)
+      continue;
+    DALI_ENFORCE(written > 0, make_string("Cannot write to the batch file \"", path_, "\": ",
+                                          std::strerror(errno)));
+    bytes += written;
+    size -= written;
+    offset_ += written;
+  }
+}
+
+void BatchFileWriter::Pad() {
+  static const uint8_t zeros[kBatchFileAlignment] = {};
+  int64_t padding = align_up(offset_, kBatchFileAlignment) - offset_;
+  if (padding)
+    WriteBytes(zeros, padding);
+}
+
+void BatchFileWriter::Write(const TensorList<CPUBackend> &batch) {
+  DALI_ENFORCE(fd_ >= 0, make_string("The batch file \"", path_, "\" is closed."));
+  DALI_ENFORCE(batch.type() != DALI_NO_TYPE, "Cannot write a batch without a type.");
+  const auto &shape = batch.shape();
+  int num_samples = shape.num_samples();
+  int sample_dim = shape.sample_dim();
+  const auto &layout = batch.GetLayout();
+  int64_t type_size = TypeTable::GetTypeInfo(batch.type()).size();
+
+  RecordHeader header{};
+  header.num_samples = num_samples;
+  header.sample_dim = sample_dim;
+  header.type = batch.type();
+  header.layout_size = layout.size();
+  header.data_offset = align_up(MetadataSize(layout.size(), num_samples, sample_dim),
+                                kBatchFileAlignment);
+  header.data_size = shape.num_elements() * type_size;
+  header.record_size = header.data_offset + align_up<int64_t>(header.data_size,
+                                                              kBatchFileAlignment);
+
+  std::vector<uint8_t> metadata(header.data_offset);
+  std::memcpy(metadata.data(), &header, sizeof(header));
+  std::memcpy(metadata.data() + sizeof(header), layout.c_str(), layout.size());
+  std::memcpy(metadata.data() + ShapesOffset(layout.size()), shape.shapes.data(),
+              shape.shapes.size() * sizeof(int64_t));
+  WriteBytes(metadata.data(), metadata.size());
+
+  for (int i = 0; i < num_samples; i++)
+    WriteBytes(batch.raw_tensor(i), shape.tensor_size(i) * type_size);
+  Pad();
+  num_batches_++;
+}
+
+BatchFileReader::BatchFileReader(const std::string &path) : path_(path) {
+  int fd = open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+  DALI_ENFORCE(fd >= 0, make_string("Cannot open the batch file \"", path_, "\": ",
+                                    std::strerror(errno)));
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    int err = errno;
+    close(fd);
+    DALI_FAIL(make_string("Cannot stat the batch file \"", path_, "\": ", std::strerror(err)));
+  }
+  size_ = st.st_size;
+  if (size_ < static_cast<int64_t>(sizeof(FileHeader))) {
+    close(fd);
+    DALI_FAIL(make_string("\"", path_, "\" is not a DALI batch file."));
+  }
+  // A private mapping: the batches can be modified in place without affecting the file
+  // (the modified pages are copied on write).
+  void *ptr = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  int err = errno;
+  close(fd);
+  DALI_ENFORCE(ptr != MAP_FAILED, make_string("Cannot map the batch file \"", path_, "\": ",
+                                              std::strerror(err)));
+  mapping_ = std::shared_ptr<uint8_t>(static_cast<uint8_t *>(ptr), [size = size_](uint8_t *p) {
+    munmap(p, size);
+  });
+
+  FileHeader file_header;
+  std::memcpy(&file_header, mapping_.get(), sizeof(file_header));
+  DALI_ENFORCE(std::memcmp(file_header.magic, kMagic, sizeof(kMagic)) == 0,
+               make_string("\"", path_, "\" is not a DALI batch file."));
+  DALI_ENFORCE(file_header.version == kVersion,
+               make_string("Unsupported version of the batch file \"", path_, "\": ",
+                           file_header.version));
+  DALI_ENFORCE(file_header.alignment > 0, make_string("The batch file \"", path_,
+                                                      "\" is corrupted."));
+
+  auto corrupted = [&]() {
+    return make_string("The batch file \"", path_, "\" is corrupted or truncated.");
+  };
+
+  int64_t offset = align_up<int64_t>(sizeof(FileHeader), file_header.alignment);
+  while (offset < size_) {
+    RecordHeader header;
+    DALI_ENFORCE(offset + static_cast<int64_t>(sizeof(header)) <= size_, corrupted());
+    std::memcpy(&header, mapping_.get() + offset, sizeof(header));
+    DALI_ENFORCE(header.num_samples >= 0 && header.sample_dim >= 0 &&
+                 header.layout_size >= 0 && header.layout_size <= header.sample_dim,
+                 corrupted());
+    int64_t metadata_size = MetadataSize(header.layout_size, header.num_samples,
+                                         header.sample_dim);
+    DALI_ENFORCE(header.record_size > 0 &&
+                 static_cast<int64_t>(header.record_size) <= size_ - offset &&
+                 static_cast<int64_t>(header.data_offset) >= metadata_size &&
+                 header.data_offset + header.data_size <= header.record_size,
+                 corrupted());
+
+    BatchInfo info;
+    info.type = static_cast<DALIDataType>(header.type);
+    const uint8_t *record = mapping_.get() + offset;
+    info.layout = TensorLayout(reinterpret_cast<const char *>(record + sizeof(header)),
+                               header.layout_size);
+    info.shape.resize(header.num_samples, header.sample_dim);
+    std::memcpy(info.shape.shapes.data(), record + ShapesOffset(header.layout_size),
+                info.shape.shapes.size() * sizeof(int64_t));
+    int64_t type_size = TypeTable::GetTypeInfo(info.type).size();
+    DALI_ENFORCE(info.shape.num_elements() * type_size ==
+                 static_cast<int64_t>(header.data_size), corrupted());
+    info.data_offset = offset + header.data_offset;
+    info.data_size = header.data_size;
+    batches_.push_back(std::move(info));
+    offset += header.record_size;
+  }
+}
+
+const BatchFileReader::BatchInfo &BatchFileReader::Info(int idx) const {
+  DALI_ENFORCE(idx >= 0 && idx < num_batches(),
+               make_string("Batch index ", idx, " out of range [0, ", num_batches(),
+                           ") in the batch file \"", path_, "\"."));
+  return batches_[idx];
+}
+
+TensorList<CPUBackend> BatchFileReader::Batch(int idx) const {
+  auto &info = Info(idx);
+  TensorList<CPUBackend> batch;
+  std::shared_ptr<void> data(mapping_, mapping_.get() + info.data_offset);
+  batch.ShareData(std::move(data), info.data_size, false, info.shape, info.type,
+                  CPU_ONLY_DEVICE_ID, AccessOrder::host(), info.layout);
+  return batch;
+}
+
+BatchFileReader::DataRange BatchFileReader::Data(int idx) const {
+  auto &info = Info(idx);
+  return { info.data_offset, info.data_size };
+}
+
+const TensorListShape<> &BatchFileReader::Shape(int idx) const {
+  return Info(idx).shape;
+}
+
+DALIDataType BatchFileReader::Type(int idx) const {
+  return Info(idx).type;
+}
+
+const TensorLayout &BatchFileReader::Layout(int idx) const {
+  return Info(idx).layout;
+}
+
+}  // namespace dali
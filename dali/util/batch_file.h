@@ -0,0 +1,119 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_UTIL_BATCH_FILE_H_
+#define DALI_UTIL_BATCH_FILE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "dali/core/api_helper.h"
+#include "dali/core/tensor_layout.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/pipeline/data/tensor_list.h"
+
+namespace dali {
+
+/**
+ * @brief A file holding a sequence of batches (TensorLists), e.g. a shard of a preprocessed
+ *        dataset.
+ *
+ * The file starts with a header, followed by the batch records. Each record has a header,
+ * the metadata (layout and sample shapes) and the sample data, stored contiguously.
+ * The records and the sample data of each record start at kBatchFileAlignment
+ * boundaries, so the data can be mapped or read with O_DIRECT or GPUDirect Storage.
+ * All the values are stored in the native (little-endian) byte order.
+ */
+constexpr int64_t kBatchFileAlignment = 4096;
+
+/**
+ * @brief Appends batches to a batch file.
+ *
+ * The file is created (or truncated) when the writer is constructed. A record is complete
+ * when `Write` returns.
+ */
+class DLL_PUBLIC BatchFileWriter {
+ public:
+  explicit BatchFileWriter(const std::string &path);
+  ~BatchFileWriter();
+
+  BatchFileWriter(const BatchFileWriter &) = delete;
+  BatchFileWriter &operator=(const BatchFileWriter &) = delete;
+
+  /** Appends a batch; the samples don't need to be contiguous. */
+  void Write(const TensorList<CPUBackend> &batch);
+
+  /** Closes the file; no more batches can be written. */
+  void Close();
+
+  int64_t num_batches() const noexcept { return num_batches_; }
+
+ private:
+  void WriteBytes(const void *data, int64_t size);
+  void Pad();
+
+  std::string path_;
+  int fd_ = -1;
+  int64_t offset_ = 0;
+  int64_t num_batches_ = 0;
+};
+
+/**
+ * @brief Reads batches from a batch file, without copying the data.
+ *
+ * The file is memory-mapped; the batches returned by the reader share the mapping, which
+ * stays valid as long as any of them (or the reader) exists.
+ */
+class DLL_PUBLIC BatchFileReader {
+ public:
+  explicit BatchFileReader(const std::string &path);
+
+  int num_batches() const noexcept { return batches_.size(); }
+
+  /** Returns the batch with the given index; the batch is contiguous and refers to the file. */
+  TensorList<CPUBackend> Batch(int idx) const;
+
+  /** The location of the sample data of a batch in the file, e.g. for reading it with GDS. */
+  struct DataRange {
+    int64_t offset, size;
+  };
+
+  DataRange Data(int idx) const;
+
+  const TensorListShape<> &Shape(int idx) const;
+
+  DALIDataType Type(int idx) const;
+
+  const TensorLayout &Layout(int idx) const;
+
+ private:
+  struct BatchInfo {
+    TensorListShape<> shape;
+    DALIDataType type;
+    TensorLayout layout;
+    int64_t data_offset, data_size;
+  };
+
+  const BatchInfo &Info(int idx) const;
+
+  std::string path_;
+  std::shared_ptr<uint8_t> mapping_;
+  int64_t size_ = 0;
+  std::vector<BatchInfo> batches_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_UTIL_BATCH_FILE_H_
@@ -0,0 +1,133 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "dali/util/batch_file.h"
+
+namespace dali {
+
+namespace {
+
+class BatchFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    filename_ = "/tmp/dali_batch_file_test_XXXXXX";
+    int fd = mkstemp(&filename_[0]);
+    ASSERT_NE(-1, fd);
+    close(fd);
+  }
+
+  void TearDown() override {
+    std::remove(filename_.c_str());
+  }
+
+  std::string filename_;
+};
+
+void FillBatch(TensorList<CPUBackend> &tl, const TensorListShape<> &shape, int base) {
+  tl.set_pinned(false);
+  tl.Resize(shape, DALI_INT16);
+  for (int i = 0; i < tl.num_samples(); i++) {
+    auto *data = tl.mutable_tensor<int16_t>(i);
+    for (int64_t j = 0; j < shape.tensor_size(i); j++)
+      data[j] = base + 100 * i + j;
+  }
+}
+
+}  // namespace
+
+TEST_F(BatchFileTest, WriteRead) {
+  TensorListShape<> shape0 = {{2, 3, 1}, {4, 1, 1}, {0, 5, 1}};
+  TensorListShape<> shape1 = {{7}, {1}};
+  {
+    TensorList<CPUBackend> tl0, tl1, empty;
+    FillBatch(tl0, shape0, 0);
+    tl0.SetLayout("HWC");
+    tl1.set_pinned(false);
+    tl1.SetContiguity(BatchContiguity::Noncontiguous);
+    FillBatch(tl1, shape1, 1000);
+    empty.set_pinned(false);
+    empty.Resize(TensorListShape<>(0, 2), DALI_FLOAT);
+
+    BatchFileWriter writer(filename_);
+    writer.Write(tl0);
+    writer.Write(tl1);
+    writer.Write(empty);
+    EXPECT_EQ(writer.num_batches(), 3);
+  }
+
+  BatchFileReader reader(filename_);
+  ASSERT_EQ(reader.num_batches(), 3);
+  EXPECT_EQ(reader.Shape(0), shape0);
+  EXPECT_EQ(reader.Layout(0), "HWC");
+  EXPECT_EQ(reader.Type(1), DALI_INT16);
+
+  TensorList<CPUBackend> expected;
+  for (int b = 0; b < 2; b++) {
+    const auto &shape = b == 0 ? shape0 : shape1;
+    FillBatch(expected, shape, 1000 * b);
+    auto range = reader.Data(b);
+    EXPECT_EQ(range.offset % kBatchFileAlignment, 0);
+    EXPECT_EQ(range.size, shape.num_elements() * 2);
+
+    auto batch = reader.Batch(b);
+    ASSERT_EQ(batch.shape(), shape);
+    EXPECT_TRUE(batch.IsContiguousInMemory());
+    EXPECT_FALSE(batch.is_pinned());
+    for (int i = 0; i < shape.num_samples(); i++) {
+      EXPECT_EQ(std::memcmp(batch.tensor<int16_t>(i), expected.tensor<int16_t>(i),
+                            shape.tensor_size(i) * sizeof(int16_t)), 0);
+    }
+  }
+  EXPECT_EQ(reader.Shape(2), TensorListShape<>(0, 2));
+  EXPECT_EQ(reader.Type(2), DALI_FLOAT);
+  EXPECT_THROW(reader.Batch(3), std::runtime_error);
+}
+
+TEST_F(BatchFileTest, BatchOutlivesReader) {
+  TensorList<CPUBackend> tl;
+  FillBatch(tl, {{10}, {20}}, 5);
+  BatchFileWriter(filename_).Write(tl);
+
+  TensorList<CPUBackend> batch;
+  {
+    BatchFileReader reader(filename_);
+    batch = reader.Batch(0);
+  }
+  EXPECT_EQ(batch.tensor<int16_t>(1)[3], 5 + 100 + 3);
+  // the mapping is private - writing to the batch doesn't change the file
+  batch.mutable_tensor<int16_t>(0)[0] = -1;
+  EXPECT_EQ(BatchFileReader(filename_).Batch(0).tensor<int16_t>(0)[0], 5);
+}
+
+TEST_F(BatchFileTest, Errors) {
+  FILE *f = std::fopen(filename_.c_str(), "wb");
+  ASSERT_NE(f, nullptr);
+  std::fputs("not a batch file, but long enough to have a header", f);
+  std::fclose(f);
+  EXPECT_THROW(BatchFileReader{filename_}, std::runtime_error);
+
+  TensorList<CPUBackend> tl;
+  FillBatch(tl, {{1000}}, 0);
+  BatchFileWriter(filename_).Write(tl);
+  // cut the last record
+  ASSERT_EQ(truncate(filename_.c_str(), kBatchFileAlignment * 2 + 100), 0);
+  EXPECT_THROW(BatchFileReader{filename_}, std::runtime_error);
+}
+
+}  // namespace dali
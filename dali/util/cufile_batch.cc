@@ -0,0 +1,162 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/util/cufile_batch.h"
+#include <time.h>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/util/std_cufile.h"
+
+namespace dali {
+
+namespace {
+
+// the default limit of the number of requests in a batch (`io_batchsize` in cufile.json)
+constexpr int kMaxBatchSize = 128;
+
+void *slot_to_cookie(int slot) {
+  return reinterpret_cast<void *>(static_cast<intptr_t>(slot));
+}
+
+int cookie_to_slot(void *cookie) {
+  return static_cast<int>(reinterpret_cast<intptr_t>(cookie));
+}
+
+}  // namespace
+
+bool CUFileBatchReader::IsSupported() {
+  static const bool supported = cuFileIsSymbolAvailable("cuFileBatchIOSetUp") &&
+                                cuFileIsSymbolAvailable("cuFileBatchIOSubmit") &&
+                                cuFileIsSymbolAvailable("cuFileBatchIOGetStatus") &&
+                                cuFileIsSymbolAvailable("cuFileBatchIODestroy");
+  return supported;
+}
+
+CUFileBatchReader::CUFileBatchReader(int queue_depth)
+    : queue_depth_(std::clamp(queue_depth, 1, kMaxBatchSize)) {
+  if (IsSupported()) {
+    CUfileError_t status = cuFileBatchIOSetUp(&batch_, queue_depth_);
+    if (status.err != CU_FILE_SUCCESS) {
+      DALI_WARN(make_string("Cannot set up cuFile batch I/O (", CUFileError::ErrorString(status),
+                            "). The reads will be issued one by one."));
+      batch_ = nullptr;
+    }
+  }
+  requests_.resize(queue_depth_);
+  events_.resize(queue_depth_);
+  pending_.reserve(queue_depth_);
+  free_slots_.reserve(queue_depth_);
+  for (int i = queue_depth_ - 1; i >= 0; i--)
+    free_slots_.push_back(i);
+}
+
+CUFileBatchReader::~CUFileBatchReader() {
+  if (!batch_)
+    return;
+  // we may get here due to an exception - the buffers may be gone soon, so don't let the driver
+  // write to them
+  if (in_flight_ > 0)
+    cuFileBatchIOCancel(batch_);
+  cuFileBatchIODestroy(batch_);
+}
+
+void CUFileBatchReader::Read(CUFileStream *file, void *buffer, size_t n_bytes,
+                             ptrdiff_t buffer_offset, int64_t file_offset, Callback on_complete) {
+  auto *std_file = dynamic_cast<StdCUFileStream *>(file);
+  if (!batch_ || !std_file) {
+    file->ReadAtGPU(buffer, n_bytes, buffer_offset, file_offset);
+    if (on_complete)
+      on_complete();
+    return;
+  }
+
+  if (free_slots_.empty()) {
+    Submit();
+    Reap(1);
+  }
+  int slot = free_slots_.back();
+  free_slots_.pop_back();
+  requests_[slot] = { file, buffer, n_bytes, buffer_offset, file_offset, std::move(on_complete) };
+
+  CUfileIOParams_t params;
+  memset(&params, 0, sizeof(params));
+  params.mode = CUFILE_BATCH;
+  params.u.batch.devPtr_base = buffer;
+  params.u.batch.devPtr_offset = buffer_offset;
+  params.u.batch.file_offset = file_offset;
+  params.u.batch.size = n_bytes;
+  params.fh = std_file->handle().cufh;
+  params.opcode = CUFILE_READ;
+  params.cookie = slot_to_cookie(slot);
+  pending_.push_back(params);
+
+  // submit in groups, to amortize the cost of the call, but without waiting for the whole queue
+  if (pending_.size() >= static_cast<size_t>(std::max(1, queue_depth_ / 4)))
+    Submit();
+}
+
+void CUFileBatchReader::Submit() {
+  if (pending_.empty())
+    return;
+  CUDA_CALL(cuFileBatchIOSubmit(batch_, pending_.size(), pending_.data(), 0));
+  in_flight_ += pending_.size();
+  pending_.clear();
+}
+
+void CUFileBatchReader::Wait() {
+  if (!batch_)
+    return;
+  Submit();
+  while (in_flight_ > 0)
+    Reap(in_flight_);
+}
+
+void CUFileBatchReader::Reap(unsigned min_nr) {
+  unsigned reaped = 0;
+  while (reaped < min_nr) {
+    unsigned nr = events_.size();
+    timespec timeout = { 1, 0 };
+    CUDA_CALL(cuFileBatchIOGetStatus(batch_, min_nr - reaped, &nr, events_.data(), &timeout));
+    for (unsigned i = 0; i < nr; i++) {
+      auto &event = events_[i];
+      int slot = cookie_to_slot(event.cookie);
+      in_flight_--;
+      free_slots_.push_back(slot);
+      if (event.status != CUFILE_COMPLETE) {
+        auto &req = requests_[slot];
+        DALI_FAIL("CUFile batch read failed for file ", req.file->path(), " at offset ",
+                  req.file_offset, " with status ", static_cast<int>(event.status));
+      }
+      Complete(slot, event.ret);
+    }
+    reaped += nr;
+  }
+}
+
+void CUFileBatchReader::Complete(int slot, size_t bytes_read) {
+  auto req = std::move(requests_[slot]);
+  requests_[slot] = {};
+  if (bytes_read < req.n_bytes) {
+    // short read - get the rest synchronously
+    req.file->ReadAtGPU(req.buffer, req.n_bytes - bytes_read,
+                        req.buffer_offset + bytes_read, req.file_offset + bytes_read);
+  }
+  if (req.on_complete)
+    req.on_complete();
+}
+
+}  // namespace dali
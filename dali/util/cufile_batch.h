@@ -0,0 +1,98 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_UTIL_CUFILE_BATCH_H_
+#define DALI_UTIL_CUFILE_BATCH_H_
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/core/dynlink_cufile.h"
+#include "dali/util/cufile.h"
+
+namespace dali {
+
+/**
+ * @brief Reads data from files to GPU memory with cuFile batch API
+ *
+ * The reads are collected and submitted to the driver in groups, keeping up to `queue_depth`
+ * requests in flight. When a read completes, its callback is invoked - always in the thread which
+ * calls `Read` or `Wait`.
+ *
+ * If the batch API is not available (older GDS), the reads are done synchronously in `Read`.
+ *
+ * The object is not thread-safe.
+ */
+class DLL_PUBLIC CUFileBatchReader {
+ public:
+  using Callback = std::function<void()>;
+
+  explicit CUFileBatchReader(int queue_depth);
+  ~CUFileBatchReader();
+
+  CUFileBatchReader(const CUFileBatchReader &) = delete;
+  CUFileBatchReader &operator=(const CUFileBatchReader &) = delete;
+
+  /**
+   * @brief Checks if the cuFile library provides the batch API.
+   */
+  static bool IsSupported();
+
+  /**
+   * @brief Schedules a read of `n_bytes` from `file_offset` in the file to `buffer + buffer_offset`
+   *
+   * The `buffer` must be a base address of a buffer registered with cuFile (or not registered
+   * at all) and must stay valid until `on_complete` is called.
+   * If the queue is full, the function waits for some of the pending reads to complete.
+   */
+  void Read(CUFileStream *file, void *buffer, size_t n_bytes,
+            ptrdiff_t buffer_offset, int64_t file_offset, Callback on_complete = {});
+
+  /**
+   * @brief Submits the collected reads and waits for all the pending reads to complete.
+   */
+  void Wait();
+
+  int queue_depth() const {
+    return queue_depth_;
+  }
+
+ private:
+  struct Request {
+    CUFileStream *file = nullptr;
+    void *buffer = nullptr;
+    size_t n_bytes = 0;
+    ptrdiff_t buffer_offset = 0;
+    int64_t file_offset = 0;
+    Callback on_complete;
+  };
+
+  void Submit();
+  void Reap(unsigned min_nr);
+  void Complete(int slot, size_t bytes_read);
+
+  int queue_depth_ = 0;
+  CUfileBatchHandle_t batch_ = nullptr;
+  int in_flight_ = 0;
+  std::vector<Request> requests_;
+  std::vector<int> free_slots_;
+  std::vector<CUfileIOParams_t> pending_;
+  std::vector<CUfileIOEvents_t> events_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_UTIL_CUFILE_BATCH_H_
@@ -12,13 +12,17 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
 #include <string>
+#include <utility>
 
 #include "dali/util/file.h"
 #include "dali/util/mmaped_file.h"
 #include "dali/util/odirect_file.h"
 #include "dali/util/std_file.h"
+#include "dali/util/throttled_file.h"
 #include "dali/util/uri.h"
+#include "dali/util/uring_file.h"
 
 #if AWSSDK_ENABLED
 #include "dali/util/s3_client_manager.h"
@@ -32,7 +36,8 @@ std::unique_ptr<FileStream> FileStream::Open(const std::string& uri, FileStream:
   bool is_s3 = uri.rfind("s3://", 0) == 0;
   if (is_s3) {
 #if AWSSDK_ENABLED
-    return std::make_unique<S3FileStream>(S3ClientManager::Instance().client(), uri, size);
+    return std::make_unique<S3FileStream>(S3ClientManager::Instance().client(), uri, size,
+                                          opts.read_ahead);
 #else
     throw std::runtime_error("This version of DALI was not built with AWS S3 storage support.");
 #endif
@@ -45,13 +50,25 @@ std::unique_ptr<FileStream> FileStream::Open(const std::string& uri, FileStream:
     processed_uri = uri;
   }
 
+  // The readers access O_DIRECT and io_uring streams through their concrete types,
+  // so these are never wrapped in a ThrottledFileStream
+  if (!opts.use_mmap) {
+    if (opts.use_odirect)
+      return std::unique_ptr<FileStream>(new ODirectFileStream(processed_uri));
+    else if (opts.use_io_uring)
+      return std::unique_ptr<FileStream>(new UringFileStream(processed_uri));
+  }
+
+  std::unique_ptr<FileStream> stream;
   if (opts.use_mmap) {
-    return std::unique_ptr<FileStream>(new MmapedFileStream(processed_uri, opts.read_ahead));
-  } else if (opts.use_odirect) {
-    return std::unique_ptr<FileStream>(new ODirectFileStream(processed_uri));
+    stream.reset(new MmapedFileStream(processed_uri, opts.read_ahead));
   } else {
-    return std::unique_ptr<FileStream>(new StdFileStream(processed_uri));
+    stream.reset(new StdFileStream(processed_uri));
   }
+  auto sim = GetStorageSimulation();
+  if (sim.enabled())
+    stream = std::make_unique<ThrottledFileStream>(std::move(stream), sim);
+  return stream;
 }
 
 bool FileStream::ReserveFileMappings(unsigned int num) {
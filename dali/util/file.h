@@ -27,6 +27,16 @@
 
 namespace dali {
 
+// Defined outside of FileStream, so that the default member initializers can be used
+// in the default arguments of FileStream's methods
+struct FileStreamOptions {
+  bool read_ahead;
+  bool use_mmap;
+  bool use_odirect;
+  /// Open the file as UringFileStream, so it can be read with batched io_uring submissions
+  bool use_io_uring = false;
+};
+
 class DLL_PUBLIC FileStream : public InputStream {
  public:
   class MappingReserver {
@@ -72,11 +82,7 @@ class DLL_PUBLIC FileStream : public InputStream {
     unsigned int reserved;
   };
 
-  struct Options {
-    bool read_ahead;
-    bool use_mmap;
-    bool use_odirect;
-  };
+  using Options = FileStreamOptions;
 
   /**
    * @brief Opens file stream
@@ -97,6 +103,13 @@ class DLL_PUBLIC FileStream : public InputStream {
     throw std::logic_error(
         make_string("memory mapping is not supported for this stream type. uri=", path_));
   }
+  /**
+   * @brief Hints that the given range of the file will be read soon.
+   *
+   * The stream may start loading the data in the background (e.g. to the page cache); the
+   * position of the stream is not affected. The default implementation does nothing.
+   */
+  virtual void Prefetch(int64_t offset, size_t n_bytes) {}
   const std::string& path() const { return path_; }
   virtual ~FileStream() {}
 
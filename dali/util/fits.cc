@@ -14,6 +14,7 @@
 
 #include <fitsio.h>
 
+#include <algorithm>
 #include <functional>
 #include <string>
 #include <vector>
@@ -157,8 +158,133 @@ inline void ExtractData<0>(fitsfile* fptr, std::vector<std::vector<uint8_t>>& ra
   }
 }
 
+bool CanDecodeRiceTiles(const HeaderData& header, fitsfile* src, span<const int64_t> dims) {
+  const auto* f = src->Fptr;
+  if (f->compress_type != RICE_1 || f->cn_uncompressed > 0 || f->cn_gzip_data > 0)
+    return false;
+  if (header.zbitpix <= 0 || header.bscale != 1.0 || header.bzero != 0.0)
+    return false;  // quantized floating point data or scaled integers
+  if (header.bytepix != 1 && header.bytepix != 2 && header.bytepix != 4)
+    return false;
+  if (header.type_info == nullptr || static_cast<int64_t>(header.type_info->size()) !=
+      header.bytepix)
+    return false;
+  // the tiles must be contiguous in the output - all but the outermost extent must match
+  for (int i = 0; i + 1 < dims.size(); i++) {
+    if (header.tile_sizes[i] != dims[i])
+      return false;
+  }
+  return true;
+}
+
+/** @brief The position of the highest bit set, counted from 1 */
+inline int BitWidth(unsigned value) {
+  return value ? 32 - __builtin_clz(value) : 0;
+}
+
+template <typename T>
+void DecodeRiceTileImpl(T* out, int64_t nelem, const uint8_t* in, int64_t in_size,
+                        int blocksize) {
+  // the parameters of the Rice code for the given pixel size, as in CFITSIO
+  constexpr int fsbits = sizeof(T) == 1 ? 3 : sizeof(T) == 2 ? 4 : 5;
+  constexpr int fsmax = sizeof(T) == 1 ? 6 : sizeof(T) == 2 ? 14 : 25;
+  constexpr int bbits = 1 << fsbits;
+
+  const uint8_t* end = in + in_size;
+  const uint8_t* c = in;
+  // a corrupted tile might try to read past its end - it's reported after the block
+  auto next_byte = [&]() -> unsigned {
+    unsigned byte = c < end ? *c : 0;
+    c++;
+    return byte;
+  };
+
+  DALI_ENFORCE(in_size > static_cast<int64_t>(sizeof(T)),
+               "Rice decompression error: the compressed tile is too short.");
+  unsigned lastpix = 0;
+  for (size_t i = 0; i < sizeof(T); i++)
+    lastpix = (lastpix << 8) | next_byte();
+
+  unsigned b = next_byte();
+  int nbits = 8;
+  for (int64_t i = 0; i < nelem;) {
+    nbits -= fsbits;
+    while (nbits < 0) {
+      b = (b << 8) | next_byte();
+      nbits += 8;
+    }
+    int fs = static_cast<int>(b >> nbits) - 1;
+    b &= (1u << nbits) - 1;
+    int64_t imax = std::min<int64_t>(i + blocksize, nelem);
+    if (fs < 0) {
+      // low-entropy block - all the differences are 0
+      for (; i < imax; i++)
+        out[i] = lastpix;
+    } else if (fs == fsmax) {
+      // high-entropy block - the differences are stored directly
+      for (; i < imax; i++) {
+        int k = bbits - nbits;
+        unsigned diff = k < 32 ? b << k : 0;  // b is 0 if nbits is 0
+        for (k -= 8; k >= 0; k -= 8) {
+          b = next_byte();
+          diff |= b << k;
+        }
+        if (nbits > 0) {
+          b = next_byte();
+          diff |= b >> (-k);
+          b &= (1u << nbits) - 1;
+        } else {
+          b = 0;
+        }
+        diff = (diff & 1) == 0 ? diff >> 1 : ~(diff >> 1);
+        out[i] = static_cast<T>(diff + lastpix);
+        lastpix = out[i];
+      }
+    } else {
+      for (; i < imax; i++) {
+        while (b == 0) {
+          nbits += 8;
+          b = next_byte();
+        }
+        int nzero = nbits - BitWidth(b);
+        nbits -= nzero + 1;
+        b ^= 1u << nbits;
+        nbits -= fs;
+        while (nbits < 0) {
+          b = (b << 8) | next_byte();
+          nbits += 8;
+        }
+        unsigned diff = (static_cast<unsigned>(nzero) << fs) | (b >> nbits);
+        b &= (1u << nbits) - 1;
+        diff = (diff & 1) == 0 ? diff >> 1 : ~(diff >> 1);
+        out[i] = static_cast<T>(diff + lastpix);
+        lastpix = out[i];
+      }
+    }
+    DALI_ENFORCE(c <= end, "Rice decompression error: hit the end of the compressed tile.");
+  }
+}
+
 }  // namespace
 
+void DecodeRiceTile(void* out, int64_t nelem, const uint8_t* in, int64_t in_size, int bytepix,
+                    int blocksize) {
+  switch (bytepix) {
+    case 1:
+      DecodeRiceTileImpl(static_cast<uint8_t*>(out), nelem, in, in_size, blocksize);
+      break;
+    case 2:
+      DecodeRiceTileImpl(static_cast<uint16_t*>(out), nelem, in, in_size, blocksize);
+      break;
+    case 4:
+      DecodeRiceTileImpl(static_cast<uint32_t*>(out), nelem, in, in_size, blocksize);
+      break;
+    default:
+      DALI_FAIL(make_string("Unsupported number of bytes per pixel in a Rice-coded image: ",
+                            bytepix));
+  }
+}
+
 void ParseHeader(HeaderData& parsed_header, fitsfile* src) {
   int32_t hdu_type, img_type, n_dims, status = 0;
 
@@ -193,6 +319,7 @@ void ParseHeader(HeaderData& parsed_header, fitsfile* src) {
     parsed_header.tile_sizes = GetTileSizes(src, n_dims);
     parsed_header.tiles = std::accumulate(parsed_header.tile_sizes.begin(),
                                           parsed_header.tile_sizes.end(), 1, std::multiplies<>());
+    parsed_header.rice_tiles = CanDecodeRiceTiles(parsed_header, src, make_cspan(dims));
   }
 
   for (auto it = dims.rbegin(); it != dims.rend(); ++it) {
@@ -1,4 +1,4 @@
-// Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -80,6 +80,13 @@ class DLL_PUBLIC HeaderData {
   double bscale, bzero;
   std::vector<int64_t> tile_sizes;
 
+  /**
+   * Whether the tiles can be decoded independently with DecodeRiceTile: the image is Rice-coded,
+   * the tiles span whole rows (so each one is contiguous in the output) and the pixel values
+   * are stored without scaling.
+   */
+  bool rice_tiles = false;
+
   DALIDataType type() const;
 
   size_t size() const;
@@ -95,6 +102,20 @@ DLL_PUBLIC int ExtractUndecodedData(fitsfile *fptr, std::vector<uint8_t> &data,
                                       std::vector<int64_t> &tile_offset,
                                       std::vector<int64_t> &tile_size, int64_t rows, int *status);
 
+/**
+ * @brief Decodes a Rice-coded tile.
+ *
+ * The function doesn't use CFITSIO, so the tiles can be decoded in parallel.
+ *
+ * @param out       the decoded pixels, `nelem` elements of `bytepix` bytes each
+ * @param in        the tile, as extracted by ExtractUndecodedData
+ * @param in_size   the size of the tile, in bytes
+ * @param bytepix   the number of bytes per pixel: 1, 2 or 4
+ * @param blocksize the number of pixels in a Rice coding block
+ */
+DLL_PUBLIC void DecodeRiceTile(void *out, int64_t nelem, const uint8_t *in, int64_t in_size,
+                               int bytepix, int blocksize);
+
 class DLL_PUBLIC FitsHandle : public UniqueHandle<fitsfile *, FitsHandle> {
  public:
   DALI_INHERIT_UNIQUE_HANDLE(fitsfile *, FitsHandle)
@@ -104,6 +104,35 @@ TEST(FitsExtractUndecodedTest, ExtractData) {
   }
 }
 
+TEST(FitsDecodeRiceTileTest, MatchesCfitsio) {
+  int status = 0, anynul = 0, nulval = 0;
+  vector<uint8_t> undecoded_data, decoded, ref;
+  vector<int64_t> offset_sizes, tile_sizes;
+
+  for (const auto &sample : data.get()) {
+    auto fptr = FitsHandle::OpenFile(sample.path.c_str(), READONLY);
+    FITS_CALL(fits_movabs_hdu(fptr, 2, nullptr, &status));  // move to the first HDU with data
+    HeaderData header;
+    ParseHeader(header, fptr);
+    ASSERT_TRUE(header.rice_tiles);
+
+    ref.resize(header.nbytes());
+    FITS_CALL(fits_read_img(fptr, header.datatype_code, 1, header.size(), &nulval, ref.data(),
+                            &anynul, &status));
+
+    ExtractUndecodedData(fptr, undecoded_data, offset_sizes, tile_sizes, header.rows, &status);
+    decoded.clear();
+    decoded.resize(header.nbytes(), 0xcc);
+    uint8_t *out = decoded.data();
+    for (size_t t = 0; t < tile_sizes.size(); t++) {
+      DecodeRiceTile(out, tile_sizes[t], undecoded_data.data() + offset_sizes[t],
+                     offset_sizes[t + 1] - offset_sizes[t], header.bytepix, header.blocksize);
+      out += tile_sizes[t] * header.bytepix;
+    }
+    ASSERT_EQ(out, decoded.data() + decoded.size());
+    ASSERT_EQ(decoded, ref);
+  }
+}
 
 }  // namespace fits
 }  // namespace dali
@@ -27,10 +27,11 @@
 #include <string>
 #include <cstdio>
 #include <cstring>
-#include <map>
+#include <cstdlib>
+#include <deque>
 #include <mutex>
 #include <algorithm>
-#include <tuple>
+#include <unordered_map>
 
 #include "dali/util/mmaped_file.h"
 #include "dali/core/error_handling.h"
@@ -74,16 +75,15 @@ static int get_max_vm_cnt() {
   return vm_cnt;
 }
 
+// Files up to this size are read in full anyway - fault them in with a single call
+// instead of a page fault per page
+static constexpr size_t kPopulateMaxSize = 1 << 20;
+
 static void *file_map(const char *path, size_t *length, bool read_ahead) {
   int fd = -1;
   struct stat s;
   void *p = nullptr;
   int flags = MAP_PRIVATE;
-  if (read_ahead) {
-#if !defined(__AARCH64_QNX__) && !defined(__AARCH64_GNU__) && !defined(__aarch64__)
-    flags |= MAP_POPULATE;
-#endif
-  }
 
   if ((fd = open(path, O_RDONLY)) < 0) {
     goto fail;
@@ -95,6 +95,12 @@ static void *file_map(const char *path, size_t *length, bool read_ahead) {
 
   *length = (size_t)s.st_size;
 
+  if (read_ahead || *length <= kPopulateMaxSize) {
+#if !defined(__AARCH64_QNX__) && !defined(__AARCH64_GNU__) && !defined(__aarch64__)
+    flags |= MAP_POPULATE;
+#endif
+  }
+
   if ((p = mmap(nullptr, *length, PROT_READ, flags, fd, 0)) == MAP_FAILED) {
     p = nullptr;
     goto fail;
@@ -112,36 +118,93 @@ fail:
 
 namespace dali {
 
-using MappedFile = std::tuple<std::weak_ptr<void>, size_t>;
-
 // limit to half of allowed mmaped files
 static const unsigned int dali_max_mv_cnt = get_max_vm_cnt() / 2;
 // number of currenlty reserved file mappings
 static unsigned int dali_reserved_mv_cnt = 0;
 
-// Cache the already opened files: this avoids mapping the same file N times in memory.
-// Doing so is wasteful since the file is read-only: we can share the underlying buffer,
-// with different pos_.
-std::mutex mapped_files_mutex;
-std::map<std::string, MappedFile> mapped_files;
+namespace {
+
+/**
+ * @brief Keeps track of the mapped files, so that the same file is never mapped twice.
+ *
+ * Doing so is wasteful since the file is read-only: we can share the underlying buffer,
+ * with different pos_. The mapping is released when the last stream or piece of memory
+ * obtained with Get that refers to it is gone - except for a few most recently used files,
+ * which are kept mapped, so that reopening a file soon after (e.g. when the samples of
+ * multiple files are interleaved) doesn't map and unmap it again.
+ */
+class MappingPool {
+ public:
+  static MappingPool &Instance() {
+    // never destroyed - the mappings can outlive the static objects
+    static MappingPool *pool = new MappingPool();
+    return *pool;
+  }
 
-MmapedFileStream::MmapedFileStream(const std::string& path, bool read_ahead) :
-  FileStream(path), length_(0), pos_(0), read_ahead_whole_file_(read_ahead) {
-  std::lock_guard<std::mutex> lock(mapped_files_mutex);
-  std::weak_ptr<void> mapped_memory;
-  std::tie(mapped_memory, length_) = mapped_files[path];
-
-  if (!(p_ = mapped_memory.lock())) {
-    void *p = file_map(path.c_str(), &length_, read_ahead_whole_file_);
-    size_t length_tmp = length_;
-    p_ = shared_ptr<void>(p, [=](void*) {
-      // we are not touching mapped_files, weak_ptr is enough to check if
-      // memory is valid or not
+  std::shared_ptr<void> Get(const std::string &path, bool read_ahead, size_t &length) {
+    std::shared_ptr<void> evicted;  // released after the lock, its deleter locks the mutex
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_ptr<void> p;
+    auto it = mappings_.find(path);
+    if (it != mappings_.end() && (p = it->second.memory.lock())) {
+      length = it->second.length;
+    } else {
+      p = Map(path, read_ahead, length);
+      mappings_[path] = {p, length};
+    }
+    if (retained_max_ > 0) {
+      auto r = std::find(retained_.begin(), retained_.end(), p);
+      if (r != retained_.end())
+        retained_.erase(r);
+      retained_.push_back(p);
+      if (retained_.size() > retained_max_) {
+        evicted = std::move(retained_.front());
+        retained_.pop_front();
+      }
+    }
+    return p;
+  }
+
+ private:
+  MappingPool() {
+    const char *env = std::getenv("DALI_MMAP_POOL_SIZE");
+    retained_max_ = std::min<size_t>(env ? std::atoi(env) : 16, dali_max_mv_cnt / 4);
+  }
+
+  std::shared_ptr<void> Map(const std::string &path, bool read_ahead, size_t &length) {
+    void *p = file_map(path.c_str(), &length, read_ahead);
+    size_t length_tmp = length;
+    return std::shared_ptr<void>(p, [this, path, length_tmp](void *p) {
       munmap(p, length_tmp);
-     });
-    mapped_files[path] = std::make_tuple(p_, length_);
+      Forget(path);
+    });
+  }
+
+  void Forget(const std::string &path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = mappings_.find(path);
+    // the file might have been mapped again in the meantime
+    if (it != mappings_.end() && it->second.memory.expired())
+      mappings_.erase(it);
   }
 
+  struct MappedFile {
+    std::weak_ptr<void> memory;
+    size_t length = 0;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, MappedFile> mappings_;
+  std::deque<std::shared_ptr<void>> retained_;
+  size_t retained_max_ = 0;
+};
+
+}  // namespace
+
+MmapedFileStream::MmapedFileStream(const std::string& path, bool read_ahead) :
+  FileStream(path), length_(0), pos_(0), read_ahead_whole_file_(read_ahead) {
+  p_ = MappingPool::Instance().Get(path, read_ahead_whole_file_, length_);
   path_ = path;
 
   DALI_ENFORCE(p_ != nullptr, "Could not open file " + path + ": " + std::strerror(errno));
@@ -185,6 +248,18 @@ void MmapedFileStream::SeekRead(ptrdiff_t pos, int whence) {
   pos_ = pos;
 }
 
+void MmapedFileStream::Prefetch(int64_t offset, size_t n_bytes) {
+  if (!p_ || offset < 0 || static_cast<size_t>(offset) >= length_)
+    return;
+  n_bytes = std::min(n_bytes, length_ - offset);
+  // madvise needs a page-aligned address
+  static const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  auto start = reinterpret_cast<uintptr_t>(p_.get()) + offset;
+  auto aligned_start = start & ~(page_size - 1);
+  madvise(reinterpret_cast<void *>(aligned_start), n_bytes + (start - aligned_start),
+          MADV_WILLNEED);
+}
+
 ptrdiff_t MmapedFileStream::TellRead() const {
   return pos_;
 }
@@ -194,18 +269,10 @@ shared_ptr<void> MmapedFileStream::Get(size_t n_bytes) {
   if (pos_ + n_bytes > length_) {
     return nullptr;
   }
-  auto tmp = p_;
-  shared_ptr<void> p(ReadAheadHelper(p_, pos_, n_bytes, !read_ahead_whole_file_),
-    [tmp](void*) {
-    // This is an empty lambda, which is a custom deleter for
-    // std::shared_ptr.
-    // While instantiating shared_ptr, also lambda is instantiated,
-    // making a copy of p_. This way, reference counter
-    // of p_ is incremented. Therefore, for the duration
-    // of life cycle of underlying memory in shared_ptr, file that was
-    // mapped creating p_ won't be unmapped
-    // It will be freed, when last shared_ptr is deleted.
-  });
+  // The aliasing constructor shares the ownership of the whole mapping, so the file won't be
+  // unmapped for the duration of the life cycle of the returned memory - and, unlike a custom
+  // deleter, it doesn't allocate a new control block for every sample.
+  shared_ptr<void> p(p_, ReadAheadHelper(p_, pos_, n_bytes, !read_ahead_whole_file_));
   pos_ += n_bytes;
   return p;
 }
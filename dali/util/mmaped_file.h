@@ -38,6 +38,7 @@ class MmapedFileStream : public FileStream {
   void SeekRead(ptrdiff_t pos, int whence = SEEK_SET) override;
   int64_t TellRead() const override;
   size_t Size() const override;
+  void Prefetch(int64_t offset, size_t n_bytes) override;
 
   ~MmapedFileStream() override;
 
@@ -0,0 +1,82 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "dali/util/mmaped_file.h"
+
+namespace dali {
+
+namespace {
+
+class MmapedFileStreamTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    filename_ = "/tmp/dali_mmap_test_XXXXXX";
+    int fd = mkstemp(&filename_[0]);
+    ASSERT_NE(-1, fd);
+    data_.resize(100000);
+    std::iota(data_.begin(), data_.end(), 0);
+    ASSERT_EQ(write(fd, data_.data(), data_.size()), static_cast<ssize_t>(data_.size()));
+    close(fd);
+  }
+
+  void TearDown() override {
+    std::remove(filename_.c_str());
+  }
+
+  std::string filename_;
+  std::vector<char> data_;
+};
+
+}  // namespace
+
+TEST_F(MmapedFileStreamTest, SharedMapping) {
+  auto file1 = std::make_unique<MmapedFileStream>(filename_, false);
+  auto file2 = std::make_unique<MmapedFileStream>(filename_, false);
+  ASSERT_EQ(file1->Size(), data_.size());
+  file2->SeekRead(1000);
+  auto p1 = file1->Get(1000);
+  auto p2 = file2->Get(500);
+  ASSERT_NE(p1, nullptr);
+  ASSERT_NE(p2, nullptr);
+  // both streams use the same mapping
+  EXPECT_EQ(static_cast<char *>(p1.get()) + 1000, static_cast<char *>(p2.get()));
+  EXPECT_EQ(std::memcmp(p2.get(), data_.data() + 1000, 500), 0);
+  EXPECT_EQ(file1->Get(data_.size()), nullptr);
+}
+
+TEST_F(MmapedFileStreamTest, MemoryOutlivesStream) {
+  auto file = std::make_unique<MmapedFileStream>(filename_, false);
+  file->SeekRead(10);
+  auto p = file->Get(100);
+  file->Close();
+  file.reset();
+  EXPECT_EQ(std::memcmp(p.get(), data_.data() + 10, 100), 0);
+  p.reset();
+
+  // the file can be mapped again after all the references are gone
+  file = std::make_unique<MmapedFileStream>(filename_, true);
+  std::vector<char> buf(data_.size());
+  EXPECT_EQ(file->Read(buf.data(), buf.size()), data_.size());
+  EXPECT_EQ(buf, data_);
+}
+
+}  // namespace dali
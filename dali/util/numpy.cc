@@ -317,5 +317,70 @@ size_t HeaderData::nbytes() const {
   return data;
 }
 
+std::vector<FileRange> GetRoiRanges(const HeaderData &header,
+                                    span<const int64_t> roi_anchor,
+                                    span<const int64_t> roi_shape) {
+  const auto &shape = header.shape;
+  int ndim = shape.sample_dim();
+  DALI_ENFORCE(!header.fortran_order, "Only C-order arrays are supported.");
+  DALI_ENFORCE(roi_anchor.size() == ndim && roi_shape.size() == ndim,
+               make_string("The region of interest should have ", ndim, " dimensions."));
+  for (int d = 0; d < ndim; d++) {
+    DALI_ENFORCE(roi_anchor[d] >= 0 && roi_shape[d] >= 0 &&
+                 roi_anchor[d] + roi_shape[d] <= shape[d],
+                 make_string("The region of interest doesn't lie within the array of shape ",
+                             shape, " in dimension ", d));
+  }
+  std::vector<FileRange> ranges;
+  int64_t elem_size = header.type_info->size();
+  if (volume(roi_shape) == 0)
+    return ranges;
+  if (ndim == 0) {
+    ranges.push_back({header.data_offset, elem_size});
+    return ranges;
+  }
+
+  // the innermost dimensions, which are read in full, are contiguous with the first partial one
+  int inner = ndim - 1;
+  while (inner > 0 && roi_anchor[inner] == 0 && roi_shape[inner] == shape[inner])
+    inner--;
+
+  SmallVector<int64_t, 6> strides;
+  strides.resize(inner + 1);
+  strides[inner] = elem_size;
+  for (int d = inner + 1; d < ndim; d++)
+    strides[inner] *= shape[d];
+  for (int d = inner - 1; d >= 0; d--)
+    strides[d] = strides[d + 1] * shape[d + 1];
+  int64_t range_size = roi_shape[inner] * strides[inner];
+
+  int64_t start = header.data_offset;
+  for (int d = 0; d <= inner; d++)
+    start += roi_anchor[d] * strides[d];
+
+  // iterate over the outer dimensions of the region
+  SmallVector<int64_t, 6> pos;
+  pos.resize(inner, 0);
+  int64_t offset = start;
+  for (;;) {
+    if (!ranges.empty() && ranges.back().offset + ranges.back().size == offset)
+      ranges.back().size += range_size;
+    else
+      ranges.push_back({offset, range_size});
+
+    int d = inner - 1;
+    for (; d >= 0; d--) {
+      offset += strides[d];
+      if (++pos[d] < roi_shape[d])
+        break;
+      offset -= pos[d] * strides[d];
+      pos[d] = 0;
+    }
+    if (d < 0)
+      break;
+  }
+  return ranges;
+}
+
 }  // namespace numpy
 }  // namespace dali
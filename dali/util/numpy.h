@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,7 +16,9 @@
 #define DALI_UTIL_NUMPY_H_
 
 #include <string>
+#include <vector>
 #include "dali/core/common.h"
+#include "dali/core/span.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/core/stream.h"
 #include "dali/pipeline/data/sample_view.h"
@@ -46,6 +48,14 @@ class DLL_PUBLIC HeaderData {
   size_t nbytes() const;
 };
 
+/**
+ * @brief A contiguous part of a file
+ */
+struct FileRange {
+  int64_t offset;
+  int64_t size;
+};
+
 DLL_PUBLIC void ParseHeader(HeaderData &parsed_header, InputStream *src);
 
 DLL_PUBLIC void ParseODirectHeader(HeaderData &parsed_header, InputStream *src,
@@ -57,6 +67,20 @@ DLL_PUBLIC void ParseHeaderContents(HeaderData& target, const std::string &heade
 
 DLL_PUBLIC Tensor<CPUBackend> ReadTensor(InputStream *src, bool pinned);
 
+/**
+ * @brief Calculates the parts of the file occupied by a region of a C-order array.
+ *
+ * The ranges are sorted by the offset and the adjacent ones are merged. Reading the ranges
+ * one after another gives the region as a dense, C-order array.
+ *
+ * @param header      the header of the array; must not be in Fortran order
+ * @param roi_anchor  the start of the region; the region must lie within the array
+ * @param roi_shape   the shape of the region
+ */
+DLL_PUBLIC std::vector<FileRange> GetRoiRanges(const HeaderData &header,
+                                               span<const int64_t> roi_anchor,
+                                               span<const int64_t> roi_shape);
+
 }  // namespace numpy
 }  // namespace dali
 
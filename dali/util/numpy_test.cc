@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -62,6 +62,34 @@ TEST(NumpyLoaderTest, ParseHeaderError) {
   }
 }
 
+TEST(NumpyLoaderTest, GetRoiRanges) {
+  HeaderData header;
+  ParseHeaderContents(header, "{'descr':'<i2', 'fortran_order':False, 'shape':(4,5,6),}");
+  header.data_offset = 128;
+  auto check = [&](std::vector<int64_t> anchor, std::vector<int64_t> shape,
+                   std::vector<std::pair<int64_t, int64_t>> expected) {
+    auto ranges = GetRoiRanges(header, make_cspan(anchor), make_cspan(shape));
+    ASSERT_EQ(ranges.size(), expected.size());
+    for (size_t i = 0; i < ranges.size(); i++) {
+      EXPECT_EQ(ranges[i].offset, expected[i].first) << " range " << i;
+      EXPECT_EQ(ranges[i].size, expected[i].second) << " range " << i;
+    }
+  };
+  // the whole array
+  check({0, 0, 0}, {4, 5, 6}, {{128, 240}});
+  // whole planes are contiguous
+  check({1, 0, 0}, {2, 5, 6}, {{188, 120}});
+  // whole rows of a plane are contiguous
+  check({1, 2, 0}, {2, 2, 6}, {{212, 24}, {272, 24}});
+  // parts of rows
+  check({3, 1, 2}, {1, 2, 3}, {{324, 6}, {336, 6}});
+  // empty region
+  check({1, 1, 1}, {1, 0, 1}, {});
+  // out of bounds
+  std::vector<int64_t> anchor = {0, 4, 0}, shape = {1, 2, 1};
+  EXPECT_THROW(GetRoiRanges(header, make_cspan(anchor), make_cspan(shape)), std::runtime_error);
+}
+
 }  // namespace numpy
 }  // namespace dali
 
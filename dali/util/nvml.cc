@@ -1,4 +1,4 @@
-// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,7 +15,10 @@
 #include "dali/util/nvml.h"
 #include <pthread.h>
 #include <sys/sysinfo.h>
+#include <cstdlib>
+#include <string>
 #include <vector>
+#include "dali/core/device_guard.h"
 
 namespace dali {
 namespace nvml {
@@ -61,6 +64,21 @@ std::string uuid_str(const char *uuid, const char *prefix = "GPU-") {
   *ptr = 0;
   return buf;
 }
+
+/** The CPUs listed in DALI_AFFINITY_RESERVED_CORES - they're never chosen by NVML affinity */
+const std::vector<int> &ReservedCores() {
+  static const std::vector<int> cores = []() {
+    std::vector<int> ret;
+    if (const char *env = std::getenv("DALI_AFFINITY_RESERVED_CORES")) {
+      for (auto &id : string_split(env, ',')) {
+        if (!id.empty())
+          ret.push_back(std::stoi(id));
+      }
+    }
+    return ret;
+  }();
+  return cores;
+}
 }  // namespace
 
 nvmlDevice_t nvmlGetDeviceHandleForCUDA(int cuda_idx) {
@@ -124,6 +142,12 @@ void GetNVMLAffinityMask(cpu_set_t *mask, size_t num_cpus) {
 
   // AND masks
   CPU_AND(mask, &nvml_set, &current_set);
+
+  // Leave the reserved cores (e.g. for the training framework) alone
+  for (int core : ReservedCores()) {
+    if (core >= 0 && static_cast<size_t>(core) < num_cpus)
+      CPU_CLR(core, mask);
+  }
 }
 
 void SetCPUAffinity(int core) {
@@ -163,6 +187,32 @@ void SetCPUAffinity(int core) {
   }
 }
 
+void SetDeviceLocalAffinity(int device_id) {
+  try {
+    DeviceGuard dg(device_id);
+    auto nvml_handle = NvmlInstance::CreateNvmlInstance();
+    SetCPUAffinity();
+  } catch (std::exception &e) {
+    DALI_WARN(make_string("Cannot set the thread affinity: ", e.what()));
+  }
+}
+
+int GetNumaNode(int device_idx) {
+#if (CUDART_VERSION >= 11000)
+  if (!nvmlIsInitialized() || !nvmlIsSymbolAvailable("nvmlDeviceGetMemoryAffinity"))
+    return -1;
+  nvmlDevice_t device = nvmlGetDeviceHandleForCUDA(device_idx);
+  unsigned long node_set = 0;  // NOLINT(runtime/int)
+  if (nvmlDeviceGetMemoryAffinity(device, 1, &node_set, NVML_AFFINITY_SCOPE_NODE) != NVML_SUCCESS)
+    return -1;
+  if (!node_set)
+    return -1;
+  return __builtin_ctzl(node_set);
+#else
+  return -1;
+#endif
+}
+
 
 }  // namespace nvml
 }  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -141,6 +141,9 @@ inline void Init() {
 /**
  * @brief Gets the CPU affinity mask using NVML,
  *        respecting previously set mask.
+ *
+ * The CPUs listed in the DALI_AFFINITY_RESERVED_CORES environment variable
+ * (comma-separated) are removed from the mask.
  */
 void GetNVMLAffinityMask(cpu_set_t * mask, size_t num_cpus);
 
@@ -149,6 +152,21 @@ void GetNVMLAffinityMask(cpu_set_t * mask, size_t num_cpus);
  */
 void SetCPUAffinity(int core = -1);
 
+/**
+ * @brief Sets the CPU affinity of the calling thread to the CPUs close to the given device
+ *
+ * Unlike SetCPUAffinity, it doesn't require NVML to be initialized. The errors are reported as
+ * warnings - the affinity is an optimization only.
+ */
+void SetDeviceLocalAffinity(int device_id);
+
+/**
+ * @brief Gets the NUMA node closest to the given CUDA device
+ *
+ * @return The index of the NUMA node or -1, if it can't be determined
+ */
+int GetNumaNode(int device_idx);
+
 inline void Shutdown() {
   std::lock_guard<std::mutex> lock(Mutex());
   if (!nvmlIsInitialized()) {
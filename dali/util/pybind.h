@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -245,6 +245,17 @@ static DLMTensorPtr DLMTensorPtrFromCapsule(py::capsule &capsule) {
   return {DLMTensorRawPtrFromCapsule(capsule), DLMTensorPtrDeleter};
 }
 
+/**
+ * @brief Returns a new reference to the Python object passed to an operator as an integer id.
+ *
+ * The operators are constructed when the pipeline is built, which doesn't hold the GIL,
+ * so the GIL is acquired here.
+ */
+inline py::object BorrowPythonObject(int64_t object_id) {
+  py::gil_scoped_acquire interpreter_guard{};
+  return py::reinterpret_borrow<py::object>(reinterpret_cast<PyObject *>(object_id));
+}
+
 
 /**
  * @see to_struct
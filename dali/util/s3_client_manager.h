@@ -16,14 +16,18 @@
 #define DALI_UTIL_S3_CLIENT_MANAGER_H_
 
 #include <aws/core/Aws.h>
+#include <aws/core/utils/threading/Executor.h>
 #include <aws/s3/S3Client.h>
+#include <algorithm>
 #include <cstdio>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include "dali/core/common.h"
 #include "dali/pipeline/util/thread_pool.h"
+#include "dali/util/s3_filesystem.h"
 
 namespace dali {
 
@@ -60,6 +64,13 @@ struct S3ClientManager {
     if (endpoint_url_ptr) {
       config.endpointOverride = std::string(endpoint_url_ptr);
     }
+    // The asynchronous (ranged and read-ahead) requests are run by the executor - use a bounded
+    // pool and allow enough connections so that several readers can keep their requests in flight
+    int max_requests = s3_filesystem::max_requests_in_flight();
+    int num_executor_threads = std::max<int>(4 * max_requests, std::thread::hardware_concurrency());
+    config.executor = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(
+        "S3ClientManager", num_executor_threads);
+    config.maxConnections = std::max<unsigned>(config.maxConnections, num_executor_threads);
     client_ = std::make_unique<Aws::S3::S3Client>(std::move(config));
   }
 
@@ -14,14 +14,16 @@
 
 #include "dali/util/s3_file.h"
 #include <fnmatch.h>
+#include <algorithm>
+#include <cstring>
 #include "dali/core/format.h"
 #include "dali/util/s3_client_manager.h"
 #include "dali/util/uri.h"
 namespace dali {
 
 S3FileStream::S3FileStream(Aws::S3::S3Client* s3_client, const std::string& uri,
-                           std::optional<size_t> size)
-    : FileStream(uri), s3_client_(s3_client) {
+                           std::optional<size_t> size, bool read_ahead)
+    : FileStream(uri), s3_client_(s3_client), read_ahead_(read_ahead) {
   object_location_ = s3_filesystem::parse_uri(uri);
   if (size.has_value() && size.value() > 0) {
     object_stats_.exists = true;
@@ -35,7 +37,8 @@ S3FileStream::~S3FileStream() {}
 
 
 void S3FileStream::Close() {
-  // nothing to do here (there's no file open)
+  // there's no file open, only the pending read-ahead requests
+  read_ahead_blocks_.clear();
 }
 
 void S3FileStream::SeekRead(ptrdiff_t pos, int whence) {
@@ -66,12 +69,70 @@ size_t S3FileStream::Size() const {
   return object_stats_.size;
 }
 
+size_t S3FileStream::ReadFromReadAhead(uint8_t* buf, size_t n) {
+  auto& blocks = read_ahead_blocks_;
+  size_t pos = pos_;
+  // the blocks form a contiguous range - drop them all if we've seeked outside of it
+  if (!blocks.empty() &&
+      (pos < blocks.front().offset || pos >= blocks.back().offset + blocks.back().size)) {
+    blocks.clear();
+  }
+  while (!blocks.empty() && pos >= blocks.front().offset + blocks.front().size)
+    blocks.pop_front();
+
+  size_t copied = 0;
+  while (copied < n && !blocks.empty()) {
+    auto& block = blocks.front();
+    block.size = std::min(block.size, block.read->Wait());
+    if (pos >= block.offset + block.size)
+      break;  // short read - end of object
+    size_t block_offset = pos - block.offset;
+    size_t count = std::min(n - copied, block.size - block_offset);
+    std::memcpy(buf + copied, block.data.get() + block_offset, count);
+    copied += count;
+    pos += count;
+    if (pos == block.offset + block.size)
+      blocks.pop_front();
+  }
+  return copied;
+}
+
+void S3FileStream::IssueReadAhead() {
+  auto& blocks = read_ahead_blocks_;
+  size_t part_size = s3_filesystem::read_part_size();
+  size_t next = blocks.empty() ? pos_ : blocks.back().offset + blocks.back().size;
+  while (static_cast<int>(blocks.size()) < s3_filesystem::max_requests_in_flight() &&
+         next < object_stats_.size) {
+    ReadAheadBlock block;
+    block.offset = next;
+    block.size = std::min(part_size, object_stats_.size - next);
+    block.data.reset(new uint8_t[block.size]);
+    block.read = std::make_unique<s3_filesystem::S3AsyncRead>(
+        s3_client_, object_location_, block.data.get(), block.size, block.offset);
+    next += block.size;
+    blocks.push_back(std::move(block));
+  }
+}
+
 size_t S3FileStream::Read(void* buf, size_t n) {
   if (n == 0)
     return 0;
-  size_t bytes_read =
-      s3_filesystem::read_object_contents(s3_client_, object_location_, buf, n, pos_);
-  pos_ += bytes_read;
+  n = std::min<size_t>(n, object_stats_.size - pos_);
+  size_t bytes_read = 0;
+  if (read_ahead_) {
+    bytes_read = ReadFromReadAhead(static_cast<uint8_t*>(buf), n);
+    pos_ += bytes_read;
+  }
+  if (bytes_read < n) {
+    // what's not covered by the read-ahead is read directly into the output buffer
+    size_t direct_read = s3_filesystem::read_object_contents(
+        s3_client_, object_location_, static_cast<uint8_t*>(buf) + bytes_read, n - bytes_read,
+        pos_);
+    pos_ += direct_read;
+    bytes_read += direct_read;
+  }
+  if (read_ahead_)
+    IssueReadAhead();
   return bytes_read;
 }
 
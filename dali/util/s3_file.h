@@ -18,6 +18,7 @@
 #include <aws/core/Aws.h>
 #include <aws/s3/S3Client.h>
 #include <cstdio>
+#include <deque>
 #include <memory>
 #include <optional>
 #include <string>
@@ -29,8 +30,14 @@ namespace dali {
 
 class S3FileStream : public FileStream {
  public:
+  /**
+   * @brief Opens an S3 object for reading
+   *
+   * @param read_ahead if true, after each read the following parts of the object are requested
+   *                   asynchronously, so that sequential reads don't wait for a full round trip
+   */
   explicit S3FileStream(Aws::S3::S3Client* s3_client, const std::string& uri,
-                        std::optional<size_t> size = std::nullopt);
+                        std::optional<size_t> size = std::nullopt, bool read_ahead = false);
   void Close() override;
   size_t Read(void* buf, size_t n) override;
   void SeekRead(ptrdiff_t pos, int whence = SEEK_SET) override;
@@ -40,7 +47,28 @@ class S3FileStream : public FileStream {
   ~S3FileStream() override;
 
  private:
+  struct ReadAheadBlock {
+    size_t offset = 0;
+    size_t size = 0;
+    std::unique_ptr<uint8_t[]> data;
+    // declared after data, so that it's destroyed (and waited for) first
+    std::unique_ptr<s3_filesystem::S3AsyncRead> read;
+  };
+
+  /**
+   * @brief Copies the part of the requested range that's covered by the read-ahead blocks,
+   *        starting at the current position.
+   */
+  size_t ReadFromReadAhead(uint8_t* buf, size_t n);
+
+  /**
+   * @brief Issues the asynchronous requests for the parts that follow the current position.
+   */
+  void IssueReadAhead();
+
   Aws::S3::S3Client* s3_client_ = nullptr;
+  bool read_ahead_ = false;
+  std::deque<ReadAheadBlock> read_ahead_blocks_;
   ptrdiff_t pos_ = 0;
   s3_filesystem::S3ObjectLocation object_location_ = {};
   s3_filesystem::S3ObjectStats object_stats_ = {};
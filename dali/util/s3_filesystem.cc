@@ -21,7 +21,11 @@
 #include <aws/s3/model/HeadBucketRequest.h>
 #include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/ListObjectsV2Request.h>
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
 #include <vector>
+#include "dali/core/error_handling.h"
 #include "dali/core/format.h"
 #include "dali/core/nvtx.h"
 #include "dali/util/uri.h"
@@ -32,6 +36,80 @@ namespace s3_filesystem {
 
 static const char kAllocationTag[] = "s3_filesystem";
 
+static constexpr size_t kDefaultPartSize = 8 << 20;  // 8M
+static constexpr int kDefaultMaxRequestsInFlight = 8;
+
+static std::string byte_range(size_t offset, size_t n) {
+  std::stringstream ss;
+  ss << "bytes=" << offset << "-" << offset + n - 1;
+  return ss.str();
+}
+
+size_t read_part_size() {
+  static const size_t part_size = []() {
+    const char* env = std::getenv("DALI_S3_PART_SIZE");
+    if (!env || !*env)
+      return kDefaultPartSize;
+    char* end = nullptr;
+    size_t s = std::strtoull(env, &end, 10);
+    if (*end == 'k')
+      s <<= 10, end++;
+    else if (*end == 'M')
+      s <<= 20, end++;
+    DALI_ENFORCE(*end == '\0' && s >= (64 << 10), make_string(
+        "DALI_S3_PART_SIZE must be a number of at least 64k, optionally followed by "
+        "'k' or 'M', got: ", env));
+    return s;
+  }();
+  return part_size;
+}
+
+int max_requests_in_flight() {
+  static const int max_requests = []() {
+    const char* env = std::getenv("DALI_S3_MAX_REQUESTS_IN_FLIGHT");
+    if (!env || !*env)
+      return kDefaultMaxRequestsInFlight;
+    int n = std::atoi(env);
+    DALI_ENFORCE(n > 0, make_string(
+        "DALI_S3_MAX_REQUESTS_IN_FLIGHT must be a positive number, got: ", env));
+    return n;
+  }();
+  return max_requests;
+}
+
+S3AsyncRead::S3AsyncRead(Aws::S3::S3Client* s3_client, const S3ObjectLocation& object_location,
+                         void* buf, size_t n, size_t offset) {
+  Aws::S3::Model::GetObjectRequest getObjectRequest;
+  getObjectRequest.SetBucket(object_location.bucket.c_str());
+  getObjectRequest.SetKey(object_location.object.c_str());
+  getObjectRequest.SetRange(byte_range(offset, n).c_str());
+
+  streambuf_ = std::make_unique<Aws::Utils::Stream::PreallocatedStreamBuf>(
+      reinterpret_cast<uint8_t*>(buf), n);
+  auto* streambuf = streambuf_.get();
+  getObjectRequest.SetResponseStreamFactory(
+      [streambuf]() { return Aws::New<Aws::IOStream>(kAllocationTag, streambuf); });
+  outcome_ = s3_client->GetObjectCallable(getObjectRequest);
+}
+
+S3AsyncRead::~S3AsyncRead() {
+  // the request writes to streambuf_ - it must not outlive it
+  if (outcome_.valid())
+    outcome_.wait();
+}
+
+size_t S3AsyncRead::Wait() {
+  if (!bytes_read_.has_value()) {
+    auto get_object_outcome = outcome_.get();
+    if (!get_object_outcome.IsSuccess()) {
+      const Aws::S3::S3Error& err = get_object_outcome.GetError();
+      throw std::runtime_error(err.GetExceptionName() + ": " + err.GetMessage());
+    }
+    bytes_read_ = get_object_outcome.GetResult().GetContentLength();
+  }
+  return *bytes_read_;
+}
+
 S3ObjectLocation parse_uri(const std::string& uri) {
   auto parsed_uri = URI::Parse(uri, URI::ParseOpts::AllowNonEscaped);
   if (parsed_uri.scheme() != "s3")
@@ -70,14 +148,44 @@ S3ObjectStats get_stats(Aws::S3::S3Client* s3_client, const S3ObjectLocation& ob
 
 size_t read_object_contents(Aws::S3::S3Client* s3_client, const S3ObjectLocation& object_location,
                             void* buf, size_t n, size_t offset) {
-  std::stringstream ss;
-  ss << "bytes=" << offset << "-" << offset + n - 1;
-  std::string byte_range_str = ss.str();
+  std::string byte_range_str = byte_range(offset, n);
 
   DomainTimeRange tr(make_string("read_object_contents @ ", object_location.object, " ",
                                  byte_range_str, " (", n, ")"),
                      DomainTimeRange::kOrange);
 
+  size_t part_size = read_part_size();
+  if (n > part_size) {
+    // Split the read into parts; each of them is written directly to its place in `buf`
+    std::deque<std::unique_ptr<S3AsyncRead>> in_flight;
+    size_t issued = 0, bytes_read = 0;
+    bool eof = false;
+    while (issued < n || !in_flight.empty()) {
+      while (issued < n && static_cast<int>(in_flight.size()) < max_requests_in_flight()) {
+        size_t part = std::min(part_size, n - issued);
+        in_flight.push_back(std::make_unique<S3AsyncRead>(
+            s3_client, object_location, static_cast<uint8_t*>(buf) + issued, part,
+            offset + issued));
+        issued += part;
+      }
+      if (eof) {
+        // past the end of the object - just wait for the remaining requests to finish
+        in_flight.pop_front();
+        continue;
+      }
+      size_t expected = std::min(part_size, n - bytes_read);
+      size_t part_read = in_flight.front()->Wait();
+      in_flight.pop_front();
+      bytes_read += part_read;
+      if (part_read < expected) {
+        // end of object - no more parts are issued, the ones in flight are discarded
+        eof = true;
+        issued = n;
+      }
+    }
+    return bytes_read;
+  }
+
   Aws::S3::Model::GetObjectRequest getObjectRequest;
   getObjectRequest.SetBucket(object_location.bucket.c_str());
   getObjectRequest.SetKey(object_location.object.c_str());
@@ -99,11 +207,11 @@ size_t read_object_contents(Aws::S3::S3Client* s3_client, const S3ObjectLocation
 }
 
 void list_objects_f(Aws::S3::S3Client* s3_client, const S3ObjectLocation& object_location,
-                    PerObjectCallable per_object_call) {
+                    PerObjectCallable per_object_call, PerPrefixCallable per_prefix_call) {
   DomainTimeRange tr(make_string("list_object_contents @ ", object_location.object),
                      DomainTimeRange::kOrange);
   std::string prefix = object_location.object;
-  if (prefix.back() != '/') {
+  if (!prefix.empty() && prefix.back() != '/') {
     prefix.push_back('/');
   }
   constexpr int kS3GetChildrenMaxKeys = 1000;
@@ -111,6 +219,8 @@ void list_objects_f(Aws::S3::S3Client* s3_client, const S3ObjectLocation& object
   list_obj_req.WithBucket(object_location.bucket.c_str())
       .WithPrefix(prefix.c_str())
       .WithMaxKeys(kS3GetChildrenMaxKeys);
+  if (per_prefix_call)
+    list_obj_req.SetDelimiter("/");
   list_obj_req.SetResponseStreamFactory(
       []() { return Aws::New<Aws::StringStream>(kAllocationTag); });
   Aws::S3::Model::ListObjectsV2Result list_obj_result;
@@ -125,6 +235,11 @@ void list_objects_f(Aws::S3::S3Client* s3_client, const S3ObjectLocation& object
     for (const auto& object : list_obj_result.GetContents()) {
       per_object_call(object.GetKey(), object.GetSize());
     }
+    if (per_prefix_call) {
+      for (const auto& common_prefix : list_obj_result.GetCommonPrefixes()) {
+        per_prefix_call(common_prefix.GetPrefix());
+      }
+    }
     list_obj_req.SetContinuationToken(list_obj_result.GetNextContinuationToken());
   } while (list_obj_result.GetIsTruncated());
 }
@@ -16,9 +16,12 @@
 #define DALI_UTIL_S3_FILESYSTEM_H_
 
 #include <aws/core/Aws.h>
+#include <aws/core/utils/stream/PreallocatedStreamBuf.h>
 #include <aws/s3/S3Client.h>
 #include <cstdio>
 #include <functional>
+#include <memory>
+#include <optional>
 #include <string>
 #include "dali/core/api_helper.h"
 
@@ -57,6 +60,9 @@ DLL_PUBLIC S3ObjectStats get_stats(Aws::S3::S3Client* s3_client,
 /**
  * @brief Read S3 object contents
  *
+ * Reads larger than `read_part_size()` are split into parts fetched concurrently,
+ * with up to `max_requests_in_flight()` requests at a time.
+ *
  * @param s3_client open S3 client
  * @param object_location object location
  * @param buf preallocated buffer location
@@ -68,7 +74,50 @@ DLL_PUBLIC size_t read_object_contents(Aws::S3::S3Client* s3_client,
                                        const S3ObjectLocation& object_location, void* buf, size_t n,
                                        size_t offset = 0);
 
+/**
+ * @brief A ranged read of an S3 object, issued asynchronously on the client's executor.
+ *
+ * The data is written directly to the destination buffer, which must stay valid until
+ * the read completes. The destructor waits for the request to finish.
+ */
+class DLL_PUBLIC S3AsyncRead {
+ public:
+  S3AsyncRead(Aws::S3::S3Client* s3_client, const S3ObjectLocation& object_location, void* buf,
+              size_t n, size_t offset);
+  ~S3AsyncRead();
+
+  S3AsyncRead(const S3AsyncRead&) = delete;
+  S3AsyncRead& operator=(const S3AsyncRead&) = delete;
+
+  /**
+   * @brief Waits for the read to complete and returns the number of bytes read.
+   *
+   * Throws if the request failed.
+   */
+  size_t Wait();
+
+ private:
+  std::unique_ptr<Aws::Utils::Stream::PreallocatedStreamBuf> streambuf_;
+  Aws::S3::Model::GetObjectOutcomeCallable outcome_;
+  std::optional<size_t> bytes_read_;
+};
+
+/**
+ * @brief Size of a single ranged request; larger reads are split into multiple requests.
+ *
+ * Can be adjusted with DALI_S3_PART_SIZE environment variable.
+ */
+DLL_PUBLIC size_t read_part_size();
+
+/**
+ * @brief Maximum number of ranged requests issued concurrently for a single read.
+ *
+ * Can be adjusted with DALI_S3_MAX_REQUESTS_IN_FLIGHT environment variable.
+ */
+DLL_PUBLIC int max_requests_in_flight();
+
 using PerObjectCallable = std::function<void(const std::string&, size_t)>;
+using PerPrefixCallable = std::function<void(const std::string&)>;
 
 /**
  * @brief Visits all objects under a given object location
@@ -76,10 +125,15 @@ using PerObjectCallable = std::function<void(const std::string&, size_t)>;
  * @param s3_client open S3 client
  * @param object_location S3 object location
  * @param per_object_call callable to run on each object listed
+ * @param per_prefix_call if provided, the listing is not recursive - the objects directly
+ *                        under the location are visited with `per_object_call` and the
+ *                        sub-prefixes ("subdirectories", ending with '/') are passed
+ *                        to `per_prefix_call` instead of being traversed
  */
 DLL_PUBLIC void list_objects_f(Aws::S3::S3Client* s3_client,
                                const S3ObjectLocation& object_location,
-                               PerObjectCallable per_object_call);
+                               PerObjectCallable per_object_call,
+                               PerPrefixCallable per_prefix_call = {});
 
 }  // namespace s3_filesystem
 
@@ -41,6 +41,10 @@ class StdCUFileStream : public CUFileStream {
   void HandleIOError(int64_t ret) const;
   size_t Size() const override;
 
+  const cufile::CUFileHandle &handle() const {
+    return f_;
+  }
+
   ~StdCUFileStream() override;
 
  private:
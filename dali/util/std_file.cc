@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <errno.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <cstdio>
 #include <cstring>
@@ -49,6 +50,11 @@ ptrdiff_t StdFileStream::TellRead() const {
   return std::ftell(fp_);
 }
 
+void StdFileStream::Prefetch(int64_t offset, size_t n_bytes) {
+  // only a hint - the errors are ignored
+  posix_fadvise(fileno(fp_), offset, n_bytes, POSIX_FADV_WILLNEED);
+}
+
 size_t StdFileStream::Read(void *buffer, size_t n_bytes) {
   size_t n_read = std::fread(buffer, 1, n_bytes, fp_);
   return n_read;
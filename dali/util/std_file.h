@@ -32,6 +32,7 @@ class StdFileStream : public FileStream {
   void SeekRead(ptrdiff_t pos, int whence = SEEK_SET) override;
   ptrdiff_t TellRead() const override;
   size_t Size() const override;
+  void Prefetch(int64_t offset, size_t n_bytes) override;
 
   ~StdFileStream() override;
 
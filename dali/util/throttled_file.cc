@@ -0,0 +1,168 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "dali/core/error_handling.h"
+#include "dali/util/throttled_file.h"
+
+namespace dali {
+
+namespace {
+
+using clock = std::chrono::steady_clock;
+
+struct StorageSimulationState {
+  std::mutex mtx;
+  StorageSimulation sim;
+  /// The moment at which the shared link finishes the transfers already scheduled
+  clock::time_point link_free_at = {};
+
+  StorageSimulationState() {
+    if (const char *env = std::getenv("DALI_SIMULATED_STORAGE"))
+      sim = ParseStorageSimulation(env);
+  }
+};
+
+StorageSimulationState &GetState() {
+  static StorageSimulationState state;
+  return state;
+}
+
+int64_t Jitter(int64_t max_us) {
+  if (max_us <= 0)
+    return 0;
+  static thread_local std::mt19937_64 rng(std::random_device{}());
+  return std::uniform_int_distribution<int64_t>(0, max_us)(rng);
+}
+
+}  // namespace
+
+StorageSimulation ParseStorageSimulation(const std::string &desc) {
+  StorageSimulation sim;
+  size_t pos = 0;
+  while (pos < desc.size()) {
+    size_t end = desc.find(',', pos);
+    if (end == std::string::npos)
+      end = desc.size();
+    std::string entry = desc.substr(pos, end - pos);
+    pos = end + 1;
+    if (entry.empty())
+      continue;
+    size_t eq = entry.find('=');
+    DALI_ENFORCE(eq != std::string::npos, make_string(
+        "Invalid storage simulation entry \"", entry, "\". Expected \"key=value\"."));
+    std::string key = entry.substr(0, eq), value = entry.substr(eq + 1);
+    try {
+      if (key == "open_latency_us") {
+        sim.open_latency_us = std::stoll(value);
+      } else if (key == "read_latency_us") {
+        sim.read_latency_us = std::stoll(value);
+      } else if (key == "jitter_us") {
+        sim.latency_jitter_us = std::stoll(value);
+      } else if (key == "bandwidth_mb_per_s") {
+        sim.bandwidth_mb_per_s = std::stod(value);
+      } else {
+        DALI_FAIL(make_string("Unknown storage simulation parameter \"", key, "\". Supported are: "
+                              "open_latency_us, read_latency_us, jitter_us, bandwidth_mb_per_s."));
+      }
+    } catch (const std::logic_error &) {
+      DALI_FAIL(make_string("Invalid value of the storage simulation parameter \"", key, "\": \"",
+                            value, "\"."));
+    }
+  }
+  DALI_ENFORCE(sim.open_latency_us >= 0 && sim.read_latency_us >= 0 &&
+               sim.latency_jitter_us >= 0 && sim.bandwidth_mb_per_s >= 0,
+               make_string("The storage simulation parameters must not be negative. Got: \"",
+                           desc, "\"."));
+  return sim;
+}
+
+void SetStorageSimulation(const StorageSimulation &sim) {
+  auto &state = GetState();
+  std::lock_guard<std::mutex> g(state.mtx);
+  state.sim = sim;
+}
+
+StorageSimulation GetStorageSimulation() {
+  auto &state = GetState();
+  std::lock_guard<std::mutex> g(state.mtx);
+  return state.sim;
+}
+
+ThrottledFileStream::ThrottledFileStream(std::unique_ptr<FileStream> inner,
+                                         const StorageSimulation &sim)
+    : FileStream(inner->path()), inner_(std::move(inner)), sim_(sim) {
+  Delay(sim_.open_latency_us, 0);
+}
+
+void ThrottledFileStream::Delay(int64_t latency_us, size_t n_bytes) {
+  auto now = clock::now();
+  auto done = now + std::chrono::microseconds(latency_us + Jitter(sim_.latency_jitter_us));
+  if (n_bytes > 0 && sim_.bandwidth_mb_per_s > 0) {
+    auto transfer = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double, std::micro>(n_bytes / sim_.bandwidth_mb_per_s));
+    // the transfer starts when the request is served and the link is free
+    auto &state = GetState();
+    std::lock_guard<std::mutex> g(state.mtx);
+    done = std::max(done, state.link_free_at) + transfer;
+    state.link_free_at = done;
+  }
+  std::this_thread::sleep_until(done);
+}
+
+void ThrottledFileStream::Close() {
+  inner_->Close();
+}
+
+bool ThrottledFileStream::CanMemoryMap() {
+  return inner_->CanMemoryMap();
+}
+
+shared_ptr<void> ThrottledFileStream::Get(size_t n_bytes) {
+  Delay(sim_.read_latency_us, n_bytes);
+  return inner_->Get(n_bytes);
+}
+
+size_t ThrottledFileStream::Read(void *buffer, size_t n_bytes) {
+  Delay(sim_.read_latency_us, n_bytes);
+  return inner_->Read(buffer, n_bytes);
+}
+
+void ThrottledFileStream::SeekRead(ptrdiff_t pos, int whence) {
+  inner_->SeekRead(pos, whence);
+}
+
+ptrdiff_t ThrottledFileStream::TellRead() const {
+  return inner_->TellRead();
+}
+
+size_t ThrottledFileStream::Size() const {
+  return inner_->Size();
+}
+
+void ThrottledFileStream::Prefetch(int64_t offset, size_t n_bytes) {
+  // not delayed - the hint doesn't wait for the storage
+  inner_->Prefetch(offset, n_bytes);
+}
+
+}  // namespace dali
@@ -0,0 +1,100 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_UTIL_THROTTLED_FILE_H_
+#define DALI_UTIL_THROTTLED_FILE_H_
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "dali/core/api_helper.h"
+#include "dali/core/common.h"
+#include "dali/util/file.h"
+
+namespace dali {
+
+/**
+ * @brief Parameters of the simulated storage
+ *
+ * Used to benchmark the readers as if the data was kept on a network file system or
+ * an object store, while it actually comes from a local disk or the page cache.
+ */
+struct StorageSimulation {
+  /// Delay of opening a file, in microseconds
+  int64_t open_latency_us = 0;
+  /// Delay of each read request, in microseconds
+  int64_t read_latency_us = 0;
+  /// Random delay, uniformly distributed in [0, latency_jitter_us], added to each delay
+  int64_t latency_jitter_us = 0;
+  /// Throughput of the link, in megabytes per second, shared by all streams; 0 means unlimited
+  double bandwidth_mb_per_s = 0;
+
+  bool enabled() const {
+    return open_latency_us > 0 || read_latency_us > 0 || latency_jitter_us > 0 ||
+           bandwidth_mb_per_s > 0;
+  }
+};
+
+/**
+ * @brief Parses the storage simulation parameters
+ *
+ * The format is a comma-separated list of `key=value` pairs, e.g.
+ * "open_latency_us=2000,read_latency_us=500,jitter_us=200,bandwidth_mb_per_s=100".
+ * The keys which are not given keep their default (zero) values.
+ */
+DLL_PUBLIC StorageSimulation ParseStorageSimulation(const std::string &desc);
+
+/**
+ * @brief Sets the storage simulation applied to the streams opened with FileStream::Open
+ *
+ * The initial value is taken from the environment variable DALI_SIMULATED_STORAGE.
+ * The streams which are already open keep their parameters.
+ */
+DLL_PUBLIC void SetStorageSimulation(const StorageSimulation &sim);
+
+DLL_PUBLIC StorageSimulation GetStorageSimulation();
+
+/**
+ * @brief A stream that delays the operations of another stream according to
+ *        the storage simulation parameters
+ *
+ * The latency of the requests is independent, so the concurrent requests overlap;
+ * the transfers are serialized on a link with the given bandwidth, shared by all streams.
+ */
+class DLL_PUBLIC ThrottledFileStream : public FileStream {
+ public:
+  ThrottledFileStream(std::unique_ptr<FileStream> inner, const StorageSimulation &sim);
+
+  void Close() override;
+  bool CanMemoryMap() override;
+  shared_ptr<void> Get(size_t n_bytes) override;
+  size_t Read(void *buffer, size_t n_bytes) override;
+  void SeekRead(ptrdiff_t pos, int whence = SEEK_SET) override;
+  ptrdiff_t TellRead() const override;
+  size_t Size() const override;
+  void Prefetch(int64_t offset, size_t n_bytes) override;
+
+  FileStream *inner() const { return inner_.get(); }
+
+ private:
+  void Delay(int64_t latency_us, size_t n_bytes);
+
+  std::unique_ptr<FileStream> inner_;
+  StorageSimulation sim_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_UTIL_THROTTLED_FILE_H_
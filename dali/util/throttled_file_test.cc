@@ -0,0 +1,115 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "dali/util/throttled_file.h"
+
+namespace dali {
+
+namespace {
+
+class ThrottledFileStreamTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    filename_ = "/tmp/dali_throttled_test_XXXXXX";
+    int fd = mkstemp(&filename_[0]);
+    ASSERT_NE(-1, fd);
+    data_.resize(100000);
+    std::iota(data_.begin(), data_.end(), 0);
+    ASSERT_EQ(write(fd, data_.data(), data_.size()), static_cast<ssize_t>(data_.size()));
+    close(fd);
+    prev_sim_ = GetStorageSimulation();
+  }
+
+  void TearDown() override {
+    SetStorageSimulation(prev_sim_);
+    std::remove(filename_.c_str());
+  }
+
+  std::string filename_;
+  std::vector<char> data_;
+  StorageSimulation prev_sim_;
+};
+
+double ElapsedMs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+TEST(StorageSimulationTest, Parse) {
+  auto sim = ParseStorageSimulation(
+      "open_latency_us=2000,read_latency_us=500,jitter_us=100,bandwidth_mb_per_s=12.5");
+  EXPECT_EQ(sim.open_latency_us, 2000);
+  EXPECT_EQ(sim.read_latency_us, 500);
+  EXPECT_EQ(sim.latency_jitter_us, 100);
+  EXPECT_EQ(sim.bandwidth_mb_per_s, 12.5);
+  EXPECT_TRUE(sim.enabled());
+  EXPECT_FALSE(ParseStorageSimulation("").enabled());
+  EXPECT_THROW(ParseStorageSimulation("latency=5"), std::exception);
+  EXPECT_THROW(ParseStorageSimulation("read_latency_us"), std::exception);
+  EXPECT_THROW(ParseStorageSimulation("read_latency_us=x"), std::exception);
+  EXPECT_THROW(ParseStorageSimulation("read_latency_us=-1"), std::exception);
+}
+
+TEST_F(ThrottledFileStreamTest, Latency) {
+  StorageSimulation sim;
+  sim.open_latency_us = 20000;
+  sim.read_latency_us = 10000;
+  SetStorageSimulation(sim);
+
+  auto start = std::chrono::steady_clock::now();
+  auto file = FileStream::Open(filename_);
+  ASSERT_NE(dynamic_cast<ThrottledFileStream *>(file.get()), nullptr);
+  EXPECT_GE(ElapsedMs(start), 20);
+  EXPECT_EQ(file->Size(), data_.size());
+
+  std::vector<char> buf(data_.size());
+  start = std::chrono::steady_clock::now();
+  EXPECT_EQ(file->Read(buf.data(), 1000), 1000u);
+  file->SeekRead(1000);
+  EXPECT_EQ(file->Read(buf.data() + 1000, buf.size() - 1000), buf.size() - 1000);
+  EXPECT_GE(ElapsedMs(start), 20);
+  EXPECT_EQ(buf, data_);
+}
+
+TEST_F(ThrottledFileStreamTest, Bandwidth) {
+  StorageSimulation sim;
+  sim.bandwidth_mb_per_s = 2;  // 100 kB take 50 ms
+  SetStorageSimulation(sim);
+  auto file = FileStream::Open(filename_, {false, true, false});
+  ASSERT_TRUE(file->CanMemoryMap());
+  auto start = std::chrono::steady_clock::now();
+  auto p = file->Get(data_.size());
+  EXPECT_GE(ElapsedMs(start), 50);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(std::memcmp(p.get(), data_.data(), data_.size()), 0);
+}
+
+TEST_F(ThrottledFileStreamTest, Disabled) {
+  SetStorageSimulation({});
+  auto file = FileStream::Open(filename_);
+  EXPECT_EQ(dynamic_cast<ThrottledFileStream *>(file.get()), nullptr);
+}
+
+}  // namespace dali
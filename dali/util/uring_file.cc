@@ -0,0 +1,423 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define DALI_HAS_IO_URING_HEADER 1
+#else
+#define DALI_HAS_IO_URING_HEADER 0
+#endif
+
+#include "dali/core/call_at_exit.h"
+#include "dali/core/error_handling.h"
+#include "dali/util/uring_file.h"
+
+namespace dali {
+
+namespace {
+
+constexpr unsigned kDefaultQueueDepth = 64;
+
+/**
+ * @brief Reads the whole request with pread, retrying on short reads.
+ *
+ * @return false if the end of file was reached before the request was satisfied
+ */
+bool PReadFully(int fd, char *dst, size_t n_bytes, off_t offset) {
+  while (n_bytes > 0) {
+    ssize_t ret = pread(fd, dst, n_bytes, offset);
+    if (ret < 0) {
+      if (errno == EINTR)
+        continue;
+      DALI_FAIL(make_string("Read operation failed: ", std::strerror(errno)));
+    }
+    if (ret == 0)
+      return false;
+    dst += ret;
+    offset += ret;
+    n_bytes -= ret;
+  }
+  return true;
+}
+
+#if DALI_HAS_IO_URING_HEADER && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+
+/**
+ * @brief A minimal io_uring instance using the raw kernel interface.
+ *
+ * Only IORING_OP_READ is used. The ring is owned by a single thread, so no locking is needed,
+ * but the memory shared with the kernel is accessed with acquire/release semantics.
+ */
+class IoUring {
+ public:
+  explicit IoUring(unsigned entries) {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    ring_fd_ = syscall(__NR_io_uring_setup, entries, &params);
+    if (ring_fd_ < 0)
+      return;
+
+    sq_entries_ = params.sq_entries;
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap)
+      sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+    sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    ring_fd_, IORING_OFF_SQ_RING);
+    if (sq_ring_ == MAP_FAILED) {
+      sq_ring_ = nullptr;
+      Destroy();
+      return;
+    }
+    if (single_mmap) {
+      cq_ring_ = sq_ring_;
+    } else {
+      cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring_fd_, IORING_OFF_CQ_RING);
+      if (cq_ring_ == MAP_FAILED) {
+        cq_ring_ = nullptr;
+        Destroy();
+        return;
+      }
+    }
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring_fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+      Destroy();
+      return;
+    }
+    sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+    char *sq = static_cast<char *>(sq_ring_);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+
+    char *cq = static_cast<char *>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+  }
+
+  ~IoUring() {
+    Destroy();
+  }
+
+  IoUring(const IoUring &) = delete;
+  IoUring &operator=(const IoUring &) = delete;
+
+  bool valid() const {
+    return sqes_ != nullptr;
+  }
+
+  unsigned capacity() const {
+    return sq_entries_;
+  }
+
+  /**
+   * @brief Places a read in the submission queue; the caller must not exceed `capacity()`
+   *        reads in flight.
+   */
+  void PrepareRead(int fd, void *dst, size_t n_bytes, off_t offset, uint64_t user_data) {
+    unsigned tail = *sq_tail_;
+    unsigned idx = tail & sq_mask_;
+    io_uring_sqe *sqe = &sqes_[idx];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(dst);
+    sqe->len = static_cast<uint32_t>(n_bytes);
+    sqe->off = offset;
+    sqe->user_data = user_data;
+    sq_array_[idx] = idx;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+    pending_submit_++;
+  }
+
+  /**
+   * @brief Submits the prepared reads and waits until at least `min_complete` completions
+   *        are available.
+   */
+  void Enter(unsigned min_complete) {
+    for (;;) {
+      int ret = syscall(__NR_io_uring_enter, ring_fd_, pending_submit_, min_complete,
+                        min_complete ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+      if (ret >= 0) {
+        pending_submit_ -= std::min<unsigned>(ret, pending_submit_);
+        if (pending_submit_ == 0 || min_complete > 0)
+          return;
+        continue;
+      }
+      if (errno == EINTR)
+        continue;
+      DALI_FAIL(make_string("io_uring_enter failed: ", std::strerror(errno)));
+    }
+  }
+
+  /**
+   * @brief Calls `fn(user_data, result)` for each available completion.
+   */
+  template <typename Fn>
+  unsigned Reap(Fn &&fn) {
+    unsigned head = *cq_head_;
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    unsigned n = 0;
+    for (; head != tail; head++, n++) {
+      const io_uring_cqe &cqe = cqes_[head & cq_mask_];
+      fn(cqe.user_data, cqe.res);
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    return n;
+  }
+
+ private:
+  void Destroy() {
+    if (sqes_)
+      munmap(sqes_, sqes_size_);
+    if (cq_ring_ && cq_ring_ != sq_ring_)
+      munmap(cq_ring_, cq_ring_size_);
+    if (sq_ring_)
+      munmap(sq_ring_, sq_ring_size_);
+    if (ring_fd_ >= 0)
+      close(ring_fd_);
+    sqes_ = nullptr;
+    cq_ring_ = sq_ring_ = nullptr;
+    ring_fd_ = -1;
+  }
+
+  int ring_fd_ = -1;
+  unsigned sq_entries_ = 0;
+  unsigned pending_submit_ = 0;
+  size_t sq_ring_size_ = 0, cq_ring_size_ = 0, sqes_size_ = 0;
+  void *sq_ring_ = nullptr, *cq_ring_ = nullptr;
+  io_uring_sqe *sqes_ = nullptr;
+  unsigned *sq_tail_ = nullptr, *sq_array_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned *cq_head_ = nullptr, *cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  io_uring_cqe *cqes_ = nullptr;
+};
+
+IoUring *ThreadRing() {
+  // Each reading thread gets its own ring - the rings are cheap and this avoids any locking
+  thread_local std::unique_ptr<IoUring> ring = [] {
+    auto r = std::make_unique<IoUring>(UringFileStream::GetQueueDepth());
+    if (!r->valid())
+      r.reset();
+    return r;
+  }();
+  return ring.get();
+}
+
+#else
+
+struct IoUring {};
+
+IoUring *ThreadRing() {
+  return nullptr;
+}
+
+#endif
+
+}  // namespace
+
+UringFileStream::UringFileStream(const std::string& path) : FileStream(path) {
+  fd_ = open(path.c_str(), O_RDONLY);
+  DALI_ENFORCE(fd_ >= 0, "Could not open file " + path + ": " + std::strerror(errno));
+}
+
+UringFileStream::~UringFileStream() {
+  Close();
+}
+
+void UringFileStream::Close() {
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+void UringFileStream::SeekRead(ptrdiff_t pos, int whence) {
+  if (whence == SEEK_CUR)
+    pos += pos_;
+  else if (whence == SEEK_END)
+    pos += Size();
+  else
+    DALI_ENFORCE(whence == SEEK_SET, "Invalid seek");
+  DALI_ENFORCE(pos >= 0, make_string("Invalid seek position: ", pos));
+  pos_ = pos;
+}
+
+ptrdiff_t UringFileStream::TellRead() const {
+  return pos_;
+}
+
+size_t UringFileStream::ReadAt(void *buffer, size_t n_bytes, off_t offset) {
+  ssize_t n_read;
+  do {
+    n_read = pread(fd_, buffer, n_bytes, offset);
+  } while (n_read < 0 && errno == EINTR);
+  DALI_ENFORCE(n_read >= 0, make_string("Read operation failed: ", std::strerror(errno)));
+  return n_read;
+}
+
+size_t UringFileStream::Read(void *buffer, size_t n_bytes) {
+  size_t n_read = ReadAt(buffer, n_bytes, pos_);
+  pos_ += n_read;
+  return n_read;
+}
+
+void UringFileStream::Prefetch(int64_t offset, size_t n_bytes) {
+  // only a hint - the errors are ignored
+  posix_fadvise(fd_, offset, n_bytes, POSIX_FADV_WILLNEED);
+}
+
+size_t UringFileStream::Size() const {
+  struct stat sb;
+  if (fstat(fd_, &sb) == -1) {
+    DALI_FAIL("Unable to stat file " + path_ + ": " + std::strerror(errno));
+  }
+  return sb.st_size;
+}
+
+unsigned UringFileStream::GetQueueDepth() {
+  static const unsigned depth = []() {
+    const char *env = std::getenv("DALI_IO_URING_QUEUE_DEPTH");
+    if (!env || !*env)
+      return kDefaultQueueDepth;
+    int value = std::atoi(env);
+    DALI_ENFORCE(value > 0 && value <= 4096, make_string(
+        "DALI_IO_URING_QUEUE_DEPTH must be a number between 1 and 4096, got: ", env));
+    return static_cast<unsigned>(value);
+  }();
+  return depth;
+}
+
+bool UringFileStream::IsSupported() {
+  return ThreadRing() != nullptr;
+}
+
+void UringFileStream::ReadBatch(span<const ReadRequest> requests) {
+  auto read_fallback = [](const ReadRequest &r) {
+    DALI_ENFORCE(PReadFully(r.file->fd_, static_cast<char *>(r.buffer), r.n_bytes, r.offset),
+                 make_string("Failed to read file: ", r.file->path(), ", requested ",
+                             r.n_bytes, " bytes at offset ", r.offset));
+  };
+
+  IoUring *ring = ThreadRing();
+  if (!ring) {
+    for (auto &r : requests)
+      read_fallback(r);
+    return;
+  }
+
+#if DALI_HAS_IO_URING_HEADER && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+  // Progress of each request - a short read is resubmitted for the remaining part
+  std::vector<size_t> done(requests.size(), 0);
+  std::vector<int64_t> queue;
+  queue.reserve(requests.size());
+  for (int64_t i = requests.size() - 1; i >= 0; i--)
+    queue.push_back(i);
+
+  // Errors are not thrown until all the reads in flight complete - otherwise the kernel
+  // could still be writing to the buffers after the caller had released them.
+  std::string error_msg;
+  unsigned in_flight = 0;
+  while ((!queue.empty() && error_msg.empty()) || in_flight > 0) {
+    while (!queue.empty() && error_msg.empty() && in_flight < ring->capacity()) {
+      int64_t i = queue.back();
+      queue.pop_back();
+      auto &r = requests[i];
+      // a single read is limited to 2GB - 1 by the kernel, so big requests are split
+      size_t n = std::min<size_t>(r.n_bytes - done[i], 1u << 30);
+      ring->PrepareRead(r.file->fd_, static_cast<char *>(r.buffer) + done[i], n,
+                        r.offset + done[i], i);
+      in_flight++;
+    }
+    ring->Enter(1);
+    in_flight -= ring->Reap([&](uint64_t i, int res) {
+      auto &r = requests[i];
+      if (res == -EINTR || res == -EAGAIN) {
+        queue.push_back(i);
+      } else if (res == -EINVAL || res == -EOPNOTSUPP) {
+        // e.g. the kernel doesn't support IORING_OP_READ - fall back to plain reads
+        size_t offset = done[i];
+        try {
+          if (!PReadFully(r.file->fd_, static_cast<char *>(r.buffer) + offset,
+                          r.n_bytes - offset, r.offset + offset) && error_msg.empty())
+            error_msg = make_string("Failed to read file: ", r.file->path());
+        } catch (const std::exception &e) {
+          if (error_msg.empty())
+            error_msg = e.what();
+        }
+        done[i] = r.n_bytes;
+      } else if (res < 0) {
+        if (error_msg.empty())
+          error_msg = make_string("Failed to read file: ", r.file->path(), ": ",
+                                  std::strerror(-res));
+      } else if (res == 0) {
+        if (error_msg.empty())
+          error_msg = make_string("Failed to read file: ", r.file->path(),
+                                  ", unexpected end of file at offset ", r.offset + done[i]);
+      } else {
+        done[i] += res;
+        if (done[i] < r.n_bytes)
+          queue.push_back(i);
+      }
+    });
+  }
+  if (!error_msg.empty())
+    DALI_FAIL(error_msg);
+#endif
+}
+
+void UringReadBatch::Add(std::shared_ptr<FileStream> file, void *buffer, size_t n_bytes,
+                         off_t offset) {
+  auto *uring_file = dynamic_cast<UringFileStream *>(file.get());
+  DALI_ENFORCE(uring_file != nullptr,
+               make_string("File ", file->path(), " was not opened for io_uring reading."));
+  requests_.push_back({uring_file, buffer, n_bytes, offset});
+  if (files_.empty() || files_.back() != file)
+    files_.push_back(std::move(file));
+}
+
+void UringReadBatch::Submit() {
+  if (requests_.empty())
+    return;
+  auto cleanup = AtScopeExit([&]() {
+    requests_.clear();
+    files_.clear();
+  });
+  UringFileStream::ReadBatch(make_cspan(requests_));
+}
+
+}  // namespace dali
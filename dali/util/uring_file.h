@@ -0,0 +1,113 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_UTIL_URING_FILE_H_
+#define DALI_UTIL_URING_FILE_H_
+
+#include <sys/types.h>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/core/span.h"
+#include "dali/util/file.h"
+
+namespace dali {
+
+/**
+ * @brief File stream which can read many regions (possibly from many files) with a single
+ *        io_uring submission.
+ *
+ * Regular `Read` calls are served with `pread`. The benefit comes from `ReadBatch`, which
+ * submits all the requests to a per-thread io_uring instance and reaps the completions.
+ * If io_uring is not available (old kernel, seccomp filter in a container), `ReadBatch`
+ * falls back to issuing `pread` calls one by one.
+ */
+class DLL_PUBLIC UringFileStream : public FileStream {
+ public:
+  struct ReadRequest {
+    UringFileStream *file;
+    void *buffer;
+    size_t n_bytes;
+    off_t offset;
+  };
+
+  explicit UringFileStream(const std::string& path);
+  void Close() override;
+  size_t Read(void * buffer, size_t n_bytes) override;
+  size_t ReadAt(void * buffer, size_t n_bytes, off_t offset);
+  void SeekRead(ptrdiff_t pos, int whence = SEEK_SET) override;
+  ptrdiff_t TellRead() const override;
+  size_t Size() const override;
+  void Prefetch(int64_t offset, size_t n_bytes) override;
+
+  /**
+   * @brief Reads all the requests, submitting them to the kernel in as few calls as possible.
+   *
+   * Throws if any of the requests could not be read in full.
+   */
+  static void ReadBatch(span<const ReadRequest> requests);
+
+  /**
+   * @brief Checks if the running kernel allows creating io_uring instances.
+   */
+  static bool IsSupported();
+
+  /**
+   * @brief The number of submission queue entries of the per-thread ring.
+   *
+   * Can be adjusted with DALI_IO_URING_QUEUE_DEPTH environment variable.
+   */
+  static unsigned GetQueueDepth();
+
+  ~UringFileStream() override;
+
+ private:
+  int fd_;
+  ptrdiff_t pos_ = 0;
+};
+
+/**
+ * @brief Collects reads to be done with `UringFileStream::ReadBatch`.
+ *
+ * The batch keeps the files alive until the reads are submitted, so the loaders can drop
+ * their references as soon as the read is scheduled.
+ */
+class DLL_PUBLIC UringReadBatch {
+ public:
+  void Add(std::shared_ptr<FileStream> file, void *buffer, size_t n_bytes, off_t offset);
+
+  /**
+   * @brief Reads all the collected requests and clears the batch.
+   */
+  void Submit();
+
+  bool empty() const {
+    return requests_.empty();
+  }
+
+  size_t size() const {
+    return requests_.size();
+  }
+
+ private:
+  std::vector<UringFileStream::ReadRequest> requests_;
+  std::vector<std::shared_ptr<FileStream>> files_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_UTIL_URING_FILE_H_
@@ -0,0 +1,89 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "dali/util/uring_file.h"
+
+namespace dali {
+
+namespace {
+
+class UringFileStreamTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    filename_ = "/tmp/dali_uring_test_XXXXXX";
+    int fd = mkstemp(&filename_[0]);
+    ASSERT_NE(-1, fd);
+    data_.resize(1 << 20);
+    std::iota(data_.begin(), data_.end(), 0);
+    ASSERT_EQ(write(fd, data_.data(), data_.size()), static_cast<ssize_t>(data_.size()));
+    close(fd);
+  }
+
+  void TearDown() override {
+    std::remove(filename_.c_str());
+  }
+
+  std::string filename_;
+  std::vector<char> data_;
+};
+
+}  // namespace
+
+TEST_F(UringFileStreamTest, ReadAndSeek) {
+  auto file = FileStream::Open(filename_, {false, false, false, true});
+  ASSERT_NE(dynamic_cast<UringFileStream *>(file.get()), nullptr);
+  EXPECT_EQ(file->Size(), data_.size());
+  std::vector<char> buf(100);
+  file->SeekRead(1000);
+  EXPECT_EQ(file->Read(buf.data(), buf.size()), buf.size());
+  EXPECT_EQ(std::memcmp(buf.data(), data_.data() + 1000, buf.size()), 0);
+  EXPECT_EQ(file->TellRead(), 1100);
+}
+
+TEST_F(UringFileStreamTest, ReadBatch) {
+  // more requests than the ring size, to check that the queue is refilled
+  int n = UringFileStream::GetQueueDepth() * 3 + 1;
+  std::shared_ptr<FileStream> file = std::make_shared<UringFileStream>(filename_);
+  std::vector<std::vector<char>> out(n);
+  UringReadBatch batch;
+  for (int i = 0; i < n; i++) {
+    out[i].resize(100 + i);
+    batch.Add(file, out[i].data(), out[i].size(), i * 1000);
+  }
+  EXPECT_EQ(batch.size(), static_cast<size_t>(n));
+  batch.Submit();
+  EXPECT_TRUE(batch.empty());
+  for (int i = 0; i < n; i++)
+    EXPECT_EQ(std::memcmp(out[i].data(), data_.data() + i * 1000, out[i].size()), 0)
+      << "Request " << i << " returned wrong data";
+}
+
+TEST_F(UringFileStreamTest, ReadBatchPastEnd) {
+  std::shared_ptr<FileStream> file = std::make_shared<UringFileStream>(filename_);
+  std::vector<char> buf(100);
+  UringReadBatch batch;
+  batch.Add(file, buf.data(), buf.size(), data_.size() - 10);
+  EXPECT_THROW(batch.Submit(), std::exception);
+  EXPECT_TRUE(batch.empty());
+}
+
+}  // namespace dali
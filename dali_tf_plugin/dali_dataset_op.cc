@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <chrono>
+#include <deque>
+#include <map>
 #include <queue>
 #include <sstream>
 #include <vector>
@@ -220,6 +222,7 @@ class DALIDatasetOp::Dataset : public DatasetBase {
     SerializeField(attrs, b, kNumThreads, pipeline_def_.num_threads);
     SerializeField(attrs, b, kDeviceId, pipeline_def_.device_id);
     SerializeField(attrs, b, kExecSeparated, pipeline_def_.exec_separated);
+    SerializeField(attrs, b, kExecDynamic, pipeline_def_.exec_dynamic);
     SerializeField(attrs, b, kPrefetchQueueDepth, pipeline_def_.prefetch_queue_depth);
     SerializeField(attrs, b, kCpuPrefetchQueueDepth, pipeline_def_.cpu_prefetch_queue_depth);
     SerializeField(attrs, b, kGpuPrefetchQueueDepth, pipeline_def_.gpu_prefetch_queue_depth);
@@ -248,6 +251,17 @@ class DALIDatasetOp::Dataset : public DatasetBase {
   }
 
   Status InitPipeline(daliPipelineHandle *pipeline_handle) const {
+    if (pipeline_def_.exec_dynamic) {
+      auto flags = DALI_EXEC_DYNAMIC;
+      if (pipeline_def_.exec_separated)
+        flags = flags | DALI_EXEC_IS_SEPARATED;
+      TF_DALI_CALL(daliCreatePipeline3(
+          pipeline_handle, pipeline_def_.pipeline.c_str(), pipeline_def_.pipeline.length(),
+          pipeline_def_.batch_size, pipeline_def_.num_threads, pipeline_def_.device_id, flags,
+          pipeline_def_.prefetch_queue_depth, pipeline_def_.cpu_prefetch_queue_depth,
+          pipeline_def_.gpu_prefetch_queue_depth, pipeline_def_.enable_memory_stats));
+      return Status();
+    }
     TF_DALI_CALL(daliCreatePipeline(
         pipeline_handle, pipeline_def_.pipeline.c_str(), pipeline_def_.pipeline.length(),
         pipeline_def_.batch_size, pipeline_def_.num_threads, pipeline_def_.device_id,
@@ -374,7 +388,7 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
     // We schedule next run always when we don't have inputs or when we have inputs
     // and they produced something - which happens only in `in_progress` state.
     if (!dataset()->HasInputs() || iterator_state_ == InputState::in_progress) {
-      TF_DALI_CALL(daliRun(&pipeline_handle_));
+      TF_RETURN_IF_ERROR(RunPipeline(context));
     }
     return Status();
   }
@@ -444,6 +458,9 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
       &pipeline_handle_, cpt_data.data(), cpt_data.size(), &external_context));
 
     // Checkpointing is not supported with separated queues, so we can just prefetch uniformly
+    output_buffers_.clear();
+    for (int i = 0; i < dataset()->pipeline_def_.prefetch_queue_depth; i++)
+      TF_RETURN_IF_ERROR(ProvideOutputBuffers(ctx));
     TF_DALI_CALL(daliPrefetchUniform(&pipeline_handle_,
                                      dataset()->pipeline_def_.prefetch_queue_depth));
 
@@ -456,6 +473,62 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
 #endif
 
  private:
+  /**
+   * @brief Whether DALI writes the outputs directly to the TF tensors, see ProvideOutputBuffers
+   */
+  bool UseOutputBuffers() const {
+    return dataset()->pipeline_def_.exec_dynamic && !dataset()->pipeline_def_.exec_separated &&
+           dataset()->device_type_ == device_type_t::GPU;
+  }
+
+  /**
+   * @brief Allocates the TF tensors in which the next scheduled iteration produces its GPU
+   * outputs, so that they needn't be copied.
+   *
+   * The shape is taken from `output_shapes`, if fully defined, or from the previous iteration.
+   * If the actual output doesn't match it, the buffer is dropped and the output is copied
+   * to a new tensor, as usual.
+   */
+  Status ProvideOutputBuffers(IteratorContext *context) {
+    if (!UseOutputBuffers())
+      return Status();
+    auto num_outputs = 0;
+    TF_DALI_CALL(num_outputs = daliGetNumOutput(&pipeline_handle_));
+    std::vector<Tensor> buffers(num_outputs);
+    for (int out_id = 0; out_id < num_outputs; out_id++) {
+      device_type_t device;
+      TF_DALI_CALL(device = daliGetOutputDevice(&pipeline_handle_, out_id));
+      if (device != device_type_t::GPU)
+        continue;
+      TensorShape shape;
+      if (!dataset()->shapes_[out_id].AsTensorShape(&shape)) {
+        auto it = last_shapes_.find(out_id);
+        if (it == last_shapes_.end())
+          continue;
+        shape = it->second;
+      }
+      if (shape.num_elements() == 0)
+        continue;
+      Tensor buffer(context->allocator({}), dataset()->dtypes_[out_id], shape);
+      auto data = buffer.tensor_data();
+      TF_DALI_CALL(daliSetOutputBuffer(&pipeline_handle_, out_id,
+                                       const_cast<char *>(data.data()), data.size(),
+                                       dataset()->stream_));
+      buffers[out_id] = std::move(buffer);
+    }
+    output_buffers_.push_back(std::move(buffers));
+    return Status();
+  }
+
+  /**
+   * @brief Schedule a run of DALI Pipeline, providing the output buffers for it.
+   */
+  Status RunPipeline(IteratorContext *context) {
+    TF_RETURN_IF_ERROR(ProvideOutputBuffers(context));
+    TF_DALI_CALL(daliRun(&pipeline_handle_));
+    return Status();
+  }
+
   /**
    * @brief Schedule required number of runs of DALI Pipeline to fill the prefetch queue.
    *
@@ -486,7 +559,7 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
         actual_prefetch_depth = prefetch_depth;
       }
       for (int i = 0; i < actual_prefetch_depth; i++)
-        TF_DALI_CALL(daliRun(pipeline_handle));
+        TF_RETURN_IF_ERROR(RunPipeline(context));
     } else {
       if (dataset()->HasInputs()) {
         return errors::InvalidArgument("Input datasets are not compatible with split executor.");
@@ -610,6 +683,13 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
                         bool &end_of_sequence) {
     TF_DALI_CALL(daliShareOutput(&pipeline_handle_));
 
+    // The buffers provided for this iteration, if any
+    std::vector<Tensor> buffers;
+    if (!output_buffers_.empty()) {
+      buffers = std::move(output_buffers_.front());
+      output_buffers_.pop_front();
+    }
+
     auto num_outputs = 0;
     TF_DALI_CALL(num_outputs = daliGetNumOutput(&pipeline_handle_));
 
@@ -659,7 +739,15 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
         return errors::InvalidArgument(ss.str());
       }
 
-      out_tensors->emplace_back(context->allocator({}), dataset()->dtypes_[out_id], output_shape);
+      if (out_id < static_cast<int>(buffers.size()) && buffers[out_id].IsInitialized() &&
+          buffers[out_id].shape() == output_shape) {
+        // DALI has produced the output in this tensor - the copy below is a no-op
+        out_tensors->push_back(std::move(buffers[out_id]));
+      } else {
+        out_tensors->emplace_back(context->allocator({}), dataset()->dtypes_[out_id],
+                                  output_shape);
+      }
+      last_shapes_[out_id] = output_shape;
       tensorflow::Tensor &output = out_tensors->operator[](out_id);
 
       void *dst = nullptr;  // TODO(klecki): output.data();
@@ -940,6 +1028,9 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
   // Obtained from pipeline, the `device` parameter of external source nodes used for inputs
   std::vector<dali_backend_t> input_ext_src_devices_;
   std::queue<ListOfBatches> alive_batches_;
+  // The tensors in which the scheduled iterations produce their outputs; see ProvideOutputBuffers
+  std::deque<std::vector<Tensor>> output_buffers_;
+  std::map<int, TensorShape> last_shapes_;
   InputState iterator_state_ = InputState::in_progress;
   daliPipelineHandle pipeline_handle_;
   bool enable_memory_stats_;
@@ -959,6 +1050,7 @@ void DALIDatasetOp::FillPipelineDef(OpKernelConstruction *context, PipelineDef &
   OP_REQUIRES_OK(context, context->GetAttr(kNumThreads, &def.num_threads));
   OP_REQUIRES_OK(context, context->GetAttr(kDeviceId, &def.device_id));
   OP_REQUIRES_OK(context, context->GetAttr(kExecSeparated, &def.exec_separated));
+  OP_REQUIRES_OK(context, context->GetAttr(kExecDynamic, &def.exec_dynamic));
   OP_REQUIRES_OK(context, context->GetAttr(kPrefetchQueueDepth, &def.prefetch_queue_depth));
   OP_REQUIRES_OK(context, context->GetAttr(kCpuPrefetchQueueDepth, &def.cpu_prefetch_queue_depth));
   OP_REQUIRES_OK(context, context->GetAttr(kGpuPrefetchQueueDepth, &def.gpu_prefetch_queue_depth));
@@ -1079,6 +1171,7 @@ REGISTER_OP("DALIDataset")
     .Attr("num_threads: int")
     .Attr("device_id: int")
     .Attr("exec_separated: bool")
+    .Attr("exec_dynamic: bool = false")
     .Attr("prefetch_queue_depth: int")
     .Attr("cpu_prefetch_queue_depth: int")
     .Attr("gpu_prefetch_queue_depth: int")
@@ -86,7 +86,7 @@ def fn_to_op_table(out_filename):
     for op in sorted(all_ops, key=name_sort):
         op_full_name, submodule, op_name = ops._process_op_name(op, api="ops")
         fn_full_name = ops._op_name(op, api="fn")
-        schema = b.TryGetSchema(op)
+        schema = b.TryGetSchema(op, load=True)
         if schema:
             if schema.IsDocHidden():
                 continue
@@ -141,7 +141,7 @@ def operations_table_str(ops_to_process):
             fn_full_name = ops._op_name(op, api="fn")
             if op_name in removed_ops:
                 continue
-            schema = b.TryGetSchema(op)
+            schema = b.TryGetSchema(op, load=True)
             short_descr = ""
             devices = []
             if op in cpu_ops:
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -355,6 +355,45 @@ daliSetExternalInput(daliPipelineHandle *pipe_handle, const char *name,
                      device_type_t device, const void *data_ptr,
                      dali_data_type_t data_type, const int64_t *shapes,
                      int sample_dim, const char *layout_str, unsigned int flags);
+
+/**
+ * @brief Notifies the producer that DALI no longer uses a buffer passed to
+ *        `daliSetExternalInputWithRelease`.
+ *
+ * @param data_ptr The buffer.
+ * @param user_data The value passed to `daliSetExternalInputWithRelease`.
+ * @param done If the buffer was last used on a CUDA stream (GPU inputs and pinned CPU inputs),
+ *             an event recorded after that use; the buffer must not be reused before the event
+ *             completes - e.g. make the producer's stream wait for it. The event is valid only
+ *             until the callback returns. NULL otherwise.
+ */
+typedef void (*daliExternalInputReleaseCallback)(void *data_ptr, void *user_data,
+                                                 cudaEvent_t done);
+
+/**
+ * @brief Feed the data to ExternalSource as contiguous memory, without copying it, and get
+ *        notified when DALI no longer needs it.
+ *
+ * Works like `daliSetExternalInputAsync` with `DALI_ext_force_no_copy`, but the buffer doesn't
+ * have to be kept alive for an unspecified time: `release` is called once DALI is done with
+ * the data, so the producer can recycle its buffers right away. If `DALI_ext_force_copy` is
+ * specified, the data is copied and `release` is called once the copy is complete.
+ *
+ * The callback can be invoked from any thread, also from within this function, if the data
+ * cannot be accepted. It must not throw, nor call the DALI API functions for this pipeline.
+ *
+ * @param release The callback invoked exactly once for the buffer; cannot be NULL.
+ * @param user_data Passed to `release`.
+ *
+ * The remaining parameters are the same as in `daliSetExternalInputAsync`.
+ */
+DLL_PUBLIC void
+daliSetExternalInputWithRelease(daliPipelineHandle *pipe_handle, const char *name,
+                                device_type_t device, void *data_ptr,
+                                dali_data_type_t data_type, const int64_t *shapes,
+                                int sample_dim, const char *layout_str,
+                                cudaStream_t stream, unsigned int flags,
+                                daliExternalInputReleaseCallback release, void *user_data);
 /** @} */
 
 /**
@@ -510,6 +549,19 @@ DLL_PUBLIC void daliShareOutput(daliPipelineHandle *pipe_handle);
  */
 DLL_PUBLIC void daliOutputRelease(daliPipelineHandle *pipe_handle);
 
+/**
+ * @brief Checks, without blocking, whether the output of the pipeline is ready.
+ *
+ * Returns 1 if the next call to daliOutput or daliShareOutput won't wait, 0 otherwise.
+ * It allows a single thread to serve multiple pipelines by polling them, instead of
+ * blocking in daliOutput. The GPU outputs are ready when the work producing them is complete
+ * on the device.
+ * daliRun (or daliPrefetch) must be called prior to calling this function.
+ *
+ * Requires the dynamic executor (DALI_EXEC_IS_DYNAMIC).
+ */
+DLL_PUBLIC int daliOutputReady(daliPipelineHandle *pipe_handle);
+
 /**
  * @brief Returns 1 if the the output batch stored at position `n` in the pipeline can
  * be represented as dense, uniform tensor. Otherwise 0.
@@ -648,7 +700,8 @@ daliGetOperatorTrace(daliPipelineHandle *pipe_handle, const char *operator_name,
 
 /**
  * @brief Copy the output batch stored at position `output_idx` in the pipeline.
- * @remarks If the pipeline output is TensorList then it needs to be dense
+ * @remarks The samples are copied one after another, without padding - together with
+ *          daliOutputRaggedOffsets this gives the ragged representation of the batch.
  * @param pipe_handle Pointer to pipeline handle
  * @param dst Pointer to the destination buffer where the data will be copied
  * @param output_idx index of the pipeline output
@@ -676,6 +729,43 @@ DLL_PUBLIC void daliOutputCopySamples(daliPipelineHandle *pipe_handle, void **ds
                                       device_type_t dst_type, cudaStream_t stream,
                                       unsigned int flags);
 
+/**
+ * @brief Write the offsets (in elements) of the samples of the output stored at position
+ *        `output_idx` in the buffer filled by daliOutputCopy.
+ *
+ * A ragged batch (e.g. token ids of different lengths) can be consumed as values and offsets
+ * without padding: sample `i` occupies elements `[offsets[i], offsets[i + 1])`.
+ *
+ * @param offsets Buffer for `daliNumTensors(pipe_handle, output_idx) + 1` values; the last one
+ *                is the total number of elements.
+ */
+DLL_PUBLIC void daliOutputRaggedOffsets(daliPipelineHandle *pipe_handle, int64_t *offsets,
+                                        int output_idx);
+
+/**
+ * @brief Provides a device buffer in which the GPU output at position `output_idx` is to be
+ *        produced by the next scheduled iteration, so that it needn't be copied.
+ *
+ * The buffer is taken by the next scheduled iteration which doesn't have a buffer for this
+ * output yet - to cover the prefetched iterations, call this function before each daliRun
+ * (or before daliPrefetch, once per prefetched iteration).
+ * The buffer is used if it's large enough and the output is produced by an operator (rather
+ * than passed through); otherwise, the output is allocated as usual. In either case, calling
+ * daliOutputCopy with the same buffer as the destination produces the expected result - if the
+ * data is already there, no copy is made.
+ *
+ * The buffer must remain valid until the outputs of the iteration are released.
+ * Requires the dynamic executor.
+ *
+ * @param pipe_handle Pointer to pipeline handle
+ * @param output_idx index of the pipeline output
+ * @param dst Pointer to the device buffer
+ * @param size The size of the buffer, in bytes
+ * @param stream The buffer is written after the work scheduled in this stream up to this call
+ */
+DLL_PUBLIC void daliSetOutputBuffer(daliPipelineHandle *pipe_handle, int output_idx, void *dst,
+                                    size_t size, cudaStream_t stream);
+
 /**
  * @brief DEPRECATED API: use daliOutputCopy instead
  */
@@ -793,6 +883,151 @@ DLL_PUBLIC int daliPreallocateDeviceMemory(size_t bytes, int device_id);
  */
 DLL_PUBLIC int daliPreallocatePinnedMemory(size_t bytes);
 
+/*
+ * Need to keep that in sync with pool_stats from pool_resource_base.h
+ */
+typedef struct {
+  size_t reserved;              // memory obtained from the upstream resource
+  size_t allocated;             // memory currently allocated from the pool
+  size_t peak_allocated;        // the maximum value of `allocated`
+  size_t free;                  // memory in the free list(s), excluding pending frees
+  size_t largest_free_block;    // the size of the largest contiguous free block
+  size_t free_blocks;           // the number of free blocks
+  size_t upstream_blocks;       // the number of blocks obtained from the upstream resource
+  size_t pending_free;          // memory deallocated on streams, not yet returned to the pool
+  size_t pending_free_blocks;   // the number of pending stream-ordered deallocations
+  size_t pending_free_streams;  // the number of streams with pending deallocations
+} daliPoolStats;
+
+/**
+ * @brief Gets the statistics of the default device memory pool
+ *
+ * @param device_id The ordinal number of the device. If negative, the current device
+ *                  as indicated by cudaGetDevice is used.
+ *
+ * The statistics are all zero, if the pool has not been created yet.
+ */
+DLL_PUBLIC void daliGetDevicePoolStats(daliPoolStats *stats, int device_id);
+
+/**
+ * @brief Gets the statistics of the default host pinned memory pool used with given device
+ *
+ * @param device_id The ordinal number of the device. If negative, the current device
+ *                  as indicated by cudaGetDevice is used.
+ *
+ * The statistics are all zero, if the pool has not been created yet.
+ */
+DLL_PUBLIC void daliGetPinnedPoolStats(daliPoolStats *stats, int device_id);
+
+/**
+ * @brief Prints the statistics of the memory pools to stderr every `interval_seconds`
+ *
+ * A non-positive interval stops the logging.
+ */
+DLL_PUBLIC void daliSetPoolStatsLogInterval(double interval_seconds);
+
+/**
+ * @brief Enables or disables the collection of the always-on metrics
+ *
+ * The metrics can also be enabled with the environment variable DALI_METRICS=1.
+ * The operators, readers and thread pools register their metrics when they're created,
+ * so the metrics should be enabled before the pipeline is built.
+ */
+DLL_PUBLIC void daliSetMetricsEnabled(int enabled);
+
+/**
+ * @brief Returns the current values of the metrics in the Prometheus text exposition format
+ *
+ * The string is null-terminated and allocated with daliAlloc; freeing it is the caller's
+ * responsibility (with daliFree).
+ */
+DLL_PUBLIC char *daliGetMetrics();
+
+/**
+ * @name Batching server
+ * @{
+ */
+typedef struct DALIBatchingServer *daliBatchingServerHandle;
+
+/**
+ * @brief Notifies about the completion of a request enqueued with daliBatchingServerEnqueue.
+ *
+ * The outputs of the request are the sample `sample_idx` of the pipeline outputs; they can be
+ * inspected with the daliOutput* functions (e.g. daliShapeAtSample, daliOutputCopySamples)
+ * called with `pipe_handle`, but only until the callback returns.
+ * The callback is invoked on the server's thread. It must not throw, nor run the pipeline.
+ *
+ * @param sample_idx The index of the request in the batch or -1, if the batch failed.
+ * @param error      The error message, if the batch failed, NULL otherwise.
+ */
+typedef void (*daliBatchingServerCallback)(void *user_data, int64_t request_id,
+                                           daliPipelineHandle *pipe_handle, int sample_idx,
+                                           const char *error);
+
+/**
+ * @brief Starts batching the requests fed to an input of the pipeline and running them
+ *
+ * The requests (single samples) can be enqueued from multiple threads. They are gathered into
+ * batches, which are run when `max_batch_size` requests are pending or when the oldest of them
+ * has waited for `max_delay_us` microseconds. The delay bounds the latency added by batching,
+ * so it's the main knob for tuning the tail latency against the throughput.
+ *
+ * The server drives the pipeline: it must be the only user of `pipe_handle` until the server
+ * is destroyed and the pipeline must have no other inputs to feed. The pipeline is run one
+ * batch at a time, so `prefetch_queue_depth=1` is recommended.
+ *
+ * @param max_batch_size The maximum number of requests in a batch; if not positive, the max
+ *                       batch size of the pipeline is used.
+ * @param callback       Invoked for each request once its batch was processed.
+ */
+DLL_PUBLIC void daliBatchingServerCreate(daliBatchingServerHandle *server,
+                                         daliPipelineHandle *pipe_handle, const char *input_name,
+                                         int max_batch_size, int64_t max_delay_us,
+                                         daliBatchingServerCallback callback, void *user_data);
+
+/**
+ * @brief Enqueues a request; the sample is copied, so the buffer can be reused right away.
+ *
+ * The requests are batched in the order of arrival; a request whose type or dimensionality
+ * differs from the previous one starts a new batch.
+ *
+ * @param data  Host memory with the sample.
+ * @param shape The shape of the sample, `sample_dim` elements.
+ */
+DLL_PUBLIC void daliBatchingServerEnqueue(daliBatchingServerHandle *server, int64_t request_id,
+                                          const void *data, dali_data_type_t data_type,
+                                          const int64_t *shape, int sample_dim);
+
+/**
+ * @brief Enqueues a request without copying it; `release` is called once DALI is done with it.
+ *
+ * The sample can reside in GPU memory (e.g. a request tensor of an inference server), in which
+ * case it's fed to the pipeline directly, with no intermediate host copy. The batch is fed in
+ * the pipeline's internal stream, which waits for the work enqueued in `stream` before this call.
+ * The zero-copy requests and the ones copied by daliBatchingServerEnqueue, as well as requests
+ * residing on different devices, are not batched together.
+ *
+ * The buffer must stay valid until `release` is called (see daliExternalInputReleaseCallback).
+ * The callback is invoked exactly once - also when the request cannot be enqueued.
+ *
+ * @param device The device of the memory; GPU memory requires a pipeline with a GPU and must
+ *               reside on the pipeline's device.
+ * @param stream The stream in which the data was produced (GPU memory only).
+ */
+DLL_PUBLIC void daliBatchingServerEnqueueWithRelease(daliBatchingServerHandle *server,
+                                                     int64_t request_id, device_type_t device,
+                                                     void *data, dali_data_type_t data_type,
+                                                     const int64_t *shape, int sample_dim,
+                                                     cudaStream_t stream,
+                                                     daliExternalInputReleaseCallback release,
+                                                     void *user_data);
+
+/**
+ * @brief Processes the pending requests and stops the server.
+ */
+DLL_PUBLIC void daliBatchingServerDestroy(daliBatchingServerHandle *server);
+/** @} */
+
 /** @brief Returns serialized pipeline checkpoint
  *
  * Saves pipeline state together with provided external context.
@@ -0,0 +1,124 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_BFLOAT16_H_
+#define DALI_CORE_BFLOAT16_H_
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "dali/core/float16.h"
+#include "dali/core/host_dev.h"
+#include "dali/core/force_inline.h"
+
+namespace dali {
+
+/**
+ * @brief Brain floating point type (bfloat16) usable in host and device code
+ *
+ * bfloat16 has the same exponent range as float, but only 8 bits of precision. It's used as
+ * a storage type - the arithmetic is done in float: the value converts implicitly to `float`
+ * and the conversion from arithmetic types goes through `float`, rounding to nearest even.
+ *
+ * The binary layout is that of the upper half of a float, so it's compatible with
+ * `__nv_bfloat16`, `torch.bfloat16` and DLPack's `kDLBfloat`.
+ */
+struct bfloat16 {
+  bfloat16() = default;
+  bfloat16(const bfloat16 &) = default;
+
+  template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+  DALI_HOST_DEV DALI_FORCEINLINE bfloat16(T x)  // NOLINT
+      : bits(FromFloat(static_cast<float>(x))) {}
+
+  DALI_HOST_DEV DALI_FORCEINLINE bfloat16(float16 x)  // NOLINT
+      : bits(FromFloat(static_cast<float>(x))) {}
+
+  DALI_HOST_DEV DALI_FORCEINLINE operator float() const noexcept {
+    return ToFloat(bits);
+  }
+
+  /**
+   * @brief Creates a value from the binary representation
+   */
+  DALI_HOST_DEV static constexpr bfloat16 FromBits(uint16_t bits) noexcept {
+    bfloat16 ret{};
+    ret.bits = bits;
+    return ret;
+  }
+
+  DALI_HOST_DEV DALI_FORCEINLINE bfloat16 operator-() const noexcept {
+    return FromBits(bits ^ 0x8000u);
+  }
+
+  DALI_HOST_DEV DALI_FORCEINLINE bfloat16 operator+() const noexcept {
+    return *this;
+  }
+
+#define DALI_BFLOAT16_COMPOUND_ASSIGNMENT(op)                                    \
+  template <typename T>                                                          \
+  DALI_HOST_DEV DALI_FORCEINLINE bfloat16 &operator op##=(const T &x) noexcept { \
+    return *this = static_cast<float>(*this) op static_cast<float>(x);           \
+  }
+
+  DALI_BFLOAT16_COMPOUND_ASSIGNMENT(+)
+  DALI_BFLOAT16_COMPOUND_ASSIGNMENT(-)
+  DALI_BFLOAT16_COMPOUND_ASSIGNMENT(*)
+  DALI_BFLOAT16_COMPOUND_ASSIGNMENT(/)
+
+#undef DALI_BFLOAT16_COMPOUND_ASSIGNMENT
+
+  uint16_t bits;
+
+ private:
+  DALI_HOST_DEV static DALI_FORCEINLINE uint16_t FromFloat(float f) noexcept {
+#ifdef __CUDA_ARCH__
+    uint32_t u = __float_as_uint(f);
+#else
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+#endif
+    if ((u & 0x7fffffffu) > 0x7f800000u)  // NaN - keep it quiet
+      return static_cast<uint16_t>((u >> 16) | 0x40u);
+    u += 0x7fffu + ((u >> 16) & 1u);  // round to nearest even
+    return static_cast<uint16_t>(u >> 16);
+  }
+
+  DALI_HOST_DEV static DALI_FORCEINLINE float ToFloat(uint16_t bits) noexcept {
+    uint32_t u = static_cast<uint32_t>(bits) << 16;
+#ifdef __CUDA_ARCH__
+    return __uint_as_float(u);
+#else
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+#endif
+  }
+};
+
+static_assert(sizeof(bfloat16) == 2, "bfloat16 must be a 16-bit type");
+static_assert(std::is_trivially_copyable<bfloat16>::value, "bfloat16 must be trivially copyable");
+
+template <typename T>
+struct is_bfloat16 : std::is_same<std::remove_cv_t<T>, bfloat16> {};
+
+template <>
+struct is_fp_or_half<bfloat16> : std::true_type {};
+
+template <>
+struct is_arithmetic_or_half<bfloat16> : std::true_type {};
+
+}  // namespace dali
+
+#endif  // DALI_CORE_BFLOAT16_H_
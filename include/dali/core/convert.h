@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -20,6 +20,7 @@
 #include <limits>
 #include <type_traits>
 #include "dali/core/host_dev.h"
+#include "dali/core/bfloat16.h"
 #include "dali/core/float16.h"
 
 namespace dali {
@@ -185,6 +186,29 @@ DALI_HOST_DEV constexpr float16 clamp(T value, ret_type<float16>) {
   return static_cast<float16>(f);
 }
 
+template <typename T>
+DALI_HOST_DEV constexpr T clamp(bfloat16 value, ret_type<T>) {
+  return clamp(static_cast<float>(value), ret_type<T>());
+}
+
+DALI_HOST_DEV inline bfloat16 clamp(bfloat16 value, ret_type<bfloat16>) {
+  return value;
+}
+
+DALI_HOST_DEV inline float16 clamp(bfloat16 value, ret_type<float16>) {
+  return clamp(static_cast<float>(value), ret_type<float16>());
+}
+
+/// bfloat16 has the range of float
+template <typename T>
+DALI_HOST_DEV constexpr bfloat16 clamp(T value, ret_type<bfloat16>) {
+  return static_cast<bfloat16>(clamp(value, ret_type<float>()));
+}
+
+DALI_HOST_DEV inline bfloat16 clamp(float16 value, ret_type<bfloat16>) {
+  return static_cast<bfloat16>(value);
+}
+
 template <typename T, typename U>
 DALI_HOST_DEV constexpr T clamp(U value) {
   return clamp(value, ret_type<T>());
@@ -302,6 +326,47 @@ struct ConverterBase<float16, In, true, false, false, false> {
   }
 };
 
+/// Converts integral to bfloat16 special case
+template <typename In>
+struct ConverterBase<bfloat16, In, true, false, false, false> {
+  DALI_HOST_DEV
+  static constexpr bfloat16 Convert(In value) {
+    auto out = ConverterBase<float, In, true, false>::Convert(value);
+    return static_cast<bfloat16>(out);
+  }
+
+  DALI_HOST_DEV
+  static constexpr bfloat16 ConvertSat(In value) {
+    auto out = ConverterBase<float, In, true, false>::ConvertSat(value);
+    return static_cast<bfloat16>(out);
+  }
+
+  DALI_HOST_DEV
+  static constexpr bfloat16 ConvertNorm(In value) {
+    auto out = ConverterBase<float, In, true, false>::ConvertNorm(value);
+    return static_cast<bfloat16>(out);
+  }
+
+  DALI_HOST_DEV
+  static constexpr bfloat16 ConvertSatNorm(In value) {
+    auto out = ConverterBase<float, In, true, false>::ConvertSatNorm(value);
+    return static_cast<bfloat16>(out);
+  }
+};
+
+/// Converts bfloat16 to float16 special case - goes through float
+template <>
+struct ConverterBase<float16, bfloat16, true, true, false, false> {
+  DALI_HOST_DEV
+  static float16 Convert(bfloat16 value) { return static_cast<float>(value); }
+  DALI_HOST_DEV
+  static float16 ConvertNorm(bfloat16 value) { return static_cast<float>(value); }
+  DALI_HOST_DEV
+  static float16 ConvertSat(bfloat16 value) { return static_cast<float>(value); }
+  DALI_HOST_DEV
+  static float16 ConvertSatNorm(bfloat16 value) { return static_cast<float>(value); }
+};
+
 /// Converts FP to integral type
 template <typename Out, typename In>
 struct ConverterBase<Out, In, false, true, false, false> {
@@ -37,11 +37,13 @@ class DLL_PUBLIC CUDAStreamPool {
    *
    * @param device_id   CUDA runtime API device ordinal. If negative, calling thread's
    *                    current device is used.
+   * @param priority    CUDA stream priority; lower numbers mean higher priority and
+   *                    0 is the default (and the lowest) priority.
    *
-   * @return A CUDA stream wrapper object. If there were any streams in the pools, the
-   *         stream is taken from it, otherwise a new stream is created.
+   * @return A CUDA stream wrapper object. If there were any streams with the requested
+   *         priority in the pool, the stream is taken from it, otherwise a new stream is created.
    */
-  CUDAStreamLease Get(int device_id = -1);
+  CUDAStreamLease Get(int device_id = -1, int priority = 0);
 
   /**
    * @brief Places a stream for given device in the pool.
@@ -49,11 +51,12 @@ class DLL_PUBLIC CUDAStreamPool {
    * @param device_id CUDA runtime API device ordinal of the device for which the stream was
    *                  created. If negative, the device is obtained from the device context
    *                  associated with the stream.
+   * @param priority  The priority with which the stream was created.
    *
    * @remarks It is an error to misstate the device_id. Placing a stream with improper device_id
    *          will render the stream pool unusable.
    */
-  void Put(CUDAStream &&stream, int device_id = -1);
+  void Put(CUDAStream &&stream, int device_id = -1, int priority = 0);
 
   /**
    * @brief Removes all streams currently in the pool and deletes auxiliary data structures.
@@ -78,7 +81,12 @@ class DLL_PUBLIC CUDAStreamPool {
 
   void Init();
 
-  CUDAStream GetFromPool(int device_id);
+  CUDAStream GetFromPool(int device_id, int priority);
+
+  /** The index of the list of the streams with given priority; the priorities are non-positive */
+  static int PriorityIndex(int priority) {
+    return priority < 0 ? -priority : 0;
+  }
 
   struct StreamEntry {
     StreamEntry() = default;
@@ -91,7 +99,8 @@ class DLL_PUBLIC CUDAStreamPool {
   StreamEntry *unused_ = nullptr;
   std::atomic_int lease_count_{0};
 
-  std::vector<StreamEntry *> dev_streams_;
+  /** The streams of each device, indexed with PriorityIndex */
+  std::vector<std::vector<StreamEntry *>> dev_streams_;
   spinlock lock_;
 
   static StreamEntry *Pop(StreamEntry *&head) {
@@ -132,8 +141,10 @@ class CUDAStreamLease {
       stream_ = std::move(other.stream_);
       owner_ = other.owner_;
       device_id_ = other.device_id_;
+      priority_ = other.priority_;
       other.owner_ = nullptr;
       other.device_id_ = -1;
+      other.priority_ = 0;
     }
     return *this;
   }
@@ -216,6 +227,13 @@ class CUDAStreamLease {
     return device_id_;
   }
 
+  /**
+   * @brief Returns the priority with which the stream was requested.
+   */
+  int priority() const noexcept {
+    return priority_;
+  }
+
   /**
    * @brief Returns the owning pool object.
    */
@@ -229,18 +247,19 @@ class CUDAStreamLease {
   void reset() {
     if (owner_) {
       if (stream_) {
-        owner_->Put(std::move(stream_), device_id_);
+        owner_->Put(std::move(stream_), device_id_, priority_);
         owner_->lease_count_--;
       }
       owner_ = nullptr;
     }
     stream_.reset();
     device_id_ = -1;
+    priority_ = 0;
   }
 
  private:
-  CUDAStreamLease(CUDAStream &&stream, int device_id, CUDAStreamPool *owner)
-  : stream_(std::move(stream)), device_id_(device_id), owner_(owner) {
+  CUDAStreamLease(CUDAStream &&stream, int device_id, int priority, CUDAStreamPool *owner)
+  : stream_(std::move(stream)), device_id_(device_id), priority_(priority), owner_(owner) {
     assert(owner_ && stream_);
     ++owner->lease_count_;
   }
@@ -248,6 +267,7 @@ class CUDAStreamLease {
   friend class CUDAStreamPool;
   CUDAStream stream_;
   int device_id_ = -1;
+  int priority_ = 0;
   CUDAStreamPool *owner_ = nullptr;
 };
 
@@ -15,6 +15,7 @@
 #ifndef DALI_CORE_EXEC_TASKING_SCHEDULER_H_
 #define DALI_CORE_EXEC_TASKING_SCHEDULER_H_
 
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include <queue>
@@ -132,6 +133,10 @@ class TaskFuture {
     return results_.Value(index);
   }
 
+  /** Checks, without blocking, whether the task is complete and the results are available. */
+  bool Ready() const {
+    return complete_ || task_->state_ == TaskState::Complete;
+  }
 
  private:
   void Wait();
@@ -169,6 +174,12 @@ class TaskFuture {
  * case the overhead of creating a future object can be avoided by using AddSilentTask.
  * The user can still Wait for tasks without a future object. The only difference is that
  * the results of silent tasks are only accessible by the registered consumers of its outputs.
+ *
+ * Locking
+ * The ready queue has its own lock, which is held only for the duration of push and pop.
+ * The pending list and the waiting lists of the Waitables are guarded by another one.
+ * This way, the threads which Pop tasks don't contend with the (much longer) evaluation of the
+ * preconditions in Notify. When both are needed, the ready queue lock is acquired second.
  */
 class Scheduler {
   struct TaskPriorityLess {
@@ -182,7 +193,7 @@ class Scheduler {
    *  for a shutdown notification.
    */
   SharedTask Pop() {
-    std::unique_lock lock(mtx_);
+    std::unique_lock lock(ready_mtx_);
     task_ready_.wait(lock, [&]() { return !ready_.empty() || shutdown_requested_; });
     if (ready_.empty()) {
       assert(shutdown_requested_);
@@ -233,7 +244,7 @@ class Scheduler {
 
   /** Makes all Pop functions return with an error value. */
   void Shutdown() {
-    std::lock_guard g(mtx_);
+    std::scoped_lock g(mtx_, ready_mtx_);
     shutdown_requested_ = true;
     task_ready_.notify_all();
     task_done_.notify_all();
@@ -245,52 +256,66 @@ class Scheduler {
   }
 
  private:
-  /** Moves the task to the ready queue if all of its preconditions can be acquired.
+  using ReadyBatch = SmallVector<SharedTask, 8>;
+
+  /** Moves the task from the pending list to `batch` if all of its preconditions can be acquired.
    *
    * This function atomically checks that all preconditions can be met and if so, acquires them.
-   * If the preconditions where met, the task is moved from the pending list to the ready queue.
+   * The caller must hold `mtx_` and later push the batch to the ready queue with PushReady.
    */
-  bool DLL_PUBLIC AcquireAllAndMoveToReady(SharedTask &task) noexcept;
+  bool DLL_PUBLIC AcquireAllAndMoveToReady(SharedTask &task, ReadyBatch &batch) noexcept;
+
+  /** Pushes the tasks to the ready queue and wakes up the threads waiting in Pop. */
+  void PushReady(ReadyBatch &batch) {
+    if (batch.empty())
+      return;
+    {
+      std::lock_guard lock(ready_mtx_);
+      for (auto &task : batch)
+        ready_.push(std::move(task));
+    }
+    if (batch.size() == 1)
+      task_ready_.notify_one();
+    else
+      task_ready_.notify_all();
+    batch.clear();
+  }
 
   void AddTaskImpl(SharedTask task) {
     assert(task->state_ == TaskState::New);
     task->Submit(*this);
+    ReadyBatch batch;
     if (task->Ready()) {  // if the task has no preconditions...
-      {
-        // ...then we add it directly to the read_ queue.
-        std::lock_guard lock(mtx_);
-        task->state_ = TaskState::Ready;
-        ready_.push(task);
-      }
-      task_ready_.notify_one();
+      // ...then we add it directly to the ready_ queue.
+      task->state_ = TaskState::Ready;
+      batch.push_back(std::move(task));
     } else {
       // Otherwise, the task is added to the pending list
-      bool ready = false;
-      {
-        std::lock_guard lock(mtx_);
-        task->state_ = TaskState::Pending;
-        for (auto &pre : task->preconditions_) {
-          bool added = pre->AddToWaiting(task);
-          (void)added;
-          assert(added);
-        }
-        pending_.PushFront(task);
-        // ...and we check whether its preconditions are, in fact, met.
-        ready = AcquireAllAndMoveToReady(task);
+      std::lock_guard lock(mtx_);
+      task->state_ = TaskState::Pending;
+      for (auto &pre : task->preconditions_) {
+        bool added = pre->AddToWaiting(task);
+        (void)added;
+        assert(added);
       }
-      if (ready)
-        task_ready_.notify_one();
+      pending_.PushFront(task);
+      // ...and we check whether its preconditions are, in fact, met.
+      AcquireAllAndMoveToReady(task, batch);
     }
+    PushReady(batch);
   }
 
   friend class Task;
 
+  /** Guards the pending list, the waiting lists of the Waitables and the task_done_ condition. */
   std::mutex mtx_;
+  /** Guards the ready queue and the task_ready_ condition. */
+  std::mutex ready_mtx_;
   std::condition_variable task_ready_, task_done_;
 
   detail::TaskList pending_;
   std::priority_queue<SharedTask, std::vector<SharedTask>, TaskPriorityLess> ready_;
-  bool shutdown_requested_ = false;
+  std::atomic_bool shutdown_requested_{false};
 };
 
 inline void Waitable::Notify(Scheduler &sched) {
@@ -20,7 +20,6 @@
 #include <memory>
 #include <mutex>
 #include "dali/core/small_vector.h"
-#include "dali/core/spinlock.h"
 
 namespace dali::tasking {
 
@@ -46,6 +45,18 @@ class Waitable : public std::enable_shared_from_this<Waitable> {
   /** A list of tasks waiting for this waitable object. */
   SmallVector<WeakTask, 8> waiting_;
 
+  /** The kind of the object - cached, so the scheduler doesn't need a dynamic_cast to get it. */
+  enum class Kind : uint8_t {
+    Other,
+    CompletionEvent,
+    Task
+  };
+
+  Waitable() = default;
+  explicit Waitable(Kind kind) : kind_(kind) {}
+
+  const Kind kind_ = Kind::Other;
+
   /** Checks whether the Waitable is ready to be acquired. */
   virtual bool IsAcquirable() const = 0;
 
@@ -109,6 +120,8 @@ class Waitable : public std::enable_shared_from_this<Waitable> {
  */
 class CompletionEvent : public Waitable {
  protected:
+  explicit CompletionEvent(Kind kind = Kind::CompletionEvent) : Waitable(kind) {}
+
   bool AcquireImpl() override {
     // Nothing to acquire - just return true if the event is completed.
     return IsAcquirable();
@@ -161,31 +174,31 @@ class Semaphore : public Releasable {
   constexpr int MaxCount() const { return max_count; }
 
  protected:
-  mutable spinlock lock_;
-
   bool IsAcquirable() const override {
-    std::lock_guard g(lock_);
-    return count > 0;
+    return count.load(std::memory_order_acquire) > 0;
   }
 
   bool AcquireImpl() override {
-    std::lock_guard g(lock_);
-    if (count > 0) {
-      count--;
-      return true;
-    }
-    return false;
+    int c = count.load(std::memory_order_relaxed);
+    do {
+      if (c <= 0)
+        return false;
+    } while (!count.compare_exchange_weak(c, c - 1, std::memory_order_acq_rel,
+                                          std::memory_order_relaxed));
+    return true;
   }
 
   void ReleaseImpl() override {
-    std::lock_guard g(lock_);
-    if (count >= max_count)
-      throw std::out_of_range("The semaphore exceeded its maximum count.");
-    count++;
+    int c = count.load(std::memory_order_relaxed);
+    do {
+      if (c >= max_count)
+        throw std::out_of_range("The semaphore exceeded its maximum count.");
+    } while (!count.compare_exchange_weak(c, c + 1, std::memory_order_acq_rel,
+                                          std::memory_order_relaxed));
   }
 
  private:
-  int count = 1;
+  std::atomic_int count{1};
   int max_count = 1;
 };
 
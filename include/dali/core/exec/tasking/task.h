@@ -16,6 +16,7 @@
 #define DALI_CORE_EXEC_TASKING_TASK_H_
 
 #include <any>
+#include <atomic>
 #include <cassert>
 #include <condition_variable>
 #include <functional>
@@ -362,7 +363,7 @@ class Task : public CompletionEvent {
 
  public:
   template <typename F>
-  Task(int num_results, F &&function, double priority = 0) {
+  Task(int num_results, F &&function, double priority = 0) : CompletionEvent(Kind::Task) {
     using Func = std::remove_reference_t<F>;
     priority_ = priority;
     results_.Init(num_results);
@@ -438,7 +439,8 @@ class Task : public CompletionEvent {
     state_ = TaskState::Destroyed;
   }
 
-  TaskState state_ = TaskState::New;
+  // Atomic, because it's updated under different locks (or none) - see Scheduler
+  std::atomic<TaskState> state_{TaskState::New};
 
   /** The priority of the task; the higher, the sooner a task is picked. */
   double Priority() const {
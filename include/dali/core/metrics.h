@@ -0,0 +1,172 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_METRICS_H_
+#define DALI_CORE_METRICS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "dali/core/api_helper.h"
+
+/**
+ * Always-on, low-overhead metrics, meant to be exported to a monitoring system.
+ *
+ * Unlike the NVTX ranges, the metrics don't need a profiler attached. The values are
+ * accumulated in per-thread tables, written only by the owning thread without locks or
+ * read-modify-write atomics, and aggregated when a snapshot is requested.
+ *
+ * The metrics are disabled by default; they're enabled with SetEnabled or with the
+ * environment variable DALI_METRICS=1.
+ */
+namespace dali::metrics {
+
+enum class MetricKind : int {
+  Counter = 0,    ///< a monotonically increasing sum
+  Gauge = 1,      ///< the last value set
+  Histogram = 2,  ///< the distribution of the observed values
+};
+
+/**
+ * The upper bounds of the histogram buckets are the powers of 2: 1, 2, 4, ..., 2^(kNumBuckets-2);
+ * the last bucket is unbounded.
+ */
+constexpr int kNumBuckets = 32;
+
+/** The maximum number of distinct metrics. The metrics above the limit are ignored. */
+constexpr int kMaxMetrics = 4096;
+
+extern DLL_PUBLIC std::atomic<bool> g_metrics_enabled;
+
+/** Returns true if the metrics are collected. Cheap - it's a single relaxed load. */
+inline bool Enabled() {
+  return g_metrics_enabled.load(std::memory_order_relaxed);
+}
+
+DLL_PUBLIC void SetEnabled(bool enabled);
+
+/**
+ * @brief Sets the sampling interval of LatencyTimer
+ *
+ * With interval N, each thread measures every N-th timed event; the counters and
+ * the explicitly observed values are not sampled. The default interval is 1 and it can be
+ * set with the environment variable DALI_METRICS_SAMPLING.
+ */
+DLL_PUBLIC void SetSamplingInterval(int interval);
+
+DLL_PUBLIC int GetSamplingInterval();
+
+/**
+ * @brief A lightweight handle of a metric
+ *
+ * The metric is identified by its name and labels (in Prometheus syntax, e.g. `op="Resize_3"`);
+ * creating the handle twice for the same name and labels gives the same metric.
+ * A default-constructed handle (or one created over the kMaxMetrics limit) is a no-op.
+ */
+class DLL_PUBLIC Metric {
+ public:
+  Metric() = default;
+  Metric(const std::string &name, MetricKind kind, const std::string &labels = "",
+         const std::string &help = "");
+
+  explicit operator bool() const noexcept { return id_ >= 0; }
+
+  /** Increments a counter */
+  void Add(double value) const {
+    if (id_ >= 0 && Enabled())
+      AddImpl(value);
+  }
+
+  /** Sets the value of a gauge */
+  void Set(double value) const {
+    if (id_ >= 0 && Enabled())
+      SetImpl(value);
+  }
+
+  /** Records `count` observations of `value` in a histogram */
+  void Observe(double value, uint64_t count = 1) const {
+    if (id_ >= 0 && Enabled())
+      ObserveImpl(value, count);
+  }
+
+  int id() const noexcept { return id_; }
+
+ private:
+  void AddImpl(double value) const;
+  void SetImpl(double value) const;
+  void ObserveImpl(double value, uint64_t count) const;
+  int id_ = -1;
+};
+
+/**
+ * @brief Measures the time of a scope in microseconds and records it in a histogram
+ *
+ * The timer is subject to sampling (see SetSamplingInterval) and doesn't read the clock
+ * at all when the metrics are disabled or the event is not sampled.
+ */
+class DLL_PUBLIC LatencyTimer {
+ public:
+  explicit LatencyTimer(const Metric &metric) : metric_(metric) {
+    if (metric_ && Enabled() && Sample())
+      start_ = std::chrono::steady_clock::now();
+  }
+
+  ~LatencyTimer() {
+    Stop();
+  }
+
+  void Stop() {
+    if (start_ != std::chrono::steady_clock::time_point{}) {
+      std::chrono::duration<double, std::micro> t = std::chrono::steady_clock::now() - start_;
+      metric_.Observe(t.count());
+      start_ = {};
+    }
+  }
+
+ private:
+  static bool Sample();
+  const Metric &metric_;
+  std::chrono::steady_clock::time_point start_{};
+};
+
+/** The aggregated value of a metric */
+struct MetricSnapshot {
+  std::string name, labels, help;
+  MetricKind kind = MetricKind::Counter;
+  /** The number of updates or observations */
+  uint64_t count = 0;
+  /** The value of a counter or a gauge; the sum of the values observed in a histogram */
+  double value = 0;
+  double min = 0, max = 0;
+  /** The (non-cumulative) numbers of observations in the histogram buckets */
+  std::vector<uint64_t> buckets;
+};
+
+/** Aggregates the values of all metrics from all threads */
+DLL_PUBLIC std::vector<MetricSnapshot> Snapshot();
+
+/** Formats the metrics in the Prometheus text exposition format */
+DLL_PUBLIC std::string ToPrometheusText(const std::vector<MetricSnapshot> &metrics);
+
+/** Formats a label as `name="value"`, escaping the value as required by Prometheus */
+DLL_PUBLIC std::string Label(const std::string &name, const std::string &value);
+
+/** Returns the upper bound of the histogram bucket, or infinity for the last one */
+DLL_PUBLIC double BucketUpperBound(int bucket);
+
+}  // namespace dali::metrics
+
+#endif  // DALI_CORE_METRICS_H_
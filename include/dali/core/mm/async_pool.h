@@ -122,11 +122,51 @@ class async_pool_resource : public async_memory_resource<Kind>,
     global_pool_.release_unused();
   }
 
+  /**
+   * @brief Enables the reuse of the memory freed on other streams, before the frees complete.
+   *
+   * If enabled, an allocation that cannot be satisfied otherwise takes a block which
+   * is pending deallocation on another stream. Instead of synchronizing with the host (or
+   * allocating from upstream), the allocating stream waits for the event recorded when the
+   * block was freed.
+   */
+  void set_cross_stream_reuse(bool enable) {
+    std::lock_guard<LockType> guard(lock_);
+    cross_stream_reuse_ = enable;
+  }
+
+  bool cross_stream_reuse() const {
+    return cross_stream_reuse_;
+  }
+
   void *try_allocate_from_free(size_t size, size_t alignment) override {
     std::lock_guard<std::mutex> guard(lock_);
     return global_pool_.try_allocate_from_free(size, alignment);
   }
 
+  /**
+   * @brief Gets the statistics of the global pool, adjusted for the per-stream free blocks
+   *
+   * The memory deallocated on streams is allocated from the global pool until it's returned
+   * there - it's reported as `pending_free` and not included in `allocated`.
+   */
+  pool_stats get_stats() override {
+    std::lock_guard<LockType> guard(lock_);
+    pool_stats stats = global_pool_.get_stats();
+    stats.allocated = allocated_;
+    stats.peak_allocated = peak_allocated_;
+    for (auto &kv : stream_free_) {
+      if (!kv.second.free_list.head)
+        continue;
+      for (auto *f = kv.second.free_list.head; f; f = f->next) {
+        stats.pending_free += f->bytes;
+        stats.pending_free_blocks++;
+      }
+      stats.pending_free_streams++;
+    }
+    return stats;
+  }
+
   GlobalPool *upstream() const override {
     // ugly WAR - the global pool may be the "upstream" we really care about here
     return const_cast<GlobalPool *>(&global_pool_);
@@ -157,7 +197,9 @@ class async_pool_resource : public async_memory_resource<Kind>,
   void *do_allocate(size_t bytes, size_t alignment) override {
     adjust_size_and_alignment(bytes, alignment, true);
     std::lock_guard<LockType> guard(lock_);
-    return allocate_from_global_pool(bytes, alignment);
+    void *ptr = allocate_from_global_pool(bytes, alignment);
+    add_allocated(bytes);
+    return ptr;
   }
 
   void do_deallocate(void *mem, size_t bytes, size_t alignment) override {
@@ -165,6 +207,7 @@ class async_pool_resource : public async_memory_resource<Kind>,
       return;
     adjust_size_and_alignment(bytes, alignment, false);
     std::lock_guard<LockType> guard(lock_);
+    allocated_ -= bytes;
     char *ptr = static_cast<char *>(mem);
     pop_block_padding(ptr, bytes, alignment);
     global_pool_.deallocate(ptr, bytes, alignment);
@@ -187,19 +230,31 @@ class async_pool_resource : public async_memory_resource<Kind>,
     adjust_size_and_alignment(bytes, alignment, true);
     std::lock_guard<LockType> guard(lock_);
     auto it = stream_free_.find(stream_id_hint::from_handle(stream.get()));
-    void *ptr;
-    if (it != stream_free_.end()) {
+    void *ptr = nullptr;
+    if (it != stream_free_.end())
       ptr = try_allocate(it->second, bytes, alignment, stream);
-      if (ptr)
-        return ptr;
-    }
-    return allocate_from_global_pool(bytes, alignment);
+    if (!ptr)
+      ptr = allocate_from_global_pool(bytes, alignment, &stream);
+    add_allocated(bytes);
+    return ptr;
+  }
+
+  /// Must be called with lock_ held
+  void add_allocated(size_t bytes) {
+    allocated_ += bytes;
+    if (allocated_ > peak_allocated_)
+      peak_allocated_ = allocated_;
   }
 
   /**
    * @brief Allocates from the global pool, possibly releasing per-stream memory to the global pool.
+   *
+   * If the allocation is stream-ordered (`stream` is not null) and cross-stream reuse is enabled,
+   * the memory pending deallocation on other streams is tried before synchronizing or
+   * using upstream.
    */
-  void *allocate_from_global_pool(size_t bytes, size_t alignment) {
+  void *allocate_from_global_pool(size_t bytes, size_t alignment,
+                                  const stream_view *stream = nullptr) {
     void *ptr;
     if (num_pending_frees_ == 0) {
       // There are no pending per-stream frees - there's no hope of reclaiming anything.
@@ -213,12 +268,21 @@ class async_pool_resource : public async_memory_resource<Kind>,
     // Try to reclaim some memory from completed pending frees.
     for (auto &kv : stream_free_)
       free_ready(kv.second);
-    if (avoid_upstream_ && num_pending_frees_ > 0) {
-      // AVOIDING UPSTREAM
+    bool cross_stream = stream && cross_stream_reuse_;
+    if ((avoid_upstream_ || cross_stream) && num_pending_frees_ > 0) {
       // Try to allocate from the global pool again...
       ptr = global_pool_.try_allocate_from_free(bytes, alignment);
       if (ptr)
         return ptr;
+      // ...then from the blocks still pending on other streams, chaining the streams with events
+      if (cross_stream) {
+        ptr = try_allocate_cross_stream(bytes, alignment, *stream);
+        if (ptr)
+          return ptr;
+      }
+    }
+    if (avoid_upstream_ && num_pending_frees_ > 0) {
+      // AVOIDING UPSTREAM
       // Synchronize - this will wait for pending frees to complete.
       synchronize_impl(false);
       for (auto &kv : stream_free_)
@@ -242,6 +306,7 @@ class async_pool_resource : public async_memory_resource<Kind>,
     CUDA_CALL(cudaEventRecord(event, stream.get()));
 
     std::lock_guard<LockType> guard(lock_);
+    allocated_ -= bytes;
     char *ptr = static_cast<char*>(mem);
     pop_block_padding(ptr, bytes, alignment);
     auto stream_id = stream_id_hint::from_handle(stream.get());
@@ -330,11 +395,15 @@ class async_pool_resource : public async_memory_resource<Kind>,
    * @brief Try to allocate a block from per-stream free memory
    *
    * If the allocation fails, the function returns nullptr.
+   *
+   * @param other_stream  if true, the blocks were freed on a different stream than `stream`,
+   *                      which has to wait for the deallocation to complete
    */
   void *try_allocate(PerStreamFreeBlocks &from,
                      size_t bytes,
                      size_t alignment,
-                     stream_view stream) {
+                     stream_view stream,
+                     bool other_stream = false) {
     // This value is only used when not splitting - it limits how much memory
     // can be wasted for padding - the allowed padding is 1/16 of the allocated size,
     // clamped to between 16 bytes and 1 MiB.
@@ -387,7 +456,7 @@ class async_pool_resource : public async_memory_resource<Kind>,
         size_t orig_alignment = f->alignment;
         size_t split_size = block_size;
         // If stream_id is ambiguous, we might have blocks from other streams mixed in
-        if (!stream_id_hint::is_unambiguous()) {
+        if (other_stream || !stream_id_hint::is_unambiguous()) {
           // This check is not necessary for correctness but skipping it resulted in a big
           // performance hit in allocator performance tests.
           if (!f->ready())
@@ -417,6 +486,24 @@ class async_pool_resource : public async_memory_resource<Kind>,
     return nullptr;
   }
 
+  /**
+   * @brief Tries to allocate a block pending deallocation on a stream other than `stream`.
+   *
+   * The block is taken without waiting on the host - `stream` waits for the event recorded
+   * at deallocation. If the block is later freed on `stream`, the new event completes after
+   * the old one, so the dependency chain is preserved.
+   */
+  void *try_allocate_cross_stream(size_t bytes, size_t alignment, stream_view stream) {
+    auto stream_id = stream_id_hint::from_handle(stream.get());
+    for (auto &kv : stream_free_) {
+      if (kv.first == stream_id || !kv.second.free_list.head)
+        continue;
+      if (void *ptr = try_allocate(kv.second, bytes, alignment, stream, true))
+        return ptr;
+    }
+    return nullptr;
+  }
+
   /**
    * @brief Searches per-stream free blocks to find the most recently freed one.
    */
@@ -585,6 +672,8 @@ class async_pool_resource : public async_memory_resource<Kind>,
   using FreeDescAlloc = detail::object_pool_allocator<pending_free>;
 
   LockType lock_;
+  // guarded by lock_
+  size_t allocated_ = 0, peak_allocated_ = 0;
   vector<CUDAStream> sync_streams_;
   CUDAStream &GetSyncStream(int device_id) {
     int ndev = sync_streams_.size();
@@ -645,6 +734,7 @@ class async_pool_resource : public async_memory_resource<Kind>,
 
   int num_pending_frees_ = 0;
   bool avoid_upstream_ = true;
+  bool cross_stream_reuse_ = false;
 };
 
 }  // namespace mm
@@ -0,0 +1,121 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_BUDGET_RESOURCE_H_
+#define DALI_CORE_MM_BUDGET_RESOURCE_H_
+
+#include <atomic>
+#include <type_traits>
+#include "dali/core/cuda_error.h"
+#include "dali/core/mm/memory_resource.h"
+#include "dali/core/mm/with_upstream.h"
+
+namespace dali {
+namespace mm {
+
+/**
+ * @brief The maximum amount of memory which can be obtained by a group of resources
+ *
+ * A limit of 0 means that there's no limit.
+ */
+struct memory_budget {
+  /** The fraction of the limit above which the memory is considered to be under pressure */
+  static constexpr double kPressureThreshold = 0.9;
+
+  std::atomic<size_t> limit{0};
+  std::atomic<size_t> used{0};
+
+  /**
+   * @brief Accounts for `bytes` of memory, unless it would exceed the limit
+   *
+   * @return true, if the memory fits in the budget
+   */
+  bool acquire(size_t bytes) noexcept {
+    size_t prev = used.fetch_add(bytes, std::memory_order_relaxed);
+    size_t lim = limit.load(std::memory_order_relaxed);
+    if (lim && prev + bytes > lim) {
+      used.fetch_sub(bytes, std::memory_order_relaxed);
+      return false;
+    }
+    return true;
+  }
+
+  void release(size_t bytes) noexcept {
+    used.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Tells whether the memory usage is close to the limit
+   *
+   * The components which can work with less memory (caches, queues) should use this as a hint
+   * to reduce their usage.
+   */
+  bool under_pressure() const noexcept {
+    size_t lim = limit.load(std::memory_order_relaxed);
+    return lim && used.load(std::memory_order_relaxed) > lim * kPressureThreshold;
+  }
+};
+
+/**
+ * @brief Passes the allocations to the upstream resource, as long as they fit in a budget
+ *
+ * When the budget would be exceeded, the allocation fails without calling the upstream resource.
+ * Placed under a pool, this makes the pool release its unused blocks (see
+ * pool_options::return_to_upstream_on_failure) before the allocation request fails.
+ *
+ * Several resources can share one budget.
+ */
+template <typename Kind>
+class budget_resource : public memory_resource<Kind>, public with_upstream<Kind> {
+ public:
+  budget_resource(memory_resource<Kind> *upstream, memory_budget *budget)
+  : upstream_(upstream), budget_(budget) {}
+
+  memory_resource<Kind> *upstream() const override {
+    return upstream_;
+  }
+
+  memory_budget *budget() const noexcept {
+    return budget_;
+  }
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    if (!budget_->acquire(bytes)) {
+      if (std::is_same_v<Kind, memory_kind::host>)
+        throw std::bad_alloc();
+      else
+        throw CUDABadAlloc(bytes, !std::is_same_v<Kind, memory_kind::device>);
+    }
+    try {
+      return upstream_->allocate(bytes, alignment);
+    } catch (...) {
+      budget_->release(bytes);
+      throw;
+    }
+  }
+
+  void do_deallocate(void *ptr, size_t bytes, size_t alignment) override {
+    upstream_->deallocate(ptr, bytes, alignment);
+    budget_->release(bytes);
+  }
+
+  memory_resource<Kind> *upstream_;
+  memory_budget *budget_;
+};
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_BUDGET_RESOURCE_H_
@@ -0,0 +1,250 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_CUDA_IPC_RESOURCE_H_
+#define DALI_CORE_MM_CUDA_IPC_RESOURCE_H_
+
+#include <unistd.h>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include "dali/core/mm/cu_vm.h"
+#include "dali/core/mm/memory_resource.h"
+#include "dali/core/device_guard.h"
+#include "dali/core/format.h"
+
+#if DALI_USE_CUDA_VM_MAP
+
+namespace dali {
+namespace mm {
+
+/**
+ * @brief Describes a range of device memory which can be mapped in another process.
+ *
+ * `fd` is a POSIX file descriptor of the whole physical allocation; it must be passed to the
+ * other process by means of a UNIX domain socket (SCM_RIGHTS) or pidfd_getfd.
+ * The memory of interest starts `offset` bytes after the beginning of the allocation.
+ */
+struct ipc_mem_handle {
+  int fd = -1;
+  /** The size of the whole physical allocation */
+  size_t size = 0;
+  /** The offset of the data within the allocation */
+  size_t offset = 0;
+};
+
+/**
+ * @brief A device memory resource whose allocations can be shared with other processes.
+ *
+ * Each allocation is a separate physical allocation, created with cuMemCreate with a shareable
+ * POSIX file descriptor handle type and mapped to its own virtual address range.
+ * The address ranges are never adjacent, so this resource can be safely used as an upstream
+ * of a pool which coalesces the free blocks - an allocation from such pool never spans
+ * two upstream blocks and can be exported with `export_handle`.
+ */
+class cuda_ipc_memory_resource : public memory_resource<memory_kind::device> {
+ public:
+  explicit cuda_ipc_memory_resource(int device_id = -1) {
+    if (device_id < 0)
+      CUDA_CALL(cudaGetDevice(&device_id));
+    device_id_ = device_id;
+  }
+
+  ~cuda_ipc_memory_resource() {
+    std::lock_guard<std::mutex> g(mtx_);
+    for (auto &[addr, block] : blocks_)
+      unmap(block);
+    blocks_.clear();
+  }
+
+  static bool is_supported(int device_id) {
+    if (!cuvm::IsSupported())
+      return false;
+    CUdevice dev;
+    int supported = 0;
+    if (cuDeviceGet(&dev, device_id) != CUDA_SUCCESS)
+      return false;
+    if (cuDeviceGetAttribute(&supported,
+                             CU_DEVICE_ATTRIBUTE_HANDLE_TYPE_POSIX_FILE_DESCRIPTOR_SUPPORTED,
+                             dev) != CUDA_SUCCESS)
+      return false;
+    return supported;
+  }
+
+  int device_id() const noexcept {
+    return device_id_;
+  }
+
+  /**
+   * @brief Tells whether the pointer points to the memory allocated from this resource
+   */
+  bool owns(const void *ptr) const {
+    std::lock_guard<std::mutex> g(mtx_);
+    return find(reinterpret_cast<CUdeviceptr>(ptr)) != nullptr;
+  }
+
+  /**
+   * @brief Gets a shareable handle to the allocation containing the memory pointed to by `ptr`.
+   *
+   * The file descriptor is owned by the resource and remains valid until the allocation
+   * is freed.
+   */
+  ipc_mem_handle export_handle(const void *ptr) {
+    std::lock_guard<std::mutex> g(mtx_);
+    auto addr = reinterpret_cast<CUdeviceptr>(ptr);
+    block *blk = find(addr);
+    if (!blk)
+      throw std::invalid_argument(make_string(
+          "The address ", ptr, " was not allocated from a CUDA IPC memory resource."));
+    if (blk->fd < 0) {
+      CUDA_CALL(cuMemExportToShareableHandle(&blk->fd, blk->mem.handle(),
+                                             CU_MEM_HANDLE_TYPE_POSIX_FILE_DESCRIPTOR, 0));
+    }
+    return { blk->fd, blk->mem.size(), static_cast<size_t>(addr - blk->va.ptr()) };
+  }
+
+ private:
+  struct block {
+    cuvm::CUMemAddressRange va;
+    cuvm::CUMem mem;
+    int fd = -1;
+  };
+
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    if (bytes == 0)
+      return nullptr;
+    size_t grain = cuvm::GetAddressGranularity();
+    if (alignment > grain)
+      throw std::bad_alloc();
+    DeviceGuard dg(device_id_);
+    CUmemAllocationProp prop = cuvm::DeviceMemProp(device_id_);
+    prop.requestedHandleTypes = CU_MEM_HANDLE_TYPE_POSIX_FILE_DESCRIPTOR;
+    block blk;
+    blk.mem = cuvm::CUMem::Create(bytes, prop);
+    // Reserve one extra granule, so that two allocations are never adjacent
+    blk.va = cuvm::CUMemAddressRange::Reserve(blk.mem.size() + grain);
+    void *ptr = cuvm::Map(blk.va.ptr(), blk.mem);
+    std::lock_guard<std::mutex> g(mtx_);
+    blocks_.emplace(blk.va.ptr(), std::move(blk));
+    return ptr;
+  }
+
+  void do_deallocate(void *ptr, size_t bytes, size_t alignment) override {
+    if (!ptr)
+      return;
+    std::lock_guard<std::mutex> g(mtx_);
+    auto it = blocks_.find(reinterpret_cast<CUdeviceptr>(ptr));
+    if (it == blocks_.end())
+      throw std::invalid_argument("The pointer was not allocated from this resource.");
+    unmap(it->second);
+    blocks_.erase(it);
+  }
+
+  block *find(CUdeviceptr addr) const {
+    auto it = blocks_.upper_bound(addr);
+    if (it == blocks_.begin())
+      return nullptr;
+    --it;
+    auto &blk = const_cast<block &>(it->second);
+    return addr < blk.va.ptr() + blk.mem.size() ? &blk : nullptr;
+  }
+
+  static void unmap(block &blk) {
+    if (blk.fd >= 0)
+      close(blk.fd);
+    blk.fd = -1;
+    cuvm::Unmap(blk.va.ptr(), blk.mem.size());
+  }
+
+  int device_id_ = -1;
+  mutable std::mutex mtx_;
+  std::map<CUdeviceptr, block> blocks_;
+};
+
+/**
+ * @brief Maps the memory exported by another process (see cuda_ipc_memory_resource).
+ *
+ * The mapping keeps the physical memory alive even if the exporting process frees it.
+ * The file descriptor is not taken over - the caller can close it once the mapping is created.
+ */
+class cuda_ipc_mapping {
+ public:
+  cuda_ipc_mapping() = default;
+
+  explicit cuda_ipc_mapping(const ipc_mem_handle &handle) {
+    CUmemGenericAllocationHandle h;
+    CUDA_CALL(cuMemImportFromShareableHandle(
+        &h, reinterpret_cast<void *>(static_cast<intptr_t>(handle.fd)),
+        CU_MEM_HANDLE_TYPE_POSIX_FILE_DESCRIPTOR));
+    mem_ = cuvm::CUMem({ h, handle.size });
+    CUmemAllocationProp prop = {};
+    CUDA_CALL(cuMemGetAllocationPropertiesFromHandle(&prop, h));
+    device_id_ = prop.location.id;
+    va_ = cuvm::CUMemAddressRange::Reserve(handle.size);
+    cuvm::Map(va_.ptr(), mem_);
+    data_ = reinterpret_cast<char *>(va_.ptr()) + handle.offset;
+  }
+
+  ~cuda_ipc_mapping() {
+    reset();
+  }
+
+  cuda_ipc_mapping(cuda_ipc_mapping &&other) noexcept {
+    *this = std::move(other);
+  }
+
+  cuda_ipc_mapping &operator=(cuda_ipc_mapping &&other) noexcept {
+    if (this != &other) {
+      reset();
+      mem_ = std::move(other.mem_);
+      va_ = std::move(other.va_);
+      data_ = other.data_;
+      device_id_ = other.device_id_;
+      other.data_ = nullptr;
+    }
+    return *this;
+  }
+
+  void reset() {
+    if (data_)
+      cuvm::Unmap(va_.ptr(), mem_.size());
+    data_ = nullptr;
+    va_.reset();
+    mem_.reset();
+  }
+
+  /** The pointer to the shared data (i.e. the mapped address + the offset) */
+  void *data() const noexcept {
+    return data_;
+  }
+
+  /** The ordinal (in this process) of the device on which the memory is located */
+  int device_id() const noexcept {
+    return device_id_;
+  }
+
+ private:
+  cuvm::CUMem mem_;
+  cuvm::CUMemAddressRange va_;
+  void *data_ = nullptr;
+  int device_id_ = -1;
+};
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_USE_CUDA_VM_MAP
+
+#endif  // DALI_CORE_MM_CUDA_IPC_RESOURCE_H_
@@ -109,6 +109,21 @@ class cuda_vm_resource : public memory_resource<memory_kind::device>,
     stat_ = {};
   }
 
+  pool_stats get_stats() override {
+    pool_stats stats;
+    lock_guard pool_guard(pool_lock_);
+    stats.reserved = static_cast<size_t>(stat_.allocated_blocks) * block_size_;
+    stats.upstream_blocks = stat_.allocated_blocks;
+    stats.allocated = stat_.curr_allocated;
+    stats.peak_allocated = stat_.peak_allocated;
+    free_mapped_.for_each_block([&](void *, size_t size) {
+      stats.free += size;
+      stats.largest_free_block = std::max(stats.largest_free_block, size);
+      stats.free_blocks++;
+    });
+    return stats;
+  }
+
   void dump_stats(std::ostream &os) {
     print(os, "cuda_vm_resource stat dump:",
       "\ntotal VM size:         ", stat_.allocated_va,
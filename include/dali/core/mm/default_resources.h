@@ -19,6 +19,7 @@
 #include <memory>
 #include "dali/core/api_helper.h"
 #include "dali/core/mm/memory_resource.h"
+#include "dali/core/mm/pool_resource_base.h"
 
 namespace dali {
 namespace mm {
@@ -156,6 +157,127 @@ void PreallocateDeviceMemory(size_t bytes, int device_id = -1);
 DLL_PUBLIC
 void PreallocatePinnedMemory(size_t bytes);
 
+/**
+ * @brief Gets the NUMA node whose pinned memory pool serves the given device
+ *
+ * Unless a pinned memory resource is set explicitly, the default pinned memory resource
+ * returned for the current device is a pool whose memory is allocated on the NUMA node closest
+ * to that device. This can be disabled by setting DALI_USE_NUMA_PINNED_MEM_POOL=0.
+ *
+ * @param device_id Device index; if negative, current device is used.
+ * @return The index of the NUMA node or -1, if a single, process-wide pool is used.
+ */
+DLL_PUBLIC
+int GetPinnedMemoryNumaNode(int device_id = -1);
+
+struct PinnedMemoryStats {
+  /** The number of bytes of pinned memory obtained from the OS */
+  size_t allocated = 0;
+  /** The peak number of bytes of pinned memory obtained from the OS */
+  size_t peak_allocated = 0;
+};
+
+/**
+ * @brief Gets the statistics of the pinned memory pool of a NUMA node
+ *
+ * The statistics are all-zero if there's no pool for this node.
+ */
+DLL_PUBLIC
+PinnedMemoryStats GetPinnedMemoryStats(int numa_node);
+
+/**
+ * @brief Gets the statistics of the default device memory pool
+ *
+ * @param device_id Device index; if negative, current device is used.
+ * @return The statistics of the pool; all zeros, if the resource for this device hasn't been
+ *         created yet or it's not a pool.
+ */
+DLL_PUBLIC
+pool_stats GetDevicePoolStats(int device_id = -1);
+
+/**
+ * @brief Gets the statistics of the default pinned memory pool used with given device
+ *
+ * @param device_id Device index; if negative, current device is used.
+ * @return The statistics of the pool; all zeros, if the resource hasn't been created yet
+ *         or it's not a pool.
+ */
+DLL_PUBLIC
+pool_stats GetPinnedPoolStats(int device_id = -1);
+
+/**
+ * @brief Prints the statistics of the default device and pinned memory pools periodically
+ *
+ * The statistics are printed to stderr every `interval_seconds`.
+ * A non-positive interval stops the logging.
+ */
+DLL_PUBLIC
+void SetPoolStatsLogInterval(double interval_seconds);
+
+class alloc_trace;
+
+/**
+ * @brief Gets the trace of the requests to the default memory resources
+ *
+ * The tracing is enabled by setting the DALI_MM_TRACE_FILE environment variable; the trace is
+ * written to that file at exit. The trace covers the resources created by DALI (not the ones set
+ * with SetDefaultResource) and can be replayed with the benchmarks in dali/core/mm/perf_test.cu.
+ *
+ * @return The trace or nullptr, if the tracing is disabled.
+ */
+DLL_PUBLIC
+std::shared_ptr<alloc_trace> GetDefaultResourceTrace();
+
+/**
+ * @brief Limits the amount of memory which the default device memory pool can obtain on
+ *        each device
+ *
+ * When an allocation would exceed the budget, the pool first releases its unused blocks;
+ * if that doesn't help, the allocation fails with CUDABadAlloc.
+ * When the usage is close to the budget (see IsDeviceMemoryUnderPressure), the executor and
+ * the image caches reduce their memory usage.
+ *
+ * The budget only applies to the default pools. It must be set before the first allocation on
+ * a device, if the pool would otherwise use CUDA virtual memory management, which is not
+ * compatible with a budget. It can be also set with the DALI_DEVICE_MEMORY_BUDGET environment
+ * variable (a number, optionally followed by 'k', 'M' or 'G').
+ *
+ * @param bytes The budget, in bytes; 0 means no limit.
+ */
+DLL_PUBLIC
+void SetDeviceMemoryBudget(size_t bytes);
+
+DLL_PUBLIC
+size_t GetDeviceMemoryBudget();
+
+/**
+ * @brief Limits the total amount of memory which the default pinned memory pools can obtain
+ *
+ * Works like SetDeviceMemoryBudget. The corresponding environment variable is
+ * DALI_PINNED_MEMORY_BUDGET.
+ *
+ * @param bytes The budget, in bytes; 0 means no limit.
+ */
+DLL_PUBLIC
+void SetPinnedMemoryBudget(size_t bytes);
+
+DLL_PUBLIC
+size_t GetPinnedMemoryBudget();
+
+/**
+ * @brief Tells whether the default device memory pool is close to its budget
+ *
+ * @param device_id Device index; if negative, current device is used.
+ */
+DLL_PUBLIC
+bool IsDeviceMemoryUnderPressure(int device_id = -1);
+
+/**
+ * @brief Tells whether the default pinned memory pools are close to their budget
+ */
+DLL_PUBLIC
+bool IsPinnedMemoryUnderPressure();
+
 }  // namespace mm
 }  // namespace dali
 
@@ -247,6 +247,15 @@ class best_fit_free_list {
     return false;
   }
 
+  /**
+   * @brief Calls `fn(start, size)` for each free block
+   */
+  template <typename Fn>
+  void for_each_block(Fn &&fn) const {
+    for (block *b = head_; b; b = b->next)
+      fn(static_cast<void *>(b->start), static_cast<size_t>(b->end - b->start));
+  }
+
  protected:
   /**
    * @brief Recycle an unused block descriptor or create a new one.
@@ -664,6 +673,15 @@ class coalescing_free_tree {
     }
   }
 
+  /**
+   * @brief Calls `fn(start, size)` for each free block, in the order of addresses
+   */
+  template <typename Fn>
+  void for_each_block(Fn &&fn) const {
+    for (auto &[addr, size] : by_addr_)
+      fn(static_cast<void *>(addr), size);
+  }
+
   void merge(coalescing_free_tree &&with) {
     with.by_size_.clear();
     // Erase the source list one by one - this reduces requirements on total auxiliary memory
@@ -782,6 +800,15 @@ class best_fit_free_tree {
     return get_specific_block(base, size) != nullptr;
   }
 
+  /**
+   * @brief Calls `fn(start, size)` for each free block, in the order of addresses
+   */
+  template <typename Fn>
+  void for_each_block(Fn &&fn) const {
+    for (auto &[addr, size] : by_addr_)
+      fn(static_cast<void *>(addr), size);
+  }
+
   detail::pooled_set<std::pair<size_t, char *>, true> by_size_;
   detail::pooled_map<char *, size_t, true> by_addr_;
   detail::pooled_map<char *, std::pair<char *, size_t>, true> original_;
@@ -0,0 +1,189 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_HOST_ARENA_H_
+#define DALI_CORE_MM_HOST_ARENA_H_
+
+#include <algorithm>
+#include <vector>
+#include "dali/core/mm/malloc_resource.h"
+#include "dali/core/mm/monotonic_resource.h"
+#include "dali/core/mm/detail/align.h"
+#include "dali/core/small_vector.h"
+#include "dali/core/util.h"
+
+namespace dali {
+namespace mm {
+
+/**
+ * @brief A monotonic host memory resource which keeps its memory when reset.
+ *
+ * The arena serves the allocations from a single buffer. When the buffer is exhausted, the
+ * allocations are served from additional blocks, taken from the upstream resource. After a call
+ * to `reset`, all the previous allocations are invalid; if additional blocks were needed, they're
+ * freed and the buffer is enlarged to accommodate all the memory used since the previous reset.
+ * Once the size of the buffer stabilizes, allocations and resets don't call the upstream resource.
+ *
+ * The arena is not thread-safe.
+ */
+class host_arena : public memory_resource<memory_kind::host> {
+ public:
+  explicit host_arena(host_memory_resource *upstream = &malloc_memory_resource::instance(),
+                      size_t initial_size = 0)
+  : upstream_(upstream), overflow_(upstream, kMinBlockSize) {
+    if (initial_size)
+      grow(initial_size);
+  }
+
+  ~host_arena() {
+    release();
+  }
+
+  host_arena(const host_arena &) = delete;
+  host_arena &operator=(const host_arena &) = delete;
+
+  /**
+   * @brief Invalidates all the allocations made from the arena.
+   *
+   * If the buffer was too small to accommodate all the allocations, it's enlarged.
+   */
+  void reset() {
+    if (overflow_used_) {
+      overflow_.free_all();
+      grow(used_);
+      overflow_used_ = false;
+    }
+    curr_ = begin_;
+    used_ = 0;
+  }
+
+  /**
+   * @brief Frees all the memory, including the buffer.
+   */
+  void release() {
+    overflow_.free_all();
+    overflow_used_ = false;
+    if (begin_)
+      upstream_->deallocate(begin_, limit_ - begin_, kAlignment);
+    begin_ = curr_ = limit_ = nullptr;
+    used_ = 0;
+  }
+
+  /** The size of the buffer */
+  size_t capacity() const {
+    return limit_ - begin_;
+  }
+
+  /** The number of bytes allocated since the last reset, including the alignment padding */
+  size_t used() const {
+    return used_;
+  }
+
+  host_memory_resource *upstream() const {
+    return upstream_;
+  }
+
+ private:
+  static constexpr size_t kAlignment = 64;
+  static constexpr size_t kMinBlockSize = 4096;
+
+  void grow(size_t min_size) {
+    size_t size = std::max(align_up(min_size, kMinBlockSize), kMinBlockSize);
+    if (size <= capacity())
+      return;
+    if (begin_)
+      upstream_->deallocate(begin_, limit_ - begin_, kAlignment);
+    begin_ = curr_ = limit_ = nullptr;
+    begin_ = static_cast<char *>(upstream_->allocate(size, kAlignment));
+    curr_ = begin_;
+    limit_ = begin_ + size;
+  }
+
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    char *ret = detail::align_ptr(curr_, alignment);
+    if (ret && ret + bytes <= limit_) {
+      used_ += ret + bytes - curr_;
+      curr_ = ret + bytes;
+      return ret;
+    }
+    // the worst case padding, so that the enlarged buffer is always sufficient
+    used_ += bytes + alignment - 1;
+    overflow_used_ = true;
+    return overflow_.allocate(bytes, alignment);
+  }
+
+  // don't deallocate at all
+  void do_deallocate(void *data, size_t bytes, size_t alignment) override {
+  }
+
+  host_memory_resource *upstream_;
+  char *begin_ = nullptr, *curr_ = nullptr, *limit_ = nullptr;
+  size_t used_ = 0;
+  monotonic_memory_resource<memory_kind::host, host_memory_resource> overflow_;
+  bool overflow_used_ = false;
+};
+
+/**
+ * @brief An STL-compatible allocator which obtains the memory from a host memory resource
+ *
+ * Typically used with a `host_arena` - there, the deallocation is a no-op.
+ * A default-constructed allocator uses the regular heap.
+ */
+template <typename T>
+class arena_allocator {
+ public:
+  using value_type = T;
+
+  arena_allocator() noexcept = default;
+  arena_allocator(host_memory_resource *mr) noexcept : mr_(mr) {}  // NOLINT
+
+  template <typename U>
+  arena_allocator(const arena_allocator<U> &other) noexcept : mr_(other.resource()) {}  // NOLINT
+
+  T *allocate(size_t count) {
+    return static_cast<T *>(resource()->allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *ptr, size_t count) noexcept {
+    resource()->deallocate(ptr, count * sizeof(T), alignof(T));
+  }
+
+  host_memory_resource *resource() const noexcept {
+    return mr_ ? mr_ : &malloc_memory_resource::instance();
+  }
+
+  template <typename U>
+  bool operator==(const arena_allocator<U> &other) const noexcept {
+    return resource() == other.resource();
+  }
+
+  template <typename U>
+  bool operator!=(const arena_allocator<U> &other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  host_memory_resource *mr_ = nullptr;
+};
+
+template <typename T>
+using arena_vector = std::vector<T, arena_allocator<T>>;
+
+template <typename T, size_t static_size>
+using arena_small_vector = SmallVector<T, static_size, arena_allocator<T>>;
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_HOST_ARENA_H_
@@ -17,6 +17,11 @@
 
 #include <stdlib.h>
 #include <malloc.h>
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <atomic>
 #include "dali/core/mm/memory_resource.h"
 #include "dali/core/cuda_error.h"
 #include "dali/core/cuda_stream_pool.h"
@@ -154,6 +159,92 @@ class pinned_malloc_memory_resource : public pinned_async_resource {
   }
 };
 
+/**
+ * @brief A memory resource that allocates page-locked host memory on a given NUMA node.
+ *
+ * The memory is mapped, bound to the node and registered with cudaHostRegister, which populates
+ * the pages according to the binding. If the binding is not permitted (e.g. in a container),
+ * the memory is allocated anyway and its placement is left to the OS.
+ */
+class numa_pinned_memory_resource : public pinned_async_resource {
+ public:
+  explicit numa_pinned_memory_resource(int numa_node) : numa_node_(numa_node) {}
+
+  int numa_node() const noexcept {
+    return numa_node_;
+  }
+
+  /**
+   * @brief The number of bytes currently allocated from the OS
+   */
+  size_t allocated() const noexcept {
+    return allocated_;
+  }
+
+  /**
+   * @brief The maximum number of bytes allocated from the OS at any time
+   */
+  size_t peak_allocated() const noexcept {
+    return peak_allocated_;
+  }
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    if (bytes == 0)
+      return nullptr;
+    if (alignment <= static_cast<size_t>(sysconf(_SC_PAGESIZE)))
+      alignment = 1;  // mmap returns page-aligned memory - avoid overhead
+
+    return detail::aligned_alloc([&](size_t size) {
+      void *mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (mem == MAP_FAILED)
+        throw CUDABadAlloc(size, true);
+      if (numa_node_ >= 0 && numa_node_ < 64) {
+        unsigned long node_mask = 1ul << numa_node_;  // NOLINT(runtime/int)
+        // preferred, not bound - fall back to other nodes rather than fail
+        (void)syscall(SYS_mbind, mem, size, MPOL_PREFERRED, &node_mask, 65, 0);
+      }
+      auto err = cudaHostRegister(mem, size, cudaHostRegisterPortable);
+      if (err != cudaSuccess) {
+        munmap(mem, size);
+        CUDA_CALL(err);
+      }
+      size_t total = allocated_ += size;
+      size_t peak = peak_allocated_;
+      while (total > peak && !peak_allocated_.compare_exchange_weak(peak, total)) {}
+      return mem;
+    }, bytes, alignment);
+  }
+
+  void do_deallocate(void *ptr, size_t bytes, size_t alignment) override {
+    if (ptr) {
+      if (alignment <= static_cast<size_t>(sysconf(_SC_PAGESIZE)))
+        alignment = 1;
+      detail::aligned_dealloc([&](void *mem, size_t size) {
+        CUDA_DTOR_CALL(cudaHostUnregister(mem));
+        munmap(mem, size);
+        allocated_ -= size;
+      }, ptr, bytes, alignment);
+    }
+  }
+
+  void *do_allocate_async(size_t bytes, size_t alignment, stream_view) override {
+    return allocate(bytes, alignment);
+  }
+
+  void do_deallocate_async(void *mem, size_t bytes, size_t alignment, stream_view) override {
+    return deallocate(mem, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource<memory_kind> &other) const noexcept override {
+    auto *numa = dynamic_cast<const numa_pinned_memory_resource*>(&other);
+    return numa && numa->numa_node_ == numa_node_;
+  }
+
+  int numa_node_ = -1;
+  std::atomic<size_t> allocated_{0}, peak_allocated_{0};
+};
+
 /**
  * @brief A memory resource that directly calls cudaMallocManaged and cudaFree.
  */
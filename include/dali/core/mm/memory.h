@@ -18,6 +18,7 @@
 #include <memory>
 #include <utility>
 #include "dali/core/mm/default_resources.h"
+#include "dali/core/mm/memory_tag.h"
 #include "dali/core/access_order.h"
 
 namespace dali {
@@ -38,9 +39,14 @@ struct Deleter {
   void *resource;
   size_t size, alignment;
   void (*free)(void *resource, void *memory, size_t size, size_t alignment);
+  /** The memory tracking information (see MemoryTagScope) */
+  TrackedAllocation tracking;
 
   void operator()(void *memory) const {
-    if (memory) free(resource, memory, size, alignment);
+    if (memory) {
+      free(resource, memory, size, alignment);
+      tracking.Release();
+    }
   }
 };
 
@@ -55,9 +61,14 @@ struct AsyncDeleter {
   size_t size, alignment;
   cudaStream_t release_on_stream;
   void (*free)(void *resource, void *memory, size_t size, size_t alignment, cudaStream_t stream);
+  /** The memory tracking information (see MemoryTagScope) */
+  TrackedAllocation tracking;
 
   void operator()(void *memory) const {
-    if (memory) free(resource, memory, size, alignment, release_on_stream);
+    if (memory) {
+      free(resource, memory, size, alignment, release_on_stream);
+      tracking.Release();
+    }
   }
 };
 
@@ -133,7 +144,9 @@ template <typename Kind>
 std::pair<void*, Deleter> alloc_raw(memory_resource<Kind> *mr,
                                     size_t bytes, size_t alignment = alignof(std::max_align_t)) {
   void *mem = mr->allocate(bytes, alignment);
-  return { mem, GetDeleter(mr, bytes, alignment) };
+  auto del = GetDeleter(mr, bytes, alignment);
+  del.tracking.Track(kind2id_v<Kind>, bytes);
+  return { mem, std::move(del) };
 }
 
 
@@ -272,7 +285,9 @@ std::pair<void*, AsyncDeleter> alloc_raw_async(async_memory_resource<Kind> *mr,
   void *mem = alloc_stream == host_sync
     ? mr->allocate(bytes, alignment)
     : mr->allocate_async(bytes, alignment, alloc_stream);
-  return { mem, GetDeleter(mr, bytes, alignment, dealloc_stream) };
+  auto del = GetDeleter(mr, bytes, alignment, dealloc_stream);
+  del.tracking.Track(kind2id_v<Kind>, bytes);
+  return { mem, std::move(del) };
 }
 
 /**
@@ -0,0 +1,150 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_MEMORY_TAG_H_
+#define DALI_CORE_MM_MEMORY_TAG_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include "dali/core/api_helper.h"
+#include "dali/core/mm/memory_kind.h"
+
+namespace dali {
+namespace mm {
+
+/**
+ * @brief The purpose of an allocation, used for breaking down the memory usage.
+ */
+enum class MemoryTag : uint8_t {
+  Other = 0,  ///< Not tagged
+  Output,     ///< The output buffers of an operator
+  Scratch,    ///< Temporary buffers, released at the end of the operator's run
+  Staging,    ///< Intermediate buffers, e.g. for reading the data or for decoding
+  Cache,      ///< The data cached between the iterations
+  Count
+};
+
+DLL_PUBLIC const char *MemoryTagName(MemoryTag tag);
+
+/**
+ * @brief Tracks the current and the peak size of the memory allocated with each tag and kind.
+ *
+ * The tracker is shared by the allocations made in its context (see MemoryTagScope), which
+ * keep it alive until they're freed.
+ */
+class DLL_PUBLIC MemoryTracker {
+ public:
+  struct Usage {
+    int64_t current = 0, peak = 0;
+  };
+
+  void Allocated(MemoryTag tag, memory_kind_id kind, size_t bytes) noexcept;
+
+  void Freed(MemoryTag tag, memory_kind_id kind, size_t bytes) noexcept {
+    counter(tag, kind).current.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+
+  Usage Get(MemoryTag tag, memory_kind_id kind) const noexcept {
+    auto &c = counters_[static_cast<int>(tag)][kind];
+    return { c.current.load(std::memory_order_relaxed), c.peak.load(std::memory_order_relaxed) };
+  }
+
+  /** Sets the peak sizes to the current ones, e.g. to measure the steady state after warmup. */
+  void ResetPeak() noexcept;
+
+ private:
+  struct Counter {
+    std::atomic<int64_t> current{0}, peak{0};
+  };
+
+  Counter &counter(MemoryTag tag, memory_kind_id kind) noexcept {
+    return counters_[static_cast<int>(tag)][kind];
+  }
+
+  Counter counters_[static_cast<int>(MemoryTag::Count)][memory_kind_id::count];
+};
+
+/**
+ * @brief The tracker and the tag of the allocations made by the current thread.
+ */
+struct MemoryTagContext {
+  std::shared_ptr<MemoryTracker> tracker;
+  MemoryTag tag = MemoryTag::Other;
+};
+
+/**
+ * @brief Returns the memory tracking context of the calling thread.
+ */
+DLL_PUBLIC const MemoryTagContext &GetMemoryTagContext() noexcept;
+
+/**
+ * @brief Sets the memory tracking context of the calling thread and restores the previous one
+ *        when destroyed.
+ *
+ * The allocations made with the functions from memory.h (alloc_raw and the like) while the
+ * scope is active are recorded in the tracker, with the tag, until they're freed.
+ */
+class DLL_PUBLIC MemoryTagScope {
+ public:
+  explicit MemoryTagScope(MemoryTagContext ctx);
+
+  MemoryTagScope(std::shared_ptr<MemoryTracker> tracker, MemoryTag tag)
+  : MemoryTagScope(MemoryTagContext{ std::move(tracker), tag }) {}
+
+  /** Changes the tag of the allocations, keeping the current tracker. */
+  explicit MemoryTagScope(MemoryTag tag)
+  : MemoryTagScope(MemoryTagContext{ GetMemoryTagContext().tracker, tag }) {}
+
+  ~MemoryTagScope();
+
+  MemoryTagScope(const MemoryTagScope &) = delete;
+  MemoryTagScope &operator=(const MemoryTagScope &) = delete;
+
+ private:
+  MemoryTagContext prev_;
+};
+
+/**
+ * @brief Holds the tracking information of an allocation; used by the deleters.
+ */
+struct TrackedAllocation {
+  std::shared_ptr<MemoryTracker> tracker;
+  MemoryTag tag = MemoryTag::Other;
+  memory_kind_id kind = memory_kind_id::host;
+  size_t size = 0;
+
+  /** Records an allocation in the memory tracking context of the calling thread (if any). */
+  void Track(memory_kind_id alloc_kind, size_t bytes) {
+    auto &ctx = GetMemoryTagContext();
+    if (!ctx.tracker)
+      return;
+    ctx.tracker->Allocated(ctx.tag, alloc_kind, bytes);
+    tracker = ctx.tracker;
+    tag = ctx.tag;
+    kind = alloc_kind;
+    size = bytes;
+  }
+
+  void Release() const noexcept {
+    if (tracker)
+      tracker->Freed(tag, kind, size);
+  }
+};
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_MEMORY_TAG_H_
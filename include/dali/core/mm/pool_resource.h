@@ -112,6 +112,7 @@ class pool_resource : public memory_resource<Kind>,
     }
     blocks_.clear();
     free_list_.clear();
+    allocated_ = 0;
   }
 
   int device_ordinal() const noexcept {
@@ -131,7 +132,10 @@ class pool_resource : public memory_resource<Kind>,
 
     {
       lock_guard guard(lock_);
-      return free_list_.get(bytes, alignment);
+      void *ptr = free_list_.get(bytes, alignment);
+      if (ptr)
+        add_allocated(bytes);
+      return ptr;
     }
   }
 
@@ -154,6 +158,23 @@ class pool_resource : public memory_resource<Kind>,
     release_unused_impl(true);
   }
 
+  pool_stats get_stats() override {
+    pool_stats stats;
+    upstream_lock_guard uguard(upstream_lock_);
+    for (auto &block : blocks_)
+      stats.reserved += block.bytes;
+    stats.upstream_blocks = blocks_.size();
+    lock_guard guard(lock_);
+    stats.allocated = allocated_;
+    stats.peak_allocated = peak_allocated_;
+    free_list_.for_each_block([&](void *, size_t size) {
+      stats.free += size;
+      stats.largest_free_block = std::max(stats.largest_free_block, size);
+      stats.free_blocks++;
+    });
+    return stats;
+  }
+
  protected:
   void *do_allocate(size_t bytes, size_t alignment) override {
     if (!bytes)
@@ -178,15 +199,16 @@ class pool_resource : public memory_resource<Kind>,
     char *block_end = block_start + blk_size;
     assert(tail <= block_end);
 
+    lock_guard guard(lock_);
     if (blk_size != bytes) {
       // we've allocated an oversized block - put the front & back padding in the free list
-      lock_guard guard(lock_);
       if (ret != block_start)
         free_list_.put(block_start, ret - block_start);
 
       if (tail != block_end)
         free_list_.put(tail, block_end - tail);
     }
+    add_allocated(bytes);
     return ret;
   }
 
@@ -195,6 +217,14 @@ class pool_resource : public memory_resource<Kind>,
       throw std::bad_alloc();
     lock_guard guard(lock_);
     free_list_.put(ptr, bytes);
+    allocated_ -= bytes;
+  }
+
+  /// Must be called with lock_ held
+  void add_allocated(size_t bytes) {
+    allocated_ += bytes;
+    if (allocated_ > peak_allocated_)
+      peak_allocated_ = allocated_;
   }
 
   void *get_upstream_block(size_t &blk_size, size_t min_bytes, size_t alignment) {
@@ -318,6 +348,8 @@ class pool_resource : public memory_resource<Kind>,
   pool_options options_;
   size_t next_block_size_ = 0;
   int device_ordinal_ = -1;
+  // guarded by lock_
+  size_t allocated_ = 0, peak_allocated_ = 0;
 
   struct UpstreamBlock {
     void *ptr;
@@ -20,6 +20,35 @@
 namespace dali {
 namespace mm {
 
+/**
+ * @brief A snapshot of the state of a memory pool
+ *
+ * The difference between `reserved` and `allocated` is the memory kept by the pool for future
+ * use. If `largest_free_block` is much smaller than the free memory, the pool is fragmented.
+ */
+struct pool_stats {
+  /// The memory obtained from the upstream resource
+  size_t reserved = 0;
+  /// The memory currently allocated by the clients of the pool
+  size_t allocated = 0;
+  /// The maximum value of `allocated`
+  size_t peak_allocated = 0;
+  /// The memory in the free list(s), excluding pending frees
+  size_t free = 0;
+  /// The size of the largest contiguous free block
+  size_t largest_free_block = 0;
+  /// The number of blocks in the free list(s)
+  size_t free_blocks = 0;
+  /// The number of blocks obtained from the upstream resource
+  size_t upstream_blocks = 0;
+  /// The memory deallocated on streams, which is not returned to the free list yet
+  size_t pending_free = 0;
+  /// The number of pending stream-ordered deallocations
+  size_t pending_free_blocks = 0;
+  /// The number of streams with pending deallocations
+  size_t pending_free_streams = 0;
+};
+
 template <typename Kind>
 class pool_resource_base {
  public:
@@ -28,6 +57,13 @@ class pool_resource_base {
   virtual void *try_allocate_from_free(size_t bytes, size_t alignment) {
     return nullptr;
   }
+
+  /**
+   * @brief Gets the current statistics of the pool
+   */
+  virtual pool_stats get_stats() {
+    return {};
+  }
 };
 
 }  // namespace mm
@@ -0,0 +1,176 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_TRACING_RESOURCE_H_
+#define DALI_CORE_MM_TRACING_RESOURCE_H_
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "dali/core/api_helper.h"
+#include "dali/core/mm/composite_resource.h"
+#include "dali/core/mm/memory_kind.h"
+#include "dali/core/mm/memory_resource.h"
+#include "dali/core/mm/with_upstream.h"
+
+namespace dali {
+namespace mm {
+
+/**
+ * @brief An allocation or a deallocation recorded by tracing_resource
+ */
+struct alloc_trace_event {
+  /** The stream value of the host-ordered (synchronous) allocations and deallocations */
+  static constexpr uint64_t host_order = ~uint64_t(0);
+
+  /** The time, in nanoseconds, since the beginning of the trace */
+  int64_t time = 0;
+  /** The address of the allocation - it identifies the allocation until it's freed */
+  uint64_t id = 0;
+  size_t size = 0, alignment = 0;
+  /** The stream handle (as an integer) or host_order */
+  uint64_t stream = host_order;
+  /** The id of the calling thread */
+  int64_t thread = 0;
+  memory_kind_id kind = memory_kind_id::host;
+  bool is_free = false;
+};
+
+/**
+ * @brief A thread-safe record of allocations and deallocations
+ *
+ * The lifetime of an allocation spans from its allocation event to the first subsequent
+ * deallocation event with the same id.
+ *
+ * The text format has one event per line:
+ * `<time> <a|f> <kind> <id> <size> <alignment> <stream|host> <thread>`
+ */
+class DLL_PUBLIC alloc_trace {
+ public:
+  void record(bool is_free, memory_kind_id kind, void *ptr, size_t size, size_t alignment,
+              uint64_t stream = alloc_trace_event::host_order);
+
+  /** Returns a copy of the events recorded so far. */
+  std::vector<alloc_trace_event> events() const;
+
+  /** Discards the recorded events. */
+  void clear();
+
+  void write(std::ostream &os) const;
+
+  /** Reads a trace in the format produced by `write`; throws on a malformed line. */
+  static std::vector<alloc_trace_event> read(std::istream &is);
+
+ private:
+  mutable std::mutex mtx_;
+  std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+  std::vector<alloc_trace_event> events_;
+};
+
+namespace detail {
+
+template <typename Interface>
+class TracingResourceBase : public Interface, public with_upstream<memory_kind_of<Interface>> {
+ public:
+  using memory_kind = memory_kind_of<Interface>;
+
+  TracingResourceBase(std::shared_ptr<Interface> upstream, std::shared_ptr<alloc_trace> trace)
+  : upstream_(std::move(upstream)), trace_(std::move(trace)) {}
+
+  Interface *upstream() const override {
+    return upstream_.get();
+  }
+
+  alloc_trace *trace() const noexcept {
+    return trace_.get();
+  }
+
+ protected:
+  static constexpr memory_kind_id kind_id = kind2id_v<memory_kind>;
+
+  std::shared_ptr<Interface> upstream_;
+  std::shared_ptr<alloc_trace> trace_;
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    void *ptr = upstream_->allocate(bytes, alignment);
+    trace_->record(false, kind_id, ptr, bytes, alignment);
+    return ptr;
+  }
+
+  void do_deallocate(void *ptr, size_t bytes, size_t alignment) override {
+    trace_->record(true, kind_id, ptr, bytes, alignment);
+    upstream_->deallocate(ptr, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource<memory_kind> &other) const noexcept override {
+    if (auto *other_tracing = dynamic_cast<const TracingResourceBase *>(&other))
+      return upstream_->is_equal(*other_tracing->upstream_);
+    return upstream_->is_equal(other);
+  }
+};
+
+template <typename Interface>
+class TracingResourceImpl;
+
+template <typename Kind>
+class TracingResourceImpl<memory_resource<Kind>>
+: public TracingResourceBase<memory_resource<Kind>> {
+ public:
+  using TracingResourceBase<memory_resource<Kind>>::TracingResourceBase;
+};
+
+template <typename Kind>
+class TracingResourceImpl<async_memory_resource<Kind>>
+: public TracingResourceBase<async_memory_resource<Kind>> {
+ public:
+  using Base = TracingResourceBase<async_memory_resource<Kind>>;
+  using Base::Base;
+
+ private:
+  void *do_allocate_async(size_t bytes, size_t alignment, stream_view stream) override {
+    void *ptr = this->upstream_->allocate_async(bytes, alignment, stream);
+    this->trace_->record(false, Base::kind_id, ptr, bytes, alignment,
+                         reinterpret_cast<uintptr_t>(stream.get()));
+    return ptr;
+  }
+
+  void do_deallocate_async(void *ptr, size_t bytes, size_t alignment, stream_view stream) override {
+    this->trace_->record(true, Base::kind_id, ptr, bytes, alignment,
+                         reinterpret_cast<uintptr_t>(stream.get()));
+    this->upstream_->deallocate_async(ptr, bytes, alignment, stream);
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Passes the requests to the upstream resource and records them in a trace
+ *
+ * The traces of real workloads can be replayed against different resources to compare them
+ * (see dali/core/mm/perf_test.cu).
+ *
+ * @tparam Interface  memory_resource<Kind> or async_memory_resource<Kind>
+ */
+template <typename Interface>
+using tracing_resource = detail::TracingResourceImpl<Interface>;
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_TRACING_RESOURCE_H_
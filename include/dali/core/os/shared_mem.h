@@ -16,6 +16,7 @@
 #define DALI_CORE_OS_SHARED_MEM_H_
 
 #include <stdint.h>
+#include <cstring>
 #include <memory>
 #include <string>
 #include "dali/core/common.h"
@@ -28,7 +29,7 @@ namespace dali {
 using shm_handle_t = int;
 using fd_handle_t = int;
 
-void handle_strerror(int errnum, char *buf, size_t buflen) {
+inline void handle_strerror(int errnum, char *buf, size_t buflen) {
   #if (_POSIX_C_SOURCE >= 200112L) && !_GNU_SOURCE
     DALI_ENFORCE(strerror_r(errnum, buf, buflen) == 0, "Call to strerror_r failed.");
   #else
@@ -90,6 +91,23 @@ class DLL_PUBLIC ShmHandle : public UniqueHandle<shm_handle_t, ShmHandle> {
    */
   static ShmHandle CreateHandle();
 
+  /**
+   * Open a named shared memory object, creating it if it doesn't exist.
+   *
+   * Unlike the handles from `CreateHandle`, the named objects can be opened by unrelated
+   * processes. The object outlives the handle - it's removed with `Unlink`.
+   *
+   * @param name    the name of the object, without the leading slash
+   * @param created if not null, set to true when the object was created by this call
+   */
+  static ShmHandle OpenNamed(const std::string &name, bool *created = nullptr);
+
+  /**
+   * Remove the name of a shared memory object. The memory is released when the last handle
+   * (or mapping) of the object is closed.
+   */
+  static void Unlink(const std::string &name);
+
   static void DestroyHandle(shm_handle_t h);
 
   static constexpr shm_handle_t null_handle() {
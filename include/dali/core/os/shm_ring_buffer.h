@@ -0,0 +1,162 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_OS_SHM_RING_BUFFER_H_
+#define DALI_CORE_OS_SHM_RING_BUFFER_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include "dali/core/common.h"
+#include "dali/core/os/shared_mem.h"
+#include "dali/core/span.h"
+
+namespace dali {
+
+/**
+ * @brief A single-producer, single-consumer ring buffer of variable-sized records in shared
+ *        memory
+ *
+ * The producer reserves a record, writes the data directly to the shared memory and commits it;
+ * the consumer reads the records in the order in which they were committed and releases them
+ * when it's done with the data - which allows the consumer to use the records without copying.
+ * The synchronization is lock-free: the write and release positions are atomic counters in the
+ * shared memory, each modified by one side only.
+ *
+ * The buffer is created by one of the processes (`Create`) and attached to, by its handle,
+ * in the other one (`Attach`). Typically, the producer process writes the records and the
+ * consumer process reads them, but both sides can be used within one process.
+ *
+ * The payloads are aligned to kAlignment bytes.
+ */
+class DLL_PUBLIC ShmRingBuffer {
+ public:
+  static constexpr uint64_t kAlignment = 64;
+
+  /**
+   * @brief Creates a new ring buffer, with `capacity` bytes for the records and their headers
+   *
+   * The capacity is rounded up to a multiple of kAlignment.
+   */
+  static std::unique_ptr<ShmRingBuffer> Create(uint64_t capacity);
+
+  /**
+   * @brief Attaches to a ring buffer created with `Create`, possibly in another process
+   *
+   * The handle is owned (and closed) by the returned object.
+   */
+  static std::unique_ptr<ShmRingBuffer> Attach(shm_handle_t handle);
+
+  ShmRingBuffer(const ShmRingBuffer &) = delete;
+  ShmRingBuffer &operator=(const ShmRingBuffer &) = delete;
+
+  /** The handle (file descriptor) of the shared memory, to be passed to the other process. */
+  shm_handle_t handle() {
+    return shm_.handle();
+  }
+
+  /** The number of bytes available for the records, including the record headers. */
+  uint64_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  /** The largest record which can be written to the buffer. */
+  uint64_t max_record_size() const noexcept {
+    return capacity_ - kAlignment;
+  }
+
+  /// @name Producer
+  /// @{
+
+  /**
+   * @brief Reserves a record of `size` bytes
+   *
+   * @return The memory to be filled with the data of the record or nullptr, if there's not
+   *         enough free space (the consumer has not released enough records yet).
+   *         The record becomes visible to the consumer after `Commit`.
+   */
+  uint8_t *TryReserve(uint64_t size);
+
+  /** Publishes the record reserved with TryReserve. */
+  void Commit();
+
+  /// @}
+  /// @name Consumer
+  /// @{
+
+  /**
+   * @brief Gets the next committed record
+   *
+   * @return The data of the record; if there are no new records, the returned span has
+   *         a null data pointer (an empty record has a non-null one).
+   *
+   * The record remains valid until it's released. Multiple records can be read before they're
+   * released.
+   */
+  span<uint8_t> TryRead();
+
+  /** Releases the oldest record that was read and not yet released. */
+  void Release();
+
+  /**
+   * @brief Reads the next record and shares it; the record is released when the last reference
+   *        is gone.
+   *
+   * The references can be dropped in any order and on any thread - the records are released in
+   * order, as soon as all the older ones are released, too. The ring buffer must outlive the
+   * references.
+   *
+   * @return A pointer to the data of the record or nullptr, if there are no new records.
+   */
+  std::shared_ptr<uint8_t> TryShare(uint64_t *size = nullptr);
+
+  /// @}
+
+ private:
+  ShmRingBuffer(shm_handle_t handle, uint64_t size);
+
+  struct Header;
+  /** The size of the control block preceding the data region */
+  static constexpr uint64_t kHeaderSize = 3 * kAlignment;
+  struct Record {
+    uint64_t pos, extent;
+    bool done;
+  };
+
+  Header *header();
+  /** Reads the next record, if any; must be called with read_mtx_ locked. */
+  bool ReadNext(span<uint8_t> &record, uint64_t &pos);
+  uint8_t *data();
+  void ReleaseDone();
+
+  SharedMem shm_;
+  uint64_t capacity_ = 0;
+
+  // producer state
+  struct {
+    uint64_t pos = 0, skip = 0, size = 0, extent = 0;
+    bool active = false;
+  } reservation_;
+
+  // consumer state
+  uint64_t read_pos_ = 0;
+  std::mutex read_mtx_;
+  std::deque<Record> read_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_CORE_OS_SHM_RING_BUFFER_H_
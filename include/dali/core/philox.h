@@ -0,0 +1,165 @@
+// Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_PHILOX_H_
+#define DALI_CORE_PHILOX_H_
+
+#include <cstdint>
+#include "dali/core/host_dev.h"
+
+namespace dali {
+
+/**
+ * @brief Philox4x32-10 counter-based random bit generator
+ *
+ * The generated sequence is a function of the key (seed) and a 128-bit counter - there's no
+ * other state, so any position of any stream can be reached in constant time.
+ * The upper 64 bits of the counter select the subsequence and the lower 64 bits - the block
+ * of 4 outputs within it.
+ *
+ * The seeding and the order of the outputs follow `curand_init` and `curand` for
+ * `curandStatePhilox4_32_10_t`, so the host and device generators initialized with the same
+ * (seed, subsequence, offset) produce the same bits.
+ *
+ * Satisfies the UniformRandomBitGenerator requirements.
+ */
+class Philox4x32_10 {
+ public:
+  using result_type = uint32_t;
+
+  DALI_HOST_DEV Philox4x32_10() : Philox4x32_10(0) {}
+
+  /**
+   * @param seed        the key
+   * @param subsequence the index of the subsequence (upper half of the counter)
+   * @param offset      the number of 32-bit outputs to skip within the subsequence
+   */
+  DALI_HOST_DEV explicit Philox4x32_10(uint64_t seed, uint64_t subsequence = 0,
+                                       uint64_t offset = 0) {
+    init(seed, subsequence, offset);
+  }
+
+  DALI_HOST_DEV void init(uint64_t seed, uint64_t subsequence = 0, uint64_t offset = 0) {
+    key_[0] = static_cast<uint32_t>(seed);
+    key_[1] = static_cast<uint32_t>(seed >> 32);
+    for (auto &c : ctr_)
+      c = 0;
+    idx_ = 0;
+    skipahead_subsequence(subsequence);
+    skipahead(offset);
+  }
+
+  /**
+   * @brief Skips `n` 32-bit outputs
+   */
+  DALI_HOST_DEV void skipahead(uint64_t n) {
+    idx_ += n & 3;
+    n >>= 2;
+    if (idx_ > 3) {
+      idx_ -= 4;
+      n++;
+    }
+    add_lo(n);
+    generate_block();
+  }
+
+  /**
+   * @brief Skips `n` subsequences (2^66 outputs each)
+   */
+  DALI_HOST_DEV void skipahead_subsequence(uint64_t n) {
+    add_hi(n);
+    generate_block();
+  }
+
+  DALI_HOST_DEV result_type operator()() {
+    result_type ret = out_[idx_++];
+    if (idx_ == 4) {
+      add_lo(1);
+      generate_block();
+      idx_ = 0;
+    }
+    return ret;
+  }
+
+  DALI_HOST_DEV static constexpr result_type min() { return 0; }
+  DALI_HOST_DEV static constexpr result_type max() { return ~result_type(0); }
+
+  DALI_HOST_DEV friend bool operator==(const Philox4x32_10 &a, const Philox4x32_10 &b) {
+    for (int i = 0; i < 4; i++)
+      if (a.ctr_[i] != b.ctr_[i])
+        return false;
+    return a.key_[0] == b.key_[0] && a.key_[1] == b.key_[1] && a.idx_ == b.idx_;
+  }
+
+  DALI_HOST_DEV friend bool operator!=(const Philox4x32_10 &a, const Philox4x32_10 &b) {
+    return !(a == b);
+  }
+
+  /**
+   * @brief Calculates the 4 outputs of Philox4x32-10 for given counter and key
+   */
+  DALI_HOST_DEV static void Block(uint32_t out[4], const uint32_t ctr[4], const uint32_t key[2]) {
+    uint32_t x[4] = { ctr[0], ctr[1], ctr[2], ctr[3] };
+    uint32_t k[2] = { key[0], key[1] };
+    for (int r = 0; r < 10; r++) {
+      if (r) {
+        k[0] += kW0;
+        k[1] += kW1;
+      }
+      uint64_t p0 = static_cast<uint64_t>(kM0) * x[0];
+      uint64_t p1 = static_cast<uint64_t>(kM1) * x[2];
+      uint32_t y0 = static_cast<uint32_t>(p1 >> 32) ^ x[1] ^ k[0];
+      uint32_t y2 = static_cast<uint32_t>(p0 >> 32) ^ x[3] ^ k[1];
+      x[0] = y0;
+      x[1] = static_cast<uint32_t>(p1);
+      x[2] = y2;
+      x[3] = static_cast<uint32_t>(p0);
+    }
+    for (int i = 0; i < 4; i++)
+      out[i] = x[i];
+  }
+
+ private:
+  static constexpr uint32_t kM0 = 0xD2511F53u;
+  static constexpr uint32_t kM1 = 0xCD9E8D57u;
+  static constexpr uint32_t kW0 = 0x9E3779B9u;
+  static constexpr uint32_t kW1 = 0xBB67AE85u;
+
+  DALI_HOST_DEV void add_lo(uint64_t n) {
+    uint64_t lo = (static_cast<uint64_t>(ctr_[1]) << 32 | ctr_[0]) + n;
+    if (lo < n)
+      add_hi(1);
+    ctr_[0] = static_cast<uint32_t>(lo);
+    ctr_[1] = static_cast<uint32_t>(lo >> 32);
+  }
+
+  DALI_HOST_DEV void add_hi(uint64_t n) {
+    uint64_t hi = (static_cast<uint64_t>(ctr_[3]) << 32 | ctr_[2]) + n;
+    ctr_[2] = static_cast<uint32_t>(hi);
+    ctr_[3] = static_cast<uint32_t>(hi >> 32);
+  }
+
+  DALI_HOST_DEV void generate_block() {
+    Block(out_, ctr_, key_);
+  }
+
+  uint32_t ctr_[4];
+  uint32_t key_[2];
+  uint32_t out_[4];
+  int idx_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_CORE_PHILOX_H_
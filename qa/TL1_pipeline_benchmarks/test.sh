@@ -0,0 +1,16 @@
+#!/bin/bash -e
+# used pip packages
+pip_packages='numpy pillow'
+target_dir=./dali/benchmark
+
+test_body() {
+    # test code
+    python pipeline_bench.py --iters 20 --warmup 5 --output /tmp/pipeline_bench.json
+    # a run compared with itself must not report a regression
+    python pipeline_bench.py --workloads asr --iters 1 --warmup 0 \
+        --baseline /tmp/pipeline_bench.json --max-regression 1
+}
+
+pushd ../..
+source ./qa/test_template.sh
+popd